@@ -322,6 +322,44 @@ void time_left_test()
     TEST_ASSERT_EQUAL(-1, queue.time_left(0));
 }
 
+volatile int user_count = 0;
+
+void user_count_func()
+{
+    user_count++;
+}
+
+void user_allocated_event_test()
+{
+    EventQueue queue(TEST_EQUEUE_SIZE);
+    UserAllocatedEvent<void (*)()> event(&queue, user_count_func);
+    user_count = 0;
+
+    // exhaust the queue's buffer, user allocated events need none of it
+    while (queue.call(no)) {
+    }
+
+    TEST_ASSERT(event.call());
+    TEST_ASSERT(!event.call());
+    TEST_ASSERT(event.cancel());
+    TEST_ASSERT(!event.cancel());
+
+    EventQueue other(TEST_EQUEUE_SIZE);
+    TEST_ASSERT(event.call_on(&other));
+    other.dispatch(0);
+    TEST_ASSERT_EQUAL(1, user_count);
+
+    // reposting reuses the same memory
+    event.delay(10);
+    event.period(10);
+    TEST_ASSERT(event.call_on(&other));
+    other.dispatch(55);
+    TEST_ASSERT_EQUAL(6, user_count);
+    TEST_ASSERT(event.cancel());
+    other.dispatch(20);
+    TEST_ASSERT_EQUAL(6, user_count);
+}
+
 // Test setup
 utest::v1::status_t test_setup(const size_t number_of_cases)
 {
@@ -348,6 +386,7 @@ const Case cases[] = {
     Case("Testing the event inference", event_inference_test),
 
     Case("Testing time_left", time_left_test),
+    Case("Testing user allocated events", user_allocated_event_test),
 };
 
 Specification specification(test_setup, cases);
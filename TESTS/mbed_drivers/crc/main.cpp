@@ -48,6 +48,12 @@ void test_supported_polynomials()
         TEST_ASSERT_EQUAL(0, ct.compute((void *)test, strlen((const char *)test), &crc));
         TEST_ASSERT_EQUAL(0xBB3D, crc);
     }
+    {
+        MbedCRC<POLY_16BIT_IBM, 16> ct;
+        char high[] = { 0x3F, (char)0xBF, 0x7F, (char)0xFF };
+        TEST_ASSERT_EQUAL(0, ct.compute((void *)high, sizeof(high), &crc));
+        TEST_ASSERT_EQUAL(0x805D, crc);
+    }
     {
         MbedCRC<POLY_32BIT_ANSI, 32> ct;
         TEST_ASSERT_EQUAL(0, ct.compute((void *)test, strlen((const char *)test), &crc));
@@ -70,6 +76,60 @@ void test_partial_crc()
     }
 }
 
+void test_partial_long_crc()
+{
+    char test[300];
+    uint32_t crc;
+    uint32_t partial_crc;
+
+    for (size_t i = 0; i < sizeof(test); i++) {
+        test[i] = i * 7;
+    }
+
+    // Parts of all sizes, so the multi-byte steps start at any offset
+    MbedCRC<POLY_32BIT_ANSI, 32> ct;
+    TEST_ASSERT_EQUAL(0, ct.compute((void *)test, sizeof(test), &crc));
+
+    TEST_ASSERT_EQUAL(0, ct.compute_partial_start(&partial_crc));
+    for (size_t offset = 0, size = 1; offset < sizeof(test); offset += size, size++) {
+        if (offset + size > sizeof(test)) {
+            size = sizeof(test) - offset;
+        }
+        TEST_ASSERT_EQUAL(0, ct.compute_partial((void *)&test[offset], size, &partial_crc));
+    }
+    TEST_ASSERT_EQUAL(0, ct.compute_partial_stop(&partial_crc));
+
+    TEST_ASSERT_EQUAL(crc, partial_crc);
+}
+
+void test_chained_crc()
+{
+    char  test[] = "123456789";
+    uint32_t crc;
+
+    // Chained the way littlefs and TDBStore compute their CRCs, the CRC of
+    // one part being the initial value of the next
+    {
+        MbedCRC<POLY_32BIT_REV_ANSI, 32> ct(0xFFFFFFFF, 0x0, true, false);
+        TEST_ASSERT_EQUAL(0, ct.compute((void *)test, 4, &crc));
+    }
+    {
+        MbedCRC<POLY_32BIT_REV_ANSI, 32> ct(crc, 0x0, true, false);
+        TEST_ASSERT_EQUAL(0, ct.compute((void *)&test[4], 5, &crc));
+    }
+    TEST_ASSERT_EQUAL(0xCBF43926, crc ^ 0xFFFFFFFF);
+
+    {
+        MbedCRC<POLY_32BIT_ANSI, 32> ct(0xFFFFFFFF, 0x0, true, false);
+        TEST_ASSERT_EQUAL(0, ct.compute((void *)test, 4, &crc));
+    }
+    {
+        MbedCRC<POLY_32BIT_ANSI, 32> ct(crc, 0x0, true, false);
+        TEST_ASSERT_EQUAL(0, ct.compute((void *)&test[4], 5, &crc));
+    }
+    TEST_ASSERT_EQUAL(0x9B63D02C, crc);
+}
+
 void test_sd_crc()
 {
     MbedCRC<POLY_7BIT_SD, 7> crc7;
@@ -123,6 +183,11 @@ void test_any_polynomial()
         TEST_ASSERT_EQUAL(0, ct.compute((void *)test, strlen((const char *)test), &crc));
         TEST_ASSERT_EQUAL(0xE3069283, crc);
     }
+    {
+        MbedCRC<0x31, 8> ct(0x0, 0x0, 1, 1);
+        TEST_ASSERT_EQUAL(0, ct.compute((void *)test, strlen((const char *)test), &crc));
+        TEST_ASSERT_EQUAL(0xA1, crc);
+    }
 }
 
 void test_thread(void)
@@ -157,6 +222,8 @@ void test_thread_safety()
 Case cases[] = {
     Case("Test supported polynomials", test_supported_polynomials),
     Case("Test partial CRC", test_partial_crc),
+    Case("Test partial CRC of long data", test_partial_long_crc),
+    Case("Test chained CRC", test_chained_crc),
     Case("Test SD CRC polynomials", test_sd_crc),
     Case("Test not supported polynomials", test_any_polynomial),
     Case("Test thread safety", test_thread_safety)
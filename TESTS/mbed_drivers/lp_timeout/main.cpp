@@ -23,9 +23,52 @@
 #include "utest/utest.h"
 #include "unity/unity.h"
 #include "../timeout/timeout_tests.h"
+#include "hal/mbed_lp_ticker_wrapper.h"
 
 using namespace utest::v1;
 
+#if DEVICE_LPTICKER && (LPTICKER_DELAY_TICKS > 0)
+#define CLOSE_TIMEOUTS      8
+#define CLOSE_SPACING_US    200
+
+static volatile uint32_t close_fired;
+
+static void close_timeout_cb()
+{
+    close_fired++;
+}
+
+/** Test timeouts closer together than the low power ticker can be rewritten
+ *
+ * Given LowPowerTimeouts a few ticks apart
+ * When they are scheduled through the low power ticker wrapper
+ * Then all of them fire, and the wrapper statistics are reported
+ */
+void test_close_timeouts()
+{
+    LowPowerTimeout timeouts[CLOSE_TIMEOUTS];
+    lp_ticker_wrapper_stats_t before, after;
+
+    close_fired = 0;
+    lp_ticker_wrapper_get_stats(&before);
+    for (int i = 0; i < CLOSE_TIMEOUTS; i++) {
+        timeouts[i].attach_us(close_timeout_cb, 1000 + i * CLOSE_SPACING_US);
+    }
+    wait_ms(10 + CLOSE_TIMEOUTS * CLOSE_SPACING_US / 1000);
+    lp_ticker_wrapper_get_stats(&after);
+
+    TEST_ASSERT_EQUAL_UINT32(CLOSE_TIMEOUTS, close_fired);
+
+    utest_printf("hw_writes %lu batched %lu absorbed_irqs %lu spins %lu timeouts %lu max_late_ticks %lu\n",
+                 (unsigned long)(after.hw_writes - before.hw_writes),
+                 (unsigned long)(after.batched - before.batched),
+                 (unsigned long)(after.absorbed_irqs - before.absorbed_irqs),
+                 (unsigned long)(after.spins - before.spins),
+                 (unsigned long)(after.timeouts - before.timeouts),
+                 (unsigned long)after.max_late_ticks);
+}
+#endif
+
 utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason)
 {
     greentea_case_failure_abort_handler(source, reason);
@@ -75,6 +118,10 @@ Case cases[] = {
          greentea_failure_handler),
 #endif
 
+#if DEVICE_LPTICKER && (LPTICKER_DELAY_TICKS > 0)
+    Case("Timeouts closer than the ticker rewrite interval", test_close_timeouts),
+#endif
+
     Case("Timing drift (attach)", test_drift<AttachTester<LowPowerTimeout> >),
     Case("Timing drift (attach_us)", test_drift<AttachUSTester<LowPowerTimeout> >),
 };
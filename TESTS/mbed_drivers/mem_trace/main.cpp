@@ -23,6 +23,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdarg.h>
+#include <string.h>
 
 #ifndef MBED_MEM_TRACING_ENABLED
 #error [NOT_SUPPORTED] test not supported
@@ -402,6 +403,58 @@ static void test_case_multithread_malloc_free()
 }
 
 
+/** Test the aggregating tracer
+ *
+ *  Given the aggregating memory trace callback
+ *  When memory is allocated and freed from a single call site
+ *  Then the snapshot reports the live, peak and operation counts of that site
+ *
+ */
+static void test_case_aggregate()
+{
+    const size_t block_size = 40;
+    const uint32_t num_blocks = 3;
+    void *blocks[num_blocks];
+    uint8_t snapshot[sizeof(mbed_mem_trace_snapshot_t) + 4 * sizeof(mbed_mem_trace_site_t)];
+    mbed_mem_trace_snapshot_t header;
+    mbed_mem_trace_site_t site;
+
+    // Allocated before tracing, so unknown to the tracer
+    void *untraced = malloc(block_size);
+    TEST_ASSERT_NOT_NULL(untraced);
+
+    mbed_mem_trace_aggregate_reset();
+    mbed_mem_trace_set_callback(mbed_mem_trace_aggregate_callback);
+
+    for (uint32_t i = 0; i < num_blocks; i++) {
+        blocks[i] = malloc(block_size);
+    }
+    free(blocks[0]);
+    free(untraced);
+
+    mbed_mem_trace_set_callback(NULL);
+
+    TEST_ASSERT_EQUAL(sizeof(header) + sizeof(site), mbed_mem_trace_aggregate_snapshot(NULL, 0));
+    TEST_ASSERT_EQUAL(0, mbed_mem_trace_aggregate_snapshot(snapshot, sizeof(header) - 1));
+    TEST_ASSERT_EQUAL(sizeof(header) + sizeof(site), mbed_mem_trace_aggregate_snapshot(snapshot, sizeof(snapshot)));
+
+    memcpy(&header, snapshot, sizeof(header));
+    memcpy(&site, snapshot + sizeof(header), sizeof(site));
+    TEST_ASSERT_EQUAL_HEX32(MBED_MEM_TRACE_SNAPSHOT_MAGIC, header.magic);
+    TEST_ASSERT_EQUAL(MBED_MEM_TRACE_SNAPSHOT_VERSION, header.version);
+    TEST_ASSERT_EQUAL(1, header.site_cnt);
+    TEST_ASSERT_EQUAL(0, header.untracked_cnt);
+    TEST_ASSERT_EQUAL(1, header.unknown_free_cnt);
+    TEST_ASSERT_EQUAL(num_blocks, site.alloc_cnt);
+    TEST_ASSERT_EQUAL(1, site.free_cnt);
+    TEST_ASSERT_EQUAL((num_blocks - 1) * block_size, site.live_size);
+    TEST_ASSERT_EQUAL(num_blocks * block_size, site.peak_size);
+
+    for (uint32_t i = 1; i < num_blocks; i++) {
+        free(blocks[i]);
+    }
+}
+
 
 static Case cases[] = {
     Case("Test single malloc/free trace", test_case_single_malloc_free),
@@ -409,7 +462,8 @@ static Case cases[] = {
     Case("Test trace off", test_case_trace_off),
     Case("Test partial trace", test_case_partial_trace),
     Case("Test new/delete trace", test_case_new_delete),
-    Case("Test multithreaded trace", test_case_multithread_malloc_free)
+    Case("Test multithreaded trace", test_case_multithread_malloc_free),
+    Case("Test aggregating tracer", test_case_aggregate)
 };
 
 static utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
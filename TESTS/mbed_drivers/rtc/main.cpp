@@ -467,6 +467,38 @@ utest::v1::status_t test_setup(const size_t number_of_cases)
     return verbose_test_setup_handler(number_of_cases);
 }
 
+#if MBED_CONF_PLATFORM_TIME_CACHE_SYNC_MS && DEVICE_LPTICKER
+/* This test verifies that time() reads the RTC once per sync interval.
+ *
+ * Given RTC stubs are attached and the time has been set.
+ * When time() is called twice within the sync interval.
+ * Then the RTC is read only by the first call, and the second call
+ * extrapolates the time read.
+ */
+void test_time_cache()
+{
+    attach_rtc(read_rtc_stub, write_rtc_stub, init_rtc_stub, isenabled_rtc_stub);
+    rtc_enabled_ret = true;
+
+    set_time(CUSTOM_TIME_1);
+
+    rtc_read_called = false;
+    TEST_ASSERT_EQUAL(CUSTOM_TIME_1, time(NULL));
+    TEST_ASSERT_EQUAL(true, rtc_read_called);
+
+    rtc_read_called = false;
+    TEST_ASSERT_EQUAL(CUSTOM_TIME_1, time(NULL));
+    TEST_ASSERT_EQUAL(false, rtc_read_called);
+
+    /* Setting the time drops the extrapolated one. */
+    set_time(CUSTOM_TIME_2);
+    TEST_ASSERT_EQUAL(CUSTOM_TIME_2, time(NULL));
+    TEST_ASSERT_EQUAL(true, rtc_read_called);
+
+    attach_rtc(rtc_read, rtc_write, rtc_init, rtc_isenabled);
+}
+#endif
+
 Case cases[] = {
     Case("Unit Test: attach stub RTC functions.", test_attach_RTC_stub_funtions),
     Case("Unit Test: attach original RTC functions.", test_attach_RTC_org_funtions),
@@ -486,6 +518,9 @@ Case cases[] = {
     Case("Functional Test: set time - CUSTOM_TIME_2.", test_functional_set<CUSTOM_TIME_2>),
 
     Case("Functional Test: RTC counts seconds.", test_functional_count),
+#if MBED_CONF_PLATFORM_TIME_CACHE_SYNC_MS && DEVICE_LPTICKER
+    Case("Unit Test: time() - RTC read once per sync interval.", test_time_cache),
+#endif
 };
 
 Specification specification(test_setup, cases);
@@ -686,6 +686,33 @@ void test_dispatch5()
     Verifier<T>::verify5(&Callback<T(T, T, T, T, T)>::thunk, (void *)&cb);
 }
 
+// Function object too large for the default storage
+template <typename T>
+struct Sum4 {
+    T a, b, c, d;
+
+    T operator()(T x) const
+    {
+        return a + b + c + d + x;
+    }
+};
+
+template <typename T>
+void test_storage()
+{
+    Sum4<T> sum = { 1, 2, 3, 4 };
+    Callback<T(T), sizeof(Sum4<T>)> cb(sum);
+    TEST_ASSERT_EQUAL(15, cb(5));
+
+    Callback<T(T), sizeof(Sum4<T>)> copy(cb);
+    TEST_ASSERT_EQUAL(15, copy(5));
+    TEST_ASSERT(copy == cb);
+
+    cb = &static_func1<T>;
+    TEST_ASSERT_EQUAL(static_func1<T>(5), cb(5));
+    TEST_ASSERT(copy != cb);
+}
+
 
 // Test setup
 utest::v1::status_t test_setup(const size_t number_of_cases)
@@ -701,6 +728,7 @@ Case cases[] = {
     Case("Testing callbacks with 3 ints", test_dispatch3<int>),
     Case("Testing callbacks with 4 ints", test_dispatch4<int>),
     Case("Testing callbacks with 5 ints", test_dispatch5<int>),
+    Case("Testing callbacks with extra storage", test_storage<int>),
 };
 
 Specification specification(test_setup, cases);
@@ -19,6 +19,7 @@
 #include "greentea-client/test_env.h"
 
 #include "cmsis.h"
+#include "platform/mbed_toolchain.h"
 #include <stdlib.h>
 
 #include "mpu_api.h"
@@ -43,6 +44,8 @@ uint32_t real_mem_fault_handler;
 static volatile uint16_t data_function = ASM_BX_LR;
 static volatile uint16_t bss_function;
 
+MBED_ALIGN(32) static volatile uint32_t guard_words[8];
+
 static void clear_caches()
 {
 #if defined(__CORTEX_M7)
@@ -68,6 +71,7 @@ static void hard_fault_handler_test()
 {
     fault_count++;
     mbed_mpu_enable_ram_xn(false);
+    mbed_mpu_set_stack_guard(0, 0);
 }
 
 static void mpu_fault_test(const volatile uint16_t *mem_function)
@@ -152,6 +156,29 @@ void mpu_fault_test_heap()
     free(heap_function);
 }
 
+void mpu_stack_guard_test()
+{
+    mbed_mpu_init();
+
+    // Reads of the guard are allowed, writes fault
+    fault_count = 0;
+    mbed_mpu_set_stack_guard((uint32_t)guard_words, sizeof(guard_words));
+    TEST_ASSERT_EQUAL(0, guard_words[0]);
+    TEST_ASSERT_EQUAL(0, fault_count);
+    guard_words[0] = 1;
+    TEST_ASSERT_EQUAL(1, fault_count);
+
+    // Verify that the guard can be removed
+    fault_count = 0;
+    mbed_mpu_set_stack_guard((uint32_t)guard_words, sizeof(guard_words));
+    mbed_mpu_set_stack_guard(0, 0);
+    guard_words[0] = 2;
+    TEST_ASSERT_EQUAL(0, fault_count);
+    TEST_ASSERT_EQUAL(2, guard_words[0]);
+
+    mbed_mpu_free();
+}
+
 utest::v1::status_t fault_override_setup(const Case *const source, const size_t index_of_case)
 {
     // Save old fault handlers and replace it with a new one
@@ -181,7 +208,8 @@ Case cases[] = {
     Case("MPU - data fault", fault_override_setup, mpu_fault_test_data, fault_override_teardown),
     Case("MPU - bss fault", fault_override_setup, mpu_fault_test_bss, fault_override_teardown),
     Case("MPU - stack fault", fault_override_setup, mpu_fault_test_stack, fault_override_teardown),
-    Case("MPU - heap fault", fault_override_setup, mpu_fault_test_heap, fault_override_teardown)
+    Case("MPU - heap fault", fault_override_setup, mpu_fault_test_heap, fault_override_teardown),
+    Case("MPU - stack guard fault", fault_override_setup, mpu_stack_guard_test, fault_override_teardown)
 #endif
 };
 
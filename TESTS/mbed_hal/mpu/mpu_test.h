@@ -81,6 +81,16 @@ void mpu_fault_test_stack(void);
  */
 void mpu_fault_test_heap(void);
 
+/** Test that the stack guard faults on writes
+ *
+ * Given board provides a v7-M MPU.
+ * When a stack guard is set with a call to ::mbed_mpu_set_stack_guard.
+ * Then reading the guard succeeds, writing it results in a fault, and
+ * writing succeeds again once the guard is removed.
+ *
+ */
+void mpu_stack_guard_test(void);
+
 /**@}*/
 
 #ifdef __cplusplus
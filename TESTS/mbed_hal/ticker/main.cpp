@@ -1782,6 +1782,65 @@ static void test_irq_handler_multiple_event_multiple_dequeue()
     TEST_ASSERT_EQUAL(0, interface_stub.disable_interrupt_call);
 }
 
+/**
+ * Given an initialized ticker.
+ * When events are inserted with ticker_insert_event_with_tolerance_us.
+ * Then:
+ *   - The interrupt should be scheduled at the earliest deadline, the
+ *     timestamp plus the tolerance, of the queued events.
+ *   - Inserting an event with an earlier deadline behind the head should
+ *     move the interrupt earlier.
+ *   - When ticker_irq_handler is called at the deadline every event whose
+ *     timestamp has passed should be dispatched at once.
+ */
+static void test_irq_handler_coalesce_events_with_tolerance()
+{
+    static size_t handler_called = 0;
+    struct irq_handler_stub_t {
+        static void event_handler(uint32_t id)
+        {
+            ++handler_called;
+        }
+    };
+    handler_called = 0;
+
+    ticker_set_handler(&ticker_stub, irq_handler_stub_t::event_handler);
+    interface_stub.set_interrupt_call = 0;
+
+    ticker_event_t first_event = { 0 };
+    ticker_insert_event_with_tolerance_us(&ticker_stub, &first_event, 100, 50, 1);
+    TEST_ASSERT_EQUAL(1, interface_stub.set_interrupt_call);
+    TEST_ASSERT_EQUAL_UINT32(150, interface_stub.interrupt_timestamp);
+
+    // later deadlines don't need a new interrupt
+    ticker_event_t second_event = { 0 };
+    ticker_insert_event_with_tolerance_us(&ticker_stub, &second_event, 120, 100, 2);
+    ticker_event_t exact_event = { 0 };
+    ticker_insert_event_us(&ticker_stub, &exact_event, 200, 3);
+    TEST_ASSERT_EQUAL(1, interface_stub.set_interrupt_call);
+    TEST_ASSERT_EQUAL_UINT32(150, interface_stub.interrupt_timestamp);
+
+    // an earlier deadline behind the head moves the interrupt
+    ticker_event_t urgent_event = { 0 };
+    ticker_insert_event_with_tolerance_us(&ticker_stub, &urgent_event, 130, 5, 4);
+    TEST_ASSERT_EQUAL(2, interface_stub.set_interrupt_call);
+    TEST_ASSERT_EQUAL_UINT32(135, interface_stub.interrupt_timestamp);
+
+    // the first three events share one interrupt
+    interface_stub.timestamp = 135;
+    ticker_irq_handler(&ticker_stub);
+    TEST_ASSERT_EQUAL_UINT32(3, handler_called);
+    TEST_ASSERT_EQUAL_PTR(&exact_event, queue_stub.head);
+    TEST_ASSERT_EQUAL_UINT32(200, interface_stub.interrupt_timestamp);
+
+    interface_stub.timestamp = 200;
+    ticker_irq_handler(&ticker_stub);
+    TEST_ASSERT_EQUAL_UINT32(4, handler_called);
+    TEST_ASSERT_NULL(queue_stub.head);
+
+    TEST_ASSERT_EQUAL(0, interface_stub.disable_interrupt_call);
+}
+
 /**
  * Given an initialized ticker with two ticker event inserted scheduled from more
  * than TIMESTAMP_MAX_DELTA from one another. The interface
@@ -2441,6 +2500,10 @@ static const case_t cases[] = {
         "test_frequencies_and_masks",
         test_over_frequency_and_width<test_frequencies_and_masks>
     ),
+    MAKE_TEST_CASE(
+        "test_irq_handler_coalesce_events_with_tolerance",
+        test_irq_handler_coalesce_events_with_tolerance
+    ),
     MAKE_TEST_CASE(
         "test_ticker_max_value",
         test_ticker_max_value
@@ -0,0 +1,169 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Benchmark of the ticker event queue.
+ *
+ * The queue runs on a stub ticker interface that never raises an interrupt,
+ * so only the cost of ordering events is measured. For each queue size the
+ * test reports the average time to insert an event at a random position and
+ * to remove it again, measured with the microsecond ticker.
+ */
+
+#define __STDC_LIMIT_MACROS
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+
+#include "mbed.h"
+#include "ticker_api.h"
+
+using namespace utest::v1;
+
+#define MAX_EVENTS      256
+#define ITERATIONS      1000
+
+static uint32_t stub_timestamp;
+
+static void stub_init()
+{
+}
+
+static uint32_t stub_read()
+{
+    return stub_timestamp;
+}
+
+static void stub_disable_interrupt()
+{
+}
+
+static void stub_clear_interrupt()
+{
+}
+
+static void stub_set_interrupt(timestamp_t timestamp)
+{
+}
+
+static void stub_fire_interrupt()
+{
+}
+
+static const ticker_info_t *stub_get_info()
+{
+    static const ticker_info_t info = { 1000000, 32 };
+    return &info;
+}
+
+static const ticker_interface_t stub_interface = {
+    stub_init,
+    stub_read,
+    stub_disable_interrupt,
+    stub_clear_interrupt,
+    stub_set_interrupt,
+    stub_fire_interrupt,
+    NULL,
+    stub_get_info
+};
+
+static ticker_event_queue_t stub_queue;
+
+static const ticker_data_t stub_ticker = {
+    &stub_interface,
+    &stub_queue
+};
+
+static ticker_event_t events[MAX_EVENTS + 1];
+
+static void stub_handler(uint32_t id)
+{
+}
+
+static us_timestamp_t random_timestamp()
+{
+    // far enough in the future that no event is ever due
+    return 1000000 + (rand() % 1000000);
+}
+
+template<size_t N>
+static void test_insert_remove()
+{
+    memset(&stub_queue, 0, sizeof(stub_queue));
+    stub_timestamp = 0;
+    ticker_set_handler(&stub_ticker, stub_handler);
+    srand(N);
+
+    for (size_t i = 0; i < N; i++) {
+        ticker_insert_event_us(&stub_ticker, &events[i], random_timestamp(), i);
+    }
+
+    ticker_event_t *e = &events[MAX_EVENTS];
+    uint32_t insert_us = 0;
+    uint32_t remove_us = 0;
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        us_timestamp_t timestamp = random_timestamp();
+
+        uint32_t start = us_ticker_read();
+        ticker_insert_event_us(&stub_ticker, e, timestamp, MAX_EVENTS);
+        uint32_t middle = us_ticker_read();
+        ticker_remove_event(&stub_ticker, e);
+        uint32_t end = us_ticker_read();
+
+        insert_us += middle - start;
+        remove_us += end - middle;
+    }
+
+    utest_printf("%u events: insert %u.%03u us, remove %u.%03u us\r\n", (unsigned) N,
+                 insert_us / ITERATIONS, insert_us % ITERATIONS,
+                 remove_us / ITERATIONS, remove_us % ITERATIONS);
+
+    // the queue must still hold the original events in order
+    size_t count = 0;
+    for (e = stub_queue.head; e != NULL; e = e->next) {
+        if (e->next) {
+            TEST_ASSERT_TRUE(e->timestamp <= e->next->timestamp);
+        }
+        count++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(N, count);
+
+    for (size_t i = 0; i < N; i++) {
+        ticker_remove_event(&stub_ticker, &events[i]);
+    }
+    TEST_ASSERT_NULL(stub_queue.head);
+}
+
+static Case cases[] = {
+    Case("Ticker queue insert/remove with 1 event", test_insert_remove<1>),
+    Case("Ticker queue insert/remove with 16 events", test_insert_remove<16>),
+    Case("Ticker queue insert/remove with 256 events", test_insert_remove<256>)
+};
+
+static utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(60, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+int main()
+{
+    Specification specification(greentea_test_setup, cases);
+    return !Harness::run(specification);
+}
@@ -513,6 +513,50 @@ void test_ftruncate_fstat()
     close(fildes);
 }
 
+static ssize_t async_result;
+static int async_calls;
+
+static void async_done(ssize_t result)
+{
+    async_result = result;
+    async_calls++;
+}
+
+/** Test read_async/write_async default implementation
+ *
+ *  Given a file without native asynchronous I/O
+ *
+ *  When data is written and read back asynchronously
+ *  Then the write and read are done synchronously
+ *       and the callback is called once with their result
+ *       before the functions return
+ *
+ */
+void test_read_write_async()
+{
+    const uint32_t FS = 16;
+    char buff[] = "test";
+    char read_buf[sizeof(buff)] = {0};
+    TestFile<FS> fh;
+
+    async_calls = 0;
+    TestFile<FS>::resetFunctionCallHistory();
+    TEST_ASSERT_EQUAL(0, fh.write_async(buff, sizeof(buff), async_done));
+    TEST_ASSERT_TRUE(TestFile<FS>::functionCalled(TestFile<FS>::fnWrite));
+    TEST_ASSERT_EQUAL(1, async_calls);
+    TEST_ASSERT_EQUAL(sizeof(buff), async_result);
+
+    fh.seek(0, SEEK_SET);
+
+    async_calls = 0;
+    TestFile<FS>::resetFunctionCallHistory();
+    TEST_ASSERT_EQUAL(0, fh.read_async(read_buf, sizeof(read_buf), async_done));
+    TEST_ASSERT_TRUE(TestFile<FS>::functionCalled(TestFile<FS>::fnRead));
+    TEST_ASSERT_EQUAL(1, async_calls);
+    TEST_ASSERT_EQUAL(sizeof(buff), async_result);
+    TEST_ASSERT_EQUAL_STRING(buff, read_buf);
+}
+
 utest::v1::status_t test_setup(const size_t number_of_cases)
 {
     GREENTEA_SETUP(10, "default_auto");
@@ -526,7 +570,8 @@ Case cases[] = {
     Case("Test fputs/fgets", test_fputs_fgets),
     Case("Test fprintf/fscanf", test_fprintf_fscanf),
     Case("Test fseek/ftell", test_fseek_ftell),
-    Case("Test ftruncate/fstat", test_ftruncate_fstat)
+    Case("Test ftruncate/fstat", test_ftruncate_fstat),
+    Case("Test read_async/write_async", test_read_write_async)
 };
 
 utest::v1::Specification specification(test_setup, cases);
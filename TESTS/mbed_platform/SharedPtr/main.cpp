@@ -108,6 +108,35 @@ void test_equality_comparators()
     TEST_ASSERT_TRUE(s_ptr1_1 != s_ptr2); // Shared pointer / Shared pointer
 }
 
+/**
+ * Test that an object created by make_shared is shared and released like
+ * one given to a shared pointer
+ */
+void test_make_shared()
+{
+    // Sanity-check value of counter
+    TEST_ASSERT_EQUAL(0, TestStruct::s_count);
+
+    SharedPtr<TestStruct> s_ptr1;
+    {
+        SharedPtr<TestStruct> s_ptr2 = mbed::make_shared<TestStruct>();
+        TEST_ASSERT_EQUAL(1, TestStruct::s_count);
+        TEST_ASSERT_EQUAL(42, s_ptr2->value);
+        TEST_ASSERT_EQUAL(1, s_ptr2.use_count());
+
+        s_ptr1 = s_ptr2;
+        TEST_ASSERT_EQUAL(2, s_ptr1.use_count());
+    }
+
+    TEST_ASSERT_EQUAL(1, TestStruct::s_count);
+    TEST_ASSERT_EQUAL(1, s_ptr1.use_count());
+
+    s_ptr1 = NULL;
+
+    // Destroy shared pointer
+    TEST_ASSERT_EQUAL(0, TestStruct::s_count);
+}
+
 utest::v1::status_t test_setup(const size_t number_of_cases)
 {
     GREENTEA_SETUP(10, "default_auto");
@@ -117,7 +146,8 @@ utest::v1::status_t test_setup(const size_t number_of_cases)
 Case cases[] = {
     Case("Test single shared pointer instance", test_single_sharedptr_lifetime),
     Case("Test instance sharing across multiple shared pointers", test_instance_sharing),
-    Case("Test equality comparators", test_equality_comparators)
+    Case("Test equality comparators", test_equality_comparators),
+    Case("Test make_shared", test_make_shared)
 };
 
 utest::v1::Specification specification(test_setup, cases);
@@ -0,0 +1,102 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include "mbed.h"
+#include "platform/mbed_app_record.h"
+#include "mbedtls/sha256.h"
+
+#if !MBED_CONF_PLATFORM_APP_RECORD_ENABLED
+#error [NOT_SUPPORTED] test not supported
+#endif
+
+using namespace utest::v1;
+
+// Verify the running image's start, it doesn't change during the test
+#define IMAGE_SIZE  (64 * 1024)
+
+static uint8_t image_hash[MBED_APP_HASH_SIZE];
+
+void test_clear()
+{
+    mbed_app_record_t record;
+
+    TEST_ASSERT_EQUAL(MBED_SUCCESS, mbed_app_record_clear());
+    TEST_ASSERT_EQUAL(MBED_ERROR_ITEM_NOT_FOUND, mbed_app_record_read(&record));
+}
+
+void test_verify_record()
+{
+    mbed_app_record_t record;
+    Timer timer;
+
+    TEST_ASSERT_EQUAL(0, mbedtls_sha256_ret((const unsigned char *)MBED_ROM_START, IMAGE_SIZE, image_hash, 0));
+    TEST_ASSERT_EQUAL(MBED_SUCCESS, mbed_app_record_clear());
+
+    timer.start();
+    TEST_ASSERT_EQUAL(MBED_SUCCESS, mbed_app_verify(MBED_ROM_START, IMAGE_SIZE, 3, image_hash));
+    int full_us = timer.read_us();
+
+    TEST_ASSERT_EQUAL(MBED_SUCCESS, mbed_app_record_read(&record));
+    TEST_ASSERT_EQUAL_HEX32(MBED_ROM_START, record.address);
+    TEST_ASSERT_EQUAL(IMAGE_SIZE, record.size);
+    TEST_ASSERT_EQUAL(3, record.version);
+    TEST_ASSERT_EQUAL_MEMORY(image_hash, record.hash, MBED_APP_HASH_SIZE);
+
+    timer.reset();
+    TEST_ASSERT_EQUAL(MBED_SUCCESS, mbed_app_verify(MBED_ROM_START, IMAGE_SIZE, 3, image_hash));
+    int record_us = timer.read_us();
+    utest_printf("full hash %d us, from record %d us\n", full_us, record_us);
+    TEST_ASSERT(record_us < full_us);
+}
+
+void test_verify_mismatch()
+{
+    mbed_app_record_t record;
+    uint8_t bad_hash[MBED_APP_HASH_SIZE];
+
+    // A different version isn't taken from the record, the image is hashed
+    TEST_ASSERT_EQUAL(MBED_SUCCESS, mbed_app_verify(MBED_ROM_START, IMAGE_SIZE, 4, image_hash));
+    TEST_ASSERT_EQUAL(MBED_SUCCESS, mbed_app_record_read(&record));
+    TEST_ASSERT_EQUAL(4, record.version);
+
+    memcpy(bad_hash, image_hash, sizeof(bad_hash));
+    bad_hash[0] ^= 1;
+    TEST_ASSERT_EQUAL(MBED_ERROR_INVALID_DATA_DETECTED, mbed_app_verify(MBED_ROM_START, IMAGE_SIZE, 4, bad_hash));
+    TEST_ASSERT_EQUAL(MBED_ERROR_ITEM_NOT_FOUND, mbed_app_record_read(&record));
+}
+
+Case cases[] = {
+    Case("Test record clear", test_clear),
+    Case("Test verify and record", test_verify_record),
+    Case("Test verify mismatch", test_verify_mismatch)
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(30, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    Harness::run(specification);
+}
@@ -0,0 +1,90 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include "mbed.h"
+#include "platform/mbed_crash_dump.h"
+
+#if !MBED_CONF_PLATFORM_CRASH_DUMP_ENABLED
+#error [NOT_SUPPORTED] test not supported
+#endif
+
+using namespace utest::v1;
+
+static uint8_t stack[64];
+
+void test_clear()
+{
+    mbed_crash_dump_t dump;
+
+    TEST_ASSERT_EQUAL(MBED_SUCCESS, mbed_crash_dump_clear());
+    TEST_ASSERT_EQUAL(MBED_ERROR_ITEM_NOT_FOUND, mbed_crash_dump_read(&dump, NULL, 0));
+}
+
+void test_write_read()
+{
+    mbed_error_ctx ctx;
+    mbed_crash_dump_t dump;
+    uint32_t thread_stack[16];
+
+    for (uint32_t i = 0; i < 16; i++) {
+        thread_stack[i] = 0xA5000000 | i;
+    }
+
+    // Report the error on a fake stack, the dump captures it from SP up
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.error_status = MBED_ERROR_OUT_OF_MEMORY;
+    ctx.error_value = 0x1234;
+    ctx.thread_stack_mem = (uint32_t)thread_stack;
+    ctx.thread_stack_size = sizeof(thread_stack);
+    ctx.thread_current_sp = (uint32_t)&thread_stack[4];
+
+    mbed_crash_dump_write(&ctx);
+    TEST_ASSERT_EQUAL(MBED_SUCCESS, mbed_crash_dump_read(&dump, stack, sizeof(stack)));
+    TEST_ASSERT_EQUAL_HEX32(MBED_CRASH_DUMP_MAGIC, dump.magic);
+    TEST_ASSERT_EQUAL(MBED_CRASH_DUMP_VERSION, dump.version);
+    TEST_ASSERT_EQUAL(MBED_ERROR_OUT_OF_MEMORY, dump.error_ctx.error_status);
+    TEST_ASSERT_EQUAL(0x1234, dump.error_ctx.error_value);
+    TEST_ASSERT_EQUAL(0, dump.fault_valid);
+    TEST_ASSERT_EQUAL_HEX32((uint32_t)&thread_stack[16], dump.stack_top);
+    TEST_ASSERT_EQUAL_HEX32((uint32_t)&thread_stack[4], dump.stack_addr);
+    TEST_ASSERT_EQUAL(12 * sizeof(uint32_t), dump.stack_len);
+    TEST_ASSERT_EQUAL_MEMORY(&thread_stack[4], stack, dump.stack_len);
+
+    TEST_ASSERT_EQUAL(MBED_SUCCESS, mbed_crash_dump_clear());
+    TEST_ASSERT_EQUAL(MBED_ERROR_ITEM_NOT_FOUND, mbed_crash_dump_read(&dump, NULL, 0));
+}
+
+Case cases[] = {
+    Case("Test crash dump clear", test_clear),
+    Case("Test crash dump write and read", test_write_read)
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    Harness::run(specification);
+}
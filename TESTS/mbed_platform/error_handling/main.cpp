@@ -44,6 +44,31 @@ void test_error_count_and_reset()
 
 }
 
+#if MBED_CONF_PLATFORM_ERROR_RATE_LIMIT
+/** Test warnings over the rate limit of their status are dropped
+ */
+void test_error_rate_limit()
+{
+    mbed_clear_all_errors();
+
+    for (int i = 0; i < MBED_CONF_PLATFORM_ERROR_RATE_LIMIT + 3; i++) {
+        MBED_WARNING1(MBED_ERROR_TIME_OUT, "Timeout error", i);
+    }
+    MBED_WARNING1(MBED_ERROR_NOT_READY, "Not ready error", 0);
+
+    TEST_ASSERT_EQUAL_INT(MBED_CONF_PLATFORM_ERROR_RATE_LIMIT + 1, mbed_get_error_count());
+    TEST_ASSERT_EQUAL_INT(3, mbed_get_error_suppressed_count());
+
+    //a new window records the status again
+    wait_ms(MBED_CONF_PLATFORM_ERROR_RATE_LIMIT_WINDOW_MS);
+    MBED_WARNING1(MBED_ERROR_TIME_OUT, "Timeout error", 0);
+    TEST_ASSERT_EQUAL_INT(MBED_CONF_PLATFORM_ERROR_RATE_LIMIT + 2, mbed_get_error_count());
+
+    mbed_clear_all_errors();
+    TEST_ASSERT_EQUAL_INT(0, mbed_get_error_suppressed_count());
+}
+#endif
+
 /** Test error type encoding and test capturing of system, custom, posix errors
  *  and ensure the status/error code/type/error value is correct
  */
@@ -356,6 +381,9 @@ Case cases[] = {
     Case("Test error context capture", test_error_context_capture),
 #endif //MBED_CONF_RTOS_PRESENT
     Case("Test error hook", test_error_hook),
+#if MBED_CONF_PLATFORM_ERROR_RATE_LIMIT
+    Case("Test error rate limit", test_error_rate_limit),
+#endif
 #if MBED_CONF_PLATFORM_ERROR_HIST_ENABLED
     Case("Test error logging", test_error_logging),
 #if MBED_CONF_RTOS_PRESENT
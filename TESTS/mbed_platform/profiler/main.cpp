@@ -0,0 +1,103 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include "mbed.h"
+#include "platform/mbed_profiler.h"
+
+#if !defined(MBED_PROFILER_ENABLED) || !defined(__CORTEX_M)
+#error [NOT_SUPPORTED] test not supported
+#endif
+
+using namespace utest::v1;
+
+#define SPIN_TIME_US 200000
+
+static volatile uint32_t spin_count;
+
+MBED_NOINLINE static void spin()
+{
+    Timer timer;
+    timer.start();
+    while (timer.read_us() < SPIN_TIME_US) {
+        spin_count++;
+    }
+}
+
+void test_samples()
+{
+    mbed_profiler_reset();
+    TEST_ASSERT_EQUAL(0, mbed_profiler_start(true));
+    spin();
+    mbed_profiler_stop();
+
+    // One sample per ms, with some time lost to interrupts
+    uint32_t total = mbed_profiler_get_total();
+    TEST_ASSERT_UINT32_WITHIN(SPIN_TIME_US / 1000 / 4, SPIN_TIME_US / 1000, total);
+
+    mbed_profiler_sample_t samples[8];
+    size_t count = mbed_profiler_get_each(samples, 8);
+    TEST_ASSERT_TRUE(count > 0);
+    for (size_t i = 1; i < count; i++) {
+        TEST_ASSERT_TRUE(samples[i - 1].count >= samples[i].count);
+    }
+
+#ifdef MBED_CONF_RTOS_PRESENT
+    // The test thread was recorded with the samples
+    uint32_t thread_samples = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (samples[i].thread_id == (uint32_t)ThisThread::get_id()) {
+            thread_samples += samples[i].count;
+        }
+    }
+    TEST_ASSERT_TRUE(thread_samples > 0);
+#endif
+
+    // No more samples once stopped
+    wait_ms(20);
+    TEST_ASSERT_EQUAL(total, mbed_profiler_get_total());
+}
+
+void test_reset()
+{
+    mbed_profiler_sample_t samples[1];
+
+    mbed_profiler_reset();
+    TEST_ASSERT_EQUAL(0, mbed_profiler_get_total());
+    TEST_ASSERT_EQUAL(0, mbed_profiler_get_dropped());
+    TEST_ASSERT_EQUAL(0, mbed_profiler_get_each(samples, 1));
+}
+
+Case cases[] = {
+    Case("Test profiler samples", test_samples),
+    Case("Test profiler reset", test_reset)
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    Harness::run(specification);
+}
@@ -0,0 +1,77 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include "mbed.h"
+
+#if !defined(MBED_BOOT_STATS_ENABLED) || !defined(DWT_CTRL_CYCCNTENA_Msk)
+#error [NOT_SUPPORTED] test not supported
+#endif
+
+using namespace utest::v1;
+
+void test_boot_phases()
+{
+    mbed_stats_boot_t stats;
+    mbed_stats_boot_get(&stats);
+
+    TEST_ASSERT_TRUE(stats.phase_mask & (1 << MBED_BOOT_PHASE_INIT));
+    TEST_ASSERT_TRUE(stats.phase_mask & (1 << MBED_BOOT_PHASE_SDK_INIT));
+    TEST_ASSERT_TRUE(stats.phase_mask & (1 << MBED_BOOT_PHASE_MAIN));
+    TEST_ASSERT_EQUAL(0, stats.phase_time[MBED_BOOT_PHASE_INIT]);
+
+    // phases are reached in order
+    us_timestamp_t last = 0;
+    for (int i = 0; i < MBED_BOOT_PHASE_COUNT; i++) {
+        if (stats.phase_mask & (1 << i)) {
+            TEST_ASSERT_TRUE(stats.phase_time[i] >= last);
+            last = stats.phase_time[i];
+            printf("Boot phase %d reached at %llu us\r\n", i, last);
+        }
+    }
+}
+
+void test_boot_stats_fixed()
+{
+    mbed_stats_boot_t before;
+    mbed_stats_boot_t after;
+
+    mbed_stats_boot_get(&before);
+    wait_us(1000);
+    mbed_stats_boot_get(&after);
+    TEST_ASSERT_EQUAL_MEMORY(&before, &after, sizeof(mbed_stats_boot_t));
+}
+
+Case cases[] = {
+    Case("Test boot phases", test_boot_phases),
+    Case("Test boot stats don't change after boot", test_boot_stats_fixed)
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    Harness::run(specification);
+}
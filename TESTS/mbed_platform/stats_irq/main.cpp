@@ -0,0 +1,88 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include "mbed.h"
+
+#if !defined(MBED_IRQ_STATS_ENABLED) || !defined(__CORTEX_M)
+#error [NOT_SUPPORTED] test not supported
+#endif
+
+using namespace utest::v1;
+
+#define CRITICAL_TIME_US    2000
+
+static void long_critical_section()
+{
+    core_util_critical_section_enter();
+    // nested sections are accounted to the outermost one
+    core_util_critical_section_enter();
+    wait_us(CRITICAL_TIME_US);
+    core_util_critical_section_exit();
+    core_util_critical_section_exit();
+}
+
+void test_critical_section_stats()
+{
+    mbed_stats_irq_t stats;
+
+    long_critical_section();
+    mbed_stats_irq_get(&stats);
+
+    TEST_ASSERT_NOT_EQUAL(0, stats.critical_section_cnt);
+    TEST_ASSERT_TRUE(stats.critical_section_cnt <= MBED_IRQ_STATS_MAX_CRITICAL_SECTIONS);
+
+    // wait_us doesn't sleep, so the section must be one of the longest
+    bool found = false;
+    for (uint32_t i = 0; i < stats.critical_section_cnt; i++) {
+        if (i > 0) {
+            TEST_ASSERT_TRUE(stats.critical_sections[i - 1].time >= stats.critical_sections[i].time);
+        }
+        if (stats.critical_sections[i].time >= CRITICAL_TIME_US) {
+            TEST_ASSERT_NOT_NULL(stats.critical_sections[i].caller);
+            found = true;
+        }
+    }
+    TEST_ASSERT_TRUE(found);
+}
+
+void test_irq_profile_limit()
+{
+    mbed_stats_irq_t stats;
+    mbed_stats_irq_get(&stats);
+    TEST_ASSERT_TRUE(stats.handler_cnt <= MBED_IRQ_STATS_MAX_HANDLERS);
+}
+
+Case cases[] = {
+    Case("Test critical section stats", test_critical_section_stats),
+    Case("Test IRQ handler stats", test_irq_profile_limit)
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    Harness::run(specification);
+}
@@ -0,0 +1,126 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include "mbed.h"
+
+#if !defined(MBED_MUTEX_STATS_ENABLED) || !defined(MBED_CONF_RTOS_PRESENT)
+#error [NOT_SUPPORTED] test not supported
+#endif
+
+using namespace utest::v1;
+
+#define MAX_MUTEX_STATS     32
+#define HOLD_TIME_MS        20
+#define TEST_STACK_SIZE     512
+
+static bool find_stats(const char *name, mbed_stats_mutex_t *found)
+{
+    mbed_stats_mutex_t *stats = new mbed_stats_mutex_t[MAX_MUTEX_STATS];
+    size_t count = mbed_stats_mutex_get_each(stats, MAX_MUTEX_STATS);
+    bool ret = false;
+    for (size_t i = 0; i < count; i++) {
+        if (stats[i].name && strcmp(stats[i].name, name) == 0) {
+            *found = stats[i];
+            ret = true;
+            break;
+        }
+    }
+    delete[] stats;
+    return ret;
+}
+
+void test_uncontended()
+{
+    Mutex mutex("uncontended");
+    mbed_stats_mutex_t stats;
+
+    mutex.lock();
+    mutex.lock();
+    mutex.unlock();
+    mutex.unlock();
+    TEST_ASSERT_TRUE(mutex.trylock());
+    mutex.unlock();
+
+    TEST_ASSERT_TRUE(find_stats("uncontended", &stats));
+    TEST_ASSERT_EQUAL(3, stats.acquire_cnt);
+    TEST_ASSERT_EQUAL(0, stats.contended_cnt);
+    TEST_ASSERT_EQUAL(0, stats.max_wait_time);
+}
+
+static void hold(Mutex *mutex)
+{
+    mutex->lock();
+    ThisThread::sleep_for(HOLD_TIME_MS);
+    mutex->unlock();
+}
+
+void test_contended()
+{
+    Mutex mutex("contended");
+    Thread thread(osPriorityAboveNormal, TEST_STACK_SIZE);
+    mbed_stats_mutex_t stats;
+
+    thread.start(callback(hold, &mutex));
+    mutex.lock();
+    mutex.unlock();
+    thread.join();
+
+    TEST_ASSERT_TRUE(find_stats("contended", &stats));
+    TEST_ASSERT_EQUAL(2, stats.acquire_cnt);
+    TEST_ASSERT_EQUAL(1, stats.contended_cnt);
+    TEST_ASSERT_TRUE(stats.max_wait_time >= (HOLD_TIME_MS - 1) * 1000);
+    TEST_ASSERT_EQUAL(stats.max_wait_time, stats.total_wait_time);
+    TEST_ASSERT_TRUE(stats.max_hold_time >= (HOLD_TIME_MS - 1) * 1000);
+    TEST_ASSERT_EQUAL((uint32_t)thread.get_id(), stats.max_hold_thread_id);
+}
+
+void test_deleted()
+{
+    mbed_stats_mutex_t stats;
+    {
+        Mutex mutex("deleted");
+        TEST_ASSERT_TRUE(find_stats("deleted", &stats));
+    }
+    mbed_stats_mutex_t *all = new mbed_stats_mutex_t[MAX_MUTEX_STATS];
+    size_t count = mbed_stats_mutex_get_each(all, MAX_MUTEX_STATS);
+    for (size_t i = 0; i < count; i++) {
+        TEST_ASSERT_NOT_EQUAL(stats.id, all[i].id);
+    }
+    delete[] all;
+}
+
+Case cases[] = {
+    Case("Test uncontended mutex stats", test_uncontended),
+    Case("Test contended mutex stats", test_contended),
+    Case("Test deleted mutex removed from stats", test_deleted)
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    Harness::run(specification);
+}
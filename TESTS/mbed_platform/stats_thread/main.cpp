@@ -155,11 +155,42 @@ void test_case_multi_threads_terminate()
     delete[] stats;
 }
 
+#define BUSY_TIME_US    100000
+void busy_wait()
+{
+    wait_us(BUSY_TIME_US);
+    ef.wait_all(FLAG_SIGNAL_DEC);
+}
+
+void test_case_thread_cpu_time()
+{
+    mbed_stats_thread_t *stats = new mbed_stats_thread_t[MAX_THREAD_STATS];
+
+    Thread t1(osPriorityNormal1, TEST_STACK_SIZE, NULL, "Th1");
+    t1.start(busy_wait);
+    ThisThread::sleep_for(2 * BUSY_TIME_US / 1000);
+
+    // Read stats while the thread is blocked, its time stays accounted until it terminates
+    int count = mbed_stats_thread_get_each(stats, MAX_THREAD_STATS);
+    for (int i = 0; i < count; i++) {
+        if (0 == strcmp(stats[i].name, "Th1")) {
+            TEST_ASSERT_UINT32_WITHIN(BUSY_TIME_US / 10, BUSY_TIME_US, (uint32_t)stats[i].cpu_time);
+            break;
+        }
+    }
+
+    uint32_t ret = ef.set(FLAG_SIGNAL_DEC);
+    TEST_ASSERT_FALSE(ret & osFlagsError);
+    t1.join();
+    delete[] stats;
+}
+
 Case cases[] = {
     Case("Single Thread Stats", test_case_single_thread_stats),
     Case("Less count value", test_case_less_count),
     Case("Multiple Threads blocked", test_case_multi_threads_blocked),
     Case("Multiple Threads terminate", test_case_multi_threads_terminate),
+    Case("Thread CPU time", test_case_thread_cpu_time),
 };
 
 utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
@@ -0,0 +1,82 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include "mbed.h"
+#include "platform/mbed_swo_trace.h"
+
+#if !defined(MBED_SWO_TRACE_ENABLED) || !DEVICE_ITM
+#error [NOT_SUPPORTED] test not supported
+#endif
+
+using namespace utest::v1;
+
+static volatile int dispatched;
+
+static void count_dispatch()
+{
+    dispatched++;
+}
+
+void test_start_stop()
+{
+    const uint32_t ports = (1UL << MBED_SWO_TRACE_EQUEUE_DISPATCH) | (1UL << MBED_SWO_TRACE_EQUEUE_DISPATCH_END);
+
+    mbed_swo_trace_start(ports);
+    TEST_ASSERT_TRUE(ITM->TCR & ITM_TCR_ITMENA_Msk);
+    TEST_ASSERT_TRUE(ITM->TCR & ITM_TCR_TSENA_Msk);
+    TEST_ASSERT_EQUAL_HEX32(ports, ITM->TER & MBED_SWO_TRACE_ALL);
+
+    mbed_swo_trace_stop(ports);
+    TEST_ASSERT_EQUAL_HEX32(0, ITM->TER & MBED_SWO_TRACE_ALL);
+}
+
+void test_traced_dispatch()
+{
+    EventQueue queue;
+
+    mbed_swo_trace_start(MBED_SWO_TRACE_ALL);
+    dispatched = 0;
+    for (int i = 0; i < 100; i++) {
+        queue.call(count_dispatch);
+    }
+    queue.dispatch(0);
+    MBED_SWO_TRACE(MBED_SWO_TRACE_USER, dispatched);
+    mbed_swo_trace_stop(MBED_SWO_TRACE_ALL);
+
+    TEST_ASSERT_EQUAL(100, dispatched);
+}
+
+Case cases[] = {
+    Case("SWO trace start and stop", test_start_stop),
+    Case("SWO traced event dispatch", test_traced_dispatch)
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    Harness::run(specification);
+}
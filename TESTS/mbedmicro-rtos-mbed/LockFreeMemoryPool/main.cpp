@@ -0,0 +1,208 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+
+#if !defined(MBED_CONF_RTOS_PRESENT)
+#error [NOT_SUPPORTED] LockFreeMemoryPool test cases require RTOS to run.
+#endif
+
+using namespace utest::v1;
+
+#define POOL_SIZE       4
+#define THREAD_STACK_SIZE 512
+#define WAIT_MS         50
+
+typedef struct {
+    int a;
+    char b;
+    int c;
+} COMPLEX_TYPE;
+
+/* Given a LockFreeMemoryPool
+ * When every block is allocated
+ * Then all allocations succeed with distinct blocks and the next one fails
+ */
+void test_alloc_exhaust()
+{
+    LockFreeMemoryPool<COMPLEX_TYPE, POOL_SIZE> mem_pool;
+    COMPLEX_TYPE *blocks[POOL_SIZE];
+
+    for (int i = 0; i < POOL_SIZE; i++) {
+        blocks[i] = mem_pool.calloc();
+        TEST_ASSERT_NOT_NULL(blocks[i]);
+        TEST_ASSERT_EQUAL(0, blocks[i]->a);
+        for (int j = 0; j < i; j++) {
+            TEST_ASSERT_NOT_EQUAL(blocks[j], blocks[i]);
+        }
+        blocks[i]->a = i;
+    }
+
+    TEST_ASSERT_NULL(mem_pool.alloc());
+    TEST_ASSERT_NULL(mem_pool.alloc_for(0));
+
+    for (int i = 0; i < POOL_SIZE; i++) {
+        TEST_ASSERT_EQUAL(i, blocks[i]->a);
+    }
+}
+
+/* Given a LockFreeMemoryPool with every block allocated
+ * When a block is freed
+ * Then the next allocation returns it
+ */
+void test_free_realloc()
+{
+    LockFreeMemoryPool<int, POOL_SIZE> mem_pool;
+    int *blocks[POOL_SIZE];
+
+    for (int i = 0; i < POOL_SIZE; i++) {
+        blocks[i] = mem_pool.alloc();
+        TEST_ASSERT_NOT_NULL(blocks[i]);
+    }
+
+    TEST_ASSERT_EQUAL(osOK, mem_pool.free(blocks[1]));
+    TEST_ASSERT_EQUAL_PTR(blocks[1], mem_pool.alloc());
+    TEST_ASSERT_NULL(mem_pool.alloc());
+
+    for (int i = 0; i < POOL_SIZE; i++) {
+        TEST_ASSERT_EQUAL(osOK, mem_pool.free(blocks[i]));
+    }
+}
+
+/* Given a LockFreeMemoryPool
+ * When free is called with NULL or a pointer that is not a block of the pool
+ * Then it fails with osErrorParameter
+ */
+void test_free_invalid()
+{
+    LockFreeMemoryPool<int, POOL_SIZE> mem_pool;
+    int other;
+
+    int *block = mem_pool.alloc();
+    TEST_ASSERT_NOT_NULL(block);
+
+    TEST_ASSERT_EQUAL(osErrorParameter, mem_pool.free(NULL));
+    TEST_ASSERT_EQUAL(osErrorParameter, mem_pool.free(&other));
+    TEST_ASSERT_EQUAL(osErrorParameter, mem_pool.free((int *)((char *)block + 1)));
+    TEST_ASSERT_EQUAL(osOK, mem_pool.free(block));
+}
+
+static LockFreeMemoryPool<int, POOL_SIZE> isr_pool;
+static int *isr_block;
+
+static void isr_free()
+{
+    isr_pool.free(isr_block);
+}
+
+static void isr_alloc()
+{
+    isr_block = isr_pool.alloc();
+}
+
+/* Given a LockFreeMemoryPool
+ * When blocks are allocated and freed from interrupt context
+ * Then the pool stays consistent
+ */
+void test_isr()
+{
+    Timeout timeout;
+    int *blocks[POOL_SIZE];
+
+    timeout.attach_us(isr_alloc, 1000);
+    ThisThread::sleep_for(WAIT_MS);
+    TEST_ASSERT_NOT_NULL(isr_block);
+
+    for (int i = 0; i < POOL_SIZE - 1; i++) {
+        blocks[i] = isr_pool.alloc();
+        TEST_ASSERT_NOT_NULL(blocks[i]);
+    }
+    TEST_ASSERT_NULL(isr_pool.alloc());
+
+    timeout.attach_us(isr_free, 1000);
+    ThisThread::sleep_for(WAIT_MS);
+    TEST_ASSERT_EQUAL_PTR(isr_block, isr_pool.alloc());
+
+    TEST_ASSERT_EQUAL(osOK, isr_pool.free(isr_block));
+    for (int i = 0; i < POOL_SIZE - 1; i++) {
+        TEST_ASSERT_EQUAL(osOK, isr_pool.free(blocks[i]));
+    }
+}
+
+typedef struct {
+    LockFreeMemoryPool<int, POOL_SIZE> *pool;
+    int *block;
+} delayed_free_t;
+
+static void delayed_free(delayed_free_t *arg)
+{
+    ThisThread::sleep_for(WAIT_MS);
+    arg->pool->free(arg->block);
+}
+
+/* Given a LockFreeMemoryPool with every block allocated
+ * When alloc_for waits and another thread frees a block
+ * Then alloc_for returns that block, and times out when nothing is freed
+ */
+void test_alloc_for()
+{
+    LockFreeMemoryPool<int, POOL_SIZE> mem_pool;
+    Thread thread(osPriorityNormal, THREAD_STACK_SIZE);
+    int *blocks[POOL_SIZE];
+
+    for (int i = 0; i < POOL_SIZE; i++) {
+        blocks[i] = mem_pool.alloc();
+        TEST_ASSERT_NOT_NULL(blocks[i]);
+    }
+
+    Timer timer;
+    timer.start();
+    TEST_ASSERT_NULL(mem_pool.alloc_for(WAIT_MS));
+    TEST_ASSERT_INT_WITHIN(WAIT_MS / 5, WAIT_MS, timer.read_ms());
+
+    delayed_free_t arg = { &mem_pool, blocks[2] };
+    thread.start(callback(delayed_free, &arg));
+    TEST_ASSERT_EQUAL_PTR(blocks[2], mem_pool.alloc_for(osWaitForever));
+    thread.join();
+
+    for (int i = 0; i < POOL_SIZE; i++) {
+        TEST_ASSERT_EQUAL(osOK, mem_pool.free(blocks[i]));
+    }
+}
+
+Case cases[] = {
+    Case("Test: alloc()/calloc() - exhaust the pool", test_alloc_exhaust),
+    Case("Test: free() - re-allocation", test_free_realloc),
+    Case("Test: free() - robust (invalid param)", test_free_invalid),
+    Case("Test: alloc()/free() from ISR", test_isr),
+    Case("Test: alloc_for() - wait for free", test_alloc_for)
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    Harness::run(specification);
+}
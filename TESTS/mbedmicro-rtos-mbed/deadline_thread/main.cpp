@@ -0,0 +1,131 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+#include "rtos.h"
+
+#if defined(MBED_RTOS_SINGLE_THREAD)
+#error [NOT_SUPPORTED] test not supported
+#endif
+
+using namespace utest::v1;
+
+#if defined(__CORTEX_M23) || defined(__CORTEX_M33)
+#define TEST_STACK_SIZE 768
+#else
+#define TEST_STACK_SIZE 512
+#endif
+
+#define TEST_DURATION_MS    500
+
+static void busy_wait_ms(int ms)
+{
+    Timer timer;
+    timer.start();
+    while (timer.read_ms() < ms) {
+    }
+}
+
+static void short_job()
+{
+    busy_wait_ms(2);
+}
+
+static void long_job()
+{
+    busy_wait_ms(15);
+}
+
+/** Test periodic release
+
+    Given a deadline thread with a short job
+    When it runs for a while
+    Then the job is released once per period and meets its deadlines
+ */
+void test_periodic()
+{
+    DeadlineThread thread(10, 5, TEST_STACK_SIZE);
+
+    TEST_ASSERT_EQUAL(osOK, thread.start(short_job));
+    ThisThread::sleep_for(TEST_DURATION_MS);
+    thread.stop();
+
+    TEST_ASSERT_UINT32_WITHIN(2, TEST_DURATION_MS / 10, thread.jobs());
+    TEST_ASSERT_EQUAL(0, thread.deadline_misses());
+    TEST_ASSERT_TRUE(thread.max_response_time() <= 5);
+}
+
+/** Test earliest deadline first
+
+    Given a thread with long jobs and a long deadline, and one with short jobs and a short deadline
+    When both run at the same time
+    Then the short jobs preempt the long ones and meet their deadlines
+ */
+void test_edf()
+{
+    DeadlineThread slow(50, 50, TEST_STACK_SIZE);
+    DeadlineThread fast(10, 5, TEST_STACK_SIZE);
+
+    TEST_ASSERT_EQUAL(osOK, slow.start(long_job));
+    TEST_ASSERT_EQUAL(osOK, fast.start(short_job));
+    ThisThread::sleep_for(TEST_DURATION_MS);
+    fast.stop();
+    slow.stop();
+
+    TEST_ASSERT_EQUAL(0, fast.deadline_misses());
+    TEST_ASSERT_EQUAL(0, slow.deadline_misses());
+    TEST_ASSERT_TRUE(slow.jobs() > 0);
+}
+
+/** Test deadline misses
+
+    Given a deadline thread whose job takes longer than its period
+    When it runs for a while
+    Then the misses, including the skipped releases, are counted
+ */
+void test_misses()
+{
+    DeadlineThread thread(10, 10, TEST_STACK_SIZE);
+
+    TEST_ASSERT_EQUAL(osOK, thread.start(long_job));
+    ThisThread::sleep_for(TEST_DURATION_MS);
+    thread.stop();
+
+    TEST_ASSERT_TRUE(thread.jobs() > 0);
+    TEST_ASSERT_TRUE(thread.deadline_misses() >= 2 * thread.jobs() - 1);
+    TEST_ASSERT_TRUE(thread.max_response_time() >= 15);
+}
+
+Case cases[] = {
+    Case("Test periodic release", test_periodic),
+    Case("Test earliest deadline first", test_edf),
+    Case("Test deadline misses", test_misses)
+};
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
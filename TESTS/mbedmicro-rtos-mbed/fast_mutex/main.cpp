@@ -0,0 +1,193 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+#include "rtos.h"
+
+#if defined(MBED_RTOS_SINGLE_THREAD)
+#error [NOT_SUPPORTED] test not supported
+#endif
+
+using namespace utest::v1;
+
+#if defined(__CORTEX_M23) || defined(__CORTEX_M33)
+#define TEST_STACK_SIZE 768
+#else
+#define TEST_STACK_SIZE 512
+#endif
+
+#define TEST_DELAY          10
+#define TEST_ITERATIONS     1000
+#define TEST_THREADS        3
+
+/** Test recursive locking
+
+    Given a FastMutex
+    When it is locked several times by the same thread
+    Then it stays owned by the thread until it is unlocked as many times
+ */
+void test_recursive()
+{
+    FastMutex mutex;
+
+    TEST_ASSERT_NULL(mutex.get_owner());
+    mutex.lock();
+    TEST_ASSERT_TRUE(mutex.trylock());
+    mutex.lock();
+    TEST_ASSERT_EQUAL(ThisThread::get_id(), mutex.get_owner());
+    mutex.unlock();
+    mutex.unlock();
+    TEST_ASSERT_EQUAL(ThisThread::get_id(), mutex.get_owner());
+    mutex.unlock();
+    TEST_ASSERT_NULL(mutex.get_owner());
+}
+
+static void hold(FastMutex *mutex)
+{
+    mutex->lock();
+    ThisThread::sleep_for(TEST_DELAY);
+    mutex->unlock();
+}
+
+/** Test timed locking
+
+    Given a FastMutex held by another thread
+    When it is locked with a timeout
+    Then the lock fails before the mutex is released, and succeeds after
+ */
+void test_trylock_for()
+{
+    FastMutex mutex;
+    Thread thread(osPriorityAboveNormal, TEST_STACK_SIZE);
+
+    thread.start(callback(hold, &mutex));
+    TEST_ASSERT_FALSE(mutex.trylock());
+    TEST_ASSERT_FALSE(mutex.trylock_for(1));
+    TEST_ASSERT_TRUE(mutex.trylock_for(TEST_DELAY * 2));
+    mutex.unlock();
+    thread.join();
+}
+
+static FastMutex counter_mutex;
+static uint32_t counter;
+
+static void increment()
+{
+    for (int i = 0; i < TEST_ITERATIONS; i++) {
+        counter_mutex.lock();
+        uint32_t value = counter;
+        if ((i % 100) == 0) {
+            ThisThread::yield();
+        }
+        counter = value + 1;
+        counter_mutex.unlock();
+    }
+}
+
+/** Test mutual exclusion
+
+    Given threads incrementing a counter protected by a FastMutex, and yielding while holding it
+    When they have all finished
+    Then no increment has been lost
+ */
+void test_contention()
+{
+    Thread *threads[TEST_THREADS];
+
+    counter = 0;
+    for (int i = 0; i < TEST_THREADS; i++) {
+        threads[i] = new Thread(osPriorityNormal, TEST_STACK_SIZE);
+        threads[i]->start(increment);
+    }
+    for (int i = 0; i < TEST_THREADS; i++) {
+        threads[i]->join();
+        delete threads[i];
+    }
+    TEST_ASSERT_EQUAL(TEST_THREADS * TEST_ITERATIONS, counter);
+    TEST_ASSERT_NULL(counter_mutex.get_owner());
+}
+
+static volatile bool low_locked;
+
+static void low_priority(FastMutex *mutex)
+{
+    mutex->lock();
+    low_locked = true;
+    // Busy wait, so only the inherited priority lets this finish while
+    // the medium priority thread is running
+    while (low_locked) {
+    }
+    mutex->unlock();
+}
+
+static void medium_priority(volatile bool *running)
+{
+    while (*running) {
+    }
+}
+
+/** Test priority inheritance
+
+    Given a low priority thread holding a FastMutex and a medium priority thread spinning
+    When a high priority thread waits for the mutex
+    Then the low priority thread is raised above the medium one, and back when it releases the mutex
+ */
+void test_priority_inheritance()
+{
+    FastMutex mutex;
+    Thread low(osPriorityLow, TEST_STACK_SIZE);
+    Thread medium(osPriorityBelowNormal, TEST_STACK_SIZE);
+    volatile bool running = true;
+
+    low_locked = false;
+    low.start(callback(low_priority, &mutex));
+    while (!low_locked) {
+        ThisThread::sleep_for(1);
+    }
+    medium.start(callback(medium_priority, &running));
+
+    // The main thread runs at osPriorityNormal, above both
+    low_locked = false;
+    mutex.lock();
+    TEST_ASSERT_EQUAL(osPriorityLow, low.get_priority());
+    mutex.unlock();
+
+    running = false;
+    medium.join();
+    low.join();
+}
+
+Case cases[] = {
+    Case("Test recursive lock", test_recursive),
+    Case("Test timed lock", test_trylock_for),
+    Case("Test mutual exclusion", test_contention),
+    Case("Test priority inheritance", test_priority_inheritance)
+};
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
@@ -0,0 +1,110 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+#include "rtos.h"
+
+#if !DEVICE_USTICKER
+#error [NOT_SUPPORTED] test not supported
+#endif
+
+using namespace utest::v1;
+
+#if defined(__CORTEX_M23) || defined(__CORTEX_M33)
+#define TEST_STACK_SIZE 768
+#else
+#define TEST_STACK_SIZE 512
+#endif
+
+#define TEST_PERIOD_US      250
+#define TEST_PERIODS        400
+// Wake-up latency: ticker interrupt and context switch
+#define TEST_TOLERANCE_US   100
+
+/** Test sub-millisecond sleep
+
+    Given a sleep shorter than a kernel tick
+    When the thread sleeps
+    Then it wakes up after the requested time, not rounded to a tick
+ */
+void test_sleep_for_us()
+{
+    const ticker_data_t *ticker = get_us_ticker_data();
+
+    for (uint32_t us = 100; us <= 1500; us += 350) {
+        us_timestamp_t start = ticker_read_us(ticker);
+        ThisThread::sleep_for_us(us);
+        us_timestamp_t elapsed = ticker_read_us(ticker) - start;
+        TEST_ASSERT_TRUE(elapsed >= us);
+        TEST_ASSERT_UINT64_WITHIN(TEST_TOLERANCE_US, us, elapsed);
+    }
+}
+
+static volatile uint32_t spins;
+
+static void spin()
+{
+    while (true) {
+        spins++;
+    }
+}
+
+/** Test periodic sleep
+
+    Given a 4 kHz loop sleeping until absolute times, and a lower priority thread
+    When the loop runs
+    Then it doesn't drift, and the other thread runs while it sleeps
+ */
+void test_sleep_until_us()
+{
+    const ticker_data_t *ticker = get_us_ticker_data();
+    Thread thread(osPriorityBelowNormal, TEST_STACK_SIZE);
+
+    spins = 0;
+    thread.start(spin);
+
+    us_timestamp_t start = ticker_read_us(ticker);
+    us_timestamp_t next = start;
+    for (int i = 0; i < TEST_PERIODS; i++) {
+        next += TEST_PERIOD_US;
+        ThisThread::sleep_until_us(next);
+    }
+    us_timestamp_t elapsed = ticker_read_us(ticker) - start;
+
+    thread.terminate();
+    TEST_ASSERT_UINT64_WITHIN(TEST_TOLERANCE_US, TEST_PERIOD_US * TEST_PERIODS, elapsed);
+    TEST_ASSERT_NOT_EQUAL(0, spins);
+}
+
+Case cases[] = {
+    Case("Test sleep_for_us", test_sleep_for_us),
+    Case("Test sleep_until_us", test_sleep_until_us)
+};
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
@@ -0,0 +1,150 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+#include "rtos.h"
+
+#if defined(MBED_RTOS_SINGLE_THREAD)
+#error [NOT_SUPPORTED] test not supported
+#endif
+
+using namespace utest::v1;
+
+#if defined(__CORTEX_M23) || defined(__CORTEX_M33)
+#define TEST_STACK_SIZE 768
+#else
+#define TEST_STACK_SIZE 512
+#endif
+
+#define TEST_DELAY 10
+
+static Semaphore sem;
+static EventFlags flags;
+static Queue<uint32_t, 4> queue;
+static uint32_t message = 42;
+static Waitable *const objects[] = { &sem, &flags, &queue };
+
+/** Test wait_any timeout
+
+    Given objects which are not ready
+    When wait_any is called with a timeout
+    Then it returns -1 after the timeout
+ */
+void test_timeout()
+{
+    Timer timer;
+    timer.start();
+    TEST_ASSERT_EQUAL(-1, wait_any(objects, 3, TEST_DELAY));
+    timer.stop();
+    TEST_ASSERT_UINT32_WITHIN(1000, TEST_DELAY * 1000, timer.read_us());
+    TEST_ASSERT_EQUAL(-1, wait_any(objects, 3, 0));
+}
+
+/** Test wait_any with a ready object
+
+    Given one object which is already ready
+    When wait_any is called
+    Then it returns its index immediately, without consuming it
+ */
+void test_already_ready()
+{
+    queue.put(&message);
+    TEST_ASSERT_EQUAL(2, wait_any(objects, 3, 0));
+    osEvent evt = queue.get(0);
+    TEST_ASSERT_EQUAL(osEventMessage, evt.status);
+    TEST_ASSERT_EQUAL_PTR(&message, evt.value.p);
+}
+
+static void release_sem()
+{
+    ThisThread::sleep_for(TEST_DELAY);
+    sem.release();
+}
+
+static void set_flags()
+{
+    ThisThread::sleep_for(TEST_DELAY);
+    flags.set(0x4);
+}
+
+static void put_message()
+{
+    ThisThread::sleep_for(TEST_DELAY);
+    queue.put(&message);
+}
+
+/** Test wait_any wake up
+
+    Given a thread making one of the objects ready later
+    When wait_any is called
+    Then it returns the index of that object
+ */
+template <void (*F)(), int index>
+void test_wake_up()
+{
+    Thread thread(osPriorityNormal, TEST_STACK_SIZE);
+    thread.start(F);
+    TEST_ASSERT_EQUAL(index, wait_any(objects, 3));
+    thread.join();
+
+    sem.wait(0);
+    flags.clear();
+    queue.get(0);
+}
+
+static Timeout timeout;
+
+static void release_sem_isr()
+{
+    sem.release();
+}
+
+/** Test wait_any wake up from an interrupt
+
+    Given a timeout releasing a semaphore
+    When wait_any is called
+    Then it returns the index of the semaphore
+ */
+void test_wake_up_isr()
+{
+    timeout.attach_us(release_sem_isr, TEST_DELAY * 1000);
+    TEST_ASSERT_EQUAL(0, wait_any(objects, 3));
+    TEST_ASSERT_EQUAL(1, sem.wait(0));
+}
+
+Case cases[] = {
+    Case("Test timeout", test_timeout),
+    Case("Test object already ready", test_already_ready),
+    Case("Test wake up by Semaphore", test_wake_up<release_sem, 0>),
+    Case("Test wake up by EventFlags", test_wake_up<set_flags, 1>),
+    Case("Test wake up by Queue", test_wake_up<put_message, 2>),
+    Case("Test wake up from ISR", test_wake_up_isr)
+};
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
@@ -0,0 +1,275 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Throughput of the symmetric primitives used by Mbed OS: AES-CCM and
+ * AES-GCM (TLS, LoRaWAN), AES-CMAC (SecureStore) and SHA-256 (DeviceKey).
+ * The ALT implementations compiled in are listed first, build with and
+ * without them to compare. When the target has a crypto engine, the
+ * operations it runs are also measured through crypto_accel.h.
+ *
+ * ECDSA and ECDH are measured by TESTS/mbedtls/ecp_benchmark.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+
+using namespace utest::v1;
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if !defined(MBEDTLS_AES_C) || !defined(MBEDTLS_SHA256_C)
+#error [NOT_SUPPORTED] AES or SHA-256 not enabled
+#else
+
+#include "mbedtls/aes.h"
+#include "mbedtls/ccm.h"
+#include "mbedtls/gcm.h"
+#include "mbedtls/cmac.h"
+#include "mbedtls/sha256.h"
+#include "crypto_accel.h"
+
+#if defined(MBEDTLS_PLATFORM_C)
+#include "mbedtls/platform.h"
+#endif
+
+/* Size of each message and number of messages per measurement */
+#define BENCHMARK_MESSAGE_SIZE 1024
+#define BENCHMARK_MESSAGES     64
+
+static unsigned char input[BENCHMARK_MESSAGE_SIZE];
+static unsigned char output[BENCHMARK_MESSAGE_SIZE];
+static const unsigned char key[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+                                       0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+                                     };
+static const unsigned char iv[12] = { 0 };
+static unsigned char tag[32];
+
+static void report(const char *name, const Timer &timer)
+{
+    uint64_t us = timer.read_high_resolution_us();
+    uint64_t bytes = (uint64_t) BENCHMARK_MESSAGES * BENCHMARK_MESSAGE_SIZE;
+    uint64_t cycles = (uint64_t) SystemCoreClock * us / 1000000;
+    uint32_t cycles_per_byte_x100 = (uint32_t)(100 * cycles / bytes);
+    uint32_t messages_per_second = (uint32_t)((uint64_t) BENCHMARK_MESSAGES * 1000000 / us);
+    uint32_t kib_per_second = (uint32_t)(bytes * 1000000 / 1024 / us);
+
+    utest_printf("%s: %lu.%02lu cycles/byte, %lu KiB/s, %lu messages/s of %d bytes\n", name,
+                 (unsigned long)(cycles_per_byte_x100 / 100), (unsigned long)(cycles_per_byte_x100 % 100),
+                 (unsigned long) kib_per_second, (unsigned long) messages_per_second,
+                 BENCHMARK_MESSAGE_SIZE);
+}
+
+#define REPORT_ALT(alt, defined) utest_printf("  %-32s %s\n", alt, defined ? "on" : "off")
+
+static void test_report_alt()
+{
+    utest_printf("Core clock %lu Hz, ALT implementations:\n", (unsigned long) SystemCoreClock);
+#if defined(MBEDTLS_AES_ALT)
+    REPORT_ALT("MBEDTLS_AES_ALT", 1);
+#else
+    REPORT_ALT("MBEDTLS_AES_ALT", 0);
+#endif
+#if defined(MBEDTLS_CCM_ALT)
+    REPORT_ALT("MBEDTLS_CCM_ALT", 1);
+#else
+    REPORT_ALT("MBEDTLS_CCM_ALT", 0);
+#endif
+#if defined(MBEDTLS_GCM_ALT)
+    REPORT_ALT("MBEDTLS_GCM_ALT", 1);
+#else
+    REPORT_ALT("MBEDTLS_GCM_ALT", 0);
+#endif
+#if defined(MBEDTLS_CMAC_ALT)
+    REPORT_ALT("MBEDTLS_CMAC_ALT", 1);
+#else
+    REPORT_ALT("MBEDTLS_CMAC_ALT", 0);
+#endif
+#if defined(MBEDTLS_SHA256_ALT)
+    REPORT_ALT("MBEDTLS_SHA256_ALT", 1);
+#else
+    REPORT_ALT("MBEDTLS_SHA256_ALT", 0);
+#endif
+#if defined(MBEDTLS_SHA256_PROCESS_ALT)
+    REPORT_ALT("MBEDTLS_SHA256_PROCESS_ALT", 1);
+#else
+    REPORT_ALT("MBEDTLS_SHA256_PROCESS_ALT", 0);
+#endif
+
+    const mbed_crypto_accel_driver_t *driver = mbed_crypto_accel_get_driver();
+    utest_printf("Crypto engine: %s\n", driver ? "present" : "none");
+}
+
+#if defined(MBEDTLS_CCM_C)
+static void test_aes_ccm()
+{
+    mbedtls_ccm_context ctx;
+    Timer timer;
+
+    mbedtls_ccm_init(&ctx);
+    TEST_ASSERT_EQUAL(0, mbedtls_ccm_setkey(&ctx, MBEDTLS_CIPHER_ID_AES, key, 128));
+
+    timer.start();
+    for (int i = 0; i < BENCHMARK_MESSAGES; i++) {
+        TEST_ASSERT_EQUAL(0, mbedtls_ccm_encrypt_and_tag(&ctx, sizeof(input), iv, 12, NULL, 0,
+                                                         input, output, tag, 16));
+    }
+    timer.stop();
+    report("AES-128-CCM encrypt", timer);
+
+    mbedtls_ccm_free(&ctx);
+}
+#endif
+
+#if defined(MBEDTLS_GCM_C)
+static void test_aes_gcm()
+{
+    mbedtls_gcm_context ctx;
+    Timer timer;
+
+    mbedtls_gcm_init(&ctx);
+    TEST_ASSERT_EQUAL(0, mbedtls_gcm_setkey(&ctx, MBEDTLS_CIPHER_ID_AES, key, 128));
+
+    timer.start();
+    for (int i = 0; i < BENCHMARK_MESSAGES; i++) {
+        TEST_ASSERT_EQUAL(0, mbedtls_gcm_crypt_and_tag(&ctx, MBEDTLS_GCM_ENCRYPT, sizeof(input), iv, 12,
+                                                       NULL, 0, input, output, 16, tag));
+    }
+    timer.stop();
+    report("AES-128-GCM encrypt", timer);
+
+    mbedtls_gcm_free(&ctx);
+}
+#endif
+
+#if defined(MBEDTLS_CMAC_C)
+static void test_aes_cmac()
+{
+    const mbedtls_cipher_info_t *info = mbedtls_cipher_info_from_type(MBEDTLS_CIPHER_AES_128_ECB);
+    Timer timer;
+
+    timer.start();
+    for (int i = 0; i < BENCHMARK_MESSAGES; i++) {
+        TEST_ASSERT_EQUAL(0, mbedtls_cipher_cmac(info, key, 128, input, sizeof(input), tag));
+    }
+    timer.stop();
+    report("AES-128-CMAC", timer);
+}
+#endif
+
+static void test_sha256()
+{
+    Timer timer;
+
+    timer.start();
+    for (int i = 0; i < BENCHMARK_MESSAGES; i++) {
+        TEST_ASSERT_EQUAL(0, mbedtls_sha256_ret(input, sizeof(input), tag, 0));
+    }
+    timer.stop();
+    report("SHA-256", timer);
+}
+
+/* The same operations through the crypto engine, for those it runs */
+static void test_crypto_engine()
+{
+    static const struct {
+        mbed_crypto_accel_op_t op;
+        const char *name;
+    } ops[] = {
+        { MBED_CRYPTO_ACCEL_AES_GCM_ENCRYPT, "Engine AES-128-GCM encrypt" },
+        { MBED_CRYPTO_ACCEL_AES_CMAC, "Engine AES-128-CMAC" },
+        { MBED_CRYPTO_ACCEL_SHA256, "Engine SHA-256" },
+    };
+
+    const mbed_crypto_accel_driver_t *driver = mbed_crypto_accel_get_driver();
+    if (!driver) {
+        TEST_IGNORE_MESSAGE("No crypto engine");
+        return;
+    }
+
+    for (size_t i = 0; i < sizeof(ops) / sizeof(ops[0]); i++) {
+        if (!(driver->ops & MBED_CRYPTO_ACCEL_OP_BIT(ops[i].op))) {
+            utest_printf("%s: not supported\n", ops[i].name);
+            continue;
+        }
+
+        Timer timer;
+        timer.start();
+        for (int j = 0; j < BENCHMARK_MESSAGES; j++) {
+            mbed_crypto_accel_job_t job;
+            memset(&job, 0, sizeof(job));
+            job.op = ops[i].op;
+            job.key = key;
+            job.key_bits = 128;
+            job.iv = iv;
+            job.iv_len = sizeof(iv);
+            job.input = input;
+            job.length = sizeof(input);
+            job.output = output;
+            job.tag = tag;
+            job.tag_len = ops[i].op == MBED_CRYPTO_ACCEL_SHA256 ? 32 : 16;
+            TEST_ASSERT_EQUAL(0, mbed_crypto_accel_run(&job));
+        }
+        timer.stop();
+        report(ops[i].name, timer);
+    }
+}
+
+Case cases[] = {
+    Case("ALT configuration", test_report_alt),
+#if defined(MBEDTLS_CCM_C)
+    Case("AES-CCM", test_aes_ccm),
+#endif
+#if defined(MBEDTLS_GCM_C)
+    Case("AES-GCM", test_aes_gcm),
+#endif
+#if defined(MBEDTLS_CMAC_C)
+    Case("AES-CMAC", test_aes_cmac),
+#endif
+    Case("SHA-256", test_sha256),
+    Case("Crypto engine", test_crypto_engine),
+};
+
+utest::v1::status_t test_setup(const size_t num_cases)
+{
+    GREENTEA_SETUP(120, "default_auto");
+    return verbose_test_setup_handler(num_cases);
+}
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    int ret = 0;
+#if defined(MBEDTLS_PLATFORM_C)
+    if ((ret = mbedtls_platform_setup(NULL)) != 0) {
+        mbedtls_printf("Mbed TLS benchmark failed! mbedtls_platform_setup returned %d\n", ret);
+        return 1;
+    }
+#endif
+
+    ret = (Harness::run(specification) ? 0 : 1);
+#if defined(MBEDTLS_PLATFORM_C)
+    mbedtls_platform_teardown(NULL);
+#endif
+    return ret;
+}
+
+#endif
@@ -0,0 +1,185 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+
+using namespace utest::v1;
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#if !defined(MBEDTLS_ECDSA_C) || !defined(MBEDTLS_ECDH_C) || !defined(MBEDTLS_ECP_DP_SECP256R1_ENABLED)
+#error [NOT_SUPPORTED] ECDSA, ECDH or secp256r1 not enabled
+#else
+
+#include "mbedtls/ecdsa.h"
+#include "mbedtls/ecdh.h"
+
+#if defined(MBEDTLS_PLATFORM_C)
+#include "mbedtls/platform.h"
+#endif
+
+/* Each benchmark runs this many operations, a few seconds on slow cores */
+#define BENCHMARK_OPERATIONS 10
+
+/* Deterministic, so that runs are comparable. Not for any real use. */
+static int test_rng(void *ctx, unsigned char *output, size_t len)
+{
+    static uint32_t state = 0x12345678;
+    while (len--) {
+        state = state * 1103515245 + 12345;
+        *output++ = state >> 16;
+    }
+    return 0;
+}
+
+static void report(const char *name, const Timer &timer)
+{
+    int us = timer.read_us();
+    int per_second_x100 = (int)(100ULL * BENCHMARK_OPERATIONS * 1000000 / us);
+    utest_printf("%s: %d operations in %d ms, %d.%02d per second\n", name,
+                 BENCHMARK_OPERATIONS, us / 1000, per_second_x100 / 100, per_second_x100 % 100);
+}
+
+/* Every operation loads its own group like a TLS handshake does, so the
+ * cost of precomputation for the base point is included */
+static void test_ecdsa_sign()
+{
+    const unsigned char hash[32] = { 0 };
+    mbedtls_ecdsa_context key;
+    mbedtls_mpi r, s;
+    Timer timer;
+
+    mbedtls_ecdsa_init(&key);
+    mbedtls_mpi_init(&r);
+    mbedtls_mpi_init(&s);
+    TEST_ASSERT_EQUAL(0, mbedtls_ecdsa_genkey(&key, MBEDTLS_ECP_DP_SECP256R1, test_rng, NULL));
+
+    timer.start();
+    for (int i = 0; i < BENCHMARK_OPERATIONS; i++) {
+        mbedtls_ecp_group grp;
+        mbedtls_ecp_group_init(&grp);
+        TEST_ASSERT_EQUAL(0, mbedtls_ecp_group_load(&grp, MBEDTLS_ECP_DP_SECP256R1));
+        TEST_ASSERT_EQUAL(0, mbedtls_ecdsa_sign(&grp, &r, &s, &key.d, hash, sizeof(hash), test_rng, NULL));
+        mbedtls_ecp_group_free(&grp);
+    }
+    timer.stop();
+    report("ECDSA secp256r1 sign", timer);
+
+    mbedtls_mpi_free(&r);
+    mbedtls_mpi_free(&s);
+    mbedtls_ecdsa_free(&key);
+}
+
+static void test_ecdsa_verify()
+{
+    const unsigned char hash[32] = { 0 };
+    mbedtls_ecdsa_context key;
+    mbedtls_mpi r, s;
+    Timer timer;
+
+    mbedtls_ecdsa_init(&key);
+    mbedtls_mpi_init(&r);
+    mbedtls_mpi_init(&s);
+    TEST_ASSERT_EQUAL(0, mbedtls_ecdsa_genkey(&key, MBEDTLS_ECP_DP_SECP256R1, test_rng, NULL));
+    TEST_ASSERT_EQUAL(0, mbedtls_ecdsa_sign(&key.grp, &r, &s, &key.d, hash, sizeof(hash), test_rng, NULL));
+
+    timer.start();
+    for (int i = 0; i < BENCHMARK_OPERATIONS; i++) {
+        mbedtls_ecp_group grp;
+        mbedtls_ecp_group_init(&grp);
+        TEST_ASSERT_EQUAL(0, mbedtls_ecp_group_load(&grp, MBEDTLS_ECP_DP_SECP256R1));
+        TEST_ASSERT_EQUAL(0, mbedtls_ecdsa_verify(&grp, hash, sizeof(hash), &key.Q, &r, &s));
+        mbedtls_ecp_group_free(&grp);
+    }
+    timer.stop();
+    report("ECDSA secp256r1 verify", timer);
+
+    mbedtls_mpi_free(&r);
+    mbedtls_mpi_free(&s);
+    mbedtls_ecdsa_free(&key);
+}
+
+static void test_ecdh()
+{
+    mbedtls_ecdh_context peer;
+    Timer timer;
+
+    mbedtls_ecdh_init(&peer);
+    TEST_ASSERT_EQUAL(0, mbedtls_ecp_group_load(&peer.grp, MBEDTLS_ECP_DP_SECP256R1));
+    TEST_ASSERT_EQUAL(0, mbedtls_ecdh_gen_public(&peer.grp, &peer.d, &peer.Q, test_rng, NULL));
+
+    /* An ephemeral key pair and the shared secret, as in ECDHE */
+    timer.start();
+    for (int i = 0; i < BENCHMARK_OPERATIONS; i++) {
+        mbedtls_ecp_group grp;
+        mbedtls_mpi d, z;
+        mbedtls_ecp_point Q;
+        mbedtls_ecp_group_init(&grp);
+        mbedtls_mpi_init(&d);
+        mbedtls_mpi_init(&z);
+        mbedtls_ecp_point_init(&Q);
+        TEST_ASSERT_EQUAL(0, mbedtls_ecp_group_load(&grp, MBEDTLS_ECP_DP_SECP256R1));
+        TEST_ASSERT_EQUAL(0, mbedtls_ecdh_gen_public(&grp, &d, &Q, test_rng, NULL));
+        TEST_ASSERT_EQUAL(0, mbedtls_ecdh_compute_shared(&grp, &z, &peer.Q, &d, test_rng, NULL));
+        mbedtls_ecp_point_free(&Q);
+        mbedtls_mpi_free(&z);
+        mbedtls_mpi_free(&d);
+        mbedtls_ecp_group_free(&grp);
+    }
+    timer.stop();
+    report("ECDHE secp256r1", timer);
+
+    mbedtls_ecdh_free(&peer);
+}
+
+Case cases[] = {
+    Case("ECDSA sign", test_ecdsa_sign),
+    Case("ECDSA verify", test_ecdsa_verify),
+    Case("ECDH", test_ecdh),
+};
+
+utest::v1::status_t test_setup(const size_t num_cases)
+{
+    GREENTEA_SETUP(300, "default_auto");
+    return verbose_test_setup_handler(num_cases);
+}
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    int ret = 0;
+#if defined(MBEDTLS_PLATFORM_C)
+    if ((ret = mbedtls_platform_setup(NULL)) != 0) {
+        mbedtls_printf("Mbed TLS benchmark failed! mbedtls_platform_setup returned %d\n", ret);
+        return 1;
+    }
+#endif
+
+    ret = (Harness::run(specification) ? 0 : 1);
+#if defined(MBEDTLS_PLATFORM_C)
+    mbedtls_platform_teardown(NULL);
+#endif
+    return ret;
+}
+
+#endif
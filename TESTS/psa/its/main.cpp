@@ -20,6 +20,7 @@
 #error [NOT_SUPPORTED] ITS tests can run only on PSA-enabled targets.
 #endif // TARGET_PSA
 
+#include "mbed.h"
 #include "greentea-client/test_env.h"
 #include "unity/unity.h"
 #include "utest/utest.h"
@@ -29,6 +30,7 @@
 using namespace utest::v1;
 
 #define TEST_BUFF_SIZE 16
+#define BENCHMARK_ITERATIONS 100
 
 static void pits_test()
 {
@@ -109,6 +111,108 @@ static void pits_write_once_test()
     TEST_ASSERT_EQUAL(PSA_ITS_FLAG_WRITE_ONCE, info.flags);
 }
 
+static void pits_get_multiple_test()
+{
+    psa_its_status_t status = PSA_ITS_SUCCESS;
+    uint8_t write_buff[TEST_BUFF_SIZE] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F};
+    uint8_t read_buff[3 * TEST_BUFF_SIZE] = {0};
+    uint8_t zero_buff[TEST_BUFF_SIZE] = {0};
+    const psa_its_uid_t uids[3] = {5, 6, 7};
+    const uint32_t lengths[3] = {TEST_BUFF_SIZE, TEST_BUFF_SIZE, TEST_BUFF_SIZE / 2};
+    psa_its_status_t item_status[3];
+
+    status = psa_its_set(5, TEST_BUFF_SIZE, write_buff, 0);
+    TEST_ASSERT_EQUAL(PSA_ITS_SUCCESS, status);
+
+    status = psa_its_set(7, TEST_BUFF_SIZE, write_buff, 0);
+    TEST_ASSERT_EQUAL(PSA_ITS_SUCCESS, status);
+
+    memset(read_buff, 0xFF, sizeof(read_buff));
+    status = psa_its_get_multiple(3, uids, lengths, read_buff, item_status);
+    TEST_ASSERT_EQUAL(PSA_ITS_ERROR_UID_NOT_FOUND, status);
+    TEST_ASSERT_EQUAL(PSA_ITS_SUCCESS, item_status[0]);
+    TEST_ASSERT_EQUAL(PSA_ITS_ERROR_UID_NOT_FOUND, item_status[1]);
+    TEST_ASSERT_EQUAL(PSA_ITS_SUCCESS, item_status[2]);
+    TEST_ASSERT_EQUAL_MEMORY(write_buff, read_buff, TEST_BUFF_SIZE);
+    TEST_ASSERT_EQUAL_MEMORY(zero_buff, read_buff + TEST_BUFF_SIZE, TEST_BUFF_SIZE);
+    TEST_ASSERT_EQUAL_MEMORY(write_buff, read_buff + 2 * TEST_BUFF_SIZE, TEST_BUFF_SIZE / 2);
+
+    status = psa_its_set(6, TEST_BUFF_SIZE, write_buff, 0);
+    TEST_ASSERT_EQUAL(PSA_ITS_SUCCESS, status);
+
+    status = psa_its_get_multiple(3, uids, lengths, read_buff, item_status);
+    TEST_ASSERT_EQUAL(PSA_ITS_SUCCESS, status);
+    TEST_ASSERT_EQUAL_MEMORY(write_buff, read_buff + TEST_BUFF_SIZE, TEST_BUFF_SIZE);
+
+    status = psa_its_get_multiple(0, uids, lengths, read_buff, item_status);
+    TEST_ASSERT_EQUAL(PSA_ITS_ERROR_INVALID_ARGUMENTS, status);
+
+    status = psa_its_get_multiple(PSA_ITS_GET_MULTIPLE_MAX + 1, uids, lengths, read_buff, item_status);
+    TEST_ASSERT_EQUAL(PSA_ITS_ERROR_INVALID_ARGUMENTS, status);
+}
+
+static void pits_latency_test()
+{
+    uint8_t write_buff[TEST_BUFF_SIZE] = {0};
+    uint8_t read_buff[PSA_ITS_GET_MULTIPLE_MAX * TEST_BUFF_SIZE];
+    psa_its_uid_t uids[PSA_ITS_GET_MULTIPLE_MAX];
+    uint32_t lengths[PSA_ITS_GET_MULTIPLE_MAX];
+    psa_its_status_t item_status[PSA_ITS_GET_MULTIPLE_MAX];
+    struct psa_its_info_t info;
+    Timer timer;
+
+    for (int i = 0; i < PSA_ITS_GET_MULTIPLE_MAX; i++) {
+        uids[i] = 10 + i;
+        lengths[i] = TEST_BUFF_SIZE;
+        TEST_ASSERT_EQUAL(PSA_ITS_SUCCESS, psa_its_set(uids[i], TEST_BUFF_SIZE, write_buff, 0));
+    }
+
+    timer.start();
+    for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+        TEST_ASSERT_EQUAL(PSA_ITS_SUCCESS, psa_its_get_info(uids[0], &info));
+    }
+    timer.stop();
+    utest_printf("psa_its_get_info: %lu us\n", (unsigned long)(timer.read_high_resolution_us() / BENCHMARK_ITERATIONS));
+
+    timer.reset();
+    timer.start();
+    for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+        TEST_ASSERT_EQUAL(PSA_ITS_SUCCESS, psa_its_get(uids[0], 0, TEST_BUFF_SIZE, read_buff));
+    }
+    timer.stop();
+    utest_printf("psa_its_get of %d bytes: %lu us\n", TEST_BUFF_SIZE,
+                 (unsigned long)(timer.read_high_resolution_us() / BENCHMARK_ITERATIONS));
+
+    timer.reset();
+    timer.start();
+    for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+        for (int j = 0; j < PSA_ITS_GET_MULTIPLE_MAX; j++) {
+            TEST_ASSERT_EQUAL(PSA_ITS_SUCCESS, psa_its_get(uids[j], 0, TEST_BUFF_SIZE, read_buff + j * TEST_BUFF_SIZE));
+        }
+    }
+    timer.stop();
+    utest_printf("%d psa_its_get calls: %lu us\n", PSA_ITS_GET_MULTIPLE_MAX,
+                 (unsigned long)(timer.read_high_resolution_us() / BENCHMARK_ITERATIONS));
+
+    timer.reset();
+    timer.start();
+    for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+        TEST_ASSERT_EQUAL(PSA_ITS_SUCCESS, psa_its_get_multiple(PSA_ITS_GET_MULTIPLE_MAX, uids, lengths, read_buff, item_status));
+    }
+    timer.stop();
+    utest_printf("psa_its_get_multiple of %d items: %lu us\n", PSA_ITS_GET_MULTIPLE_MAX,
+                 (unsigned long)(timer.read_high_resolution_us() / BENCHMARK_ITERATIONS));
+
+    timer.reset();
+    timer.start();
+    for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+        TEST_ASSERT_EQUAL(PSA_ITS_SUCCESS, psa_its_set(uids[0], TEST_BUFF_SIZE, write_buff, 0));
+    }
+    timer.stop();
+    utest_printf("psa_its_set of %d bytes: %lu us\n", TEST_BUFF_SIZE,
+                 (unsigned long)(timer.read_high_resolution_us() / BENCHMARK_ITERATIONS));
+}
+
 utest::v1::status_t case_teardown_handler(const Case *const source, const size_t passed, const size_t failed, const failure_t reason)
 {
     psa_status_t status;
@@ -127,13 +231,15 @@ utest::v1::status_t case_setup_handler(const Case *const source, const size_t in
 
 Case cases[] = {
     Case("PSA prot internal storage - Basic", case_setup_handler, pits_test, case_teardown_handler),
-    Case("PSA prot internal storage - Write-once", case_setup_handler, pits_write_once_test, case_teardown_handler)
+    Case("PSA prot internal storage - Write-once", case_setup_handler, pits_write_once_test, case_teardown_handler),
+    Case("PSA prot internal storage - Get multiple", case_setup_handler, pits_get_multiple_test, case_teardown_handler),
+    Case("PSA prot internal storage - Latency", case_setup_handler, pits_latency_test, case_teardown_handler)
 };
 
 utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
 {
 #ifndef NO_GREENTEA
-    GREENTEA_SETUP(60, "default_auto");
+    GREENTEA_SETUP(120, "default_auto");
 #endif
     return greentea_test_setup_handler(number_of_cases);
 }
@@ -0,0 +1,421 @@
+/*
+ * Copyright (c) 2018 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "NetworkStack.h"
+#include "NetworkInterface.h"
+#include "TCPSocket.h"
+#include "UDPSocket.h"
+#include "SocketAddress.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#ifndef __STDC_FORMAT_MACROS
+#define __STDC_FORMAT_MACROS
+#endif
+#include <inttypes.h>
+
+#include "mbed-client-cli/ns_cmdline.h"
+#include "mbed-trace/mbed_trace.h"
+
+#define TRACE_GROUP "Anpf"
+
+#include "cmd_ifconfig.h"
+#include "cmd_netperf.h"
+
+#define NETPERF_MAX_SOCKETS     4
+#define NETPERF_STACK_SIZE      1536
+#define NETPERF_DEFAULT_TIME    10
+#define NETPERF_DEFAULT_BUF     1024
+#define NETPERF_DEFAULT_COUNT   100
+#define NETPERF_MAX_COUNT       1000
+#define NETPERF_ACCEPT_TIMEOUT  60000
+#define NETPERF_RECV_TIMEOUT    500
+#define NETPERF_ECHO_TIMEOUT    1000
+
+#define MAN_NETPERF         "\r\nNETWORK PERFORMANCE\r\n"\
+                            "\r\n"\
+                            "netperf <tcp|udp> client <addr> <port> [--time <s>] [--buf <len>] [--sockets <n>]\r\n"\
+                            "   send to an iperf style server for <s> seconds\r\n"\
+                            "netperf <tcp|udp> server <port> [--time <s>] [--buf <len>] [--sockets <n>]\r\n"\
+                            "   receive for <s> seconds from the first connection or datagram\r\n"\
+                            "netperf rtt <addr> <port> [--count <N>] [--buf <len>] [--interval <ms>]\r\n"\
+                            "   round trip times of UDP datagrams through an echo server\r\n"\
+                            "\r\nOptions\r\n"\
+                            " --time <s>      Duration, default 10\r\n"\
+                            " --buf <len>     Size of each send or receive, default 1024\r\n"\
+                            " --sockets <n>   Number of parallel TCP connections or UDP sockets, up to 4, default 1\r\n"\
+                            " --count <N>     Number of datagrams, up to 1000, default 100\r\n"\
+                            " --interval <ms> Delay between datagrams, default 0\r\n"\
+                            "\r\nCPU utilization is reported when platform.cpu-stats-enabled is set"
+
+struct netperf_worker_t {
+    Socket *sock;
+    bool tcp;
+    bool tx;
+    SocketAddress peer;
+    uint8_t *buf;
+    size_t len;
+    uint64_t bytes;
+    uint32_t packets;
+    nsapi_error_t error;
+    Thread *thread;
+};
+
+static Timer netperf_timer;
+static us_timestamp_t netperf_deadline;
+
+static int cmd_netperf(int argc, char *argv[]);
+
+void cmd_netperf_init(void)
+{
+    cmd_add("netperf", cmd_netperf, "netperf", MAN_NETPERF);
+}
+
+static void netperf_worker(netperf_worker_t *w)
+{
+    while (netperf_timer.read_high_resolution_us() < netperf_deadline) {
+        nsapi_size_or_error_t ret;
+        if (w->tx) {
+            ret = w->tcp ? static_cast<TCPSocket *>(w->sock)->send(w->buf, w->len)
+                  : static_cast<UDPSocket *>(w->sock)->sendto(w->peer, w->buf, w->len);
+        } else {
+            ret = w->tcp ? static_cast<TCPSocket *>(w->sock)->recv(w->buf, w->len)
+                  : static_cast<UDPSocket *>(w->sock)->recvfrom(NULL, w->buf, w->len);
+        }
+
+        // Receive timeouts, and UDP sends outrunning the stack buffers
+        if (ret == NSAPI_ERROR_WOULD_BLOCK || (!w->tcp && ret == NSAPI_ERROR_NO_MEMORY)) {
+            ThisThread::yield();
+            continue;
+        }
+        if (ret < 0) {
+            w->error = ret;
+            break;
+        }
+        if (ret == 0 && w->tcp && !w->tx) {
+            // Connection closed by the peer
+            break;
+        }
+        w->bytes += ret;
+        w->packets++;
+    }
+}
+
+static void netperf_report(const char *what, uint64_t bytes, uint32_t packets, us_timestamp_t us,
+                           const mbed_stats_cpu_t *cpu_start)
+{
+    if (us == 0) {
+        us = 1;
+    }
+    uint32_t kbps = (uint32_t)(bytes * 8000 / us);
+    uint32_t pps = (uint32_t)((uint64_t)packets * 1000000 / us);
+
+    cmd_printf("%s: %" PRIu64 " bytes, %" PRIu32 " packets in %" PRIu32 " ms\r\n",
+               what, bytes, packets, (uint32_t)(us / 1000));
+    cmd_printf("throughput: %" PRIu32 ".%03" PRIu32 " Mbit/s, %" PRIu32 " pps\r\n",
+               kbps / 1000, kbps % 1000, pps);
+
+#if defined(MBED_CPU_STATS_ENABLED)
+    mbed_stats_cpu_t cpu_end;
+    mbed_stats_cpu_get(&cpu_end);
+    us_timestamp_t uptime = cpu_end.uptime - cpu_start->uptime;
+    us_timestamp_t idle = cpu_end.idle_time - cpu_start->idle_time;
+    if (uptime) {
+        cmd_printf("cpu: %" PRIu32 "%%\r\n", (uint32_t)(100 - idle * 100 / uptime));
+    }
+#else
+    cmd_printf("cpu: n/a\r\n");
+#endif
+}
+
+// Run the workers until the deadline and report their totals
+static int netperf_run(const char *what, netperf_worker_t *workers, int count, int32_t time_s,
+                       const mbed_stats_cpu_t *cpu_start)
+{
+    netperf_timer.reset();
+    netperf_timer.start();
+    netperf_deadline = (us_timestamp_t)time_s * 1000000;
+
+    for (int i = 0; i < count; i++) {
+        workers[i].thread = new Thread(osPriorityNormal, NETPERF_STACK_SIZE);
+        workers[i].thread->start(callback(netperf_worker, &workers[i]));
+    }
+
+    uint64_t bytes = 0;
+    uint32_t packets = 0;
+    int ret = CMDLINE_RETCODE_SUCCESS;
+    for (int i = 0; i < count; i++) {
+        workers[i].thread->join();
+        delete workers[i].thread;
+        bytes += workers[i].bytes;
+        packets += workers[i].packets;
+        if (workers[i].error != NSAPI_ERROR_OK) {
+            cmd_printf("socket %d: %s\r\n", i, networkstack_error_to_str(workers[i].error));
+            ret = CMDLINE_RETCODE_FAIL;
+        }
+    }
+    us_timestamp_t us = netperf_timer.read_high_resolution_us();
+    netperf_timer.stop();
+
+    netperf_report(what, bytes, packets, us, cpu_start);
+
+    return ret;
+}
+
+static void netperf_cleanup(netperf_worker_t *workers, int count)
+{
+    for (int i = 0; i < count; i++) {
+        if (workers[i].sock) {
+            workers[i].sock->close();
+            delete workers[i].sock;
+        }
+        delete[] workers[i].buf;
+    }
+}
+
+static int netperf_client(NetworkInterface *net, bool tcp, const SocketAddress &peer,
+                          int32_t time_s, int32_t len, int32_t sockets)
+{
+    netperf_worker_t workers[NETPERF_MAX_SOCKETS] = {};
+    int ret = CMDLINE_RETCODE_SUCCESS;
+
+    for (int i = 0; i < sockets; i++) {
+        netperf_worker_t *w = &workers[i];
+        w->tcp = tcp;
+        w->tx = true;
+        w->peer = peer;
+        w->len = len;
+        w->buf = new uint8_t[len];
+        for (int32_t j = 0; j < len; j++) {
+            w->buf[j] = '0' + j % 10;
+        }
+
+        nsapi_error_t err;
+        if (tcp) {
+            TCPSocket *sock = new TCPSocket;
+            w->sock = sock;
+            err = sock->open(net);
+            if (err == NSAPI_ERROR_OK) {
+                err = sock->connect(peer);
+            }
+        } else {
+            w->sock = new UDPSocket;
+            err = static_cast<UDPSocket *>(w->sock)->open(net);
+        }
+        if (err != NSAPI_ERROR_OK) {
+            cmd_printf("socket %d: %s\r\n", i, networkstack_error_to_str(err));
+            ret = CMDLINE_RETCODE_FAIL;
+            break;
+        }
+    }
+
+    if (ret == CMDLINE_RETCODE_SUCCESS) {
+        mbed_stats_cpu_t cpu_start;
+        mbed_stats_cpu_get(&cpu_start);
+        ret = netperf_run("sent", workers, sockets, time_s, &cpu_start);
+    }
+
+    netperf_cleanup(workers, sockets);
+    return ret;
+}
+
+static int netperf_server(NetworkInterface *net, bool tcp, uint16_t port,
+                          int32_t time_s, int32_t len, int32_t sockets)
+{
+    netperf_worker_t workers[NETPERF_MAX_SOCKETS] = {};
+    mbed_stats_cpu_t cpu_start;
+    nsapi_error_t err;
+    int ret = CMDLINE_RETCODE_SUCCESS;
+
+    if (!tcp) {
+        // One socket receives all the datagrams sent to the port
+        sockets = 1;
+    }
+    for (int i = 0; i < sockets; i++) {
+        workers[i].tcp = tcp;
+        workers[i].len = len;
+        workers[i].buf = new uint8_t[len];
+    }
+
+    if (tcp) {
+        TCPSocket listener;
+        err = listener.open(net);
+        if (err == NSAPI_ERROR_OK) {
+            err = listener.bind(port);
+        }
+        if (err == NSAPI_ERROR_OK) {
+            err = listener.listen(sockets);
+        }
+        listener.set_timeout(NETPERF_ACCEPT_TIMEOUT);
+        for (int i = 0; i < sockets && err == NSAPI_ERROR_OK; i++) {
+            TCPSocket *sock = listener.accept(&err);
+            if (sock) {
+                sock->set_timeout(NETPERF_RECV_TIMEOUT);
+                workers[i].sock = sock;
+            }
+        }
+        listener.close();
+        mbed_stats_cpu_get(&cpu_start);
+    } else {
+        UDPSocket *sock = new UDPSocket;
+        workers[0].sock = sock;
+        err = sock->open(net);
+        if (err == NSAPI_ERROR_OK) {
+            err = sock->bind(port);
+        }
+        if (err == NSAPI_ERROR_OK) {
+            // Wait for the first datagram before timing the rest
+            sock->set_timeout(NETPERF_ACCEPT_TIMEOUT);
+            nsapi_size_or_error_t size = sock->recvfrom(NULL, workers[0].buf, len);
+            err = size < 0 ? size : NSAPI_ERROR_OK;
+            sock->set_timeout(NETPERF_RECV_TIMEOUT);
+        }
+        mbed_stats_cpu_get(&cpu_start);
+    }
+
+    if (err != NSAPI_ERROR_OK) {
+        cmd_printf("server: %s\r\n", networkstack_error_to_str(err));
+        ret = CMDLINE_RETCODE_FAIL;
+    } else {
+        ret = netperf_run("received", workers, sockets, time_s, &cpu_start);
+    }
+
+    netperf_cleanup(workers, sockets);
+    return ret;
+}
+
+static int netperf_rtt(NetworkInterface *net, const SocketAddress &peer,
+                       int32_t count, int32_t len, int32_t interval)
+{
+    UDPSocket sock;
+    nsapi_error_t err = sock.open(net);
+    if (err != NSAPI_ERROR_OK) {
+        cmd_printf("socket: %s\r\n", networkstack_error_to_str(err));
+        return CMDLINE_RETCODE_FAIL;
+    }
+    sock.set_timeout(NETPERF_ECHO_TIMEOUT);
+
+    uint8_t *buf = new uint8_t[len];
+    uint8_t *echo = new uint8_t[len];
+    uint32_t *rtts = new uint32_t[count];
+    int32_t received = 0;
+    memset(buf, 'x', len);
+
+    netperf_timer.reset();
+    netperf_timer.start();
+    for (uint32_t seq = 0; seq < (uint32_t)count; seq++) {
+        memcpy(buf, &seq, sizeof(seq));
+        us_timestamp_t start = netperf_timer.read_high_resolution_us();
+        if (sock.sendto(peer, buf, len) < 0) {
+            continue;
+        }
+
+        // Skip late echoes of earlier datagrams
+        while (true) {
+            nsapi_size_or_error_t ret = sock.recvfrom(NULL, echo, len);
+            if (ret < 0) {
+                break;
+            }
+            if (ret >= (nsapi_size_or_error_t)sizeof(seq) && memcmp(echo, &seq, sizeof(seq)) == 0) {
+                rtts[received++] = (uint32_t)(netperf_timer.read_high_resolution_us() - start);
+                break;
+            }
+        }
+
+        if (interval) {
+            ThisThread::sleep_for(interval);
+        }
+    }
+    netperf_timer.stop();
+    sock.close();
+
+    cmd_printf("rtt: %" PRId32 " sent, %" PRId32 " received, %" PRId32 "%% lost\r\n",
+               count, received, (count - received) * 100 / count);
+    if (received) {
+        std::sort(rtts, rtts + received);
+        cmd_printf("rtt us: min %" PRIu32 ", p50 %" PRIu32 ", p90 %" PRIu32 ", p99 %" PRIu32 ", max %" PRIu32 "\r\n",
+                   rtts[0], rtts[(received - 1) * 50 / 100], rtts[(received - 1) * 90 / 100],
+                   rtts[(received - 1) * 99 / 100], rtts[received - 1]);
+    }
+
+    delete[] rtts;
+    delete[] echo;
+    delete[] buf;
+    return received ? CMDLINE_RETCODE_SUCCESS : CMDLINE_RETCODE_FAIL;
+}
+
+static bool netperf_resolve(NetworkInterface *net, const char *host, const char *port, SocketAddress *addr)
+{
+    nsapi_error_t err = net->gethostbyname(host, addr);
+    if (err != NSAPI_ERROR_OK) {
+        cmd_printf("%s: %s\r\n", host, networkstack_error_to_str(err));
+        return false;
+    }
+    addr->set_port(strtol(port, NULL, 10));
+    return true;
+}
+
+static int cmd_netperf(int argc, char *argv[])
+{
+    NetworkInterface *net = get_interface();
+    if (!net) {
+        cmd_printf("No interface configured\r\n");
+        return CMDLINE_RETCODE_FAIL;
+    }
+    if (argc < 3) {
+        return CMDLINE_RETCODE_INVALID_PARAMETERS;
+    }
+
+    int32_t time_s = NETPERF_DEFAULT_TIME;
+    int32_t len = NETPERF_DEFAULT_BUF;
+    int32_t sockets = 1;
+    int32_t count = NETPERF_DEFAULT_COUNT;
+    int32_t interval = 0;
+    cmd_parameter_int(argc, argv, "--time", &time_s);
+    cmd_parameter_int(argc, argv, "--buf", &len);
+    cmd_parameter_int(argc, argv, "--sockets", &sockets);
+    cmd_parameter_int(argc, argv, "--count", &count);
+    cmd_parameter_int(argc, argv, "--interval", &interval);
+    if (time_s <= 0 || len < (int32_t)sizeof(uint32_t) || sockets <= 0 || sockets > NETPERF_MAX_SOCKETS ||
+            count <= 0 || count > NETPERF_MAX_COUNT || interval < 0) {
+        return CMDLINE_RETCODE_INVALID_PARAMETERS;
+    }
+
+    SocketAddress peer;
+    if (strcmp(argv[1], "rtt") == 0) {
+        if (!netperf_resolve(net, argv[2], argc > 3 ? argv[3] : "7", &peer)) {
+            return CMDLINE_RETCODE_FAIL;
+        }
+        return netperf_rtt(net, peer, count, len, interval);
+    }
+
+    bool tcp = strcmp(argv[1], "tcp") == 0;
+    if (!tcp && strcmp(argv[1], "udp") != 0) {
+        return CMDLINE_RETCODE_INVALID_PARAMETERS;
+    }
+
+    if (strcmp(argv[2], "client") == 0 && argc > 4) {
+        if (!netperf_resolve(net, argv[3], argv[4], &peer)) {
+            return CMDLINE_RETCODE_FAIL;
+        }
+        return netperf_client(net, tcp, peer, time_s, len, sockets);
+    } else if (strcmp(argv[2], "server") == 0 && argc > 3) {
+        return netperf_server(net, tcp, strtol(argv[3], NULL, 10), time_s, len, sockets);
+    }
+
+    return CMDLINE_RETCODE_INVALID_PARAMETERS;
+}
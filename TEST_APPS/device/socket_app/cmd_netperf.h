@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2018 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef CMD_NETPERF_H
+#define CMD_NETPERF_H
+
+/** Register the netperf command
+ *
+ * netperf measures TCP and UDP throughput and UDP round trip times over the
+ * interface brought up with ifup, against an iperf style peer or an echo
+ * server. See MAN_NETPERF for the options.
+ */
+void cmd_netperf_init(void);
+
+#endif
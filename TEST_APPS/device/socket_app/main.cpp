@@ -19,6 +19,7 @@
 #include "mbed-client-cli/ns_cmdline.h"
 #include "cmd_ifconfig.h"
 #include "cmd_socket.h"
+#include "cmd_netperf.h"
 
 /**
  * Macros for setting console flow control.
@@ -47,6 +48,7 @@ int main()
     cmd_init(&wrap_printf);
     cmd_ifconfig_init();
     cmd_socket_init();
+    cmd_netperf_init();
 
     int c;
     while ((c = getchar()) != EOF) {
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <map>
+#include <string>
+#include "gtest/gtest.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCHMARK_CYCLES() __rdtsc()
+#else
+#define BENCHMARK_CYCLES() 0
+#endif
+
+namespace benchmark {
+
+static const uint32_t ROUNDS = 5;
+static const double DEFAULT_TOLERANCE = 50;
+
+typedef std::map<std::string, double> results_t;
+
+/* Loads the baseline before the benchmarks run and rewrites it after them
+ * in update mode. */
+class Baseline : public ::testing::Environment {
+public:
+    virtual void SetUp()
+    {
+        _path = getenv("MBED_BENCHMARK_BASELINE");
+        _update = getenv("MBED_BENCHMARK_UPDATE") != NULL;
+        const char *tolerance = getenv("MBED_BENCHMARK_TOLERANCE");
+        _tolerance = tolerance ? atof(tolerance) : DEFAULT_TOLERANCE;
+
+        if (!_path) {
+            return;
+        }
+
+        FILE *file = fopen(_path, "r");
+        if (!file) {
+            return;
+        }
+
+        char line[256];
+        while (fgets(line, sizeof(line), file)) {
+            char name[200];
+            double ns;
+            if (line[0] != '#' && sscanf(line, "%199s %lf", name, &ns) == 2) {
+                _entries[name] = ns;
+            }
+        }
+        fclose(file);
+    }
+
+    virtual void TearDown()
+    {
+        if (!_path || !_update) {
+            return;
+        }
+
+        FILE *file = fopen(_path, "w");
+        if (!file) {
+            fprintf(stderr, "Can't write benchmark baseline %s\n", _path);
+            return;
+        }
+
+        fprintf(file, "# <Suite.Test> <ns per iteration>\n");
+        for (results_t::const_iterator it = _entries.begin(); it != _entries.end(); ++it) {
+            fprintf(file, "%s %.3f\n", it->first.c_str(), it->second);
+        }
+        fclose(file);
+    }
+
+    void report(const std::string &name, double ns, double cycles)
+    {
+        char result[128];
+        if (cycles) {
+            snprintf(result, sizeof(result), "%.3f ns, %.1f cycles per iteration", ns, cycles);
+        } else {
+            snprintf(result, sizeof(result), "%.3f ns per iteration", ns);
+        }
+        ::testing::Test::RecordProperty("result", result);
+
+        results_t::iterator entry = _entries.find(name);
+        if (_update) {
+            printf("[ BENCH    ] %s: %s\n", name.c_str(), result);
+            _entries[name] = ns;
+            return;
+        }
+
+        if (entry == _entries.end()) {
+            printf("[ BENCH    ] %s: %s, no baseline\n", name.c_str(), result);
+            return;
+        }
+
+        double change = (ns - entry->second) * 100 / entry->second;
+        printf("[ BENCH    ] %s: %s, baseline %.3f ns (%+.1f%%)\n",
+               name.c_str(), result, entry->second, change);
+        if (change > _tolerance) {
+            ADD_FAILURE() << name << " is " << change << "% slower than its baseline, tolerance is "
+                          << _tolerance << "%";
+        }
+    }
+
+private:
+    const char *_path;
+    bool _update;
+    double _tolerance;
+    results_t _entries;
+};
+
+static Baseline *const baseline =
+    static_cast<Baseline *>(::testing::AddGlobalTestEnvironment(new Baseline));
+
+static uint64_t now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+Measurement::Measurement(uint32_t iterations) :
+    _round_iterations(iterations / ROUNDS ? iterations / ROUNDS : 1),
+    _remaining(0),
+    _rounds(0),
+    _start_ns(0),
+    _start_cycles(0),
+    _best_ns((uint64_t) -1),
+    _best_cycles((uint64_t) -1)
+{
+}
+
+bool Measurement::next_round()
+{
+    if (_rounds) {
+        uint64_t cycles = BENCHMARK_CYCLES() - _start_cycles;
+        uint64_t ns = now_ns() - _start_ns;
+        if (ns < _best_ns) {
+            _best_ns = ns;
+            _best_cycles = cycles;
+        }
+    }
+
+    if (_rounds < ROUNDS) {
+        _rounds++;
+        _remaining = _round_iterations - 1;
+        _start_ns = now_ns();
+        _start_cycles = BENCHMARK_CYCLES();
+        return true;
+    }
+
+    const ::testing::TestInfo *info = ::testing::UnitTest::GetInstance()->current_test_info();
+    std::string name = std::string(info->test_case_name()) + "." + info->name();
+    baseline->report(name, (double) _best_ns / _round_iterations,
+                     (double) _best_cycles / _round_iterations);
+    return false;
+}
+
+} // namespace benchmark
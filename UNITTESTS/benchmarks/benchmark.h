@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UNITTESTS_BENCHMARK_H
+#define UNITTESTS_BENCHMARK_H
+
+#include <stdint.h>
+
+/*
+ * Host microbenchmarks
+ *
+ * Benchmarks are gtest tests which time a loop with BENCHMARK_LOOP. The loop
+ * runs in several rounds and the fastest round gives the time per iteration,
+ * which is printed and compared with the baseline of the suite.
+ *
+ * Environment variables:
+ * - MBED_BENCHMARK_BASELINE: file holding the baseline, one
+ *   "<Suite.Test> <ns per iteration>" line per benchmark. Set by CMake to
+ *   baseline.txt in the directory of the suite.
+ * - MBED_BENCHMARK_TOLERANCE: slowdown against the baseline, in percent,
+ *   above which a benchmark fails. Defaults to 50.
+ * - MBED_BENCHMARK_UPDATE: if set, the baseline is rewritten with the
+ *   results of the run instead of being checked.
+ *
+ * Benchmarks without an entry in the baseline are only reported. Times
+ * depend on the host, so the baseline must be recorded on the machine which
+ * checks it.
+ *
+ * Example:
+ * @code
+ * TEST(BenchmarkCircularBuffer, push_pop)
+ * {
+ *     mbed::CircularBuffer<int, 16> buf;
+ *     int data = 0;
+ *     BENCHMARK_LOOP(1000000) {
+ *         buf.push(data);
+ *         buf.pop(data);
+ *     }
+ *     benchmark::do_not_optimize(data);
+ * }
+ * @endcode
+ */
+
+namespace benchmark {
+
+/** Prevent the compiler from optimizing away the computation of a value */
+template<typename T>
+inline void do_not_optimize(const T &value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/** Timed loop, use through BENCHMARK_LOOP */
+class Measurement {
+public:
+    Measurement(uint32_t iterations);
+
+    /** Advance the loop, return false once all iterations have run */
+    bool running()
+    {
+        if (_remaining) {
+            _remaining--;
+            return true;
+        }
+        return next_round();
+    }
+
+private:
+    bool next_round();
+
+    uint32_t _round_iterations;
+    uint32_t _remaining;
+    uint32_t _rounds;
+    uint64_t _start_ns;
+    uint64_t _start_cycles;
+    uint64_t _best_ns;
+    uint64_t _best_cycles;
+};
+
+} // namespace benchmark
+
+/** Run the following statement in a timed loop
+ *
+ * @param iterations Total number of iterations, spread over the rounds
+ */
+#define BENCHMARK_LOOP(iterations) \
+    for (benchmark::Measurement benchmark_measurement_(iterations); benchmark_measurement_.running(); )
+
+#endif /* UNITTESTS_BENCHMARK_H */
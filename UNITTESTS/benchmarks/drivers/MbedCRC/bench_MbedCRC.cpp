@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "benchmark.h"
+#include "drivers/MbedCRC.h"
+
+using namespace mbed;
+
+class BenchmarkMbedCRC : public testing::Test {
+protected:
+    uint8_t data[1024];
+
+    virtual void SetUp()
+    {
+        for (size_t i = 0; i < sizeof(data); i++) {
+            data[i] = i * 7;
+        }
+    }
+};
+
+// All benchmarks compute the CRC of 1 KB
+
+TEST_F(BenchmarkMbedCRC, crc32_ansi)
+{
+    MbedCRC<POLY_32BIT_ANSI, 32> ct;
+    uint32_t crc = 0;
+
+    BENCHMARK_LOOP(20000) {
+        ct.compute(data, sizeof(data), &crc);
+    }
+    benchmark::do_not_optimize(crc);
+}
+
+TEST_F(BenchmarkMbedCRC, crc16_ccitt)
+{
+    MbedCRC<POLY_16BIT_CCITT, 16> ct;
+    uint32_t crc = 0;
+
+    BENCHMARK_LOOP(20000) {
+        ct.compute(data, sizeof(data), &crc);
+    }
+    benchmark::do_not_optimize(crc);
+}
+
+TEST_F(BenchmarkMbedCRC, crc7_sd)
+{
+    MbedCRC<POLY_7BIT_SD, 7> ct;
+    uint32_t crc = 0;
+
+    BENCHMARK_LOOP(20000) {
+        ct.compute(data, sizeof(data), &crc);
+    }
+    benchmark::do_not_optimize(crc);
+}
+
+// Polynomial without table, computed bitwise
+TEST_F(BenchmarkMbedCRC, crc32_custom)
+{
+    MbedCRC<0x1EDC6F41, 32> ct(0xFFFFFFFF, 0xFFFFFFFF, true, true);
+    uint32_t crc = 0;
+
+    BENCHMARK_LOOP(20000) {
+        ct.compute(data, sizeof(data), &crc);
+    }
+    benchmark::do_not_optimize(crc);
+}
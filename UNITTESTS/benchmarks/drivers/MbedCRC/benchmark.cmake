@@ -0,0 +1,16 @@
+
+####################
+# BENCHMARKS
+####################
+
+set(benchmark-sources
+  ../drivers/MbedCRC.cpp
+  ../drivers/TableCRC.cpp
+)
+
+set(benchmark-test-sources
+  benchmarks/drivers/MbedCRC/bench_MbedCRC.cpp
+  stubs/Mutex_stub.cpp
+  stubs/mbed_assert_stub.c
+  benchmarks/mbed_critical_host.c
+)
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "benchmark.h"
+#include "equeue/equeue.h"
+
+static void increment(void *p)
+{
+    (*(int *)p)++;
+}
+
+class BenchmarkEqueue : public testing::Test {
+protected:
+    equeue_t q;
+    int count;
+
+    virtual void SetUp()
+    {
+        ASSERT_EQ(0, equeue_create(&q, 64 * EQUEUE_EVENT_SIZE));
+        count = 0;
+    }
+
+    virtual void TearDown()
+    {
+        equeue_destroy(&q);
+    }
+};
+
+TEST_F(BenchmarkEqueue, call_dispatch)
+{
+    BENCHMARK_LOOP(1000000) {
+        equeue_call(&q, increment, &count);
+        equeue_dispatch(&q, 0);
+    }
+    benchmark::do_not_optimize(count);
+}
+
+TEST_F(BenchmarkEqueue, alloc_post_dispatch)
+{
+    BENCHMARK_LOOP(1000000) {
+        void *e = equeue_alloc(&q, sizeof(int *));
+        *(int **)e = &count;
+        equeue_post(&q, increment, e);
+        equeue_dispatch(&q, 0);
+    }
+    benchmark::do_not_optimize(count);
+}
+
+// Insertion and removal of timed events among 32 pending ones
+TEST_F(BenchmarkEqueue, call_in_cancel)
+{
+    for (int i = 0; i < 32; i++) {
+        equeue_call_in(&q, 100000 + 1000 * i, increment, &count);
+    }
+
+    int delay = 0;
+    BENCHMARK_LOOP(1000000) {
+        int id = equeue_call_in(&q, 100000 + delay, increment, &count);
+        equeue_cancel(&q, id);
+        delay = (delay + 997) % 32000;
+    }
+    benchmark::do_not_optimize(count);
+}
@@ -0,0 +1,16 @@
+
+####################
+# BENCHMARKS
+####################
+
+# Use the real equeue platform instead of the unittest one
+set(unittest-includes ../events ${unittest-includes})
+
+set(benchmark-sources
+  ../events/equeue/equeue.c
+  ../events/equeue/equeue_posix.c
+)
+
+set(benchmark-test-sources
+  benchmarks/events/equeue/bench_equeue.cpp
+)
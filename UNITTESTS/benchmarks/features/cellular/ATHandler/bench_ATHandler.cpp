@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "benchmark.h"
+#include "ATHandler.h"
+#include "EventQueue.h"
+#include "FileHandle_stub.h"
+#include "mbed_poll_stub.h"
+
+using namespace mbed;
+using namespace events;
+
+class BenchmarkATHandler : public testing::Test {
+protected:
+    EventQueue que;
+    FileHandle_stub fh;
+    ATHandler *at;
+
+    virtual void SetUp()
+    {
+        at = new ATHandler(&fh, que, 0, ",");
+        mbed_poll_stub::revents_value = POLLIN;
+        mbed_poll_stub::int_value = 1;
+    }
+
+    virtual void TearDown()
+    {
+        delete at;
+        filehandle_stub_table = NULL;
+        filehandle_stub_table_pos = 0;
+    }
+
+    void receive(char *data)
+    {
+        at->flush();
+        at->clear_error();
+        filehandle_stub_table = data;
+        filehandle_stub_table_pos = 0;
+    }
+};
+
+TEST_F(BenchmarkATHandler, read_int)
+{
+    char response[] = "+CSQ: 20,99\r\nOK\r\n";
+    int value = 0;
+
+    BENCHMARK_LOOP(200000) {
+        receive(response);
+        at->resp_start("+CSQ:");
+        value = at->read_int();
+        value += at->read_int();
+        at->resp_stop();
+    }
+    EXPECT_EQ(NSAPI_ERROR_OK, at->get_last_error());
+    EXPECT_EQ(119, value);
+}
+
+TEST_F(BenchmarkATHandler, read_string)
+{
+    char response[] = "+COPS: 0,0,\"Operator name\",7\r\nOK\r\n";
+    char name[32];
+
+    BENCHMARK_LOOP(200000) {
+        receive(response);
+        at->resp_start("+COPS:");
+        at->skip_param(2);
+        at->read_string(name, sizeof(name));
+        at->skip_param();
+        at->resp_stop();
+    }
+    EXPECT_EQ(NSAPI_ERROR_OK, at->get_last_error());
+    EXPECT_STREQ("Operator name", name);
+}
+
+static int urc_count;
+
+static void urc_callback()
+{
+    urc_count++;
+}
+
+// URC matched among several registered handlers
+TEST_F(BenchmarkATHandler, urc_dispatch)
+{
+    char urc[] = "+CEREG: 2\r\n";
+    at->set_urc_handler("+CREG:", &urc_callback);
+    at->set_urc_handler("+CGREG:", &urc_callback);
+    at->set_urc_handler("+CMTI:", &urc_callback);
+    at->set_urc_handler("+CEREG:", &urc_callback);
+    urc_count = 0;
+
+    BENCHMARK_LOOP(200000) {
+        receive(urc);
+        filehandle_stub_short_value_counter = 1;
+        fh.short_value = POLLIN;
+        at->process_oob();
+    }
+    EXPECT_EQ(200000, urc_count);
+}
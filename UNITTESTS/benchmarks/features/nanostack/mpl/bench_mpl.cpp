@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "benchmark.h"
+#include <cstring>
+#include <cstdlib>
+#include <vector>
+
+extern "C" {
+#include "nsconfig.h"
+#include "ns_types.h"
+#include "ns_list.h"
+#include "common_functions.h"
+#include "Core/include/ns_buffer.h"
+#include "Core/include/address.h"
+#include "NWK_INTERFACE/Include/protocol.h"
+#include "Common_Protocols/ipv6_constants.h"
+#include "Service_Libs/Trickle/trickle.h"
+#include "MPL/mpl.h"
+
+extern uint32_t protocol_core_monotonic_time;
+}
+
+static const uint8_t domain_address[16] = { 0xff, 0x05, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01 };
+
+static const trickle_params_t data_params = { 1, 1, 1, 3 };
+
+// Forwarder of a domain, receiving copies of the buffered messages from
+// its neighbours
+class BenchmarkMpl : public testing::Test {
+protected:
+    protocol_interface_info_entry_t *cur;
+    mpl_domain_t *domain;
+    std::vector<buffer_t *> messages;
+
+    virtual void SetUp()
+    {
+        cur = (protocol_interface_info_entry_t *)calloc(1, sizeof(protocol_interface_info_entry_t));
+        domain = mpl_domain_create(cur, domain_address, NULL, MULTICAST_MPL_SEED_ID_IPV6_SRC_FOR_DOMAIN,
+                                   1, 600, &data_params, &data_params);
+    }
+
+    virtual void TearDown()
+    {
+        for (size_t i = 0; i < messages.size(); i++) {
+            buffer_free(messages[i]);
+        }
+        mpl_domain_delete(cur, domain_address);
+        mpl_domain_delete(cur, ADDR_ALL_MPL_FORWARDERS);
+        free(cur);
+    }
+
+    void add_message(uint16_t seed, uint8_t sequence)
+    {
+        const uint16_t size = 48;
+        buffer_t *buf = buffer_get(size);
+        uint8_t *ptr = buffer_data_pointer(buf);
+        memset(ptr, 0, size);
+        ptr[0] = 0x60;
+        common_write_16_bit(size - IPV6_HDRLEN, ptr + IPV6_HDROFF_PAYLOAD_LENGTH);
+        ptr[IPV6_HDROFF_NH] = IPV6_NH_HOP_BY_HOP;
+        ptr[IPV6_HDROFF_HOP_LIMIT] = 64;
+        ptr[IPV6_HDROFF_SRC_ADDR] = 0xfd;
+        common_write_16_bit(seed, ptr + IPV6_HDROFF_SRC_ADDR + 14);
+        memcpy(ptr + IPV6_HDROFF_DST_ADDR, domain_address, 16);
+        uint8_t *ext = ptr + IPV6_HDRLEN;
+        ext[0] = IPV6_NH_NONE;
+        ext[2] = IPV6_OPTION_MPL;
+        ext[3] = 2;
+        ext[5] = sequence;
+        ext[6] = IPV6_OPTION_PADN;
+        buffer_data_length_set(buf, size);
+
+        buf->interface = cur;
+        buf->mpl_option_data_offset = IPV6_HDRLEN + 4;
+        buf->src_sa.addr_type = ADDR_IPV6;
+        memcpy(buf->src_sa.address, ptr + IPV6_HDROFF_SRC_ADDR, 16);
+        buf->dst_sa.addr_type = ADDR_IPV6;
+        memcpy(buf->dst_sa.address, domain_address, 16);
+
+        protocol_core_monotonic_time++;
+        mpl_forwarder_process_message(buf, domain, false);
+        messages.push_back(buf);
+    }
+
+    void repeats()
+    {
+        size_t i = 0;
+        bool accepted = false;
+        BENCHMARK_LOOP(200000) {
+            accepted = mpl_forwarder_process_message(messages[i], domain, false);
+            i = (i + 1) % messages.size();
+        }
+        benchmark::do_not_optimize(accepted);
+    }
+};
+
+// Repeats of the latest message of each seed
+TEST_F(BenchmarkMpl, repeat_10_seeds)
+{
+    for (int seed = 1; seed <= 10; seed++) {
+        add_message(seed, 0);
+    }
+    repeats();
+}
+
+TEST_F(BenchmarkMpl, repeat_40_seeds)
+{
+    for (int seed = 1; seed <= 40; seed++) {
+        add_message(seed, 0);
+    }
+    repeats();
+}
+
+// Repeats of the buffered messages of a seed, as for the fragments of a
+// firmware image
+TEST_F(BenchmarkMpl, repeat_40_messages)
+{
+    for (int sequence = 0; sequence < 40; sequence++) {
+        add_message(1, sequence);
+    }
+    repeats();
+}
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "benchmark.h"
+#include <cstring>
+#include <cstdlib>
+
+extern "C" {
+#include "nsconfig.h"
+#include "ns_types.h"
+#include "ns_list.h"
+#include "common_functions.h"
+#include "NWK_INTERFACE/Include/protocol.h"
+#include "ipv6_stack/ipv6_routing_table.h"
+#include "net_rpl.h"
+#include "RPL/rpl_protocol.h"
+#include "RPL/rpl_upward.h"
+#include "RPL/rpl_downward.h"
+#include "RPL/rpl_structures.h"
+
+// Address of the border router. See protocol_core_stub.c
+extern uint8_t protocol_core_stub_address[16];
+}
+
+#define INTERFACE_ID 1
+
+static const uint8_t mesh_prefix[8] = { 0xfd, 0x00, 0x0d, 0xb8, 0, 0, 0, 0 };
+
+static void node_address(uint8_t address[16], uint16_t node)
+{
+    memcpy(address, mesh_prefix, 8);
+    memcpy(address + 8, "\x00\x00\x00\xff\xfe\x00", 6);
+    common_write_16_bit(node, address + 14);
+}
+
+// Border router of a non-storing DODAG, with the nodes in a tree of 4
+// children per node below it
+class BenchmarkRplDownward : public testing::Test {
+protected:
+    rpl_instance_t *instance;
+    rpl_dodag_t dodag;
+    rpl_dodag_version_t version;
+
+    virtual void SetUp()
+    {
+        instance = (rpl_instance_t *)calloc(1, sizeof(rpl_instance_t));
+        ns_list_init(&instance->dodags);
+        ns_list_init(&instance->candidate_neighbours);
+        ns_list_init(&instance->dao_targets);
+        ns_list_init(&instance->root_children);
+
+        memset(&dodag, 0, sizeof(dodag));
+        dodag.instance = instance;
+        dodag.root = true;
+        dodag.have_config = true;
+        dodag.g_mop_prf = RPL_MODE_NON_STORING;
+        dodag.config.lifetime_unit = 60;
+        memset(&version, 0, sizeof(version));
+        version.dodag = &dodag;
+        instance->current_dodag_version = &version;
+
+        node_address(protocol_core_stub_address, 0);
+    }
+
+    virtual void TearDown()
+    {
+        ns_list_foreach_safe(rpl_dao_target_t, target, &instance->dao_targets) {
+            rpl_delete_dao_target(instance, target);
+        }
+        free(instance);
+    }
+
+    void dao(uint16_t node)
+    {
+        uint8_t opts[4 + 16 + 2 + 20];
+        uint8_t *ptr = opts;
+        uint8_t src[16];
+
+        node_address(src, node);
+        *ptr++ = RPL_TARGET_OPTION;
+        *ptr++ = 2 + 16;
+        *ptr++ = 0;
+        *ptr++ = 128;
+        memcpy(ptr, src, 16);
+        ptr += 16;
+        *ptr++ = RPL_TRANSIT_OPTION;
+        *ptr++ = 20;
+        *ptr++ = 0;
+        *ptr++ = 0x80;
+        *ptr++ = 1;
+        *ptr++ = 10;
+        node_address(ptr, (node - 1) / 4);
+        ptr += 16;
+
+        uint8_t status;
+        rpl_instance_dao_received(instance, src, INTERFACE_ID, false, opts, ptr - opts, &status);
+    }
+
+    void join(int nodes)
+    {
+        for (int node = 1; node <= nodes; node++) {
+            dao(node);
+        }
+        ASSERT_EQ(nodes, ns_list_count(&instance->dao_targets));
+    }
+
+    // DAO refreshes received by the border router, one per node in turn
+    void dao_refresh(int nodes)
+    {
+        join(nodes);
+        int node = 1;
+        BENCHMARK_LOOP(20000) {
+            dao(node);
+            node = node % nodes + 1;
+        }
+    }
+
+    // Source routes recomputed after a topology change
+    void compute_paths(int nodes)
+    {
+        join(nodes);
+        BENCHMARK_LOOP(100) {
+            instance->root_topo_sort_valid = false;
+            instance->root_paths_valid = false;
+            rpl_downward_compute_paths(instance);
+        }
+    }
+
+    // Target of the destination of a packet
+    void match(int nodes)
+    {
+        uint8_t address[16];
+        rpl_dao_target_t *target = NULL;
+        join(nodes);
+        int node = 1;
+        BENCHMARK_LOOP(100000) {
+            node_address(address, node);
+            target = rpl_instance_match_dao_target(instance, address, 128);
+            node = node % nodes + 1;
+        }
+        benchmark::do_not_optimize(target);
+    }
+};
+
+TEST_F(BenchmarkRplDownward, dao_refresh_100)
+{
+    dao_refresh(100);
+}
+
+TEST_F(BenchmarkRplDownward, dao_refresh_500)
+{
+    dao_refresh(500);
+}
+
+TEST_F(BenchmarkRplDownward, dao_refresh_1000)
+{
+    dao_refresh(1000);
+}
+
+TEST_F(BenchmarkRplDownward, compute_paths_100)
+{
+    compute_paths(100);
+}
+
+TEST_F(BenchmarkRplDownward, compute_paths_500)
+{
+    compute_paths(500);
+}
+
+TEST_F(BenchmarkRplDownward, compute_paths_1000)
+{
+    compute_paths(1000);
+}
+
+TEST_F(BenchmarkRplDownward, match_100)
+{
+    match(100);
+}
+
+TEST_F(BenchmarkRplDownward, match_500)
+{
+    match(500);
+}
+
+TEST_F(BenchmarkRplDownward, match_1000)
+{
+    match(1000);
+}
@@ -0,0 +1,39 @@
+
+####################
+# BENCHMARKS
+####################
+
+# Nanostack configuration of the RPL unit tests
+set(unittest-includes ${unittest-includes}
+  features/nanostack/rpl_downward
+  ../features/nanostack/sal-stack-nanostack/source
+  ../features/nanostack/sal-stack-nanostack/nanostack
+  ../features/frameworks/mbed-client-randlib/mbed-client-randlib
+)
+
+set(benchmark-sources
+  ../features/nanostack/sal-stack-nanostack/source/RPL/rpl_downward.c
+  ../features/nanostack/sal-stack-nanostack/source/ipv6_stack/ipv6_routing_table.c
+  ../features/frameworks/nanostack-libservice/source/libList/ns_list.c
+  ../features/frameworks/nanostack-libservice/source/libBits/common_functions.c
+  ../features/frameworks/nanostack-libservice/source/libip6string/ip6tos.c
+)
+
+set(benchmark-test-sources
+  benchmarks/features/nanostack/rpl_downward/bench_rpl_downward.cpp
+  stubs/address_stub.c
+  stubs/etx_stub.c
+  stubs/icmpv6_stub.c
+  stubs/ipv6_resolution_stub.c
+  stubs/nsdynmemLIB_stub.c
+  stubs/protocol_core_stub.c
+  stubs/randLIB_stub.c
+  stubs/rpl_stub.c
+)
+
+set_source_files_properties(
+  ../features/nanostack/sal-stack-nanostack/source/RPL/rpl_downward.c
+  ../features/nanostack/sal-stack-nanostack/source/ipv6_stack/ipv6_routing_table.c
+  benchmarks/features/nanostack/rpl_downward/bench_rpl_downward.cpp
+  stubs/rpl_stub.c
+  PROPERTIES COMPILE_DEFINITIONS NSCONFIG=unittest)
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "benchmark.h"
+#include "features/netsocket/SocketAddress.h"
+
+TEST(BenchmarkSocketAddress, parse_ipv4)
+{
+    SocketAddress addr;
+    BENCHMARK_LOOP(1000000) {
+        addr.set_ip_address("192.168.100.254");
+    }
+    benchmark::do_not_optimize(addr);
+}
+
+TEST(BenchmarkSocketAddress, parse_ipv6)
+{
+    SocketAddress addr;
+    BENCHMARK_LOOP(1000000) {
+        addr.set_ip_address("2001:db8:85a3::8a2e:370:7334");
+    }
+    benchmark::do_not_optimize(addr);
+}
+
+TEST(BenchmarkSocketAddress, format_ipv4)
+{
+    SocketAddress addr("192.168.100.254");
+    const char *str = 0;
+    BENCHMARK_LOOP(1000000) {
+        // Setting the address drops the cached string
+        addr.set_addr(addr.get_addr());
+        str = addr.get_ip_address();
+    }
+    benchmark::do_not_optimize(str);
+}
+
+TEST(BenchmarkSocketAddress, format_ipv6)
+{
+    SocketAddress addr("2001:db8:85a3::8a2e:370:7334");
+    const char *str = 0;
+    BENCHMARK_LOOP(1000000) {
+        addr.set_addr(addr.get_addr());
+        str = addr.get_ip_address();
+    }
+    benchmark::do_not_optimize(str);
+}
@@ -0,0 +1,17 @@
+
+####################
+# BENCHMARKS
+####################
+
+set(benchmark-sources
+  ../features/netsocket/SocketAddress.cpp
+  ../features/frameworks/nanostack-libservice/source/libip4string/ip4tos.c
+  ../features/frameworks/nanostack-libservice/source/libip6string/ip6tos.c
+  ../features/frameworks/nanostack-libservice/source/libip4string/stoip4.c
+  ../features/frameworks/nanostack-libservice/source/libip6string/stoip6.c
+  ../features/frameworks/nanostack-libservice/source/libBits/common_functions.c
+)
+
+set(benchmark-test-sources
+  benchmarks/features/netsocket/SocketAddress/bench_SocketAddress.cpp
+)
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "benchmark.h"
+#include "HeapBlockDevice.h"
+#include "FlashSimBlockDevice.h"
+#include "TDBStore.h"
+
+using namespace mbed;
+
+#define KEYS 32
+
+class BenchmarkTDBStore : public testing::Test {
+protected:
+    HeapBlockDevice *heap_bd;
+    FlashSimBlockDevice *bd;
+    TDBStore *tdb;
+    char keys[KEYS][16];
+    uint8_t value[64];
+
+    virtual void SetUp()
+    {
+        heap_bd = new HeapBlockDevice(64 * 1024, 1, 1, 4096);
+        bd = new FlashSimBlockDevice(heap_bd);
+        ASSERT_EQ(0, bd->init());
+        tdb = new TDBStore(bd);
+        ASSERT_EQ(0, tdb->init());
+
+        memset(value, 0x5A, sizeof(value));
+        for (int i = 0; i < KEYS; i++) {
+            snprintf(keys[i], sizeof(keys[i]), "key%d", i);
+            ASSERT_EQ(0, tdb->set(keys[i], value, sizeof(value), 0));
+        }
+    }
+
+    virtual void TearDown()
+    {
+        tdb->deinit();
+        delete tdb;
+        bd->deinit();
+        delete bd;
+        delete heap_bd;
+    }
+};
+
+// Overwrites, including the garbage collections they trigger
+TEST_F(BenchmarkTDBStore, set)
+{
+    int i = 0;
+    BENCHMARK_LOOP(100000) {
+        tdb->set(keys[i], value, sizeof(value), 0);
+        i = (i + 1) % KEYS;
+    }
+}
+
+TEST_F(BenchmarkTDBStore, get)
+{
+    uint8_t buf[64];
+    int i = 0;
+    BENCHMARK_LOOP(200000) {
+        tdb->get(keys[i], buf, sizeof(buf));
+        i = (i + 1) % KEYS;
+    }
+    benchmark::do_not_optimize(buf);
+}
+
+TEST_F(BenchmarkTDBStore, get_missing)
+{
+    uint8_t buf[64];
+    BENCHMARK_LOOP(200000) {
+        tdb->get("missing", buf, sizeof(buf));
+    }
+    benchmark::do_not_optimize(buf);
+}
+
+// Mount, rebuilding the RAM table from the records on the device
+TEST_F(BenchmarkTDBStore, init)
+{
+    BENCHMARK_LOOP(5000) {
+        tdb->deinit();
+        tdb->init();
+    }
+}
+
+// Time the overwrites would take on a serial NOR flash, from the timing
+// model of FlashSimBlockDevice, with erases suspended by reads
+TEST_F(BenchmarkTDBStore, set_flash_time)
+{
+    flash_sim_timing_t timing = {};
+    timing.read_ns = 500;
+    timing.read_byte_ns = 80;
+    timing.program_page_ns = 700000;
+    timing.program_page_size = 256;
+    timing.erase_ns = 45000000;
+    timing.erase_suspend = true;
+    timing.suspend_ns = 20000;
+    timing.resume_ns = 20000;
+    bd->set_timing(timing);
+    bd->reset_time();
+
+    const int sets = 1000;
+    for (int i = 0; i < sets; i++) {
+        ASSERT_EQ(0, tdb->set(keys[i % KEYS], value, sizeof(value), 0));
+    }
+    ASSERT_EQ(0, bd->sync());
+    printf("[ FLASH    ] %s.%s: %.1f us of flash time per set\n",
+           ::testing::UnitTest::GetInstance()->current_test_info()->test_case_name(),
+           ::testing::UnitTest::GetInstance()->current_test_info()->name(),
+           bd->get_time_ns() / 1000.0 / sets);
+}
@@ -0,0 +1,30 @@
+
+####################
+# BENCHMARKS
+####################
+
+set(unittest-includes ${unittest-includes}
+  ../features/storage/blockdevice
+  ../features/storage/kvstore/include
+  ../features/storage/kvstore/tdbstore
+  ../features/storage/kvstore/conf
+  ../features/storage/system_storage
+)
+
+set(benchmark-sources
+  ../features/storage/kvstore/tdbstore/TDBStore.cpp
+  ../features/storage/blockdevice/HeapBlockDevice.cpp
+  ../features/storage/blockdevice/FlashSimBlockDevice.cpp
+  ../features/storage/blockdevice/BufferedBlockDevice.cpp
+  ../drivers/MbedCRC.cpp
+  ../drivers/TableCRC.cpp
+)
+
+set(benchmark-test-sources
+  benchmarks/features/storage/TDBStore/bench_TDBStore.cpp
+  stubs/Mutex_stub.cpp
+  stubs/SystemStorage_stub.cpp
+  stubs/mbed_assert_stub.c
+  benchmarks/mbed_critical_host.c
+  stubs/mbed_error.c
+)
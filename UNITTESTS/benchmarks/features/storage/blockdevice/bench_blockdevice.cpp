@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "benchmark.h"
+#include "HeapBlockDevice.h"
+#include "SlicingBlockDevice.h"
+#include "MBRBlockDevice.h"
+#include "BufferedBlockDevice.h"
+
+using namespace mbed;
+
+#define DEVICE_SIZE (64 * 1024)
+#define ERASE_SIZE 4096
+#define READ_SIZE 16
+
+// Small reads, as made by littlefs, through stacks of block devices
+class BenchmarkBlockDevice : public testing::Test {
+protected:
+    HeapBlockDevice *ram_bd;
+    uint8_t buffer[ERASE_SIZE];
+
+    virtual void SetUp()
+    {
+        // Contiguous, so the time is mostly that of the devices above it
+        ram_bd = new HeapBlockDevice(DEVICE_SIZE, 1, 1, ERASE_SIZE, NULL);
+        ASSERT_EQ(0, ram_bd->init());
+    }
+
+    virtual void TearDown()
+    {
+        ram_bd->deinit();
+        delete ram_bd;
+    }
+
+    void reads(BlockDevice *bd)
+    {
+        bd_size_t size = bd->size();
+        bd_addr_t addr = 0;
+        BENCHMARK_LOOP(500000) {
+            bd->read(buffer, addr, READ_SIZE);
+            addr = (addr + READ_SIZE) % size;
+        }
+        benchmark::do_not_optimize(buffer);
+    }
+
+    void block_reads(BlockDevice *bd)
+    {
+        memset(buffer, 0x5A, sizeof(buffer));
+        for (bd_addr_t addr = 0; addr < DEVICE_SIZE; addr += ERASE_SIZE) {
+            ASSERT_EQ(0, bd->program(buffer, addr, ERASE_SIZE));
+        }
+        bd_addr_t addr = 0;
+        BENCHMARK_LOOP(20000) {
+            bd->read(buffer, addr, ERASE_SIZE);
+            addr = (addr + ERASE_SIZE) % DEVICE_SIZE;
+        }
+        benchmark::do_not_optimize(buffer);
+    }
+};
+
+// Whole erase blocks, with a read size of one byte
+TEST_F(BenchmarkBlockDevice, read_block_heap)
+{
+    HeapBlockDevice heap_bd(DEVICE_SIZE, 1, 1, ERASE_SIZE);
+    ASSERT_EQ(0, heap_bd.init());
+    block_reads(&heap_bd);
+    heap_bd.deinit();
+}
+
+TEST_F(BenchmarkBlockDevice, read_block_heap_arena)
+{
+    block_reads(ram_bd);
+}
+
+TEST_F(BenchmarkBlockDevice, read_device)
+{
+    reads(ram_bd);
+}
+
+TEST_F(BenchmarkBlockDevice, read_slice)
+{
+    SlicingBlockDevice slice(ram_bd, ERASE_SIZE);
+    ASSERT_EQ(0, slice.init());
+    reads(&slice);
+    slice.deinit();
+}
+
+TEST_F(BenchmarkBlockDevice, read_slice_of_slices)
+{
+    SlicingBlockDevice outer(ram_bd, ERASE_SIZE);
+    SlicingBlockDevice middle(&outer, ERASE_SIZE);
+    SlicingBlockDevice inner(&middle, ERASE_SIZE);
+    ASSERT_EQ(0, inner.init());
+    reads(&inner);
+    inner.deinit();
+}
+
+// A partition sliced for a file system and buffered
+TEST_F(BenchmarkBlockDevice, read_buffered_slice_of_partition)
+{
+    ASSERT_EQ(0, MBRBlockDevice::partition(ram_bd, 1, 0x83, 0));
+    MBRBlockDevice partition(ram_bd, 1);
+    SlicingBlockDevice slice(&partition, ERASE_SIZE);
+    BufferedBlockDevice buffered(&slice);
+    ASSERT_EQ(0, buffered.init());
+    reads(&buffered);
+    buffered.deinit();
+}
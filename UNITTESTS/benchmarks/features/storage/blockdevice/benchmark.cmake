@@ -0,0 +1,21 @@
+
+####################
+# BENCHMARKS
+####################
+
+set(unittest-includes ${unittest-includes}
+  ../features/storage/blockdevice
+)
+
+set(benchmark-sources
+  ../features/storage/blockdevice/HeapBlockDevice.cpp
+  ../features/storage/blockdevice/SlicingBlockDevice.cpp
+  ../features/storage/blockdevice/MBRBlockDevice.cpp
+  ../features/storage/blockdevice/BufferedBlockDevice.cpp
+)
+
+set(benchmark-test-sources
+  benchmarks/features/storage/blockdevice/bench_blockdevice.cpp
+  stubs/mbed_assert_stub.c
+  benchmarks/mbed_critical_host.c
+)
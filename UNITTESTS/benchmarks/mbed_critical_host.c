@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Host implementation of the critical section and atomic functions
+ *
+ * Unlike the unittest stub, the atomic operations take effect, so the code
+ * under benchmark behaves as on target. Benchmarks run single threaded and
+ * critical sections only track their nesting. */
+
+#include "platform/mbed_critical.h"
+
+static uint32_t critical_section_nesting = 0;
+
+bool core_util_are_interrupts_enabled(void)
+{
+    return critical_section_nesting == 0;
+}
+
+bool core_util_is_isr_active(void)
+{
+    return false;
+}
+
+bool core_util_in_critical_section(void)
+{
+    return critical_section_nesting != 0;
+}
+
+void core_util_critical_section_enter(void)
+{
+    critical_section_nesting++;
+}
+
+void core_util_critical_section_exit(void)
+{
+    if (critical_section_nesting) {
+        critical_section_nesting--;
+    }
+}
+
+bool core_util_atomic_flag_test_and_set(volatile core_util_atomic_flag *flagPtr)
+{
+    return __atomic_test_and_set(&flagPtr->_flag, __ATOMIC_SEQ_CST);
+}
+
+bool core_util_atomic_cas_u8(volatile uint8_t *ptr, uint8_t *expectedCurrentValue, uint8_t desiredValue)
+{
+    return __atomic_compare_exchange_n(ptr, expectedCurrentValue, desiredValue, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+uint8_t core_util_atomic_exchange_u8(volatile uint8_t *ptr, uint8_t desiredValue)
+{
+    return __atomic_exchange_n(ptr, desiredValue, __ATOMIC_SEQ_CST);
+}
+
+uint8_t core_util_atomic_incr_u8(volatile uint8_t *valuePtr, uint8_t delta)
+{
+    return __atomic_add_fetch(valuePtr, delta, __ATOMIC_SEQ_CST);
+}
+
+uint8_t core_util_atomic_decr_u8(volatile uint8_t *valuePtr, uint8_t delta)
+{
+    return __atomic_sub_fetch(valuePtr, delta, __ATOMIC_SEQ_CST);
+}
+
+bool core_util_atomic_cas_u16(volatile uint16_t *ptr, uint16_t *expectedCurrentValue, uint16_t desiredValue)
+{
+    return __atomic_compare_exchange_n(ptr, expectedCurrentValue, desiredValue, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+uint16_t core_util_atomic_exchange_u16(volatile uint16_t *ptr, uint16_t desiredValue)
+{
+    return __atomic_exchange_n(ptr, desiredValue, __ATOMIC_SEQ_CST);
+}
+
+uint16_t core_util_atomic_incr_u16(volatile uint16_t *valuePtr, uint16_t delta)
+{
+    return __atomic_add_fetch(valuePtr, delta, __ATOMIC_SEQ_CST);
+}
+
+uint16_t core_util_atomic_decr_u16(volatile uint16_t *valuePtr, uint16_t delta)
+{
+    return __atomic_sub_fetch(valuePtr, delta, __ATOMIC_SEQ_CST);
+}
+
+bool core_util_atomic_cas_u32(volatile uint32_t *ptr, uint32_t *expectedCurrentValue, uint32_t desiredValue)
+{
+    return __atomic_compare_exchange_n(ptr, expectedCurrentValue, desiredValue, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+uint32_t core_util_atomic_exchange_u32(volatile uint32_t *ptr, uint32_t desiredValue)
+{
+    return __atomic_exchange_n(ptr, desiredValue, __ATOMIC_SEQ_CST);
+}
+
+uint32_t core_util_atomic_incr_u32(volatile uint32_t *valuePtr, uint32_t delta)
+{
+    return __atomic_add_fetch(valuePtr, delta, __ATOMIC_SEQ_CST);
+}
+
+uint32_t core_util_atomic_decr_u32(volatile uint32_t *valuePtr, uint32_t delta)
+{
+    return __atomic_sub_fetch(valuePtr, delta, __ATOMIC_SEQ_CST);
+}
+
+bool core_util_atomic_cas_u64(volatile uint64_t *ptr, uint64_t *expectedCurrentValue, uint64_t desiredValue)
+{
+    return __atomic_compare_exchange_n(ptr, expectedCurrentValue, desiredValue, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+uint64_t core_util_atomic_exchange_u64(volatile uint64_t *ptr, uint64_t desiredValue)
+{
+    return __atomic_exchange_n(ptr, desiredValue, __ATOMIC_SEQ_CST);
+}
+
+uint64_t core_util_atomic_incr_u64(volatile uint64_t *valuePtr, uint64_t delta)
+{
+    return __atomic_add_fetch(valuePtr, delta, __ATOMIC_SEQ_CST);
+}
+
+uint64_t core_util_atomic_decr_u64(volatile uint64_t *valuePtr, uint64_t delta)
+{
+    return __atomic_sub_fetch(valuePtr, delta, __ATOMIC_SEQ_CST);
+}
+
+uint64_t core_util_atomic_load_u64(const volatile uint64_t *valuePtr)
+{
+    return __atomic_load_n(valuePtr, __ATOMIC_SEQ_CST);
+}
+
+void core_util_atomic_store_u64(volatile uint64_t *valuePtr, uint64_t desiredValue)
+{
+    __atomic_store_n(valuePtr, desiredValue, __ATOMIC_SEQ_CST);
+}
+
+bool core_util_atomic_cas_ptr(void *volatile *ptr, void **expectedCurrentValue, void *desiredValue)
+{
+    return __atomic_compare_exchange_n(ptr, expectedCurrentValue, desiredValue, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+void *core_util_atomic_exchange_ptr(void *volatile *valuePtr, void *desiredValue)
+{
+    return __atomic_exchange_n(valuePtr, desiredValue, __ATOMIC_SEQ_CST);
+}
+
+void *core_util_atomic_incr_ptr(void *volatile *valuePtr, ptrdiff_t delta)
+{
+    return (void *) __atomic_add_fetch((uintptr_t volatile *) valuePtr, delta, __ATOMIC_SEQ_CST);
+}
+
+void *core_util_atomic_decr_ptr(void *volatile *valuePtr, ptrdiff_t delta)
+{
+    return (void *) __atomic_sub_fetch((uintptr_t volatile *) valuePtr, delta, __ATOMIC_SEQ_CST);
+}
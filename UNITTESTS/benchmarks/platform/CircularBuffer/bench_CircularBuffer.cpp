@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "benchmark.h"
+#include "platform/CircularBuffer.h"
+
+TEST(BenchmarkCircularBuffer, push_pop)
+{
+    mbed::CircularBuffer<int, 16> buf;
+    int data = 0;
+
+    BENCHMARK_LOOP(10000000) {
+        buf.push(data + 1);
+        buf.pop(data);
+    }
+    benchmark::do_not_optimize(data);
+}
+
+TEST(BenchmarkCircularBuffer, fill_drain)
+{
+    mbed::CircularBuffer<int, 256> buf;
+    int data = 0;
+
+    BENCHMARK_LOOP(20000) {
+        for (int i = 0; i < 256; i++) {
+            buf.push(i);
+        }
+        while (buf.pop(data)) {
+        }
+    }
+    benchmark::do_not_optimize(data);
+}
+
+TEST(BenchmarkCircularBuffer, push_pop_bulk)
+{
+    mbed::CircularBuffer<uint8_t, 256> buf;
+    uint8_t in[100] = { 0 };
+    uint8_t out[100];
+
+    BENCHMARK_LOOP(1000000) {
+        buf.push(in, sizeof(in));
+        buf.pop(out, sizeof(out));
+    }
+    benchmark::do_not_optimize(out);
+}
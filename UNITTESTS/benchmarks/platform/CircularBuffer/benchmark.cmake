@@ -0,0 +1,13 @@
+
+####################
+# BENCHMARKS
+####################
+
+set(benchmark-sources
+)
+
+set(benchmark-test-sources
+  benchmarks/platform/CircularBuffer/bench_CircularBuffer.cpp
+  stubs/mbed_assert_stub.c
+  benchmarks/mbed_critical_host.c
+)
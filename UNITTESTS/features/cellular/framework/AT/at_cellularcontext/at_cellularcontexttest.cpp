@@ -488,6 +488,13 @@ TEST_F(TestAT_CellularContext, connect_disconnect_sync)
 
     ASSERT_EQ(network_cb_count, 5);
 
+    // the kernel stub clock doesn't advance, phases reached are reported as 1 ms
+    nsapi_connection_timeline_t timeline;
+    ASSERT_EQ(ctx1.get_connection_timeline(&timeline), NSAPI_ERROR_OK);
+    EXPECT_EQ(timeline.phase_ms[NSAPI_PHASE_ADDRESS], 1);
+    EXPECT_EQ(timeline.phase_ms[NSAPI_PHASE_DNS_SERVER], 0);
+    EXPECT_EQ(timeline.phase_ms[NSAPI_PHASE_GLOBAL_UP], 1);
+
     ASSERT_EQ(ctx1.connect(), NSAPI_ERROR_IS_CONNECTED);
 
     EXPECT_TRUE(ctx1.is_connected() == true);
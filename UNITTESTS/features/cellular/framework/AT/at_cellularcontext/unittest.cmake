@@ -32,6 +32,7 @@ set(unittest-test-sources
   stubs/equeue_stub.c
   stubs/EventQueue_stub.cpp
   stubs/FileHandle_stub.cpp
+  stubs/Kernel_stub.cpp
   stubs/mbed_assert_stub.c
   stubs/NetworkInterface_stub.cpp
   stubs/NetworkInterfaceDefaults_stub.cpp
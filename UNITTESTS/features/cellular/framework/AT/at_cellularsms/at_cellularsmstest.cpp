@@ -154,6 +154,48 @@ TEST_F(TestAT_CellularSMS, test_AT_CellularSMS_get_sms)
     EXPECT_TRUE(NSAPI_ERROR_AUTH_FAILURE == sms.get_sms(buf, 16, phone, 21, stamp, 21, &size));
 }
 
+TEST_F(TestAT_CellularSMS, test_AT_CellularSMS_get_sms_concatenated)
+{
+    EventQueue que;
+    FileHandle_stub fh1;
+    ATHandler at(&fh1, que, 0, ",");
+
+    AT_CellularSMS sms(at);
+    sms.initialize(CellularSMS::CellularSMSMmodePDU);
+
+    // two 8-bit parts of the same message listed with one +CMGL, second part first
+    ATHandler_stub::read_string_table[1] = "00440B915391234567F800049110918105450011050003"
+                                           "2A0202576F726C64";
+    ATHandler_stub::read_string_table[0] = "00440B915391234567F800049110918105450011050003"
+                                           "2A020148656C6C6F";
+    ATHandler_stub::read_string_index = 2;
+    ATHandler_stub::resp_info_true_counter = 2;
+    ATHandler_stub::int_value = 40;
+
+    char buf[8];
+    int size = 0;
+    EXPECT_EQ(NSAPI_ERROR_PARAMETER, sms.get_sms(buf, sizeof(buf), NULL, 0, NULL, 0, &size));
+    EXPECT_EQ(10, size);
+
+    // more parts than the initial pool size, with newer single messages between them
+    char pdus[20][64];
+    for (int i = 0; i < 20; i++) {
+        if (i % 2) {
+            strcpy(pdus[i], "00040B915391234567F800049110918105650005");
+        } else {
+            sprintf(pdus[i], "00440B915391234567F800049110918105450011050003"
+                    "2B0A%02X48656C6C6F", i / 2 + 1);
+        }
+        ATHandler_stub::read_string_table[i] = pdus[i];
+    }
+    ATHandler_stub::read_string_index = 20;
+    ATHandler_stub::resp_info_true_counter = 20;
+    EXPECT_EQ(NSAPI_ERROR_PARAMETER, sms.get_sms(buf, sizeof(buf), NULL, 0, NULL, 0, &size));
+    EXPECT_EQ(50, size);
+
+    ATHandler_stub::read_string_index = kRead_string_table_size;
+}
+
 TEST_F(TestAT_CellularSMS, test_AT_CellularSMS_set_sms_callback)
 {
     EventQueue que;
@@ -14,6 +14,7 @@ set(unittest-includes ${unittest-includes}
 # Source files
 set(unittest-sources
   ../features/cellular/framework/AT/AT_CellularSMS.cpp
+  ../features/cellular/framework/common/CellularUtil.cpp
 )
 
 # Test files
@@ -23,8 +24,8 @@ set(unittest-test-sources
   stubs/AT_CellularBase_stub.cpp
   stubs/EventQueue_stub.cpp
   stubs/FileHandle_stub.cpp
-  stubs/CellularUtil_stub.cpp
   stubs/us_ticker_stub.cpp
   stubs/mbed_assert_stub.c
   stubs/mbed_wait_api_stub.cpp
+  stubs/randLIB_stub.cpp
 )
@@ -23,6 +23,7 @@
 #include "FileHandle_stub.h"
 #include "CellularLog.h"
 #include "mbed_poll_stub.h"
+#include "equeue_stub.h"
 
 #include "Timer_stub.h"
 
@@ -176,6 +177,133 @@ TEST_F(TestATHandler, test_ATHandler_remove_urc_handler)
     at.set_urc_handler(ch, 0);
 }
 
+static int creg_count;
+static int cereg_count;
+static int ring_count;
+
+void creg_callback()
+{
+    creg_count++;
+}
+
+void cereg_callback()
+{
+    cereg_count++;
+}
+
+void ring_callback()
+{
+    ring_count++;
+}
+
+static void process_oob_with(ATHandler &at, FileHandle_stub &fh, char *table)
+{
+    filehandle_stub_table = table;
+    filehandle_stub_table_pos = 0;
+    filehandle_stub_short_value_counter = 1;
+    fh.short_value = POLLIN;
+    mbed_poll_stub::revents_value = POLLIN;
+    mbed_poll_stub::int_value = 1;
+    at.process_oob();
+}
+
+TEST_F(TestATHandler, test_ATHandler_urc_dispatch)
+{
+    EventQueue que;
+    FileHandle_stub fh1;
+
+    ATHandler at(&fh1, que, 0, ",");
+    at.set_at_timeout(10);
+    creg_count = 0;
+    cereg_count = 0;
+    ring_count = 0;
+
+    at.set_urc_handler("+CREG:", &creg_callback);
+    at.set_urc_handler("+CEREG:", &cereg_callback);
+    // Too short to be hashed
+    at.set_urc_handler("RI", &ring_callback);
+
+    char table1[] = "+CEREG: 2\r\n\0";
+    process_oob_with(at, fh1, table1);
+    EXPECT_EQ(0, creg_count);
+    EXPECT_EQ(1, cereg_count);
+
+    char table2[] = "RI\r\n\0";
+    process_oob_with(at, fh1, table2);
+    EXPECT_EQ(1, ring_count);
+
+    char table3[] = "+CREG: 1\r\n\0";
+    process_oob_with(at, fh1, table3);
+    EXPECT_EQ(1, creg_count);
+    EXPECT_EQ(1, cereg_count);
+
+    at.set_urc_handler("+CREG:", 0);
+    at.set_urc_handler("RI", 0);
+    process_oob_with(at, fh1, table3);
+    process_oob_with(at, fh1, table2);
+    EXPECT_EQ(1, creg_count);
+    EXPECT_EQ(1, ring_count);
+
+    filehandle_stub_table = NULL;
+    filehandle_stub_table_pos = 0;
+}
+
+static int csq_rssi;
+static nsapi_error_t csq_err;
+static int csq_done_count;
+
+void csq_parse(ATHandler &at)
+{
+    csq_rssi = at.read_int();
+}
+
+void csq_done(nsapi_error_t err)
+{
+    csq_err = err;
+    csq_done_count++;
+}
+
+TEST_F(TestATHandler, test_ATHandler_queue_cmd)
+{
+    EventQueue que;
+    FileHandle_stub fh1;
+
+    ATHandler at(&fh1, que, 0, ",");
+    csq_rssi = -1;
+    csq_err = NSAPI_ERROR_OK;
+    csq_done_count = 0;
+
+    // No room in the event queue
+    equeue_stub.void_ptr = NULL;
+    equeue_stub.call_cb_immediately = false;
+    EXPECT_EQ(NSAPI_ERROR_NO_MEMORY, at.queue_cmd("AT+CSQ", "+CSQ:", csq_parse, csq_done));
+    EXPECT_EQ(0, csq_done_count);
+
+    char table[] = "+CSQ: 20,99\r\nOK\r\n\0";
+    filehandle_stub_table = table;
+    filehandle_stub_table_pos = 0;
+    fh1.size_value = 10;
+    mbed_poll_stub::revents_value = POLLIN | POLLOUT;
+    mbed_poll_stub::int_value = 1;
+    struct equeue_event ptr;
+    equeue_stub.void_ptr = &ptr;
+    equeue_stub.call_cb_immediately = true;
+    EXPECT_EQ(NSAPI_ERROR_OK, at.queue_cmd("AT+CSQ", "+CSQ:", csq_parse, csq_done));
+    EXPECT_EQ(1, csq_done_count);
+    EXPECT_EQ(NSAPI_ERROR_OK, csq_err);
+    EXPECT_EQ(20, csq_rssi);
+
+    // No response
+    filehandle_stub_table = NULL;
+    filehandle_stub_table_pos = 0;
+    EXPECT_EQ(NSAPI_ERROR_OK, at.queue_cmd("AT+CSQ", "+CSQ:", csq_parse, csq_done));
+    EXPECT_EQ(2, csq_done_count);
+    EXPECT_EQ(NSAPI_ERROR_DEVICE_ERROR, csq_err);
+
+    equeue_stub.void_ptr = NULL;
+    equeue_stub.call_cb_immediately = false;
+}
+
 TEST_F(TestATHandler, test_ATHandler_get_last_error)
 {
     EventQueue que;
@@ -544,7 +672,7 @@ TEST_F(TestATHandler, test_ATHandler_read_bytes)
     filehandle_stub_table_pos = 0;
 
     ATHandler at(&fh1, que, 0, ",");
-    uint8_t buf[5];
+    uint8_t buf[8];
 
     // TEST EMPTY BUFFER
     // Shouldn't read any byte since buffer is empty
@@ -573,6 +701,36 @@ TEST_F(TestATHandler, test_ATHandler_read_bytes)
     EXPECT_TRUE(NSAPI_ERROR_DEVICE_ERROR == at.get_last_error());
 }
 
+TEST_F(TestATHandler, test_ATHandler_read_bytes_direct)
+{
+    EventQueue que;
+    FileHandle_stub fh1;
+    filehandle_stub_table = NULL;
+    filehandle_stub_table_pos = 0;
+
+    ATHandler at(&fh1, que, 0, ",");
+    uint8_t buf[40];
+
+    char table1[] = "12345678901234567890123456789012345OK\r\n\0";
+    filehandle_stub_table = table1;
+    filehandle_stub_table_pos = 0;
+    mbed_poll_stub::revents_value = POLLIN;
+    mbed_poll_stub::int_value = 1;
+
+    // Fills the receiving buffer
+    EXPECT_TRUE(2 == at.read_bytes(buf, 2));
+    EXPECT_TRUE(filehandle_stub_table_pos == 16);
+    // Copies the rest of the receiving buffer, then reads straight to buf only what was asked
+    EXPECT_TRUE(33 == at.read_bytes(buf, 33));
+    EXPECT_TRUE(!memcmp(buf, table1 + 2, 33));
+    EXPECT_TRUE(filehandle_stub_table_pos == 35);
+    EXPECT_TRUE(NSAPI_ERROR_OK == at.get_last_error());
+
+    // Reading more than the 4 bytes left -> ERROR
+    EXPECT_TRUE(-1 == at.read_bytes(buf, 20));
+    EXPECT_TRUE(NSAPI_ERROR_DEVICE_ERROR == at.get_last_error());
+}
+
 TEST_F(TestATHandler, test_ATHandler_read_string)
 {
     EventQueue que;
@@ -626,7 +784,7 @@ TEST_F(TestATHandler, test_ATHandler_read_string)
     filehandle_stub_table_pos = 0;
     mbed_poll_stub::revents_value = POLLIN;
     mbed_poll_stub::int_value = 1;
-    char buf3[1];
+    char buf3[2];
     // Set _stop_tag to resp_stop(OKCRLF)
     at.resp_start();
     // OK because after CRLF matched there is more data to read ending in CRLF
@@ -749,7 +907,7 @@ TEST_F(TestATHandler, test_ATHandler_read_string)
     filehandle_stub_table_pos = 0;
     mbed_poll_stub::revents_value = POLLIN;
     mbed_poll_stub::int_value = 1;
-    char buf9[5];
+    char buf9[7];
 
     // NO prefix, NO OK, NO ERROR and NO URC match, CRLF found -> return so buffer could be read
     at.resp_start();
@@ -1200,3 +1358,78 @@ TEST_F(TestATHandler, test_ATHandler_get_3gpp_error)
     at.get_3gpp_error();
 }
 
+
+static int power_save_wakeups;
+static int power_save_sleeps;
+
+static void power_save_cb(bool awake)
+{
+    if (awake) {
+        power_save_wakeups++;
+    } else {
+        power_save_sleeps++;
+    }
+}
+
+TEST_F(TestATHandler, test_ATHandler_power_save)
+{
+    EventQueue que;
+    FileHandle_stub fh1;
+
+    ATHandler at(&fh1, que, 0, ",");
+    power_save_wakeups = 0;
+    power_save_sleeps = 0;
+
+    struct equeue_event ptr;
+    equeue_stub.void_ptr = &ptr;
+    equeue_stub.call_cb_immediately = true;
+    mbed_poll_stub::revents_value = POLLOUT;
+    mbed_poll_stub::int_value = 1;
+    fh1.size_value = 10;
+
+    // without a callback the modem is never put to sleep
+    at.lock();
+    at.cmd_start("AT");
+    at.cmd_stop();
+    at.unlock();
+    EXPECT_EQ(0, power_save_wakeups);
+
+    at.set_power_save_callback(&power_save_cb, 0);
+
+    // one wake window for the commands sent under the same lock
+    at.lock();
+    at.cmd_start("AT");
+    at.cmd_stop();
+    at.cmd_start("AT");
+    at.cmd_stop();
+    EXPECT_EQ(1, power_save_wakeups);
+    EXPECT_EQ(0, power_save_sleeps);
+    at.unlock();
+    EXPECT_EQ(1, power_save_sleeps);
+
+    ATHandler::power_save_stats_t stats;
+    at.get_power_save_stats(&stats);
+    EXPECT_EQ(1, stats.wakeups);
+    EXPECT_EQ(2, stats.commands);
+    EXPECT_EQ(2, stats.last_commands);
+
+    // the modem stays awake while the file handle is in data mode
+    at.set_is_filehandle_usable(false);
+    at.lock();
+    at.cmd_start("AT");
+    at.cmd_stop();
+    at.unlock();
+    EXPECT_EQ(2, power_save_wakeups);
+    EXPECT_EQ(1, power_save_sleeps);
+
+    // removing the callback closes the window without notifying
+    at.set_power_save_callback(NULL, 0);
+    at.get_power_save_stats(&stats);
+    EXPECT_EQ(2, stats.wakeups);
+    EXPECT_EQ(3, stats.commands);
+    EXPECT_EQ(1, stats.last_commands);
+    EXPECT_EQ(1, power_save_sleeps);
+
+    equeue_stub.void_ptr = NULL;
+    equeue_stub.call_cb_immediately = false;
+}
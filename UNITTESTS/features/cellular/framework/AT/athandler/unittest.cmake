@@ -35,5 +35,5 @@ set(unittest-test-sources
   stubs/randLIB_stub.cpp
 )
 
-set(CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -DMBED_CONF_CELLULAR_DEBUG_AT=true -DOS_STACK_SIZE=2048")
-set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DMBED_CONF_CELLULAR_DEBUG_AT=true -DOS_STACK_SIZE=2048")
+set(CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -DMBED_CONF_CELLULAR_DEBUG_AT=true -DMBED_CONF_CELLULAR_AT_HANDLER_BUFFER_SIZE=16 -DOS_STACK_SIZE=2048")
+set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DMBED_CONF_CELLULAR_DEBUG_AT=true -DMBED_CONF_CELLULAR_AT_HANDLER_BUFFER_SIZE=16 -DOS_STACK_SIZE=2048")
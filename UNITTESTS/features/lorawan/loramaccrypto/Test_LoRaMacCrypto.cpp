@@ -84,6 +84,27 @@ TEST_F(Test_LoRaMacCrypto, compute_mic)
 
 }
 
+TEST_F(Test_LoRaMacCrypto, compute_mic_reuses_key)
+{
+    uint8_t key[16] = {1};
+    uint8_t other_key[16] = {2};
+    uint32_t mic;
+
+    mbedtls_cipher_info_t info;
+    cipher_stub.info_value = &info;
+    EXPECT_TRUE(0 == object->compute_mic(NULL, 0, key, 128, 0, 0, 0, &mic));
+
+    // Same key, the cipher is not set up again
+    cipher_stub.int_value = -1;
+    EXPECT_TRUE(0 == object->compute_mic(NULL, 0, key, 128, 0, 0, 1, &mic));
+
+    EXPECT_TRUE(-1 == object->compute_mic(NULL, 0, other_key, 128, 0, 0, 0, &mic));
+
+    cipher_stub.int_value = 0;
+    cmac_stub.int_value = -1;
+    EXPECT_TRUE(-1 == object->compute_mic(NULL, 0, key, 128, 0, 0, 0, &mic));
+}
+
 TEST_F(Test_LoRaMacCrypto, encrypt_payload)
 {
     aes_stub.int_zero_counter = 0;
@@ -109,6 +130,24 @@ TEST_F(Test_LoRaMacCrypto, encrypt_payload)
     EXPECT_TRUE(0 == object->encrypt_payload(NULL, 0, NULL, 0, 0, 0, 0, NULL));
 }
 
+TEST_F(Test_LoRaMacCrypto, encrypt_payload_reuses_key)
+{
+    uint8_t key[16] = {1};
+    uint8_t other_key[16] = {2};
+    uint8_t buf[10];
+    uint8_t enc[10];
+
+    EXPECT_TRUE(0 == object->encrypt_payload(buf, 10, key, 128, 0, 0, 0, enc));
+
+    // Only the block encryption may run, the key schedule is kept
+    aes_stub.int_zero_counter = 1;
+    aes_stub.int_value = -1;
+    EXPECT_TRUE(0 == object->encrypt_payload(buf, 10, key, 128, 0, 0, 1, enc));
+
+    aes_stub.int_zero_counter = 1;
+    EXPECT_TRUE(-1 == object->encrypt_payload(buf, 10, other_key, 128, 0, 0, 0, enc));
+}
+
 TEST_F(Test_LoRaMacCrypto, decrypt_payload)
 {
     EXPECT_TRUE(0 == object->decrypt_payload(NULL, 0, NULL, 0, 0, 0, 0, NULL));
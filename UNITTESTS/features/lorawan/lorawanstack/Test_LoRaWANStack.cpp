@@ -431,6 +431,37 @@ TEST_F(Test_LoRaWANStack, handle_tx)
 
 }
 
+#if MBED_CONF_LORA_UPLINK_COALESCING
+TEST_F(Test_LoRaWANStack, handle_tx_coalescing)
+{
+    EventQueue queue;
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->initialize_mac_layer(&queue));
+
+    lorawan_connect_t conn;
+    conn.connect_type = LORAWAN_CONNECTION_ABP;
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->connect(conn));
+
+    // TX ongoing, 8 bytes fit in the next frame
+    uint8_t data[8] = {};
+    LoRaMac_stub::bool_false_counter = 0;
+    LoRaMac_stub::bool_true_counter = 0;
+    LoRaMac_stub::bool_value = true;
+    LoRaMac_stub::uint8_value = 8;
+    EXPECT_TRUE(4 == object->handle_tx(1, data, 4, MSG_UNCONFIRMED_FLAG));
+
+    // Other port or confirmed messages are not queued
+    EXPECT_TRUE(LORAWAN_STATUS_WOULD_BLOCK == object->handle_tx(2, data, 4, MSG_UNCONFIRMED_FLAG));
+    EXPECT_TRUE(LORAWAN_STATUS_WOULD_BLOCK == object->handle_tx(1, data, 4, MSG_CONFIRMED_FLAG));
+
+    EXPECT_TRUE(4 == object->handle_tx(1, data, 4, MSG_UNCONFIRMED_FLAG));
+
+    // Frame is full
+    EXPECT_TRUE(LORAWAN_STATUS_WOULD_BLOCK == object->handle_tx(1, data, 1, MSG_UNCONFIRMED_FLAG));
+
+    LoRaMac_stub::uint8_value = 1;
+}
+#endif
+
 TEST_F(Test_LoRaWANStack, handle_rx)
 {
     uint8_t port;
@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Nanostack configuration of the unit tests, selected with NSCONFIG=unittest.
+ * Optional features stay disabled, so only the code under test is needed. */
+
+#ifndef _CFG_UNITTEST_H_
+#define _CFG_UNITTEST_H_
+
+#endif /* _CFG_UNITTEST_H_ */
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include <ctime>
+#include <cstdio>
+#include <cstring>
+
+extern "C" {
+#include "ns_types.h"
+#include "ns_list.h"
+#include "common_functions.h"
+#include "ipv6_stack/ipv6_routing_table.h"
+
+// Cache returned by ipv6_neighbour_cache_by_interface_id(). See ipv6_resolution_stub.c
+extern ipv6_neighbour_cache_t *ipv6_resolution_stub_cache;
+}
+
+#define INTERFACE_ID 1
+
+// Largest number of nodes of the forwarding benchmark
+#define BENCH_MAX_NODES 512
+
+// Lookups timed for each number of nodes
+#define BENCH_LOOKUPS 100000
+
+static const uint8_t mesh_prefix[8] = { 0xfd, 0x00, 0x0d, 0xb8, 0, 0, 0, 0 };
+static const uint8_t new_mesh_prefix[8] = { 0xfd, 0x00, 0x0d, 0xb8, 0, 0, 0, 1 };
+static const uint8_t link_local_prefix[8] = { 0xfe, 0x80, 0, 0, 0, 0, 0, 0 };
+
+// Address of a mesh node, with an interface identifier derived from a
+// 16-bit short address as 6LoWPAN does
+static void node_address(uint8_t address[16], const uint8_t prefix[8], uint16_t node)
+{
+    memcpy(address, prefix, 8);
+    memcpy(address + 8, "\x00\x00\x00\xff\xfe\x00", 6);
+    common_write_16_bit(node, address + 14);
+}
+
+class Test_ipv6_routing_table : public testing::Test {
+protected:
+    ipv6_neighbour_cache_t cache;
+
+    virtual void SetUp()
+    {
+        memset(&cache, 0, sizeof(cache));
+        ns_list_init(&cache.list);
+        ipv6_neighbour_cache_init(&cache, INTERFACE_ID);
+        ipv6_resolution_stub_cache = &cache;
+        ipv6_neighbour_set_current_max_cache(2 * BENCH_MAX_NODES);
+    }
+
+    virtual void TearDown()
+    {
+        ipv6_neighbour_cache_init(&cache, INTERFACE_ID);
+        ipv6_resolution_stub_cache = NULL;
+        ipv6_neighbour_set_current_max_cache(64);
+    }
+};
+
+TEST_F(Test_ipv6_routing_table, neighbour_lookup)
+{
+    uint8_t address[16];
+    ipv6_neighbour_t *entries[200];
+
+    for (int i = 0; i < 200; i++) {
+        node_address(address, mesh_prefix, i);
+        entries[i] = ipv6_neighbour_lookup_or_create(&cache, address);
+        ASSERT_TRUE(entries[i] != NULL);
+    }
+    EXPECT_EQ(200, cache.num_entries);
+
+    for (int i = 0; i < 200; i++) {
+        node_address(address, mesh_prefix, i);
+        EXPECT_EQ(entries[i], ipv6_neighbour_lookup(&cache, address));
+        EXPECT_EQ(entries[i], ipv6_neighbour_lookup_or_create(&cache, address));
+    }
+    EXPECT_EQ(200, cache.num_entries);
+
+    // Same interface identifier, other prefix
+    node_address(address, link_local_prefix, 0);
+    EXPECT_TRUE(ipv6_neighbour_lookup(&cache, address) == NULL);
+    node_address(address, mesh_prefix, 200);
+    EXPECT_TRUE(ipv6_neighbour_lookup(&cache, address) == NULL);
+}
+
+TEST_F(Test_ipv6_routing_table, neighbour_remove)
+{
+    uint8_t address[16];
+
+    for (int i = 0; i < 100; i++) {
+        node_address(address, mesh_prefix, i);
+        ASSERT_TRUE(ipv6_neighbour_lookup_or_create(&cache, address) != NULL);
+    }
+
+    for (int i = 0; i < 100; i += 2) {
+        node_address(address, mesh_prefix, i);
+        ipv6_neighbour_entry_remove(&cache, ipv6_neighbour_lookup(&cache, address));
+    }
+    EXPECT_EQ(50, cache.num_entries);
+
+    for (int i = 0; i < 100; i++) {
+        node_address(address, mesh_prefix, i);
+        ipv6_neighbour_t *entry = ipv6_neighbour_lookup(&cache, address);
+        if (i % 2) {
+            ASSERT_TRUE(entry != NULL);
+            EXPECT_EQ(0, memcmp(entry->ip_address, address, 16));
+        } else {
+            EXPECT_TRUE(entry == NULL);
+        }
+    }
+
+    ipv6_neighbour_cache_init(&cache, INTERFACE_ID);
+    EXPECT_EQ(0, cache.num_entries);
+    node_address(address, mesh_prefix, 1);
+    EXPECT_TRUE(ipv6_neighbour_lookup(&cache, address) == NULL);
+}
+
+TEST_F(Test_ipv6_routing_table, neighbour_eviction)
+{
+    uint8_t address[16];
+
+    ipv6_neighbour_set_current_max_cache(8);
+    for (int i = 0; i < 8; i++) {
+        node_address(address, mesh_prefix, i);
+        ASSERT_TRUE(ipv6_neighbour_lookup_or_create(&cache, address) != NULL);
+    }
+
+    // Node 0 becomes the most recently used, so node 1 is evicted
+    node_address(address, mesh_prefix, 0);
+    ipv6_neighbour_lookup_or_create(&cache, address);
+    node_address(address, mesh_prefix, 8);
+    ASSERT_TRUE(ipv6_neighbour_lookup_or_create(&cache, address) != NULL);
+
+    EXPECT_EQ(8, cache.num_entries);
+    node_address(address, mesh_prefix, 1);
+    EXPECT_TRUE(ipv6_neighbour_lookup(&cache, address) == NULL);
+    node_address(address, mesh_prefix, 0);
+    EXPECT_TRUE(ipv6_neighbour_lookup(&cache, address) != NULL);
+}
+
+TEST_F(Test_ipv6_routing_table, neighbour_prefix_change)
+{
+    uint8_t address[16];
+
+    node_address(address, mesh_prefix, 42);
+    ipv6_neighbour_t *entry = ipv6_neighbour_lookup_or_create(&cache, address);
+    ASSERT_TRUE(entry != NULL);
+
+    // Thread updates the mesh local prefix of entries in place
+    memcpy(entry->ip_address, new_mesh_prefix, 8);
+
+    EXPECT_TRUE(ipv6_neighbour_lookup(&cache, address) == NULL);
+    node_address(address, new_mesh_prefix, 42);
+    EXPECT_EQ(entry, ipv6_neighbour_lookup(&cache, address));
+}
+
+TEST_F(Test_ipv6_routing_table, destination_lookup)
+{
+    uint8_t address[16];
+
+    node_address(address, mesh_prefix, 1000);
+    ipv6_destination_t *dest = ipv6_destination_lookup_or_create(address, INTERFACE_ID);
+    ASSERT_TRUE(dest != NULL);
+    EXPECT_EQ(dest, ipv6_destination_lookup_or_create(address, INTERFACE_ID));
+    EXPECT_EQ(dest, ipv6_destination_lookup_or_create(address, INTERFACE_ID + 1));
+
+    // Link-local destinations are specific to their interface
+    node_address(address, link_local_prefix, 1000);
+    ipv6_destination_t *ll_dest = ipv6_destination_lookup_or_create(address, INTERFACE_ID);
+    ASSERT_TRUE(ll_dest != NULL);
+    EXPECT_NE(dest, ll_dest);
+    EXPECT_EQ(ll_dest, ipv6_destination_lookup_or_create(address, INTERFACE_ID));
+    ipv6_destination_t *other_dest = ipv6_destination_lookup_or_create(address, INTERFACE_ID + 1);
+    ASSERT_TRUE(other_dest != NULL);
+    EXPECT_NE(ll_dest, other_dest);
+    EXPECT_TRUE(ipv6_destination_lookup_or_create(address, -1) == NULL);
+}
+
+// Per packet look-ups of a border router forwarding to mesh nodes: the
+// Destination Cache entry of the packet, then the Neighbour Cache entry of
+// the next hop
+TEST_F(Test_ipv6_routing_table, bench_forwarding_lookups)
+{
+    static const int node_counts[] = { 16, 64, 256, BENCH_MAX_NODES };
+    uint8_t address[16];
+
+    for (size_t n = 0; n < sizeof(node_counts) / sizeof(node_counts[0]); n++) {
+        int nodes = node_counts[n];
+
+        ipv6_neighbour_cache_init(&cache, INTERFACE_ID);
+        for (int i = 0; i < nodes; i++) {
+            node_address(address, mesh_prefix, i);
+            ASSERT_TRUE(ipv6_neighbour_lookup_or_create(&cache, address) != NULL);
+            ASSERT_TRUE(ipv6_destination_lookup_or_create(address, INTERFACE_ID) != NULL);
+        }
+
+        int found = 0;
+        clock_t start = clock();
+        for (int i = 0; i < BENCH_LOOKUPS; i++) {
+            // Stride through the nodes, so the most recently used ones
+            // at the start of the lists are no shortcut
+            node_address(address, mesh_prefix, (i * 7) % nodes);
+            if (ipv6_destination_lookup_or_create(address, INTERFACE_ID) &&
+                    ipv6_neighbour_lookup(&cache, address)) {
+                found++;
+            }
+        }
+        clock_t ticks = clock() - start;
+        EXPECT_EQ(BENCH_LOOKUPS, found);
+
+        printf("[ BENCH    ] forwarding lookups, %d nodes: %.1f ns per packet\n", nodes,
+               (double)ticks * 1e9 / CLOCKS_PER_SEC / BENCH_LOOKUPS);
+    }
+}
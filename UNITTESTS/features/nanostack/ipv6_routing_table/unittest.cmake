@@ -0,0 +1,30 @@
+####################
+# UNIT TESTS
+####################
+
+# Add test specific include paths
+set(unittest-includes ${unittest-includes}
+  features/nanostack/ipv6_routing_table
+  ../features/nanostack/sal-stack-nanostack/source
+  ../features/nanostack/sal-stack-nanostack/nanostack
+  ../features/frameworks/mbed-client-randlib/mbed-client-randlib
+)
+
+set(unittest-sources
+  ../features/nanostack/sal-stack-nanostack/source/ipv6_stack/ipv6_routing_table.c
+  ../features/frameworks/nanostack-libservice/source/libList/ns_list.c
+  ../features/frameworks/nanostack-libservice/source/libBits/common_functions.c
+  ../features/frameworks/nanostack-libservice/source/libip6string/ip6tos.c
+)
+
+set(unittest-test-sources
+  features/nanostack/ipv6_routing_table/test_ipv6_routing_table.cpp
+  stubs/address_stub.c
+  stubs/etx_stub.c
+  stubs/ipv6_resolution_stub.c
+  stubs/nsdynmemLIB_stub.c
+  stubs/protocol_core_stub.c
+  stubs/randLIB_stub.c
+)
+
+set_source_files_properties(../features/nanostack/sal-stack-nanostack/source/ipv6_stack/ipv6_routing_table.c PROPERTIES COMPILE_DEFINITIONS NSCONFIG=unittest)
@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Nanostack configuration of the unit tests, selected with NSCONFIG=unittest.
+ * MPL is built as a forwarder. */
+
+#ifndef _CFG_UNITTEST_H_
+#define _CFG_UNITTEST_H_
+
+#define HAVE_MPL
+
+#endif /* _CFG_UNITTEST_H_ */
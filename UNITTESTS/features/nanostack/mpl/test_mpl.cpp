@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include <cstring>
+#include <cstdlib>
+#include <vector>
+
+extern "C" {
+#include "nsconfig.h"
+#include "ns_types.h"
+#include "ns_list.h"
+#include "common_functions.h"
+#include "Core/include/ns_buffer.h"
+#include "Core/include/address.h"
+#include "NWK_INTERFACE/Include/protocol.h"
+#include "Common_Protocols/ipv6_constants.h"
+#include "Service_Libs/Trickle/trickle.h"
+#include "MPL/mpl.h"
+
+// See protocol_core_stub.c, protocol_timer_stub.c and ipv6_stub.c
+extern uint32_t protocol_core_monotonic_time;
+extern struct buffer *protocol_core_stub_pushed;
+extern void (*protocol_timer_stub_callback)(uint16_t ticks);
+extern int ipv6_stub_multicast_count;
+}
+
+#define SEED_LIFETIME 600
+
+static const uint8_t domain_address[16] = { 0xff, 0x05, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01 };
+
+// Intervals of one tick, so the trickle timers run on each timer call
+static const trickle_params_t data_params = { 1, 1, 1, 3 };
+static const trickle_params_t control_params = { 1, 1, 1, 10 };
+
+static void seed_address(uint8_t address[16], uint16_t seed)
+{
+    memset(address, 0, 16);
+    address[0] = 0xfd;
+    common_write_16_bit(seed, address + 14);
+}
+
+class Test_mpl : public testing::Test {
+protected:
+    protocol_interface_info_entry_t *cur;
+    mpl_domain_t *domain;
+
+    virtual void SetUp()
+    {
+        cur = (protocol_interface_info_entry_t *)calloc(1, sizeof(protocol_interface_info_entry_t));
+        domain = mpl_domain_create(cur, domain_address, NULL, MULTICAST_MPL_SEED_ID_IPV6_SRC_FOR_DOMAIN,
+                                   1, SEED_LIFETIME, &data_params, &control_params);
+        ASSERT_TRUE(domain != NULL);
+        protocol_core_monotonic_time = 0;
+        ipv6_stub_multicast_count = 0;
+    }
+
+    virtual void TearDown()
+    {
+        EXPECT_TRUE(mpl_domain_delete(cur, domain_address));
+        EXPECT_TRUE(mpl_domain_delete(cur, ADDR_ALL_MPL_FORWARDERS));
+        free(cur);
+        buffer_free(protocol_core_stub_pushed);
+        protocol_core_stub_pushed = NULL;
+    }
+
+    // Multicast from the seed, returns true if it was accepted as new
+    bool receive(uint16_t seed, uint8_t sequence, uint16_t size = 48)
+    {
+        buffer_t *buf = buffer_get(size);
+        uint8_t *ptr = buffer_data_pointer(buf);
+        memset(ptr, 0, size);
+        ptr[0] = 0x60;
+        common_write_16_bit(size - IPV6_HDRLEN, ptr + IPV6_HDROFF_PAYLOAD_LENGTH);
+        ptr[IPV6_HDROFF_NH] = IPV6_NH_HOP_BY_HOP;
+        ptr[IPV6_HDROFF_HOP_LIMIT] = 64;
+        seed_address(ptr + IPV6_HDROFF_SRC_ADDR, seed);
+        memcpy(ptr + IPV6_HDROFF_DST_ADDR, domain_address, 16);
+        uint8_t *ext = ptr + IPV6_HDRLEN;
+        ext[0] = IPV6_NH_NONE;
+        ext[2] = IPV6_OPTION_MPL;
+        ext[3] = 2;
+        ext[5] = sequence;
+        ext[6] = IPV6_OPTION_PADN;
+        buffer_data_length_set(buf, size);
+
+        buf->interface = cur;
+        buf->mpl_option_data_offset = IPV6_HDRLEN + 4;
+        buf->src_sa.addr_type = ADDR_IPV6;
+        memcpy(buf->src_sa.address, ptr + IPV6_HDROFF_SRC_ADDR, 16);
+        buf->dst_sa.addr_type = ADDR_IPV6;
+        memcpy(buf->dst_sa.address, domain_address, 16);
+
+        protocol_core_monotonic_time++;
+        bool accepted = mpl_forwarder_process_message(buf, domain, false);
+        buffer_free(buf);
+        return accepted;
+    }
+
+    // Runs the MPL timer for a tick, returns the payload of the control
+    // message sent, if any
+    std::vector<uint8_t> run_timer()
+    {
+        std::vector<uint8_t> control;
+        buffer_free(protocol_core_stub_pushed);
+        protocol_core_stub_pushed = NULL;
+        protocol_timer_stub_callback(1);
+        if (protocol_core_stub_pushed) {
+            buffer_t *buf = protocol_core_stub_pushed;
+            control.assign(buffer_data_pointer(buf), buffer_data_end(buf));
+            buffer_free(buf);
+            protocol_core_stub_pushed = NULL;
+        }
+        return control;
+    }
+};
+
+TEST_F(Test_mpl, new_and_repeated)
+{
+    for (int seed = 1; seed <= 20; seed++) {
+        for (int sequence = 0; sequence < 2; sequence++) {
+            EXPECT_TRUE(receive(seed, sequence));
+        }
+    }
+    for (int seed = 1; seed <= 20; seed++) {
+        for (int sequence = 0; sequence < 2; sequence++) {
+            EXPECT_FALSE(receive(seed, sequence));
+        }
+    }
+}
+
+TEST_F(Test_mpl, out_of_order)
+{
+    EXPECT_TRUE(receive(1, 10));
+    EXPECT_TRUE(receive(1, 13));
+    EXPECT_TRUE(receive(1, 12));
+    EXPECT_FALSE(receive(1, 12));
+    EXPECT_FALSE(receive(1, 13));
+    EXPECT_TRUE(receive(1, 11));
+    EXPECT_FALSE(receive(1, 11));
+    // Older than MinSequence
+    EXPECT_FALSE(receive(1, 9));
+}
+
+TEST_F(Test_mpl, control_bitmap)
+{
+    EXPECT_TRUE(receive(1, 10));
+    EXPECT_TRUE(receive(1, 12));
+    EXPECT_TRUE(receive(1, 13));
+
+    std::vector<uint8_t> control = run_timer();
+    ASSERT_EQ(2 + 16 + 1, control.size());
+    EXPECT_EQ(10, control[0]);
+    EXPECT_EQ((1 << 2) | 3, control[1]);
+    uint8_t id[16];
+    seed_address(id, 1);
+    EXPECT_EQ(0, memcmp(&control[2], id, 16));
+    EXPECT_EQ(0xB0, control[18]);
+}
+
+TEST_F(Test_mpl, beyond_window)
+{
+    EXPECT_TRUE(receive(1, 0));
+    EXPECT_TRUE(receive(1, 70));
+    EXPECT_FALSE(receive(1, 70));
+    EXPECT_TRUE(receive(1, 69));
+    EXPECT_TRUE(receive(1, 5));
+    EXPECT_FALSE(receive(1, 5));
+
+    std::vector<uint8_t> control = run_timer();
+    ASSERT_EQ(2 + 16 + 9, control.size());
+    EXPECT_EQ(0, control[0]);
+    EXPECT_EQ((9 << 2) | 3, control[1]);
+    const uint8_t bitmap[9] = { 0x84, 0, 0, 0, 0, 0, 0, 0, 0x06 };
+    EXPECT_EQ(0, memcmp(&control[18], bitmap, 9));
+}
+
+TEST_F(Test_mpl, buffer_full)
+{
+    // 2048 bytes are buffered, the 11th message frees the oldest
+    for (int sequence = 0; sequence <= 10; sequence++) {
+        EXPECT_TRUE(receive(1, sequence, 200));
+    }
+    EXPECT_FALSE(receive(1, 0, 200));
+    EXPECT_FALSE(receive(1, 1, 200));
+
+    std::vector<uint8_t> control = run_timer();
+    ASSERT_EQ(2 + 16 + 2, control.size());
+    EXPECT_EQ(1, control[0]);
+    EXPECT_EQ(0xFF, control[18]);
+    EXPECT_EQ(0xC0, control[19]);
+}
+
+TEST_F(Test_mpl, message_expiry)
+{
+    EXPECT_TRUE(receive(1, 0));
+    EXPECT_TRUE(receive(1, 1));
+    EXPECT_TRUE(receive(1, 2));
+
+    // Transmitted until the data trickle timers stop
+    for (int i = 0; i < 10; i++) {
+        run_timer();
+    }
+    EXPECT_EQ(3 * 3, ipv6_stub_multicast_count);
+
+    protocol_core_monotonic_time += 600;
+    mpl_slow_timer(1);
+    EXPECT_FALSE(receive(1, 2));
+    EXPECT_TRUE(receive(1, 3));
+
+    std::vector<uint8_t> control = run_timer();
+    ASSERT_EQ(2 + 16 + 1, control.size());
+    EXPECT_EQ(3, control[0]);
+    EXPECT_EQ(0x80, control[18]);
+}
+
+TEST_F(Test_mpl, seed_expiry)
+{
+    for (int seed = 1; seed <= 40; seed++) {
+        EXPECT_TRUE(receive(seed, 5));
+    }
+    mpl_slow_timer(SEED_LIFETIME / 2);
+    for (int seed = 1; seed <= 40; seed += 2) {
+        EXPECT_TRUE(receive(seed, 6));
+    }
+
+    // Seeds not heard from in their lifetime are forgotten
+    mpl_slow_timer(SEED_LIFETIME / 2);
+    for (int seed = 1; seed <= 40; seed++) {
+        if (seed & 1) {
+            EXPECT_FALSE(receive(seed, 6));
+        } else {
+            EXPECT_TRUE(receive(seed, 5));
+        }
+    }
+}
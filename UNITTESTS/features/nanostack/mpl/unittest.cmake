@@ -0,0 +1,41 @@
+####################
+# UNIT TESTS
+####################
+
+# Add test specific include paths
+set(unittest-includes ${unittest-includes}
+  features/nanostack/mpl
+  ../features/nanostack/sal-stack-nanostack/source
+  ../features/nanostack/sal-stack-nanostack/nanostack
+  ../features/nanostack/sal-stack-nanostack-eventloop/nanostack-event-loop
+  ../features/frameworks/mbed-client-randlib/mbed-client-randlib
+)
+
+set(unittest-sources
+  ../features/nanostack/sal-stack-nanostack/source/MPL/mpl.c
+  ../features/nanostack/sal-stack-nanostack/source/Service_Libs/Trickle/trickle.c
+  ../features/frameworks/nanostack-libservice/source/libList/ns_list.c
+  ../features/frameworks/nanostack-libservice/source/libBits/common_functions.c
+  ../features/frameworks/nanostack-libservice/source/libip6string/ip6tos.c
+)
+
+set(unittest-test-sources
+  features/nanostack/mpl/test_mpl.cpp
+  stubs/address_stub.c
+  stubs/buffer_dyn_stub.c
+  stubs/ipv6_stub.c
+  stubs/mac_helper_stub.c
+  stubs/nsdynmemLIB_stub.c
+  stubs/protocol_core_stub.c
+  stubs/protocol_timer_stub.c
+  stubs/randLIB_stub.c
+)
+
+set_source_files_properties(
+  ../features/nanostack/sal-stack-nanostack/source/MPL/mpl.c
+  ../features/nanostack/sal-stack-nanostack/source/Service_Libs/Trickle/trickle.c
+  features/nanostack/mpl/test_mpl.cpp
+  stubs/buffer_dyn_stub.c
+  stubs/ipv6_stub.c
+  stubs/protocol_timer_stub.c
+  PROPERTIES COMPILE_DEFINITIONS NSCONFIG=unittest)
@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Nanostack configuration of the unit tests, selected with NSCONFIG=unittest.
+ * RPL is built as a border router in storing and non-storing modes. */
+
+#ifndef _CFG_UNITTEST_H_
+#define _CFG_UNITTEST_H_
+
+#define HAVE_RPL
+#define HAVE_RPL_ROOT
+#define HAVE_RPL_DAO_HANDLING
+
+#endif /* _CFG_UNITTEST_H_ */
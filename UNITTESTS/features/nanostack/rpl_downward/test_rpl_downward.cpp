@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include <cstring>
+#include <cstdlib>
+
+extern "C" {
+#include "nsconfig.h"
+#include "ns_types.h"
+#include "ns_list.h"
+#include "common_functions.h"
+#include "NWK_INTERFACE/Include/protocol.h"
+#include "ipv6_stack/ipv6_routing_table.h"
+#include "net_rpl.h"
+#include "RPL/rpl_protocol.h"
+#include "RPL/rpl_upward.h"
+#include "RPL/rpl_downward.h"
+#include "RPL/rpl_structures.h"
+
+// Address of the border router. See protocol_core_stub.c
+extern uint8_t protocol_core_stub_address[16];
+// RPL memory limit and usage. See rpl_stub.c
+extern size_t rpl_stub_alloc_limit;
+extern size_t rpl_stub_alloc_total;
+}
+
+#define INTERFACE_ID 1
+#define LIFETIME_UNIT 60
+
+static const uint8_t mesh_prefix[8] = { 0xfd, 0x00, 0x0d, 0xb8, 0, 0, 0, 0 };
+static const uint8_t external_prefix[8] = { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 1 };
+
+// Address of a mesh node, node 0 is the border router
+static void node_address(uint8_t address[16], uint16_t node)
+{
+    memcpy(address, mesh_prefix, 8);
+    memcpy(address + 8, "\x00\x00\x00\xff\xfe\x00", 6);
+    common_write_16_bit(node, address + 14);
+}
+
+// Nodes form a tree below the border router, 4 children per node
+static uint16_t node_parent(uint16_t node)
+{
+    return (node - 1) / 4;
+}
+
+class Test_rpl_downward : public testing::Test {
+protected:
+    rpl_instance_t *instance;
+    rpl_dodag_t dodag;
+    rpl_dodag_version_t version;
+
+    virtual void SetUp()
+    {
+        instance = (rpl_instance_t *)calloc(1, sizeof(rpl_instance_t));
+        ns_list_init(&instance->dodags);
+        ns_list_init(&instance->candidate_neighbours);
+        ns_list_init(&instance->dao_targets);
+        ns_list_init(&instance->root_children);
+
+        memset(&dodag, 0, sizeof(dodag));
+        dodag.instance = instance;
+        dodag.root = true;
+        dodag.have_config = true;
+        dodag.g_mop_prf = RPL_MODE_NON_STORING;
+        dodag.config.lifetime_unit = LIFETIME_UNIT;
+        memset(&version, 0, sizeof(version));
+        version.dodag = &dodag;
+        instance->current_dodag_version = &version;
+
+        node_address(protocol_core_stub_address, 0);
+        rpl_stub_alloc_limit = 0;
+    }
+
+    virtual void TearDown()
+    {
+        ns_list_foreach_safe(rpl_dao_target_t, target, &instance->dao_targets) {
+            rpl_delete_dao_target(instance, target);
+        }
+        EXPECT_EQ(0u, rpl_stub_alloc_total);
+        free(instance);
+    }
+
+    // Non-storing DAO of a node to the border router
+    bool dao(uint16_t node, uint8_t path_lifetime, uint8_t path_sequence = 1)
+    {
+        uint8_t opts[4 + 16 + 2 + 20];
+        uint8_t *ptr = opts;
+        uint8_t src[16];
+
+        node_address(src, node);
+        *ptr++ = RPL_TARGET_OPTION;
+        *ptr++ = 2 + 16;
+        *ptr++ = 0;
+        *ptr++ = 128;
+        memcpy(ptr, src, 16);
+        ptr += 16;
+        *ptr++ = RPL_TRANSIT_OPTION;
+        *ptr++ = 20;
+        *ptr++ = 0;
+        *ptr++ = 0x80;
+        *ptr++ = path_sequence;
+        *ptr++ = path_lifetime;
+        node_address(ptr, node_parent(node));
+        ptr += 16;
+
+        uint8_t status;
+        return rpl_instance_dao_received(instance, src, INTERFACE_ID, false, opts, ptr - opts, &status);
+    }
+
+    rpl_dao_target_t *target(uint16_t node)
+    {
+        uint8_t address[16];
+        node_address(address, node);
+        return rpl_instance_match_dao_target(instance, address, 128);
+    }
+};
+
+TEST_F(Test_rpl_downward, dao_targets)
+{
+    for (int node = 1; node <= 300; node++) {
+        ASSERT_TRUE(dao(node, 10));
+    }
+    EXPECT_EQ(300, ns_list_count(&instance->dao_targets));
+
+    uint8_t address[16];
+    for (int node = 1; node <= 300; node++) {
+        rpl_dao_target_t *t = target(node);
+        ASSERT_TRUE(t != NULL);
+        node_address(address, node);
+        EXPECT_EQ(0, memcmp(t->prefix, address, 16));
+        EXPECT_EQ(128, t->prefix_len);
+        EXPECT_EQ((uint32_t)10 * LIFETIME_UNIT, t->lifetime);
+    }
+    EXPECT_TRUE(target(0) == NULL);
+    EXPECT_TRUE(target(301) == NULL);
+
+    // A refresh updates the existing targets
+    for (int node = 1; node <= 300; node++) {
+        ASSERT_TRUE(dao(node, 20, 2));
+    }
+    EXPECT_EQ(300, ns_list_count(&instance->dao_targets));
+    EXPECT_EQ((uint32_t)20 * LIFETIME_UNIT, target(300)->lifetime);
+}
+
+TEST_F(Test_rpl_downward, no_path)
+{
+    for (int node = 1; node <= 100; node++) {
+        ASSERT_TRUE(dao(node, 10));
+    }
+    for (int node = 2; node <= 100; node += 2) {
+        ASSERT_TRUE(dao(node, 0));
+    }
+    EXPECT_EQ(50, ns_list_count(&instance->dao_targets));
+    for (int node = 1; node <= 100; node++) {
+        EXPECT_EQ(node % 2 == 1, target(node) != NULL);
+    }
+}
+
+TEST_F(Test_rpl_downward, match_prefix)
+{
+    uint8_t address[16];
+
+    ASSERT_TRUE(dao(1, 10));
+    memcpy(address, external_prefix, 8);
+    memset(address + 8, 0, 8);
+    rpl_dao_target_t *prefix_target = rpl_create_dao_target(instance, address, 64, true);
+    ASSERT_TRUE(prefix_target != NULL);
+
+    // Full-length targets come first, then the longest prefix
+    EXPECT_EQ(target(1), rpl_instance_lookup_dao_target(instance, target(1)->prefix, 128));
+    address[15] = 1;
+    EXPECT_EQ(prefix_target, rpl_instance_match_dao_target(instance, address, 128));
+    EXPECT_TRUE(rpl_instance_lookup_dao_target(instance, address, 128) == NULL);
+    EXPECT_TRUE(target(2) == NULL);
+
+    rpl_delete_dao_target(instance, prefix_target);
+    EXPECT_TRUE(rpl_instance_match_dao_target(instance, address, 128) == NULL);
+    EXPECT_TRUE(target(1) != NULL);
+}
+
+TEST_F(Test_rpl_downward, compute_paths)
+{
+    for (int node = 1; node <= 200; node++) {
+        ASSERT_TRUE(dao(node, 10));
+    }
+    rpl_downward_compute_paths(instance);
+
+    for (int node = 1; node <= 200; node++) {
+        rpl_dao_target_t *t = target(node);
+        ASSERT_TRUE(t != NULL);
+        EXPECT_TRUE(t->connected);
+        rpl_dao_root_transit_t *transit = ns_list_get_first(&t->info.root.transits);
+        ASSERT_TRUE(transit != NULL);
+        if (node_parent(node) == 0) {
+            EXPECT_TRUE(transit->parent == NULL);
+        } else {
+            EXPECT_EQ(target(node_parent(node)), transit->parent);
+        }
+    }
+}
+
+TEST_F(Test_rpl_downward, eviction)
+{
+    // Room for 8 targets with their transit
+    rpl_stub_alloc_limit = 8 * (sizeof(rpl_dao_target_t) + sizeof(rpl_dao_root_transit_t) + 16);
+    for (int node = 1; node <= 8; node++) {
+        ASSERT_TRUE(dao(node, 10 + node));
+    }
+    EXPECT_EQ(8, ns_list_count(&instance->dao_targets));
+
+    // No target expires before one with the same lifetime: dropped
+    ASSERT_TRUE(dao(9, 11));
+    EXPECT_TRUE(target(9) == NULL);
+
+    // The target closest to expiry makes room
+    ASSERT_TRUE(dao(9, 30));
+    EXPECT_TRUE(target(9) != NULL);
+    EXPECT_TRUE(target(1) == NULL);
+    EXPECT_EQ(8, ns_list_count(&instance->dao_targets));
+    for (int node = 2; node <= 8; node++) {
+        EXPECT_TRUE(target(node) != NULL);
+    }
+}
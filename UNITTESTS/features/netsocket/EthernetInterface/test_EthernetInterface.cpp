@@ -92,6 +92,7 @@ public:
         MOCK_METHOD0(bringdown, nsapi_error_t());
         MOCK_METHOD1(attach, void(mbed::Callback<void(nsapi_event_t, intptr_t)> status_cb));
         MOCK_CONST_METHOD0(get_connection_status, nsapi_connection_status_t());
+        MOCK_METHOD1(get_connection_timeline, nsapi_error_t(nsapi_connection_timeline_t *timeline));
         MOCK_METHOD2(get_mac_address, char *(char *buf, nsapi_size_t buflen));
         MOCK_METHOD2(get_ip_address, char *(char *buf, nsapi_size_t buflen));
         MOCK_METHOD2(get_netmask, char *(char *buf, nsapi_size_t buflen));
@@ -266,6 +267,19 @@ TEST_F(TestEthernetInterface, get_connection_status)
     EXPECT_EQ(NSAPI_STATUS_LOCAL_UP, iface->get_connection_status());
 }
 
+TEST_F(TestEthernetInterface, get_connection_timeline)
+{
+    nsapi_connection_timeline_t timeline;
+    EXPECT_EQ(NSAPI_ERROR_NO_CONNECTION, iface->get_connection_timeline(&timeline));
+
+    doConnect();
+
+    EXPECT_CALL(*netStackIface, get_connection_timeline(&timeline))
+    .Times(1)
+    .WillOnce(Return(NSAPI_ERROR_OK));
+    EXPECT_EQ(NSAPI_ERROR_OK, iface->get_connection_timeline(&timeline));
+}
+
 TEST_F(TestEthernetInterface, attach)
 {
     doConnect();
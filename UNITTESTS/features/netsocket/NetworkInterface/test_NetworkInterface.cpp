@@ -136,6 +136,12 @@ TEST_F(TestNetworkInterface, get_connection_status)
     EXPECT_EQ(iface->get_connection_status(), NSAPI_ERROR_UNSUPPORTED);
 }
 
+TEST_F(TestNetworkInterface, get_connection_timeline)
+{
+    nsapi_connection_timeline_t timeline;
+    EXPECT_EQ(iface->get_connection_timeline(&timeline), NSAPI_ERROR_UNSUPPORTED);
+}
+
 TEST_F(TestNetworkInterface, set_blocking)
 {
     EXPECT_EQ(iface->set_blocking(true), NSAPI_ERROR_UNSUPPORTED);
@@ -79,12 +79,15 @@ class NetworkStackChild : public NetworkStack {
     virtual nsapi_size_or_error_t socket_send(nsapi_socket_t handle,
                                               const void *data, nsapi_size_t size)
     {
-        return NSAPI_ERROR_OK;
+        sent_data.append(static_cast<const char *>(data), size);
+        return size;
     }
     virtual nsapi_size_or_error_t socket_recv(nsapi_socket_t handle,
                                               void *data, nsapi_size_t size)
     {
-        return NSAPI_ERROR_OK;
+        nsapi_size_t len = recv_data.copy(static_cast<char *>(data), size);
+        recv_data.erase(0, len);
+        return len;
     }
     virtual nsapi_size_or_error_t socket_sendto(nsapi_socket_t handle, const SocketAddress &address,
                                                 const void *data, nsapi_size_t size)
@@ -100,6 +103,10 @@ class NetworkStackChild : public NetworkStack {
     {
     }
 public:
+    using NetworkStack::socket_sendmsg;
+    using NetworkStack::socket_recvmsg;
+    std::string sent_data;
+    std::string recv_data;
     std::string ip_address;
     const char *get_ip_address()
     {
@@ -238,3 +245,23 @@ TEST_F(TestNetworkStack, setstackopt)
     EXPECT_EQ(stack->setstackopt(0, 0, 0, 0), NSAPI_ERROR_UNSUPPORTED);
 }
 
+
+TEST_F(TestNetworkStack, socket_sendmsg_gathers)
+{
+    char header[] = "head";
+    char payload[] = "payload";
+    nsapi_iovec_t iov[] = {{header, 4}, {payload, 7}};
+    EXPECT_EQ(stack->socket_sendmsg(0, NULL, iov, 2), 11);
+    EXPECT_EQ(stack->sent_data, "headpayload");
+}
+
+TEST_F(TestNetworkStack, socket_recvmsg_scatters)
+{
+    char header[4];
+    char payload[8];
+    nsapi_iovec_t iov[] = {{header, sizeof(header)}, {payload, sizeof(payload)}};
+    stack->recv_data = "headpay";
+    EXPECT_EQ(stack->socket_recvmsg(0, NULL, iov, 2), 7);
+    EXPECT_EQ(std::string(header, 4), "head");
+    EXPECT_EQ(std::string(payload, 3), "pay");
+}
@@ -162,5 +162,43 @@ TEST_F(TestSocketAddress, bool_operator_ip6_true)
     EXPECT_TRUE(addr ? true : false);
 }
 
+TEST_F(TestSocketAddress, get_ip_address_cached)
+{
+    address->set_ip_address("127.0.0.1");
+    const char *str = address->get_ip_address();
+    EXPECT_STREQ("127.0.0.1", str);
+    // Same address doesn't convert again
+    EXPECT_TRUE(address->set_ip_address("127.0.0.1"));
+    EXPECT_EQ(str, address->get_ip_address());
+    address->set_addr(address->get_addr());
+    EXPECT_EQ(str, address->get_ip_address());
+
+    EXPECT_TRUE(address->set_ip_address("127.0.0.2"));
+    EXPECT_STREQ("127.0.0.2", address->get_ip_address());
+    EXPECT_FALSE(address->set_ip_address("127.0.0.256"));
+    EXPECT_EQ(NULL, address->get_ip_address());
+}
+
+TEST_F(TestSocketAddress, less_than_operator)
+{
+    SocketAddress addr4("127.0.0.1", 80);
+    SocketAddress addr4_port("127.0.0.1", 81);
+    SocketAddress addr4_high("127.0.0.2", 80);
+    SocketAddress addr6("::1", 80);
+
+    EXPECT_TRUE(addr4 < addr4_port);
+    EXPECT_FALSE(addr4_port < addr4);
+    EXPECT_TRUE(addr4_port < addr4_high);
+    EXPECT_TRUE(addr4_high < addr6);
+    EXPECT_FALSE(addr4 < addr4);
+}
 
+TEST_F(TestSocketAddress, hash)
+{
+    SocketAddress addr4("127.0.0.1", 80);
+    SocketAddress same(addr4.get_addr(), 80);
+    SocketAddress addr4_port("127.0.0.1", 81);
 
+    EXPECT_EQ(addr4.hash(), same.hash());
+    EXPECT_NE(addr4.hash(), addr4_port.hash());
+}
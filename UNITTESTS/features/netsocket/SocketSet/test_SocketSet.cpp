@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "features/netsocket/SocketSet.h"
+#include <list>
+
+// Control the rtos EventFlags stub. See EventFlags_stub.cpp
+extern std::list<uint32_t> eventFlagsStubNextRetval;
+
+// Socket recording its sigio callback and blocking mode
+class SocketFake : public Socket {
+public:
+    mbed::Callback<void()> callback;
+    bool blocking;
+
+    SocketFake() : blocking(true) {}
+
+    virtual nsapi_error_t close()
+    {
+        return NSAPI_ERROR_OK;
+    }
+    virtual nsapi_error_t connect(const SocketAddress &address)
+    {
+        return NSAPI_ERROR_OK;
+    }
+    virtual nsapi_size_or_error_t send(const void *data, nsapi_size_t size)
+    {
+        return size;
+    }
+    virtual nsapi_size_or_error_t recv(void *data, nsapi_size_t size)
+    {
+        return NSAPI_ERROR_WOULD_BLOCK;
+    }
+    virtual nsapi_size_or_error_t sendto(const SocketAddress &address, const void *data, nsapi_size_t size)
+    {
+        return size;
+    }
+    virtual nsapi_size_or_error_t recvfrom(SocketAddress *address, void *data, nsapi_size_t size)
+    {
+        return NSAPI_ERROR_WOULD_BLOCK;
+    }
+    virtual nsapi_error_t bind(const SocketAddress &address)
+    {
+        return NSAPI_ERROR_OK;
+    }
+    virtual void set_blocking(bool blocking)
+    {
+        this->blocking = blocking;
+    }
+    virtual void set_timeout(int timeout)
+    {
+    }
+    virtual void sigio(mbed::Callback<void()> func)
+    {
+        callback = func;
+    }
+    virtual nsapi_error_t setsockopt(int level, int optname, const void *optval, unsigned optlen)
+    {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+    virtual nsapi_error_t getsockopt(int level, int optname, void *optval, unsigned *optlen)
+    {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+    virtual Socket *accept(nsapi_error_t *error = NULL)
+    {
+        return NULL;
+    }
+    virtual nsapi_error_t listen(int backlog = 1)
+    {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+    virtual nsapi_error_t getpeername(SocketAddress *address)
+    {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+};
+
+class TestSocketSet : public testing::Test {
+protected:
+    SocketSet *set;
+    SocketFake sockets[3];
+    Socket *ready[3];
+
+    virtual void SetUp()
+    {
+        set = new SocketSet;
+        eventFlagsStubNextRetval.clear();
+    }
+
+    virtual void TearDown()
+    {
+        delete set;
+    }
+};
+
+TEST_F(TestSocketSet, constructor)
+{
+    EXPECT_TRUE(set);
+}
+
+TEST_F(TestSocketSet, wait_empty)
+{
+    EXPECT_EQ(set->wait(ready, 3, 0), 0);
+    eventFlagsStubNextRetval.push_back(osFlagsErrorTimeout);
+    EXPECT_EQ(set->wait(ready, 3, 10), 0);
+}
+
+TEST_F(TestSocketSet, add)
+{
+    EXPECT_EQ(set->add(&sockets[0]), NSAPI_ERROR_OK);
+    EXPECT_EQ(set->add(&sockets[0]), NSAPI_ERROR_PARAMETER);
+    EXPECT_FALSE(sockets[0].blocking);
+    EXPECT_TRUE(sockets[0].callback);
+
+    // Added sockets are ready once
+    EXPECT_EQ(set->wait(ready, 3, 0), 1);
+    EXPECT_EQ(ready[0], &sockets[0]);
+    EXPECT_EQ(set->wait(ready, 3, 0), 0);
+}
+
+TEST_F(TestSocketSet, wait_hands_out_ready_sockets_in_order)
+{
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(set->add(&sockets[i]), NSAPI_ERROR_OK);
+    }
+    EXPECT_EQ(set->wait(ready, 3, 0), 3);
+
+    sockets[2].callback();
+    sockets[0].callback();
+    sockets[2].callback(); // Already queued
+    EXPECT_EQ(set->wait(ready, 1, 0), 1);
+    EXPECT_EQ(ready[0], &sockets[2]);
+    EXPECT_EQ(set->wait(ready, 3, 0), 1);
+    EXPECT_EQ(ready[0], &sockets[0]);
+    EXPECT_EQ(set->wait(ready, 3, 0), 0);
+}
+
+TEST_F(TestSocketSet, remove)
+{
+    EXPECT_EQ(set->remove(&sockets[0]), NSAPI_ERROR_PARAMETER);
+    EXPECT_EQ(set->add(&sockets[0]), NSAPI_ERROR_OK);
+    EXPECT_EQ(set->add(&sockets[1]), NSAPI_ERROR_OK);
+
+    // Removed while queued
+    EXPECT_EQ(set->remove(&sockets[1]), NSAPI_ERROR_OK);
+    EXPECT_FALSE(sockets[1].callback);
+    EXPECT_EQ(set->wait(ready, 3, 0), 1);
+    EXPECT_EQ(ready[0], &sockets[0]);
+
+    sockets[0].callback();
+    EXPECT_EQ(set->remove(&sockets[0]), NSAPI_ERROR_OK);
+    EXPECT_EQ(set->wait(ready, 3, 0), 0);
+}
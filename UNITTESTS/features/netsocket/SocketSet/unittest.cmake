@@ -0,0 +1,16 @@
+
+####################
+# UNIT TESTS
+####################
+
+set(unittest-sources
+  ../features/netsocket/SocketSet.cpp
+)
+
+set(unittest-test-sources
+  features/netsocket/SocketSet/test_SocketSet.cpp
+  stubs/Mutex_stub.cpp
+  stubs/mbed_assert_stub.c
+  stubs/mbed_critical_stub.c
+  stubs/EventFlags_stub.cpp
+)
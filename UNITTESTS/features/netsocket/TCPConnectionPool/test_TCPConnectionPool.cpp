@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "features/netsocket/TCPConnectionPool.h"
+#include "NetworkStack_stub.h"
+
+// Control the rtos EventFlags stub. See EventFlags_stub.cpp
+extern std::list<uint32_t> eventFlagsStubNextRetval;
+
+class TestTCPConnectionPool : public testing::Test {
+protected:
+    // Declared first, to outlive the sockets
+    NetworkStackstub stack;
+    TCPSocket server;
+    TCPSocket sockets[2];
+    TCPConnectionPool *pool;
+
+    virtual void SetUp()
+    {
+        pool = new TCPConnectionPool(sockets, 2);
+        stack.return_value = NSAPI_ERROR_OK;
+        server.open((NetworkStack *)&stack);
+    }
+
+    virtual void TearDown()
+    {
+        stack.return_value = NSAPI_ERROR_OK;
+        stack.return_values.clear();
+        eventFlagsStubNextRetval.clear();
+        delete pool;
+    }
+};
+
+TEST_F(TestTCPConnectionPool, constructor)
+{
+    EXPECT_EQ(pool->available(), 2);
+}
+
+TEST_F(TestTCPConnectionPool, accept)
+{
+    nsapi_error_t error;
+    TCPSocket *first = pool->accept(&server, &error);
+    EXPECT_EQ(error, NSAPI_ERROR_OK);
+    TCPSocket *second = pool->accept(&server, &error);
+    EXPECT_EQ(error, NSAPI_ERROR_OK);
+    EXPECT_TRUE(first == &sockets[0] || first == &sockets[1]);
+    EXPECT_TRUE(second == &sockets[0] || second == &sockets[1]);
+    EXPECT_NE(first, second);
+    EXPECT_EQ(pool->available(), 0);
+}
+
+TEST_F(TestTCPConnectionPool, accept_no_socket)
+{
+    nsapi_error_t error;
+    pool->accept(&server);
+    pool->accept(&server);
+    EXPECT_EQ(pool->accept(&server, &error), static_cast<TCPSocket *>(NULL));
+    EXPECT_EQ(error, NSAPI_ERROR_NO_SOCKET);
+}
+
+TEST_F(TestTCPConnectionPool, accept_would_block)
+{
+    nsapi_error_t error;
+    stack.return_value = NSAPI_ERROR_WOULD_BLOCK;
+    eventFlagsStubNextRetval.push_back(0);
+    eventFlagsStubNextRetval.push_back(osFlagsError); // Break the wait loop
+    EXPECT_EQ(pool->accept(&server, &error), static_cast<TCPSocket *>(NULL));
+    EXPECT_EQ(error, NSAPI_ERROR_WOULD_BLOCK);
+    EXPECT_EQ(pool->available(), 2);
+}
+
+TEST_F(TestTCPConnectionPool, release)
+{
+    TCPSocket *connection = pool->accept(&server);
+    ASSERT_NE(connection, static_cast<TCPSocket *>(NULL));
+    EXPECT_EQ(pool->available(), 1);
+    pool->release(connection);
+    EXPECT_EQ(pool->available(), 2);
+    EXPECT_EQ(connection->close(), NSAPI_ERROR_NO_SOCKET);
+    EXPECT_EQ(pool->accept(&server), connection);
+}
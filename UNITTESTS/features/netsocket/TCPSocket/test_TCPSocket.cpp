@@ -242,6 +242,56 @@ TEST_F(TestTCPSocket, recv_from_null)
     EXPECT_EQ(socket->recvfrom(NULL, dataBuf, dataSize), NSAPI_ERROR_OK);
 }
 
+TEST_F(TestTCPSocket, sendmsg_in_two_chunks)
+{
+    nsapi_iovec_t iov[] = {{dataBuf, 4}, {dataBuf + 4, 6}};
+    EXPECT_EQ(socket->sendmsg(NULL, iov, 2), NSAPI_ERROR_NO_SOCKET);
+    socket->open((NetworkStack *)&stack);
+    stack.return_values.push_back(6);
+    stack.return_values.push_back(4);
+    EXPECT_EQ(socket->sendmsg(NULL, iov, 2), dataSize);
+}
+
+TEST_F(TestTCPSocket, sendmsg_error_would_block)
+{
+    nsapi_iovec_t iov[] = {{dataBuf, 4}, {dataBuf + 4, 6}};
+    socket->open((NetworkStack *)&stack);
+    stack.return_value = NSAPI_ERROR_WOULD_BLOCK;
+    eventFlagsStubNextRetval.push_back(osFlagsError); // Break the wait loop
+    EXPECT_EQ(socket->sendmsg(NULL, iov, 2), NSAPI_ERROR_WOULD_BLOCK);
+}
+
+TEST_F(TestTCPSocket, recvmsg)
+{
+    nsapi_iovec_t iov[] = {{dataBuf, 4}, {dataBuf + 4, 6}};
+    EXPECT_EQ(socket->recvmsg(NULL, iov, 2), NSAPI_ERROR_NO_SOCKET);
+    socket->open((NetworkStack *)&stack);
+    stack.return_value = 7;
+    EXPECT_EQ(socket->recvmsg(NULL, iov, 2), 7);
+}
+
+TEST_F(TestTCPSocket, send_buf_unsupported)
+{
+    net_stack_mem_buf_t *buf = reinterpret_cast<net_stack_mem_buf_t *>(1234);
+    EXPECT_EQ(socket->send_buf(buf), NSAPI_ERROR_NO_SOCKET);
+    socket->open((NetworkStack *)&stack);
+    EXPECT_EQ(socket->send_buf(buf), NSAPI_ERROR_UNSUPPORTED);
+}
+
+TEST_F(TestTCPSocket, recv_buf)
+{
+    net_stack_mem_buf_t *buf = NULL;
+    SocketAddress a("127.0.0.1", 1024);
+    SocketAddress b;
+    EXPECT_EQ(socket->recv_buf(&buf), NSAPI_ERROR_NO_SOCKET);
+    EXPECT_EQ(socket->open((NetworkStack *)&stack), NSAPI_ERROR_OK);
+    EXPECT_EQ(socket->connect(a), NSAPI_ERROR_OK);
+    stack.return_value = 100;
+    EXPECT_EQ(socket->recvfrom_buf(&b, &buf), 100);
+    EXPECT_EQ(buf, reinterpret_cast<net_stack_mem_buf_t *>(1234));
+    EXPECT_EQ(a, b);
+}
+
 /* listen */
 
 TEST_F(TestTCPSocket, listen_no_open)
@@ -286,3 +336,38 @@ TEST_F(TestTCPSocket, accept_would_block)
     EXPECT_EQ(socket->accept(&error), static_cast<TCPSocket *>(NULL));
     EXPECT_EQ(error, NSAPI_ERROR_WOULD_BLOCK);
 }
+
+TEST_F(TestTCPSocket, accept_into_no_open)
+{
+    TCPSocket connection;
+    stack.return_value = NSAPI_ERROR_OK;
+    EXPECT_EQ(socket->accept_into(&connection), NSAPI_ERROR_NO_SOCKET);
+}
+
+TEST_F(TestTCPSocket, accept_into)
+{
+    TCPSocket connection;
+    SocketAddress address;
+    stack.return_value = NSAPI_ERROR_OK;
+    stack.return_socketAddress = SocketAddress("127.0.0.1", 1024);
+    socket->open((NetworkStack *)&stack);
+    EXPECT_EQ(socket->accept_into(&connection, &address), NSAPI_ERROR_OK);
+    EXPECT_EQ(address, stack.return_socketAddress);
+    EXPECT_EQ(connection.getpeername(&address), NSAPI_ERROR_OK);
+    EXPECT_EQ(address, stack.return_socketAddress);
+    EXPECT_EQ(connection.close(), NSAPI_ERROR_OK);
+    // The socket can take another connection
+    EXPECT_EQ(socket->accept_into(&connection), NSAPI_ERROR_OK);
+    EXPECT_EQ(connection.close(), NSAPI_ERROR_OK);
+}
+
+TEST_F(TestTCPSocket, accept_into_would_block)
+{
+    TCPSocket connection;
+    socket->open((NetworkStack *)&stack);
+    stack.return_value = NSAPI_ERROR_WOULD_BLOCK;
+    eventFlagsStubNextRetval.push_back(0);
+    eventFlagsStubNextRetval.push_back(osFlagsError); // Break the wait loop
+    EXPECT_EQ(socket->accept_into(&connection), NSAPI_ERROR_WOULD_BLOCK);
+    EXPECT_EQ(connection.close(), NSAPI_ERROR_NO_SOCKET);
+}
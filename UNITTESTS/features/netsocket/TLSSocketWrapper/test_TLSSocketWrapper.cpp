@@ -21,6 +21,7 @@
 #include "NetworkStack_stub.h"
 #include "features/nanostack/coap-service/test/coap-service/unittest/stub/mbedtls_stub.h"
 #include <cstring> //memset
+#include <string>
 
 #include "mbed_error.h"
 mbed_error_status_t mbed_error(mbed_error_status_t error_status, const char *error_msg, unsigned int error_value, const char *filename, int line_number)
@@ -31,6 +32,9 @@ mbed_error_status_t mbed_error(mbed_error_status_t error_status, const char *err
 // Control the rtos EventFlags stub. See EventFlags_stub.cpp
 extern std::list<uint32_t> eventFlagsStubNextRetval;
 
+// Key of the last session stored. See TLSSessionCache_stub.cpp
+extern std::string tlsSessionCacheStubKey;
+
 class TestTLSSocketWrapper : public testing::Test {
 public:
     unsigned int dataSize = 10;
@@ -113,6 +117,21 @@ TEST_F(TestTLSSocketWrapper, connect)
     EXPECT_EQ(wrapper->connect(a), NSAPI_ERROR_IS_CONNECTED);
 }
 
+TEST_F(TestTLSSocketWrapper, connect_session_cache_by_address)
+{
+    TLSSessionCache cache(1);
+    tlsSessionCacheStubKey.clear();
+    wrapper->set_session_cache(&cache);
+    transport->open((NetworkStack *)&stack);
+    const SocketAddress a("127.0.0.1", 1024);
+    EXPECT_EQ(wrapper->connect(a), NSAPI_ERROR_OK);
+    // Without hostname, the session is stored for the address of the peer
+    // (the address is not formatted by the ip4tos stub)
+    ASSERT_GT(tlsSessionCacheStubKey.size(), 5);
+    EXPECT_EQ(tlsSessionCacheStubKey.substr(tlsSessionCacheStubKey.size() - 5), ":1024");
+    wrapper->set_session_cache(NULL);
+}
+
 /* connect: TCP-related errors */
 
 TEST_F(TestTLSSocketWrapper, connect_no_open)
@@ -404,6 +423,19 @@ TEST_F(TestTLSSocketWrapper, getsockopt)
     EXPECT_EQ(wrapper->getsockopt(0, 0, 0, 0), NSAPI_ERROR_UNSUPPORTED);
 }
 
+TEST_F(TestTLSSocketWrapper, set_max_fragment_length)
+{
+    EXPECT_EQ(wrapper->set_max_fragment_length(0), NSAPI_ERROR_OK);
+    EXPECT_EQ(wrapper->set_max_fragment_length(4096), NSAPI_ERROR_OK);
+}
+
+TEST_F(TestTLSSocketWrapper, set_max_fragment_length_invalid)
+{
+    EXPECT_EQ(wrapper->set_max_fragment_length(1000), NSAPI_ERROR_PARAMETER);
+    mbedtls_stub.expected_int = MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+    EXPECT_EQ(wrapper->set_max_fragment_length(512), NSAPI_ERROR_PARAMETER);
+}
+
 /* unsupported */
 
 TEST_F(TestTLSSocketWrapper, listen_unsupported)
@@ -142,6 +142,159 @@ TEST_F(TestUDPSocket, recv_address_filtering)
     EXPECT_EQ(socket->recvfrom(&a1, &dataBuf, dataSize), 100);
 }
 
+TEST_F(TestUDPSocket, send_buf)
+{
+    const nsapi_addr_t saddr = {NSAPI_IPv4, {127, 0, 0, 1} };
+    const SocketAddress addr(saddr, 1024);
+    net_stack_mem_buf_t *buf = reinterpret_cast<net_stack_mem_buf_t *>(1234);
+
+    EXPECT_EQ(socket->get_memory_manager(), static_cast<NetStackMemoryManager *>(NULL));
+    EXPECT_EQ(socket->sendto_buf(addr, buf), NSAPI_ERROR_NO_SOCKET);
+    EXPECT_EQ(socket->send_buf(buf), NSAPI_ERROR_NO_ADDRESS);
+
+    socket->open((NetworkStack *)&stack);
+
+    stack.return_value = 100;
+    EXPECT_EQ(socket->sendto_buf(addr, buf), 100);
+
+    EXPECT_EQ(socket->connect(addr), NSAPI_ERROR_OK);
+    EXPECT_EQ(socket->send_buf(buf), 100);
+
+    stack.return_value = NSAPI_ERROR_WOULD_BLOCK;
+    eventFlagsStubNextRetval.push_back(0);
+    eventFlagsStubNextRetval.push_back(osFlagsError); // Break the wait loop
+    EXPECT_EQ(socket->send_buf(buf), NSAPI_ERROR_WOULD_BLOCK);
+}
+
+TEST_F(TestUDPSocket, recv_buf)
+{
+    net_stack_mem_buf_t *buf = NULL;
+
+    EXPECT_EQ(socket->recv_buf(&buf), NSAPI_ERROR_NO_SOCKET);
+
+    socket->open((NetworkStack *)&stack);
+
+    stack.return_value = NSAPI_ERROR_WOULD_BLOCK;
+    eventFlagsStubNextRetval.push_back(0);
+    eventFlagsStubNextRetval.push_back(osFlagsError); // Break the wait loop
+    EXPECT_EQ(socket->recv_buf(&buf), NSAPI_ERROR_WOULD_BLOCK);
+    EXPECT_EQ(buf, static_cast<net_stack_mem_buf_t *>(NULL));
+
+    const nsapi_addr_t saddr = {NSAPI_IPv4, {127, 0, 0, 1} };
+    SocketAddress addr;
+    stack.return_socketAddress = SocketAddress(saddr, 1024);
+    stack.return_value = 100;
+    EXPECT_EQ(socket->recvfrom_buf(&addr, &buf), 100);
+    EXPECT_EQ(buf, reinterpret_cast<net_stack_mem_buf_t *>(1234));
+    EXPECT_EQ(addr, stack.return_socketAddress);
+}
+
+TEST_F(TestUDPSocket, sendmsg)
+{
+    const nsapi_addr_t saddr = {NSAPI_IPv4, {127, 0, 0, 1} };
+    const SocketAddress addr(saddr, 1024);
+    nsapi_iovec_t iov[] = {{dataBuf, 4}, {dataBuf + 4, 6}};
+
+    EXPECT_EQ(socket->sendmsg(&addr, iov, 2), NSAPI_ERROR_NO_SOCKET);
+    EXPECT_EQ(socket->sendmsg(NULL, iov, 2), NSAPI_ERROR_NO_ADDRESS);
+
+    socket->open((NetworkStack *)&stack);
+
+    stack.return_value = 10;
+    EXPECT_EQ(socket->sendmsg(&addr, iov, 2), 10);
+
+    stack.return_value = NSAPI_ERROR_WOULD_BLOCK;
+    eventFlagsStubNextRetval.push_back(0);
+    eventFlagsStubNextRetval.push_back(osFlagsError); // Break the wait loop
+    EXPECT_EQ(socket->sendmsg(&addr, iov, 2), NSAPI_ERROR_WOULD_BLOCK);
+}
+
+TEST_F(TestUDPSocket, recvmsg)
+{
+    nsapi_iovec_t iov[] = {{dataBuf, 4}, {dataBuf + 4, 6}};
+
+    EXPECT_EQ(socket->recvmsg(NULL, iov, 2), NSAPI_ERROR_NO_SOCKET);
+
+    socket->open((NetworkStack *)&stack);
+
+    stack.return_value = 10;
+    EXPECT_EQ(socket->recvmsg(NULL, iov, 2), 10);
+
+    stack.return_value = NSAPI_ERROR_WOULD_BLOCK;
+    eventFlagsStubNextRetval.push_back(0);
+    eventFlagsStubNextRetval.push_back(osFlagsError); // Break the wait loop
+    EXPECT_EQ(socket->recvmsg(NULL, iov, 2), NSAPI_ERROR_WOULD_BLOCK);
+}
+
+TEST_F(TestUDPSocket, sendto_batch)
+{
+    const nsapi_addr_t saddr = {NSAPI_IPv4, {127, 0, 0, 1} };
+    UDPSocket::datagram_t datagrams[2] = {
+        {SocketAddress(saddr, 1024), dataBuf, 4, 0},
+        {SocketAddress(saddr, 1025), dataBuf, 6, 0},
+    };
+
+    EXPECT_EQ(socket->sendto_batch(datagrams, 2), NSAPI_ERROR_NO_SOCKET);
+
+    socket->open((NetworkStack *)&stack);
+
+    stack.return_value = 4;
+    EXPECT_EQ(socket->sendto_batch(datagrams, 2), 2);
+    EXPECT_EQ(datagrams[1].length, 4);
+
+    stack.return_value = NSAPI_ERROR_WOULD_BLOCK;
+    socket->set_blocking(false);
+    EXPECT_EQ(socket->sendto_batch(datagrams, 2), NSAPI_ERROR_WOULD_BLOCK);
+}
+
+TEST_F(TestUDPSocket, recvfrom_batch)
+{
+    UDPSocket::datagram_t datagrams[3] = {
+        {SocketAddress(), dataBuf, 4, 0},
+        {SocketAddress(), dataBuf + 4, 4, 0},
+        {SocketAddress(), dataBuf + 8, 2, 0},
+    };
+
+    EXPECT_EQ(socket->recvfrom_batch(datagrams, 3), NSAPI_ERROR_NO_SOCKET);
+
+    socket->open((NetworkStack *)&stack);
+
+    // Drains the queued datagrams without waiting
+    stack.return_values.push_back(4);
+    stack.return_values.push_back(3);
+    stack.return_values.push_back(NSAPI_ERROR_WOULD_BLOCK);
+    EXPECT_EQ(socket->recvfrom_batch(datagrams, 3), 2);
+    EXPECT_EQ(datagrams[0].length, 4);
+    EXPECT_EQ(datagrams[1].length, 3);
+
+    stack.return_value = NSAPI_ERROR_WOULD_BLOCK;
+    eventFlagsStubNextRetval.push_back(osFlagsError); // Break the wait loop
+    EXPECT_EQ(socket->recvfrom_batch(datagrams, 3), NSAPI_ERROR_WOULD_BLOCK);
+}
+
+TEST_F(TestUDPSocket, recvfrom_batch_address_filtering)
+{
+    socket->open((NetworkStack *)&stack);
+    const nsapi_addr_t addr1 = {NSAPI_IPv4, {127, 0, 0, 1} };
+    const nsapi_addr_t addr2 = {NSAPI_IPv4, {127, 0, 0, 2} };
+    UDPSocket::datagram_t datagrams[2] = {
+        {SocketAddress(), dataBuf, 4, 0},
+        {SocketAddress(), dataBuf + 4, 6, 0},
+    };
+
+    EXPECT_EQ(socket->connect(SocketAddress(addr1, 1024)), NSAPI_ERROR_OK);
+
+    stack.return_socketAddress = SocketAddress(addr2, 1024);
+    stack.return_values.push_back(4); // Dropped, wrong address
+    stack.return_values.push_back(NSAPI_ERROR_NO_MEMORY);
+    EXPECT_EQ(socket->recvfrom_batch(datagrams, 2), NSAPI_ERROR_NO_MEMORY);
+
+    stack.return_socketAddress = SocketAddress(addr1, 1024);
+    stack.return_values.push_back(4);
+    stack.return_values.push_back(6);
+    EXPECT_EQ(socket->recvfrom_batch(datagrams, 2), 2);
+}
+
 TEST_F(TestUDPSocket, unsupported_api)
 {
     nsapi_error_t error;
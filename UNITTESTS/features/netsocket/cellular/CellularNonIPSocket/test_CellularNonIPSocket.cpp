@@ -154,3 +154,19 @@ TEST_F(TestCellularNonIPSocket, recv)
     eventFlagsStubNextRetval.push_back(osFlagsError); // Break the wait loop
     EXPECT_EQ(socket->recv(&dataBuf, dataSize), NSAPI_ERROR_WOULD_BLOCK);
 }
+
+TEST_F(TestCellularNonIPSocket, recv_cancel)
+{
+    socket->open((CellularContext *)&cellular_context);
+    cp_netif = cellular_context.get_cp_netif();
+
+    cp_netif->return_value = 100;
+    EXPECT_EQ(socket->recv(&dataBuf, dataSize), 100);
+    EXPECT_TRUE(cp_netif->cancelled_buffer == NULL);
+
+    // the netif must not keep the buffer after recv() gives up
+    socket->set_blocking(false);
+    cp_netif->return_value = NSAPI_ERROR_WOULD_BLOCK;
+    EXPECT_EQ(socket->recv(&dataBuf, dataSize), NSAPI_ERROR_WOULD_BLOCK);
+    EXPECT_TRUE(cp_netif->cancelled_buffer == &dataBuf);
+}
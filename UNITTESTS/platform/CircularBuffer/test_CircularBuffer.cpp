@@ -37,3 +37,80 @@ TEST_F(TestCircularBuffer, constructor)
 {
     EXPECT_TRUE(buf);
 }
+
+TEST_F(TestCircularBuffer, push_pop_bulk)
+{
+    int in[15];
+    int out[15];
+    for (int i = 0; i < 15; i++) {
+        in[i] = i;
+    }
+
+    // wrap around the end of the pool
+    buf->push(in, 7);
+    EXPECT_EQ(5u, buf->pop(out, 5));
+    buf->push(in + 7, 6);
+    EXPECT_EQ(8u, buf->size());
+    EXPECT_EQ(8u, buf->pop(out, 15));
+    for (int i = 0; i < 8; i++) {
+        EXPECT_EQ(i + 5, out[i]);
+    }
+    EXPECT_TRUE(buf->empty());
+    EXPECT_EQ(0u, buf->pop(out, 1));
+}
+
+TEST_F(TestCircularBuffer, push_bulk_overwrites)
+{
+    int in[15];
+    int out[10];
+    for (int i = 0; i < 15; i++) {
+        in[i] = i;
+    }
+
+    buf->push(in, 4);
+    buf->push(in + 4, 8);
+    EXPECT_TRUE(buf->full());
+    EXPECT_EQ(10u, buf->pop(out, 10));
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(i + 2, out[i]);
+    }
+
+    buf->push(in, 15);
+    EXPECT_TRUE(buf->full());
+    EXPECT_EQ(10u, buf->pop(out, 10));
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(i + 5, out[i]);
+    }
+}
+
+TEST_F(TestCircularBuffer, spans)
+{
+    EXPECT_TRUE(buf->readable_span().empty());
+
+    mbed::Span<int> free = buf->writable_span();
+    EXPECT_EQ(10, free.size());
+    for (int i = 0; i < 8; i++) {
+        free[i] = i;
+    }
+    buf->commit(8);
+    EXPECT_EQ(8u, buf->size());
+
+    mbed::Span<const int> data = buf->readable_span();
+    EXPECT_EQ(8, data.size());
+    EXPECT_EQ(0, data[0]);
+    buf->consume(6);
+
+    // free space wraps, so it comes in two parts
+    EXPECT_EQ(2, buf->writable_span().size());
+    buf->commit(2);
+    EXPECT_EQ(6, buf->writable_span().size());
+    buf->commit(6);
+    EXPECT_TRUE(buf->full());
+    EXPECT_TRUE(buf->writable_span().empty());
+
+    data = buf->readable_span();
+    EXPECT_EQ(4, data.size());
+    EXPECT_EQ(6, data[0]);
+    buf->consume(4);
+    EXPECT_EQ(6, buf->readable_span().size());
+}
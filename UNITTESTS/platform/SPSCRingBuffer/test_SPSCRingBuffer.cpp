@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "platform/SPSCRingBuffer.h"
+
+class TestSPSCRingBuffer : public testing::Test {
+protected:
+    mbed::SPSCRingBuffer<int, 8> *buf;
+
+    virtual void SetUp()
+    {
+        buf = new mbed::SPSCRingBuffer<int, 8>;
+    }
+
+    virtual void TearDown()
+    {
+        delete buf;
+    }
+};
+
+TEST_F(TestSPSCRingBuffer, push_pop)
+{
+    int data;
+    EXPECT_TRUE(buf->empty());
+    EXPECT_FALSE(buf->pop(data));
+
+    for (int i = 0; i < 8; i++) {
+        EXPECT_TRUE(buf->push(i));
+    }
+    EXPECT_TRUE(buf->full());
+    EXPECT_FALSE(buf->push(8));
+
+    EXPECT_TRUE(buf->peek(data));
+    EXPECT_EQ(0, data);
+    for (int i = 0; i < 8; i++) {
+        EXPECT_TRUE(buf->pop(data));
+        EXPECT_EQ(i, data);
+    }
+    EXPECT_TRUE(buf->empty());
+}
+
+TEST_F(TestSPSCRingBuffer, push_pop_bulk)
+{
+    int in[12];
+    int out[12];
+    for (int i = 0; i < 12; i++) {
+        in[i] = i;
+    }
+
+    // a full buffer takes no more
+    EXPECT_EQ(8u, buf->push(in, 12));
+    EXPECT_EQ(5u, buf->pop(out, 5));
+    EXPECT_EQ(5u, buf->push(in + 8, 4) + buf->push(in, 1));
+    EXPECT_EQ(8u, buf->size());
+    EXPECT_EQ(8u, buf->pop(out, 12));
+    for (int i = 0; i < 7; i++) {
+        EXPECT_EQ(i + 5, out[i]);
+    }
+    EXPECT_EQ(0, out[7]);
+    EXPECT_EQ(0u, buf->pop(out, 1));
+}
+
+TEST_F(TestSPSCRingBuffer, spans)
+{
+    EXPECT_TRUE(buf->readable_span().empty());
+
+    mbed::Span<int> free = buf->writable_span();
+    EXPECT_EQ(8, free.size());
+    for (int i = 0; i < 6; i++) {
+        free[i] = i;
+    }
+    buf->commit(6);
+
+    mbed::Span<const int> data = buf->readable_span();
+    EXPECT_EQ(6, data.size());
+    EXPECT_EQ(0, data[0]);
+    buf->consume(4);
+
+    // free space wraps, so it comes in two parts
+    EXPECT_EQ(2, buf->writable_span().size());
+    buf->commit(2);
+    EXPECT_EQ(4, buf->writable_span().size());
+    buf->commit(4);
+    EXPECT_TRUE(buf->full());
+    EXPECT_TRUE(buf->writable_span().empty());
+
+    data = buf->readable_span();
+    EXPECT_EQ(4, data.size());
+    EXPECT_EQ(4, data[0]);
+    buf->consume(4);
+    EXPECT_EQ(4, buf->readable_span().size());
+}
@@ -0,0 +1,13 @@
+
+####################
+# UNIT TESTS
+####################
+
+set(unittest-sources
+)
+
+set(unittest-test-sources
+  platform/SPSCRingBuffer/test_SPSCRingBuffer.cpp
+  stubs/mbed_assert_stub.c
+  stubs/mbed_critical_stub.c
+)
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "platform/mbed_tlsf.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define POOL_SIZE   (64 * 1024)
+
+class TestTLSF : public testing::Test {
+protected:
+    mbed_tlsf_t tlsf;
+    char *pool;
+    size_t initial_free;
+
+    virtual void SetUp()
+    {
+        pool = new char[POOL_SIZE];
+        ASSERT_EQ(0, mbed_tlsf_init(&tlsf, pool, POOL_SIZE));
+        initial_free = stats().free_size;
+    }
+
+    virtual void TearDown()
+    {
+        delete[] pool;
+    }
+
+    mbed_tlsf_stats_t stats()
+    {
+        mbed_tlsf_stats_t stats;
+        mbed_tlsf_get_stats(&tlsf, &stats);
+        return stats;
+    }
+};
+
+static void count_owned(void *ptr, size_t size, void *owner, void *context)
+{
+    if (owner == context) {
+        // the context doubles as the owner to count
+        (*(size_t *)owner) += size;
+    }
+}
+
+TEST_F(TestTLSF, init)
+{
+    mbed_tlsf_t small;
+    char mem[16];
+    EXPECT_EQ(-1, mbed_tlsf_init(&small, mem, sizeof(mem)));
+
+    EXPECT_EQ(1u, stats().free_block_cnt);
+    EXPECT_EQ(initial_free, stats().largest_free_size);
+    EXPECT_GT(initial_free, POOL_SIZE - 128u);
+}
+
+TEST_F(TestTLSF, malloc_free_coalesces)
+{
+    void *ptrs[32];
+    for (int i = 0; i < 32; i++) {
+        ptrs[i] = mbed_tlsf_malloc(&tlsf, 100 + i * 10, NULL);
+        ASSERT_TRUE(ptrs[i] != NULL);
+        EXPECT_EQ(0u, (uintptr_t)ptrs[i] % MBED_TLSF_ALIGN);
+        EXPECT_EQ(100u + i * 10, mbed_tlsf_requested_size(ptrs[i]));
+        memset(ptrs[i], i, 100 + i * 10);
+    }
+
+    // free every other block, the holes can't coalesce
+    for (int i = 0; i < 32; i += 2) {
+        mbed_tlsf_free(&tlsf, ptrs[i]);
+    }
+    EXPECT_EQ(17u, stats().free_block_cnt);
+
+    for (int i = 1; i < 32; i += 2) {
+        EXPECT_EQ(i, ((unsigned char *)ptrs[i])[99]);
+        mbed_tlsf_free(&tlsf, ptrs[i]);
+    }
+    EXPECT_EQ(1u, stats().free_block_cnt);
+    EXPECT_EQ(initial_free, stats().free_size);
+}
+
+TEST_F(TestTLSF, malloc_exhausts)
+{
+    EXPECT_TRUE(mbed_tlsf_malloc(&tlsf, POOL_SIZE, NULL) == NULL);
+
+    void *ptrs[POOL_SIZE / 1024];
+    int count = 0;
+    while ((ptrs[count] = mbed_tlsf_malloc(&tlsf, 1000, NULL)) != NULL) {
+        count++;
+    }
+    // requests are rounded up to the next size class, so a little is left
+    EXPECT_GE(count, POOL_SIZE / 1024 - 2);
+    EXPECT_LT(stats().largest_free_size, 1000u + 128u);
+
+    for (int i = 0; i < count; i++) {
+        mbed_tlsf_free(&tlsf, ptrs[i]);
+    }
+    EXPECT_EQ(initial_free, stats().free_size);
+    EXPECT_TRUE(mbed_tlsf_malloc(&tlsf, initial_free / 2, NULL) != NULL);
+}
+
+TEST_F(TestTLSF, memalign)
+{
+    void *ptr = mbed_tlsf_malloc(&tlsf, 8, NULL);
+    for (size_t align = 16; align <= 1024; align *= 2) {
+        void *aligned = mbed_tlsf_memalign(&tlsf, align, 40, NULL);
+        ASSERT_TRUE(aligned != NULL);
+        EXPECT_EQ(0u, (uintptr_t)aligned % align);
+        mbed_tlsf_free(&tlsf, aligned);
+    }
+    mbed_tlsf_free(&tlsf, ptr);
+    EXPECT_EQ(1u, stats().free_block_cnt);
+    EXPECT_EQ(initial_free, stats().free_size);
+}
+
+TEST_F(TestTLSF, realloc)
+{
+    char *a = (char *)mbed_tlsf_malloc(&tlsf, 64, NULL);
+    memset(a, 'a', 64);
+
+    // grows in place into the free space after it
+    char *b = (char *)mbed_tlsf_realloc(&tlsf, a, 256, NULL);
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(256u, mbed_tlsf_requested_size(b));
+
+    // moves once blocked by another allocation
+    void *c = mbed_tlsf_malloc(&tlsf, 16, NULL);
+    char *d = (char *)mbed_tlsf_realloc(&tlsf, b, 1024, NULL);
+    EXPECT_NE(b, d);
+    for (int i = 0; i < 64; i++) {
+        EXPECT_EQ('a', d[i]);
+    }
+
+    // shrinking stays in place
+    EXPECT_EQ(d, mbed_tlsf_realloc(&tlsf, d, 32, NULL));
+    EXPECT_TRUE(mbed_tlsf_realloc(&tlsf, d, 0, NULL) == NULL);
+    mbed_tlsf_free(&tlsf, c);
+    EXPECT_EQ(initial_free, stats().free_size);
+}
+
+TEST_F(TestTLSF, walk_owner)
+{
+    size_t owned = 0;
+    void *a = mbed_tlsf_malloc(&tlsf, 100, &owned);
+    void *b = mbed_tlsf_malloc(&tlsf, 50, NULL);
+    void *c = mbed_tlsf_malloc(&tlsf, 30, &owned);
+
+    mbed_tlsf_walk(&tlsf, count_owned, &owned);
+    EXPECT_EQ(130u, owned);
+
+    mbed_tlsf_free(&tlsf, a);
+    mbed_tlsf_free(&tlsf, b);
+    mbed_tlsf_free(&tlsf, c);
+}
+
+TEST_F(TestTLSF, random)
+{
+    void *ptrs[64] = {0};
+    srand(1);
+    for (int n = 0; n < 10000; n++) {
+        int i = rand() % 64;
+        if (ptrs[i]) {
+            mbed_tlsf_free(&tlsf, ptrs[i]);
+            ptrs[i] = NULL;
+        } else if (rand() % 4) {
+            ptrs[i] = mbed_tlsf_malloc(&tlsf, rand() % 2048, NULL);
+        } else {
+            ptrs[i] = mbed_tlsf_memalign(&tlsf, 32, rand() % 512, NULL);
+        }
+    }
+    for (int i = 0; i < 64; i++) {
+        mbed_tlsf_free(&tlsf, ptrs[i]);
+    }
+    EXPECT_EQ(1u, stats().free_block_cnt);
+    EXPECT_EQ(initial_free, stats().free_size);
+}
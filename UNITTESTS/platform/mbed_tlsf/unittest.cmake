@@ -0,0 +1,13 @@
+
+####################
+# UNIT TESTS
+####################
+
+set(unittest-sources
+  ../platform/mbed_tlsf.c
+)
+
+set(unittest-test-sources
+  platform/mbed_tlsf/test_mbed_tlsf.cpp
+  stubs/mbed_assert_stub.c
+)
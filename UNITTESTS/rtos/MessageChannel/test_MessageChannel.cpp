@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "rtos/MessageChannel.h"
+#include <list>
+#include <string.h>
+
+using namespace rtos;
+
+extern std::list<uint32_t> eventFlagsStubNextRetval;
+
+#define ARENA_SIZE  128
+#define HEADER_SIZE 8
+
+class TestMessageChannel : public testing::Test {
+protected:
+    MessageChannel<ARENA_SIZE> channel;
+
+    virtual void TearDown()
+    {
+        eventFlagsStubNextRetval.clear();
+    }
+};
+
+TEST_F(TestMessageChannel, borrow_commit_receive_release)
+{
+    uint32_t size = 0;
+    EXPECT_FALSE(channel.readable());
+    EXPECT_EQ(NULL, channel.receive(&size));
+
+    char *msg = (char *)channel.borrow(5);
+    ASSERT_TRUE(msg != NULL);
+    EXPECT_EQ(0u, (uintptr_t)msg % 8);
+    memcpy(msg, "hello", 5);
+    EXPECT_FALSE(channel.readable());
+    channel.commit(msg, 5);
+    EXPECT_TRUE(channel.readable());
+
+    char *got = (char *)channel.receive(&size);
+    EXPECT_EQ(msg, got);
+    EXPECT_EQ(5u, size);
+    EXPECT_EQ(0, memcmp(got, "hello", 5));
+    EXPECT_FALSE(channel.readable());
+    channel.release(got);
+}
+
+TEST_F(TestMessageChannel, commit_shorter)
+{
+    uint32_t size = 0;
+    void *msg = channel.borrow(40);
+    ASSERT_TRUE(msg != NULL);
+    channel.commit(msg, 3);
+    EXPECT_EQ(msg, channel.receive(&size));
+    EXPECT_EQ(3u, size);
+    channel.release(msg);
+}
+
+TEST_F(TestMessageChannel, fifo_order_and_variable_size)
+{
+    uint32_t size = 0;
+    void *a = channel.borrow(1);
+    void *b = channel.borrow(20);
+    void *c = channel.borrow(9);
+    ASSERT_TRUE(a != NULL && b != NULL && c != NULL);
+
+    // An uncommitted message holds back the ones borrowed after it
+    channel.commit(b, 20);
+    channel.commit(c, 9);
+    EXPECT_FALSE(channel.readable());
+    channel.commit(a, 1);
+
+    EXPECT_EQ(a, channel.receive(&size));
+    EXPECT_EQ(1u, size);
+    EXPECT_EQ(b, channel.receive(&size));
+    EXPECT_EQ(20u, size);
+    EXPECT_EQ(c, channel.receive(&size));
+    EXPECT_EQ(9u, size);
+    channel.release(c);
+    channel.release(a);
+    channel.release(b);
+}
+
+TEST_F(TestMessageChannel, full_and_too_large)
+{
+    EXPECT_EQ(ARENA_SIZE - HEADER_SIZE, channel.max_message_size());
+    EXPECT_EQ(NULL, channel.borrow(ARENA_SIZE));
+
+    void *msg = channel.borrow(channel.max_message_size());
+    ASSERT_TRUE(msg != NULL);
+    EXPECT_EQ(NULL, channel.borrow(1));
+
+    // A timed out wait returns NULL
+    eventFlagsStubNextRetval.push_back(osFlagsErrorTimeout);
+    EXPECT_EQ(NULL, channel.borrow(1, 10));
+
+    channel.release(msg);
+    EXPECT_TRUE(channel.borrow(channel.max_message_size()) != NULL);
+}
+
+TEST_F(TestMessageChannel, space_reclaimed_in_order)
+{
+    uint32_t size = 0;
+    void *a = channel.borrow(56);
+    void *b = channel.borrow(56);
+    ASSERT_TRUE(a != NULL && b != NULL);
+    channel.commit(a, 56);
+    channel.commit(b, 56);
+    EXPECT_EQ(a, channel.receive(&size));
+    EXPECT_EQ(b, channel.receive(&size));
+
+    // Releasing the second message first frees nothing
+    channel.release(b);
+    EXPECT_EQ(NULL, channel.borrow(1));
+    channel.release(a);
+    EXPECT_TRUE(channel.borrow(1) != NULL);
+}
+
+TEST_F(TestMessageChannel, wrap_around)
+{
+    uint32_t size = 0;
+    // 48 + 48 bytes used, 32 left at the end
+    void *a = channel.borrow(40);
+    void *b = channel.borrow(40);
+    ASSERT_TRUE(a != NULL && b != NULL);
+    channel.commit(a, 40);
+    channel.commit(b, 40);
+    EXPECT_EQ(a, channel.receive(&size));
+    channel.release(a);
+
+    // Doesn't fit at the end, so starts again at the beginning
+    void *c = channel.borrow(40);
+    EXPECT_EQ(a, c);
+    channel.commit(c, 40);
+
+    EXPECT_EQ(b, channel.receive(&size));
+    EXPECT_EQ(c, channel.receive(&size));
+    EXPECT_EQ(40u, size);
+    channel.release(b);
+    channel.release(c);
+
+    // Everything released, the whole arena is available again
+    EXPECT_TRUE(channel.borrow(channel.max_message_size()) != NULL);
+}
+
+TEST_F(TestMessageChannel, discard_borrowed)
+{
+    uint32_t size = 0;
+    void *a = channel.borrow(56);
+    void *b = channel.borrow(56);
+    ASSERT_TRUE(a != NULL && b != NULL);
+    channel.commit(b, 56);
+
+    // Discarding the first message lets the second through and frees its space
+    channel.release(a);
+    EXPECT_TRUE(channel.readable());
+    EXPECT_EQ(b, channel.receive(&size));
+    EXPECT_TRUE(channel.borrow(56) != NULL);
+    channel.release(b);
+}
+
+TEST_F(TestMessageChannel, many_messages)
+{
+    uint32_t size = 0;
+    for (uint32_t i = 0; i < 200; i++) {
+        uint32_t len = 1 + (i * 7) % 50;
+        char *msg = (char *)channel.borrow(len);
+        ASSERT_TRUE(msg != NULL);
+        memset(msg, (char)i, len);
+        channel.commit(msg, len);
+        if (i % 2) {
+            // Keep one message in flight every other round
+            char *got = (char *)channel.receive(&size);
+            ASSERT_TRUE(got != NULL);
+            channel.release(got);
+            got = (char *)channel.receive(&size);
+            ASSERT_TRUE(got != NULL);
+            EXPECT_EQ(len, size);
+            EXPECT_EQ((char)i, got[len - 1]);
+            channel.release(got);
+        }
+    }
+    EXPECT_FALSE(channel.readable());
+}
@@ -0,0 +1,16 @@
+
+####################
+# UNIT TESTS
+####################
+
+set(unittest-sources
+  ../rtos/MessageChannel.cpp
+)
+
+set(unittest-test-sources
+  rtos/MessageChannel/test_MessageChannel.cpp
+  stubs/EventFlags_stub.cpp
+  stubs/Kernel_stub.cpp
+  stubs/mbed_critical_stub.c
+  stubs/mbed_assert_stub.c
+)
@@ -381,3 +381,12 @@ void ATHandler::flush()
 {
 
 }
+
+void ATHandler::set_power_save_callback(Callback<void(bool)> cb, uint32_t idle_ms, uint32_t batch_ms)
+{
+}
+
+void ATHandler::get_power_save_stats(power_save_stats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+}
@@ -218,6 +218,15 @@ nsapi_connection_status_t AT_CellularContext::get_connection_status() const
     return NSAPI_STATUS_DISCONNECTED;
 }
 
+nsapi_error_t AT_CellularContext::get_connection_timeline(nsapi_connection_timeline_t *timeline)
+{
+    return NSAPI_ERROR_OK;
+}
+
+void AT_CellularContext::record_phase(nsapi_connection_phase_t phase)
+{
+}
+
 nsapi_error_t AT_CellularContext::get_apn_backoff_timer(int &backoff_timer)
 {
     return NSAPI_ERROR_OK;
@@ -35,7 +35,8 @@ const uint16_t SMS_MAX_GSM7_CONCATENATED_SINGLE_SMS_SIZE = 153;
 
 
 AT_CellularSMS::AT_CellularSMS(ATHandler &at) : AT_CellularBase(at), _cb(0), _mode(CellularSMSMmodeText),
-    _use_8bit_encoding(false), _sim_wait_time(0), _sms_message_ref_number(1), _sms_info(NULL)
+    _use_8bit_encoding(false), _sim_wait_time(0), _sms_message_ref_number(1), _sms_info(NULL), _sms_info_count(0),
+    _sms_info_size(0), _sms_ref_table(NULL), _pdu(NULL), _pdu_size(0)
 {
 }
 
@@ -158,7 +159,21 @@ nsapi_size_or_error_t AT_CellularSMS::read_pdu_payload(const char *pdu, int msg_
     return NSAPI_ERROR_OK;
 }
 
-void AT_CellularSMS::free_linked_list()
+void AT_CellularSMS::free_sms_info()
+{
+}
+
+char *AT_CellularSMS::get_pdu_buffer(int size)
+{
+    return NULL;
+}
+
+AT_CellularSMS::sms_info_t *AT_CellularSMS::alloc_info()
+{
+    return NULL;
+}
+
+void AT_CellularSMS::add_ref(uint16_t pool_index)
 {
 }
 
@@ -166,7 +181,7 @@ void AT_CellularSMS::add_info(sms_info_t *info, int index, int part_number)
 {
 }
 
-// reads all the messages to the linked list AT_CellularSMS::_sms_info
+// reads all the messages to the pool AT_CellularSMS::_sms_info
 nsapi_error_t AT_CellularSMS::list_messages()
 {
     return NSAPI_ERROR_OK;
@@ -26,7 +26,7 @@ static inline uint32_t align_down(bd_size_t val, bd_size_t size)
     return 0;
 }
 
-BufferedBlockDevice::BufferedBlockDevice(BlockDevice *bd)
+BufferedBlockDevice::BufferedBlockDevice(BlockDevice *bd, uint32_t cache_lines)
 {
 }
 
@@ -24,10 +24,12 @@ class ControlPlane_netif_stub : public ControlPlane_netif {
 public:
     std::list<nsapi_error_t> return_values;
     nsapi_error_t return_value;
+    void *cancelled_buffer;
 
     ControlPlane_netif_stub()
     {
         return_value = 0;
+        cancelled_buffer = NULL;
     }
 
 protected:
@@ -51,6 +53,11 @@ protected:
         return return_value;
     };
 
+    virtual void recv_cancel(void *cpdata)
+    {
+        cancelled_buffer = cpdata;
+    };
+
     virtual void data_received() {};
 
     virtual void attach(void (*callback)(void *), void *data) {};
@@ -36,6 +36,10 @@ uint32_t rtos::EventFlags::get() const
 {
     return 0;
 }
+bool rtos::EventFlags::ready() const
+{
+    return false;
+}
 uint32_t rtos::EventFlags::wait_all(uint32_t flags, uint32_t timeout, bool clear)
 {
     return 0;
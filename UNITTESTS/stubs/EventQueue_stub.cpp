@@ -30,6 +30,11 @@ EventQueue::EventQueue(unsigned event_size, unsigned char *event_pointer)
 {
 }
 
+EventQueue::EventQueue(unsigned event_size, unsigned char *event_pointer,
+                       const size_t *classes, int count)
+{
+}
+
 EventQueue::~EventQueue()
 {
 }
@@ -38,6 +43,16 @@ void EventQueue::dispatch(int ms)
 {
 }
 
+int EventQueue::dispatch_due()
+{
+    return EventQueue_stub::int_value;
+}
+
+int EventQueue::deadline()
+{
+    return EventQueue_stub::int_value;
+}
+
 void EventQueue::break_dispatch()
 {
 }
@@ -60,6 +75,19 @@ void EventQueue::background(Callback<void(int)> update)
 {
 }
 
+void EventQueue::get_stats(equeue_stats_t *stats)
+{
+}
+
+int EventQueue::get_class_stats(equeue_class_stats_t *stats, int count)
+{
+    return 0;
+}
+
+void EventQueue::reset_stats()
+{
+}
+
 int EventQueue::chain(EventQueue *target)
 {
 }
@@ -24,6 +24,16 @@ off_t FileHandle::size()
     return 0;
 }
 
+int FileHandle::read_async(void *buffer, size_t size, Callback<void(ssize_t)> done)
+{
+    return 0;
+}
+
+int FileHandle::write_async(const void *buffer, size_t size, Callback<void(ssize_t)> done)
+{
+    return 0;
+}
+
 std::FILE *fdopen(FileHandle *fh, const char *mode)
 {
     return NULL;
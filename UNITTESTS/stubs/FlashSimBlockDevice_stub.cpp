@@ -96,3 +96,20 @@ int FlashSimBlockDevice::get_erase_value() const
 {
     return 0;
 }
+
+void FlashSimBlockDevice::set_timing(const flash_sim_timing_t &timing)
+{
+}
+
+uint64_t FlashSimBlockDevice::get_time_ns() const
+{
+    return 0;
+}
+
+void FlashSimBlockDevice::advance_time(uint64_t ns)
+{
+}
+
+void FlashSimBlockDevice::reset_time()
+{
+}
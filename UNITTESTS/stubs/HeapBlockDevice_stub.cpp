@@ -27,6 +27,10 @@ HeapBlockDevice::HeapBlockDevice(bd_size_t size, bd_size_t read, bd_size_t progr
 {
 }
 
+HeapBlockDevice::HeapBlockDevice(bd_size_t size, bd_size_t read, bd_size_t program, bd_size_t erase, void *arena)
+{
+}
+
 HeapBlockDevice::~HeapBlockDevice()
 {
 }
@@ -81,3 +85,8 @@ int HeapBlockDevice::erase(bd_addr_t addr, bd_size_t size)
     return 0;
 }
 
+
+uint8_t *HeapBlockDevice::get_buffer() const
+{
+    return 0;
+}
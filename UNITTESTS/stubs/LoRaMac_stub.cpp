@@ -305,6 +305,11 @@ bool LoRaMac::tx_ongoing()
     return LoRaMac_stub::bool_value;
 }
 
+uint8_t LoRaMac::get_max_tx_payload_size()
+{
+    return LoRaMac_stub::uint8_value;
+}
+
 void LoRaMac::set_tx_ongoing(bool ongoing)
 {
 }
@@ -72,6 +72,11 @@ nsapi_connection_status_t NetworkInterface::get_connection_status() const
     return NSAPI_STATUS_LOCAL_UP;
 }
 
+nsapi_error_t NetworkInterface::get_connection_timeline(nsapi_connection_timeline_t *timeline)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
 nsapi_error_t NetworkInterface::set_blocking(bool blocking)
 {
     return NSAPI_ERROR_UNSUPPORTED;
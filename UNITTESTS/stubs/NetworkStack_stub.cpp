@@ -57,6 +57,35 @@ nsapi_error_t NetworkStack::getsockopt(void *handle, int level, int optname, voi
     return NSAPI_ERROR_UNSUPPORTED;
 }
 
+nsapi_size_or_error_t NetworkStack::socket_sendmsg(nsapi_socket_t handle, const SocketAddress *address,
+                                                   const nsapi_iovec_t *iov, unsigned iovcnt)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_recvmsg(nsapi_socket_t handle, SocketAddress *address,
+                                                   nsapi_iovec_t *iov, unsigned iovcnt)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_recv_buf(nsapi_socket_t handle, net_stack_mem_buf_t **buf)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_sendto_buf(nsapi_socket_t handle, const SocketAddress &address,
+                                                      net_stack_mem_buf_t *buf)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_recvfrom_buf(nsapi_socket_t handle, SocketAddress *address,
+                                                        net_stack_mem_buf_t **buf)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
 // Conversion function for network stacks
 NetworkStack *nsapi_create_stack(nsapi_stack_t *stack)
 {
@@ -84,6 +84,12 @@ protected:
     virtual nsapi_error_t socket_accept(nsapi_socket_t server,
                                         nsapi_socket_t *handle, SocketAddress *address = 0)
     {
+        if (return_value == NSAPI_ERROR_OK) {
+            *handle = reinterpret_cast<nsapi_socket_t *>(1234);
+            if (address) {
+                *address = return_socketAddress;
+            }
+        }
         return return_value;
     };
     virtual nsapi_size_or_error_t socket_send(nsapi_socket_t handle,
@@ -124,6 +130,44 @@ protected:
         }
         return return_value;
     };
+    virtual nsapi_size_or_error_t socket_recv_buf(nsapi_socket_t handle, net_stack_mem_buf_t **buf)
+    {
+        nsapi_error_t ret = return_value;
+        if (!return_values.empty()) {
+            ret = return_values.front();
+            return_values.pop_front();
+        }
+        if (ret >= 0) {
+            *buf = reinterpret_cast<net_stack_mem_buf_t *>(1234);
+        }
+        return ret;
+    };
+    virtual nsapi_size_or_error_t socket_sendto_buf(nsapi_socket_t handle, const SocketAddress &address,
+                                                    net_stack_mem_buf_t *buf)
+    {
+        if (!return_values.empty()) {
+            nsapi_error_t ret = return_values.front();
+            return_values.pop_front();
+            return ret;
+        }
+        return return_value;
+    };
+    virtual nsapi_size_or_error_t socket_recvfrom_buf(nsapi_socket_t handle, SocketAddress *address,
+                                                      net_stack_mem_buf_t **buf)
+    {
+        if (return_socketAddress != SocketAddress()) {
+            *address = return_socketAddress;
+        }
+        nsapi_error_t ret = return_value;
+        if (!return_values.empty()) {
+            ret = return_values.front();
+            return_values.pop_front();
+        }
+        if (ret >= 0) {
+            *buf = reinterpret_cast<net_stack_mem_buf_t *>(1234);
+        }
+        return ret;
+    };
     virtual void socket_attach(nsapi_socket_t handle, void (*callback)(void *), void *data) {};
 
 private:
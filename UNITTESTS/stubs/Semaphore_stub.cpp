@@ -52,6 +52,11 @@ osStatus Semaphore::release(void)
     return 0;
 }
 
+bool Semaphore::ready() const
+{
+    return false;
+}
+
 Semaphore::~Semaphore()
 {
 
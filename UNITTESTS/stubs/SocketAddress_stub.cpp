@@ -119,3 +119,13 @@ bool operator!=(const SocketAddress &a, const SocketAddress &b)
 {
     return false;
 }
+
+bool operator<(const SocketAddress &a, const SocketAddress &b)
+{
+    return false;
+}
+
+uint32_t SocketAddress::hash() const
+{
+    return 0;
+}
@@ -61,3 +61,13 @@ void SocketStats::stats_update_recv_bytes(const Socket *const reference_id, size
 {
     return;
 }
+
+void SocketStats::stats_update_send_blocked(const Socket *const reference_id, uint32_t blocked_ms)
+{
+    return;
+}
+
+void SocketStats::stats_update_tcp_info(const Socket *const reference_id, const nsapi_tcp_info_t &info)
+{
+    return;
+}
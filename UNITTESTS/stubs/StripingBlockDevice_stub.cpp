@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "StripingBlockDevice.h"
+
+
+StripingBlockDevice::StripingBlockDevice(BlockDevice **bds, size_t bd_count)
+{
+}
+
+StripingBlockDevice::~StripingBlockDevice()
+{
+}
+
+int StripingBlockDevice::init()
+{
+    return 0;
+}
+
+int StripingBlockDevice::deinit()
+{
+    return 0;
+}
+
+int StripingBlockDevice::sync()
+{
+    return 0;
+}
+
+int StripingBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
+{
+    return 0;
+}
+
+int StripingBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
+{
+    return 0;
+}
+
+int StripingBlockDevice::erase(bd_addr_t addr, bd_size_t size)
+{
+    return 0;
+}
+
+int StripingBlockDevice::read_async(void *b, bd_addr_t addr, bd_size_t size, bd_callback_t callback)
+{
+    return 0;
+}
+
+int StripingBlockDevice::program_async(const void *b, bd_addr_t addr, bd_size_t size, bd_callback_t callback)
+{
+    return 0;
+}
+
+int StripingBlockDevice::erase_async(bd_addr_t addr, bd_size_t size, bd_callback_t callback)
+{
+    return 0;
+}
+
+bd_size_t StripingBlockDevice::get_read_size() const
+{
+    return 0;
+}
+
+bd_size_t StripingBlockDevice::get_program_size() const
+{
+    return 0;
+}
+
+bd_size_t StripingBlockDevice::get_erase_size() const
+{
+    return 0;
+}
+
+bd_size_t StripingBlockDevice::get_erase_size(bd_addr_t addr) const
+{
+    return 0;
+}
+
+int StripingBlockDevice::get_erase_value() const
+{
+    return 0;
+}
+
+bd_size_t StripingBlockDevice::size() const
+{
+    return 0;
+}
+
+const char *StripingBlockDevice::get_type() const
+{
+    return 0;
+}
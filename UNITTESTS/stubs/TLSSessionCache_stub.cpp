@@ -0,0 +1,66 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TLSSessionCache.h"
+
+#if defined(MBEDTLS_SSL_CLI_C)
+
+#include <string>
+
+// Key of the last session stored
+std::string tlsSessionCacheStubKey;
+
+TLSSessionCache::TLSSessionCache(unsigned size)
+    : _entries(NULL), _size(0), _use_counter(0), _kvstore(NULL)
+{
+}
+
+TLSSessionCache::~TLSSessionCache()
+{
+}
+
+TLSSessionCache *TLSSessionCache::get_default_instance()
+{
+    return NULL;
+}
+
+void TLSSessionCache::set_kvstore(mbed::KVStore *kvstore)
+{
+}
+
+bool TLSSessionCache::apply(const char *hostname, mbedtls_ssl_context *ssl)
+{
+    return false;
+}
+
+nsapi_error_t TLSSessionCache::store(const char *hostname, const mbedtls_ssl_context *ssl)
+{
+    if (!hostname) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+    tlsSessionCacheStubKey = hostname;
+    return NSAPI_ERROR_OK;
+}
+
+void TLSSessionCache::remove(const char *hostname)
+{
+}
+
+void TLSSessionCache::clear()
+{
+}
+
+#endif // MBEDTLS_SSL_CLI_C
@@ -130,4 +130,24 @@ void UARTSerial::set_flow_control(mbed::SerialBase::Flow, PinName, PinName)
 
 }
 
+#if DEVICE_SERIAL_ASYNCH
+int UARTSerial::set_dma_rx(bool enabled, unsigned char delimiter)
+{
+    return 0;
+}
+
+Span<const uint8_t> UARTSerial::rx_peek()
+{
+    return Span<const uint8_t>();
+}
+
+void UARTSerial::rx_consume(size_t length)
+{
+}
+
+void UARTSerial::set_dma_tx(bool enabled)
+{
+}
+#endif
+
 }
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "WearStatsBlockDevice.h"
+
+
+WearStatsBlockDevice::WearStatsBlockDevice(BlockDevice *bd, bd_size_t stats_size)
+{
+}
+
+WearStatsBlockDevice::~WearStatsBlockDevice()
+{
+}
+
+int WearStatsBlockDevice::init()
+{
+    return 0;
+}
+
+int WearStatsBlockDevice::deinit()
+{
+    return 0;
+}
+
+int WearStatsBlockDevice::sync()
+{
+    return 0;
+}
+
+int WearStatsBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
+{
+    return 0;
+}
+
+int WearStatsBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
+{
+    return 0;
+}
+
+int WearStatsBlockDevice::erase(bd_addr_t addr, bd_size_t size)
+{
+    return 0;
+}
+
+bd_size_t WearStatsBlockDevice::get_read_size() const
+{
+    return 0;
+}
+
+bd_size_t WearStatsBlockDevice::get_program_size() const
+{
+    return 0;
+}
+
+bd_size_t WearStatsBlockDevice::get_erase_size() const
+{
+    return 0;
+}
+
+bd_size_t WearStatsBlockDevice::get_erase_size(bd_addr_t addr) const
+{
+    return 0;
+}
+
+int WearStatsBlockDevice::get_erase_value() const
+{
+    return 0;
+}
+
+bd_size_t WearStatsBlockDevice::size() const
+{
+    return 0;
+}
+
+const char *WearStatsBlockDevice::get_type() const
+{
+    return NULL;
+}
+
+int WearStatsBlockDevice::save()
+{
+    return 0;
+}
+
+void WearStatsBlockDevice::reset()
+{
+}
+
+void WearStatsBlockDevice::add_requested_count(bd_size_t size)
+{
+}
+
+bd_size_t WearStatsBlockDevice::get_requested_count() const
+{
+    return 0;
+}
+
+bd_size_t WearStatsBlockDevice::get_read_count() const
+{
+    return 0;
+}
+
+bd_size_t WearStatsBlockDevice::get_program_count() const
+{
+    return 0;
+}
+
+bd_size_t WearStatsBlockDevice::get_erase_count() const
+{
+    return 0;
+}
+
+bd_size_t WearStatsBlockDevice::get_unit_count() const
+{
+    return 0;
+}
+
+uint32_t WearStatsBlockDevice::get_unit_erase_count(bd_addr_t addr) const
+{
+    return 0;
+}
+
+uint32_t WearStatsBlockDevice::get_max_erase_count() const
+{
+    return 0;
+}
+
+uint32_t WearStatsBlockDevice::get_latency_count(operation op, int bucket) const
+{
+    return 0;
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+#include "ns_types.h"
+#include "Core/include/address.h"
+#include "Common_Protocols/ipv6_constants.h"
+
+const uint8_t ADDR_UNSPECIFIED[16] = { 0 };
+const uint8_t ADDR_ALL_MPL_FORWARDERS[16] = { 0xff, 0x03, [15] = 0xfc };
+
+uint8_t addr_len_from_type(addrtype_t addr_type)
+{
+    switch (addr_type) {
+        case ADDR_802_15_4_SHORT:
+            return 2 + 2;
+        case ADDR_802_15_4_LONG:
+            return 2 + 8;
+        case ADDR_EUI_48:
+            return 6;
+        case ADDR_IPV6:
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+bool addr_is_ipv6_link_local(const uint8_t addr[static 16])
+{
+    return addr[0] == 0xfe && (addr[1] & 0xc0) == 0x80;
+}
+
+uint_fast8_t addr_ipv6_scope(const uint8_t addr[static 16], const struct protocol_interface_info_entry *interface)
+{
+    (void)interface;
+    if (addr[0] == 0xff) {
+        return addr[1] & 0x0f;
+    }
+    if (addr_is_ipv6_link_local(addr)) {
+        return IPV6_SCOPE_LINK_LOCAL;
+    }
+    return IPV6_SCOPE_GLOBAL;
+}
+
+bool addr_ipv6_equal(const uint8_t a[static 16], const uint8_t b[static 16])
+{
+    return memcmp(a, b, 16) == 0;
+}
+
+const uint8_t *addr_select_source(struct protocol_interface_info_entry *interface, const uint8_t dest[static 16], uint32_t addr_preferences)
+{
+    return NULL;
+}
+
+bool addr_is_assigned_to_interface(const struct protocol_interface_info_entry *interface, const uint8_t addr[static 16])
+{
+    return false;
+}
+
+struct if_group_entry *addr_add_group(struct protocol_interface_info_entry *interface, const uint8_t group[static 16])
+{
+    return NULL;
+}
+
+void addr_delete_group(struct protocol_interface_info_entry *interface, const uint8_t group[static 16])
+{
+}
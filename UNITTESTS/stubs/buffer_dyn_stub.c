@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nsconfig.h"
+#include <stdlib.h>
+#include <string.h>
+#include "ns_types.h"
+#include "Core/include/ns_buffer.h"
+
+#define BUFFER_STUB_HEADROOM 40
+
+buffer_t *buffer_get(uint16_t size)
+{
+    buffer_t *buf = calloc(1, sizeof(buffer_t) + BUFFER_STUB_HEADROOM + size);
+    if (!buf) {
+        return NULL;
+    }
+    buf->size = BUFFER_STUB_HEADROOM + size;
+    buf->buf_ptr = BUFFER_STUB_HEADROOM;
+    buf->buf_end = BUFFER_STUB_HEADROOM;
+    return buf;
+}
+
+buffer_t *buffer_free(buffer_t *buf)
+{
+    free(buf);
+    return NULL;
+}
+
+buffer_t *buffer_headroom(buffer_t *buf, uint16_t size)
+{
+    if (buf->buf_ptr >= size) {
+        return buf;
+    }
+    uint16_t len = buf->buf_end - buf->buf_ptr;
+    buffer_t *copy = realloc(buf, sizeof(buffer_t) + size + len);
+    if (!copy) {
+        free(buf);
+        return NULL;
+    }
+    memmove(copy->buf + size, copy->buf + copy->buf_ptr, len);
+    copy->size = size + len;
+    copy->buf_ptr = size;
+    copy->buf_end = size + len;
+    return copy;
+}
+
+void buffer_data_add(buffer_t *buf, const uint8_t *data_ptr, uint16_t data_len)
+{
+    memcpy(buffer_data_end(buf), data_ptr, data_len);
+    buf->buf_end += data_len;
+}
@@ -42,6 +42,16 @@ void equeue_dispatch(equeue_t *queue, int ms)
 
 }
 
+int equeue_dispatch_due(equeue_t *queue)
+{
+    return 0;
+}
+
+int equeue_deadline(equeue_t *queue)
+{
+    return -1;
+}
+
 void equeue_break(equeue_t *queue)
 {
 
@@ -82,6 +92,11 @@ void equeue_event_dtor(void *event, void (*dtor)(void *))
 
 }
 
+void equeue_event_priority(void *event, int priority)
+{
+
+}
+
 int equeue_post(equeue_t *queue, void (*cb)(void *), void *event)
 {
     struct equeue_event *e = (struct equeue_event *)event - 1;
@@ -92,6 +107,53 @@ int equeue_post(equeue_t *queue, void (*cb)(void *), void *event)
     return 0;
 }
 
+int equeue_create_classes(equeue_t *queue, size_t size, void *buffer,
+                          const size_t *classes, int count)
+{
+    return 0;
+}
+
+int equeue_get_class_stats(equeue_t *queue, equeue_class_stats_t *stats,
+                           int count)
+{
+    return 0;
+}
+
+void equeue_get_stats(equeue_t *queue, equeue_stats_t *stats)
+{
+}
+
+void equeue_reset_stats(equeue_t *queue)
+{
+}
+
+void *equeue_alloc_batch(equeue_t *queue, size_t size, int count)
+{
+    return equeue_stub.void_ptr;
+}
+
+void *equeue_batch_next(void *event)
+{
+    return 0;
+}
+
+int equeue_post_batch(equeue_t *queue, void (*cb)(void *), void *event,
+                      int *ids)
+{
+    return equeue_post(queue, cb, event);
+}
+
+int equeue_call_batch(equeue_t *queue, void (*const *cbs)(void *),
+                      void *const *data, int count, int *ids)
+{
+    return 0;
+}
+
+int equeue_post_isr(equeue_t *queue, void (*cb)(void *), void *event)
+{
+    return equeue_post(queue, cb, event);
+}
+
 void equeue_cancel(equeue_t *queue, int id)
 {
 
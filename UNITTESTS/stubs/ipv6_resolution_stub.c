@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ns_types.h"
+#include "ipv6_stack/ipv6_routing_table.h"
+#include "Common_Protocols/ipv6_resolution.h"
+
+ipv6_neighbour_cache_t *ipv6_resolution_stub_cache;
+
+void ipv6_interface_resolve_send_ns(ipv6_neighbour_cache_t *cache, ipv6_neighbour_t *entry, bool unicast, uint_fast8_t seq)
+{
+}
+
+void ipv6_interface_resolution_failed(ipv6_neighbour_cache_t *cache, ipv6_neighbour_t *entry)
+{
+}
+
+ipv6_neighbour_cache_t *ipv6_neighbour_cache_by_interface_id(int8_t interface_id)
+{
+    return ipv6_resolution_stub_cache;
+}
+
+void ipv6_send_queued(ipv6_neighbour_t *entry)
+{
+}
+
+uint16_t ipv6_map_ip_to_ll_and_call_ll_addr_handler(struct protocol_interface_info_entry *cur, int8_t interface_id, ipv6_neighbour_t *n, const uint8_t ipaddr[16], ll_addr_handler_t *ll_addr_handler_ptr)
+{
+    return 0;
+}
@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nsconfig.h"
+#include "ns_types.h"
+#include "Core/include/ns_buffer.h"
+#include "Common_Protocols/ipv6.h"
+
+// Multicasts transmitted, the buffers are freed
+int ipv6_stub_multicast_count;
+
+void ipv6_set_exthdr_provider(ipv6_route_src_t src, ipv6_exthdr_provider_fn_t *fn)
+{
+}
+
+void ipv6_transmit_multicast_on_interface(buffer_t *buf, struct protocol_interface_info_entry *cur)
+{
+    ipv6_stub_multicast_count++;
+    buffer_free(buf);
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+#include "ns_types.h"
+
+struct buffer;
+struct protocol_interface_info_entry;
+
+int protocol_core_buffers_in_event_queue;
+uint32_t protocol_core_monotonic_time;
+
+// Address of the interface, see protocol_interface_address_compare()
+uint8_t protocol_core_stub_address[16];
+
+// Last pushed buffer, to be freed by the test
+struct buffer *protocol_core_stub_pushed;
+
+void protocol_push(struct buffer *buf)
+{
+    protocol_core_stub_pushed = buf;
+}
+
+struct protocol_interface_info_entry *protocol_stack_interface_info_get_by_id(int8_t nwk_id)
+{
+    return NULL;
+}
+
+int8_t protocol_interface_address_compare(const uint8_t *addr)
+{
+    return memcmp(addr, protocol_core_stub_address, 16) == 0 ? 0 : -1;
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2019, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nsconfig.h"
+#include <string.h>
+#include "ns_types.h"
+#include "ns_list.h"
+#include "nsdynmemLIB.h"
+#include "NWK_INTERFACE/Include/protocol.h"
+#include "net_rpl.h"
+#include "RPL/rpl_protocol.h"
+#include "RPL/rpl_policy.h"
+#include "RPL/rpl_upward.h"
+#include "RPL/rpl_control.h"
+#include "RPL/rpl_data.h"
+#include "RPL/rpl_structures.h"
+
+// RPL allocations, counted as rpl_control.c does. No limit if 0.
+size_t rpl_stub_alloc_limit;
+size_t rpl_stub_alloc_total;
+
+#define RPL_ALLOC_OVERHEAD 8
+
+void *rpl_alloc(uint16_t size)
+{
+    if (rpl_stub_alloc_limit && rpl_stub_alloc_total + size + RPL_ALLOC_OVERHEAD > rpl_stub_alloc_limit) {
+        return NULL;
+    }
+    void *p = ns_dyn_mem_alloc(size);
+    if (p) {
+        rpl_stub_alloc_total += (size_t) size + RPL_ALLOC_OVERHEAD;
+    }
+    return p;
+}
+
+void rpl_free(void *p, uint16_t size)
+{
+    if (p) {
+        rpl_stub_alloc_total -= (size_t) size + RPL_ALLOC_OVERHEAD;
+    }
+    ns_dyn_mem_free(p);
+}
+
+void rpl_control_event(struct rpl_domain *domain, rpl_event_t event)
+{
+}
+
+bool rpl_control_transmit_dao(struct rpl_domain *domain, struct protocol_interface_info_entry *cur, struct rpl_instance *instance, uint8_t instance_id, uint8_t dao_sequence, const uint8_t dodagid[16], const uint8_t *opts, uint16_t opts_size, const uint8_t *dst)
+{
+    return false;
+}
+
+void rpl_control_register_address(struct protocol_interface_info_entry *interface, if_address_entry_t *addr)
+{
+}
+
+void rpl_data_sr_invalidate(void)
+{
+}
+
+uint16_t rpl_policy_initial_dao_ack_wait(const rpl_domain_t *domain, uint8_t mop)
+{
+    return 20;
+}
+
+uint16_t rpl_policy_modify_downward_cost_to_root_neighbour(rpl_domain_t *domain, int8_t if_id, const uint8_t *next_hop, uint16_t cost)
+{
+    return cost;
+}
+
+bool rpl_policy_dao_trigger_after_srh_error(rpl_domain_t *domain, uint32_t seconds_since_last_dao_trigger, uint16_t errors_since_last_dao_trigger, uint_fast16_t targets)
+{
+    return false;
+}
+
+uint8_t rpl_seq_init(void)
+{
+    return 240;
+}
+
+uint8_t rpl_seq_inc(uint8_t seq)
+{
+    return seq == 127 ? 0 : (uint8_t)(seq + 1);
+}
+
+rpl_cmp_t rpl_seq_compare(uint8_t a, uint8_t b)
+{
+    if (a == b) {
+        return RPL_CMP_EQUAL;
+    }
+    return (int8_t)(a - b) > 0 ? RPL_CMP_GREATER : RPL_CMP_LESS;
+}
+
+rpl_dodag_t *rpl_instance_current_dodag(const rpl_instance_t *instance)
+{
+    return instance->current_dodag_version ? instance->current_dodag_version->dodag : NULL;
+}
+
+#ifdef HAVE_RPL_ROOT
+bool rpl_instance_am_root(const rpl_instance_t *instance)
+{
+    rpl_dodag_t *dodag = rpl_instance_current_dodag(instance);
+    return dodag ? dodag->root : false;
+}
+
+bool rpl_dodag_am_root(const rpl_dodag_t *dodag)
+{
+    return dodag->root;
+}
+#endif
+
+uint8_t rpl_instance_mop(const rpl_instance_t *instance)
+{
+    rpl_dodag_t *dodag = rpl_instance_current_dodag(instance);
+    return dodag ? rpl_dodag_mop(dodag) : RPL_MODE_NO_DOWNWARD;
+}
+
+void rpl_instance_increment_dtsn(rpl_instance_t *instance)
+{
+    instance->dtsn = rpl_seq_inc(instance->dtsn);
+}
+
+uint8_t rpl_dodag_mop(const rpl_dodag_t *dodag)
+{
+    return dodag->g_mop_prf & RPL_MODE_MASK;
+}
+
+const rpl_dodag_conf_t *rpl_dodag_get_config(const rpl_dodag_t *dodag)
+{
+    return dodag->have_config ? &dodag->config : NULL;
+}
@@ -23,5 +23,9 @@ extern void randLIB_seed_random(void);
 
 uint16_t randLIB_get_random_in_range(uint16_t min, uint16_t max);
 
+uint32_t randLIB_get_32bit(void);
+
+uint32_t randLIB_randomise_base(uint32_t base, uint16_t min_factor, uint16_t max_factor);
+
 
 #endif /* FEATURES_CELLULAR_UNITTESTS_TARGET_H_RANDLIB_H_ */
@@ -132,6 +132,7 @@ static uint8_t MAC_address[8];
 /* Driver instance handle and hardware */
 static NanostackRfPhyMcr20a *rf = NULL;
 static SPI *spi = NULL;
+static uint32_t spi_frequency = 0; // Last frequency set, 0 if none
 static DigitalOut *cs = NULL;
 static DigitalOut *rst = NULL;
 static InterruptIn *irq = NULL;
@@ -1600,7 +1601,12 @@ extern "C" void xcvr_spi_configure_speed(uint32_t instance, uint32_t freq)
 {
     MBED_ASSERT(spi != NULL);
     (void)instance;
-    spi->frequency(freq);
+    // Register accesses alternate between two speeds, only reconfigure
+    // the SPI peripheral when the speed changes
+    if (freq != spi_frequency) {
+        spi->frequency(freq);
+        spi_frequency = freq;
+    }
 }
 
 extern "C" void xcvr_spi_transfer(uint32_t instance,
@@ -1610,7 +1616,6 @@ extern "C" void xcvr_spi_transfer(uint32_t instance,
 {
     MBED_ASSERT(spi != NULL);
     (void)instance;
-    volatile uint8_t dummy;
 
     if (!transferByteCount) {
         return;
@@ -1620,21 +1625,10 @@ extern "C" void xcvr_spi_transfer(uint32_t instance,
         return;
     }
 
-    while (transferByteCount--) {
-        if (sendBuffer) {
-            dummy = *sendBuffer;
-            sendBuffer++;
-        } else {
-            dummy = 0xFF;
-        }
-
-        dummy = spi->write(dummy);
-
-        if (receiveBuffer) {
-            *receiveBuffer = dummy;
-            receiveBuffer++;
-        }
-    }
+    // Block transfer, so the SPI HAL can keep its FIFO full rather than
+    // waiting for each byte. Bytes not sent from the buffer are 0xFF.
+    spi->write(reinterpret_cast<const char *>(sendBuffer), sendBuffer ? transferByteCount : 0,
+               reinterpret_cast<char *>(receiveBuffer), receiveBuffer ? transferByteCount : 0);
 }
 
 /*****************************************************************************/
@@ -1740,6 +1734,7 @@ void NanostackRfPhyMcr20a::set_mac_address(uint8_t *mac)
 void NanostackRfPhyMcr20a::_pins_set()
 {
     spi = &_spi;
+    spi_frequency = 0;
     cs = &_rf_cs;
     rst = &_rf_rst;
     irq = &_rf_irq;
@@ -1750,6 +1745,7 @@ void NanostackRfPhyMcr20a::_pins_set()
 void NanostackRfPhyMcr20a::_pins_clear()
 {
     spi = NULL;
+    spi_frequency = 0;
     cs = NULL;
     rst = NULL;
     irq = NULL;
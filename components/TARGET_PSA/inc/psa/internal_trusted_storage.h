@@ -20,4 +20,40 @@
 
 #include "psa_prot_internal_storage.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum number of UIDs read by one psa_its_get_multiple() call */
+#define PSA_ITS_GET_MULTIPLE_MAX    8
+
+/**
+ * \brief Retrieve the values associated with several uids at once
+ *
+ * Mbed OS extension: reads the items in a single call to the secure side,
+ * instead of one per item.
+ *
+ * \param[in] count            Number of uids, at most PSA_ITS_GET_MULTIPLE_MAX
+ * \param[in] uids             The uid values
+ * \param[in] data_lengths     The amount of data requested for each uid, from offset 0
+ * \param[out] p_data          The buffer where the data of all items is placed one after
+ *                             the other. Its size is the sum of `data_lengths`.
+ * \param[out] p_status        The status of each item, as returned by psa_its_get().
+ *                             The data of an item that could not be read is zeroed.
+ *
+ * \return      PSA_ITS_SUCCESS if all items were read, or the status of the first
+ *              item that could not be
+ * \retval      PSA_ITS_ERROR_INVALID_ARGUMENTS  `count` is out of range or one of the pointers is `NULL`
+ * \retval      PSA_ITS_ERROR_STORAGE_FAILURE    The physical storage has failed (Fatal error)
+ */
+psa_its_status_t psa_its_get_multiple(size_t count,
+                                      const psa_its_uid_t *uids,
+                                      const uint32_t *data_lengths,
+                                      void *p_data,
+                                      psa_its_status_t *p_status);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif // __MBED_INTERNAL_TRUSTED_STORAGE_H__
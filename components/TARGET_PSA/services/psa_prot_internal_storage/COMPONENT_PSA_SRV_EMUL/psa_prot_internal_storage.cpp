@@ -63,6 +63,37 @@ psa_its_status_t psa_its_get(psa_its_uid_t uid, uint32_t data_offset, uint32_t d
     return psa_its_get_impl(PSA_ITS_EMUL_PID, uid, data_offset, data_length, p_data);
 }
 
+psa_its_status_t psa_its_get_multiple(size_t count, const psa_its_uid_t *uids, const uint32_t *data_lengths,
+                                      void *p_data, psa_its_status_t *p_status)
+{
+    uint32_t total = 0;
+
+    if (count == 0 || count > PSA_ITS_GET_MULTIPLE_MAX || !uids || !data_lengths || !p_status) {
+        return PSA_ITS_ERROR_INVALID_ARGUMENTS;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (total + data_lengths[i] < total) {
+            return PSA_ITS_ERROR_INVALID_ARGUMENTS;
+        }
+        total += data_lengths[i];
+    }
+
+    if (!p_data && total) {
+        return PSA_ITS_ERROR_INVALID_ARGUMENTS;
+    }
+
+    // KVStore initiation:
+    // - In EMUL (non-secure single core) we do it here since we don't have another context to do it inside.
+    // - Repeating calls has no effect
+    int kv_status = kv_init_storage_config();
+    if (kv_status != MBED_SUCCESS) {
+        return PSA_ITS_ERROR_STORAGE_FAILURE;
+    }
+
+    return psa_its_get_multiple_impl(PSA_ITS_EMUL_PID, count, uids, data_lengths, p_data, p_status);
+}
+
 psa_its_status_t psa_its_get_info(psa_its_uid_t uid, struct psa_its_info_t *p_info)
 {
     if (!p_info) {
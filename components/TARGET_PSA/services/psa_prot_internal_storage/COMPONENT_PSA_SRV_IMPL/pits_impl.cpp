@@ -24,6 +24,8 @@
 #include "mbed_error.h"
 #include "mbed_assert.h"
 #include "mbed_toolchain.h"
+#include "PlatformMutex.h"
+#include "SingletonPtr.h"
 
 #if defined(TARGET_TFM)
 
@@ -53,6 +55,10 @@ KVStore *get_its_kvstore_instance(void)
 // pid: 6; delimiter: 1; uid: 11; str terminator: 1
 #define PSA_ITS_FILENAME_MAX_LEN        19
 
+// Number of UIDs whose metadata is kept in RAM
+#ifndef PSA_ITS_INDEX_SIZE
+#define PSA_ITS_INDEX_SIZE              16
+#endif
 
 const uint8_t base64_coding_table[] = {
     'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H',
@@ -67,6 +73,28 @@ const uint8_t base64_coding_table[] = {
 
 static KVStore *kvstore = NULL;
 
+/*
+ * RAM index of the size and flags of recently used UIDs, so that reading
+ * an item doesn't first need a get_info() from KVStore, which reads the
+ * record header from flash. Entries are added by set and by the first
+ * lookup of a UID, and dropped by remove and reset. When the index is
+ * full, entries are replaced in turn.
+ *
+ * The mutex serializes the KVStore updates with the index ones, so the
+ * index always follows the order the updates reached KVStore in.
+ */
+typedef struct {
+    psa_its_uid_t uid;
+    int32_t pid;
+    uint32_t size;
+    uint32_t kv_flags;
+} its_index_entry_t;
+
+static its_index_entry_t its_index[PSA_ITS_INDEX_SIZE];
+static size_t its_index_count = 0;
+static size_t its_index_next = 0;
+static SingletonPtr<PlatformMutex> its_mutex;
+
 MBED_WEAK psa_its_status_t its_version_migrate(void *storage, const its_version_t *version)
 {
     (void)storage;
@@ -214,6 +242,69 @@ static void generate_fn(char *tdb_filename, uint32_t tdb_filename_size, psa_its_
     MBED_ASSERT(filename_idx <= PSA_ITS_FILENAME_MAX_LEN);
 }
 
+static its_index_entry_t *index_find(int32_t pid, psa_its_uid_t uid)
+{
+    for (size_t i = 0; i < its_index_count; i++) {
+        if (its_index[i].uid == uid && its_index[i].pid == pid) {
+            return &its_index[i];
+        }
+    }
+    return NULL;
+}
+
+static void index_update(int32_t pid, psa_its_uid_t uid, uint32_t size, uint32_t kv_flags)
+{
+    its_index_entry_t *entry = index_find(pid, uid);
+    if (!entry) {
+        if (its_index_count < PSA_ITS_INDEX_SIZE) {
+            entry = &its_index[its_index_count++];
+        } else {
+            entry = &its_index[its_index_next];
+            its_index_next = (its_index_next + 1) % PSA_ITS_INDEX_SIZE;
+        }
+        entry->uid = uid;
+        entry->pid = pid;
+    }
+    entry->size = size;
+    entry->kv_flags = kv_flags;
+}
+
+static void index_remove(int32_t pid, psa_its_uid_t uid)
+{
+    its_index_entry_t *entry = index_find(pid, uid);
+    if (entry) {
+        *entry = its_index[--its_index_count];
+    }
+}
+
+/*
+ * \brief Get the size and flags of an item, from the index if possible
+ *
+ * \param[in]  pid - owner PSA partition ID
+ * \param[in]  uid - PSA internal storage unique ID
+ * \param[in]  kv_key - KVStore key of the item
+ * \param[out] kv_info - size and KVStore flags of the item
+ * \return KVStore status code
+ */
+static int index_get_info(int32_t pid, psa_its_uid_t uid, const char *kv_key, KVStore::info_t *kv_info)
+{
+    its_mutex->lock();
+    its_index_entry_t *entry = index_find(pid, uid);
+    if (entry) {
+        kv_info->size = entry->size;
+        kv_info->flags = entry->kv_flags;
+        its_mutex->unlock();
+        return MBED_SUCCESS;
+    }
+
+    int status = kvstore->get_info(kv_key, kv_info);
+    if (status == MBED_SUCCESS) {
+        index_update(pid, uid, kv_info->size, kv_info->flags);
+    }
+    its_mutex->unlock();
+    return status;
+}
+
 psa_its_status_t psa_its_set_impl(int32_t pid, psa_its_uid_t uid, uint32_t data_length, const void *p_data, psa_its_create_flags_t create_flags)
 {
     if (!kvstore) {
@@ -233,7 +324,12 @@ psa_its_status_t psa_its_set_impl(int32_t pid, psa_its_uid_t uid, uint32_t data_
         kv_create_flags = KVStore::WRITE_ONCE_FLAG;
     }
 
+    its_mutex->lock();
     int status = kvstore->set(kv_key, p_data, data_length, kv_create_flags);
+    if (status == MBED_SUCCESS) {
+        index_update(pid, uid, data_length, kv_create_flags);
+    }
+    its_mutex->unlock();
 
     return convert_status(status);
 }
@@ -249,7 +345,7 @@ psa_its_status_t psa_its_get_impl(int32_t pid, psa_its_uid_t uid, uint32_t data_
     generate_fn(kv_key, PSA_ITS_FILENAME_MAX_LEN, uid, pid);
 
     KVStore::info_t kv_info;
-    int status = kvstore->get_info(kv_key, &kv_info);
+    int status = index_get_info(pid, uid, kv_key, &kv_info);
 
     if (status == MBED_SUCCESS) {
         if (data_offset > kv_info.size) {
@@ -289,7 +385,7 @@ psa_its_status_t psa_its_get_info_impl(int32_t pid, psa_its_uid_t uid, struct ps
     generate_fn(kv_key, PSA_ITS_FILENAME_MAX_LEN, uid, pid);
 
     KVStore::info_t kv_info;
-    int status = kvstore->get_info(kv_key, &kv_info);
+    int status = index_get_info(pid, uid, kv_key, &kv_info);
 
     if (status == MBED_SUCCESS) {
         p_info->flags = 0;
@@ -312,7 +408,12 @@ psa_its_status_t psa_its_remove_impl(int32_t pid, psa_its_uid_t uid)
     char kv_key[PSA_ITS_FILENAME_MAX_LEN] = {'\0'};
     generate_fn(kv_key, PSA_ITS_FILENAME_MAX_LEN, uid, pid);
 
+    its_mutex->lock();
     int status = kvstore->remove(kv_key);
+    if (status != MBED_ERROR_WRITE_PROTECTED) {
+        index_remove(pid, uid);
+    }
+    its_mutex->unlock();
 
     return convert_status(status);
 }
@@ -323,6 +424,32 @@ psa_its_status_t psa_its_reset_impl()
         its_init();
     }
 
+    its_mutex->lock();
     int status = kvstore->reset();
+    its_index_count = 0;
+    its_index_next = 0;
+    its_mutex->unlock();
+
     return convert_status(status);
 }
+
+psa_its_status_t psa_its_get_multiple_impl(int32_t pid, size_t count, const psa_its_uid_t *uids,
+                                           const uint32_t *data_lengths, void *p_data,
+                                           psa_its_status_t *p_status)
+{
+    psa_its_status_t status = PSA_ITS_SUCCESS;
+    uint8_t *data = (uint8_t *)p_data;
+
+    for (size_t i = 0; i < count; i++) {
+        p_status[i] = psa_its_get_impl(pid, uids[i], 0, data_lengths[i], data);
+        if (p_status[i] != PSA_ITS_SUCCESS) {
+            memset(data, 0, data_lengths[i]);
+            if (status == PSA_ITS_SUCCESS) {
+                status = p_status[i];
+            }
+        }
+        data += data_lengths[i];
+    }
+
+    return status;
+}
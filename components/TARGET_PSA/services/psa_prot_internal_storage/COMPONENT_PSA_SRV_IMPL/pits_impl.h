@@ -36,6 +36,9 @@ psa_its_status_t psa_its_get_impl(int32_t pid, psa_its_uid_t uid, uint32_t data_
 psa_its_status_t psa_its_get_info_impl(int32_t pid, psa_its_uid_t uid, struct psa_its_info_t *p_info);
 psa_its_status_t psa_its_remove_impl(int32_t pid, psa_its_uid_t uid);
 psa_its_status_t psa_its_reset_impl();
+psa_its_status_t psa_its_get_multiple_impl(int32_t pid, size_t count, const psa_its_uid_t *uids,
+                                           const uint32_t *data_lengths, void *p_data,
+                                           psa_its_status_t *p_status);
 
 psa_its_status_t psa_its_reset_impl(void);
 
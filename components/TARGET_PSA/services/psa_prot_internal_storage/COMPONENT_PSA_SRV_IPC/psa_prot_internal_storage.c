@@ -72,6 +72,52 @@ psa_its_status_t psa_its_get(psa_its_uid_t uid, uint32_t data_offset, uint32_t d
     return status;
 }
 
+psa_its_status_t psa_its_get_multiple(size_t count, const psa_its_uid_t *uids, const uint32_t *data_lengths,
+                                      void *p_data, psa_its_status_t *p_status)
+{
+    uint32_t total = 0;
+
+    if (count == 0 || count > PSA_ITS_GET_MULTIPLE_MAX || !uids || !data_lengths || !p_status) {
+        return PSA_ITS_ERROR_INVALID_ARGUMENTS;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (total + data_lengths[i] < total) {
+            return PSA_ITS_ERROR_INVALID_ARGUMENTS;
+        }
+        total += data_lengths[i];
+    }
+
+    if (!p_data && total) {
+        return PSA_ITS_ERROR_INVALID_ARGUMENTS;
+    }
+
+    uint32_t data_offset = 0;
+    psa_invec msg[3] = {
+        { uids, count * sizeof(uids[0]) },
+        { &data_offset, sizeof(data_offset) },
+        { data_lengths, count * sizeof(data_lengths[0]) }
+    };
+    psa_outvec resp[2] = {
+        { p_data, total },
+        { p_status, count * sizeof(p_status[0]) }
+    };
+
+    psa_handle_t conn = psa_connect(PSA_ITS_GET, 1);
+    if (conn <= PSA_NULL_HANDLE) {
+        return PSA_ITS_ERROR_STORAGE_FAILURE;
+    }
+
+    psa_status_t status = psa_call(conn, msg, 3, resp, 2);
+
+    if (status == PSA_DROP_CONNECTION) {
+        status = PSA_ITS_ERROR_STORAGE_FAILURE;
+    }
+
+    psa_close(conn);
+    return status;
+}
+
 psa_its_status_t psa_its_get_info(psa_its_uid_t uid, struct psa_its_info_t *p_info)
 {
     if (!p_info) {
@@ -80,11 +80,70 @@ static psa_status_t storage_set(psa_msg_t *msg)
     return status;
 }
 
+static psa_status_t storage_get_multiple(psa_msg_t *msg)
+{
+    psa_its_uid_t keys[PSA_ITS_GET_MULTIPLE_MAX];
+    uint32_t lengths[PSA_ITS_GET_MULTIPLE_MAX];
+    psa_its_status_t statuses[PSA_ITS_GET_MULTIPLE_MAX];
+    size_t count = msg->in_size[0] / sizeof(keys[0]);
+    uint32_t total = 0;
+
+    if ((count == 0) || (count > PSA_ITS_GET_MULTIPLE_MAX) ||
+            (msg->in_size[0] != count * sizeof(keys[0])) ||
+            (msg->in_size[2] != count * sizeof(lengths[0])) ||
+            (msg->out_size[1] != count * sizeof(statuses[0]))) {
+        return PSA_DROP_CONNECTION;
+    }
+
+    if (psa_read(msg->handle, 0, keys, msg->in_size[0]) != msg->in_size[0]) {
+        return PSA_DROP_CONNECTION;
+    }
+
+    if (psa_read(msg->handle, 2, lengths, msg->in_size[2]) != msg->in_size[2]) {
+        return PSA_DROP_CONNECTION;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (total + lengths[i] < total) {
+            return PSA_DROP_CONNECTION;
+        }
+        total += lengths[i];
+    }
+
+    if (total != msg->out_size[0]) {
+        return PSA_DROP_CONNECTION;
+    }
+
+    uint8_t *data = (uint8_t *)malloc(total);
+    if (data == NULL && total != 0) {
+        return PSA_ITS_ERROR_STORAGE_FAILURE;
+    }
+
+#if defined(TARGET_MBED_SPM)
+    psa_its_status_t status = psa_its_get_multiple_impl(psa_identity(msg->handle), count, keys, lengths, data, statuses);
+#else
+    psa_its_status_t status = psa_its_get_multiple_impl(msg->client_id, count, keys, lengths, data, statuses);
+#endif
+
+    // Items that could not be read are zeroed, the statuses tell which ones
+    psa_write(msg->handle, 0, data, total);
+    psa_write(msg->handle, 1, statuses, msg->out_size[1]);
+
+    memset(data, 0, total);
+    free(data);
+    return status;
+}
+
 static psa_status_t storage_get(psa_msg_t *msg)
 {
     psa_its_uid_t key = 0;
     uint32_t offset = 0;
 
+    // A third input vector holds the lengths of a psa_its_get_multiple() call
+    if (msg->in_size[2] != 0) {
+        return storage_get_multiple(msg);
+    }
+
     if ((msg->in_size[0] != sizeof(key)) || (msg->in_size[1] != sizeof(offset))) {
         return PSA_DROP_CONNECTION;
     }
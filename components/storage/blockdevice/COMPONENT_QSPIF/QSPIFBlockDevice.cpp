@@ -319,6 +319,46 @@ int QSPIFBlockDevice::read(void *buffer, bd_addr_t addr, bd_size_t size)
 
 }
 
+int QSPIFBlockDevice::map(bd_addr_t addr, bd_size_t size, const void **data)
+{
+    int status = QSPIF_BD_ERROR_OK;
+    const void *base = NULL;
+
+    if (addr + size > _device_size_bytes) {
+        return QSPIF_BD_ERROR_DEVICE_ERROR;
+    }
+
+    _mutex.lock();
+
+    // Configure Bus for Reading
+    _qspi_configure_format(_inst_width, _address_width, _address_size, QSPI_CFG_BUS_SINGLE,
+                           QSPI_CFG_ALT_SIZE_8, _data_width, _dummy_and_mode_cycles);
+
+    if (QSPI_STATUS_OK != _qspi.memory_map(_read_instruction, -1, &base)) {
+        status = QSPIF_BD_ERROR_DEVICE_ERROR;
+        tr_error("Memory map failed");
+    }
+
+    // The read command is built at mapping time, restore the default 1-1-1 Bus mode for the other commands
+    _qspi_configure_format(QSPI_CFG_BUS_SINGLE, QSPI_CFG_BUS_SINGLE, QSPI_CFG_ADDR_SIZE_24, QSPI_CFG_BUS_SINGLE,
+                           QSPI_CFG_ALT_SIZE_8, QSPI_CFG_BUS_SINGLE, 0);
+
+    if (status != QSPIF_BD_ERROR_OK) {
+        _mutex.unlock();
+        return status;
+    }
+
+    // Stay locked until unmap
+    *data = (const uint8_t *)base + addr;
+    return QSPIF_BD_ERROR_OK;
+}
+
+int QSPIFBlockDevice::unmap()
+{
+    _mutex.unlock();
+    return QSPIF_BD_ERROR_OK;
+}
+
 int QSPIFBlockDevice::program(const void *buffer, bd_addr_t addr, bd_size_t size)
 {
     qspi_status_t result = QSPI_STATUS_OK;
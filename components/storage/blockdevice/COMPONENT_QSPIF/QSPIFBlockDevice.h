@@ -136,6 +136,27 @@ public:
      */
     virtual int read(void *buffer, mbed::bd_addr_t addr, mbed::bd_size_t size);
 
+    /** Map a region of the block device into the memory space for reading in place
+     *
+     *  On targets whose QSPI controller supports memory-mapped mode, the region
+     *  can then be read, or code executed from it, without copying it into a buffer.
+     *  The block device stays locked until unmap is called, and any other call on
+     *  it from the same thread leaves memory-mapped mode and invalidates the pointer.
+     *
+     *  @param addr     Address of block to begin mapping from
+     *  @param size     Size to map in bytes
+     *  @param data     Set to where the region is mapped, valid until unmap is called
+     *  @return         QSPIF_BD_ERROR_OK(0) - success
+     *                  QSPIF_BD_ERROR_DEVICE_ERROR - memory-mapped mode not supported or failed
+     */
+    int map(mbed::bd_addr_t addr, mbed::bd_size_t size, const void **data);
+
+    /** Release a region mapped by map
+     *
+     *  @return         QSPIF_BD_ERROR_OK(0) - success
+     */
+    int unmap();
+
     /** Program blocks to a block device
      *
      *  The blocks must have been erased prior to being programmed
@@ -20,6 +20,7 @@
 #include "mbed_trace.h"
 #include "rtos/Thread.h"
 #include <stdlib.h>
+#include <string.h>
 
 using namespace utest::v1;
 
@@ -137,6 +138,62 @@ end:
     delete[] read_block;
 }
 
+void test_qspif_memory_map()
+{
+    utest_printf("\nTest Memory Map Starts..\n");
+
+    QSPIFBlockDevice blockD(QSPI_FLASH1_IO0, QSPI_FLASH1_IO1, QSPI_FLASH1_IO2, QSPI_FLASH1_IO3,
+                            QSPI_FLASH1_SCK, QSPI_FLASH1_CSN, QSPIF_POLARITY_MODE_0, MBED_CONF_QSPIF_QSPI_FREQ);
+
+    int err = blockD.init();
+    TEST_ASSERT_EQUAL(0, err);
+
+    bd_size_t block_size = blockD.get_erase_size();
+    bd_addr_t block = blockD.size() - block_size;
+    const void *mapped = NULL;
+
+    uint8_t *write_block = new (std::nothrow) uint8_t[block_size];
+    uint8_t *read_block = new (std::nothrow) uint8_t[block_size];
+    if (!write_block || !read_block) {
+        utest_printf("\n Not enough memory for test");
+        goto end;
+    }
+
+    for (bd_size_t i_ind = 0; i_ind < block_size; i_ind++) {
+        write_block[i_ind] = 0xff & rand();
+    }
+
+    err = blockD.erase(block, block_size);
+    TEST_ASSERT_EQUAL(0, err);
+
+    err = blockD.program(write_block, block, block_size);
+    TEST_ASSERT_EQUAL(0, err);
+
+    err = blockD.map(block, block_size, &mapped);
+    if (err) {
+        utest_printf("\n Memory-mapped mode not supported on this target");
+        goto deinit;
+    }
+
+    // Copy out before unmapping, reading leaves memory-mapped mode
+    memcpy(read_block, mapped, block_size);
+    err = blockD.unmap();
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_block, read_block, block_size);
+
+    err = blockD.read(read_block, block, block_size);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_block, read_block, block_size);
+
+deinit:
+    err = blockD.deinit();
+    TEST_ASSERT_EQUAL(0, err);
+
+end:
+    delete[] write_block;
+    delete[] read_block;
+}
+
 void test_qspif_unaligned_erase()
 {
 
@@ -282,7 +339,8 @@ utest::v1::status_t test_setup(const size_t number_of_cases)
 Case cases[] = {
     Case("Testing unaligned erase blocks", test_qspif_unaligned_erase),
     Case("Testing read write random blocks", test_qspif_random_program_read_erase),
-    Case("Testing Multi Threads Erase Program Read", test_qspif_multi_threads)
+    Case("Testing Multi Threads Erase Program Read", test_qspif_multi_threads),
+    Case("Testing memory-mapped read", test_qspif_memory_map)
 };
 
 Specification specification(test_setup, cases);
@@ -82,9 +82,10 @@
  * just always use the Standard Capacity cards with a block size of 512 bytes.
  * This is set with CMD16.
  *
- * You can read and write single blocks (CMD17, CMD25) or multiple blocks
- * (CMD18, CMD25). For simplicity, I'll just use single block accesses. When
- * the card gets a read command, it responds with a response token, and then
+ * You can read and write single blocks (CMD17, CMD24) or multiple blocks
+ * (CMD18, CMD25). Transfers of more than one block are streamed with the
+ * multiple block commands, after setting the number of blocks to pre-erase
+ * (ACMD23) for writes. When the card gets a read command, it responds with a response token, and then
  * a data token or an error.
  *
  * SPI Command Format
@@ -267,6 +268,7 @@ SDBlockDevice::SDBlockDevice(PinName mosi, PinName miso, PinName sclk, PinName c
                        "Initialization frequency should be between 100KHz to 400KHz");
     _init_sck = MBED_CONF_SD_INIT_FREQUENCY;
     _transfer_sck = hz;
+    _max_sck = 0;
 
     _erase_size = BLOCK_SIZE_HC;
 }
@@ -503,6 +505,7 @@ int SDBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
             response = _write(buffer, SPI_START_BLK_MUL_WRITE, _block_size);
             if (response != SPI_DATA_ACCEPTED) {
                 debug_if(SD_DBG, "Multiple Block Write failed: 0x%x \n", response);
+                status = SD_BLOCK_DEVICE_ERROR_WRITE;
                 break;
             }
             buffer += _block_size;
@@ -566,7 +569,10 @@ int SDBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
 
     // Send CMD12(0x00000000) to stop the transmission for multi-block transfer
     if (size > _block_size) {
-        status = _cmd(CMD12_STOP_TRANSMISSION, 0x0);
+        int stop_status = _cmd(CMD12_STOP_TRANSMISSION, 0x0);
+        if (BD_ERROR_OK == status) {
+            status = stop_status;
+        }
     }
     unlock();
     return status;
@@ -654,13 +660,19 @@ int SDBlockDevice::frequency(uint64_t freq)
 // PRIVATE FUNCTIONS
 int SDBlockDevice::_freq(void)
 {
-    // Max frequency supported is 25MHZ
-    if (_transfer_sck <= 25000000) {
-        _spi.frequency(_transfer_sck);
+    // Max frequency supported is 25MHZ, or less if the card reports so
+    uint32_t max_sck = ((0 != _max_sck) && (_max_sck < 25000000)) ? _max_sck : 25000000;
+
+    if (0 == _transfer_sck) {
+        // Fastest clock the card supports
+        _spi.frequency(max_sck);
+        return 0;
+    } else if (_transfer_sck <= 25000000) {
+        _spi.frequency((_transfer_sck < max_sck) ? _transfer_sck : max_sck);
         return 0;
     } else {  // TODO: Switch function to be implemented for higher frequency
         _transfer_sck = 25000000;
-        _spi.frequency(_transfer_sck);
+        _spi.frequency(max_sck);
         return -EINVAL;
     }
 }
@@ -701,9 +713,7 @@ uint8_t SDBlockDevice::_cmd_spi(SDBlockDevice::cmdSupported cmd, uint32_t arg)
     }
 
     // send a command
-    for (int i = 0; i < PACKET_SIZE; i++) {
-        _spi.write(cmdPacket[i]);
-    }
+    _spi.write(make_Span((const char *)cmdPacket, PACKET_SIZE));
 
     // The received byte immediataly following CMD12 is a stuff byte,
     // it should be discarded before receive the response of the CMD12.
@@ -889,13 +899,10 @@ int SDBlockDevice::_read_bytes(uint8_t *buffer, uint32_t length)
     }
 
     // read data
-    for (uint32_t i = 0; i < length; i++) {
-        buffer[i] = _spi.write(SPI_FILL_CHAR);
-    }
+    _spi.write(Span<const char>(), make_Span((char *)buffer, length));
 
     // Read the CRC16 checksum for the data block
-    crc = (_spi.write(SPI_FILL_CHAR) << 8);
-    crc |= _spi.write(SPI_FILL_CHAR);
+    crc = _read_crc();
 
 #if MBED_CONF_SD_CRC_ENABLED
     if (_crc_on) {
@@ -915,6 +922,13 @@ int SDBlockDevice::_read_bytes(uint8_t *buffer, uint32_t length)
     return 0;
 }
 
+uint16_t SDBlockDevice::_read_crc()
+{
+    char crc_bytes[2];
+    _spi.write(Span<const char>(), crc_bytes);
+    return ((uint8_t)crc_bytes[0] << 8) | (uint8_t)crc_bytes[1];
+}
+
 int SDBlockDevice::_read(uint8_t *buffer, uint32_t length)
 {
     uint16_t crc;
@@ -926,11 +940,10 @@ int SDBlockDevice::_read(uint8_t *buffer, uint32_t length)
     }
 
     // read data
-    _spi.write(NULL, 0, (char *)buffer, length);
+    _spi.write(Span<const char>(), make_Span((char *)buffer, length));
 
     // Read the CRC16 checksum for the data block
-    crc = (_spi.write(SPI_FILL_CHAR) << 8);
-    crc |= _spi.write(SPI_FILL_CHAR);
+    crc = _read_crc();
 
 #if MBED_CONF_SD_CRC_ENABLED
     if (_crc_on) {
@@ -958,7 +971,7 @@ uint8_t SDBlockDevice::_write(const uint8_t *buffer, uint8_t token, uint32_t len
     _spi.write(token);
 
     // write the data
-    _spi.write((char *)buffer, length, NULL, 0);
+    _spi.write(make_Span((const char *)buffer, length));
 
 #if MBED_CONF_SD_CRC_ENABLED
     if (_crc_on) {
@@ -968,8 +981,8 @@ uint8_t SDBlockDevice::_write(const uint8_t *buffer, uint8_t token, uint32_t len
 #endif
 
     // write the checksum CRC16
-    _spi.write(crc >> 8);
-    _spi.write(crc);
+    const char crc_bytes[2] = { (char)(crc >> 8), (char)crc };
+    _spi.write(crc_bytes);
 
 
     // check the response token
@@ -997,6 +1010,20 @@ static uint32_t ext_bits(unsigned char *data, int msb, int lsb)
     return bits;
 }
 
+// Decode the TRAN_SPEED field of the CSD into a frequency in Hz, 0 if reserved
+static uint32_t tran_speed_hz(uint32_t tran_speed)
+{
+    // Time value in tenths, and transfer rate unit in 100kbit/s
+    static const uint8_t time_value[16] = {0, 10, 12, 13, 15, 20, 25, 30, 35, 40, 45, 50, 55, 60, 70, 80};
+    static const uint32_t rate_unit[4] = {1, 10, 100, 1000};
+
+    uint32_t unit = tran_speed & 0x7;
+    if (unit >= 4) {
+        return 0;
+    }
+    return time_value[(tran_speed >> 3) & 0xF] * rate_unit[unit] * 10000;
+}
+
 bd_size_t SDBlockDevice::_sd_sectors()
 {
     uint32_t c_size, c_size_mult, read_bl_len;
@@ -1015,6 +1042,10 @@ bd_size_t SDBlockDevice::_sd_sectors()
         return 0;
     }
 
+    // tran_speed : csd[103:96], max data transfer rate of the card
+    _max_sck = tran_speed_hz(ext_bits(csd, 103, 96));
+    debug_if(SD_DBG, "Max transfer rate: %" PRIu32 " Hz\n", _max_sck);
+
     // csd_structure : csd[127:126]
     int csd_structure = ext_bits(csd, 127, 126);
     switch (csd_structure) {
@@ -28,6 +28,10 @@
 #include "platform/platform.h"
 #include "platform/PlatformMutex.h"
 
+#ifndef MBED_CONF_SD_TRANSFER_FREQUENCY
+#define MBED_CONF_SD_TRANSFER_FREQUENCY          1000000 /*!< Data transfer frequency, 0 for the fastest the card supports */
+#endif
+
 /** SDBlockDevice class
  *
  * Access an SD Card using SPI bus
@@ -40,10 +44,11 @@ public:
      *  @param miso     SPI master in, slave out pin
      *  @param sclk     SPI clock pin
      *  @param cs       SPI chip select pin
-     *  @param hz       Clock speed of the SPI bus (defaults to 1MHz)
+     *  @param hz       Clock speed of the SPI bus (defaults to sd.TRANSFER_FREQUENCY, 1MHz),
+     *                  or 0 for the fastest clock the card supports
      *  @param crc_on   Enable cyclic redundancy check (defaults to disabled)
      */
-    SDBlockDevice(PinName mosi, PinName miso, PinName sclk, PinName cs, uint64_t hz = 1000000, bool crc_on = 0);
+    SDBlockDevice(PinName mosi, PinName miso, PinName sclk, PinName cs, uint64_t hz = MBED_CONF_SD_TRANSFER_FREQUENCY, bool crc_on = 0);
     virtual ~SDBlockDevice();
 
     /** Initialize a block device
@@ -140,8 +145,8 @@ public:
 
     /** Set the transfer frequency
      *
-     *  @param freq     Transfer frequency
-     *  @note Max frequency supported is 25MHZ
+     *  @param freq     Transfer frequency, or 0 for the fastest the card supports
+     *  @note Max frequency supported is 25MHZ, or less if the card reports so
      */
     virtual int frequency(uint64_t freq);
 
@@ -218,6 +223,7 @@ private:
     mbed::Timer _spi_timer;               /**< Timer Class object used for busy wait */
     uint32_t _init_sck;             /**< Initial SPI frequency */
     uint32_t _transfer_sck;         /**< SPI frequency during data transfer/after initialization */
+    uint32_t _max_sck;              /**< Max SPI frequency reported by the card (TRAN_SPEED), 0 if unknown */
     mbed::SPI _spi;                       /**< SPI Class object */
 
     /* SPI initialization function */
@@ -229,6 +235,7 @@ private:
     bool _wait_ready(uint16_t ms = 300);    /**< 300ms default wait for card to be ready */
     int _read(uint8_t *buffer, uint32_t length);
     int _read_bytes(uint8_t *buffer, uint32_t length);
+    uint16_t _read_crc();
     uint8_t _write(const uint8_t *buffer, uint8_t token, uint32_t length);
     int _freq(void);
 
@@ -56,6 +56,8 @@ using namespace mbed;
 #define SPIF_BASIC_PARAM_TABLE_PAGE_SIZE_BYTE 40
 // Address Length
 #define SPIF_ADDR_SIZE_3_BYTES 3
+// Instruction, 4 Address Bytes and Dummy Cycles Bytes, sent in one SPI write
+#define SPIF_COMMAND_HEADER_SIZE 16
 // Erase Types Params
 #define SPIF_BASIC_PARAM_ERASE_TYPE_1_BYTE 29
 #define SPIF_BASIC_PARAM_ERASE_TYPE_2_BYTE 31
@@ -75,6 +77,9 @@ using namespace mbed;
 
 #define IS_MEM_READY_MAX_RETRIES 10000
 
+// Interval between polls of the status register during asynchronous program and erase
+#define SPIF_ASYNC_POLL_INTERVAL_MS 1
+
 enum spif_default_instructions {
     SPIF_NOP = 0x00, // No operation
     SPIF_PP = 0x02, // Page Program data
@@ -103,7 +108,8 @@ static unsigned int local_math_power(int base, int exp);
 //***********************
 SPIFBlockDevice::SPIFBlockDevice(
     PinName mosi, PinName miso, PinName sclk, PinName csel, int freq)
-    : _spi(mosi, miso, sclk), _cs(csel), _device_size_bytes(0), _is_initialized(false), _init_ref_count(0)
+    : _spi(mosi, miso, sclk), _cs(csel), _device_size_bytes(0), _is_initialized(false), _init_ref_count(0),
+      _async_op(SPIF_ASYNC_NONE)
 {
     _address_size = SPIF_ADDR_SIZE_3_BYTES;
     // Initial SFDP read tables are read with 8 dummy cycles
@@ -116,6 +122,12 @@ SPIFBlockDevice::SPIFBlockDevice(
     _regions_count = 1;
     _region_erase_types_bitfield[0] = ERASE_BITMASK_NONE;
 
+#if defined(MBED_CONF_EVENTS_PRESENT)
+    _stream_is_open = false;
+    _stream_erasing = false;
+    memset(&_stream_stats, 0, sizeof(_stream_stats));
+#endif
+
     if (SPIF_BD_ERROR_OK != _spi_set_frequency(freq)) {
         tr_error("ERROR: SPI Set Frequency Failed");
     }
@@ -227,7 +239,7 @@ int SPIFBlockDevice::deinit()
 {
     spif_bd_error status = SPIF_BD_ERROR_OK;
 
-    _mutex->lock();
+    _lock_idle();
 
     if (!_is_initialized) {
         _init_ref_count = 0;
@@ -261,7 +273,7 @@ int SPIFBlockDevice::read(void *buffer, bd_addr_t addr, bd_size_t size)
 
     int status = SPIF_BD_ERROR_OK;
     tr_info("INFO Read - Inst: 0x%xh", _read_instruction);
-    _mutex->lock();
+    _lock_idle();
 
     // Set Dummy Cycles for Specific Read Command Mode
     _dummy_and_mode_cycles = _read_dummy_and_mode_cycles;
@@ -294,7 +306,7 @@ int SPIFBlockDevice::program(const void *buffer, bd_addr_t addr, bd_size_t size)
         offset = addr % _page_size_bytes;
         chunk = (offset + size < _page_size_bytes) ? size : (_page_size_bytes - offset);
 
-        _mutex->lock();
+        _lock_idle();
 
         //Send WREN
         if (_set_write_enable() != 0) {
@@ -372,7 +384,7 @@ int SPIFBlockDevice::erase(bd_addr_t addr, bd_size_t in_size)
         tr_debug("DEBUG: erase - Region: %d, Type:%d",
                  region, type);
 
-        _mutex->lock();
+        _lock_idle();
 
         if (_set_write_enable() != 0) {
             tr_error("ERROR: SPI Erase Device not ready - failed");
@@ -410,6 +422,203 @@ exit_point:
     return status;
 }
 
+#if defined(MBED_CONF_EVENTS_PRESENT)
+int SPIFBlockDevice::read_async(void *buffer, bd_addr_t addr, bd_size_t size, mbed::bd_callback_t callback)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    _mutex->lock();
+    if (_async_op != SPIF_ASYNC_NONE) {
+        _mutex->unlock();
+        return SPIF_BD_ERROR_BUSY;
+    }
+    _mutex->unlock();
+
+    callback(read(buffer, addr, size));
+    return SPIF_BD_ERROR_OK;
+}
+
+int SPIFBlockDevice::program_async(const void *buffer, bd_addr_t addr, bd_size_t size, mbed::bd_callback_t callback)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (size == 0) {
+        callback(SPIF_BD_ERROR_OK);
+        return SPIF_BD_ERROR_OK;
+    }
+
+    tr_debug("DEBUG: program_async - Buff: 0x%lxh, addr: %llu, size: %llu", (uint32_t)buffer, addr, size);
+
+    _mutex->lock();
+    if (_async_op != SPIF_ASYNC_NONE) {
+        _mutex->unlock();
+        return SPIF_BD_ERROR_BUSY;
+    }
+
+    _async_op = SPIF_ASYNC_PROGRAM;
+    _async_buffer = static_cast<const uint8_t *>(buffer);
+    _async_addr = addr;
+    _async_size = size;
+    _async_callback = callback;
+
+    int status = _async_step();
+    if (status != SPIF_BD_ERROR_OK) {
+        _async_op = SPIF_ASYNC_NONE;
+    }
+    _mutex->unlock();
+    return status;
+}
+
+int SPIFBlockDevice::erase_async(bd_addr_t addr, bd_size_t size, mbed::bd_callback_t callback)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    tr_info("DEBUG: erase_async - addr: %llu, size: %llu", addr, size);
+
+    if ((addr + size) > _device_size_bytes) {
+        tr_error("ERROR: erase exceeds flash device size");
+        return SPIF_BD_ERROR_INVALID_ERASE_PARAMS;
+    }
+
+    if (((addr % get_erase_size(addr)) != 0) || (((addr + size) % get_erase_size(addr + size - 1)) != 0)) {
+        tr_error("ERROR: invalid erase - unaligned address and size");
+        return SPIF_BD_ERROR_INVALID_ERASE_PARAMS;
+    }
+
+    if (size == 0) {
+        callback(SPIF_BD_ERROR_OK);
+        return SPIF_BD_ERROR_OK;
+    }
+
+    _mutex->lock();
+    if (_async_op != SPIF_ASYNC_NONE) {
+        _mutex->unlock();
+        return SPIF_BD_ERROR_BUSY;
+    }
+
+    _async_op = SPIF_ASYNC_ERASE;
+    _async_addr = addr;
+    _async_size = size;
+    // Find region of erased address, and its erase types
+    _async_region = _utils_find_addr_region(addr);
+    _async_bitfield = _region_erase_types_bitfield[_async_region];
+    _async_callback = callback;
+
+    int status = _async_step();
+    if (status != SPIF_BD_ERROR_OK) {
+        _async_op = SPIF_ASYNC_NONE;
+    }
+    _mutex->unlock();
+    return status;
+}
+
+int SPIFBlockDevice::stream_open(bd_addr_t addr, bd_size_t size)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if ((size == 0) || ((addr + size) > _device_size_bytes) || ((addr % get_erase_size(addr)) != 0)
+            || (((addr + size) % get_erase_size(addr + size - 1)) != 0)) {
+        tr_error("ERROR: invalid stream - unaligned address and size");
+        return SPIF_BD_ERROR_INVALID_ERASE_PARAMS;
+    }
+
+    _mutex->lock();
+    if (_stream_is_open) {
+        _mutex->unlock();
+        return SPIF_BD_ERROR_BUSY;
+    }
+    _stream_is_open = true;
+    _mutex->unlock();
+
+    _stream_addr = addr;
+    _stream_erased = addr;
+    _stream_end = addr + size;
+    _stream_erase_status = SPIF_BD_ERROR_OK;
+    memset(&_stream_stats, 0, sizeof(_stream_stats));
+    _stream_timer.reset();
+    _stream_timer.start();
+
+    // Start erasing the first sector right away
+    int status = _stream_erase_ahead();
+    if (status != SPIF_BD_ERROR_OK) {
+        _stream_timer.stop();
+        _stream_is_open = false;
+    }
+    return status;
+}
+
+int SPIFBlockDevice::stream_write(const void *buffer, bd_size_t size)
+{
+    const uint8_t *data = static_cast<const uint8_t *>(buffer);
+
+    if (!_stream_is_open || (size > (_stream_end - _stream_addr))) {
+        return SPIF_BD_ERROR_DEVICE_ERROR;
+    }
+
+    while (size > 0) {
+        if (_stream_addr == _stream_erased) {
+            // The erase ahead was not started, the previous one failed to start
+            int status = _stream_erase_ahead();
+            if (status != SPIF_BD_ERROR_OK) {
+                return status;
+            }
+        }
+
+        int status = _stream_wait_erase();
+        if (status != SPIF_BD_ERROR_OK) {
+            return status;
+        }
+
+        bd_size_t chunk = (size < (_stream_erased - _stream_addr)) ? size : (_stream_erased - _stream_addr);
+        status = program(data, _stream_addr, chunk);
+        if (status != SPIF_BD_ERROR_OK) {
+            return status;
+        }
+
+        data += chunk;
+        size -= chunk;
+        _stream_addr += chunk;
+        _stream_stats.bytes_written += chunk;
+
+        // The sector is written, erase the next one while the caller produces more data
+        if ((_stream_addr == _stream_erased) && (_stream_erased < _stream_end)) {
+            _stream_erase_ahead();
+        }
+    }
+
+    return SPIF_BD_ERROR_OK;
+}
+
+int SPIFBlockDevice::stream_close()
+{
+    if (!_stream_is_open) {
+        return SPIF_BD_ERROR_DEVICE_ERROR;
+    }
+
+    int status = _stream_wait_erase();
+    _stream_stats.elapsed_us = _stream_timer.read_us();
+    _stream_timer.stop();
+    _stream_is_open = false;
+    return status;
+}
+
+void SPIFBlockDevice::stream_get_stats(spif_stream_stats_t *stats)
+{
+    *stats = _stream_stats;
+    if (_stream_is_open) {
+        stats->elapsed_us = _stream_timer.read_us();
+    }
+}
+#endif
+
 bd_size_t SPIFBlockDevice::get_read_size() const
 {
     // Assuming all devices support 1byte read granularity
@@ -487,34 +696,53 @@ spif_bd_error SPIFBlockDevice::_spi_set_frequency(int freq)
     return SPIF_BD_ERROR_OK;
 }
 
-spif_bd_error SPIFBlockDevice::_spi_send_read_command(int read_inst, uint8_t *buffer, bd_addr_t addr, bd_size_t size)
+void SPIFBlockDevice::_spi_send_command_header(int instruction, bd_addr_t addr)
 {
+    // Instruction, Address and Dummy Cycles Bytes go out in one transfer
+    char header[SPIF_COMMAND_HEADER_SIZE];
+    size_t header_length = 0;
     uint32_t dummy_bytes = _dummy_and_mode_cycles / 8;
-    int dummy_byte = 0;
 
-    // csel must go low for the entire command (Inst, Address and Data)
-    _cs = 0;
+    // 1 byte Instruction
+    header[header_length++] = instruction;
 
-    // Write 1 byte Instruction
-    _spi.write(read_inst);
+    // Reading SPI Bus registers does not require Flash Address
+    if (addr != SPI_NO_ADDRESS_COMMAND) {
+        // Address (can be either 3 or 4 bytes long)
+        for (int address_shift = ((_address_size - 1) * 8); address_shift >= 0; address_shift -= 8) {
+            header[header_length++] = (addr >> address_shift) & 0xFF;
+        }
 
-    // Write Address (can be either 3 or 4 bytes long)
-    for (int address_shift = ((_address_size - 1) * 8); address_shift >= 0; address_shift -= 8) {
-        _spi.write((addr >> address_shift) & 0xFF);
+        // Dummy Cycles Bytes
+        for (uint32_t i = 0; i < dummy_bytes; i++) {
+            if (header_length == sizeof(header)) {
+                _spi.write(make_Span(header, header_length));
+                header_length = 0;
+            }
+            header[header_length++] = 0;
+        }
     }
 
-    // Write Dummy Cycles Bytes
-    for (uint32_t i = 0; i < dummy_bytes; i++) {
-        _spi.write(dummy_byte);
-    }
+    _spi.write(make_Span(header, header_length));
+}
+
+spif_bd_error SPIFBlockDevice::_spi_send_read_command(int read_inst, uint8_t *buffer, bd_addr_t addr, bd_size_t size)
+{
+    // Keep the bus, and its format, for the entire command
+    _spi.lock();
+
+    // csel must go low for the entire command (Inst, Address and Data)
+    _cs = 0;
+
+    _spi_send_command_header(read_inst, addr);
 
     // Read Data
-    for (bd_size_t i = 0; i < size; i++) {
-        buffer[i] = _spi.write(0);
-    }
+    _spi.write(Span<const char>(), make_Span((char *)buffer, size));
 
     // csel back to high
     _cs = 1;
+
+    _spi.unlock();
     return SPIF_BD_ERROR_OK;
 }
 
@@ -522,34 +750,20 @@ spif_bd_error SPIFBlockDevice::_spi_send_program_command(int prog_inst, const vo
                                                          bd_size_t size)
 {
     // Send Program (write) command to device driver
-    uint32_t dummy_bytes = _dummy_and_mode_cycles / 8;
-    int dummy_byte = 0;
-    uint8_t *data = (uint8_t *)buffer;
+    _spi.lock();
 
     // csel must go low for the entire command (Inst, Address and Data)
     _cs = 0;
 
-    // Write 1 byte Instruction
-    _spi.write(prog_inst);
-
-    // Write Address (can be either 3 or 4 bytes long)
-    for (int address_shift = ((_address_size - 1) * 8); address_shift >= 0; address_shift -= 8) {
-        _spi.write((addr >> address_shift) & 0xFF);
-    }
-
-    // Write Dummy Cycles Bytes
-    for (uint32_t i = 0; i < dummy_bytes; i++) {
-        _spi.write(dummy_byte);
-    }
+    _spi_send_command_header(prog_inst, addr);
 
     // Write Data
-    for (bd_size_t i = 0; i < size; i++) {
-        _spi.write(data[i]);
-    }
+    _spi.write(make_Span((const char *)buffer, size));
 
     // csel back to high
     _cs = 1;
 
+    _spi.unlock();
     return SPIF_BD_ERROR_OK;
 }
 
@@ -565,27 +779,12 @@ spif_bd_error SPIFBlockDevice::_spi_send_general_command(int instruction, bd_add
                                                          size_t tx_length, char *rx_buffer, size_t rx_length)
 {
     // Send a general command Instruction to driver
-    uint32_t dummy_bytes = _dummy_and_mode_cycles / 8;
-    uint8_t dummy_byte = 0x00;
+    _spi.lock();
 
     // csel must go low for the entire command (Inst, Address and Data)
     _cs = 0;
 
-    // Write 1 byte Instruction
-    _spi.write(instruction);
-
-    // Reading SPI Bus registers does not require Flash Address
-    if (addr != SPI_NO_ADDRESS_COMMAND) {
-        // Write Address (can be either 3 or 4 bytes long)
-        for (int address_shift = ((_address_size - 1) * 8); address_shift >= 0; address_shift -= 8) {
-            _spi.write((addr >> address_shift) & 0xFF);
-        }
-
-        // Write Dummy Cycles Bytes
-        for (uint32_t i = 0; i < dummy_bytes; i++) {
-            _spi.write(dummy_byte);
-        }
-    }
+    _spi_send_command_header(instruction, addr);
 
     // Read/Write Data
     _spi.write(tx_buffer, (int)tx_length, rx_buffer, (int)rx_length);
@@ -593,6 +792,7 @@ spif_bd_error SPIFBlockDevice::_spi_send_general_command(int instruction, bd_add
     // csel back to high
     _cs = 1;
 
+    _spi.unlock();
     return SPIF_BD_ERROR_OK;
 }
 
@@ -953,6 +1153,165 @@ bool SPIFBlockDevice::_is_mem_ready()
     return mem_ready;
 }
 
+void SPIFBlockDevice::_lock_idle()
+{
+    _mutex->lock();
+    while (_async_op != SPIF_ASYNC_NONE) {
+        _mutex->unlock();
+        wait_ms(SPIF_ASYNC_POLL_INTERVAL_MS);
+        _mutex->lock();
+    }
+}
+
+#if defined(MBED_CONF_EVENTS_PRESENT)
+int SPIFBlockDevice::_async_step()
+{
+    if (_async_op == SPIF_ASYNC_PROGRAM) {
+        // Write on _page_size_bytes boundaries (Default 256 bytes a page)
+        uint32_t offset = _async_addr % _page_size_bytes;
+        uint32_t chunk = (offset + _async_size < _page_size_bytes) ? _async_size : (_page_size_bytes - offset);
+
+        if (_set_write_enable() != 0) {
+            tr_error("ERROR: Write Enabe failed\n");
+            return SPIF_BD_ERROR_WREN_FAILED;
+        }
+
+        _spi_send_program_command(_prog_instruction, _async_buffer, _async_addr, chunk);
+
+        _async_buffer += chunk;
+        _async_addr += chunk;
+        _async_size -= chunk;
+    } else {
+        // Erase the largest section supported by current region
+        int type = _utils_iterate_next_largest_erase_type(_async_bitfield, (int)_async_size, (unsigned int)_async_addr,
+                                                          _region_high_boundary[_async_region]);
+        int cur_erase_inst = _erase_type_inst_arr[type];
+        uint32_t offset = _async_addr % _erase_type_size_arr[type];
+        uint32_t chunk = ((offset + _async_size) < _erase_type_size_arr[type]) ? _async_size : (_erase_type_size_arr[type] - offset);
+
+        if (_set_write_enable() != 0) {
+            tr_error("ERROR: SPI Erase Device not ready - failed");
+            return SPIF_BD_ERROR_READY_FAILED;
+        }
+
+        _spi_send_erase_command(cur_erase_inst, _async_addr, _async_size);
+
+        _async_addr += chunk;
+        _async_size -= chunk;
+
+        if ((_async_size > 0) && (_async_addr > _region_high_boundary[_async_region])) {
+            // erase crossed to next region
+            _async_region++;
+            _async_bitfield = _region_erase_types_bitfield[_async_region];
+        }
+    }
+
+    _async_retries = 0;
+    return _async_schedule();
+}
+
+int SPIFBlockDevice::_async_schedule()
+{
+    if (0 == mbed::mbed_event_queue()->call_in(SPIF_ASYNC_POLL_INTERVAL_MS, mbed::callback(this, &SPIFBlockDevice::_async_poll))) {
+        // Don't leave the device busy behind the caller's back
+        tr_error("ERROR: Queueing status poll failed\n");
+        _is_mem_ready();
+        return SPIF_BD_ERROR_DEVICE_ERROR;
+    }
+    return SPIF_BD_ERROR_OK;
+}
+
+void SPIFBlockDevice::_async_poll()
+{
+    char status_value[2];
+    int status = SPIF_BD_ERROR_OK;
+
+    _mutex->lock();
+
+    //Read the Status Register from device
+    memset(status_value, 0, 2);
+    if (SPIF_BD_ERROR_OK != _spi_send_general_command(SPIF_RDSR, SPI_NO_ADDRESS_COMMAND, NULL, 0, status_value,
+                                                      1)) {   // store received values in status_value
+        tr_error("ERROR: Reading Status Register failed\n");
+    }
+
+    if ((status_value[0] & SPIF_STATUS_BIT_WIP) != 0) {
+        if (++_async_retries < IS_MEM_READY_MAX_RETRIES) {
+            status = _async_schedule();
+        } else {
+            tr_error("ERROR: _async_poll Device not ready - failed\n");
+            status = SPIF_BD_ERROR_READY_FAILED;
+        }
+    } else if (_async_size > 0) {
+        status = _async_step();
+    } else {
+        _async_complete(SPIF_BD_ERROR_OK);
+        return;
+    }
+
+    if (status != SPIF_BD_ERROR_OK) {
+        _async_complete(status);
+        return;
+    }
+    _mutex->unlock();
+}
+
+void SPIFBlockDevice::_async_complete(int status)
+{
+    mbed::bd_callback_t callback = _async_callback;
+    _async_callback = NULL;
+    _async_op = SPIF_ASYNC_NONE;
+    _mutex->unlock();
+
+    // The callback may start another request
+    callback(status);
+}
+
+int SPIFBlockDevice::_stream_erase_ahead()
+{
+    bd_size_t sector_size = get_erase_size(_stream_erased);
+
+    _stream_erasing = true;
+    int status = erase_async(_stream_erased, sector_size, mbed::callback(this, &SPIFBlockDevice::_stream_erase_done));
+    if (status == SPIF_BD_ERROR_BUSY) {
+        // Another asynchronous request is in progress, erase once it completes
+        _stream_erasing = false;
+        status = erase(_stream_erased, sector_size);
+    } else if (status != SPIF_BD_ERROR_OK) {
+        _stream_erasing = false;
+    }
+
+    if (status != SPIF_BD_ERROR_OK) {
+        tr_error("ERROR: stream erase ahead failed");
+        return status;
+    }
+
+    _stream_erased += sector_size;
+    _stream_stats.sectors_erased++;
+    return SPIF_BD_ERROR_OK;
+}
+
+void SPIFBlockDevice::_stream_erase_done(int status)
+{
+    _stream_erase_status = status;
+    _stream_erasing = false;
+}
+
+int SPIFBlockDevice::_stream_wait_erase()
+{
+    if (_stream_erasing) {
+        uint32_t start_us = _stream_timer.read_us();
+        while (_stream_erasing) {
+            wait_ms(SPIF_ASYNC_POLL_INTERVAL_MS);
+        }
+        _stream_stats.erase_wait_us += _stream_timer.read_us() - start_us;
+    }
+
+    // A failed erase leaves the rest of the stream unwritable until it is opened again
+    return _stream_erase_status;
+}
+#endif
+
 int SPIFBlockDevice::_set_write_enable()
 {
     // Check Status Register Busy Bit to Verify the Device isn't Busy
@@ -19,6 +19,10 @@
 #include "SPI.h"
 #include "DigitalOut.h"
 #include "BlockDevice.h"
+#if defined(MBED_CONF_EVENTS_PRESENT)
+#include "Timer.h"
+#include "events/mbed_shared_queues.h"
+#endif
 
 /** Enum spif standard error codes
  *
@@ -31,6 +35,18 @@ enum spif_bd_error {
     SPIF_BD_ERROR_READY_FAILED          = -4003, /* Wait for Memory Ready failed */
     SPIF_BD_ERROR_WREN_FAILED           = -4004, /* Write Enable Failed */
     SPIF_BD_ERROR_INVALID_ERASE_PARAMS  = -4005, /* Erase command not on sector aligned addresses or exceeds device size */
+    SPIF_BD_ERROR_BUSY                  = -4006, /* Another asynchronous program or erase is in progress */
+};
+
+/** Counters of a streaming write
+ *
+ *  @see SPIFBlockDevice::stream_open
+ */
+struct spif_stream_stats_t {
+    mbed::bd_size_t bytes_written;  /*!< bytes programmed since the stream was opened */
+    uint32_t sectors_erased;        /*!< sectors erased ahead of the writes */
+    uint32_t elapsed_us;            /*!< time since the stream was opened */
+    uint32_t erase_wait_us;         /*!< time the writes spent waiting for an erase to complete */
 };
 
 
@@ -143,6 +159,110 @@ public:
      */
     virtual int erase(mbed::bd_addr_t addr, mbed::bd_size_t size);
 
+#if defined(MBED_CONF_EVENTS_PRESENT)
+    /** Read blocks from a block device without waiting for an asynchronous program or erase
+     *
+     *  Reads are short, so the read is done and the callback called before this function
+     *  returns, unless an asynchronous program or erase is in progress.
+     *
+     *  @param buffer   Buffer to write blocks to
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @param callback Callback called with the result of the read
+     *  @return         SPIF_BD_ERROR_OK(0) - success
+     *                  SPIF_BD_ERROR_DEVICE_ERROR - device not initialized
+     *                  SPIF_BD_ERROR_BUSY - an asynchronous program or erase is in progress
+     */
+    virtual int read_async(void *buffer, mbed::bd_addr_t addr, mbed::bd_size_t size, mbed::bd_callback_t callback);
+
+    /** Program blocks to a block device without waiting for the program to complete
+     *
+     *  The first page is programmed here, then the status register is polled and the
+     *  following pages programmed from the shared event queue, which calls the callback
+     *  once done. The buffer must stay valid until then.
+     *
+     *  @note Blocking calls made while the program is in progress wait for it to complete,
+     *        so they must not be made from the shared event queue.
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @param callback Callback called with the result of the program
+     *  @return         SPIF_BD_ERROR_OK(0) - success
+     *                  SPIF_BD_ERROR_DEVICE_ERROR - device driver transaction failed
+     *                  SPIF_BD_ERROR_WREN_FAILED - Write Enable failed
+     *                  SPIF_BD_ERROR_BUSY - an asynchronous program or erase is in progress
+     */
+    virtual int program_async(const void *buffer, mbed::bd_addr_t addr, mbed::bd_size_t size,
+                              mbed::bd_callback_t callback);
+
+    /** Erase blocks on a block device without waiting for the erase to complete
+     *
+     *  The first sector erase is started here, then the status register is polled and
+     *  the following sectors erased from the shared event queue, which calls the callback
+     *  once done.
+     *
+     *  @note Blocking calls made while the erase is in progress wait for it to complete,
+     *        so they must not be made from the shared event queue.
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of erase block size
+     *  @param callback Callback called with the result of the erase
+     *  @return         SPIF_BD_ERROR_OK(0) - success
+     *                  SPIF_BD_ERROR_DEVICE_ERROR - device driver transaction failed
+     *                  SPIF_BD_ERROR_READY_FAILED - Waiting for Memory ready failed
+     *                  SPIF_BD_ERROR_INVALID_ERASE_PARAMS - Trying to erase unaligned address or size
+     *                  SPIF_BD_ERROR_BUSY - an asynchronous program or erase is in progress
+     */
+    virtual int erase_async(mbed::bd_addr_t addr, mbed::bd_size_t size, mbed::bd_callback_t callback);
+
+    /** Open a streaming write over a region of the block device
+     *
+     *  The region is then written in order with stream_write, which erases each sector
+     *  before it is programmed. As soon as a sector has been written, the next one is
+     *  erased in the background, so the erase overlaps with producing the data to write
+     *  instead of delaying the next write by the full erase time.
+     *
+     *  @note The flash can't program while it erases, so a write into a sector still
+     *        being erased waits for the erase to complete.
+     *
+     *  @param addr     Address of block to begin the stream at, must be erase-aligned
+     *  @param size     Size of the region in bytes, must be a multiple of erase block size
+     *  @return         SPIF_BD_ERROR_OK(0) - success
+     *                  SPIF_BD_ERROR_DEVICE_ERROR - device not initialized
+     *                  SPIF_BD_ERROR_INVALID_ERASE_PARAMS - unaligned address or size
+     *                  SPIF_BD_ERROR_BUSY - a stream is already open
+     */
+    int stream_open(mbed::bd_addr_t addr, mbed::bd_size_t size);
+
+    /** Append data to the stream opened with stream_open
+     *
+     *  @param buffer   Buffer of data to write
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @return         SPIF_BD_ERROR_OK(0) - success
+     *                  SPIF_BD_ERROR_DEVICE_ERROR - no stream open, or the write exceeds its region
+     *                  SPIF_BD_ERROR_READY_FAILED - Waiting for Memory ready failed or timed out
+     *                  SPIF_BD_ERROR_WREN_FAILED - Write Enable failed
+     */
+    int stream_write(const void *buffer, mbed::bd_size_t size);
+
+    /** Close the stream once any erase ahead of it is complete
+     *
+     *  @return         SPIF_BD_ERROR_OK(0) - success
+     *                  SPIF_BD_ERROR_DEVICE_ERROR - no stream open
+     *                  SPIF_BD_ERROR_READY_FAILED - the erase ahead failed
+     */
+    int stream_close();
+
+    /** Get the counters of the open stream, or of the last one closed
+     *
+     *  The sustained write bandwidth is bytes_written over elapsed_us.
+     *
+     *  @param stats    Set to the counters
+     */
+    void stream_get_stats(spif_stream_stats_t *stats);
+#endif
+
     /** Get the size of a readable block
      *
      *  @return         Size of a readable block in bytes
@@ -235,6 +355,9 @@ private:
     /********************************/
     /*   Calls to SPI Driver APIs   */
     /********************************/
+    // Send Instruction, Address and Dummy Cycles Bytes of a command
+    void _spi_send_command_header(int instruction, mbed::bd_addr_t addr);
+
     // Send Program => Write command to Driver
     spif_bd_error _spi_send_program_command(int prog_inst, const void *buffer, mbed::bd_addr_t addr, mbed::bd_size_t size);
 
@@ -262,6 +385,38 @@ private:
     // Wait on status register until write not-in-progress
     bool _is_mem_ready();
 
+    // Lock the mutex once no asynchronous program or erase is in progress
+    void _lock_idle();
+
+#if defined(MBED_CONF_EVENTS_PRESENT)
+    /*****************************************/
+    /* Asynchronous Program and Erase Steps  */
+    /*****************************************/
+    // Start programming the next page or erasing the next sector, with the mutex locked
+    int _async_step();
+
+    // Poll the status register from the shared event queue once the step has had time to complete
+    int _async_schedule();
+
+    // Check if the current step completed and start the next one, or complete the request
+    void _async_poll();
+
+    // Unlock the mutex and call the callback of the request
+    void _async_complete(int status);
+
+    /*****************************************/
+    /* Streaming Write                       */
+    /*****************************************/
+    // Start erasing the sector at the end of the erased part of the stream
+    int _stream_erase_ahead();
+
+    // Completion of the erase ahead, called from the shared event queue
+    void _stream_erase_done(int status);
+
+    // Wait for the erase ahead to complete, and account for the time spent waiting
+    int _stream_wait_erase();
+#endif
+
 private:
     // Master side hardware
     mbed::SPI _spi;
@@ -300,6 +455,34 @@ private:
     unsigned int _dummy_and_mode_cycles; // Number of Dummy and Mode Bits required by Current Bus Mode
     uint32_t _init_ref_count;
     bool _is_initialized;
+
+    // Asynchronous program or erase in progress
+    enum async_op {
+        SPIF_ASYNC_NONE,
+        SPIF_ASYNC_PROGRAM,
+        SPIF_ASYNC_ERASE,
+    };
+    async_op _async_op;
+    const uint8_t *_async_buffer;
+    bd_addr_t _async_addr;
+    bd_size_t _async_size;
+    int _async_region;
+    uint8_t _async_bitfield;
+    int _async_retries;
+    mbed::bd_callback_t _async_callback;
+
+#if defined(MBED_CONF_EVENTS_PRESENT)
+    // Streaming write, the region between _stream_addr and _stream_erased is erased
+    // or being erased, up to _stream_end
+    bool _stream_is_open;
+    bd_addr_t _stream_addr;
+    bd_addr_t _stream_erased;
+    bd_addr_t _stream_end;
+    volatile bool _stream_erasing;
+    volatile int _stream_erase_status;
+    spif_stream_stats_t _stream_stats;
+    mbed::Timer _stream_timer;
+#endif
 };
 
 #endif  /* MBED_SPIF_BLOCK_DEVICE_H */
@@ -19,6 +19,7 @@
 #include "SPIFBlockDevice.h"
 #include "mbed_trace.h"
 #include "rtos/Thread.h"
+#include "rtos/Semaphore.h"
 #include <stdlib.h>
 
 using namespace utest::v1;
@@ -268,6 +269,146 @@ void test_spif_multi_threads()
     TEST_ASSERT_EQUAL(0, err);
 }
 
+static rtos::Semaphore async_done(0, 1);
+static int async_result;
+
+static void async_callback(int result)
+{
+    async_result = result;
+    async_done.release();
+}
+
+static int wait_async(int err)
+{
+    if (err) {
+        return err;
+    }
+    TEST_ASSERT_EQUAL(1, async_done.wait(10000));
+    return async_result;
+}
+
+void test_spif_async_erase_program_read()
+{
+    utest_printf("\nTest Async Erase Program Read Starts..\n");
+
+    SPIFBlockDevice block_device(MBED_CONF_SPIF_DRIVER_SPI_MOSI, MBED_CONF_SPIF_DRIVER_SPI_MISO,
+                                 MBED_CONF_SPIF_DRIVER_SPI_CLK,
+                                 MBED_CONF_SPIF_DRIVER_SPI_CS);
+
+    int err = block_device.init();
+    TEST_ASSERT_EQUAL(0, err);
+
+    bd_size_t block_size = block_device.get_erase_size();
+    uint8_t *write_block = new (std::nothrow) uint8_t[block_size];
+    uint8_t *read_block = new (std::nothrow) uint8_t[block_size];
+    if (!write_block || !read_block) {
+        utest_printf("\n Not enough memory for test");
+        goto end;
+    }
+
+    for (bd_size_t i_ind = 0; i_ind < block_size; i_ind++) {
+        write_block[i_ind] = 0xff & rand();
+    }
+
+    err = block_device.erase_async(0, block_size, async_callback);
+    TEST_ASSERT_EQUAL(0, err);
+    // Only one asynchronous program or erase at a time
+    err = block_device.erase_async(block_size, block_size, async_callback);
+    TEST_ASSERT_EQUAL(SPIF_BD_ERROR_BUSY, err);
+    err = wait_async(0);
+    TEST_ASSERT_EQUAL(0, err);
+
+    err = wait_async(block_device.program_async(write_block, 0, block_size, async_callback));
+    TEST_ASSERT_EQUAL(0, err);
+
+    err = wait_async(block_device.read_async(read_block, 0, block_size, async_callback));
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_block, read_block, block_size);
+
+    // Blocking calls wait for the asynchronous erase to complete
+    err = block_device.erase_async(0, block_size, async_callback);
+    TEST_ASSERT_EQUAL(0, err);
+    err = block_device.read(read_block, 0, block_size);
+    TEST_ASSERT_EQUAL(0, err);
+    err = wait_async(0);
+    TEST_ASSERT_EQUAL(0, err);
+    for (bd_size_t i_ind = 0; i_ind < block_size; i_ind++) {
+        TEST_ASSERT_EQUAL(0xff, read_block[i_ind]);
+    }
+
+    err = block_device.deinit();
+    TEST_ASSERT_EQUAL(0, err);
+
+end:
+    delete[] write_block;
+    delete[] read_block;
+}
+
+#define STREAM_SECTOR_COUNT 4
+#define STREAM_CHUNK_SIZE 256
+
+void test_spif_stream_write()
+{
+    utest_printf("\nTest Stream Write Starts..\n");
+
+    SPIFBlockDevice block_device(MBED_CONF_SPIF_DRIVER_SPI_MOSI, MBED_CONF_SPIF_DRIVER_SPI_MISO,
+                                 MBED_CONF_SPIF_DRIVER_SPI_CLK,
+                                 MBED_CONF_SPIF_DRIVER_SPI_CS);
+
+    int err = block_device.init();
+    TEST_ASSERT_EQUAL(0, err);
+
+    bd_size_t block_size = block_device.get_erase_size();
+    bd_size_t stream_size = STREAM_SECTOR_COUNT * block_size;
+    uint8_t write_chunk[STREAM_CHUNK_SIZE];
+    uint8_t read_chunk[STREAM_CHUNK_SIZE];
+    spif_stream_stats_t stats;
+
+    // Unaligned regions are rejected
+    err = block_device.stream_open(1, stream_size);
+    TEST_ASSERT_EQUAL(SPIF_BD_ERROR_INVALID_ERASE_PARAMS, err);
+
+    err = block_device.stream_open(0, stream_size);
+    TEST_ASSERT_EQUAL(0, err);
+    err = block_device.stream_open(0, stream_size);
+    TEST_ASSERT_EQUAL(SPIF_BD_ERROR_BUSY, err);
+
+    srand(1);
+    for (bd_size_t offset = 0; offset < stream_size; offset += STREAM_CHUNK_SIZE) {
+        for (int i_ind = 0; i_ind < STREAM_CHUNK_SIZE; i_ind++) {
+            write_chunk[i_ind] = 0xff & rand();
+        }
+        err = block_device.stream_write(write_chunk, STREAM_CHUNK_SIZE);
+        TEST_ASSERT_EQUAL(0, err);
+    }
+
+    // Writing past the end of the region fails
+    err = block_device.stream_write(write_chunk, STREAM_CHUNK_SIZE);
+    TEST_ASSERT_EQUAL(SPIF_BD_ERROR_DEVICE_ERROR, err);
+
+    err = block_device.stream_close();
+    TEST_ASSERT_EQUAL(0, err);
+
+    block_device.stream_get_stats(&stats);
+    TEST_ASSERT_EQUAL(stream_size, stats.bytes_written);
+    TEST_ASSERT_EQUAL(STREAM_SECTOR_COUNT, stats.sectors_erased);
+    utest_printf("\n%llu bytes in %lu us, %lu us waiting for erase\n",
+                 stats.bytes_written, stats.elapsed_us, stats.erase_wait_us);
+
+    srand(1);
+    for (bd_size_t offset = 0; offset < stream_size; offset += STREAM_CHUNK_SIZE) {
+        for (int i_ind = 0; i_ind < STREAM_CHUNK_SIZE; i_ind++) {
+            write_chunk[i_ind] = 0xff & rand();
+        }
+        err = block_device.read(read_chunk, offset, STREAM_CHUNK_SIZE);
+        TEST_ASSERT_EQUAL(0, err);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(write_chunk, read_chunk, STREAM_CHUNK_SIZE);
+    }
+
+    err = block_device.deinit();
+    TEST_ASSERT_EQUAL(0, err);
+}
+
 // Test setup
 utest::v1::status_t test_setup(const size_t number_of_cases)
 {
@@ -278,7 +419,9 @@ utest::v1::status_t test_setup(const size_t number_of_cases)
 Case cases[] = {
     Case("Testing unaligned erase blocks", test_spif_unaligned_erase),
     Case("Testing read write random blocks", test_spif_random_program_read_erase),
-    Case("Testing Multi Threads Erase Program Read", test_spif_multi_threads)
+    Case("Testing Multi Threads Erase Program Read", test_spif_multi_threads),
+    Case("Testing Async Erase Program Read", test_spif_async_erase_program_read),
+    Case("Testing Stream Write", test_spif_stream_write)
 };
 
 Specification specification(test_setup, cases);
@@ -26,10 +26,12 @@
 #include "platform/Callback.h"
 #include "platform/mbed_error.h"
 #include "rtos/Kernel.h"
+#include "rtos/ThisThread.h"
 
 #define TRACE_GROUP  "ESPA" // ESP8266 AT layer
 
 #define ESP8266_DEFAULT_BAUD_RATE   115200
+#define ESP8266_SERIAL_BAUD_RATE    MBED_CONF_ESP8266_SERIAL_BAUDRATE
 #define ESP8266_ALL_SOCKET_IDS      -1
 
 using namespace mbed;
@@ -43,6 +45,8 @@ ESP8266::ESP8266(PinName tx, PinName rx, bool debug, PinName rts, PinName cts)
       _serial_rts(rts),
       _serial_cts(cts),
       _parser(&_serial),
+      _send_status(SEND_STATUS_OK),
+      _send_id(-1),
       _packets(0),
       _packets_end(&_packets),
       _heap_usage(0),
@@ -84,6 +88,8 @@ ESP8266::ESP8266(PinName tx, PinName rx, bool debug, PinName rts, PinName cts)
     _parser.oob("busy ", callback(this, &ESP8266::_oob_busy));
     // NOTE: documentation v3.0 says '+CIPRECVDATA:<data_len>,' but it's not how the FW responds...
     _parser.oob("+CIPRECVDATA,", callback(this, &ESP8266::_oob_tcp_data_hdlr));
+    _parser.oob("SEND OK", callback(this, &ESP8266::_oob_send_ok_received));
+    _parser.oob("SEND FAIL", callback(this, &ESP8266::_oob_send_fail_received));
 
     for (int i = 0; i < SOCKET_COUNT; i++) {
         _sock_i[i].open = false;
@@ -167,64 +173,95 @@ struct ESP8266::fw_at_version ESP8266::at_version()
 bool ESP8266::stop_uart_hw_flow_ctrl(void)
 {
     bool done = true;
-#if DEVICE_SERIAL_FC
 
-    if (_serial_rts != NC || _serial_cts != NC) {
+    if (_serial_rts != NC || _serial_cts != NC || ESP8266_SERIAL_BAUD_RATE != ESP8266_DEFAULT_BAUD_RATE) {
+        _smutex.lock();
+#if DEVICE_SERIAL_FC
         // Stop board's flow control
         _serial.set_flow_control(SerialBase::Disabled, _serial_rts, _serial_cts);
+#endif
 
         // Stop ESP8266's flow control
         done = _parser.send("AT+UART_CUR=%u,8,1,0,0", ESP8266_DEFAULT_BAUD_RATE)
                && _parser.recv("OK\n");
+
+        if (done) {
+            // ESP8266 switches once it has responded
+            _serial.set_baud(ESP8266_DEFAULT_BAUD_RATE);
+        }
+        _smutex.unlock();
     }
 
-#endif
     return done;
 }
 
 bool ESP8266::start_uart_hw_flow_ctrl(void)
 {
     bool done = true;
+    // ESP8266's flow control: 0 disabled, 1 RTS, 2 CTS, 3 RTS and CTS
+    int flow_ctrl = 0;
 
 #if DEVICE_SERIAL_FC
-    _smutex.lock();
     if (_serial_rts != NC && _serial_cts != NC) {
-        // Start ESP8266's flow control
-        done = _parser.send("AT+UART_CUR=%u,8,1,0,3", ESP8266_DEFAULT_BAUD_RATE)
-               && _parser.recv("OK\n");
+        flow_ctrl = 3;
+    } else if (_serial_rts != NC) {
+        // Enable ESP8266's CTS pin
+        flow_ctrl = 2;
+    } else if (_serial_cts != NC) {
+        // Enable ESP8266's RTS pin
+        flow_ctrl = 1;
+    }
+#else
+    if (_serial_rts != NC || _serial_cts != NC) {
+        return false;
+    }
+#endif
 
-        if (done) {
-            // Start board's flow control
-             _serial.set_flow_control(SerialBase::RTSCTS, _serial_rts, _serial_cts);
-        }
+    if (flow_ctrl == 0 && ESP8266_SERIAL_BAUD_RATE == ESP8266_DEFAULT_BAUD_RATE) {
+        return true;
+    }
 
-    } else if (_serial_rts != NC) {
+    _smutex.lock();
+#if DEVICE_SERIAL_FC
+    if (flow_ctrl == 2) {
         _serial.set_flow_control(SerialBase::RTS, _serial_rts, NC);
+    }
+#endif
 
-        // Enable ESP8266's CTS pin
-        done = _parser.send("AT+UART_CUR=%u,8,1,0,2", ESP8266_DEFAULT_BAUD_RATE)
-               && _parser.recv("OK\n");
+    done = _parser.send("AT+UART_CUR=%u,8,1,0,%d", ESP8266_SERIAL_BAUD_RATE, flow_ctrl)
+           && _parser.recv("OK\n");
 
-    } else if (_serial_cts != NC) {
-        // Enable ESP8266's RTS pin
-        done = _parser.send("AT+UART_CUR=%u,8,1,0,1", ESP8266_DEFAULT_BAUD_RATE)
-               && _parser.recv("OK\n");
+    if (done) {
+        // ESP8266 switches once it has responded
+        _serial.set_baud(ESP8266_SERIAL_BAUD_RATE);
 
-        if (done) {
+#if DEVICE_SERIAL_FC
+        // Start board's flow control
+        if (flow_ctrl == 3) {
+            _serial.set_flow_control(SerialBase::RTSCTS, _serial_rts, _serial_cts);
+        } else if (flow_ctrl == 1) {
             _serial.set_flow_control(SerialBase::CTS, NC, _serial_cts);
         }
+#endif
     }
     _smutex.unlock();
 
     if (!done) {
         tr_debug("Enable UART HW flow control: FAIL");
     }
-#else
+    return done;
+}
+
+void ESP8266::reset_uart_settings()
+{
+    _smutex.lock();
+#if DEVICE_SERIAL_FC
     if (_serial_rts != NC || _serial_cts != NC) {
-        done = false;
+        _serial.set_flow_control(SerialBase::Disabled, _serial_rts, _serial_cts);
     }
 #endif
-    return done;
+    _serial.set_baud(ESP8266_DEFAULT_BAUD_RATE);
+    _smutex.unlock();
 }
 
 bool ESP8266::startup(int mode)
@@ -261,6 +298,8 @@ bool ESP8266::reset(void)
             tr_debug("reset(): AT+RST failed or no response");
             continue;
         }
+        // ESP8266 restarts with its default UART settings
+        reset_uart_settings();
 
         _rmutex.lock();
         while ((rtos::Kernel::get_ms_count() - start_time < ESP8266_BOOTTIME) && !_reset_done) {
@@ -278,6 +317,7 @@ bool ESP8266::reset(void)
     tr_debug("reset(): done: %s", done ? "OK" : "FAIL");
 
     _clear_socket_packets(ESP8266_ALL_SOCKET_IDS);
+    _send_status = SEND_STATUS_OK;
     set_timeout();
     _smutex.unlock();
 
@@ -482,6 +522,7 @@ nsapi_error_t ESP8266::open_udp(int id, const char *addr, int port, int local_po
 
     // process OOB so that _sock_i reflects the correct state of the socket
     _process_oob(ESP8266_SEND_TIMEOUT, true);
+    _wait_send_done(ESP8266_SEND_TIMEOUT);
 
     if (id >= SOCKET_COUNT || _sock_i[id].open) {
         _smutex.unlock();
@@ -533,6 +574,7 @@ nsapi_error_t ESP8266::open_tcp(int id, const char *addr, int port, int keepaliv
 
     // process OOB so that _sock_i reflects the correct state of the socket
     _process_oob(ESP8266_SEND_TIMEOUT, true);
+    _wait_send_done(ESP8266_SEND_TIMEOUT);
 
     if (id >= SOCKET_COUNT || _sock_i[id].open) {
         _smutex.unlock();
@@ -584,9 +626,29 @@ bool ESP8266::dns_lookup(const char *name, char *ip)
     return done;
 }
 
+bool ESP8266::_wait_send_done(uint32_t timeout)
+{
+    unsigned long int start_time = rtos::Kernel::get_ms_count();
+
+    // The modem answers "busy s..." to any command until it confirms the
+    // last send
+    while (_send_status == SEND_STATUS_PENDING) {
+        if (rtos::Kernel::get_ms_count() - start_time >= timeout) {
+            tr_debug("ESP8266::_wait_send_done(): no confirmation from modem");
+            return false;
+        }
+        if (!_parser.process_oob()) {
+            rtos::ThisThread::sleep_for(1);
+        }
+    }
+    return true;
+}
+
 nsapi_error_t ESP8266::send(int id, const void *data, uint32_t amount)
 {
     nsapi_error_t ret = NSAPI_ERROR_DEVICE_ERROR;
+    unsigned long int bytes_confirmed = 0;
+
     // +CIPSEND supports up to 2048 bytes at a time
     // Data stream can be truncated
     if (amount > 2048 && _sock_i[id].proto == NSAPI_TCP) {
@@ -601,6 +663,20 @@ nsapi_error_t ESP8266::send(int id, const void *data, uint32_t amount)
     set_timeout(ESP8266_SEND_TIMEOUT);
     _busy = false;
     _error = false;
+
+    // Previous send still in progress, not an error
+    if (!_wait_send_done(ESP8266_SEND_TIMEOUT)) {
+        ret = NSAPI_ERROR_WOULD_BLOCK;
+        goto END;
+    }
+    if (_send_status == SEND_STATUS_FAILED && _send_id == id) {
+        _send_status = SEND_STATUS_OK;
+        tr_debug("ESP8266::send(): previous send failed");
+        ret = NSAPI_ERROR_CONNECTION_LOST;
+        goto END;
+    }
+    _send_status = SEND_STATUS_OK;
+
     if (!_parser.send("AT+CIPSEND=%d,%lu", id, amount)) {
         tr_debug("ESP8266::send(): AT+CIPSEND failed");
         goto END;
@@ -612,8 +688,22 @@ nsapi_error_t ESP8266::send(int id, const void *data, uint32_t amount)
         goto END;
     }
 
-    if (_parser.write((char *)data, (int)amount) >= 0 && _parser.recv("SEND OK")) {
+    // The modem confirms having received the data, "SEND OK" follows once
+    // it has been sent out
+    if (_parser.write((char *)data, (int)amount) >= 0
+            && _parser.recv("Recv %lu bytes\n", &bytes_confirmed)
+            && bytes_confirmed == amount) {
+        _send_status = SEND_STATUS_PENDING;
+        _send_id = id;
         ret = NSAPI_ERROR_OK;
+
+        // Datagrams are reported sent or not
+        if (_sock_i[id].proto == NSAPI_UDP) {
+            if (!_wait_send_done(ESP8266_SEND_TIMEOUT) || _send_status == SEND_STATUS_FAILED) {
+                ret = NSAPI_ERROR_DEVICE_ERROR;
+            }
+            _send_status = SEND_STATUS_OK;
+        }
     }
 
 END:
@@ -725,7 +815,7 @@ int32_t ESP8266::_recv_tcp_passive(int id, void *data, uint32_t amount, uint32_t
 
     _process_oob(timeout, true);
 
-    if (_sock_i[id].tcp_data_avbl != 0) {
+    if (_sock_i[id].tcp_data_avbl != 0 && _wait_send_done(timeout)) {
         _sock_i[id].tcp_data = (char*)data;
         _sock_i[id].tcp_data_rcvd = NSAPI_ERROR_WOULD_BLOCK;
         _sock_active_id = id;
@@ -901,6 +991,7 @@ bool ESP8266::close(int id)
     //May take a second try if device is busy
     for (unsigned i = 0; i < 2; i++) {
         _smutex.lock();
+        _wait_send_done(ESP8266_SEND_TIMEOUT);
         if (_parser.send("AT+CIPCLOSE=%d", id)) {
             if (!_parser.recv("OK\n")) {
                 if (_closed) { // UNLINK ERROR
@@ -1049,6 +1140,17 @@ void ESP8266::_oob_tcp_data_hdlr()
     _sock_i[_sock_active_id].tcp_data_rcvd = len;
 }
 
+void ESP8266::_oob_send_ok_received()
+{
+    _send_status = SEND_STATUS_OK;
+}
+
+void ESP8266::_oob_send_fail_received()
+{
+    tr_debug("socket %d send failed", _send_id);
+    _send_status = SEND_STATUS_FAILED;
+}
+
 void ESP8266::_oob_connect_err()
 {
     _fail = false;
@@ -239,9 +239,13 @@ public:
     /**
     * Sends data to an open socket
     *
+    * TCP data is handed to the modem, without waiting for it to be sent
+    * out: the next command waits for that instead, so the caller can
+    * prepare more data meanwhile.
+    *
     * @param id id of socket to send to
     * @param data data to be sent
-    * @param amount amount of data to be sent - max 1024
+    * @param amount amount of data to be sent - max 2048
     * @return NSAPI_ERROR_OK in success, negative error code in failure
     */
     nsapi_error_t send(int id, const void *data, uint32_t amount);
@@ -342,19 +346,28 @@ public:
     nsapi_connection_status_t connection_status() const;
 
     /**
-     * Start board's and ESP8266's UART flow control
+     * Start board's and ESP8266's UART flow control, and switch both
+     * to the esp8266.serial-baudrate baud rate
      *
      * @return true if started
      */
     bool start_uart_hw_flow_ctrl();
 
     /**
-     * Stop board's and ESP8266's UART flow control
+     * Stop board's and ESP8266's UART flow control, and switch both
+     * back to the default baud rate
      *
      * @return true if started
      */
     bool stop_uart_hw_flow_ctrl();
 
+    /**
+     * Set the board's UART back to the settings the ESP8266 starts with,
+     * the default baud rate without flow control. Call it once the
+     * ESP8266 was reset.
+     */
+    void reset_uart_settings();
+
     /*
      * From AT firmware v1.7.0.0 onwards enables TCP passive mode
      */
@@ -405,6 +418,16 @@ private:
     // Wifi scan result handling
     bool _recv_ap(nsapi_wifi_ap_t *ap);
 
+    // Status of the last send, confirmed by the modem after send() returned
+    enum send_status {
+        SEND_STATUS_OK,
+        SEND_STATUS_PENDING,
+        SEND_STATUS_FAILED
+    };
+    send_status _send_status;
+    int _send_id;
+    bool _wait_send_done(uint32_t timeout);
+
     // Socket data buffer
     struct packet {
         struct packet *next;
@@ -438,6 +461,8 @@ private:
     void _oob_busy();
     void _oob_tcp_data_hdlr();
     void _oob_ready();
+    void _oob_send_ok_received();
+    void _oob_send_fail_received();
 
     // OOB state variables
     int _connect_error;
@@ -442,12 +442,18 @@ nsapi_error_t ESP8266Interface::_reset()
         // If you happen to use Pin7 CH_EN as reset pin, not needed otherwise
         // https://www.espressif.com/sites/default/files/documentation/esp8266_hardware_design_guidelines_en.pdf
         wait_ms(2); // Documentation says 200 us should have been enough, but experimentation shows that 1ms was not enough
+        _esp.reset_uart_settings();
         _esp.flush();
         _rst_pin.rst_deassert();
     } else {
         _esp.flush();
         if (!_esp.at_available()) {
-            return NSAPI_ERROR_DEVICE_ERROR;
+            // Modem may have restarted on its own with the default UART settings
+            _esp.reset_uart_settings();
+            _esp.flush();
+            if (!_esp.at_available()) {
+                return NSAPI_ERROR_DEVICE_ERROR;
+            }
         }
         if (!_esp.reset()) {
             return NSAPI_ERROR_DEVICE_ERROR;
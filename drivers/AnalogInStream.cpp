@@ -0,0 +1,88 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "drivers/AnalogInStream.h"
+#include "platform/mbed_error.h"
+#include "platform/mbed_power_mgmt.h"
+
+#if DEVICE_ANALOGIN_STREAM
+
+namespace mbed {
+
+AnalogInStream::AnalogInStream(const PinName *pins, size_t pin_count) :
+    _stream(),
+    _pin_count(pin_count),
+    _running(false)
+{
+    if (analogin_stream_init(&_stream, pins, pin_count) != 0) {
+        MBED_ERROR(MBED_MAKE_ERROR(MBED_MODULE_DRIVER_ANALOG, MBED_ERROR_CODE_INVALID_ARGUMENT), "Pins can't be sampled together");
+    }
+}
+
+AnalogInStream::~AnalogInStream()
+{
+    stop();
+    analogin_stream_free(&_stream);
+}
+
+uint32_t AnalogInStream::set_sample_rate(uint32_t hz)
+{
+    _mutex.lock();
+    uint32_t ret = analogin_stream_set_rate(&_stream, hz);
+    _mutex.unlock();
+    return ret;
+}
+
+int AnalogInStream::start(Span<uint16_t> buffer, Callback<void(Span<uint16_t>)> callback)
+{
+    _mutex.lock();
+    if (_running || buffer.empty() || buffer.size() % (2 * _pin_count) != 0) {
+        _mutex.unlock();
+        return -1;
+    }
+
+    // Timer and DMA stop in deep sleep
+    sleep_manager_lock_deep_sleep();
+    _callback = callback;
+    _running = true;
+    analogin_stream_start(&_stream, buffer.data(), buffer.size(), &AnalogInStream::irq_handler, (uint32_t)this);
+    _mutex.unlock();
+    return 0;
+}
+
+void AnalogInStream::stop()
+{
+    _mutex.lock();
+    if (_running) {
+        analogin_stream_stop(&_stream);
+        _running = false;
+        sleep_manager_unlock_deep_sleep();
+    }
+    _mutex.unlock();
+}
+
+void AnalogInStream::irq_handler(uint32_t id, uint16_t *samples, size_t count)
+{
+    AnalogInStream *handler = (AnalogInStream *)id;
+    if (handler->_callback) {
+        handler->_callback(Span<uint16_t>(samples, count));
+    }
+}
+
+} // namespace mbed
+
+#endif
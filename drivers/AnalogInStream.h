@@ -0,0 +1,116 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_ANALOGIN_STREAM_H
+#define MBED_ANALOGIN_STREAM_H
+
+#include "platform/platform.h"
+
+#if DEVICE_ANALOGIN_STREAM || defined(DOXYGEN_ONLY)
+
+#include "hal/analogin_stream_api.h"
+#include "platform/Callback.h"
+#include "platform/NonCopyable.h"
+#include "platform/PlatformMutex.h"
+#include "platform/Span.h"
+
+namespace mbed {
+/** \addtogroup drivers */
+
+/** Continuous sampling of one or more analog inputs
+ *
+ * The inputs are converted at a fixed rate and the samples are written to
+ * a buffer by DMA. The buffer is used as two halves: while the callback
+ * handles one half, the other one is being filled.
+ *
+ * Samples are interleaved by input, in the order the pins are given, and
+ * scaled like AnalogIn::read_u16().
+ *
+ * @note Synchronization level: Thread safe, the callback is called from interrupt context
+ *
+ * Example:
+ * @code
+ * #include "mbed.h"
+ *
+ * const PinName pins[] = { A0, A1 };
+ * AnalogInStream adc(pins, 2);
+ * uint16_t buffer[2 * 2 * 256];
+ *
+ * void on_samples(Span<uint16_t> samples)
+ * {
+ *     // 256 samples of A0 and A1 each, interleaved
+ * }
+ *
+ * int main() {
+ *     adc.set_sample_rate(100000);
+ *     adc.start(buffer, callback(on_samples));
+ * }
+ * @endcode
+ * @ingroup drivers
+ */
+class AnalogInStream : private NonCopyable<AnalogInStream> {
+
+public:
+
+    /** Create an AnalogInStream, connected to the specified pins
+     *
+     * @param pins      AnalogIn pins to convert, in order
+     * @param pin_count Number of pins
+     */
+    AnalogInStream(const PinName *pins, size_t pin_count);
+
+    virtual ~AnalogInStream();
+
+    /** Set the rate at which all inputs are converted
+     *
+     * @param hz The requested rate
+     * @returns The rate set, nearest to the requested one the hardware allows
+     */
+    uint32_t set_sample_rate(uint32_t hz);
+
+    /** Start sampling into a buffer
+     *
+     * @param buffer   Buffer the samples are written to. Its size must be a
+     *                 multiple of twice the number of pins and it must stay
+     *                 valid until stop() is called.
+     * @param callback Called from interrupt context with each filled half of the buffer
+     * @returns 0 on success, or -1 if already sampling or the buffer size is invalid
+     */
+    int start(Span<uint16_t> buffer, Callback<void(Span<uint16_t>)> callback);
+
+    /** Stop sampling
+     *
+     * The callback is not called after this returns.
+     */
+    void stop();
+
+protected:
+#if !defined(DOXYGEN_ONLY)
+    static void irq_handler(uint32_t id, uint16_t *samples, size_t count);
+
+    analogin_stream_t _stream;
+    Callback<void(Span<uint16_t>)> _callback;
+    size_t _pin_count;
+    bool _running;
+    PlatformMutex _mutex;
+#endif //!defined(DOXYGEN_ONLY)
+};
+
+} // namespace mbed
+
+#endif
+
+#endif
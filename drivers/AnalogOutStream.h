@@ -0,0 +1,113 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_ANALOGOUT_STREAM_H
+#define MBED_ANALOGOUT_STREAM_H
+
+#include "platform/platform.h"
+
+#if DEVICE_ANALOGOUT_STREAM || defined(DOXYGEN_ONLY)
+
+#include "hal/analogout_stream_api.h"
+#include "platform/Callback.h"
+#include "platform/NonCopyable.h"
+#include "platform/PlatformMutex.h"
+#include "platform/Span.h"
+
+namespace mbed {
+/** \addtogroup drivers */
+
+/** Continuous output of a waveform on an analog output
+ *
+ * Samples are written to the DAC at a fixed rate by DMA, scaled like
+ * AnalogOut::write_u16(). The buffer is used as two halves: while one
+ * half is being output, the callback refills the other one.
+ *
+ * @note Synchronization level: Thread safe, the callback is called from interrupt context
+ *
+ * Example:
+ * @code
+ * #include "mbed.h"
+ *
+ * AnalogOutStream dac(A2);
+ * uint16_t buffer[2 * 128];
+ *
+ * void refill(Span<uint16_t> samples)
+ * {
+ *     for (ptrdiff_t i = 0; i < samples.size(); i++) {
+ *         samples[i] = next_sample();
+ *     }
+ * }
+ *
+ * int main() {
+ *     refill(buffer);
+ *     dac.set_sample_rate(48000);
+ *     dac.start(buffer, callback(refill));
+ * }
+ * @endcode
+ * @ingroup drivers
+ */
+class AnalogOutStream : private NonCopyable<AnalogOutStream> {
+
+public:
+
+    /** Create an AnalogOutStream, connected to the specified pin
+     *
+     * @param pin AnalogOut pin to connect to
+     */
+    AnalogOutStream(PinName pin);
+
+    virtual ~AnalogOutStream();
+
+    /** Set the rate at which samples are output
+     *
+     * @param hz The requested rate
+     * @returns The rate set, nearest to the requested one the hardware allows
+     */
+    uint32_t set_sample_rate(uint32_t hz);
+
+    /** Start output from a buffer
+     *
+     * @param buffer   Buffer the samples are taken from. Its size must be even
+     *                 and it must stay valid until stop() is called.
+     * @param callback Called from interrupt context with each half of the
+     *                 buffer once it has been output, to refill it
+     * @returns 0 on success, or -1 if already running or the buffer size is invalid
+     */
+    int start(Span<uint16_t> buffer, Callback<void(Span<uint16_t>)> callback);
+
+    /** Stop output
+     *
+     * The output keeps the last value. The callback is not called after this returns.
+     */
+    void stop();
+
+protected:
+#if !defined(DOXYGEN_ONLY)
+    static void irq_handler(uint32_t id, uint16_t *samples, size_t count);
+
+    analogout_stream_t _stream;
+    Callback<void(Span<uint16_t>)> _callback;
+    bool _running;
+    PlatformMutex _mutex;
+#endif //!defined(DOXYGEN_ONLY)
+};
+
+} // namespace mbed
+
+#endif
+
+#endif
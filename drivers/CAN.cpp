@@ -20,9 +20,13 @@
 
 #include "platform/mbed_power_mgmt.h"
 
+#if MBED_CONF_DRIVERS_CAN_RX_BUFFER_SIZE
+#include "hal/us_ticker_api.h"
+#endif
+
 namespace mbed {
 
-CAN::CAN(PinName rd, PinName td) : _can(), _irq()
+CAN::CAN(PinName rd, PinName td) : _can(), _irq(), _filter_handles(0), _rx_buffering(false)
 {
     // No lock needed in constructor
 
@@ -34,7 +38,7 @@ CAN::CAN(PinName rd, PinName td) : _can(), _irq()
     can_irq_init(&_can, (&CAN::_irq_handler), (uint32_t)this);
 }
 
-CAN::CAN(PinName rd, PinName td, int hz) : _can(), _irq()
+CAN::CAN(PinName rd, PinName td, int hz) : _can(), _irq(), _filter_handles(0), _rx_buffering(false)
 {
     // No lock needed in constructor
 
@@ -51,6 +55,9 @@ CAN::~CAN()
     // No lock needed in destructor
 
     // Detaching interrupts releases the sleep lock if it was locked
+#if MBED_CONF_DRIVERS_CAN_RX_BUFFER_SIZE
+    buffer_rx(false);
+#endif
     for (int irq = 0; irq < IrqCnt; irq++) {
         attach(NULL, (IrqType)irq);
     }
@@ -128,30 +135,106 @@ int CAN::filter(unsigned int id, unsigned int mask, CANFormat format, int handle
     return ret;
 }
 
-void CAN::attach(Callback<void()> func, IrqType type)
+int CAN::add_filter(unsigned int id, unsigned int mask, CANFormat format)
 {
+    int ret = 0;
     lock();
-    if (func) {
-        // lock deep sleep only the first time
-        if (!_irq[(CanIrqType)type]) {
-            sleep_manager_lock_deep_sleep();
+    for (int handle = 1; handle < 32; handle++) {
+        if (_filter_handles & (1UL << handle)) {
+            continue;
         }
-        _irq[(CanIrqType)type] = func;
-        can_irq_set(&_can, (CanIrqType)type, 1);
-    } else {
-        // unlock deep sleep only the first time
-        if (_irq[(CanIrqType)type]) {
-            sleep_manager_unlock_deep_sleep();
+        // Targets refuse handles past their last filter bank
+        ret = can_filter(&_can, id, mask, format, handle);
+        if (ret > 0 && ret < 32) {
+            _filter_handles |= 1UL << ret;
+        }
+        break;
+    }
+    unlock();
+    return ret;
+}
+
+int CAN::remove_filter(int handle)
+{
+    int ret = 0;
+    lock();
+    if (handle > 0 && handle < 32 && (_filter_handles & (1UL << handle))) {
+        ret = can_filter_remove(&_can, handle);
+        if (ret) {
+            _filter_handles &= ~(1UL << handle);
         }
-        _irq[(CanIrqType)type] = NULL;
-        can_irq_set(&_can, (CanIrqType)type, 0);
     }
     unlock();
+    return ret;
+}
+
+#if MBED_CONF_DRIVERS_CAN_RX_BUFFER_SIZE
+void CAN::buffer_rx(bool enable)
+{
+    lock();
+    bool was_needed = _irq_needed(RxIrq);
+    _rx_buffering = enable;
+    _irq_update(RxIrq, was_needed);
+    unlock();
+}
+
+size_t CAN::read(CANMessage *msgs, size_t count, us_timestamp_t *timestamps)
+{
+    size_t read = 0;
+    rx_entry_t entry;
+    while (read < count && _rx_buffer.pop(entry)) {
+        msgs[read] = entry.msg;
+        if (timestamps) {
+            timestamps[read] = entry.timestamp;
+        }
+        read++;
+    }
+    return read;
+}
+#endif
+
+void CAN::attach(Callback<void()> func, IrqType type)
+{
+    lock();
+    bool was_needed = _irq_needed(type);
+    _irq[(CanIrqType)type] = func;
+    _irq_update(type, was_needed);
+    unlock();
+}
+
+bool CAN::_irq_needed(IrqType type)
+{
+    return _irq[(CanIrqType)type] || (type == RxIrq && _rx_buffering);
+}
+
+// Note: Private function with no locking
+void CAN::_irq_update(IrqType type, bool was_needed)
+{
+    bool needed = _irq_needed(type);
+    if (needed == was_needed) {
+        return;
+    }
+    if (needed) {
+        sleep_manager_lock_deep_sleep();
+    } else {
+        sleep_manager_unlock_deep_sleep();
+    }
+    can_irq_set(&_can, (CanIrqType)type, needed ? 1 : 0);
 }
 
 void CAN::_irq_handler(uint32_t id, CanIrqType type)
 {
     CAN *handler = (CAN *)id;
+#if MBED_CONF_DRIVERS_CAN_RX_BUFFER_SIZE
+    if (type == IRQ_RX && handler->_rx_buffering) {
+        // Empty the hardware FIFO, so one interrupt covers a burst of frames
+        rx_entry_t entry;
+        entry.timestamp = ticker_read_us(get_us_ticker_data());
+        while (can_read(&handler->_can, &entry.msg, 0)) {
+            handler->_rx_buffer.push(entry);
+        }
+    }
+#endif
     if (handler->_irq[type]) {
         handler->_irq[type].call();
     }
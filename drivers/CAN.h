@@ -26,6 +26,11 @@
 #include "platform/PlatformMutex.h"
 #include "platform/NonCopyable.h"
 
+#if MBED_CONF_DRIVERS_CAN_RX_BUFFER_SIZE
+#include "hal/ticker_api.h"
+#include "platform/CircularBuffer.h"
+#endif
+
 namespace mbed {
 /** \addtogroup drivers */
 
@@ -215,6 +220,58 @@ public:
      */
     int filter(unsigned int id, unsigned int mask, CANFormat format = CANAny, int handle = 0);
 
+    /** Add a filter in the first filter bank not used by add_filter()
+     *
+     *  Handle 0 is left to filter(), which configures the default filter.
+     *
+     *  @param id the id to filter on
+     *  @param mask the mask applied to the id
+     *  @param format format to filter on (Default CANAny)
+     *
+     *  @returns
+     *    0 if all filter banks are used or filtering is unsupported,
+     *    the filter handle if successful
+     */
+    int add_filter(unsigned int id, unsigned int mask, CANFormat format = CANAny);
+
+    /** Remove a filter added with add_filter()
+     *
+     *  @param handle the filter handle returned by add_filter()
+     *
+     *  @returns
+     *    0 if the handle is invalid or removing filters is unsupported,
+     *    1 if successful
+     */
+    int remove_filter(int handle);
+
+#if MBED_CONF_DRIVERS_CAN_RX_BUFFER_SIZE || defined(DOXYGEN_ONLY)
+    /** Buffer received messages from the RX interrupt
+     *
+     *  While enabled, each RX interrupt reads all the messages the hardware
+     *  holds into a buffer of drivers.can-rx-buffer-size messages, with the
+     *  time they were read, before calling the callback attached to RxIrq.
+     *  Read them with read(CANMessage *, size_t, us_timestamp_t *). When the
+     *  buffer is full, the oldest messages are lost.
+     *
+     *  This function locks the deep sleep while enabled
+     *
+     *  @param enable true to start buffering, false to stop
+     */
+    void buffer_rx(bool enable);
+
+    /** Read buffered messages, without blocking
+     *
+     *  @param msgs Array the messages are copied to, oldest first
+     *  @param count Number of messages the array holds
+     *  @param timestamps Optional array of count entries, receiving the
+     *                    time each message was read, in microseconds of the
+     *                    us ticker
+     *
+     *  @returns number of messages read
+     */
+    size_t read(CANMessage *msgs, size_t count, us_timestamp_t *timestamps = NULL);
+#endif
+
     /**  Detects read errors - Used to detect read overflow errors.
      *
      *  @returns number of read errors
@@ -300,6 +357,24 @@ protected:
     can_t               _can;
     Callback<void()>    _irq[IrqCnt];
     PlatformMutex       _mutex;
+    uint32_t            _filter_handles;    // Handles used by add_filter()
+    bool                _rx_buffering;
+#if MBED_CONF_DRIVERS_CAN_RX_BUFFER_SIZE
+    struct rx_entry_t {
+        CANMessage      msg;
+        us_timestamp_t  timestamp;
+    };
+    CircularBuffer<rx_entry_t, MBED_CONF_DRIVERS_CAN_RX_BUFFER_SIZE> _rx_buffer;
+#endif
+
+private:
+    /** Check if an interrupt has to be enabled */
+    bool _irq_needed(IrqType type);
+
+    /** Enable or disable an interrupt after its users changed, locking deep
+     *  sleep while it is enabled
+     */
+    void _irq_update(IrqType type, bool was_needed);
 #endif
 };
 
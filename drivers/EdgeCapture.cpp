@@ -0,0 +1,115 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "drivers/EdgeCapture.h"
+#include "hal/us_ticker_api.h"
+
+#if DEVICE_INTERRUPTIN
+
+namespace mbed {
+
+EdgeCapture::EdgeCapture(PinName pin, PinMode mode) :
+    _in(pin, mode),
+    _last(0),
+    _debounce_us(0),
+    _dropped(0)
+{
+    core_util_atomic_flag_clear(&_notified);
+}
+
+EdgeCapture::~EdgeCapture()
+{
+    stop();
+}
+
+void EdgeCapture::set_debounce(uint32_t us)
+{
+    core_util_critical_section_enter();
+    _debounce_us = us;
+    core_util_critical_section_exit();
+}
+
+void EdgeCapture::start(Callback<void()> notify, bool rise, bool fall)
+{
+    stop();
+    core_util_critical_section_enter();
+    _notify = notify;
+    _last = 0;
+    core_util_critical_section_exit();
+    if (rise) {
+        _in.rise(callback(this, &EdgeCapture::_on_rise));
+    }
+    if (fall) {
+        _in.fall(callback(this, &EdgeCapture::_on_fall));
+    }
+}
+
+void EdgeCapture::stop()
+{
+    _in.rise(NULL);
+    _in.fall(NULL);
+}
+
+size_t EdgeCapture::read(Edge *edges, size_t count)
+{
+    // Clear first, so edges stored while reading notify again
+    core_util_atomic_flag_clear(&_notified);
+    size_t read = 0;
+    while (read < count && _edges.pop(edges[read])) {
+        read++;
+    }
+    return read;
+}
+
+uint32_t EdgeCapture::dropped() const
+{
+    return _dropped;
+}
+
+void EdgeCapture::_on_rise()
+{
+    _capture(true);
+}
+
+void EdgeCapture::_on_fall()
+{
+    _capture(false);
+}
+
+void EdgeCapture::_capture(bool rising)
+{
+    Edge edge;
+    edge.timestamp = ticker_read_us(get_us_ticker_data());
+    edge.rising = rising;
+
+    if (_debounce_us && _last && edge.timestamp - _last < _debounce_us) {
+        return;
+    }
+    _last = edge.timestamp;
+
+    if (!_edges.push(edge)) {
+        _dropped++;
+        return;
+    }
+    if (_notify && !core_util_atomic_flag_test_and_set(&_notified)) {
+        _notify();
+    }
+}
+
+} // namespace mbed
+
+#endif
@@ -0,0 +1,142 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_EDGE_CAPTURE_H
+#define MBED_EDGE_CAPTURE_H
+
+#include "platform/platform.h"
+
+#if DEVICE_INTERRUPTIN || defined(DOXYGEN_ONLY)
+
+#include "drivers/InterruptIn.h"
+#include "hal/ticker_api.h"
+#include "platform/Callback.h"
+#include "platform/mbed_critical.h"
+#include "platform/NonCopyable.h"
+#include "platform/SPSCRingBuffer.h"
+
+namespace mbed {
+/** \addtogroup drivers */
+
+/** Timestamped capture of the edges of a digital input
+ *
+ * Each edge is timestamped in the interrupt handler and stored in a
+ * lock-free buffer of drivers.edge-capture-buffer-size edges, to be read in
+ * batches. Instead of a callback per edge, a notification is sent once when
+ * the buffer stops being empty, and again after each read(). Passing an
+ * EventQueue event as the notification, for example
+ * mbed_event_queue()->event(handler), handles batches in a thread.
+ *
+ * Edges closer than the debounce time to the previous stored edge are
+ * ignored.
+ *
+ * @note Synchronization level: Interrupt safe for one reader
+ *
+ * Example:
+ * @code
+ * #include "mbed.h"
+ *
+ * EdgeCapture encoder(D2);
+ *
+ * void on_edges()
+ * {
+ *     EdgeCapture::Edge edges[16];
+ *     size_t count;
+ *     while ((count = encoder.read(edges, 16)) > 0) {
+ *         // edges[i].timestamp, edges[i].rising
+ *     }
+ * }
+ *
+ * int main() {
+ *     encoder.set_debounce(50);
+ *     encoder.start(mbed_event_queue()->event(on_edges));
+ *     mbed_event_queue()->dispatch_forever();
+ * }
+ * @endcode
+ * @ingroup drivers
+ */
+class EdgeCapture : private NonCopyable<EdgeCapture> {
+
+public:
+    /** A captured edge */
+    struct Edge {
+        /** Time of the edge, in microseconds of the us ticker */
+        us_timestamp_t timestamp;
+        /** true for a rising edge, false for a falling one */
+        bool rising;
+    };
+
+    /** Create an EdgeCapture connected to the specified pin
+     *
+     *  @param pin InterruptIn pin to connect to
+     *  @param mode Desired Pin mode configuration
+     */
+    EdgeCapture(PinName pin, PinMode mode = PullDefault);
+
+    virtual ~EdgeCapture();
+
+    /** Ignore edges closer than a time to the previous stored edge
+     *
+     *  @param us Debounce time in microseconds, 0 to store all edges
+     */
+    void set_debounce(uint32_t us);
+
+    /** Start capturing edges
+     *
+     *  @param notify Called from interrupt context when edges are available, or NULL
+     *  @param rise Capture rising edges
+     *  @param fall Capture falling edges
+     */
+    void start(Callback<void()> notify = NULL, bool rise = true, bool fall = true);
+
+    /** Stop capturing edges, the buffered ones can still be read */
+    void stop();
+
+    /** Read captured edges, without blocking
+     *
+     *  @param edges Array the edges are copied to, oldest first
+     *  @param count Number of edges the array holds
+     *  @returns number of edges read
+     */
+    size_t read(Edge *edges, size_t count);
+
+    /** Number of edges lost because the buffer was full
+     *
+     *  @returns number of edges lost since the object was created
+     */
+    uint32_t dropped() const;
+
+#if !defined(DOXYGEN_ONLY)
+protected:
+    void _on_rise();
+    void _on_fall();
+    void _capture(bool rising);
+
+    InterruptIn _in;
+    SPSCRingBuffer<Edge, MBED_CONF_DRIVERS_EDGE_CAPTURE_BUFFER_SIZE> _edges;
+    Callback<void()> _notify;
+    core_util_atomic_flag _notified;
+    us_timestamp_t _last;
+    uint32_t _debounce_us;
+    volatile uint32_t _dropped;
+#endif
+};
+
+} // namespace mbed
+
+#endif
+
+#endif
@@ -28,6 +28,11 @@
 #include "platform/ScopedRamExecutionLock.h"
 #include "platform/ScopedRomWriteLock.h"
 
+#if DEVICE_FLASH_ASYNCH
+#include "platform/mbed_mpu_mgmt.h"
+#include "platform/mbed_power_mgmt.h"
+#endif
+
 
 #if DEVICE_FLASH
 
@@ -36,6 +41,9 @@ namespace mbed {
 const unsigned int num_write_retries = 16;
 
 SingletonPtr<PlatformMutex> FlashIAP::_mutex;
+#if DEVICE_FLASH_ASYNCH
+volatile bool FlashIAP::_async_busy = false;
+#endif
 
 static inline bool is_aligned(uint32_t number, uint32_t alignment)
 {
@@ -121,6 +129,11 @@ int FlashIAP::program(const void *buffer, uint32_t addr, uint32_t size)
 
     int ret = 0;
     _mutex->lock();
+#if DEVICE_FLASH_ASYNCH
+    if (_async_busy) {
+        ret = -1;
+    }
+#endif
     while (size && !ret) {
         uint32_t current_sector_size = flash_get_sector_size(&_flash, addr);
         bool unaligned_src = (((size_t) buf / sizeof(uint32_t) * sizeof(uint32_t)) != (size_t) buf);
@@ -195,6 +208,11 @@ int FlashIAP::erase(uint32_t addr, uint32_t size)
 
     int32_t ret = 0;
     _mutex->lock();
+#if DEVICE_FLASH_ASYNCH
+    if (_async_busy) {
+        ret = -1;
+    }
+#endif
     while (size && !ret) {
         // Few boards may fail the erase actions due to HW limitations (like critical drivers that
         // disable flash operations). Just retry a few times until success.
@@ -216,6 +234,133 @@ int FlashIAP::erase(uint32_t addr, uint32_t size)
     return ret;
 }
 
+#if DEVICE_FLASH_ASYNCH
+
+int FlashIAP::program(const void *buffer, uint32_t addr, uint32_t size, Callback<void(int)> callback)
+{
+    uint32_t page_size = get_page_size();
+    uint32_t flash_size = flash_get_size(&_flash);
+    uint32_t flash_start_addr = flash_get_start_address(&_flash);
+
+    // Without the page buffer of the blocking program(), the source must
+    // be word aligned and whole pages
+    if (!is_aligned(addr, page_size) || !is_aligned(size, page_size) || (!buffer) ||
+            !is_aligned((size_t) buffer, sizeof(uint32_t)) || !size ||
+            ((addr + size) > (flash_start_addr + flash_size))) {
+        return -1;
+    }
+
+    int ret = -1;
+    _mutex->lock();
+    if (!_async_busy) {
+        _async_busy = true;
+        _async_callback = callback;
+        _async_buf = (const uint8_t *) buffer;
+        _async_addr = addr;
+        _async_size = size;
+        // Released in _async_done()
+        mbed_mpu_manager_lock_ram_execution();
+        mbed_mpu_manager_lock_rom_write();
+        sleep_manager_lock_deep_sleep();
+        ret = _async_step();
+        if (ret) {
+            ret = -1;
+            _async_callback = NULL;
+            _async_done(ret);
+        }
+    }
+    _mutex->unlock();
+    return ret;
+}
+
+int FlashIAP::erase(uint32_t addr, uint32_t size, Callback<void(int)> callback)
+{
+    uint32_t flash_size = flash_get_size(&_flash);
+    uint32_t flash_start_addr = flash_get_start_address(&_flash);
+    uint32_t flash_end_addr = flash_start_addr + flash_size;
+    uint32_t erase_end_addr = addr + size;
+
+    if (!size || erase_end_addr > flash_end_addr) {
+        return -1;
+    } else if (erase_end_addr < flash_end_addr) {
+        uint32_t following_sector_size = flash_get_sector_size(&_flash, erase_end_addr);
+        if (!is_aligned(erase_end_addr, following_sector_size)) {
+            return -1;
+        }
+    }
+
+    int ret = -1;
+    _mutex->lock();
+    if (!_async_busy) {
+        _async_busy = true;
+        _async_callback = callback;
+        _async_buf = NULL;
+        _async_addr = addr;
+        _async_size = size;
+        // Released in _async_done()
+        mbed_mpu_manager_lock_ram_execution();
+        mbed_mpu_manager_lock_rom_write();
+        sleep_manager_lock_deep_sleep();
+        ret = _async_step();
+        if (ret) {
+            ret = -1;
+            _async_callback = NULL;
+            _async_done(ret);
+        }
+    }
+    _mutex->unlock();
+    return ret;
+}
+
+int32_t FlashIAP::_async_step()
+{
+    uint32_t current_sector_size = flash_get_sector_size(&_flash, _async_addr);
+    if (!_async_buf) {
+        _async_chunk = current_sector_size;
+        return flash_erase_sector_asynch(&_flash, _async_addr, &FlashIAP::_async_handler, (uint32_t) this);
+    }
+
+    // Program up to the end of the sector, as the blocking program() does
+    _async_chunk = std::min(current_sector_size - (_async_addr % current_sector_size), _async_size);
+    return flash_program_page_asynch(&_flash, _async_addr, _async_buf, _async_chunk,
+                                     &FlashIAP::_async_handler, (uint32_t) this);
+}
+
+void FlashIAP::_async_done(int status)
+{
+    Callback<void(int)> callback = _async_callback;
+    sleep_manager_unlock_deep_sleep();
+    mbed_mpu_manager_unlock_rom_write();
+    mbed_mpu_manager_unlock_ram_execution();
+    _async_busy = false;
+    if (callback) {
+        callback(status);
+    }
+}
+
+void FlashIAP::_async_handler(uint32_t id, int32_t status)
+{
+    FlashIAP *flash = (FlashIAP *) id;
+    if (status) {
+        flash->_async_done(-1);
+        return;
+    }
+
+    flash->_async_size -= std::min(flash->_async_chunk, flash->_async_size);
+    flash->_async_addr += flash->_async_chunk;
+    if (flash->_async_buf) {
+        flash->_async_buf += flash->_async_chunk;
+    }
+
+    if (!flash->_async_size) {
+        flash->_async_done(0);
+    } else if (flash->_async_step()) {
+        flash->_async_done(-1);
+    }
+}
+
+#endif
+
 uint32_t FlashIAP::get_page_size() const
 {
     return flash_get_page_size(&_flash);
@@ -30,6 +30,10 @@
 #include "platform/NonCopyable.h"
 #include <algorithm>
 
+#if DEVICE_FLASH_ASYNCH
+#include "platform/Callback.h"
+#endif
+
 // Export ROM end address
 #if defined(TOOLCHAIN_GCC_ARM)
 extern uint32_t __etext;
@@ -106,6 +110,36 @@ public:
      */
     int erase(uint32_t addr, uint32_t size);
 
+#if DEVICE_FLASH_ASYNCH
+    /** Program data to pages, completing in the background
+     *
+     *  Returns once programming of the first sector has started. The
+     *  following sectors are started from the flash completion interrupt, so
+     *  code running from RAM, or from another flash bank, keeps running.
+     *  Until the callback is called, other program and erase calls fail.
+     *  Deep sleep is locked while programming.
+     *
+     *  @param buffer   Buffer of data to be written, aligned to 4 bytes and
+     *                  valid until the callback is called
+     *  @param addr     Address of a page to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of the page size
+     *  @param callback Called from interrupt context with 0 on success or -1 on failure
+     *  @return         0 if programming has started, negative error code on failure
+     */
+    int program(const void *buffer, uint32_t addr, uint32_t size, Callback<void(int)> callback);
+
+    /** Erase sectors, completing in the background
+     *
+     *  Same behavior as the asynchronous program().
+     *
+     *  @param addr     Address of a sector to begin erasing, must be a multiple of the sector size
+     *  @param size     Size to erase in bytes, must be a multiple of the sector size
+     *  @param callback Called from interrupt context with 0 on success or -1 on failure
+     *  @return         0 if erasing has started, negative error code on failure
+     */
+    int erase(uint32_t addr, uint32_t size, Callback<void(int)> callback);
+#endif
+
     /** Get the sector size at the defined address
      *
      *  Sector size might differ at address ranges.
@@ -156,6 +190,22 @@ private:
     flash_t _flash;
     uint8_t *_page_buf;
     static SingletonPtr<PlatformMutex> _mutex;
+
+#if DEVICE_FLASH_ASYNCH
+    /* Start the next step of the asynchronous operation */
+    int32_t _async_step();
+    /* End the asynchronous operation and call the callback */
+    void _async_done(int status);
+    static void _async_handler(uint32_t id, int32_t status);
+
+    /* Set while an asynchronous operation is ongoing, on any object */
+    static volatile bool _async_busy;
+    Callback<void(int)> _async_callback;
+    const uint8_t *_async_buf;
+    uint32_t _async_addr;
+    uint32_t _async_size;
+    uint32_t _async_chunk;
+#endif
 #endif
 };
 
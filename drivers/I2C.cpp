@@ -22,6 +22,7 @@
 #if DEVICE_I2C
 
 #if DEVICE_I2C_ASYNCH
+#include "platform/mbed_critical.h"
 #include "platform/mbed_power_mgmt.h"
 #endif
 
@@ -30,9 +31,13 @@ namespace mbed {
 I2C *I2C::_owner = NULL;
 SingletonPtr<PlatformMutex> I2C::_mutex;
 
+#if DEVICE_I2C_ASYNCH && MBED_CONF_DRIVERS_I2C_TRANSACTION_QUEUE_SIZE
+CircularBuffer<I2C::transfer_t, MBED_CONF_DRIVERS_I2C_TRANSACTION_QUEUE_SIZE> I2C::_transfer_queue;
+#endif
+
 I2C::I2C(PinName sda, PinName scl) :
 #if DEVICE_I2C_ASYNCH
-    _irq(this), _usage(DMA_USAGE_NEVER), _deep_sleep_locked(false),
+    _irq(this), _usage(DMA_USAGE_NEVER), _deep_sleep_locked(false), _reg(0),
 #endif
     _i2c(), _hz(100000)
 {
@@ -63,11 +68,17 @@ void I2C::frequency(int hz)
 void I2C::aquire()
 {
     lock();
+    _acquire();
+    unlock();
+}
+
+// Note: Private function with no locking
+void I2C::_acquire()
+{
     if (_owner != this) {
         i2c_frequency(&_i2c, _hz);
         _owner = this;
     }
-    unlock();
 }
 
 // write - Master Transmitter Mode
@@ -104,6 +115,18 @@ int I2C::read(int address, char *data, int length, bool repeated)
     return length != read;
 }
 
+int I2C::read_registers(int address, uint8_t reg, char *data, int length)
+{
+    lock();
+    char reg_byte = reg;
+    int ret = write(address, &reg_byte, 1, true);
+    if (ret == 0) {
+        ret = read(address, data, length);
+    }
+    unlock();
+    return ret;
+}
+
 int I2C::read(int ack)
 {
     lock();
@@ -191,39 +214,127 @@ int I2C::recover(PinName sda, PinName scl)
 
 int I2C::transfer(int address, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length, const event_callback_t &callback, int event, bool repeated)
 {
+    transfer_t t;
+    t.obj = this;
+    t.address = address;
+    t.tx_buffer = tx_buffer;
+    t.tx_length = tx_length;
+    t.rx_buffer = rx_buffer;
+    t.rx_length = rx_length;
+    t.callback = callback;
+    t.event = event;
+    t.repeated = repeated;
+    t.reg = -1;
+    return _transfer(t);
+}
+
+int I2C::read_registers(int address, uint8_t reg, char *rx_buffer, int rx_length, const event_callback_t &callback, int event)
+{
+    transfer_t t;
+    t.obj = this;
+    t.address = address;
+    t.tx_buffer = NULL;
+    t.tx_length = 1;
+    t.rx_buffer = rx_buffer;
+    t.rx_length = rx_length;
+    t.callback = callback;
+    t.event = event;
+    t.repeated = false;
+    t.reg = reg;
+    return _transfer(t);
+}
+
+int I2C::_transfer(const transfer_t &t)
+{
+    int ret = 0;
     lock();
-    if (i2c_active(&_i2c)) {
-        unlock();
-        return -1; // transaction ongoing
+    // The completion interrupt starts queued transfers, keep it out while
+    // deciding whether to queue
+    core_util_critical_section_enter();
+    if (!_bus_active()) {
+        _start_transfer(t);
+    } else {
+#if MBED_CONF_DRIVERS_I2C_TRANSACTION_QUEUE_SIZE
+        if (_transfer_queue.full()) {
+            ret = -1;
+        } else {
+            _transfer_queue.push(t);
+        }
+#else
+        ret = -1; // transaction ongoing
+#endif
     }
+    core_util_critical_section_exit();
+    unlock();
+    return ret;
+}
+
+void I2C::_start_transfer(const transfer_t &t)
+{
     lock_deep_sleep();
-    aquire();
+    _acquire();
 
-    _callback = callback;
-    int stop = (repeated) ? 0 : 1;
+    const char *tx_buffer = t.tx_buffer;
+    if (t.reg >= 0) {
+        _reg = t.reg;
+        tx_buffer = &_reg;
+    }
+    _callback = t.callback;
+    int stop = (t.repeated) ? 0 : 1;
     _irq.callback(&I2C::irq_handler_asynch);
-    i2c_transfer_asynch(&_i2c, (void *)tx_buffer, tx_length, (void *)rx_buffer, rx_length, address, stop, _irq.entry(), event, _usage);
-    unlock();
-    return 0;
+    i2c_transfer_asynch(&_i2c, (void *)tx_buffer, t.tx_length, (void *)t.rx_buffer, t.rx_length, t.address, stop, _irq.entry(), t.event, _usage);
+}
+
+// All I2C objects share the transfer queue, so a transfer started by another
+// instance on the bus keeps this one queued too
+bool I2C::_bus_active()
+{
+    return i2c_active(&_i2c) || (_owner != NULL && _owner != this && i2c_active(&_owner->_i2c));
+}
+
+#if MBED_CONF_DRIVERS_I2C_TRANSACTION_QUEUE_SIZE
+void I2C::_dequeue_transfer()
+{
+    transfer_t t;
+    if (_transfer_queue.pop(t)) {
+        t.obj->_start_transfer(t);
+    }
 }
+#endif
 
 void I2C::abort_transfer(void)
 {
     lock();
+    core_util_critical_section_enter();
     i2c_abort_asynch(&_i2c);
     unlock_deep_sleep();
+#if MBED_CONF_DRIVERS_I2C_TRANSACTION_QUEUE_SIZE
+    if (!_bus_active()) {
+        _dequeue_transfer();
+    }
+#endif
+    core_util_critical_section_exit();
     unlock();
 }
 
 void I2C::irq_handler_asynch(void)
 {
     int event = i2c_irq_handler_asynch(&_i2c);
-    if (_callback && event) {
-        _callback.call(event);
+    if (!event) {
+        return;
     }
 
-    if (event) {
-        unlock_deep_sleep();
+    unlock_deep_sleep();
+
+    // The next transfer may be ours and replace the callback
+    event_callback_t callback = _callback;
+#if MBED_CONF_DRIVERS_I2C_TRANSACTION_QUEUE_SIZE
+    // Start the next transfer before running the callback, so the bus
+    // doesn't idle while it executes
+    _dequeue_transfer();
+#endif
+    if (callback) {
+        callback.call(event);
     }
 }
 
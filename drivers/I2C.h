@@ -31,6 +31,9 @@
 #include "platform/CThunk.h"
 #include "hal/dma_api.h"
 #include "platform/FunctionPointer.h"
+#if MBED_CONF_DRIVERS_I2C_TRANSACTION_QUEUE_SIZE
+#include "platform/CircularBuffer.h"
+#endif
 #endif
 
 namespace mbed {
@@ -154,6 +157,22 @@ public:
      */
     int write(int data);
 
+    /** Read consecutive registers of an I2C slave
+     *
+     * Writes the register address, then reads with a repeated start,
+     * holding the bus for the whole burst.
+     *
+     *  @param address 8-bit I2C slave address
+     *  @param reg First register to read
+     *  @param data Pointer to the byte-array to read data in to
+     *  @param length Number of bytes to read
+     *
+     *  @returns
+     *       0 on success (ack),
+     *       nonzero on failure (nack)
+     */
+    int read_registers(int address, uint8_t reg, char *data, int length);
+
     /** Creates a start condition on the I2C bus
      */
     void start(void);
@@ -181,6 +200,12 @@ public:
      *
      * This function locks the deep sleep until any event has occurred
      *
+     * If the bus is busy with a transfer of any I2C instance, the transfer is
+     * queued and started from interrupt context when the bus becomes free,
+     * so drivers sharing a bus don't need to retry. To handle the completion
+     * in a thread, pass a callback posting to an EventQueue, for example
+     * mbed_event_queue()->event(handler).
+     *
      * @param address   8/10 bit I2C slave address
      * @param tx_buffer The TX buffer with data to be transferred
      * @param tx_length The length of TX buffer in bytes
@@ -191,10 +216,28 @@ public:
      * @param repeated Repeated start, true - do not send stop at end
      *        default value is false.
      *
-     * @returns Zero if the transfer has started, or -1 if I2C peripheral is busy
+     * @returns Zero if the transfer has started or was queued, or -1 if
+     *          the I2C peripheral is busy and the queue is full
      */
     int transfer(int address, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length, const event_callback_t &callback, int event = I2C_EVENT_TRANSFER_COMPLETE, bool repeated = false);
 
+    /** Start nonblocking read of consecutive registers.
+     *
+     * Like transfer() with the register address as the only byte to write,
+     * the address doesn't have to stay valid after this returns.
+     *
+     * @param address   8/10 bit I2C slave address
+     * @param reg       First register to read
+     * @param rx_buffer The RX buffer, which is used for received data
+     * @param rx_length The length of RX buffer in bytes
+     * @param callback  The event callback function
+     * @param event     The logical OR of events to modify
+     *
+     * @returns Zero if the transfer has started or was queued, or -1 if
+     *          the I2C peripheral is busy and the queue is full
+     */
+    int read_registers(int address, uint8_t reg, char *rx_buffer, int rx_length, const event_callback_t &callback, int event = I2C_EVENT_TRANSFER_COMPLETE);
+
     /** Abort the ongoing I2C transfer
      */
     void abort_transfer();
@@ -212,12 +255,49 @@ protected:
     CThunk<I2C> _irq;
     DMAUsage _usage;
     bool _deep_sleep_locked;
+    /* Register address written by the ongoing read_registers() transfer */
+    char _reg;
+
+private:
+    /* A transfer waiting for the bus */
+    struct transfer_t {
+        I2C *obj;
+        int address;
+        const char *tx_buffer;
+        int tx_length;
+        char *rx_buffer;
+        int rx_length;
+        event_callback_t callback;
+        int event;
+        bool repeated;
+        /* Register to write before reading, or -1 to write tx_buffer */
+        int reg;
+    };
+
+    /** Check if a transfer started by any I2C object is ongoing */
+    bool _bus_active();
+
+    /** Start the transfer or put it on the queue, if the bus is busy */
+    int _transfer(const transfer_t &t);
+
+    /** Configure the peripheral and start a transfer, without locking */
+    void _start_transfer(const transfer_t &t);
+
+#if MBED_CONF_DRIVERS_I2C_TRANSACTION_QUEUE_SIZE
+    /** Start the next queued transfer, if there is one */
+    static void _dequeue_transfer();
+
+    /* Transfers waiting for the bus */
+    static CircularBuffer<transfer_t, MBED_CONF_DRIVERS_I2C_TRANSACTION_QUEUE_SIZE> _transfer_queue;
+#endif
 #endif
 #endif
 
 #if !defined(DOXYGEN_ONLY)
 protected:
     void aquire();
+    /* aquire() without locking */
+    void _acquire();
 
     i2c_t _i2c;
     static I2C  *_owner;
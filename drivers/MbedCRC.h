@@ -39,15 +39,94 @@ but we check for ( width < 8) before performing shift, so it should not be an is
 #pragma diag_suppress=Pe062  // Shift count is negative
 #endif
 
+#if !defined(MBED_CONF_DRIVERS_CRC_TABLE_SLICES)
+#define MBED_CONF_DRIVERS_CRC_TABLE_SLICES 1
+#endif
+
 namespace mbed {
+
+#if __cplusplus >= 201103L
+namespace internal {
+/* Type of the table entries of a CRC width */
+template<int size>
+struct crc_table_entry;
+template<>
+struct crc_table_entry<1> {
+    typedef uint8_t type;
+};
+template<>
+struct crc_table_entry<2> {
+    typedef uint16_t type;
+};
+template<>
+struct crc_table_entry<4> {
+    typedef uint32_t type;
+};
+
+/* CRC table generated at compile time. Entry i of a slice is the CRC
+ * register holding i in its top byte, shifted by 8 bits plus 8 bits for
+ * each slice, so slice n stands for the byte n bytes ahead of the last one.
+ * Registers of CRCs narrower than 8 bits are kept in the top bits of a byte,
+ * like the ROM table of POLY_7BIT_SD.
+ */
+template<uint32_t polynomial, uint8_t width, int slice>
+struct crc_table {
+    typedef typename crc_table_entry<(width <= 8 ? 1 : (width <= 16 ? 2 : 4))>::type entry_t;
+
+    static constexpr uint8_t reg_width = width < 8 ? 8 : width;
+    static constexpr uint32_t reg_polynomial = width < 8 ? polynomial << (8 - width) : polynomial;
+    static constexpr uint32_t reg_mask = (uint32_t)((1ull << reg_width) - 1);
+
+    static constexpr uint32_t shift(uint32_t reg, int bits)
+    {
+        return bits == 0 ? reg :
+               shift(((reg & (1ul << (reg_width - 1))) ? (reg << 1) ^ reg_polynomial : reg << 1) & reg_mask, bits - 1);
+    }
+
+    static constexpr entry_t entry(uint32_t index)
+    {
+        return shift(index << (reg_width - 8), 8 + 8 * slice);
+    }
+
+    static const entry_t table[MBED_CRC_TABLE_SIZE];
+};
+
+#define MBED_CRC_TABLE_ENTRIES_4(i)   entry(i), entry(i + 1), entry(i + 2), entry(i + 3)
+#define MBED_CRC_TABLE_ENTRIES_16(i)  MBED_CRC_TABLE_ENTRIES_4(i), MBED_CRC_TABLE_ENTRIES_4(i + 4), \
+                                      MBED_CRC_TABLE_ENTRIES_4(i + 8), MBED_CRC_TABLE_ENTRIES_4(i + 12)
+#define MBED_CRC_TABLE_ENTRIES_64(i)  MBED_CRC_TABLE_ENTRIES_16(i), MBED_CRC_TABLE_ENTRIES_16(i + 16), \
+                                      MBED_CRC_TABLE_ENTRIES_16(i + 32), MBED_CRC_TABLE_ENTRIES_16(i + 48)
+
+template<uint32_t polynomial, uint8_t width, int slice>
+const typename crc_table<polynomial, width, slice>::entry_t crc_table<polynomial, width, slice>::table[MBED_CRC_TABLE_SIZE] = {
+    MBED_CRC_TABLE_ENTRIES_64(0), MBED_CRC_TABLE_ENTRIES_64(64),
+    MBED_CRC_TABLE_ENTRIES_64(128), MBED_CRC_TABLE_ENTRIES_64(192)
+};
+
+#undef MBED_CRC_TABLE_ENTRIES_4
+#undef MBED_CRC_TABLE_ENTRIES_16
+#undef MBED_CRC_TABLE_ENTRIES_64
+
+/* Selects the sliced CRC computation, used by 32-bit CRCs */
+template<bool sliced>
+struct crc_sliced {
+};
+} // namespace internal
+#endif
+
 /** \addtogroup drivers */
 /** @{*/
 
 /** CRC object provides CRC generation through hardware/software
  *
  *  ROM polynomial tables for supported polynomials (:: crc_polynomial_t) will be used for
- *  software CRC computation, if ROM tables are not available then CRC is computed runtime
- *  bit by bit for all data input.
+ *  software CRC computation. Tables for other polynomials are generated at compile time
+ *  when building with C++11 or later, otherwise the CRC is computed runtime bit by bit
+ *  for all data input.
+ *
+ *  32-bit CRCs other than POLY_32BIT_REV_ANSI process MBED_CONF_DRIVERS_CRC_TABLE_SLICES
+ *  bytes at a time (slice-by-4 or slice-by-8) when it is set to 4 or 8 and building with
+ *  C++11 or later, at the cost of 1KB of ROM for each additional table.
  *  @note Synchronization level: Thread safe
  *
  *  @tparam  polynomial CRC polynomial value in hex
@@ -236,12 +315,7 @@ public:
         if (_mode == HARDWARE) {
             lock();
             crc_mbed_config_t config;
-            config.polynomial  = polynomial;
-            config.width       = width;
-            config.initial_xor = _initial_value;
-            config.final_xor   = _final_xor;
-            config.reflect_in  = _reflect_data;
-            config.reflect_out = _reflect_remainder;
+            get_hal_config(&config);
 
             hal_crc_compute_partial_start(&config);
         }
@@ -393,15 +467,11 @@ private:
     uint32_t reflect_bytes(uint32_t data) const
     {
         if (_reflect_data) {
-            uint32_t reflection = 0x0;
-
-            for (uint8_t bit = 0; bit < 8; ++bit) {
-                if (data & 0x01) {
-                    reflection |= (1 << (7 - bit));
-                }
-                data = (data >> 1);
-            }
-            return (reflection);
+            // Swap the nibbles, then the bit pairs, then the bits
+            data = ((data & 0xF0) >> 4) | ((data & 0x0F) << 4);
+            data = ((data & 0xCC) >> 2) | ((data & 0x33) << 2);
+            data = ((data & 0xAA) >> 1) | ((data & 0x55) << 1);
+            return data;
         } else {
             return data;
         }
@@ -486,7 +556,12 @@ private:
                     p_crc = (p_crc >> 4) ^ crc_table[(p_crc ^ (data[i] >> 4)) & 0xf];
                 }
             } else {
-                for (crc_data_size_t byte = 0; byte < size; byte++) {
+#if __cplusplus >= 201103L && MBED_CONF_DRIVERS_CRC_TABLE_SLICES > 1
+                crc_data_size_t byte = slice_compute_partial(data, size, &p_crc, internal::crc_sliced < width == 32 && polynomial != POLY_32BIT_REV_ANSI > ());
+#else
+                crc_data_size_t byte = 0;
+#endif
+                for (; byte < size; byte++) {
                     data_byte = reflect_bytes(data[byte]) ^ (p_crc >> (width - 8));
                     p_crc = crc_table[data_byte] ^ (p_crc << 8);
                 }
@@ -496,6 +571,100 @@ private:
         return 0;
     }
 
+#if __cplusplus >= 201103L && MBED_CONF_DRIVERS_CRC_TABLE_SLICES > 1
+    /** CRC computation of the whole slices of the data, for CRCs not sliced.
+     *
+     * @return  0, the number of bytes processed
+     */
+    crc_data_size_t slice_compute_partial(const uint8_t *data, crc_data_size_t size, uint32_t *crc,
+                                          internal::crc_sliced<false>) const
+    {
+        return 0;
+    }
+
+    /** CRC computation of the whole slices of the data using a table per byte of a slice.
+     *
+     * @param  data  data buffer
+     * @param  size  size of the data
+     * @param  crc  CRC register, updated with the bytes processed
+     * @return  number of bytes processed, a multiple of the number of slices
+     */
+    crc_data_size_t slice_compute_partial(const uint8_t *data, crc_data_size_t size, uint32_t *crc,
+                                          internal::crc_sliced<true>) const
+    {
+        MBED_STATIC_ASSERT(MBED_CONF_DRIVERS_CRC_TABLE_SLICES == 4 || MBED_CONF_DRIVERS_CRC_TABLE_SLICES == 8,
+                           "CRC table slices must be 1, 4 or 8");
+        const int slices = MBED_CONF_DRIVERS_CRC_TABLE_SLICES;
+        const uint32_t *const tables[slices] = {
+            _crc_table,
+            internal::crc_table<polynomial, width, 1>::table,
+            internal::crc_table<polynomial, width, 2>::table,
+            internal::crc_table<polynomial, width, 3>::table,
+#if MBED_CONF_DRIVERS_CRC_TABLE_SLICES == 8
+            internal::crc_table<polynomial, width, 4>::table,
+            internal::crc_table<polynomial, width, 5>::table,
+            internal::crc_table<polynomial, width, 6>::table,
+            internal::crc_table<polynomial, width, 7>::table,
+#endif
+        };
+        uint32_t p_crc = *crc;
+        crc_data_size_t byte = 0;
+
+        // The first 4 bytes are combined with the register, and each byte is
+        // looked up in the table of how many bytes it is ahead of the last one
+        for (; byte + slices <= size; byte += slices) {
+            uint32_t next_crc = 0;
+            for (int i = 0; i < slices; i++) {
+                uint32_t index = reflect_bytes(data[byte + i]);
+                if (i < 4) {
+                    index ^= (p_crc >> (24 - 8 * i)) & 0xFF;
+                }
+                next_crc ^= tables[slices - 1 - i][index];
+            }
+            p_crc = next_crc;
+        }
+
+        *crc = p_crc;
+        return byte;
+    }
+#endif
+
+#if DEVICE_CRC
+    /** Get the configuration of the CRC hardware computing this CRC.
+     *
+     *  POLY_32BIT_REV_ANSI is the POLY_32BIT_ANSI CRC computed LSB first, with
+     *  the remainder kept reflected, so it is computed by the hardware as the
+     *  reflected POLY_32BIT_ANSI CRC starting from the reflected initial value.
+     *
+     * @param  config  Filled with the configuration
+     */
+    void get_hal_config(crc_mbed_config_t *config) const
+    {
+        if (POLY_32BIT_REV_ANSI == polynomial) {
+            uint32_t initial_value = 0;
+            for (uint8_t bit = 0; bit < 32; ++bit) {
+                if (_initial_value & (1ul << bit)) {
+                    initial_value |= 1ul << (31 - bit);
+                }
+            }
+            config->polynomial  = POLY_32BIT_ANSI;
+            config->width       = 32;
+            config->initial_xor = initial_value;
+            config->final_xor   = _final_xor;
+            config->reflect_in  = true;
+            config->reflect_out = true;
+            return;
+        }
+
+        config->polynomial  = polynomial;
+        config->width       = width;
+        config->initial_xor = _initial_value;
+        config->final_xor   = _final_xor;
+        config->reflect_in  = _reflect_data;
+        config->reflect_out = _reflect_remainder;
+    }
+#endif
+
     /** Constructor init called from all specialized cases of constructor.
      *  Note: All constructor common code should be in this function.
      */
@@ -504,18 +673,8 @@ private:
         MBED_STATIC_ASSERT(width <= 32, "Max 32-bit CRC supported");
 
 #if DEVICE_CRC
-        if (POLY_32BIT_REV_ANSI == polynomial) {
-            _crc_table = (uint32_t *)Table_CRC_32bit_Rev_ANSI;
-            _mode = TABLE;
-            return;
-        }
         crc_mbed_config_t config;
-        config.polynomial  = polynomial;
-        config.width       = width;
-        config.initial_xor = _initial_value;
-        config.final_xor   = _final_xor;
-        config.reflect_in  = _reflect_data;
-        config.reflect_out = _reflect_remainder;
+        get_hal_config(&config);
 
         if (hal_crc_is_supported(&config)) {
             _mode = HARDWARE;
@@ -543,7 +702,11 @@ private:
                 _crc_table = (uint32_t *)Table_CRC_16bit_IBM;
                 break;
             default:
+#if __cplusplus >= 201103L
+                _crc_table = (uint32_t *)internal::crc_table<polynomial, width, 0>::table;
+#else
                 _crc_table = NULL;
+#endif
                 break;
         }
         _mode = (_crc_table != NULL) ? TABLE : BITWISE;
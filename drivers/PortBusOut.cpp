@@ -0,0 +1,145 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "drivers/PortBusOut.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_error.h"
+
+#if DEVICE_PORTOUT
+
+namespace mbed {
+
+PortBusOut::PortBusOut(PinName p0, PinName p1, PinName p2, PinName p3, PinName p4, PinName p5, PinName p6, PinName p7, PinName p8, PinName p9, PinName p10, PinName p11, PinName p12, PinName p13, PinName p14, PinName p15)
+{
+    PinName pins[16] = {p0, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15};
+    init(pins);
+}
+
+PortBusOut::PortBusOut(PinName pins[16])
+{
+    init(pins);
+}
+
+void PortBusOut::init(const PinName *pins)
+{
+    _port_count = 0;
+    _nc_mask = 0;
+    for (int i = 0; i < 16; i++) {
+        _pin_port[i] = -1;
+        _pin_bit[i] = 0;
+        if (pins[i] == NC) {
+            continue;
+        }
+
+        PortName name;
+        int pin_n;
+        if (port_pin_find(pins[i], &name, &pin_n) != 0) {
+            MBED_ERROR(MBED_MAKE_ERROR(MBED_MODULE_DRIVER_GPIO, MBED_ERROR_CODE_INVALID_ARGUMENT), "Pin isn't in a port");
+        }
+
+        int g = 0;
+        while (g < _port_count && _ports[g].name != name) {
+            g++;
+        }
+        if (g == _port_count) {
+            if (_port_count == MaxPorts) {
+                MBED_ERROR(MBED_MAKE_ERROR(MBED_MODULE_DRIVER_GPIO, MBED_ERROR_CODE_INVALID_ARGUMENT), "Bus pins are in too many ports");
+            }
+            _ports[g].name = name;
+            _ports[g].port_mask = 0;
+            _ports[g].bus_mask = 0;
+            _ports[g].shift = pin_n - i;
+            _ports[g].shifted = true;
+            _port_count++;
+        }
+
+        port_group_t &group = _ports[g];
+        group.port_mask |= 1 << pin_n;
+        group.bus_mask |= 1 << i;
+        if (pin_n - i != group.shift) {
+            group.shifted = false;
+        }
+        _pin_port[i] = g;
+        _pin_bit[i] = pin_n;
+        _nc_mask |= 1 << i;
+    }
+
+    for (int g = 0; g < _port_count; g++) {
+        port_init(&_ports[g].port, _ports[g].name, _ports[g].port_mask, PIN_OUTPUT);
+    }
+}
+
+int PortBusOut::to_port(const port_group_t &group, int value)
+{
+    value &= group.bus_mask;
+    if (group.shifted) {
+        return (group.shift >= 0) ? (value << group.shift) : (value >> -group.shift);
+    }
+
+    int port_value = 0;
+    for (int i = 0; i < 16; i++) {
+        if (value & (1 << i)) {
+            port_value |= 1 << _pin_bit[i];
+        }
+    }
+    return port_value;
+}
+
+int PortBusOut::from_port(const port_group_t &group, int port_value)
+{
+    port_value &= group.port_mask;
+    if (group.shifted) {
+        return (group.shift >= 0) ? (port_value >> group.shift) : (port_value << -group.shift);
+    }
+
+    int value = 0;
+    for (int i = 0; i < 16; i++) {
+        if ((group.bus_mask & (1 << i)) && (port_value & (1 << _pin_bit[i]))) {
+            value |= 1 << i;
+        }
+    }
+    return value;
+}
+
+void PortBusOut::write(int value)
+{
+    int port_values[MaxPorts];
+    for (int g = 0; g < _port_count; g++) {
+        port_values[g] = to_port(_ports[g], value);
+    }
+
+    core_util_critical_section_enter();
+    for (int g = 0; g < _port_count; g++) {
+        port_write(&_ports[g].port, port_values[g]);
+    }
+    core_util_critical_section_exit();
+}
+
+int PortBusOut::read()
+{
+    int value = 0;
+    core_util_critical_section_enter();
+    for (int g = 0; g < _port_count; g++) {
+        value |= from_port(_ports[g], port_read(&_ports[g].port));
+    }
+    core_util_critical_section_exit();
+    return value;
+}
+
+} // namespace mbed
+
+#endif
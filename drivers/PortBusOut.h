@@ -0,0 +1,156 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_PORTBUSOUT_H
+#define MBED_PORTBUSOUT_H
+
+#include "platform/platform.h"
+
+#if DEVICE_PORTOUT || defined(DOXYGEN_ONLY)
+
+#include "hal/port_api.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+/** \addtogroup drivers */
+
+/** A digital output bus written one GPIO port at a time
+ *
+ * Like BusOut, but the pins are grouped by GPIO port when the bus is
+ * created, and a write sets all the pins of a port with one port write.
+ * When the bus bits of a port map to consecutive port bits in the same
+ * order, as for a parallel display bus, the port value is computed with a
+ * single shift. All ports are written in one critical section, so the
+ * bus changes atomically as far as software can tell.
+ *
+ * The pins can spread over up to 4 ports.
+ *
+ * @note Synchronization level: Interrupt safe
+ * @ingroup drivers
+ */
+class PortBusOut : private NonCopyable<PortBusOut> {
+
+public:
+
+    /** Create a PortBusOut, connected to the specified pins
+     *
+     *  @param p0 Pin to connect to bus bit 0
+     *  @param p1 Pin to connect to bus bit 1
+     *  @param p2 Pin to connect to bus bit 2
+     *  @param p3 Pin to connect to bus bit 3
+     *  @param p4 Pin to connect to bus bit 4
+     *  @param p5 Pin to connect to bus bit 5
+     *  @param p6 Pin to connect to bus bit 6
+     *  @param p7 Pin to connect to bus bit 7
+     *  @param p8 Pin to connect to bus bit 8
+     *  @param p9 Pin to connect to bus bit 9
+     *  @param p10 Pin to connect to bus bit 10
+     *  @param p11 Pin to connect to bus bit 11
+     *  @param p12 Pin to connect to bus bit 12
+     *  @param p13 Pin to connect to bus bit 13
+     *  @param p14 Pin to connect to bus bit 14
+     *  @param p15 Pin to connect to bus bit 15
+     *
+     *  @note
+     *  It is only required to specify as many pin variables as is required
+     *  for the bus; the rest will default to NC (not connected)
+     */
+    PortBusOut(PinName p0, PinName p1 = NC, PinName p2 = NC, PinName p3 = NC,
+               PinName p4 = NC, PinName p5 = NC, PinName p6 = NC, PinName p7 = NC,
+               PinName p8 = NC, PinName p9 = NC, PinName p10 = NC, PinName p11 = NC,
+               PinName p12 = NC, PinName p13 = NC, PinName p14 = NC, PinName p15 = NC);
+
+    /** Create a PortBusOut, connected to the specified pins
+     *
+     *  @param pins An array of pins to connect to bus the bit
+     */
+    PortBusOut(PinName pins[16]);
+
+    /** Write the value to the output bus
+     *
+     *  @param value An integer specifying a bit to write for every corresponding pin
+     */
+    void write(int value);
+
+    /** Read the value currently output on the bus
+     *
+     *  @returns
+     *    An integer with each bit corresponding to associated pin setting
+     */
+    int read();
+
+    /** Binary mask of bus pins connected to actual pins (not NC pins)
+     *
+     *  @returns
+     *    Binary mask of connected pins
+     */
+    int mask()
+    {
+        return _nc_mask;
+    }
+
+    /** A shorthand for write()
+     * \sa PortBusOut::write()
+     */
+    PortBusOut &operator= (int v)
+    {
+        write(v);
+        return *this;
+    }
+
+    /** A shorthand for read()
+     * \sa PortBusOut::read()
+     */
+    operator int()
+    {
+        return read();
+    }
+
+#if !defined(DOXYGEN_ONLY)
+protected:
+    enum { MaxPorts = 4 };
+
+    /* Bus pins in one GPIO port */
+    struct port_group_t {
+        port_t port;
+        PortName name;
+        /* Port pins of the bus */
+        int port_mask;
+        /* Bus bits in the port */
+        int bus_mask;
+        /* Port bit minus bus bit, if the same for all the pins */
+        int shift;
+        bool shifted;
+    };
+
+    void init(const PinName *pins);
+    int to_port(const port_group_t &group, int value);
+    int from_port(const port_group_t &group, int value);
+
+    port_group_t _ports[MaxPorts];
+    int _port_count;
+    /* Port group and port bit of each bus bit */
+    int8_t _pin_port[16];
+    uint8_t _pin_bit[16];
+    int _nc_mask;
+#endif
+};
+
+} // namespace mbed
+
+#endif
+
+#endif
@@ -0,0 +1,83 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "drivers/PwmOutStream.h"
+#include "platform/mbed_power_mgmt.h"
+
+#if DEVICE_PWMOUT_STREAM
+
+namespace mbed {
+
+PwmOutStream::PwmOutStream(PinName pin) :
+    _stream(),
+    _running(false)
+{
+    pwmout_stream_init(&_stream, pin);
+}
+
+PwmOutStream::~PwmOutStream()
+{
+    stop();
+    pwmout_stream_free(&_stream);
+}
+
+void PwmOutStream::period_us(int us)
+{
+    _mutex.lock();
+    pwmout_stream_period_us(&_stream, us);
+    _mutex.unlock();
+}
+
+int PwmOutStream::start(Span<uint16_t> buffer, Callback<void(Span<uint16_t>)> callback)
+{
+    _mutex.lock();
+    if (_running || buffer.empty() || buffer.size() % 2 != 0) {
+        _mutex.unlock();
+        return -1;
+    }
+
+    // Timer and DMA stop in deep sleep
+    sleep_manager_lock_deep_sleep();
+    _callback = callback;
+    _running = true;
+    pwmout_stream_start(&_stream, buffer.data(), buffer.size(), &PwmOutStream::irq_handler, (uint32_t)this);
+    _mutex.unlock();
+    return 0;
+}
+
+void PwmOutStream::stop()
+{
+    _mutex.lock();
+    if (_running) {
+        pwmout_stream_stop(&_stream);
+        _running = false;
+        sleep_manager_unlock_deep_sleep();
+    }
+    _mutex.unlock();
+}
+
+void PwmOutStream::irq_handler(uint32_t id, uint16_t *samples, size_t count)
+{
+    PwmOutStream *handler = (PwmOutStream *)id;
+    if (handler->_callback) {
+        handler->_callback(Span<uint16_t>(samples, count));
+    }
+}
+
+} // namespace mbed
+
+#endif
@@ -19,12 +19,19 @@
 #include "platform/mbed_critical.h"
 #include <string.h>
 
+#if DEVICE_QSPI_ASYNCH
+#include "platform/mbed_power_mgmt.h"
+#endif
+
 #if DEVICE_QSPI
 
 namespace mbed {
 
 QSPI *QSPI::_owner = NULL;
 SingletonPtr<PlatformMutex> QSPI::_mutex;
+#if DEVICE_QSPI_ASYNCH
+QSPI *volatile QSPI::_async_owner = NULL;
+#endif
 
 QSPI::QSPI(PinName io0, PinName io1, PinName io2, PinName io3, PinName sclk, PinName ssel, int mode) : _qspi()
 {
@@ -44,6 +51,7 @@ QSPI::QSPI(PinName io0, PinName io1, PinName io2, PinName io3, PinName sclk, Pin
     _mode = mode;
     _hz = ONE_MHZ;
     _initialized = false;
+    _qspi_command_built = false;
 
     //Go ahead init the device here with the default config
     bool success = _initialize();
@@ -62,6 +70,7 @@ qspi_status_t QSPI::configure_format(qspi_bus_width_t inst_width, qspi_bus_width
     _alt_size = alt_size;
     _data_width = data_width;
     _num_dummy_cycles = dummy_cycles;
+    _qspi_command_built = false;
 
     unlock();
 
@@ -206,6 +215,113 @@ qspi_status_t QSPI::command_transfer(int instruction, int address, const char *t
     return ret_status;
 }
 
+qspi_status_t QSPI::memory_map(int instruction, int alt, const void **address)
+{
+    qspi_status_t ret_status = QSPI_STATUS_ERROR;
+
+    if (_initialized) {
+        if (address != NULL) {
+            lock();
+            if (true == _acquire()) {
+                _build_qspi_command(instruction, 0, alt);
+                if (QSPI_STATUS_OK == qspi_memory_mapped(&_qspi, &_qspi_command, address)) {
+                    ret_status = QSPI_STATUS_OK;
+                }
+            }
+            unlock();
+        } else {
+            ret_status = QSPI_STATUS_INVALID_PARAMETER;
+        }
+    }
+
+    return ret_status;
+}
+
+#if DEVICE_QSPI_ASYNCH
+
+qspi_status_t QSPI::read(int instruction, int alt, int address, char *rx_buffer, size_t rx_length, const Callback<void(qspi_status_t)> &callback)
+{
+    qspi_status_t ret_status = QSPI_STATUS_ERROR;
+
+    if (_initialized) {
+        if ((rx_buffer != NULL) && (rx_length != 0)) {
+            lock();
+            if (true == _acquire()) {
+                _build_qspi_command(instruction, address, alt);
+                _callback = callback;
+                _async_owner = this;
+                sleep_manager_lock_deep_sleep();
+                if (QSPI_STATUS_OK == qspi_read_asynch(&_qspi, &_qspi_command, rx_buffer, rx_length, &QSPI::_irq_handler, (uint32_t)this)) {
+                    ret_status = QSPI_STATUS_OK;
+                } else {
+                    sleep_manager_unlock_deep_sleep();
+                    _async_owner = NULL;
+                }
+            }
+            unlock();
+        } else {
+            ret_status = QSPI_STATUS_INVALID_PARAMETER;
+        }
+    }
+
+    return ret_status;
+}
+
+qspi_status_t QSPI::write(int instruction, int alt, int address, const char *tx_buffer, size_t tx_length, const Callback<void(qspi_status_t)> &callback)
+{
+    qspi_status_t ret_status = QSPI_STATUS_ERROR;
+
+    if (_initialized) {
+        if ((tx_buffer != NULL) && (tx_length != 0)) {
+            lock();
+            if (true == _acquire()) {
+                _build_qspi_command(instruction, address, alt);
+                _callback = callback;
+                _async_owner = this;
+                sleep_manager_lock_deep_sleep();
+                if (QSPI_STATUS_OK == qspi_write_asynch(&_qspi, &_qspi_command, tx_buffer, tx_length, &QSPI::_irq_handler, (uint32_t)this)) {
+                    ret_status = QSPI_STATUS_OK;
+                } else {
+                    sleep_manager_unlock_deep_sleep();
+                    _async_owner = NULL;
+                }
+            }
+            unlock();
+        } else {
+            ret_status = QSPI_STATUS_INVALID_PARAMETER;
+        }
+    }
+
+    return ret_status;
+}
+
+void QSPI::abort_transfer()
+{
+    lock();
+    core_util_critical_section_enter();
+    if (_async_owner == this) {
+        qspi_abort_asynch(&_qspi);
+        _async_owner = NULL;
+        sleep_manager_unlock_deep_sleep();
+    }
+    core_util_critical_section_exit();
+    unlock();
+}
+
+void QSPI::_irq_handler(uint32_t id, qspi_status_t status)
+{
+    QSPI *handler = (QSPI *)id;
+
+    // Release the bus first, so the callback can start the next transfer
+    _async_owner = NULL;
+    sleep_manager_unlock_deep_sleep();
+    if (handler->_callback) {
+        handler->_callback(status);
+    }
+}
+
+#endif
+
 void QSPI::lock()
 {
     _mutex->lock();
@@ -237,6 +353,12 @@ bool QSPI::_initialize()
 // Note: Private function with no locking
 bool QSPI::_acquire()
 {
+#if DEVICE_QSPI_ASYNCH
+    // The bus is held until the asynchronous transfer ends
+    if (_async_owner != NULL) {
+        return false;
+    }
+#endif
     if (_owner != this) {
         //This will set freq as well
         _initialize();
@@ -248,9 +370,21 @@ bool QSPI::_acquire()
 
 void QSPI::_build_qspi_command(int instruction, int address, int alt)
 {
-    memset(&_qspi_command, 0,  sizeof(qspi_command_t));
+    //The format only changes with configure_format, so repeated commands
+    //only update the values of the phases
+    if (!_qspi_command_built) {
+        memset(&_qspi_command, 0,  sizeof(qspi_command_t));
+        _qspi_command.instruction.bus_width = _inst_width;
+        _qspi_command.address.bus_width = _address_width;
+        _qspi_command.address.size = _address_size;
+        _qspi_command.alt.bus_width = _alt_width;
+        _qspi_command.alt.size = _alt_size;
+        _qspi_command.dummy_count = _num_dummy_cycles;
+        _qspi_command.data.bus_width = _data_width;
+        _qspi_command_built = true;
+    }
+
     //Set up instruction phase parameters
-    _qspi_command.instruction.bus_width = _inst_width;
     if (instruction != -1) {
         _qspi_command.instruction.value = instruction;
         _qspi_command.instruction.disabled = false;
@@ -259,8 +393,6 @@ void QSPI::_build_qspi_command(int instruction, int address, int alt)
     }
 
     //Set up address phase parameters
-    _qspi_command.address.bus_width = _address_width;
-    _qspi_command.address.size = _address_size;
     if (address != -1) {
         _qspi_command.address.value = address;
         _qspi_command.address.disabled = false;
@@ -269,19 +401,12 @@ void QSPI::_build_qspi_command(int instruction, int address, int alt)
     }
 
     //Set up alt phase parameters
-    _qspi_command.alt.bus_width = _alt_width;
-    _qspi_command.alt.size = _alt_size;
     if (alt != -1) {
         _qspi_command.alt.value = alt;
         _qspi_command.alt.disabled = false;
     } else {
         _qspi_command.alt.disabled = true;
     }
-
-    _qspi_command.dummy_count = _num_dummy_cycles;
-
-    //Set up bus width for data phase
-    _qspi_command.data.bus_width = _data_width;
 }
 
 } // namespace mbed
@@ -26,6 +26,10 @@
 #include "platform/SingletonPtr.h"
 #include "platform/NonCopyable.h"
 
+#if DEVICE_QSPI_ASYNCH
+#include "platform/Callback.h"
+#endif
+
 #define ONE_MHZ     1000000
 
 namespace mbed {
@@ -183,6 +187,65 @@ public:
      */
     qspi_status_t command_transfer(int instruction, int address, const char *tx_buffer, size_t tx_length, const char *rx_buffer, size_t rx_length);
 
+    /** Map the QSPI peripheral into the memory space using custom read instruction, alt values
+     *
+     *  The peripheral can then be read in place, until any other call on this QSPI object, or on
+     *  any other QSPI object sharing the interface, leaves memory-mapped mode.
+     *
+     *  @param instruction Instruction value to be used in instruction phase
+     *  @param alt Alt value to be used in Alternate-byte phase. Use -1 for ignoring Alternate-byte phase
+     *  @param address Pointer to a variable which on return is set to where address 0 of the peripheral is mapped
+     *
+     *  @returns
+     *    Returns QSPI_STATUS_SUCCESS on success and QSPI_STATUS_ERROR if the target doesn't support
+     *    memory-mapped mode or mapping failed.
+     */
+    qspi_status_t memory_map(int instruction, int alt, const void **address);
+
+#if DEVICE_QSPI_ASYNCH
+
+    /** Start a read from the QSPI peripheral, completing in the background
+     *
+     *  The data is transferred by DMA. Until the callback is called, any other
+     *  call using the bus fails with QSPI_STATUS_ERROR. Deep sleep is locked
+     *  while the transfer is ongoing.
+     *
+     *  @param instruction Instruction value to be used in instruction phase
+     *  @param alt Alt value to be used in Alternate-byte phase. Use -1 for ignoring Alternate-byte phase
+     *  @param address Address to be accessed in QSPI peripheral
+     *  @param rx_buffer Buffer for data to be read from the peripheral, valid until the callback
+     *  @param rx_length Length of rx_buffer
+     *  @param callback Called from interrupt context with the status of the transfer
+     *
+     *  @returns
+     *    Returns QSPI_STATUS_OK if the transfer has started and QSPI_STATUS_ERROR if the bus is busy or it failed to start.
+     */
+    qspi_status_t read(int instruction, int alt, int address, char *rx_buffer, size_t rx_length, const Callback<void(qspi_status_t)> &callback);
+
+    /** Start a write to the QSPI peripheral, completing in the background
+     *
+     *  Same constraints as the asynchronous read().
+     *
+     *  @param instruction Instruction value to be used in instruction phase
+     *  @param alt Alt value to be used in Alternate-byte phase. Use -1 for ignoring Alternate-byte phase
+     *  @param address Address to be accessed in QSPI peripheral
+     *  @param tx_buffer Buffer containing data to be sent to peripheral, valid until the callback
+     *  @param tx_length Length of tx_buffer
+     *  @param callback Called from interrupt context with the status of the transfer
+     *
+     *  @returns
+     *    Returns QSPI_STATUS_OK if the transfer has started and QSPI_STATUS_ERROR if the bus is busy or it failed to start.
+     */
+    qspi_status_t write(int instruction, int alt, int address, const char *tx_buffer, size_t tx_length, const Callback<void(qspi_status_t)> &callback);
+
+    /** Abort the ongoing asynchronous transfer of this object
+     *
+     *  The callback is not called.
+     */
+    void abort_transfer();
+
+#endif
+
 #if !defined(DOXYGEN_ONLY)
 protected:
     /** Acquire exclusive access to this SPI bus
@@ -205,6 +268,7 @@ protected:
     qspi_alt_size_t _alt_size;
     qspi_bus_width_t _data_width; //Bus width for Data phase
     qspi_command_t _qspi_command; //QSPI Hal command struct
+    bool _qspi_command_built; //Format fields of _qspi_command are up to date
     unsigned int _num_dummy_cycles; //Number of dummy cycles to be used
     int _hz; //Bus Frequency
     int _mode; //SPI mode
@@ -222,6 +286,14 @@ private:
      * This function builds the qspi command struct to be send to Hal
      */
     inline void _build_qspi_command(int instruction, int address, int alt);
+
+#if DEVICE_QSPI_ASYNCH
+    static void _irq_handler(uint32_t id, qspi_status_t status);
+
+    Callback<void(qspi_status_t)> _callback;
+    /* Object with an asynchronous transfer ongoing, which holds the bus */
+    static QSPI *volatile _async_owner;
+#endif
 #endif
 };
 
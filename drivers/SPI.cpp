@@ -39,12 +39,35 @@ SPI::SPI(PinName mosi, PinName miso, PinName sclk, PinName ssel) :
     _bits(8),
     _mode(0),
     _hz(1000000),
-    _write_fill(SPI_FILL_CHAR)
+    _write_fill(SPI_FILL_CHAR),
+    _sw_ssel(),
+    _use_gpio_ssel(false),
+    _select_count(0)
 {
     // No lock needed in the constructor
     spi_init(&_spi, mosi, miso, sclk, ssel);
 }
 
+SPI::SPI(PinName mosi, PinName miso, PinName sclk, PinName ssel, use_gpio_ssel_t) :
+    _spi(),
+#if DEVICE_SPI_ASYNCH
+    _irq(this),
+    _usage(DMA_USAGE_NEVER),
+    _deep_sleep_locked(false),
+#endif
+    _bits(8),
+    _mode(0),
+    _hz(1000000),
+    _write_fill(SPI_FILL_CHAR),
+    _sw_ssel(),
+    _use_gpio_ssel(true),
+    _select_count(0)
+{
+    // No lock needed in the constructor
+    gpio_init_out_ex(&_sw_ssel, ssel, 1);
+    spi_init(&_spi, mosi, miso, sclk, NC);
+}
+
 SPI::~SPI()
 {
     if (_owner == this) {
@@ -90,11 +113,7 @@ SingletonPtr<PlatformMutex> SPI::_mutex;
 void SPI::aquire()
 {
     lock();
-    if (_owner != this) {
-        spi_format(&_spi, _bits, _mode, 0);
-        spi_frequency(&_spi, _hz);
-        _owner = this;
-    }
+    _acquire();
     unlock();
 }
 
@@ -102,27 +121,24 @@ void SPI::aquire()
 void SPI::_acquire()
 {
     if (_owner != this) {
-        spi_format(&_spi, _bits, _mode, 0);
-        spi_frequency(&_spi, _hz);
+        spi_configure(&_spi, _bits, _mode, _hz);
         _owner = this;
     }
 }
 
 int SPI::write(int value)
 {
-    lock();
-    _acquire();
+    select();
     int ret = spi_master_write(&_spi, value);
-    unlock();
+    deselect();
     return ret;
 }
 
 int SPI::write(const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length)
 {
-    lock();
-    _acquire();
+    select();
     int ret = spi_master_block_write(&_spi, tx_buffer, tx_length, rx_buffer, rx_length, _write_fill);
-    unlock();
+    deselect();
     return ret;
 }
 
@@ -136,6 +152,23 @@ void SPI::unlock()
     _mutex->unlock();
 }
 
+void SPI::select()
+{
+    lock();
+    _acquire();
+    if (_select_count++ == 0 && _use_gpio_ssel) {
+        gpio_write(&_sw_ssel, 0);
+    }
+}
+
+void SPI::deselect()
+{
+    if (--_select_count == 0 && _use_gpio_ssel) {
+        gpio_write(&_sw_ssel, 1);
+    }
+    unlock();
+}
+
 void SPI::set_default_write_value(char data)
 {
     lock();
@@ -147,7 +180,7 @@ void SPI::set_default_write_value(char data)
 
 int SPI::transfer(const void *tx_buffer, int tx_length, void *rx_buffer, int rx_length, unsigned char bit_width, const event_callback_t &callback, int event)
 {
-    if (spi_active(&_spi)) {
+    if (_bus_active()) {
         return queue_transfer(tx_buffer, tx_length, rx_buffer, rx_length, bit_width, callback, event);
     }
     start_transfer(tx_buffer, tx_length, rx_buffer, rx_length, bit_width, callback, event);
@@ -157,6 +190,9 @@ int SPI::transfer(const void *tx_buffer, int tx_length, void *rx_buffer, int rx_
 void SPI::abort_transfer()
 {
     spi_abort_asynch(&_spi);
+    if (_use_gpio_ssel && _select_count == 0) {
+        gpio_write(&_sw_ssel, 1);
+    }
     unlock_deep_sleep();
 #if TRANSACTION_QUEUE_SIZE_SPI
     dequeue_transaction();
@@ -204,7 +240,7 @@ int SPI::queue_transfer(const void *tx_buffer, int tx_length, void *rx_buffer, i
     } else {
         core_util_critical_section_enter();
         _transaction_buffer.push(transaction);
-        if (!spi_active(&_spi)) {
+        if (!_bus_active()) {
             dequeue_transaction();
         }
         core_util_critical_section_exit();
@@ -218,7 +254,12 @@ int SPI::queue_transfer(const void *tx_buffer, int tx_length, void *rx_buffer, i
 void SPI::start_transfer(const void *tx_buffer, int tx_length, void *rx_buffer, int rx_length, unsigned char bit_width, const event_callback_t &callback, int event)
 {
     lock_deep_sleep();
+    // Format and frequency are only reprogrammed when the previous transfer
+    // on the bus was for another device
     _acquire();
+    if (_use_gpio_ssel) {
+        gpio_write(&_sw_ssel, 0);
+    }
     _callback = callback;
     _irq.callback(&SPI::irq_handler_asynch);
     spi_master_transfer(&_spi, tx_buffer, tx_length, rx_buffer, rx_length, bit_width, _irq.entry(), event, _usage);
@@ -240,6 +281,13 @@ void SPI::unlock_deep_sleep()
     }
 }
 
+// All SPI objects share the transaction queue, so a transfer started by another
+// device on the bus keeps this one queued too
+bool SPI::_bus_active()
+{
+    return spi_active(&_spi) || (_owner != NULL && _owner != this && spi_active(&_owner->_spi));
+}
+
 #if TRANSACTION_QUEUE_SIZE_SPI
 
 void SPI::start_transaction(transaction_t *data)
@@ -262,16 +310,25 @@ void SPI::dequeue_transaction()
 void SPI::irq_handler_asynch(void)
 {
     int event = spi_irq_handler_asynch(&_spi);
-    if (_callback && (event & SPI_EVENT_ALL)) {
-        unlock_deep_sleep();
-        _callback.call(event & SPI_EVENT_ALL);
+    if (!(event & (SPI_EVENT_ALL | SPI_EVENT_INTERNAL_TRANSFER_COMPLETE))) {
+        return;
     }
-#if TRANSACTION_QUEUE_SIZE_SPI
-    if (event & (SPI_EVENT_ALL | SPI_EVENT_INTERNAL_TRANSFER_COMPLETE)) {
-        // SPI peripheral is free (event happened), dequeue transaction
-        dequeue_transaction();
+
+    if (_use_gpio_ssel && _select_count == 0) {
+        gpio_write(&_sw_ssel, 1);
     }
+    unlock_deep_sleep();
+
+    // The next transfer may be ours and replace the callback
+    event_callback_t callback = _callback;
+#if TRANSACTION_QUEUE_SIZE_SPI
+    // SPI peripheral is free, start the next transfer before running the
+    // callback so the bus doesn't idle while it executes
+    dequeue_transaction();
 #endif
+    if (callback && (event & SPI_EVENT_ALL)) {
+        callback.call(event & SPI_EVENT_ALL);
+    }
 }
 
 #endif
@@ -23,8 +23,10 @@
 
 #include "platform/PlatformMutex.h"
 #include "hal/spi_api.h"
+#include "hal/gpio_api.h"
 #include "platform/SingletonPtr.h"
 #include "platform/NonCopyable.h"
+#include "platform/Span.h"
 
 #if DEVICE_SPI_ASYNCH
 #include "platform/CThunk.h"
@@ -37,6 +39,13 @@
 namespace mbed {
 /** \addtogroup drivers */
 
+/** Tag selecting the SPI constructor that drives Chip Select as a GPIO
+ *
+ * @ingroup drivers
+ */
+struct use_gpio_ssel_t { };
+const use_gpio_ssel_t use_gpio_ssel;
+
 /** A SPI Master, used for communicating with SPI slave devices.
  *
  * The default format is set to 8-bits, mode 0, and a clock frequency of 1MHz.
@@ -77,6 +86,24 @@ namespace mbed {
  *     device.unlock();
  * }
  * @endcode
+ *
+ * Example sharing a bus between devices, with Chip Select driven by the driver:
+ * @code
+ * #include "mbed.h"
+ *
+ * SPI sensor_a(SPI_MOSI, SPI_MISO, SPI_SCLK, D9, use_gpio_ssel);
+ * SPI sensor_b(SPI_MOSI, SPI_MISO, SPI_SCLK, D10, use_gpio_ssel);
+ *
+ * int main() {
+ *     sensor_b.format(8, 3);
+ *     sensor_b.frequency(8000000);
+ *
+ *     // Both transfers are chained from interrupt context, each with its
+ *     // own Chip Select, mode and frequency
+ *     sensor_a.transfer(a_tx, sizeof a_tx, a_rx, sizeof a_rx, a_done);
+ *     sensor_b.transfer(b_tx, sizeof b_tx, b_rx, sizeof b_rx, b_done);
+ * }
+ * @endcode
  * @ingroup drivers
  */
 class SPI : private NonCopyable<SPI> {
@@ -93,6 +120,19 @@ public:
      *  @param ssel SPI Chip Select pin.
      */
     SPI(PinName mosi, PinName miso, PinName sclk, PinName ssel = NC);
+
+    /** Create a SPI master with Chip Select driven as a GPIO by the driver.
+     *
+     *  Chip Select is asserted around each write(), each non-blocking transfer
+     *  and between select() and deselect(). Unlike a hardware Chip Select,
+     *  any pin can be used, so several devices can share the bus.
+     *
+     *  @param mosi SPI Master Out, Slave In pin.
+     *  @param miso SPI Master In, Slave Out pin.
+     *  @param sclk SPI Clock pin.
+     *  @param ssel SPI Chip Select pin, active low.
+     */
+    SPI(PinName mosi, PinName miso, PinName sclk, PinName ssel, use_gpio_ssel_t);
     virtual ~SPI();
 
     /** Configure the data transmission format.
@@ -141,6 +181,23 @@ public:
      */
     virtual int write(const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length);
 
+    /** Write to the SPI Slave and obtain the response.
+     *
+     *  Same as write(const char *, int, char *, int), with the buffers given as spans.
+     *  Sending a whole frame in one call takes the bus and applies this
+     *  object's format once, rather than for each byte.
+     *
+     *  @param tx_buffer Data to write to the device, may be empty.
+     *  @param rx_buffer Buffer for the data read from the device, may be empty.
+     *  @return
+     *      The number of bytes written and read from the device. This is
+     *      maximum of tx_buffer and rx_buffer sizes.
+     */
+    int write(Span<const char> tx_buffer, Span<char> rx_buffer = Span<char>())
+    {
+        return write(tx_buffer.data(), tx_buffer.size(), rx_buffer.data(), rx_buffer.size());
+    }
+
     /** Acquire exclusive access to this SPI bus.
      */
     virtual void lock(void);
@@ -149,6 +206,18 @@ public:
      */
     virtual void unlock(void);
 
+    /** Acquire exclusive access to this SPI bus and assert Chip Select.
+     *
+     *  Keeps Chip Select asserted over several writes, until the matching
+     *  deselect(). Calls can be nested. Only has an effect on Chip Select
+     *  when it is driven as a GPIO, see use_gpio_ssel.
+     */
+    void select(void);
+
+    /** Deassert Chip Select and release exclusive access to this SPI bus.
+     */
+    void deselect(void);
+
     /** Set default write data.
       * SPI requires the master to send some data during a read operation.
       * Different devices may require different default byte values.
@@ -180,7 +249,7 @@ public:
     template<typename Type>
     int transfer(const Type *tx_buffer, int tx_length, Type *rx_buffer, int rx_length, const event_callback_t &callback, int event = SPI_EVENT_COMPLETE)
     {
-        if (spi_active(&_spi)) {
+        if (_bus_active()) {
             return queue_transfer(tx_buffer, tx_length, rx_buffer, rx_length, sizeof(Type) * 8, callback, event);
         }
         start_transfer(tx_buffer, tx_length, rx_buffer, rx_length, sizeof(Type) * 8, callback, event);
@@ -272,6 +341,9 @@ private:
     /** Unlock deep sleep in case it is locked */
     void unlock_deep_sleep();
 
+    /** Check if a transfer started by any SPI object is ongoing */
+    bool _bus_active();
+
 
 #if TRANSACTION_QUEUE_SIZE_SPI
 
@@ -282,6 +354,9 @@ private:
     void start_transaction(transaction_t *data);
 
     /** Dequeue a transaction and start the transfer if there was one pending.
+     *
+     *  Called from the completion interrupt, so queued transfers of all
+     *  devices on the bus run back to back without waking a thread.
      */
     void dequeue_transaction();
 
@@ -323,6 +398,11 @@ protected:
     int _hz;
     /* Default character used for NULL transfers */
     char _write_fill;
+    /* Chip Select driven by the driver, if _use_gpio_ssel */
+    gpio_t _sw_ssel;
+    bool _use_gpio_ssel;
+    /* Nesting of select() */
+    int _select_count;
 
 private:
     /** Private acquire function without locking/unlocking.
@@ -41,13 +41,13 @@ void Ticker::setup(us_timestamp_t t)
     core_util_critical_section_enter();
     remove();
     _delay = t;
-    insert_absolute(_delay + ticker_read_us(_ticker_data));
+    insert_absolute(_delay + ticker_read_us(_ticker_data), _tolerance);
     core_util_critical_section_exit();
 }
 
 void Ticker::handler()
 {
-    insert_absolute(event.timestamp + _delay);
+    insert_absolute(event.timestamp + _delay, _tolerance);
     if (_function) {
         _function();
     }
@@ -61,6 +61,20 @@ void Ticker::attach_us(Callback<void()> func, us_timestamp_t t)
         sleep_manager_lock_deep_sleep();
     }
     _function = func;
+    _tolerance = 0;
+    setup(t);
+    core_util_critical_section_exit();
+}
+
+void Ticker::attach_us_with_tolerance(Callback<void()> func, us_timestamp_t t, uint32_t tolerance)
+{
+    core_util_critical_section_enter();
+    // lock only for the initial callback setup and this is not low power ticker
+    if (!_function && _lock_deepsleep) {
+        sleep_manager_lock_deep_sleep();
+    }
+    _function = func;
+    _tolerance = tolerance;
     setup(t);
     core_util_critical_section_exit();
 }
@@ -67,12 +67,12 @@ namespace mbed {
 class Ticker : public TimerEvent, private NonCopyable<Ticker> {
 
 public:
-    Ticker() : TimerEvent(), _function(0), _lock_deepsleep(true)
+    Ticker() : TimerEvent(), _function(0), _tolerance(0), _lock_deepsleep(true)
     {
     }
 
     // When low power ticker is in use, then do not disable deep sleep.
-    Ticker(const ticker_data_t *data) : TimerEvent(data), _function(0), _lock_deepsleep(true)
+    Ticker(const ticker_data_t *data) : TimerEvent(data), _function(0), _tolerance(0), _lock_deepsleep(true)
     {
 #if DEVICE_LPTICKER
         _lock_deepsleep = (data != get_lp_ticker_data());
@@ -119,6 +119,19 @@ public:
      */
     void attach_us(Callback<void()> func, us_timestamp_t t);
 
+    /** Attach a function to be called by the Ticker, specifying the interval and the tolerance in microseconds
+     *
+     *  Each call may be delayed by up to @a tolerance so it can share a timer
+     *  interrupt with other timers, which reduces the number of times the
+     *  CPU wakes up from sleep. The delay does not accumulate: every call is
+     *  scheduled relative to the nominal time of the previous one.
+     *
+     *  @param func pointer to the function to be called
+     *  @param t the time between calls in micro-seconds
+     *  @param tolerance the time in micro-seconds each call may be delayed by
+     */
+    void attach_us_with_tolerance(Callback<void()> func, us_timestamp_t t, uint32_t tolerance);
+
     /** Attach a member function to be called by the Ticker, specifying the interval in microseconds
      *
      *  @param obj pointer to the object to call the member function on
@@ -154,6 +167,7 @@ protected:
 protected:
     us_timestamp_t         _delay;  /**< Time delay (in microseconds) for resetting the multishot callback. */
     Callback<void()>    _function;  /**< Callback. */
+    uint32_t           _tolerance;  /**< Time (in microseconds) each callback may be delayed by. */
     bool          _lock_deepsleep;  /**< Flag which indicates if deep sleep should be disabled. */
 #endif
 };
@@ -54,6 +54,11 @@ void TimerEvent::insert_absolute(us_timestamp_t timestamp)
     ticker_insert_event_us(_ticker_data, &event, timestamp, (uint32_t)this);
 }
 
+void TimerEvent::insert_absolute(us_timestamp_t timestamp, uint32_t tolerance)
+{
+    ticker_insert_event_with_tolerance_us(_ticker_data, &event, timestamp, tolerance, (uint32_t)this);
+}
+
 void TimerEvent::remove()
 {
     ticker_remove_event(_ticker_data, &event);
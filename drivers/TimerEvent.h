@@ -72,6 +72,17 @@ protected:
      */
     void insert_absolute(us_timestamp_t timestamp);
 
+    /** Set absolute timestamp of the internal event, allowing it to be delayed.
+     * @param   timestamp   event's us timestamp
+     * @param   tolerance   time in us the event may be delayed by so it can
+     *                      share a timer interrupt with other events
+     *
+     * @warning
+     * Do not insert more than one timestamp.
+     * The same @a event object is used for every @a insert/insert_absolute call.
+     */
+    void insert_absolute(us_timestamp_t timestamp, uint32_t tolerance);
+
     /** Remove timestamp.
      */
     void remove();
@@ -19,6 +19,9 @@
 #if (DEVICE_SERIAL && DEVICE_INTERRUPTIN)
 
 #include "platform/mbed_poll.h"
+#include "platform/mbed_power_mgmt.h"
+#include <string.h>
+#include <new>
 
 #if MBED_CONF_RTOS_PRESENT
 #include "rtos/ThisThread.h"
@@ -33,14 +36,39 @@ UARTSerial::UARTSerial(PinName tx, PinName rx, int baud) :
     _blocking(true),
     _tx_irq_enabled(false),
     _rx_irq_enabled(true),
-    _dcd_irq(NULL)
+    _dcd_irq(NULL),
+    _async_rbuf(NULL),
+    _async_rlen(0),
+    _async_wbuf(NULL),
+    _async_wlen(0)
+#if DEVICE_SERIAL_ASYNCH
+    , _dma_rx(NULL),
+    _dma_offset(0),
+    _dma_head(0),
+    _dma_active(0),
+    _dma_receiving(false),
+    _dma_delimiter(SERIAL_RESERVED_CHAR_MATCH),
+    _dma_tx(false),
+    _dma_sending(false),
+    _dma_tx_len(0)
+#endif
 {
     /* Attatch IRQ routines to the serial device. */
     SerialBase::attach(callback(this, &UARTSerial::rx_irq), RxIrq);
+
+#if DEVICE_SERIAL_ASYNCH && MBED_CONF_DRIVERS_UART_SERIAL_DMA_TX
+    // nothing is queued yet, the first write starts the first transfer
+    _dma_tx = true;
+    _tx_usage = DMA_USAGE_OPPORTUNISTIC;
+#endif
 }
 
 UARTSerial::~UARTSerial()
 {
+#if DEVICE_SERIAL_ASYNCH
+    set_dma_rx(false);
+    set_dma_tx(false);
+#endif
     delete _dcd_irq;
 }
 
@@ -139,13 +167,24 @@ void UARTSerial::sigio(Callback<void()> func)
  */
 ssize_t UARTSerial::write_unbuffered(const char *buf_ptr, size_t length)
 {
+#if DEVICE_SERIAL_ASYNCH
+    if (_dma_sending) {
+        // The completion interrupt can't run in a critical section, so stop
+        // the transfer and send its data again by hand. Part of it may be
+        // repeated, but nothing queued before this write is lost.
+        serial_tx_abort_asynch(&_serial);
+        _tx_callback = NULL;
+        sleep_manager_unlock_deep_sleep();
+        _dma_sending = false;
+    }
+#endif
+
     while (!_txbuf.empty()) {
         tx_irq();
     }
 
     for (size_t data_written = 0; data_written < length; data_written++) {
         SerialBase::_base_putc(*buf_ptr++);
-        data_written++;
     }
 
     return length;
@@ -182,20 +221,9 @@ ssize_t UARTSerial::write(const void *buffer, size_t length)
             } while (_txbuf.full());
         }
 
-        while (data_written < length && !_txbuf.full()) {
-            _txbuf.push(*buf_ptr++);
-            data_written++;
-        }
-
-        core_util_critical_section_enter();
-        if (!_tx_irq_enabled) {
-            UARTSerial::tx_irq();                // only write to hardware in one place
-            if (!_txbuf.empty()) {
-                SerialBase::attach(callback(this, &UARTSerial::tx_irq), TxIrq);
-                _tx_irq_enabled = true;
-            }
-        }
-        core_util_critical_section_exit();
+        size_t chunk = write_available(buf_ptr, length - data_written);
+        buf_ptr += chunk;
+        data_written += chunk;
     }
 
     api_unlock();
@@ -203,6 +231,34 @@ ssize_t UARTSerial::write(const void *buffer, size_t length)
     return data_written != 0 ? (ssize_t) data_written : (ssize_t) - EAGAIN;
 }
 
+size_t UARTSerial::write_available(const char *buf_ptr, size_t length)
+{
+    size_t chunk = MBED_CONF_DRIVERS_UART_SERIAL_TXBUF_SIZE - _txbuf.size();
+    if (chunk > length) {
+        chunk = length;
+    }
+    _txbuf.push(buf_ptr, chunk);
+
+    core_util_critical_section_enter();
+#if DEVICE_SERIAL_ASYNCH
+    if (_dma_tx) {
+        if (!_dma_sending) {
+            dma_tx_start();
+        }
+    } else
+#endif
+    if (!_tx_irq_enabled) {
+        UARTSerial::tx_irq();                // only write to hardware in one place
+        if (!_txbuf.empty()) {
+            SerialBase::attach(callback(this, &UARTSerial::tx_irq), TxIrq);
+            _tx_irq_enabled = true;
+        }
+    }
+    core_util_critical_section_exit();
+
+    return chunk;
+}
+
 ssize_t UARTSerial::read(void *buffer, size_t length)
 {
     size_t data_read = 0;
@@ -215,7 +271,7 @@ ssize_t UARTSerial::read(void *buffer, size_t length)
 
     api_lock();
 
-    while (_rxbuf.empty()) {
+    while (!rx_available()) {
         if (!_blocking) {
             api_unlock();
             return -EAGAIN;
@@ -225,10 +281,54 @@ ssize_t UARTSerial::read(void *buffer, size_t length)
         api_lock();
     }
 
-    while (data_read < length && !_rxbuf.empty()) {
-        _rxbuf.pop(*ptr++);
-        data_read++;
+    data_read = read_available(ptr, length);
+
+    api_unlock();
+
+    return data_read;
+}
+
+bool UARTSerial::rx_available() const
+{
+#if DEVICE_SERIAL_ASYNCH
+    if (_dma_rx) {
+        return !_rxbuf.empty() || dma_rx_readable();
     }
+#endif
+    return !_rxbuf.empty();
+}
+
+size_t UARTSerial::read_available(char *ptr, size_t length)
+{
+    size_t data_read;
+
+#if DEVICE_SERIAL_ASYNCH
+    if (_dma_rx) {
+        // bytes received before DMA mode was enabled come first
+        data_read = _rxbuf.pop(ptr, length);
+        ptr += data_read;
+
+        while (data_read < length) {
+            Span<const uint8_t> data = rx_peek();
+            if (data.empty()) {
+                break;
+            }
+
+            size_t n = length - data_read;
+            if (n > (size_t)data.size()) {
+                n = data.size();
+            }
+            memcpy(ptr, data.data(), n);
+            rx_consume(n);
+            ptr += n;
+            data_read += n;
+        }
+
+        return data_read;
+    }
+#endif
+
+    data_read = _rxbuf.pop(ptr, length);
 
     core_util_critical_section_enter();
     if (!_rx_irq_enabled) {
@@ -240,9 +340,82 @@ ssize_t UARTSerial::read(void *buffer, size_t length)
     }
     core_util_critical_section_exit();
 
+    return data_read;
+}
+
+int UARTSerial::read_async(void *buffer, size_t length, Callback<void(ssize_t)> done)
+{
+    api_lock();
+
+    core_util_critical_section_enter();
+    if (_async_read_cb) {
+        core_util_critical_section_exit();
+        api_unlock();
+        return -EBUSY;
+    }
+    if (length != 0 && !rx_available()) {
+        // completed by the interrupt reporting the next data
+        _async_rbuf = static_cast<char *>(buffer);
+        _async_rlen = length;
+        _async_read_cb = done;
+        core_util_critical_section_exit();
+        api_unlock();
+        return 0;
+    }
+    core_util_critical_section_exit();
+
+    ssize_t data_read = read_available(static_cast<char *>(buffer), length);
     api_unlock();
 
-    return data_read;
+    done(data_read);
+    return 0;
+}
+
+int UARTSerial::write_async(const void *buffer, size_t length, Callback<void(ssize_t)> done)
+{
+    api_lock();
+
+    core_util_critical_section_enter();
+    if (_async_write_cb) {
+        core_util_critical_section_exit();
+        api_unlock();
+        return -EBUSY;
+    }
+    if (length != 0 && _txbuf.full()) {
+        // completed by the interrupt freeing room in _txbuf
+        _async_wbuf = static_cast<const char *>(buffer);
+        _async_wlen = length;
+        _async_write_cb = done;
+        core_util_critical_section_exit();
+        api_unlock();
+        return 0;
+    }
+    core_util_critical_section_exit();
+
+    ssize_t data_written = write_available(static_cast<const char *>(buffer), length);
+    api_unlock();
+
+    done(data_written);
+    return 0;
+}
+
+/* Complete pending async transfers, from the interrupt reporting a change.
+ * The pending transfer stands for the api_lock holder, as read() and write()
+ * are not called meanwhile.
+ */
+void UARTSerial::async_complete()
+{
+    if (_async_read_cb && rx_available()) {
+        Callback<void(ssize_t)> done = _async_read_cb;
+        _async_read_cb = NULL;
+        done(read_available(_async_rbuf, _async_rlen));
+    }
+
+    if (_async_write_cb && !_txbuf.full()) {
+        Callback<void(ssize_t)> done = _async_write_cb;
+        _async_write_cb = NULL;
+        done(write_available(_async_wbuf, _async_wlen));
+    }
 }
 
 bool UARTSerial::hup() const
@@ -252,6 +425,8 @@ bool UARTSerial::hup() const
 
 void UARTSerial::wake()
 {
+    async_complete();
+
     if (_sigio_cb) {
         _sigio_cb();
     }
@@ -268,6 +443,12 @@ short UARTSerial::poll(short events) const
         revents |= POLLIN;
     }
 
+#if DEVICE_SERIAL_ASYNCH
+    if (_dma_rx && dma_rx_readable()) {
+        revents |= POLLIN;
+    }
+#endif
+
     /* POLLHUP and POLLOUT are mutually exclusive */
     if (hup()) {
         revents |= POLLHUP;
@@ -347,6 +528,199 @@ void UARTSerial::tx_irq(void)
     }
 }
 
+#if DEVICE_SERIAL_ASYNCH
+int UARTSerial::set_dma_rx(bool enabled, unsigned char delimiter)
+{
+    api_lock();
+
+    if (enabled && !_dma_rx) {
+        uint8_t *buffer = new (std::nothrow) uint8_t[2 * DMA_RX_HALF];
+        if (!buffer) {
+            api_unlock();
+            return -ENOMEM;
+        }
+
+        core_util_critical_section_enter();
+        if (_rx_irq_enabled) {
+            SerialBase::attach(NULL, RxIrq);
+            _rx_irq_enabled = false;
+        }
+
+        _dma_rx = buffer;
+        _dma_len[0] = 0;
+        _dma_len[1] = 0;
+        _dma_offset = 0;
+        _dma_head = 0;
+        _dma_delimiter = delimiter;
+        dma_rx_start(0);
+        core_util_critical_section_exit();
+    } else if (!enabled && _dma_rx) {
+        core_util_critical_section_enter();
+        if (_dma_receiving) {
+            // SerialBase::abort_read only drops the deep sleep lock taken
+            // by start_read when a TX transfer exists, so drop it here
+            serial_rx_abort_asynch(&_serial);
+            _rx_callback = NULL;
+            sleep_manager_unlock_deep_sleep();
+            _dma_receiving = false;
+        }
+
+        uint8_t *buffer = _dma_rx;
+        _dma_rx = NULL;
+
+        SerialBase::attach(callback(this, &UARTSerial::rx_irq), RxIrq);
+        _rx_irq_enabled = true;
+        core_util_critical_section_exit();
+
+        delete[] buffer;
+    } else if (enabled) {
+        _dma_delimiter = delimiter;
+    }
+
+    api_unlock();
+
+    return 0;
+}
+
+Span<const uint8_t> UARTSerial::rx_peek()
+{
+    if (!_dma_rx || _dma_len[_dma_head] <= _dma_offset) {
+        return Span<const uint8_t>();
+    }
+
+    return Span<const uint8_t>(&_dma_rx[_dma_head * DMA_RX_HALF + _dma_offset],
+                               _dma_len[_dma_head] - _dma_offset);
+}
+
+void UARTSerial::rx_consume(size_t length)
+{
+    if (!_dma_rx || !length) {
+        return;
+    }
+
+    _dma_offset += length;
+    if (_dma_offset < _dma_len[_dma_head]) {
+        return;
+    }
+
+    // hand the drained half back to the peripheral
+    core_util_critical_section_enter();
+    uint8_t half = _dma_head;
+    _dma_len[half] = 0;
+    _dma_offset = 0;
+    _dma_head = half ^ 1;
+    if (!_dma_receiving) {
+        dma_rx_start(half);
+    }
+    core_util_critical_section_exit();
+}
+
+bool UARTSerial::dma_rx_readable() const
+{
+    return _dma_len[_dma_head] > _dma_offset;
+}
+
+void UARTSerial::dma_rx_start(uint8_t half)
+{
+    _dma_active = half;
+    _dma_receiving = SerialBase::read(&_dma_rx[half * DMA_RX_HALF], DMA_RX_HALF,
+                                      callback(this, &UARTSerial::dma_rx_event),
+                                      SERIAL_EVENT_RX_ALL, _dma_delimiter) == 0;
+}
+
+void UARTSerial::dma_rx_event(int event)
+{
+    bool was_empty = !dma_rx_readable();
+
+    size_t received = DMA_RX_HALF;
+    if (!(event & SERIAL_EVENT_RX_COMPLETE) && _serial.rx_buff.pos < DMA_RX_HALF) {
+        received = _serial.rx_buff.pos;
+    }
+
+    uint8_t half = _dma_active;
+    _dma_len[half] = received;
+    _dma_receiving = false;
+
+    // keep receiving into the other half if the reader is done with it,
+    // or into the same half if nothing arrived, otherwise rx_consume
+    // restarts reception once the reader frees a half
+    if (!received) {
+        dma_rx_start(half);
+    } else if (!_dma_len[half ^ 1]) {
+        dma_rx_start(half ^ 1);
+    }
+
+    if (was_empty && dma_rx_readable()) {
+        wake();
+    }
+}
+
+void UARTSerial::set_dma_tx(bool enabled)
+{
+    api_lock();
+
+    if (enabled && !_dma_tx) {
+        core_util_critical_section_enter();
+        if (_tx_irq_enabled) {
+            SerialBase::attach(NULL, TxIrq);
+            _tx_irq_enabled = false;
+        }
+
+        _dma_tx = true;
+        _tx_usage = DMA_USAGE_OPPORTUNISTIC;
+        dma_tx_start();
+        core_util_critical_section_exit();
+    } else if (!enabled && _dma_tx) {
+        // writers are held off by the lock, let the last transfer end
+        while (_dma_sending) {
+            wait_ms(1);
+        }
+
+        core_util_critical_section_enter();
+        _dma_tx = false;
+        _tx_usage = DMA_USAGE_NEVER;
+        UARTSerial::tx_irq();
+        if (!_txbuf.empty()) {
+            SerialBase::attach(callback(this, &UARTSerial::tx_irq), TxIrq);
+            _tx_irq_enabled = true;
+        }
+        core_util_critical_section_exit();
+    }
+
+    api_unlock();
+}
+
+void UARTSerial::dma_tx_start()
+{
+    Span<const char> data = _txbuf.readable_span();
+    if (data.empty()) {
+        return;
+    }
+
+    _dma_tx_len = data.size();
+    _dma_sending = SerialBase::write(reinterpret_cast<const uint8_t *>(data.data()), data.size(),
+                                     callback(this, &UARTSerial::dma_tx_event),
+                                     SERIAL_EVENT_TX_COMPLETE) == 0;
+}
+
+void UARTSerial::dma_tx_event(int event)
+{
+    bool was_full = _txbuf.full();
+
+    _txbuf.consume(_dma_tx_len);
+    _dma_sending = false;
+
+    // the other end of a wrapped buffer, or data queued meanwhile
+    if (_dma_tx) {
+        dma_tx_start();
+    }
+
+    if (was_full && !_txbuf.full() && !hup()) {
+        wake();
+    }
+}
+#endif
+
 void UARTSerial::wait_ms(uint32_t millisec)
 {
     /* wait_ms implementation for RTOS spins until exact microseconds - we
@@ -28,7 +28,9 @@
 #include "platform/PlatformMutex.h"
 #include "hal/serial_api.h"
 #include "platform/CircularBuffer.h"
+#include "platform/SPSCRingBuffer.h"
 #include "platform/NonCopyable.h"
+#include "platform/Span.h"
 
 #ifndef MBED_CONF_DRIVERS_UART_SERIAL_RXBUF_SIZE
 #define MBED_CONF_DRIVERS_UART_SERIAL_RXBUF_SIZE  256
@@ -171,6 +173,31 @@ public:
      */
     virtual void sigio(Callback<void()> func);
 
+    /** Start reading, see FileHandle::read_async()
+     *
+     *  A read that can't complete at once is completed by the receive
+     *  interrupt, which calls the callback.
+     *
+     *  @param buffer   The buffer to read in to, valid until the callback
+     *  @param length   The number of bytes to read
+     *  @param done     Called with the number of bytes read
+     *  @return         0 once started, -EBUSY if a read is already pending
+     */
+    virtual int read_async(void *buffer, size_t length, Callback<void(ssize_t)> done);
+
+    /** Start writing, see FileHandle::write_async()
+     *
+     *  A write that finds the transmit buffer full is completed by the
+     *  transmit interrupt freeing room, which calls the callback with the
+     *  number of bytes that fit.
+     *
+     *  @param buffer   The buffer to write from, valid until the callback
+     *  @param length   The number of bytes to write
+     *  @param done     Called with the number of bytes written
+     *  @return         0 once started, -EBUSY if a write is already pending
+     */
+    virtual int write_async(const void *buffer, size_t length, Callback<void(ssize_t)> done);
+
     /** Setup interrupt handler for DCD line
      *
      *  If DCD line is connected, an IRQ handler will be setup.
@@ -223,6 +250,65 @@ public:
     void set_flow_control(Flow type, PinName flow1 = NC, PinName flow2 = NC);
 #endif
 
+#if DEVICE_SERIAL_ASYNCH
+    /** Enable or disable DMA receive mode
+     *
+     *  In DMA receive mode the serial peripheral writes received data
+     *  straight into one half of a receive buffer of
+     *  MBED_CONF_DRIVERS_UART_SERIAL_RXBUF_SIZE bytes, instead of the receive
+     *  interrupt pushing it in one byte at a time. While the reader drains
+     *  one half the peripheral fills the other. A half is handed to the
+     *  reader when it is full, or early when the delimiter is received.
+     *
+     *  The serial HAL has no idle line detection, so data that is not
+     *  followed by the delimiter is only delivered once its half fills.
+     *  Use a delimiter that ends every message of the protocol, such as
+     *  the line feed ending AT command responses.
+     *
+     *  @param enabled      True to enable DMA receive mode
+     *  @param delimiter    Character ending a transfer early, or
+     *                      SERIAL_RESERVED_CHAR_MATCH for none
+     *                      (defaults to '\n')
+     *  @return             0 on success, -ENOMEM if the buffer could not be
+     *                      allocated
+     */
+    int set_dma_rx(bool enabled, unsigned char delimiter = '\n');
+
+    /** Access received data without copying it
+     *
+     *  Returns the oldest contiguous run of received data, in place in the
+     *  DMA receive buffer. The data stays valid until it is released with
+     *  rx_consume. Only available in DMA receive mode.
+     *
+     *  @return             Received data, empty if nothing is available
+     */
+    Span<const uint8_t> rx_peek();
+
+    /** Release received data returned by rx_peek
+     *
+     *  @param length       Number of bytes to release, at most the size of
+     *                      the span last returned by rx_peek
+     */
+    void rx_consume(size_t length);
+
+    /** Enable or disable DMA transmit mode
+     *
+     *  In DMA transmit mode the serial peripheral reads queued data straight
+     *  out of the transmit buffer, one contiguous run per transfer, instead
+     *  of the transmit interrupt writing it out one byte at a time. Writes
+     *  still only copy into the transmit buffer and return.
+     *
+     *  Disabling waits for the ongoing transfer to end, then any remaining
+     *  data is sent by the transmit interrupt.
+     *
+     *  Instances start in DMA transmit mode when drivers.uart-serial-dma-tx
+     *  is set.
+     *
+     *  @param enabled      True to enable DMA transmit mode
+     */
+    void set_dma_tx(bool enabled);
+#endif
+
 private:
 
     void wait_ms(uint32_t millisec);
@@ -242,11 +328,24 @@ private:
     /** Unbuffered write - invoked when write called from critical section */
     ssize_t write_unbuffered(const char *buf_ptr, size_t length);
 
+    /** Nonblocking transfers, by the api_lock holder or a pending async transfer */
+    bool rx_available() const;
+    size_t read_available(char *ptr, size_t length);
+    size_t write_available(const char *buf_ptr, size_t length);
+    void async_complete();
+
     /** Software serial buffers
      *  By default buffer size is 256 for TX and 256 for RX. Configurable through mbed_app.json
+     *  Each buffer has one producer and one consumer, the interrupt handler
+     *  and the api_lock holder, so they can be lock-free.
      */
+#if MBED_CONF_DRIVERS_UART_SERIAL_LOCK_FREE
+    SPSCRingBuffer<char, MBED_CONF_DRIVERS_UART_SERIAL_RXBUF_SIZE> _rxbuf;
+    SPSCRingBuffer<char, MBED_CONF_DRIVERS_UART_SERIAL_TXBUF_SIZE> _txbuf;
+#else
     CircularBuffer<char, MBED_CONF_DRIVERS_UART_SERIAL_RXBUF_SIZE> _rxbuf;
     CircularBuffer<char, MBED_CONF_DRIVERS_UART_SERIAL_TXBUF_SIZE> _txbuf;
+#endif
 
     PlatformMutex _mutex;
 
@@ -257,6 +356,14 @@ private:
     bool _rx_irq_enabled;
     InterruptIn *_dcd_irq;
 
+    /** Pending async transfers, completed from wake() */
+    char *_async_rbuf;
+    size_t _async_rlen;
+    Callback<void(ssize_t)> _async_read_cb;
+    const char *_async_wbuf;
+    size_t _async_wlen;
+    Callback<void(ssize_t)> _async_write_cb;
+
     /** Device Hanged up
      *  Determines if the device hanged up on us.
      *
@@ -276,6 +383,37 @@ private:
 
     void dcd_irq(void);
 
+#if DEVICE_SERIAL_ASYNCH
+    /** DMA receive mode
+     *  _dma_len holds the number of received bytes in each half of
+     *  _dma_rx, zero while the half is free or still being received.
+     */
+    static const size_t DMA_RX_HALF = MBED_CONF_DRIVERS_UART_SERIAL_RXBUF_SIZE / 2;
+
+    bool dma_rx_readable() const;
+    void dma_rx_start(uint8_t half);
+    void dma_rx_event(int event);
+
+    uint8_t *_dma_rx;
+    volatile size_t _dma_len[2];
+    size_t _dma_offset;
+    uint8_t _dma_head;
+    volatile uint8_t _dma_active;
+    volatile bool _dma_receiving;
+    unsigned char _dma_delimiter;
+
+    /** DMA transmit mode
+     *  _dma_tx_len holds the size of the run of _txbuf being transmitted,
+     *  released from _txbuf once the transfer completes.
+     */
+    void dma_tx_start();
+    void dma_tx_event(int event);
+
+    bool _dma_tx;
+    volatile bool _dma_sending;
+    size_t _dma_tx_len;
+#endif
+
 };
 } //namespace mbed
 
@@ -59,6 +59,7 @@ public:
             _event->id = 0;
             _event->delay = 0;
             _event->period = -1;
+            _event->priority = 0;
 
             _event->post = &Event::event_post<F>;
             _event->dtor = &Event::event_dtor<F>;
@@ -127,6 +128,21 @@ public:
         }
     }
 
+    /** Configure the priority of an event
+     *
+     *  Due events are dispatched in order of priority, higher priorities
+     *  first. Priorities are clamped to the range 0 to EQUEUE_PRIORITIES-1,
+     *  with 0 being the default.
+     *
+     *  @param priority Dispatch priority of the event
+     */
+    void priority(int priority)
+    {
+        if (_event) {
+            _event->priority = priority;
+        }
+    }
+
     /** Posts an event onto the underlying event queue
      *
      *  The event is posted to the underlying queue and is executed in the
@@ -201,6 +217,7 @@ private:
 
         int delay;
         int period;
+        int priority;
 
         int (*post)(struct event *);
         void (*dtor)(struct event *);
@@ -221,7 +238,8 @@ private:
         new (p) C(*(F *)(e + 1));
         equeue_event_delay(p, e->delay);
         equeue_event_period(p, e->period);
-        equeue_event_dtor(p, &EventQueue::function_dtor<C>);
+        equeue_event_priority(p, e->priority);
+        EventQueue::function_register_dtor<C>(p);
         return equeue_post(e->equeue, &EventQueue::function_call<C>, p);
     }
 
@@ -511,6 +529,7 @@ public:
             _event->id = 0;
             _event->delay = 0;
             _event->period = -1;
+            _event->priority = 0;
 
             _event->post = &Event::event_post<F>;
             _event->dtor = &Event::event_dtor<F>;
@@ -579,6 +598,21 @@ public:
         }
     }
 
+    /** Configure the priority of an event
+     *
+     *  Due events are dispatched in order of priority, higher priorities
+     *  first. Priorities are clamped to the range 0 to EQUEUE_PRIORITIES-1,
+     *  with 0 being the default.
+     *
+     *  @param priority Dispatch priority of the event
+     */
+    void priority(int priority)
+    {
+        if (_event) {
+            _event->priority = priority;
+        }
+    }
+
     /** Posts an event onto the underlying event queue
      *
      *  The event is posted to the underlying queue and is executed in the
@@ -657,6 +691,7 @@ private:
 
         int delay;
         int period;
+        int priority;
 
         int (*post)(struct event *, A0 a0);
         void (*dtor)(struct event *);
@@ -677,7 +712,8 @@ private:
         new (p) C(*(F *)(e + 1), a0);
         equeue_event_delay(p, e->delay);
         equeue_event_period(p, e->period);
-        equeue_event_dtor(p, &EventQueue::function_dtor<C>);
+        equeue_event_priority(p, e->priority);
+        EventQueue::function_register_dtor<C>(p);
         return equeue_post(e->equeue, &EventQueue::function_call<C>, p);
     }
 
@@ -967,6 +1003,7 @@ public:
             _event->id = 0;
             _event->delay = 0;
             _event->period = -1;
+            _event->priority = 0;
 
             _event->post = &Event::event_post<F>;
             _event->dtor = &Event::event_dtor<F>;
@@ -1035,6 +1072,21 @@ public:
         }
     }
 
+    /** Configure the priority of an event
+     *
+     *  Due events are dispatched in order of priority, higher priorities
+     *  first. Priorities are clamped to the range 0 to EQUEUE_PRIORITIES-1,
+     *  with 0 being the default.
+     *
+     *  @param priority Dispatch priority of the event
+     */
+    void priority(int priority)
+    {
+        if (_event) {
+            _event->priority = priority;
+        }
+    }
+
     /** Posts an event onto the underlying event queue
      *
      *  The event is posted to the underlying queue and is executed in the
@@ -1113,6 +1165,7 @@ private:
 
         int delay;
         int period;
+        int priority;
 
         int (*post)(struct event *, A0 a0, A1 a1);
         void (*dtor)(struct event *);
@@ -1133,7 +1186,8 @@ private:
         new (p) C(*(F *)(e + 1), a0, a1);
         equeue_event_delay(p, e->delay);
         equeue_event_period(p, e->period);
-        equeue_event_dtor(p, &EventQueue::function_dtor<C>);
+        equeue_event_priority(p, e->priority);
+        EventQueue::function_register_dtor<C>(p);
         return equeue_post(e->equeue, &EventQueue::function_call<C>, p);
     }
 
@@ -1423,6 +1477,7 @@ public:
             _event->id = 0;
             _event->delay = 0;
             _event->period = -1;
+            _event->priority = 0;
 
             _event->post = &Event::event_post<F>;
             _event->dtor = &Event::event_dtor<F>;
@@ -1491,6 +1546,21 @@ public:
         }
     }
 
+    /** Configure the priority of an event
+     *
+     *  Due events are dispatched in order of priority, higher priorities
+     *  first. Priorities are clamped to the range 0 to EQUEUE_PRIORITIES-1,
+     *  with 0 being the default.
+     *
+     *  @param priority Dispatch priority of the event
+     */
+    void priority(int priority)
+    {
+        if (_event) {
+            _event->priority = priority;
+        }
+    }
+
     /** Posts an event onto the underlying event queue
      *
      *  The event is posted to the underlying queue and is executed in the
@@ -1569,6 +1639,7 @@ private:
 
         int delay;
         int period;
+        int priority;
 
         int (*post)(struct event *, A0 a0, A1 a1, A2 a2);
         void (*dtor)(struct event *);
@@ -1589,7 +1660,8 @@ private:
         new (p) C(*(F *)(e + 1), a0, a1, a2);
         equeue_event_delay(p, e->delay);
         equeue_event_period(p, e->period);
-        equeue_event_dtor(p, &EventQueue::function_dtor<C>);
+        equeue_event_priority(p, e->priority);
+        EventQueue::function_register_dtor<C>(p);
         return equeue_post(e->equeue, &EventQueue::function_call<C>, p);
     }
 
@@ -1879,6 +1951,7 @@ public:
             _event->id = 0;
             _event->delay = 0;
             _event->period = -1;
+            _event->priority = 0;
 
             _event->post = &Event::event_post<F>;
             _event->dtor = &Event::event_dtor<F>;
@@ -1947,6 +2020,21 @@ public:
         }
     }
 
+    /** Configure the priority of an event
+     *
+     *  Due events are dispatched in order of priority, higher priorities
+     *  first. Priorities are clamped to the range 0 to EQUEUE_PRIORITIES-1,
+     *  with 0 being the default.
+     *
+     *  @param priority Dispatch priority of the event
+     */
+    void priority(int priority)
+    {
+        if (_event) {
+            _event->priority = priority;
+        }
+    }
+
     /** Posts an event onto the underlying event queue
      *
      *  The event is posted to the underlying queue and is executed in the
@@ -2025,6 +2113,7 @@ private:
 
         int delay;
         int period;
+        int priority;
 
         int (*post)(struct event *, A0 a0, A1 a1, A2 a2, A3 a3);
         void (*dtor)(struct event *);
@@ -2045,7 +2134,8 @@ private:
         new (p) C(*(F *)(e + 1), a0, a1, a2, a3);
         equeue_event_delay(p, e->delay);
         equeue_event_period(p, e->period);
-        equeue_event_dtor(p, &EventQueue::function_dtor<C>);
+        equeue_event_priority(p, e->priority);
+        EventQueue::function_register_dtor<C>(p);
         return equeue_post(e->equeue, &EventQueue::function_call<C>, p);
     }
 
@@ -2336,6 +2426,7 @@ public:
             _event->id = 0;
             _event->delay = 0;
             _event->period = -1;
+            _event->priority = 0;
 
             _event->post = &Event::event_post<F>;
             _event->dtor = &Event::event_dtor<F>;
@@ -2404,6 +2495,21 @@ public:
         }
     }
 
+    /** Configure the priority of an event
+     *
+     *  Due events are dispatched in order of priority, higher priorities
+     *  first. Priorities are clamped to the range 0 to EQUEUE_PRIORITIES-1,
+     *  with 0 being the default.
+     *
+     *  @param priority Dispatch priority of the event
+     */
+    void priority(int priority)
+    {
+        if (_event) {
+            _event->priority = priority;
+        }
+    }
+
     /** Posts an event onto the underlying event queue
      *
      *  The event is posted to the underlying queue and is executed in the
@@ -2482,6 +2588,7 @@ private:
 
         int delay;
         int period;
+        int priority;
 
         int (*post)(struct event *, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4);
         void (*dtor)(struct event *);
@@ -2502,7 +2609,8 @@ private:
         new (p) C(*(F *)(e + 1), a0, a1, a2, a3, a4);
         equeue_event_delay(p, e->delay);
         equeue_event_period(p, e->period);
-        equeue_event_dtor(p, &EventQueue::function_dtor<C>);
+        equeue_event_priority(p, e->priority);
+        EventQueue::function_register_dtor<C>(p);
         return equeue_post(e->equeue, &EventQueue::function_call<C>, p);
     }
 
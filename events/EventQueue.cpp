@@ -30,6 +30,12 @@ EventQueue::EventQueue(unsigned event_size, unsigned char *event_pointer)
     }
 }
 
+EventQueue::EventQueue(unsigned event_size, unsigned char *event_pointer,
+                       const size_t *classes, int count)
+{
+    equeue_create_classes(&_equeue, event_size, event_pointer, classes, count);
+}
+
 EventQueue::~EventQueue()
 {
     equeue_destroy(&_equeue);
@@ -40,6 +46,16 @@ void EventQueue::dispatch(int ms)
     return equeue_dispatch(&_equeue, ms);
 }
 
+int EventQueue::dispatch_due()
+{
+    return equeue_dispatch_due(&_equeue);
+}
+
+int EventQueue::deadline()
+{
+    return equeue_deadline(&_equeue);
+}
+
 void EventQueue::break_dispatch()
 {
     return equeue_break(&_equeue);
@@ -71,6 +87,21 @@ void EventQueue::background(Callback<void(int)> update)
     }
 }
 
+void EventQueue::get_stats(equeue_stats_t *stats)
+{
+    return equeue_get_stats(&_equeue, stats);
+}
+
+int EventQueue::get_class_stats(equeue_class_stats_t *stats, int count)
+{
+    return equeue_get_class_stats(&_equeue, stats, count);
+}
+
+void EventQueue::reset_stats()
+{
+    return equeue_reset_stats(&_equeue);
+}
+
 int EventQueue::chain(EventQueue *target)
 {
     if (target) {
@@ -42,6 +42,8 @@ namespace events {
 // Predeclared classes
 template <typename F>
 class Event;
+template <typename F>
+class UserAllocatedEvent;
 
 
 /** EventQueue
@@ -63,6 +65,23 @@ public:
      */
     EventQueue(unsigned size = EVENTS_QUEUE_SIZE, unsigned char *buffer = NULL);
 
+    /** Create an EventQueue with allocation size classes
+     *
+     *  Create an event queue whose allocations are rounded up to one of the
+     *  given size classes, each served from its own constant time free
+     *  list. Events larger than every class use the general allocator.
+     *  Use get_class_stats to find out how many events of each class an
+     *  application needs.
+     *
+     *  @param size     Size of buffer to use for events in bytes
+     *  @param buffer   Pointer to buffer to use for events, or NULL to
+     *                  allocate the buffer with malloc
+     *  @param classes  Array of event sizes in bytes to use as size classes
+     *  @param count    Number of size classes, at most EQUEUE_CLASSES
+     */
+    EventQueue(unsigned size, unsigned char *buffer,
+               const size_t *classes, int count);
+
     /** Destroy an EventQueue
      */
     ~EventQueue();
@@ -95,6 +114,27 @@ public:
         dispatch();
     }
 
+    /** Dispatch only the events that are currently due
+     *
+     *  Executes every event whose time has come and returns without
+     *  waiting. Unlike dispatch, dispatch_due does not affect background
+     *  timers or pending calls to break_dispatch, so multiple threads may
+     *  call dispatch_due on the same queue at once. Each event is still
+     *  dispatched exactly once.
+     *
+     *  @return         Number of events dispatched
+     */
+    int dispatch_due();
+
+    /** Query the time until the next event
+     *
+     *  @return         Milliseconds until the next event is due, 0 if an
+     *                  event is already due, or -1 if the queue is empty
+     *
+     *  @note This function is IRQ safe.
+     */
+    int deadline();
+
     /** Break out of a running event loop
      *
      *  Forces the specified event queue's dispatch loop to terminate. Pending
@@ -187,8 +227,98 @@ public:
      */
     int chain(EventQueue *target);
 
+    /** Query the dispatch statistics of the event queue
+     *
+     *  Reports how late events were dispatched compared to when they were
+     *  due, and how long their callbacks ran, as log2 histograms in
+     *  milliseconds. The slowest member points at the dispatch function of
+     *  the longest running event, which is distinct for each callback type
+     *  and can be looked up in the map file.
+     *
+     *  Statistics are only recorded if events.dispatch-stats-enabled is
+     *  set, otherwise the structure is zeroed.
+     *
+     *  This function is IRQ safe.
+     *
+     *  @param stats    Structure to fill with the dispatch statistics
+     */
+    void get_stats(equeue_stats_t *stats);
+
+    /** Query the allocation statistics of the event queue
+     *
+     *  Fills one entry for each size class, in order of size, followed by
+     *  one entry with a size of 0 for the general allocator. Each entry
+     *  reports how many chunks of the buffer the class uses and how many
+     *  events are, and have at most been, allocated from it.
+     *
+     *  This function is IRQ safe.
+     *
+     *  @param stats    Array of entries to fill
+     *  @param count    Number of entries in stats
+     *  @return         Number of entries available
+     */
+    int get_class_stats(equeue_class_stats_t *stats, int count);
+
+    /** Reset the dispatch statistics of the event queue
+     *
+     *  This function is IRQ safe.
+     */
+    void reset_stats();
+
 
 
+    /** Calls a batch of events on the queue
+     *
+     *  Each of the specified callbacks will be executed in the context of
+     *  the event queue's dispatch loop, in order. All of the events are
+     *  allocated and inserted into the queue at once, which is cheaper than
+     *  calling each of them individually.
+     *
+     *  The call_batch function is IRQ safe and can act as a mechanism for
+     *  moving events out of IRQ contexts.
+     *
+     *  @param fs       Array of functions to execute in the context of the
+     *                  dispatch loop
+     *  @param count    Number of functions in fs
+     *  @param ids      Optional array of count entries that receives the
+     *                  unique IDs of the posted events
+     *  @return         The number of events posted, either count, or 0 if
+     *                  there is not enough memory to allocate all of the
+     *                  events, in which case none are posted.
+     *
+     * @code
+     *     #include "mbed.h"
+     *
+     *     void sample_x() { ... }
+     *     void sample_y() { ... }
+     *
+     *     EventQueue queue;
+     *     const Callback<void()> samples[] = { sample_x, sample_y };
+     *
+     *     void frame_isr()
+     *     {
+     *         // post both samples with a single allocation and insert
+     *         queue.call_batch(samples, 2);
+     *     }
+     * @endcode
+     */
+    template <typename F>
+    int call_batch(const F *fs, int count, int *ids = 0)
+    {
+        void *p = equeue_alloc_batch(&_equeue, sizeof(F), count);
+        if (!p) {
+            return 0;
+        }
+
+        int i = 0;
+        for (void *e = p; e; e = equeue_batch_next(e)) {
+            new (e) F(fs[i++]);
+            function_register_dtor<F>(e);
+        }
+
+        return equeue_post_batch(&_equeue, &EventQueue::function_call<F>, p, ids);
+    }
+
 #if defined(DOXYGEN_ONLY)
     /** Calls an event on the queue
      *
@@ -630,7 +760,7 @@ public:
         }
 
         F *e = new (p) F(f);
-        equeue_event_dtor(e, &EventQueue::function_dtor<F>);
+        function_register_dtor<F>(e);
         return equeue_post(&_equeue, &EventQueue::function_call<F>, e);
     }
 
@@ -930,7 +1060,7 @@ public:
 
         F *e = new (p) F(f);
         equeue_event_delay(e, ms);
-        equeue_event_dtor(e, &EventQueue::function_dtor<F>);
+        function_register_dtor<F>(e);
         return equeue_post(&_equeue, &EventQueue::function_call<F>, e);
     }
 
@@ -1238,7 +1368,7 @@ public:
         F *e = new (p) F(f);
         equeue_event_delay(e, ms);
         equeue_event_period(e, ms);
-        equeue_event_dtor(e, &EventQueue::function_dtor<F>);
+        function_register_dtor<F>(e);
         return equeue_post(&_equeue, &EventQueue::function_call<F>, e);
     }
 
@@ -2825,6 +2955,8 @@ protected:
 #if !defined(DOXYGEN_ONLY)
     template <typename F>
     friend class Event;
+    template <typename F>
+    friend class UserAllocatedEvent;
     struct equeue _equeue;
     mbed::Callback<void(int)> _update;
 
@@ -2841,6 +2973,16 @@ protected:
         ((F *)p)->~F();
     }
 
+    // Trivially destructible functions, such as plain function pointers and
+    // contexts holding them, need no destructor call when deallocated
+    template <typename F>
+    static void function_register_dtor(void *p)
+    {
+        if (!__has_trivial_destructor(F)) {
+            equeue_event_dtor(p, &EventQueue::function_dtor<F>);
+        }
+    }
+
     // Context structures
     template <typename F>
     struct context00 {
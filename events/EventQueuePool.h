@@ -0,0 +1,483 @@
+/** \addtogroup events */
+/** @{*/
+/* events
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef EVENT_QUEUE_POOL_H
+#define EVENT_QUEUE_POOL_H
+
+#include "events/EventQueue.h"
+#include "rtos/Thread.h"
+#include "rtos/ThisThread.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_critical.h"
+#include "platform/NonCopyable.h"
+
+namespace events {
+
+/** EventQueuePool
+ *
+ *  Flexible event queue dispatched by a fixed set of worker threads
+ *
+ *  Each worker thread owns a shared queue and a pinned queue. Events posted
+ *  with call, call_in and call_every are spread across the shared queues,
+ *  and a worker that runs out of due events on its own queues takes due
+ *  events from the shared queues of its siblings. Events posted to a pinned
+ *  queue, obtained through keyed, only ever run on the owning worker, so
+ *  events posted with the same key execute in order.
+ *
+ *  @tparam Workers     Number of worker threads
+ *  @tparam QueueSize   Size of each of the worker queues in bytes
+ */
+template <unsigned Workers, unsigned QueueSize = EVENTS_QUEUE_SIZE>
+class EventQueuePool : private mbed::NonCopyable<EventQueuePool<Workers, QueueSize> > {
+    MBED_STRUCT_STATIC_ASSERT(Workers > 0 && Workers < 128,
+                              "EventQueuePool needs between 1 and 127 workers");
+
+public:
+    /** Create an EventQueuePool
+     *
+     *  The worker threads are created but not started, call start to begin
+     *  dispatching events.
+     *
+     *  @param priority     Priority of the worker threads
+     *  @param stack_size   Stack size of each worker thread in bytes
+     */
+    EventQueuePool(osPriority priority = osPriorityNormal,
+                   uint32_t stack_size = OS_STACK_SIZE)
+        : _next(0), _stopping(false)
+    {
+        for (unsigned i = 0; i < Workers; i++) {
+            _workers[i].pool = this;
+            _workers[i].index = i;
+            _workers[i].started = false;
+            _workers[i].idle = false;
+            _workers[i].thread = new rtos::Thread(priority, stack_size);
+            _workers[i].shared.background(
+                mbed::callback(&_workers[i], &Worker::wake_any));
+            _workers[i].pinned.background(
+                mbed::callback(&_workers[i], &Worker::wake_owner));
+        }
+    }
+
+    /** Destroy an EventQueuePool
+     *
+     *  Stops and joins the worker threads. Events still pending are
+     *  discarded.
+     */
+    ~EventQueuePool()
+    {
+        _stopping = true;
+        for (unsigned i = 0; i < Workers; i++) {
+            if (_workers[i].started) {
+                _workers[i].thread->flags_set(WAKE);
+            }
+        }
+
+        for (unsigned i = 0; i < Workers; i++) {
+            if (_workers[i].started) {
+                _workers[i].thread->join();
+                _workers[i].started = false;
+            }
+        }
+
+        for (unsigned i = 0; i < Workers; i++) {
+            _workers[i].shared.background(0);
+            _workers[i].pinned.background(0);
+            delete _workers[i].thread;
+        }
+    }
+
+    /** Start the worker threads
+     *
+     *  @return         Status code from starting the last worker, osOK on
+     *                  success
+     */
+    osStatus start()
+    {
+        osStatus status = osOK;
+        for (unsigned i = 0; i < Workers && status == osOK; i++) {
+            status = _workers[i].thread->start(
+                         mbed::callback(&_workers[i], &Worker::run));
+            _workers[i].started = (status == osOK);
+        }
+
+        return status;
+    }
+
+    /** Cancel an in-flight event
+     *
+     *  Accepts ids returned by call, call_in and call_every on the pool.
+     *  Events posted through keyed must be cancelled on the queue returned
+     *  by keyed.
+     *
+     *  @param id       Unique id of the event
+     *  @see EventQueue::cancel
+     */
+    void cancel(int id)
+    {
+        unsigned tag = (unsigned)id >> TAG_SHIFT;
+        if (!tag || tag > Workers) {
+            return;
+        }
+
+        // the tag overwrote the top bits of the queue's id, try each value
+        // they could have had, at most one of them can match a live event
+        EventQueue &q = _workers[tag - 1].shared;
+        unsigned low = (unsigned)id & ((1u << TAG_SHIFT) - 1);
+        for (unsigned top = 0; top < (1u << TAG_BITS); top++) {
+            q.cancel((int)((top << TAG_SHIFT) | low));
+        }
+    }
+
+    /** Get the queue pinned to a key
+     *
+     *  Events posted to the returned queue always run on the same worker,
+     *  in order, so the key can be used to serialize related work.
+     *
+     *  @param key      Key identifying a stream of ordered work
+     *  @return         Queue owned by the worker assigned to the key
+     */
+    EventQueue *keyed(unsigned key)
+    {
+        return &_workers[key % Workers].pinned;
+    }
+
+    /** Calls an event on the pool
+     *
+     *  Forwards to EventQueue::call on one of the workers' shared queues.
+     *  Any idle worker may execute the callback, so callbacks posted this
+     *  way are not ordered relative to each other.
+     *
+     *  @param f        Function to execute in the context of a worker
+     *  @return         A unique id that represents the posted event and can
+     *                  be passed to cancel, or an id of 0 if there is not
+     *                  enough memory to allocate the event.
+     */
+    template <typename F>
+    int call(F f)
+    {
+        unsigned i = next();
+        return encode(i, _workers[i].shared.call(f));
+    }
+
+    /** Calls an event on the pool
+     *  @see EventQueuePool::call
+     */
+    template <typename F, typename A0>
+    int call(F f, A0 a0)
+    {
+        unsigned i = next();
+        return encode(i, _workers[i].shared.call(f, a0));
+    }
+
+    /** Calls an event on the pool
+     *  @see EventQueuePool::call
+     */
+    template <typename F, typename A0, typename A1>
+    int call(F f, A0 a0, A1 a1)
+    {
+        unsigned i = next();
+        return encode(i, _workers[i].shared.call(f, a0, a1));
+    }
+
+    /** Calls an event on the pool
+     *  @see EventQueuePool::call
+     */
+    template <typename F, typename A0, typename A1, typename A2>
+    int call(F f, A0 a0, A1 a1, A2 a2)
+    {
+        unsigned i = next();
+        return encode(i, _workers[i].shared.call(f, a0, a1, a2));
+    }
+
+    /** Calls an event on the pool
+     *  @see EventQueuePool::call
+     */
+    template <typename F, typename A0, typename A1, typename A2, typename A3>
+    int call(F f, A0 a0, A1 a1, A2 a2, A3 a3)
+    {
+        unsigned i = next();
+        return encode(i, _workers[i].shared.call(f, a0, a1, a2, a3));
+    }
+
+    /** Calls an event on the pool
+     *  @see EventQueuePool::call
+     */
+    template <typename F, typename A0, typename A1, typename A2, typename A3, typename A4>
+    int call(F f, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4)
+    {
+        unsigned i = next();
+        return encode(i, _workers[i].shared.call(f, a0, a1, a2, a3, a4));
+    }
+
+    /** Calls an event on the pool after a specified delay
+     *
+     *  Forwards to EventQueue::call_in on one of the workers' shared queues.
+     *  Any idle worker may execute the callback, so callbacks posted this
+     *  way are not ordered relative to each other.
+     *
+     *  @param ms       Time to delay in milliseconds
+     *  @param f        Function to execute in the context of a worker
+     *  @return         A unique id that represents the posted event and can
+     *                  be passed to cancel, or an id of 0 if there is not
+     *                  enough memory to allocate the event.
+     */
+    template <typename F>
+    int call_in(int ms, F f)
+    {
+        unsigned i = next();
+        return encode(i, _workers[i].shared.call_in(ms, f));
+    }
+
+    /** Calls an event on the pool after a specified delay
+     *  @see EventQueuePool::call_in
+     */
+    template <typename F, typename A0>
+    int call_in(int ms, F f, A0 a0)
+    {
+        unsigned i = next();
+        return encode(i, _workers[i].shared.call_in(ms, f, a0));
+    }
+
+    /** Calls an event on the pool after a specified delay
+     *  @see EventQueuePool::call_in
+     */
+    template <typename F, typename A0, typename A1>
+    int call_in(int ms, F f, A0 a0, A1 a1)
+    {
+        unsigned i = next();
+        return encode(i, _workers[i].shared.call_in(ms, f, a0, a1));
+    }
+
+    /** Calls an event on the pool after a specified delay
+     *  @see EventQueuePool::call_in
+     */
+    template <typename F, typename A0, typename A1, typename A2>
+    int call_in(int ms, F f, A0 a0, A1 a1, A2 a2)
+    {
+        unsigned i = next();
+        return encode(i, _workers[i].shared.call_in(ms, f, a0, a1, a2));
+    }
+
+    /** Calls an event on the pool after a specified delay
+     *  @see EventQueuePool::call_in
+     */
+    template <typename F, typename A0, typename A1, typename A2, typename A3>
+    int call_in(int ms, F f, A0 a0, A1 a1, A2 a2, A3 a3)
+    {
+        unsigned i = next();
+        return encode(i, _workers[i].shared.call_in(ms, f, a0, a1, a2, a3));
+    }
+
+    /** Calls an event on the pool after a specified delay
+     *  @see EventQueuePool::call_in
+     */
+    template <typename F, typename A0, typename A1, typename A2, typename A3, typename A4>
+    int call_in(int ms, F f, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4)
+    {
+        unsigned i = next();
+        return encode(i, _workers[i].shared.call_in(ms, f, a0, a1, a2, a3, a4));
+    }
+
+    /** Calls an event on the pool periodically
+     *
+     *  Forwards to EventQueue::call_every on one of the workers' shared queues.
+     *  Any idle worker may execute the callback, so callbacks posted this
+     *  way are not ordered relative to each other.
+     *
+     *  @param ms       Period of the event in milliseconds
+     *  @param f        Function to execute in the context of a worker
+     *  @return         A unique id that represents the posted event and can
+     *                  be passed to cancel, or an id of 0 if there is not
+     *                  enough memory to allocate the event.
+     */
+    template <typename F>
+    int call_every(int ms, F f)
+    {
+        unsigned i = next();
+        return encode(i, _workers[i].shared.call_every(ms, f));
+    }
+
+    /** Calls an event on the pool periodically
+     *  @see EventQueuePool::call_every
+     */
+    template <typename F, typename A0>
+    int call_every(int ms, F f, A0 a0)
+    {
+        unsigned i = next();
+        return encode(i, _workers[i].shared.call_every(ms, f, a0));
+    }
+
+    /** Calls an event on the pool periodically
+     *  @see EventQueuePool::call_every
+     */
+    template <typename F, typename A0, typename A1>
+    int call_every(int ms, F f, A0 a0, A1 a1)
+    {
+        unsigned i = next();
+        return encode(i, _workers[i].shared.call_every(ms, f, a0, a1));
+    }
+
+    /** Calls an event on the pool periodically
+     *  @see EventQueuePool::call_every
+     */
+    template <typename F, typename A0, typename A1, typename A2>
+    int call_every(int ms, F f, A0 a0, A1 a1, A2 a2)
+    {
+        unsigned i = next();
+        return encode(i, _workers[i].shared.call_every(ms, f, a0, a1, a2));
+    }
+
+    /** Calls an event on the pool periodically
+     *  @see EventQueuePool::call_every
+     */
+    template <typename F, typename A0, typename A1, typename A2, typename A3>
+    int call_every(int ms, F f, A0 a0, A1 a1, A2 a2, A3 a3)
+    {
+        unsigned i = next();
+        return encode(i, _workers[i].shared.call_every(ms, f, a0, a1, a2, a3));
+    }
+
+    /** Calls an event on the pool periodically
+     *  @see EventQueuePool::call_every
+     */
+    template <typename F, typename A0, typename A1, typename A2, typename A3, typename A4>
+    int call_every(int ms, F f, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4)
+    {
+        unsigned i = next();
+        return encode(i, _workers[i].shared.call_every(ms, f, a0, a1, a2, a3, a4));
+    }
+
+private:
+    static const uint32_t WAKE = 1;
+
+    // ids are tagged with the index of the worker plus one in their top bits
+    static const unsigned TAG_BITS = (Workers < 2) ? 1 :
+                                     (Workers < 4) ? 2 :
+                                     (Workers < 8) ? 3 :
+                                     (Workers < 16) ? 4 :
+                                     (Workers < 32) ? 5 :
+                                     (Workers < 64) ? 6 : 7;
+    static const unsigned TAG_SHIFT = 32 - TAG_BITS;
+
+    struct Worker {
+        Worker() : shared(QueueSize), pinned(QueueSize) {}
+
+        void wake_owner(int ms)
+        {
+            if (ms >= 0 && started) {
+                thread->flags_set(WAKE);
+            }
+        }
+
+        void wake_any(int ms)
+        {
+            wake_owner(ms);
+
+            // idle siblings may take the event if the owner is busy
+            if (ms >= 0) {
+                for (unsigned i = 0; i < Workers; i++) {
+                    if (i != index && pool->_workers[i].idle) {
+                        pool->_workers[i].wake_owner(ms);
+                    }
+                }
+            }
+        }
+
+        void run()
+        {
+            pool->work(index);
+        }
+
+        EventQueue shared;
+        EventQueue pinned;
+        rtos::Thread *thread;
+        EventQueuePool *pool;
+        unsigned index;
+        volatile bool started;
+        volatile bool idle;
+    };
+
+    unsigned next()
+    {
+        return core_util_atomic_incr_u32(&_next, 1) % Workers;
+    }
+
+    static int encode(unsigned i, int id)
+    {
+        if (!id) {
+            return 0;
+        }
+
+        return (int)((((unsigned)id) & ((1u << TAG_SHIFT) - 1)) |
+                     ((i + 1) << TAG_SHIFT));
+    }
+
+    static int earliest(int a, int b)
+    {
+        if (a < 0) {
+            return b;
+        }
+
+        return (b >= 0 && b < a) ? b : a;
+    }
+
+    void work(unsigned i)
+    {
+        Worker &w = _workers[i];
+
+        while (!_stopping) {
+            // announce before looking for work, so events posted after this
+            // point leave a wake flag behind
+            w.idle = true;
+
+            int count = w.pinned.dispatch_due();
+            count += w.shared.dispatch_due();
+            for (unsigned j = 1; !count && j < Workers; j++) {
+                count = _workers[(i + j) % Workers].shared.dispatch_due();
+            }
+
+            if (count) {
+                continue;
+            }
+
+            // sleep until the earliest event this worker could run
+            int ms = w.pinned.deadline();
+            for (unsigned j = 0; j < Workers; j++) {
+                ms = earliest(ms, _workers[j].shared.deadline());
+            }
+
+            if (ms < 0) {
+                rtos::ThisThread::flags_wait_any(WAKE);
+            } else if (ms > 0) {
+                rtos::ThisThread::flags_wait_any_for(WAKE, ms);
+            }
+
+            w.idle = false;
+        }
+    }
+
+    Worker _workers[Workers];
+    volatile uint32_t _next;
+    volatile bool _stopping;
+};
+
+}
+
+#endif
+
+/** @}*/
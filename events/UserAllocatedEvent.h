@@ -0,0 +1,169 @@
+/* events
+ * Copyright (c) 2018 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef USER_ALLOCATED_EVENT_H
+#define USER_ALLOCATED_EVENT_H
+
+#include "events/EventQueue.h"
+#include "platform/NonCopyable.h"
+
+namespace events {
+/** \addtogroup events */
+
+/** UserAllocatedEvent
+ *
+ *  Event whose memory is owned by the object, typically embedded in the
+ *  object that posts it. Posting never allocates from the event queue's
+ *  buffer, so it cannot fail for lack of memory, and no destructor runs
+ *  after each dispatch. The function is called with no arguments.
+ *
+ *  The event can be posted again once its function has returned or it has
+ *  been cancelled. It must not be destroyed while it is posted.
+ *
+ *  @code
+ *  class Sensor {
+ *  public:
+ *      Sensor(EventQueue *queue)
+ *          : _sample(queue, mbed::callback(this, &Sensor::sample)) {}
+ *
+ *      void data_ready_isr()
+ *      {
+ *          _sample.call();
+ *      }
+ *
+ *  private:
+ *      void sample();
+ *
+ *      UserAllocatedEvent<mbed::Callback<void()> > _sample;
+ *  };
+ *  @endcode
+ * @ingroup events
+ */
+template <typename F>
+class UserAllocatedEvent : private mbed::NonCopyable<UserAllocatedEvent<F> > {
+public:
+    /** Create a user allocated event
+     *
+     *  @param q        Event queue the event is posted on by call
+     *  @param f        Function to execute when the event is dispatched
+     */
+    UserAllocatedEvent(EventQueue *q, F f)
+        : _queue(q), _posted_queue(0), _delay(0), _period(-1)
+    {
+        equeue_user_allocated_init(data());
+        new (data()) F(f);
+    }
+
+    /** Destroy the event, cancelling it if it is still pending
+     */
+    ~UserAllocatedEvent()
+    {
+        cancel();
+        ((F *)data())->~F();
+    }
+
+    /** Configure the delay of the event
+     *
+     *  Takes effect on the next post.
+     *
+     *  @param delay    Millisecond delay before dispatching the event
+     */
+    void delay(int delay)
+    {
+        _delay = delay;
+    }
+
+    /** Configure the period of the event
+     *
+     *  Takes effect on the next post. A periodic event stays posted until
+     *  it is cancelled.
+     *
+     *  @param period   Millisecond period for repeatedly dispatching the
+     *                  event, or a negative value to dispatch it once
+     */
+    void period(int period)
+    {
+        _period = period;
+    }
+
+    /** Post the event on its event queue
+     *
+     *  The call function is IRQ safe.
+     *
+     *  @return         true if the event was posted, false if it is still
+     *                  posted from an earlier call
+     */
+    bool call()
+    {
+        return call_on(_queue);
+    }
+
+    /** Post the event on another event queue
+     *
+     *  The call_on function is IRQ safe.
+     *
+     *  @param q        Event queue to post the event on
+     *  @return         true if the event was posted, false if it is still
+     *                  posted from an earlier call
+     */
+    bool call_on(EventQueue *q)
+    {
+        if (!equeue_post_user_allocated(&q->_equeue, _delay, _period,
+                                        &EventQueue::function_call<F>, data())) {
+            return false;
+        }
+
+        _posted_queue = q;
+        return true;
+    }
+
+    /** Cancel the event
+     *
+     *  The cancel function is IRQ safe. If called while the event queue's
+     *  dispatch loop is active, the event may already be executing.
+     *
+     *  @return         true if the event was cancelled before it was
+     *                  dispatched
+     */
+    bool cancel()
+    {
+        EventQueue *q = _posted_queue;
+        if (!q) {
+            return false;
+        }
+
+        return equeue_cancel_user_allocated(&q->_equeue, data());
+    }
+
+private:
+    void *data()
+    {
+        return (struct equeue_event *)_storage + 1;
+    }
+
+    EventQueue *_queue;
+    EventQueue *volatile _posted_queue;
+    int _delay;
+    int _period;
+
+    // struct equeue_event followed by F, as laid out by equeue_alloc
+    void *_storage[(sizeof(struct equeue_event) + sizeof(F) +
+                    sizeof(void *) - 1) / sizeof(void *)];
+};
+
+}
+
+#endif
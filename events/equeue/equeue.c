@@ -75,15 +75,29 @@ int equeue_create_inplace(equeue_t *q, size_t size, void *buffer)
     q->slab.size = size;
     q->slab.data = buffer;
 
+    memset(q->classes, 0, sizeof(q->classes));
+    memset(&q->general, 0, sizeof(q->general));
+    q->nclasses = 0;
+
     q->queue = 0;
+    q->pending = 0;
+#ifdef EQUEUE_TIMER_WHEEL
+    memset(&q->wheel, 0, sizeof(q->wheel));
+    q->wheel.now = equeue_tick();
+#endif
     q->tick = equeue_tick();
     q->generation = 0;
+    q->preempt = 0;
     q->break_requested = false;
 
     q->background.active = false;
     q->background.update = 0;
     q->background.timer = 0;
 
+#ifdef EQUEUE_STATS_ENABLED
+    memset(&q->stats, 0, sizeof(q->stats));
+#endif
+
     // initialize platform resources
     int err;
     err = equeue_sema_create(&q->eventsema);
@@ -104,9 +118,56 @@ int equeue_create_inplace(equeue_t *q, size_t size, void *buffer)
     return 0;
 }
 
+static void equeue_incorporate(equeue_t *q);
+
+static inline size_t equeue_mem_size(size_t size)
+{
+    // add event overhead
+    size += sizeof(struct equeue_event);
+    return (size + sizeof(void *) -1) & ~(sizeof(void *) -1);
+}
+
+int equeue_create_classes(equeue_t *q, size_t size, void *buffer,
+                          const size_t *classes, int count)
+{
+    if (count < 0 || count > EQUEUE_CLASSES) {
+        return -1;
+    }
+
+    int err = buffer ? equeue_create_inplace(q, size, buffer)
+              : equeue_create(q, size);
+    if (err) {
+        return err;
+    }
+
+    // keep classes sorted by size so the first fit is the best fit
+    for (int i = 0; i < count; i++) {
+        size_t csize = equeue_mem_size(classes[i]);
+
+        unsigned j = 0;
+        while (j < q->nclasses && q->classes[j].size < csize) {
+            j++;
+        }
+
+        if (j < q->nclasses && q->classes[j].size == csize) {
+            continue;
+        }
+
+        memmove(&q->classes[j + 1], &q->classes[j],
+                (q->nclasses - j) * sizeof(struct equeue_class));
+        memset(&q->classes[j], 0, sizeof(struct equeue_class));
+        q->classes[j].size = csize;
+        q->nclasses += 1;
+    }
+
+    return 0;
+}
+
 void equeue_destroy(equeue_t *q)
 {
     // call destructors on pending events
+    equeue_incorporate(q);
+#ifndef EQUEUE_TIMER_WHEEL
     for (struct equeue_event *es = q->queue; es; es = es->next) {
         for (struct equeue_event *e = es->sibling; e; e = e->sibling) {
             if (e->dtor) {
@@ -117,6 +178,20 @@ void equeue_destroy(equeue_t *q)
             es->dtor(es + 1);
         }
     }
+#else
+    for (unsigned i = 0; i < EQUEUE_WHEEL_LEVELS * EQUEUE_WHEEL_SLOTS + 2; i++) {
+        struct equeue_event *es =
+            (i < EQUEUE_WHEEL_LEVELS * EQUEUE_WHEEL_SLOTS)
+            ? q->wheel.slots[i / EQUEUE_WHEEL_SLOTS][i % EQUEUE_WHEEL_SLOTS]
+            : (i == EQUEUE_WHEEL_LEVELS * EQUEUE_WHEEL_SLOTS)
+            ? q->wheel.due : q->wheel.overflow;
+        for (struct equeue_event *e = es; e; e = e->next) {
+            if (e->dtor) {
+                e->dtor(e + 1);
+            }
+        }
+    }
+#endif
     // notify background timer
     if (q->background.update) {
         q->background.update(q->background.timer, -1);
@@ -131,13 +206,41 @@ void equeue_destroy(equeue_t *q)
 
 
 // equeue chunk allocation functions
-static struct equeue_event *equeue_mem_alloc(equeue_t *q, size_t size)
+static inline void equeue_mem_used(struct equeue_class *c)
 {
-    // add event overhead
-    size += sizeof(struct equeue_event);
-    size = (size + sizeof(void *) -1) & ~(sizeof(void *) -1);
+    c->used += 1;
+    if (c->used > c->high_water) {
+        c->high_water = c->used;
+    }
+}
 
-    equeue_mutex_lock(&q->memlock);
+static struct equeue_event *equeue_mem_take(equeue_t *q, size_t size)
+{
+    // size classes have constant time free lists, if a class runs out
+    // we can still borrow from a larger class
+    for (unsigned i = 0; i < q->nclasses; i++) {
+        struct equeue_class *c = &q->classes[i];
+        if (c->size < size) {
+            continue;
+        }
+
+        struct equeue_event *e = c->free;
+        if (e) {
+            c->free = e->next;
+        } else if (q->slab.size >= c->size) {
+            e = (struct equeue_event *)q->slab.data;
+            q->slab.data += c->size;
+            q->slab.size -= c->size;
+            e->size = c->size;
+            e->id = 1;
+            c->chunks += 1;
+        } else {
+            continue;
+        }
+
+        equeue_mem_used(c);
+        return e;
+    }
 
     // check if a good chunk is available
     for (struct equeue_event **p = &q->chunks; *p; p = &(*p)->next) {
@@ -150,7 +253,7 @@ static struct equeue_event *equeue_mem_alloc(equeue_t *q, size_t size)
                 *p = e->next;
             }
 
-            equeue_mutex_unlock(&q->memlock);
+            equeue_mem_used(&q->general);
             return e;
         }
     }
@@ -163,17 +266,77 @@ static struct equeue_event *equeue_mem_alloc(equeue_t *q, size_t size)
         e->size = size;
         e->id = 1;
 
-        equeue_mutex_unlock(&q->memlock);
+        q->general.chunks += 1;
+        equeue_mem_used(&q->general);
         return e;
     }
 
-    equeue_mutex_unlock(&q->memlock);
     return 0;
 }
 
+static void equeue_mem_give(equeue_t *q, struct equeue_event *e);
+
+static struct equeue_event *equeue_mem_alloc(equeue_t *q, size_t size)
+{
+    size = equeue_mem_size(size);
+
+    equeue_mutex_lock(&q->memlock);
+    struct equeue_event *e = equeue_mem_take(q, size);
+    equeue_mutex_unlock(&q->memlock);
+
+    return e;
+}
+
+// allocate a chain of events linked through next under a single lock,
+// either all of the events are allocated or none are
+static struct equeue_event *equeue_mem_alloc_chain(equeue_t *q,
+                                                   size_t size, int count)
+{
+    size = equeue_mem_size(size);
+
+    equeue_mutex_lock(&q->memlock);
+    struct equeue_event *head = 0;
+    for (int i = 0; i < count; i++) {
+        struct equeue_event *e = equeue_mem_take(q, size);
+        if (!e) {
+            while (head) {
+                struct equeue_event *n = head->next;
+                equeue_mem_give(q, head);
+                head = n;
+            }
+
+            break;
+        }
+
+        e->next = head;
+        head = e;
+    }
+    equeue_mutex_unlock(&q->memlock);
+
+    return head;
+}
+
 static void equeue_mem_dealloc(equeue_t *q, struct equeue_event *e)
 {
     equeue_mutex_lock(&q->memlock);
+    equeue_mem_give(q, e);
+    equeue_mutex_unlock(&q->memlock);
+}
+
+static void equeue_mem_give(equeue_t *q, struct equeue_event *e)
+{
+    // chunks from a size class go back onto the class's free list
+    for (unsigned i = 0; i < q->nclasses; i++) {
+        struct equeue_class *c = &q->classes[i];
+        if (c->size == e->size) {
+            e->next = c->free;
+            c->free = e;
+            c->used -= 1;
+            return;
+        }
+    }
+
+    q->general.used -= 1;
 
     // stick chunk into list of chunks
     struct equeue_event **p = &q->chunks;
@@ -189,8 +352,29 @@ static void equeue_mem_dealloc(equeue_t *q, struct equeue_event *e)
         e->next = *p;
     }
     *p = e;
+}
+
+static void equeue_class_stats(struct equeue_class *c,
+                               equeue_class_stats_t *stats)
+{
+    stats->size = c->size ? c->size - sizeof(struct equeue_event) : 0;
+    stats->chunks = c->chunks;
+    stats->used = c->used;
+    stats->high_water = c->high_water;
+}
 
+int equeue_get_class_stats(equeue_t *q, equeue_class_stats_t *stats,
+                           int count)
+{
+    equeue_mutex_lock(&q->memlock);
+    int n = q->nclasses + 1;
+    for (int i = 0; i < n && i < count; i++) {
+        equeue_class_stats((unsigned)i < q->nclasses ? &q->classes[i]
+                           : &q->general, &stats[i]);
+    }
     equeue_mutex_unlock(&q->memlock);
+
+    return n;
 }
 
 void *equeue_alloc(equeue_t *q, size_t size)
@@ -202,15 +386,41 @@ void *equeue_alloc(equeue_t *q, size_t size)
 
     e->target = 0;
     e->period = -1;
+    e->priority = 0;
     e->dtor = 0;
 
     return e + 1;
 }
 
+void *equeue_alloc_batch(equeue_t *q, size_t size, int count)
+{
+    struct equeue_event *head = equeue_mem_alloc_chain(q, size, count);
+    for (struct equeue_event *e = head; e; e = e->next) {
+        e->target = 0;
+        e->period = -1;
+        e->priority = 0;
+        e->dtor = 0;
+    }
+
+    return head ? head + 1 : 0;
+}
+
+void *equeue_batch_next(void *p)
+{
+    struct equeue_event *e = (struct equeue_event *)p - 1;
+    return e->next ? e->next + 1 : 0;
+}
+
 void equeue_dealloc(equeue_t *q, void *p)
 {
     struct equeue_event *e = (struct equeue_event *)p - 1;
 
+    // user allocated events only need to be marked as no longer posted
+    if (!e->size) {
+        e->id = 0;
+        return;
+    }
+
     if (e->dtor) {
         e->dtor(e + 1);
     }
@@ -220,15 +430,17 @@ void equeue_dealloc(equeue_t *q, void *p)
 
 
 // equeue scheduling functions
-static int equeue_enqueue(equeue_t *q, struct equeue_event *e, unsigned tick)
+static inline int equeue_id(equeue_t *q, struct equeue_event *e)
 {
-    // setup event and hash local id with buffer offset for unique id
-    int id = (e->id << q->npw2) | ((unsigned char *)e - q->buffer);
-    e->target = tick + equeue_clampdiff(e->target, tick);
-    e->generation = q->generation;
-
-    equeue_mutex_lock(&q->queuelock);
+    // hash local id with buffer offset for unique id
+    return (e->id << q->npw2) | ((unsigned char *)e - q->buffer);
+}
 
+#ifndef EQUEUE_TIMER_WHEEL
+// sorted list of slots, each slot holding a stack of siblings with the
+// same target
+static bool equeue_insert(equeue_t *q, struct equeue_event *e)
+{
     // find the event slot
     struct equeue_event **p = &q->queue;
     while (*p && equeue_tickdiff((*p)->target, e->target) < 0) {
@@ -256,41 +468,11 @@ static int equeue_enqueue(equeue_t *q, struct equeue_event *e, unsigned tick)
     *p = e;
     e->ref = p;
 
-    // notify background timer
-    if ((q->background.update && q->background.active) &&
-            (q->queue == e && !e->sibling)) {
-        q->background.update(q->background.timer,
-                             equeue_clampdiff(e->target, tick));
-    }
-
-    equeue_mutex_unlock(&q->queuelock);
-
-    return id;
+    return q->queue == e && !e->sibling;
 }
 
-static struct equeue_event *equeue_unqueue(equeue_t *q, int id)
+static void equeue_remove(equeue_t *q, struct equeue_event *e)
 {
-    // decode event from unique id and check that the local id matches
-    struct equeue_event *e = (struct equeue_event *)
-                             &q->buffer[id & ((1 << q->npw2) - 1)];
-
-    equeue_mutex_lock(&q->queuelock);
-    if (e->id != id >> q->npw2) {
-        equeue_mutex_unlock(&q->queuelock);
-        return 0;
-    }
-
-    // clear the event and check if already in-flight
-    e->cb = 0;
-    e->period = -1;
-
-    int diff = equeue_tickdiff(e->target, q->tick);
-    if (diff < 0 || (diff == 0 && e->generation != q->generation)) {
-        equeue_mutex_unlock(&q->queuelock);
-        return 0;
-    }
-
-    // disentangle from queue
     if (e->sibling) {
         e->sibling->next = e->next;
         if (e->sibling->next) {
@@ -305,23 +487,10 @@ static struct equeue_event *equeue_unqueue(equeue_t *q, int id)
             e->next->ref = e->ref;
         }
     }
-
-    equeue_incid(q, e);
-    equeue_mutex_unlock(&q->queuelock);
-
-    return e;
 }
 
-static struct equeue_event *equeue_dequeue(equeue_t *q, unsigned target)
+static struct equeue_event *equeue_collect(equeue_t *q, unsigned target)
 {
-    equeue_mutex_lock(&q->queuelock);
-
-    // find all expired events and mark a new generation
-    q->generation += 1;
-    if (equeue_tickdiff(q->tick, target) <= 0) {
-        q->tick = target;
-    }
-
     struct equeue_event *head = q->queue;
     struct equeue_event **p = &head;
     while (*p && equeue_tickdiff((*p)->target, target) <= 0) {
@@ -335,8 +504,6 @@ static struct equeue_event *equeue_dequeue(equeue_t *q, unsigned target)
 
     *p = 0;
 
-    equeue_mutex_unlock(&q->queuelock);
-
     // reverse and flatten each slot to match insertion order
     struct equeue_event **tail = &head;
     struct equeue_event *ess = head;
@@ -357,6 +524,453 @@ static struct equeue_event *equeue_dequeue(equeue_t *q, unsigned target)
     return head;
 }
 
+static bool equeue_next(equeue_t *q, unsigned *target)
+{
+    if (!q->queue) {
+        return false;
+    }
+
+    *target = q->queue->target;
+    return true;
+}
+
+#else
+// hierarchical timer wheel, level n of the wheel holds events that differ
+// from the wheel's current tick in bit group n, and is cascaded into the
+// lower levels whenever the current tick crosses one of its slots
+#define EQUEUE_WHEEL_MASK (EQUEUE_WHEEL_SLOTS - 1)
+
+static inline unsigned equeue_wheel_ctz(uint32_t x)
+{
+#if defined(__GNUC__)
+    return __builtin_ctz(x);
+#else
+    unsigned n = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+static void equeue_wheel_push(struct equeue_event **p, struct equeue_event *e)
+{
+    e->next = *p;
+    if (e->next) {
+        e->next->ref = &e->next;
+    }
+    e->sibling = 0;
+
+    *p = e;
+    e->ref = p;
+}
+
+static void equeue_wheel_place(equeue_t *q, struct equeue_event *e)
+{
+    unsigned now = q->wheel.now;
+    unsigned target = e->target;
+
+    // events behind the wheel are already due
+    if (equeue_tickdiff(target, now) < 0) {
+        equeue_wheel_push(&q->wheel.due, e);
+        return;
+    }
+
+    // find the lowest level that shares all higher bits with now
+    unsigned diff = target ^ now;
+    unsigned level = 0;
+    while (level < EQUEUE_WHEEL_LEVELS &&
+            (diff >> (EQUEUE_WHEEL_BITS * (level + 1)))) {
+        level++;
+    }
+
+    if (level == EQUEUE_WHEEL_LEVELS) {
+        equeue_wheel_push(&q->wheel.overflow, e);
+        return;
+    }
+
+    unsigned slot = (target >> (EQUEUE_WHEEL_BITS * level)) & EQUEUE_WHEEL_MASK;
+    q->wheel.occupied[level] |= (uint32_t)1 << slot;
+    equeue_wheel_push(&q->wheel.slots[level][slot], e);
+}
+
+// find the earliest target in a list of events
+static unsigned equeue_wheel_min(struct equeue_event *es, unsigned from)
+{
+    unsigned target = es->target;
+    for (struct equeue_event *e = es->next; e; e = e->next) {
+        if (equeue_tickdiff(e->target, target) < 0) {
+            target = e->target;
+        }
+    }
+
+    return equeue_tickdiff(target, from) < 0 ? from : target;
+}
+
+// find the next tick at or after from where the wheel has work to do,
+// either the start of the next occupied slot, which is where the wheel
+// needs to cascade, or the exact target of the next event
+static bool equeue_wheel_next(equeue_t *q, unsigned from, unsigned *next,
+                              bool exact)
+{
+    for (unsigned level = 0; level < EQUEUE_WHEEL_LEVELS; level++) {
+        unsigned shift = EQUEUE_WHEEL_BITS * level;
+        unsigned slot = (from >> shift) & EQUEUE_WHEEL_MASK;
+
+        // the current slot of a higher level is only valid on its boundary
+        if (level > 0 && (from & ((1u << shift) - 1))) {
+            slot += 1;
+            if (slot == EQUEUE_WHEEL_SLOTS) {
+                continue;
+            }
+        }
+
+        uint32_t pending = q->wheel.occupied[level] & ~(((uint32_t)1 << slot) - 1);
+        while (pending) {
+            unsigned found = equeue_wheel_ctz(pending);
+            struct equeue_event *es = q->wheel.slots[level][found];
+            if (!es) {
+                // clear stale slots left behind by cancelled events
+                q->wheel.occupied[level] &= ~((uint32_t)1 << found);
+                pending &= ~((uint32_t)1 << found);
+                continue;
+            }
+
+            if (exact) {
+                *next = equeue_wheel_min(es, from);
+            } else {
+                unsigned block = from & ~((1u << (shift + EQUEUE_WHEEL_BITS)) - 1);
+                unsigned start = block | (found << shift);
+                *next = equeue_tickdiff(start, from) < 0 ? from : start;
+            }
+            return true;
+        }
+    }
+
+    if (q->wheel.overflow) {
+        if (exact) {
+            *next = equeue_wheel_min(q->wheel.overflow, from);
+        } else {
+            unsigned mask = (1u << (EQUEUE_WHEEL_BITS * EQUEUE_WHEEL_LEVELS)) - 1;
+            *next = (from + mask) & ~mask;
+        }
+        return true;
+    }
+
+    return false;
+}
+
+// move any higher level slots that start at now down the wheel
+static void equeue_wheel_cascade(equeue_t *q, unsigned now)
+{
+    for (int level = EQUEUE_WHEEL_LEVELS; level > 0; level--) {
+        if (now & ((1u << (EQUEUE_WHEEL_BITS * level)) - 1)) {
+            continue;
+        }
+
+        struct equeue_event *es;
+        if (level == EQUEUE_WHEEL_LEVELS) {
+            es = q->wheel.overflow;
+            q->wheel.overflow = 0;
+        } else {
+            unsigned slot = (now >> (EQUEUE_WHEEL_BITS * level)) & EQUEUE_WHEEL_MASK;
+            if (!(q->wheel.occupied[level] & ((uint32_t)1 << slot))) {
+                continue;
+            }
+
+            es = q->wheel.slots[level][slot];
+            q->wheel.slots[level][slot] = 0;
+            q->wheel.occupied[level] &= ~((uint32_t)1 << slot);
+        }
+
+        // reverse so slots keep insertion order
+        struct equeue_event *prev = 0;
+        while (es) {
+            struct equeue_event *e = es;
+            es = e->next;
+            e->next = prev;
+            prev = e;
+        }
+
+        while (prev) {
+            struct equeue_event *e = prev;
+            prev = e->next;
+            equeue_wheel_place(q, e);
+        }
+    }
+}
+
+static bool equeue_next(equeue_t *q, unsigned *target);
+
+static bool equeue_insert(equeue_t *q, struct equeue_event *e)
+{
+    // only find the current deadline if someone is interested
+    bool head = false;
+    if (q->background.update && q->background.active) {
+        unsigned next;
+        head = !equeue_next(q, &next) ||
+               equeue_tickdiff(e->target, next) < 0;
+    }
+
+    equeue_wheel_place(q, e);
+    return head;
+}
+
+static void equeue_remove(equeue_t *q, struct equeue_event *e)
+{
+    // occupancy bits are left set and cleared lazily when the wheel
+    // reaches the slot
+    *e->ref = e->next;
+    if (e->next) {
+        e->next->ref = e->ref;
+    }
+}
+
+static struct equeue_event *equeue_collect(equeue_t *q, unsigned target)
+{
+    struct equeue_event *head = 0;
+    struct equeue_event **tail = &head;
+
+    // reverse events that were already due to match insertion order
+    struct equeue_event *es = q->wheel.due;
+    q->wheel.due = 0;
+    for (struct equeue_event *e = es; e;) {
+        struct equeue_event *n = e->next;
+        e->next = head;
+        head = e;
+        e = n;
+    }
+
+    if (es) {
+        tail = &es->next;
+    }
+
+    while (equeue_tickdiff(q->wheel.now, target) <= 0) {
+        unsigned now = q->wheel.now;
+        equeue_wheel_cascade(q, now);
+
+        unsigned slot = now & EQUEUE_WHEEL_MASK;
+        if (q->wheel.occupied[0] & ((uint32_t)1 << slot)) {
+            struct equeue_event *es = q->wheel.slots[0][slot];
+            q->wheel.slots[0][slot] = 0;
+            q->wheel.occupied[0] &= ~((uint32_t)1 << slot);
+
+            // reverse slot to match insertion order
+            struct equeue_event *prev = 0;
+            for (struct equeue_event *e = es; e;) {
+                struct equeue_event *n = e->next;
+                e->next = prev;
+                prev = e;
+                e = n;
+            }
+
+            if (es) {
+                *tail = prev;
+                tail = &es->next;
+            }
+        }
+
+        // skip ahead to the next slot with work
+        unsigned next;
+        if (!equeue_wheel_next(q, now + 1, &next, false) ||
+                equeue_tickdiff(next, target) > 0) {
+            next = target + 1;
+        }
+        q->wheel.now = next;
+    }
+
+    *tail = 0;
+    return head;
+}
+
+static bool equeue_next(equeue_t *q, unsigned *target)
+{
+    if (q->wheel.due) {
+        *target = q->tick;
+        return true;
+    }
+
+    return equeue_wheel_next(q, q->wheel.now, target, true);
+}
+#endif
+
+// enqueue an event, the queue lock must be held
+static int equeue_enqueue_locked(equeue_t *q, struct equeue_event *e,
+                                 unsigned tick)
+{
+    // setup event and hash local id with buffer offset for unique id
+    int id = equeue_id(q, e);
+    e->target = tick + equeue_clampdiff(e->target, tick);
+    e->generation = q->generation;
+
+    bool head = equeue_insert(q, e);
+
+    // let the dispatch loop know higher priority events are available
+    if (e->priority > q->preempt) {
+        q->preempt = e->priority;
+    }
+
+    // notify background timer
+    if ((q->background.update && q->background.active) && head) {
+        q->background.update(q->background.timer,
+                             equeue_clampdiff(e->target, tick));
+    }
+
+    return id;
+}
+
+static int equeue_enqueue(equeue_t *q, struct equeue_event *e, unsigned tick)
+{
+    equeue_mutex_lock(&q->queuelock);
+    int id = equeue_enqueue_locked(q, e, tick);
+    equeue_mutex_unlock(&q->queuelock);
+
+    return id;
+}
+
+// remove an event from the queue unless it is already in-flight, the queue
+// lock must be held
+static bool equeue_unqueue_locked(equeue_t *q, struct equeue_event *e)
+{
+    // clear the event and check if already in-flight
+    e->cb = 0;
+    e->period = -1;
+
+    int diff = equeue_tickdiff(e->target, q->tick);
+    if (diff < 0 || (diff == 0 && e->generation != q->generation)) {
+        return false;
+    }
+
+    // events still on the pending stack can't be removed, the dispatch
+    // loop deallocates them once incorporated
+    if (!e->ref) {
+        return false;
+    }
+
+    // disentangle from queue
+    equeue_remove(q, e);
+
+    equeue_incid(q, e);
+    return true;
+}
+
+static struct equeue_event *equeue_unqueue(equeue_t *q, int id)
+{
+    // decode event from unique id and check that the local id matches
+    struct equeue_event *e = (struct equeue_event *)
+                             &q->buffer[id & ((1 << q->npw2) - 1)];
+
+    equeue_mutex_lock(&q->queuelock);
+    if (e->id != id >> q->npw2) {
+        equeue_mutex_unlock(&q->queuelock);
+        return 0;
+    }
+
+    bool removed = equeue_unqueue_locked(q, e);
+    equeue_mutex_unlock(&q->queuelock);
+
+    return removed ? e : 0;
+}
+
+// move events posted with equeue_post_isr into the sorted queue
+static void equeue_incorporate(equeue_t *q)
+{
+    // atomically take the whole pending stack, the stack is only ever
+    // emptied as a whole so there is no ABA problem here
+    struct equeue_event *head;
+    do {
+        head = q->pending;
+        if (!head) {
+            return;
+        }
+    } while (!equeue_atomic_cas((void *volatile *)&q->pending, head, 0));
+
+    // reverse to match posting order
+    struct equeue_event *prev = 0;
+    while (head) {
+        struct equeue_event *e = head;
+        head = e->next;
+        e->next = prev;
+        prev = e;
+    }
+
+    unsigned tick = equeue_tick();
+    while (prev) {
+        struct equeue_event *e = prev;
+        prev = e->next;
+        equeue_enqueue(q, e, tick);
+    }
+}
+
+static struct equeue_event *equeue_dequeue(equeue_t *q, unsigned target)
+{
+    equeue_incorporate(q);
+
+    equeue_mutex_lock(&q->queuelock);
+
+    // find all expired events and mark a new generation
+    q->generation += 1;
+    q->preempt = 0;
+    if (equeue_tickdiff(q->tick, target) <= 0) {
+        q->tick = target;
+    }
+
+    struct equeue_event *head = equeue_collect(q, target);
+
+    equeue_mutex_unlock(&q->queuelock);
+
+    // sort into priority lanes, this is stable so each lane keeps
+    // insertion order
+    struct equeue_event *lanes[EQUEUE_PRIORITIES];
+    struct equeue_event **tails[EQUEUE_PRIORITIES];
+    for (int i = 0; i < EQUEUE_PRIORITIES; i++) {
+        lanes[i] = 0;
+        tails[i] = &lanes[i];
+    }
+
+    while (head) {
+        struct equeue_event *e = head;
+        head = e->next;
+
+        *tails[e->priority] = e;
+        tails[e->priority] = &e->next;
+    }
+
+    struct equeue_event **tail = &head;
+    for (int i = EQUEUE_PRIORITIES - 1; i >= 0; i--) {
+        *tail = lanes[i];
+        if (lanes[i]) {
+            tail = tails[i];
+        }
+    }
+    *tail = 0;
+
+    return head;
+}
+
+// merge two lists of dequeued events, both ordered by priority, favoring
+// the pending list when priorities match
+static struct equeue_event *equeue_merge(struct equeue_event *pending,
+                                         struct equeue_event *es)
+{
+    struct equeue_event *head = 0;
+    struct equeue_event **tail = &head;
+    while (pending && es) {
+        if (es->priority > pending->priority) {
+            *tail = es;
+            es = es->next;
+        } else {
+            *tail = pending;
+            pending = pending->next;
+        }
+        tail = &(*tail)->next;
+    }
+
+    *tail = pending ? pending : es;
+    return head;
+}
+
 int equeue_post(equeue_t *q, void (*cb)(void *), void *p)
 {
     struct equeue_event *e = (struct equeue_event *)p - 1;
@@ -369,6 +983,59 @@ int equeue_post(equeue_t *q, void (*cb)(void *), void *p)
     return id;
 }
 
+int equeue_post_batch(equeue_t *q, void (*cb)(void *), void *p, int *ids)
+{
+    unsigned tick = equeue_tick();
+    int count = 0;
+
+    equeue_mutex_lock(&q->queuelock);
+    struct equeue_event *e = p ? (struct equeue_event *)p - 1 : 0;
+    while (e) {
+        // enqueueing overwrites next
+        struct equeue_event *n = e->next;
+        e->cb = cb;
+        e->target = tick + e->target;
+
+        int id = equeue_enqueue_locked(q, e, tick);
+        if (ids) {
+            ids[count] = id;
+        }
+        count += 1;
+
+        e = n;
+    }
+    equeue_mutex_unlock(&q->queuelock);
+
+    equeue_sema_signal(&q->eventsema);
+    return count;
+}
+
+int equeue_post_isr(equeue_t *q, void (*cb)(void *), void *p)
+{
+    if (q->background.update) {
+        return equeue_post(q, cb, p);
+    }
+
+    struct equeue_event *e = (struct equeue_event *)p - 1;
+    e->cb = cb;
+    e->target = equeue_tick() + e->target;
+    e->ref = 0;
+    int id = equeue_id(q, e);
+
+    struct equeue_event *head;
+    do {
+        head = q->pending;
+        e->next = head;
+    } while (!equeue_atomic_cas((void *volatile *)&q->pending, head, e));
+
+    if (e->priority > q->preempt) {
+        q->preempt = e->priority;
+    }
+
+    equeue_sema_signal(&q->eventsema);
+    return id;
+}
+
 void equeue_cancel(equeue_t *q, int id)
 {
     if (!id) {
@@ -381,6 +1048,54 @@ void equeue_cancel(equeue_t *q, int id)
     }
 }
 
+// user allocated events
+void equeue_user_allocated_init(void *p)
+{
+    struct equeue_event *e = (struct equeue_event *)p - 1;
+    memset(e, 0, sizeof(*e));
+    e->period = -1;
+}
+
+bool equeue_post_user_allocated(equeue_t *q, int ms, int period,
+                                void (*cb)(void *), void *p)
+{
+    struct equeue_event *e = (struct equeue_event *)p - 1;
+    unsigned tick = equeue_tick();
+
+    // the header is only ours to update once the event is no longer posted,
+    // the dispatch loop clears the id when it is done with the event
+    equeue_mutex_lock(&q->queuelock);
+    if (e->id) {
+        equeue_mutex_unlock(&q->queuelock);
+        return false;
+    }
+
+    e->id = 1;
+    e->cb = cb;
+    e->target = tick + ms;
+    e->period = period;
+    equeue_enqueue_locked(q, e, tick);
+    equeue_mutex_unlock(&q->queuelock);
+
+    equeue_sema_signal(&q->eventsema);
+    return true;
+}
+
+bool equeue_cancel_user_allocated(equeue_t *q, void *p)
+{
+    struct equeue_event *e = (struct equeue_event *)p - 1;
+
+    equeue_mutex_lock(&q->queuelock);
+    bool removed = e->id && equeue_unqueue_locked(q, e);
+    equeue_mutex_unlock(&q->queuelock);
+
+    if (removed) {
+        equeue_dealloc(q, p);
+    }
+
+    return removed;
+}
+
 int equeue_timeleft(equeue_t *q, int id)
 {
     int ret = -1;
@@ -409,6 +1124,136 @@ void equeue_break(equeue_t *q)
     equeue_sema_signal(&q->eventsema);
 }
 
+// dispatch statistics
+#ifdef EQUEUE_STATS_ENABLED
+static inline unsigned equeue_stats_bucket(unsigned ticks)
+{
+    unsigned bucket = 0;
+    while (ticks && bucket < EQUEUE_STATS_BUCKETS - 1) {
+        ticks >>= 1;
+        bucket++;
+    }
+
+    return bucket;
+}
+
+struct ecallback {
+    void (*cb)(void *);
+    void *data;
+};
+
+static void ecallback_dispatch(void *p);
+
+static void equeue_stats_record(equeue_t *q, struct equeue_event *e,
+                                void (*cb)(void *),
+                                unsigned lateness, unsigned runtime)
+{
+    // report the user's callback for simple calls
+    if (cb == ecallback_dispatch) {
+        cb = ((struct ecallback *)(e + 1))->cb;
+    }
+
+    equeue_mutex_lock(&q->queuelock);
+    q->stats.dispatched += 1;
+    q->stats.lateness[equeue_stats_bucket(lateness)] += 1;
+    q->stats.runtime[equeue_stats_bucket(runtime)] += 1;
+
+    if (lateness > q->stats.max_lateness) {
+        q->stats.max_lateness = lateness;
+    }
+
+    if (runtime > q->stats.max_runtime || !q->stats.slowest) {
+        q->stats.max_runtime = runtime;
+        q->stats.slowest = cb;
+    }
+    equeue_mutex_unlock(&q->queuelock);
+}
+#endif
+
+void equeue_get_stats(equeue_t *q, equeue_stats_t *stats)
+{
+#ifdef EQUEUE_STATS_ENABLED
+    equeue_mutex_lock(&q->queuelock);
+    *stats = q->stats;
+    equeue_mutex_unlock(&q->queuelock);
+#else
+    memset(stats, 0, sizeof(*stats));
+#endif
+}
+
+void equeue_reset_stats(equeue_t *q)
+{
+#ifdef EQUEUE_STATS_ENABLED
+    equeue_mutex_lock(&q->queuelock);
+    memset(&q->stats, 0, sizeof(q->stats));
+    equeue_mutex_unlock(&q->queuelock);
+#endif
+}
+
+// dispatch a list of dequeued events, returning how many were dispatched
+static int equeue_dispatch_events(equeue_t *q, struct equeue_event *es)
+{
+    int count = 0;
+    while (es) {
+        struct equeue_event *e = es;
+        es = e->next;
+
+        // actually dispatch the callbacks
+        void (*cb)(void *) = e->cb;
+        if (cb) {
+            equeue_trace_dispatch(cb);
+#ifdef EQUEUE_STATS_ENABLED
+            unsigned start = equeue_tick();
+            cb(e + 1);
+            equeue_stats_record(q, e, cb,
+                                equeue_clampdiff(start, e->target),
+                                equeue_tick() - start);
+#else
+            cb(e + 1);
+#endif
+            equeue_trace_dispatch_end();
+        }
+
+        // reenqueue periodic events or deallocate
+        if (e->period >= 0) {
+            e->target += e->period;
+            equeue_enqueue(q, e, equeue_tick());
+        } else {
+            equeue_incid(q, e);
+            equeue_dealloc(q, e + 1);
+        }
+
+        // pick up any higher priority events posted in the meantime
+        if (es && q->preempt > es->priority) {
+            es = equeue_merge(es, equeue_dequeue(q, equeue_tick()));
+        }
+
+        count += 1;
+    }
+
+    return count;
+}
+
+int equeue_dispatch_due(equeue_t *q)
+{
+    return equeue_dispatch_events(q, equeue_dequeue(q, equeue_tick()));
+}
+
+int equeue_deadline(equeue_t *q)
+{
+    int deadline = -1;
+
+    equeue_incorporate(q);
+    equeue_mutex_lock(&q->queuelock);
+    unsigned next;
+    if (equeue_next(q, &next)) {
+        deadline = equeue_clampdiff(next, equeue_tick());
+    }
+    equeue_mutex_unlock(&q->queuelock);
+
+    return deadline;
+}
+
 void equeue_dispatch(equeue_t *q, int ms)
 {
     unsigned tick = equeue_tick();
@@ -420,25 +1265,7 @@ void equeue_dispatch(equeue_t *q, int ms)
         struct equeue_event *es = equeue_dequeue(q, tick);
 
         // dispatch events
-        while (es) {
-            struct equeue_event *e = es;
-            es = e->next;
-
-            // actually dispatch the callbacks
-            void (*cb)(void *) = e->cb;
-            if (cb) {
-                cb(e + 1);
-            }
-
-            // reenqueue periodic events or deallocate
-            if (e->period >= 0) {
-                e->target += e->period;
-                equeue_enqueue(q, e, equeue_tick());
-            } else {
-                equeue_incid(q, e);
-                equeue_dealloc(q, e + 1);
-            }
-        }
+        equeue_dispatch_events(q, es);
 
         int deadline = -1;
         tick = equeue_tick();
@@ -450,9 +1277,10 @@ void equeue_dispatch(equeue_t *q, int ms)
                 // update background timer if necessary
                 if (q->background.update) {
                     equeue_mutex_lock(&q->queuelock);
-                    if (q->background.update && q->queue) {
+                    unsigned next;
+                    if (q->background.update && equeue_next(q, &next)) {
                         q->background.update(q->background.timer,
-                                             equeue_clampdiff(q->queue->target, tick));
+                                             equeue_clampdiff(next, tick));
                     }
                     q->background.active = true;
                     equeue_mutex_unlock(&q->queuelock);
@@ -463,9 +1291,11 @@ void equeue_dispatch(equeue_t *q, int ms)
         }
 
         // find closest deadline
+        equeue_incorporate(q);
         equeue_mutex_lock(&q->queuelock);
-        if (q->queue) {
-            int diff = equeue_clampdiff(q->queue->target, tick);
+        unsigned next;
+        if (equeue_next(q, &next)) {
+            int diff = equeue_clampdiff(next, tick);
             if ((unsigned)diff < (unsigned)deadline) {
                 deadline = diff;
             }
@@ -511,12 +1341,25 @@ void equeue_event_dtor(void *p, void (*dtor)(void *))
     e->dtor = dtor;
 }
 
+void equeue_event_priority(void *p, int priority)
+{
+    struct equeue_event *e = (struct equeue_event *)p - 1;
+    if (priority < 0) {
+        priority = 0;
+    } else if (priority > EQUEUE_PRIORITIES - 1) {
+        priority = EQUEUE_PRIORITIES - 1;
+    }
+    e->priority = priority;
+}
+
 
 // simple callbacks
+#ifndef EQUEUE_STATS_ENABLED
 struct ecallback {
     void (*cb)(void *);
     void *data;
 };
+#endif
 
 static void ecallback_dispatch(void *p)
 {
@@ -564,6 +1407,25 @@ int equeue_call_every(equeue_t *q, int ms, void (*cb)(void *), void *data)
 }
 
 
+int equeue_call_batch(equeue_t *q, void (*const *cbs)(void *),
+                      void *const *data, int count, int *ids)
+{
+    struct ecallback *e = equeue_alloc_batch(q, sizeof(struct ecallback), count);
+    if (!e) {
+        return 0;
+    }
+
+    int i = 0;
+    for (struct ecallback *p = e; p; p = equeue_batch_next(p)) {
+        p->cb = cbs[i];
+        p->data = data[i];
+        i++;
+    }
+
+    return equeue_post_batch(q, ecallback_dispatch, e, ids);
+}
+
+
 // backgrounding
 void equeue_background(equeue_t *q,
                        void (*update)(void *timer, int ms), void *timer)
@@ -576,9 +1438,10 @@ void equeue_background(equeue_t *q,
     q->background.update = update;
     q->background.timer = timer;
 
-    if (q->background.update && q->queue) {
+    unsigned next;
+    if (q->background.update && equeue_next(q, &next)) {
         q->background.update(q->background.timer,
-                             equeue_clampdiff(q->queue->target, equeue_tick()));
+                             equeue_clampdiff(next, equeue_tick()));
     }
     q->background.active = true;
     equeue_mutex_unlock(&q->queuelock);
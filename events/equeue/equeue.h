@@ -36,11 +36,54 @@ extern "C" {
 // This size is guaranteed to fit events created by event_call
 #define EQUEUE_EVENT_SIZE (sizeof(struct equeue_event) + 2*sizeof(void*))
 
+// The number of priority lanes in an event queue
+// Priorities range from 0 (the default) up to EQUEUE_PRIORITIES-1
+#ifndef EQUEUE_PRIORITIES
+#define EQUEUE_PRIORITIES 4
+#endif
+
+// Use a hierarchical timer wheel instead of a sorted list for pending
+// events, this makes posting and cancelling events constant time at the
+// cost of EQUEUE_WHEEL_LEVELS*EQUEUE_WHEEL_SLOTS pointers per queue
+#if !defined(EQUEUE_TIMER_WHEEL) && MBED_CONF_EVENTS_USE_TIMER_WHEEL
+#define EQUEUE_TIMER_WHEEL
+#endif
+
+// The number of levels in the timer wheel, each level covers
+// EQUEUE_WHEEL_SLOTS times the range of the level below it, events beyond
+// the last level are kept on an overflow list
+#ifndef EQUEUE_WHEEL_LEVELS
+#define EQUEUE_WHEEL_LEVELS 4
+#endif
+#define EQUEUE_WHEEL_BITS 5
+#define EQUEUE_WHEEL_SLOTS (1 << EQUEUE_WHEEL_BITS)
+
+#if EQUEUE_WHEEL_BITS*EQUEUE_WHEEL_LEVELS >= 32
+#error "EQUEUE_WHEEL_LEVELS must cover less than 32 bits of ticks"
+#endif
+
+// The maximum number of allocation size classes in an event queue
+#ifndef EQUEUE_CLASSES
+#define EQUEUE_CLASSES 4
+#endif
+
+// Record dispatch statistics, this adds two tick reads to every dispatched
+// event
+#if !defined(EQUEUE_STATS_ENABLED) && MBED_CONF_EVENTS_DISPATCH_STATS_ENABLED
+#define EQUEUE_STATS_ENABLED
+#endif
+
+// The number of buckets in the dispatch statistic histograms
+#ifndef EQUEUE_STATS_BUCKETS
+#define EQUEUE_STATS_BUCKETS 16
+#endif
+
 // Internal event structure
 struct equeue_event {
     unsigned size;
     uint8_t id;
     uint8_t generation;
+    uint8_t priority;
 
     struct equeue_event *next;
     struct equeue_event *sibling;
@@ -54,12 +97,49 @@ struct equeue_event {
     // data follows
 };
 
+// Dispatch statistics
+//
+// The lateness and runtime histograms are log2 scaled in milliseconds,
+// bucket 0 counts events that took less than a tick, bucket n counts
+// events that took from 2^(n-1) up to 2^n-1 ticks, and the last bucket
+// also counts anything longer.
+typedef struct equeue_stats {
+    unsigned dispatched;
+    unsigned max_lateness;
+    unsigned max_runtime;
+    void (*slowest)(void *);
+    unsigned lateness[EQUEUE_STATS_BUCKETS];
+    unsigned runtime[EQUEUE_STATS_BUCKETS];
+} equeue_stats_t;
+
+// Allocation statistics
+//
+// Reported for each allocation size class, and for the general allocator
+// that serves every other size, which is reported with a size of 0.
+typedef struct equeue_class_stats {
+    size_t size;
+    unsigned chunks;
+    unsigned used;
+    unsigned high_water;
+} equeue_class_stats_t;
+
 // Event queue structure
 typedef struct equeue {
     struct equeue_event *queue;
+    struct equeue_event *volatile pending;
+#ifdef EQUEUE_TIMER_WHEEL
+    struct equeue_wheel {
+        unsigned now;
+        uint32_t occupied[EQUEUE_WHEEL_LEVELS];
+        struct equeue_event *slots[EQUEUE_WHEEL_LEVELS][EQUEUE_WHEEL_SLOTS];
+        struct equeue_event *due;
+        struct equeue_event *overflow;
+    } wheel;
+#endif
     unsigned tick;
     bool break_requested;
     uint8_t generation;
+    uint8_t preempt;
 
     unsigned char *buffer;
     unsigned npw2;
@@ -71,12 +151,25 @@ typedef struct equeue {
         unsigned char *data;
     } slab;
 
+    struct equeue_class {
+        size_t size;
+        struct equeue_event *free;
+        unsigned chunks;
+        unsigned used;
+        unsigned high_water;
+    } classes[EQUEUE_CLASSES], general;
+    unsigned nclasses;
+
     struct equeue_background {
         bool active;
         void (*update)(void *timer, int ms);
         void *timer;
     } background;
 
+#ifdef EQUEUE_STATS_ENABLED
+    equeue_stats_t stats;
+#endif
+
     equeue_sema_t eventsema;
     equeue_mutex_t queuelock;
     equeue_mutex_t memlock;
@@ -95,17 +188,70 @@ int equeue_create(equeue_t *queue, size_t size);
 int equeue_create_inplace(equeue_t *queue, size_t size, void *buffer);
 void equeue_destroy(equeue_t *queue);
 
+// Create an event queue with allocation size classes
+//
+// Behaves like equeue_create_inplace, or like equeue_create if buffer is
+// null, but also sets up to EQUEUE_CLASSES size classes for allocations.
+// An allocation is rounded up to the smallest class that fits and is served
+// from that class's free list in constant time, with chunks carved from the
+// buffer on demand. Allocations larger than every class use the general
+// allocator. Rounding costs some memory, but mixed size events no longer
+// fragment each other.
+//
+// The classes are given as the sizes passed to equeue_alloc, in any order.
+//
+// If the event queue creation fails, equeue_create_classes returns a
+// negative, platform-specific error code.
+int equeue_create_classes(equeue_t *queue, size_t size, void *buffer,
+                          const size_t *classes, int count);
+
+// Query allocation statistics
+//
+// Fills up to count entries of stats, one for each size class in order of
+// size followed by one for the general allocator, with how many chunks
+// are carved from the buffer, how many are in use and the peak number in
+// use. Returns the number of entries available.
+//
+// The equeue_get_class_stats function is irq safe.
+int equeue_get_class_stats(equeue_t *queue, equeue_class_stats_t *stats,
+                           int count);
+
 // Dispatch events
 //
 // Executes events until the specified milliseconds have passed. If ms is
 // negative, equeue_dispatch will dispatch events indefinitely or until
 // equeue_break is called on this queue.
 //
+// Events that are due are dispatched strictly in order of priority, and
+// in order of insertion within a priority. A higher priority event posted
+// while lower priority events are being dispatched runs before the
+// remaining lower priority events.
+//
 // When called with a finite timeout, the equeue_dispatch function is
 // guaranteed to terminate. When called with a timeout of 0, the
 // equeue_dispatch does not wait and is irq safe.
 void equeue_dispatch(equeue_t *queue, int ms);
 
+// Dispatch only the events that are currently due
+//
+// Executes every event whose time has come and returns without waiting.
+// Unlike equeue_dispatch, equeue_dispatch_due leaves the background timer
+// and pending breaks untouched, so several threads may call
+// equeue_dispatch_due on the same queue at once, for example to let an
+// idle thread take work from a busy one. Each event is still dispatched
+// exactly once.
+//
+// Returns the number of events dispatched.
+int equeue_dispatch_due(equeue_t *queue);
+
+// Find the time until the next event
+//
+// Returns the milliseconds until the next event is due, 0 if an event is
+// already due, or -1 if the queue is empty.
+//
+// The equeue_deadline function is irq safe.
+int equeue_deadline(equeue_t *queue);
+
 // Break out of a running event loop
 //
 // Forces the specified event queue's dispatch loop to terminate. Pending
@@ -131,6 +277,22 @@ int equeue_call(equeue_t *queue, void (*cb)(void *), void *data);
 int equeue_call_in(equeue_t *queue, int ms, void (*cb)(void *), void *data);
 int equeue_call_every(equeue_t *queue, int ms, void (*cb)(void *), void *data);
 
+// Post a batch of simple callbacks
+//
+// The equeue_call_batch function posts count events, the nth of which
+// calls cbs[n] with data[n]. All of the events are allocated while taking
+// the allocator's lock once, and inserted while taking the queue's lock
+// once, which is cheaper than posting the events one at a time.
+//
+// If ids is not null, the unique ids of the posted events are written to
+// the count entries of ids in order.
+//
+// The equeue_call_batch function is irq safe. It either posts all of the
+// events and returns count, or posts none of them and returns 0 if there is
+// not enough memory.
+int equeue_call_batch(equeue_t *queue, void (*const *cbs)(void *),
+                      void *const *data, int count, int *ids);
+
 // Allocate memory for events
 //
 // The equeue_alloc function allocates an event that can be manually dispatched
@@ -151,14 +313,31 @@ int equeue_call_every(equeue_t *queue, int ms, void (*cb)(void *), void *data);
 void *equeue_alloc(equeue_t *queue, size_t size);
 void equeue_dealloc(equeue_t *queue, void *event);
 
+// Allocate a batch of events
+//
+// The equeue_alloc_batch function allocates count events of the same size
+// while taking the allocator's lock once. Either all of the events are
+// allocated or null is returned. The returned event is the head of the
+// batch, equeue_batch_next returns the following event, or null at the end
+// of the batch.
+//
+// The batch can be posted as a whole with equeue_post_batch. Individual
+// events of an unposted batch must each be freed with equeue_dealloc.
+//
+// Both equeue_alloc_batch and equeue_batch_next are irq safe.
+void *equeue_alloc_batch(equeue_t *queue, size_t size, int count);
+void *equeue_batch_next(void *event);
+
 // Configure an allocated event
 //
 // equeue_event_delay  - Millisecond delay before dispatching an event
 // equeue_event_period - Millisecond period for repeating dispatching an event
 // equeue_event_dtor   - Destructor to run when the event is deallocated
+// equeue_event_priority - Dispatch lane of an event, higher values run first
 void equeue_event_delay(void *event, int ms);
 void equeue_event_period(void *event, int ms);
 void equeue_event_dtor(void *event, void (*dtor)(void *));
+void equeue_event_priority(void *event, int priority);
 
 // Post an event onto the event queue
 //
@@ -174,6 +353,36 @@ void equeue_event_dtor(void *event, void (*dtor)(void *));
 // be passed to equeue_cancel.
 int equeue_post(equeue_t *queue, void (*cb)(void *), void *event);
 
+// Post a batch of events onto the event queue
+//
+// The equeue_post_batch function posts every event of a batch allocated
+// with equeue_alloc_batch, all with the same callback, while taking the
+// queue's lock once. Each event may be configured individually before
+// posting. If ids is not null, the unique ids of the posted events are
+// written to ids in batch order.
+//
+// The equeue_post_batch function is irq safe and returns the number of
+// events posted.
+int equeue_post_batch(equeue_t *queue, void (*cb)(void *), void *event,
+                      int *ids);
+
+// Post an event onto the event queue without taking the queue lock
+//
+// The equeue_post_isr function behaves like equeue_post, but instead of
+// sorting the event into the queue it pushes the event onto a lock-free
+// pending stack with a single atomic compare-and-swap. The dispatch loop
+// moves pending events into the queue before dispatching, so the time spent
+// with interrupts disabled does not depend on the number of events already
+// in the queue.
+//
+// A pending event can be cancelled with equeue_cancel, but its memory is
+// only reclaimed once the dispatch loop has picked it up. If the event queue
+// is backgrounded, equeue_post_isr falls back to equeue_post so the
+// background timer can be updated.
+//
+// The equeue_post_isr function is irq safe.
+int equeue_post_isr(equeue_t *queue, void (*cb)(void *), void *event);
+
 // Cancel an in-flight event
 //
 // Attempts to cancel an event referenced by the unique id returned from
@@ -187,6 +396,33 @@ int equeue_post(equeue_t *queue, void (*cb)(void *), void *event);
 // the event may have already begun executing.
 void equeue_cancel(equeue_t *queue, int id);
 
+// Post events in memory owned by the caller
+//
+// A user allocated event is a struct equeue_event immediately followed by
+// the event's data, placed anywhere that outlives its posts, for example
+// embedded in the object that posts it. It is never allocated from or
+// returned to the event queue's buffer, so it can be reposted indefinitely
+// without allocation and without running a destructor after each dispatch.
+//
+// The equeue_user_allocated_init function prepares the header of an event,
+// given a pointer to the event's data just past the header.
+//
+// The equeue_post_user_allocated function posts the event with a delay and
+// a period in milliseconds, a negative period posts it only once. It returns
+// false without posting if the event is still posted, an event can be posted
+// again once its callback has returned or it has been cancelled.
+//
+// The equeue_cancel_user_allocated function returns true if the event was
+// removed before it was dispatched. Like equeue_cancel, the event may
+// already be executing when it returns false.
+//
+// The user allocated functions are irq safe. The event's memory must stay
+// valid while it is posted.
+void equeue_user_allocated_init(void *event);
+bool equeue_post_user_allocated(equeue_t *queue, int ms, int period,
+                                void (*cb)(void *), void *event);
+bool equeue_cancel_user_allocated(equeue_t *queue, void *event);
+
 // Query how much time is left for delayed event
 //
 //  If event is delayed, this function can be used to query how much time
@@ -196,6 +432,19 @@ void equeue_cancel(equeue_t *queue, int id);
 //
 int equeue_timeleft(equeue_t *q, int id);
 
+// Query dispatch statistics
+//
+// If the event queue was built with EQUEUE_STATS_ENABLED, the
+// equeue_get_stats function copies how late events were dispatched
+// compared to their target tick, and how long their callbacks ran,
+// into the provided structure. Otherwise the structure is zeroed.
+//
+// The equeue_reset_stats function clears the collected statistics.
+//
+// Both functions are irq safe.
+void equeue_get_stats(equeue_t *queue, equeue_stats_t *stats);
+void equeue_reset_stats(equeue_t *queue);
+
 // Background an event queue onto a single-shot timer
 //
 // The provided update function will be called to indicate when the queue
@@ -119,6 +119,13 @@ void equeue_mutex_unlock(equeue_mutex_t *m)
 }
 
 
+// Atomic operations
+bool equeue_atomic_cas(void *volatile *ptr, void *expected, void *desired)
+{
+    return core_util_atomic_cas_ptr(ptr, &expected, desired);
+}
+
+
 // Semaphore operations
 #ifdef MBED_CONF_RTOS_PRESENT
 
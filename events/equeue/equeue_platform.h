@@ -97,6 +97,18 @@ void equeue_mutex_lock(equeue_mutex_t *mutex);
 void equeue_mutex_unlock(equeue_mutex_t *mutex);
 
 
+// Platform atomic operations
+//
+// The equeue_atomic_cas function atomically compares the pointer stored at
+// ptr with the expected value and, only if they match, replaces it with the
+// desired value. The equeue_atomic_cas returns true if the pointer was
+// replaced.
+//
+// This is used to post events without taking the queue lock, so it must be
+// safe in interrupt contexts and should not block.
+bool equeue_atomic_cas(void *volatile *ptr, void *expected, void *desired);
+
+
 // Platform semaphore type
 //
 // The equeue library requires a binary semaphore type that can be safely
@@ -143,6 +155,20 @@ void equeue_sema_signal(equeue_sema_t *sema);
 bool equeue_sema_wait(equeue_sema_t *sema, int ms);
 
 
+// Platform trace hooks
+//
+// The equeue_trace_dispatch and equeue_trace_dispatch_end hooks bracket
+// each dispatched callback. They may be left empty.
+#if defined(EQUEUE_PLATFORM_MBED) && defined(MBED_SWO_TRACE_ENABLED)
+#include "platform/mbed_swo_trace.h"
+#define equeue_trace_dispatch(cb) MBED_SWO_TRACE(MBED_SWO_TRACE_EQUEUE_DISPATCH, cb)
+#define equeue_trace_dispatch_end() MBED_SWO_TRACE_MARK(MBED_SWO_TRACE_EQUEUE_DISPATCH_END)
+#else
+#define equeue_trace_dispatch(cb) ((void)0)
+#define equeue_trace_dispatch_end() ((void)0)
+#endif
+
+
 #ifdef __cplusplus
 }
 #endif
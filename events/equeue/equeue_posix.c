@@ -55,6 +55,13 @@ void equeue_mutex_unlock(equeue_mutex_t *m)
 }
 
 
+// Atomic operations
+bool equeue_atomic_cas(void *volatile *ptr, void *expected, void *desired)
+{
+    return __sync_bool_compare_and_swap(ptr, expected, desired);
+}
+
+
 // Semaphore operations
 int equeue_sema_create(equeue_sema_t *s)
 {
@@ -180,6 +180,33 @@ void equeue_alloc_many_prof(int count)
     equeue_destroy(&q);
 }
 
+void equeue_alloc_classes_many_prof(int count)
+{
+    struct equeue q;
+    size_t classes[3] = {0, 2 * sizeof(int), 8 * sizeof(int)};
+    equeue_create_classes(&q, count * EQUEUE_EVENT_SIZE, 0, classes, 3);
+
+    void *es[count];
+
+    for (int i = 0; i < count; i++) {
+        es[i] = equeue_alloc(&q, (i % 4) * sizeof(int));
+    }
+
+    for (int i = 0; i < count; i++) {
+        equeue_dealloc(&q, es[i]);
+    }
+
+    prof_loop() {
+        prof_start();
+        void *e = equeue_alloc(&q, 8 * sizeof(int));
+        prof_stop();
+
+        equeue_dealloc(&q, e);
+    }
+
+    equeue_destroy(&q);
+}
+
 void equeue_post_prof(void)
 {
     struct equeue q;
@@ -220,6 +247,60 @@ void equeue_post_many_prof(int count)
     equeue_destroy(&q);
 }
 
+void equeue_post_worst_prof(int count)
+{
+    struct equeue q;
+    equeue_create(&q, count * EQUEUE_EVENT_SIZE);
+
+    for (int i = 0; i < count - 1; i++) {
+        equeue_call_in(&q, i, no_func, 0);
+    }
+
+    prof_cycle_t worst = 0;
+    for (int i = 0; i < 1000; i++) {
+        void *e = equeue_alloc(&q, 0);
+        equeue_event_delay(e, count);
+
+        prof_cycle_t start = prof_cycle();
+        int id = equeue_post(&q, no_func, e);
+        prof_cycle_t cycles = prof_cycle() - start;
+        if (cycles > worst) {
+            worst = cycles;
+        }
+
+        equeue_cancel(&q, id);
+    }
+
+    prof_result(worst, "cycles");
+    equeue_destroy(&q);
+}
+
+void equeue_post_isr_worst_prof(int count)
+{
+    struct equeue q;
+    equeue_create(&q, (count + 1000) * EQUEUE_EVENT_SIZE);
+
+    for (int i = 0; i < count - 1; i++) {
+        equeue_call_in(&q, i, no_func, 0);
+    }
+
+    prof_cycle_t worst = 0;
+    for (int i = 0; i < 1000; i++) {
+        void *e = equeue_alloc(&q, 0);
+        equeue_event_delay(e, count);
+
+        prof_cycle_t start = prof_cycle();
+        equeue_post_isr(&q, no_func, e);
+        prof_cycle_t cycles = prof_cycle() - start;
+        if (cycles > worst) {
+            worst = cycles;
+        }
+    }
+
+    prof_result(worst, "cycles");
+    equeue_destroy(&q);
+}
+
 void equeue_post_future_prof(void)
 {
     struct equeue q;
@@ -262,6 +343,47 @@ void equeue_post_future_many_prof(int count)
     equeue_destroy(&q);
 }
 
+void equeue_call_batch_prof(int count)
+{
+    struct equeue q;
+    equeue_create(&q, count * EQUEUE_EVENT_SIZE);
+
+    void (*cbs[count])(void *);
+    void *data[count];
+    for (int i = 0; i < count; i++) {
+        cbs[i] = no_func;
+        data[i] = 0;
+    }
+
+    prof_loop() {
+        prof_start();
+        equeue_call_batch(&q, cbs, data, count, 0);
+        prof_stop();
+
+        equeue_dispatch(&q, 0);
+    }
+
+    equeue_destroy(&q);
+}
+
+void equeue_call_unbatched_prof(int count)
+{
+    struct equeue q;
+    equeue_create(&q, count * EQUEUE_EVENT_SIZE);
+
+    prof_loop() {
+        prof_start();
+        for (int i = 0; i < count; i++) {
+            equeue_call(&q, no_func, 0);
+        }
+        prof_stop();
+
+        equeue_dispatch(&q, 0);
+    }
+
+    equeue_destroy(&q);
+}
+
 void equeue_dispatch_prof(void)
 {
     struct equeue q;
@@ -296,6 +418,49 @@ void equeue_dispatch_many_prof(int count)
     equeue_destroy(&q);
 }
 
+static volatile bool prof_high_dispatched;
+
+void high_func(void *eh)
+{
+    prof_stop();
+    prof_high_dispatched = true;
+}
+
+void slow_func(void *eh)
+{
+    for (prof_volatile(int) i = 0; i < 100; i++) {
+    }
+}
+
+void equeue_dispatch_priority_latency_prof(int count)
+{
+    struct equeue q;
+    equeue_create(&q, (count + 2) * EQUEUE_EVENT_SIZE);
+
+    prof_loop() {
+        for (int i = 0; i < count / 2; i++) {
+            equeue_call(&q, slow_func, 0);
+        }
+
+        void *e = equeue_alloc(&q, 0);
+        equeue_event_priority(e, EQUEUE_PRIORITIES - 1);
+        equeue_post(&q, high_func, e);
+
+        for (int i = 0; i < count / 2; i++) {
+            equeue_call(&q, slow_func, 0);
+        }
+
+        prof_high_dispatched = false;
+        prof_start();
+        equeue_dispatch(&q, 0);
+        if (!prof_high_dispatched) {
+            prof_stop();
+        }
+    }
+
+    equeue_destroy(&q);
+}
+
 void equeue_cancel_prof(void)
 {
     struct equeue q;
@@ -411,10 +576,16 @@ int main()
     prof_measure(equeue_cancel_prof);
 
     prof_measure(equeue_alloc_many_prof, 1000);
+    prof_measure(equeue_alloc_classes_many_prof, 1000);
     prof_measure(equeue_post_many_prof, 1000);
     prof_measure(equeue_post_future_many_prof, 1000);
     prof_measure(equeue_dispatch_many_prof, 100);
     prof_measure(equeue_cancel_many_prof, 100);
+    prof_measure(equeue_dispatch_priority_latency_prof, 100);
+    prof_measure(equeue_call_unbatched_prof, 16);
+    prof_measure(equeue_call_batch_prof, 16);
+    prof_measure(equeue_post_worst_prof, 1000);
+    prof_measure(equeue_post_isr_worst_prof, 1000);
 
     prof_measure(equeue_alloc_size_prof);
     prof_measure(equeue_alloc_many_size_prof, 1000);
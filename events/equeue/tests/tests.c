@@ -60,6 +60,11 @@ void simple_func(void *p)
     (*(int *)p)++;
 }
 
+void simple_func_indirect(void *p)
+{
+    (**(int **)p)++;
+}
+
 void sloth_func(void *p)
 {
     usleep(10000);
@@ -669,6 +674,46 @@ void simple_barrage_test(int N)
     equeue_destroy(&q);
 }
 
+void cancelling_barrage_test(int N)
+{
+    equeue_t q;
+    int err = equeue_create(&q, N * (EQUEUE_EVENT_SIZE + sizeof(struct timing)));
+    test_assert(!err);
+
+    int touched = 0;
+    int ids[N];
+    for (int i = 0; i < N; i++) {
+        struct timing *timing = equeue_alloc(&q, sizeof(struct timing));
+        test_assert(timing);
+
+        // spread delays so events land on several levels of a timer wheel
+        timing->tick = equeue_tick();
+        timing->delay = 10 + (i * 37) % 1200;
+        equeue_event_delay(timing, timing->delay);
+
+        ids[i] = equeue_post(&q, timing_func, timing);
+        test_assert(ids[i]);
+    }
+
+    for (int i = 0; i < N; i += 2) {
+        equeue_cancel(&q, ids[i]);
+    }
+
+    for (int i = 0; i < N; i++) {
+        test_assert((equeue_timeleft(&q, ids[i]) < 0) == !(i % 2));
+    }
+
+    equeue_call_in(&q, 1300, simple_func, &touched);
+    equeue_dispatch(&q, 1400);
+    test_assert(touched == 1);
+
+    for (int i = 0; i < N; i++) {
+        test_assert(equeue_timeleft(&q, ids[i]) < 0);
+    }
+
+    equeue_destroy(&q);
+}
+
 void fragmenting_barrage_test(int N)
 {
     equeue_t q;
@@ -802,6 +847,533 @@ void sibling_test(void)
     equeue_destroy(&q);
 }
 
+struct order {
+    int *log;
+    int *count;
+    int value;
+};
+
+void order_func(void *p)
+{
+    struct order *o = (struct order *)p;
+    o->log[(*o->count)++] = o->value;
+}
+
+struct preempt {
+    equeue_t *q;
+    struct order order;
+};
+
+void preempt_func(void *p)
+{
+    struct preempt *pr = (struct preempt *)p;
+    struct order *o = equeue_alloc(pr->q, sizeof(struct order));
+    test_assert(o);
+    *o = pr->order;
+    equeue_event_priority(o, EQUEUE_PRIORITIES - 1);
+    test_assert(equeue_post(pr->q, order_func, o));
+}
+
+void priority_test(void)
+{
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    int log[8];
+    int count = 0;
+    int priorities[8] = {0, 1, 0, 3, 2, 3, 0, 1};
+
+    for (int i = 0; i < 8; i++) {
+        struct order *o = equeue_alloc(&q, sizeof(struct order));
+        test_assert(o);
+        o->log = log;
+        o->count = &count;
+        o->value = i;
+        equeue_event_priority(o, priorities[i]);
+        test_assert(equeue_post(&q, order_func, o));
+    }
+
+    equeue_dispatch(&q, 0);
+    test_assert(count == 8);
+
+    int expected[8] = {3, 5, 4, 1, 7, 0, 2, 6};
+    for (int i = 0; i < 8; i++) {
+        test_assert(log[i] == expected[i]);
+    }
+
+    equeue_destroy(&q);
+}
+
+void priority_preempt_test(void)
+{
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    int log[8];
+    int count = 0;
+
+    struct order *o = equeue_alloc(&q, sizeof(struct order));
+    test_assert(o);
+    o->log = log;
+    o->count = &count;
+    o->value = 0;
+    test_assert(equeue_post(&q, order_func, o));
+
+    struct preempt *pr = equeue_alloc(&q, sizeof(struct preempt));
+    test_assert(pr);
+    pr->q = &q;
+    pr->order.log = log;
+    pr->order.count = &count;
+    pr->order.value = 1;
+    test_assert(equeue_post(&q, preempt_func, pr));
+
+    o = equeue_alloc(&q, sizeof(struct order));
+    test_assert(o);
+    o->log = log;
+    o->count = &count;
+    o->value = 2;
+    test_assert(equeue_post(&q, order_func, o));
+
+    equeue_dispatch(&q, 0);
+    test_assert(count == 3);
+    test_assert(log[0] == 0);
+    test_assert(log[1] == 1);
+    test_assert(log[2] == 2);
+
+    equeue_destroy(&q);
+}
+
+struct isr_post {
+    equeue_t *q;
+    int count;
+    int *touched;
+};
+
+void *isr_post_thread(void *p)
+{
+    struct isr_post *t = (struct isr_post *)p;
+    for (int i = 0; i < t->count; i++) {
+        int **e = equeue_alloc(t->q, sizeof(int *));
+        if (!e) {
+            usleep(1000);
+            i--;
+            continue;
+        }
+
+        *e = t->touched;
+        equeue_post_isr(t->q, (void (*)(void *))simple_func_indirect, e);
+    }
+
+    return 0;
+}
+
+void post_isr_test(void)
+{
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    int touched = 0;
+    int **e = equeue_alloc(&q, sizeof(int *));
+    test_assert(e);
+    *e = &touched;
+    int id = equeue_post_isr(&q, (void (*)(void *))simple_func_indirect, e);
+    test_assert(id);
+    test_assert(!q.queue);
+
+    equeue_dispatch(&q, 0);
+    test_assert(touched == 1);
+
+    // cancelled pending events are not dispatched
+    e = equeue_alloc(&q, sizeof(int *));
+    test_assert(e);
+    *e = &touched;
+    equeue_event_delay(e, 10);
+    id = equeue_post_isr(&q, (void (*)(void *))simple_func_indirect, e);
+    test_assert(id);
+    test_assert(equeue_timeleft(&q, id) > 0);
+    equeue_cancel(&q, id);
+
+    equeue_dispatch(&q, 20);
+    test_assert(touched == 1);
+
+    // pending events are merged with the existing queue in order
+    struct timing timings[3] = {{0, 10}, {0, 20}, {0, 30}};
+    for (int i = 0; i < 3; i++) {
+        struct timing *t = equeue_alloc(&q, sizeof(struct timing));
+        test_assert(t);
+        *t = timings[i];
+        t->tick = equeue_tick();
+        equeue_event_delay(t, t->delay);
+        if (i % 2) {
+            test_assert(equeue_post_isr(&q, timing_func, t));
+        } else {
+            test_assert(equeue_post(&q, timing_func, t));
+        }
+    }
+
+    equeue_dispatch(&q, 40);
+
+    equeue_destroy(&q);
+}
+
+void multithreaded_post_isr_test(int N)
+{
+    equeue_t q;
+    int err = equeue_create(&q, N * 64);
+    test_assert(!err);
+
+    int touched = 0;
+    struct isr_post t = {&q, N, &touched};
+    pthread_t threads[4];
+    for (int i = 0; i < 4; i++) {
+        err = pthread_create(&threads[i], 0, isr_post_thread, &t);
+        test_assert(!err);
+    }
+
+    while (touched < 4 * N) {
+        equeue_dispatch(&q, 1);
+    }
+
+    for (int i = 0; i < 4; i++) {
+        err = pthread_join(threads[i], 0);
+        test_assert(!err);
+    }
+
+    test_assert(touched == 4 * N);
+    equeue_destroy(&q);
+}
+
+void dispatch_due_test(void)
+{
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    test_assert(equeue_deadline(&q) == -1);
+    test_assert(equeue_dispatch_due(&q) == 0);
+
+    uint8_t touched = 0;
+    int id = equeue_call_in(&q, 20, simple_func, &touched);
+    test_assert(id);
+    test_assert(equeue_deadline(&q) > 10 && equeue_deadline(&q) <= 20);
+    test_assert(equeue_dispatch_due(&q) == 0);
+    test_assert(touched == 0);
+
+    test_assert(equeue_call(&q, simple_func, &touched));
+    test_assert(equeue_call(&q, simple_func, &touched));
+    test_assert(equeue_deadline(&q) == 0);
+    test_assert(equeue_dispatch_due(&q) == 2);
+    test_assert(touched == 2);
+
+    equeue_cancel(&q, id);
+    test_assert(equeue_deadline(&q) == -1);
+
+    equeue_destroy(&q);
+}
+
+struct dispatch_due {
+    equeue_t *q;
+    int N;
+    volatile int touched;
+};
+
+static void dispatch_due_func(void *p)
+{
+    struct dispatch_due *d = *(struct dispatch_due **)p;
+    __sync_fetch_and_add(&d->touched, 1);
+}
+
+static void *dispatch_due_thread(void *p)
+{
+    struct dispatch_due *d = (struct dispatch_due *)p;
+    while (d->touched < d->N) {
+        equeue_dispatch_due(d->q);
+    }
+
+    return 0;
+}
+
+void multithreaded_dispatch_due_test(int N)
+{
+    equeue_t q;
+    int err = equeue_create(&q, N * 64);
+    test_assert(!err);
+
+    struct dispatch_due d = {&q, N, 0};
+    for (int i = 0; i < N; i++) {
+        struct dispatch_due **e = equeue_alloc(&q, sizeof(struct dispatch_due *));
+        test_assert(e);
+        *e = &d;
+        equeue_event_delay(e, i % 4);
+        test_assert(equeue_post(&q, dispatch_due_func, e));
+    }
+
+    pthread_t threads[4];
+    for (int i = 0; i < 4; i++) {
+        err = pthread_create(&threads[i], 0, dispatch_due_thread, &d);
+        test_assert(!err);
+    }
+
+    for (int i = 0; i < 4; i++) {
+        err = pthread_join(threads[i], 0);
+        test_assert(!err);
+    }
+
+    // every event ran exactly once
+    test_assert(d.touched == N);
+    test_assert(equeue_deadline(&q) == -1);
+    equeue_destroy(&q);
+}
+
+void class_test(void)
+{
+    equeue_t q;
+    size_t classes[3] = {64, 8, 32};
+    int err = equeue_create_classes(&q, 4096, 0, classes, 3);
+    test_assert(!err);
+
+    equeue_class_stats_t stats[4];
+    test_assert(equeue_get_class_stats(&q, stats, 4) == 4);
+    test_assert(stats[0].size >= 8 && stats[0].size < 16);
+    test_assert(stats[1].size >= 32 && stats[1].size < 40);
+    test_assert(stats[2].size >= 64 && stats[2].size < 72);
+    test_assert(stats[3].size == 0);
+
+    // mixed sizes are served from their own classes
+    void *es[30];
+    for (int i = 0; i < 30; i++) {
+        es[i] = equeue_alloc(&q, (size_t[]){4, 24, 60}[i % 3]);
+        test_assert(es[i]);
+    }
+
+    equeue_get_class_stats(&q, stats, 4);
+    for (int i = 0; i < 3; i++) {
+        test_assert(stats[i].chunks == 10);
+        test_assert(stats[i].used == 10);
+        test_assert(stats[i].high_water == 10);
+    }
+    test_assert(stats[3].chunks == 0);
+
+    for (int i = 0; i < 30; i++) {
+        equeue_dealloc(&q, es[i]);
+    }
+
+    // chunks are reused without growing the classes
+    for (int i = 0; i < 15; i++) {
+        es[i] = equeue_alloc(&q, (size_t[]){4, 60}[i % 2]);
+        test_assert(es[i]);
+    }
+
+    void *big = equeue_alloc(&q, 128);
+    test_assert(big);
+
+    equeue_get_class_stats(&q, stats, 4);
+    test_assert(stats[0].chunks == 10 && stats[0].used == 8);
+    test_assert(stats[1].chunks == 10 && stats[1].used == 0);
+    test_assert(stats[2].chunks == 10 && stats[2].used == 7);
+    test_assert(stats[0].high_water == 10);
+    test_assert(stats[3].chunks == 1 && stats[3].used == 1);
+
+    for (int i = 0; i < 15; i++) {
+        equeue_dealloc(&q, es[i]);
+    }
+    equeue_dealloc(&q, big);
+
+    // events still dispatch normally
+    int touched = 0;
+    equeue_call(&q, simple_func, &touched);
+    equeue_dispatch(&q, 0);
+    test_assert(touched == 1);
+
+    equeue_destroy(&q);
+}
+
+void class_exhaustion_test(void)
+{
+    equeue_t q;
+    size_t classes[2] = {8, 64};
+    int err = equeue_create_classes(&q, 4 * (64 + sizeof(struct equeue_event)),
+                                    0, classes, 2);
+    test_assert(!err);
+
+    // small allocations borrow from the larger class when the buffer runs out
+    void *es[4];
+    for (int i = 0; i < 4; i++) {
+        es[i] = equeue_alloc(&q, 64);
+        test_assert(es[i]);
+    }
+    test_assert(!equeue_alloc(&q, 8));
+
+    equeue_dealloc(&q, es[0]);
+    es[0] = equeue_alloc(&q, 8);
+    test_assert(es[0]);
+
+    equeue_class_stats_t stats[3];
+    equeue_get_class_stats(&q, stats, 3);
+    test_assert(stats[0].chunks == 0);
+    test_assert(stats[1].chunks == 4 && stats[1].used == 4);
+
+    for (int i = 0; i < 4; i++) {
+        equeue_dealloc(&q, es[i]);
+    }
+
+    equeue_destroy(&q);
+}
+
+void batch_test(void)
+{
+    equeue_t q;
+    int err = equeue_create(&q, 16 * (EQUEUE_EVENT_SIZE + sizeof(struct order)));
+    test_assert(!err);
+
+    int log[8];
+    int count = 0;
+    struct order orders[8];
+    void (*cbs[8])(void *);
+    void *data[8];
+    int ids[8];
+    for (int i = 0; i < 8; i++) {
+        orders[i].log = log;
+        orders[i].count = &count;
+        orders[i].value = i;
+        cbs[i] = order_func;
+        data[i] = &orders[i];
+    }
+
+    test_assert(equeue_call_batch(&q, cbs, data, 8, ids) == 8);
+    for (int i = 0; i < 8; i++) {
+        test_assert(ids[i]);
+        for (int j = 0; j < i; j++) {
+            test_assert(ids[i] != ids[j]);
+        }
+    }
+
+    equeue_cancel(&q, ids[3]);
+    equeue_dispatch(&q, 0);
+    test_assert(count == 7);
+    for (int i = 0; i < 7; i++) {
+        test_assert(log[i] == i + (i >= 3));
+    }
+
+    // batches are all or nothing
+    equeue_t small;
+    err = equeue_create(&small, 4 * EQUEUE_EVENT_SIZE);
+    test_assert(!err);
+    test_assert(!equeue_call_batch(&small, cbs, data, 8, 0));
+    test_assert(equeue_call_batch(&small, cbs, data, 4, 0) == 4);
+    equeue_dispatch(&small, 0);
+    test_assert(count == 11);
+    equeue_destroy(&small);
+
+    // events in a batch can be configured individually
+    struct order *o = equeue_alloc_batch(&q, sizeof(struct order), 2);
+    test_assert(o);
+    struct order *n = equeue_batch_next(o);
+    test_assert(n && !equeue_batch_next(n));
+    *o = orders[0];
+    *n = orders[1];
+    equeue_event_delay(o, 10);
+    test_assert(equeue_post_batch(&q, order_func, o, 0) == 2);
+
+    count = 0;
+    equeue_dispatch(&q, 0);
+    test_assert(count == 1 && log[0] == 1);
+    equeue_dispatch(&q, 20);
+    test_assert(count == 2 && log[1] == 0);
+
+    equeue_destroy(&q);
+}
+
+void stats_test(void)
+{
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    equeue_stats_t stats;
+    equeue_get_stats(&q, &stats);
+    test_assert(stats.dispatched == 0);
+
+    int touched = 0;
+    equeue_call(&q, simple_func, &touched);
+    equeue_call(&q, sloth_func, &touched);
+    equeue_dispatch(&q, 0);
+    test_assert(touched == 2);
+
+    equeue_get_stats(&q, &stats);
+#ifdef EQUEUE_STATS_ENABLED
+    test_assert(stats.dispatched == 2);
+    test_assert(stats.slowest == sloth_func);
+    test_assert(stats.max_runtime >= 9 && stats.max_runtime < 20);
+
+    unsigned runtimes = 0;
+    unsigned latenesses = 0;
+    for (int i = 0; i < EQUEUE_STATS_BUCKETS; i++) {
+        runtimes += stats.runtime[i];
+        latenesses += stats.lateness[i];
+    }
+    test_assert(runtimes == 2 && latenesses == 2);
+    test_assert(stats.runtime[4] == 1);
+
+    equeue_reset_stats(&q);
+    equeue_get_stats(&q, &stats);
+#endif
+    test_assert(stats.dispatched == 0);
+    test_assert(stats.max_runtime == 0);
+
+    equeue_destroy(&q);
+}
+
+struct user_event {
+    struct equeue_event e;
+    int count;
+};
+
+void user_allocated_test(void)
+{
+    equeue_t q;
+    int err = equeue_create(&q, 2048);
+    test_assert(!err);
+
+    struct user_event u;
+    equeue_user_allocated_init(&u.count);
+    u.count = 0;
+
+    // an event can only be posted again once it has been dispatched
+    test_assert(equeue_post_user_allocated(&q, 0, -1, simple_func, &u.count));
+    test_assert(!equeue_post_user_allocated(&q, 0, -1, simple_func, &u.count));
+    equeue_dispatch(&q, 0);
+    test_assert(u.count == 1);
+    test_assert(equeue_post_user_allocated(&q, 0, -1, simple_func, &u.count));
+    equeue_dispatch(&q, 0);
+    test_assert(u.count == 2);
+
+    // or cancelled
+    test_assert(equeue_post_user_allocated(&q, 10, -1, simple_func, &u.count));
+    test_assert(equeue_cancel_user_allocated(&q, &u.count));
+    test_assert(!equeue_cancel_user_allocated(&q, &u.count));
+    equeue_dispatch(&q, 20);
+    test_assert(u.count == 2);
+
+    // periodic events keep reusing the same memory alongside allocated ones
+    int touched = 0;
+    test_assert(equeue_post_user_allocated(&q, 10, 10, simple_func, &u.count));
+    test_assert(equeue_call_in(&q, 5, simple_func, &touched));
+    equeue_dispatch(&q, 55);
+    test_assert(u.count == 7 && touched == 1);
+    test_assert(equeue_cancel_user_allocated(&q, &u.count));
+    equeue_dispatch(&q, 20);
+    test_assert(u.count == 7);
+    test_assert(equeue_post_user_allocated(&q, 0, -1, simple_func, &u.count));
+    equeue_dispatch(&q, 0);
+    test_assert(u.count == 8);
+
+    equeue_destroy(&q);
+}
+
 int main()
 {
     printf("beginning tests...\n");
@@ -826,10 +1398,22 @@ int main()
     test_run(unchain_test);
     test_run(multithread_test);
     test_run(simple_barrage_test, 20);
+    test_run(cancelling_barrage_test, 200);
     test_run(fragmenting_barrage_test, 20);
     test_run(multithreaded_barrage_test, 20);
     test_run(break_request_cleared_on_timeout);
     test_run(sibling_test);
+    test_run(priority_test);
+    test_run(priority_preempt_test);
+    test_run(class_test);
+    test_run(class_exhaustion_test);
+    test_run(batch_test);
+    test_run(stats_test);
+    test_run(post_isr_test);
+    test_run(multithreaded_post_isr_test, 1000);
+    test_run(dispatch_due_test);
+    test_run(multithreaded_dispatch_due_test, 1000);
+    test_run(user_allocated_test);
     printf("done!\n");
     return test_failure;
 }
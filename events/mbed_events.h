@@ -28,9 +28,14 @@
 
 #include "events/EventQueue.h"
 #include "events/Event.h"
+#include "events/UserAllocatedEvent.h"
 
 #include "events/mbed_shared_queues.h"
 
+#ifdef MBED_CONF_RTOS_PRESENT
+#include "events/EventQueuePool.h"
+#endif
+
 #ifndef MBED_NO_GLOBAL_USING_DIRECTIVE
 using namespace events;
 #endif
@@ -124,7 +124,8 @@ public:
         _read_allowed(true),
         _read_security(Security_t::NONE),
         _write_allowed(true),
-        _write_security(Security_t::NONE) {
+        _write_security(Security_t::NONE),
+        _app_owned_value(false) {
     }
 
 public:
@@ -291,6 +292,43 @@ public:
         return static_cast<Security_t::type>(_write_security);
     }
 
+    /**
+     * Keep the value of the attribute in the application's memory buffer.
+     *
+     * By default the GATT server copies the value into storage of its own
+     * when the attribute is registered and every time it is written. If the
+     * value is owned by the application, the server instead serves client
+     * reads directly from the buffer passed at construction, and values
+     * written by clients land in it. The current length is the one returned
+     * by getLength().
+     *
+     * The application may then update the value in place and call
+     * GattServer::write() with the same buffer to set the new length and
+     * send notifications or indications, without the value being copied.
+     *
+     * @note The buffer must be writable and remain valid while the
+     * attribute is registered in the GATT server. It must be set before the
+     * service containing the attribute is added to the GATT server.
+     *
+     * @note Not every GATT server supports it, others keep copying the value.
+     *
+     * @param owned The value is kept in the application buffer if true.
+     */
+    void setValueOwnedByApplication(bool owned)
+    {
+        _app_owned_value = owned;
+    }
+
+    /**
+     * Indicate if the value of the attribute is kept in the application's
+     * memory buffer.
+     * @return true if the value is owned by the application.
+     */
+    bool isValueOwnedByApplication(void) const
+    {
+        return _app_owned_value;
+    }
+
 private:
     /**
      * Characteristic's UUID.
@@ -342,6 +380,11 @@ private:
      */
     uint8_t _write_security: Security_t::size;
 
+    /**
+     * Whether the value is kept in the application buffer.
+     */
+    uint8_t _app_owned_value:1;
+
 private:
     /* Disallow copy and assignment. */
     GattAttribute(const GattAttribute &);
@@ -688,6 +688,34 @@ public:
         return BLE_ERROR_NOT_IMPLEMENTED;
     }
 
+    /**
+     * Reuse the result of a complete service discovery on later connections
+     * to the same bonded peer.
+     *
+     * Once enabled, a discovery launched without service or characteristic
+     * filter on a bonded peer is recorded against the identity of the peer.
+     * Later discoveries on connections to that peer are answered from the
+     * record, without exchanging ATT requests; the callbacks may then be
+     * invoked before launchServiceDiscovery() returns.
+     *
+     * A record is dropped when the peer indicates a change of its database
+     * through the Service Changed characteristic. Indications of that
+     * characteristic must be enabled by the application.
+     *
+     * @param enable True to record and reuse discoveries, false to stop and
+     * drop the records.
+     *
+     * @return BLE_ERROR_NONE if the cache has been configured or an
+     * appropriate error.
+     */
+    virtual ble_error_t enableDiscoveryCache(bool enable = true)
+    {
+        /* Requesting action from porter(s): override this API if this
+           capability is supported. */
+        (void) enable;
+        return BLE_ERROR_NOT_IMPLEMENTED;
+    }
+
     /**
      * Register an handler for Handle Value Notification/Indication events.
      *
@@ -106,6 +106,23 @@ public:
         )
         {
         }
+
+        /**
+         * Function invoked when the notifications queued for a connection
+         * have been handed to the controller and more can be sent.
+         *
+         * Notifications written while a previous one is still waiting for
+         * the link are queued by the implementation; once the queue is full
+         * write() fails with BLE_ERROR_NO_MEM. This event signals when
+         * streaming can resume without polling or delays.
+         *
+         * @param connectionHandle The handle of the connection ready to send.
+         */
+        virtual void onAttTxReady(
+            ble::connection_handle_t connectionHandle
+        )
+        {
+        }
     };
 
     /**
@@ -326,6 +343,10 @@ public:
      * characteristic's notifications or indications. Otherwise, the update does
      * not generate a single server initiated event.
      *
+     * @note If the attribute value is owned by the application and @p value
+     * is its buffer, the value is not copied.
+     * @see GattAttribute::setValueOwnedByApplication
+     *
      * @return BLE_ERROR_NONE if the attribute value has been successfully
      * updated.
      */
@@ -364,6 +385,10 @@ public:
      * notifications or indications. Otherwise, the update does not generate a
      * single server initiated event.
      *
+     * @note If the attribute value is owned by the application and @p value
+     * is its buffer, the value is not copied.
+     * @see GattAttribute::setValueOwnedByApplication
+     *
      * @return BLE_ERROR_NONE if the attribute value has been successfully
      * updated.
      */
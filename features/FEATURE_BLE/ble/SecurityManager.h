@@ -442,7 +442,10 @@ public:
      * @param[in]  passkey       To specify a static passkey.
      * @param[in]  signing       Generate and distribute signing key during pairing
      * @param[in]  dbFilepath    Path to the file used to store keys in the filesystem,
-     *                           if NULL keys will be only stored in memory
+     *                           if NULL keys will be only stored in memory. With
+     *                           ble.security-db-kvstore set, a path starting with
+     *                           /kv/ stores keys in the KVStore, under keys starting
+     *                           with the path.
      *
      *
      * @return BLE_ERROR_NONE on success.
@@ -470,7 +473,10 @@ public:
      * @note This operation is only allowed with no active connections.
      *
      * @param[in]  dbFilepath    Path to the file used to store keys in the filesystem,
-     *                           if NULL keys will be only stored in memory
+     *                           if NULL keys will be only stored in memory. With
+     *                           ble.security-db-kvstore set, a path starting with
+     *                           /kv/ stores keys in the KVStore, under keys starting
+     *                           with the path.
      *
      * @return BLE_ERROR_NONE on success.
      */
@@ -1000,6 +1006,32 @@ public:
         return BLE_ERROR_NOT_IMPLEMENTED; /* Requesting action from porters: override this API if security is supported. */
     }
 
+    /**
+     * Get the identity of the bonded peer of a connection.
+     *
+     * Unlike the address of the connection, the identity does not change
+     * when the peer uses resolvable private addresses.
+     *
+     * @param[in]  connectionHandle Handle to identify the connection.
+     * @param[out] address          Identity address of the peer.
+     * @param[out] isPublic         True if the address is public, false if it
+     *                              is static random.
+     *
+     * @retval BLE_ERROR_NONE             On success, else an error code indicating reason for failure.
+     * @retval BLE_ERROR_INVALID_STATE    If the peer is not bonded.
+     */
+    virtual ble_error_t getPeerIdentity(
+        ble::connection_handle_t connectionHandle,
+        ble::address_t *address,
+        bool *isPublic
+    ) {
+        /* Avoid compiler warnings about unused variables */
+        (void) connectionHandle;
+        (void) address;
+        (void) isPublic;
+        return BLE_ERROR_NOT_IMPLEMENTED; /* Requesting action from porters: override this API if security is supported. */
+    }
+
     /**
      * @deprecated
      *
@@ -817,6 +817,84 @@ private:
 
 };
 
+/**
+ * Event received when the parameters that bound the goodput of a connection
+ * tuned with ble::Gap::setLinkProfile() have changed.
+ *
+ * @see ble::Gap::EventHandler::onLinkGoodputUpdate().
+ */
+struct LinkGoodputUpdateEvent {
+#if !defined(DOXYGEN_ONLY)
+
+    LinkGoodputUpdateEvent(
+        connection_handle_t connectionHandle,
+        phy_t txPhy,
+        uint16_t txOctets,
+        const conn_interval_t &connectionInterval,
+        uint32_t goodput
+    ) :
+        connectionHandle(connectionHandle),
+        txPhy(txPhy),
+        txOctets(txOctets),
+        connectionInterval(connectionInterval),
+        goodput(goodput)
+    {
+    }
+
+#endif
+
+    /**
+     * Get the handle of the connection.
+     */
+    connection_handle_t getConnectionHandle() const
+    {
+        return connectionHandle;
+    }
+
+    /**
+     * Get the PHY used to transmit.
+     */
+    phy_t getTxPhy() const
+    {
+        return txPhy;
+    }
+
+    /**
+     * Get the maximum payload of a transmitted link layer packet.
+     */
+    uint16_t getTxOctets() const
+    {
+        return txOctets;
+    }
+
+    /**
+     * Get the connection interval.
+     */
+    const conn_interval_t &getConnectionInterval() const
+    {
+        return connectionInterval;
+    }
+
+    /**
+     * Get the goodput of notifications or write commands the link can carry
+     * in bits per second.
+     *
+     * @note This is the ceiling set by the link parameters, assuming the
+     * controllers fill every connection event and no packet is lost.
+     */
+    uint32_t getGoodput() const
+    {
+        return goodput;
+    }
+
+private:
+    ble::connection_handle_t connectionHandle;
+    ble::phy_t txPhy;
+    uint16_t txOctets;
+    ble::conn_interval_t connectionInterval;
+    uint32_t goodput;
+};
+
 /**
  * @}
  * @}
@@ -24,6 +24,7 @@
 #include "ble/gap/AdvertisingDataSimpleBuilder.h"
 #include "ble/gap/ConnectionParameters.h"
 #include "ble/gap/ScanParameters.h"
+#include "ble/gap/ScanFilter.h"
 #include "ble/gap/AdvertisingParameters.h"
 #include "ble/gap/Events.h"
 
@@ -420,6 +421,18 @@ public:
         {
         }
 
+        /**
+         * Called when the PHY, packet length or connection interval of a
+         * connection tuned with setLinkProfile() have changed.
+         *
+         * @param event The new link parameters and the goodput they allow.
+         *
+         * @see setLinkProfile()
+         */
+        virtual void onLinkGoodputUpdate(const LinkGoodputUpdateEvent &event)
+        {
+        }
+
         /**
          * Called when a connection has been disconnected.
          *
@@ -785,6 +798,23 @@ public:
      */
     virtual ble_error_t stopScan();
 
+    /**
+     * Select the advertising reports delivered to the application.
+     *
+     * Reports which do not match the filter, or which come from an
+     * advertiser reported less than the report interval of the filter ago,
+     * are dropped before EventHandler::onAdvertisingReport is called.
+     *
+     * @param filter The filter to apply; an empty filter without report
+     * interval delivers every report.
+     *
+     * @return BLE_ERROR_NONE if the filter has been applied or an appropriate
+     * error code.
+     *
+     * @see ScanFilter
+     */
+    virtual ble_error_t setScanFilter(const ScanFilter &filter);
+
     /** Synchronize with periodic advertising from an advertiser and begin receiving periodic
      *  advertising packets.
      *
@@ -956,6 +986,32 @@ public:
         conn_event_length_t maxConnectionEventLength = conn_event_length_t(0)
     );
 
+    /**
+     * Tune a connection for throughput, latency or power.
+     *
+     * The PHY, the link layer packet length and the connection parameters
+     * are negotiated with the peer to match the profile, within what the
+     * controllers support. Each procedure completes independently and is
+     * reported by its usual event; the goodput the link then allows is
+     * reported by EventHandler::onLinkGoodputUpdate.
+     *
+     * @param connectionHandle The handle of the connection to tune.
+     * @param profile The target of the tuning.
+     *
+     * @return BLE_ERROR_NONE if the procedures have been started or an
+     * appropriate error code.
+     *
+     * @note The ATT MTU is not part of the link profile; a GATT client
+     * should call GattClient::negotiateAttMtu() so that attribute values
+     * fill the longer packets.
+     *
+     * @see EventHandler::onLinkGoodputUpdate
+     */
+    virtual ble_error_t setLinkProfile(
+        connection_handle_t connectionHandle,
+        link_profile_t profile
+    );
+
     /**
      * Allows the application to accept or reject a connection parameters update
      * request.
@@ -0,0 +1,185 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#ifndef MBED_GAP_SCAN_FILTER_H__
+#define MBED_GAP_SCAN_FILTER_H__
+
+#include <stdint.h>
+#include "ble/blecommon.h"
+#include "ble/UUID.h"
+#include "BLETypes.h"
+#include "platform/Span.h"
+
+namespace ble {
+
+/**
+ * @addtogroup ble
+ * @{
+ * @addtogroup gap
+ * @{
+ */
+
+/**
+ * Filter applied to advertising reports before they reach the application.
+ *
+ * A report is delivered if it matches any of the entries of the filter: the
+ * address of the advertiser, a service UUID listed in the payload or the
+ * beginning of the manufacturer specific data of the payload. A filter
+ * without entries lets every report through.
+ *
+ * Independently of the entries, a report interval limits how often reports
+ * of the same advertiser are delivered. It complements the duplicate
+ * filtering of the controller, which drops repeated payloads but lets
+ * advertisers changing their payload, like most beacons, flood the host.
+ *
+ * @note Reports are filtered on the host. To drop reports in the controller
+ * instead, use the whitelist with scanning_filter_policy_t of ScanParameters
+ * and duplicates_filter_t of Gap::startScan().
+ *
+ * @see Gap::setScanFilter()
+ */
+class ScanFilter {
+public:
+    /** Maximum number of advertiser addresses in a filter. */
+    static const size_t MAX_PEER_ADDRESSES = 4;
+
+    /** Maximum number of service UUIDs in a filter. */
+    static const size_t MAX_SERVICE_UUIDS = 4;
+
+    /** Maximum number of manufacturer data patterns in a filter. */
+    static const size_t MAX_MANUFACTURER_PATTERNS = 2;
+
+    /** Maximum size of a manufacturer data pattern. */
+    static const size_t MAX_MANUFACTURER_PATTERN_SIZE = 8;
+
+    /**
+     * Construct a filter which lets every report through.
+     */
+    ScanFilter() :
+        _peer_address_count(0),
+        _service_uuid_count(0),
+        _manufacturer_pattern_count(0),
+        _report_interval(0)
+    {
+    }
+
+    /**
+     * Deliver the reports of an advertiser.
+     *
+     * @param address Address of the advertiser.
+     *
+     * @return BLE_ERROR_NONE on success or BLE_ERROR_NO_MEM if the filter
+     * already holds MAX_PEER_ADDRESSES addresses.
+     */
+    ble_error_t addPeerAddress(const address_t &address);
+
+    /**
+     * Deliver the reports listing a service UUID.
+     *
+     * @param uuid The UUID of the service, 16 or 128 bits.
+     *
+     * @return BLE_ERROR_NONE on success or BLE_ERROR_NO_MEM if the filter
+     * already holds MAX_SERVICE_UUIDS UUIDs.
+     */
+    ble_error_t addServiceUuid(const UUID &uuid);
+
+    /**
+     * Deliver the reports whose manufacturer specific data starts with a
+     * pattern.
+     *
+     * @param pattern Bytes expected at the start of the manufacturer specific
+     * data, company identifier first.
+     *
+     * @return BLE_ERROR_NONE on success, BLE_ERROR_INVALID_PARAM if the pattern
+     * is empty or larger than MAX_MANUFACTURER_PATTERN_SIZE or BLE_ERROR_NO_MEM
+     * if the filter already holds MAX_MANUFACTURER_PATTERNS patterns.
+     */
+    ble_error_t addManufacturerData(mbed::Span<const uint8_t> pattern);
+
+    /**
+     * Set the minimum time between two reports of the same advertiser.
+     *
+     * @param interval The minimum time; zero delivers every report.
+     *
+     * @return A reference to this object.
+     */
+    ScanFilter &setReportInterval(millisecond_t interval)
+    {
+        _report_interval = interval;
+        return *this;
+    }
+
+    /**
+     * Get the minimum time between two reports of the same advertiser.
+     */
+    millisecond_t getReportInterval() const
+    {
+        return _report_interval;
+    }
+
+    /**
+     * Remove all entries and the report interval.
+     *
+     * @return A reference to this object.
+     */
+    ScanFilter &clear()
+    {
+        *this = ScanFilter();
+        return *this;
+    }
+
+    /**
+     * Return true if the filter has no entry.
+     */
+    bool isEmpty() const
+    {
+        return !_peer_address_count && !_service_uuid_count &&
+            !_manufacturer_pattern_count;
+    }
+
+    /**
+     * Check if a report matches the entries of the filter.
+     *
+     * @param address Address of the advertiser.
+     * @param payload Advertising data of the report.
+     *
+     * @return true if the report should be delivered.
+     */
+    bool matches(const address_t &address, mbed::Span<const uint8_t> payload) const;
+
+private:
+    bool matches_service_uuid(const UUID &uuid) const;
+
+    bool matches_manufacturer_data(mbed::Span<const uint8_t> data) const;
+
+    address_t _peer_addresses[MAX_PEER_ADDRESSES];
+    UUID _service_uuids[MAX_SERVICE_UUIDS];
+    uint8_t _manufacturer_patterns[MAX_MANUFACTURER_PATTERNS][MAX_MANUFACTURER_PATTERN_SIZE];
+    uint8_t _manufacturer_pattern_sizes[MAX_MANUFACTURER_PATTERNS];
+    uint8_t _peer_address_count;
+    uint8_t _service_uuid_count;
+    uint8_t _manufacturer_pattern_count;
+    millisecond_t _report_interval;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+} // namespace ble
+
+#endif /* ifndef MBED_GAP_SCAN_FILTER_H__ */
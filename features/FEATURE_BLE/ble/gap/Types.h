@@ -846,6 +846,44 @@ struct disconnection_reason_t : SafeEnum<disconnection_reason_t, uint8_t> {
     }
 };
 
+/**
+ * Target a connection is tuned for.
+ *
+ * @see ble::Gap::setLinkProfile().
+ */
+struct link_profile_t : SafeEnum<link_profile_t, uint8_t> {
+    /// enumeration of link_profile_t values.
+    enum type {
+        /**
+         * Move as much data as possible: 2M PHY, longest link layer packets
+         * and a connection interval long enough to fill each event.
+         */
+        HIGH_THROUGHPUT,
+
+        /**
+         * Deliver small updates quickly: 2M PHY, longest link layer packets
+         * and the shortest connection interval.
+         */
+        LOW_LATENCY,
+
+        /**
+         * Keep the radio off as much as possible: long connection interval
+         * with slave latency. The 2M PHY and longest packets still shorten
+         * the time on air of each exchange.
+         */
+        LOW_POWER
+    };
+
+    /**
+     * Construct a new instance of link_profile_t.
+     *
+     * @param value The value of the link_profile_t created.
+     */
+    link_profile_t(type value) : SafeEnum(value)
+    {
+    }
+};
+
 /**
  * Privacy Configuration of the peripheral role.
  *
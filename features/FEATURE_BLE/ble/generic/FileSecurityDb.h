@@ -21,6 +21,18 @@
 
 #include <stdio.h>
 
+/* Number of writes held in memory before they are written to the file,
+ * 0 writes through */
+#ifndef MBED_CONF_BLE_SECURITY_DB_WRITE_BACK_ENTRIES
+#define MBED_CONF_BLE_SECURITY_DB_WRITE_BACK_ENTRIES 0
+#endif
+
+/* Age in milliseconds of the oldest held write at which writes are written
+ * to the file, checked on each write, 0 for no limit */
+#ifndef MBED_CONF_BLE_SECURITY_DB_FLUSH_INTERVAL_MS
+#define MBED_CONF_BLE_SECURITY_DB_FLUSH_INTERVAL_MS 0
+#endif
+
 namespace ble {
 namespace generic {
 
@@ -40,18 +52,38 @@ private:
         return reinterpret_cast<entry_t*>(db_handle);
     }
 
+    /* largest value held in memory, a key */
+    static const size_t MAX_PENDING_SIZE = sizeof(ltk_t);
+
+    static const size_t MAX_PENDING =
+        MBED_CONF_BLE_SECURITY_DB_WRITE_BACK_ENTRIES ? MBED_CONF_BLE_SECURITY_DB_WRITE_BACK_ENTRIES : 1;
+
+    struct pending_write_t {
+        long int offset;
+        size_t size;
+        uint8_t data[MAX_PENDING_SIZE];
+    };
+
     template<class T>
     void db_read(T *value, long int offset) {
         fseek(_db_file, offset, SEEK_SET);
         fread(value, sizeof(T), 1, _db_file);
+        apply_pending(value, sizeof(T), offset);
     }
 
     template<class T>
     void db_write(T *value, long int offset) {
-        fseek(_db_file, offset, SEEK_SET);
-        fwrite(value, sizeof(T), 1, _db_file);
+        db_write(static_cast<const void *>(value), sizeof(T), offset);
     }
 
+    void db_write(const void *value, size_t size, long int offset);
+
+    /* overlay the writes still held in memory on a value read from the file */
+    void apply_pending(void *value, size_t size, long int offset);
+
+    /* forget the writes held in memory overlapping a range of the file */
+    void drop_pending(long int offset, size_t size);
+
 public:
     FileSecurityDb(FILE *db_file);
     virtual ~FileSecurityDb();
@@ -126,6 +158,16 @@ public:
 
     virtual void set_restore(bool reload);
 
+    /**
+     * Write the changes held in memory to the file.
+     *
+     * Changes are held in memory when ble.security-db-write-back-entries is
+     * set and written on sync(), which is called on disconnection, once that
+     * many distinct values changed, or once the oldest change is
+     * ble.security-db-flush-interval-ms old.
+     */
+    void flush();
+
 private:
     virtual uint8_t get_entry_count();
 
@@ -149,6 +191,9 @@ private:
     entry_t _entries[MAX_ENTRIES];
     FILE *_db_file;
     uint8_t _buffer[sizeof(SecurityEntryKeys_t)];
+    pending_write_t _pending[MAX_PENDING];
+    size_t _pending_count;
+    uint64_t _pending_since_us;
 };
 
 } /* namespace pal */
@@ -32,6 +32,11 @@
 #include "ble/pal/ConnectionEventMonitor.h"
 
 #include "drivers/Timeout.h"
+#if DEVICE_LPTICKER
+#include "drivers/LowPowerTimer.h"
+#else
+#include "drivers/Timer.h"
+#endif
 
 namespace ble {
 namespace generic {
@@ -187,6 +192,10 @@ public:
         scan_period_t period
     );
 
+    /** @copydoc Gap::setScanFilter
+     */
+    virtual ble_error_t setScanFilter(const ScanFilter &filter);
+
     /** @copydoc Gap::createSync
      */
     virtual ble_error_t createSync(
@@ -325,6 +334,11 @@ public:
         conn_event_length_t maxConnectionEventLength
     );
 
+    virtual ble_error_t setLinkProfile(
+        connection_handle_t connectionHandle,
+        link_profile_t profile
+    );
+
     virtual ble_error_t acceptConnectionParametersUpdate(
         connection_handle_t connectionHandle,
         conn_interval_t minConnectionInterval,
@@ -797,6 +811,52 @@ private:
     BitArray<MAX_ADVERTISING_SETS> _connectable_payload_size_exceeded;
     BitArray<MAX_ADVERTISING_SETS> _set_is_connectable;
 
+    // Parameters bounding the goodput of each connection
+    struct link_state_t {
+        link_state_t() :
+            connection(),
+            tx_phy(phy_t::LE_1M),
+            tx_octets(0),
+            interval(0),
+            in_use(false),
+            profiled(false)
+        {
+        }
+
+        connection_handle_t connection;
+        phy_t tx_phy;
+        uint16_t tx_octets;
+        uint16_t interval;
+        bool in_use : 1;
+        bool profiled : 1;
+    };
+
+    static const size_t MAX_LINK_STATES = 5;
+    link_state_t _link_states[MAX_LINK_STATES];
+
+    // Advertisers recently reported through the scan filter
+    struct scan_report_record_t {
+        scan_report_record_t() :
+            address(),
+            last_report(0),
+            in_use(false)
+        {
+        }
+
+        ble::address_t address;
+        uint32_t last_report;
+        bool in_use;
+    };
+
+    static const size_t MAX_SCAN_REPORT_RECORDS = 16;
+    ScanFilter _scan_filter;
+    scan_report_record_t _scan_report_records[MAX_SCAN_REPORT_RECORDS];
+#if DEVICE_LPTICKER
+    mbed::LowPowerTimer _scan_report_timer;
+#else
+    mbed::Timer _scan_report_timer;
+#endif
+
     // deprecation flags
     mutable bool _deprecated_scan_api_used : 1;
     mutable bool _non_deprecated_scan_api_used : 1;
@@ -809,6 +869,15 @@ private:
     );
 
     bool is_extended_advertising_available();
+
+    link_state_t *get_link_state(connection_handle_t connection);
+
+    void report_link_goodput(const link_state_t &link);
+
+    bool filter_scan_report(
+        const ble::address_t &address,
+        mbed::Span<const uint8_t> payload
+    );
 };
 
 }
@@ -133,6 +133,11 @@ public:
         connection_handle_t connection
     );
 
+    /**
+     * @see GattClient::enableDiscoveryCache
+     */
+    virtual ble_error_t enableDiscoveryCache(bool enable);
+
 	/**
 	 * @see GattClient::reset
 	 */
@@ -157,6 +162,20 @@ private:
     struct ReadControlBlock;
     struct WriteControlBlock;
     struct DescriptorDiscoveryControlBlock;
+    struct cached_attribute_t;
+
+    /*
+     * Services and characteristics discovered on a bonded peer, keyed by its
+     * identity address.
+     */
+    struct discovery_cache_t {
+        address_t peer_address;
+        bool peer_address_is_public;
+        uint16_t service_changed_handle;
+        cached_attribute_t* attributes;
+    };
+
+    static const size_t MAX_DISCOVERY_CACHES = 3;
 
     ProcedureControlBlock* get_control_block(connection_handle_t connection);
     const ProcedureControlBlock* get_control_block(connection_handle_t connection) const;
@@ -171,11 +190,18 @@ private:
 
     uint16_t get_mtu(connection_handle_t connection) const;
 
+    discovery_cache_t* get_discovery_cache(connection_handle_t connection);
+    void store_discovery_cache(connection_handle_t connection, cached_attribute_t* attributes);
+    void release_discovery_cache(discovery_cache_t& cache);
+
     pal::GattClient* const _pal_client;
     ServiceDiscovery::TerminationCallback_t _termination_callback;
     pal::SigningEventMonitor::EventHandler* _signing_event_handler;
     mutable ProcedureControlBlock* control_blocks;
     bool _is_reseting;
+    bool _discovery_cache_enabled;
+    discovery_cache_t _discovery_caches[MAX_DISCOVERY_CACHES];
+    size_t _next_discovery_cache;
 };
 
 }
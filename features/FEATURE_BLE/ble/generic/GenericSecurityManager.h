@@ -71,6 +71,12 @@ public:
         ::Gap::Whitelist_t *whitelist
     ) const;
 
+    virtual ble_error_t getPeerIdentity(
+        connection_handle_t connection,
+        address_t *address,
+        bool *is_public
+    );
+
     ////////////////////////////////////////////////////////////////////////////
     // Pairing
     //
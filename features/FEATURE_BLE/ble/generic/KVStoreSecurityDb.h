@@ -0,0 +1,84 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GENERIC_KVSTORE_SECURITY_DB_H_
+#define GENERIC_KVSTORE_SECURITY_DB_H_
+
+#include "MemorySecurityDb.h"
+
+namespace ble {
+namespace generic {
+
+/**
+ * KVStore implementation.
+ *
+ * Entries are held in memory and each one is stored as a key of the KVStore
+ * global API when it is synced, on disconnection, so repeated changes such
+ * as sign counter increments cost no storage write.
+ */
+class KVStoreSecurityDb : public MemorySecurityDb {
+public:
+    /**
+     * @param key_prefix prefix of the keys of the database, including the
+     * KVStore path, such as "/kv/ble_sec", copied and truncated to
+     * MAX_KEY_PREFIX_SIZE - 1 characters
+     */
+    KVStoreSecurityDb(const char *key_prefix);
+    virtual ~KVStoreSecurityDb() { }
+
+    /**
+     * Check the prefix is a KVStore global API path.
+     * @param db_path database path
+     * @return true if db_path starts with "/kv/"
+     */
+    static bool is_kvstore_path(const char *db_path);
+
+    /* saving and loading from nvm */
+
+    virtual void restore();
+
+    virtual void sync(entry_handle_t db_handle);
+
+    virtual void set_restore(bool reload);
+
+private:
+    virtual void reset_entry(entry_handle_t db_handle);
+
+    /* build the key of the database ending with suffix */
+    void get_key(char *key, const char *suffix);
+
+    /* build the key of an entry */
+    void get_entry_key(char *key, const entry_t *entry);
+
+    void store_local();
+
+    struct local_t {
+        uint16_t version;
+        SecurityEntryIdentity_t identity;
+        csrk_t csrk;
+        sign_count_t sign_counter;
+    };
+
+    static const size_t MAX_KEY_PREFIX_SIZE = 64;
+
+private:
+    char _key_prefix[MAX_KEY_PREFIX_SIZE];
+};
+
+} /* namespace pal */
+} /* namespace ble */
+
+#endif /*GENERIC_KVSTORE_SECURITY_DB_H_*/
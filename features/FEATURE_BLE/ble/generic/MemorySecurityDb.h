@@ -24,7 +24,7 @@ namespace generic {
 
 /** Naive memory implementation for verification. */
 class MemorySecurityDb : public SecurityDb {
-private:
+protected:
     struct entry_t {
         entry_t() { };
         SecurityDistributionFlags_t flags;
@@ -186,7 +186,7 @@ private:
         return &entry->peer_signing;
     };
 
-private:
+protected:
     entry_t _entries[MAX_ENTRIES];
 };
 
@@ -1599,6 +1599,29 @@ struct Gap {
         coded_symbol_per_bit_t coded_symbol
     ) = 0;
 
+    /**
+     * Suggest the maximum payload and transmission time of the link layer
+     * packets sent on a connection.
+     *
+     * The result of the negotiation with the peer is reported by
+     * EventHandler::on_data_length_change.
+     *
+     * @param connection Handle of the connection.
+     * @param tx_octets Preferred maximum payload, in the range [27 : 251].
+     * @param tx_time Preferred maximum transmission time in microseconds, in
+     * the range [328 : 17040].
+     *
+     * @return BLE_ERROR_NONE if the request has been sent or the appropriate
+     * error otherwise.
+     *
+     * @note: See Bluetooth 5 Vol 2 PartE: 7.8.33 LE Set Data Length command.
+     */
+    virtual ble_error_t set_data_length(
+        connection_handle_t connection,
+        uint16_t tx_octets,
+        uint16_t tx_time
+    ) = 0;
+
     /**
      * Register a callback which will handle Gap events.
      *
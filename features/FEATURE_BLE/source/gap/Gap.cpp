@@ -174,6 +174,13 @@ ble_error_t Gap::stopScan()
     return BLE_ERROR_NOT_IMPLEMENTED;
 }
 
+ble_error_t Gap::setScanFilter(const ScanFilter &filter)
+{
+    /* Requesting action from porter(s): override this API if this capability
+       is supported. */
+    return BLE_ERROR_NOT_IMPLEMENTED;
+}
+
 ble_error_t Gap::createSync(
     peer_address_type_t peerAddressType,
     const address_t &peerAddress,
@@ -268,6 +275,14 @@ ble_error_t Gap::updateConnectionParameters(
     return BLE_ERROR_NOT_IMPLEMENTED;
 }
 
+ble_error_t Gap::setLinkProfile(
+    connection_handle_t connectionHandle,
+    link_profile_t profile
+)
+{
+    return BLE_ERROR_NOT_IMPLEMENTED;
+}
+
 ble_error_t Gap::manageConnectionParametersUpdateRequest(
     bool userManageConnectionUpdateRequest
 )
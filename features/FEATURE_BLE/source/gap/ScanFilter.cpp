@@ -0,0 +1,135 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include <string.h>
+#include "gap/ScanFilter.h"
+#include "gap/AdvertisingDataParser.h"
+
+namespace ble {
+
+ble_error_t ScanFilter::addPeerAddress(const address_t &address)
+{
+    if (_peer_address_count == MAX_PEER_ADDRESSES) {
+        return BLE_ERROR_NO_MEM;
+    }
+
+    _peer_addresses[_peer_address_count++] = address;
+    return BLE_ERROR_NONE;
+}
+
+ble_error_t ScanFilter::addServiceUuid(const UUID &uuid)
+{
+    if (_service_uuid_count == MAX_SERVICE_UUIDS) {
+        return BLE_ERROR_NO_MEM;
+    }
+
+    _service_uuids[_service_uuid_count++] = uuid;
+    return BLE_ERROR_NONE;
+}
+
+ble_error_t ScanFilter::addManufacturerData(mbed::Span<const uint8_t> pattern)
+{
+    if (pattern.empty() || pattern.size() > MAX_MANUFACTURER_PATTERN_SIZE) {
+        return BLE_ERROR_INVALID_PARAM;
+    }
+
+    if (_manufacturer_pattern_count == MAX_MANUFACTURER_PATTERNS) {
+        return BLE_ERROR_NO_MEM;
+    }
+
+    memcpy(_manufacturer_patterns[_manufacturer_pattern_count], pattern.data(), pattern.size());
+    _manufacturer_pattern_sizes[_manufacturer_pattern_count] = pattern.size();
+    ++_manufacturer_pattern_count;
+    return BLE_ERROR_NONE;
+}
+
+bool ScanFilter::matches(const address_t &address, mbed::Span<const uint8_t> payload) const
+{
+    if (isEmpty()) {
+        return true;
+    }
+
+    for (size_t i = 0; i < _peer_address_count; ++i) {
+        if (_peer_addresses[i] == address) {
+            return true;
+        }
+    }
+
+    if (!_service_uuid_count && !_manufacturer_pattern_count) {
+        return false;
+    }
+
+    AdvertisingDataParser parser(payload);
+    while (parser.hasNext()) {
+        AdvertisingDataParser::element_t element = parser.next();
+        mbed::Span<const uint8_t> value = element.value;
+
+        switch (element.type.value()) {
+            case adv_data_type_t::INCOMPLETE_LIST_16BIT_SERVICE_IDS:
+            case adv_data_type_t::COMPLETE_LIST_16BIT_SERVICE_IDS:
+                for (ptrdiff_t i = 0; i + 2 <= value.size(); i += 2) {
+                    if (matches_service_uuid(UUID(value[i] | (value[i + 1] << 8)))) {
+                        return true;
+                    }
+                }
+                break;
+
+            case adv_data_type_t::INCOMPLETE_LIST_128BIT_SERVICE_IDS:
+            case adv_data_type_t::COMPLETE_LIST_128BIT_SERVICE_IDS:
+                for (ptrdiff_t i = 0; i + UUID::LENGTH_OF_LONG_UUID <= value.size(); i += UUID::LENGTH_OF_LONG_UUID) {
+                    if (matches_service_uuid(UUID(value.data() + i, UUID::LSB))) {
+                        return true;
+                    }
+                }
+                break;
+
+            case adv_data_type_t::MANUFACTURER_SPECIFIC_DATA:
+                if (matches_manufacturer_data(value)) {
+                    return true;
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    return false;
+}
+
+bool ScanFilter::matches_service_uuid(const UUID &uuid) const
+{
+    for (size_t i = 0; i < _service_uuid_count; ++i) {
+        if (_service_uuids[i] == uuid) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ScanFilter::matches_manufacturer_data(mbed::Span<const uint8_t> data) const
+{
+    for (size_t i = 0; i < _manufacturer_pattern_count; ++i) {
+        size_t size = _manufacturer_pattern_sizes[i];
+        if ((size_t) data.size() >= size &&
+            memcmp(data.data(), _manufacturer_patterns[i], size) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace ble
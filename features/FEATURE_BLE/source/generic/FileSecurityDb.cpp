@@ -15,6 +15,11 @@
  */
 
 #include "FileSecurityDb.h"
+#include <string.h>
+
+#if MBED_CONF_BLE_SECURITY_DB_FLUSH_INTERVAL_MS
+#include "hal/us_ticker_api.h"
+#endif
 
 namespace ble {
 namespace generic {
@@ -69,7 +74,9 @@ typedef SecurityDb::entry_handle_t entry_handle_t;
 
 FileSecurityDb::FileSecurityDb(FILE *db_file)
     : SecurityDb(),
-      _db_file(db_file) {
+      _db_file(db_file),
+      _pending_count(0),
+      _pending_since_us(0) {
     /* init the offset in entries so they point to file positions */
     for (size_t i = 0; i < get_entry_count(); i++) {
         _entries[i].file_offset = DB_OFFSET_STORES + i * DB_SIZE_STORE;
@@ -77,6 +84,7 @@ FileSecurityDb::FileSecurityDb(FILE *db_file)
 }
 
 FileSecurityDb::~FileSecurityDb() {
+    flush();
     fclose(_db_file);
 }
 
@@ -273,6 +281,7 @@ void FileSecurityDb::restore() {
     db_read(&restore_toggle, DB_OFFSET_RESTORE);
 
     if (!restore_toggle) {
+        _pending_count = 0;
         erase_db_file(_db_file);
 
         db_write(&DB_VERSION, DB_OFFSET_VERSION);
@@ -299,10 +308,94 @@ void FileSecurityDb::sync(entry_handle_t db_handle) {
 
     db_write(&entry->peer_sign_counter, entry->file_offset + DB_STORE_OFFSET_PEER_SIGNING_COUNT);
     db_write(&entry->flags, entry->file_offset + DB_STORE_OFFSET_FLAGS);
+    flush();
 }
 
 void FileSecurityDb::set_restore(bool reload) {
     db_write(&reload, DB_OFFSET_RESTORE);
+    flush();
+}
+
+void FileSecurityDb::flush() {
+    if (!_pending_count) {
+        return;
+    }
+
+    for (size_t i = 0; i < _pending_count; i++) {
+        fseek(_db_file, _pending[i].offset, SEEK_SET);
+        fwrite(_pending[i].data, _pending[i].size, 1, _db_file);
+    }
+    _pending_count = 0;
+
+    fflush(_db_file);
+}
+
+void FileSecurityDb::db_write(const void *value, size_t size, long int offset) {
+    if (!MBED_CONF_BLE_SECURITY_DB_WRITE_BACK_ENTRIES || size > MAX_PENDING_SIZE) {
+        /* older held writes must not overwrite this one later */
+        flush();
+        fseek(_db_file, offset, SEEK_SET);
+        fwrite(value, size, 1, _db_file);
+        return;
+    }
+
+    /* coalesce successive writes of the same value */
+    pending_write_t *pending = NULL;
+    for (size_t i = 0; i < _pending_count; i++) {
+        if (_pending[i].offset == offset && _pending[i].size == size) {
+            pending = &_pending[i];
+            break;
+        }
+    }
+
+    if (!pending) {
+        if (_pending_count == MAX_PENDING) {
+            flush();
+        }
+#if MBED_CONF_BLE_SECURITY_DB_FLUSH_INTERVAL_MS
+        if (!_pending_count) {
+            _pending_since_us = ticker_read_us(get_us_ticker_data());
+        }
+#endif
+        pending = &_pending[_pending_count++];
+        pending->offset = offset;
+        pending->size = size;
+    }
+    memcpy(pending->data, value, size);
+
+#if MBED_CONF_BLE_SECURITY_DB_FLUSH_INTERVAL_MS
+    if (ticker_read_us(get_us_ticker_data()) - _pending_since_us >=
+        MBED_CONF_BLE_SECURITY_DB_FLUSH_INTERVAL_MS * 1000ULL) {
+        flush();
+    }
+#endif
+}
+
+void FileSecurityDb::apply_pending(void *value, size_t size, long int offset) {
+    /* held writes are applied in the order they were made */
+    for (size_t i = 0; i < _pending_count; i++) {
+        const pending_write_t &pending = _pending[i];
+        long int start = (pending.offset > offset) ? pending.offset : offset;
+        long int end = pending.offset + (long int)pending.size;
+        if (end > offset + (long int)size) {
+            end = offset + (long int)size;
+        }
+        if (start < end) {
+            memcpy(static_cast<uint8_t *>(value) + (start - offset),
+                   pending.data + (start - pending.offset), end - start);
+        }
+    }
+}
+
+void FileSecurityDb::drop_pending(long int offset, size_t size) {
+    size_t kept = 0;
+    for (size_t i = 0; i < _pending_count; i++) {
+        if (_pending[i].offset >= offset + (long int)size ||
+            _pending[i].offset + (long int)_pending[i].size <= offset) {
+            _pending[kept++] = _pending[i];
+        }
+    }
+    _pending_count = kept;
 }
 
 /* helper functions */
@@ -325,6 +418,8 @@ void FileSecurityDb::reset_entry(entry_handle_t db_entry) {
         return;
     }
 
+    drop_pending(entry->file_offset, DB_SIZE_STORE);
+
     fseek(_db_file, entry->file_offset, SEEK_SET);
     const uint32_t zero = 0;
     size_t count = DB_SIZE_STORE / 4;
@@ -419,6 +419,47 @@ microsecond_t minSupervisionTimeout(
     return (1 + slaveLatency.value()) * maxConnectionInterval * 2;
 }
 
+/*
+ * Longest link layer payload and its transmission time at 1M, see
+ * BLUETOOTH SPECIFICATION Version 5.0 | Vol 6, Part B, Section 4.5.10
+ */
+static const uint16_t max_tx_octets = 251;
+static const uint16_t max_tx_time = 2120;
+
+/*
+ * Goodput ceiling of a link, in bits per second.
+ *
+ * Every exchange is a full data packet acknowledged by an empty one, each
+ * followed by the inter frame space, and as many exchanges as fit are made
+ * in every connection event. The L2CAP and ATT headers take 7 octets of
+ * each packet. The coded PHY is counted with 8 symbols per bit.
+ */
+static uint32_t link_goodput(phy_t phy, uint16_t tx_octets, uint16_t interval)
+{
+    const uint32_t inter_frame_space = 150;
+    const uint16_t headers = 7;
+
+    // preamble, access address, header and CRC
+    uint32_t overhead = 10;
+    uint32_t octet_time = 8;
+    if (phy == phy_t::LE_2M) {
+        overhead = 11;
+        octet_time = 4;
+    } else if (phy == phy_t::LE_CODED) {
+        octet_time = 64;
+    }
+
+    if (tx_octets <= headers) {
+        return 0;
+    }
+
+    uint32_t exchange_time = (2 * overhead + tx_octets) * octet_time + 2 * inter_frame_space;
+    uint32_t interval_time = interval * 1250;
+    uint32_t exchanges = interval_time / exchange_time;
+
+    return ((uint64_t) exchanges * (tx_octets - headers) * 8 * 1000000) / interval_time;
+}
+
 } // end of anonymous namespace
 
 GenericGap::GenericGap(
@@ -770,6 +811,64 @@ ble_error_t GenericGap::updateConnectionParameters(
     );
 }
 
+ble_error_t GenericGap::setLinkProfile(
+    connection_handle_t connectionHandle,
+    link_profile_t profile
+)
+{
+    useVersionTwoAPI();
+
+    link_state_t *link = get_link_state(connectionHandle);
+    if (!link) {
+        return BLE_ERROR_INVALID_PARAM;
+    }
+
+    // HIGH_THROUGHPUT leaves room for many packets per event
+    conn_interval_t min_interval(12);
+    conn_interval_t max_interval(24);
+    slave_latency_t latency(0);
+    supervision_timeout_t timeout(400);
+
+    if (profile == link_profile_t::LOW_LATENCY) {
+        min_interval = conn_interval_t(6);
+        max_interval = conn_interval_t(12);
+    } else if (profile == link_profile_t::LOW_POWER) {
+        min_interval = conn_interval_t(80);
+        max_interval = conn_interval_t(160);
+        latency = slave_latency_t(4);
+        timeout = supervision_timeout_t(600);
+    }
+
+    ble_error_t err = updateConnectionParameters(
+        connectionHandle,
+        min_interval,
+        max_interval,
+        latency,
+        timeout,
+        conn_event_length_t(0),
+        conn_event_length_t(0)
+    );
+    if (err) {
+        return err;
+    }
+
+    // The 2M PHY and long packets shorten the time on air of every
+    // exchange, which helps all profiles
+    if (_pal_gap.is_feature_supported(controller_supported_features_t::LE_2M_PHY)) {
+        phy_set_t phys(phy_t::LE_2M);
+        _pal_gap.set_phy(connectionHandle, phys, phys, coded_symbol_per_bit_t::UNDEFINED);
+    }
+
+    if (_pal_gap.is_feature_supported(controller_supported_features_t::LE_DATA_PACKET_LENGTH_EXTENSION)) {
+        _pal_gap.set_data_length(connectionHandle, max_tx_octets, max_tx_time);
+    }
+
+    link->profiled = true;
+    report_link_goodput(*link);
+
+    return BLE_ERROR_NONE;
+}
+
 ble_error_t GenericGap::acceptConnectionParametersUpdate(
     connection_handle_t connectionHandle,
     conn_interval_t minConnectionInterval,
@@ -866,6 +965,12 @@ void GenericGap::on_data_length_change(
     uint16_t rx_size
 )
 {
+    link_state_t *link = get_link_state(connection_handle);
+    if (link) {
+        link->tx_octets = tx_size;
+        report_link_goodput(*link);
+    }
+
     if (_eventHandler) {
         _eventHandler->onDataLengthChange(connection_handle, tx_size, rx_size);
     }
@@ -883,6 +988,12 @@ void GenericGap::on_phy_update_complete(
         status = BLE_ERROR_UNSPECIFIED;
     }
 
+    link_state_t *link = get_link_state(connection_handle);
+    if (link && status == BLE_ERROR_NONE) {
+        link->tx_phy = tx_phy;
+        report_link_goodput(*link);
+    }
+
     if (_eventHandler) {
         _eventHandler->onPhyUpdateComplete(status, connection_handle, tx_phy, rx_phy);
     }
@@ -1421,6 +1532,12 @@ ble_error_t GenericGap::reset(void)
 
     _existing_sets.set(LEGACY_ADVERTISING_HANDLE);
 
+    for (size_t i = 0; i < MAX_LINK_STATES; ++i) {
+        _link_states[i].in_use = false;
+    }
+
+    setScanFilter(ScanFilter());
+
     return BLE_ERROR_NONE;
 }
 
@@ -1468,6 +1585,11 @@ void GenericGap::processDisconnectionEvent(
     DisconnectionReason_t reason
 )
 {
+    link_state_t *link = get_link_state(handle);
+    if (link) {
+        link->in_use = false;
+    }
+
     if (_connection_event_handler) {
         _connection_event_handler->on_disconnected(
             handle,
@@ -1591,6 +1713,13 @@ void GenericGap::on_advertising_report(const pal::GapAdvertisingReportEvent &e)
             continue;
         }
 
+        if (!filter_scan_report(
+            advertising.address,
+            mbed::make_Span(advertising.data.data(), advertising.data.size())
+        )) {
+            continue;
+        }
+
         // note 1-to-1 conversion between connection_peer_address_type_t and
         // peer_address_type_t
         peer_address_type_t peer_address_type =
@@ -2699,6 +2828,22 @@ void GenericGap::on_enhanced_connection_complete(
     pal::clock_accuracy_t master_clock_accuracy
 )
 {
+    if (status == pal::hci_error_code_t::SUCCESS) {
+        for (size_t i = 0; i < MAX_LINK_STATES; ++i) {
+            link_state_t &link = _link_states[i];
+            if (!link.in_use) {
+                // every connection starts on the 1M PHY with the shortest packets
+                link.connection = connection_handle;
+                link.tx_phy = phy_t::LE_1M;
+                link.tx_octets = 27;
+                link.interval = connection_interval;
+                link.in_use = true;
+                link.profiled = false;
+                break;
+            }
+        }
+    }
+
     if (!_eventHandler) {
         return;
     }
@@ -2740,6 +2885,10 @@ void GenericGap::on_extended_advertising_report(
         return;
     }
 
+    if (!filter_scan_report(address, mbed::make_Span(data, data_length))) {
+        return;
+    }
+
     _eventHandler->onAdvertisingReport(
         AdvertisingReportEvent(
             event_type,
@@ -2875,6 +3024,12 @@ void GenericGap::on_connection_update_complete(
     uint16_t supervision_timeout
 )
 {
+    link_state_t *link = get_link_state(connection_handle);
+    if (link && status == pal::hci_error_code_t::SUCCESS) {
+        link->interval = connection_interval;
+        report_link_goodput(*link);
+    }
+
     if (!_eventHandler) {
         return;
     }
@@ -3023,6 +3178,23 @@ ble_error_t GenericGap::startScan(
     return BLE_ERROR_NONE;
 }
 
+ble_error_t GenericGap::setScanFilter(const ScanFilter &filter)
+{
+    _scan_filter = filter;
+
+    for (size_t i = 0; i < MAX_SCAN_REPORT_RECORDS; ++i) {
+        _scan_report_records[i] = scan_report_record_t();
+    }
+
+    _scan_report_timer.stop();
+    _scan_report_timer.reset();
+    if (filter.getReportInterval().value()) {
+        _scan_report_timer.start();
+    }
+
+    return BLE_ERROR_NONE;
+}
+
 ble_error_t GenericGap::createSync(
     peer_address_type_t peerAddressType,
     const ble::address_t &peerAddress,
@@ -3203,5 +3375,80 @@ bool GenericGap::is_extended_advertising_available()
     );
 }
 
+GenericGap::link_state_t *GenericGap::get_link_state(connection_handle_t connection)
+{
+    for (size_t i = 0; i < MAX_LINK_STATES; ++i) {
+        if (_link_states[i].in_use && _link_states[i].connection == connection) {
+            return &_link_states[i];
+        }
+    }
+    return NULL;
+}
+
+void GenericGap::report_link_goodput(const link_state_t &link)
+{
+    if (!link.profiled || !_eventHandler) {
+        return;
+    }
+
+    _eventHandler->onLinkGoodputUpdate(
+        LinkGoodputUpdateEvent(
+            link.connection,
+            link.tx_phy,
+            link.tx_octets,
+            conn_interval_t(link.interval),
+            link_goodput(link.tx_phy, link.tx_octets, link.interval)
+        )
+    );
+}
+
+bool GenericGap::filter_scan_report(
+    const ble::address_t &address,
+    mbed::Span<const uint8_t> payload
+)
+{
+    if (!_scan_filter.matches(address, payload)) {
+        return false;
+    }
+
+    uint32_t interval = _scan_filter.getReportInterval().value();
+    if (!interval) {
+        return true;
+    }
+
+    uint32_t now = _scan_report_timer.read_high_resolution_us() / 1000;
+
+    // Look for the advertiser, otherwise replace the record that has not
+    // been used for the longest time.
+    scan_report_record_t *record = &_scan_report_records[0];
+    for (size_t i = 0; i < MAX_SCAN_REPORT_RECORDS; ++i) {
+        scan_report_record_t &candidate = _scan_report_records[i];
+        if (!candidate.in_use) {
+            if (record->in_use) {
+                record = &candidate;
+            }
+            continue;
+        }
+
+        if (candidate.address == address) {
+            if ((now - candidate.last_report) < interval) {
+                return false;
+            }
+            candidate.last_report = now;
+            return true;
+        }
+
+        if (record->in_use &&
+            (now - candidate.last_report) > (now - record->last_report)) {
+            record = &candidate;
+        }
+    }
+
+    record->address = address;
+    record->last_report = now;
+    record->in_use = true;
+    return true;
+}
+
 } // namespace generic
 } // namespace ble
@@ -92,6 +92,40 @@ struct GenericGattClient::ProcedureControlBlock {
 };
 
 
+/*
+ * Service or characteristic recorded in a discovery cache.
+ */
+struct GenericGattClient::cached_attribute_t {
+	cached_attribute_t(const UUID& uuid, uint16_t begin, uint16_t end) :
+		uuid(uuid), properties(), begin(begin), value_handle(0), end(end),
+		is_service(true), next(NULL) { }
+
+	cached_attribute_t(const DiscoveredCharacteristic& characteristic) :
+		uuid(characteristic.getUUID()),
+		properties(characteristic.getProperties()),
+		begin(characteristic.getDeclHandle()),
+		value_handle(characteristic.getValueHandle()),
+		end(characteristic.getLastHandle()),
+		is_service(false),
+		next(NULL) { }
+
+	static void release(cached_attribute_t* attributes) {
+		while (attributes) {
+			cached_attribute_t* tmp = attributes->next;
+			delete attributes;
+			attributes = tmp;
+		}
+	}
+
+	UUID uuid;
+	DiscoveredCharacteristic::Properties_t properties;
+	uint16_t begin;
+	uint16_t value_handle;
+	uint16_t end;
+	bool is_service;
+	cached_attribute_t* next;
+};
+
 /*
  * Procedure control block for the discovery process.
  */
@@ -108,7 +142,10 @@ struct GenericGattClient::DiscoveryControlBlock : public ProcedureControlBlock {
 		matching_service_uuid(matching_service_uuid),
 		matching_characteristic_uuid(matching_characteristic_uuid),
 		services_discovered(NULL),
-		done(false) {
+		done(false),
+		recording(false),
+		record(NULL),
+		record_tail(NULL) {
 	}
 
 	virtual ~DiscoveryControlBlock() {
@@ -117,6 +154,7 @@ struct GenericGattClient::DiscoveryControlBlock : public ProcedureControlBlock {
 			delete services_discovered;
 			services_discovered = tmp;
 		}
+		cached_attribute_t::release(record);
 	}
 
 	virtual void handle_timeout_error(GenericGattClient* client) {
@@ -241,6 +279,14 @@ struct GenericGattClient::DiscoveryControlBlock : public ProcedureControlBlock {
 			service_callback(&discovered_service);
 		}
 
+		if (recording) {
+			record_attribute(new (std::nothrow) cached_attribute_t(
+				services_discovered->uuid,
+				services_discovered->begin,
+				services_discovered->end
+			));
+		}
+
 		last_characteristic = characteristic_t();
 		client->_pal_client->discover_characteristics_of_a_service(
 			connection_handle,
@@ -255,6 +301,11 @@ struct GenericGattClient::DiscoveryControlBlock : public ProcedureControlBlock {
 		for (size_t i = 0; i < response.size(); ++i) {
 			if (last_characteristic.is_valid() == false) {
 				last_characteristic.set_last_handle(response[i].handle - 1);
+				if (recording) {
+					record_attribute(
+						new (std::nothrow) cached_attribute_t(last_characteristic)
+					);
+				}
 				if (matching_characteristic_uuid == UUID()
 				|| last_characteristic.getUUID() == matching_characteristic_uuid) {
 					characteristic_callback(&last_characteristic);
@@ -289,6 +340,11 @@ struct GenericGattClient::DiscoveryControlBlock : public ProcedureControlBlock {
 			if (matching_characteristic_uuid == UUID()
 				|| matching_characteristic_uuid == last_characteristic.getUUID()) {
 				last_characteristic.set_last_handle(services_discovered->end);
+				if (recording) {
+					record_attribute(
+						new (std::nothrow) cached_attribute_t(last_characteristic)
+					);
+				}
 				characteristic_callback(&last_characteristic);
 			}
 		}
@@ -298,12 +354,64 @@ struct GenericGattClient::DiscoveryControlBlock : public ProcedureControlBlock {
 		delete old;
 
 		if (!services_discovered) {
+			// the discovery is complete, the record can be reused
+			if (recording) {
+				client->store_discovery_cache(connection_handle, record);
+				record = NULL;
+			}
 			terminate(client);
 		} else {
 			start_characteristic_discovery(client);
 		}
 	}
 
+	/*
+	 * Report a recorded discovery through the callbacks of this procedure,
+	 * with its filters applied.
+	 */
+	void replay(GenericGattClient* client, const cached_attribute_t* attribute) {
+		bool service_matches = false;
+		for (; attribute; attribute = attribute->next) {
+			if (attribute->is_service) {
+				service_matches = matching_service_uuid == UUID() ||
+					matching_service_uuid == attribute->uuid;
+				if (service_matches && service_callback) {
+					DiscoveredService discovered_service;
+					discovered_service.setup(
+						attribute->uuid, attribute->begin, attribute->end
+					);
+					service_callback(&discovered_service);
+				}
+			} else if (service_matches && characteristic_callback) {
+				if (matching_characteristic_uuid == UUID() ||
+					matching_characteristic_uuid == attribute->uuid) {
+					characteristic_t characteristic(
+						client, connection_handle, *attribute
+					);
+					characteristic_callback(&characteristic);
+				}
+			}
+		}
+	}
+
+	void record_attribute(cached_attribute_t* attribute) {
+		if (attribute == NULL) {
+			// out of memory, the discovery is not recorded
+			cached_attribute_t::release(record);
+			record = NULL;
+			record_tail = NULL;
+			recording = false;
+			return;
+		}
+
+		if (record_tail) {
+			record_tail->next = attribute;
+		} else {
+			record = attribute;
+		}
+		record_tail = attribute;
+	}
+
 	void terminate(GenericGattClient* client) {
 		// unknown error, terminate the procedure immediately
 		client->remove_control_block(this);
@@ -369,6 +477,20 @@ struct GenericGattClient::DiscoveryControlBlock : public ProcedureControlBlock {
 			connHandle = connection_handle;
 		}
 
+		characteristic_t(
+			GattClient* client,
+			connection_handle_t connection_handle,
+			const cached_attribute_t& attribute
+		) : DiscoveredCharacteristic() {
+			gattc = client;
+			uuid = attribute.uuid;
+			props = attribute.properties;
+			declHandle = attribute.begin;
+			valueHandle = attribute.value_handle;
+			lastHandle = attribute.end;
+			connHandle = connection_handle;
+		}
+
 		static UUID get_uuid(const ArrayView<const uint8_t>& value) {
 			if (value.size() == 5) {
 				return UUID(value[3] | (value[4] << 8));
@@ -423,6 +545,9 @@ struct GenericGattClient::DiscoveryControlBlock : public ProcedureControlBlock {
 	service_t* services_discovered;
 	characteristic_t last_characteristic;
 	bool done;
+	bool recording;
+	cached_attribute_t* record;
+	cached_attribute_t* record_tail;
 };
 
 
@@ -939,7 +1064,10 @@ GenericGattClient::GenericGattClient(pal::GattClient* pal_client) :
 	_termination_callback(),
 	_signing_event_handler(NULL),
 	 control_blocks(NULL),
-	_is_reseting(false) {
+	_is_reseting(false),
+	_discovery_cache_enabled(false),
+	_discovery_caches(),
+	_next_discovery_cache(0) {
 	_pal_client->when_server_message_received(
 		mbed::callback(this, &GenericGattClient::on_server_message_received)
 	);
@@ -966,6 +1094,21 @@ ble_error_t GenericGattClient::launchServiceDiscovery(
 		return BLE_ERROR_NONE;
 	}
 
+	// answer from the record of a previous discovery on the same peer
+	discovery_cache_t* cache = get_discovery_cache(connection_handle);
+	if (cache) {
+		DiscoveryControlBlock replay_pcb(
+			connection_handle,
+			service_callback,
+			characteristic_callback,
+			matching_service_uuid,
+			matching_characteristic_uuid
+		);
+		replay_pcb.replay(this, cache->attributes);
+		on_termination(connection_handle);
+		return BLE_ERROR_NONE;
+	}
+
 	DiscoveryControlBlock* discovery_pcb = new(std::nothrow) DiscoveryControlBlock(
 		connection_handle,
 		service_callback,
@@ -978,6 +1121,12 @@ ble_error_t GenericGattClient::launchServiceDiscovery(
 		return BLE_ERROR_NO_MEM;
 	}
 
+	// only complete discoveries are recorded
+	discovery_pcb->recording = _discovery_cache_enabled &&
+		characteristic_callback &&
+		matching_service_uuid == UUID() &&
+		matching_characteristic_uuid == UUID();
+
 	// note: control block inserted prior the request because they are part of
 	// of the transaction and the callback can be call synchronously
 	insert_control_block(discovery_pcb);
@@ -1265,6 +1414,16 @@ ble_error_t GenericGattClient::negotiateAttMtu(
     return _pal_client->exchange_mtu(connection);
 }
 
+ble_error_t GenericGattClient::enableDiscoveryCache(bool enable) {
+	_discovery_cache_enabled = enable;
+	if (!enable) {
+		for (size_t i = 0; i < MAX_DISCOVERY_CACHES; ++i) {
+			release_discovery_cache(_discovery_caches[i]);
+		}
+	}
+	return BLE_ERROR_NONE;
+}
+
 ble_error_t GenericGattClient::reset(void) {
 
 	// _is_reseting prevent executions of new procedure while the instance resets.
@@ -1276,6 +1435,11 @@ ble_error_t GenericGattClient::reset(void) {
 	}
 	_is_reseting = false;
 
+	for (size_t i = 0; i < MAX_DISCOVERY_CACHES; ++i) {
+		release_discovery_cache(_discovery_caches[i]);
+	}
+	_discovery_cache_enabled = false;
+
 	return BLE_ERROR_NONE;
 }
 
@@ -1356,6 +1520,12 @@ void GenericGattClient::on_server_event(connection_handle_t connection, const At
 			callbacks_params.type = BLE_HVX_INDICATION;
 			callbacks_params.len = indication.attribute_value.size();
 			callbacks_params.data = indication.attribute_value.data();
+
+			// the database of the peer has changed, its record is stale
+			discovery_cache_t* cache = get_discovery_cache(connection);
+			if (cache && cache->service_changed_handle == indication.attribute_handle) {
+				release_discovery_cache(*cache);
+			}
 		} break;
 
 		default:
@@ -1434,5 +1604,68 @@ uint16_t GenericGattClient::get_mtu(connection_handle_t connection) const {
 	return result;
 }
 
+GenericGattClient::discovery_cache_t* GenericGattClient::get_discovery_cache(
+	connection_handle_t connection
+) {
+	if (!_discovery_cache_enabled) {
+		return NULL;
+	}
+
+	address_t peer_address;
+	bool peer_address_is_public = false;
+	SecurityManager &sm = createBLEInstance()->getSecurityManager();
+	if (sm.getPeerIdentity(connection, &peer_address, &peer_address_is_public)) {
+		return NULL;
+	}
+
+	for (size_t i = 0; i < MAX_DISCOVERY_CACHES; ++i) {
+		discovery_cache_t& cache = _discovery_caches[i];
+		if (cache.attributes &&
+			cache.peer_address == peer_address &&
+			cache.peer_address_is_public == peer_address_is_public) {
+			return &cache;
+		}
+	}
+	return NULL;
+}
+
+void GenericGattClient::store_discovery_cache(
+	connection_handle_t connection,
+	cached_attribute_t* attributes
+) {
+	address_t peer_address;
+	bool peer_address_is_public = false;
+	SecurityManager &sm = createBLEInstance()->getSecurityManager();
+	if (sm.getPeerIdentity(connection, &peer_address, &peer_address_is_public)) {
+		// only bonded peers keep their database across connections
+		cached_attribute_t::release(attributes);
+		return;
+	}
+
+	discovery_cache_t* cache = get_discovery_cache(connection);
+	if (!cache) {
+		// replace the oldest record once all of them are used
+		cache = &_discovery_caches[_next_discovery_cache];
+		_next_discovery_cache = (_next_discovery_cache + 1) % MAX_DISCOVERY_CACHES;
+	}
+	release_discovery_cache(*cache);
+
+	cache->peer_address = peer_address;
+	cache->peer_address_is_public = peer_address_is_public;
+	cache->attributes = attributes;
+	for (cached_attribute_t* it = attributes; it; it = it->next) {
+		if (!it->is_service &&
+			it->uuid == UUID(BLE_UUID_GATT_CHARACTERISTIC_SERVICE_CHANGED)) {
+			cache->service_changed_handle = it->value_handle;
+		}
+	}
+}
+
+void GenericGattClient::release_discovery_cache(discovery_cache_t& cache) {
+	cached_attribute_t::release(cache.attributes);
+	cache.attributes = NULL;
+	cache.service_changed_handle = 0;
+}
+
 } // namespace pal
 } // namespace ble
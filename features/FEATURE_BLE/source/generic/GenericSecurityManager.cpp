@@ -19,6 +19,9 @@
 #include "ble/generic/GenericSecurityManager.h"
 #include "ble/generic/MemorySecurityDb.h"
 #include "ble/generic/FileSecurityDb.h"
+#if MBED_CONF_BLE_SECURITY_DB_KVSTORE
+#include "ble/generic/KVStoreSecurityDb.h"
+#endif
 
 using ble::pal::advertising_peer_address_type_t;
 using ble::pal::AuthenticationMask;
@@ -153,6 +156,30 @@ ble_error_t GenericSecurityManager::generateWhitelistFromBondTable(::Gap::Whitel
     return BLE_ERROR_NONE;
 }
 
+ble_error_t GenericSecurityManager::getPeerIdentity(
+    connection_handle_t connection,
+    address_t *address,
+    bool *is_public
+) {
+    if (!_db) return BLE_ERROR_INITIALIZATION_INCOMPLETE;
+    if (!address || !is_public) {
+        return BLE_ERROR_INVALID_PARAM;
+    }
+    ControlBlock_t *cb = get_control_block(connection);
+    if (!cb) {
+        return BLE_ERROR_INVALID_PARAM;
+    }
+
+    SecurityDistributionFlags_t* flags = _db->get_distribution_flags(cb->db_entry);
+    if (!flags || !flags->ltk_stored) {
+        return BLE_ERROR_INVALID_STATE;
+    }
+
+    *address = flags->peer_address;
+    *is_public = flags->peer_address_is_public;
+    return BLE_ERROR_NONE;
+}
+
 ////////////////////////////////////////////////////////////////////////////
 // Pairing
 //
@@ -782,6 +809,20 @@ ble_error_t GenericSecurityManager::init_database(
     const char *db_path
 ) {
     delete _db;
+    _db = NULL;
+
+#if MBED_CONF_BLE_SECURITY_DB_KVSTORE
+    if (KVStoreSecurityDb::is_kvstore_path(db_path)) {
+        _db = new (std::nothrow) KVStoreSecurityDb(db_path);
+        if (!_db) {
+            return BLE_ERROR_NO_MEM;
+        }
+
+        _db->restore();
+
+        return BLE_ERROR_NONE;
+    }
+#endif
 
     FILE* db_file = FileSecurityDb::open_db_file(db_path);
 
@@ -0,0 +1,149 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if MBED_CONF_BLE_SECURITY_DB_KVSTORE
+
+#include "KVStoreSecurityDb.h"
+#include "kvstore_global_api.h"
+#include <stdio.h>
+#include <string.h>
+
+namespace ble {
+namespace generic {
+
+static const uint16_t DB_VERSION = 1;
+
+#define DB_KEY_RESTORE "_restore"
+#define DB_KEY_LOCAL   "_local"
+#define DB_KEY_ENTRY   "_entry%u"
+
+KVStoreSecurityDb::KVStoreSecurityDb(const char *key_prefix)
+    : MemorySecurityDb() {
+    strncpy(_key_prefix, key_prefix, sizeof(_key_prefix) - 1);
+    _key_prefix[sizeof(_key_prefix) - 1] = '\0';
+}
+
+bool KVStoreSecurityDb::is_kvstore_path(const char *db_path) {
+    return db_path && !strncmp(db_path, "/kv/", 4);
+}
+
+void KVStoreSecurityDb::get_key(char *key, const char *suffix) {
+    snprintf(key, KV_MAX_KEY_LENGTH, "%s%s", _key_prefix, suffix);
+}
+
+void KVStoreSecurityDb::get_entry_key(char *key, const entry_t *entry) {
+    char suffix[16];
+    snprintf(suffix, sizeof(suffix), DB_KEY_ENTRY, (unsigned int)(entry - _entries));
+    get_key(key, suffix);
+}
+
+void KVStoreSecurityDb::store_local() {
+    char key[KV_MAX_KEY_LENGTH];
+    local_t local;
+    local.version = DB_VERSION;
+    local.identity = _local_identity;
+    local.csrk = _local_csrk;
+    local.sign_counter = _local_sign_counter;
+
+    get_key(key, DB_KEY_LOCAL);
+    kv_set(key, &local, sizeof(local), 0);
+}
+
+/* saving and loading from nvm */
+
+void KVStoreSecurityDb::restore() {
+    char key[KV_MAX_KEY_LENGTH];
+    size_t actual_size = 0;
+
+    /* restore if requested */
+    bool restore_toggle = false;
+    get_key(key, DB_KEY_RESTORE);
+    if (kv_get(key, &restore_toggle, sizeof(restore_toggle), &actual_size) ||
+        actual_size != sizeof(restore_toggle)) {
+        restore_toggle = false;
+    }
+
+    local_t local;
+    get_key(key, DB_KEY_LOCAL);
+    if (kv_get(key, &local, sizeof(local), &actual_size) ||
+        actual_size != sizeof(local) || local.version != DB_VERSION) {
+        restore_toggle = false;
+    }
+
+    if (!restore_toggle) {
+        /* start from an empty database */
+        for (size_t i = 0; i < MAX_ENTRIES; i++) {
+            get_entry_key(key, &_entries[i]);
+            kv_remove(key);
+        }
+        get_key(key, DB_KEY_LOCAL);
+        kv_remove(key);
+        return;
+    }
+
+    _local_identity = local.identity;
+    _local_csrk = local.csrk;
+    _local_sign_counter = local.sign_counter;
+
+    for (size_t i = 0; i < MAX_ENTRIES; i++) {
+        entry_t entry;
+        get_entry_key(key, &_entries[i]);
+        if (!kv_get(key, &entry, sizeof(entry), &actual_size) && actual_size == sizeof(entry)) {
+            _entries[i] = entry;
+        }
+    }
+}
+
+void KVStoreSecurityDb::sync(entry_handle_t db_handle) {
+    entry_t *entry = as_entry(db_handle);
+    if (!entry) {
+        return;
+    }
+
+    char key[KV_MAX_KEY_LENGTH];
+    get_entry_key(key, entry);
+    kv_set(key, entry, sizeof(*entry), 0);
+
+    store_local();
+}
+
+void KVStoreSecurityDb::set_restore(bool reload) {
+    char key[KV_MAX_KEY_LENGTH];
+    get_key(key, DB_KEY_RESTORE);
+    kv_set(key, &reload, sizeof(reload), 0);
+
+    if (reload) {
+        store_local();
+    }
+}
+
+void KVStoreSecurityDb::reset_entry(entry_handle_t db_entry) {
+    entry_t *entry = as_entry(db_entry);
+    if (!entry) {
+        return;
+    }
+
+    *entry = entry_t();
+
+    char key[KV_MAX_KEY_LENGTH];
+    get_entry_key(key, entry);
+    kv_remove(key);
+}
+
+} /* namespace pal */
+} /* namespace ble */
+
+#endif // MBED_CONF_BLE_SECURITY_DB_KVSTORE
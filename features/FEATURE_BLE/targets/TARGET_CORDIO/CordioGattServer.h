@@ -31,6 +31,9 @@
 /*! client characteristic configuration descriptors settings */
 #define MAX_CCCD_CNT 20
 
+/*! Maximum count of notifications waiting for the ATT bearer, across all connections */
+#define MAX_QUEUED_NOTIFICATION_CNT 16
+
 namespace ble {
 
 // fwd declaration of CordioAttClient and BLE
@@ -226,9 +229,15 @@ private:
     void add_generic_attribute_service();
     void* alloc_block(size_t block_size);
     GattCharacteristic* get_auth_char(uint16_t value_handle);
+    attsAttr_t *get_attribute(GattAttribute::Handle_t att_handle);
+    ble_error_t set_attribute_value(GattAttribute::Handle_t att_handle, const uint8_t *buffer, uint16_t len);
     bool get_cccd_index_by_cccd_handle(GattAttribute::Handle_t cccd_handle, uint8_t& idx) const;
     bool get_cccd_index_by_value_handle(GattAttribute::Handle_t char_handle, uint8_t& idx) const;
     bool is_update_authorized(connection_handle_t connection, GattAttribute::Handle_t value_handle);
+    void update_handle_table();
+    ble_error_t send_notification(dmConnId_t conn_id, GattAttribute::Handle_t value_handle, uint16_t len, const uint8_t *buffer);
+    void send_next_notification(dmConnId_t conn_id);
+    void clear_notifications(dmConnId_t conn_id);
 
     struct alloc_block_t {
         alloc_block_t* next;
@@ -240,6 +249,22 @@ private:
         internal_service_t *next;
     };
 
+    // Index of the metadata attached to an attribute handle, NO_INDEX if
+    // there is none.
+    struct handle_entry_t {
+        static const uint8_t NO_INDEX = 0xFF;
+        uint8_t auth_char;
+        uint8_t cccd;
+        uint8_t value_cccd;
+    };
+
+    struct queued_notification_t {
+        dmConnId_t connection;
+        GattAttribute::Handle_t handle;
+        uint16_t len;
+        uint8_t *value;
+    };
+
     pal::SigningEventMonitor::EventHandler *_signing_event_handler;
 
     attsCccSet_t cccds[MAX_CCCD_CNT];
@@ -250,6 +275,20 @@ private:
     GattCharacteristic *_auth_char[MAX_CHARACTERISTIC_AUTHORIZATION_CNT];
     uint8_t _auth_char_count;
 
+    // Handle indexed view of _auth_char and the CCCD tables, rebuilt when
+    // services are registered so ATT requests don't scan them.
+    handle_entry_t *_handle_table;
+    uint16_t _handle_table_size;
+
+    // A single notification per connection is handed to the stack at a
+    // time, the following ones wait here in order. The stack confirms a
+    // notification as soon as L2CAP accepts it, so the controller buffers
+    // stay full and are packed into each connection event.
+    queued_notification_t _notification_queue[MAX_QUEUED_NOTIFICATION_CNT];
+    uint8_t _notification_queue_count;
+    GattAttribute::Handle_t _notification_in_flight[DM_CONN_MAX];
+    bool _tx_ready_pending[DM_CONN_MAX];
+
     struct {
         attsGroup_t service;
         attsAttr_t attributes[7];
@@ -145,6 +145,12 @@ public:
         coded_symbol_per_bit_t coded_symbol
     );
 
+    virtual ble_error_t set_data_length(
+        connection_handle_t connection,
+        uint16_t tx_octets,
+        uint16_t tx_time
+    );
+
     // singleton of the ARM Cordio client
     static Gap& get_gap();
 
@@ -0,0 +1,141 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+
+#include "events/mbed_events.h"
+#include "platform/Callback.h"
+#include "drivers/Timer.h"
+
+#include "ble/BLE.h"
+
+#include "greentea-client/test_env.h"
+#include "utest/utest.h"
+#include "unity/unity.h"
+
+using namespace utest::v1;
+using mbed::callback;
+
+#define INITIALIZATION_TIMEOUT (10 * 1000)
+
+// 20 characteristics with a CCCD and 50 without: 161 attributes with the
+// service declaration
+#define NOTIFY_CHARACTERISTIC_COUNT 20
+#define READ_CHARACTERISTIC_COUNT 50
+#define CHARACTERISTIC_COUNT (NOTIFY_CHARACTERISTIC_COUNT + READ_CHARACTERISTIC_COUNT)
+
+#define LOOKUP_ITERATIONS 1000
+
+static EventQueue event_queue(/* event count */ 10 * EVENTS_EVENT_SIZE);
+
+static bool initialized = false;
+
+static uint8_t values[CHARACTERISTIC_COUNT];
+static GattCharacteristic *characteristics[CHARACTERISTIC_COUNT];
+
+static void process_ble_events(BLE::OnEventsToProcessCallbackContext* context) {
+    BLE &ble = BLE::Instance();
+    event_queue.call(callback(&ble, &BLE::processEvents));
+}
+
+static void on_initialization_complete(BLE::InitializationCompleteCallbackContext *params) {
+    initialized = (params->error == BLE_ERROR_NONE);
+    event_queue.break_dispatch();
+}
+
+static void test_add_service() {
+    BLE &ble = BLE::Instance();
+    ble.onEventsToProcess(process_ble_events);
+    ble.init(on_initialization_complete);
+    event_queue.dispatch(INITIALIZATION_TIMEOUT);
+    TEST_ASSERT_TRUE(initialized);
+
+    for (size_t i = 0; i < CHARACTERISTIC_COUNT; ++i) {
+        uint8_t properties = GattCharacteristic::BLE_GATT_CHAR_PROPERTIES_READ;
+        if (i < NOTIFY_CHARACTERISTIC_COUNT) {
+            properties |= GattCharacteristic::BLE_GATT_CHAR_PROPERTIES_NOTIFY;
+        }
+        characteristics[i] = new GattCharacteristic(
+            UUID(0xA000 + i), &values[i], sizeof(values[i]), sizeof(values[i]), properties
+        );
+    }
+
+    GattService service(UUID(0xA000), characteristics, CHARACTERISTIC_COUNT);
+    TEST_ASSERT_EQUAL(BLE_ERROR_NONE, ble.gattServer().addService(service));
+}
+
+static void test_lookup() {
+    GattServer &server = BLE::Instance().gattServer();
+
+    for (size_t i = 0; i < CHARACTERISTIC_COUNT; ++i) {
+        bool enabled = true;
+        ble_error_t err = server.areUpdatesEnabled(*characteristics[i], &enabled);
+        if (i < NOTIFY_CHARACTERISTIC_COUNT) {
+            TEST_ASSERT_EQUAL(BLE_ERROR_NONE, err);
+            TEST_ASSERT_FALSE(enabled);
+        } else {
+            TEST_ASSERT_EQUAL(BLE_ERROR_PARAM_OUT_OF_RANGE, err);
+        }
+
+        uint8_t value = i;
+        TEST_ASSERT_EQUAL(
+            BLE_ERROR_NONE,
+            server.write(characteristics[i]->getValueHandle(), &value, sizeof(value))
+        );
+        TEST_ASSERT_EQUAL(i, values[i]);
+    }
+}
+
+static void test_lookup_time() {
+    GattServer &server = BLE::Instance().gattServer();
+
+    // the last characteristics are the furthest from the start of a scan
+    GattCharacteristic &notify = *characteristics[NOTIFY_CHARACTERISTIC_COUNT - 1];
+    GattCharacteristic &read = *characteristics[CHARACTERISTIC_COUNT - 1];
+    bool enabled;
+
+    mbed::Timer timer;
+    timer.start();
+    for (size_t i = 0; i < LOOKUP_ITERATIONS; ++i) {
+        server.areUpdatesEnabled(notify, &enabled);
+        server.areUpdatesEnabled(read, &enabled);
+    }
+    timer.stop();
+
+    printf(
+        "%d lookups of %d attributes: %d us\r\n",
+        2 * LOOKUP_ITERATIONS,
+        (int) read.getValueHandle(),
+        (int) timer.read_us()
+    );
+}
+
+Case cases[] = {
+    Case("Test add service with many attributes", test_add_service),
+    Case("Test handle lookup", test_lookup),
+    Case("Benchmark handle lookup", test_lookup_time),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases) {
+    GREENTEA_SETUP(15, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main() {
+    return !Harness::run(specification);
+}
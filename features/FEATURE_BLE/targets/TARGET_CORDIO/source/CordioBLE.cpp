@@ -326,6 +326,8 @@ void BLE::device_manager_cb(dmEvt_t* dm_event)
         case DM_CONN_CLOSE_IND:
             /* clear CCC table on connection close */
             AttsCccClearTable(connId);
+            /* drop notifications still waiting for the link */
+            GattServer::getInstance().clear_notifications(connId);
             break;
         default:
             break;
@@ -67,6 +67,7 @@ void GattServer::initialize()
     AttsAuthorRegister(atts_auth_cb);
     add_generic_access_service();
     add_generic_attribute_service();
+    update_handle_table();
 }
 
 ble_error_t GattServer::addService(GattService &service)
@@ -125,6 +126,7 @@ ble_error_t GattServer::addService(GattService &service)
     // register services and update cccds
     AttsAddGroup(&att_service->attGroup);
     AttsCccRegister(cccd_cnt, (attsCccSet_t*)cccds, cccd_cb);
+    update_handle_table();
     return BLE_ERROR_NONE;
 }
 
@@ -283,11 +285,17 @@ ble_error_t GattServer::insert_characteristic_value_attribute(
     // Create Value Attribute
     attribute_it->pUuid = value_attribute.getUUID().getBaseUUID();
     attribute_it->maxLen = characteristic->getValueAttribute().getMaxLength();
-    attribute_it->pLen = (uint16_t*) alloc_block(attribute_it->maxLen + sizeof(uint16_t));
-    *attribute_it->pLen = value_attribute.getLength();
-    attribute_it->pValue = (uint8_t*) ((uint16_t*)attribute_it->pLen + 1);
-    memcpy(attribute_it->pValue, value_attribute.getValuePtr(), *attribute_it->pLen);
-    memset(attribute_it->pValue + *attribute_it->pLen, 0, attribute_it->maxLen - *attribute_it->pLen);
+    if (value_attribute.isValueOwnedByApplication() && value_attribute.getValuePtr()) {
+        // reads are served from and writes land in the application buffer
+        attribute_it->pLen = value_attribute.getLengthPtr();
+        attribute_it->pValue = value_attribute.getValuePtr();
+    } else {
+        attribute_it->pLen = (uint16_t*) alloc_block(attribute_it->maxLen + sizeof(uint16_t));
+        *attribute_it->pLen = value_attribute.getLength();
+        attribute_it->pValue = (uint8_t*) ((uint16_t*)attribute_it->pLen + 1);
+        memcpy(attribute_it->pValue, value_attribute.getValuePtr(), *attribute_it->pLen);
+        memset(attribute_it->pValue + *attribute_it->pLen, 0, attribute_it->maxLen - *attribute_it->pLen);
+    }
 
     // Set value attribute settings
     if (properties & READ_PROPERTY) {
@@ -579,6 +587,43 @@ ble_error_t GattServer::read(
     return read(att_handle, buffer, buffer_length);
 }
 
+ble_error_t GattServer::set_attribute_value(
+    GattAttribute::Handle_t att_handle,
+    const uint8_t *buffer,
+    uint16_t len
+) {
+    // values owned by the application may have been updated in place, only
+    // their length needs to be set
+    attsAttr_t *attribute = get_attribute(att_handle);
+    if (attribute && attribute->pValue == buffer) {
+        if (len > attribute->maxLen) {
+            return BLE_ERROR_PARAM_OUT_OF_RANGE;
+        }
+        if (attribute->settings & ATTS_SET_VARIABLE_LEN) {
+            *attribute->pLen = len;
+        }
+        return BLE_ERROR_NONE;
+    }
+
+    if (AttsSetAttr(att_handle, len, (uint8_t*)buffer) != ATT_SUCCESS) {
+        return BLE_ERROR_PARAM_OUT_OF_RANGE;
+    }
+
+    return BLE_ERROR_NONE;
+}
+
+attsAttr_t *GattServer::get_attribute(GattAttribute::Handle_t att_handle)
+{
+    for (internal_service_t *service = registered_service; service; service = service->next) {
+        if ((att_handle >= service->attGroup.startHandle) &&
+            (att_handle <= service->attGroup.endHandle)) {
+            return &service->attGroup.pAttr[att_handle - service->attGroup.startHandle];
+        }
+    }
+
+    return NULL;
+}
+
 ble_error_t GattServer::write(
     GattAttribute::Handle_t att_handle,
     const uint8_t buffer[],
@@ -606,7 +651,7 @@ ble_error_t GattServer::write(
     }
 
     // write the value to the attribute handle
-    if (AttsSetAttr(att_handle, len, (uint8_t*)buffer) != ATT_SUCCESS) {
+    if (set_attribute_value(att_handle, buffer, len) != BLE_ERROR_NONE) {
         return BLE_ERROR_PARAM_OUT_OF_RANGE;
     }
 
@@ -619,14 +664,18 @@ ble_error_t GattServer::write(
     // indications for all active connections if the authentication is
     // successful
     size_t updates_sent = 0;
+    ble_error_t err = BLE_ERROR_NONE;
 
     for (dmConnId_t conn_id = DM_CONN_MAX; conn_id > DM_CONN_ID_NONE; --conn_id) {
         if (DmConnInUse(conn_id) == true) {
             if (is_update_authorized(conn_id, att_handle)) {
                 uint16_t cccd_config = AttsCccEnabled(conn_id, cccd_index);
                 if (cccd_config & ATT_CLIENT_CFG_NOTIFY) {
-                    AttsHandleValueNtf(conn_id, att_handle, len, (uint8_t*)buffer);
-                    updates_sent++;
+                    if (send_notification(conn_id, att_handle, len, buffer) == BLE_ERROR_NONE) {
+                        updates_sent++;
+                    } else {
+                        err = BLE_ERROR_NO_MEM;
+                    }
                 }
                 if (cccd_config & ATT_CLIENT_CFG_INDICATE) {
                     AttsHandleValueInd(conn_id, att_handle, len, (uint8_t*)buffer);
@@ -640,7 +689,7 @@ ble_error_t GattServer::write(
         handleDataSentEvent(updates_sent);
     }
 
-    return BLE_ERROR_NONE;
+    return err;
 }
 
 ble_error_t GattServer::write(
@@ -664,7 +713,7 @@ ble_error_t GattServer::write(
     }
 
     // write the value to the attribute handle
-    if (AttsSetAttr(att_handle, len, (uint8_t*)buffer) != ATT_SUCCESS) {
+    if (set_attribute_value(att_handle, buffer, len) != BLE_ERROR_NONE) {
         return BLE_ERROR_PARAM_OUT_OF_RANGE;
     }
 
@@ -675,12 +724,15 @@ ble_error_t GattServer::write(
 
     // This characteristic has a CCCD attribute. Handle notifications and indications.
     size_t updates_sent = 0;
+    ble_error_t err = BLE_ERROR_NONE;
 
     if (is_update_authorized(connection, att_handle)) {
         uint16_t cccEnabled = AttsCccEnabled(connection, cccd_index);
         if (cccEnabled & ATT_CLIENT_CFG_NOTIFY) {
-            AttsHandleValueNtf(connection, att_handle, len, (uint8_t*)buffer);
-            updates_sent++;
+            err = send_notification(connection, att_handle, len, buffer);
+            if (err == BLE_ERROR_NONE) {
+                updates_sent++;
+            }
         }
         if (cccEnabled & ATT_CLIENT_CFG_INDICATE) {
             AttsHandleValueInd(connection, att_handle, len, (uint8_t*)buffer);
@@ -692,31 +744,30 @@ ble_error_t GattServer::write(
         handleDataSentEvent(updates_sent);
     }
 
-    return BLE_ERROR_NONE;
+    return err;
 }
 
 ble_error_t GattServer::areUpdatesEnabled(
     const GattCharacteristic &characteristic,
     bool *enabled
 ) {
-    for (size_t idx = 0; idx < cccd_cnt; idx++) {
-        if (characteristic.getValueHandle() == cccd_handles[idx]) {
-            for (dmConnId_t conn_id = DM_CONN_MAX; conn_id > DM_CONN_ID_NONE; --conn_id) {
-                if (DmConnInUse(conn_id) == true) {
-                    uint16_t cccd_value = AttsCccGet(conn_id, idx);
-                    if (cccd_value & (ATT_CLIENT_CFG_NOTIFY | ATT_CLIENT_CFG_INDICATE)) {
-                        *enabled = true;
-                        return BLE_ERROR_NONE;
-                    }
+    uint8_t idx;
+    if (!get_cccd_index_by_value_handle(characteristic.getValueHandle(), idx)) {
+        return BLE_ERROR_PARAM_OUT_OF_RANGE;
+    }
 
-                }
+    for (dmConnId_t conn_id = DM_CONN_MAX; conn_id > DM_CONN_ID_NONE; --conn_id) {
+        if (DmConnInUse(conn_id) == true) {
+            uint16_t cccd_value = AttsCccGet(conn_id, idx);
+            if (cccd_value & (ATT_CLIENT_CFG_NOTIFY | ATT_CLIENT_CFG_INDICATE)) {
+                *enabled = true;
+                return BLE_ERROR_NONE;
             }
-            *enabled = false;
-            return BLE_ERROR_NONE;
+
         }
     }
-
-    return BLE_ERROR_PARAM_OUT_OF_RANGE;
+    *enabled = false;
+    return BLE_ERROR_NONE;
 }
 
 ble_error_t GattServer::areUpdatesEnabled(
@@ -728,18 +779,18 @@ ble_error_t GattServer::areUpdatesEnabled(
         return BLE_ERROR_INVALID_PARAM;
     }
 
-    for (uint8_t idx = 0; idx < cccd_cnt; idx++) {
-        if (characteristic.getValueHandle() == cccd_handles[idx]) {
-            uint16_t cccd_value = AttsCccGet(connectionHandle, idx);
-            if (cccd_value & (ATT_CLIENT_CFG_NOTIFY | ATT_CLIENT_CFG_INDICATE)) {
-                *enabled = true;
-            } else {
-                *enabled = false;
-            }
-            return BLE_ERROR_NONE;
-        }
+    uint8_t idx;
+    if (!get_cccd_index_by_value_handle(characteristic.getValueHandle(), idx)) {
+        return BLE_ERROR_PARAM_OUT_OF_RANGE;
+    }
+
+    uint16_t cccd_value = AttsCccGet(connectionHandle, idx);
+    if (cccd_value & (ATT_CLIENT_CFG_NOTIFY | ATT_CLIENT_CFG_INDICATE)) {
+        *enabled = true;
+    } else {
+        *enabled = false;
     }
-    return BLE_ERROR_PARAM_OUT_OF_RANGE;
+    return BLE_ERROR_NONE;
 }
 
 bool GattServer::isOnDataReadAvailable() const
@@ -832,6 +883,14 @@ ble_error_t GattServer::reset(void)
 
     _auth_char_count = 0;
 
+    free(_handle_table);
+    _handle_table = NULL;
+    _handle_table_size = 0;
+
+    for (dmConnId_t conn_id = DM_CONN_MAX; conn_id > DM_CONN_ID_NONE; --conn_id) {
+        clear_notifications(conn_id);
+    }
+
     AttsCccRegister(cccd_cnt, (attsCccSet_t*)cccds, cccd_cb);
 
     return BLE_ERROR_NONE;
@@ -854,8 +913,20 @@ void GattServer::att_cb(const attEvt_t *evt)
         if (handler) {
             handler->onAttMtuChange(evt->hdr.param, evt->mtu);
         }
-    } else if (evt->hdr.status == ATT_SUCCESS && evt->hdr.event == ATTS_HANDLE_VALUE_CNF) {
-        getInstance().handleEvent(GattServerEvents::GATT_EVENT_DATA_SENT, evt->handle);
+    } else if (evt->hdr.event == ATTS_HANDLE_VALUE_CNF) {
+        GattServer &server = getInstance();
+        dmConnId_t conn_id = (dmConnId_t) evt->hdr.param;
+
+        // The stack confirms notifications once L2CAP accepted them, or with
+        // an error status if they were dropped: either way the next one can go.
+        if (conn_id > DM_CONN_ID_NONE && conn_id <= DM_CONN_MAX &&
+            server._notification_in_flight[conn_id - 1] == evt->handle) {
+            server.send_next_notification(conn_id);
+        }
+
+        if (evt->hdr.status == ATT_SUCCESS) {
+            server.handleEvent(GattServerEvents::GATT_EVENT_DATA_SENT, evt->handle);
+        }
     }
 }
 
@@ -1193,8 +1264,43 @@ void* GattServer::alloc_block(size_t block_size) {
     return block->data;
 }
 
+void GattServer::update_handle_table()
+{
+    if (currentHandle > _handle_table_size) {
+        handle_entry_t *table = (handle_entry_t*) realloc(
+            _handle_table, currentHandle * sizeof(handle_entry_t)
+        );
+        if (!table) {
+            // lookups of the new handles fall back to a scan
+            return;
+        }
+        _handle_table = table;
+        _handle_table_size = currentHandle;
+    }
+
+    for (uint16_t i = 0; i < _handle_table_size; ++i) {
+        _handle_table[i].auth_char = handle_entry_t::NO_INDEX;
+        _handle_table[i].cccd = handle_entry_t::NO_INDEX;
+        _handle_table[i].value_cccd = handle_entry_t::NO_INDEX;
+    }
+
+    for (uint8_t i = 0; i < _auth_char_count; ++i) {
+        _handle_table[_auth_char[i]->getValueHandle() - 1].auth_char = i;
+    }
+
+    for (uint8_t i = 0; i < cccd_cnt; ++i) {
+        _handle_table[cccds[i].handle - 1].cccd = i;
+        _handle_table[cccd_handles[i] - 1].value_cccd = i;
+    }
+}
+
 GattCharacteristic* GattServer::get_auth_char(uint16_t value_handle)
 {
+    if (value_handle && value_handle <= _handle_table_size) {
+        uint8_t idx = _handle_table[value_handle - 1].auth_char;
+        return idx == handle_entry_t::NO_INDEX ? NULL : _auth_char[idx];
+    }
+
     for (size_t i = 0; i < _auth_char_count; ++i) {
         if (_auth_char[i]->getValueHandle() == value_handle) {
             return _auth_char[i];
@@ -1205,6 +1311,11 @@ GattCharacteristic* GattServer::get_auth_char(uint16_t value_handle)
 
 bool GattServer::get_cccd_index_by_cccd_handle(GattAttribute::Handle_t cccd_handle, uint8_t& idx) const
 {
+    if (cccd_handle && cccd_handle <= _handle_table_size) {
+        idx = _handle_table[cccd_handle - 1].cccd;
+        return idx != handle_entry_t::NO_INDEX;
+    }
+
     for (idx = 0; idx < cccd_cnt; idx++) {
         if (cccd_handle == cccds[idx].handle) {
             return true;
@@ -1215,6 +1326,11 @@ bool GattServer::get_cccd_index_by_cccd_handle(GattAttribute::Handle_t cccd_hand
 
 bool GattServer::get_cccd_index_by_value_handle(GattAttribute::Handle_t char_handle, uint8_t& idx) const
 {
+    if (char_handle && char_handle <= _handle_table_size) {
+        idx = _handle_table[char_handle - 1].value_cccd;
+        return idx != handle_entry_t::NO_INDEX;
+    }
+
     for (idx = 0; idx < cccd_cnt; ++idx) {
         if (char_handle == cccd_handles[idx]) {
             return true;
@@ -1270,6 +1386,96 @@ bool GattServer::is_update_authorized(
     }
 }
 
+ble_error_t GattServer::send_notification(
+    dmConnId_t conn_id,
+    GattAttribute::Handle_t value_handle,
+    uint16_t len,
+    const uint8_t *buffer
+) {
+    uint8_t conn_index = conn_id - 1;
+    bool in_flight = _notification_in_flight[conn_index] != ATT_HANDLE_NONE;
+
+    // signal the application once this connection's queue drains
+    if (in_flight) {
+        _tx_ready_pending[conn_index] = true;
+    }
+
+    if (in_flight && _notification_queue_count == MAX_QUEUED_NOTIFICATION_CNT) {
+        return BLE_ERROR_NO_MEM;
+    }
+
+    uint8_t *value = (uint8_t*) AttMsgAlloc(len, ATT_PDU_VALUE_NTF);
+    if (!value) {
+        return BLE_ERROR_NO_MEM;
+    }
+    memcpy(value, buffer, len);
+
+    // nothing in flight means nothing queued either: send right away
+    if (!in_flight) {
+        _notification_in_flight[conn_index] = value_handle;
+        AttsHandleValueNtfZeroCpy(conn_id, value_handle, len, value);
+        return BLE_ERROR_NONE;
+    }
+
+    queued_notification_t &entry = _notification_queue[_notification_queue_count++];
+    entry.connection = conn_id;
+    entry.handle = value_handle;
+    entry.len = len;
+    entry.value = value;
+
+    return BLE_ERROR_NONE;
+}
+
+void GattServer::send_next_notification(dmConnId_t conn_id)
+{
+    uint8_t conn_index = conn_id - 1;
+    _notification_in_flight[conn_index] = ATT_HANDLE_NONE;
+
+    for (uint8_t i = 0; i < _notification_queue_count; ++i) {
+        if (_notification_queue[i].connection != conn_id) {
+            continue;
+        }
+
+        queued_notification_t next = _notification_queue[i];
+        _notification_queue_count--;
+        memmove(
+            &_notification_queue[i],
+            &_notification_queue[i + 1],
+            (_notification_queue_count - i) * sizeof(queued_notification_t)
+        );
+
+        _notification_in_flight[conn_index] = next.handle;
+        // the stack owns the buffer from here, even if the connection is gone
+        AttsHandleValueNtfZeroCpy(conn_id, next.handle, next.len, next.value);
+        return;
+    }
+
+    if (_tx_ready_pending[conn_index]) {
+        _tx_ready_pending[conn_index] = false;
+        ::GattServer::EventHandler *handler = getEventHandler();
+        if (handler) {
+            handler->onAttTxReady(conn_id);
+        }
+    }
+}
+
+void GattServer::clear_notifications(dmConnId_t conn_id)
+{
+    uint8_t kept = 0;
+
+    for (uint8_t i = 0; i < _notification_queue_count; ++i) {
+        if (_notification_queue[i].connection == conn_id) {
+            AttMsgFree(_notification_queue[i].value, ATT_PDU_VALUE_NTF);
+        } else {
+            _notification_queue[kept++] = _notification_queue[i];
+        }
+    }
+
+    _notification_queue_count = kept;
+    _notification_in_flight[conn_id - 1] = ATT_HANDLE_NONE;
+    _tx_ready_pending[conn_id - 1] = false;
+}
+
 GattServer::GattServer() :
     ::GattServer(),
     _signing_event_handler(NULL),
@@ -1279,6 +1485,12 @@ GattServer::GattServer() :
     cccd_cnt(0),
     _auth_char(),
     _auth_char_count(0),
+    _handle_table(NULL),
+    _handle_table_size(0),
+    _notification_queue(),
+    _notification_queue_count(0),
+    _notification_in_flight(),
+    _tx_ready_pending(),
     generic_access_service(),
     generic_attribute_service(),
     registered_service(NULL),
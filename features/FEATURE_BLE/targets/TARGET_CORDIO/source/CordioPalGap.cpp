@@ -409,6 +409,21 @@ ble_error_t Gap::set_phy(
     return BLE_ERROR_NONE;
 }
 
+ble_error_t Gap::set_data_length(
+    connection_handle_t connection,
+    uint16_t tx_octets,
+    uint16_t tx_time
+)
+{
+    if (!is_feature_supported(controller_supported_features_t::LE_DATA_PACKET_LENGTH_EXTENSION)) {
+        return BLE_ERROR_NOT_IMPLEMENTED;
+    }
+
+    DmConnSetDataLen(connection, tx_octets, tx_time);
+
+    return BLE_ERROR_NONE;
+}
+
 // singleton of the ARM Cordio client
 Gap &Gap::get_gap()
 {
@@ -68,14 +68,22 @@ ATHandler::ATHandler(FileHandle *fh, EventQueue &queue, uint32_t timeout, const
     _last_err(NSAPI_ERROR_OK),
     _last_3gpp_error(0),
     _oob_string_max_length(0),
-    _oobs(NULL),
     _at_timeout(timeout),
     _previous_at_timeout(timeout),
     _at_send_delay(send_delay),
     _last_response_stop(0),
     _oob_queued(false),
+    _cmds(NULL),
+    _cmd_queued(false),
     _ref_count(1),
     _is_fh_usable(false),
+    _power_save_idle(0),
+    _power_save_batch(0),
+    _awake(false),
+    _wake_time(0),
+    _last_activity(0),
+    _sleep_event_id(0),
+    _window_commands(0),
     _stop_tag(NULL),
     _delimiter(DEFAULT_DELIMITER),
     _prefix_matched(false),
@@ -96,6 +104,9 @@ ATHandler::ATHandler(FileHandle *fh, EventQueue &queue, uint32_t timeout, const
         _output_delimiter = NULL;
     }
 
+    memset(_oobs, 0, sizeof(_oobs));
+    memset(&_power_save_stats, 0, sizeof(_power_save_stats));
+
     reset_buffer();
     memset(_recv_buff, 0, sizeof(_recv_buff));
     memset(_info_resp_prefix, 0, sizeof(_info_resp_prefix));
@@ -120,12 +131,22 @@ bool ATHandler::get_debug() const
 
 ATHandler::~ATHandler()
 {
+    if (_sleep_event_id) {
+        _queue.cancel(_sleep_event_id);
+    }
     set_file_handle(NULL);
 
-    while (_oobs) {
-        struct oob_t *oob = _oobs;
-        _oobs = oob->next;
-        delete oob;
+    for (size_t i = 0; i < sizeof(_oobs) / sizeof(_oobs[0]); i++) {
+        while (_oobs[i]) {
+            struct oob_t *oob = _oobs[i];
+            _oobs[i] = oob->next;
+            delete oob;
+        }
+    }
+    while (_cmds) {
+        struct cmd_t *cmd = _cmds;
+        _cmds = cmd->next;
+        delete cmd;
     }
     if (_output_delimiter) {
         delete [] _output_delimiter;
@@ -198,23 +219,25 @@ void ATHandler::set_urc_handler(const char *prefix, Callback<void()> callback)
         }
     }
 
+    struct oob_t **list = urc_list(prefix, prefix_len);
     oob->prefix = prefix;
     oob->prefix_len = prefix_len;
     oob->cb = callback;
-    oob->next = _oobs;
-    _oobs = oob;
+    oob->next = *list;
+    *list = oob;
 }
 
 void ATHandler::remove_urc_handler(const char *prefix)
 {
-    struct oob_t *current = _oobs;
+    struct oob_t **list = urc_list(prefix, strlen(prefix));
+    struct oob_t *current = *list;
     struct oob_t *prev = NULL;
     while (current) {
         if (strcmp(prefix, current->prefix) == 0) {
             if (prev) {
                 prev->next = current->next;
             } else {
-                _oobs = current->next;
+                *list = current->next;
             }
             delete current;
             break;
@@ -226,7 +249,7 @@ void ATHandler::remove_urc_handler(const char *prefix)
 
 bool ATHandler::find_urc_handler(const char *prefix)
 {
-    struct oob_t *oob = _oobs;
+    struct oob_t *oob = *urc_list(prefix, strlen(prefix));
     while (oob) {
         if (strcmp(prefix, oob->prefix) == 0) {
             return true;
@@ -237,6 +260,88 @@ bool ATHandler::find_urc_handler(const char *prefix)
     return false;
 }
 
+nsapi_error_t ATHandler::queue_cmd(const char *cmd, const char *prefix, Callback<void(ATHandler &)> parse,
+                                   Callback<void(nsapi_error_t)> done)
+{
+    struct cmd_t *new_cmd = new struct cmd_t;
+    new_cmd->cmd = cmd;
+    new_cmd->prefix = prefix;
+    new_cmd->parse = parse;
+    new_cmd->done = done;
+    new_cmd->next = NULL;
+
+#ifdef AT_HANDLER_MUTEX
+    _fileHandleMutex.lock();
+#endif
+    struct cmd_t **last = &_cmds;
+    while (*last) {
+        last = &(*last)->next;
+    }
+    *last = new_cmd;
+
+    bool post = !_cmd_queued;
+    _cmd_queued = true;
+#ifdef AT_HANDLER_MUTEX
+    _fileHandleMutex.unlock();
+#endif
+
+    // a sleeping modem waits for more commands to send them in a single wake window
+    int batch_ms = (_power_save_cb && !_awake) ? _power_save_batch : 0;
+    if (post && !_queue.call_in(batch_ms, Callback<void(void)>(this, &ATHandler::process_cmd_queue))) {
+#ifdef AT_HANDLER_MUTEX
+        _fileHandleMutex.lock();
+#endif
+        // commands queued meanwhile were waiting for this event too
+        struct cmd_t *cmds = _cmds;
+        _cmds = NULL;
+        _cmd_queued = false;
+#ifdef AT_HANDLER_MUTEX
+        _fileHandleMutex.unlock();
+#endif
+        while (cmds) {
+            struct cmd_t *cmd = cmds;
+            cmds = cmd->next;
+            if (cmd != new_cmd && cmd->done) {
+                cmd->done(NSAPI_ERROR_NO_MEMORY);
+            }
+            delete cmd;
+        }
+        tr_error("AT command queue full");
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    return NSAPI_ERROR_OK;
+}
+
+void ATHandler::process_cmd_queue()
+{
+    while (true) {
+        lock();
+        struct cmd_t *cmd = _cmds;
+        if (!cmd) {
+            _cmd_queued = false;
+            unlock();
+            return;
+        }
+        _cmds = cmd->next;
+
+        cmd_start(cmd->cmd);
+        cmd_stop();
+        resp_start(cmd->prefix);
+        if (cmd->parse) {
+            cmd->parse(*this);
+        }
+        resp_stop();
+        nsapi_error_t err = unlock_return_error();
+
+        // called unlocked so that it can queue more commands or send them synchronously
+        if (cmd->done) {
+            cmd->done(err);
+        }
+        delete cmd;
+    }
+}
+
 void ATHandler::event()
 {
     if (!_oob_queued) {
@@ -256,6 +361,14 @@ void ATHandler::lock()
 
 void ATHandler::unlock()
 {
+    if (_awake) {
+        // restart the idle time of the wake window
+        _last_activity = rtos::Kernel::get_ms_count();
+        if (_sleep_event_id) {
+            _queue.cancel(_sleep_event_id);
+        }
+        _sleep_event_id = _queue.call_in(_power_save_idle, Callback<void(void)>(this, &ATHandler::power_save_sleep));
+    }
 #ifdef AT_HANDLER_MUTEX
     _fileHandleMutex.unlock();
 #endif
@@ -372,20 +485,30 @@ bool ATHandler::fill_buffer(bool wait_for_timeout)
         reset_buffer();
     }
 
+    size_t len = read_serial(_recv_buff + _recv_len, sizeof(_recv_buff) - _recv_len, wait_for_timeout);
+    if (len > 0) {
+        debug_print(_recv_buff + _recv_len, len);
+        _recv_len += len;
+        return true;
+    }
+
+    return false;
+}
+
+size_t ATHandler::read_serial(void *buf, size_t size, bool wait_for_timeout)
+{
     pollfh fhs;
     fhs.fh = _fileHandle;
     fhs.events = POLLIN;
     int count = poll(&fhs, 1, poll_timeout(wait_for_timeout));
     if (count > 0 && (fhs.revents & POLLIN)) {
-        ssize_t len = _fileHandle->read(_recv_buff + _recv_len, sizeof(_recv_buff) - _recv_len);
+        ssize_t len = _fileHandle->read(buf, size);
         if (len > 0) {
-            debug_print(_recv_buff + _recv_len, len);
-            _recv_len += len;
-            return true;
+            return len;
         }
     }
 
-    return false;
+    return 0;
 }
 
 int ATHandler::get_char()
@@ -459,14 +582,41 @@ ssize_t ATHandler::read_bytes(uint8_t *buf, size_t len)
 
     bool debug_on = _debug_on;
     size_t read_len = 0;
-    for (; read_len < len; read_len++) {
-        int c = get_char();
-        if (c == -1) {
+    while (read_len < len) {
+        size_t count = _recv_len - _recv_pos;
+        if (count > 0) {
+            // copy what was already received
+            if (count > len - read_len) {
+                count = len - read_len;
+            }
+            memcpy(buf + read_len, _recv_buff + _recv_pos, count);
+            _recv_pos += count;
+        } else if (len - read_len >= sizeof(_recv_buff)) {
+            // the rest would not fit in the receiving buffer, so read it straight to buf
+            reset_buffer();
+            count = read_serial(buf + read_len, len - read_len);
+            if (_debug_on && count > DEBUG_MAXLEN) {
+                debug_print((char *)buf + read_len, DEBUG_MAXLEN);
+                debug_print(DEBUG_END_MARK, sizeof(DEBUG_END_MARK) - 1);
+                _debug_on = false;
+            } else {
+                debug_print((char *)buf + read_len, count);
+            }
+        } else {
+            reset_buffer();
+            if (fill_buffer()) {
+                continue;
+            }
+        }
+
+        if (count == 0) {
+            tr_warn("AT timeout");
             set_error(NSAPI_ERROR_DEVICE_ERROR);
             _debug_on = debug_on;
             return -1;
         }
-        buf[read_len] = c;
+        read_len += count;
+
         if (_debug_on && read_len >= DEBUG_MAXLEN) {
             debug_print(DEBUG_END_MARK, sizeof(DEBUG_END_MARK) - 1);
             _debug_on = false;
@@ -709,11 +859,32 @@ bool ATHandler::match(const char *str, size_t size)
     return false;
 }
 
+ATHandler::oob_t **ATHandler::urc_list(const char *prefix, size_t prefix_len)
+{
+    if (prefix_len < URC_HASH_LEN) {
+        return &_oobs[URC_HASH_SIZE];
+    }
+
+    uint32_t hash = 0;
+    for (size_t i = 0; i < URC_HASH_LEN; i++) {
+        hash = hash * 31 + (uint8_t)prefix[i];
+    }
+    return &_oobs[hash % URC_HASH_SIZE];
+}
+
 bool ATHandler::match_urc()
 {
     rewind_buffer();
+    if (_recv_len >= URC_HASH_LEN && match_urc(*urc_list(_recv_buff, _recv_len))) {
+        return true;
+    }
+    return match_urc(_oobs[URC_HASH_SIZE]);
+}
+
+bool ATHandler::match_urc(oob_t *oob)
+{
     size_t prefix_len = 0;
-    for (struct oob_t *oob = _oobs; oob; oob = oob->next) {
+    for (; oob; oob = oob->next) {
         prefix_len = oob->prefix_len;
         if (_recv_len >= prefix_len) {
             if (match(oob->prefix, prefix_len)) {
@@ -1081,6 +1252,7 @@ const char *ATHandler::mem_str(const char *dest, size_t dest_len, const char *sr
 
 void ATHandler::cmd_start(const char *cmd)
 {
+    power_save_wake();
 
     if (_at_send_delay) {
         rtos::ThisThread::sleep_until(_last_response_stop + _at_send_delay);
@@ -1253,6 +1425,79 @@ void ATHandler::debug_print(const char *p, int len)
 #endif // MBED_CONF_CELLULAR_DEBUG_AT
 }
 
+void ATHandler::set_power_save_callback(Callback<void(bool)> cb, uint32_t idle_ms, uint32_t batch_ms)
+{
+    lock();
+    if (_awake && !cb) {
+        // the modem stays awake from now on
+        close_wake_window(rtos::Kernel::get_ms_count());
+    }
+    _power_save_cb = cb;
+    _power_save_idle = idle_ms;
+    _power_save_batch = batch_ms;
+    unlock();
+}
+
+void ATHandler::get_power_save_stats(power_save_stats_t *stats)
+{
+    lock();
+    *stats = _power_save_stats;
+    unlock();
+}
+
+void ATHandler::power_save_wake()
+{
+    if (!_power_save_cb) {
+        return;
+    }
+
+    if (!_awake) {
+        _awake = true;
+        _wake_time = rtos::Kernel::get_ms_count();
+        _window_commands = 0;
+        _power_save_stats.wakeups++;
+        _power_save_cb(true);
+    }
+
+    _window_commands++;
+    _power_save_stats.commands++;
+}
+
+void ATHandler::power_save_sleep()
+{
+    // not through lock()/unlock(), which would restart the wake window
+#ifdef AT_HANDLER_MUTEX
+    _fileHandleMutex.lock();
+#endif
+    _sleep_event_id = 0;
+    uint64_t now = rtos::Kernel::get_ms_count();
+    uint64_t idle = now - _last_activity;
+
+    // the modem is kept awake in data mode and while queued commands wait to be sent
+    if (_awake && _is_fh_usable && !_cmds) {
+        if (idle < _power_save_idle) {
+            _sleep_event_id = _queue.call_in(_power_save_idle - idle,
+                                             Callback<void(void)>(this, &ATHandler::power_save_sleep));
+        } else {
+            close_wake_window(now);
+            _power_save_cb(false);
+        }
+    }
+#ifdef AT_HANDLER_MUTEX
+    _fileHandleMutex.unlock();
+#endif
+}
+
+void ATHandler::close_wake_window(uint64_t now)
+{
+    uint32_t awake_time = now - _wake_time;
+    _awake = false;
+    _power_save_stats.awake_time += awake_time;
+    _power_save_stats.last_awake_time = awake_time;
+    _power_save_stats.last_commands = _window_commands;
+    tr_debug("AT modem awake %lu ms for %lu commands", (unsigned long)awake_time, (unsigned long)_window_commands);
+}
+
 bool ATHandler::sync(int timeout_ms)
 {
     tr_debug("AT sync");
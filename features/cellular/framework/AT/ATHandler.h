@@ -45,6 +45,17 @@ extern const char *CRLF;
 
 #define BUFF_SIZE 16
 
+#define URC_HASH_SIZE 16
+#define URC_HASH_LEN 3
+
+/**
+ * Size of the buffer AT responses are received in. A bigger buffer takes fewer reads
+ * from the FileHandle to parse hex payloads and long information responses.
+ */
+#ifndef MBED_CONF_CELLULAR_AT_HANDLER_BUFFER_SIZE
+#define MBED_CONF_CELLULAR_AT_HANDLER_BUFFER_SIZE 64
+#endif
+
 /* AT Error types enumeration */
 enum DeviceErrorType {
     DeviceErrorTypeNoError = 0,
@@ -127,6 +138,19 @@ public:
      */
     void set_urc_handler(const char *prefix, Callback<void()> callback);
 
+    /** Queue an AT command to be sent from the event queue, without waiting for its response.
+     *  Queued commands are sent one after another, each as soon as the previous one has got its
+     *  final result, so independent queries can be issued back to back without blocking the caller.
+     *
+     *  @param cmd      AT command to send, e.g. "AT+CSQ". Must stay valid until done is called.
+     *  @param prefix   information response prefix, e.g. "+CSQ:", or NULL if there is no information response
+     *  @param parse    called after resp_start(prefix) to read the information response, or 0
+     *  @param done     called with the last error once the response is stopped, or 0
+     *  @return         NSAPI_ERROR_OK, or NSAPI_ERROR_NO_MEMORY if the command could not be queued
+     */
+    nsapi_error_t queue_cmd(const char *cmd, const char *prefix, Callback<void(ATHandler &)> parse,
+                            Callback<void(nsapi_error_t)> done);
+
     ATHandler *_nextATHandler; // linked list
 
     /** returns the last error while parsing AT responses.
@@ -210,8 +234,51 @@ public:
      */
     bool sync(int timeout_ms);
 
+    /** Modem power save statistics of the AT channel, see set_power_save_callback() */
+    struct power_save_stats_t {
+        uint32_t wakeups;           // wake windows opened
+        uint32_t commands;          // commands written
+        uint64_t awake_time;        // time in ms the modem was kept awake, in total
+        uint32_t last_awake_time;   // time in ms of the last closed wake window
+        uint32_t last_commands;     // commands written in the last closed wake window
+    };
+
+    /** Let the modem sleep while the AT channel is idle.
+     *
+     *  The callback is called with true before a command is written to a sleeping modem, and with
+     *  false once no command has been written for idle_ms. Commands and socket sends following each
+     *  other within idle_ms share a single wake window. The callback drives the power save lines of
+     *  the modem, for example asserts DTR or RTS and waits for the modem to be ready when called with
+     *  true, and deasserts them when called with false. It is called with the AT handler locked, on
+     *  the event queue when letting the modem sleep.
+     *
+     *  Commands queued with queue_cmd() while the modem sleeps are held for batch_ms, so that the
+     *  ones queued meanwhile are sent in the same wake window.
+     *
+     *  The modem is kept awake while the file handle is not usable, for example in data mode.
+     *
+     *  @param cb       power save callback, or 0 to keep the modem awake
+     *  @param idle_ms  time in ms the modem is kept awake after the last command
+     *  @param batch_ms time in ms queued commands wait for others while the modem sleeps
+     */
+    void set_power_save_callback(Callback<void(bool)> cb, uint32_t idle_ms, uint32_t batch_ms = 0);
+
+    /** Get the power save statistics, the open wake window is not included.
+     *
+     *  @param stats    statistics to fill in
+     */
+    void get_power_save_stats(power_save_stats_t *stats);
+
 protected:
     void event();
+    // Sends the queued commands, see queue_cmd().
+    void process_cmd_queue();
+    // Opens a wake window if the modem sleeps, see set_power_save_callback().
+    void power_save_wake();
+    // Closes the wake window once the AT channel has been idle long enough.
+    void power_save_sleep();
+    // Accounts the wake window closing at the given time.
+    void close_wake_window(uint64_t now);
 #ifdef AT_HANDLER_MUTEX
     PlatformMutex _fileHandleMutex;
 #endif
@@ -238,7 +305,10 @@ private:
         Callback<void()> cb;
         oob_t *next;
     };
-    oob_t *_oobs;
+    // URCs are listed by a hash of the first URC_HASH_LEN chars of their prefix,
+    // so that a received line is only compared with the URCs starting alike.
+    // Prefixes shorter than that are listed last, at URC_HASH_SIZE.
+    oob_t *_oobs[URC_HASH_SIZE + 1];
     uint32_t _at_timeout;
     uint32_t _previous_at_timeout;
 
@@ -246,9 +316,30 @@ private:
     uint64_t _last_response_stop;
 
     bool _oob_queued;
+
+    struct cmd_t {
+        const char *cmd;
+        const char *prefix;
+        Callback<void(ATHandler &)> parse;
+        Callback<void(nsapi_error_t)> done;
+        cmd_t *next;
+    };
+    // commands queued with queue_cmd(), in sending order
+    cmd_t *_cmds;
+    bool _cmd_queued;
     int32_t _ref_count;
     bool _is_fh_usable;
 
+    Callback<void(bool)> _power_save_cb;
+    uint32_t _power_save_idle;
+    uint32_t _power_save_batch;
+    bool _awake;
+    uint64_t _wake_time;
+    uint64_t _last_activity;
+    int _sleep_event_id;
+    uint32_t _window_commands;
+    power_save_stats_t _power_save_stats;
+
     static ATHandler *_atHandlers;
 
     //*************************************
@@ -335,6 +426,7 @@ public:
     void skip_param(ssize_t len, uint32_t count);
 
     /** Reads given number of bytes from receiving buffer without checking any subparameter delimiters, such as comma.
+     *  Once the receiving buffer is empty, the rest is read from the FileHandle straight to buf.
      *
      *  @param buf output buffer for the read
      *  @param len maximum number of bytes to read
@@ -443,7 +535,7 @@ public: // just for debugging
 private:
 
     // should fit any prefix and int
-    char _recv_buff[BUFF_SIZE];
+    char _recv_buff[MBED_CONF_CELLULAR_AT_HANDLER_BUFFER_SIZE];
     // reading position
     size_t _recv_len;
     // reading length
@@ -507,6 +599,9 @@ private:
     // Reads from serial to receiving buffer.
     // Returns true on successful read OR false on timeout.
     bool fill_buffer(bool wait_for_timeout = true);
+    // Reads from serial to the given buffer, at most size bytes, without debug printing.
+    // Returns number of bytes read OR 0 on timeout.
+    size_t read_serial(void *buf, size_t size, bool wait_for_timeout = true);
 
     void set_tag(tag_t *tag_dest, const char *tag_seq);
 
@@ -516,6 +611,10 @@ private:
     // If URC match sets the scope to information response and after urc's cb returns
     // finishes the information response scope(consumes to CRLF).
     bool match_urc();
+    // Checks if any of the listed URCs matches, see match_urc().
+    bool match_urc(oob_t *oob);
+    // Returns the list of URCs for the given prefix.
+    oob_t **urc_list(const char *prefix, size_t prefix_len);
     // Checks if any of the error strings are matching the receiving buffer content.
     bool match_error();
     // Checks if current char in buffer matches ch and consumes it,
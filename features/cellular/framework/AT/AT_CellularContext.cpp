@@ -22,6 +22,7 @@
 #include "CellularUtil.h"
 #include "UARTSerial.h"
 #include "mbed_wait_api.h"
+#include "Kernel.h"
 
 #define NETWORK_TIMEOUT 30 * 60 * 1000 // 30 minutes
 #define DEVICE_TIMEOUT 5 * 60 * 1000 // 5 minutes
@@ -46,7 +47,8 @@ using namespace mbed;
 
 AT_CellularContext::AT_CellularContext(ATHandler &at, CellularDevice *device, const char *apn, bool cp_req, bool nonip_req) :
     AT_CellularBase(at), _is_connected(false), _is_blocking(true),
-    _current_op(OP_INVALID), _device(device), _nw(0), _fh(0), _cp_req(cp_req), _nonip_req(nonip_req), _cp_in_use(false)
+    _current_op(OP_INVALID), _device(device), _nw(0), _fh(0), _timeline(), _connect_time(0),
+    _cp_req(cp_req), _nonip_req(nonip_req), _cp_in_use(false)
 {
     tr_info("New CellularContext %s (%p)", apn ? apn : "", this);
     _stack = NULL;
@@ -112,6 +114,8 @@ nsapi_error_t AT_CellularContext::connect()
     if (_is_connected) {
         return NSAPI_ERROR_IS_CONNECTED;
     }
+    memset(&_timeline, 0, sizeof(_timeline));
+    _connect_time = rtos::Kernel::get_ms_count();
     call_network_cb(NSAPI_STATUS_CONNECTING);
 
     nsapi_error_t err = _device->attach_to_network();
@@ -185,6 +189,12 @@ nsapi_connection_status_t AT_CellularContext::get_connection_status() const
     return _connect_status;
 }
 
+nsapi_error_t AT_CellularContext::get_connection_timeline(nsapi_connection_timeline_t *timeline)
+{
+    *timeline = _timeline;
+    return NSAPI_ERROR_OK;
+}
+
 uint32_t AT_CellularContext::get_timeout_for_operation(ContextOperation op) const
 {
     uint32_t timeout = NETWORK_TIMEOUT; // default timeout is 30 minutes as registration and attach may take time
@@ -578,6 +588,7 @@ void AT_CellularContext::do_connect()
         }
     }
 #else
+    record_phase(NSAPI_PHASE_ADDRESS);
     _is_connected = true;
     call_network_cb(NSAPI_STATUS_GLOBAL_UP);
 #endif
@@ -630,6 +641,10 @@ void AT_CellularContext::ppp_status_cb(nsapi_event_t ev, intptr_t ptr)
     tr_debug("ppp_status_cb: event %d, ptr %d", ev, ptr);
     if (ev == NSAPI_EVENT_CONNECTION_STATUS_CHANGE && ptr == NSAPI_STATUS_GLOBAL_UP) {
         _is_connected = true;
+        // IPCP has negotiated the address and the DNS servers
+        record_phase(NSAPI_PHASE_ADDRESS);
+        record_phase(NSAPI_PHASE_DNS_SERVER);
+        record_phase(NSAPI_PHASE_GLOBAL_UP);
     } else if (ev == NSAPI_EVENT_CONNECTION_STATUS_CHANGE && ptr == NSAPI_STATUS_DISCONNECTED) {
         ppp_disconnected();
     } else {
@@ -883,6 +898,13 @@ void AT_CellularContext::cellular_callback(nsapi_event_t ev, intptr_t ptr)
         cell_callback_data_t *data = (cell_callback_data_t *)ptr;
         cellular_connection_status_t st = (cellular_connection_status_t)ev;
         _cb_data.error = data->error;
+        if (data->error == NSAPI_ERROR_OK &&
+                ((st == CellularRegistrationStatusChanged && (data->status_data == CellularNetwork::RegisteredHomeNetwork ||
+                                                              data->status_data == CellularNetwork::RegisteredRoaming ||
+                                                              data->status_data == CellularNetwork::AlreadyRegistered)) ||
+                 (st == CellularAttachNetwork && data->status_data == CellularNetwork::Attached))) {
+            record_phase(NSAPI_PHASE_LINK_UP);
+        }
 #if USE_APN_LOOKUP
         if (st == CellularSIMStatusChanged && data->status_data == CellularDevice::SimStateReady &&
                 _cb_data.error == NSAPI_ERROR_OK) {
@@ -979,8 +1001,19 @@ void AT_CellularContext::cellular_callback(nsapi_event_t ev, intptr_t ptr)
     }
 }
 
+void AT_CellularContext::record_phase(nsapi_connection_phase_t phase)
+{
+    if (_timeline.phase_ms[phase] == 0) {
+        uint32_t elapsed = rtos::Kernel::get_ms_count() - _connect_time;
+        _timeline.phase_ms[phase] = elapsed ? elapsed : 1;
+    }
+}
+
 void AT_CellularContext::call_network_cb(nsapi_connection_status_t status)
 {
+    if (status == NSAPI_STATUS_GLOBAL_UP) {
+        record_phase(NSAPI_PHASE_GLOBAL_UP);
+    }
     if (_connect_status != status) {
         _connect_status = status;
         if (_status_cb) {
@@ -38,6 +38,7 @@ public:
     virtual nsapi_error_t connect();
     virtual nsapi_error_t disconnect();
     virtual nsapi_connection_status_t get_connection_status() const;
+    virtual nsapi_error_t get_connection_timeline(nsapi_connection_timeline_t *timeline);
     virtual bool is_connected();
     // from CellularBase
     virtual void set_plmn(const char *plmn);
@@ -94,6 +95,12 @@ protected:
      */
     void call_network_cb(nsapi_connection_status_t status);
 
+    /** Records the time since connect() of the first time the connection reaches the phase
+     *
+     *  @param phase    connection phase reached
+     */
+    void record_phase(nsapi_connection_phase_t phase);
+
     virtual nsapi_error_t activate_non_ip_context();
     virtual nsapi_error_t setup_control_plane_opt();
     virtual void deactivate_non_ip_context();
@@ -128,6 +135,8 @@ private:
     FileHandle *_fh;
     rtos::Semaphore _semaphore;
     rtos::Semaphore _cp_opt_semaphore;
+    nsapi_connection_timeline_t _timeline;
+    uint64_t _connect_time;
 
 protected:
     // flag indicating if CP was requested to be setup
@@ -174,13 +174,24 @@ static const char gsm_to_ascii[] = {
 
 const int GSM_TO_ASCII_TABLE_SIZE = sizeof(gsm_to_ascii) / sizeof(gsm_to_ascii[0]);
 
+// Initial size of the message pool, doubled when the storage holds more messages. Must be a power of two.
+#ifndef SMS_INFO_POOL_SIZE
+#define SMS_INFO_POOL_SIZE 8
+#endif
+
+const int SMS_MAX_CONCATENATED_PARTS = 50;
+
 AT_CellularSMS::AT_CellularSMS(ATHandler &at) : AT_CellularBase(at), _cb(0), _mode(CellularSMSMmodeText),
-    _use_8bit_encoding(false), _sim_wait_time(0), _sms_message_ref_number(1), _sms_info(NULL)
+    _use_8bit_encoding(false), _sim_wait_time(0), _sms_message_ref_number(1), _sms_info(NULL), _sms_info_count(0),
+    _sms_info_size(0), _sms_ref_table(NULL), _pdu(NULL), _pdu_size(0)
 {
 }
 
 AT_CellularSMS::~AT_CellularSMS()
 {
+    delete [] _sms_info;
+    delete [] _sms_ref_table;
+    delete [] _pdu;
 }
 
 void AT_CellularSMS::cmt_urc()
@@ -662,8 +673,7 @@ nsapi_size_or_error_t AT_CellularSMS::read_sms(sms_info_t *sms, char *buf, char
                     msg_len = _at.read_int();
                     if (msg_len > 0) {
                         pduSize = msg_len * 2 + 20; // *2 as it's hex encoded and +20 as service center number is not included in size given by CMGR
-                        pdu = new char[pduSize];
-                        memset(pdu, 0, pduSize);
+                        pdu = get_pdu_buffer(pduSize);
                         if (!pdu) {
                             _at.resp_stop();
                             return NSAPI_ERROR_NO_MEMORY;
@@ -674,12 +684,10 @@ nsapi_size_or_error_t AT_CellularSMS::read_sms(sms_info_t *sms, char *buf, char
                             if (msg_len >= 0) { // we need to allow zero length messages
                                 index += msg_len;
                             } else {
-                                delete [] pdu;
                                 _at.resp_stop();
                                 return -1;
                             }
                         }
-                        delete [] pdu;
                     }
                 }
             }
@@ -722,7 +730,7 @@ nsapi_size_or_error_t AT_CellularSMS::get_sms(char *buf, uint16_t len, char *pho
                 if (buf_size) {
                     *buf_size = info->msg_size;
                 }
-                free_linked_list();
+                free_sms_info();
                 _at.unlock();
                 return NSAPI_ERROR_PARAMETER;
             }
@@ -745,7 +753,7 @@ nsapi_size_or_error_t AT_CellularSMS::get_sms(char *buf, uint16_t len, char *pho
         }
     }
 
-    free_linked_list();
+    free_sms_info();
 
     _at.unlock();
 
@@ -967,62 +975,113 @@ nsapi_size_or_error_t AT_CellularSMS::read_pdu_payload(const char *pdu, int msg_
     }
 }
 
-void AT_CellularSMS::free_linked_list()
+void AT_CellularSMS::free_sms_info()
+{
+    // pool is kept for the next listing
+    _sms_info_count = 0;
+}
+
+char *AT_CellularSMS::get_pdu_buffer(int size)
+{
+    if (size > _pdu_size) {
+        delete [] _pdu;
+        _pdu = new char[size];
+        if (!_pdu) {
+            _pdu_size = 0;
+            return NULL;
+        }
+        _pdu_size = size;
+    }
+    memset(_pdu, 0, size);
+    return _pdu;
+}
+
+// returns the next free item of the pool, it's taken in use by add_info()
+AT_CellularSMS::sms_info_t *AT_CellularSMS::alloc_info()
+{
+    if (_sms_info_count == _sms_info_size) {
+        uint16_t size = _sms_info_size ? _sms_info_size * 2 : SMS_INFO_POOL_SIZE;
+        sms_info_t *pool = new sms_info_t[size];
+        uint16_t *table = new uint16_t[size * 2];
+        if (!pool || !table) {
+            delete [] pool;
+            delete [] table;
+            return NULL;
+        }
+        for (int i = 0; i < _sms_info_count; i++) {
+            pool[i] = _sms_info[i];
+        }
+        delete [] _sms_info;
+        delete [] _sms_ref_table;
+        _sms_info = pool;
+        _sms_ref_table = table;
+        _sms_info_size = size;
+
+        memset(_sms_ref_table, 0, size * 2 * sizeof(uint16_t));
+        for (int i = 0; i < _sms_info_count; i++) {
+            if (_sms_info[i].parts > _sms_info[i].parts_added) {
+                add_ref(i);
+            }
+        }
+    }
+
+    if (_sms_info_count == 0) {
+        memset(_sms_ref_table, 0, _sms_info_size * 2 * sizeof(uint16_t));
+    }
+
+    sms_info_t *info = &_sms_info[_sms_info_count];
+    *info = sms_info_t();
+    return info;
+}
+
+void AT_CellularSMS::add_ref(uint16_t pool_index)
 {
-    sms_info_t *info = _sms_info;
-    sms_info_t *old;
-    while (info) {
-        old = info;
-        info = info->next_info;
-        delete old;
+    uint16_t mask = _sms_info_size * 2 - 1;
+    uint16_t i = _sms_info[pool_index].msg_ref_number & mask;
+    // table is twice the pool size so there is always a free slot
+    while (_sms_ref_table[i]) {
+        i = (i + 1) & mask;
     }
-    _sms_info = NULL;
+    _sms_ref_table[i] = pool_index + 1;
 }
 
 void AT_CellularSMS::add_info(sms_info_t *info, int index, int part_number)
 {
-    // check for same message reference id. If found, update it and delete the given info.
-    // if NOT found then add to the end of the list.
+    // check for same message reference id. If found, update it and leave the given info unused.
+    // if NOT found then take the given info in use from the pool.
 
-    if (!_sms_info) {
-        info->msg_index[part_number - 1] = index; // part numbering starts from 1 so -1 to put to right index
-        _sms_info = info;
+    if (part_number < 1 || part_number > SMS_MAX_CONCATENATED_PARTS) {
+        tr_warn("Invalid concatenated sms part number: %d", part_number);
         return;
     }
-    sms_info_t *current = _sms_info;
-    sms_info_t *prev = NULL;
-    bool found_msg = false;
-    while (current) {
-        prev = current;
-        // sms messages can have same reference number so additional checks are needed.
-        // TODO: should we include phone number also?
-        if (current->msg_ref_number == info->msg_ref_number && current->parts > current->parts_added &&
-                info->parts > info->parts_added) {
-            // multipart sms, update msg size and index
-            current->msg_size += info->msg_size;
-            current->msg_index[part_number - 1] = index; // part numbering starts from 1 so -1 to put to right index
-            current->parts_added++;
-            // update oldest part as date
-            if (compare_time_strings(info->date, current->date) == -1) {
-                strcpy(current->date, info->date);
+
+    if (info->parts > info->parts_added) {
+        uint16_t mask = _sms_info_size * 2 - 1;
+        for (uint16_t i = info->msg_ref_number & mask; _sms_ref_table[i]; i = (i + 1) & mask) {
+            sms_info_t *current = &_sms_info[_sms_ref_table[i] - 1];
+            // sms messages can have same reference number so additional checks are needed.
+            // TODO: should we include phone number also?
+            if (current->msg_ref_number == info->msg_ref_number && current->parts > current->parts_added) {
+                // multipart sms, update msg size and index
+                current->msg_size += info->msg_size;
+                current->msg_index[part_number - 1] = index; // part numbering starts from 1 so -1 to put to right index
+                current->parts_added++;
+                // update oldest part as date
+                if (compare_time_strings(info->date, current->date) == -1) {
+                    strcpy(current->date, info->date);
+                }
+                return;
             }
-            found_msg = true;
-            break;
         }
-        current = current->next_info;
+        add_ref(_sms_info_count);
     }
 
-    if (found_msg) {
-        // info was added to existing item in linked list, must be deleted
-        delete info;
-    } else {
-        // message not found, add to linked list
-        info->msg_index[part_number - 1] = index;
-        prev->next_info = info;
-    }
+    // message not found, add to the pool
+    info->msg_index[part_number - 1] = index;
+    _sms_info_count++;
 }
 
-// reads all the messages to the linked list AT_CellularSMS::_sms_info
+// reads all the messages to the pool AT_CellularSMS::_sms_info with one +CMGL
 nsapi_error_t AT_CellularSMS::list_messages()
 {
     // TODO: NOTE:  If the selected <mem1> can contain different types of SMs (e.g. SMS-DELIVERs, SMS-SUBMITs, SMS-STATUS-REPORTs and SMS-COMMANDs),
@@ -1035,6 +1094,8 @@ nsapi_error_t AT_CellularSMS::list_messages()
     }
     _at.cmd_stop();
 
+    free_sms_info();
+
     sms_info_t *info = NULL;
     // init for 1 so that in text mode we will add to the correct place without any additional logic in addInfo() in text mode
     int part_number = 1;
@@ -1044,7 +1105,11 @@ nsapi_error_t AT_CellularSMS::list_messages()
 
     _at.resp_start("+CMGL:");
     while (_at.info_resp()) {
-        info = new sms_info_t();
+        info = alloc_info();
+        if (!info) {
+            _at.resp_stop();
+            return NSAPI_ERROR_NO_MEMORY;
+        }
         if (_mode == CellularSMSMmodePDU) {
             //+CMGL: <index>,<stat>,[<alpha>],<length><CR><LF><pdu>[<CR><LF>
             // +CMGL:<index>,<stat>,[<alpha>],<length><CR><LF><pdu>
@@ -1053,8 +1118,11 @@ nsapi_error_t AT_CellularSMS::list_messages()
             _at.skip_param(2); // <stat>,[<alpha>]
             length = _at.read_int();
             length = length * 2 + 20; // *2 as it's hex encoded and +20 as service center number is not included in size given by CMGL
-            pdu = new char[length];
-            memset(pdu, 0, length);
+            pdu = get_pdu_buffer(length);
+            if (!pdu) {
+                _at.resp_stop();
+                return NSAPI_ERROR_NO_MEMORY;
+            }
             _at.read_string(pdu, length, true);
             if (_at.get_last_error() == NSAPI_ERROR_OK) {
                 info->msg_size = get_data_from_pdu(pdu, info, &part_number);
@@ -1063,18 +1131,22 @@ nsapi_error_t AT_CellularSMS::list_messages()
             // +CMGL: <index>,<stat>,<oa/da>,[<alpha>],[<scts>][,<tooa/toda>,<length>]<CR><LF><data>[<CR><LF>
             // +CMGL: <index>,<stat>,<da/oa>,[<alpha>],[<scts>][,<tooa/toda>,<length>]<CR><LF><data>[...]]
             index = _at.read_int();
+            _at.skip_param(3); // <stat>,<oa/da>,[<alpha>]
+            // time stamp contains a comma so it's read in two parts, if it's missing it's read later with +CMGR
+            int len = _at.read_string(info->date, SMS_MAX_TIME_STAMP_SIZE);
+            if (len > 0 && len < (SMS_MAX_TIME_STAMP_SIZE - 2)) {
+                info->date[len++] = ',';
+                _at.read_string(&info->date[len], SMS_MAX_TIME_STAMP_SIZE - len);
+            } else {
+                info->date[0] = '\0';
+            }
             (void)_at.consume_to_stop_tag(); // consume until <CR><LF>
             (void)_at.consume_to_stop_tag(); // consume until <CR><LF>
         }
 
         if (index > 0) {
             add_info(info, index, part_number);
-        } else {
-            delete info;
-            info = NULL;
         }
-        delete [] pdu;
-        pdu = NULL;
     }
 
 
@@ -1093,15 +1165,15 @@ AT_CellularSMS::sms_info_t *AT_CellularSMS::get_oldest_sms_index()
      * 3. Find other than first part first and it was received first
      * 4. Find other than first part first and it was NOT received first -> older timestamp might exist in some other part
      *
-     * So must take all message to a linked list and loop that for the oldest
+     * So must take all messages to the pool and loop that for the oldest
      */
 
-    // if text mode we need to read sms with +CMGR because time stamp is optional while looping with +CMGL
+    // in text mode time stamp is optional while looping with +CMGL, read sms with +CMGR only if it was missing
     sms_info_t *retVal = NULL;
-    sms_info_t *current = _sms_info;
     nsapi_size_or_error_t err = 0;
-    while (current) {
-        if (_mode == CellularSMSMmodeText) {
+    for (int i = 0; i < _sms_info_count; i++) {
+        sms_info_t *current = &_sms_info[i];
+        if (_mode == CellularSMSMmodeText && current->date[0] == '\0') {
             wait_ms(_sim_wait_time);
             err = read_sms_from_index(current->msg_index[0], NULL, 0, NULL, current->date);
             if (err != 0) {
@@ -1115,7 +1187,6 @@ AT_CellularSMS::sms_info_t *AT_CellularSMS::get_oldest_sms_index()
             // found older sms, update return value to oldest
             retVal = current;
         }
-        current = current->next_info;
     }
 
     return retVal;
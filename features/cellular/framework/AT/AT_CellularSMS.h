@@ -67,8 +67,7 @@ private:
         uint8_t parts;
         uint8_t parts_added;
         uint16_t msg_ref_number;
-        struct sms_info_t *next_info;
-        sms_info_t() : msg_size(0), parts(1), parts_added(1), msg_ref_number(0), next_info(0) {};
+        sms_info_t() : msg_size(0), parts(1), parts_added(1), msg_ref_number(0) {};
     };
 
     // application callback function for received sms
@@ -77,7 +76,17 @@ private:
     bool _use_8bit_encoding;
     uint32_t _sim_wait_time;
     uint16_t _sms_message_ref_number;
+    // Messages listed from the storage. The pool is kept between reads and only grows
+    // when the storage holds more messages than before.
     sms_info_t *_sms_info;
+    uint16_t _sms_info_count;
+    uint16_t _sms_info_size;
+    // Open addressing table of the incomplete concatenated messages by reference number,
+    // holds pool index + 1 and is twice the pool size
+    uint16_t *_sms_ref_table;
+    // Buffer for a hex encoded pdu, reused for all the messages
+    char *_pdu;
+    int _pdu_size;
 
     // SMS urc's
     void cmt_urc();
@@ -125,8 +134,11 @@ private:
      */
     nsapi_error_t list_messages();
     int read_sms_params(char *, char *);
-    void free_linked_list();
+    void free_sms_info();
+    sms_info_t *alloc_info();
     void add_info(sms_info_t *info, int index, int part_number);
+    void add_ref(uint16_t pool_index);
+    char *get_pdu_buffer(int size);
     int read_udh_from_pdu(const char *pdu, sms_info_t *info, int &part_number, int &padding_bits);
     nsapi_size_or_error_t get_data_from_pdu(const char *pdu, sms_info_t *info, int *part_number,
                                             char *phone_number = NULL, char *msg = NULL);
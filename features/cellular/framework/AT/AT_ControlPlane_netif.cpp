@@ -4,7 +4,7 @@
 namespace mbed {
 
 AT_ControlPlane_netif::AT_ControlPlane_netif(ATHandler &at, int cid) : AT_CellularBase(at),
-    _cid(cid), _cb(NULL), _data(NULL), _recv_len(0)
+    _cid(cid), _cb(NULL), _data(NULL), _recv_len(0), _recv_dest(NULL), _recv_dest_size(0), _recv_dest_len(0)
 {
     _at.set_urc_handler("+CRTDCP:", mbed::Callback<void()>(this, &AT_ControlPlane_netif::urc_cp_recv));
 }
@@ -18,14 +18,31 @@ void AT_ControlPlane_netif::urc_cp_recv()
     _at.lock();
     int cid = _at.read_int();
     int cpdata_length = _at.read_int();
-    int read_len = _at.read_string(_recv_buffer, sizeof(_recv_buffer));
 
-    _at.unlock();
+    // read straight to the buffer of a waiting recv() if the data and the terminating null fit in it
+    bool direct = _recv_dest && !_recv_dest_len && !_recv_len && cpdata_length >= 0 &&
+                  (size_t)cpdata_length < _recv_dest_size;
+    int read_len;
+    if (direct) {
+        read_len = _at.read_string(_recv_dest, _recv_dest_size);
+    } else {
+        read_len = _at.read_string(_recv_buffer, sizeof(_recv_buffer));
+    }
 
     // cid not expected to be different because: one context - one file handle
     // so this file handle cannot get urc from different context
-    if (read_len > 0 && read_len == cpdata_length && cid == _cid) {
-        _recv_len = read_len;
+    bool received = read_len > 0 && read_len == cpdata_length && cid == _cid;
+    if (received) {
+        if (direct) {
+            _recv_dest_len = read_len;
+        } else {
+            _recv_len = read_len;
+        }
+    }
+
+    _at.unlock();
+
+    if (received) {
         data_received();
     }
 }
@@ -37,32 +54,74 @@ nsapi_size_or_error_t AT_ControlPlane_netif::send(const void *cpdata, nsapi_size
     _at.cmd_start("AT+CSODCP=");
     _at.write_int(_cid);
     _at.write_int(cpdata_length);
-    _at.write_bytes((uint8_t *)cpdata, cpdata_length);
+    // payload goes from the caller's buffer straight to the file handle
+    _at.write_bytes((const uint8_t *)",\"", 2);
+    _at.write_bytes((const uint8_t *)cpdata, cpdata_length);
+    _at.write_bytes((const uint8_t *)"\"", 1);
+    _at.cmd_stop_read_resp();
 
-    return _at.unlock_return_error();
+    nsapi_error_t err = _at.unlock_return_error();
+    return (err == NSAPI_ERROR_OK) ? (nsapi_size_or_error_t)cpdata_length : err;
 }
 
 nsapi_size_or_error_t AT_ControlPlane_netif::recv(void *cpdata, nsapi_size_t cpdata_length)
 {
-    // If no data received through CRTDCP URC
-    if (!_recv_len) {
-        return NSAPI_ERROR_WOULD_BLOCK;
-    }
+    nsapi_size_or_error_t ret = NSAPI_ERROR_WOULD_BLOCK;
 
-    // If too small buffer for data
-    if (_recv_len > cpdata_length) {
-        return NSAPI_ERROR_DEVICE_ERROR;
+    _at.lock();
+    if (_recv_dest_len) {
+        // data was read straight to the buffer of a waiting recv(), if it's another
+        // caller's buffer that caller will return it
+        if (_recv_dest == cpdata) {
+            ret = _recv_dest_len;
+            _recv_dest = NULL;
+            _recv_dest_len = 0;
+        }
+    } else if (_recv_len) {
+        if (_recv_len > cpdata_length) {
+            // If too small buffer for data
+            ret = NSAPI_ERROR_DEVICE_ERROR;
+        } else {
+            memcpy(cpdata, _recv_buffer, _recv_len);
+            ret = _recv_len;
+            _recv_len = 0;
+        }
+    } else {
+        // No data received through CRTDCP URC, receive the next data to the caller's buffer
+        _recv_dest = (char *)cpdata;
+        _recv_dest_size = cpdata_length;
     }
+    _at.unlock();
 
-    memcpy(cpdata, _recv_buffer, _recv_len);
+    return ret;
+}
 
-    return _recv_len = 0;
+void AT_ControlPlane_netif::recv_cancel(void *cpdata)
+{
+    _at.lock();
+    if (_recv_dest == cpdata) {
+        // keep data that arrived after the caller stopped waiting
+        if (_recv_dest_len && !_recv_len) {
+            memcpy(_recv_buffer, _recv_dest, _recv_dest_len);
+            _recv_len = _recv_dest_len;
+        }
+        _recv_dest = NULL;
+        _recv_dest_len = 0;
+    }
+    _at.unlock();
 }
 
 void AT_ControlPlane_netif::attach(void (*callback)(void *), void *data)
 {
+    _at.lock();
     _cb = callback;
     _data = data;
+    if (!callback) {
+        // socket was closed, don't write to its buffers
+        _recv_dest = NULL;
+        _recv_dest_len = 0;
+    }
+    _at.unlock();
 }
 
 void AT_ControlPlane_netif::data_received()
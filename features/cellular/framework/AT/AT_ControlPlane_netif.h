@@ -24,6 +24,7 @@ protected:
      */
     virtual nsapi_size_or_error_t recv(void *cpdata, nsapi_size_t cpdata_length);
 
+    virtual void recv_cancel(void *cpdata);
     virtual void data_received();
     virtual void attach(void (*callback)(void *), void *data);
 
@@ -35,6 +36,10 @@ private:
     void *_data;
     char _recv_buffer[MAX_CP_DATA_RECV_LEN];
     size_t _recv_len;
+    // Buffer of a waiting recv(), the next data is read straight to it instead of _recv_buffer
+    char *_recv_dest;
+    size_t _recv_dest_size;
+    size_t _recv_dest_len;
     // Called on receiving URC: +CRTDCP
     void urc_cp_recv();
 };
@@ -20,6 +20,10 @@
 #include "CellularLog.h"
 #include "Thread.h"
 #include "UARTSerial.h"
+#if MBED_CONF_CELLULAR_FAST_RECONNECT
+#include "kvstore_global_api.h"
+#include "mbed_error.h"
+#endif
 
 #ifndef MBED_TRACE_MAX_LEVEL
 #define MBED_TRACE_MAX_LEVEL TRACE_LEVEL_INFO
@@ -44,6 +48,27 @@ const int DEVICE_READY = 0x04;
 
 namespace mbed {
 
+#if MBED_CONF_CELLULAR_FAST_RECONNECT
+// Last known good network state, saved in KVStore once attached
+#define NETWORK_STATE_KEY       "/kv/cellular_stm"
+#define NETWORK_STATE_VERSION   1
+
+struct network_state_t {
+    uint8_t version;
+    // operator given with set_plmn(), empty for automatic registration
+    char plmn[MAX_OPERATOR_NAME_SHORT + 1];
+};
+
+static void make_network_state(network_state_t &state, const char *plmn)
+{
+    memset(&state, 0, sizeof(state));
+    state.version = NETWORK_STATE_VERSION;
+    if (plmn) {
+        strncpy(state.plmn, plmn, sizeof(state.plmn) - 1);
+    }
+}
+#endif // MBED_CONF_CELLULAR_FAST_RECONNECT
+
 CellularStateMachine::CellularStateMachine(CellularDevice &device, events::EventQueue &queue) :
     _cellularDevice(device), _state(STATE_INIT), _next_state(_state), _target_state(_state),
     _event_status_cb(0), _network(0), _queue(queue), _queue_thread(0), _sim_pin(0),
@@ -233,10 +258,66 @@ bool CellularStateMachine::get_network_registration(CellularNetwork::Registratio
     return true;
 }
 
+bool CellularStateMachine::fast_reconnect()
+{
+#if MBED_CONF_CELLULAR_FAST_RECONNECT
+    network_state_t saved;
+    network_state_t wanted;
+    size_t size = 0;
+    if (kv_get(NETWORK_STATE_KEY, &saved, sizeof(saved), &size) != MBED_SUCCESS || size != sizeof(saved)) {
+        return false;
+    }
+    make_network_state(wanted, _plmn);
+    if (memcmp(&saved, &wanted, sizeof(saved)) != 0) {
+        return false;
+    }
+
+    // Registration is lost when the modem restarts, so if the modem is still registered it also kept
+    // the SIM unlocked and the registration URCs enabled, and the SIM state can be skipped.
+    if (!is_registered()) {
+        tr_info("Not registered anymore, full reconnect");
+        return false;
+    }
+
+    tr_info("Still registered, skip SIM setup");
+    return true;
+#else
+    return false;
+#endif // MBED_CONF_CELLULAR_FAST_RECONNECT
+}
+
+void CellularStateMachine::save_network_state()
+{
+#if MBED_CONF_CELLULAR_FAST_RECONNECT
+    network_state_t state;
+    network_state_t saved;
+    size_t size = 0;
+    make_network_state(state, _plmn);
+    // don't wear the storage rewriting the same state on every connect
+    if (kv_get(NETWORK_STATE_KEY, &saved, sizeof(saved), &size) == MBED_SUCCESS && size == sizeof(saved) &&
+            memcmp(&saved, &state, sizeof(saved)) == 0) {
+        return;
+    }
+    if (kv_set(NETWORK_STATE_KEY, &state, sizeof(state), 0) != MBED_SUCCESS) {
+        tr_warn("Failed to save network state");
+    }
+#endif // MBED_CONF_CELLULAR_FAST_RECONNECT
+}
+
+void CellularStateMachine::clear_network_state()
+{
+#if MBED_CONF_CELLULAR_FAST_RECONNECT
+    (void)kv_remove(NETWORK_STATE_KEY);
+#endif // MBED_CONF_CELLULAR_FAST_RECONNECT
+}
+
 void CellularStateMachine::report_failure(const char *msg)
 {
     tr_error("CellularStateMachine failure: %s", msg);
 
+    // next connect must go through the full sequence
+    clear_network_state();
+
     _event_id = -1;
     if (_event_status_cb) {
         _cb_data.final_try = true;
@@ -392,7 +473,11 @@ void CellularStateMachine::state_device_ready()
         if (_cb_data.error == NSAPI_ERROR_OK) {
             if (device_ready()) {
                 _status = 0;
-                enter_to_state(STATE_SIM_PIN);
+                if (fast_reconnect()) {
+                    enter_to_state(_plmn ? STATE_MANUAL_REGISTERING_NETWORK : STATE_REGISTERING_NETWORK);
+                } else {
+                    enter_to_state(STATE_SIM_PIN);
+                }
             }
         }
     }
@@ -493,6 +578,7 @@ void CellularStateMachine::state_attaching()
         _cb_data.error = _network->set_attach();
     }
     if (_cb_data.error == NSAPI_ERROR_OK) {
+        save_network_state();
         if (_event_status_cb) {
             _cb_data.status_data = CellularNetwork::Attached;
             _event_status_cb(_current_event, (intptr_t)&_cb_data);
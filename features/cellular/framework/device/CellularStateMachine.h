@@ -139,6 +139,9 @@ private:
     bool get_network_registration(CellularNetwork::RegistrationType type, CellularNetwork::RegistrationStatus &status, bool &is_registered);
     bool is_registered();
     bool device_ready();
+    bool fast_reconnect();
+    void save_network_state();
+    void clear_network_state();
 
     // state functions to keep state machine simple
     void state_init();
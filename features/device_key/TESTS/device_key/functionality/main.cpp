@@ -336,6 +336,54 @@ void generate_derived_key_consistency_16_byte_key_test()
     }
 }
 
+/*
+ * Test that derived keys are the same whether they come from the cache or not.
+ */
+void generate_derived_key_cache_test()
+{
+    unsigned char output1[DEVICE_KEY_32BYTE];
+    unsigned char output2[DEVICE_KEY_32BYTE];
+    unsigned char output3[DEVICE_KEY_32BYTE];
+    unsigned char salt1[] = "AUTHkey";
+    unsigned char salt2[] = "ENCkey";
+    DeviceKey &devkey = DeviceKey::get_instance();
+    KVMap &kv_map = KVMap::get_instance();
+    KVStore *inner_store = kv_map.get_internal_kv_instance(NULL);
+    TEST_ASSERT_NOT_EQUAL(NULL, inner_store);
+
+    int ret = inner_store->reset();
+    TEST_ASSERT_EQUAL_INT(DEVICEKEY_SUCCESS, ret);
+    devkey.clear_derived_key_cache();
+
+    ret = inject_dummy_rot_key();
+    TEST_ASSERT_EQUAL_INT(DEVICEKEY_SUCCESS, ret);
+
+    ret = devkey.generate_derived_key(salt1, sizeof(salt1), output1, DEVICE_KEY_16BYTE);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+
+    ret = devkey.generate_derived_key(salt2, sizeof(salt2), output2, DEVICE_KEY_16BYTE);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+    TEST_ASSERT_TRUE(memcmp(output1, output2, DEVICE_KEY_16BYTE) != 0);
+
+    // Same salt, other key type
+    ret = devkey.generate_derived_key(salt1, sizeof(salt1), output3, DEVICE_KEY_32BYTE);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+    TEST_ASSERT_TRUE(memcmp(output1, output3, DEVICE_KEY_16BYTE) != 0);
+
+    ret = devkey.generate_derived_key(salt1, sizeof(salt1), output2, DEVICE_KEY_16BYTE);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(output1, output2, DEVICE_KEY_16BYTE);
+
+    devkey.clear_derived_key_cache();
+    ret = devkey.generate_derived_key(salt1, sizeof(salt1), output2, DEVICE_KEY_16BYTE);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(output1, output2, DEVICE_KEY_16BYTE);
+
+    ret = devkey.generate_derived_key(salt1, sizeof(salt1), output2, DEVICE_KEY_32BYTE);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(output3, output2, DEVICE_KEY_32BYTE);
+}
+
 /*
  * Test the consistency of derived 32 byte key result.
  */
@@ -479,6 +527,7 @@ Case cases[] = {
     Case("Device Key - inject value several times",          device_inject_root_of_trust_several_times_test,    greentea_failure_handler),
     Case("Device Key - derived key consistency 16 byte key", generate_derived_key_consistency_16_byte_key_test, greentea_failure_handler),
     Case("Device Key - derived key consistency 32 byte key", generate_derived_key_consistency_32_byte_key_test, greentea_failure_handler),
+    Case("Device Key - derived key cache",                   generate_derived_key_cache_test,                   greentea_failure_handler),
     Case("Device Key - derived key key type 16",             generate_derived_key_key_type_16_test,             greentea_failure_handler),
     Case("Device Key - derived key key type 32",             generate_derived_key_key_type_32_test,             greentea_failure_handler),
     Case("Device Key - derived key wrong key type",          generate_derived_key_wrong_key_type_test,          greentea_failure_handler)
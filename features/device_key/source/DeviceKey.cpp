@@ -20,6 +20,7 @@
 #include "mbedtls/config.h"
 #include "mbedtls/cmac.h"
 #include "mbedtls/platform.h"
+#include "mbedtls/platform_util.h"
 #include "KVStore.h"
 #include "TDBStore.h"
 #include "KVMap.h"
@@ -60,6 +61,10 @@ namespace mbed {
 
 DeviceKey::DeviceKey()
 {
+#if MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_ENTRIES
+    _cache_count = 0;
+    _cache_clock = 0;
+#endif
 
     int ret = kv_init_storage_config();
     if (ret != MBED_SUCCESS) {
@@ -76,6 +81,7 @@ DeviceKey::DeviceKey()
 
 DeviceKey::~DeviceKey()
 {
+    clear_derived_key_cache();
 #if defined(MBEDTLS_PLATFORM_C)
     mbedtls_platform_teardown(NULL);
 #endif /* MBEDTLS_PLATFORM_C */
@@ -94,6 +100,12 @@ int DeviceKey::generate_derived_key(const unsigned char *salt, size_t isalt_size
 
     actual_size = DEVICE_KEY_16BYTE != ikey_type ? DEVICE_KEY_32BYTE : DEVICE_KEY_16BYTE;
 
+#if MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_ENTRIES
+    if (cache_get(salt, isalt_size, output, ikey_type)) {
+        return DEVICEKEY_SUCCESS;
+    }
+#endif
+
     //First try to read the key from KVStore
     int ret = read_key_from_kvstore(key_buff, actual_size);
     if (DEVICEKEY_SUCCESS != ret && DEVICEKEY_NOT_FOUND != ret) {
@@ -114,13 +126,85 @@ int DeviceKey::generate_derived_key(const unsigned char *salt, size_t isalt_size
     }
 
     ret = get_derived_key(key_buff, actual_size, salt, isalt_size, output, ikey_type);
+    mbedtls_platform_zeroize(key_buff, sizeof(key_buff));
+
+#if MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_ENTRIES
+    if (DEVICEKEY_SUCCESS == ret) {
+        cache_add(salt, isalt_size, output, ikey_type);
+    }
+#endif
+
     return ret;
 }
 
 int DeviceKey::device_inject_root_of_trust(uint32_t *value, size_t isize)
 {
-    return write_key_to_kvstore(value, isize);
+    int ret = write_key_to_kvstore(value, isize);
+    if (DEVICEKEY_SUCCESS == ret) {
+        clear_derived_key_cache();
+    }
+    return ret;
+}
+
+void DeviceKey::clear_derived_key_cache()
+{
+#if MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_ENTRIES
+    _mutex.lock();
+    mbedtls_platform_zeroize(_cache, sizeof(_cache));
+    _cache_count = 0;
+    _mutex.unlock();
+#endif
+}
+
+#if MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_ENTRIES
+bool DeviceKey::cache_get(const unsigned char *isalt, size_t isalt_size, unsigned char *output, uint16_t ikey_type)
+{
+    bool found = false;
+
+    _mutex.lock();
+    for (size_t i = 0; i < _cache_count; i++) {
+        derived_key_t &entry = _cache[i];
+        if (entry.key_type == ikey_type && entry.salt_size == isalt_size &&
+                memcmp(entry.salt, isalt, isalt_size) == 0) {
+            memcpy(output, entry.key, ikey_type);
+            entry.last_use = ++_cache_clock;
+            found = true;
+            break;
+        }
+    }
+    _mutex.unlock();
+
+    return found;
+}
+
+void DeviceKey::cache_add(const unsigned char *isalt, size_t isalt_size, const unsigned char *key, uint16_t ikey_type)
+{
+    if (isalt_size > MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_SALT_SIZE) {
+        return;
+    }
+
+    _mutex.lock();
+    derived_key_t *entry;
+    if (_cache_count < MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_ENTRIES) {
+        entry = &_cache[_cache_count++];
+    } else {
+        entry = &_cache[0];
+        for (size_t i = 1; i < _cache_count; i++) {
+            if ((int32_t)(_cache[i].last_use - entry->last_use) < 0) {
+                entry = &_cache[i];
+            }
+        }
+    }
+
+    mbedtls_platform_zeroize(entry, sizeof(*entry));
+    memcpy(entry->salt, isalt, isalt_size);
+    memcpy(entry->key, key, ikey_type);
+    entry->salt_size = isalt_size;
+    entry->key_type = ikey_type;
+    entry->last_use = ++_cache_clock;
+    _mutex.unlock();
 }
+#endif
 
 int DeviceKey::write_key_to_kvstore(uint32_t *input, size_t isize)
 {
@@ -19,6 +19,7 @@
 #include "stddef.h"
 #include "stdint.h"
 #include "platform/NonCopyable.h"
+#include "platform/PlatformMutex.h"
 
 #define DEVICEKEY_ENABLED 1
 
@@ -82,6 +83,11 @@ public:
     ~DeviceKey();
 
     /** Derive a new key based on the salt string.
+     *
+     * If device-key.derived-key-cache-entries is set, derived keys are kept in RAM
+     * and deriving again with the same salt and key type returns the kept key,
+     * without reading the root of trust nor running the KDF.
+     *
      * @param isalt Input buffer used to create the new key. Same input always generates the same key
      * @param isalt_size Size of the data in salt buffer.
      * @param output Buffer to receive the derived key. Size must be 16 bytes or 32 bytes
@@ -99,6 +105,13 @@ public:
      */
     int device_inject_root_of_trust(uint32_t *value, size_t isize);
 
+    /** Wipe the derived keys kept in RAM.
+     *
+     * Call it when the root of trust is erased other than through this class,
+     * for example by resetting the internal KVStore.
+     */
+    void clear_derived_key_cache();
+
 private:
     // Private constructor, as class is a singleton
     DeviceKey();
@@ -142,6 +155,28 @@ private:
      */
     int generate_key_by_random(uint32_t *output, size_t size);
 
+#if MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_ENTRIES
+    struct derived_key_t {
+        uint8_t salt[MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_SALT_SIZE];
+        uint8_t key[DEVICE_KEY_32BYTE];
+        uint32_t last_use;
+        uint16_t salt_size;
+        uint16_t key_type;
+    };
+
+    /** Copy a derived key from the cache, making it the most recently used
+     * @return true if the key was found
+     */
+    bool cache_get(const unsigned char *isalt, size_t isalt_size, unsigned char *output, uint16_t ikey_type);
+
+    /** Add a derived key to the cache, evicting the least recently used one if full */
+    void cache_add(const unsigned char *isalt, size_t isalt_size, const unsigned char *key, uint16_t ikey_type);
+
+    derived_key_t _cache[MBED_CONF_DEVICE_KEY_DERIVED_KEY_CACHE_ENTRIES];
+    size_t _cache_count;
+    uint32_t _cache_clock;
+    PlatformMutex _mutex;
+#endif
 };
 /** @}*/
 
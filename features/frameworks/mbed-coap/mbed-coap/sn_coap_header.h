@@ -325,6 +325,34 @@ extern sn_coap_hdr_s *sn_coap_parser(struct coap_s *handle, uint16_t packet_data
  */
 extern void sn_coap_parser_release_allocated_coap_msg_mem(struct coap_s *handle, sn_coap_hdr_s *freed_coap_msg_ptr);
 
+/**
+ * \fn sn_coap_hdr_s *sn_coap_parser_in_place(sn_coap_hdr_s *dst_coap_msg_ptr, sn_coap_options_list_s *options_ptr, uint16_t packet_data_len, uint8_t *packet_data_ptr, coap_version_e *coap_version_ptr)
+ *
+ * \brief Parses CoAP message from given Packet data without allocating memory
+ *
+ *        Token, options and payload of the parsed message point into the
+ *        Packet data, which must stay valid as long as the message is used.
+ *        Repeated options such as Uri-Path are joined in place, so the
+ *        Packet data is modified.
+ *
+ *        Note!!! The message must not be released with sn_coap_parser_release_allocated_coap_msg_mem()
+ *
+ * \param *dst_coap_msg_ptr is destination for parsed CoAP message
+ *
+ * \param *options_ptr is storage for parsed options, used if the message has any
+ *
+ * \param packet_data_len is length of given Packet data to be parsed to CoAP message
+ *
+ * \param *packet_data_ptr is source for Packet data to be parsed to CoAP message
+ *
+ * \param *coap_version_ptr is destination for parsed CoAP specification version
+ *
+ * \return Return value is dst_coap_msg_ptr, with coap_status set if parsing failed.\n
+ *         NULL is returned if a given pointer is NULL or Packet data is too short.
+ */
+extern sn_coap_hdr_s *sn_coap_parser_in_place(sn_coap_hdr_s *dst_coap_msg_ptr, sn_coap_options_list_s *options_ptr,
+                                              uint16_t packet_data_len, uint8_t *packet_data_ptr, coap_version_e *coap_version_ptr);
+
 /**
  * \fn int16_t sn_coap_builder(uint8_t *dst_packet_data_ptr, sn_coap_hdr_s *src_coap_msg_ptr)
  *
@@ -370,6 +398,28 @@ extern uint16_t sn_coap_builder_calc_needed_packet_data_size(sn_coap_hdr_s *src_
  */
 extern int16_t sn_coap_builder_2(uint8_t *dst_packet_data_ptr, sn_coap_hdr_s *src_coap_msg_ptr, uint16_t blockwise_payload_size);
 
+/**
+ * \fn int16_t sn_coap_builder_3(uint8_t *dst_packet_data_ptr, uint16_t dst_packet_data_len, sn_coap_hdr_s *src_coap_msg_ptr, uint16_t blockwise_payload_size)
+ *
+ * \brief Builds an outgoing message into a given buffer, such as a network buffer, if it fits.
+ *
+ *        Saves a separate sn_coap_builder_calc_needed_packet_data_size_2() call and allocation.
+ *
+ * \param *dst_packet_data_ptr is pointer to destination buffer for built CoAP packet
+ *
+ * \param dst_packet_data_len is size of destination buffer
+ *
+ * \param *src_coap_msg_ptr is pointer to source structure for building Packet data
+ *
+ * \param blockwise_payload_size Blockwise message maximum payload size
+ *
+ * \return Return value is byte count of built Packet data. In failure cases:\n
+ *          -1 = Failure in given CoAP header structure\n
+ *          -2 = Failure in given pointer (= NULL)\n
+ *          -3 = Destination buffer too small
+ */
+extern int16_t sn_coap_builder_3(uint8_t *dst_packet_data_ptr, uint16_t dst_packet_data_len, sn_coap_hdr_s *src_coap_msg_ptr, uint16_t blockwise_payload_size);
+
 /**
  * \fn uint16_t sn_coap_builder_calc_needed_packet_data_size_2(sn_coap_hdr_s *src_coap_msg_ptr, uint16_t blockwise_payload_size)
  *
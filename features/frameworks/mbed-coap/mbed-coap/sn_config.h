@@ -215,6 +215,20 @@
 #define SN_COAP_DUPLICATION_MAX_TIME_MSGS_STORED    60 /** RESPONSE_TIMEOUT * RESPONSE_RANDOM_FACTOR * (2 ^ MAX_RETRANSMIT - 1) + the expected maximum round trip time **/
 #endif
 
+/**
+ * \def SN_COAP_MSG_ID_HASH_SIZE
+ * \brief Number of hash buckets used to look up re-sending and duplication
+ * detection messages by message ID. Each bucket takes one pointer per list.
+ * By default value is 16.
+ */
+#ifdef MBED_CONF_MBED_CLIENT_SN_COAP_MSG_ID_HASH_SIZE
+#define SN_COAP_MSG_ID_HASH_SIZE MBED_CONF_MBED_CLIENT_SN_COAP_MSG_ID_HASH_SIZE
+#endif
+
+#ifndef SN_COAP_MSG_ID_HASH_SIZE
+#define SN_COAP_MSG_ID_HASH_SIZE                    16
+#endif
+
 /**
  * \def SN_COAP_BLOCKWISE_MAX_TIME_DATA_STORED
  * \brief Maximum time in seconds how long (messages and payload) are be stored for blockwising.
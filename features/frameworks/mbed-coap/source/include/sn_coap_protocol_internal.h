@@ -53,6 +53,7 @@ typedef struct coap_send_msg_ {
     struct coap_s       *coap;              /* CoAP library handle */
     void                *param;             /* Extra parameter that will be passed to TX/RX callback functions */
 
+    struct coap_send_msg_ *hash_next;       /* Next message in the same message ID hash bucket */
     ns_list_link_t      link;
 } coap_send_msg_s;
 
@@ -67,6 +68,7 @@ typedef struct coap_duplication_info_ {
     struct coap_s       *coap;  /* CoAP library handle */
     sn_nsdl_addr_s      *address;
     void                *param;
+    struct coap_duplication_info_ *hash_next; /* Next info in the same message ID hash bucket */
     ns_list_link_t      link;
 } coap_duplication_info_s;
 
@@ -117,11 +119,13 @@ struct coap_s {
     #if ENABLE_RESENDINGS /* If Message resending is not used at all, this part of code will not be compiled */
         coap_send_msg_list_t linked_list_resent_msgs; /* Active resending messages are stored to this Linked list */
         uint16_t count_resent_msgs;
+        coap_send_msg_s *resent_msgs_hash[SN_COAP_MSG_ID_HASH_SIZE]; /* Same messages, indexed by message ID */
     #endif
 
     #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT /* If Message duplication detection is not used at all, this part of code will not be compiled */
         coap_duplication_info_list_t  linked_list_duplication_msgs; /* Messages for duplicated messages detection is stored to this Linked list */
         uint16_t                      count_duplication_msgs;
+        coap_duplication_info_s       *duplication_msgs_hash[SN_COAP_MSG_ID_HASH_SIZE]; /* Same messages, indexed by message ID */
     #endif
 
     #if SN_COAP_BLOCKWISE_ENABLED || SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE /* If Message blockwise is not enabled, this part of code will not be compiled */
@@ -103,6 +103,11 @@ int16_t sn_coap_builder(uint8_t *dst_packet_data_ptr, sn_coap_hdr_s *src_coap_ms
 }
 
 int16_t sn_coap_builder_2(uint8_t *dst_packet_data_ptr, sn_coap_hdr_s *src_coap_msg_ptr, uint16_t blockwise_payload_size)
+{
+    return sn_coap_builder_3(dst_packet_data_ptr, UINT16_MAX, src_coap_msg_ptr, blockwise_payload_size);
+}
+
+int16_t sn_coap_builder_3(uint8_t *dst_packet_data_ptr, uint16_t dst_packet_data_len, sn_coap_hdr_s *src_coap_msg_ptr, uint16_t blockwise_payload_size)
 {
     uint8_t *base_packet_data_ptr = NULL;
 
@@ -118,6 +123,11 @@ int16_t sn_coap_builder_2(uint8_t *dst_packet_data_ptr, sn_coap_hdr_s *src_coap_
         return -1;
     }
 
+    if (dst_byte_count_to_be_built > dst_packet_data_len) {
+        tr_error("sn_coap_builder_3 - destination too small!");
+        return -3;
+    }
+
     memset(dst_packet_data_ptr, 0, dst_byte_count_to_be_built);
 
     /* * * * Store base (= original) destination Packet data pointer for later usage * * * */
@@ -43,7 +43,10 @@
 /* * * * * * * * * * * * * * * * * * * * */
 
 static void     sn_coap_parser_header_parse(uint8_t **packet_data_pptr, sn_coap_hdr_s *dst_coap_msg_ptr, coap_version_e *coap_version_ptr);
-static int8_t   sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **packet_data_pptr, sn_coap_hdr_s *dst_coap_msg_ptr, uint8_t *packet_data_start_ptr, uint16_t packet_len);
+static sn_coap_hdr_s *sn_coap_parser_parse(struct coap_s *handle, sn_coap_hdr_s *dst_coap_msg_ptr, sn_coap_options_list_s *options_ptr, uint16_t packet_data_len, uint8_t *packet_data_ptr, coap_version_e *coap_version_ptr);
+static sn_coap_options_list_s *sn_coap_parser_init_options(sn_coap_options_list_s *options_ptr);
+static uint8_t *sn_coap_parser_store_option(struct coap_s *handle, uint8_t *src_ptr, uint16_t len);
+static int8_t   sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **packet_data_pptr, sn_coap_hdr_s *dst_coap_msg_ptr, sn_coap_options_list_s *options_ptr, uint8_t *packet_data_start_ptr, uint16_t packet_len);
 static int8_t   sn_coap_parser_options_parse_multiple_options(struct coap_s *handle, uint8_t **packet_data_pptr, uint16_t packet_left_len,  uint8_t **dst_pptr, uint16_t *dst_len_ptr, sn_coap_option_numbers_e option, uint16_t option_number_len);
 static int16_t  sn_coap_parser_options_count_needed_memory_multiple_option(uint8_t *packet_data_ptr, uint16_t packet_left_len, sn_coap_option_numbers_e option, uint16_t option_number_len);
 static int8_t   sn_coap_parser_payload_parse(uint16_t packet_data_len, uint8_t *packet_data_start_ptr, uint8_t **packet_data_pptr, sn_coap_hdr_s *dst_coap_msg_ptr);
@@ -99,22 +102,26 @@ sn_coap_options_list_s *sn_coap_parser_alloc_options(struct coap_s *handle, sn_c
         return NULL;
     }
 
+    return sn_coap_parser_init_options(coap_msg_ptr->options_list_ptr);
+}
+
+static sn_coap_options_list_s *sn_coap_parser_init_options(sn_coap_options_list_s *options_ptr)
+{
     /* XXX not technically legal to memset pointers to 0 */
-    memset(coap_msg_ptr->options_list_ptr, 0x00, sizeof(sn_coap_options_list_s));
+    memset(options_ptr, 0x00, sizeof(sn_coap_options_list_s));
 
-    coap_msg_ptr->options_list_ptr->max_age = 0;
-    coap_msg_ptr->options_list_ptr->uri_port = COAP_OPTION_URI_PORT_NONE;
-    coap_msg_ptr->options_list_ptr->observe = COAP_OBSERVE_NONE;
-    coap_msg_ptr->options_list_ptr->accept = COAP_CT_NONE;
-    coap_msg_ptr->options_list_ptr->block2 = COAP_OPTION_BLOCK_NONE;
-    coap_msg_ptr->options_list_ptr->block1 = COAP_OPTION_BLOCK_NONE;
+    options_ptr->max_age = 0;
+    options_ptr->uri_port = COAP_OPTION_URI_PORT_NONE;
+    options_ptr->observe = COAP_OBSERVE_NONE;
+    options_ptr->accept = COAP_CT_NONE;
+    options_ptr->block2 = COAP_OPTION_BLOCK_NONE;
+    options_ptr->block1 = COAP_OPTION_BLOCK_NONE;
 
-    return coap_msg_ptr->options_list_ptr;
+    return options_ptr;
 }
 
 sn_coap_hdr_s *sn_coap_parser(struct coap_s *handle, uint16_t packet_data_len, uint8_t *packet_data_ptr, coap_version_e *coap_version_ptr)
 {
-    uint8_t       *data_temp_ptr                    = packet_data_ptr;
     sn_coap_hdr_s *parsed_and_returned_coap_msg_ptr = NULL;
 
     /* * * * Check given pointer * * * */
@@ -130,11 +137,44 @@ sn_coap_hdr_s *sn_coap_parser(struct coap_s *handle, uint16_t packet_data_len, u
         return NULL;
     }
 
+    return sn_coap_parser_parse(handle, parsed_and_returned_coap_msg_ptr, NULL, packet_data_len, packet_data_ptr, coap_version_ptr);
+}
+
+sn_coap_hdr_s *sn_coap_parser_in_place(sn_coap_hdr_s *dst_coap_msg_ptr, sn_coap_options_list_s *options_ptr,
+                                       uint16_t packet_data_len, uint8_t *packet_data_ptr, coap_version_e *coap_version_ptr)
+{
+    /* * * * Check given pointer * * * */
+    if (dst_coap_msg_ptr == NULL || options_ptr == NULL || packet_data_ptr == NULL || packet_data_len < 4) {
+        return NULL;
+    }
+
+    sn_coap_parser_init_message(dst_coap_msg_ptr);
+
+    return sn_coap_parser_parse(NULL, dst_coap_msg_ptr, options_ptr, packet_data_len, packet_data_ptr, coap_version_ptr);
+}
+
+/**
+ * \fn static sn_coap_hdr_s *sn_coap_parser_parse(struct coap_s *handle, sn_coap_hdr_s *dst_coap_msg_ptr, sn_coap_options_list_s *options_ptr, uint16_t packet_data_len, uint8_t *packet_data_ptr, coap_version_e *coap_version_ptr)
+ *
+ * \brief Parses given Packet data to an initialized CoAP message
+ *
+ * \param *handle is used to allocate token and options, or NULL to point them into Packet data
+ *
+ * \param *options_ptr is storage for options when handle is NULL
+ *
+ * \return Return value is dst_coap_msg_ptr, with coap_status set in failure case
+ */
+static sn_coap_hdr_s *sn_coap_parser_parse(struct coap_s *handle, sn_coap_hdr_s *dst_coap_msg_ptr, sn_coap_options_list_s *options_ptr,
+                                           uint16_t packet_data_len, uint8_t *packet_data_ptr, coap_version_e *coap_version_ptr)
+{
+    uint8_t       *data_temp_ptr                    = packet_data_ptr;
+    sn_coap_hdr_s *parsed_and_returned_coap_msg_ptr = dst_coap_msg_ptr;
+
     /* * * * Header parsing, move pointer over the header...  * * * */
     sn_coap_parser_header_parse(&data_temp_ptr, parsed_and_returned_coap_msg_ptr, coap_version_ptr);
 
     /* * * * Options parsing, move pointer over the options... * * * */
-    if (sn_coap_parser_options_parse(handle, &data_temp_ptr, parsed_and_returned_coap_msg_ptr, packet_data_ptr, packet_data_len) != 0) {
+    if (sn_coap_parser_options_parse(handle, &data_temp_ptr, parsed_and_returned_coap_msg_ptr, options_ptr, packet_data_ptr, packet_data_len) != 0) {
         parsed_and_returned_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_ERROR_IN_HEADER;
         return parsed_and_returned_coap_msg_ptr;
     }
@@ -243,6 +283,29 @@ static uint32_t sn_coap_parser_options_parse_uint(uint8_t **packet_data_pptr, ui
     return value;
 }
 
+/**
+ * \brief Stores an option value, or points to it in Packet data if there is no handle
+ *
+ * \param *src_ptr is option value in Packet data
+ * \param len is length of option value
+ *
+ * \return Return value is pointer to stored value, or NULL if allocation failed
+ */
+static uint8_t *sn_coap_parser_store_option(struct coap_s *handle, uint8_t *src_ptr, uint16_t len)
+{
+    uint8_t *dst_ptr;
+
+    if (handle == NULL) {
+        return src_ptr;
+    }
+
+    dst_ptr = handle->sn_coap_protocol_malloc(len);
+    if (dst_ptr != NULL) {
+        memcpy(dst_ptr, src_ptr, len);
+    }
+    return dst_ptr;
+}
+
 /**
  * \fn static uint8_t sn_coap_parser_options_parse(uint8_t **packet_data_pptr, sn_coap_hdr_s *dst_coap_msg_ptr)
  *
@@ -253,7 +316,7 @@ static uint32_t sn_coap_parser_options_parse_uint(uint8_t **packet_data_pptr, ui
  *
  * \return Return value is 0 in ok case and -1 in failure case
  */
-static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **packet_data_pptr, sn_coap_hdr_s *dst_coap_msg_ptr, uint8_t *packet_data_start_ptr, uint16_t packet_len)
+static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **packet_data_pptr, sn_coap_hdr_s *dst_coap_msg_ptr, sn_coap_options_list_s *options_ptr, uint8_t *packet_data_start_ptr, uint16_t packet_len)
 {
     uint8_t previous_option_number = 0;
     uint8_t i                      = 0;
@@ -269,14 +332,13 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
             return -1;
         }
 
-        dst_coap_msg_ptr->token_ptr = handle->sn_coap_protocol_malloc(dst_coap_msg_ptr->token_len);
+        dst_coap_msg_ptr->token_ptr = sn_coap_parser_store_option(handle, *packet_data_pptr, dst_coap_msg_ptr->token_len);
 
         if (dst_coap_msg_ptr->token_ptr == NULL) {
             tr_error("sn_coap_parser_options_parse - failed to allocate token!");
             return -1;
         }
 
-        memcpy(dst_coap_msg_ptr->token_ptr, *packet_data_pptr, dst_coap_msg_ptr->token_len);
         (*packet_data_pptr) += dst_coap_msg_ptr->token_len;
     }
 
@@ -344,7 +406,11 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
             case COAP_OPTION_ACCEPT:
             case COAP_OPTION_SIZE1:
             case COAP_OPTION_SIZE2:
-                if (sn_coap_parser_alloc_options(handle, dst_coap_msg_ptr) == NULL) {
+                if (handle == NULL) {
+                    if (dst_coap_msg_ptr->options_list_ptr == NULL) {
+                        dst_coap_msg_ptr->options_list_ptr = sn_coap_parser_init_options(options_ptr);
+                    }
+                } else if (sn_coap_parser_alloc_options(handle, dst_coap_msg_ptr) == NULL) {
                     tr_error("sn_coap_parser_options_parse - failed to allocate options!");
                     return -1;
                 }
@@ -379,14 +445,13 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
                 dst_coap_msg_ptr->options_list_ptr->proxy_uri_len = option_len;
                 (*packet_data_pptr)++;
 
-                dst_coap_msg_ptr->options_list_ptr->proxy_uri_ptr = handle->sn_coap_protocol_malloc(option_len);
+                dst_coap_msg_ptr->options_list_ptr->proxy_uri_ptr = sn_coap_parser_store_option(handle, *packet_data_pptr, option_len);
 
                 if (dst_coap_msg_ptr->options_list_ptr->proxy_uri_ptr == NULL) {
                     tr_error("sn_coap_parser_options_parse - COAP_OPTION_PROXY_URI allocation failed!");
                     return -1;
                 }
 
-                memcpy(dst_coap_msg_ptr->options_list_ptr->proxy_uri_ptr, *packet_data_pptr, option_len);
                 (*packet_data_pptr) += option_len;
 
                 break;
@@ -415,13 +480,12 @@ static int8_t sn_coap_parser_options_parse(struct coap_s *handle, uint8_t **pack
                 dst_coap_msg_ptr->options_list_ptr->uri_host_len = option_len;
                 (*packet_data_pptr)++;
 
-                dst_coap_msg_ptr->options_list_ptr->uri_host_ptr = handle->sn_coap_protocol_malloc(option_len);
+                dst_coap_msg_ptr->options_list_ptr->uri_host_ptr = sn_coap_parser_store_option(handle, *packet_data_pptr, option_len);
 
                 if (dst_coap_msg_ptr->options_list_ptr->uri_host_ptr == NULL) {
                     tr_error("sn_coap_parser_options_parse - COAP_OPTION_URI_HOST allocation failed!");
                     return -1;
                 }
-                memcpy(dst_coap_msg_ptr->options_list_ptr->uri_host_ptr, *packet_data_pptr, option_len);
                 (*packet_data_pptr) += option_len;
 
                 break;
@@ -603,7 +667,10 @@ static int8_t sn_coap_parser_options_parse_multiple_options(struct coap_s *handl
         return -1;
     }
 
-    if (uri_query_needed_heap) {
+    if (uri_query_needed_heap && handle == NULL) {
+        /* Parts are joined in place, over the headers of the following parts */
+        *dst_pptr = *packet_data_pptr + 1;
+    } else if (uri_query_needed_heap) {
         *dst_pptr = (uint8_t *) handle->sn_coap_protocol_malloc(uri_query_needed_heap);
 
         if (*dst_pptr == NULL) {
@@ -639,7 +706,7 @@ static int8_t sn_coap_parser_options_parse_multiple_options(struct coap_s *handl
             return -1;
         }
 
-        memcpy(temp_parsed_uri_query_ptr, *packet_data_pptr, option_number_len);
+        memmove(temp_parsed_uri_query_ptr, *packet_data_pptr, option_number_len);
 
         (*packet_data_pptr) += option_number_len;
         temp_parsed_uri_query_ptr += option_number_len;
@@ -52,6 +52,8 @@ static void                  sn_coap_protocol_linked_list_duplication_info_store
 static coap_duplication_info_s *sn_coap_protocol_linked_list_duplication_info_search(const struct coap_s *handle, const sn_nsdl_addr_s *scr_addr_ptr, const uint16_t msg_id);
 static void                  sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *handle, uint8_t *scr_addr_ptr, uint16_t port, uint16_t msg_id);
 static void                  sn_coap_protocol_linked_list_duplication_info_remove_old_ones(struct coap_s *handle);
+static void                  sn_coap_protocol_duplication_info_link(struct coap_s *handle, coap_duplication_info_s *stored_duplication_info_ptr);
+static void                  sn_coap_protocol_duplication_info_unlink(struct coap_s *handle, coap_duplication_info_s *stored_duplication_info_ptr);
 static bool                  sn_coap_protocol_update_duplicate_package_data(const struct coap_s *handle, const sn_nsdl_addr_s *dst_addr_ptr, const sn_coap_hdr_s *coap_msg_ptr, const int16_t data_size, const uint8_t *dst_packet_data_ptr);
 #endif
 
@@ -72,6 +74,9 @@ static sn_coap_hdr_s        *sn_coap_protocol_copy_header(struct coap_s *handle,
 static uint8_t               sn_coap_protocol_linked_list_send_msg_store(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr, uint16_t send_packet_data_len, uint8_t *send_packet_data_ptr, uint32_t sending_time, void *param);
 static sn_nsdl_transmit_s   *sn_coap_protocol_linked_list_send_msg_search(struct coap_s *handle,sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id);
 static void                  sn_coap_protocol_linked_list_send_msg_remove(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id);
+static uint16_t              sn_coap_protocol_send_msg_id(const coap_send_msg_s *stored_msg_ptr);
+static void                  sn_coap_protocol_send_msg_link(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr);
+static void                  sn_coap_protocol_send_msg_unlink(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr);
 static coap_send_msg_s      *sn_coap_protocol_allocate_mem_for_msg(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr, uint16_t packet_data_len);
 static void                  sn_coap_protocol_release_allocated_send_msg_mem(struct coap_s *handle, coap_send_msg_s *freed_send_msg_ptr);
 static uint16_t              sn_coap_count_linked_list_size(const coap_send_msg_list_t *linked_list_ptr);
@@ -109,8 +114,7 @@ int8_t sn_coap_protocol_destroy(struct coap_s *handle)
                 handle->sn_coap_protocol_free(tmp->packet_ptr);
                 tmp->packet_ptr = 0;
             }
-            ns_list_remove(&handle->linked_list_duplication_msgs, tmp);
-            handle->count_duplication_msgs--;
+            sn_coap_protocol_duplication_info_unlink(handle, tmp);
             handle->sn_coap_protocol_free(tmp);
             tmp = 0;
         }
@@ -339,9 +343,8 @@ void sn_coap_protocol_clear_retransmission_buffer(struct coap_s *handle)
         return;
     }
     ns_list_foreach_safe(coap_send_msg_s, tmp, &handle->linked_list_resent_msgs) {
-        ns_list_remove(&handle->linked_list_resent_msgs, tmp);
+        sn_coap_protocol_send_msg_unlink(handle, tmp);
         sn_coap_protocol_release_allocated_send_msg_mem(handle, tmp);
-        --handle->count_resent_msgs;
     }
 #endif
 }
@@ -352,16 +355,11 @@ int8_t sn_coap_protocol_delete_retransmission(struct coap_s *handle, uint16_t ms
     if (handle == NULL) {
         return -1;
     }
-    ns_list_foreach_safe(coap_send_msg_s, tmp, &handle->linked_list_resent_msgs) {
-        if (tmp->send_msg_ptr && tmp->send_msg_ptr->packet_ptr ) {
-            uint16_t temp_msg_id = (tmp->send_msg_ptr->packet_ptr[2] << 8);
-            temp_msg_id += (uint16_t)tmp->send_msg_ptr->packet_ptr[3];
-            if(temp_msg_id == msg_id){
-                ns_list_remove(&handle->linked_list_resent_msgs, tmp);
-                --handle->count_resent_msgs;
-                sn_coap_protocol_release_allocated_send_msg_mem(handle, tmp);
-                return 0;
-            }
+    for (coap_send_msg_s *tmp = handle->resent_msgs_hash[msg_id % SN_COAP_MSG_ID_HASH_SIZE]; tmp; tmp = tmp->hash_next) {
+        if (sn_coap_protocol_send_msg_id(tmp) == msg_id) {
+            sn_coap_protocol_send_msg_unlink(handle, tmp);
+            sn_coap_protocol_release_allocated_send_msg_mem(handle, tmp);
+            return 0;
         }
     }
 #endif
@@ -385,8 +383,7 @@ int8_t sn_coap_protocol_delete_retransmission_by_token(struct coap_s *handle, ui
                 uint16_t temp_msg_id = (stored_msg->send_msg_ptr->packet_ptr[2] << 8);
                 temp_msg_id += (uint16_t)stored_msg->send_msg_ptr->packet_ptr[3];
                 tr_debug("sn_coap_protocol_delete_retransmission_by_token - removed msg_id: %d", temp_msg_id);
-                ns_list_remove(&handle->linked_list_resent_msgs, stored_msg);
-                --handle->count_resent_msgs;
+                sn_coap_protocol_send_msg_unlink(handle, stored_msg);
 
                 /* Free memory of stored message */
                 sn_coap_protocol_release_allocated_send_msg_mem(handle, stored_msg);
@@ -856,8 +853,7 @@ rescan:
                     temp_msg_id += (uint16_t)stored_msg_ptr->send_msg_ptr->packet_ptr[3];
 
                     /* Remove message from Linked list */
-                    ns_list_remove(&handle->linked_list_resent_msgs, stored_msg_ptr);
-                    --handle->count_resent_msgs;
+                    sn_coap_protocol_send_msg_unlink(handle, stored_msg_ptr);
 
                     /* If RX callback have been defined.. */
                     if (stored_msg_ptr->coap->sn_coap_rx_callback != 0) {
@@ -970,8 +966,7 @@ static uint8_t sn_coap_protocol_linked_list_send_msg_store(struct coap_s *handle
     stored_msg_ptr->param = param;
 
     /* Storing Resending message to Linked list */
-    ns_list_add_to_end(&handle->linked_list_resent_msgs, stored_msg_ptr);
-    ++handle->count_resent_msgs;
+    sn_coap_protocol_send_msg_link(handle, stored_msg_ptr);
     return 1;
 }
 
@@ -991,14 +986,10 @@ static uint8_t sn_coap_protocol_linked_list_send_msg_store(struct coap_s *handle
 static sn_nsdl_transmit_s *sn_coap_protocol_linked_list_send_msg_search(struct coap_s *handle,
         sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id)
 {
-    /* Loop all stored resending messages Linked list */
-    ns_list_foreach(coap_send_msg_s, stored_msg_ptr, &handle->linked_list_resent_msgs) {
-        /* Get message ID from stored resending message */
-        uint16_t temp_msg_id = (stored_msg_ptr->send_msg_ptr->packet_ptr[2] << 8);
-        temp_msg_id += (uint16_t)stored_msg_ptr->send_msg_ptr->packet_ptr[3];
-
+    /* Loop stored resending messages with the same Message ID hash */
+    for (coap_send_msg_s *stored_msg_ptr = handle->resent_msgs_hash[msg_id % SN_COAP_MSG_ID_HASH_SIZE]; stored_msg_ptr; stored_msg_ptr = stored_msg_ptr->hash_next) {
         /* If message's Message ID is same than is searched */
-        if (temp_msg_id == msg_id) {
+        if (sn_coap_protocol_send_msg_id(stored_msg_ptr) == msg_id) {
             /* If message's Source address is same than is searched */
             if (0 == memcmp(src_addr_ptr->addr_ptr, stored_msg_ptr->send_msg_ptr->dst_addr_ptr->addr_ptr, src_addr_ptr->addr_len)) {
                 /* If message's Source address port is same than is searched */
@@ -1024,14 +1015,10 @@ static sn_nsdl_transmit_s *sn_coap_protocol_linked_list_send_msg_search(struct c
 
 static void sn_coap_protocol_linked_list_send_msg_remove(struct coap_s *handle, sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id)
 {
-    /* Loop all stored resending messages in Linked list */
-    ns_list_foreach(coap_send_msg_s, stored_msg_ptr, &handle->linked_list_resent_msgs) {
-        /* Get message ID from stored resending message */
-        uint16_t temp_msg_id = (stored_msg_ptr->send_msg_ptr->packet_ptr[2] << 8);
-        temp_msg_id += (uint16_t)stored_msg_ptr->send_msg_ptr->packet_ptr[3];
-
+    /* Loop stored resending messages with the same Message ID hash */
+    for (coap_send_msg_s *stored_msg_ptr = handle->resent_msgs_hash[msg_id % SN_COAP_MSG_ID_HASH_SIZE]; stored_msg_ptr; stored_msg_ptr = stored_msg_ptr->hash_next) {
         /* If message's Message ID is same than is searched */
-        if (temp_msg_id == msg_id) {
+        if (sn_coap_protocol_send_msg_id(stored_msg_ptr) == msg_id) {
             /* If message's Source address is same than is searched */
             if (0 == memcmp(src_addr_ptr->addr_ptr, stored_msg_ptr->send_msg_ptr->dst_addr_ptr->addr_ptr, src_addr_ptr->addr_len)) {
                 /* If message's Source address port is same than is searched */
@@ -1039,8 +1026,7 @@ static void sn_coap_protocol_linked_list_send_msg_remove(struct coap_s *handle,
                     /* * * Message found * * */
 
                     /* Remove message from Linked list */
-                    ns_list_remove(&handle->linked_list_resent_msgs, stored_msg_ptr);
-                    --handle->count_resent_msgs;
+                    sn_coap_protocol_send_msg_unlink(handle, stored_msg_ptr);
 
                     /* Free memory of stored message */
                     sn_coap_protocol_release_allocated_send_msg_mem(handle, stored_msg_ptr);
@@ -1052,6 +1038,56 @@ static void sn_coap_protocol_linked_list_send_msg_remove(struct coap_s *handle,
     }
 }
 
+/**************************************************************************//**
+ * \fn static uint16_t sn_coap_protocol_send_msg_id(const coap_send_msg_s *stored_msg_ptr)
+ *
+ * \brief Gets Message ID from the packet of stored resending message
+ *****************************************************************************/
+
+static uint16_t sn_coap_protocol_send_msg_id(const coap_send_msg_s *stored_msg_ptr)
+{
+    return (stored_msg_ptr->send_msg_ptr->packet_ptr[2] << 8) | stored_msg_ptr->send_msg_ptr->packet_ptr[3];
+}
+
+/**************************************************************************//**
+ * \fn static void sn_coap_protocol_send_msg_link(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr)
+ *
+ * \brief Adds resending message to the end of Linked list and to its Message ID hash bucket
+ *****************************************************************************/
+
+static void sn_coap_protocol_send_msg_link(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr)
+{
+    coap_send_msg_s **bucket = &handle->resent_msgs_hash[sn_coap_protocol_send_msg_id(stored_msg_ptr) % SN_COAP_MSG_ID_HASH_SIZE];
+
+    stored_msg_ptr->hash_next = *bucket;
+    *bucket = stored_msg_ptr;
+
+    ns_list_add_to_end(&handle->linked_list_resent_msgs, stored_msg_ptr);
+    ++handle->count_resent_msgs;
+}
+
+/**************************************************************************//**
+ * \fn static void sn_coap_protocol_send_msg_unlink(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr)
+ *
+ * \brief Removes resending message from Linked list and from its Message ID hash bucket, without freeing it
+ *****************************************************************************/
+
+static void sn_coap_protocol_send_msg_unlink(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr)
+{
+    coap_send_msg_s **next = &handle->resent_msgs_hash[sn_coap_protocol_send_msg_id(stored_msg_ptr) % SN_COAP_MSG_ID_HASH_SIZE];
+
+    while (*next && *next != stored_msg_ptr) {
+        next = &(*next)->hash_next;
+    }
+    if (*next) {
+        *next = stored_msg_ptr->hash_next;
+    }
+    stored_msg_ptr->hash_next = NULL;
+
+    ns_list_remove(&handle->linked_list_resent_msgs, stored_msg_ptr);
+    --handle->count_resent_msgs;
+}
+
 uint32_t sn_coap_calculate_new_resend_time(const uint32_t current_time, const uint8_t interval, const uint8_t counter)
 {
     uint32_t resend_time = interval << counter;
@@ -1146,8 +1182,7 @@ static void sn_coap_protocol_linked_list_duplication_info_store(struct coap_s *h
     stored_duplication_info_ptr->param = param;
     /* * * * Storing Duplication info to Linked list * * * */
 
-    ns_list_add_to_end(&handle->linked_list_duplication_msgs, stored_duplication_info_ptr);
-    ++handle->count_duplication_msgs;
+    sn_coap_protocol_duplication_info_link(handle, stored_duplication_info_ptr);
 }
 
 /**************************************************************************//**
@@ -1164,8 +1199,9 @@ static void sn_coap_protocol_linked_list_duplication_info_store(struct coap_s *h
 static coap_duplication_info_s* sn_coap_protocol_linked_list_duplication_info_search(const struct coap_s *handle,
         const sn_nsdl_addr_s *addr_ptr, const uint16_t msg_id)
 {
-    /* Loop all nodes in Linked list for searching Message ID */
-    ns_list_foreach(coap_duplication_info_s, stored_duplication_info_ptr, &handle->linked_list_duplication_msgs) {
+    /* Loop stored duplication infos with the same Message ID hash */
+    for (coap_duplication_info_s *stored_duplication_info_ptr = handle->duplication_msgs_hash[msg_id % SN_COAP_MSG_ID_HASH_SIZE];
+            stored_duplication_info_ptr; stored_duplication_info_ptr = stored_duplication_info_ptr->hash_next) {
         /* If message's Message ID is same than is searched */
         if (stored_duplication_info_ptr->msg_id == msg_id) {
             /* If message's Source address is same than is searched */
@@ -1195,8 +1231,9 @@ static coap_duplication_info_s* sn_coap_protocol_linked_list_duplication_info_se
 
 static void sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *handle, uint8_t *addr_ptr, uint16_t port, uint16_t msg_id)
 {
-    /* Loop all stored duplication messages in Linked list */
-    ns_list_foreach(coap_duplication_info_s, removed_duplication_info_ptr, &handle->linked_list_duplication_msgs) {
+    /* Loop stored duplication infos with the same Message ID hash */
+    for (coap_duplication_info_s *removed_duplication_info_ptr = handle->duplication_msgs_hash[msg_id % SN_COAP_MSG_ID_HASH_SIZE];
+            removed_duplication_info_ptr; removed_duplication_info_ptr = removed_duplication_info_ptr->hash_next) {
         /* If message's Address is same than is searched */
         if (handle == removed_duplication_info_ptr->coap && 0 == memcmp(addr_ptr,
                                                                         removed_duplication_info_ptr->address->addr_ptr,
@@ -1206,8 +1243,7 @@ static void sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *
                 /* If Message ID is same than is searched */
                 if (removed_duplication_info_ptr->msg_id == msg_id) {
                     /* * * * Correct Duplication info found, remove it from Linked list * * * */
-                    ns_list_remove(&handle->linked_list_duplication_msgs, removed_duplication_info_ptr);
-                    --handle->count_duplication_msgs;
+                    sn_coap_protocol_duplication_info_unlink(handle, removed_duplication_info_ptr);
 
                     /* Free memory of stored Duplication info */
                     handle->sn_coap_protocol_free(removed_duplication_info_ptr->address->addr_ptr);
@@ -1237,8 +1273,7 @@ static void sn_coap_protocol_linked_list_duplication_info_remove_old_ones(struct
     ns_list_foreach_safe(coap_duplication_info_s, removed_duplication_info_ptr, &handle->linked_list_duplication_msgs) {
         if ((handle->system_time - removed_duplication_info_ptr->timestamp)  > SN_COAP_DUPLICATION_MAX_TIME_MSGS_STORED) {
             /* * * * Old Duplication info found, remove it from Linked list * * * */
-            ns_list_remove(&handle->linked_list_duplication_msgs, removed_duplication_info_ptr);
-            --handle->count_duplication_msgs;
+            sn_coap_protocol_duplication_info_unlink(handle, removed_duplication_info_ptr);
 
             /* Free memory of stored Duplication info */
             handle->sn_coap_protocol_free(removed_duplication_info_ptr->address->addr_ptr);
@@ -1253,6 +1288,45 @@ static void sn_coap_protocol_linked_list_duplication_info_remove_old_ones(struct
     }
 }
 
+/**************************************************************************//**
+ * \fn static void sn_coap_protocol_duplication_info_link(struct coap_s *handle, coap_duplication_info_s *stored_duplication_info_ptr)
+ *
+ * \brief Adds Duplication info to the end of Linked list and to its Message ID hash bucket
+ *****************************************************************************/
+
+static void sn_coap_protocol_duplication_info_link(struct coap_s *handle, coap_duplication_info_s *stored_duplication_info_ptr)
+{
+    coap_duplication_info_s **bucket = &handle->duplication_msgs_hash[stored_duplication_info_ptr->msg_id % SN_COAP_MSG_ID_HASH_SIZE];
+
+    stored_duplication_info_ptr->hash_next = *bucket;
+    *bucket = stored_duplication_info_ptr;
+
+    ns_list_add_to_end(&handle->linked_list_duplication_msgs, stored_duplication_info_ptr);
+    ++handle->count_duplication_msgs;
+}
+
+/**************************************************************************//**
+ * \fn static void sn_coap_protocol_duplication_info_unlink(struct coap_s *handle, coap_duplication_info_s *stored_duplication_info_ptr)
+ *
+ * \brief Removes Duplication info from Linked list and from its Message ID hash bucket, without freeing it
+ *****************************************************************************/
+
+static void sn_coap_protocol_duplication_info_unlink(struct coap_s *handle, coap_duplication_info_s *stored_duplication_info_ptr)
+{
+    coap_duplication_info_s **next = &handle->duplication_msgs_hash[stored_duplication_info_ptr->msg_id % SN_COAP_MSG_ID_HASH_SIZE];
+
+    while (*next && *next != stored_duplication_info_ptr) {
+        next = &(*next)->hash_next;
+    }
+    if (*next) {
+        *next = stored_duplication_info_ptr->hash_next;
+    }
+    stored_duplication_info_ptr->hash_next = NULL;
+
+    ns_list_remove(&handle->linked_list_duplication_msgs, stored_duplication_info_ptr);
+    --handle->count_duplication_msgs;
+}
+
 #endif /* SN_COAP_DUPLICATION_MAX_MSGS_COUNT */
 
 #if SN_COAP_BLOCKWISE_ENABLED || SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE
@@ -328,6 +328,34 @@ void mbed_vtracef(uint8_t dlevel, const char *grp, const char *fmt, va_list ap);
  *  Get last trace from buffer
  */
 const char *mbed_trace_last(void);
+/**
+ * Defer trace formatting and printing
+ * When enabled, a trace call only stores its format string pointer, arguments
+ * and timestamp in a ring, without locking, and mbed_trace_deferred_flush()
+ * formats and prints the traces later, e.g. from a low priority thread.
+ * Format strings and trace groups must stay valid until then, as string literals do.
+ * String arguments are copied, up to MBED_TRACE_DEFERRED_STR_LENGTH bytes per trace.
+ * Traces which don't fit in the ring are dropped and counted, and traces with
+ * more than MBED_TRACE_DEFERRED_ARGS arguments or unsupported conversions are
+ * printed at once. tr_cmdline() is never deferred.
+ * Requires the library to be built with MBED_TRACE_DEFERRED_SIZE, the number of
+ * traces in the ring.
+ * @param enable    true to defer traces, false to print pending and following traces
+ * @return 0 when all success, otherwise non zero
+ */
+int mbed_trace_deferred_set(bool enable);
+/**
+ * Set trace timestamp function
+ * Called when a deferred trace is stored. The value is printed in brackets
+ * before the trace text.
+ */
+void mbed_trace_timestamp_function_set(uint32_t (*timestamp_f)(void));
+/**
+ * Format and print deferred traces
+ * Must not be called from several threads at once.
+ * @return number of traces printed
+ */
+int mbed_trace_deferred_flush(void);
 #if MBED_CONF_MBED_TRACE_FEA_IPV6 == 1
 /**
  * mbed_tracef helping function for convert ipv6
@@ -401,6 +429,9 @@ char *mbed_trace_array(const uint8_t *buf, uint16_t len);
 #undef mbed_tracef
 #undef mbed_vtracef
 #undef mbed_trace_last
+#undef mbed_trace_deferred_set
+#undef mbed_trace_timestamp_function_set
+#undef mbed_trace_deferred_flush
 #undef mbed_trace_ipv6
 #undef mbed_trace_ipv6_prefix
 #undef mbed_trace_array
@@ -424,6 +455,9 @@ char *mbed_trace_array(const uint8_t *buf, uint16_t len);
 #define mbed_trace_include_filters_set(...)         ((void) 0)
 #define mbed_trace_include_filters_get(...)         ((const char *) 0)
 #define mbed_trace_last(...)                        ((const char *) 0)
+#define mbed_trace_deferred_set(...)                ((int) -1)
+#define mbed_trace_timestamp_function_set(...)      ((void) 0)
+#define mbed_trace_deferred_flush(...)              ((int) 0)
 #define mbed_tracef(...)                            ((void) 0)
 #define mbed_vtracef(...)                           ((void) 0)
 /**
@@ -16,6 +16,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdarg.h>
+#include <stddef.h>
 
 #ifdef MBED_CONF_MBED_TRACE_ENABLE
 #undef MBED_CONF_MBED_TRACE_ENABLE
@@ -92,10 +93,104 @@
 #define DEFAULT_TRACE_CONFIG              TRACE_MODE_COLOR | TRACE_ACTIVE_LEVEL_ALL | TRACE_CARRIAGE_RETURN
 #endif
 
+/** default number of traces stored for deferred printing, a power of two.
+    0 leaves deferred mode out */
+#ifdef MBED_TRACE_DEFERRED_SIZE
+#define DEFAULT_TRACE_DEFERRED_SIZE       MBED_TRACE_DEFERRED_SIZE
+#else
+#define DEFAULT_TRACE_DEFERRED_SIZE       0
+#endif
+
+/** default max arguments of a deferred trace, traces with more are printed at once */
+#ifdef MBED_TRACE_DEFERRED_ARGS
+#define DEFAULT_TRACE_DEFERRED_ARGS       MBED_TRACE_DEFERRED_ARGS
+#else
+#define DEFAULT_TRACE_DEFERRED_ARGS       6
+#endif
+
+/** default bytes stored for the string arguments of a deferred trace */
+#ifdef MBED_TRACE_DEFERRED_STR_LENGTH
+#define DEFAULT_TRACE_DEFERRED_STR_LENGTH MBED_TRACE_DEFERRED_STR_LENGTH
+#else
+#define DEFAULT_TRACE_DEFERRED_STR_LENGTH 32
+#endif
+
+#if DEFAULT_TRACE_DEFERRED_SIZE
+#if (DEFAULT_TRACE_DEFERRED_SIZE & (DEFAULT_TRACE_DEFERRED_SIZE - 1)) != 0
+#error MBED_TRACE_DEFERRED_SIZE must be a power of two
+#endif
+
+#if defined(__MBED__)
+#include "platform/mbed_critical.h"
+#define trace_atomic_cas_u32(ptr, expected, desired)    core_util_atomic_cas_u32(ptr, expected, desired)
+#define trace_atomic_incr_u32(ptr)                      core_util_atomic_incr_u32(ptr, 1)
+#define trace_atomic_load_u8(ptr)                       core_util_atomic_load_u8(ptr)
+#define trace_atomic_load_u32(ptr)                      core_util_atomic_load_u32(ptr)
+#define trace_atomic_store_u32(ptr, value)              core_util_atomic_store_u32(ptr, value)
+#define trace_atomic_store_u8(ptr, value)               core_util_atomic_store_u8(ptr, value)
+#else
+#define trace_atomic_cas_u32(ptr, expected, desired)    __atomic_compare_exchange_n(ptr, expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)
+#define trace_atomic_incr_u32(ptr)                      __atomic_add_fetch(ptr, 1, __ATOMIC_SEQ_CST)
+#define trace_atomic_load_u8(ptr)                       __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+#define trace_atomic_load_u32(ptr)                      __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+#define trace_atomic_store_u32(ptr, value)              __atomic_store_n(ptr, value, __ATOMIC_RELEASE)
+#define trace_atomic_store_u8(ptr, value)               __atomic_store_n(ptr, value, __ATOMIC_RELEASE)
+#endif
+
+/** argument type of a printf conversion */
+typedef enum {
+    TRACE_ARG_END,      // end of format string
+    TRACE_ARG_PERCENT,  // "%%", no argument
+    TRACE_ARG_INT,
+    TRACE_ARG_LONG,
+    TRACE_ARG_LLONG,
+    TRACE_ARG_SIZE,
+    TRACE_ARG_PTRDIFF,
+    TRACE_ARG_INTMAX,
+    TRACE_ARG_DOUBLE,
+    TRACE_ARG_PTR,
+    TRACE_ARG_STR,
+    TRACE_ARG_INVALID   // not supported in deferred traces
+} trace_arg_type_t;
+
+typedef struct {
+    /** start of the conversion, or end of format string */
+    const char *start;
+    /** one past the conversion character */
+    const char *end;
+    /** '*' width and precision, each taking an int argument before the value */
+    uint8_t stars;
+    trace_arg_type_t type;
+} trace_conv_t;
+
+typedef union {
+    long long ll;       // all integers, and offsets of strings in str
+    double d;
+    const void *p;
+} trace_arg_t;
+
+/** trace stored for deferred printing */
+typedef struct {
+    volatile uint8_t ready;
+    uint8_t dlevel;
+    uint32_t timestamp;
+    const char *grp;
+    const char *fmt;
+    trace_arg_t args[DEFAULT_TRACE_DEFERRED_ARGS];
+    char str[DEFAULT_TRACE_DEFERRED_STR_LENGTH];
+} trace_record_t;
+
+static trace_record_t m_trace_records[DEFAULT_TRACE_DEFERRED_SIZE];
+
+static int mbed_trace_deferred_store(uint8_t dlevel, const char *grp, const char *fmt, va_list ap);
+static void mbed_trace_print(uint8_t dlevel, const char *grp, const char *fmt, ...);
+#endif
+
 /** default print function, just redirect str to printf */
 static void mbed_trace_realloc(char **buffer, int *length_ptr, int new_length);
 static void mbed_trace_default_print(const char *str);
 static void mbed_trace_reset_tmp(void);
+static void mbed_trace_vprint(uint8_t dlevel, const char *grp, const char *fmt, va_list ap);
 
 typedef struct trace_s {
     /** trace configuration bits */
@@ -131,6 +226,24 @@ typedef struct trace_s {
     void (*mutex_release_f)(void);
     /** number of times the mutex has been locked */
     int mutex_lock_count;
+#if DEFAULT_TRACE_DEFERRED_SIZE
+    /** store traces for mbed_trace_deferred_flush() instead of printing them */
+    bool deferred;
+    /** timestamp function for deferred traces */
+    uint32_t (*timestamp_f)(void);
+    /** text of deferred trace being printed */
+    char *deferred_line;
+    /** deferred trace text length */
+    int deferred_line_length;
+    /** sequence number of next deferred trace to store */
+    volatile uint32_t deferred_write;
+    /** sequence number of next deferred trace to print */
+    volatile uint32_t deferred_read;
+    /** number of deferred traces dropped because all records were in use */
+    volatile uint32_t deferred_dropped;
+    /** number of dropped traces already reported */
+    uint32_t deferred_dropped_reported;
+#endif
 } trace_t;
 
 static trace_t m_trace = {
@@ -191,6 +304,9 @@ void mbed_trace_free(void)
     MBED_TRACE_MEM_FREE(m_trace.tmp_data);
     MBED_TRACE_MEM_FREE(m_trace.filters_exclude);
     MBED_TRACE_MEM_FREE(m_trace.filters_include);
+#if DEFAULT_TRACE_DEFERRED_SIZE
+    MBED_TRACE_MEM_FREE(m_trace.deferred_line);
+#endif
 
     // reset to default values
     m_trace.trace_config = DEFAULT_TRACE_CONFIG;
@@ -208,6 +324,12 @@ void mbed_trace_free(void)
     m_trace.mutex_wait_f = 0;
     m_trace.mutex_release_f = 0;
     m_trace.mutex_lock_count = 0;
+#if DEFAULT_TRACE_DEFERRED_SIZE
+    m_trace.deferred = false;
+    m_trace.timestamp_f = 0;
+    m_trace.deferred_line = 0;
+    m_trace.deferred_line_length = 0;
+#endif
 }
 static void mbed_trace_realloc(char **buffer, int *length_ptr, int new_length)
 {
@@ -312,6 +434,23 @@ void mbed_tracef(uint8_t dlevel, const char *grp, const char *fmt, ...)
     va_end(ap);
 }
 void mbed_vtracef(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
+{
+#if DEFAULT_TRACE_DEFERRED_SIZE
+    if (m_trace.deferred) {
+        int strings = mbed_trace_deferred_store(dlevel, grp, fmt, ap);
+        if (strings == 0) {
+            return;
+        }
+        if (strings > 0) {
+            // String arguments may come from the helper functions, which
+            // leave the mutex locked. Release it as an empty trace does.
+            fmt = 0;
+        }
+    }
+#endif
+    mbed_trace_vprint(dlevel, grp, fmt, ap);
+}
+static void mbed_trace_vprint(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
 {
     if (m_trace.mutex_wait_f) {
         m_trace.mutex_wait_f();
@@ -501,6 +640,372 @@ const char *mbed_trace_last(void)
 {
     return m_trace.line;
 }
+#if DEFAULT_TRACE_DEFERRED_SIZE
+static void mbed_trace_print(uint8_t dlevel, const char *grp, const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    mbed_trace_vprint(dlevel, grp, fmt, ap);
+    va_end(ap);
+}
+/** Find the first conversion of fmt and its argument type */
+static const char *mbed_trace_next_conv(const char *fmt, trace_conv_t *conv)
+{
+    const char *p = strchr(fmt, '%');
+    char length = 0;
+
+    conv->stars = 0;
+    if (p == NULL) {
+        conv->start = conv->end = fmt + strlen(fmt);
+        conv->type = TRACE_ARG_END;
+        return conv->end;
+    }
+    conv->start = p++;
+
+    while (*p && strchr("-+ #0", *p)) {
+        p++;
+    }
+    if (*p == '*') {
+        conv->stars++;
+        p++;
+    }
+    while (*p >= '0' && *p <= '9') {
+        p++;
+    }
+    if (*p == '.') {
+        p++;
+        if (*p == '*') {
+            conv->stars++;
+            p++;
+        }
+        while (*p >= '0' && *p <= '9') {
+            p++;
+        }
+    }
+    switch (*p) {
+        case 'h':
+            // short and char are promoted to int
+            p += (p[1] == 'h') ? 2 : 1;
+            break;
+        case 'l':
+            length = (p[1] == 'l') ? 'q' : 'l';
+            p += (p[1] == 'l') ? 2 : 1;
+            break;
+        case 'z':
+        case 'j':
+        case 't':
+        case 'L':
+            length = *p++;
+            break;
+    }
+
+    conv->end = *p ? p + 1 : p;
+    switch (*p) {
+        case '%':
+            conv->type = TRACE_ARG_PERCENT;
+            break;
+        case 'd':
+        case 'i':
+        case 'o':
+        case 'u':
+        case 'x':
+        case 'X':
+            conv->type = length == 0   ? TRACE_ARG_INT :
+                         length == 'l' ? TRACE_ARG_LONG :
+                         length == 'q' ? TRACE_ARG_LLONG :
+                         length == 'z' ? TRACE_ARG_SIZE :
+                         length == 't' ? TRACE_ARG_PTRDIFF :
+                         length == 'j' ? TRACE_ARG_INTMAX : TRACE_ARG_INVALID;
+            break;
+        case 'c':
+            conv->type = length == 0 ? TRACE_ARG_INT : TRACE_ARG_INVALID;
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            conv->type = length == 0 || length == 'l' ? TRACE_ARG_DOUBLE : TRACE_ARG_INVALID;
+            break;
+        case 'p':
+            conv->type = TRACE_ARG_PTR;
+            break;
+        case 's':
+            conv->type = length == 0 ? TRACE_ARG_STR : TRACE_ARG_INVALID;
+            break;
+        default:
+            conv->type = TRACE_ARG_INVALID;
+            break;
+    }
+    return conv->end;
+}
+/**
+ * Store a trace for mbed_trace_deferred_flush() without locking.
+ * @return number of string arguments, or -1 if the trace must be printed at once
+ */
+static int mbed_trace_deferred_store(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
+{
+    trace_record_t record;
+    trace_record_t *slot;
+    trace_conv_t conv;
+    int argc = 0, strings = 0, str_used = 0;
+    uint32_t seq;
+    va_list ap2;
+
+    if (fmt == 0 || grp == 0 || dlevel == TRACE_LEVEL_CMD || !m_trace.printf ||
+            !((m_trace.trace_config & TRACE_MASK_LEVEL) & dlevel) || mbed_trace_skip(dlevel, grp)) {
+        return -1;
+    }
+
+    record.ready = 0;
+    record.dlevel = dlevel;
+    record.grp = grp;
+    record.fmt = fmt;
+    record.timestamp = m_trace.timestamp_f ? m_trace.timestamp_f() : 0;
+
+    va_copy(ap2, ap);
+    for (const char *p = fmt; ; ) {
+        p = mbed_trace_next_conv(p, &conv);
+        if (conv.type == TRACE_ARG_END) {
+            break;
+        }
+        if (conv.type == TRACE_ARG_PERCENT) {
+            continue;
+        }
+        if (conv.type == TRACE_ARG_INVALID || argc + conv.stars >= DEFAULT_TRACE_DEFERRED_ARGS) {
+            va_end(ap2);
+            return -1;
+        }
+        for (int i = 0; i < conv.stars; i++) {
+            record.args[argc++].ll = va_arg(ap2, int);
+        }
+        trace_arg_t *arg = &record.args[argc++];
+        switch (conv.type) {
+            case TRACE_ARG_INT:
+                arg->ll = va_arg(ap2, int);
+                break;
+            case TRACE_ARG_LONG:
+                arg->ll = va_arg(ap2, long);
+                break;
+            case TRACE_ARG_LLONG:
+                arg->ll = va_arg(ap2, long long);
+                break;
+            case TRACE_ARG_SIZE:
+                arg->ll = va_arg(ap2, size_t);
+                break;
+            case TRACE_ARG_PTRDIFF:
+                arg->ll = va_arg(ap2, ptrdiff_t);
+                break;
+            case TRACE_ARG_INTMAX:
+                arg->ll = va_arg(ap2, intmax_t);
+                break;
+            case TRACE_ARG_DOUBLE:
+                arg->d = va_arg(ap2, double);
+                break;
+            case TRACE_ARG_PTR:
+                arg->p = va_arg(ap2, void *);
+                break;
+            default: { // TRACE_ARG_STR
+                // Copy the string, it may not live until printing
+                const char *str = va_arg(ap2, const char *);
+                int len = 0;
+                if (str == NULL) {
+                    str = "(null)";
+                }
+                while (str[len] && str_used + len < DEFAULT_TRACE_DEFERRED_STR_LENGTH - 1) {
+                    len++;
+                }
+                memcpy(record.str + str_used, str, len);
+                record.str[str_used + len] = 0;
+                arg->ll = str_used;
+                str_used += (str_used + len < DEFAULT_TRACE_DEFERRED_STR_LENGTH - 1) ? len + 1 : len;
+                strings++;
+                break;
+            }
+        }
+    }
+    va_end(ap2);
+
+    // Claim the record after the last one claimed, unless the oldest
+    // stored one hasn't been printed yet
+    seq = trace_atomic_load_u32(&m_trace.deferred_write);
+    do {
+        if (seq - trace_atomic_load_u32(&m_trace.deferred_read) >= DEFAULT_TRACE_DEFERRED_SIZE) {
+            trace_atomic_incr_u32(&m_trace.deferred_dropped);
+            return strings;
+        }
+    } while (!trace_atomic_cas_u32(&m_trace.deferred_write, &seq, seq + 1));
+
+    slot = &m_trace_records[seq & (DEFAULT_TRACE_DEFERRED_SIZE - 1)];
+    // Leave the ready flag alone, the flush may be polling it
+    memcpy((uint8_t *)slot + offsetof(trace_record_t, dlevel), &record.dlevel,
+           offsetof(trace_record_t, str) - offsetof(trace_record_t, dlevel) + str_used);
+    trace_atomic_store_u8(&slot->ready, 1);
+    return strings;
+}
+/** Format the text of a deferred trace into m_trace.deferred_line */
+static void mbed_trace_deferred_format(const trace_record_t *record)
+{
+    const trace_arg_t *arg = record->args;
+    const char *text = record->fmt;
+    char *ptr = m_trace.deferred_line;
+    int retval = 0, bLeft = m_trace.deferred_line_length;
+    trace_conv_t conv;
+    char spec[24];
+
+    *ptr = 0;
+    if (m_trace.timestamp_f) {
+        retval = snprintf(ptr, bLeft, "[%lu] ", (unsigned long)record->timestamp);
+        if (retval > 0 && retval < bLeft) {
+            ptr += retval;
+            bLeft -= retval;
+        }
+    }
+    while (bLeft > 1) {
+        const char *next = mbed_trace_next_conv(text, &conv);
+        // text before the conversion
+        int len = conv.start - text;
+        if (len > bLeft - 1) {
+            len = bLeft - 1;
+        }
+        memcpy(ptr, text, len);
+        ptr += len;
+        bLeft -= len;
+        *ptr = 0;
+        text = next;
+        if (conv.type == TRACE_ARG_END || bLeft <= 1) {
+            break;
+        }
+        if (conv.type == TRACE_ARG_PERCENT) {
+            *ptr++ = '%';
+            *ptr = 0;
+            bLeft--;
+            continue;
+        }
+
+        // Put the '*' values in the conversion, as the arguments can't be passed separately
+        const trace_arg_t *value = arg + conv.stars;
+        const char *p = conv.start;
+        int s = 0;
+        for (; p < conv.end && s < (int)sizeof(spec) - 12; p++) {
+            if (*p != '*') {
+                spec[s++] = *p;
+            } else if (p[-1] == '.' && arg->ll < 0) {
+                s--; // negative precision is as if it were omitted
+                arg++;
+            } else {
+                s += sprintf(spec + s, "%d", (int)(arg++)->ll);
+            }
+        }
+        spec[s] = 0;
+        arg = value + 1;
+        if (p < conv.end) {
+            // conversion too long, leave it out
+            continue;
+        }
+
+        switch (conv.type) {
+            case TRACE_ARG_INT:
+                retval = snprintf(ptr, bLeft, spec, (int)value->ll);
+                break;
+            case TRACE_ARG_LONG:
+                retval = snprintf(ptr, bLeft, spec, (long)value->ll);
+                break;
+            case TRACE_ARG_LLONG:
+                retval = snprintf(ptr, bLeft, spec, value->ll);
+                break;
+            case TRACE_ARG_SIZE:
+                retval = snprintf(ptr, bLeft, spec, (size_t)value->ll);
+                break;
+            case TRACE_ARG_PTRDIFF:
+                retval = snprintf(ptr, bLeft, spec, (ptrdiff_t)value->ll);
+                break;
+            case TRACE_ARG_INTMAX:
+                retval = snprintf(ptr, bLeft, spec, (intmax_t)value->ll);
+                break;
+            case TRACE_ARG_DOUBLE:
+                retval = snprintf(ptr, bLeft, spec, value->d);
+                break;
+            case TRACE_ARG_PTR:
+                retval = snprintf(ptr, bLeft, spec, value->p);
+                break;
+            default: // TRACE_ARG_STR
+                retval = snprintf(ptr, bLeft, spec, record->str + value->ll);
+                break;
+        }
+        if (retval >= bLeft) {
+            retval = bLeft - 1;
+        }
+        if (retval > 0) {
+            ptr += retval;
+            bLeft -= retval;
+        }
+    }
+}
+int mbed_trace_deferred_set(bool enable)
+{
+    if (enable && m_trace.deferred_line == NULL) {
+        m_trace.deferred_line = MBED_TRACE_MEM_ALLOC(m_trace.line_length);
+        if (m_trace.deferred_line == NULL) {
+            return -1;
+        }
+        m_trace.deferred_line_length = m_trace.line_length;
+    }
+    m_trace.deferred = enable;
+    if (!enable) {
+        mbed_trace_deferred_flush();
+    }
+    return 0;
+}
+void mbed_trace_timestamp_function_set(uint32_t (*timestamp_f)(void))
+{
+    m_trace.timestamp_f = timestamp_f;
+}
+int mbed_trace_deferred_flush(void)
+{
+    int count = 0;
+
+    if (m_trace.deferred_line == NULL) {
+        return 0;
+    }
+    for (;;) {
+        trace_record_t *record = &m_trace_records[m_trace.deferred_read & (DEFAULT_TRACE_DEFERRED_SIZE - 1)];
+        if (!trace_atomic_load_u8(&record->ready)) {
+            break;
+        }
+        mbed_trace_deferred_format(record);
+        mbed_trace_print(record->dlevel, record->grp, "%s", m_trace.deferred_line);
+        trace_atomic_store_u8(&record->ready, 0);
+        trace_atomic_store_u32(&m_trace.deferred_read, m_trace.deferred_read + 1);
+        count++;
+    }
+
+    uint32_t dropped = trace_atomic_load_u32(&m_trace.deferred_dropped);
+    if (dropped != m_trace.deferred_dropped_reported) {
+        mbed_trace_print(TRACE_LEVEL_WARN, "trce", "%lu traces dropped",
+                         (unsigned long)(dropped - m_trace.deferred_dropped_reported));
+        m_trace.deferred_dropped_reported = dropped;
+    }
+    return count;
+}
+#else
+int mbed_trace_deferred_set(bool enable)
+{
+    (void)enable;
+    return -1;
+}
+void mbed_trace_timestamp_function_set(uint32_t (*timestamp_f)(void))
+{
+    (void)timestamp_f;
+}
+int mbed_trace_deferred_flush(void)
+{
+    return 0;
+}
+#endif
 /* Helping functions */
 #define tmp_data_left()  m_trace.tmp_data_length-(m_trace.tmp_data_ptr-m_trace.tmp_data)
 #if MBED_CONF_MBED_TRACE_FEA_IPV6 == 1
@@ -499,3 +499,23 @@ TEST(trace, uninitialized)
     STRCMP_EQUAL("hello", buf);
 }
 
+TEST(trace, deferred)
+{
+    if (mbed_trace_deferred_set(true) != 0) {
+        return; // built without MBED_TRACE_DEFERRED_SIZE
+    }
+    buf[0] = 0;
+    mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", "hello %d %s %.1f", 12, "world", 5.5);
+    STRCMP_EQUAL("", buf);
+
+    CHECK(mbed_trace_deferred_flush() == 1);
+    STRCMP_EQUAL("hello 12 world 5.5", buf);
+    CHECK(mbed_trace_deferred_flush() == 0);
+
+    mbed_tracef(TRACE_LEVEL_CMD, "mygr", "command line");
+    STRCMP_EQUAL("command line", buf);
+
+    mbed_tracef(TRACE_LEVEL_DEBUG, "mygr", "last");
+    mbed_trace_deferred_set(false);
+    STRCMP_EQUAL("last", buf);
+}
@@ -21,6 +21,12 @@
  * nsdynmemlib provides access to one default heap, along with the ability to use extra user heaps.
  * ns_dyn_mem_alloc/free always access the default heap initialised by ns_dyn_mem_init.
  * ns_mem_alloc/free access a user heap initialised by ns_mem_init. User heaps are identified by a book-keeping pointer.
+ *
+ * By default free blocks are found by a first-fit search of the whole heap. Define NS_DYN_MEM_SEGREGATED_FIT
+ * to keep them in lists by size class instead, so that allocation and free take constant time on large,
+ * busy heaps. Temporary allocations then still take the start of a free block and long period ones its end,
+ * but not the start and end of the heap. The lists cost NS_DYN_MEM_HOLE_LIST_COUNT (default 16) list heads
+ * of heap; the last list holds all free blocks of 2^(NS_DYN_MEM_HOLE_LIST_COUNT-1) words or more.
  */
 
 #ifndef NSDYNMEMLIB_H_
@@ -19,6 +19,9 @@
 #include "platform/arm_hal_interrupt.h"
 #include <stdlib.h>
 #include "ns_list.h"
+#ifdef NS_DYN_MEM_SEGREGATED_FIT
+#include "common_functions.h"
+#endif
 
 #ifndef STANDARD_MALLOC
 typedef enum mem_stat_update_t {
@@ -33,13 +36,28 @@ typedef struct {
 
 typedef int ns_mem_word_size_t; // internal signed heap block size type
 
+#ifdef NS_DYN_MEM_SEGREGATED_FIT
+// Holes are kept in one list per size class: list n holds the holes of
+// 2^n to 2^(n+1)-1 words, the last list all larger ones, and bit n of
+// holes_map is set when list n isn't empty.
+#ifndef NS_DYN_MEM_HOLE_LIST_COUNT
+#define NS_DYN_MEM_HOLE_LIST_COUNT 16
+#endif
+#define HOLE_LIST_COUNT NS_DYN_MEM_HOLE_LIST_COUNT
+#endif
+
 /* struct for book keeping variables */
 struct ns_mem_book {
     ns_mem_word_size_t     *heap_main;
     ns_mem_word_size_t     *heap_main_end;
     mem_stat_t *mem_stat_info_ptr;
     void (*heap_failure_callback)(heap_fail_t);
+#ifdef NS_DYN_MEM_SEGREGATED_FIT
+    NS_LIST_HEAD(hole_t, link) holes_lists[HOLE_LIST_COUNT];
+    uint32_t holes_map;
+#else
     NS_LIST_HEAD(hole_t, link) holes_list;
+#endif
     ns_mem_heap_size_t heap_size;
     ns_mem_heap_size_t temporary_alloc_heap_limit;   /* Amount of reserved heap temporary alloc can't exceed */
 };
@@ -68,6 +86,67 @@ static void heap_failure(ns_mem_book_t *book, heap_fail_t reason)
     }
 }
 
+#ifdef NS_DYN_MEM_SEGREGATED_FIT
+static int8_t ns_mem_block_validate(ns_mem_word_size_t *block_start);
+
+static NS_INLINE uint_fast8_t hole_list_index(ns_mem_word_size_t size)
+{
+    uint_fast8_t n = 31 - common_count_leading_zeros_32((uint32_t) size);
+    return n < HOLE_LIST_COUNT ? n : HOLE_LIST_COUNT - 1;
+}
+
+// Hole size must be set in the block before adding it
+static void hole_list_add(ns_mem_book_t *book, ns_mem_word_size_t *block_start)
+{
+    uint_fast8_t n = hole_list_index(-*block_start);
+    ns_list_add_to_start(&book->holes_lists[n], hole_from_block_start(block_start));
+    book->holes_map |= (uint32_t) 1 << n;
+}
+
+// Hole size must still be the one it was added with
+static void hole_list_remove(ns_mem_book_t *book, ns_mem_word_size_t *block_start)
+{
+    uint_fast8_t n = hole_list_index(-*block_start);
+    ns_list_remove(&book->holes_lists[n], hole_from_block_start(block_start));
+    if (ns_list_is_empty(&book->holes_lists[n])) {
+        book->holes_map &= ~((uint32_t) 1 << n);
+    }
+}
+
+// Returns a hole of at least data_size words, or NULL
+static ns_mem_word_size_t *hole_list_find(ns_mem_book_t *book, ns_mem_word_size_t data_size)
+{
+    uint_fast8_t n = hole_list_index(data_size);
+    ns_mem_word_size_t *p = NULL;
+
+    // Any hole of a larger size class fits, so take the first one of the
+    // smallest non-empty class. Only if there is none, search the class
+    // of the request itself.
+    uint32_t map = book->holes_map & ~(((uint32_t) 2 << n) - 1);
+    if (map) {
+        hole_t *hole = ns_list_get_first(&book->holes_lists[31 - common_count_leading_zeros_32(map & (~map + 1))]);
+        p = block_start_from_hole(hole);
+        if (ns_mem_block_validate(p) != 0 || *p >= 0) {
+            heap_failure(book, NS_DYN_MEM_HEAP_SECTOR_CORRUPTED);
+            return NULL;
+        }
+        return p;
+    }
+
+    ns_list_foreach(hole_t, cur_hole, &book->holes_lists[n]) {
+        p = block_start_from_hole(cur_hole);
+        if (ns_mem_block_validate(p) != 0 || *p >= 0) {
+            heap_failure(book, NS_DYN_MEM_HEAP_SECTOR_CORRUPTED);
+            return NULL;
+        }
+        if (-*p >= data_size) {
+            return p;
+        }
+    }
+    return NULL;
+}
+#endif
+
 #endif
 
 void ns_dyn_mem_init(void *heap, ns_mem_heap_size_t h_size,
@@ -118,8 +197,16 @@ ns_mem_book_t *ns_mem_init(void *heap, ns_mem_heap_size_t h_size,
     *ptr = -(temp_int);
     book->heap_main_end = ptr;
 
+#ifdef NS_DYN_MEM_SEGREGATED_FIT
+    for (int i = 0; i < HOLE_LIST_COUNT; i++) {
+        ns_list_init(&book->holes_lists[i]);
+    }
+    book->holes_map = 0;
+    hole_list_add(book, book->heap_main);
+#else
     ns_list_init(&book->holes_list);
     ns_list_add_to_start(&book->holes_list, hole_from_block_start(book->heap_main));
+#endif
 
     book->mem_stat_info_ptr = info_ptr;
     //RESET Memory by Hea Len
@@ -264,6 +351,36 @@ static void *ns_mem_internal_alloc(ns_mem_book_t *book, const ns_mem_block_size_
         goto done;
     }
 
+#ifdef NS_DYN_MEM_SEGREGATED_FIT
+    block_ptr = hole_list_find(book, data_size);
+    if (!block_ptr) {
+        goto done;
+    }
+
+    // Separate declaration from initialization to keep IAR happy as the gotos skip this block.
+    ns_mem_word_size_t block_data_size;
+    block_data_size = -*block_ptr;
+    hole_list_remove(book, block_ptr);
+    if (block_data_size >= (data_size + 2 + HOLE_T_SIZE)) {
+        ns_mem_word_size_t hole_size = block_data_size - data_size - 2;
+        ns_mem_word_size_t *hole_ptr;
+        // Temporary allocations still take the start of the hole and long
+        // term ones its end
+        if (direction > 0) {
+            hole_ptr = block_ptr + 1 + data_size + 1;
+        } else {
+            hole_ptr = block_ptr;
+            block_ptr += 1 + hole_size + 1;
+        }
+
+        hole_ptr[0] = -hole_size;
+        hole_ptr[1 + hole_size] = -hole_size;
+        hole_list_add(book, hole_ptr);
+    } else {
+        // Not enough room for a left-over hole, so use the whole block
+        data_size = block_data_size;
+    }
+#else
     // ns_list_foreach, either forwards or backwards, result to ptr
     for (hole_t *cur_hole = direction > 0 ? ns_list_get_first(&book->holes_list)
                             : ns_list_get_last(&book->holes_list);
@@ -321,6 +438,7 @@ static void *ns_mem_internal_alloc(ns_mem_book_t *book, const ns_mem_block_size_
         data_size = block_data_size;
         ns_list_remove(&book->holes_list, hole_from_block_start(block_ptr));
     }
+#endif
     block_ptr[0] = data_size;
     block_ptr[1 + data_size] = data_size;
 
@@ -370,6 +488,55 @@ void *ns_dyn_mem_temporary_alloc(ns_mem_block_size_t alloc_size)
 }
 
 #ifndef STANDARD_MALLOC
+#ifdef NS_DYN_MEM_SEGREGATED_FIT
+static void ns_mem_free_and_merge_with_adjacent_blocks(ns_mem_book_t *book, ns_mem_word_size_t *cur_block, ns_mem_word_size_t data_size)
+{
+    // Same block format as below. The adjacent holes are taken off their
+    // lists, and the merged hole is added to the list of its size class.
+    ns_mem_word_size_t *start = cur_block;
+    ns_mem_word_size_t *end = cur_block + data_size + 1;
+    //invalidate current block
+    *start = -data_size;
+    *end = -data_size;
+    ns_mem_word_size_t merged_data_size = data_size;
+
+    if (start != book->heap_main && *(start - 1) < 0) {
+        ns_mem_word_size_t *block_end = start - 1;
+        ns_mem_word_size_t block_size = 1 + (-*block_end) + 1;
+        ns_mem_word_size_t *block_start = start - block_size;
+        if (*block_start != *block_end) {
+            heap_failure(book, NS_DYN_MEM_HEAP_SECTOR_CORRUPTED);
+            return;
+        }
+        if (block_size >= 1 + HOLE_T_SIZE + 1) {
+            hole_list_remove(book, block_start);
+        }
+        merged_data_size += block_size;
+        start = block_start;
+    }
+
+    if (end != book->heap_main_end && *(end + 1) < 0) {
+        ns_mem_word_size_t *block_start = end + 1;
+        ns_mem_word_size_t block_size = 1 + (-*block_start) + 1;
+        ns_mem_word_size_t *block_end = end + block_size;
+        if (*block_end != *block_start) {
+            heap_failure(book, NS_DYN_MEM_HEAP_SECTOR_CORRUPTED);
+            return;
+        }
+        if (block_size >= 1 + HOLE_T_SIZE + 1) {
+            hole_list_remove(book, block_start);
+        }
+        merged_data_size += block_size;
+        end = block_end;
+    }
+
+    *start = -merged_data_size;
+    *end = -merged_data_size;
+    if (merged_data_size >= HOLE_T_SIZE) {
+        hole_list_add(book, start);
+    }
+}
+#else
 static void ns_mem_free_and_merge_with_adjacent_blocks(ns_mem_book_t *book, ns_mem_word_size_t *cur_block, ns_mem_word_size_t data_size)
 {
     // Theory of operation: Block is always in form | Len | Data | Len |
@@ -456,6 +623,7 @@ static void ns_mem_free_and_merge_with_adjacent_blocks(ns_mem_book_t *book, ns_m
     *end = -merged_data_size;
 }
 #endif
+#endif
 
 void ns_mem_free(ns_mem_book_t *book, void *block)
 {
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2019 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "CppUTest/TestHarness.h"
+#include "nsdynmemLIB.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include "../nsdynmem/error_callback.h"
+
+TEST_GROUP(dynmem_segregated)
+{
+    void setup() {
+        reset_heap_error();
+    }
+
+    void teardown() {
+    }
+};
+
+TEST(dynmem_segregated, alloc_and_free_all)
+{
+    uint16_t size = 4000;
+    mem_stat_t info;
+    void *p[size];
+    uint8_t *heap = (uint8_t *)malloc(size);
+    CHECK(NULL != heap);
+    ns_dyn_mem_init(heap, size, &heap_fail_callback, &info);
+    CHECK(!heap_have_failed());
+    ns_mem_heap_size_t heap_size = info.heap_sector_size;
+
+    int i;
+    for (i = 0; i < size; i++) {
+        p[i] = (i & 1) ? ns_dyn_mem_alloc(1 + i % 50) : ns_dyn_mem_temporary_alloc(1 + i % 50);
+        if (!p[i]) {
+            break;
+        }
+    }
+    CHECK(!heap_have_failed());
+    CHECK(info.heap_sector_alloc_cnt == i);
+
+    // Free every other block first, so that the rest merge with holes
+    for (int j = 0; j < i; j += 2) {
+        ns_dyn_mem_free(p[j]);
+    }
+    for (int j = 1; j < i; j += 2) {
+        ns_dyn_mem_free(p[j]);
+    }
+    CHECK(!heap_have_failed());
+    CHECK(info.heap_sector_alloc_cnt == 0);
+    CHECK(info.heap_sector_allocated_bytes == 0);
+
+    // All holes merged back into one
+    void *all = ns_dyn_mem_alloc(heap_size - 2 * sizeof(int));
+    CHECK(all);
+    ns_dyn_mem_free(all);
+    CHECK(!heap_have_failed());
+    free(heap);
+}
+
+TEST(dynmem_segregated, temporary_below_long_term)
+{
+    uint16_t size = 1000;
+    mem_stat_t info;
+    uint8_t *heap = (uint8_t *)malloc(size);
+    CHECK(NULL != heap);
+    ns_dyn_mem_init(heap, size, &heap_fail_callback, &info);
+
+    uint8_t *temp = (uint8_t *)ns_dyn_mem_temporary_alloc(20);
+    uint8_t *long_term = (uint8_t *)ns_dyn_mem_alloc(20);
+    CHECK(temp && long_term);
+    CHECK(temp < long_term);
+
+    ns_dyn_mem_free(temp);
+    ns_dyn_mem_free(long_term);
+    CHECK(!heap_have_failed());
+    CHECK(info.heap_sector_alloc_cnt == 0);
+    free(heap);
+}
+
+TEST(dynmem_segregated, reuses_freed_block)
+{
+    uint16_t size = 1000;
+    mem_stat_t info;
+    uint8_t *heap = (uint8_t *)malloc(size);
+    CHECK(NULL != heap);
+    ns_dyn_mem_init(heap, size, &heap_fail_callback, &info);
+
+    // Fill the heap, then free one block in the middle
+    void *p1 = ns_dyn_mem_alloc(64);
+    void *p2 = ns_dyn_mem_alloc(64);
+    void *rest = ns_dyn_mem_alloc(info.heap_sector_size - info.heap_sector_allocated_bytes - 2 * sizeof(int));
+    CHECK(p1 && p2 && rest);
+    ns_dyn_mem_free(p2);
+
+    // Only the freed block can hold these
+    void *p3 = ns_dyn_mem_alloc(64);
+    CHECK(p3 == p2);
+    ns_dyn_mem_free(p3);
+    void *p4 = ns_dyn_mem_alloc(8);
+    CHECK(p4);
+    CHECK(NULL == ns_dyn_mem_alloc(64));
+    CHECK(info.heap_alloc_fail_cnt == 1);
+
+    ns_dyn_mem_free(p4);
+    ns_dyn_mem_free(p1);
+    ns_dyn_mem_free(rest);
+    CHECK(!heap_have_failed());
+    CHECK(info.heap_sector_alloc_cnt == 0);
+    free(heap);
+}
+
+TEST(dynmem_segregated, random_alloc_free)
+{
+    uint16_t size = 8000;
+    mem_stat_t info;
+    void *p[64] = { NULL };
+    uint8_t *heap = (uint8_t *)malloc(size);
+    CHECK(NULL != heap);
+    ns_dyn_mem_init(heap, size, &heap_fail_callback, &info);
+    srand(1);
+
+    for (int i = 0; i < 10000; i++) {
+        int n = rand() % 64;
+        if (p[n]) {
+            ns_dyn_mem_free(p[n]);
+            p[n] = NULL;
+        } else {
+            ns_mem_block_size_t len = 1 + rand() % 300;
+            p[n] = (rand() & 1) ? ns_dyn_mem_alloc(len) : ns_dyn_mem_temporary_alloc(len);
+        }
+        CHECK(!heap_have_failed());
+    }
+    for (int n = 0; n < 64; n++) {
+        ns_dyn_mem_free(p[n]);
+    }
+    CHECK(!heap_have_failed());
+    CHECK(info.heap_sector_alloc_cnt == 0);
+    CHECK(info.heap_sector_allocated_bytes == 0);
+    free(heap);
+}
+
+TEST(dynmem_segregated, double_free)
+{
+    uint16_t size = 1000;
+    mem_stat_t info;
+    uint8_t *heap = (uint8_t *)malloc(size);
+    void *p;
+    CHECK(NULL != heap);
+    ns_dyn_mem_init(heap, size, &heap_fail_callback, &info);
+    p = ns_dyn_mem_alloc(100);
+    CHECK(p);
+    ns_dyn_mem_free(p);
+    CHECK(!heap_have_failed());
+    ns_dyn_mem_free(p);
+    CHECK(heap_have_failed());
+    CHECK(NS_DYN_MEM_DOUBLE_FREE == current_heap_error);
+    free(heap);
+}
+
+TEST(dynmem_segregated, corrupted_hole)
+{
+    uint16_t size = 1000;
+    mem_stat_t info;
+    uint8_t *heap = (uint8_t *)malloc(size);
+    CHECK(NULL != heap);
+    ns_dyn_mem_init(heap, size, &heap_fail_callback, &info);
+    int *pt = (int *)ns_dyn_mem_alloc(8);
+    CHECK(!heap_have_failed());
+    // Overwrite the end length of the hole below
+    pt -= 2;
+    *pt = 0;
+    ns_dyn_mem_alloc(8);
+    CHECK(NS_DYN_MEM_HEAP_SECTOR_CORRUPTED == current_heap_error);
+    free(heap);
+}
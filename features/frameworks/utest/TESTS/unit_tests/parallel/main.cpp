@@ -0,0 +1,86 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "utest/utest.h"
+#include "unity/unity.h"
+#include "utest/utest_stack_trace.h"
+
+using namespace utest::v1;
+
+#define SLEEP_MS 100
+
+static volatile uint32_t call_counter = 0;
+
+static void test_sleep()
+{
+    UTEST_LOG_FUNCTION();
+    wait_ms(SLEEP_MS);
+    core_util_atomic_incr_u32(&call_counter, 1);
+}
+
+static const parallel_case_t sleep_cases[] = {
+    {"Sleep 1", test_sleep},
+    {"Sleep 2", test_sleep},
+    {"Sleep 3", test_sleep},
+    {"Sleep 4", test_sleep},
+};
+
+static const size_t sleep_count = sizeof(sleep_cases) / sizeof(sleep_cases[0]);
+
+void test_parallel()
+{
+    UTEST_LOG_FUNCTION();
+    Timer timer;
+    timer.start();
+    run_parallel(sleep_cases, sleep_count);
+    int elapsed_ms = timer.read_ms();
+
+    TEST_ASSERT_EQUAL(sleep_count, call_counter);
+    TEST_ASSERT(elapsed_ms >= SLEEP_MS);
+#if MBED_CONF_RTOS_PRESENT && (MBED_CONF_UTEST_PARALLEL_THREADS > 1)
+    // The cases sleep concurrently
+    TEST_ASSERT(elapsed_ms < (int)(sleep_count * SLEEP_MS));
+#endif
+}
+
+void test_parallel_empty()
+{
+    UTEST_LOG_FUNCTION();
+    call_counter = 0;
+    run_parallel(sleep_cases, 0);
+    TEST_ASSERT_EQUAL(0, call_counter);
+}
+
+utest::v1::status_t greentea_setup(const size_t number_of_cases)
+{
+    UTEST_LOG_FUNCTION();
+    GREENTEA_SETUP(20, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Parallel cases", test_parallel),
+    Case("Parallel without cases", test_parallel_empty),
+};
+
+Specification specification(greentea_setup, cases);
+
+int main()
+{
+    UTEST_LOG_FUNCTION();
+    Harness::run(specification);
+}
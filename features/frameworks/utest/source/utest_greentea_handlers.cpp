@@ -21,9 +21,15 @@
 #include "greentea-client/test_env.h"
 #include "utest/utest_stack_trace.h"
 #include "utest/utest_serial.h"
+#include "hal/us_ticker_api.h"
+#include "platform/mbed_stats.h"
 
 using namespace utest::v1;
 
+#if MBED_CONF_UTEST_CASE_TIMING
+static case_timing_t case_timing;
+#endif
+
 static void selftest_failure_handler(const failure_t);
 static void test_failure_handler(const failure_t);
 
@@ -87,6 +93,38 @@ void utest::v1::greentea_testcase_notification_handler(const char *testcase)
     greentea_send_kv(GREENTEA_TEST_ENV_TESTCASE_NAME, testcase);
 }
 
+void utest::v1::greentea_case_timing_start(case_timing_t *timing)
+{
+    UTEST_LOG_FUNCTION();
+    mbed_stats_heap_t heap_stats;
+    mbed_stats_stack_t stack_stats;
+    mbed_stats_heap_get(&heap_stats);
+    mbed_stats_stack_get(&stack_stats);
+
+    timing->heap_size = heap_stats.current_size;
+    timing->stack_size = stack_stats.max_size;
+    timing->start_us = ticker_read_us(get_us_ticker_data());
+}
+
+void utest::v1::greentea_case_timing_report(const char *description, const case_timing_t *timing)
+{
+    UTEST_LOG_FUNCTION();
+    uint64_t duration_us = ticker_read_us(get_us_ticker_data()) - timing->start_us;
+
+    mbed_stats_heap_t heap_stats;
+    mbed_stats_stack_t stack_stats;
+    mbed_stats_heap_get(&heap_stats);
+    mbed_stats_stack_get(&stack_stats);
+
+    // The stack growth is the growth of the high water marks of all threads
+    char result[128];
+    snprintf(result, sizeof(result), "%s,us=%lu,heap_delta=%ld,stack_delta=%lu",
+             description, (unsigned long)duration_us,
+             (long)((int32_t)(heap_stats.current_size - timing->heap_size)),
+             (unsigned long)(stack_stats.max_size - timing->stack_size));
+    greentea_send_kv("testcase_timing", result);
+}
+
 utest::v1::status_t utest::v1::default_greentea_test_setup_handler(const size_t number_of_cases)
 {
     UTEST_LOG_FUNCTION();
@@ -123,12 +161,18 @@ utest::v1::status_t utest::v1::greentea_case_setup_handler(const Case *const sou
     UTEST_LOG_FUNCTION();
     utest::v1::status_t status = verbose_case_setup_handler(source, index_of_case);
     greentea_send_kv(TEST_ENV_TESTCASE_START, source->get_description());
+#if MBED_CONF_UTEST_CASE_TIMING
+    greentea_case_timing_start(&case_timing);
+#endif
     return status;
 }
 
 utest::v1::status_t utest::v1::greentea_case_teardown_handler(const Case *const source, const size_t passed, const size_t failed, const failure_t failure)
 {
     UTEST_LOG_FUNCTION();
+#if MBED_CONF_UTEST_CASE_TIMING
+    greentea_case_timing_report(source->get_description(), &case_timing);
+#endif
     greentea_send_kv(TEST_ENV_TESTCASE_FINISH, source->get_description(), passed, failed);
     return verbose_case_teardown_handler(source, passed, failed, failure);
 }
@@ -0,0 +1,124 @@
+/****************************************************************************
+ * Copyright (c) 2019, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ****************************************************************************
+ */
+
+#include "utest/utest_parallel.h"
+#include "utest/utest_default_handlers.h"
+#include "utest/utest_harness.h"
+#include "utest/utest_stack_trace.h"
+
+#if MBED_CONF_RTOS_PRESENT
+#include "rtos/Thread.h"
+#include "rtos/Mutex.h"
+#include "platform/SingletonPtr.h"
+#include <new>
+#endif
+
+using namespace utest::v1;
+
+namespace
+{
+    const parallel_case_t *parallel_cases = NULL;
+    size_t parallel_count = 0;
+    size_t parallel_next = 0;
+
+#if MBED_CONF_RTOS_PRESENT
+    // Hands out the cases and serializes the reports on the serial port
+    SingletonPtr<rtos::Mutex> parallel_mutex;
+#endif
+}
+
+static void parallel_lock()
+{
+#if MBED_CONF_RTOS_PRESENT
+    parallel_mutex->lock();
+#endif
+}
+
+static void parallel_unlock()
+{
+#if MBED_CONF_RTOS_PRESENT
+    parallel_mutex->unlock();
+#endif
+}
+
+static void parallel_worker()
+{
+    UTEST_LOG_FUNCTION();
+    while (true) {
+        parallel_lock();
+        size_t index = parallel_next++;
+        parallel_unlock();
+        if (index >= parallel_count) {
+            return;
+        }
+
+        const parallel_case_t *parallel_case = &parallel_cases[index];
+#if MBED_CONF_UTEST_CASE_TIMING
+        case_timing_t timing;
+        greentea_case_timing_start(&timing);
+#endif
+        if (parallel_case->handler) {
+            parallel_case->handler();
+        } else {
+            Harness::raise_failure(REASON_EMPTY_CASE);
+        }
+#if MBED_CONF_UTEST_CASE_TIMING
+        parallel_lock();
+        greentea_case_timing_report(parallel_case->description, &timing);
+        parallel_unlock();
+#endif
+    }
+}
+
+void utest::v1::run_parallel(const parallel_case_t *cases, size_t count)
+{
+    UTEST_LOG_FUNCTION();
+    parallel_cases = cases;
+    parallel_count = count;
+    parallel_next = 0;
+
+#if MBED_CONF_RTOS_PRESENT
+    // The calling thread is one of the threads running the cases
+    size_t thread_count = (count < MBED_CONF_UTEST_PARALLEL_THREADS) ? count : MBED_CONF_UTEST_PARALLEL_THREADS;
+    thread_count = thread_count ? thread_count - 1 : 0;
+
+    // Threads that can't be created leave their cases to the others
+    rtos::Thread *threads[MBED_CONF_UTEST_PARALLEL_THREADS] = { NULL };
+    for (size_t i = 0; i < thread_count; i++) {
+        threads[i] = new (std::nothrow) rtos::Thread(osPriorityNormal, MBED_CONF_UTEST_PARALLEL_STACK_SIZE);
+        if (threads[i] && threads[i]->start(parallel_worker) != osOK) {
+            delete threads[i];
+            threads[i] = NULL;
+        }
+    }
+
+    parallel_worker();
+
+    for (size_t i = 0; i < thread_count; i++) {
+        if (threads[i]) {
+            threads[i]->join();
+            delete threads[i];
+        }
+    }
+#else
+    parallel_worker();
+#endif
+
+    parallel_cases = NULL;
+    parallel_count = 0;
+}
@@ -27,6 +27,7 @@
 #include "utest/utest_default_handlers.h"
 #include "utest/utest_harness.h"
 #include "utest/utest_serial.h"
+#include "utest/utest_parallel.h"
 
 #endif // UTEST_H
 
@@ -182,6 +182,19 @@ namespace v1 {
     /// Notify greentea of testcase name.
     void greentea_testcase_notification_handler(const char *testcase);
 
+    /// Time and memory use at the start of a test case
+    struct case_timing_t {
+        uint64_t start_us;
+        uint32_t heap_size;
+        uint32_t stack_size;
+    };
+
+    /// Records the time and memory use at the start of a test case.
+    void greentea_case_timing_start(case_timing_t *timing);
+    /// Reports the duration and the heap and stack growth of a test case to greentea.
+    /// Heap and stack growth are 0 unless the mbed heap and stack stats are enabled.
+    void greentea_case_timing_report(const char *description, const case_timing_t *timing);
+
     /// The verbose default handlers that always continue on failure
     extern const handlers_t verbose_continue_handlers;
 
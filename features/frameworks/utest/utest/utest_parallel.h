@@ -0,0 +1,61 @@
+/****************************************************************************
+ * Copyright (c) 2019, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ****************************************************************************
+ */
+
+#ifndef UTEST_PARALLEL_H
+#define UTEST_PARALLEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "utest/utest_types.h"
+
+
+namespace utest {
+/** \addtogroup frameworks */
+/** @{*/
+namespace v1 {
+
+    /// Independent test case run by `run_parallel()`
+    struct parallel_case_t
+    {
+        const char *description;
+        case_handler_t handler;
+    };
+
+    /** Runs independent test case handlers concurrently.
+     *
+     * Call this from a case handler to run a group of handlers that share no
+     * state, for example handlers testing different peripherals, on
+     * `utest.parallel-threads` threads: the calling thread and RTOS threads
+     * of `utest.parallel-stack-size` bytes. It returns once all handlers have
+     * returned. Without an RTOS the handlers run one after the other.
+     *
+     * Failures are raised as failures of the calling case. With
+     * `utest.case-timing` set, the duration of each handler is reported like
+     * the one of a case.
+     *
+     * @param cases     the handlers to run
+     * @param count     the number of handlers
+     */
+    void run_parallel(const parallel_case_t *cases, size_t count);
+
+}   // namespace v1
+}   // namespace utest
+
+#endif // UTEST_PARALLEL_H
+
+/** @}*/
@@ -308,6 +308,10 @@ public:
      *
      *                      All flags are mutually exclusive, and MSG_MULTICAST_FLAG cannot be set.
      *
+     *                      With lora.uplink-coalescing enabled, unconfirmed messages sent to the same port
+     *                      while another TX is ongoing are queued and sent together in the next uplink,
+     *                      as long as they fit in one frame.
+     *
      * @return              The number of bytes sent, or a negative error code on failure:
      *                      LORAWAN_STATUS_NOT_INITIALIZED   if system is not initialized with initialize(),
      *                      LORAWAN_STATUS_NO_ACTIVE_SESSIONS if connection is not open,
@@ -74,6 +74,10 @@ LoRaWANStack::LoRaWANStack()
       _link_check_requested(false),
       _automatic_uplink_ongoing(false),
       _queue(NULL)
+#if MBED_CONF_LORA_UPLINK_COALESCING
+    , _tx_batch_length(0),
+      _tx_batch_port(INVALID_PORT)
+#endif
 {
     _tx_metadata.stale = true;
     _rx_metadata.stale = true;
@@ -275,6 +279,10 @@ lorawan_status_t LoRaWANStack::stop_sending(void)
 
     lorawan_status_t status = _loramac.clear_tx_pipe();
 
+#if MBED_CONF_LORA_UPLINK_COALESCING
+    _tx_batch_length = 0;
+#endif
+
     if (status == LORAWAN_STATUS_OK) {
         _ctrl_flags &= ~TX_DONE_FLAG;
         _loramac.set_tx_ongoing(false);
@@ -302,9 +310,23 @@ int16_t LoRaWANStack::handle_tx(const uint8_t port, const uint8_t *data,
     }
 
     if (_loramac.tx_ongoing()) {
+#if MBED_CONF_LORA_UPLINK_COALESCING
+        return coalesce_tx(port, data, length, flags);
+#else
         return LORAWAN_STATUS_WOULD_BLOCK;
+#endif
     }
 
+#if MBED_CONF_LORA_UPLINK_COALESCING
+    // Messages queued during the previous uplink go first, this one with
+    // them if it fits
+    if (_tx_batch_length > 0 && !allow_port_0) {
+        const int16_t ret = coalesce_tx(port, data, length, flags);
+        send_coalesced_uplink();
+        return ret;
+    }
+#endif
+
     // add a link check request with normal data, until the application
     // explicitly removes it.
     if (_link_check_requested) {
@@ -857,6 +879,65 @@ void LoRaWANStack::send_automatic_uplink_message(const uint8_t port)
     }
 }
 
+#if MBED_CONF_LORA_UPLINK_COALESCING
+int16_t LoRaWANStack::coalesce_tx(const uint8_t port, const uint8_t *data,
+                                  uint16_t length, uint8_t flags)
+{
+    if ((flags & MSG_FLAG_MASK) != MSG_UNCONFIRMED_FLAG || !data || length == 0
+            || !is_port_valid(port) || !_loramac.nwk_joined()) {
+        return LORAWAN_STATUS_WOULD_BLOCK;
+    }
+
+    if (_tx_batch_length > 0 && port != _tx_batch_port) {
+        return LORAWAN_STATUS_WOULD_BLOCK;
+    }
+
+    uint16_t max_size = _loramac.get_max_tx_payload_size();
+    if (max_size > MBED_CONF_LORA_TX_MAX_SIZE) {
+        max_size = MBED_CONF_LORA_TX_MAX_SIZE;
+    }
+
+    if (_tx_batch_length + length > max_size) {
+        return LORAWAN_STATUS_WOULD_BLOCK;
+    }
+
+    memcpy(_tx_batch + _tx_batch_length, data, length);
+    _tx_batch_length += length;
+    _tx_batch_port = port;
+
+    tr_debug("Queued %u bytes for the next uplink, %u in total", length, _tx_batch_length);
+
+    return length;
+}
+
+void LoRaWANStack::send_coalesced_uplink(void)
+{
+    if (_tx_batch_length == 0 || _loramac.tx_ongoing()) {
+        return;
+    }
+
+    // handle_tx() copies the data before returning, so the batch buffer
+    // can be refilled right away
+    const uint16_t length = _tx_batch_length;
+    _tx_batch_length = 0;
+
+    const int16_t ret = handle_tx(_tx_batch_port, _tx_batch, length, MSG_UNCONFIRMED_FLAG);
+    if (ret >= 0) {
+        // More MAC commands may have been queued since, keep what didn't fit
+        // for the next uplink
+        if (ret < length) {
+            memmove(_tx_batch, _tx_batch + ret, length - ret);
+            _tx_batch_length = length - ret;
+        }
+    } else if (ret == LORAWAN_STATUS_WOULD_BLOCK) {
+        _tx_batch_length = length;
+    } else {
+        tr_error("Failed to send queued uplink messages, error code = %d", ret);
+        send_event_to_application(TX_SCHEDULING_ERROR);
+    }
+}
+#endif
+
 int LoRaWANStack::convert_to_msg_flag(const mcps_type_t type)
 {
     int msg_flag = MSG_UNCONFIRMED_FLAG;
@@ -1121,6 +1202,9 @@ void LoRaWANStack::process_shutdown_state(lorawan_status_t &op_status)
     drop_channel_list();
     _loramac.disconnect();
     _lw_session.active = false;
+#if MBED_CONF_LORA_UPLINK_COALESCING
+    _tx_batch_length = 0;
+#endif
     _device_current_state = DEVICE_STATE_SHUTDOWN;
     op_status = LORAWAN_STATUS_DEVICE_OFF;
     _ctrl_flags = 0;
@@ -1165,6 +1249,14 @@ void LoRaWANStack::process_status_check_state()
             mcps_indication_handler();
         }
     }
+
+#if MBED_CONF_LORA_UPLINK_COALESCING
+    if (_tx_batch_length > 0 && !_loramac.tx_ongoing()) {
+        const int ret = _queue->call(this, &LoRaWANStack::send_coalesced_uplink);
+        MBED_ASSERT(ret != 0);
+        (void)ret;
+    }
+#endif
 }
 
 void LoRaWANStack::process_scheduling_state(lorawan_status_t &op_status)
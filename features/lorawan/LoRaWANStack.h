@@ -460,6 +460,23 @@ private:
      */
     void send_automatic_uplink_message(uint8_t port);
 
+#if MBED_CONF_LORA_UPLINK_COALESCING
+    /** Queue a message for the uplink after the ongoing one.
+     *
+     * Only unconfirmed messages to the same port are queued together, as
+     * long as they fit in one frame at the current datarate.
+     *
+     * @return                 The length of the message if queued,
+     *                         LORAWAN_STATUS_WOULD_BLOCK otherwise.
+     */
+    int16_t coalesce_tx(uint8_t port, const uint8_t *data, uint16_t length,
+                        uint8_t flags);
+
+    /** Send the queued messages in one uplink.
+     */
+    void send_coalesced_uplink(void);
+#endif
+
     /**
      * TX interrupt handlers and corresponding processors
      */
@@ -509,6 +526,11 @@ private:
     uint8_t _rx_payload[LORAMAC_PHY_MAXPAYLOAD];
     events::EventQueue *_queue;
     lorawan_time_t _tx_timestamp;
+#if MBED_CONF_LORA_UPLINK_COALESCING
+    uint8_t _tx_batch[MBED_CONF_LORA_TX_MAX_SIZE];
+    uint16_t _tx_batch_length;
+    uint8_t _tx_batch_port;
+#endif
 };
 
 #endif /* LORAWANSTACK_H_ */
@@ -1282,6 +1282,16 @@ bool LoRaMac::tx_ongoing()
     return _ongoing_tx_msg.tx_ongoing;
 }
 
+uint8_t LoRaMac::get_max_tx_payload_size()
+{
+    uint8_t fopts_len = _mac_commands.get_mac_cmd_length()
+                        + _mac_commands.get_repeat_commands_length();
+    uint8_t max_size = _lora_phy->get_max_payload(_params.sys_params.channel_data_rate,
+                                                  _params.is_repeater_supported);
+
+    return (max_size > fopts_len) ? max_size - fopts_len : 0;
+}
+
 void LoRaMac::set_tx_ongoing(bool ongoing)
 {
     _can_cancel_tx = true;
@@ -249,6 +249,14 @@ public:
      */
     bool tx_ongoing();
 
+    /**
+     * @brief get_max_tx_payload_size Queries the FRMPayload size an uplink at the
+     *                                current datarate has room for, next to the
+     *                                MAC commands already queued.
+     * @return Size in bytes.
+     */
+    uint8_t get_max_tx_payload_size();
+
     /**
      * @brief set_tx_ongoing Changes the ongoing status for prepared message.
      * @param ongoing The value indicating the status.
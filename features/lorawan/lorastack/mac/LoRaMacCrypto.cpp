@@ -25,6 +25,7 @@
 
 #include <stdlib.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "LoRaMacCrypto.h"
 #include "system/lorawan_data_structures.h"
@@ -34,6 +35,8 @@
 #if defined(MBEDTLS_CMAC_C) && defined(MBEDTLS_AES_C) && defined(MBEDTLS_CIPHER_C)
 
 LoRaMacCrypto::LoRaMacCrypto()
+    : aes_key_length(0),
+      cmac_key_length(0)
 {
 #if defined(MBEDTLS_PLATFORM_C)
     int ret = mbedtls_platform_setup(NULL);
@@ -41,15 +44,76 @@ LoRaMacCrypto::LoRaMacCrypto()
         MBED_ASSERT(0 && "LoRaMacCrypto: Fail in mbedtls_platform_setup.");
     }
 #endif /* MBEDTLS_PLATFORM_C */
+
+    mbedtls_aes_init(&aes_ctx);
+    mbedtls_cipher_init(aes_cmac_ctx);
 }
 
 LoRaMacCrypto::~LoRaMacCrypto()
 {
+    mbedtls_cipher_free(aes_cmac_ctx);
+    mbedtls_aes_free(&aes_ctx);
+
 #if defined(MBEDTLS_PLATFORM_C)
     mbedtls_platform_teardown(NULL);
 #endif /* MBEDTLS_PLATFORM_C */
 }
 
+int LoRaMacCrypto::set_aes_key(const uint8_t *key, uint32_t key_length)
+{
+    int ret = 0;
+
+    // Session keys stay the same for many frames, so keep the key schedule
+    if (key != NULL && aes_key_length == key_length
+            && memcmp(aes_key, key, key_length / 8) == 0) {
+        return 0;
+    }
+
+    aes_key_length = 0;
+    mbedtls_aes_free(&aes_ctx);
+    mbedtls_aes_init(&aes_ctx);
+
+    ret = mbedtls_aes_setkey_enc(&aes_ctx, key, key_length);
+    if (0 == ret && key != NULL && key_length <= sizeof(aes_key) * 8) {
+        memcpy(aes_key, key, key_length / 8);
+        aes_key_length = key_length;
+    }
+
+    return ret;
+}
+
+int LoRaMacCrypto::start_cmac(const uint8_t *key, uint32_t key_length)
+{
+    int ret = 0;
+
+    if (key != NULL && cmac_key_length == key_length
+            && memcmp(cmac_key, key, key_length / 8) == 0) {
+        return mbedtls_cipher_cmac_reset(aes_cmac_ctx);
+    }
+
+    cmac_key_length = 0;
+    mbedtls_cipher_free(aes_cmac_ctx);
+    mbedtls_cipher_init(aes_cmac_ctx);
+
+    const mbedtls_cipher_info_t *cipher_info = mbedtls_cipher_info_from_type(MBEDTLS_CIPHER_AES_128_ECB);
+    if (NULL == cipher_info) {
+        return MBEDTLS_ERR_CIPHER_ALLOC_FAILED;
+    }
+
+    ret = mbedtls_cipher_setup(aes_cmac_ctx, cipher_info);
+    if (0 != ret) {
+        return ret;
+    }
+
+    ret = mbedtls_cipher_cmac_starts(aes_cmac_ctx, key, key_length);
+    if (0 == ret && key != NULL && key_length <= sizeof(cmac_key) * 8) {
+        memcpy(cmac_key, key, key_length / 8);
+        cmac_key_length = key_length;
+    }
+
+    return ret;
+}
+
 int LoRaMacCrypto::compute_mic(const uint8_t *buffer, uint16_t size,
                                const uint8_t *key, const uint32_t key_length,
                                uint32_t address, uint8_t dir, uint32_t seq_counter,
@@ -75,45 +139,30 @@ int LoRaMacCrypto::compute_mic(const uint8_t *buffer, uint16_t size,
 
     mic_block_b0[15] = size & 0xFF;
 
-    mbedtls_cipher_init(aes_cmac_ctx);
-
-    const mbedtls_cipher_info_t *cipher_info = mbedtls_cipher_info_from_type(MBEDTLS_CIPHER_AES_128_ECB);
-
-    if (NULL != cipher_info) {
-        ret = mbedtls_cipher_setup(aes_cmac_ctx, cipher_info);
-        if (0 != ret) {
-            goto exit;
-        }
-
-        ret = mbedtls_cipher_cmac_starts(aes_cmac_ctx, key, key_length);
-        if (0 != ret) {
-            goto exit;
-        }
-
-        ret = mbedtls_cipher_cmac_update(aes_cmac_ctx, mic_block_b0, sizeof(mic_block_b0));
-        if (0 != ret) {
-            goto exit;
-        }
+    ret = start_cmac(key, key_length);
+    if (0 != ret) {
+        return ret;
+    }
 
-        ret = mbedtls_cipher_cmac_update(aes_cmac_ctx, buffer, size & 0xFF);
-        if (0 != ret) {
-            goto exit;
-        }
+    ret = mbedtls_cipher_cmac_update(aes_cmac_ctx, mic_block_b0, sizeof(mic_block_b0));
+    if (0 != ret) {
+        return ret;
+    }
 
-        ret = mbedtls_cipher_cmac_finish(aes_cmac_ctx, computed_mic);
-        if (0 != ret) {
-            goto exit;
-        }
+    ret = mbedtls_cipher_cmac_update(aes_cmac_ctx, buffer, size & 0xFF);
+    if (0 != ret) {
+        return ret;
+    }
 
-        *mic = (uint32_t)((uint32_t) computed_mic[3] << 24
-                          | (uint32_t) computed_mic[2] << 16
-                          | (uint32_t) computed_mic[1] << 8 | (uint32_t) computed_mic[0]);
-    } else {
-        ret = MBEDTLS_ERR_CIPHER_ALLOC_FAILED;
+    ret = mbedtls_cipher_cmac_finish(aes_cmac_ctx, computed_mic);
+    if (0 != ret) {
+        return ret;
     }
 
-exit:
-    mbedtls_cipher_free(aes_cmac_ctx);
+    *mic = (uint32_t)((uint32_t) computed_mic[3] << 24
+                      | (uint32_t) computed_mic[2] << 16
+                      | (uint32_t) computed_mic[1] << 8 | (uint32_t) computed_mic[0]);
+
     return ret;
 }
 
@@ -129,10 +178,9 @@ int LoRaMacCrypto::encrypt_payload(const uint8_t *buffer, uint16_t size,
     uint8_t a_block[16] = {};
     uint8_t s_block[16] = {};
 
-    mbedtls_aes_init(&aes_ctx);
-    ret = mbedtls_aes_setkey_enc(&aes_ctx, key, key_length);
+    ret = set_aes_key(key, key_length);
     if (0 != ret) {
-        goto exit;
+        return ret;
     }
 
     a_block[0] = 0x01;
@@ -178,7 +226,6 @@ int LoRaMacCrypto::encrypt_payload(const uint8_t *buffer, uint16_t size,
     }
 
 exit:
-    mbedtls_aes_free(&aes_ctx);
     return ret;
 }
 
@@ -198,39 +245,25 @@ int LoRaMacCrypto::compute_join_frame_mic(const uint8_t *buffer, uint16_t size,
     uint8_t computed_mic[16] = {};
     int ret = 0;
 
-    mbedtls_cipher_init(aes_cmac_ctx);
-    const mbedtls_cipher_info_t *cipher_info = mbedtls_cipher_info_from_type(MBEDTLS_CIPHER_AES_128_ECB);
-
-    if (NULL != cipher_info) {
-        ret = mbedtls_cipher_setup(aes_cmac_ctx, cipher_info);
-        if (0 != ret) {
-            goto exit;
-        }
-
-        ret = mbedtls_cipher_cmac_starts(aes_cmac_ctx, key, key_length);
-        if (0 != ret) {
-            goto exit;
-        }
-
-        ret = mbedtls_cipher_cmac_update(aes_cmac_ctx, buffer, size & 0xFF);
-        if (0 != ret) {
-            goto exit;
-        }
+    ret = start_cmac(key, key_length);
+    if (0 != ret) {
+        return ret;
+    }
 
-        ret = mbedtls_cipher_cmac_finish(aes_cmac_ctx, computed_mic);
-        if (0 != ret) {
-            goto exit;
-        }
+    ret = mbedtls_cipher_cmac_update(aes_cmac_ctx, buffer, size & 0xFF);
+    if (0 != ret) {
+        return ret;
+    }
 
-        *mic = (uint32_t)((uint32_t) computed_mic[3] << 24
-                          | (uint32_t) computed_mic[2] << 16
-                          | (uint32_t) computed_mic[1] << 8 | (uint32_t) computed_mic[0]);
-    } else {
-        ret = MBEDTLS_ERR_CIPHER_ALLOC_FAILED;
+    ret = mbedtls_cipher_cmac_finish(aes_cmac_ctx, computed_mic);
+    if (0 != ret) {
+        return ret;
     }
 
-exit:
-    mbedtls_cipher_free(aes_cmac_ctx);
+    *mic = (uint32_t)((uint32_t) computed_mic[3] << 24
+                      | (uint32_t) computed_mic[2] << 16
+                      | (uint32_t) computed_mic[1] << 8 | (uint32_t) computed_mic[0]);
+
     return ret;
 }
 
@@ -240,11 +273,9 @@ int LoRaMacCrypto::decrypt_join_frame(const uint8_t *buffer, uint16_t size,
 {
     int ret = 0;
 
-    mbedtls_aes_init(&aes_ctx);
-
-    ret = mbedtls_aes_setkey_enc(&aes_ctx, key, key_length);
+    ret = set_aes_key(key, key_length);
     if (0 != ret) {
-        goto exit;
+        return ret;
     }
 
     ret = mbedtls_aes_crypt_ecb(&aes_ctx, MBEDTLS_AES_ENCRYPT, buffer,
@@ -260,7 +291,6 @@ int LoRaMacCrypto::decrypt_join_frame(const uint8_t *buffer, uint16_t size,
     }
 
 exit:
-    mbedtls_aes_free(&aes_ctx);
     return ret;
 }
 
@@ -272,11 +302,9 @@ int LoRaMacCrypto::compute_skeys_for_join_frame(const uint8_t *key, uint32_t key
     uint8_t *p_dev_nonce = (uint8_t *) &dev_nonce;
     int ret = 0;
 
-    mbedtls_aes_init(&aes_ctx);
-
-    ret = mbedtls_aes_setkey_enc(&aes_ctx, key, key_length);
+    ret = set_aes_key(key, key_length);
     if (0 != ret) {
-        goto exit;
+        return ret;
     }
 
     memset(nonce, 0, sizeof(nonce));
@@ -295,7 +323,6 @@ int LoRaMacCrypto::compute_skeys_for_join_frame(const uint8_t *key, uint32_t key
     ret = mbedtls_aes_crypt_ecb(&aes_ctx, MBEDTLS_AES_ENCRYPT, nonce, app_skey);
 
 exit:
-    mbedtls_aes_free(&aes_ctx);
     return ret;
 }
 #else
@@ -152,15 +152,49 @@ public:
                                      uint8_t *nwk_skey, uint8_t *app_skey);
 
 private:
+    /**
+     * Sets up the AES context for the given key, unless it already holds
+     * the key schedule for it
+     *
+     * @param [in]  key             - AES key to be used
+     * @param [in]  key_length      - Length of the key (bits)
+     *
+     * @return                        0 if successful, or a cipher specific error code
+     */
+    int set_aes_key(const uint8_t *key, uint32_t key_length);
+
+    /**
+     * Starts a CMAC computation with the given key. The cipher context is
+     * only set up again when the key differs from the previous one.
+     *
+     * @param [in]  key             - AES key to be used
+     * @param [in]  key_length      - Length of the key (bits)
+     *
+     * @return                        0 if successful, or a cipher specific error code
+     */
+    int start_cmac(const uint8_t *key, uint32_t key_length);
+
     /**
      * AES computation context variable
      */
     mbedtls_aes_context aes_ctx;
 
+    /**
+     * Key the AES context is set up with, valid if aes_key_length is non-zero
+     */
+    uint8_t aes_key[32];
+    uint32_t aes_key_length;
+
     /**
      * CMAC computation context variable
      */
     mbedtls_cipher_context_t aes_cmac_ctx[1];
+
+    /**
+     * Key the CMAC context is set up with, valid if cmac_key_length is non-zero
+     */
+    uint8_t cmac_key[32];
+    uint32_t cmac_key_length;
 };
 
 #endif // MBED_LORAWAN_MAC_LORAMAC_CRYPTO_H__
@@ -40,6 +40,22 @@
 
 #include "LWIPStack.h"
 
+#if LWIP_DHCP && MBED_CONF_LWIP_DHCP_LEASE_PERSIST
+#include "kvstore_global_api.h"
+#include "mbed_error.h"
+
+#define DHCP_LEASE_KEY_SIZE 24
+
+// The lease is only reused by the interface with the same hardware address
+typedef struct {
+    u8_t hwaddr[NETIF_MAX_HWADDR_LEN];
+    u32_t addr;
+    u32_t server;
+    u32_t lease_time;
+    u32_t dns[2];
+} dhcp_lease_t;
+#endif
+
 LWIP::Interface *LWIP::Interface::list;
 
 LWIP::Interface *LWIP::Interface::our_if_from_netif(struct netif *netif)
@@ -141,13 +157,85 @@ void LWIP::add_dns_addr(struct netif *lwip_netif)
 #endif
 }
 
+#if LWIP_DHCP && MBED_CONF_LWIP_DHCP_LEASE_PERSIST
+static void dhcp_lease_key(const struct netif *netif, char *key)
+{
+    snprintf(key, DHCP_LEASE_KEY_SIZE, "/kv/lwip_dhcp_%c%c%u", netif->name[0], netif->name[1], netif->num);
+}
+
+void LWIP::Interface::load_dhcp_lease()
+{
+    char key[DHCP_LEASE_KEY_SIZE];
+    dhcp_lease_t lease;
+    size_t size = 0;
+
+    ip4_addr_set_any(&dhcp_lease_addr);
+    dhcp_lease_key(&netif, key);
+    if (kv_get(key, &lease, sizeof(lease), &size) != MBED_SUCCESS || size != sizeof(lease) ||
+            memcmp(lease.hwaddr, netif.hwaddr, netif.hwaddr_len) != 0) {
+        return;
+    }
+
+    ip4_addr_set_u32(&dhcp_lease_addr, lease.addr);
+    // The servers of the lease are usable as soon as the server acknowledges it
+    for (u8_t i = 0; i < LWIP_ARRAYSIZE(lease.dns) && i < DNS_MAX_SERVERS; i++) {
+        if (lease.dns[i] && ip_addr_isany(dns_getserver(i))) {
+            ip_addr_t dns_addr;
+            ip_addr_set_ip4_u32(&dns_addr, lease.dns[i]);
+            dns_setserver(i, &dns_addr);
+        }
+    }
+}
+
+void LWIP::Interface::save_dhcp_lease()
+{
+    struct dhcp *dhcp = netif_dhcp_data(&netif);
+    if (!dhcp || !dhcp_supplied_address(&netif)) {
+        return;
+    }
+
+    dhcp_lease_t lease;
+    memset(&lease, 0, sizeof(lease));
+    memcpy(lease.hwaddr, netif.hwaddr, netif.hwaddr_len);
+    lease.addr = ip4_addr_get_u32(&dhcp->offered_ip_addr);
+    lease.server = ip4_addr_get_u32(ip_2_ip4(&dhcp->server_ip_addr));
+    lease.lease_time = dhcp->offered_t0_lease;
+    for (u8_t i = 0; i < LWIP_ARRAYSIZE(lease.dns) && i < DNS_MAX_SERVERS; i++) {
+        const ip_addr_t *dns_addr = dns_getserver(i);
+        if (IP_IS_V4(dns_addr)) {
+            lease.dns[i] = ip4_addr_get_u32(ip_2_ip4(dns_addr));
+        }
+    }
+
+    char key[DHCP_LEASE_KEY_SIZE];
+    dhcp_lease_t saved;
+    size_t size = 0;
+    dhcp_lease_key(&netif, key);
+    // don't wear the storage rewriting the same lease on every connect
+    if (kv_get(key, &saved, sizeof(saved), &size) == MBED_SUCCESS && size == sizeof(saved) &&
+            memcmp(&saved, &lease, sizeof(lease)) == 0) {
+        return;
+    }
+    kv_set(key, &lease, sizeof(lease), 0);
+}
+#endif
+
 nsapi_error_t LWIP::Interface::set_dhcp()
 {
     netif_set_up(&netif);
 
 #if LWIP_DHCP
     if (dhcp_has_to_be_set) {
+#if MBED_CONF_LWIP_DHCP_LEASE_PERSIST
+        err_t err;
+        if (!ip4_addr_isany_val(dhcp_lease_addr)) {
+            err = dhcp_start_reboot(&netif, &dhcp_lease_addr);
+        } else {
+            err = dhcp_start(&netif);
+        }
+#else
         err_t err = dhcp_start(&netif);
+#endif
         dhcp_has_to_be_set = false;
         if (err) {
             connected = NSAPI_STATUS_DISCONNECTED;
@@ -163,12 +251,22 @@ nsapi_error_t LWIP::Interface::set_dhcp()
     return NSAPI_ERROR_OK;
 }
 
+void LWIP::Interface::record_phase(nsapi_connection_phase_t phase)
+{
+    // Only the first time a phase is reached after bringup counts
+    if (timeline.phase_ms[phase] == 0) {
+        u32_t elapsed = sys_now() - connect_time;
+        timeline.phase_ms[phase] = elapsed ? elapsed : 1;
+    }
+}
+
 void LWIP::Interface::netif_link_irq(struct netif *netif)
 {
     LWIP::Interface *interface = our_if_from_netif(netif);
     nsapi_connection_status_t connectedStatusPrev = interface->connected;
 
     if (netif_is_link_up(&interface->netif) && interface->connected == NSAPI_STATUS_CONNECTING) {
+        interface->record_phase(NSAPI_PHASE_LINK_UP);
         nsapi_error_t dhcp_status = interface->set_dhcp();
 
         if (interface->blocking && dhcp_status == NSAPI_ERROR_OK) {
@@ -204,6 +302,7 @@ void LWIP::Interface::netif_status_irq(struct netif *netif)
             }
             interface->has_addr_state |= HAS_ANY_ADDR;
             dns_addr_has_to_be_added = true;
+            interface->record_phase(NSAPI_PHASE_ADDRESS);
         }
 #if PREF_ADDR_TIMEOUT
         if (!(interface->has_addr_state & HAS_PREF_ADDR) && LWIP::get_ip_addr(false, netif)) {
@@ -226,9 +325,14 @@ void LWIP::Interface::netif_status_irq(struct netif *netif)
         if (dns_addr_has_to_be_added && !interface->blocking) {
             add_dns_addr(&interface->netif);
         }
+        // DHCP sets the servers before it binds the address
+        if (!ip_addr_isany(dns_getserver(0))) {
+            interface->record_phase(NSAPI_PHASE_DNS_SERVER);
+        }
 
         if (interface->has_addr_state & HAS_ANY_ADDR) {
             interface->connected = NSAPI_STATUS_GLOBAL_UP;
+            interface->record_phase(NSAPI_PHASE_GLOBAL_UP);
         }
     } else if (!netif_is_up(&interface->netif) && netif_is_link_up(&interface->netif)) {
         interface->connected = NSAPI_STATUS_DISCONNECTED;
@@ -316,12 +420,29 @@ char *LWIP::Interface::get_gateway(char *buf, nsapi_size_t buflen)
 #endif
 }
 
+nsapi_error_t LWIP::Interface::get_stats(nsapi_netif_stats_t *stats)
+{
+    *stats = this->stats;
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t LWIP::Interface::get_connection_timeline(nsapi_connection_timeline_t *timeline)
+{
+    *timeline = this->timeline;
+    return NSAPI_ERROR_OK;
+}
+
 LWIP::Interface::Interface() :
     hw(NULL), has_addr_state(0),
     connected(NSAPI_STATUS_DISCONNECTED),
-    dhcp_started(false), dhcp_has_to_be_set(false), blocking(true), ppp(false)
+    dhcp_started(false), dhcp_has_to_be_set(false), blocking(true), ppp(false), connect_time(0)
 {
     memset(&netif, 0, sizeof netif);
+    memset(&stats, 0, sizeof stats);
+    memset(&timeline, 0, sizeof timeline);
+#if LWIP_DHCP && MBED_CONF_LWIP_DHCP_LEASE_PERSIST
+    ip4_addr_set_any(&dhcp_lease_addr);
+#endif
 
     osSemaphoreAttr_t attr;
     attr.name = NULL;
@@ -429,7 +550,7 @@ nsapi_error_t LWIP::add_l3ip_interface(L3IP &l3ip, bool default_if, OnboardNetwo
 #if LWIP_IPV4
                    0, 0, 0,
 #endif
-                   interface, &LWIP::Interface::emac_if_init, ip_input)) {
+                   interface, &LWIP::Interface::l3ip_if_init, tcpip_input)) {
         return NSAPI_ERROR_DEVICE_ERROR;
     }
 
@@ -508,10 +629,15 @@ nsapi_error_t LWIP::Interface::bringup(bool dhcp, const char *ip, const char *ne
 
     connected = NSAPI_STATUS_CONNECTING;
     blocking = block;
+    memset(&timeline, 0, sizeof timeline);
+    connect_time = sys_now();
 
 #if LWIP_DHCP
     if (stack != IPV6_STACK && dhcp) {
         dhcp_has_to_be_set = true;
+#if MBED_CONF_LWIP_DHCP_LEASE_PERSIST
+        load_dhcp_lease();
+#endif
     }
 #endif
 
@@ -586,6 +712,7 @@ nsapi_error_t LWIP::Interface::bringup(bool dhcp, const char *ip, const char *ne
             }
         }
     } else {
+        record_phase(NSAPI_PHASE_LINK_UP);
         nsapi_error_t ret = set_dhcp();
         if (ret != NSAPI_ERROR_OK) {
             return ret;
@@ -628,6 +755,12 @@ nsapi_error_t LWIP::Interface::bringup(bool dhcp, const char *ip, const char *ne
 #endif
 
     add_dns_addr(&netif);
+    if (!ip_addr_isany(dns_getserver(0))) {
+        record_phase(NSAPI_PHASE_DNS_SERVER);
+    }
+#if LWIP_DHCP && MBED_CONF_LWIP_DHCP_LEASE_PERSIST
+    save_dhcp_lease();
+#endif
 
     return NSAPI_ERROR_OK;
 }
@@ -642,6 +775,10 @@ nsapi_error_t LWIP::Interface::bringdown()
 #if LWIP_DHCP
     // Disconnect from the network
     if (dhcp_started) {
+#if MBED_CONF_LWIP_DHCP_LEASE_PERSIST
+        // a non-blocking connect hasn't saved the lease yet
+        save_dhcp_lease();
+#endif
         dhcp_release(&netif);
         dhcp_stop(&netif);
         dhcp_started = false;
@@ -33,19 +33,31 @@ err_t LWIP::Interface::emac_low_level_output(struct netif *netif, struct pbuf *p
     pbuf_ref(p);
 
     LWIP::Interface *mbed_if = static_cast<LWIP::Interface *>(netif->state);
+    u16_t len = p->tot_len;
     bool ret = mbed_if->emac->link_out(p);
+    if (ret) {
+        mbed_if->stats.tx_frames++;
+        mbed_if->stats.tx_bytes += len;
+    } else {
+        mbed_if->stats.tx_dropped++;
+    }
     return ret ? ERR_OK : ERR_IF;
 }
 
 void LWIP::Interface::emac_input(emac_mem_buf_t *buf)
 {
     struct pbuf *p = static_cast<struct pbuf *>(buf);
+    u16_t len = p->tot_len;
 
     /* pass all packets to ethernet_input, which decides what packets it supports */
     if (netif.input(p, &netif) != ERR_OK) {
         LWIP_DEBUGF(NETIF_DEBUG, ("Emac LWIP: IP input error\n"));
 
         pbuf_free(p);
+        stats.rx_dropped++;
+    } else {
+        stats.rx_frames++;
+        stats.rx_bytes += len;
     }
 }
 
@@ -158,6 +170,43 @@ err_t LWIP::Interface::emac_if_init(struct netif *netif)
 
     mbed_if->emac->get_ifname(netif->name, 2);
 
+#if LWIP_CHECKSUM_CTRL_PER_NETIF
+    /* Leave the checksums the hardware handles to it */
+    uint32_t offload = mbed_if->emac->get_checksum_offload();
+    uint16_t checksum_ctrl = NETIF_CHECKSUM_ENABLE_ALL;
+    if (offload & EMAC::TX_CHECKSUM_IP) {
+        checksum_ctrl &= ~NETIF_CHECKSUM_GEN_IP;
+    }
+    if (offload & EMAC::TX_CHECKSUM_UDP) {
+        checksum_ctrl &= ~NETIF_CHECKSUM_GEN_UDP;
+    }
+    if (offload & EMAC::TX_CHECKSUM_TCP) {
+        checksum_ctrl &= ~NETIF_CHECKSUM_GEN_TCP;
+    }
+    if (offload & EMAC::TX_CHECKSUM_ICMP) {
+        checksum_ctrl &= ~NETIF_CHECKSUM_GEN_ICMP;
+    }
+    if (offload & EMAC::TX_CHECKSUM_ICMP6) {
+        checksum_ctrl &= ~NETIF_CHECKSUM_GEN_ICMP6;
+    }
+    if (offload & EMAC::RX_CHECKSUM_IP) {
+        checksum_ctrl &= ~NETIF_CHECKSUM_CHECK_IP;
+    }
+    if (offload & EMAC::RX_CHECKSUM_UDP) {
+        checksum_ctrl &= ~NETIF_CHECKSUM_CHECK_UDP;
+    }
+    if (offload & EMAC::RX_CHECKSUM_TCP) {
+        checksum_ctrl &= ~NETIF_CHECKSUM_CHECK_TCP;
+    }
+    if (offload & EMAC::RX_CHECKSUM_ICMP) {
+        checksum_ctrl &= ~NETIF_CHECKSUM_CHECK_ICMP;
+    }
+    if (offload & EMAC::RX_CHECKSUM_ICMP6) {
+        checksum_ctrl &= ~NETIF_CHECKSUM_CHECK_ICMP6;
+    }
+    NETIF_SET_CHECKSUM_CTRL(netif, checksum_ctrl);
+#endif
+
 #if LWIP_IPV4
     netif->output = etharp_output;
 #if LWIP_IGMP
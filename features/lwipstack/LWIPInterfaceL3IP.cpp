@@ -34,10 +34,41 @@ err_t LWIP::Interface::l3ip_output(struct netif *netif, struct pbuf *p, const ip
     pbuf_ref(p);
 
     LWIP::Interface *mbed_if = static_cast<LWIP::Interface *>(netif->state);
+#if MBED_CONF_LWIP_L3IP_TX_BURST
+    /* Collect the packets sent while the TCPIP thread handles one message,
+       and pass them to the driver together from a callback queued behind it */
+    if (mbed_if->l3ip_tx_msg) {
+        mbed_if->l3ip_tx_burst[mbed_if->l3ip_tx_count++] = p;
+        if (!mbed_if->l3ip_tx_pending && tcpip_trycallback(mbed_if->l3ip_tx_msg) == ERR_OK) {
+            mbed_if->l3ip_tx_pending = true;
+        }
+        if (!mbed_if->l3ip_tx_pending || mbed_if->l3ip_tx_count == MBED_CONF_LWIP_L3IP_TX_BURST) {
+            // full burst, or the callback couldn't be queued
+            uint32_t count = mbed_if->l3ip_tx_count;
+            mbed_if->l3ip_tx_count = 0;
+            mbed_if->l3ip->link_out_burst(mbed_if->l3ip_tx_burst, count);
+        }
+        return ERR_OK;
+    }
+#endif
     bool ret = mbed_if->l3ip->link_out(p);
     return ret ? ERR_OK : ERR_IF;
 }
 
+#if MBED_CONF_LWIP_L3IP_TX_BURST
+void LWIP::Interface::l3ip_tx_flush(void *ctx)
+{
+    LWIP::Interface *mbed_if = static_cast<LWIP::Interface *>(ctx);
+    uint32_t count = mbed_if->l3ip_tx_count;
+
+    mbed_if->l3ip_tx_pending = false;
+    mbed_if->l3ip_tx_count = 0;
+    if (count) {
+        mbed_if->l3ip->link_out_burst(mbed_if->l3ip_tx_burst, count);
+    }
+}
+#endif
+
 void LWIP::Interface::l3ip_input(net_stack_mem_buf_t *buf)
 {
     struct pbuf *p = static_cast<struct pbuf *>(buf);
@@ -129,8 +160,14 @@ err_t LWIP::Interface::l3ip_if_init(struct netif *netif)
     mbed_if->l3ip->set_link_input_cb(mbed::callback(mbed_if, &LWIP::Interface::l3ip_input));
     mbed_if->l3ip->set_link_state_cb(mbed::callback(mbed_if, &LWIP::Interface::l3ip_state_change));
 
-    /* Interface capabilities */
-    netif->flags = NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP | NETIF_FLAG_ETHERNET;
+    /* Interface capabilities. No link layer, so tcpip_input passes packets to ip_input */
+    netif->flags = NETIF_FLAG_BROADCAST;
+
+#if MBED_CONF_LWIP_L3IP_TX_BURST
+    mbed_if->l3ip_tx_count = 0;
+    mbed_if->l3ip_tx_pending = false;
+    mbed_if->l3ip_tx_msg = tcpip_callbackmsg_new(&LWIP::Interface::l3ip_tx_flush, mbed_if);
+#endif
 
     if (!mbed_if->l3ip->power_up()) {
         err = ERR_IF;
@@ -15,9 +15,16 @@
 
 #include "pbuf.h"
 #include "LWIPMemoryManager.h"
+#if MBED_CONF_LWIP_MEM_PROFILE
+#include "lwip/memp.h"
+#include "lwip/stats.h"
+#include "platform/mbed_critical.h"
+#endif
 
 net_stack_mem_buf_t *LWIPMemoryManager::alloc_heap(uint32_t size, uint32_t align)
 {
+    profile_alloc(size);
+
     struct pbuf *pbuf = pbuf_alloc(PBUF_RAW, size + align, PBUF_RAM);
     if (pbuf == NULL) {
         return NULL;
@@ -30,6 +37,8 @@ net_stack_mem_buf_t *LWIPMemoryManager::alloc_heap(uint32_t size, uint32_t align
 
 net_stack_mem_buf_t *LWIPMemoryManager::alloc_pool(uint32_t size, uint32_t align)
 {
+    profile_alloc(size);
+
     uint32_t total_align = count_total_align(size, align);
 
     struct pbuf *pbuf = pbuf_alloc(PBUF_RAW, size + total_align, PBUF_POOL);
@@ -104,6 +113,53 @@ void LWIPMemoryManager::set_len(net_stack_mem_buf_t *buf, uint32_t len)
     set_total_len(pbuf);
 }
 
+void LWIPMemoryManager::profile_alloc(uint32_t size)
+{
+#if MBED_CONF_LWIP_MEM_PROFILE
+    int size_class;
+    if (size <= MBED_CONF_LWIP_MEM_POOL_SMALL_SIZE) {
+        size_class = 0;
+    } else if (size <= MBED_CONF_LWIP_MEM_POOL_MEDIUM_SIZE) {
+        size_class = 1;
+    } else if (size <= MBED_CONF_LWIP_MEM_POOL_LARGE_SIZE) {
+        size_class = 2;
+    } else {
+        size_class = 3;
+    }
+    core_util_atomic_incr_u32(&_alloc_sizes[size_class], 1);
+#else
+    (void)size;
+#endif
+}
+
+bool LWIPMemoryManager::get_profile(profile_t &profile) const
+{
+#if MBED_CONF_LWIP_MEM_PROFILE
+    core_util_critical_section_enter();
+    profile.pool_used_max = lwip_stats.memp[MEMP_PBUF_POOL]->max;
+    profile.pool_failures = lwip_stats.memp[MEMP_PBUF_POOL]->err;
+#if MEM_USE_POOLS
+    profile.heap_used_max = 0;
+    profile.heap_failures = 0;
+    for (int i = MEMP_POOL_FIRST; i <= MEMP_POOL_LAST; i++) {
+        profile.heap_used_max += lwip_stats.memp[i]->max * memp_pools[i]->size;
+        profile.heap_failures += lwip_stats.memp[i]->err;
+    }
+#else
+    profile.heap_used_max = lwip_stats.mem.max;
+    profile.heap_failures = lwip_stats.mem.err;
+#endif
+    for (int i = 0; i < PROFILE_SIZE_CLASSES; i++) {
+        profile.alloc_sizes[i] = _alloc_sizes[i];
+    }
+    core_util_critical_section_exit();
+    return true;
+#else
+    (void)profile;
+    return false;
+#endif
+}
+
 uint32_t LWIPMemoryManager::count_total_align(uint32_t size, uint32_t align)
 {
     uint32_t buffers = size / get_pool_alloc_unit(align);
@@ -22,6 +22,23 @@
 class LWIPMemoryManager : public EMACMemoryManager {
 public:
 
+    /** Number of allocation size classes in a profile */
+    static const int PROFILE_SIZE_CLASSES = 4;
+
+    /**
+     * Memory use recorded when lwip.mem-profile is enabled
+     *
+     * The size classes are those of the lwip.mem-pool-* options: up to the
+     * small, medium and large pool sizes, and larger.
+     */
+    struct profile_t {
+        uint32_t pool_used_max;     /**< Peak number of pool pbufs in use */
+        uint32_t pool_failures;     /**< Pool pbuf allocations that failed */
+        uint32_t heap_used_max;     /**< Peak heap bytes in use, summed over the pools with lwip.mem-pools-enabled */
+        uint32_t heap_failures;     /**< Heap allocations that failed */
+        uint32_t alloc_sizes[PROFILE_SIZE_CLASSES]; /**< Allocations by drivers, per size class */
+    };
+
     /**
      * Allocates memory buffer from the heap
      *
@@ -161,8 +178,30 @@ public:
      */
     virtual void set_len(net_stack_mem_buf_t *buf, uint32_t len);
 
+    /**
+     * Gets the memory profile
+     *
+     * Peaks and failures cover all allocations of the stack, the size
+     * classes only the allocations made through this memory manager.
+     *
+     * @param profile  Profile to fill in
+     * @return         True on success, false if lwip.mem-profile is disabled
+     */
+    bool get_profile(profile_t &profile) const;
+
 private:
 
+    /**
+     * Counts an allocation in its size class, if profiling
+     *
+     * @param size     Size of the allocation in bytes
+     */
+    void profile_alloc(uint32_t size);
+
+#if MBED_CONF_LWIP_MEM_PROFILE
+    volatile uint32_t _alloc_sizes[PROFILE_SIZE_CLASSES];
+#endif
+
     /**
      * Returns a total memory alignment size
      *
@@ -27,6 +27,7 @@
 #include "lwip/dhcp.h"
 #include "lwip/tcpip.h"
 #include "lwip/tcp.h"
+#include "lwip/priv/tcp_priv.h"
 #include "lwip/ip.h"
 #include "lwip/mld6.h"
 #include "lwip/igmp.h"
@@ -256,6 +257,11 @@ const char *LWIP::get_ip_address()
 #endif
 }
 
+NetStackMemoryManager *LWIP::get_memory_manager()
+{
+    return &memory_manager;
+}
+
 nsapi_error_t LWIP::socket_open(nsapi_socket_t *handle, nsapi_protocol_t proto)
 {
     // check if network is connected
@@ -485,6 +491,230 @@ nsapi_size_or_error_t LWIP::socket_recvfrom(nsapi_socket_t handle, SocketAddress
     return recv;
 }
 
+nsapi_size_or_error_t LWIP::socket_sendmsg(nsapi_socket_t handle, const SocketAddress *address, const nsapi_iovec_t *iov, unsigned iovcnt)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+
+    if (NETCONNTYPE_GROUP(s->conn->type) == NETCONN_TCP) {
+        // Queue the buffers as one stream, holding the push back until the
+        // last one so they can share segments
+        nsapi_size_t sent = 0;
+        for (unsigned i = 0; i < iovcnt; i++) {
+            size_t bytes_written = 0;
+            u8_t flags = NETCONN_COPY | ((i + 1 < iovcnt) ? NETCONN_MORE : 0);
+            err_t err = netconn_write_partly(s->conn, iov[i].iov_base, iov[i].iov_len, flags, &bytes_written);
+            if (err != ERR_OK) {
+                return sent ? (nsapi_size_or_error_t)sent : err_remap(err);
+            }
+            sent += bytes_written;
+            if (bytes_written < iov[i].iov_len) {
+                break;
+            }
+        }
+        return sent;
+    }
+
+    if (!address) {
+        return NSAPI_ERROR_NO_ADDRESS;
+    }
+
+    ip_addr_t ip_addr;
+    nsapi_addr_t addr = address->get_addr();
+    if (!convert_mbed_addr_to_lwip(&ip_addr, &addr)) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    nsapi_size_t size = 0;
+    for (unsigned i = 0; i < iovcnt; i++) {
+        size += iov[i].iov_len;
+    }
+    if (size > 0xFFFF) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    // Chain the buffers by reference into a single datagram
+    struct pbuf *head = NULL;
+    for (unsigned i = 0; i < iovcnt; i++) {
+        if (!iov[i].iov_len) {
+            continue;
+        }
+        struct pbuf *p = pbuf_alloc(PBUF_RAW, (u16_t)iov[i].iov_len, PBUF_REF);
+        if (!p) {
+            if (head) {
+                pbuf_free(head);
+            }
+            return NSAPI_ERROR_NO_MEMORY;
+        }
+        p->payload = iov[i].iov_base;
+        if (head) {
+            pbuf_cat(head, p);
+        } else {
+            head = p;
+        }
+    }
+    if (!head) {
+        head = pbuf_alloc(PBUF_RAW, 0, PBUF_REF);
+        if (!head) {
+            return NSAPI_ERROR_NO_MEMORY;
+        }
+    }
+
+    struct netbuf *buf = netbuf_new();
+    if (!buf) {
+        pbuf_free(head);
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+    buf->p = buf->ptr = head;
+
+    err_t err = netconn_sendto(s->conn, buf, &ip_addr, address->get_port());
+    netbuf_delete(buf);
+    if (err != ERR_OK) {
+        return err_remap(err);
+    }
+
+    return size;
+}
+
+nsapi_size_or_error_t LWIP::socket_recvmsg(nsapi_socket_t handle, SocketAddress *address, nsapi_iovec_t *iov, unsigned iovcnt)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+
+    if (NETCONNTYPE_GROUP(s->conn->type) == NETCONN_TCP) {
+        nsapi_size_t recv = 0;
+        for (unsigned i = 0; i < iovcnt; i++) {
+            if (!iov[i].iov_len) {
+                continue;
+            }
+            nsapi_size_or_error_t ret = socket_recv(handle, iov[i].iov_base, iov[i].iov_len);
+            if (ret < 0) {
+                return recv ? (nsapi_size_or_error_t)recv : ret;
+            }
+            recv += ret;
+            if ((nsapi_size_t)ret < iov[i].iov_len) {
+                break;
+            }
+        }
+        return recv;
+    }
+
+    struct netbuf *buf;
+    err_t err = netconn_recv(s->conn, &buf);
+    if (err != ERR_OK) {
+        return err_remap(err);
+    }
+
+    if (address) {
+        nsapi_addr_t addr;
+        convert_lwip_addr_to_mbed(&addr, netbuf_fromaddr(buf));
+        address->set_addr(addr);
+        address->set_port(netbuf_fromport(buf));
+    }
+
+    // Scatter the datagram over the buffers
+    u16_t recv = 0;
+    for (unsigned i = 0; i < iovcnt && recv < netbuf_len(buf); i++) {
+        recv += netbuf_copy_partial(buf, iov[i].iov_base, (u16_t)iov[i].iov_len, recv);
+    }
+    netbuf_delete(buf);
+
+    return recv;
+}
+
+nsapi_size_or_error_t LWIP::socket_recv_buf(nsapi_socket_t handle, net_stack_mem_buf_t **buf)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+
+    if (!s->buf) {
+        err_t err = netconn_recv(s->conn, &s->buf);
+        s->offset = 0;
+
+        if (err != ERR_OK) {
+            return err_remap(err);
+        }
+    }
+
+    struct pbuf *p;
+    if (s->offset) {
+        // Rest of a netbuf partially read with socket_recv, copy it
+        u16_t len = netbuf_len(s->buf) - s->offset;
+        p = pbuf_alloc(PBUF_RAW, len, PBUF_RAM);
+        if (!p) {
+            return NSAPI_ERROR_NO_MEMORY;
+        }
+        netbuf_copy_partial(s->buf, p->payload, len, s->offset);
+    } else {
+        // Take the pbuf chain from the netbuf
+        p = s->buf->p;
+        s->buf->p = s->buf->ptr = NULL;
+    }
+
+    netbuf_delete(s->buf);
+    s->buf = 0;
+
+    *buf = p;
+    return p->tot_len;
+}
+
+nsapi_size_or_error_t LWIP::socket_sendto_buf(nsapi_socket_t handle, const SocketAddress &address, net_stack_mem_buf_t *buf)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+    struct pbuf *p = static_cast<struct pbuf *>(buf);
+    ip_addr_t ip_addr;
+
+    nsapi_addr_t addr = address.get_addr();
+    if (!convert_mbed_addr_to_lwip(&ip_addr, &addr)) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    struct netbuf *nbuf = netbuf_new();
+    if (!nbuf) {
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    // The pbuf chain is passed down as it is, lwIP chains its headers in
+    // front of it
+    u16_t size = p->tot_len;
+    nbuf->p = nbuf->ptr = p;
+
+    err_t err = netconn_sendto(s->conn, nbuf, &ip_addr, address.get_port());
+    if (err != ERR_OK) {
+        // The caller keeps the buffer
+        nbuf->p = nbuf->ptr = NULL;
+    }
+    netbuf_delete(nbuf);
+    if (err != ERR_OK) {
+        return err_remap(err);
+    }
+
+    return size;
+}
+
+nsapi_size_or_error_t LWIP::socket_recvfrom_buf(nsapi_socket_t handle, SocketAddress *address, net_stack_mem_buf_t **buf)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+    struct netbuf *nbuf;
+
+    err_t err = netconn_recv(s->conn, &nbuf);
+    if (err != ERR_OK) {
+        return err_remap(err);
+    }
+
+    if (address) {
+        nsapi_addr_t addr;
+        convert_lwip_addr_to_mbed(&addr, netbuf_fromaddr(nbuf));
+        address->set_addr(addr);
+        address->set_port(netbuf_fromport(nbuf));
+    }
+
+    // Take the pbuf chain from the netbuf
+    struct pbuf *p = nbuf->p;
+    nbuf->p = nbuf->ptr = NULL;
+    netbuf_delete(nbuf);
+
+    *buf = p;
+    return p->tot_len;
+}
+
 int32_t LWIP::find_multicast_member(const struct mbed_lwip_socket *s, const nsapi_ip_mreq_t *imr)
 {
     uint32_t count = 0;
@@ -547,6 +777,22 @@ nsapi_error_t LWIP::setsockopt(nsapi_socket_t handle, int level, int optname, co
             }
             return 0;
 
+#if LWIP_TCP
+        case NSAPI_LINGER:
+            if (optlen != sizeof(int) || NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+            // A negative value closes gracefully in the background, 0 aborts
+            // the connection if unsent data is left. Waiting for the data
+            // to be sent is not possible, as the netconns are non-blocking.
+            if (*(int *)optval > 0) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+            s->conn->linger = *(int *)optval < 0 ? -1 : 0;
+            return 0;
+#endif
+
         case NSAPI_ADD_MEMBERSHIP:
         case NSAPI_DROP_MEMBERSHIP: {
             if (optlen != sizeof(nsapi_ip_mreq_t)) {
@@ -651,7 +897,47 @@ nsapi_error_t LWIP::setsockopt(nsapi_socket_t handle, int level, int optname, co
 
 nsapi_error_t LWIP::getsockopt(nsapi_socket_t handle, int level, int optname, void *optval, unsigned *optlen)
 {
-    return NSAPI_ERROR_UNSUPPORTED;
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+
+    switch (optname) {
+#if LWIP_TCP
+        case NSAPI_TCP_INFO: {
+            if (*optlen < sizeof(nsapi_tcp_info_t) || NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+            LOCK_TCPIP_CORE();
+            struct tcp_pcb *pcb = s->conn->pcb.tcp;
+            if (!pcb) {
+                UNLOCK_TCPIP_CORE();
+                return NSAPI_ERROR_NO_CONNECTION;
+            }
+
+            // lwIP keeps 8 times the smoothed RTT and 4 times its variation, in slow timer ticks
+            nsapi_tcp_info_t *info = (nsapi_tcp_info_t *)optval;
+            info->rtt_ms = (pcb->sa >> 3) * TCP_SLOW_INTERVAL;
+            info->rtt_var_ms = (pcb->sv >> 2) * TCP_SLOW_INTERVAL;
+            info->cwnd = pcb->cwnd;
+            info->snd_wnd = pcb->snd_wnd;
+            info->snd_queued = pcb->snd_lbb - pcb->lastack;
+            info->retransmits = pcb->nrtx;
+#if LWIP_WND_SCALE
+            info->snd_wnd_scale = (pcb->flags & TF_WND_SCALE) ? pcb->snd_scale : 0;
+            info->rcv_wnd_scale = (pcb->flags & TF_WND_SCALE) ? pcb->rcv_scale : 0;
+#else
+            info->snd_wnd_scale = 0;
+            info->rcv_wnd_scale = 0;
+#endif
+            UNLOCK_TCPIP_CORE();
+
+            *optlen = sizeof(nsapi_tcp_info_t);
+            return 0;
+        }
+#endif
+
+        default:
+            return NSAPI_ERROR_UNSUPPORTED;
+    }
 }
 
 
@@ -111,12 +111,31 @@ public:
          */
         virtual char *get_gateway(char *buf, nsapi_size_t buflen);
 
+        /** Copies the frame counters of the network interface
+         *
+         * @param    stats      structure to which the counters will be copied
+         * @return              NSAPI_ERROR_OK on success, or error code
+         */
+        virtual nsapi_error_t get_stats(nsapi_netif_stats_t *stats);
+
+        /** Copies the timeline of the last bringup of the network interface
+         *
+         * @param    timeline   structure to which the times will be copied
+         * @return              NSAPI_ERROR_OK on success, or error code
+         */
+        virtual nsapi_error_t get_connection_timeline(nsapi_connection_timeline_t *timeline);
+
     private:
         friend LWIP;
 
         Interface();
 
         nsapi_error_t set_dhcp();
+        void record_phase(nsapi_connection_phase_t phase);
+#if LWIP_DHCP && MBED_CONF_LWIP_DHCP_LEASE_PERSIST
+        void load_dhcp_lease();
+        void save_dhcp_lease();
+#endif
         static void netif_link_irq(struct netif *netif);
         static void netif_status_irq(struct netif *netif);
         static Interface *our_if_from_netif(struct netif *netif);
@@ -147,6 +166,9 @@ public:
 #endif
 
         static err_t l3ip_if_init(struct netif *netif);
+#if MBED_CONF_LWIP_L3IP_TX_BURST
+        static void l3ip_tx_flush(void *ctx);
+#endif
 #endif
 
         union {
@@ -181,13 +203,25 @@ public:
         nsapi_connection_status_t connected;
         bool dhcp_started;
         bool dhcp_has_to_be_set;
+#if LWIP_DHCP && MBED_CONF_LWIP_DHCP_LEASE_PERSIST
+        ip4_addr_t dhcp_lease_addr;
+#endif
         bool blocking;
         bool ppp;
         mbed::Callback<void(nsapi_event_t, intptr_t)> client_callback;
         struct netif netif;
+        nsapi_netif_stats_t stats;
+        nsapi_connection_timeline_t timeline;
+        u32_t connect_time;
         static Interface *list;
         Interface *next;
         LWIPMemoryManager *memory_manager;
+#if LWIP_L3IP && MBED_CONF_LWIP_L3IP_TX_BURST
+        net_stack_mem_buf_t *l3ip_tx_burst[MBED_CONF_LWIP_L3IP_TX_BURST];
+        uint32_t l3ip_tx_count;
+        bool l3ip_tx_pending;
+        struct tcpip_callback_msg *l3ip_tx_msg;
+#endif
     };
 
     /** Register a network interface with the IP stack
@@ -262,6 +296,12 @@ public:
      */
     virtual const char *get_ip_address();
 
+    /** Get the memory manager of the network buffers of the stack
+     *
+     *  @return         The memory manager allocating lwIP pbufs
+     */
+    virtual NetStackMemoryManager *get_memory_manager();
+
 protected:
     LWIP();
     virtual ~LWIP() {}
@@ -415,6 +455,93 @@ protected:
     virtual nsapi_size_or_error_t socket_recvfrom(nsapi_socket_t handle, SocketAddress *address,
                                                   void *buffer, nsapi_size_t size);
 
+    /** Send a message gathered from several buffers over a socket
+     *
+     *  TCP sockets queue the buffers as one stream, UDP sockets send them
+     *  to address as a single datagram, chaining them by reference.
+     *
+     *  This call is non-blocking. If sendmsg would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param address  The SocketAddress of the remote host, or NULL for
+     *                  connected TCP sockets
+     *  @param iov      Array of the buffers of data to send to the host
+     *  @param iovcnt   Number of buffers in the array
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_sendmsg(nsapi_socket_t handle, const SocketAddress *address,
+                                                 const nsapi_iovec_t *iov, unsigned iovcnt);
+
+    /** Receive data scattered into several buffers over a socket
+     *
+     *  This call is non-blocking. If recvmsg would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param address  Destination for the source address or NULL
+     *  @param iov      Array of the destination buffers
+     *  @param iovcnt   Number of buffers in the array
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_recvmsg(nsapi_socket_t handle, SocketAddress *address,
+                                                 nsapi_iovec_t *iov, unsigned iovcnt);
+
+    /** Receive data over a TCP socket in a network buffer
+     *
+     *  The socket must be connected to a remote host. On success the
+     *  buffer holding the received data is passed to the caller, who
+     *  must free it with the memory manager of the stack.
+     *
+     *  This call is non-blocking. If recv would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param buf      Destination for the received network buffer
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_recv_buf(nsapi_socket_t handle, net_stack_mem_buf_t **buf);
+
+    /** Send a packet held in a network buffer over a UDP socket
+     *
+     *  Sends the buffer allocated with the memory manager of the stack to
+     *  the specified address. On success the stack takes the buffer and
+     *  frees it once sent, on failure the caller keeps it.
+     *
+     *  This call is non-blocking. If sendto would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param address  The SocketAddress of the remote host
+     *  @param buf      Network buffer of data to send to the host
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_sendto_buf(nsapi_socket_t handle, const SocketAddress &address,
+                                                    net_stack_mem_buf_t *buf);
+
+    /** Receive a packet over a UDP socket in a network buffer
+     *
+     *  Receives a packet and stores the source address in address if
+     *  address is not NULL. On success the buffer holding the packet is
+     *  passed to the caller, who must free it with the memory manager of
+     *  the stack.
+     *
+     *  This call is non-blocking. If recvfrom would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param address  Destination for the source address or NULL
+     *  @param buf      Destination for the received network buffer
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_recvfrom_buf(nsapi_socket_t handle, SocketAddress *address,
+                                                      net_stack_mem_buf_t **buf);
+
     /** Register a callback on state change of the socket
      *
      *  The specified callback will be called on state changes such as when
@@ -0,0 +1,153 @@
+/*
+* Copyright (c) 2019 ARM Limited. All rights reserved.
+*
+* SPDX-License-Identifier: Apache-2.0
+*
+* Licensed under the Apache License, Version 2.0 (the License); you may
+* not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an AS IS BASIS, WITHOUT
+* WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/* Cost of the internet checksum lwIP computes in software, compared with
+ * a plain C version summing 16 bits at a time.
+ *
+ * Every result is sent to the host as
+ *
+ *     {{benchmark;<impl>,len=<B>,align=<n>,runs=<n>,millicycles_per_byte=<n>}}
+ */
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+#include "lwip/inet_chksum.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifndef MBED_CONF_LWIP_PRESENT
+#error [NOT_SUPPORTED] lwIP is required
+#endif
+
+using namespace utest::v1;
+
+// Number of checksums timed for each length
+#ifndef MBED_TEST_BENCH_RUNS
+#define MBED_TEST_BENCH_RUNS 1000
+#endif
+
+// Largest length, a full Ethernet frame
+#define BENCH_MAX_LEN 1514
+
+static uint8_t bench_buffer[BENCH_MAX_LEN + 4];
+
+static u16_t reference_chksum(const void *dataptr, int len)
+{
+    const uint8_t *data = (const uint8_t *)dataptr;
+    uint32_t sum = 0;
+
+    // Sum bytes in memory order, as lwIP does on a little endian host
+    for (int i = 0; i + 1 < len; i += 2) {
+        sum += data[i] | (data[i + 1] << 8);
+    }
+    if (len & 1) {
+        sum += data[len - 1];
+    }
+    while (sum >> 16) {
+        sum = (sum & 0xFFFF) + (sum >> 16);
+    }
+    return (u16_t)sum;
+}
+
+static u16_t lwip_chksum(const void *dataptr, int len)
+{
+    return (u16_t)~inet_chksum(dataptr, (u16_t)len);
+}
+
+// 0 and 0xFFFF are both zero in one's complement
+static bool chksum_equal(u16_t a, u16_t b)
+{
+    return a == b || (u16_t)(a + b) == 0xFFFF;
+}
+
+typedef u16_t (*chksum_t)(const void *dataptr, int len);
+
+static void bench_chksum(const char *impl, chksum_t chksum, size_t len, size_t align)
+{
+    Timer timer;
+    volatile u16_t result = 0;
+
+    timer.start();
+    for (int i = 0; i < MBED_TEST_BENCH_RUNS; i++) {
+        result += chksum(bench_buffer + align, len);
+    }
+    timer.stop();
+    (void)result;
+
+    uint64_t cycles = (uint64_t)timer.read_high_resolution_us() * (SystemCoreClock / 1000);
+    uint64_t bytes = (uint64_t)len * MBED_TEST_BENCH_RUNS;
+
+    char report[100];
+    snprintf(report, sizeof(report), "%s,len=%lu,align=%lu,runs=%lu,millicycles_per_byte=%lu",
+             impl, (unsigned long)len, (unsigned long)align, (unsigned long)MBED_TEST_BENCH_RUNS,
+             (unsigned long)(cycles / bytes));
+    greentea_send_kv("benchmark", report);
+}
+
+static void test_chksum_matches_reference()
+{
+    for (size_t i = 0; i < sizeof(bench_buffer); i++) {
+        bench_buffer[i] = rand();
+    }
+
+    for (size_t align = 0; align < 4; align++) {
+        for (size_t len = 0; len <= 256; len++) {
+            TEST_ASSERT(chksum_equal(reference_chksum(bench_buffer + align, len),
+                                     lwip_chksum(bench_buffer + align, len)));
+        }
+    }
+
+    // All ones makes every add carry
+    memset(bench_buffer, 0xFF, sizeof(bench_buffer));
+    for (size_t align = 0; align < 4; align++) {
+        TEST_ASSERT(chksum_equal(reference_chksum(bench_buffer + align, BENCH_MAX_LEN),
+                                 lwip_chksum(bench_buffer + align, BENCH_MAX_LEN)));
+    }
+}
+
+static void bench_chksum_lengths()
+{
+    static const size_t lengths[] = { 20, 64, 576, BENCH_MAX_LEN };
+
+    for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        for (size_t align = 0; align < 4; align += 2) {
+            bench_chksum("lwip", lwip_chksum, lengths[i], align);
+            bench_chksum("reference", reference_chksum, lengths[i], align);
+        }
+    }
+}
+
+Case cases[] = {
+    Case("Checksum matches the reference", test_chksum_matches_reference),
+    Case("Benchmark: checksum", bench_chksum_lengths),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(120, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    return !Harness::run(specification);
+}
@@ -0,0 +1,124 @@
+/*
+* Copyright (c) 2019 ARM Limited. All rights reserved.
+*
+* SPDX-License-Identifier: Apache-2.0
+*
+* Licensed under the Apache License, Version 2.0 (the License); you may
+* not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an AS IS BASIS, WITHOUT
+* WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/* Latency of socket calls into lwIP, which either run in the calling
+ * thread under the core lock or are passed to the TCPIP thread, depending
+ * on lwip.tcpip-core-locking. Build the test with both settings to compare
+ * them. No network interface is needed.
+ *
+ * Every result is sent to the host as
+ *
+ *     {{benchmark;<mode>,<call>,calls=<n>,avg_us=<us>}}
+ */
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+#include "OnboardNetworkStack.h"
+#include <stdio.h>
+
+#ifndef MBED_CONF_LWIP_PRESENT
+#error [NOT_SUPPORTED] lwIP is required
+#endif
+
+using namespace utest::v1;
+
+// Number of calls timed for each benchmark
+#ifndef MBED_TEST_BENCH_CALLS
+#define MBED_TEST_BENCH_CALLS 1000
+#endif
+
+#if MBED_CONF_LWIP_TCPIP_CORE_LOCKING
+static const char *const bench_mode = "core_locking";
+#else
+static const char *const bench_mode = "message_passing";
+#endif
+
+static void bench_report(const char *call, us_timestamp_t total_us, int calls)
+{
+    char report[80];
+    snprintf(report, sizeof(report), "%s,%s,calls=%d,avg_us=%lu",
+             bench_mode, call, calls, (unsigned long)(total_us / calls));
+    greentea_send_kv("benchmark", report);
+}
+
+template <class Sock>
+static void bench_open_close(const char *call)
+{
+    NetworkStack &stack = OnboardNetworkStack::get_default_instance();
+    Sock sock;
+    Timer timer;
+
+    timer.start();
+    for (int i = 0; i < MBED_TEST_BENCH_CALLS; i++) {
+        TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.open(&stack));
+        TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.close());
+    }
+    timer.stop();
+
+    bench_report(call, timer.read_high_resolution_us(), MBED_TEST_BENCH_CALLS);
+}
+
+static void bench_udp_open_close()
+{
+    bench_open_close<UDPSocket>("udp_open_close");
+}
+
+static void bench_tcp_open_close()
+{
+    bench_open_close<TCPSocket>("tcp_open_close");
+}
+
+static void bench_bind()
+{
+    NetworkStack &stack = OnboardNetworkStack::get_default_instance();
+    UDPSocket sock;
+    Timer timer;
+
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.open(&stack));
+
+    timer.start();
+    for (int i = 0; i < MBED_TEST_BENCH_CALLS; i++) {
+        TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.bind(0));
+    }
+    timer.stop();
+
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_OK, sock.close());
+
+    bench_report("udp_bind", timer.read_high_resolution_us(), MBED_TEST_BENCH_CALLS);
+}
+
+Case cases[] = {
+    Case("Benchmark: UDP open and close", bench_udp_open_close),
+    Case("Benchmark: TCP open and close", bench_tcp_open_close),
+    Case("Benchmark: UDP bind", bench_bind),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(120, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    return !Harness::run(specification);
+}
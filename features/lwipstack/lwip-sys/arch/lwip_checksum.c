@@ -17,8 +17,9 @@
 
 /* This is a hand written Thumb-2 assembly language version of the
    algorithm 3 version of lwip_standard_chksum in lwIP's inet_chksum.c.  It
-   performs the checksumming 32-bits at a time and even unrolls the loop to
-   perform two of these 32-bit adds per loop iteration.
+   performs the checksumming 32-bits at a time, loading 32 bytes per loop
+   iteration with LDM and chaining the adds through the carry flag, so that
+   each word costs a single add on Cortex-M3/M4/M7.
    
    Returns:
         16-bit 1's complement summation (not inversed).
@@ -35,7 +36,7 @@ __attribute__((naked)) void /*uint16_t*/ thumb2_checksum(const void* pData, int
 
         // Push non-volatile registers we use on stack.  Push link register too to
         // keep stack 8-byte aligned and allow single pop to restore and return.
-        "    push        {r4, lr}\n"
+        "    push        {r4, r5, r6, lr}\n"
         // Initialize sum, r2, to 0.
         "    movs    r2, #0\n"
         // Remember whether pData was at odd address in r3.  This is used later to
@@ -69,9 +70,31 @@ __attribute__((naked)) void /*uint16_t*/ thumb2_checksum(const void* pData, int
         "    adds    r2, r2, r4\n"
         "    subs    r1, r1, #2\n"
 
-        // Main summing loop which sums up data 2 words at a time.
-        // Make sure that we have more than 7 bytes left to sum.
+        // Main summing loop which sums up data 8 words at a time.  The carry of
+        // each add goes into the next one, and the last carry is folded back
+        // twice since it can wrap the sum to 0.  r12 is free to clobber.
         "2$:\n"
+        "    subs    r1, r1, #32\n"
+        "    blt     4$\n"
+        "    ldmia   r0!, {r4, r5, r6, r12}\n"
+        "    adds    r2, r2, r4\n"
+        "    adcs    r2, r2, r5\n"
+        "    adcs    r2, r2, r6\n"
+        "    adcs    r2, r2, r12\n"
+        "    ldmia   r0!, {r4, r5, r6, r12}\n"
+        "    adcs    r2, r2, r4\n"
+        "    adcs    r2, r2, r5\n"
+        "    adcs    r2, r2, r6\n"
+        "    adcs    r2, r2, r12\n"
+        "    adcs    r2, r2, #0\n"
+        "    adc     r2, r2, #0\n"
+        "    b       2$\n"
+        "4$:\n"
+        "    adds    r1, r1, #32\n"
+
+        // Sum up the remaining words 2 at a time.
+        // Make sure that we have more than 7 bytes left to sum.
+        "5$:\n"
         "    cmp     r1, #8\n"
         "    blt     3$\n"
         // Sum next two words.  Applying previous upper 16-bit carry to
@@ -83,7 +106,7 @@ __attribute__((naked)) void /*uint16_t*/ thumb2_checksum(const void* pData, int
         "    adds    r2, r4\n"
         "    adc     r2, r2, #0\n"
         "    subs    r1, r1, #8\n"
-        "    b       2$\n"
+        "    b       5$\n"
 
         // Sum up any remaining half-words.
         "3$:\n"
@@ -119,7 +142,7 @@ __attribute__((naked)) void /*uint16_t*/ thumb2_checksum(const void* pData, int
 
         // Return final sum.
         "9$: mov     r0, r2\n"
-        "    pop     {r4, pc}\n"
+        "    pop     {r4, r5, r6, pc}\n"
     );
 }
 
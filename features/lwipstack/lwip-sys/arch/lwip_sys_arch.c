@@ -67,10 +67,12 @@ struct mem {
 #define SIZEOF_STRUCT_MEM    LWIP_MEM_ALIGN_SIZE(sizeof(struct mem))
 #define MEM_SIZE_ALIGNED     LWIP_MEM_ALIGN_SIZE(MEM_SIZE)
 
+#if !MEM_USE_POOLS
 #if defined (__ICCARM__)
 #pragma location = ".ethusbram"
 #endif
 LWIP_DECLARE_MEMORY_ALIGNED(lwip_ram_heap, MEM_SIZE_ALIGNED + (2U*SIZEOF_STRUCT_MEM)) ETHMEM_SECTION;
+#endif
 
  #if NO_SYS==1
 #include "cmsis.h"
@@ -182,6 +182,7 @@ static err_t dhcp_decline(struct netif *netif);
 #endif /* DHCP_DOES_ARP_CHECK */
 static err_t dhcp_rebind(struct netif *netif);
 static err_t dhcp_reboot(struct netif *netif);
+static err_t dhcp_start_client(struct netif *netif, const ip4_addr_t *reboot_addr);
 static void dhcp_set_state(struct dhcp *dhcp, u8_t new_state);
 
 /* receive, unfold, parse and free incoming messages */
@@ -719,6 +720,32 @@ void dhcp_cleanup(struct netif *netif)
  */
 err_t
 dhcp_start(struct netif *netif)
+{
+  return dhcp_start_client(netif, NULL);
+}
+
+/**
+ * @ingroup dhcp4
+ * Start DHCP for a network interface from a previously allocated address.
+ *
+ * Like dhcp_start(), but the client starts in the INIT-REBOOT state
+ * (RFC 2131, 3.2) and requests the given address directly instead of
+ * discovering servers. If the server doesn't acknowledge it, the client
+ * falls back to discovery.
+ *
+ * @param netif The lwIP network interface
+ * @param addr The address of the previous lease
+ * @return lwIP error code
+ */
+err_t
+dhcp_start_reboot(struct netif *netif, const ip4_addr_t *addr)
+{
+  LWIP_ERROR("addr != NULL", (addr != NULL), return ERR_ARG;);
+  return dhcp_start_client(netif, addr);
+}
+
+static err_t
+dhcp_start_client(struct netif *netif, const ip4_addr_t *reboot_addr)
 {
   struct dhcp *dhcp;
   err_t result;
@@ -779,7 +806,12 @@ dhcp_start(struct netif *netif)
 
 
   /* (re)start the DHCP negotiation */
-  result = dhcp_discover(netif);
+  if (reboot_addr != NULL) {
+    ip4_addr_copy(dhcp->offered_ip_addr, *reboot_addr);
+    result = dhcp_reboot(netif);
+  } else {
+    result = dhcp_discover(netif);
+  }
   if (result != ERR_OK) {
     /* free resources allocated above */
     dhcp_stop(netif);
@@ -1762,6 +1794,14 @@ dhcp_recv(void *arg, struct udp_pcb *pcb, struct pbuf *p, const ip_addr_t *addr,
       dhcp_bind(netif);
 #endif
     }
+#if DHCP_DOES_ARP_CHECK
+    /* rebooting with an address that may have been taken since */
+    else if ((dhcp->state == DHCP_STATE_REBOOTING) && ip4_addr_isany_val(*netif_ip4_addr(netif)) &&
+             ((netif->flags & NETIF_FLAG_ETHARP) != 0)) {
+      dhcp_handle_ack(netif);
+      dhcp_check(netif);
+    }
+#endif
     /* already bound to the given lease address? */
     else if ((dhcp->state == DHCP_STATE_REBOOTING) || (dhcp->state == DHCP_STATE_REBINDING) ||
              (dhcp->state == DHCP_STATE_RENEWING)) {
@@ -110,6 +110,18 @@
 
 #define TCPIP_THREAD_PRIO           (osPriorityNormal)
 
+#ifdef MBED_CONF_LWIP_TCPIP_CORE_LOCKING
+#define LWIP_TCPIP_CORE_LOCKING         MBED_CONF_LWIP_TCPIP_CORE_LOCKING
+#endif
+
+#ifdef MBED_CONF_LWIP_TCPIP_CORE_LOCKING_INPUT
+#define LWIP_TCPIP_CORE_LOCKING_INPUT   MBED_CONF_LWIP_TCPIP_CORE_LOCKING_INPUT
+#endif
+
+#if LWIP_TCPIP_CORE_LOCKING_INPUT && !LWIP_TCPIP_CORE_LOCKING
+#error "lwip.tcpip-core-locking-input requires lwip.tcpip-core-locking"
+#endif
+
 // Thread stack size for lwip system threads
 #ifndef MBED_CONF_LWIP_DEFAULT_THREAD_STACKSIZE
 #define MBED_CONF_LWIP_DEFAULT_THREAD_STACKSIZE    512
@@ -120,6 +132,11 @@
 #define MBED_CONF_LWIP_PPP_THREAD_STACKSIZE    768
 #endif
 
+// Buffer the PPP thread reads received data into
+#ifndef MBED_CONF_LWIP_PPP_INPUT_BUFFER_SIZE
+#define MBED_CONF_LWIP_PPP_INPUT_BUFFER_SIZE   256
+#endif
+
 #ifdef LWIP_DEBUG
 #define DEFAULT_THREAD_STACKSIZE    LWIP_ALIGN_UP(MBED_CONF_LWIP_DEFAULT_THREAD_STACKSIZE*2, 8)
 #define PPP_THREAD_STACK_SIZE       LWIP_ALIGN_UP(MBED_CONF_LWIP_PPP_THREAD_STACKSIZE*2, 8)
@@ -142,6 +159,9 @@
 // Number of simultaneously queued TCP segments.
 #ifdef MBED_CONF_LWIP_MEMP_NUM_TCP_SEG
 #define MEMP_NUM_TCP_SEG            MBED_CONF_LWIP_MEMP_NUM_TCP_SEG
+#elif defined MBED_CONF_LWIP_TCP_RCV_SCALE
+// Enough for a full send queue plus a full receive window held out of order
+#define MEMP_NUM_TCP_SEG            (TCP_SND_QUEUELEN + TCP_WND / TCP_MSS)
 #endif
 
 // TCP Maximum segment size.
@@ -159,6 +179,12 @@
 #define TCP_WND                     MBED_CONF_LWIP_TCP_WND
 #endif
 
+// TCP window scaling, for receive windows over 64 KB.
+#ifdef MBED_CONF_LWIP_TCP_RCV_SCALE
+#define LWIP_WND_SCALE              1
+#define TCP_RCV_SCALE               MBED_CONF_LWIP_TCP_RCV_SCALE
+#endif
+
 #ifdef MBED_CONF_LWIP_TCP_MAXRTX
 #define TCP_MAXRTX                  MBED_CONF_LWIP_TCP_MAXRTX
 #endif
@@ -167,6 +193,10 @@
 #define TCP_SYNMAXRTX               MBED_CONF_LWIP_TCP_SYNMAXRTX
 #endif
 
+#if MBED_CONF_LWIP_TCP_LISTEN_BACKLOG
+#define TCP_LISTEN_BACKLOG          1
+#endif
+
 // Number of pool pbufs.
 // Each requires 684 bytes of RAM (if MSS=536 and PBUF_POOL_BUFSIZE defaulting to be based on MSS)
 #ifdef MBED_CONF_LWIP_PBUF_POOL_SIZE
@@ -174,9 +204,14 @@
 #define PBUF_POOL_SIZE              MBED_CONF_LWIP_PBUF_POOL_SIZE
 #else
 #ifndef PBUF_POOL_SIZE
+#ifdef MBED_CONF_LWIP_TCP_RCV_SCALE
+// A scaled window is only useful if received frames can fill it
+#define PBUF_POOL_SIZE              (TCP_WND / TCP_MSS + 2)
+#else
 #define PBUF_POOL_SIZE              5
 #endif
 #endif
+#endif
 
 #ifdef MBED_CONF_LWIP_PBUF_POOL_BUFSIZE
 #undef PBUF_POOL_BUFSIZE
@@ -196,6 +231,14 @@
 #define MEM_SIZE                    MBED_CONF_LWIP_MEM_SIZE
 #endif
 
+// Allocate the heap from pools of a few sizes, defined in lwippools.h,
+// so that bursts of allocations don't fragment it.
+#if MBED_CONF_LWIP_MEM_POOLS_ENABLED
+#define MEM_USE_POOLS               1
+#define MEM_USE_POOLS_TRY_BIGGER_POOL 1
+#define MEMP_USE_CUSTOM_POOLS       1
+#endif
+
 // One tcp_pcb_listen is needed for each TCPServer.
 // Each requires 72 bytes of RAM.
 #ifdef MBED_CONF_LWIP_TCP_SERVER_MAX
@@ -253,6 +296,7 @@
 #define LWIP_SOCKET                 0
 
 #define SO_REUSE                    1
+#define LWIP_SO_LINGER              1
 
 // Support Multicast
 #include "stdlib.h"
@@ -319,8 +363,27 @@
 #define LWIP_DBG_MIN_LEVEL          LWIP_DBG_LEVEL_ALL
 #else
 #define LWIP_NOASSERT               1
+#if MBED_CONF_LWIP_MEM_PROFILE
+// Only the memory statistics are needed by the memory profile
+#define LWIP_STATS                  1
+#define LINK_STATS                  0
+#define ETHARP_STATS                0
+#define IP_STATS                    0
+#define IPFRAG_STATS                0
+#define ICMP_STATS                  0
+#define IGMP_STATS                  0
+#define UDP_STATS                   0
+#define TCP_STATS                   0
+#define SYS_STATS                   0
+#define IP6_STATS                   0
+#define ICMP6_STATS                 0
+#define IP6_FRAG_STATS              0
+#define MLD6_STATS                  0
+#define ND6_STATS                   0
+#else
 #define LWIP_STATS                  0
 #endif
+#endif
 
 #define TRACE_TO_ASCII_HEX_DUMP     0
 
@@ -372,6 +435,9 @@
 // Checksum-on-copy disabled due to https://savannah.nongnu.org/bugs/?50914
 #define LWIP_CHECKSUM_ON_COPY       0
 
+// Lets EMACs with checksum offload switch off the software checksums
+#define LWIP_CHECKSUM_CTRL_PER_NETIF 1
+
 #define LWIP_NETIF_HOSTNAME         1
 #define LWIP_NETIF_STATUS_CALLBACK  1
 #define LWIP_NETIF_LINK_CALLBACK    1
@@ -0,0 +1,26 @@
+/* Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Included several times by memp_std.h, so there is no include guard.
+
+// Pools mem_malloc() allocates from when lwip.mem-pools-enabled is set.
+// They must be listed in increasing size order.
+#if MEM_USE_POOLS
+LWIP_MALLOC_MEMPOOL_START
+LWIP_MALLOC_MEMPOOL(MBED_CONF_LWIP_MEM_POOL_SMALL_NUM, MBED_CONF_LWIP_MEM_POOL_SMALL_SIZE)
+LWIP_MALLOC_MEMPOOL(MBED_CONF_LWIP_MEM_POOL_MEDIUM_NUM, MBED_CONF_LWIP_MEM_POOL_MEDIUM_SIZE)
+LWIP_MALLOC_MEMPOOL(MBED_CONF_LWIP_MEM_POOL_LARGE_NUM, MBED_CONF_LWIP_MEM_POOL_LARGE_SIZE)
+LWIP_MALLOC_MEMPOOL_END
+#endif
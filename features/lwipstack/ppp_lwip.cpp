@@ -252,10 +252,12 @@ static void ppp_input()
         return;
     }
 
+    // Only this thread reads, so the buffer needn't be on its stack
+    static u8_t buffer[MBED_CONF_LWIP_PPP_INPUT_BUFFER_SIZE];
+
     // Infinite loop, but we assume that we can read faster than the
     // serial, so we will fairly rapidly hit -EAGAIN.
     for (;;) {
-        u8_t buffer[16];
         ssize_t len = my_stream->read(buffer, sizeof buffer);
         if (len == -EAGAIN) {
             break;
@@ -0,0 +1,155 @@
+/*
+  *  crypto_accel.h
+  *
+  *  Copyright (C) 2019, Arm Limited, All Rights Reserved
+  *  SPDX-License-Identifier: Apache-2.0
+  *
+  *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+  *  not use this file except in compliance with the License.
+  *  You may obtain a copy of the License at
+  *
+  *  http://www.apache.org/licenses/LICENSE-2.0
+  *
+  *  Unless required by applicable law or agreed to in writing, software
+  *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+  *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  *  See the License for the specific language governing permissions and
+  *  limitations under the License.
+  *
+  */
+
+#ifndef __CRYPTO_ACCEL__
+#define __CRYPTO_ACCEL__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief   Operations a crypto job can run.
+ */
+typedef enum {
+    MBED_CRYPTO_ACCEL_AES_GCM_ENCRYPT = 0, /**< AES-GCM encryption, producing a tag */
+    MBED_CRYPTO_ACCEL_AES_GCM_DECRYPT,     /**< AES-GCM decryption, checking a tag */
+    MBED_CRYPTO_ACCEL_AES_CMAC,            /**< AES-CMAC of the input */
+    MBED_CRYPTO_ACCEL_SHA256,              /**< SHA-256 digest of the input */
+    MBED_CRYPTO_ACCEL_OP_COUNT
+} mbed_crypto_accel_op_t;
+
+/** Bit of an operation in mbed_crypto_accel_driver_t::ops */
+#define MBED_CRYPTO_ACCEL_OP_BIT(op)    (1UL << (op))
+
+/** Status of a job submitted and not completed yet */
+#define MBED_CRYPTO_ACCEL_PENDING       1
+
+typedef struct mbed_crypto_accel_job mbed_crypto_accel_job_t;
+
+/**
+ * \brief   Callback called when a job completes.
+ *
+ * \note    It may be called from interrupt context, by the driver.
+ */
+typedef void (*mbed_crypto_accel_done_t)(mbed_crypto_accel_job_t *job);
+
+/**
+ * \brief   A crypto job.
+ *
+ *          Jobs are linked by \c next to be submitted as a batch. The
+ *          buffers must stay valid until the job completes, and must be
+ *          reachable by DMA for jobs run by a driver.
+ */
+struct mbed_crypto_accel_job {
+    mbed_crypto_accel_op_t op;      /**< Operation to run */
+    const unsigned char *key;       /**< AES key, unused by SHA-256 */
+    unsigned int key_bits;          /**< Size of the key in bits */
+    const unsigned char *iv;        /**< GCM initialization vector */
+    size_t iv_len;                  /**< Size of the IV */
+    const unsigned char *add;       /**< GCM additional data */
+    size_t add_len;                 /**< Size of the additional data */
+    const unsigned char *input;     /**< Data to process */
+    size_t length;                  /**< Size of the input */
+    unsigned char *output;          /**< GCM output, of the size of the input */
+    unsigned char *tag;             /**< GCM tag, CMAC or SHA-256 digest */
+    size_t tag_len;                 /**< Size of the tag: 16 for CMAC, 32 for SHA-256 */
+    volatile int status;            /**< MBED_CRYPTO_ACCEL_PENDING, then 0 or an Mbed TLS error code */
+    mbed_crypto_accel_done_t done;  /**< Completion callback, or NULL */
+    void *context;                  /**< User data of the callback */
+    mbed_crypto_accel_job_t *next;  /**< Next job of the batch, or NULL */
+    void *waiter;                   /**< Used internally by mbed_crypto_accel_run() */
+};
+
+/**
+ * \brief   A hardware crypto engine.
+ */
+typedef struct {
+    /** Operations the engine runs, as MBED_CRYPTO_ACCEL_OP_BIT() flags */
+    uint32_t ops;
+
+    /**
+     * \brief   Start a job.
+     *
+     *          The driver queues the job and returns, then calls
+     *          mbed_crypto_accel_complete() when the engine is done with
+     *          it, typically from its DMA completion interrupt.
+     *
+     * \return  \c 0 if the job was queued, or an Mbed TLS error code, in
+     *          which case the job is run in software.
+     */
+    int (*submit)(mbed_crypto_accel_job_t *job);
+} mbed_crypto_accel_driver_t;
+
+/**
+ * \brief   Get the hardware crypto engine of the target.
+ *
+ * \return  The engine, or NULL to run all jobs in software.
+ *
+ * \note    The default implementation is weak and returns NULL. Targets
+ *          with an engine override it.
+ */
+const mbed_crypto_accel_driver_t *mbed_crypto_accel_get_driver(void);
+
+/**
+ * \brief   Submit a batch of jobs.
+ *
+ *          Jobs the engine supports are queued to it, and the others run in
+ *          software before this function returns. The callback of each job
+ *          is called when it completes.
+ *
+ * \param   jobs    First job of the batch.
+ *
+ * \return  \c 0 once all jobs are submitted. The status of each job tells
+ *          its outcome.
+ */
+int mbed_crypto_accel_submit(mbed_crypto_accel_job_t *jobs);
+
+/**
+ * \brief   Run a batch of jobs and wait until they all complete.
+ *
+ *          The calling thread sleeps while the engine works, so other
+ *          threads can use the CPU.
+ *
+ * \param   jobs    First job of the batch. Their callbacks must be NULL.
+ *
+ * \return  \c 0 if all jobs succeeded, or the error code of the first job
+ *          that failed.
+ */
+int mbed_crypto_accel_run(mbed_crypto_accel_job_t *jobs);
+
+/**
+ * \brief   Report the completion of a job. Called by drivers.
+ *
+ * \param   job     Job that completed.
+ * \param   status  \c 0 on success, or an Mbed TLS error code.
+ *
+ * \note    Can be called from interrupt context.
+ */
+void mbed_crypto_accel_complete(mbed_crypto_accel_job_t *job, int status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CRYPTO_ACCEL__ */
@@ -0,0 +1,178 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "crypto_accel.h"
+#include "mbedtls/platform.h"
+#include "mbedtls/gcm.h"
+#include "mbedtls/cmac.h"
+#include "mbedtls/sha256.h"
+#include "mbedtls/md.h"
+#include "platform/mbed_toolchain.h"
+#if MBED_CONF_RTOS_PRESENT
+#include "rtos/Semaphore.h"
+#else
+#include "platform/mbed_critical.h"
+#include "platform/mbed_power_mgmt.h"
+#endif
+
+// Status of a job left to the software pass of mbed_crypto_accel_submit()
+#define STATUS_IN_SOFTWARE  (MBED_CRYPTO_ACCEL_PENDING + 1)
+
+MBED_WEAK const mbed_crypto_accel_driver_t *mbed_crypto_accel_get_driver(void)
+{
+    return NULL;
+}
+
+static int run_in_software(mbed_crypto_accel_job_t *job)
+{
+    switch (job->op) {
+#if defined(MBEDTLS_GCM_C)
+        case MBED_CRYPTO_ACCEL_AES_GCM_ENCRYPT:
+        case MBED_CRYPTO_ACCEL_AES_GCM_DECRYPT: {
+            mbedtls_gcm_context gcm;
+            mbedtls_gcm_init(&gcm);
+            int ret = mbedtls_gcm_setkey(&gcm, MBEDTLS_CIPHER_ID_AES, job->key, job->key_bits);
+            if (ret == 0 && job->op == MBED_CRYPTO_ACCEL_AES_GCM_ENCRYPT) {
+                ret = mbedtls_gcm_crypt_and_tag(&gcm, MBEDTLS_GCM_ENCRYPT, job->length,
+                                                job->iv, job->iv_len, job->add, job->add_len,
+                                                job->input, job->output, job->tag_len, job->tag);
+            } else if (ret == 0) {
+                ret = mbedtls_gcm_auth_decrypt(&gcm, job->length, job->iv, job->iv_len,
+                                               job->add, job->add_len, job->tag, job->tag_len,
+                                               job->input, job->output);
+            }
+            mbedtls_gcm_free(&gcm);
+            return ret;
+        }
+#endif
+#if defined(MBEDTLS_CMAC_C)
+        case MBED_CRYPTO_ACCEL_AES_CMAC: {
+            mbedtls_cipher_type_t type;
+            switch (job->key_bits) {
+                case 128:
+                    type = MBEDTLS_CIPHER_AES_128_ECB;
+                    break;
+                case 192:
+                    type = MBEDTLS_CIPHER_AES_192_ECB;
+                    break;
+                case 256:
+                    type = MBEDTLS_CIPHER_AES_256_ECB;
+                    break;
+                default:
+                    return MBEDTLS_ERR_CIPHER_BAD_INPUT_DATA;
+            }
+            if (job->tag_len < 16) {
+                return MBEDTLS_ERR_CIPHER_BAD_INPUT_DATA;
+            }
+            return mbedtls_cipher_cmac(mbedtls_cipher_info_from_type(type), job->key, job->key_bits,
+                                       job->input, job->length, job->tag);
+        }
+#endif
+#if defined(MBEDTLS_SHA256_C)
+        case MBED_CRYPTO_ACCEL_SHA256:
+            if (job->tag_len < 32) {
+                return MBEDTLS_ERR_MD_BAD_INPUT_DATA;
+            }
+            return mbedtls_sha256_ret(job->input, job->length, job->tag, 0);
+#endif
+        default:
+            return MBEDTLS_ERR_PLATFORM_FEATURE_UNSUPPORTED;
+    }
+}
+
+int mbed_crypto_accel_submit(mbed_crypto_accel_job_t *jobs)
+{
+    const mbed_crypto_accel_driver_t *driver = mbed_crypto_accel_get_driver();
+
+    // Queue all the jobs of the engine first, so that it works on them
+    // while the others run in software
+    for (mbed_crypto_accel_job_t *job = jobs; job; job = job->next) {
+        job->status = MBED_CRYPTO_ACCEL_PENDING;
+        if (driver && (driver->ops & MBED_CRYPTO_ACCEL_OP_BIT(job->op))
+                && driver->submit(job) == 0) {
+            continue;
+        }
+        job->status = STATUS_IN_SOFTWARE;
+    }
+
+    for (mbed_crypto_accel_job_t *job = jobs; job; job = job->next) {
+        if (job->status == STATUS_IN_SOFTWARE) {
+            job->status = MBED_CRYPTO_ACCEL_PENDING;
+            mbed_crypto_accel_complete(job, run_in_software(job));
+        }
+    }
+    return 0;
+}
+
+void mbed_crypto_accel_complete(mbed_crypto_accel_job_t *job, int status)
+{
+    // The job may be reused as soon as its status is set, so read the
+    // callback first
+    mbed_crypto_accel_done_t done = job->done;
+    job->status = status;
+    if (done) {
+        done(job);
+    }
+}
+
+#if MBED_CONF_RTOS_PRESENT
+static void wake_waiter(mbed_crypto_accel_job_t *job)
+{
+    static_cast<rtos::Semaphore *>(job->waiter)->release();
+}
+#endif
+
+int mbed_crypto_accel_run(mbed_crypto_accel_job_t *jobs)
+{
+#if MBED_CONF_RTOS_PRESENT
+    rtos::Semaphore completed(0);
+    for (mbed_crypto_accel_job_t *job = jobs; job; job = job->next) {
+        job->waiter = &completed;
+        job->done = wake_waiter;
+    }
+#endif
+
+    mbed_crypto_accel_submit(jobs);
+
+    int ret = 0;
+    for (mbed_crypto_accel_job_t *job = jobs; job; job = job->next) {
+#if MBED_CONF_RTOS_PRESENT
+        // Each completion releases the semaphore once
+        completed.wait();
+#else
+        // Interrupts wake the core up even when masked, so checking the
+        // status in a critical section doesn't miss the completion
+        core_util_critical_section_enter();
+        while (job->status == MBED_CRYPTO_ACCEL_PENDING) {
+            sleep_manager_sleep_auto();
+            core_util_critical_section_exit();
+            core_util_critical_section_enter();
+        }
+        core_util_critical_section_exit();
+#endif
+    }
+
+    for (mbed_crypto_accel_job_t *job = jobs; job; job = job->next) {
+#if MBED_CONF_RTOS_PRESENT
+        job->done = NULL;
+        job->waiter = NULL;
+#endif
+        if (ret == 0) {
+            ret = job->status;
+        }
+    }
+    return ret;
+}
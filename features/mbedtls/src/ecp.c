@@ -556,6 +556,20 @@ void mbedtls_ecp_point_free( mbedtls_ecp_point *pt )
     mbedtls_mpi_free( &( pt->Z ) );
 }
 
+/*
+ * Is the comb table of the base point precomputed in flash?
+ * ecp_curves.c marks such tables with a zero size, they are never freed.
+ */
+static int ecp_group_is_static_comb_table( const mbedtls_ecp_group *grp )
+{
+#if MBEDTLS_ECP_FIXED_POINT_OPTIM == 1
+    return( grp->T != NULL && grp->T_size == 0 );
+#else
+    (void) grp;
+    return( 0 );
+#endif
+}
+
 /*
  * Unallocate (the components of) a group
  */
@@ -575,7 +589,7 @@ void mbedtls_ecp_group_free( mbedtls_ecp_group *grp )
         mbedtls_mpi_free( &grp->N );
     }
 
-    if( grp->T != NULL )
+    if( grp->T != NULL && !ecp_group_is_static_comb_table( grp ) )
     {
         for( i = 0; i < grp->T_size; i++ )
             mbedtls_ecp_point_free( &grp->T[i] );
@@ -1872,10 +1886,12 @@ static unsigned char ecp_pick_window_size( const mbedtls_ecp_group *grp,
         w++;
 
     /*
-     * Make sure w is within bounds.
+     * Make sure w is within bounds, unless using a static table which is
+     * already computed for this w.
      * (The last test is useful only for very small curves in the test suite.)
      */
-    if( w > MBEDTLS_ECP_WINDOW_SIZE )
+    if( ( !p_eq_g || !ecp_group_is_static_comb_table( grp ) ) &&
+        w > MBEDTLS_ECP_WINDOW_SIZE )
         w = MBEDTLS_ECP_WINDOW_SIZE;
     if( w >= grp->nbits )
         w = 2;
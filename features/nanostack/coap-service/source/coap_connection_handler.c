@@ -43,6 +43,7 @@ typedef struct internal_socket_s {
     uint16_t listen_port; // 0 for ephemeral-port sockets
 
     int16_t data_len;
+    uint16_t data_size;
     uint8_t *data;
 
     int8_t socket;  //positive value = socket id, negative value virtual socket id
@@ -61,6 +62,11 @@ const uint8_t COAP_MULTICAST_ADDR_SITE_LOCAL[16] = { 0xff, 0x05, [15] = 0xfd };
 
 static NS_LIST_DEFINE(socket_list, internal_socket_t, link);
 
+#if COAP_MESSAGE_BUFFER_COUNT > 0
+static uint8_t *message_buffer_pool[COAP_MESSAGE_BUFFER_COUNT];
+static uint8_t message_buffer_count;
+#endif
+
 static uint8_t max_handshakes = MAX_ONGOING_HANDSHAKES;
 static uint8_t max_sessions = MAX_SECURE_SESSION_COUNT;
 
@@ -96,15 +102,67 @@ typedef struct secure_session {
 
     session_state_t session_state;
     uint32_t last_contact_time;
+    struct secure_session *hash_next;
     ns_list_link_t link;
 } secure_session_t;
 
 static NS_LIST_DEFINE(secure_session_list, secure_session_t, link);
+static secure_session_t *secure_session_table[SECURE_SESSION_TABLE_SIZE];
 static int secure_session_sendto(int8_t socket_id, void *handle, const void *buf, size_t len);
 static int secure_session_recvfrom(int8_t socket_id, unsigned char *buf, size_t len);
 static void start_timer(int8_t timer_id, uint32_t int_ms, uint32_t fin_ms);
 static int timer_status(int8_t timer_id);
 
+static uint8_t *message_buffer_alloc(uint16_t len)
+{
+#if COAP_MESSAGE_BUFFER_COUNT > 0
+    if (len <= COAP_MESSAGE_BUFFER_SIZE) {
+        if (message_buffer_count) {
+            return message_buffer_pool[--message_buffer_count];
+        }
+        return ns_dyn_mem_alloc(COAP_MESSAGE_BUFFER_SIZE);
+    }
+#endif
+    return ns_dyn_mem_temporary_alloc(len);
+}
+
+static void message_buffer_free(uint8_t *buf, uint16_t len)
+{
+#if COAP_MESSAGE_BUFFER_COUNT > 0
+    if (buf && len <= COAP_MESSAGE_BUFFER_SIZE && message_buffer_count < COAP_MESSAGE_BUFFER_COUNT) {
+        message_buffer_pool[message_buffer_count++] = buf;
+        return;
+    }
+#else
+    (void)len;
+#endif
+    ns_dyn_mem_free(buf);
+}
+
+static bool sock_data_alloc(internal_socket_t *sock, uint16_t len)
+{
+    sock->data = message_buffer_alloc(len);
+    sock->data_size = len;
+    return sock->data != NULL;
+}
+
+static void sock_data_free(internal_socket_t *sock)
+{
+    message_buffer_free(sock->data, sock->data_size);
+    sock->data = NULL;
+    sock->data_size = 0;
+}
+
+static secure_session_t **secure_session_bucket(const uint8_t *address_ptr, uint16_t port)
+{
+    // The interface identifier and the port tell the peers apart
+    uint16_t hash = port;
+    for (int i = 8; i < 16; i++) {
+        hash = hash * 31 + address_ptr[i];
+    }
+    return &secure_session_table[hash & (SECURE_SESSION_TABLE_SIZE - 1)];
+}
+
 static secure_session_t *secure_session_find_by_timer_id(int8_t timer_id)
 {
     secure_session_t *this = NULL;
@@ -131,6 +189,13 @@ static void secure_session_delete(secure_session_t *this)
 {
     if (this) {
         ns_list_remove(&secure_session_list, this);
+        secure_session_t **bucket = secure_session_bucket(this->remote_host.address, this->remote_host.identifier);
+        while (*bucket && *bucket != this) {
+            bucket = &(*bucket)->hash_next;
+        }
+        if (*bucket) {
+            *bucket = this->hash_next;
+        }
         transactions_delete_all(this->remote_host.address, this->remote_host.identifier);
         if (this->sec_handler) {
             coap_security_destroy(this->sec_handler);
@@ -225,6 +290,9 @@ static secure_session_t *secure_session_create(internal_socket_t *parent, const
 
     this->session_state = SECURE_SESSION_HANDSHAKE_ONGOING;
     ns_list_add_to_start(&secure_session_list, this);
+    secure_session_t **bucket = secure_session_bucket(address_ptr, port);
+    this->hash_next = *bucket;
+    *bucket = this;
 
     return this;
 }
@@ -245,7 +313,7 @@ static void clear_secure_sessions(internal_socket_t *this)
 static secure_session_t *secure_session_find(internal_socket_t *parent, const uint8_t *address_ptr, uint16_t port)
 {
     secure_session_t *this = NULL;
-    ns_list_foreach(secure_session_t, cur_ptr, &secure_session_list) {
+    for (secure_session_t *cur_ptr = *secure_session_bucket(address_ptr, port); cur_ptr; cur_ptr = cur_ptr->hash_next) {
         if (cur_ptr->sec_handler) {
             if (cur_ptr->parent == parent && cur_ptr->remote_host.identifier == port &&
                     memcmp(cur_ptr->remote_host.address, address_ptr, 16) == 0) {
@@ -355,8 +423,7 @@ static void int_socket_delete(internal_socket_t *this)
             socket_close(this->socket);
             ns_list_remove(&socket_list, this);
             if (this->data) {
-                ns_dyn_mem_free(this->data);
-                this->data = NULL;
+                sock_data_free(this);
             }
             if (this->parent) {
                 ns_dyn_mem_free(this->parent);
@@ -467,8 +534,7 @@ static int secure_session_recvfrom(int8_t socket_id, unsigned char *buf, size_t
     if (sock->data && sock->data_len > 0) {
         memcpy(buf, sock->data, sock->data_len);
         int l = sock->data_len;
-        ns_dyn_mem_free(sock->data);
-        sock->data = NULL;
+        sock_data_free(sock);
         sock->data_len = 0;
         return l;
     }
@@ -555,13 +621,10 @@ static int read_data(socket_callback_t *sckt_data, internal_socket_t *sock, ns_a
         ns_in6_pktinfo_t *pkt = NULL;
 
         if (sock->data) {
-            ns_dyn_mem_free(sock->data);
-            sock->data = NULL;
+            sock_data_free(sock);
         }
 
-        sock->data = ns_dyn_mem_temporary_alloc(sckt_data->d_len);
-        if (!sock->data) {
-            sock->data = NULL;
+        if (!sock_data_alloc(sock, sckt_data->d_len)) {
             return -1;
         }
 
@@ -605,8 +668,7 @@ static int read_data(socket_callback_t *sckt_data, internal_socket_t *sock, ns_a
     return 0;
 
 return_failure:
-    ns_dyn_mem_free(sock->data);
-    sock->data = NULL;
+    sock_data_free(sock);
     sock->data_len = 0;
     return -1;
 
@@ -682,7 +744,8 @@ static void secure_recv_sckt_msg(void *cb_res)
                 }
                 //Session valid
             } else {
-                unsigned char *data = ns_dyn_mem_temporary_alloc(sock->data_len);
+                uint16_t data_size = sock->data_len;
+                unsigned char *data = message_buffer_alloc(data_size);
                 int len = 0;
                 len = coap_security_handler_read(session->sec_handler, data, sock->data_len);
                 if (len < 0) {
@@ -690,12 +753,12 @@ static void secure_recv_sckt_msg(void *cb_res)
                             len != MBEDTLS_ERR_SSL_UNEXPECTED_MESSAGE) {
                         secure_session_delete(session);
                     }
-                    ns_dyn_mem_free(data);
+                    message_buffer_free(data, data_size);
                 } else {
                     if (sock->parent->_recv_cb) {
                         sock->parent->_recv_cb(sock->socket, src_address.address, src_address.identifier, dst_address, data, len);
                     }
-                    ns_dyn_mem_free(data);
+                    message_buffer_free(data, data_size);
                 }
             }
         }
@@ -714,8 +777,7 @@ static void recv_sckt_msg(void *cb_res)
         if (sock->parent && sock->parent->_recv_cb) {
             sock->parent->_recv_cb(sock->socket, src_address.address, src_address.identifier, dst_address, sock->data, sock->data_len);
         }
-        ns_dyn_mem_free(sock->data);
-        sock->data = NULL;
+        sock_data_free(sock);
     }
 }
 
@@ -727,19 +789,16 @@ int coap_connection_handler_virtual_recv(coap_conn_handler_t *handler, uint8_t a
     internal_socket_t *sock = handler->socket;
     sock->data_len = data_len;
     if (sock->data) {
-        ns_dyn_mem_free(sock->data);
-        sock->data = NULL;
+        sock_data_free(sock);
     }
-    sock->data = ns_dyn_mem_temporary_alloc(data_len);
-    if (data_len > 0 && !sock->data) {
+    if (!sock_data_alloc(sock, data_len) && data_len > 0) {
         return -1;
     }
     if (data_ptr) {
         memcpy(sock->data, data_ptr, data_len);
     } else {
         if (sock->data) {
-            ns_dyn_mem_free(sock->data);
-            sock->data = NULL;
+            sock_data_free(sock);
         }
     }
 
@@ -789,7 +848,8 @@ int coap_connection_handler_virtual_recv(coap_conn_handler_t *handler, uint8_t a
                 }
                 //TODO: error handling
             } else {
-                unsigned char *data = ns_dyn_mem_temporary_alloc(sock->data_len);
+                uint16_t data_size = sock->data_len;
+                unsigned char *data = message_buffer_alloc(data_size);
                 int len = 0;
                 len = coap_security_handler_read(session->sec_handler, data, sock->data_len);
                 if (len < 0) {
@@ -797,13 +857,13 @@ int coap_connection_handler_virtual_recv(coap_conn_handler_t *handler, uint8_t a
                             len != MBEDTLS_ERR_SSL_UNEXPECTED_MESSAGE) {
                         secure_session_delete(session);
                     }
-                    ns_dyn_mem_free(data);
+                    message_buffer_free(data, data_size);
                     return 0;
                 } else {
                     if (sock->parent->_recv_cb) {
                         sock->parent->_recv_cb(sock->socket, address, port, ns_in6addr_any, data, len);
                     }
-                    ns_dyn_mem_free(data);
+                    message_buffer_free(data, data_size);
                     data = NULL;
                 }
                 return 0;
@@ -815,8 +875,7 @@ int coap_connection_handler_virtual_recv(coap_conn_handler_t *handler, uint8_t a
             sock->parent->_recv_cb(sock->socket, address, port, ns_in6addr_any, sock->data, sock->data_len);
         }
         if (sock->data) {
-            ns_dyn_mem_free(sock->data);
-            sock->data = NULL;
+            sock_data_free(sock);
         }
         return 0;
     }
@@ -56,6 +56,7 @@ struct coap_security_s {
 
     uint8_t                     _pw[64];
     uint8_t                     _pw_len;
+    uint8_t                     _ssl_transport;     // Transport _ssl is set up for, when _ssl.conf is set
 
     bool                        _is_blocking;
     int8_t                      _socket_id;
@@ -84,6 +85,11 @@ static const int PSK_SUITES[] = {
 
 #define TRACE_GROUP "CsSh"
 
+#if COAP_SECURITY_POOL_SIZE > 0
+static coap_security_t *security_pool[COAP_SECURITY_POOL_SIZE];
+static uint8_t security_pool_count;
+#endif
+
 static void set_timer(void *sec_obj, uint32_t int_ms, uint32_t fin_ms);
 static int get_timer(void *sec_obj);
 
@@ -164,6 +170,35 @@ static void coap_security_handler_reset(coap_security_t *sec)
 }
 
 
+#if COAP_SECURITY_POOL_SIZE > 0
+/* Clear the state of a session, keeping the random generator and the SSL
+ * context with its record buffers */
+static void coap_security_handler_clear(coap_security_t *sec)
+{
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+    mbedtls_x509_crt_free(&sec->_cacert);
+    mbedtls_x509_crt_init(&sec->_cacert);
+    mbedtls_x509_crt_free(&sec->_owncert);
+    mbedtls_x509_crt_init(&sec->_owncert);
+    mbedtls_pk_free(&sec->_pkey);
+    mbedtls_pk_init(&sec->_pkey);
+#endif
+
+    if (sec->_ssl.conf) {
+        mbedtls_ssl_session_reset(&sec->_ssl);
+    }
+    // Frees the PSK, the configuration is set again on the next connect
+    mbedtls_ssl_config_free(&sec->_conf);
+    mbedtls_ssl_config_init(&sec->_conf);
+
+    memset(&sec->_cookie, 0, sizeof(simple_cookie_t));
+    memset(&sec->_keyblk, 0, sizeof(key_block_t));
+    memset(sec->_pw, 0, sizeof(sec->_pw));
+    sec->_pw_len = 0;
+    sec->_is_started = false;
+}
+#endif
+
 coap_security_t *coap_security_create(int8_t socket_id, int8_t timer_id, void *handle, SecureConnectionMode mode,
                                       send_cb *socket_cb,
                                       receive_cb *receive_data_cb,
@@ -173,14 +208,22 @@ coap_security_t *coap_security_create(int8_t socket_id, int8_t timer_id, void *h
     if (socket_cb == NULL || receive_data_cb == NULL || timer_start_cb == NULL || timer_stat_cb == NULL) {
         return NULL;
     }
-    coap_security_t *this = ns_dyn_mem_alloc(sizeof(coap_security_t));
-    if (!this) {
-        return NULL;
+    coap_security_t *this = NULL;
+#if COAP_SECURITY_POOL_SIZE > 0
+    if (security_pool_count) {
+        this = security_pool[--security_pool_count];
     }
-    memset(this, 0, sizeof(coap_security_t));
-    if (-1 == coap_security_handler_init(this)) {
-        ns_dyn_mem_free(this);
-        return NULL;
+#endif
+    if (!this) {
+        this = ns_dyn_mem_alloc(sizeof(coap_security_t));
+        if (!this) {
+            return NULL;
+        }
+        memset(this, 0, sizeof(coap_security_t));
+        if (-1 == coap_security_handler_init(this)) {
+            ns_dyn_mem_free(this);
+            return NULL;
+        }
     }
     this->_handle = handle;
     this->_conn_mode = mode;
@@ -198,6 +241,13 @@ coap_security_t *coap_security_create(int8_t socket_id, int8_t timer_id, void *h
 
 void coap_security_destroy(coap_security_t *sec)
 {
+#if COAP_SECURITY_POOL_SIZE > 0
+    if (sec && security_pool_count < COAP_SECURITY_POOL_SIZE) {
+        coap_security_handler_clear(sec);
+        security_pool[security_pool_count++] = sec;
+        return;
+    }
+#endif
     if (sec) {
         coap_security_handler_reset(sec);
         ns_dyn_mem_free(sec);
@@ -389,8 +439,20 @@ int coap_security_handler_connect_non_blocking(coap_security_t *sec, bool is_ser
 
     mbedtls_ssl_conf_rng(&sec->_conf, mbedtls_ctr_drbg_random, &sec->_ctr_drbg);
 
-    if ((mbedtls_ssl_setup(&sec->_ssl, &sec->_conf)) != 0) {
-        return -1;
+    if (sec->_ssl.conf && sec->_ssl_transport != mode) {
+        // Recycled context set up for the other record layout
+        mbedtls_ssl_free(&sec->_ssl);
+        mbedtls_ssl_init(&sec->_ssl);
+    }
+    // A recycled context was reset, and keeps its record buffers
+    if (!sec->_ssl.conf) {
+        if ((mbedtls_ssl_setup(&sec->_ssl, &sec->_conf)) != 0) {
+            // Not to be taken as set up if recycled
+            mbedtls_ssl_free(&sec->_ssl);
+            mbedtls_ssl_init(&sec->_ssl);
+            return -1;
+        }
+        sec->_ssl_transport = mode;
     }
 
     mbedtls_ssl_set_bio(&sec->_ssl, sec,
@@ -32,6 +32,22 @@
 #define OPEN_SECURE_SESSION_TIMEOUT 18000           // Seconds
 #define SECURE_SESSION_CLEAN_INTERVAL 60            // Seconds
 
+/* Buckets of the table finding secure sessions by remote address and port,
+ * a power of two */
+#ifndef SECURE_SESSION_TABLE_SIZE
+#define SECURE_SESSION_TABLE_SIZE 8
+#endif
+
+/* Freed message buffers of COAP_MESSAGE_BUFFER_SIZE bytes kept to receive
+ * the next messages, instead of allocating a buffer of each message length.
+ * Longer messages are still allocated. 0 disables the pool. */
+#ifndef COAP_MESSAGE_BUFFER_COUNT
+#define COAP_MESSAGE_BUFFER_COUNT 0
+#endif
+#ifndef COAP_MESSAGE_BUFFER_SIZE
+#define COAP_MESSAGE_BUFFER_SIZE 1280
+#endif
+
 struct internal_socket_s;
 
 typedef int send_to_socket_cb(int8_t socket_id, const uint8_t address[static 16], uint16_t port, const void *, int);
@@ -49,6 +49,13 @@ typedef int receive_cb(int8_t socket_id, unsigned char *, size_t);
 typedef void start_timer_cb(int8_t timer_id, uint32_t min, uint32_t fin);
 typedef int timer_status_cb(int8_t timer_id);
 
+/* Number of destroyed security handlers kept for new sessions, with their
+ * seeded random generator and SSL record buffers. Each holds the buffers
+ * of a connection, about twice MBEDTLS_SSL_MAX_CONTENT_LEN. */
+#ifndef COAP_SECURITY_POOL_SIZE
+#define COAP_SECURITY_POOL_SIZE 0
+#endif
+
 #define DTLS_HANDSHAKE_TIMEOUT_MIN 25000
 #define DTLS_HANDSHAKE_TIMEOUT_MAX 201000
 
@@ -16,6 +16,7 @@
  */
 
 #include "mbedtls_stub.h"
+#include <string.h>
 
 mbedtls_stub_def mbedtls_stub;
 
@@ -47,7 +48,7 @@ int mbedtls_ssl_close_notify(mbedtls_ssl_context *a)
 
 void mbedtls_ssl_init(mbedtls_ssl_context *a)
 {
-
+    memset(a, 0, sizeof(mbedtls_ssl_context));
 }
 void mbedtls_ssl_conf_min_version(mbedtls_ssl_config *conf, int major, int minor)
 {
@@ -133,6 +134,14 @@ void mbedtls_ssl_conf_ciphersuites(mbedtls_ssl_config *a,
 
 }
 
+int mbedtls_ssl_conf_max_frag_len(mbedtls_ssl_config *a, unsigned char b)
+{
+    if (mbedtls_stub.useCounter) {
+        return mbedtls_stub.retArray[mbedtls_stub.counter++];
+    }
+    return mbedtls_stub.expected_int;
+}
+
 int mbedtls_ssl_setup(mbedtls_ssl_context *a,
                       const mbedtls_ssl_config *b)
 {
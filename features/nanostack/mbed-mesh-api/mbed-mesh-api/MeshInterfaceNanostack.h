@@ -30,6 +30,7 @@ public:
     virtual char *get_gateway(char *buf, nsapi_size_t buflen);
     virtual void attach(mbed::Callback<void(nsapi_event_t, intptr_t)> status_cb);
     virtual nsapi_connection_status_t get_connection_status() const;
+    virtual nsapi_error_t get_connection_timeline(nsapi_connection_timeline_t *timeline);
 
     void get_mac_address(uint8_t *buf) const
     {
@@ -56,6 +57,8 @@ private:
 protected:
     Interface(NanostackPhy &phy);
     virtual nsapi_error_t register_phy();
+    void start_timeline();
+    void record_phase(nsapi_connection_phase_t phase);
     NanostackPhy &get_phy() const
     {
         return interface_phy;
@@ -68,6 +71,8 @@ protected:
     nsapi_connection_status_t _connect_status;
     nsapi_connection_status_t _previous_connection_status;
     bool _blocking;
+    nsapi_connection_timeline_t _timeline;
+    uint32_t _connect_ticks;
 };
 
 class Nanostack::MeshInterface : public Nanostack::Interface {
@@ -120,6 +125,16 @@ public:
      */
     virtual nsapi_connection_status_t get_connection_status() const;
 
+    /** Get the timeline of the last connection
+     *
+     *  No DNS server phase is recorded, the stack doesn't report one.
+     *
+     *  @param timeline Structure to which the times will be copied
+     *  @return         NSAPI_ERROR_OK on success, or NSAPI_ERROR_NO_CONNECTION
+     *                  if the interface was never connected
+     */
+    virtual nsapi_error_t get_connection_timeline(nsapi_connection_timeline_t *timeline);
+
     /** Set blocking status of connect() which by default should be blocking
      *
      *  @param blocking true if connect is blocking
@@ -62,6 +62,15 @@ public:
 
     mesh_error_t device_pskd_set(const char *pskd);
 
+    /**
+     * \brief Get the network joining statistics.
+     * Counts and times the bootstrap attempts since the last connect, with
+     * the failures reported by the stack.
+     * \return MESH_ERROR_NONE on success.
+     * \return MESH_ERROR_STATE if the interface is not initialized.
+     * */
+    mesh_error_t get_join_stats(mesh_join_stats_t *stats);
+
 protected:
     Nanostack::ThreadInterface *get_interface() const;
     virtual nsapi_error_t do_initialize();
@@ -38,6 +38,15 @@ public:
     WisunInterface(NanostackRfPhy *phy) : MeshInterfaceNanostack(phy) { }
 
     bool getRouterIpAddress(char *address, int8_t len);
+
+    /**
+     * \brief Get the network joining statistics.
+     * Counts and times the bootstrap attempts since the last connect, with
+     * the failures reported by the stack.
+     * \return MESH_ERROR_NONE on success.
+     * \return MESH_ERROR_STATE if the interface is not initialized.
+     * */
+    mesh_error_t get_join_stats(mesh_join_stats_t *stats);
 protected:
     Nanostack::WisunInterface *get_interface() const;
     virtual nsapi_error_t do_initialize();
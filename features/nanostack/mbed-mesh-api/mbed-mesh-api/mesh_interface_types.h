@@ -17,6 +17,8 @@
 #ifndef __MESH_INTERFACE_TYPES_H__
 #define __MESH_INTERFACE_TYPES_H__
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -62,6 +64,21 @@ typedef enum {
     MESH_DEVICE_TYPE_THREAD_MINIMAL_END_DEVICE  /*<! Thread minimal end device */
 } mesh_device_type_t;
 
+/**
+ * Network joining statistics, collected from the bootstrap events of the stack.
+ * Times are in milliseconds, counted from the connect() call.
+ */
+typedef struct {
+    uint32_t join_attempts;             /*<! bootstrap starts, including restarts after a failure */
+    uint32_t scan_failures;             /*<! no network found on the scanned channels */
+    uint32_t auth_failures;             /*<! network authentication failures */
+    uint32_t address_failures;          /*<! address registration or allocation failures */
+    uint32_t connection_losses;         /*<! connection or parent lost after joining */
+    uint32_t time_to_join_ms;           /*<! time until the first bootstrap ready, 0 if not joined yet */
+    uint32_t time_in_failed_attempts_ms;/*<! time spent in attempts that failed */
+    uint32_t last_attempt_time_ms;      /*<! duration of the last finished attempt */
+} mesh_join_stats_t;
+
 #ifdef __cplusplus
 }
 #endif
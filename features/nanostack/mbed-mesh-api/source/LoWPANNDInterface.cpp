@@ -71,6 +71,7 @@ nsapi_error_t Nanostack::LoWPANNDInterface::bringup(bool dhcp, const char *ip,
     }
 
     _blocking = blocking;
+    start_timeline();
 
     // After the RF is up, we can seed the random from it.
     randLIB_seed_random();
@@ -22,6 +22,7 @@
 #include "thread_management_if.h"
 #include "ip6string.h"
 #include "mbed_error.h"
+#include "eventOS_event_timer.h"
 
 char *Nanostack::Interface::get_ip_address(char *buf, nsapi_size_t buflen)
 {
@@ -63,6 +64,12 @@ nsapi_connection_status_t Nanostack::Interface::get_connection_status() const
     return _connect_status;
 }
 
+nsapi_error_t Nanostack::Interface::get_connection_timeline(nsapi_connection_timeline_t *timeline)
+{
+    *timeline = _timeline;
+    return NSAPI_ERROR_OK;
+}
+
 void Nanostack::Interface::attach(
     mbed::Callback<void(nsapi_event_t, intptr_t)> status_cb)
 {
@@ -70,11 +77,26 @@ void Nanostack::Interface::attach(
 }
 
 Nanostack::Interface::Interface(NanostackPhy &phy) : interface_phy(phy), interface_id(-1), _device_id(-1),
-    _connect_status(NSAPI_STATUS_DISCONNECTED), _previous_connection_status(NSAPI_STATUS_DISCONNECTED), _blocking(true)
+    _connect_status(NSAPI_STATUS_DISCONNECTED), _previous_connection_status(NSAPI_STATUS_DISCONNECTED), _blocking(true),
+    _timeline(), _connect_ticks(0)
 {
     mesh_system_init();
 }
 
+void Nanostack::Interface::start_timeline()
+{
+    memset(&_timeline, 0, sizeof _timeline);
+    _connect_ticks = eventOS_event_timer_ticks();
+}
+
+void Nanostack::Interface::record_phase(nsapi_connection_phase_t phase)
+{
+    if (_timeline.phase_ms[phase] == 0) {
+        uint32_t elapsed = eventOS_event_timer_ticks_to_ms(eventOS_event_timer_ticks() - _connect_ticks);
+        _timeline.phase_ms[phase] = elapsed ? elapsed : 1;
+    }
+}
+
 
 InterfaceNanostack::InterfaceNanostack()
     : _interface(NULL),
@@ -145,6 +167,16 @@ void Nanostack::Interface::network_handler(mesh_connection_status_t status)
         _connect_status = NSAPI_STATUS_DISCONNECTED;
     }
 
+    if (status == MESH_CONNECTED || status == MESH_CONNECTED_LOCAL || status == MESH_CONNECTED_GLOBAL) {
+        record_phase(NSAPI_PHASE_LINK_UP);
+    }
+    if (_connect_status == NSAPI_STATUS_LOCAL_UP || _connect_status == NSAPI_STATUS_GLOBAL_UP) {
+        record_phase(NSAPI_PHASE_ADDRESS);
+    }
+    if (_connect_status == NSAPI_STATUS_GLOBAL_UP) {
+        record_phase(NSAPI_PHASE_GLOBAL_UP);
+    }
+
     if (_connection_status_cb && _previous_connection_status != _connect_status) {
 
         _connection_status_cb(NSAPI_EVENT_CONNECTION_STATUS_CHANGE, _connect_status);
@@ -196,6 +228,15 @@ nsapi_connection_status_t InterfaceNanostack::get_connection_status() const
     }
 }
 
+nsapi_error_t InterfaceNanostack::get_connection_timeline(nsapi_connection_timeline_t *timeline)
+{
+    if (!_interface) {
+        return NSAPI_ERROR_NO_CONNECTION;
+    }
+
+    return _interface->get_connection_timeline(timeline);
+}
+
 void InterfaceNanostack::attach(
     mbed::Callback<void(nsapi_event_t, intptr_t)> status_cb)
 {
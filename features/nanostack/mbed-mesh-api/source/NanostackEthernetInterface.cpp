@@ -56,6 +56,7 @@ nsapi_error_t Nanostack::EthernetInterface::bringup(bool dhcp, const char *ip,
 
     nanostack_lock();
     _blocking = blocking;
+    start_timeline();
     if (interface_id < 0) {
         enet_tasklet_init();
         __mesh_handler_set_callback(this);
@@ -17,6 +17,7 @@
 #include "ThreadInterface.h"
 #include "include/thread_tasklet.h"
 #include "callback_handler.h"
+#include "NanostackLockGuard.h"
 #include "mesh_system.h"
 #include "randLIB.h"
 
@@ -123,6 +124,7 @@ nsapi_error_t Nanostack::ThreadInterface::bringup(bool dhcp, const char *ip,
     nanostack_lock();
 
     _blocking = blocking;
+    start_timeline();
 
     // After the RF is up, we can seed the random from it.
     randLIB_seed_random();
@@ -267,6 +269,18 @@ mesh_error_t Nanostack::ThreadInterface::device_pskd_set(const char *pskd)
     return (mesh_error_t)thread_tasklet_device_pskd_set(pskd);
 }
 
+mesh_error_t ThreadInterface::get_join_stats(mesh_join_stats_t *stats)
+{
+    if (!_interface) {
+        return MESH_ERROR_STATE;
+    }
+    NanostackLockGuard lock;
+    if (thread_tasklet_get_join_stats(stats) < 0) {
+        return MESH_ERROR_STATE;
+    }
+    return MESH_ERROR_NONE;
+}
+
 #define THREAD 0x2345
 #if MBED_CONF_NSAPI_DEFAULT_MESH_TYPE == THREAD && DEVICE_802_15_4_PHY
 
@@ -71,6 +71,7 @@ nsapi_error_t Nanostack::WisunInterface::bringup(bool dhcp, const char *ip,
     }
 
     _blocking = blocking;
+    start_timeline();
 
     // After the RF is up, we can seed the random from it.
     randLIB_seed_random();
@@ -174,6 +175,18 @@ bool WisunInterface::getRouterIpAddress(char *address, int8_t len)
     return _interface->get_gateway(address, len);
 }
 
+mesh_error_t WisunInterface::get_join_stats(mesh_join_stats_t *stats)
+{
+    if (!_interface) {
+        return MESH_ERROR_STATE;
+    }
+    NanostackLockGuard lock;
+    if (wisun_tasklet_get_join_stats(stats) < 0) {
+        return MESH_ERROR_STATE;
+    }
+    return MESH_ERROR_NONE;
+}
+
 #define WISUN 0x2345
 #if MBED_CONF_NSAPI_DEFAULT_MESH_TYPE == WISUN && DEVICE_802_15_4_PHY
 MBED_WEAK MeshInterface *MeshInterface::get_target_default_instance()
@@ -17,6 +17,7 @@
 #ifndef __INCLUDE_MESH_SYSTEM__
 #define __INCLUDE_MESH_SYSTEM__
 #include "ns_types.h"
+#include "mbed-mesh-api/mesh_interface_types.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -44,6 +45,32 @@ void mesh_system_send_connect_event(uint8_t receiver);
  */
 void mesh_system_init(void);
 
+/*
+ * Join statistics of a tasklet, with the state needed to time the attempts.
+ */
+typedef struct {
+    mesh_join_stats_t stats;
+    uint32_t connect_ticks;     // event timer ticks at connect
+    uint32_t attempt_ticks;     // event timer ticks at the start of the attempt
+    bool attempt_running;
+} mesh_system_join_t;
+
+/*
+ * \brief Reset the join statistics, called when connecting.
+ */
+void mesh_system_join_start(mesh_system_join_t *join);
+
+/*
+ * \brief Record the start of a bootstrap attempt.
+ */
+void mesh_system_join_attempt(mesh_system_join_t *join);
+
+/*
+ * \brief Record a network event of the interface.
+ * \param status arm_nwk_interface_status_type_e of the event
+ */
+void mesh_system_join_event(mesh_system_join_t *join, int status);
+
 #ifdef __cplusplus
 }
 #endif
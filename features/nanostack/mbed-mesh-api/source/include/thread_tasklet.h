@@ -83,6 +83,13 @@ uint8_t thread_tasklet_device_pskd_set(const char *pskd);
  */
 int8_t thread_tasklet_disconnect(bool send_cb);
 
+/*
+ * \brief Get the network joining statistics of the last connect.
+ * \param stats buffer for the statistics
+ * \return 0 on success, -1 if the tasklet is not initialized
+ */
+int8_t thread_tasklet_get_join_stats(mesh_join_stats_t *stats);
+
 /*
  * \brief Set device data polling rate
  *
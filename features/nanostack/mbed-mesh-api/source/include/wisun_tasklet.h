@@ -76,6 +76,13 @@ int8_t wisun_tasklet_network_init(int8_t device_id);
  */
 int8_t wisun_tasklet_disconnect(bool send_cb);
 
+/*
+ * \brief Get the network joining statistics of the last connect.
+ * \param stats buffer for the statistics
+ * \return 0 on success, -1 if the tasklet is not initialized
+ */
+int8_t wisun_tasklet_get_join_stats(mesh_join_stats_t *stats);
+
 #ifdef __cplusplus
 }
 #endif
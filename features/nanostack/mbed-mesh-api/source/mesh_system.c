@@ -15,8 +15,10 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include "eventOS_scheduler.h"
 #include "eventOS_event.h"
+#include "eventOS_event_timer.h"
 #include "net_interface.h"
 #include "nsdynmemLIB.h"
 #include "randLIB.h"
@@ -77,3 +79,61 @@ void mesh_system_send_connect_event(uint8_t receiver)
     };
     eventOS_event_send(&event);
 }
+
+static uint32_t mesh_system_join_elapsed_ms(uint32_t since)
+{
+    return eventOS_event_timer_ticks_to_ms(eventOS_event_timer_ticks() - since);
+}
+
+void mesh_system_join_start(mesh_system_join_t *join)
+{
+    memset(join, 0, sizeof(mesh_system_join_t));
+    join->connect_ticks = eventOS_event_timer_ticks();
+}
+
+void mesh_system_join_attempt(mesh_system_join_t *join)
+{
+    join->stats.join_attempts++;
+    join->attempt_ticks = eventOS_event_timer_ticks();
+    join->attempt_running = true;
+}
+
+void mesh_system_join_event(mesh_system_join_t *join, int status)
+{
+    switch (status) {
+        case ARM_NWK_BOOTSTRAP_READY:
+            if (join->attempt_running) {
+                join->stats.last_attempt_time_ms = mesh_system_join_elapsed_ms(join->attempt_ticks);
+                join->attempt_running = false;
+            }
+            if (join->stats.time_to_join_ms == 0) {
+                uint32_t time_to_join = mesh_system_join_elapsed_ms(join->connect_ticks);
+                join->stats.time_to_join_ms = time_to_join ? time_to_join : 1;
+            }
+            return;
+        case ARM_NWK_NWK_SCAN_FAIL:
+            join->stats.scan_failures++;
+            break;
+        case ARM_NWK_IP_ADDRESS_ALLOCATION_FAIL:
+            join->stats.address_failures++;
+            break;
+        case ARM_NWK_AUHTENTICATION_FAIL:
+            join->stats.auth_failures++;
+            break;
+        case ARM_NWK_NWK_CONNECTION_DOWN:
+        case ARM_NWK_NWK_PARENT_POLL_FAIL:
+            if (!join->attempt_running) {
+                join->stats.connection_losses++;
+            }
+            break;
+        default:
+            return;
+    }
+
+    if (join->attempt_running) {
+        uint32_t attempt_time = mesh_system_join_elapsed_ms(join->attempt_ticks);
+        join->stats.last_attempt_time_ms = attempt_time;
+        join->stats.time_in_failed_attempts_ms += attempt_time;
+        join->attempt_running = false;
+    }
+}
@@ -79,6 +79,7 @@ typedef struct {
     uint8_t networkid[16];
     uint8_t extented_panid[8];
     uint8_t ip[16];
+    mesh_system_join_t join;
 } thread_tasklet_data_str_t;
 
 
@@ -138,6 +139,7 @@ void thread_tasklet_main(arm_event_s *event)
 
                 if (status >= 0) {
                     thread_tasklet_data_ptr->tasklet_state = TASKLET_STATE_BOOTSTRAP_STARTED;
+                    mesh_system_join_attempt(&thread_tasklet_data_ptr->join);
                     tr_info("Start Thread bootstrap (%s mode)", thread_tasklet_data_ptr->operating_mode == NET_6LOWPAN_SLEEPY_HOST ? "SED" : "Router");
                     thread_tasklet_network_state_changed(MESH_BOOTSTRAP_STARTED);
                 } else {
@@ -174,6 +176,7 @@ void thread_tasklet_parse_network_event(arm_event_s *event)
 {
     arm_nwk_interface_status_type_e status = (arm_nwk_interface_status_type_e) event->event_data;
     tr_debug("app_parse_network_event() %d", status);
+    mesh_system_join_event(&thread_tasklet_data_ptr->join, status);
     switch (status) {
         case ARM_NWK_BOOTSTRAP_READY:
             /* Network is ready and node is connected to Access Point */
@@ -345,6 +348,7 @@ void thread_tasklet_configure_and_connect_to_network(void)
 
     if (status >= 0) {
         thread_tasklet_data_ptr->tasklet_state = TASKLET_STATE_BOOTSTRAP_STARTED;
+        mesh_system_join_attempt(&thread_tasklet_data_ptr->join);
         tr_info("Start Thread bootstrap (%s mode)", thread_tasklet_data_ptr->operating_mode == NET_6LOWPAN_SLEEPY_HOST ? "SED" : "Router");
         thread_tasklet_network_state_changed(MESH_BOOTSTRAP_STARTED);
     } else {
@@ -410,6 +414,7 @@ int8_t thread_tasklet_connect(mesh_interface_cb callback, int8_t nwk_interface_i
     thread_tasklet_data_ptr->mesh_api_cb = callback;
     thread_tasklet_data_ptr->nwk_if_id = nwk_interface_id;
     thread_tasklet_data_ptr->tasklet_state = TASKLET_STATE_INITIALIZED;
+    mesh_system_join_start(&thread_tasklet_data_ptr->join);
     thread_tasklet_data_ptr->poll_network_status_timeout =
         eventOS_timeout_every_ms(thread_tasklet_poll_network_status, 2000, NULL);
 
@@ -450,6 +455,15 @@ int8_t thread_tasklet_disconnect(bool send_cb)
     return status;
 }
 
+int8_t thread_tasklet_get_join_stats(mesh_join_stats_t *stats)
+{
+    if (thread_tasklet_data_ptr == NULL) {
+        return -1;
+    }
+    *stats = thread_tasklet_data_ptr->join.stats;
+    return 0;
+}
+
 void thread_tasklet_init(void)
 {
     if (thread_tasklet_data_ptr == NULL) {
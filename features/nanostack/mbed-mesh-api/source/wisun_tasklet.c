@@ -59,6 +59,7 @@ typedef struct {
     net_6lowpan_mode_e operating_mode;
     net_6lowpan_mode_extension_e operating_mode_extension;
     int8_t network_interface_id;
+    mesh_system_join_t join;
 } wisun_tasklet_data_str_t;
 
 
@@ -136,6 +137,7 @@ static void wisun_tasklet_parse_network_event(arm_event_s *event)
 {
     arm_nwk_interface_status_type_e status = (arm_nwk_interface_status_type_e) event->event_data;
     tr_debug("app_parse_network_event() %d", status);
+    mesh_system_join_event(&wisun_tasklet_data_ptr->join, status);
     switch (status) {
         case ARM_NWK_BOOTSTRAP_READY:
             /* Network is ready and node is connected to Access Point */
@@ -213,6 +215,7 @@ static void wisun_tasklet_configure_and_connect_to_network(void)
     status = arm_nwk_interface_up(wisun_tasklet_data_ptr->network_interface_id);
     if (status >= 0) {
         wisun_tasklet_data_ptr->tasklet_state = TASKLET_STATE_BOOTSTRAP_STARTED;
+        mesh_system_join_attempt(&wisun_tasklet_data_ptr->join);
         tr_info("Start Wi-SUN Bootstrap");
         wisun_tasklet_network_state_changed(MESH_BOOTSTRAP_STARTED);
     } else {
@@ -263,6 +266,7 @@ int8_t wisun_tasklet_connect(mesh_interface_cb callback, int8_t nwk_interface_id
     wisun_tasklet_data_ptr->mesh_api_cb = callback;
     wisun_tasklet_data_ptr->network_interface_id = nwk_interface_id;
     wisun_tasklet_data_ptr->tasklet_state = TASKLET_STATE_INITIALIZED;
+    mesh_system_join_start(&wisun_tasklet_data_ptr->join);
 
     if (re_connecting == false) {
         wisun_tasklet_data_ptr->tasklet = eventOS_event_handler_create(&wisun_tasklet_main,
@@ -296,6 +300,15 @@ int8_t wisun_tasklet_disconnect(bool send_cb)
     return status;
 }
 
+int8_t wisun_tasklet_get_join_stats(mesh_join_stats_t *stats)
+{
+    if (wisun_tasklet_data_ptr == NULL) {
+        return -1;
+    }
+    *stats = wisun_tasklet_data_ptr->join.stats;
+    return 0;
+}
+
 void wisun_tasklet_init(void)
 {
     if (wisun_tasklet_data_ptr == NULL) {
@@ -19,11 +19,41 @@
 
 #include "mbedtls/entropy_poll.h"
 
-void arm_random_module_init(void)
-{
-}
+#if defined(MBEDTLS_ENTROPY_HARDWARE_ALT) && MBED_CONF_NANOSTACK_HAL_RANDOM_POOL_SIZE && MBED_CONF_RTOS_PRESENT
+#define RANDOM_POOL 1
+#include "cmsis_os2.h"
+#include "mbed_rtos_storage.h"
+#include "platform/mbed_critical.h"
 
-uint32_t arm_random_seed_get(void)
+#ifndef MBED_TZ_DEFAULT_ACCESS
+#define MBED_TZ_DEFAULT_ACCESS   0
+#endif
+
+/* Seeds read ahead from the TRNG by a low priority thread, so seeding
+ * randLIB doesn't wait for the TRNG. The pool is refilled once it is
+ * half empty; when it is empty, seeds are read from the TRNG directly.
+ */
+static uint32_t random_pool[MBED_CONF_NANOSTACK_HAL_RANDOM_POOL_SIZE];
+static uint32_t random_pool_count;
+
+static void random_pool_thread(void *arg);
+
+static uint64_t random_thread_stk[MBED_CONF_NANOSTACK_HAL_RANDOM_POOL_THREAD_STACK_SIZE / 8];
+static mbed_rtos_storage_thread_t random_thread_tcb;
+static const osThreadAttr_t random_thread_attr = {
+    .name = "nanostack_random_thread",
+    .priority = osPriorityLow,
+    .stack_mem = &random_thread_stk[0],
+    .stack_size = sizeof random_thread_stk,
+    .cb_mem = &random_thread_tcb,
+    .cb_size = sizeof random_thread_tcb,
+    .tz_module = MBED_TZ_DEFAULT_ACCESS,
+};
+static osThreadId_t random_thread_id;
+static bool random_thread_started;
+#endif
+
+static uint32_t random_trng_get(void)
 {
     uint32_t result = 0;
 #ifdef MBEDTLS_ENTROPY_HARDWARE_ALT
@@ -39,3 +69,65 @@ uint32_t arm_random_seed_get(void)
 #endif
     return result;
 }
+
+#ifdef RANDOM_POOL
+static void random_pool_thread(void *arg)
+{
+    (void)arg;
+    while (true) {
+        bool full;
+        do {
+            uint32_t seed = random_trng_get();
+            core_util_critical_section_enter();
+            full = random_pool_count == MBED_CONF_NANOSTACK_HAL_RANDOM_POOL_SIZE;
+            if (!full) {
+                random_pool[random_pool_count++] = seed;
+                full = random_pool_count == MBED_CONF_NANOSTACK_HAL_RANDOM_POOL_SIZE;
+            }
+            core_util_critical_section_exit();
+        } while (!full);
+
+        osThreadFlagsWait(1, osFlagsWaitAny, osWaitForever);
+    }
+}
+#endif
+
+void arm_random_module_init(void)
+{
+#ifdef RANDOM_POOL
+    core_util_critical_section_enter();
+    bool start = !random_thread_started;
+    random_thread_started = true;
+    core_util_critical_section_exit();
+
+    if (start) {
+        random_thread_id = osThreadNew(random_pool_thread, NULL, &random_thread_attr);
+    }
+#endif
+}
+
+uint32_t arm_random_seed_get(void)
+{
+#ifdef RANDOM_POOL
+    uint32_t result;
+    bool pooled = false;
+    bool refill = false;
+
+    core_util_critical_section_enter();
+    if (random_pool_count) {
+        result = random_pool[--random_pool_count];
+        random_pool[random_pool_count] = 0;
+        pooled = true;
+    }
+    refill = random_pool_count <= MBED_CONF_NANOSTACK_HAL_RANDOM_POOL_SIZE / 2;
+    core_util_critical_section_exit();
+
+    if (refill && random_thread_id) {
+        osThreadFlagsSet(random_thread_id, 1);
+    }
+    if (pooled) {
+        return result;
+    }
+#endif
+    return random_trng_get();
+}
@@ -37,6 +37,7 @@
 #define TRACE_GROUP "nsif"
 
 #define NS_INTERFACE_SOCKETS_MAX  16  //same as NanoStack SOCKET_MAX
+#define NS_INTERFACE_IOV_MAX      8   //buffers of sendmsg and recvmsg passed down as they are
 
 #define MALLOC  ns_dyn_mem_alloc
 #define FREE    ns_dyn_mem_free
@@ -588,7 +589,7 @@ nsapi_error_t Nanostack::socket_close(void *handle)
 
 }
 
-nsapi_size_or_error_t Nanostack::do_sendto(void *handle, const ns_address_t *address, const void *data, nsapi_size_t size)
+nsapi_size_or_error_t Nanostack::do_sendmsg(void *handle, const ns_address_t *address, ns_iovec_t *iov, unsigned iovcnt)
 {
     // Validate parameters
     NanostackSocket *socket = static_cast<NanostackSocket *>(handle);
@@ -623,13 +624,10 @@ nsapi_size_or_error_t Nanostack::do_sendto(void *handle, const ns_address_t *add
     // it's the only call which takes flags so we can
     // leave the NS_MSG_LEGACY0 flag clear).
     ns_msghdr_t msg;
-    ns_iovec_t iov;
-    iov.iov_base = const_cast<void *>(data);
-    iov.iov_len = size;
     msg.msg_name = const_cast<ns_address_t *>(address);
     msg.msg_namelen = address ? sizeof * address : 0;
-    msg.msg_iov = &iov;
-    msg.msg_iovlen = 1;
+    msg.msg_iov = iov;
+    msg.msg_iovlen = iovcnt;
     msg.msg_control = NULL;
     msg.msg_controllen = 0;
     retcode = ::socket_sendmsg(socket->socket_id, &msg, 0);
@@ -669,8 +667,41 @@ nsapi_size_or_error_t Nanostack::socket_sendto(void *handle, const SocketAddress
 
     ns_address_t ns_address;
     convert_mbed_addr_to_ns(&ns_address, &address);
-    /*No lock gaurd needed here as do_sendto() will handle locks.*/
-    return do_sendto(handle, &ns_address, data, size);
+    ns_iovec_t iov;
+    iov.iov_base = const_cast<void *>(data);
+    iov.iov_len = size;
+    /*No lock gaurd needed here as do_sendmsg() will handle locks.*/
+    return do_sendmsg(handle, &ns_address, &iov, 1);
+}
+
+nsapi_size_or_error_t Nanostack::socket_sendmsg(void *handle, const SocketAddress *address, const nsapi_iovec_t *iov, unsigned iovcnt)
+{
+    if (iovcnt > NS_INTERFACE_IOV_MAX) {
+        // Gather the buffers instead
+        return NetworkStack::socket_sendmsg(handle, address, iov, iovcnt);
+    }
+
+    ns_iovec_t ns_iov[NS_INTERFACE_IOV_MAX];
+    for (unsigned i = 0; i < iovcnt; i++) {
+        if (iov[i].iov_len > 0xFFFF) {
+            return NSAPI_ERROR_PARAMETER;
+        }
+        ns_iov[i].iov_base = iov[i].iov_base;
+        ns_iov[i].iov_len = iov[i].iov_len;
+    }
+
+    if (!address) {
+        return do_sendmsg(handle, NULL, ns_iov, iovcnt);
+    }
+
+    if (address->get_ip_version() != NSAPI_IPv6) {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+
+    ns_address_t ns_address;
+    convert_mbed_addr_to_ns(&ns_address, address);
+    /*No lock gaurd needed here as do_sendmsg() will handle locks.*/
+    return do_sendmsg(handle, &ns_address, ns_iov, iovcnt);
 }
 
 nsapi_size_or_error_t Nanostack::socket_recvfrom(void *handle, SocketAddress *address, void *buffer, nsapi_size_t size)
@@ -718,6 +749,65 @@ out:
     return ret;
 }
 
+nsapi_size_or_error_t Nanostack::socket_recvmsg(void *handle, SocketAddress *address, nsapi_iovec_t *iov, unsigned iovcnt)
+{
+    if (iovcnt > NS_INTERFACE_IOV_MAX) {
+        // Scatter from a temporary buffer instead
+        return NetworkStack::socket_recvmsg(handle, address, iov, iovcnt);
+    }
+
+    // Validate parameters
+    NanostackSocket *socket = static_cast<NanostackSocket *>(handle);
+    if (handle == NULL) {
+        MBED_ASSERT(false);
+        return NSAPI_ERROR_NO_SOCKET;
+    }
+
+    ns_iovec_t ns_iov[NS_INTERFACE_IOV_MAX];
+    for (unsigned i = 0; i < iovcnt; i++) {
+        ns_iov[i].iov_base = iov[i].iov_base;
+        ns_iov[i].iov_len = iov[i].iov_len > 0xFFFF ? 0xFFFF : iov[i].iov_len;
+    }
+
+    nsapi_size_or_error_t ret;
+
+    NanostackLockGuard lock;
+
+    if (socket->closed()) {
+        ret = NSAPI_ERROR_NO_CONNECTION;
+        goto out;
+    }
+
+    ns_address_t ns_address;
+    ns_msghdr_t msg;
+    msg.msg_name = &ns_address;
+    msg.msg_namelen = sizeof ns_address;
+    msg.msg_iov = ns_iov;
+    msg.msg_iovlen = iovcnt;
+    msg.msg_control = NULL;
+    msg.msg_controllen = 0;
+    msg.msg_flags = 0;
+
+    int retcode;
+    retcode = ::socket_recvmsg(socket->socket_id, &msg, 0);
+
+    if (retcode == NS_EWOULDBLOCK) {
+        ret = NSAPI_ERROR_WOULD_BLOCK;
+    } else if (retcode < 0) {
+        ret = NSAPI_ERROR_PARAMETER;
+    } else {
+        ret = retcode;
+        if (address != NULL) {
+            convert_ns_addr_to_mbed(address, &ns_address);
+        }
+    }
+
+out:
+    tr_debug("socket_recvmsg(socket=%p) sock_id=%d, ret=%i", socket, socket->socket_id, ret);
+
+    return ret;
+}
+
 nsapi_error_t Nanostack::socket_bind(void *handle, const SocketAddress &address)
 {
     // Validate parameters
@@ -965,7 +1055,10 @@ out:
 
 nsapi_size_or_error_t Nanostack::socket_send(void *handle, const void *data, nsapi_size_t size)
 {
-    return do_sendto(handle, NULL, data, size);
+    ns_iovec_t iov;
+    iov.iov_base = const_cast<void *>(data);
+    iov.iov_len = size;
+    return do_sendmsg(handle, NULL, &iov, 1);
 }
 
 nsapi_size_or_error_t Nanostack::socket_recv(void *handle, void *data, nsapi_size_t size)
@@ -25,6 +25,7 @@
 #include "eventOS_event.h"
 
 struct ns_address;
+struct ns_iovec;
 
 class Nanostack : public OnboardNetworkStack, private mbed::NonCopyable<Nanostack> {
 public:
@@ -199,6 +200,40 @@ protected:
      */
     virtual nsapi_size_or_error_t socket_recvfrom(void *handle, SocketAddress *address, void *buffer, nsapi_size_t size);
 
+    /** Send a message gathered from several buffers over a socket
+     *
+     *  The buffers are passed down to the socket as they are, up to 8 of
+     *  them, more are gathered into a temporary buffer.
+     *
+     *  This call is non-blocking. If sendmsg would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param address  The SocketAddress of the remote host, or NULL for
+     *                  connected sockets
+     *  @param iov      Array of the buffers of data to send to the host
+     *  @param iovcnt   Number of buffers in the array
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_sendmsg(void *handle, const SocketAddress *address,
+                                                 const nsapi_iovec_t *iov, unsigned iovcnt);
+
+    /** Receive data scattered into several buffers over a socket
+     *
+     *  This call is non-blocking. If recvmsg would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param address  Destination for the source address or NULL
+     *  @param iov      Array of the destination buffers
+     *  @param iovcnt   Number of buffers in the array
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_recvmsg(void *handle, SocketAddress *address,
+                                                 nsapi_iovec_t *iov, unsigned iovcnt);
+
     /** Register a callback on state change of the socket
      *
      *  The specified callback will be called on state changes such as when
@@ -281,7 +316,7 @@ private:
         mbed::Callback<void()> callback;
     };
 
-    nsapi_size_or_error_t do_sendto(void *handle, const struct ns_address *address, const void *data, nsapi_size_t size);
+    nsapi_size_or_error_t do_sendmsg(void *handle, const struct ns_address *address, struct ns_iovec *iov, unsigned iovcnt);
     static void call_event_tasklet_main(arm_event_s *event);
     char text_ip_address[40];
     NanostackMemoryManager memory_manager;
@@ -320,6 +320,26 @@ static void ns_timer_interrupt_handler(void)
     platform_exit_critical();
 }
 
+uint16_t ns_timer_get_remaining_slots(int8_t ns_timer_id)
+{
+    uint16_t remaining_slots = 0;
+    ns_timer_struct *current_timer;
+
+    platform_enter_critical();
+    current_timer = ns_timer_get_pointer_to_timer_struct(ns_timer_id);
+    if (current_timer && (ns_timer_state & NS_TIMER_RUNNING)) {
+        /*Hold-labelled timers count from the end of the active timeout*/
+        if (current_timer->timer_state == NS_TIMER_ACTIVE) {
+            remaining_slots = platform_timer_get_remaining_slots();
+        } else if (current_timer->timer_state == NS_TIMER_HOLD) {
+            remaining_slots = current_timer->remaining_slots + platform_timer_get_remaining_slots();
+        }
+    }
+    platform_exit_critical();
+
+    return remaining_slots;
+}
+
 int8_t eventOS_callback_timer_stop(int8_t ns_timer_id)
 {
     uint16_t pl_timer_remaining_slots;
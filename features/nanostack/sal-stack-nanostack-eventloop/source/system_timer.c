@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <string.h>
 #include "ns_types.h"
 #include "ns_list.h"
 #include "timer_sys.h"
@@ -41,28 +42,67 @@ NS_STATIC_ASSERT(1000 % EVENTOS_EVENT_TIMER_HZ == 0, "Need whole number of ms pe
 static volatile uint32_t timer_sys_ticks;
 
 static NS_LIST_DEFINE(system_timer_free, sys_timer_struct_s, event.link);
-static NS_LIST_DEFINE(system_timer_list, sys_timer_struct_s, event.link);
+
+// Pending timers, in a binary min-heap ordered by launch time. It has room
+// for every timer allocated, so adding to it can't fail.
+static sys_timer_struct_s *startup_timer_heap[ST_MAX];
+static sys_timer_struct_s **timer_heap = startup_timer_heap;
+static uint16_t timer_heap_count;
+static uint16_t timer_heap_size = ST_MAX;
+static uint16_t timer_sys_seq;
 
 
 static sys_timer_struct_s *sys_timer_dynamically_allocate(void);
 static void timer_sys_interrupt(void);
 static void timer_sys_add(sys_timer_struct_s *timer);
+static void timer_sys_schedule(void);
 
 #ifndef NS_EVENTLOOP_USE_TICK_TIMER
-static int8_t platform_tick_timer_start(uint32_t period_ms);
-/* Implement platform tick timer using eventOS timer */
+/* Tickless system timer using an eventOS timer. It is started for the
+ * ticks until the first pending timer, or TIMER_SYS_MAX_TICKS when there
+ * are none, instead of waking up on every tick. timer_sys_ticks counts the
+ * ticks up to the start of the running timeout, and the slots elapsed since
+ * come from the eventOS timer.
+ */
+#define TIMER_SLOTS_PER_TICK        (TIMER_SLOTS_PER_MS * TIMER_SYS_TICK_PERIOD)
+#define TIMER_SYS_MAX_TICKS         (UINT16_MAX / TIMER_SLOTS_PER_TICK - 1)
+
 // platform tick timer callback function
 static void (*tick_timer_callback)(void);
 static int8_t tick_timer_id = -1;   // eventOS timer id for tick timer
+static uint16_t tick_timer_slots;   // slots left in the running timeout, when last synchronised
+static uint16_t tick_timer_phase;   // slots elapsed since timer_sys_ticks was incremented
+
+/* Called internally with lock held, adds the ticks elapsed in the running timeout */
+static void timer_sys_sync(uint16_t remaining_slots)
+{
+    if (!tick_timer_slots) {
+        return;
+    }
+    if (remaining_slots > tick_timer_slots) {
+        remaining_slots = tick_timer_slots;
+    }
+
+    uint32_t slots = tick_timer_phase + (tick_timer_slots - remaining_slots);
+    timer_sys_ticks += slots / TIMER_SLOTS_PER_TICK;
+    tick_timer_phase = slots % TIMER_SLOTS_PER_TICK;
+    tick_timer_slots = remaining_slots;
+}
+
+static void timer_sys_sync_now(void)
+{
+    if (tick_timer_slots) {
+        timer_sys_sync(ns_timer_get_remaining_slots(tick_timer_id));
+    }
+}
 
 // EventOS timer callback function
 static void tick_timer_eventOS_callback(int8_t timer_id, uint16_t slots)
 {
-    // Not interested in timer id or slots
+    // Not interested in slots
     (void)slots;
-    // Call the tick timer callback
     if (tick_timer_callback != NULL && timer_id == tick_timer_id) {
-        platform_tick_timer_start(TIMER_SYS_TICK_PERIOD);
+        timer_sys_sync(0);
         tick_timer_callback();
     }
 }
@@ -74,14 +114,44 @@ static int8_t platform_tick_timer_register(void (*tick_timer_cb)(void))
     return tick_timer_id;
 }
 
-static int8_t platform_tick_timer_start(uint32_t period_ms)
+static int8_t platform_tick_timer_stop(void)
 {
-    return eventOS_callback_timer_start(tick_timer_id, TIMER_SLOTS_PER_MS * period_ms);
+    timer_sys_sync_now();
+    tick_timer_slots = 0;
+    return eventOS_callback_timer_stop(tick_timer_id);
 }
 
-static int8_t platform_tick_timer_stop(void)
+/* Called internally with lock held, starts the timeout to the first pending
+ * timer if it is earlier than the running one */
+static void timer_sys_schedule(void)
+{
+    uint32_t ticks = TIMER_SYS_MAX_TICKS;
+
+    timer_sys_sync_now();
+    if (timer_heap_count) {
+        uint32_t at = timer_heap[0]->launch_time;
+        ticks = TICKS_AFTER(at, timer_sys_ticks) ? at - timer_sys_ticks : 1;
+        if (ticks > TIMER_SYS_MAX_TICKS) {
+            ticks = TIMER_SYS_MAX_TICKS;
+        }
+    }
+
+    uint16_t slots = ticks * TIMER_SLOTS_PER_TICK - tick_timer_phase;
+    if (tick_timer_slots && tick_timer_slots <= slots) {
+        return;
+    }
+    if (tick_timer_slots) {
+        eventOS_callback_timer_stop(tick_timer_id);
+    }
+    tick_timer_slots = slots;
+    eventOS_callback_timer_start(tick_timer_id, slots);
+}
+#else
+/* Periodic platform tick timer, timer_sys_ticks is always up to date */
+#define timer_sys_sync_now() ((void) 0)
+
+static void timer_sys_schedule(void)
 {
-    return eventOS_callback_timer_stop(tick_timer_id);
 }
 #endif // !NS_EVENTLOOP_USE_TICK_TIMER
 
@@ -95,7 +165,7 @@ void timer_sys_init(void)
     }
 
     platform_tick_timer_register(timer_sys_interrupt);
-    platform_tick_timer_start(TIMER_SYS_TICK_PERIOD);
+    timer_sys_wakeup();
 }
 
 
@@ -103,30 +173,127 @@ void timer_sys_init(void)
 /*-------------------SYSTEM TIMER FUNCTIONS--------------------------*/
 void timer_sys_disable(void)
 {
+    platform_enter_critical();
     platform_tick_timer_stop();
+    platform_exit_critical();
 }
 
 /*
- * Starts ticking system timer interrupts every 10ms
+ * Starts the system timer again after timer_sys_disable
  */
 int8_t timer_sys_wakeup(void)
 {
+#ifdef NS_EVENTLOOP_USE_TICK_TIMER
     return platform_tick_timer_start(TIMER_SYS_TICK_PERIOD);
+#else
+    platform_enter_critical();
+    timer_sys_schedule();
+    platform_exit_critical();
+    return 0;
+#endif
 }
 
 
 static void timer_sys_interrupt(void)
 {
+#ifdef NS_EVENTLOOP_USE_TICK_TIMER
     system_timer_tick_update(1);
+#else
+    system_timer_tick_update(0);
+#endif
 }
 
 
 
 /* * * * * * * * * */
 
+/* Called internally with lock held */
+static bool timer_sys_before(const sys_timer_struct_s *a, const sys_timer_struct_s *b)
+{
+    if (a->launch_time != b->launch_time) {
+        return TICKS_BEFORE(a->launch_time, b->launch_time);
+    }
+    return (int16_t)(a->seq - b->seq) < 0;
+}
+
+static void timer_heap_set(uint16_t i, sys_timer_struct_s *timer)
+{
+    timer_heap[i] = timer;
+    timer->heap_index = i;
+}
+
+static void timer_heap_up(uint16_t i)
+{
+    sys_timer_struct_s *timer = timer_heap[i];
+    while (i > 0) {
+        uint16_t parent = (i - 1) / 2;
+        if (!timer_sys_before(timer, timer_heap[parent])) {
+            break;
+        }
+        timer_heap_set(i, timer_heap[parent]);
+        i = parent;
+    }
+    timer_heap_set(i, timer);
+}
+
+static void timer_heap_down(uint16_t i)
+{
+    sys_timer_struct_s *timer = timer_heap[i];
+    for (;;) {
+        uint16_t child = 2 * i + 1;
+        if (child >= timer_heap_count) {
+            break;
+        }
+        if (child + 1 < timer_heap_count && timer_sys_before(timer_heap[child + 1], timer_heap[child])) {
+            child++;
+        }
+        if (!timer_sys_before(timer_heap[child], timer)) {
+            break;
+        }
+        timer_heap_set(i, timer_heap[child]);
+        i = child;
+    }
+    timer_heap_set(i, timer);
+}
+
+/* Called internally with lock held */
+static void timer_sys_remove(sys_timer_struct_s *timer)
+{
+    uint16_t i = timer->heap_index;
+    sys_timer_struct_s *last = timer_heap[--timer_heap_count];
+    if (i < timer_heap_count) {
+        timer_heap_set(i, last);
+        timer_heap_up(i);
+        timer_heap_down(last->heap_index);
+    }
+}
+
+/* Called internally with lock held, makes room in the heap for one more timer */
 static sys_timer_struct_s *sys_timer_dynamically_allocate(void)
 {
-    return ns_dyn_mem_alloc(sizeof(sys_timer_struct_s));
+    static uint16_t timer_sys_allocated = ST_MAX;
+
+    if (timer_sys_allocated == timer_heap_size) {
+        if (timer_heap_size > UINT16_MAX / 2) {
+            return NULL;
+        }
+        sys_timer_struct_s **heap = ns_dyn_mem_alloc(2 * timer_heap_size * sizeof(sys_timer_struct_s *));
+        if (!heap) {
+            return NULL;
+        }
+        memcpy(heap, timer_heap, timer_heap_count * sizeof(sys_timer_struct_s *));
+        if (timer_heap != startup_timer_heap) {
+            ns_dyn_mem_free(timer_heap);
+        }
+        timer_heap = heap;
+        timer_heap_size *= 2;
+    }
+
+    sys_timer_struct_s *timer = ns_dyn_mem_alloc(sizeof(sys_timer_struct_s));
+    if (timer) {
+        timer_sys_allocated++;
+    }
+    return timer;
 }
 
 static sys_timer_struct_s *timer_struct_get(void)
@@ -152,6 +319,7 @@ void timer_sys_event_free(arm_event_storage_t *event)
         ns_list_add_to_start(&system_timer_free, timer);
     } else {
         // Periodic - check due time of next launch
+        timer_sys_sync_now();
         timer->launch_time += timer->period;
         if (TICKS_BEFORE_OR_AT(timer->launch_time, timer_sys_ticks)) {
             // next event is overdue - queue event now
@@ -168,9 +336,11 @@ void timer_sys_event_cancel_critical(struct arm_event_storage *event)
 {
     sys_timer_struct_s *timer = NS_CONTAINER_OF(event, sys_timer_struct_s, event);
     timer->period = 0;
-    // If its unqueued it is on my timer list, otherwise it is in event-loop.
+    // If its unqueued it is on my timer heap, otherwise it is in event-loop.
+    // The system timer keeps running to the removed timer, and is scheduled
+    // again when it wakes up.
     if (event->state == ARM_LIB_EVENT_UNQUEUED) {
-        ns_list_remove(&system_timer_list, timer);
+        timer_sys_remove(timer);
     }
 }
 
@@ -180,6 +350,7 @@ uint32_t eventOS_event_timer_ticks(void)
     // Enter/exit critical is a bit clunky, but necessary on 16-bit platforms,
     // which won't be able to do an atomic 32-bit read.
     platform_enter_critical();
+    timer_sys_sync_now();
     ret_val = timer_sys_ticks;
     platform_exit_critical();
     return ret_val;
@@ -188,19 +359,14 @@ uint32_t eventOS_event_timer_ticks(void)
 /* Called internally with lock held */
 static void timer_sys_add(sys_timer_struct_s *timer)
 {
-    uint32_t at = timer->launch_time;
-
-    // Find first timer scheduled to run after us, and insert before it.
-    // (This means timers scheduled for same time run in order of request)
-    ns_list_foreach(sys_timer_struct_s, t, &system_timer_list) {
-        if (TICKS_BEFORE(at, t->launch_time)) {
-            ns_list_add_before(&system_timer_list, t, timer);
-            return;
-        }
-    }
+    // Timers scheduled for same time run in order of request
+    timer->seq = timer_sys_seq++;
+    timer_heap_set(timer_heap_count++, timer);
+    timer_heap_up(timer->heap_index);
 
-    // Didn't insert before another timer, so must be last.
-    ns_list_add_to_end(&system_timer_list, timer);
+    if (timer_heap[0] == timer) {
+        timer_sys_schedule();
+    }
 }
 
 /* Called internally with lock held */
@@ -224,6 +390,7 @@ static arm_event_storage_t *eventOS_event_timer_request_at_(const arm_event_t *e
     timer->launch_time = at;
     timer->period = period;
 
+    timer_sys_sync_now();
     if (TICKS_BEFORE_OR_AT(at, timer_sys_ticks)) {
         eventOS_event_send_timer_allocated(&timer->event);
     } else {
@@ -248,6 +415,7 @@ arm_event_storage_t *eventOS_event_timer_request_in(const arm_event_t *event, in
 {
     platform_enter_critical();
 
+    timer_sys_sync_now();
     arm_event_storage_t *ret = eventOS_event_timer_request_at_(event, timer_sys_ticks + in, 0);
 
     platform_exit_critical();
@@ -264,6 +432,7 @@ arm_event_storage_t *eventOS_event_timer_request_every(const arm_event_t *event,
 
     platform_enter_critical();
 
+    timer_sys_sync_now();
     arm_event_storage_t *ret = eventOS_event_timer_request_at_(event, timer_sys_ticks + period, period);
 
     platform_exit_critical();
@@ -297,6 +466,7 @@ int8_t eventOS_event_timer_request(uint8_t event_id, uint8_t event_type, int8_t
     }
 
     platform_enter_critical();
+    timer_sys_sync_now();
     arm_event_storage_t *ret = eventOS_event_timer_request_at_(&event, timer_sys_ticks + time, 0);
     platform_exit_critical();
     return ret ? 0 : -1;
@@ -307,7 +477,8 @@ int8_t eventOS_event_timer_cancel(uint8_t event_id, int8_t tasklet_id)
     platform_enter_critical();
 
     /* First check pending timers */
-    ns_list_foreach(sys_timer_struct_s, cur, &system_timer_list) {
+    for (uint16_t i = 0; i < timer_heap_count; i++) {
+        sys_timer_struct_s *cur = timer_heap[i];
         if (cur->event.data.receiver == tasklet_id && cur->event.data.event_id == event_id) {
             eventOS_cancel(&cur->event);
             goto done;
@@ -335,7 +506,8 @@ uint32_t eventOS_event_timer_shortest_active_timer(void)
     uint32_t ret_val = 0;
 
     platform_enter_critical();
-    sys_timer_struct_s *first = ns_list_get_first(&system_timer_list);
+    timer_sys_sync_now();
+    sys_timer_struct_s *first = timer_heap_count ? timer_heap[0] : NULL;
     if (first == NULL) {
         // Weird API has 0 for "no events"
         ret_val = 0;
@@ -355,19 +527,15 @@ void system_timer_tick_update(uint32_t ticks)
     platform_enter_critical();
     //Keep runtime time
     timer_sys_ticks += ticks;
-    ns_list_foreach_safe(sys_timer_struct_s, cur, &system_timer_list) {
-        if (TICKS_BEFORE_OR_AT(cur->launch_time, timer_sys_ticks)) {
-            // Unthread from our list
-            ns_list_remove(&system_timer_list, cur);
-            // Make it an event (can't fail - no allocation)
-            // event system will call our timer_sys_event_free on event delivery.
-            eventOS_event_send_timer_allocated(&cur->event);
-        } else {
-            // List is ordered, so as soon as we see a later event, we're done.
-            break;
-        }
+    while (timer_heap_count && TICKS_BEFORE_OR_AT(timer_heap[0]->launch_time, timer_sys_ticks)) {
+        sys_timer_struct_s *cur = timer_heap[0];
+        // Unthread from our heap
+        timer_sys_remove(cur);
+        // Make it an event (can't fail - no allocation)
+        // event system will call our timer_sys_event_free on event delivery.
+        eventOS_event_send_timer_allocated(&cur->event);
     }
+    timer_sys_schedule();
 
     platform_exit_critical();
 }
-
@@ -27,6 +27,8 @@ typedef struct sys_timer_struct_s {
     arm_event_storage_t event;
     uint32_t launch_time; // tick value
     uint32_t period;
+    uint16_t heap_index; // position in timer heap while pending
+    uint16_t seq; // request order, for timers with the same launch time
 } sys_timer_struct_s;
 
 
@@ -182,6 +182,107 @@ buffer_t *lowpan_down(buffer_t *buf)
     return buf;
 }
 
+#ifndef NO_LOWPAN_FAST_FORWARD
+/* Input: Unicast 6LoWPAN frame received, starting with an IPHC header
+ * Output: If it could be forwarded on the same interface without being
+ *         decompressed and recompressed, the frame with its Hop Limit
+ *         decremented and its MAC addresses set for the next hop, sent to
+ *         the MAC layer. Otherwise the buffer is returned untouched for the
+ *         normal path, which also handles all the errors.
+ */
+static buffer_t *lowpan_fast_forward(protocol_interface_info_entry_t *cur, buffer_t *buf, bool *forwarded)
+{
+    iphc_forward_info_t info;
+
+    *forwarded = false;
+
+    /* Leave all special interface and link-layer handling to the normal path */
+    if (!cur->ip_forwarding || cur->if_special_forwarding || cur->mesh_callbacks || thread_info(cur) ||
+            buf->options.ll_broadcast_rx || buf->options.ll_multicast_rx || buf->options.ll_security_bypass_rx ||
+            buf->options.ll_not_ours_rx || buf->options.lowpan_mesh_rx) {
+        return buf;
+    }
+
+    if (!iphc_forward_parse(&cur->lowpan_contexts, buf, &info)) {
+        return buf;
+    }
+
+    /* Expired Hop Limit needs an ICMP error, and packets for us go up */
+    if (info.hop_limit <= 1 ||
+            addr_is_ipv6_unspecified(info.src) || addr_is_ipv6_multicast(info.src) ||
+            addr_is_ipv6_loopback(info.src) || addr_is_ipv6_loopback(info.dst) ||
+            addr_is_ipv6_link_local(info.dst) ||
+            addr_interface_address_compare(cur, info.dst) == 0) {
+        return buf;
+    }
+
+    sockaddr_t ll_src = buf->src_sa;
+    sockaddr_t ll_dst = buf->dst_sa;
+
+    memcpy(buf->src_sa.address, info.src, 16);
+    buf->src_sa.addr_type = ADDR_IPV6;
+    memcpy(buf->dst_sa.address, info.dst, 16);
+    buf->dst_sa.addr_type = ADDR_IPV6;
+
+    /* Routes whose extension headers the routing code manages (eg RPL) need
+     * the packet decompressed.
+     */
+    buffer_routing_info_t *route = ipv6_buffer_route(buf);
+    if (!route || route->route_info.interface_id != cur->id ||
+            ipv6_has_exthdr_provider(route->route_info.source) ||
+            route->route_info.pmtu < info.ip_size + buffer_data_length(buf) - info.hc_size) {
+        goto normal_path;
+    }
+
+    /* Queueing for address resolution needs the packet decompressed */
+    ipv6_neighbour_t *n = ipv6_neighbour_lookup(&cur->ipv6_neighbour_cache, route->route_info.next_hop_addr);
+    if (!n || n->state == IP_NEIGHBOUR_NEW || n->state == IP_NEIGHBOUR_INCOMPLETE ||
+            (n->ll_type != ADDR_802_15_4_SHORT && n->ll_type != ADDR_802_15_4_LONG)) {
+        goto normal_path;
+    }
+
+    buf->dst_sa.addr_type = n->ll_type;
+    memcpy(buf->dst_sa.address, n->ll_address, addr_len_from_type(n->ll_type));
+    if (!buf->link_specific.ieee802_15_4.useDefaultPanId) {
+        common_write_16_bit(buf->link_specific.ieee802_15_4.dstPanId, buf->dst_sa.address);
+    }
+
+    buf->src_sa.addr_type = ADDR_NONE;
+    if (!mac_helper_write_our_addr(cur, &buf->src_sa)) {
+        goto normal_path;
+    }
+
+    /* Same first fragment limit as lowpan_down(), allowing for a Hop Limit
+     * going in line */
+    uint_fast16_t overhead = mac_helper_frame_overhead(cur, buf);
+    if (info.hc_size + 1 > mac_helper_max_payload_size(cur, overhead) - 4) {
+        goto normal_path;
+    }
+
+    ipv6_neighbour_used(&cur->ipv6_neighbour_cache, n);
+
+    *forwarded = true;
+    buf = iphc_forward_hop_limit_decrement(buf, &info);
+    if (!buf) {
+        return NULL;
+    }
+
+    buf->ip_routed_up = true;
+    buf->options.hop_limit = info.hop_limit - 1;
+    buf->options.type = 0;
+    buf->options.code = 0;
+    buf->info = (buffer_info_t)(B_FROM_IPV6_TXRX | B_TO_MAC | B_DIR_DOWN);
+    return buf;
+
+normal_path:
+    buffer_free_route(buf);
+    buf->interface = cur;
+    buf->src_sa = ll_src;
+    buf->dst_sa = ll_dst;
+    return buf;
+}
+#endif
+
 buffer_t *lowpan_up(buffer_t *buf)
 {
     protocol_interface_info_entry_t *cur = buf->interface;
@@ -231,6 +332,14 @@ buffer_t *lowpan_up(buffer_t *buf)
         goto drop;
     }
 
+#ifndef NO_LOWPAN_FAST_FORWARD
+    bool forwarded;
+    buf = lowpan_fast_forward(cur, buf, &forwarded);
+    if (forwarded) {
+        return buf;
+    }
+#endif
+
     /* Divert to new routing system - in final system, MAC/Mesh/Frag should send to IPV6_TXRX layer */
     buf->ip_routed_up = true;
     buf = iphc_decompress(&cur->lowpan_contexts, buf);
@@ -611,3 +611,124 @@ decomp_error:
     ns_dyn_mem_free(iphc);
     return buffer_free(buf);
 }
+
+/* Usable by the next hop for a frame we forward as is - the next hop may
+ * not have it any more if we no longer compress with it.
+ */
+static bool forward_context_usable(const lowpan_context_list_t *context_list, uint8_t context)
+{
+    lowpan_context_t *ctx = lowpan_contex_get_by_id(context_list, context);
+    return ctx && ctx->compression && !ctx->expiring;
+}
+
+/* Input: A 6LoWPAN frame, starting with an IPHC header
+ * Output: info on its IPv6 header, if the frame can be forwarded without
+ * decompression. That excludes:
+ *   addresses elided from the MAC addresses, which change on every hop,
+ *   multicast and unspecified addresses,
+ *   addresses compressed with contexts we don't compress with,
+ *   extension headers and ICMPv6, left to the IPv6 forwarding code.
+ */
+bool iphc_forward_parse(const lowpan_context_list_t *context_list, buffer_t *buf, iphc_forward_info_t *info)
+{
+    uint16_t ip_size;
+    uint16_t hc_size = iphc_header_scan(buf, &ip_size);
+    if (hc_size == 0) {
+        return false;
+    }
+
+    const uint8_t *iphc = buffer_data_pointer(buf);
+    const uint8_t *ptr = iphc + 2;
+    uint8_t cid = 0;
+
+    if (iphc[1] & HC_CIDE_COMP) {
+        cid = *ptr++;
+    }
+
+    if ((iphc[1] & HC_SRC_ADR_MODE_MASK) == HC_SRC_ADR_FROM_MAC ||
+            (iphc[1] & (HC_SRCADR_COMP | HC_SRC_ADR_MODE_MASK)) == (HC_SRCADR_COMP | HC_SRC_ADR_128_BIT) ||
+            (iphc[1] & HC_MULTICAST_COMP) ||
+            (iphc[1] & HC_DST_ADR_MODE_MASK) == HC_DST_ADR_FROM_MAC) {
+        return false;
+    }
+
+    if (((iphc[1] & HC_SRCADR_COMP) && !forward_context_usable(context_list, cid >> 4)) ||
+            ((iphc[1] & HC_DSTADR_COMP) && !forward_context_usable(context_list, cid & 0xf))) {
+        return false;
+    }
+
+    switch (iphc[0] & HC_TF_MASK) {
+        case HC_TF_ECN_DSCP_FLOW_LABEL:
+            ptr += 4;
+            break;
+        case HC_TF_ECN_FLOW_LABEL:
+            ptr += 3;
+            break;
+        case HC_TF_ECN_DSCP:
+            ptr += 1;
+            break;
+        default:
+            break;
+    }
+
+    uint8_t nh = IPV6_NH_NONE;
+    if (!(iphc[0] & HC_NEXT_HEADER_MASK)) {
+        nh = *ptr++;
+        if (nh != IPV6_NH_UDP && nh != IPV6_NH_TCP) {
+            return false;
+        }
+    }
+
+    info->hop_limit_offset = ptr - iphc;
+    switch (iphc[0] & HC_HOP_LIMIT_MASK) {
+        case HC_HOP_LIMIT_1:
+            info->hop_limit = 1;
+            break;
+        case HC_HOP_LIMIT_64:
+            info->hop_limit = 64;
+            break;
+        case HC_HOP_LIMIT_255:
+            info->hop_limit = 255;
+            break;
+        case HC_HOP_LIMIT_CARRIED_IN_LINE:
+        default:
+            info->hop_limit = *ptr++;
+            break;
+    }
+
+    if (!decompress_addr(context_list, info->src, &ptr, false, NULL, cid, iphc[1]) ||
+            !decompress_addr(context_list, info->dst, &ptr, true, NULL, cid, iphc[1])) {
+        return false;
+    }
+
+    /* UDP checksum compression isn't supported by iphc_decompress either */
+    if (nh == IPV6_NH_NONE && ((ptr[0] & NHC_UDP_MASK) != NHC_UDP || (ptr[0] & NHC_UDP_CKSUM_COMPRESS))) {
+        return false;
+    }
+
+    info->hc_size = hc_size;
+    info->ip_size = ip_size;
+    return true;
+}
+
+/* Input: A 6LoWPAN frame parsed by iphc_forward_parse()
+ * Output: The frame with its Hop Limit decremented. A Hop Limit compressed
+ * as 64 or 255 gets carried in line, so the frame grows by a byte.
+ */
+buffer_t *iphc_forward_hop_limit_decrement(buffer_t *buf, const iphc_forward_info_t *info)
+{
+    uint8_t *iphc = buffer_data_pointer(buf);
+
+    if ((iphc[0] & HC_HOP_LIMIT_MASK) != HC_HOP_LIMIT_CARRIED_IN_LINE) {
+        buf = buffer_headroom(buf, 1);
+        if (!buf) {
+            return NULL;
+        }
+        iphc = buffer_data_reserve_header(buf, 1);
+        memmove(iphc, iphc + 1, info->hop_limit_offset);
+        iphc[0] &= ~HC_HOP_LIMIT_MASK;
+    }
+
+    iphc[info->hop_limit_offset] = info->hop_limit - 1;
+    return buf;
+}
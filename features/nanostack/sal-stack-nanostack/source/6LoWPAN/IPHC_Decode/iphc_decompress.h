@@ -21,4 +21,18 @@ uint16_t iphc_header_scan(buffer_t *buf, uint16_t *uncompressed_size);
 
 buffer_t *iphc_decompress(const lowpan_context_list_t *context_list, buffer_t *buf);
 
+/* IPv6 header of an IPHC frame forwarded without decompression */
+typedef struct iphc_forward_info {
+    uint8_t src[16];            /* Decompressed source address */
+    uint8_t dst[16];            /* Decompressed destination address */
+    uint8_t hop_limit;
+    uint8_t hop_limit_offset;   /* Offset of the Hop Limit field, carried in line or not */
+    uint16_t hc_size;           /* Size of the compressed headers */
+    uint16_t ip_size;           /* Size of the headers once decompressed */
+} iphc_forward_info_t;
+
+bool iphc_forward_parse(const lowpan_context_list_t *context_list, buffer_t *buf, iphc_forward_info_t *info);
+
+buffer_t *iphc_forward_hop_limit_decrement(buffer_t *buf, const iphc_forward_info_t *info);
+
 #endif /* IPHC_DECOMPRESS_H_ */
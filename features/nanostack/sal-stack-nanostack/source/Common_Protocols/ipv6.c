@@ -91,6 +91,11 @@ void ipv6_set_exthdr_provider(ipv6_route_src_t src, ipv6_exthdr_provider_fn_t *f
     ipv6_exthdr_provider[src] = fn;
 }
 
+bool ipv6_has_exthdr_provider(ipv6_route_src_t src)
+{
+    return ipv6_exthdr_provider[src] != NULL;
+}
+
 
 /* If next_if != NULL, this sends to next_hop on that interface */
 buffer_routing_info_t *ipv6_buffer_route_to(buffer_t *buf, const uint8_t *next_hop, protocol_interface_info_entry_t *next_if)
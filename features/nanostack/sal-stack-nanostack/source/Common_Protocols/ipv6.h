@@ -68,6 +68,7 @@ typedef enum ipv6_exthdr_stage {
  */
 typedef buffer_t *ipv6_exthdr_provider_fn_t(buffer_t *buf, ipv6_exthdr_stage_t stage, int16_t *result);
 void ipv6_set_exthdr_provider(ipv6_route_src_t src, ipv6_exthdr_provider_fn_t *fn);
+bool ipv6_has_exthdr_provider(ipv6_route_src_t src);
 
 extern buffer_t *ipv6_down(buffer_t *buf);
 extern buffer_t *ipv6_forwarding_down(buffer_t *buf);
@@ -50,6 +50,16 @@
 #define MAX_BUFFERED_MESSAGES_SIZE 2048
 #define MAX_BUFFERED_MESSAGE_LIFETIME 600 // 1/10 s ticks
 
+/* Seed lookup buckets per domain */
+#ifndef MPL_SEED_HASH_SIZE
+#define MPL_SEED_HASH_SIZE 8
+#endif
+
+/* Sequence numbers from MinSequence tracked by the window bitmap of a seed */
+#ifndef MPL_SEED_WINDOW
+#define MPL_SEED_WINDOW 64
+#endif
+
 static bool mpl_timer_running;
 static uint16_t mpl_total_buffered;
 
@@ -80,12 +90,18 @@ typedef struct mpl_data_message {
     uint8_t message[];
 } mpl_buffered_message_t;
 
+/* Bit i of window is set when message min_sequence + i is buffered, in the
+ * bit order of the control message bitmap. Messages beyond the window are
+ * only found in the list.
+ */
 typedef struct mpl_seed {
     ns_list_link_t link;
+    struct mpl_seed *hash_next;
     bool colour;
     uint16_t lifetime;
     uint8_t min_sequence;
     uint8_t id_len;
+    uint8_t window[MPL_SEED_WINDOW / 8];
     NS_LIST_HEAD(mpl_buffered_message_t, link) messages; /* sequence number order */
     uint8_t id[];
 } mpl_seed_t;
@@ -99,6 +115,7 @@ struct mpl_domain {
     bool proactive_forwarding;
     uint16_t seed_set_entry_lifetime;
     NS_LIST_HEAD(mpl_seed_t, link) seeds;
+    mpl_seed_t *seed_hash[MPL_SEED_HASH_SIZE];
     trickle_t trickle;                      // Control timer
     trickle_params_t data_trickle_params;
     trickle_params_t control_trickle_params;
@@ -234,6 +251,7 @@ mpl_domain_t *mpl_domain_create(protocol_interface_info_entry_t *cur, const uint
     domain->sequence = randLIB_get_8bit();
     domain->colour = false;
     ns_list_init(&domain->seeds);
+    memset(domain->seed_hash, 0, sizeof domain->seed_hash);
     domain->proactive_forwarding = proactive_forwarding >= 0 ? proactive_forwarding
                                    : cur->mpl_proactive_forwarding;
     domain->seed_set_entry_lifetime = seed_set_entry_lifetime ? seed_set_entry_lifetime
@@ -312,9 +330,17 @@ static void mpl_domain_inconsistent(mpl_domain_t *domain)
     mpl_schedule_timer();
 }
 
+/* Seed IDs are 2, 8 or 16 bytes, ending with a short address or an IID */
+static uint_fast8_t mpl_seed_hash(uint8_t id_len, const uint8_t *seed_id)
+{
+    uint16_t hash = common_read_16_bit(seed_id + id_len - 2);
+    hash ^= hash >> 8;
+    return hash % MPL_SEED_HASH_SIZE;
+}
+
 static mpl_seed_t *mpl_seed_lookup(const mpl_domain_t *domain, uint8_t id_len, const uint8_t *seed_id)
 {
-    ns_list_foreach(mpl_seed_t, seed, &domain->seeds) {
+    for (mpl_seed_t *seed = domain->seed_hash[mpl_seed_hash(id_len, seed_id)]; seed; seed = seed->hash_next) {
         if (seed->id_len == id_len && memcmp(seed->id, seed_id, id_len) == 0) {
             return seed;
         }
@@ -334,9 +360,13 @@ static mpl_seed_t *mpl_seed_create(mpl_domain_t *domain, uint8_t id_len, const u
     seed->lifetime = domain->seed_set_entry_lifetime;
     seed->id_len = id_len;
     seed->colour = domain->colour;
+    memset(seed->window, 0, sizeof seed->window);
     ns_list_init(&seed->messages);
     memcpy(seed->id, seed_id, id_len);
     ns_list_add_to_end(&domain->seeds, seed);
+    mpl_seed_t **bucket = &domain->seed_hash[mpl_seed_hash(id_len, seed_id)];
+    seed->hash_next = *bucket;
+    *bucket = seed;
     return seed;
 }
 
@@ -345,22 +375,55 @@ static void mpl_seed_delete(mpl_domain_t *domain, mpl_seed_t *seed)
     ns_list_foreach_safe(mpl_buffered_message_t, message, &seed->messages) {
         mpl_buffer_delete(seed, message);
     }
+    mpl_seed_t **prev = &domain->seed_hash[mpl_seed_hash(seed->id_len, seed->id)];
+    while (*prev != seed) {
+        prev = &(*prev)->hash_next;
+    }
+    *prev = seed->hash_next;
     ns_list_remove(&domain->seeds, seed);
     ns_dyn_mem_free(seed);
 }
 
-static void mpl_seed_advance_min_sequence(mpl_seed_t *seed, uint8_t min_sequence)
+static void mpl_seed_window_update(mpl_seed_t *seed, uint8_t sequence, bool buffered)
+{
+    uint8_t offset = sequence - seed->min_sequence;
+    if (offset >= MPL_SEED_WINDOW) {
+        return;
+    }
+    if (buffered) {
+        bit_set(seed->window, offset);
+    } else {
+        bit_clear(seed->window, offset);
+    }
+}
+
+/* Moving MinSequence slides the window, and brings in messages from beyond it */
+static void mpl_seed_set_min_sequence(mpl_seed_t *seed, uint8_t min_sequence)
 {
     seed->min_sequence = min_sequence;
+    memset(seed->window, 0, sizeof seed->window);
+    ns_list_foreach(mpl_buffered_message_t, message, &seed->messages) {
+        mpl_seed_window_update(seed, mpl_buffer_sequence(message), true);
+    }
+}
+
+static void mpl_seed_advance_min_sequence(mpl_seed_t *seed, uint8_t min_sequence)
+{
     ns_list_foreach_safe(mpl_buffered_message_t, message, &seed->messages) {
         if (common_serial_number_greater_8(min_sequence, mpl_buffer_sequence(message))) {
             mpl_buffer_delete(seed, message);
         }
     }
+    mpl_seed_set_min_sequence(seed, min_sequence);
 }
 
 static mpl_buffered_message_t *mpl_buffer_lookup(mpl_seed_t *seed, uint8_t sequence)
 {
+    /* Absent messages in the window are known without the walk */
+    uint8_t offset = sequence - seed->min_sequence;
+    if (offset < MPL_SEED_WINDOW && !bit_test(seed->window, offset)) {
+        return NULL;
+    }
     ns_list_foreach(mpl_buffered_message_t, message, &seed->messages) {
         if (mpl_buffer_sequence(message) == sequence) {
             return message;
@@ -394,8 +457,9 @@ static void mpl_free_space(void)
         return;
     }
 
-    oldest_seed->min_sequence = mpl_buffer_sequence(oldest_message) + 1;
+    uint8_t sequence = mpl_buffer_sequence(oldest_message);
     mpl_buffer_delete(oldest_seed, oldest_message);
+    mpl_seed_set_min_sequence(oldest_seed, sequence + 1);
 }
 
 
@@ -454,6 +518,7 @@ static mpl_buffered_message_t *mpl_buffer_create(buffer_t *buf, mpl_domain_t *do
     if (!inserted) {
         ns_list_add_to_start(&seed->messages, message);
     }
+    mpl_seed_window_update(seed, sequence, true);
     mpl_total_buffered += ip_len;
 
     /* Does MPL spec intend this distinction between start and reset? */
@@ -465,6 +530,7 @@ static mpl_buffered_message_t *mpl_buffer_create(buffer_t *buf, mpl_domain_t *do
 static void mpl_buffer_delete(mpl_seed_t *seed, mpl_buffered_message_t *message)
 {
     mpl_total_buffered -= mpl_buffer_size(message);
+    mpl_seed_window_update(seed, mpl_buffer_sequence(message), false);
     ns_list_remove(&seed->messages, message);
     ns_dyn_mem_free(message);
 }
@@ -553,10 +619,14 @@ static uint8_t *mpl_write_seed_info(uint8_t *ptr, const mpl_seed_t *seed, const
     ptr += 2;
     memcpy(ptr, seed->id, id_len);
     ptr += id_len;
-    memset(ptr, 0, bm_len);
-    ns_list_foreach(mpl_buffered_message_t, buffer, &seed->messages) {
-        uint8_t i = mpl_buffer_sequence(buffer) - seed->min_sequence;
-        bit_set(ptr, i);
+    if (bm_len <= sizeof seed->window) {
+        memcpy(ptr, seed->window, bm_len);
+    } else {
+        memset(ptr, 0, bm_len);
+        ns_list_foreach(mpl_buffered_message_t, buffer, &seed->messages) {
+            uint8_t i = mpl_buffer_sequence(buffer) - seed->min_sequence;
+            bit_set(ptr, i);
+        }
     }
     ptr += bm_len;
     return ptr;
@@ -997,8 +1067,9 @@ void mpl_slow_timer(uint16_t seconds)
             ns_list_foreach_safe(mpl_buffered_message_t, message, &seed->messages) {
                 if (!trickle_running(&message->trickle, &domain->data_trickle_params) &&
                         protocol_core_monotonic_time - message->timestamp >= message_age_limit) {
-                    seed->min_sequence = mpl_buffer_sequence(message) + 1;
+                    uint8_t sequence = mpl_buffer_sequence(message);
                     mpl_buffer_delete(seed, message);
+                    mpl_seed_set_min_sequence(seed, sequence + 1);
                 } else {
                     break;
                 }
@@ -513,6 +513,8 @@ static void protocol_core_base_finish_init(protocol_interface_info_entry_t *entr
     entry->ip_mcast_fwd_for_scope = IPV6_SCOPE_SITE_LOCAL; // Default for backwards compatibility
 #endif
     ns_list_init(&entry->ipv6_neighbour_cache.list);
+    entry->ipv6_neighbour_cache.num_entries = 0;
+    memset(entry->ipv6_neighbour_cache.hash, 0, sizeof(entry->ipv6_neighbour_cache.hash));
 }
 
 
@@ -249,6 +249,49 @@ void rpl_downward_process_dao_parent_changes(rpl_instance_t *instance)
     }
 }
 
+static uint_fast8_t rpl_dao_target_hash(const uint8_t address[16])
+{
+    uint32_t hash = common_read_32_bit(address) ^ common_read_32_bit(address + 4) ^
+                    common_read_32_bit(address + 8) ^ common_read_32_bit(address + 12);
+    hash ^= hash >> 16;
+    hash ^= hash >> 8;
+    return hash % RPL_DAO_TARGET_HASH_SIZE;
+}
+
+/* 128-bit targets are also indexed by hash, added at the end of their bucket
+ * so lookups find them in creation order like the list. Shorter prefixes are
+ * only counted, so full-length matches can skip the list when there are none.
+ */
+static void rpl_dao_target_hash_add(rpl_instance_t *instance, rpl_dao_target_t *target)
+{
+    if (target->prefix_len != 128) {
+        instance->dao_target_prefixes++;
+        return;
+    }
+    rpl_dao_target_t **prev = &instance->dao_target_hash[rpl_dao_target_hash(target->prefix)];
+    while (*prev) {
+        prev = &(*prev)->hash_next;
+    }
+    target->hash_next = NULL;
+    *prev = target;
+}
+
+static void rpl_dao_target_hash_remove(rpl_instance_t *instance, rpl_dao_target_t *target)
+{
+    if (target->prefix_len != 128) {
+        instance->dao_target_prefixes--;
+        return;
+    }
+    rpl_dao_target_t **prev = &instance->dao_target_hash[rpl_dao_target_hash(target->prefix)];
+    while (*prev) {
+        if (*prev == target) {
+            *prev = target->hash_next;
+            return;
+        }
+        prev = &(*prev)->hash_next;
+    }
+}
+
 rpl_dao_target_t *rpl_create_dao_target(rpl_instance_t *instance, const uint8_t *prefix, uint8_t prefix_len, bool root)
 {
     rpl_dao_target_t *target = rpl_alloc(sizeof(rpl_dao_target_t));
@@ -270,6 +313,7 @@ rpl_dao_target_t *rpl_create_dao_target(rpl_instance_t *instance, const uint8_t
 #endif
 
     ns_list_add_to_end(&instance->dao_targets, target);
+    rpl_dao_target_hash_add(instance, target);
     return target;
 }
 
@@ -280,6 +324,7 @@ void rpl_delete_dao_target(rpl_instance_t *instance, rpl_dao_target_t *target)
     /* TODO - should send a No-Path to root */
 
     ns_list_remove(&instance->dao_targets, target);
+    rpl_dao_target_hash_remove(instance, target);
 
 #ifdef HAVE_RPL_ROOT
     if (target->root) {
@@ -296,6 +341,14 @@ void rpl_delete_dao_target(rpl_instance_t *instance, rpl_dao_target_t *target)
 
 rpl_dao_target_t *rpl_instance_lookup_published_dao_target(rpl_instance_t *instance, const uint8_t *prefix, uint8_t prefix_len)
 {
+    if (prefix_len == 128) {
+        for (rpl_dao_target_t *target = instance->dao_target_hash[rpl_dao_target_hash(prefix)]; target; target = target->hash_next) {
+            if (target->published && addr_ipv6_equal(target->prefix, prefix)) {
+                return target;
+            }
+        }
+        return NULL;
+    }
     ns_list_foreach(rpl_dao_target_t, target, &instance->dao_targets) {
         if (target->published && target->prefix_len == prefix_len &&
                 bitsequal(target->prefix, prefix, prefix_len)) {
@@ -307,6 +360,14 @@ rpl_dao_target_t *rpl_instance_lookup_published_dao_target(rpl_instance_t *insta
 
 rpl_dao_target_t *rpl_instance_lookup_dao_target(rpl_instance_t *instance, const uint8_t *prefix, uint8_t prefix_len)
 {
+    if (prefix_len == 128) {
+        for (rpl_dao_target_t *target = instance->dao_target_hash[rpl_dao_target_hash(prefix)]; target; target = target->hash_next) {
+            if (addr_ipv6_equal(target->prefix, prefix)) {
+                return target;
+            }
+        }
+        return NULL;
+    }
     ns_list_foreach(rpl_dao_target_t, target, &instance->dao_targets) {
         if (target->prefix_len == prefix_len &&
                 bitsequal(target->prefix, prefix, prefix_len)) {
@@ -321,6 +382,13 @@ rpl_dao_target_t *rpl_instance_match_dao_target(rpl_instance_t *instance, const
     rpl_dao_target_t *longest = NULL;
     int_fast16_t longest_len = -1;
 
+    if (prefix_len == 128) {
+        longest = rpl_instance_lookup_dao_target(instance, prefix, 128);
+        if (longest || instance->dao_target_prefixes == 0) {
+            return longest;
+        }
+    }
+
     ns_list_foreach(rpl_dao_target_t, target, &instance->dao_targets) {
         if (target->prefix_len >= longest_len && target->prefix_len <= prefix_len &&
                 bitsequal(target->prefix, prefix, target->prefix_len)) {
@@ -970,6 +1038,30 @@ void rpl_downward_transit_error(rpl_instance_t *instance, const uint8_t *target_
 #endif // HAVE_RPL_ROOT
 
 #ifdef HAVE_RPL_DAO_HANDLING
+/* Make room for a new DAO target when RPL memory is full, by deleting the
+ * learned target closest to expiry if it would expire before the new one.
+ * Targets we publish ourselves are kept.
+ */
+static bool rpl_downward_evict_dao_target(rpl_instance_t *instance, uint32_t lifetime)
+{
+    rpl_dao_target_t *oldest = NULL;
+    ns_list_foreach(rpl_dao_target_t, target, &instance->dao_targets) {
+        if (!target->published && target->lifetime < lifetime &&
+                (!oldest || target->lifetime < oldest->lifetime)) {
+            oldest = target;
+        }
+    }
+    if (!oldest) {
+        return false;
+    }
+    tr_info("RPL DAO evict %s", trace_ipv6_prefix(oldest->prefix, oldest->prefix_len));
+    if (!oldest->root) {
+        ipv6_route_table_remove_info(-1, ROUTE_RPL_DAO, oldest);
+    }
+    rpl_delete_dao_target(instance, oldest);
+    return true;
+}
+
 static bool rpl_downward_process_targets_for_transit(rpl_dodag_t *dodag, bool storing, const uint8_t *src, int8_t interface_id, const uint8_t *target_start, const uint8_t *target_end, const uint8_t *transit_opt, bool *new_info, uint8_t *status)
 {
     (void) status;
@@ -1089,6 +1181,9 @@ static bool rpl_downward_process_targets_for_transit(rpl_dodag_t *dodag, bool st
                     /* Then we proceed to add this transit to the target below */
                 } else if (path_lifetime != 0) {
                     target = rpl_create_dao_target(dodag->instance, prefix, prefix_len, !storing);
+                    if (!target && rpl_downward_evict_dao_target(dodag->instance, lifetime)) {
+                        target = rpl_create_dao_target(dodag->instance, prefix, prefix_len, !storing);
+                    }
                     if (target) {
                         target->path_sequence = path_sequence;
                         target->lifetime = lifetime;
@@ -98,6 +98,11 @@ struct rpl_dodag {
 
 typedef struct rpl_dao_target rpl_dao_target_t;
 
+/* Buckets of the hash indexing the 128-bit DAO targets of an instance */
+#ifndef RPL_DAO_TARGET_HASH_SIZE
+#define RPL_DAO_TARGET_HASH_SIZE 16
+#endif
+
 /* List of transits for a DAO target in a non-storing root */
 typedef struct rpl_dao_root_transit {
     uint8_t transit[16];
@@ -153,6 +158,7 @@ struct rpl_dao_target {
         rpl_dao_non_root_t non_root;    /* Info for other nodes (any in storing, non-root in non-storing) */
     } info;
     ns_list_link_t link;
+    rpl_dao_target_t *hash_next;        /* Next target of the hash bucket (128-bit targets only) */
 };
 
 typedef NS_LIST_HEAD(rpl_dao_target_t, link) rpl_dao_target_list_t;
@@ -190,6 +196,8 @@ struct rpl_instance {
     trickle_t dio_timer;                            /* Trickle timer for DIO transmission */
     rpl_dao_root_transit_children_list_t root_children;
     rpl_dao_target_list_t dao_targets;              /* List of DAO targets */
+    rpl_dao_target_t *dao_target_hash[RPL_DAO_TARGET_HASH_SIZE]; /* 128-bit DAO targets by address hash */
+    uint16_t dao_target_prefixes;                   /* Number of DAO targets shorter than 128 bits */
     uint8_t dao_sequence;                           /* Next DAO sequence to use */
     uint8_t dao_sequence_in_transit;                /* DAO sequence in transit (if dao_in_transit) */
     uint16_t delay_dao_timer;
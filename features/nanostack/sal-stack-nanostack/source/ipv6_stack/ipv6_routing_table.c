@@ -65,7 +65,10 @@ static uint16_t current_max_cache = 64;
 #define ETX_REACHABILITY_THRESHOLD 0x200    /* 8.8 fixed-point, so 2 */
 
 static NS_LIST_DEFINE(ipv6_destination_cache, ipv6_destination_t, link);
+static ipv6_destination_t *ipv6_destination_hash[IPV6_DESTINATION_HASH_SIZE];
+static uint16_t ipv6_destination_count;
 static NS_LIST_DEFINE(ipv6_routing_table, ipv6_route_t, link);
+static ipv6_route_t *ipv6_route_hash[IPV6_ROUTE_HASH_SIZE];
 
 static ipv6_destination_t *ipv6_destination_lookup(const uint8_t *address, int8_t interface_id);
 static void ipv6_destination_cache_forget_router(ipv6_neighbour_cache_t *cache, const uint8_t neighbour_addr[16]);
@@ -159,6 +162,37 @@ static void ipv6_neighbour_gone(ipv6_neighbour_cache_t *cache, uint8_t address[s
     ipv6_destination_cache_forget_router(cache, address);
 }
 
+/* Hash of the interface identifier, which stays valid when the prefix of
+ * a neighbour changes (see thread_bootstrap_ml_address_update). */
+static uint_fast8_t ipv6_address_hash(const uint8_t address[16], uint_fast8_t size)
+{
+    uint32_t hash = common_read_32_bit(address + 8) ^ common_read_32_bit(address + 12);
+    hash ^= hash >> 16;
+    hash ^= hash >> 8;
+    return hash % size;
+}
+
+static void ipv6_neighbour_hash_add(ipv6_neighbour_cache_t *cache, ipv6_neighbour_t *entry)
+{
+    ipv6_neighbour_t **bucket = &cache->hash[ipv6_address_hash(entry->ip_address, IPV6_NEIGHBOUR_HASH_SIZE)];
+    entry->hash_next = *bucket;
+    *bucket = entry;
+    cache->num_entries++;
+}
+
+static void ipv6_neighbour_hash_remove(ipv6_neighbour_cache_t *cache, ipv6_neighbour_t *entry)
+{
+    ipv6_neighbour_t **prev = &cache->hash[ipv6_address_hash(entry->ip_address, IPV6_NEIGHBOUR_HASH_SIZE)];
+    while (*prev) {
+        if (*prev == entry) {
+            *prev = entry->hash_next;
+            cache->num_entries--;
+            return;
+        }
+        prev = &(*prev)->hash_next;
+    }
+}
+
 void ipv6_neighbour_cache_init(ipv6_neighbour_cache_t *cache, int8_t interface_id)
 {
     /* Init Double linked Routing Table */
@@ -191,7 +225,7 @@ void ipv6_neighbour_cache_flush(ipv6_neighbour_cache_t *cache)
 
 ipv6_neighbour_t *ipv6_neighbour_lookup(ipv6_neighbour_cache_t *cache, const uint8_t *address)
 {
-    ns_list_foreach(ipv6_neighbour_t, cur, &cache->list) {
+    for (ipv6_neighbour_t *cur = cache->hash[ipv6_address_hash(address, IPV6_NEIGHBOUR_HASH_SIZE)]; cur; cur = cur->hash_next) {
         if (addr_ipv6_equal(cur->ip_address, address)) {
             return cur;
         }
@@ -218,6 +252,7 @@ void ipv6_neighbour_entry_remove(ipv6_neighbour_cache_t *cache, ipv6_neighbour_t
      * the entry.
      */
     ns_list_remove(&cache->list, entry);
+    ipv6_neighbour_hash_remove(cache, entry);
     switch (entry->state) {
         case IP_NEIGHBOUR_NEW:
             break;
@@ -245,21 +280,17 @@ void ipv6_neighbour_entry_remove(ipv6_neighbour_cache_t *cache, ipv6_neighbour_t
 
 ipv6_neighbour_t *ipv6_neighbour_lookup_or_create(ipv6_neighbour_cache_t *cache, const uint8_t *address/*, bool tentative*/)
 {
-    uint_fast16_t count = 0;
-    ipv6_neighbour_t *entry = NULL;
+    ipv6_neighbour_t *entry = ipv6_neighbour_lookup(cache, address);
 
-    ns_list_foreach(ipv6_neighbour_t, cur, &cache->list) {
-        count++;
-        if (addr_ipv6_equal(cur->ip_address, address)) {
-            if (cur != ns_list_get_first(&cache->list)) {
-                ns_list_remove(&cache->list, cur);
-                ns_list_add_to_start(&cache->list, cur);
-            }
-            return cur;
+    if (entry) {
+        if (entry != ns_list_get_first(&cache->list)) {
+            ns_list_remove(&cache->list, entry);
+            ns_list_add_to_start(&cache->list, entry);
         }
+        return entry;
     }
 
-    if (count >= current_max_cache) {
+    if (cache->num_entries >= current_max_cache) {
         entry = ns_list_get_last(&cache->list);
         ipv6_neighbour_entry_remove(cache, entry);
     }
@@ -292,6 +323,7 @@ ipv6_neighbour_t *ipv6_neighbour_lookup_or_create(ipv6_neighbour_cache_t *cache,
     }
 
     ns_list_add_to_start(&cache->list, entry);
+    ipv6_neighbour_hash_add(cache, entry);
 
     return entry;
 }
@@ -803,6 +835,29 @@ void ipv6_destination_cache_print(route_print_fn_t *print_fn)
     }
 }
 
+static void ipv6_destination_cache_add(ipv6_destination_t *entry)
+{
+    ipv6_destination_t **bucket = &ipv6_destination_hash[ipv6_address_hash(entry->destination, IPV6_DESTINATION_HASH_SIZE)];
+    ns_list_add_to_start(&ipv6_destination_cache, entry);
+    entry->hash_next = *bucket;
+    *bucket = entry;
+    ipv6_destination_count++;
+}
+
+static void ipv6_destination_cache_remove(ipv6_destination_t *entry)
+{
+    ipv6_destination_t **prev = &ipv6_destination_hash[ipv6_address_hash(entry->destination, IPV6_DESTINATION_HASH_SIZE)];
+    ns_list_remove(&ipv6_destination_cache, entry);
+    while (*prev) {
+        if (*prev == entry) {
+            *prev = entry->hash_next;
+            ipv6_destination_count--;
+            return;
+        }
+        prev = &(*prev)->hash_next;
+    }
+}
+
 static ipv6_destination_t *ipv6_destination_lookup(const uint8_t *address, int8_t interface_id)
 {
     bool is_ll = addr_is_ipv6_link_local(address);
@@ -811,7 +866,7 @@ static ipv6_destination_t *ipv6_destination_lookup(const uint8_t *address, int8_
         return NULL;
     }
 
-    ns_list_foreach(ipv6_destination_t, cur, &ipv6_destination_cache) {
+    for (ipv6_destination_t *cur = ipv6_destination_hash[ipv6_address_hash(address, IPV6_DESTINATION_HASH_SIZE)]; cur; cur = cur->hash_next) {
         if (!addr_ipv6_equal(cur->destination, address)) {
             continue;
         }
@@ -840,7 +895,6 @@ static ipv6_destination_t *ipv6_destination_lookup(const uint8_t *address, int8_
  */
 ipv6_destination_t *ipv6_destination_lookup_or_create(const uint8_t *address, int8_t interface_id)
 {
-    uint_fast16_t count = 0;
     ipv6_destination_t *entry = NULL;
     bool interface_specific = addr_ipv6_scope(address, NULL) <= IPV6_SCOPE_REALM_LOCAL;
 
@@ -849,8 +903,7 @@ ipv6_destination_t *ipv6_destination_lookup_or_create(const uint8_t *address, in
     }
 
     /* Find any existing entry */
-    ns_list_foreach(ipv6_destination_t, cur, &ipv6_destination_cache) {
-        count++;
+    for (ipv6_destination_t *cur = ipv6_destination_hash[ipv6_address_hash(address, IPV6_DESTINATION_HASH_SIZE)]; cur; cur = cur->hash_next) {
         if (!addr_ipv6_equal(cur->destination, address)) {
             continue;
         }
@@ -865,9 +918,9 @@ ipv6_destination_t *ipv6_destination_lookup_or_create(const uint8_t *address, in
 
 
     if (!entry) {
-        if (count > current_max_cache) {
+        if (ipv6_destination_count > current_max_cache) {
             entry = ns_list_get_last(&ipv6_destination_cache);
-            ns_list_remove(&ipv6_destination_cache, entry);
+            ipv6_destination_cache_remove(entry);
             ipv6_destination_release(entry);
         }
 
@@ -894,7 +947,7 @@ ipv6_destination_t *ipv6_destination_lookup_or_create(const uint8_t *address, in
         } else {
             entry->interface_id = -1;
         }
-        ns_list_add_to_start(&ipv6_destination_cache, entry);
+        ipv6_destination_cache_add(entry);
     } else if (entry != ns_list_get_first(&ipv6_destination_cache)) {
         /* If there was an entry, and it wasn't at the start, move it */
         ns_list_remove(&ipv6_destination_cache, entry);
@@ -1048,7 +1101,7 @@ static void ipv6_destination_cache_gc_periodic(void)
      */
     ns_list_foreach_reverse_safe(ipv6_destination_t, entry, &ipv6_destination_cache) {
         if (entry->lifetime == 0 || gc_count > cache_short_term(true)) {
-            ns_list_remove(&ipv6_destination_cache, entry);
+            ipv6_destination_cache_remove(entry);
             ipv6_destination_release(entry);
             if (--gc_count <= cache_long_term(true)) {
                 break;
@@ -1209,6 +1262,16 @@ static void ipv6_route_entry_remove(ipv6_route_t *route)
         ipv6_route_source_invalidated[route->info.source] = true;
     }
     ns_list_remove(&ipv6_routing_table, route);
+    if (route->prefix_len == 128) {
+        ipv6_route_t **prev = &ipv6_route_hash[ipv6_address_hash(route->prefix, IPV6_ROUTE_HASH_SIZE)];
+        while (*prev) {
+            if (*prev == route) {
+                *prev = route->hash_next;
+                break;
+            }
+            prev = &(*prev)->hash_next;
+        }
+    }
     ns_dyn_mem_free(route);
 }
 
@@ -1438,35 +1501,54 @@ ipv6_route_t *ipv6_route_choose_next_hop(const uint8_t *dest, int8_t interface_i
     return best;
 }
 
-ipv6_route_t *ipv6_route_lookup_with_info(const uint8_t *prefix, uint8_t prefix_len, int8_t interface_id, const uint8_t *next_hop, ipv6_route_src_t source, void *info, int_fast16_t src_id)
+static bool ipv6_route_matches_info(const ipv6_route_t *r, const uint8_t *prefix, uint8_t prefix_len, int8_t interface_id, const uint8_t *next_hop, ipv6_route_src_t source, void *info, int_fast16_t src_id)
 {
-    ns_list_foreach(ipv6_route_t, r, &ipv6_routing_table) {
-        if (interface_id == r->info.interface_id && prefix_len == r->prefix_len && bitsequal(prefix, r->prefix, prefix_len)) {
-            if (source != ROUTE_ANY) {
-                if (source != r->info.source) {
-                    continue;
-                }
-                if (info && info != r->info.info) {
-                    continue;
-                }
-                if (src_id != -1 && src_id != r->info.source_id) {
-                    continue;
-                }
-                if (info && ipv6_route_next_hop_computation[source]) {
-                    /* No need to match the actual next hop - we assume info distinguishes */
-                    return r;
-                }
-            }
+    if (interface_id != r->info.interface_id || prefix_len != r->prefix_len || !bitsequal(prefix, r->prefix, prefix_len)) {
+        return false;
+    }
+    if (source != ROUTE_ANY) {
+        if (source != r->info.source) {
+            return false;
+        }
+        if (info && info != r->info.info) {
+            return false;
+        }
+        if (src_id != -1 && src_id != r->info.source_id) {
+            return false;
+        }
+        if (info && ipv6_route_next_hop_computation[source]) {
+            /* No need to match the actual next hop - we assume info distinguishes */
+            return true;
+        }
+    }
 
-            /* "next_hop" being NULL means on-link; this is a flag in the route entry, and r->next_hop can't be NULL */
-            if ((next_hop && r->on_link) || (!next_hop && !r->on_link)) {
-                continue;
-            }
+    /* "next_hop" being NULL means on-link; this is a flag in the route entry, and r->next_hop can't be NULL */
+    if ((next_hop && r->on_link) || (!next_hop && !r->on_link)) {
+        return false;
+    }
 
-            if (next_hop && !r->on_link && !addr_ipv6_equal(next_hop, r->info.next_hop_addr)) {
-                continue;
+    if (next_hop && !r->on_link && !addr_ipv6_equal(next_hop, r->info.next_hop_addr)) {
+        return false;
+    }
+
+    return true;
+}
+
+ipv6_route_t *ipv6_route_lookup_with_info(const uint8_t *prefix, uint8_t prefix_len, int8_t interface_id, const uint8_t *next_hop, ipv6_route_src_t source, void *info, int_fast16_t src_id)
+{
+    /* Host routes, such as the RPL DAO routes of a border router, are found
+     * through their hash bucket. A ROUTE_ANY look-up keeps the list order. */
+    if (prefix_len == 128 && source != ROUTE_ANY) {
+        for (ipv6_route_t *r = ipv6_route_hash[ipv6_address_hash(prefix, IPV6_ROUTE_HASH_SIZE)]; r; r = r->hash_next) {
+            if (ipv6_route_matches_info(r, prefix, prefix_len, interface_id, next_hop, source, info, src_id)) {
+                return r;
             }
+        }
+        return NULL;
+    }
 
+    ns_list_foreach(ipv6_route_t, r, &ipv6_routing_table) {
+        if (ipv6_route_matches_info(r, prefix, prefix_len, interface_id, next_hop, source, info, src_id)) {
             return r;
         }
     }
@@ -1582,6 +1664,11 @@ ipv6_route_t *ipv6_route_add_metric(const uint8_t *prefix, uint8_t prefix_len, i
         /* Doesn't matter much where they start off, but put them at the */
         /* beginning so new routes tend to get tried first. */
         ns_list_add_to_start(&ipv6_routing_table, route);
+        if (prefix_len == 128) {
+            ipv6_route_t **bucket = &ipv6_route_hash[ipv6_address_hash(route->prefix, IPV6_ROUTE_HASH_SIZE)];
+            route->hash_next = *bucket;
+            *bucket = route;
+        }
         changed_info = NEW;
     } else { /* updating a route - only lifetime and metric can be changing */
         route->lifetime = lifetime;
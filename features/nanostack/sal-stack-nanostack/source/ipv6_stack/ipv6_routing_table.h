@@ -41,6 +41,18 @@
 
 #define IPV6_ROUTE_DEFAULT_METRIC           128
 
+/* Buckets of the address hashes indexing the Neighbour and Destination Caches,
+ * and the host routes of the routing table */
+#ifndef IPV6_NEIGHBOUR_HASH_SIZE
+#define IPV6_NEIGHBOUR_HASH_SIZE            16
+#endif
+#ifndef IPV6_DESTINATION_HASH_SIZE
+#define IPV6_DESTINATION_HASH_SIZE          32
+#endif
+#ifndef IPV6_ROUTE_HASH_SIZE
+#define IPV6_ROUTE_HASH_SIZE                32
+#endif
+
 /* XXX in the process of renaming this - it's really specifically the
  * IP Neighbour Cache  but was initially called a routing table */
 
@@ -101,6 +113,7 @@ typedef struct ipv6_neighbour {
     uint32_t                        timer;                      /* 100ms ticks */
     uint32_t                        lifetime;                   /* seconds */
     ns_list_link_t                  link;                       /*!< List link */
+    struct ipv6_neighbour           *hash_next;                 /*!< Next entry of the hash bucket */
     NS_LIST_HEAD_INCOMPLETE(struct buffer) queue;
     uint8_t                         ll_address[];
 } ipv6_neighbour_t;
@@ -131,8 +144,9 @@ typedef struct ipv6_neighbour_cache {
     uint32_t                                reachable_time;
     // Interface specific information for route
     ipv6_route_interface_info_t             route_if_info;
-    //uint8_t                                   num_entries;
+    uint16_t                                num_entries;
     NS_LIST_HEAD(ipv6_neighbour_t, link)    list;
+    ipv6_neighbour_t                        *hash[IPV6_NEIGHBOUR_HASH_SIZE];
 } ipv6_neighbour_cache_t;
 
 /* Macros for formatting ipv6 addresses into strings for route printing. */
@@ -202,6 +216,7 @@ typedef struct ipv6_destination {
     uint32_t                        fragment_id;
 #endif
     ipv6_neighbour_t                *last_neighbour;    // last neighbour used (only for reachability confirmation)
+    struct ipv6_destination         *hash_next;         // next entry of the hash bucket
     ns_list_link_t                  link;
 } ipv6_destination_t;
 
@@ -232,6 +247,7 @@ typedef struct ipv6_route {
     uint32_t            lifetime;           // (seconds); 0xFFFFFFFF means permanent
     uint16_t            probe_timer;
     ns_list_link_t      link;
+    struct ipv6_route   *hash_next;         // next host route of the hash bucket
     uint8_t             prefix[];           // variable length
 } ipv6_route_t;
 
@@ -29,6 +29,11 @@
 
 /**
  * \brief DTLSSocketWrapper implement DTLS stream over the existing Socket transport.
+ *
+ * As with TLS, sessions are resumed from the session cache, also with PSK
+ * and no hostname, by the address of the peer. A cache saved in a KVStore
+ * (see TLSSessionCache::set_kvstore()) keeps them across resets and power
+ * saving, so reconnects use the abbreviated handshake.
  */
 class DTLSSocketWrapper : public TLSSocketWrapper {
 public:
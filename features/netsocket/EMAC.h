@@ -175,6 +175,36 @@ public:
      * @param mem_mngr Pointer to memory manager
      */
     virtual void set_memory_manager(EMACMemoryManager &mem_mngr) = 0;
+
+    /** Checksums computed or verified by the hardware
+     *
+     * Flags returned by get_checksum_offload().
+     */
+    enum checksum_offload_t {
+        TX_CHECKSUM_IP      = 0x0001,   /**< Inserts IPv4 header checksums */
+        TX_CHECKSUM_UDP     = 0x0002,   /**< Inserts UDP checksums */
+        TX_CHECKSUM_TCP     = 0x0004,   /**< Inserts TCP checksums */
+        TX_CHECKSUM_ICMP    = 0x0008,   /**< Inserts ICMP checksums */
+        TX_CHECKSUM_ICMP6   = 0x0010,   /**< Inserts ICMPv6 checksums */
+        RX_CHECKSUM_IP      = 0x0100,   /**< Drops received IPv4 headers with a bad checksum */
+        RX_CHECKSUM_UDP     = 0x0200,   /**< Drops received UDP datagrams with a bad checksum */
+        RX_CHECKSUM_TCP     = 0x0400,   /**< Drops received TCP segments with a bad checksum */
+        RX_CHECKSUM_ICMP    = 0x0800,   /**< Drops received ICMP messages with a bad checksum */
+        RX_CHECKSUM_ICMP6   = 0x1000    /**< Drops received ICMPv6 messages with a bad checksum */
+    };
+
+    /** Return the checksums handled by the hardware
+     *
+     * The stack leaves the checksum fields of outgoing packets to zero for
+     * the TX_CHECKSUM_ flags, and skips checking incoming packets for the
+     * RX_CHECKSUM_ flags. Called after power_up().
+     *
+     * @return     Bitmask of checksum_offload_t flags, 0 by default
+     */
+    virtual uint32_t get_checksum_offload() const
+    {
+        return 0;
+    }
 };
 
 
@@ -112,6 +112,15 @@ const char *EMACInterface::get_gateway()
     return 0;
 }
 
+nsapi_error_t EMACInterface::get_stats(nsapi_netif_stats_t *stats)
+{
+    if (!_interface) {
+        return NSAPI_ERROR_NO_CONNECTION;
+    }
+
+    return _interface->get_stats(stats);
+}
+
 NetworkStack *EMACInterface::get_stack()
 {
     return &_stack;
@@ -135,6 +144,15 @@ nsapi_connection_status_t EMACInterface::get_connection_status() const
     }
 }
 
+nsapi_error_t EMACInterface::get_connection_timeline(nsapi_connection_timeline_t *timeline)
+{
+    if (!_interface) {
+        return NSAPI_ERROR_NO_CONNECTION;
+    }
+
+    return _interface->get_connection_timeline(timeline);
+}
+
 nsapi_error_t EMACInterface::set_blocking(bool blocking)
 {
     _blocking = blocking;
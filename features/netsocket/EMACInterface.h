@@ -117,6 +117,14 @@ public:
      */
     virtual const char *get_gateway();
 
+    /** Get the frame counters of the interface
+     *
+     *  @param stats    Structure to which the counters will be copied
+     *  @return         NSAPI_ERROR_OK on success, or NSAPI_ERROR_NO_CONNECTION
+     *                  if the interface was never connected
+     */
+    nsapi_error_t get_stats(nsapi_netif_stats_t *stats);
+
     /** Register callback for status reporting
      *
      *  @param status_cb The callback for status changes
@@ -129,6 +137,14 @@ public:
      */
     virtual nsapi_connection_status_t get_connection_status() const;
 
+    /** Get the timeline of the last connection
+     *
+     *  @param timeline Structure to which the times will be copied
+     *  @return         NSAPI_ERROR_OK on success, or NSAPI_ERROR_NO_CONNECTION
+     *                  if the interface was never connected
+     */
+    virtual nsapi_error_t get_connection_timeline(nsapi_connection_timeline_t *timeline);
+
     /** Set blocking status of connect() which by default should be blocking
      *
      *  @param blocking true if connect is blocking
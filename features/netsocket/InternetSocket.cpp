@@ -15,7 +15,11 @@
  */
 
 #include "InternetSocket.h"
+#include "NetStackMemoryManager.h"
 #include "platform/Callback.h"
+#if MBED_CONF_NSAPI_SOCKET_STATS_ENABLE
+#include "rtos/Kernel.h"
+#endif
 
 using namespace mbed;
 
@@ -96,6 +100,24 @@ nsapi_error_t InternetSocket::close()
     return ret;
 }
 
+uint32_t InternetSocket::wait_writable()
+{
+#if MBED_CONF_NSAPI_SOCKET_STATS_ENABLE
+    uint64_t start = rtos::Kernel::get_ms_count();
+#endif
+
+    // Release lock before blocking so other threads
+    // accessing this object aren't blocked
+    _lock.unlock();
+    uint32_t flag = _event_flag.wait_any(WRITE_FLAG, _timeout);
+    _lock.lock();
+
+#if MBED_CONF_NSAPI_SOCKET_STATS_ENABLE
+    _socket_stats.stats_update_send_blocked(this, rtos::Kernel::get_ms_count() - start);
+#endif
+    return flag;
+}
+
 int InternetSocket::modify_multicast_group(const SocketAddress &address, nsapi_socket_option_t socketopt)
 {
     nsapi_ip_mreq_t mreq;
@@ -228,3 +250,172 @@ nsapi_error_t InternetSocket::getpeername(SocketAddress *address)
     *address = _remote_peer;
     return NSAPI_ERROR_OK;
 }
+
+NetStackMemoryManager *InternetSocket::get_memory_manager()
+{
+    return _stack ? _stack->get_memory_manager() : NULL;
+}
+
+nsapi_size_or_error_t InternetSocket::send_buf(net_stack_mem_buf_t *buf)
+{
+    if (get_proto() == NSAPI_UDP) {
+        if (!_remote_peer) {
+            return NSAPI_ERROR_NO_ADDRESS;
+        }
+        return sendto_buf(_remote_peer, buf);
+    }
+
+    NetStackMemoryManager *memory_manager = get_memory_manager();
+    if (!memory_manager) {
+        return _stack ? NSAPI_ERROR_UNSUPPORTED : NSAPI_ERROR_NO_SOCKET;
+    }
+
+    // TCP keeps its own copy of the data until it is acknowledged, so the parts
+    // of the buffer are queued like any other data
+    nsapi_size_t total = memory_manager->get_total_len(buf);
+    nsapi_size_t sent = 0;
+    nsapi_size_or_error_t ret = NSAPI_ERROR_OK;
+    for (net_stack_mem_buf_t *part = buf; part && sent < total; part = memory_manager->get_next(part)) {
+        nsapi_size_t len = memory_manager->get_len(part);
+        if (!len) {
+            continue;
+        }
+        ret = send(memory_manager->get_ptr(part), len);
+        if (ret < 0) {
+            break;
+        }
+        sent += ret;
+        if ((nsapi_size_t)ret < len) {
+            break;
+        }
+    }
+
+    if (sent == total) {
+        memory_manager->free(buf);
+        return sent;
+    }
+    return sent ? (nsapi_size_or_error_t)sent : ret;
+}
+
+nsapi_size_or_error_t InternetSocket::sendto_buf(const SocketAddress &address, net_stack_mem_buf_t *buf)
+{
+    if (get_proto() != NSAPI_UDP) {
+        return send_buf(buf);
+    }
+
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+
+    _writers++;
+    if (_socket) {
+        _socket_stats.stats_update_socket_state(this, SOCK_OPEN);
+        _socket_stats.stats_update_peer(this, address);
+    }
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        core_util_atomic_flag_clear(&_pending);
+        nsapi_size_or_error_t sent = _stack->socket_sendto_buf(_socket, address, buf);
+        if ((0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != sent)) {
+            _socket_stats.stats_update_sent_bytes(this, sent);
+            ret = sent;
+            break;
+        } else {
+            uint32_t flag;
+
+            flag = wait_writable();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _writers--;
+    if (!_socket || !_writers) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+    _lock.unlock();
+    return ret;
+}
+
+nsapi_size_or_error_t InternetSocket::recv_buf(net_stack_mem_buf_t **buf)
+{
+    return recvfrom_buf(NULL, buf);
+}
+
+nsapi_size_or_error_t InternetSocket::recvfrom_buf(SocketAddress *address, net_stack_mem_buf_t **buf)
+{
+    bool udp = (get_proto() == NSAPI_UDP);
+    SocketAddress ignored;
+
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+
+    if (!address) {
+        address = &ignored;
+    } else if (!udp) {
+        *address = _remote_peer;
+    }
+
+    _readers++;
+
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        core_util_atomic_flag_clear(&_pending);
+        net_stack_mem_buf_t *recv_buf = NULL;
+        nsapi_size_or_error_t recv;
+        if (udp) {
+            recv = _stack->socket_recvfrom_buf(_socket, address, &recv_buf);
+
+            // Filter incomming packets using connected peer address
+            if (recv >= 0 && _remote_peer && _remote_peer != *address) {
+                _stack->get_memory_manager()->free(recv_buf);
+                continue;
+            }
+        } else {
+            recv = _stack->socket_recv_buf(_socket, &recv_buf);
+        }
+
+        // Non-blocking sockets always return. Blocking only returns when success or errors other than WOULD_BLOCK
+        if ((0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != recv)) {
+            if (recv >= 0) {
+                *buf = recv_buf;
+            }
+            ret = recv;
+            _socket_stats.stats_update_recv_bytes(this, recv);
+            break;
+        } else {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            flag = _event_flag.wait_any(READ_FLAG, _timeout);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _readers--;
+    if (!_socket || !_readers) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+
+    _lock.unlock();
+    return ret;
+}
@@ -123,6 +123,73 @@ public:
      */
     virtual nsapi_error_t getpeername(SocketAddress *address);
 
+    /** Get the memory manager of the network buffers of the socket's stack.
+     *
+     *  Buffers to send with send_buf() and sendto_buf() must be allocated
+     *  with it, and buffers returned by recv_buf() and recvfrom_buf() freed
+     *  with it.
+     *
+     *  @return         The memory manager, or NULL if the stack doesn't
+     *                  support network buffers or the socket isn't open.
+     */
+    NetStackMemoryManager *get_memory_manager();
+
+    /** Send data held in a network buffer over the socket.
+     *
+     *  UDP sockets send the buffer as a datagram to the connected peer,
+     *  passing it down to the network interface without copying it. TCP
+     *  sockets queue the data of each part of the buffer like send(), as
+     *  TCP keeps a copy of unacknowledged data.
+     *
+     *  Ownership of the buffer passes to the socket if the whole buffer was
+     *  sent, otherwise the caller keeps it and must free or resend it. A TCP
+     *  socket may send fewer bytes than the buffer holds in non-blocking
+     *  mode or on timeout, these leading bytes must not be sent again.
+     *
+     *  @param buf      Network buffer allocated with get_memory_manager().
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure (@see nsapi_types.h).
+     */
+    nsapi_size_or_error_t send_buf(net_stack_mem_buf_t *buf);
+
+    /** Send data held in a network buffer to an address.
+     *
+     *  Same as send_buf(), sending UDP datagrams to the given address. TCP
+     *  sockets ignore the address, like sendto().
+     *
+     *  @param address  Remote address.
+     *  @param buf      Network buffer allocated with get_memory_manager().
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure (@see nsapi_types.h).
+     */
+    nsapi_size_or_error_t sendto_buf(const SocketAddress &address, net_stack_mem_buf_t *buf);
+
+    /** Receive data in a network buffer from the socket.
+     *
+     *  The buffer received by the stack is passed to the caller without
+     *  copying it, it must be freed with get_memory_manager(). UDP sockets
+     *  receive a whole datagram, TCP sockets the data received so far.
+     *
+     *  @param buf      Destination for the received network buffer, only
+     *                  set on success.
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure (@see nsapi_types.h).
+     */
+    nsapi_size_or_error_t recv_buf(net_stack_mem_buf_t **buf);
+
+    /** Receive data in a network buffer and the address of the sender.
+     *
+     *  Same as recv_buf(), connected UDP sockets filter out datagrams from
+     *  other addresses.
+     *
+     *  @param address  Destination for the source address or NULL.
+     *  @param buf      Destination for the received network buffer, only
+     *                  set on success.
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure (@see nsapi_types.h).
+     */
+    nsapi_size_or_error_t recvfrom_buf(SocketAddress *address, net_stack_mem_buf_t **buf);
+
     /** Register a callback on state change of the socket.
      *
      *  @see Socket::sigio
@@ -159,6 +226,12 @@ protected:
     virtual void event();
     int modify_multicast_group(const SocketAddress &address, nsapi_socket_option_t socketopt);
 
+    /** Wait for the stack to accept more data to send, with the lock released
+     *
+     *  @return         Flags set, or an osFlagsError code on timeout
+     */
+    uint32_t wait_writable();
+
     NetworkStack *_stack;
     nsapi_socket_t _socket;
     uint32_t _timeout;
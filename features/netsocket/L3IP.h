@@ -87,6 +87,31 @@ public:
      */
     virtual bool link_out(net_stack_mem_buf_t *buf) = 0;
 
+    /**
+     * Sends several packets over the link
+     *
+     * Used by the stack instead of link_out() for packets sent in a burst, so
+     * the driver can pass them to the hardware in one transfer. Takes the
+     * packets like link_out(). The default implementation calls link_out()
+     * for each packet.
+     *
+     * That cannot be called from an interrupt context.
+     *
+     * @param bufs   Packets to be sent
+     * @param count  Number of packets
+     * @return       Number of packets sent successfully
+     */
+    virtual uint32_t link_out_burst(net_stack_mem_buf_t **bufs, uint32_t count)
+    {
+        uint32_t sent = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            if (link_out(bufs[i])) {
+                sent++;
+            }
+        }
+        return sent;
+    }
+
     /**
      * Initializes the hardware
      *
@@ -103,6 +128,10 @@ public:
     /**
      * Sets a callback that needs to be called for packets received for that interface
      *
+     * The stack takes the buffer passed to the callback as it is, so the driver
+     * should receive straight into buffers allocated from the memory manager
+     * (alloc_pool() for packets that fit its buffers) rather than copy to them.
+     *
      * @param input_cb Function to be register as a callback
      */
     virtual void set_link_input_cb(l3ip_link_input_cb_t input_cb) = 0;
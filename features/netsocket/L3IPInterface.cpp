@@ -133,6 +133,15 @@ nsapi_connection_status_t L3IPInterface::get_connection_status() const
     }
 }
 
+nsapi_error_t L3IPInterface::get_connection_timeline(nsapi_connection_timeline_t *timeline)
+{
+    if (!_interface) {
+        return NSAPI_ERROR_NO_CONNECTION;
+    }
+
+    return _interface->get_connection_timeline(timeline);
+}
+
 nsapi_error_t L3IPInterface::set_blocking(bool blocking)
 {
     _blocking = blocking;
@@ -289,6 +289,18 @@ public:
      */
     virtual nsapi_connection_status_t get_connection_status() const;
 
+    /** Get the timeline of the last connection.
+     *
+     * Reports how long the last connect() took to reach each phase of the
+     * bring-up: link, address, DNS server and global connectivity.
+     *
+     * @param timeline Structure to which the times will be copied.
+     * @return NSAPI_ERROR_OK on success
+     * @return NSAPI_ERROR_UNSUPPORTED if the interface doesn't record the timeline.
+     * @return NSAPI_ERROR_NO_CONNECTION if the interface was never connected.
+     */
+    virtual nsapi_error_t get_connection_timeline(nsapi_connection_timeline_t *timeline);
+
     /** Set asynchronous operation of connect() and disconnect() calls.
      *
      * By default, interfaces are in synchronous mode which means that
@@ -17,6 +17,7 @@
 #include "NetworkStack.h"
 #include "nsapi_dns.h"
 #include "stddef.h"
+#include <string.h>
 #include <new>
 #include "EventQueue.h"
 #include "mbed_shared_queues.h"
@@ -121,6 +122,90 @@ nsapi_error_t NetworkStack::getsockopt(void *handle, int level, int optname, voi
     return NSAPI_ERROR_UNSUPPORTED;
 }
 
+nsapi_size_or_error_t NetworkStack::socket_sendmsg(nsapi_socket_t handle, const SocketAddress *address,
+                                                   const nsapi_iovec_t *iov, unsigned iovcnt)
+{
+    if (iovcnt == 1) {
+        return address ? socket_sendto(handle, *address, iov[0].iov_base, iov[0].iov_len)
+               : socket_send(handle, iov[0].iov_base, iov[0].iov_len);
+    }
+
+    // Gather the buffers into a single one
+    nsapi_size_t size = 0;
+    for (unsigned i = 0; i < iovcnt; i++) {
+        size += iov[i].iov_len;
+    }
+
+    uint8_t *data = new (std::nothrow) uint8_t[size ? size : 1];
+    if (!data) {
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    nsapi_size_t offset = 0;
+    for (unsigned i = 0; i < iovcnt; i++) {
+        memcpy(data + offset, iov[i].iov_base, iov[i].iov_len);
+        offset += iov[i].iov_len;
+    }
+
+    nsapi_size_or_error_t ret = address ? socket_sendto(handle, *address, data, size)
+                                : socket_send(handle, data, size);
+    delete[] data;
+    return ret;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_recvmsg(nsapi_socket_t handle, SocketAddress *address,
+                                                   nsapi_iovec_t *iov, unsigned iovcnt)
+{
+    if (iovcnt == 1) {
+        return address ? socket_recvfrom(handle, address, iov[0].iov_base, iov[0].iov_len)
+               : socket_recv(handle, iov[0].iov_base, iov[0].iov_len);
+    }
+
+    nsapi_size_t size = 0;
+    for (unsigned i = 0; i < iovcnt; i++) {
+        size += iov[i].iov_len;
+    }
+
+    uint8_t *data = new (std::nothrow) uint8_t[size ? size : 1];
+    if (!data) {
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    nsapi_size_or_error_t ret = address ? socket_recvfrom(handle, address, data, size)
+                                : socket_recv(handle, data, size);
+
+    // Scatter the received data over the buffers
+    nsapi_size_t offset = 0;
+    for (unsigned i = 0; i < iovcnt && ret > 0 && offset < (nsapi_size_t)ret; i++) {
+        nsapi_size_t len = iov[i].iov_len;
+        if (len > (nsapi_size_t)ret - offset) {
+            len = ret - offset;
+        }
+        memcpy(iov[i].iov_base, data + offset, len);
+        offset += len;
+    }
+
+    delete[] data;
+    return ret;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_recv_buf(nsapi_socket_t handle, net_stack_mem_buf_t **buf)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_sendto_buf(nsapi_socket_t handle, const SocketAddress &address,
+                                                      net_stack_mem_buf_t *buf)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_recvfrom_buf(nsapi_socket_t handle, SocketAddress *address,
+                                                        net_stack_mem_buf_t **buf)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
 nsapi_error_t NetworkStack::call_in(int delay, mbed::Callback<void()> func)
 {
     static events::EventQueue *event_queue = mbed::mbed_event_queue();
@@ -29,6 +29,8 @@
 
 // Predeclared classes
 class OnboardNetworkStack;
+class NetStackMemoryManager;
+typedef void net_stack_mem_buf_t;
 
 /** NetworkStack class
  *
@@ -169,6 +171,18 @@ public:
         return 0;
     }
 
+    /** Get the memory manager of the network buffers of the stack
+     *
+     *  Stacks returning a memory manager support sending and receiving
+     *  network buffers allocated by it, without copying the data.
+     *
+     *  @return         The memory manager, or NULL if not supported
+     */
+    virtual NetStackMemoryManager *get_memory_manager()
+    {
+        return 0;
+    }
+
 protected:
     friend class InternetSocket;
     friend class UDPSocket;
@@ -324,6 +338,101 @@ protected:
     virtual nsapi_size_or_error_t socket_recvfrom(nsapi_socket_t handle, SocketAddress *address,
                                                   void *buffer, nsapi_size_t size) = 0;
 
+    /** Send a message gathered from several buffers over a socket
+     *
+     *  Sends the buffers like socket_send() of their concatenation if
+     *  address is NULL, or socket_sendto() of it to address otherwise.
+     *  By default the buffers are gathered into a temporary buffer, stacks
+     *  supporting scatter-gather pass them down as they are.
+     *
+     *  This call is non-blocking. If sendmsg would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param address  The SocketAddress of the remote host, or NULL for
+     *                  connected TCP sockets
+     *  @param iov      Array of the buffers of data to send to the host
+     *  @param iovcnt   Number of buffers in the array
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_sendmsg(nsapi_socket_t handle, const SocketAddress *address,
+                                                 const nsapi_iovec_t *iov, unsigned iovcnt);
+
+    /** Receive data scattered into several buffers over a socket
+     *
+     *  Receives data like socket_recv() if address is NULL, or like
+     *  socket_recvfrom() otherwise, filling the buffers in order. By
+     *  default the data is received into a temporary buffer, then
+     *  scattered.
+     *
+     *  This call is non-blocking. If recvmsg would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param address  Destination for the source address, or NULL for
+     *                  connected TCP sockets
+     *  @param iov      Array of the destination buffers
+     *  @param iovcnt   Number of buffers in the array
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_recvmsg(nsapi_socket_t handle, SocketAddress *address,
+                                                 nsapi_iovec_t *iov, unsigned iovcnt);
+
+    /** Receive data over a TCP socket in a network buffer
+     *
+     *  The socket must be connected to a remote host. On success the
+     *  buffer holding the received data is passed to the caller, who
+     *  must free it with the memory manager of the stack.
+     *
+     *  This call is non-blocking. If recv would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param buf      Destination for the received network buffer
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_recv_buf(nsapi_socket_t handle, net_stack_mem_buf_t **buf);
+
+    /** Send a packet held in a network buffer over a UDP socket
+     *
+     *  Sends the buffer allocated with the memory manager of the stack to
+     *  the specified address. On success the stack takes the buffer and
+     *  frees it once sent, on failure the caller keeps it.
+     *
+     *  This call is non-blocking. If sendto would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param address  The SocketAddress of the remote host
+     *  @param buf      Network buffer of data to send to the host
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_sendto_buf(nsapi_socket_t handle, const SocketAddress &address,
+                                                    net_stack_mem_buf_t *buf);
+
+    /** Receive a packet over a UDP socket in a network buffer
+     *
+     *  Receives a packet and stores the source address in address if
+     *  address is not NULL. On success the buffer holding the packet is
+     *  passed to the caller, who must free it with the memory manager of
+     *  the stack.
+     *
+     *  This call is non-blocking. If recvfrom would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param address  Destination for the source address or NULL
+     *  @param buf      Destination for the received network buffer
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_recvfrom_buf(nsapi_socket_t handle, SocketAddress *address,
+                                                      net_stack_mem_buf_t **buf);
+
     /** Register a callback on state change of the socket
      *
      *  The specified callback will be called on state changes such as when
@@ -120,6 +120,26 @@ public:
          * @return              Pointer to a buffer, or NULL if the buffer is too small
          */
         virtual char *get_gateway(char *buf, nsapi_size_t buflen) = 0;
+
+        /** Copies the frame counters of the network interface
+         *
+         * @param    stats      structure to which the counters will be copied
+         * @return              NSAPI_ERROR_OK on success, or error code
+         */
+        virtual nsapi_error_t get_stats(nsapi_netif_stats_t *stats)
+        {
+            return NSAPI_ERROR_UNSUPPORTED;
+        }
+
+        /** Copies the timeline of the last bringup of the network interface
+         *
+         * @param    timeline   structure to which the times will be copied
+         * @return              NSAPI_ERROR_OK on success, or error code
+         */
+        virtual nsapi_error_t get_connection_timeline(nsapi_connection_timeline_t *timeline)
+        {
+            return NSAPI_ERROR_UNSUPPORTED;
+        }
     };
 
     /** Register a network interface with the IP stack
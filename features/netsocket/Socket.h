@@ -154,6 +154,45 @@ public:
     virtual nsapi_size_or_error_t recvfrom(SocketAddress *address,
                                            void *data, nsapi_size_t size) = 0;
 
+    /** Send a message gathered from several buffers on a socket.
+     *
+     *  Sends the buffers as a single message, like send() or sendto() of
+     *  their concatenation. Datagram sockets send a single datagram to the
+     *  address, or to the connected peer if address is NULL. Connected-mode
+     *  sockets ignore the address.
+     *
+     *  Blocking and partial writes are the same as for send() and sendto().
+     *
+     *  @param address  Remote address or NULL
+     *  @param iov      Array of the buffers of data to send to the host
+     *  @param iovcnt   Number of buffers in the array
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t sendmsg(const SocketAddress *address,
+                                          const nsapi_iovec_t *iov, unsigned iovcnt)
+    {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+
+    /** Receive a message scattered into several buffers from a socket.
+     *
+     *  Receives data like recv() or recvfrom(), filling the buffers in
+     *  order, and stores the source address in address if address is not
+     *  NULL.
+     *
+     *  @param address  Destination for the source address or NULL
+     *  @param iov      Array of the destination buffers
+     *  @param iovcnt   Number of buffers in the array
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t recvmsg(SocketAddress *address,
+                                          nsapi_iovec_t *iov, unsigned iovcnt)
+    {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+
     /** Bind a specific address to a socket.
      *
      *  Binding a socket specifies the address and port on which to receive
@@ -54,13 +54,20 @@ SocketAddress::SocketAddress(const SocketAddress &addr)
 
 bool SocketAddress::set_ip_address(const char *addr)
 {
+    // Same text as the cached one, nothing to parse
+    if (addr && _ip_address && strcmp(addr, _ip_address) == 0) {
+        return true;
+    }
+
     delete[] _ip_address;
     _ip_address = NULL;
 
-    if (addr && stoip4(addr, strlen(addr), _addr.bytes)) {
+    size_t len = addr ? strlen(addr) : 0;
+    // Only IPv6 addresses contain colons, don't try them as IPv4 first
+    if (addr && !memchr(addr, ':', len) && stoip4(addr, len, _addr.bytes)) {
         _addr.version = NSAPI_IPv4;
         return true;
-    } else if (addr && stoip6(addr, strlen(addr), _addr.bytes)) {
+    } else if (addr && stoip6(addr, len, _addr.bytes)) {
         _addr.version = NSAPI_IPv6;
         return true;
     } else {
@@ -85,6 +92,12 @@ void SocketAddress::set_ip_bytes(const void *bytes, nsapi_version_t version)
 
 void SocketAddress::set_addr(nsapi_addr_t addr)
 {
+    // Keep the cached string if the address doesn't change
+    if (_ip_address && addr.version == _addr.version &&
+            memcmp(addr.bytes, _addr.bytes, sizeof(addr.bytes)) == 0) {
+        return;
+    }
+
     delete[] _ip_address;
     _ip_address = NULL;
     _addr = addr;
@@ -185,6 +198,41 @@ bool operator!=(const SocketAddress &a, const SocketAddress &b)
     return !(a == b);
 }
 
+static int addr_len(nsapi_version_t version)
+{
+    if (version == NSAPI_IPv4) {
+        return NSAPI_IPv4_BYTES;
+    } else if (version == NSAPI_IPv6) {
+        return NSAPI_IPv6_BYTES;
+    }
+    return 0;
+}
+
+bool operator<(const SocketAddress &a, const SocketAddress &b)
+{
+    if (a._addr.version != b._addr.version) {
+        return a._addr.version < b._addr.version;
+    }
+    int diff = memcmp(a._addr.bytes, b._addr.bytes, addr_len(a._addr.version));
+    if (diff) {
+        return diff < 0;
+    }
+    return a._port < b._port;
+}
+
+uint32_t SocketAddress::hash() const
+{
+    // FNV-1a
+    uint32_t h = 2166136261UL;
+    h = (h ^ _addr.version) * 16777619UL;
+    for (int i = 0; i < addr_len(_addr.version); i++) {
+        h = (h ^ _addr.bytes[i]) * 16777619UL;
+    }
+    h = (h ^ (_port >> 8)) * 16777619UL;
+    h = (h ^ (_port & 0xff)) * 16777619UL;
+    return h;
+}
+
 void SocketAddress::_SocketAddress(NetworkStack *iface, const char *host, uint16_t port)
 {
     _ip_address = NULL;
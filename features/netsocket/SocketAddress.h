@@ -122,6 +122,8 @@ public:
      *
      *  Allocates memory for a string and converts binary address to
      *  human-readable format. String is freed in the destructor.
+     *  The string is kept until the address changes, so repeated calls
+     *  don't convert again.
      *
      *  @return         Null-terminated representation of the IP Address
      */
@@ -175,6 +177,25 @@ public:
      */
     friend bool operator!=(const SocketAddress &a, const SocketAddress &b);
 
+    /** Order two addresses by IP version, IP address and port
+     *
+     *  Allows SocketAddress to be used as the key of sorted containers,
+     *  such as std::map. Unlike the equality operators this compares
+     *  the ports too, so each port of a host is a different key.
+     *
+     *  @return         True if a is ordered before b
+     */
+    friend bool operator<(const SocketAddress &a, const SocketAddress &b);
+
+    /** Get a hash of the IP version, IP address and port
+     *
+     *  Addresses ordered equal by operator< have the same hash, so it
+     *  can be used as the key hash of hash tables.
+     *
+     *  @return         32-bit hash
+     */
+    uint32_t hash() const;
+
 private:
     void _SocketAddress(NetworkStack *iface, const char *host, uint16_t port);
 
@@ -0,0 +1,160 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SocketSet.h"
+#include "platform/mbed_critical.h"
+#include <new>
+
+using namespace mbed;
+
+#define READY_FLAG 0x1u
+
+SocketSet::SocketSet()
+    : _entries(NULL), _ready_head(NULL), _ready_tail(NULL)
+{
+}
+
+SocketSet::~SocketSet()
+{
+    while (_entries) {
+        remove(_entries->socket);
+    }
+}
+
+nsapi_error_t SocketSet::add(Socket *socket)
+{
+    _mutex.lock();
+
+    for (entry_t *entry = _entries; entry; entry = entry->next) {
+        if (entry->socket == socket) {
+            _mutex.unlock();
+            return NSAPI_ERROR_PARAMETER;
+        }
+    }
+
+    entry_t *entry = new (std::nothrow) entry_t;
+    if (!entry) {
+        _mutex.unlock();
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+    entry->set = this;
+    entry->socket = socket;
+    entry->next_ready = NULL;
+    entry->ready = false;
+    entry->next = _entries;
+    _entries = entry;
+
+    socket->set_blocking(false);
+    socket->sigio(callback(&SocketSet::signal, entry));
+
+    // State changes before the socket was added went unnoticed
+    queue(entry);
+
+    _mutex.unlock();
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t SocketSet::remove(Socket *socket)
+{
+    _mutex.lock();
+
+    entry_t **prev = &_entries;
+    while (*prev && (*prev)->socket != socket) {
+        prev = &(*prev)->next;
+    }
+    entry_t *entry = *prev;
+    if (!entry) {
+        _mutex.unlock();
+        return NSAPI_ERROR_PARAMETER;
+    }
+    *prev = entry->next;
+
+    socket->sigio(NULL);
+
+    core_util_critical_section_enter();
+    if (entry->ready) {
+        entry_t **prev_ready = &_ready_head;
+        entry_t *last = NULL;
+        while (*prev_ready != entry) {
+            last = *prev_ready;
+            prev_ready = &last->next_ready;
+        }
+        *prev_ready = entry->next_ready;
+        if (_ready_tail == entry) {
+            _ready_tail = last;
+        }
+    }
+    core_util_critical_section_exit();
+
+    delete entry;
+
+    _mutex.unlock();
+    return NSAPI_ERROR_OK;
+}
+
+void SocketSet::signal(entry_t *entry)
+{
+    // May be called from interrupt context
+    entry->set->queue(entry);
+}
+
+void SocketSet::queue(entry_t *entry)
+{
+    core_util_critical_section_enter();
+    if (!entry->ready) {
+        entry->ready = true;
+        entry->next_ready = NULL;
+        if (_ready_tail) {
+            _ready_tail->next_ready = entry;
+        } else {
+            _ready_head = entry;
+        }
+        _ready_tail = entry;
+    }
+    core_util_critical_section_exit();
+
+    _flags.set(READY_FLAG);
+}
+
+int SocketSet::wait(Socket **sockets, unsigned count, int timeout)
+{
+    while (true) {
+        unsigned ready = 0;
+
+        core_util_critical_section_enter();
+        while (_ready_head && ready < count) {
+            entry_t *entry = _ready_head;
+            _ready_head = entry->next_ready;
+            entry->ready = false;
+            sockets[ready++] = entry->socket;
+        }
+        if (!_ready_head) {
+            _ready_tail = NULL;
+        }
+        core_util_critical_section_exit();
+
+        if (ready || !count || timeout == 0) {
+            return ready;
+        }
+
+        // The flag is set by any queueing since the previous wait, so
+        // checking the queue again after the wake-up closes the race
+        uint32_t flag = _flags.wait_any(READY_FLAG, timeout < 0 ? osWaitForever : timeout);
+        if (flag & osFlagsError) {
+            return 0;
+        }
+    }
+}
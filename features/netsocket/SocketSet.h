@@ -0,0 +1,123 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file SocketSet.h SocketSet class */
+/** \addtogroup netsocket
+ * @{*/
+
+#ifndef SOCKETSET_H
+#define SOCKETSET_H
+
+#include "netsocket/Socket.h"
+#include "rtos/EventFlags.h"
+#include "rtos/Mutex.h"
+#include "platform/NonCopyable.h"
+
+/** Set of sockets waited on by a single thread.
+ *
+ *  The set takes over the sigio() callback of its sockets, queueing a
+ *  socket as ready each time its state changes. wait() hands out the
+ *  queued sockets, so its cost only depends on the number of ready
+ *  sockets, not on the size of the set.
+ *
+ *  Readiness is edge triggered, like the sigio() callback it comes from:
+ *  a ready socket may have data to receive, room to send, a connection to
+ *  accept or an error, or nothing at all. The serving thread must use
+ *  non-blocking calls until they return NSAPI_ERROR_WOULD_BLOCK, and
+ *  only then wait again. A socket is queued once until handed out, and
+ *  is queued when added, so no state change is missed.
+ *
+ *  @code
+ *  SocketSet set;
+ *  set.add(&server);
+ *
+ *  while (true) {
+ *      Socket *ready[8];
+ *      int count = set.wait(ready, 8);
+ *      for (int i = 0; i < count; i++) {
+ *          // Serve ready[i] with non-blocking calls
+ *      }
+ *  }
+ *  @endcode
+ */
+class SocketSet : private mbed::NonCopyable<SocketSet> {
+public:
+    /** Create an empty set.
+     */
+    SocketSet();
+
+    /** Destroy the set, removing its sockets.
+     */
+    ~SocketSet();
+
+    /** Add a socket to the set.
+     *
+     *  The socket is set to non-blocking, and its sigio() callback is
+     *  replaced. The socket is queued as ready.
+     *
+     *  @param socket   Socket to add.
+     *  @return         0 on success, NSAPI_ERROR_PARAMETER if the socket
+     *                  is already in the set, NSAPI_ERROR_NO_MEMORY if
+     *                  out of memory.
+     */
+    nsapi_error_t add(Socket *socket);
+
+    /** Remove a socket from the set.
+     *
+     *  The sigio() callback of the socket is cleared. Must be called
+     *  before the socket is closed or destroyed.
+     *
+     *  @param socket   Socket to remove.
+     *  @return         0 on success, NSAPI_ERROR_PARAMETER if the socket
+     *                  is not in the set.
+     */
+    nsapi_error_t remove(Socket *socket);
+
+    /** Wait for sockets of the set to be ready.
+     *
+     *  Sockets are handed out in the order they became ready, and are
+     *  queued again on their next state change.
+     *
+     *  @param sockets  Destination array for the ready sockets.
+     *  @param count    Size of the array.
+     *  @param timeout  Timeout in milliseconds, 0 to return immediately,
+     *                  or -1 to wait forever.
+     *  @return         Number of ready sockets stored, 0 on timeout.
+     */
+    int wait(Socket **sockets, unsigned count, int timeout = -1);
+
+private:
+    struct entry_t {
+        SocketSet *set;
+        Socket *socket;
+        entry_t *next;          // In the set
+        entry_t *next_ready;    // In the ready queue
+        bool ready;
+    };
+
+    static void signal(entry_t *entry);
+    void queue(entry_t *entry);
+
+    entry_t *_entries;
+    entry_t *_ready_head;
+    entry_t *_ready_tail;
+    rtos::EventFlags _flags;
+    rtos::Mutex _mutex;
+};
+
+#endif // SOCKETSET_H
+
+/** @}*/
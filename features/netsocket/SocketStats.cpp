@@ -17,6 +17,7 @@
 #include "SocketStats.h"
 #include "platform/mbed_error.h"
 #include "platform/mbed_assert.h"
+#include "platform/mbed_swo_trace.h"
 #ifdef MBED_CONF_RTOS_PRESENT
 #include "rtos/Kernel.h"
 #endif
@@ -137,6 +138,7 @@ void SocketStats::stats_update_proto(const Socket *const reference_id, nsapi_pro
 
 void SocketStats::stats_update_sent_bytes(const Socket *const reference_id, size_t sent_bytes)
 {
+    MBED_SWO_TRACE(MBED_SWO_TRACE_SOCKET_SEND, sent_bytes);
 #if MBED_CONF_NSAPI_SOCKET_STATS_ENABLE
     _mutex->lock();
     int position = get_entry_position(reference_id);
@@ -149,6 +151,7 @@ void SocketStats::stats_update_sent_bytes(const Socket *const reference_id, size
 
 void SocketStats::stats_update_recv_bytes(const Socket *const reference_id, size_t recv_bytes)
 {
+    MBED_SWO_TRACE(MBED_SWO_TRACE_SOCKET_RECV, recv_bytes);
 #if MBED_CONF_NSAPI_SOCKET_STATS_ENABLE
     _mutex->lock();
     int position = get_entry_position(reference_id);
@@ -158,3 +161,43 @@ void SocketStats::stats_update_recv_bytes(const Socket *const reference_id, size
     _mutex->unlock();
 #endif
 }
+
+void SocketStats::stats_update_send_blocked(const Socket *const reference_id, uint32_t blocked_ms)
+{
+#if MBED_CONF_NSAPI_SOCKET_STATS_ENABLE
+    _mutex->lock();
+    int position = get_entry_position(reference_id);
+    if (position >= 0) {
+        _stats[position].send_blocked_ms += blocked_ms;
+    }
+    _mutex->unlock();
+#endif
+}
+
+void SocketStats::stats_update_tcp_info(const Socket *const reference_id, const nsapi_tcp_info_t &info)
+{
+#if MBED_CONF_NSAPI_SOCKET_STATS_ENABLE
+    _mutex->lock();
+    int position = get_entry_position(reference_id);
+    if (position >= 0) {
+        mbed_stats_socket_t *stats = &_stats[position];
+        // No estimate until the first RTT measurement
+        if (info.rtt_ms) {
+            stats->rtt_ms = info.rtt_ms;
+            if (!stats->rtt_min_ms || info.rtt_ms < stats->rtt_min_ms) {
+                stats->rtt_min_ms = info.rtt_ms;
+            }
+            if (info.rtt_ms > stats->rtt_max_ms) {
+                stats->rtt_max_ms = info.rtt_ms;
+            }
+        }
+        if (info.snd_queued > stats->snd_queued_max) {
+            stats->snd_queued_max = info.snd_queued;
+        }
+        if (info.retransmits > stats->retransmits_max) {
+            stats->retransmits_max = info.retransmits;
+        }
+    }
+    _mutex->unlock();
+#endif
+}
@@ -50,6 +50,12 @@ typedef struct {
     size_t sent_bytes;              /**< Data sent through this socket */
     size_t recv_bytes;              /**< Data received through this socket */
     us_timestamp_t last_change_tick;/**< osKernelGetTick() when state last changed */
+    uint32_t send_blocked_ms;       /**< Time spent waiting for the stack to accept data to send */
+    uint32_t rtt_ms;                /**< Last smoothed round trip time of a TCP socket */
+    uint32_t rtt_min_ms;            /**< Lowest smoothed round trip time seen on a TCP socket */
+    uint32_t rtt_max_ms;            /**< Highest smoothed round trip time seen on a TCP socket */
+    uint32_t snd_queued_max;        /**< Most bytes seen sent or queued, not acknowledged yet, on a TCP socket */
+    uint8_t retransmits_max;        /**< Most retransmissions of a segment seen on a TCP socket */
 } mbed_stats_socket_t;
 
 /**  SocketStats class
@@ -143,6 +149,24 @@ public:
      */
     void stats_update_recv_bytes(const Socket *const reference_id, size_t recv_bytes);
 
+    /** Add time spent blocked in a send call, which is cumulative per socket.
+     *  API used by socket (TCP or UDP) layers only, not to be used by application.
+     *
+     *  @param reference_id   ID to identify socket in data array.
+     *  @param blocked_ms Parameter to append time spent waiting to send.
+     *
+     */
+    void stats_update_send_blocked(const Socket *const reference_id, uint32_t blocked_ms);
+
+    /** Update the round trip time and queue statistics of a TCP socket.
+     *  API used by socket (TCP) layers only, not to be used by application.
+     *
+     *  @param reference_id   ID to identify socket in data array.
+     *  @param info Parameter with the current state of the connection.
+     *
+     */
+    void stats_update_tcp_info(const Socket *const reference_id, const nsapi_tcp_info_t &info);
+
 #if MBED_CONF_NSAPI_SOCKET_STATS_ENABLE
 private:
     static mbed_stats_socket_t _stats[MBED_CONF_NSAPI_SOCKET_STATS_MAX_COUNT];
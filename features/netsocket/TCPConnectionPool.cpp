@@ -0,0 +1,84 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TCPConnectionPool.h"
+#include "platform/mbed_assert.h"
+
+TCPConnectionPool::TCPConnectionPool(TCPSocket *sockets, unsigned count)
+    : _sockets(sockets), _count(count), _used(0)
+{
+    MBED_ASSERT(count <= 32);
+}
+
+TCPSocket *TCPConnectionPool::accept(TCPSocket *server, nsapi_error_t *error)
+{
+    _mutex.lock();
+
+    unsigned i;
+    for (i = 0; i < _count; i++) {
+        if (!(_used & (1UL << i))) {
+            break;
+        }
+    }
+    if (i == _count) {
+        _mutex.unlock();
+        if (error) {
+            *error = NSAPI_ERROR_NO_SOCKET;
+        }
+        return NULL;
+    }
+    _used |= 1UL << i;
+
+    _mutex.unlock();
+
+    // Without the mutex, as accepting may block
+    nsapi_error_t ret = server->accept_into(&_sockets[i]);
+    if (error) {
+        *error = ret;
+    }
+    if (ret != NSAPI_ERROR_OK) {
+        _mutex.lock();
+        _used &= ~(1UL << i);
+        _mutex.unlock();
+        return NULL;
+    }
+    return &_sockets[i];
+}
+
+void TCPConnectionPool::release(TCPSocket *connection)
+{
+    unsigned i = connection - _sockets;
+    MBED_ASSERT(i < _count);
+
+    connection->close();
+
+    _mutex.lock();
+    _used &= ~(1UL << i);
+    _mutex.unlock();
+}
+
+unsigned TCPConnectionPool::available()
+{
+    _mutex.lock();
+    unsigned count = 0;
+    for (unsigned i = 0; i < _count; i++) {
+        if (!(_used & (1UL << i))) {
+            count++;
+        }
+    }
+    _mutex.unlock();
+    return count;
+}
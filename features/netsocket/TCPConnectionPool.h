@@ -0,0 +1,91 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file TCPConnectionPool.h TCPConnectionPool class */
+/** \addtogroup netsocket
+ * @{*/
+
+#ifndef TCPCONNECTIONPOOL_H
+#define TCPCONNECTIONPOOL_H
+
+#include "netsocket/TCPSocket.h"
+#include "rtos/Mutex.h"
+#include "platform/NonCopyable.h"
+
+/** Preallocated sockets for the connections of a TCP server.
+ *
+ *  Connections are accepted into the sockets of the pool with
+ *  TCPSocket::accept_into(), instead of sockets allocated from the heap
+ *  by TCPSocket::accept(), so bursts of short connections don't fragment
+ *  the heap. The number of sockets also bounds the connections served at
+ *  once.
+ *
+ *  @code
+ *  TCPSocket sockets[4];
+ *  TCPConnectionPool pool(sockets, 4);
+ *
+ *  while (true) {
+ *      TCPSocket *connection = pool.accept(&server);
+ *      if (connection) {
+ *          // Serve the connection
+ *          pool.release(connection);
+ *      }
+ *  }
+ *  @endcode
+ */
+class TCPConnectionPool : private mbed::NonCopyable<TCPConnectionPool> {
+public:
+    /** Create a pool of sockets.
+     *
+     *  @param sockets  Array of closed sockets, owned by the application.
+     *  @param count    Number of sockets in the array, at most 32.
+     */
+    TCPConnectionPool(TCPSocket *sockets, unsigned count);
+
+    /** Accept a connection into a free socket of the pool.
+     *
+     *  Blocks as the server socket would in TCPSocket::accept().
+     *
+     *  @param server   Listening socket.
+     *  @param error    Destination for the error value or NULL. Set to
+     *                  NSAPI_ERROR_NO_SOCKET if no socket of the pool is
+     *                  free, otherwise as by TCPSocket::accept_into().
+     *  @return         Socket of the connection, NULL on failure.
+     */
+    TCPSocket *accept(TCPSocket *server, nsapi_error_t *error = NULL);
+
+    /** Close a connection and return its socket to the pool.
+     *
+     *  @param connection   Socket returned by accept().
+     */
+    void release(TCPSocket *connection);
+
+    /** Get the number of free sockets.
+     *
+     *  @return         Sockets of the pool free to accept a connection.
+     */
+    unsigned available();
+
+private:
+    TCPSocket *_sockets;
+    unsigned _count;
+    uint32_t _used;
+    rtos::Mutex _mutex;
+};
+
+#endif // TCPCONNECTIONPOOL_H
+
+/** @}*/
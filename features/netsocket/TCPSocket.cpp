@@ -43,6 +43,17 @@ nsapi_protocol_t TCPSocket::get_proto()
     return NSAPI_TCP;
 }
 
+void TCPSocket::update_tcp_stats()
+{
+#if MBED_CONF_NSAPI_SOCKET_STATS_ENABLE
+    nsapi_tcp_info_t info;
+    unsigned len = sizeof(info);
+    if (_socket && _stack->getsockopt(_socket, NSAPI_SOCKET, NSAPI_TCP_INFO, &info, &len) == NSAPI_ERROR_OK) {
+        _socket_stats.stats_update_tcp_info(this, info);
+    }
+#endif
+}
+
 nsapi_error_t TCPSocket::connect(const SocketAddress &address)
 {
     _lock.lock();
@@ -156,11 +167,7 @@ nsapi_size_or_error_t TCPSocket::send(const void *data, nsapi_size_t size)
         } else if (ret == NSAPI_ERROR_WOULD_BLOCK) {
             uint32_t flag;
 
-            // Release lock before blocking so other threads
-            // accessing this object aren't blocked
-            _lock.unlock();
-            flag = _event_flag.wait_any(WRITE_FLAG, _timeout);
-            _lock.lock();
+            flag = wait_writable();
 
             if (flag & osFlagsError) {
                 // Timeout break
@@ -176,6 +183,7 @@ nsapi_size_or_error_t TCPSocket::send(const void *data, nsapi_size_t size)
         _event_flag.set(FINISHED_FLAG);
     }
 
+    update_tcp_stats();
     _lock.unlock();
     if (ret <= 0 && ret != NSAPI_ERROR_WOULD_BLOCK) {
         return ret;
@@ -237,6 +245,7 @@ nsapi_size_or_error_t TCPSocket::recv(void *data, nsapi_size_t size)
         _event_flag.set(FINISHED_FLAG);
     }
 
+    update_tcp_stats();
     _lock.unlock();
     return ret;
 }
@@ -249,6 +258,138 @@ nsapi_size_or_error_t TCPSocket::recvfrom(SocketAddress *address, void *data, ns
     return recv(data, size);
 }
 
+nsapi_size_or_error_t TCPSocket::sendmsg(const SocketAddress *address, const nsapi_iovec_t *iov, unsigned iovcnt)
+{
+    (void)address;
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+    nsapi_size_t written = 0;
+    unsigned index = 0;
+    nsapi_size_t offset = 0;
+
+    // If this assert is hit then there are two threads
+    // performing a send at the same time which is undefined
+    // behavior
+    MBED_ASSERT(_writers == 0);
+    _writers++;
+
+    while (true) {
+        // Skip the buffers sent in full
+        while (index < iovcnt && offset >= iov[index].iov_len) {
+            offset -= iov[index].iov_len;
+            index++;
+        }
+        if (index == iovcnt) {
+            ret = written;
+            break;
+        }
+
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        core_util_atomic_flag_clear(&_pending);
+        if (offset) {
+            // Finish the partially sent buffer on its own
+            nsapi_iovec_t rest;
+            rest.iov_base = static_cast<uint8_t *>(iov[index].iov_base) + offset;
+            rest.iov_len = iov[index].iov_len - offset;
+            ret = _stack->socket_sendmsg(_socket, NULL, &rest, 1);
+        } else {
+            ret = _stack->socket_sendmsg(_socket, NULL, iov + index, iovcnt - index);
+        }
+        if (ret > 0) {
+            written += ret;
+            offset += ret;
+            continue;
+        }
+        if (_timeout == 0) {
+            break;
+        } else if (ret == NSAPI_ERROR_WOULD_BLOCK) {
+            uint32_t flag;
+
+            flag = wait_writable();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                break;
+            }
+        } else {
+            break;
+        }
+    }
+
+    _writers--;
+    if (!_socket) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+
+    update_tcp_stats();
+    _lock.unlock();
+    if (ret < 0 && ret != NSAPI_ERROR_WOULD_BLOCK) {
+        return ret;
+    } else if (written == 0 && ret < 0) {
+        return NSAPI_ERROR_WOULD_BLOCK;
+    } else {
+        _socket_stats.stats_update_sent_bytes(this, written);
+        return written;
+    }
+}
+
+nsapi_size_or_error_t TCPSocket::recvmsg(SocketAddress *address, nsapi_iovec_t *iov, unsigned iovcnt)
+{
+    if (address) {
+        *address = _remote_peer;
+    }
+
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+
+    // If this assert is hit then there are two threads
+    // performing a recv at the same time which is undefined
+    // behavior
+    MBED_ASSERT(_readers == 0);
+    _readers++;
+
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        core_util_atomic_flag_clear(&_pending);
+        ret = _stack->socket_recvmsg(_socket, NULL, iov, iovcnt);
+        if ((_timeout == 0) || (ret != NSAPI_ERROR_WOULD_BLOCK)) {
+            _socket_stats.stats_update_recv_bytes(this, ret);
+            break;
+        } else {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            flag = _event_flag.wait_any(READ_FLAG, _timeout);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _readers--;
+    if (!_socket) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+
+    update_tcp_stats();
+    _lock.unlock();
+    return ret;
+}
+
 nsapi_error_t TCPSocket::listen(int backlog)
 {
     _lock.lock();
@@ -267,10 +408,8 @@ nsapi_error_t TCPSocket::listen(int backlog)
     return ret;
 }
 
-TCPSocket *TCPSocket::accept(nsapi_error_t *error)
+nsapi_error_t TCPSocket::accept_socket(nsapi_socket_t *socket, SocketAddress *address)
 {
-    _lock.lock();
-    TCPSocket *connection = NULL;
     nsapi_error_t ret;
 
     _readers++;
@@ -282,14 +421,9 @@ TCPSocket *TCPSocket::accept(nsapi_error_t *error)
         }
 
         core_util_atomic_flag_clear(&_pending);
-        void *socket;
-        SocketAddress address;
-        ret = _stack->socket_accept(_socket, &socket, &address);
+        ret = _stack->socket_accept(_socket, socket, address);
 
         if (0 == ret) {
-            connection = new TCPSocket(this, socket, address);
-            _socket_stats.stats_update_peer(connection, address);
-            _socket_stats.stats_update_socket_state(connection, SOCK_CONNECTED);
             break;
         } else if ((_timeout == 0) || (ret != NSAPI_ERROR_WOULD_BLOCK)) {
             break;
@@ -314,9 +448,55 @@ TCPSocket *TCPSocket::accept(nsapi_error_t *error)
     if (!_socket) {
         _event_flag.set(FINISHED_FLAG);
     }
+    return ret;
+}
+
+TCPSocket *TCPSocket::accept(nsapi_error_t *error)
+{
+    _lock.lock();
+    TCPSocket *connection = NULL;
+    void *socket;
+    SocketAddress address;
+
+    nsapi_error_t ret = accept_socket(&socket, &address);
+    if (0 == ret) {
+        connection = new TCPSocket(this, socket, address);
+        _socket_stats.stats_update_peer(connection, address);
+        _socket_stats.stats_update_socket_state(connection, SOCK_CONNECTED);
+    }
+
     _lock.unlock();
     if (error) {
         *error = ret;
     }
     return connection;
 }
+
+nsapi_error_t TCPSocket::accept_into(TCPSocket *connection, SocketAddress *address)
+{
+    _lock.lock();
+    void *socket;
+    SocketAddress peer;
+
+    nsapi_error_t ret = accept_socket(&socket, &peer);
+    if (0 == ret) {
+        // Close outside of its lock, which close() releases while waiting
+        connection->close();
+        connection->_lock.lock();
+        connection->_stack = _stack;
+        connection->_socket = socket;
+        connection->_remote_peer = peer;
+        connection->_event = mbed::Callback<void()>(connection, &TCPSocket::event);
+        _stack->socket_attach(socket, &mbed::Callback<void()>::thunk, &connection->_event);
+        _socket_stats.stats_update_peer(connection, peer);
+        _socket_stats.stats_update_socket_state(connection, SOCK_CONNECTED);
+        connection->_lock.unlock();
+
+        if (address) {
+            *address = peer;
+        }
+    }
+
+    _lock.unlock();
+    return ret;
+}
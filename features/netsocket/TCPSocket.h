@@ -160,6 +160,38 @@ public:
     virtual nsapi_size_or_error_t recvfrom(SocketAddress *address,
                                            void *data, nsapi_size_t size);
 
+    /** Send data gathered from several buffers over a TCP socket
+     *
+     *  The buffers are queued as one stream of data, so they can share
+     *  segments. TCP socket is connection oriented protocol, so address is
+     *  ignored.
+     *
+     *  By default, sendmsg blocks until all data is sent. If socket is set to
+     *  non-blocking or times out, a partial amount can be written.
+     *  NSAPI_ERROR_WOULD_BLOCK is returned if no data was written.
+     *
+     *  @param address  Not used
+     *  @param iov      Array of the buffers of data to send to the host
+     *  @param iovcnt   Number of buffers in the array
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t sendmsg(const SocketAddress *address,
+                                          const nsapi_iovec_t *iov, unsigned iovcnt);
+
+    /** Receive data scattered into several buffers over a TCP socket
+     *
+     *  Same as recvfrom(), filling the buffers in order.
+     *
+     *  @param address  Destination for the remote address or NULL
+     *  @param iov      Array of the destination buffers
+     *  @param iovcnt   Number of buffers in the array
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t recvmsg(SocketAddress *address,
+                                          nsapi_iovec_t *iov, unsigned iovcnt);
+
     /** Accepts a connection on a socket.
      *
      *  The server socket must be bound and set to listen for connections.
@@ -175,6 +207,19 @@ public:
      */
     virtual TCPSocket *accept(nsapi_error_t *error = NULL);
 
+    /** Accepts a connection on a socket into a given socket.
+     *
+     *  Same as accept(), with the connection taken by a socket of the
+     *  application instead of an allocated one, e.g. from a
+     *  TCPConnectionPool. The socket is closed first if it is open. After
+     *  close(), it can take another connection.
+     *
+     *  @param connection Socket to take the connection
+     *  @param address    Destination for the remote address or NULL
+     *  @return           0 on success, negative error code on failure
+     */
+    virtual nsapi_error_t accept_into(TCPSocket *connection, SocketAddress *address = NULL);
+
     /** Listen for incoming connections.
      *
      *  Marks the socket as a passive socket that can be used to accept
@@ -196,6 +241,14 @@ private:
      *  To be used within accept() function. Close() will clean this up.
      */
     TCPSocket(TCPSocket *parent, nsapi_socket_t socket, SocketAddress address);
+
+    /** Wait for a connection and accept it at the stack level, with the lock held
+     */
+    nsapi_error_t accept_socket(nsapi_socket_t *socket, SocketAddress *address);
+
+    /** Refresh the round trip time and queue statistics of the socket
+     */
+    void update_tcp_stats();
 };
 
 
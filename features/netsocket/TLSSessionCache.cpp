@@ -0,0 +1,425 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TLSSessionCache.h"
+#include "KVStore.h"
+#include "mbedtls/platform.h"
+#include <new>
+#include <stdio.h>
+#include <string.h>
+
+// This class requires Mbed TLS SSL/TLS client code
+#if defined(MBEDTLS_SSL_CLI_C)
+
+#define TRACE_GROUP "TLSC"
+#include "mbed-trace/mbed_trace.h"
+
+using mbed::KVStore;
+
+// Version of the records saved in a KVStore. The session structure is
+// saved as it is, so records written by another Mbed TLS build are dropped
+// by the size checks, or have to be removed by changing this version.
+#define TLS_SESSION_RECORD_VERSION  1
+
+TLSSessionCache::TLSSessionCache(unsigned size)
+    : _entries(new (std::nothrow) entry_t[size]), _size(_entries ? size : 0),
+      _use_counter(0), _kvstore(NULL)
+{
+    for (unsigned i = 0; i < _size; i++) {
+        _entries[i].hostname = NULL;
+        mbedtls_ssl_session_init(&_entries[i].session);
+        _entries[i].last_use = 0;
+    }
+}
+
+TLSSessionCache::~TLSSessionCache()
+{
+    clear();
+    delete[] _entries;
+}
+
+TLSSessionCache *TLSSessionCache::get_default_instance()
+{
+#if MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE > 0
+    static TLSSessionCache cache(MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE);
+    return &cache;
+#else
+    return NULL;
+#endif
+}
+
+void TLSSessionCache::set_kvstore(KVStore *kvstore)
+{
+    _mutex.lock();
+    _kvstore = kvstore;
+    _mutex.unlock();
+}
+
+bool TLSSessionCache::apply(const char *hostname, mbedtls_ssl_context *ssl)
+{
+    if (!hostname || !ssl) {
+        return false;
+    }
+
+    _mutex.lock();
+    entry_t *entry = find(hostname);
+    if (!entry) {
+        entry = load(hostname);
+    }
+
+    bool applied = false;
+    if (entry) {
+        entry->last_use = ++_use_counter;
+        int ret = mbedtls_ssl_set_session(ssl, &entry->session);
+        if (ret == 0) {
+            tr_debug("Resuming session with %s", hostname);
+            applied = true;
+        } else {
+            tr_warn("mbedtls_ssl_set_session() failed: -0x%04X", -ret);
+        }
+    }
+    _mutex.unlock();
+    return applied;
+}
+
+nsapi_error_t TLSSessionCache::store(const char *hostname, const mbedtls_ssl_context *ssl)
+{
+    if (!hostname || !ssl) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    mbedtls_ssl_session session;
+    mbedtls_ssl_session_init(&session);
+    int ret = mbedtls_ssl_get_session(ssl, &session);
+    if (ret != 0) {
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+        // The copy fails before the ticket is duplicated, but after the
+        // structure is copied: the pointer still belongs to the context
+        session.ticket = NULL;
+#endif
+        mbedtls_ssl_session_free(&session);
+        return ret == MBEDTLS_ERR_SSL_ALLOC_FAILED ? NSAPI_ERROR_NO_MEMORY : NSAPI_ERROR_PARAMETER;
+    }
+
+    bool resumable = session.id_len > 0;
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+    resumable = resumable || session.ticket_len > 0;
+#endif
+    if (!resumable) {
+        // Nothing the server could resume the session with
+        mbedtls_ssl_session_free(&session);
+        remove(hostname);
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    _mutex.lock();
+    entry_t *entry = find(hostname);
+    if (!entry) {
+        entry = allocate(hostname);
+    }
+    if (!entry) {
+        _mutex.unlock();
+        mbedtls_ssl_session_free(&session);
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    mbedtls_ssl_session_free(&entry->session);
+    entry->session = session;
+    entry->last_use = ++_use_counter;
+    save(entry);
+    _mutex.unlock();
+
+    return NSAPI_ERROR_OK;
+}
+
+void TLSSessionCache::remove(const char *hostname)
+{
+    if (!hostname) {
+        return;
+    }
+
+    _mutex.lock();
+    entry_t *entry = find(hostname);
+    if (entry) {
+        release(entry);
+    }
+    if (_kvstore) {
+        char key[16];
+        make_key(hostname, key);
+        _kvstore->remove(key);
+    }
+    _mutex.unlock();
+}
+
+void TLSSessionCache::clear()
+{
+    _mutex.lock();
+    for (unsigned i = 0; i < _size; i++) {
+        release(&_entries[i]);
+    }
+    _mutex.unlock();
+}
+
+TLSSessionCache::entry_t *TLSSessionCache::find(const char *hostname)
+{
+    for (unsigned i = 0; i < _size; i++) {
+        if (_entries[i].hostname && strcmp(_entries[i].hostname, hostname) == 0) {
+            return &_entries[i];
+        }
+    }
+    return NULL;
+}
+
+TLSSessionCache::entry_t *TLSSessionCache::allocate(const char *hostname)
+{
+    if (!_size) {
+        return NULL;
+    }
+
+    // Reuse a free entry, or the least recently used one
+    entry_t *entry = &_entries[0];
+    for (unsigned i = 0; i < _size && entry->hostname; i++) {
+        if (!_entries[i].hostname || _entries[i].last_use < entry->last_use) {
+            entry = &_entries[i];
+        }
+    }
+    release(entry);
+
+    size_t len = strlen(hostname) + 1;
+    entry->hostname = new (std::nothrow) char[len];
+    if (!entry->hostname) {
+        return NULL;
+    }
+    memcpy(entry->hostname, hostname, len);
+    return entry;
+}
+
+void TLSSessionCache::release(entry_t *entry)
+{
+    delete[] entry->hostname;
+    entry->hostname = NULL;
+    mbedtls_ssl_session_free(&entry->session);
+    entry->last_use = 0;
+}
+
+void TLSSessionCache::make_key(const char *hostname, char *key)
+{
+    // FNV-1a hash of the hostname, which is also saved in the record to
+    // tell colliding hosts apart
+    uint32_t hash = 2166136261UL;
+    for (const char *c = hostname; *c; c++) {
+        hash = (hash ^ (uint8_t) *c) * 16777619UL;
+    }
+    snprintf(key, 16, "tlss_%08lx", (unsigned long) hash);
+}
+
+/*
+ * Record saved in a KVStore, in the layout of the session tickets of
+ * Mbed TLS (ssl_ticket.c), prefixed by the hostname:
+ *
+ *  version (1 byte), hostname length (1 byte), hostname
+ *  session structure, with its pointers cleared
+ *  peer certificate length (3 bytes), peer certificate DER
+ *  ticket length (3 bytes), ticket
+ */
+void TLSSessionCache::save(const entry_t *entry)
+{
+    if (!_kvstore) {
+        return;
+    }
+
+    size_t hostname_len = strlen(entry->hostname);
+    size_t cert_len = 0;
+    size_t ticket_len = 0;
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+    if (entry->session.peer_cert) {
+        cert_len = entry->session.peer_cert->raw.len;
+    }
+#endif
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+    if (entry->session.ticket) {
+        ticket_len = entry->session.ticket_len;
+    }
+#endif
+    if (hostname_len > 0xFF || cert_len > 0xFFFFFF || ticket_len > 0xFFFFFF) {
+        return;
+    }
+
+    size_t size = 2 + hostname_len + sizeof(mbedtls_ssl_session) + 3 + cert_len + 3 + ticket_len;
+    uint8_t *record = new (std::nothrow) uint8_t[size];
+    if (!record) {
+        tr_warn("No memory to save session with %s", entry->hostname);
+        return;
+    }
+
+    uint8_t *p = record;
+    *p++ = TLS_SESSION_RECORD_VERSION;
+    *p++ = hostname_len;
+    memcpy(p, entry->hostname, hostname_len);
+    p += hostname_len;
+
+    mbedtls_ssl_session session = entry->session;
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+    session.peer_cert = NULL;
+#endif
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+    session.ticket = NULL;
+#endif
+    memcpy(p, &session, sizeof(session));
+    p += sizeof(session);
+
+    *p++ = cert_len >> 16;
+    *p++ = cert_len >> 8;
+    *p++ = cert_len;
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+    if (cert_len) {
+        memcpy(p, entry->session.peer_cert->raw.p, cert_len);
+        p += cert_len;
+    }
+#endif
+
+    *p++ = ticket_len >> 16;
+    *p++ = ticket_len >> 8;
+    *p++ = ticket_len;
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+    if (ticket_len) {
+        memcpy(p, entry->session.ticket, ticket_len);
+        p += ticket_len;
+    }
+#endif
+
+    char key[16];
+    make_key(entry->hostname, key);
+    int ret = _kvstore->set(key, record, size, KVStore::REQUIRE_CONFIDENTIALITY_FLAG);
+    if (ret != 0) {
+        tr_warn("Failed to save session with %s: %d", entry->hostname, ret);
+    }
+    delete[] record;
+}
+
+TLSSessionCache::entry_t *TLSSessionCache::load(const char *hostname)
+{
+    if (!_kvstore) {
+        return NULL;
+    }
+
+    char key[16];
+    make_key(hostname, key);
+    KVStore::info_t info;
+    if (_kvstore->get_info(key, &info) != 0) {
+        return NULL;
+    }
+
+    size_t hostname_len = strlen(hostname);
+    size_t min_size = 2 + hostname_len + sizeof(mbedtls_ssl_session) + 3 + 3;
+    if (info.size < min_size) {
+        return NULL;
+    }
+
+    uint8_t *record = new (std::nothrow) uint8_t[info.size];
+    if (!record) {
+        return NULL;
+    }
+
+    entry_t *entry = NULL;
+    const uint8_t *p = record;
+    const uint8_t *end = record + info.size;
+    size_t cert_len;
+    size_t ticket_len;
+    mbedtls_ssl_session session;
+    mbedtls_ssl_session_init(&session);
+
+    size_t actual_size;
+    if (_kvstore->get(key, record, info.size, &actual_size) != 0 || actual_size != info.size) {
+        goto done;
+    }
+
+    if (p[0] != TLS_SESSION_RECORD_VERSION || p[1] != hostname_len
+            || memcmp(p + 2, hostname, hostname_len) != 0) {
+        // Another version, or another host with the same hash
+        goto done;
+    }
+    p += 2 + hostname_len;
+
+    memcpy(&session, p, sizeof(session));
+    p += sizeof(session);
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+    session.peer_cert = NULL;
+#endif
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+    session.ticket = NULL;
+    session.ticket_len = 0;
+#endif
+
+    cert_len = (p[0] << 16) | (p[1] << 8) | p[2];
+    p += 3;
+    if ((size_t)(end - p) < cert_len + 3) {
+        goto done;
+    }
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+    if (cert_len) {
+        session.peer_cert = (mbedtls_x509_crt *) mbedtls_calloc(1, sizeof(mbedtls_x509_crt));
+        if (!session.peer_cert) {
+            goto done;
+        }
+        mbedtls_x509_crt_init(session.peer_cert);
+        if (mbedtls_x509_crt_parse_der(session.peer_cert, p, cert_len) != 0) {
+            goto done;
+        }
+    }
+#else
+    if (cert_len) {
+        goto done;
+    }
+#endif
+    p += cert_len;
+
+    ticket_len = (p[0] << 16) | (p[1] << 8) | p[2];
+    p += 3;
+    if ((size_t)(end - p) != ticket_len) {
+        goto done;
+    }
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+    if (ticket_len) {
+        session.ticket = (unsigned char *) mbedtls_calloc(1, ticket_len);
+        if (!session.ticket) {
+            goto done;
+        }
+        memcpy(session.ticket, p, ticket_len);
+        session.ticket_len = ticket_len;
+    }
+#else
+    if (ticket_len) {
+        goto done;
+    }
+#endif
+
+    entry = allocate(hostname);
+    if (entry) {
+        entry->session = session;
+        mbedtls_ssl_session_init(&session);
+    }
+
+done:
+    mbedtls_ssl_session_free(&session);
+    delete[] record;
+    if (!entry) {
+        tr_debug("No saved session with %s", hostname);
+    }
+    return entry;
+}
+
+#endif // MBEDTLS_SSL_CLI_C
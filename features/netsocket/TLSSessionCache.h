@@ -0,0 +1,138 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file TLSSessionCache.h TLSSessionCache class */
+/** \addtogroup netsocket
+ * @{*/
+
+#ifndef TLSSESSIONCACHE_H
+#define TLSSESSIONCACHE_H
+
+#include "nsapi_types.h"
+#include "platform/PlatformMutex.h"
+#include "platform/NonCopyable.h"
+#include "mbedtls/ssl.h"
+
+// This class requires Mbed TLS SSL/TLS client code
+#if defined(MBEDTLS_SSL_CLI_C) || defined(DOXYGEN_ONLY)
+
+namespace mbed {
+class KVStore;
+}
+
+/** Cache of TLS client sessions, shared by TLSSocketWrapper instances.
+ *
+ *  Sessions are stored by hostname after each full handshake, and offered
+ *  to the server on the next connection to the same host, which then uses
+ *  the abbreviated handshake if it still knows the session ID or accepts
+ *  the session ticket (RFC 5077). A session the server refuses is replaced
+ *  by the new one after the full handshake.
+ *
+ *  The least recently used session is dropped when the cache is full.
+ *  Sessions can also be saved in a KVStore, to resume them after a reset.
+ *
+ *  @code
+ *  TLSSocket socket;
+ *  socket.set_session_cache(TLSSessionCache::get_default_instance());
+ *  socket.set_hostname("example.com");
+ *  @endcode
+ */
+class TLSSessionCache : private mbed::NonCopyable<TLSSessionCache> {
+public:
+    /** Create a cache.
+     *
+     *  @param size     Maximum number of sessions held in RAM.
+     */
+    TLSSessionCache(unsigned size);
+
+    /** Destroy the cache, freeing its sessions.
+     */
+    ~TLSSessionCache();
+
+    /** Get the cache used by default by TLSSocketWrapper.
+     *
+     *  Its size is set by the nsapi.tls-session-cache-size option.
+     *
+     *  @return         Default cache, or NULL if the option is 0.
+     */
+    static TLSSessionCache *get_default_instance();
+
+    /** Save the sessions in a KVStore.
+     *
+     *  Sessions missing from RAM are then looked up in the store, and new
+     *  sessions are written to it.
+     *
+     *  @note A session holds the master secret of its connections. Use a
+     *        store providing confidentiality, like SecureStore.
+     *
+     *  @param kvstore  Store to use, or NULL to keep sessions in RAM only.
+     */
+    void set_kvstore(mbed::KVStore *kvstore);
+
+    /** Offer the cached session of a host for the next handshake.
+     *
+     *  @param hostname Hostname of the remote host.
+     *  @param ssl      SSL context, set up but before the handshake.
+     *  @return         True if a session was set to be resumed.
+     */
+    bool apply(const char *hostname, mbedtls_ssl_context *ssl);
+
+    /** Store the session of a completed handshake.
+     *
+     *  @param hostname Hostname of the remote host.
+     *  @param ssl      SSL context, after the handshake.
+     *  @return         NSAPI_ERROR_OK on success, NSAPI_ERROR_PARAMETER if
+     *                  the context has no session, NSAPI_ERROR_NO_MEMORY if
+     *                  out of memory.
+     */
+    nsapi_error_t store(const char *hostname, const mbedtls_ssl_context *ssl);
+
+    /** Forget the session of a host.
+     *
+     *  @param hostname Hostname of the remote host.
+     */
+    void remove(const char *hostname);
+
+    /** Forget all the sessions held in RAM.
+     */
+    void clear();
+
+private:
+    struct entry_t {
+        char *hostname;
+        mbedtls_ssl_session session;
+        uint32_t last_use;
+    };
+
+    entry_t *find(const char *hostname);
+    entry_t *allocate(const char *hostname);
+    void release(entry_t *entry);
+    void make_key(const char *hostname, char *key);
+    void save(const entry_t *entry);
+    entry_t *load(const char *hostname);
+
+    entry_t *_entries;
+    unsigned _size;
+    uint32_t _use_counter;
+    mbed::KVStore *_kvstore;
+    PlatformMutex _mutex;
+};
+
+#endif // MBEDTLS_SSL_CLI_C
+
+#endif // TLSSESSIONCACHE_H
+
+/** @}*/
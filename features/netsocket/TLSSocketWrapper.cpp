@@ -30,6 +30,9 @@
 // This class requires Mbed TLS SSL/TLS client code
 #if defined(MBEDTLS_SSL_CLI_C)
 
+// Address and port of the peer, the key of a session without hostname
+#define TLS_SESSION_KEY_SIZE (NSAPI_IP_SIZE + 6)
+
 TLSSocketWrapper::TLSSocketWrapper(Socket *transport, const char *hostname, control_transport control) :
     _transport(transport),
     _timeout(-1),
@@ -38,6 +41,7 @@ TLSSocketWrapper::TLSSocketWrapper(Socket *transport, const char *hostname, cont
     _clicert(NULL),
 #endif
     _ssl_conf(NULL),
+    _session_cache(TLSSessionCache::get_default_instance()),
     _connect_transport(control == TRANSPORT_CONNECT || control == TRANSPORT_CONNECT_AND_CLOSE),
     _close_transport(control == TRANSPORT_CLOSE || control == TRANSPORT_CONNECT_AND_CLOSE),
     _tls_initialized(false),
@@ -90,6 +94,46 @@ void TLSSocketWrapper::set_hostname(const char *hostname)
 #endif
 }
 
+void TLSSocketWrapper::set_session_cache(TLSSessionCache *cache)
+{
+    _session_cache = cache;
+}
+
+nsapi_error_t TLSSocketWrapper::set_max_fragment_length(size_t length)
+{
+#if !defined(MBEDTLS_SSL_MAX_FRAGMENT_LENGTH)
+    return NSAPI_ERROR_UNSUPPORTED;
+#else
+    unsigned char mfl_code;
+    switch (length) {
+        case 0:
+            mfl_code = MBEDTLS_SSL_MAX_FRAG_LEN_NONE;
+            break;
+        case 512:
+            mfl_code = MBEDTLS_SSL_MAX_FRAG_LEN_512;
+            break;
+        case 1024:
+            mfl_code = MBEDTLS_SSL_MAX_FRAG_LEN_1024;
+            break;
+        case 2048:
+            mfl_code = MBEDTLS_SSL_MAX_FRAG_LEN_2048;
+            break;
+        case 4096:
+            mfl_code = MBEDTLS_SSL_MAX_FRAG_LEN_4096;
+            break;
+        default:
+            return NSAPI_ERROR_PARAMETER;
+    }
+
+    int ret = mbedtls_ssl_conf_max_frag_len(get_ssl_config(), mfl_code);
+    if (ret != 0) {
+        print_mbedtls_error("mbedtls_ssl_conf_max_frag_len", ret);
+        return NSAPI_ERROR_PARAMETER;
+    }
+    return NSAPI_ERROR_OK;
+#endif
+}
+
 nsapi_error_t TLSSocketWrapper::set_root_ca_cert(const void *root_ca, size_t len)
 {
 #if !defined(MBEDTLS_X509_CRT_PARSE_C)
@@ -199,6 +243,11 @@ nsapi_error_t TLSSocketWrapper::start_handshake(bool first_call)
         return NSAPI_ERROR_AUTH_FAILURE;
     }
 
+    if (_session_cache) {
+        char key_buf[TLS_SESSION_KEY_SIZE];
+        _session_cache->apply(session_key(key_buf), &_ssl);
+    }
+
     _transport->set_blocking(false);
     _transport->sigio(mbed::callback(this, &TLSSocketWrapper::event));
     mbedtls_ssl_set_bio(&_ssl, this, ssl_send, ssl_recv, NULL);
@@ -217,6 +266,21 @@ nsapi_error_t TLSSocketWrapper::start_handshake(bool first_call)
     return ret;
 }
 
+const char *TLSSocketWrapper::session_key(char *buf)
+{
+#ifdef MBEDTLS_X509_CRT_PARSE_C
+    if (_ssl.hostname) {
+        return _ssl.hostname;
+    }
+#endif
+    SocketAddress address;
+    if (_transport->getpeername(&address) != NSAPI_ERROR_OK || !address) {
+        return NULL;
+    }
+    snprintf(buf, TLS_SESSION_KEY_SIZE, "%s:%u", address.get_ip_address(), address.get_port());
+    return buf;
+}
+
 nsapi_error_t TLSSocketWrapper::continue_handshake()
 {
     int ret;
@@ -247,6 +311,11 @@ nsapi_error_t TLSSocketWrapper::continue_handshake()
         if (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE) {
             return NSAPI_ERROR_ALREADY;
         } else {
+            if (_session_cache) {
+                // Don't offer the session again if it caused the failure
+                char key_buf[TLS_SESSION_KEY_SIZE];
+                _session_cache->remove(session_key(key_buf));
+            }
             return NSAPI_ERROR_AUTH_FAILURE;
         }
     }
@@ -258,6 +327,7 @@ nsapi_error_t TLSSocketWrapper::continue_handshake()
     tr_info("TLS connection established");
 #endif
 
+    bool verified = true;
 #ifdef MBEDTLS_X509_CRT_PARSE_C
     /* Prints the server certificate and verify it. */
     const size_t buf_size = 1024;
@@ -276,8 +346,20 @@ nsapi_error_t TLSSocketWrapper::continue_handshake()
         tr_info("Certificate verification passed");
     }
     delete[] buf;
+    verified = flags == 0;
 #endif
 
+    if (_session_cache) {
+        char key_buf[TLS_SESSION_KEY_SIZE];
+        const char *key = session_key(key_buf);
+        if (verified) {
+            // Also updates the ticket the server may have renewed
+            _session_cache->store(key, &_ssl);
+        } else {
+            _session_cache->remove(key);
+        }
+    }
+
     _handshake_completed = true;
     return NSAPI_ERROR_IS_CONNECTED;
 }
@@ -558,6 +640,9 @@ mbedtls_ssl_config *TLSSocketWrapper::get_ssl_config()
          * MBEDTLS_SSL_VERIFY_NONE in the call to mbedtls_ssl_conf_authmode()
          */
         mbedtls_ssl_conf_authmode(get_ssl_config(), MBEDTLS_SSL_VERIFY_REQUIRED);
+#if defined(MBEDTLS_SSL_MAX_FRAGMENT_LENGTH) && MBED_CONF_NSAPI_TLS_MAX_FRAGMENT_LENGTH
+        set_max_fragment_length(MBED_CONF_NSAPI_TLS_MAX_FRAGMENT_LENGTH);
+#endif
     }
     return _ssl_conf;
 }
@@ -602,6 +687,11 @@ nsapi_error_t TLSSocketWrapper::close()
         }
     }
 
+    // The wrapper can't be reopened, so release the record buffers now
+    // instead of holding them until it is destroyed
+    mbedtls_ssl_free(&_ssl);
+    mbedtls_ssl_init(&_ssl);
+
     _transport = NULL;
 
     return ret;
@@ -23,6 +23,7 @@
 #define _MBED_HTTPS_TLS_SOCKET_WRAPPER_H_
 
 #include "netsocket/Socket.h"
+#include "netsocket/TLSSessionCache.h"
 #include "rtos/EventFlags.h"
 #include "platform/Callback.h"
 #include "mbedtls/platform.h"
@@ -75,6 +76,40 @@ public:
      */
     void set_hostname(const char *hostname);
 
+    /** Set the cache of TLS sessions.
+     *
+     * Sessions of the cache are offered to the server, so that reconnects to
+     * a host use the abbreviated handshake. The cache is given by
+     * TLSSessionCache::get_default_instance() by default.
+     *
+     * @note Must be called before calling connect(). Sessions are cached by
+     *       hostname, or by the address of the peer if no hostname is set,
+     *       so that PSK connections, e.g. DTLS to a CoAP server, are
+     *       resumed too.
+     *
+     * @param cache        Cache to use, or NULL to always do a full handshake.
+     */
+    void set_session_cache(TLSSessionCache *cache);
+
+    /** Set the maximum length of the records.
+     *
+     * The length is negotiated with the server (RFC 6066), so that records
+     * in both directions fit in buffers smaller than 16 KB. It is set by
+     * the nsapi.tls-max-fragment-length option by default. The record
+     * buffers themselves are sized by MBEDTLS_SSL_IN_CONTENT_LEN and
+     * MBEDTLS_SSL_OUT_CONTENT_LEN, which can then be reduced to this length.
+     *
+     * @note Must be called before calling connect(). Servers ignoring the
+     *       extension may still send 16 KB records.
+     *
+     * @param length       512, 1024, 2048 or 4096, or 0 to not negotiate it.
+     * @retval NSAPI_ERROR_OK          on success.
+     * @retval NSAPI_ERROR_PARAMETER   if the length is not supported.
+     * @retval NSAPI_ERROR_UNSUPPORTED if Mbed TLS is built without
+     *                                 MBEDTLS_SSL_MAX_FRAGMENT_LENGTH.
+     */
+    nsapi_error_t set_max_fragment_length(size_t length);
+
     /** Sets the certification of Root CA.
      *
      * @note Must be called before calling connect()
@@ -231,6 +266,13 @@ protected:
 private:
     /** Continue already initialized handshake */
     nsapi_error_t continue_handshake();
+    /** Get the key of the session in the session cache: the hostname, or
+     *  the address of the peer without hostname, as with PSK.
+     *
+     *  @param buf      Buffer for the address, of TLS_SESSION_KEY_SIZE bytes
+     *  @return         Key, or NULL if none is known
+     */
+    const char *session_key(char *buf);
     /**
      * Helper for pretty-printing Mbed TLS error codes
      */
@@ -279,6 +321,7 @@ private:
     mbedtls_x509_crt *_clicert;
 #endif
     mbedtls_ssl_config *_ssl_conf;
+    TLSSessionCache *_session_cache;
 
     bool _connect_transport: 1;
     bool _close_transport: 1;
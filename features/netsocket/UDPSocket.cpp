@@ -79,11 +79,7 @@ nsapi_size_or_error_t UDPSocket::sendto(const SocketAddress &address, const void
         } else {
             uint32_t flag;
 
-            // Release lock before blocking so other threads
-            // accessing this object aren't blocked
-            _lock.unlock();
-            flag = _event_flag.wait_any(WRITE_FLAG, _timeout);
-            _lock.lock();
+            flag = wait_writable();
 
             if (flag & osFlagsError) {
                 // Timeout break
@@ -175,6 +171,224 @@ nsapi_size_or_error_t UDPSocket::recv(void *buffer, nsapi_size_t size)
     return recvfrom(NULL, buffer, size);
 }
 
+nsapi_size_or_error_t UDPSocket::sendmsg(const SocketAddress *address, const nsapi_iovec_t *iov, unsigned iovcnt)
+{
+    if (!address) {
+        if (!_remote_peer) {
+            return NSAPI_ERROR_NO_ADDRESS;
+        }
+        address = &_remote_peer;
+    }
+
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+
+    _writers++;
+    if (_socket) {
+        _socket_stats.stats_update_socket_state(this, SOCK_OPEN);
+        _socket_stats.stats_update_peer(this, *address);
+    }
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        core_util_atomic_flag_clear(&_pending);
+        nsapi_size_or_error_t sent = _stack->socket_sendmsg(_socket, address, iov, iovcnt);
+        if ((0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != sent)) {
+            _socket_stats.stats_update_sent_bytes(this, sent);
+            ret = sent;
+            break;
+        } else {
+            uint32_t flag;
+
+            flag = wait_writable();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _writers--;
+    if (!_socket || !_writers) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+    _lock.unlock();
+    return ret;
+}
+
+nsapi_size_or_error_t UDPSocket::recvmsg(SocketAddress *address, nsapi_iovec_t *iov, unsigned iovcnt)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+    SocketAddress ignored;
+
+    if (!address) {
+        address = &ignored;
+    }
+
+    _readers++;
+
+    if (_socket) {
+        _socket_stats.stats_update_socket_state(this, SOCK_OPEN);
+    }
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        core_util_atomic_flag_clear(&_pending);
+        nsapi_size_or_error_t recv = _stack->socket_recvmsg(_socket, address, iov, iovcnt);
+
+        // Filter incomming packets using connected peer address
+        if (recv >= 0 && _remote_peer && _remote_peer != *address) {
+            continue;
+        }
+
+        _socket_stats.stats_update_peer(this, _remote_peer);
+        // Non-blocking sockets always return. Blocking only returns when success or errors other than WOULD_BLOCK
+        if ((0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != recv)) {
+            ret = recv;
+            _socket_stats.stats_update_recv_bytes(this, recv);
+            break;
+        } else {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            flag = _event_flag.wait_any(READ_FLAG, _timeout);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _readers--;
+    if (!_socket || !_readers) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
+nsapi_size_or_error_t UDPSocket::sendto_batch(datagram_t *datagrams, unsigned count)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret = NSAPI_ERROR_OK;
+    unsigned sent = 0;
+
+    _writers++;
+    if (_socket) {
+        _socket_stats.stats_update_socket_state(this, SOCK_OPEN);
+    }
+    while (sent < count) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        datagram_t *datagram = &datagrams[sent];
+        core_util_atomic_flag_clear(&_pending);
+        ret = _stack->socket_sendto(_socket, datagram->address, datagram->data, datagram->size);
+        if (ret >= 0) {
+            _socket_stats.stats_update_peer(this, datagram->address);
+            _socket_stats.stats_update_sent_bytes(this, ret);
+            datagram->length = ret;
+            sent++;
+        } else if ((0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != ret)) {
+            break;
+        } else {
+            uint32_t flag;
+
+            flag = wait_writable();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _writers--;
+    if (!_socket || !_writers) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+    _lock.unlock();
+    return (sent || !count) ? (nsapi_size_or_error_t)sent : ret;
+}
+
+nsapi_size_or_error_t UDPSocket::recvfrom_batch(datagram_t *datagrams, unsigned count)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret = NSAPI_ERROR_OK;
+    unsigned received = 0;
+
+    _readers++;
+
+    if (_socket) {
+        _socket_stats.stats_update_socket_state(this, SOCK_OPEN);
+    }
+    while (received < count) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        datagram_t *datagram = &datagrams[received];
+        core_util_atomic_flag_clear(&_pending);
+        ret = _stack->socket_recvfrom(_socket, &datagram->address, datagram->data, datagram->size);
+
+        // Filter incomming packets using connected peer address
+        if (ret >= 0 && _remote_peer && _remote_peer != datagram->address) {
+            continue;
+        }
+
+        if (ret >= 0) {
+            _socket_stats.stats_update_recv_bytes(this, ret);
+            datagram->length = ret;
+            received++;
+        } else if (received || (0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != ret)) {
+            // Only wait for the first datagram
+            break;
+        } else {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            flag = _event_flag.wait_any(READ_FLAG, _timeout);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+    _socket_stats.stats_update_peer(this, _remote_peer);
+
+    _readers--;
+    if (!_socket || !_readers) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+
+    _lock.unlock();
+    return (received || !count) ? (nsapi_size_or_error_t)received : ret;
+}
+
 Socket *UDPSocket::accept(nsapi_error_t *error)
 {
     if (error) {
@@ -30,6 +30,15 @@
  */
 class UDPSocket : public InternetSocket {
 public:
+    /** Datagram of a batched send or receive
+     */
+    struct datagram_t {
+        SocketAddress address;  /**< Destination, or source of a received datagram */
+        void *data;             /**< Buffer of the datagram */
+        nsapi_size_t size;      /**< Size of the buffer in bytes */
+        nsapi_size_t length;    /**< Number of bytes sent or received */
+    };
+
     /** Create an uninitialized socket.
      *
      *  @note Must call open to initialize the socket on a network stack.
@@ -156,6 +165,75 @@ public:
      */
     virtual nsapi_size_or_error_t recv(void *data, nsapi_size_t size);
 
+    /** Send a datagram gathered from several buffers.
+     *
+     *  The buffers are sent as a single datagram to the address, or to the
+     *  connected remote address if address is NULL.
+     *
+     *  By default, sendmsg blocks until data is sent. If socket is set to
+     *  nonblocking or times out, NSAPI_ERROR_WOULD_BLOCK is returned
+     *  immediately.
+     *
+     *  @param address  The SocketAddress of the remote host or NULL.
+     *  @param iov      Array of the buffers of data to send to the host.
+     *  @param iovcnt   Number of buffers in the array.
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure.
+     */
+    virtual nsapi_size_or_error_t sendmsg(const SocketAddress *address,
+                                          const nsapi_iovec_t *iov, unsigned iovcnt);
+
+    /** Receive a datagram scattered into several buffers.
+     *
+     *  Same as recvfrom(), filling the buffers in order.
+     *
+     *  @note If the datagram is larger than the buffers, the excess data is silently discarded.
+     *
+     *  @param address  Destination for the source address or NULL.
+     *  @param iov      Array of the destination buffers.
+     *  @param iovcnt   Number of buffers in the array.
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure.
+     */
+    virtual nsapi_size_or_error_t recvmsg(SocketAddress *address,
+                                          nsapi_iovec_t *iov, unsigned iovcnt);
+
+    /** Send several datagrams.
+     *
+     *  Sends each datagram to its address, holding the socket for the
+     *  whole batch instead of for each datagram. The length of each sent
+     *  datagram is set.
+     *
+     *  By default, sendto_batch blocks until all datagrams are sent. If
+     *  socket is set to nonblocking or times out, fewer datagrams can be
+     *  sent. NSAPI_ERROR_WOULD_BLOCK is returned if none was sent.
+     *
+     *  @param datagrams    Array of the datagrams to send.
+     *  @param count        Number of datagrams in the array.
+     *  @return             Number of sent datagrams on success, negative
+     *                      error code on failure.
+     */
+    nsapi_size_or_error_t sendto_batch(datagram_t *datagrams, unsigned count);
+
+    /** Receive several datagrams.
+     *
+     *  Receives the datagrams already queued, up to count of them, into the
+     *  buffers of the array, storing their lengths and source addresses.
+     *  Only the wait for the first datagram can block, so a burst of
+     *  datagrams is drained in a single call.
+     *
+     *  @note If a datagram is larger than its buffer, the excess data is silently discarded.
+     *
+     *  @note If socket is connected, only packets coming from connected peer address
+     *  are accepted.
+     *
+     *  @param datagrams    Array of the datagrams to receive.
+     *  @param count        Number of datagrams in the array.
+     *  @return             Number of received datagrams on success, negative
+     *                      error code on failure.
+     */
+    nsapi_size_or_error_t recvfrom_batch(datagram_t *datagrams, unsigned count);
+
     /** Not implemented for UDP.
      *
      *  @param error      Not used.
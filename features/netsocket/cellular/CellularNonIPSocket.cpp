@@ -170,6 +170,11 @@ nsapi_size_or_error_t CellularNonIPSocket::recv(void *buffer, nsapi_size_t size)
         }
     }
 
+    // The netif may hold on to the buffer to receive the next data to it
+    if (_opened && ret == NSAPI_ERROR_WOULD_BLOCK) {
+        _cp_netif->recv_cancel(buffer);
+    }
+
     _readers--;
     if (!_opened || !_readers) {
         _event_flag.set(FINISHED_FLAG);
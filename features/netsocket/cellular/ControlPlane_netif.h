@@ -66,6 +66,17 @@ protected:
     */
     virtual nsapi_size_or_error_t recv(void *cpdata, nsapi_size_t cpdata_length) = 0;
 
+    /** Stop receiving to a buffer given to recv()
+    *
+    *  An implementation may keep the buffer given to a recv() that returned
+    *  NSAPI_ERROR_WOULD_BLOCK, and receive the next data straight to it. The
+    *  caller returns it with this function when it stops waiting for the data,
+    *  the buffer is not written after that.
+    *
+    *  @param cpdata            Buffer given to recv()
+    */
+    virtual void recv_cancel(void *cpdata) {}
+
     /** Receives data from the control plane PDP context
     *
     *  This function is called by cellular PDP context when data
@@ -150,6 +150,10 @@ void Kinetis_EMAC::tx_reclaim()
  */
 void Kinetis_EMAC::rx_isr()
 {
+#if MBED_CONF_NSAPI_EMAC_RX_POLL_BUDGET
+    /* The thread polls the ring until it is empty */
+    ENET_DisableInterrupts(ENET, kENET_RxFrameInterrupt);
+#endif
     if (thread) {
         osThreadFlagsSet(thread, FLAG_RX);
     }
@@ -242,8 +246,10 @@ bool Kinetis_EMAC::low_level_init_successful()
     config.interrupt = kENET_RxFrameInterrupt | kENET_TxFrameInterrupt;
     config.rxMaxFrameLen = ENET_ETH_MAX_FLEN;
     config.macSpecialConfig = kENET_ControlFlowControlEnable;
-    config.txAccelerConfig = 0;
-    config.rxAccelerConfig = kENET_RxAccelMacCheckEnabled;
+    /* Insert IP and protocol checksums, and drop frames with bad ones */
+    config.txAccelerConfig = kENET_TxAccelIpCheckEnabled | kENET_TxAccelProtoCheckEnabled;
+    config.rxAccelerConfig = kENET_RxAccelMacCheckEnabled | kENET_RxAccelIpCheckEnabled |
+                             kENET_RxAccelProtoCheckEnabled;
     ENET_Init(ENET, &g_handle, &config, &buffCfg, hwaddr, sysClock);
 
 #if defined(TOOLCHAIN_ARM)
@@ -368,11 +374,39 @@ void Kinetis_EMAC::thread_function(void* pvParameters)
 void Kinetis_EMAC::packet_rx()
 {
     static int idx = 0;
+#if MBED_CONF_NSAPI_EMAC_RX_POLL_BUDGET
+    int budget = MBED_CONF_NSAPI_EMAC_RX_POLL_BUDGET;
+    bool polling = true;
+
+    for (;;) {
+        if (g_handle.rxBdCurrent->control & ENET_BUFFDESCRIPTOR_RX_EMPTY_MASK) {
+            if (!polling) {
+                return;
+            }
+            /* Back to interrupts, checking the ring once more for a frame
+             * received before they were unmasked */
+            ENET_ClearInterruptStatus(ENET, kENET_RxFrameInterrupt);
+            ENET_EnableInterrupts(ENET, kENET_RxFrameInterrupt);
+            polling = false;
+            continue;
+        }
 
+        if (budget-- == 0) {
+            /* Keep polling after the other threads */
+            osThreadFlagsSet(thread, FLAG_RX);
+            osThreadYield();
+            return;
+        }
+
+        input(idx);
+        idx = (idx + 1) % ENET_RX_RING_LEN;
+    }
+#else
     while ((g_handle.rxBdCurrent->control & ENET_BUFFDESCRIPTOR_RX_EMPTY_MASK) == 0) {
         input(idx);
         idx = (idx + 1) % ENET_RX_RING_LEN;
     }
+#endif
 }
 
 /** \brief  Transmit cleanup task
@@ -522,6 +556,13 @@ uint32_t Kinetis_EMAC::get_mtu_size() const
     return KINETIS_ETH_MTU_SIZE;
 }
 
+uint32_t Kinetis_EMAC::get_checksum_offload() const
+{
+    /* ICMPv6 isn't one of the protocols the ENET knows */
+    return TX_CHECKSUM_IP | TX_CHECKSUM_UDP | TX_CHECKSUM_TCP | TX_CHECKSUM_ICMP |
+           RX_CHECKSUM_IP | RX_CHECKSUM_UDP | RX_CHECKSUM_TCP | RX_CHECKSUM_ICMP;
+}
+
 uint32_t Kinetis_EMAC::get_align_preference() const
 {
     return ENET_BUFF_ALIGNMENT;
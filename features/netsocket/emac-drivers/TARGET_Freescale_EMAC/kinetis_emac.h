@@ -136,6 +136,12 @@ public:
      */
     virtual void set_memory_manager(EMACMemoryManager &mem_mngr);
 
+    /** Return the checksums handled by the hardware
+     *
+     * @return     Bitmask of checksum_offload_t flags
+     */
+    virtual uint32_t get_checksum_offload() const;
+
 private:
     bool low_level_init_successful();
     void rx_isr();
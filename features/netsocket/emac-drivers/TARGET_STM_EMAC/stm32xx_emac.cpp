@@ -68,6 +68,10 @@ void ETH_IRQHandler(void);
 void HAL_ETH_RxCpltCallback(ETH_HandleTypeDef *heth)
 {
     STM32_EMAC &emac = STM32_EMAC::get_instance();
+#if MBED_CONF_NSAPI_EMAC_RX_POLL_BUDGET
+    /* The thread polls the descriptors until they are empty */
+    __HAL_ETH_DMA_DISABLE_IT(heth, ETH_DMA_IT_R);
+#endif
     if (emac.thread) {
         osThreadFlagsSet(emac.thread, FLAG_RX);
     }
@@ -126,7 +130,7 @@ bool STM32_EMAC::low_level_init_successful()
 #endif
     EthHandle.Init.MACAddr = &MACAddr[0];
     EthHandle.Init.RxMode = ETH_RXINTERRUPT_MODE;
-    EthHandle.Init.ChecksumMode = ETH_CHECKSUM_BY_SOFTWARE;
+    EthHandle.Init.ChecksumMode = ETH_CHECKSUM_BY_HARDWARE;
     EthHandle.Init.MediaInterface = ETH_MEDIA_INTERFACE_RMII;
     HAL_ETH_Init(&EthHandle);
 
@@ -327,15 +331,38 @@ int STM32_EMAC::low_level_input(emac_mem_buf_t **buf)
  */
 void STM32_EMAC::packet_rx()
 {
+#if MBED_CONF_NSAPI_EMAC_RX_POLL_BUDGET
+    int budget = MBED_CONF_NSAPI_EMAC_RX_POLL_BUDGET;
+    bool polling = true;
+#endif
+
     /* move received packet into a new buf */
     while (1) {
         emac_mem_buf_t *p = NULL;
         if (low_level_input(&p) < 0) {
+#if MBED_CONF_NSAPI_EMAC_RX_POLL_BUDGET
+            if (polling) {
+                /* Back to interrupts, checking the descriptors once more
+                 * for a frame received before they were unmasked */
+                __HAL_ETH_DMA_CLEAR_IT(&EthHandle, ETH_DMA_IT_R);
+                __HAL_ETH_DMA_ENABLE_IT(&EthHandle, ETH_DMA_IT_R);
+                polling = false;
+                continue;
+            }
+#endif
             break;
         }
         if (p) {
             emac_link_input_cb(p);
         }
+#if MBED_CONF_NSAPI_EMAC_RX_POLL_BUDGET
+        if (--budget == 0) {
+            /* Keep polling after the other threads */
+            osThreadFlagsSet(thread, FLAG_RX);
+            osThreadYield();
+            return;
+        }
+#endif
     }
 }
 
@@ -505,6 +532,13 @@ uint32_t STM32_EMAC::get_mtu_size() const
     return STM_ETH_MTU_SIZE;
 }
 
+uint32_t STM32_EMAC::get_checksum_offload() const
+{
+    /* The DMA drops frames the MAC flags with a bad IP or payload checksum */
+    return TX_CHECKSUM_IP | TX_CHECKSUM_UDP | TX_CHECKSUM_TCP | TX_CHECKSUM_ICMP |
+           RX_CHECKSUM_IP | RX_CHECKSUM_UDP | RX_CHECKSUM_TCP | RX_CHECKSUM_ICMP;
+}
+
 uint32_t STM32_EMAC::get_align_preference() const
 {
     return 0;
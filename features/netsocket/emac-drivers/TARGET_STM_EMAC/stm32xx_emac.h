@@ -147,6 +147,12 @@ public:
      */
     virtual void set_memory_manager(EMACMemoryManager &mem_mngr);
 
+    /** Return the checksums handled by the hardware
+     *
+     * @return     Bitmask of checksum_offload_t flags
+     */
+    virtual uint32_t get_checksum_offload() const;
+
     // Called from driver functions
     ETH_HandleTypeDef EthHandle;
     osThreadId_t thread; /**< Processing thread */
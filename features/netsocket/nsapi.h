@@ -40,10 +40,13 @@
 #include "netsocket/UDPSocket.h"
 #include "netsocket/TCPSocket.h"
 #include "netsocket/TCPServer.h"
+#include "netsocket/TCPConnectionPool.h"
+#include "netsocket/TLSSessionCache.h"
 #include "netsocket/TLSSocketWrapper.h"
 #include "netsocket/DTLSSocketWrapper.h"
 #include "netsocket/TLSSocket.h"
 #include "netsocket/DTLSSocket.h"
+#include "netsocket/SocketSet.h"
 
 #endif // __cplusplus
 
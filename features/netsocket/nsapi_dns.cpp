@@ -33,8 +33,11 @@
 #define CLASS_IN 1
 
 #define RR_A 1
+#define RR_SOA 6
 #define RR_AAAA 28
 
+#define RCODE_NXDOMAIN 3
+
 // DNS options
 #define DNS_BUFFER_SIZE 512
 #define DNS_SERVERS_SIZE 5
@@ -43,12 +46,17 @@
 #define DNS_QUERY_QUEUE_SIZE 5
 #define DNS_HOST_NAME_MAX_LEN 255
 #define DNS_TIMER_TIMEOUT 100
+// RFC 2308: negative answers should not be cached for more than 3 hours
+#define DNS_NEGATIVE_TTL_MAX 10800
 
 struct DNS_CACHE {
-    nsapi_addr_t address;
-    char *host;
+    nsapi_addr_t address;  /*!< NSAPI_UNSPEC for a negative answer */
+    nsapi_version_t version; /*!< version of the query */
+    uint32_t hash;         /*!< hash of the host name */
     uint64_t expires;      /*!< time to live in milliseconds */
     uint64_t accessed;     /*!< last accessed */
+    bool refreshing;       /*!< refresh query started */
+    char host[MBED_CONF_NSAPI_DNS_CACHE_HOST_MAX_LEN + 1]; /*!< empty if entry is free */
 };
 
 struct SOCKET_CB_DATA {
@@ -78,7 +86,9 @@ struct DNS_QUERY {
     uint32_t total_timeout;
     uint32_t socket_timeout;
     uint16_t dns_message_id;
+    uint16_t dns_message_id_aaaa; /*!< AAAA question of an NSAPI_UNSPEC query, 0 if none pending */
     uint8_t dns_server;
+    uint8_t dns_server_span; /*!< number of servers asked in parallel */
     uint8_t retries;
     uint8_t total_attempts;
     uint8_t send_success;
@@ -86,8 +96,9 @@ struct DNS_QUERY {
     dns_state state;
 };
 
-static void nsapi_dns_cache_add(const char *host, nsapi_addr_t *address, uint32_t ttl);
-static nsapi_size_or_error_t nsapi_dns_cache_find(const char *host, nsapi_version_t version, nsapi_addr_t *address);
+static void nsapi_dns_cache_add(const char *host, nsapi_addr_t *address, uint32_t ttl, nsapi_version_t version);
+static nsapi_error_t nsapi_dns_cache_find(const char *host, nsapi_version_t version, nsapi_addr_t *address, bool *refresh);
+static void nsapi_dns_cache_refresh(NetworkStack *stack, const char *host, nsapi_version_t version, call_in_callback_cb_t call_in_cb);
 
 static nsapi_error_t nsapi_dns_get_server_addr(NetworkStack *stack, uint8_t *index, uint8_t *total_attempts, uint8_t *send_success, SocketAddress *dns_addr);
 
@@ -100,6 +111,9 @@ static void nsapi_dns_query_async_socket_callback(void *ptr);
 static void nsapi_dns_query_async_socket_callback_handle(NetworkStack *stack);
 static void nsapi_dns_query_async_response(void *ptr);
 static void nsapi_dns_query_async_initiate_next(void);
+static nsapi_value_or_error_t nsapi_dns_query_async_start(NetworkStack *stack, const char *host,
+                                                          NetworkStack::hostbyname_cb_t callback, nsapi_size_t addr_count,
+                                                          call_in_callback_cb_t call_in_cb, nsapi_version_t version, bool use_cache);
 
 // *INDENT-OFF*
 static nsapi_addr_t dns_servers[DNS_SERVERS_SIZE] = {
@@ -114,7 +128,7 @@ static nsapi_addr_t dns_servers[DNS_SERVERS_SIZE] = {
 // *INDENT-ON*
 
 #if (MBED_CONF_NSAPI_DNS_CACHE_SIZE > 0)
-static DNS_CACHE *dns_cache[MBED_CONF_NSAPI_DNS_CACHE_SIZE];
+static DNS_CACHE dns_cache[MBED_CONF_NSAPI_DNS_CACHE_SIZE];
 // Protects cache shared between blocking and asynchronous calls
 static SingletonPtr<PlatformMutex> dns_cache_mutex;
 #endif
@@ -180,6 +194,21 @@ static uint32_t dns_scan_word32(const uint8_t **p)
     return value;
 }
 
+static void dns_scan_name(const uint8_t **p)
+{
+    while (true) {
+        uint8_t len = dns_scan_byte(p);
+        if (len == 0) {
+            break;
+        } else if (len & 0xc0) { // this is link
+            dns_scan_byte(p);
+            break;
+        }
+
+        *p += len;
+    }
+}
+
 static int dns_append_question(uint8_t *ptr, uint16_t id, const char *host, nsapi_version_t version)
 {
     uint8_t *s_ptr = ptr;
@@ -215,8 +244,11 @@ static int dns_append_question(uint8_t *ptr, uint16_t id, const char *host, nsap
 
 static int dns_scan_response(const uint8_t *ptr, uint16_t exp_id, uint32_t *ttl, nsapi_addr_t *addr, unsigned addr_count)
 {
+    const uint8_t *end = ptr + DNS_BUFFER_SIZE;
     const uint8_t **p = &ptr;
 
+    *ttl = 0;
+
     // scan header
     uint16_t id    = dns_scan_word(p);
     uint16_t flags = dns_scan_word(p);
@@ -226,7 +258,7 @@ static int dns_scan_response(const uint8_t *ptr, uint16_t exp_id, uint32_t *ttl,
 
     uint16_t qdcount = dns_scan_word(p); // qdcount
     uint16_t ancount = dns_scan_word(p); // ancount
-    dns_scan_word(p);                    // nscount
+    uint16_t nscount = dns_scan_word(p); // nscount
     dns_scan_word(p);                    // arcount
 
     // verify header is response to query
@@ -234,21 +266,13 @@ static int dns_scan_response(const uint8_t *ptr, uint16_t exp_id, uint32_t *ttl,
         return -1;
     }
 
-    if (rcode != 0) {
+    if (rcode != 0 && rcode != RCODE_NXDOMAIN) {
         return 0;
     }
 
     // skip questions
     for (int i = 0; i < qdcount; i++) {
-        while (true) {
-            uint8_t len = dns_scan_byte(p);
-            if (len == 0) {
-                break;
-            }
-
-            *p += len;
-        }
-
+        dns_scan_name(p);
         dns_scan_word(p); // qtype
         dns_scan_word(p); // qclass
     }
@@ -256,25 +280,15 @@ static int dns_scan_response(const uint8_t *ptr, uint16_t exp_id, uint32_t *ttl,
     // scan each response
     unsigned count = 0;
 
-    for (int i = 0; i < ancount && count < addr_count; i++) {
-        while (true) {
-            uint8_t len = dns_scan_byte(p);
-            if (len == 0) {
-                break;
-            } else if (len & 0xc0) { // this is link
-                dns_scan_byte(p);
-                break;
-            }
-
-            *p += len;
-        }
+    for (int i = 0; i < ancount && count < addr_count && *p < end; i++) {
+        dns_scan_name(p);
 
         uint16_t rtype    = dns_scan_word(p);    // rtype
         uint16_t rclass   = dns_scan_word(p);    // rclass
         uint32_t ttl_val  = dns_scan_word32(p);  // ttl
         uint16_t rdlength = dns_scan_word(p);    // rdlength
 
-        if (i == 0) {
+        if (i == 0 && rcode == 0) {
             // Is interested only on first address that is stored to cache
             if (ttl_val > INT32_MAX) {
                 ttl_val = INT32_MAX;
@@ -306,85 +320,146 @@ static int dns_scan_response(const uint8_t *ptr, uint16_t exp_id, uint32_t *ttl,
         }
     }
 
-    return count;
+    if (count > 0) {
+        return count;
+    }
+
+    // RFC 2308: the time to cache a negative answer is the smaller of the
+    // TTL and the MINIMUM field of the SOA record of the authority section
+    *ttl = 0;
+    for (int i = 0; i < nscount && *p < end; i++) {
+        dns_scan_name(p);
+
+        uint16_t rtype    = dns_scan_word(p);    // rtype
+        uint16_t rclass   = dns_scan_word(p);    // rclass
+        uint32_t ttl_val  = dns_scan_word32(p);  // ttl
+        uint16_t rdlength = dns_scan_word(p);    // rdlength
+
+        if (rtype == RR_SOA && rclass == CLASS_IN && rdlength >= 22 && *p + rdlength <= end) {
+            // MINIMUM is the last field of the SOA record
+            const uint8_t *minimum_ptr = *p + rdlength - 4;
+            uint32_t minimum = dns_scan_word32(&minimum_ptr);
+            if (minimum < ttl_val) {
+                ttl_val = minimum;
+            }
+            if (ttl_val > DNS_NEGATIVE_TTL_MAX) {
+                ttl_val = DNS_NEGATIVE_TTL_MAX;
+            }
+            *ttl = ttl_val;
+            break;
+        }
+
+        *p += rdlength;
+    }
+
+    return 0;
 }
 
-static void nsapi_dns_cache_add(const char *host, nsapi_addr_t *address, uint32_t ttl)
+#if (MBED_CONF_NSAPI_DNS_CACHE_SIZE > 0)
+static uint32_t nsapi_dns_cache_hash(const char *host)
+{
+    // FNV-1a, compared before the host names
+    uint32_t hash = 2166136261UL;
+    for (const char *c = host; *c; c++) {
+        hash = (hash ^ (uint8_t) *c) * 16777619UL;
+    }
+    return hash;
+}
+#endif
+
+static void nsapi_dns_cache_add(const char *host, nsapi_addr_t *address, uint32_t ttl, nsapi_version_t version)
 {
 #if (MBED_CONF_NSAPI_DNS_CACHE_SIZE > 0)
     // RFC 1034: if TTL is zero, entry is not added to cache
-    if (ttl == 0) {
+    if (ttl == 0 || strlen(host) > MBED_CONF_NSAPI_DNS_CACHE_HOST_MAX_LEN) {
         return;
     }
 
-    // Checks if already cached
-    if (nsapi_dns_cache_find(host, address->version, NULL) == NSAPI_ERROR_OK) {
-        return;
-    }
+    uint32_t hash = nsapi_dns_cache_hash(host);
 
     dns_cache_mutex->lock();
 
-    int index = -1;
+    int index = 0;
+    bool free_found = false;
     uint64_t accessed = UINT64_MAX;
 
-    // Finds free or last accessed entry
+    // Finds the entry of the same query, otherwise free or last accessed entry
     for (int i = 0; i < MBED_CONF_NSAPI_DNS_CACHE_SIZE; i++) {
-        if (!dns_cache[i]) {
+        if (dns_cache[i].host[0] == '\0') {
+            if (!free_found) {
+                free_found = true;
+                index = i;
+            }
+        } else if (dns_cache[i].hash == hash && dns_cache[i].version == version &&
+                   strcmp(dns_cache[i].host, host) == 0) {
             index = i;
             break;
-        } else if (dns_cache[i]->accessed <= accessed) {
-            accessed = dns_cache[i]->accessed;
+        } else if (!free_found && dns_cache[i].accessed <= accessed) {
+            accessed = dns_cache[i].accessed;
             index = i;
         }
     }
 
-    if (index < 0) {
-        dns_cache_mutex->unlock();
-        return;
-    }
-
-    // Allocates in case entry is free, otherwise reuses
-    if (!dns_cache[index]) {
-        dns_cache[index] = new (std::nothrow) DNS_CACHE;
+    DNS_CACHE *entry = &dns_cache[index];
+    if (address) {
+        entry->address = *address;
     } else {
-        delete dns_cache[index]->host;
-    }
-
-    if (dns_cache[index]) {
-        dns_cache[index]->address = *address;
-        dns_cache[index]->host = new (std::nothrow) char[strlen(host) + 1];
-        strcpy(dns_cache[index]->host, host);
-        uint64_t ms_count = rtos::Kernel::get_ms_count();
-        dns_cache[index]->expires = ms_count + (uint64_t) ttl * 1000;
-        dns_cache[index]->accessed = ms_count;
+        entry->address.version = NSAPI_UNSPEC;
     }
+    entry->version = version;
+    entry->hash = hash;
+    strcpy(entry->host, host);
+    uint64_t ms_count = rtos::Kernel::get_ms_count();
+    entry->expires = ms_count + (uint64_t) ttl * 1000;
+    entry->accessed = ms_count;
+    entry->refreshing = false;
 
     dns_cache_mutex->unlock();
 #endif
 }
 
-static nsapi_error_t nsapi_dns_cache_find(const char *host, nsapi_version_t version, nsapi_addr_t *address)
+static nsapi_error_t nsapi_dns_cache_find(const char *host, nsapi_version_t version, nsapi_addr_t *address, bool *refresh)
 {
     nsapi_error_t ret_val = NSAPI_ERROR_NO_ADDRESS;
 
 #if (MBED_CONF_NSAPI_DNS_CACHE_SIZE > 0)
+    uint32_t hash = nsapi_dns_cache_hash(host);
+
     dns_cache_mutex->lock();
 
+    uint64_t ms_count = rtos::Kernel::get_ms_count();
+
     for (int i = 0; i < MBED_CONF_NSAPI_DNS_CACHE_SIZE; i++) {
-        if (dns_cache[i]) {
-            uint64_t ms_count = rtos::Kernel::get_ms_count();
-            // Checks all entries for expired entries
-            if (ms_count > dns_cache[i]->expires) {
-                delete dns_cache[i]->host;
-                delete dns_cache[i];
-                dns_cache[i] = NULL;
-            } else if ((version == NSAPI_UNSPEC || version == dns_cache[i]->address.version) &&
-                       strcmp(dns_cache[i]->host, host) == 0) {
+        DNS_CACHE *entry = &dns_cache[i];
+        if (entry->host[0] == '\0') {
+            continue;
+        }
+
+        // Checks all entries for expired entries
+        if (ms_count > entry->expires) {
+            entry->host[0] = '\0';
+        } else if (entry->hash == hash && strcmp(entry->host, host) == 0) {
+            if (entry->address.version == NSAPI_UNSPEC) {
+                // Negative answer, only valid for the same query
+                if (entry->version == version) {
+                    entry->accessed = ms_count;
+                    ret_val = NSAPI_ERROR_DNS_FAILURE;
+                }
+            } else if (version == NSAPI_UNSPEC || version == entry->address.version) {
                 if (address) {
-                    *address = dns_cache[i]->address;
+                    *address = entry->address;
                 }
-                dns_cache[i]->accessed = ms_count;
+                entry->accessed = ms_count;
                 ret_val = NSAPI_ERROR_OK;
+
+#if MBED_CONF_NSAPI_DNS_CACHE_REFRESH_TIME > 0
+                // Refreshes entries in use once, shortly before they expire
+                if (refresh && !entry->refreshing &&
+                        entry->expires - ms_count < MBED_CONF_NSAPI_DNS_CACHE_REFRESH_TIME * 1000ULL) {
+                    entry->refreshing = true;
+                    *refresh = true;
+                }
+#endif
             }
         }
     }
@@ -395,6 +470,42 @@ static nsapi_error_t nsapi_dns_cache_find(const char *host, nsapi_version_t vers
     return ret_val;
 }
 
+#if MBED_CONF_NSAPI_DNS_CACHE_REFRESH_TIME > 0
+static void nsapi_dns_cache_refreshed(nsapi_error_t result, SocketAddress *address)
+{
+    // The answer has been added to the cache by the query
+}
+
+static nsapi_error_t nsapi_dns_cache_refresh_call_in(int delay, mbed::Callback<void()> func)
+{
+    events::EventQueue *event_queue = mbed::mbed_event_queue();
+
+    if (!event_queue) {
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    if (event_queue->call_in(delay, func) == 0) {
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    return NSAPI_ERROR_OK;
+}
+#endif
+
+static void nsapi_dns_cache_refresh(NetworkStack *stack, const char *host, nsapi_version_t version, call_in_callback_cb_t call_in_cb)
+{
+#if MBED_CONF_NSAPI_DNS_CACHE_REFRESH_TIME > 0
+    if (!call_in_cb) {
+        // Blocking queries run the refresh on the shared event queue
+        call_in_cb = nsapi_dns_cache_refresh_call_in;
+    }
+
+    // If the query can't be started, the entry expires and is queried
+    // again on next use
+    nsapi_dns_query_async_start(stack, host, nsapi_dns_cache_refreshed, 0, call_in_cb, version, false);
+#endif
+}
+
 static nsapi_error_t nsapi_dns_get_server_addr(NetworkStack *stack, uint8_t *index, uint8_t *total_attempts, uint8_t *send_success, SocketAddress *dns_addr)
 {
     bool dns_addr_set = false;
@@ -442,8 +553,15 @@ static nsapi_size_or_error_t nsapi_dns_query_multiple(NetworkStack *stack, const
     }
 
     // check cache
-    if (nsapi_dns_cache_find(host, version, addr) == NSAPI_ERROR_OK) {
+    bool refresh = false;
+    nsapi_error_t cached = nsapi_dns_cache_find(host, version, addr, &refresh);
+    if (refresh) {
+        nsapi_dns_cache_refresh(stack, host, version, NULL);
+    }
+    if (cached == NSAPI_ERROR_OK) {
         return 1;
+    } else if (cached == NSAPI_ERROR_DNS_FAILURE) {
+        return cached;
     }
 
     // create a udp socket
@@ -515,10 +633,13 @@ static nsapi_size_or_error_t nsapi_dns_query_multiple(NetworkStack *stack, const
         uint32_t ttl;
         int resp = dns_scan_response(response, 1, &ttl, addr, addr_count);
         if (resp > 0) {
-            nsapi_dns_cache_add(host, addr, ttl);
+            nsapi_dns_cache_add(host, addr, ttl, version);
             result = resp;
         } else if (resp < 0) {
             continue;
+        } else {
+            // Negative answer, cached if it has a TTL
+            nsapi_dns_cache_add(host, NULL, ttl, version);
         }
 
         /* The DNS response is final, no need to check other servers */
@@ -604,6 +725,13 @@ nsapi_error_t nsapi_dns_call_in(call_in_callback_cb_t cb, int delay, mbed::Callb
 nsapi_value_or_error_t nsapi_dns_query_multiple_async(NetworkStack *stack, const char *host,
                                                       NetworkStack::hostbyname_cb_t callback, nsapi_size_t addr_count,
                                                       call_in_callback_cb_t call_in_cb, nsapi_version_t version)
+{
+    return nsapi_dns_query_async_start(stack, host, callback, addr_count, call_in_cb, version, true);
+}
+
+static nsapi_value_or_error_t nsapi_dns_query_async_start(NetworkStack *stack, const char *host,
+                                                          NetworkStack::hostbyname_cb_t callback, nsapi_size_t addr_count,
+                                                          call_in_callback_cb_t call_in_cb, nsapi_version_t version, bool use_cache)
 {
     dns_mutex->lock();
 
@@ -618,12 +746,19 @@ nsapi_value_or_error_t nsapi_dns_query_multiple_async(NetworkStack *stack, const
         return NSAPI_ERROR_PARAMETER;
     }
 
-    nsapi_addr address;
-    if (nsapi_dns_cache_find(host, version, &address) == NSAPI_ERROR_OK) {
-        SocketAddress addr(address);
-        dns_mutex->unlock();
-        callback(NSAPI_ERROR_OK, &addr);
-        return NSAPI_ERROR_OK;
+    if (use_cache) {
+        nsapi_addr address = { NSAPI_UNSPEC };
+        bool refresh = false;
+        nsapi_error_t cached = nsapi_dns_cache_find(host, version, &address, &refresh);
+        if (cached == NSAPI_ERROR_OK || cached == NSAPI_ERROR_DNS_FAILURE) {
+            SocketAddress addr(address);
+            dns_mutex->unlock();
+            callback(cached, cached == NSAPI_ERROR_OK ? &addr : NULL);
+            if (refresh) {
+                nsapi_dns_cache_refresh(stack, host, version, call_in_cb);
+            }
+            return NSAPI_ERROR_OK;
+        }
     }
 
     int index = -1;
@@ -664,13 +799,16 @@ nsapi_value_or_error_t nsapi_dns_query_multiple_async(NetworkStack *stack, const
     query->socket_cb_data = NULL;
     query->addrs = NULL;
     query->dns_server = 0;
+    query->dns_server_span = 1;
     query->retries = MBED_CONF_NSAPI_DNS_RETRIES + 1;
     query->total_attempts =  MBED_CONF_NSAPI_DNS_TOTAL_ATTEMPTS;
     query->send_success = 0;
     query->dns_message_id = 0;
+    query->dns_message_id_aaaa = 0;
     query->socket_timeout = 0;
     query->total_timeout = MBED_CONF_NSAPI_DNS_TOTAL_ATTEMPTS * MBED_CONF_NSAPI_DNS_RESPONSE_WAIT_TIME + 500;
     query->count = 0;
+    query->ttl = 0;
     query->state = DNS_CREATED;
 
     query->unique_id = dns_unique_id++;
@@ -943,6 +1081,34 @@ static void nsapi_dns_query_async_resp(DNS_QUERY *query, nsapi_error_t status, S
     }
 }
 
+static uint16_t nsapi_dns_next_message_id(void)
+{
+    uint16_t id = dns_message_id++;
+    if (dns_message_id == 0) {
+        dns_message_id = 1;
+    }
+    return id;
+}
+
+static nsapi_size_or_error_t nsapi_dns_query_async_sendto(DNS_QUERY *query, const SocketAddress &dns_addr, uint8_t *packet)
+{
+    nsapi_version_t version = query->version;
+    if (query->dns_message_id_aaaa) {
+        version = NSAPI_IPv4;
+    }
+
+    int len = dns_append_question(packet, query->dns_message_id, query->host, version);
+    nsapi_size_or_error_t err = query->socket->sendto(dns_addr, packet, len);
+
+    if (err >= 0 && query->dns_message_id_aaaa) {
+        // Asks both address families in parallel, the first address wins
+        len = dns_append_question(packet, query->dns_message_id_aaaa, query->host, NSAPI_IPv6);
+        query->socket->sendto(dns_addr, packet, len);
+    }
+
+    return err;
+}
+
 static void nsapi_dns_query_async_send(void *ptr)
 {
     dns_mutex->lock();
@@ -967,14 +1133,17 @@ static void nsapi_dns_query_async_send(void *ptr)
     if (query->retries) {
         query->retries--;
     } else {
-        query->dns_server++;
+        query->dns_server += query->dns_server_span;
         query->retries = MBED_CONF_NSAPI_DNS_RETRIES;
     }
 
-    query->dns_message_id = dns_message_id++;
-    if (dns_message_id == 0) {
-        dns_message_id = 1;
+    query->dns_message_id = nsapi_dns_next_message_id();
+    query->dns_message_id_aaaa = 0;
+#if MBED_CONF_NSAPI_DNS_PARALLEL_FAMILIES
+    if (query->version == NSAPI_UNSPEC) {
+        query->dns_message_id_aaaa = nsapi_dns_next_message_id();
     }
+#endif
 
     // create network packet
     uint8_t *packet = (uint8_t *)malloc(DNS_BUFFER_SIZE);
@@ -983,9 +1152,6 @@ static void nsapi_dns_query_async_send(void *ptr)
         return;
     }
 
-    // send the question
-    int len = dns_append_question(packet, query->dns_message_id, query->host, query->version);
-
     while (true) {
         SocketAddress dns_addr;
         nsapi_size_or_error_t err = nsapi_dns_get_server_addr(query->stack, &(query->dns_server), &(query->total_attempts), &(query->send_success), &dns_addr);
@@ -995,7 +1161,7 @@ static void nsapi_dns_query_async_send(void *ptr)
             return;
         }
 
-        err = query->socket->sendto(dns_addr, packet, len);
+        err = nsapi_dns_query_async_sendto(query, dns_addr, packet);
 
         if (err < 0) {
             query->dns_server++;
@@ -1004,6 +1170,24 @@ static void nsapi_dns_query_async_send(void *ptr)
         }
     }
 
+    // Asks the next servers too, the first answer wins and the later ones
+    // are ignored, so a server that doesn't answer doesn't add a timeout
+    uint8_t next = query->dns_server + 1;
+    for (int sent = 1; sent < MBED_CONF_NSAPI_DNS_PARALLEL_SERVERS && next < DNS_SERVERS_SIZE + DNS_STACK_SERVERS_NUM; next++) {
+        // Local counters, so that the next round doesn't wrap around early
+        uint8_t total_attempts = 1;
+        uint8_t send_success = 0;
+        SocketAddress dns_addr;
+        if (nsapi_dns_get_server_addr(query->stack, &next, &total_attempts, &send_success, &dns_addr) != NSAPI_ERROR_OK) {
+            break;
+        }
+
+        if (nsapi_dns_query_async_sendto(query, dns_addr, packet) >= 0) {
+            sent++;
+        }
+    }
+    query->dns_server_span = next - query->dns_server;
+
     query->send_success++;
 
     if (query->total_attempts) {
@@ -1061,13 +1245,16 @@ static void nsapi_dns_query_async_socket_callback_handle(NetworkStack *stack)
             DNS_QUERY *query = NULL;
 
             for (int i = 0; i < DNS_QUERY_QUEUE_SIZE; i++) {
-                if (dns_query_queue[i] && dns_query_queue[i]->dns_message_id == id) {
+                if (dns_query_queue[i] && (dns_query_queue[i]->dns_message_id == id ||
+                                           dns_query_queue[i]->dns_message_id_aaaa == id)) {
                     query = dns_query_queue[i];
                     break;
                 }
             }
 
-            if (!query || query->state != DNS_INITIATED) {
+            // Ignores also answers to a query that already has one, from
+            // other servers asked in parallel
+            if (!query || query->state != DNS_INITIATED || query->addrs) {
                 continue;
             }
 
@@ -1084,6 +1271,16 @@ static void nsapi_dns_query_async_socket_callback_handle(NetworkStack *stack)
             if (resp < 0) {
                 delete[] query->addrs;
                 query->addrs = 0;
+            } else if (resp == 0 && query->dns_message_id_aaaa) {
+                // Waits for the answer of the other address family
+                if (id == query->dns_message_id_aaaa) {
+                    query->dns_message_id_aaaa = 0;
+                } else {
+                    query->dns_message_id = query->dns_message_id_aaaa;
+                    query->dns_message_id_aaaa = 0;
+                }
+                delete[] query->addrs;
+                query->addrs = 0;
             } else {
                 query->count = resp;
                 query->status = NSAPI_ERROR_DNS_FAILURE; // Used in case failure, otherwise ok
@@ -1125,12 +1322,15 @@ static void nsapi_dns_query_async_response(void *ptr)
             }
 
             // Adds address to cache
-            nsapi_dns_cache_add(query->host, &(query->addrs[0]), query->ttl);
+            nsapi_dns_cache_add(query->host, &(query->addrs[0]), query->ttl, query->version);
 
             status = NSAPI_ERROR_OK;
             if (query->addr_count > 0) {
                 status = query->count;
             }
+        } else {
+            // Negative answer, cached if it has a TTL
+            nsapi_dns_cache_add(query->host, NULL, query->ttl, query->version);
         }
 
         nsapi_dns_query_async_resp(query, status, addresses);
@@ -112,6 +112,15 @@ typedef signed int nsapi_size_or_error_t;
  */
 typedef signed int nsapi_value_or_error_t;
 
+/** Scatter-gather descriptor
+ *
+ *  Describes one of the buffers of a vectored send or receive
+ */
+typedef struct nsapi_iovec {
+    void *iov_base;         /*!< Start of the buffer */
+    nsapi_size_t iov_len;   /*!< Size of the buffer in bytes */
+} nsapi_iovec_t;
+
 /** Enum of encryption types
  *
  *  The security type specifies a particular security to use when
@@ -259,6 +268,7 @@ typedef enum nsapi_socket_option {
     NSAPI_RCVBUF,            /*!< Sets recv buffer size */
     NSAPI_ADD_MEMBERSHIP,    /*!< Add membership to multicast address */
     NSAPI_DROP_MEMBERSHIP,   /*!< Drop membership to multicast address */
+    NSAPI_TCP_INFO,          /*!< Gets the state of a TCP connection as a nsapi_tcp_info_t */
 } nsapi_socket_option_t;
 
 /** Supported IP protocol versions of IP stack
@@ -317,6 +327,57 @@ typedef struct nsapi_ip_mreq {
     nsapi_addr_t imr_interface; /* local IP address of interface */
 } nsapi_ip_mreq_t;
 
+/** nsapi_tcp_info structure
+ *
+ *  State of a TCP connection, read with the NSAPI_TCP_INFO socket option.
+ *  Times have the resolution of the stack's TCP timers.
+ */
+typedef struct nsapi_tcp_info {
+    uint32_t rtt_ms;        /* smoothed round trip time */
+    uint32_t rtt_var_ms;    /* round trip time variation */
+    uint32_t cwnd;          /* congestion window in bytes */
+    uint32_t snd_wnd;       /* send window advertised by the peer, in bytes */
+    uint32_t snd_queued;    /* bytes sent or queued, not acknowledged yet */
+    uint8_t retransmits;    /* retransmissions of the oldest unacknowledged segment */
+    uint8_t snd_wnd_scale;  /* window scale shift of the peer, 0 if not negotiated */
+    uint8_t rcv_wnd_scale;  /* window scale shift of the stack, 0 if not negotiated */
+} nsapi_tcp_info_t;
+
+/** nsapi_netif_stats structure
+ *
+ *  Frame counters of a network interface
+ */
+typedef struct nsapi_netif_stats {
+    uint32_t rx_frames;     /* frames passed to the stack */
+    uint32_t rx_bytes;      /* bytes of the frames passed to the stack */
+    uint32_t rx_dropped;    /* received frames the stack rejected */
+    uint32_t tx_frames;     /* frames the driver accepted */
+    uint32_t tx_bytes;      /* bytes of the frames the driver accepted */
+    uint32_t tx_dropped;    /* frames the driver failed to send */
+} nsapi_netif_stats_t;
+
+/** Enum of the phases of an interface connection
+ *
+ *  @enum nsapi_connection_phase
+ */
+typedef enum nsapi_connection_phase {
+    NSAPI_PHASE_LINK_UP = 0,    /*!< link up, network joined or registered */
+    NSAPI_PHASE_ADDRESS,        /*!< first IP address acquired or context activated */
+    NSAPI_PHASE_DNS_SERVER,     /*!< a DNS server is known */
+    NSAPI_PHASE_GLOBAL_UP,      /*!< interface reported NSAPI_STATUS_GLOBAL_UP */
+    NSAPI_PHASE_MAX
+} nsapi_connection_phase_t;
+
+/** nsapi_connection_timeline structure
+ *
+ *  Times at which the last connect() reached each phase, in milliseconds
+ *  from the call. 0 if the phase wasn't reached, a phase reached within the
+ *  first millisecond is reported as 1.
+ */
+typedef struct nsapi_connection_timeline {
+    uint32_t phase_ms[NSAPI_PHASE_MAX];
+} nsapi_connection_timeline_t;
+
 /** nsapi_stack_api structure
  *
  *  Common api structure for network stack operations. A network stack
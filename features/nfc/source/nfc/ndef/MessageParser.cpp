@@ -241,8 +241,6 @@ bool MessageParser::parse_record(parsing_state_t &s)
         s.it += payload_length;
     }
 
-    s.it += payload_length;
-
     report_record_parsed(record);
 
     return true;
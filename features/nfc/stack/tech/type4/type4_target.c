@@ -25,6 +25,8 @@
 #define __MODULE__ "type4_target.c"
 #endif
 
+#include <string.h>
+
 #include "stack/nfc_errors.h"
 
 #include "type4_target.h"
@@ -98,9 +100,10 @@ void app_selected(nfc_tech_iso7816_app_t *pIso7816App, void *pUserData)
     ac_buffer_builder_write_nu16(&pType4Target->ndefFileBldr, ac_buffer_reader_readable(ac_buffer_builder_buffer(ndef_msg_buffer_builder(pType4Target->pNdef))));
 
     //Pad NDEF file with 0s
-    while (ac_buffer_builder_writable(ndef_msg_buffer_builder(pType4Target->pNdef)) > 0) {
-        ac_buffer_builder_write_nu8(ndef_msg_buffer_builder(pType4Target->pNdef), 0);
-    }
+    ac_buffer_builder_t *pNdefBldr = ndef_msg_buffer_builder(pType4Target->pNdef);
+    size_t padding = ac_buffer_builder_writable(pNdefBldr);
+    memset(ac_buffer_builder_write_position(pNdefBldr), 0, padding);
+    ac_buffer_builder_write_n_skip(pNdefBldr, padding);
 
     //No file selected
     pType4Target->selFile = DEFAULT_FILE;
@@ -169,6 +169,10 @@ nfc_err_t pn512_init(pn512_t *pPN512, nfc_transport_t *pTransport, nfc_scheduler
     DBGX_LEAVE();
 #endif
 
+    //Put IRQ enable registers into known state, pn512_irq_set() only writes changes
+    pPN512->irqsEn = PN512_IRQ_ALL;
+    pn512_irq_set(pPN512, PN512_IRQ_NONE);
+
     r = pn512_register_read(pPN512, PN512_REG_VERSION);
 
     NFC_DBG_BLOCK(
@@ -66,8 +66,13 @@ extern "C" {
  */
 static inline void pn512_irq_set(pn512_t *pPN512, uint16_t irqs) //ORed
 {
-    pn512_register_write(pPN512, PN512_REG_COMIEN, PN512_REG_COMIEN_VAL | (PN512_REG_COMIEN_MASK & (irqs & 0xFF)));
-    pn512_register_write(pPN512, PN512_REG_DIVIEN, PN512_REG_DIVIEN_VAL | (PN512_REG_DIVIEN_MASK & (irqs >> 8)));
+    //Only write registers which change, each access is a SPI transaction
+    if ((irqs ^ pPN512->irqsEn) & 0xFF) {
+        pn512_register_write(pPN512, PN512_REG_COMIEN, PN512_REG_COMIEN_VAL | (PN512_REG_COMIEN_MASK & (irqs & 0xFF)));
+    }
+    if ((irqs ^ pPN512->irqsEn) >> 8) {
+        pn512_register_write(pPN512, PN512_REG_DIVIEN, PN512_REG_DIVIEN_VAL | (PN512_REG_DIVIEN_MASK & (irqs >> 8)));
+    }
     pPN512->irqsEn = irqs;
 }
 
@@ -87,8 +92,15 @@ static inline uint16_t pn512_irq_enabled(pn512_t *pPN512) //ORed
  */
 static inline uint16_t pn512_irq_get(pn512_t *pPN512) //ORed
 {
-    return ((pn512_register_read(pPN512, PN512_REG_COMIRQ) & PN512_REG_COMIEN_MASK)
-            | ((pn512_register_read(pPN512, PN512_REG_DIVIRQ) & PN512_REG_DIVIEN_MASK) << 8)) & pPN512->irqsEn;
+    //Skip status registers of which no IRQ is enabled
+    uint16_t irqs = 0;
+    if (pPN512->irqsEn & 0xFF) {
+        irqs |= pn512_register_read(pPN512, PN512_REG_COMIRQ) & PN512_REG_COMIEN_MASK;
+    }
+    if (pPN512->irqsEn >> 8) {
+        irqs |= (pn512_register_read(pPN512, PN512_REG_DIVIRQ) & PN512_REG_DIVIEN_MASK) << 8;
+    }
+    return irqs & pPN512->irqsEn;
 }
 
 /** \internal Clear some interrupts
@@ -97,8 +109,12 @@ static inline uint16_t pn512_irq_get(pn512_t *pPN512) //ORed
  */
 static inline void pn512_irq_clear(pn512_t *pPN512, uint16_t irqs)
 {
-    pn512_register_write(pPN512, PN512_REG_COMIRQ, PN512_REG_COMIRQ_CLEAR | (PN512_REG_COMIRQ_MASK & (irqs & 0xFF)));
-    pn512_register_write(pPN512, PN512_REG_DIVIRQ, PN512_REG_DIVIRQ_CLEAR | (PN512_REG_DIVIRQ_MASK & (irqs >> 8)));
+    if (irqs & 0xFF) {
+        pn512_register_write(pPN512, PN512_REG_COMIRQ, PN512_REG_COMIRQ_CLEAR | (PN512_REG_COMIRQ_MASK & (irqs & 0xFF)));
+    }
+    if (irqs >> 8) {
+        pn512_register_write(pPN512, PN512_REG_DIVIRQ, PN512_REG_DIVIRQ_CLEAR | (PN512_REG_DIVIRQ_MASK & (irqs >> 8)));
+    }
 }
 
 #ifdef __cplusplus
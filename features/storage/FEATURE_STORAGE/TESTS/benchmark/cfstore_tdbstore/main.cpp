@@ -0,0 +1,355 @@
+/*
+* Copyright (c) 2019 ARM Limited. All rights reserved.
+*
+* SPDX-License-Identifier: Apache-2.0
+*
+* Licensed under the Apache License, Version 2.0 (the License); you may
+* not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an AS IS BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/* Boot scan, get and set latency of CFSTORE against TDBStore, its
+ * replacement, and cost of the stepped migration with kv_import_cfstore().
+ *
+ * Both stores hold the same keys and values. A CFSTORE set is flushed,
+ * as TDBStore sets are durable when they return. Every result is sent to
+ * the host in the format of the storage stack benchmark,
+ *
+ *     {{benchmark;<target>,<test>,op_size=<B>,ops=<n>,bytes_per_s=<B/s>,iops=<n>,p50_us=<us>,p99_us=<us>}}
+ */
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+#include "cfstore_config.h"
+#include "cfstore_test.h"
+#include "configuration_store.h"
+#include "HeapBlockDevice.h"
+#include "FlashSimBlockDevice.h"
+#include "TDBStore.h"
+#include "kvstore_global_api.h"
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+
+using namespace utest::v1;
+using namespace mbed;
+
+// Number of keys and size of the values
+#ifndef MBED_TEST_BENCH_KV_KEYS
+#define MBED_TEST_BENCH_KV_KEYS 32
+#endif
+
+#ifndef MBED_TEST_BENCH_KV_VALUE_SIZE
+#define MBED_TEST_BENCH_KV_VALUE_SIZE 64
+#endif
+
+// Number of boot scans timed for each store
+#ifndef MBED_TEST_BENCH_BOOTS
+#define MBED_TEST_BENCH_BOOTS 8
+#endif
+
+// Keys moved by each kv_import_cfstore() step
+#ifndef MBED_TEST_BENCH_IMPORT_STEP
+#define MBED_TEST_BENCH_IMPORT_STEP 4
+#endif
+
+// Size of the heap block device TDBStore is benchmarked on
+#ifndef MBED_TEST_BENCH_STACK_SIZE
+#define MBED_TEST_BENCH_STACK_SIZE (64 * 1024)
+#endif
+
+#define BENCH_MAX_OPS std::max(MBED_TEST_BENCH_KV_KEYS, MBED_TEST_BENCH_BOOTS)
+
+#define STR_EXPAND(tok) #tok
+#define STR(tok) STR_EXPAND(tok)
+
+// Partition of the default KVStore the keys are migrated to
+#define BENCH_DEF_KV "/" STR(MBED_CONF_STORAGE_DEFAULT_KV) "/"
+
+// Prime stride visiting every key once in random order
+static const size_t bench_stride = 7919;
+
+static uint32_t bench_latency[BENCH_MAX_OPS];
+static uint8_t bench_value[MBED_TEST_BENCH_KV_VALUE_SIZE];
+static uint8_t bench_buffer[MBED_TEST_BENCH_KV_VALUE_SIZE];
+
+extern ARM_CFSTORE_DRIVER cfstore_driver;
+static ARM_CFSTORE_DRIVER *cfstore_drv = &cfstore_driver;
+
+typedef int (*bench_op_t)(void *ctx, size_t index);
+
+static void bench_report(const char *target, const char *test, size_t op_size, size_t count)
+{
+    uint64_t total_us = 0;
+    for (size_t i = 0; i < count; i++) {
+        total_us += bench_latency[i];
+    }
+    if (!total_us) {
+        total_us = 1;
+    }
+
+    std::sort(bench_latency, bench_latency + count);
+    uint32_t p50 = bench_latency[(count - 1) * 50 / 100];
+    uint32_t p99 = bench_latency[(count - 1) * 99 / 100];
+
+    char result[160];
+    snprintf(result, sizeof(result), "%s,%s,op_size=%lu,ops=%lu,bytes_per_s=%lu,iops=%lu,p50_us=%lu,p99_us=%lu",
+             target, test, (unsigned long)op_size, (unsigned long)count,
+             (unsigned long)((uint64_t)op_size * count * 1000000 / total_us),
+             (unsigned long)((uint64_t)count * 1000000 / total_us),
+             (unsigned long)p50, (unsigned long)p99);
+    greentea_send_kv("benchmark", result);
+}
+
+/* Run count operations, in order or visiting the same indexes in a fixed
+ * random order, timing each of them
+ */
+static void bench_run(const char *target, const char *test, bench_op_t op, void *ctx,
+                      size_t op_size, size_t count, bool random)
+{
+    Timer timer;
+    TEST_ASSERT(count > 0 && count <= BENCH_MAX_OPS);
+
+    timer.start();
+    for (size_t i = 0; i < count; i++) {
+        size_t index = random ? (i * bench_stride) % count : i;
+        us_timestamp_t start = timer.read_high_resolution_us();
+        int err = op(ctx, index);
+        bench_latency[i] = timer.read_high_resolution_us() - start;
+        TEST_ASSERT_EQUAL(0, err);
+    }
+
+    bench_report(target, test, op_size, count);
+}
+
+static void make_key(char *key, size_t index)
+{
+    sprintf(key, "bench.key.%u", (unsigned int)index);
+}
+
+/*----------------CFSTORE------------------*/
+
+static int cfstore_set(void *ctx, size_t index)
+{
+    char key[32];
+    make_key(key, index);
+
+    ARM_CFSTORE_KEYDESC kdesc;
+    memset(&kdesc, 0, sizeof(kdesc));
+    ARM_CFSTORE_SIZE len = sizeof(bench_value);
+    int32_t ret = cfstore_test_create(key, (const char *)bench_value, &len, &kdesc);
+    if (ret < ARM_DRIVER_OK) {
+        return ret;
+    }
+    return cfstore_drv->Flush() < ARM_DRIVER_OK ? -1 : 0;
+}
+
+static int cfstore_get(void *ctx, size_t index)
+{
+    char key[32];
+    make_key(key, index);
+
+    ARM_CFSTORE_FMODE flags;
+    memset(&flags, 0, sizeof(flags));
+    flags.read = 1;
+    ARM_CFSTORE_HANDLE_INIT(hkey);
+    if (cfstore_drv->Open(key, flags, hkey) < ARM_DRIVER_OK) {
+        return -1;
+    }
+    ARM_CFSTORE_SIZE len = sizeof(bench_buffer);
+    int32_t ret = cfstore_drv->Read(hkey, bench_buffer, &len);
+    cfstore_drv->Close(hkey);
+    return (ret < ARM_DRIVER_OK || len != sizeof(bench_buffer)) ? -1 : 0;
+}
+
+static int cfstore_boot(void *ctx, size_t index)
+{
+    if (cfstore_drv->Uninitialize() < ARM_DRIVER_OK) {
+        return -1;
+    }
+    return cfstore_drv->Initialize(NULL, NULL) < ARM_DRIVER_OK ? -1 : 0;
+}
+
+static void cfstore_populate()
+{
+    for (size_t i = 0; i < MBED_TEST_BENCH_KV_KEYS; i++) {
+        TEST_ASSERT_EQUAL(0, cfstore_set(NULL, i));
+    }
+}
+
+/* Given an empty CFSTORE
+ * When keys are set, the store is booted and the keys are got in order
+ * and in random order
+ * Then the latencies of each operation are reported
+ */
+static void bench_cfstore()
+{
+    TEST_SKIP_UNLESS_MESSAGE(!cfstore_drv->GetCapabilities().asynchronous_ops, "CFSTORE is asynchronous");
+
+    int32_t ret = cfstore_test_startup();
+    TEST_ASSERT(ret >= ARM_DRIVER_OK);
+    ret = cfstore_drv->Initialize(NULL, NULL);
+    TEST_ASSERT(ret >= ARM_DRIVER_OK);
+    ret = cfstore_test_delete_all();
+    TEST_ASSERT(ret >= ARM_DRIVER_OK);
+
+    bench_run("CFSTORE", "set", cfstore_set, NULL, sizeof(bench_value), MBED_TEST_BENCH_KV_KEYS, false);
+    bench_run("CFSTORE", "boot_scan", cfstore_boot, NULL, sizeof(bench_value) * MBED_TEST_BENCH_KV_KEYS,
+              MBED_TEST_BENCH_BOOTS, false);
+    bench_run("CFSTORE", "seq_get", cfstore_get, NULL, sizeof(bench_value), MBED_TEST_BENCH_KV_KEYS, false);
+    bench_run("CFSTORE", "rand_get", cfstore_get, NULL, sizeof(bench_value), MBED_TEST_BENCH_KV_KEYS, true);
+
+    ret = cfstore_test_delete_all();
+    TEST_ASSERT(ret >= ARM_DRIVER_OK);
+    ret = cfstore_drv->Flush();
+    TEST_ASSERT(ret >= ARM_DRIVER_OK);
+    ret = cfstore_drv->Uninitialize();
+    TEST_ASSERT(ret >= ARM_DRIVER_OK);
+}
+
+/*----------------TDBStore------------------*/
+
+static int tdb_set(void *ctx, size_t index)
+{
+    char key[32];
+    make_key(key, index);
+    return static_cast<KVStore *>(ctx)->set(key, bench_value, sizeof(bench_value), 0);
+}
+
+static int tdb_get(void *ctx, size_t index)
+{
+    char key[32];
+    size_t actual_size;
+    make_key(key, index);
+    int err = static_cast<KVStore *>(ctx)->get(key, bench_buffer, sizeof(bench_buffer), &actual_size);
+    return (err || actual_size == sizeof(bench_buffer)) ? err : -1;
+}
+
+static int tdb_boot(void *ctx, size_t index)
+{
+    KVStore *kv = static_cast<KVStore *>(ctx);
+    int err = kv->deinit();
+    return err ? err : kv->init();
+}
+
+/* Given a reset TDBStore
+ * When the same keys as CFSTORE's are set, the store is booted and the
+ * keys are got in order and in random order
+ * Then the latencies of each operation are reported
+ */
+static void bench_tdbstore()
+{
+    HeapBlockDevice *heap_bd = new (std::nothrow) HeapBlockDevice(MBED_TEST_BENCH_STACK_SIZE, 1, 1, 4096);
+    TEST_SKIP_UNLESS_MESSAGE(heap_bd, "Not enough heap to run test");
+    {
+        // TDBStore needs a defined erase value
+        FlashSimBlockDevice flash_bd(heap_bd);
+        TDBStore tdbs(&flash_bd);
+
+        int err = tdbs.init();
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, err);
+        err = tdbs.reset();
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, err);
+
+        bench_run("TDBStore", "set", tdb_set, &tdbs, sizeof(bench_value), MBED_TEST_BENCH_KV_KEYS, false);
+        bench_run("TDBStore", "boot_scan", tdb_boot, &tdbs, sizeof(bench_value) * MBED_TEST_BENCH_KV_KEYS,
+                  MBED_TEST_BENCH_BOOTS, false);
+        bench_run("TDBStore", "seq_get", tdb_get, &tdbs, sizeof(bench_value), MBED_TEST_BENCH_KV_KEYS, false);
+        bench_run("TDBStore", "rand_get", tdb_get, &tdbs, sizeof(bench_value), MBED_TEST_BENCH_KV_KEYS, true);
+
+        err = tdbs.deinit();
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, err);
+    }
+    delete heap_bd;
+}
+
+/*----------------migration------------------*/
+
+/* Given CFSTORE holding the benchmark keys
+ * When they are moved to the default KVStore with kv_import_cfstore(),
+ * a bounded number of keys per step
+ * Then the latency of the steps is reported, CFSTORE is left empty and
+ * every key reads back from the KVStore
+ */
+static void bench_import()
+{
+    TEST_SKIP_UNLESS_MESSAGE(!cfstore_drv->GetCapabilities().asynchronous_ops, "CFSTORE is asynchronous");
+
+    int err = kv_reset(BENCH_DEF_KV);
+    TEST_SKIP_UNLESS_MESSAGE(err == MBED_SUCCESS, "no default KVStore");
+
+    int32_t ret = cfstore_drv->Initialize(NULL, NULL);
+    TEST_ASSERT(ret >= ARM_DRIVER_OK);
+    ret = cfstore_test_delete_all();
+    TEST_ASSERT(ret >= ARM_DRIVER_OK);
+    cfstore_populate();
+    ret = cfstore_drv->Uninitialize();
+    TEST_ASSERT(ret >= ARM_DRIVER_OK);
+
+    Timer timer;
+    size_t steps = 0;
+    size_t remaining = MBED_TEST_BENCH_KV_KEYS;
+    timer.start();
+    while (remaining && steps < BENCH_MAX_OPS) {
+        size_t left = 0;
+        us_timestamp_t start = timer.read_high_resolution_us();
+        err = kv_import_cfstore(BENCH_DEF_KV, MBED_TEST_BENCH_IMPORT_STEP, &left);
+        bench_latency[steps++] = timer.read_high_resolution_us() - start;
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, err);
+        TEST_ASSERT(left < remaining);
+        remaining = left;
+    }
+    TEST_ASSERT_EQUAL(0, remaining);
+    bench_report("kv_import_cfstore", "step", sizeof(bench_value) * MBED_TEST_BENCH_IMPORT_STEP, steps);
+
+    for (size_t i = 0; i < MBED_TEST_BENCH_KV_KEYS; i++) {
+        char key[64];
+        size_t actual_size = 0;
+        sprintf(key, BENCH_DEF_KV "bench.key.%u", (unsigned int)i);
+        err = kv_get(key, bench_buffer, sizeof(bench_buffer), &actual_size);
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, err);
+        TEST_ASSERT_EQUAL(sizeof(bench_value), actual_size);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(bench_value, bench_buffer, sizeof(bench_value));
+    }
+
+    err = kv_reset(BENCH_DEF_KV);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, err);
+}
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason)
+{
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+    Case("Benchmark: CFSTORE", bench_cfstore, greentea_failure_handler),
+    Case("Benchmark: TDBStore", bench_tdbstore, greentea_failure_handler),
+    Case("Benchmark: kv_import_cfstore", bench_import, greentea_failure_handler),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    for (size_t i = 0; i < sizeof(bench_value); i++) {
+        bench_value[i] = i & 0xff;
+    }
+    GREENTEA_SETUP(3000, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    return !Harness::run(specification);
+}
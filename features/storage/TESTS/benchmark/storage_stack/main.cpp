@@ -0,0 +1,726 @@
+/*
+* Copyright (c) 2019 ARM Limited. All rights reserved.
+*
+* SPDX-License-Identifier: Apache-2.0
+*
+* Licensed under the Apache License, Version 2.0 (the License); you may
+* not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an AS IS BASIS, WITHOUT
+* WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+/* Throughput, IOPS and latency of the block devices, file systems and
+ * KVStores of the storage stack.
+ *
+ * Each benchmark runs a fixed number of operations of a fixed size, with
+ * the sequential and random orders visiting the same offsets, so runs of
+ * different releases are comparable. Every result is sent to the host as
+ *
+ *     {{benchmark;<target>,<test>,op_size=<B>,ops=<n>,bytes_per_s=<B/s>,iops=<n>,p50_us=<us>,p99_us=<us>}}
+ */
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+#include "HeapBlockDevice.h"
+#include "SlicingBlockDevice.h"
+#include "FlashSimBlockDevice.h"
+#include "LittleFileSystem.h"
+#include "FATFileSystem.h"
+#include "TDBStore.h"
+#include "FileSystemStore.h"
+#include "SecureStore.h"
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+
+#if COMPONENT_SPIF
+#include "SPIFBlockDevice.h"
+#endif
+
+#if COMPONENT_QSPIF
+#include "QSPIFBlockDevice.h"
+#endif
+
+#if COMPONENT_DATAFLASH
+#include "DataFlashBlockDevice.h"
+#endif
+
+#if COMPONENT_SD
+#include "SDBlockDevice.h"
+#endif
+
+#if COMPONENT_FLASHIAP
+#include "FlashIAPBlockDevice.h"
+#endif
+
+using namespace utest::v1;
+using namespace mbed;
+
+// Number of operations of each benchmark, bounds the latency samples
+#ifndef MBED_TEST_BENCH_OPS
+#define MBED_TEST_BENCH_OPS 128
+#endif
+
+// Size of block device and file operations
+#ifndef MBED_TEST_BENCH_OP_SIZE
+#define MBED_TEST_BENCH_OP_SIZE 512
+#endif
+
+// Size of the storage the file systems and KVStores are benchmarked on
+#ifndef MBED_TEST_BENCH_STACK_SIZE
+#define MBED_TEST_BENCH_STACK_SIZE (64 * 1024)
+#endif
+
+// Number of keys and size of the values of the KVStore benchmarks
+#ifndef MBED_TEST_BENCH_KV_KEYS
+#define MBED_TEST_BENCH_KV_KEYS 32
+#endif
+
+#ifndef MBED_TEST_BENCH_KV_VALUE_SIZE
+#define MBED_TEST_BENCH_KV_VALUE_SIZE 64
+#endif
+
+// Number of files in the directory of the file system lookup benchmark
+#ifndef MBED_TEST_BENCH_FS_FILES
+#define MBED_TEST_BENCH_FS_FILES 64
+#endif
+
+// Prime stride visiting every operation of a benchmark once in random order
+static const size_t bench_stride = 7919;
+
+static uint32_t bench_latency[MBED_TEST_BENCH_OPS];
+
+typedef int (*bench_op_t)(void *ctx, size_t index);
+
+enum bd_type {
+    heap = 0,
+    spif,
+    qspif,
+    dataflash,
+    sd,
+    flashiap,
+};
+
+static inline bd_size_t align_up(bd_size_t val, bd_size_t size)
+{
+    return (val + size - 1) / size * size;
+}
+
+static inline bd_size_t align_down(bd_size_t val, bd_size_t size)
+{
+    return val / size * size;
+}
+
+static void bench_report(const char *target, const char *test, size_t op_size, size_t count)
+{
+    uint64_t total_us = 0;
+    for (size_t i = 0; i < count; i++) {
+        total_us += bench_latency[i];
+    }
+    if (!total_us) {
+        total_us = 1;
+    }
+
+    std::sort(bench_latency, bench_latency + count);
+    uint32_t p50 = bench_latency[(count - 1) * 50 / 100];
+    uint32_t p99 = bench_latency[(count - 1) * 99 / 100];
+
+    char result[160];
+    snprintf(result, sizeof(result), "%s,%s,op_size=%lu,ops=%lu,bytes_per_s=%lu,iops=%lu,p50_us=%lu,p99_us=%lu",
+             target, test, (unsigned long)op_size, (unsigned long)count,
+             (unsigned long)((uint64_t)op_size * count * 1000000 / total_us),
+             (unsigned long)((uint64_t)count * 1000000 / total_us),
+             (unsigned long)p50, (unsigned long)p99);
+    greentea_send_kv("benchmark", result);
+}
+
+/* Run count operations, in order or visiting the same indexes in a fixed
+ * random order, timing each of them
+ */
+static void bench_run(const char *target, const char *test, bench_op_t op, void *ctx,
+                      size_t op_size, size_t count, bool random)
+{
+    Timer timer;
+    TEST_ASSERT(count > 0 && count <= MBED_TEST_BENCH_OPS);
+
+    timer.start();
+    for (size_t i = 0; i < count; i++) {
+        size_t index = random ? (i * bench_stride) % count : i;
+        us_timestamp_t start = timer.read_high_resolution_us();
+        int err = op(ctx, index);
+        bench_latency[i] = timer.read_high_resolution_us() - start;
+        TEST_ASSERT_EQUAL(0, err);
+    }
+
+    bench_report(target, test, op_size, count);
+}
+
+/*----------------block devices------------------*/
+
+struct bd_ctx_t {
+    BlockDevice *bd;
+    uint8_t *buffer;
+    bd_size_t op_size;
+};
+
+static int bd_read(void *ctx, size_t index)
+{
+    bd_ctx_t *c = static_cast<bd_ctx_t *>(ctx);
+    return c->bd->read(c->buffer, index * c->op_size, c->op_size);
+}
+
+static int bd_program(void *ctx, size_t index)
+{
+    bd_ctx_t *c = static_cast<bd_ctx_t *>(ctx);
+    return c->bd->program(c->buffer, index * c->op_size, c->op_size);
+}
+
+static int bd_erase(void *ctx, size_t index)
+{
+    bd_ctx_t *c = static_cast<bd_ctx_t *>(ctx);
+    return c->bd->erase(index * c->op_size, c->op_size);
+}
+
+static BlockDevice *get_bd_instance(uint8_t bd_type)
+{
+    switch (bd_type) {
+        case spif: {
+#if COMPONENT_SPIF
+            static SPIFBlockDevice default_bd(
+                MBED_CONF_SPIF_DRIVER_SPI_MOSI,
+                MBED_CONF_SPIF_DRIVER_SPI_MISO,
+                MBED_CONF_SPIF_DRIVER_SPI_CLK,
+                MBED_CONF_SPIF_DRIVER_SPI_CS,
+                MBED_CONF_SPIF_DRIVER_SPI_FREQ
+            );
+            return &default_bd;
+#endif
+            break;
+        }
+        case qspif: {
+#if COMPONENT_QSPIF
+            static QSPIFBlockDevice default_bd(
+                MBED_CONF_QSPIF_QSPI_IO0,
+                MBED_CONF_QSPIF_QSPI_IO1,
+                MBED_CONF_QSPIF_QSPI_IO2,
+                MBED_CONF_QSPIF_QSPI_IO3,
+                MBED_CONF_QSPIF_QSPI_SCK,
+                MBED_CONF_QSPIF_QSPI_CSN,
+                MBED_CONF_QSPIF_QSPI_POLARITY_MODE,
+                MBED_CONF_QSPIF_QSPI_FREQ
+            );
+            return &default_bd;
+#endif
+            break;
+        }
+        case dataflash: {
+#if COMPONENT_DATAFLASH
+            static DataFlashBlockDevice default_bd(
+                MBED_CONF_DATAFLASH_SPI_MOSI,
+                MBED_CONF_DATAFLASH_SPI_MISO,
+                MBED_CONF_DATAFLASH_SPI_CLK,
+                MBED_CONF_DATAFLASH_SPI_CS
+            );
+            return &default_bd;
+#endif
+            break;
+        }
+        case sd: {
+#if COMPONENT_SD
+            static SDBlockDevice default_bd(
+                MBED_CONF_SD_SPI_MOSI,
+                MBED_CONF_SD_SPI_MISO,
+                MBED_CONF_SD_SPI_CLK,
+                MBED_CONF_SD_SPI_CS
+            );
+            return &default_bd;
+#endif
+            break;
+        }
+        case flashiap: {
+#if COMPONENT_FLASHIAP
+#if (MBED_CONF_FLASHIAP_BLOCK_DEVICE_SIZE == 0) && (MBED_CONF_FLASHIAP_BLOCK_DEVICE_BASE_ADDRESS == 0xFFFFFFFF)
+
+            size_t flash_size;
+            uint32_t start_address;
+            uint32_t bottom_address;
+            mbed::FlashIAP flash;
+
+            int ret = flash.init();
+            if (ret != 0) {
+                return NULL;
+            }
+
+            //Find the start of first sector after text area
+            bottom_address = align_up(FLASHIAP_APP_ROM_END_ADDR, flash.get_sector_size(FLASHIAP_APP_ROM_END_ADDR));
+            start_address = flash.get_flash_start();
+            flash_size = flash.get_flash_size();
+
+            ret = flash.deinit();
+
+            static FlashIAPBlockDevice default_bd(bottom_address, start_address + flash_size - bottom_address);
+
+#else
+
+            static FlashIAPBlockDevice default_bd;
+
+#endif
+            return &default_bd;
+#endif
+            break;
+        }
+        default:
+            break;
+    }
+    return NULL;
+}
+
+/* Given a block device
+ * When its first erase units are erased, programmed and read sequentially
+ * and in random order
+ * Then the throughput and latencies of each operation are reported
+ */
+static void bench_bd(const char *target, BlockDevice *bd)
+{
+    TEST_SKIP_UNLESS_MESSAGE(bd != NULL, "no block device found.");
+
+    int err = bd->init();
+    TEST_ASSERT_EQUAL(0, err);
+
+    bd_size_t op_size = align_up(MBED_TEST_BENCH_OP_SIZE, bd->get_program_size());
+    bd_size_t erase_size = align_up(op_size, bd->get_erase_size(0));
+    size_t count = MBED_TEST_BENCH_OPS;
+    bd_size_t region = align_up(count * op_size, erase_size);
+    if (region > bd->size()) {
+        region = align_down(bd->size(), erase_size);
+        count = region / op_size;
+    }
+    TEST_SKIP_UNLESS_MESSAGE(count && bd->is_valid_erase(0, region), "block device too small");
+
+    uint8_t *buffer = new (std::nothrow) uint8_t[op_size];
+    TEST_SKIP_UNLESS_MESSAGE(buffer, "Not enough heap to run test");
+    for (bd_size_t i = 0; i < op_size; i++) {
+        buffer[i] = i & 0xff;
+    }
+
+    bd_ctx_t ctx = { bd, buffer, erase_size };
+    bench_run(target, "erase", bd_erase, &ctx, erase_size, region / erase_size, false);
+
+    ctx.op_size = op_size;
+    bench_run(target, "seq_write", bd_program, &ctx, op_size, count, false);
+    bench_run(target, "seq_read", bd_read, &ctx, op_size, count, false);
+    bench_run(target, "rand_read", bd_read, &ctx, op_size, count, true);
+
+    err = bd->erase(0, region);
+    TEST_ASSERT_EQUAL(0, err);
+    bench_run(target, "rand_write", bd_program, &ctx, op_size, count, true);
+
+    delete[] buffer;
+
+    err = bd->deinit();
+    TEST_ASSERT_EQUAL(0, err);
+}
+
+static void bench_heap_bd()
+{
+    HeapBlockDevice heap_bd(MBED_TEST_BENCH_OPS * MBED_TEST_BENCH_OP_SIZE, MBED_TEST_BENCH_OP_SIZE);
+    bench_bd("HeapBlockDevice", &heap_bd);
+}
+
+template <bd_type type>
+static void bench_component_bd()
+{
+    static const char *names[] = {
+        "HeapBlockDevice", "SPIFBlockDevice", "QSPIFBlockDevice",
+        "DataFlashBlockDevice", "SDBlockDevice", "FlashIAPBlockDevice"
+    };
+    bench_bd(names[type], get_bd_instance(type));
+}
+
+/*----------------storage stack------------------*/
+
+/* The file systems and KVStores are benchmarked on the start of the
+ * default block device, or on a heap block device without one
+ */
+static BlockDevice *stack_bd = NULL;
+static HeapBlockDevice *stack_heap_bd = NULL;
+static SlicingBlockDevice *stack_slice_bd = NULL;
+
+static bool stack_init()
+{
+    BlockDevice *bd = BlockDevice::get_default_instance();
+    if (!bd) {
+        stack_heap_bd = new HeapBlockDevice(MBED_TEST_BENCH_STACK_SIZE, 1, 1, MBED_TEST_BENCH_OP_SIZE);
+        bd = stack_heap_bd;
+    }
+
+    int err = bd->init();
+    TEST_ASSERT_EQUAL(0, err);
+
+    bd_size_t erase_size = bd->get_erase_size(0);
+    bd_size_t size = std::min(align_up(MBED_TEST_BENCH_STACK_SIZE, erase_size), bd->size());
+    bool valid = bd->is_valid_erase(0, size);
+
+    if (valid && stack_heap_bd) {
+        // The heap block device allocates its blocks on the fly, program
+        // them all ahead to check there is enough heap
+        uint8_t *buffer = new (std::nothrow) uint8_t[MBED_TEST_BENCH_OP_SIZE];
+        valid = buffer != NULL;
+        if (buffer) {
+            memset(buffer, 0xff, MBED_TEST_BENCH_OP_SIZE);
+        }
+        for (bd_addr_t addr = 0; addr < size && valid; addr += MBED_TEST_BENCH_OP_SIZE) {
+            valid = bd->program(buffer, addr, MBED_TEST_BENCH_OP_SIZE) == 0;
+        }
+        delete[] buffer;
+    }
+
+    err = bd->deinit();
+    TEST_ASSERT_EQUAL(0, err);
+
+    if (!valid) {
+        delete stack_heap_bd;
+        stack_heap_bd = NULL;
+        return false;
+    }
+
+    stack_slice_bd = new SlicingBlockDevice(bd, 0, size);
+    stack_bd = stack_slice_bd;
+    return true;
+}
+
+static void stack_deinit()
+{
+    delete stack_slice_bd;
+    stack_slice_bd = NULL;
+    delete stack_heap_bd;
+    stack_heap_bd = NULL;
+    stack_bd = NULL;
+}
+
+/*----------------file systems------------------*/
+
+struct fs_ctx_t {
+    File *file;
+    uint8_t *buffer;
+    size_t op_size;
+};
+
+static int fs_read(void *ctx, size_t index)
+{
+    fs_ctx_t *c = static_cast<fs_ctx_t *>(ctx);
+    ssize_t size = c->file->read(c->buffer, c->op_size);
+    return (size == (ssize_t)c->op_size) ? 0 : -1;
+}
+
+static int fs_write(void *ctx, size_t index)
+{
+    fs_ctx_t *c = static_cast<fs_ctx_t *>(ctx);
+    ssize_t size = c->file->write(c->buffer, c->op_size);
+    return (size == (ssize_t)c->op_size) ? 0 : -1;
+}
+
+static int fs_seek_read(void *ctx, size_t index)
+{
+    fs_ctx_t *c = static_cast<fs_ctx_t *>(ctx);
+    off_t off = c->file->seek(index * c->op_size, SEEK_SET);
+    return (off == (off_t)(index * c->op_size)) ? fs_read(ctx, index) : -1;
+}
+
+static int fs_seek_write(void *ctx, size_t index)
+{
+    fs_ctx_t *c = static_cast<fs_ctx_t *>(ctx);
+    off_t off = c->file->seek(index * c->op_size, SEEK_SET);
+    return (off == (off_t)(index * c->op_size)) ? fs_write(ctx, index) : -1;
+}
+
+struct fs_dir_ctx_t {
+    FileSystem *fs;
+};
+
+static void make_path(char *path, size_t index)
+{
+    sprintf(path, "dir/bench_file_%u", (unsigned int)index);
+}
+
+static int fs_create(void *ctx, size_t index)
+{
+    fs_dir_ctx_t *c = static_cast<fs_dir_ctx_t *>(ctx);
+    char path[32];
+    make_path(path, index);
+    File file;
+    int err = file.open(c->fs, path, O_WRONLY | O_CREAT | O_TRUNC);
+    return err ? err : file.close();
+}
+
+static int fs_open(void *ctx, size_t index)
+{
+    fs_dir_ctx_t *c = static_cast<fs_dir_ctx_t *>(ctx);
+    char path[32];
+    make_path(path, index);
+    File file;
+    int err = file.open(c->fs, path, O_RDONLY);
+    return err ? err : file.close();
+}
+
+static int fs_stat(void *ctx, size_t index)
+{
+    fs_dir_ctx_t *c = static_cast<fs_dir_ctx_t *>(ctx);
+    char path[32];
+    make_path(path, index);
+    struct stat st;
+    return c->fs->stat(path, &st);
+}
+
+/* Given a freshly formatted file system
+ * When a file is written and read sequentially and in random order
+ * Then the throughput and latencies of each operation are reported
+ */
+static void bench_fs(const char *target, FileSystem *fs)
+{
+    TEST_SKIP_UNLESS_MESSAGE(stack_init(), "Not enough storage to run test");
+
+    int err = fs->reformat(stack_bd);
+    TEST_ASSERT_EQUAL(0, err);
+
+    // Leave room for the file system and for the copies made on writes
+    size_t op_size = MBED_TEST_BENCH_OP_SIZE;
+    size_t count = std::min<size_t>(MBED_TEST_BENCH_OPS, stack_bd->size() / 4 / op_size);
+    TEST_SKIP_UNLESS_MESSAGE(count, "block device too small");
+
+    uint8_t *buffer = new (std::nothrow) uint8_t[op_size];
+    TEST_SKIP_UNLESS_MESSAGE(buffer, "Not enough heap to run test");
+    for (size_t i = 0; i < op_size; i++) {
+        buffer[i] = i & 0xff;
+    }
+
+    File file;
+    fs_ctx_t ctx = { &file, buffer, op_size };
+
+    err = file.open(fs, "bench", O_WRONLY | O_CREAT | O_TRUNC);
+    TEST_ASSERT_EQUAL(0, err);
+    bench_run(target, "seq_write", fs_write, &ctx, op_size, count, false);
+    err = file.close();
+    TEST_ASSERT_EQUAL(0, err);
+
+    err = file.open(fs, "bench", O_RDONLY);
+    TEST_ASSERT_EQUAL(0, err);
+    bench_run(target, "seq_read", fs_read, &ctx, op_size, count, false);
+    bench_run(target, "rand_read", fs_seek_read, &ctx, op_size, count, true);
+    err = file.close();
+    TEST_ASSERT_EQUAL(0, err);
+
+    err = file.open(fs, "bench", O_RDWR);
+    TEST_ASSERT_EQUAL(0, err);
+    bench_run(target, "rand_write", fs_seek_write, &ctx, op_size, count, true);
+    err = file.close();
+    TEST_ASSERT_EQUAL(0, err);
+
+    delete[] buffer;
+
+    // Name lookups in a directory with many entries
+    err = fs->mkdir("dir", 0777);
+    TEST_ASSERT_EQUAL(0, err);
+
+    size_t files = std::min(MBED_TEST_BENCH_FS_FILES, MBED_TEST_BENCH_OPS);
+    fs_dir_ctx_t dir_ctx = { fs };
+    bench_run(target, "create", fs_create, &dir_ctx, 0, files, false);
+    bench_run(target, "rand_open", fs_open, &dir_ctx, 0, files, true);
+    bench_run(target, "rand_stat", fs_stat, &dir_ctx, 0, files, true);
+
+    err = fs->unmount();
+    TEST_ASSERT_EQUAL(0, err);
+
+    stack_deinit();
+}
+
+static void bench_littlefs()
+{
+    LittleFileSystem fs("bench");
+    bench_fs("LittleFileSystem", &fs);
+}
+
+static void bench_fatfs()
+{
+    FATFileSystem fs("bench");
+    bench_fs("FATFileSystem", &fs);
+}
+
+/*----------------KVStores------------------*/
+
+struct kv_ctx_t {
+    KVStore *kv;
+    uint8_t *buffer;
+    size_t value_size;
+};
+
+static void make_key(char *key, size_t index)
+{
+    sprintf(key, "bench_key_%u", (unsigned int)index);
+}
+
+static int kv_get(void *ctx, size_t index)
+{
+    kv_ctx_t *c = static_cast<kv_ctx_t *>(ctx);
+    char key[32];
+    size_t actual_size;
+    make_key(key, index);
+    int err = c->kv->get(key, c->buffer, c->value_size, &actual_size);
+    return (err || actual_size == c->value_size) ? err : -1;
+}
+
+static int kv_set(void *ctx, size_t index)
+{
+    kv_ctx_t *c = static_cast<kv_ctx_t *>(ctx);
+    char key[32];
+    make_key(key, index);
+    return c->kv->set(key, c->buffer, c->value_size, 0);
+}
+
+/* Given a reset KVStore
+ * When keys are set and got in order and in random order
+ * Then the throughput and latencies of each operation are reported
+ */
+static void bench_kv(const char *target, KVStore *kv)
+{
+    int err = kv->init();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, err);
+    err = kv->reset();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, err);
+
+    size_t value_size = MBED_TEST_BENCH_KV_VALUE_SIZE;
+    size_t count = std::min(MBED_TEST_BENCH_KV_KEYS, MBED_TEST_BENCH_OPS);
+
+    uint8_t *buffer = new (std::nothrow) uint8_t[value_size];
+    TEST_SKIP_UNLESS_MESSAGE(buffer, "Not enough heap to run test");
+    for (size_t i = 0; i < value_size; i++) {
+        buffer[i] = i & 0xff;
+    }
+
+    kv_ctx_t ctx = { kv, buffer, value_size };
+    bench_run(target, "seq_write", kv_set, &ctx, value_size, count, false);
+    bench_run(target, "seq_read", kv_get, &ctx, value_size, count, false);
+    bench_run(target, "rand_read", kv_get, &ctx, value_size, count, true);
+    bench_run(target, "rand_write", kv_set, &ctx, value_size, count, true);
+
+    delete[] buffer;
+
+    err = kv->deinit();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, err);
+}
+
+static void bench_tdbstore()
+{
+    TEST_SKIP_UNLESS_MESSAGE(stack_init(), "Not enough storage to run test");
+
+    stack_bd->init();
+    int erase_val = stack_bd->get_erase_value();
+    stack_bd->deinit();
+
+    // TDBStore needs a defined erase value
+    FlashSimBlockDevice flash_bd(stack_bd);
+    TDBStore tdbs((erase_val == -1) ? static_cast<BlockDevice *>(&flash_bd) : stack_bd);
+    bench_kv("TDBStore", &tdbs);
+
+    stack_deinit();
+}
+
+static void bench_filesystemstore()
+{
+    TEST_SKIP_UNLESS_MESSAGE(stack_init(), "Not enough storage to run test");
+
+    LittleFileSystem fs("bench");
+    int err = fs.reformat(stack_bd);
+    TEST_ASSERT_EQUAL(0, err);
+
+    FileSystemStore fsst(&fs);
+    bench_kv("FileSystemStore", &fsst);
+
+    err = fs.unmount();
+    TEST_ASSERT_EQUAL(0, err);
+
+    stack_deinit();
+}
+
+#if SECURESTORE_ENABLED
+static void bench_securestore()
+{
+    TEST_SKIP_UNLESS_MESSAGE(stack_init(), "Not enough storage to run test");
+
+    stack_bd->init();
+    int erase_val = stack_bd->get_erase_value();
+    bd_size_t erase_size = stack_bd->get_erase_size(0);
+    bd_size_t size = stack_bd->size();
+    stack_bd->deinit();
+
+    // A quarter of the storage for rollback protection, like the default
+    // configuration of the internal storage
+    bd_size_t ul_size = align_up(size * 3 / 4, erase_size);
+    TEST_SKIP_UNLESS_MESSAGE(ul_size < size, "block device too small");
+
+    FlashSimBlockDevice flash_bd(stack_bd);
+    BlockDevice *bd = (erase_val == -1) ? static_cast<BlockDevice *>(&flash_bd) : stack_bd;
+    SlicingBlockDevice ul_bd(bd, 0, ul_size);
+    SlicingBlockDevice rbp_bd(bd, ul_size, size);
+    TDBStore ul_kv(&ul_bd);
+    TDBStore rbp_kv(&rbp_bd);
+    SecureStore sec_kv(&ul_kv, &rbp_kv);
+    bench_kv("SecureStore", &sec_kv);
+
+    stack_deinit();
+}
+#endif
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason)
+{
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+    Case("Benchmark: HeapBlockDevice", bench_heap_bd, greentea_failure_handler),
+#if COMPONENT_SPIF
+    Case("Benchmark: SPIFBlockDevice", bench_component_bd<spif>, greentea_failure_handler),
+#endif
+#if COMPONENT_QSPIF
+    Case("Benchmark: QSPIFBlockDevice", bench_component_bd<qspif>, greentea_failure_handler),
+#endif
+#if COMPONENT_DATAFLASH
+    Case("Benchmark: DataFlashBlockDevice", bench_component_bd<dataflash>, greentea_failure_handler),
+#endif
+#if COMPONENT_SD
+    Case("Benchmark: SDBlockDevice", bench_component_bd<sd>, greentea_failure_handler),
+#endif
+#if COMPONENT_FLASHIAP
+    Case("Benchmark: FlashIAPBlockDevice", bench_component_bd<flashiap>, greentea_failure_handler),
+#endif
+    Case("Benchmark: LittleFileSystem", bench_littlefs, greentea_failure_handler),
+    Case("Benchmark: FATFileSystem", bench_fatfs, greentea_failure_handler),
+    Case("Benchmark: TDBStore", bench_tdbstore, greentea_failure_handler),
+    Case("Benchmark: FileSystemStore", bench_filesystemstore, greentea_failure_handler),
+#if SECURESTORE_ENABLED
+    Case("Benchmark: SecureStore", bench_securestore, greentea_failure_handler),
+#endif
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(3000, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    return !Harness::run(specification);
+}
@@ -175,6 +175,87 @@ void functionality_test()
     }
 }
 
+void multi_line_test()
+{
+    const bd_size_t heap_read_size = 1;
+    const bd_size_t heap_prog_size = 128;
+    const uint32_t cache_lines = 2;
+
+    uint8_t *read_buf, *write_buf;
+    read_buf = new (std::nothrow) uint8_t[heap_erase_size];
+    TEST_SKIP_UNLESS_MESSAGE(read_buf, "Not enough memory for test");
+    write_buf = new (std::nothrow) uint8_t[heap_erase_size];
+    TEST_SKIP_UNLESS_MESSAGE(write_buf, "Not enough memory for test");
+
+    uint8_t *dummy = new (std::nothrow) uint8_t[num_blocks * heap_erase_size + cache_lines * heap_prog_size + heap_read_size];
+    TEST_SKIP_UNLESS_MESSAGE(dummy, "Not enough memory for test");
+    delete[] dummy;
+
+    HeapBlockDevice *heap_bd = new HeapBlockDevice(num_blocks * heap_erase_size, heap_read_size, heap_prog_size, heap_erase_size);
+    BufferedBlockDevice *bd = new BufferedBlockDevice(heap_bd, cache_lines);
+
+    int err = bd->init();
+    TEST_ASSERT_EQUAL(0, err);
+
+    for (bd_size_t i = 0; i < num_blocks; i++) {
+        memset(write_buf, i, heap_erase_size);
+        err = heap_bd->program(write_buf, i * heap_erase_size, heap_erase_size);
+        TEST_SKIP_UNLESS_MESSAGE(!err, "Not enough memory for test");
+    }
+
+    // Interleaved partial programs to two units stay in the cache
+    memset(write_buf, 0x5A, 8);
+    for (int i = 0; i < 4; i++) {
+        err = bd->program(write_buf, heap_erase_size + i * 8, 8);
+        TEST_ASSERT_EQUAL(0, err);
+        err = bd->program(write_buf, 2 * heap_erase_size + i * 8, 8);
+        TEST_ASSERT_EQUAL(0, err);
+    }
+
+    memset(write_buf, 1, heap_erase_size);
+    err = heap_bd->read(read_buf, heap_erase_size, heap_erase_size);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_buf, read_buf, heap_erase_size);
+    memset(write_buf, 0x5A, 32);
+    err = bd->read(read_buf, heap_erase_size, heap_erase_size);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_buf, read_buf, heap_erase_size);
+
+    // The read made the first unit the most recently used one, so a third
+    // unit evicts the second
+    err = bd->program(write_buf, 3 * heap_erase_size, 8);
+    TEST_ASSERT_EQUAL(0, err);
+    memset(write_buf, 2, heap_erase_size);
+    memset(write_buf, 0x5A, 32);
+    err = heap_bd->read(read_buf, 2 * heap_erase_size, heap_erase_size);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_buf, read_buf, heap_erase_size);
+    memset(write_buf, 1, heap_erase_size);
+    err = heap_bd->read(read_buf, heap_erase_size, heap_erase_size);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_buf, read_buf, heap_erase_size);
+
+    // Sync programs everything left
+    err = bd->sync();
+    TEST_ASSERT_EQUAL(0, err);
+    memset(write_buf, 0x5A, 32);
+    err = heap_bd->read(read_buf, heap_erase_size, heap_erase_size);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_buf, read_buf, heap_erase_size);
+    memset(write_buf, 3, heap_erase_size);
+    memset(write_buf, 0x5A, 8);
+    err = heap_bd->read(read_buf, 3 * heap_erase_size, heap_erase_size);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_buf, read_buf, heap_erase_size);
+
+    bd->deinit();
+
+    delete[] read_buf;
+    delete[] write_buf;
+    delete bd;
+    delete heap_bd;
+}
+
 // Test setup
 utest::v1::status_t test_setup(const size_t number_of_cases)
 {
@@ -184,6 +265,7 @@ utest::v1::status_t test_setup(const size_t number_of_cases)
 
 Case cases[] = {
     Case("BufferedBlockDevice functionality test", functionality_test),
+    Case("BufferedBlockDevice multi-line cache test", multi_line_test),
 };
 
 Specification specification(test_setup, cases);
@@ -0,0 +1,219 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+
+#include "DeltaPatchWriter.h"
+#include "HeapBlockDevice.h"
+#include <stdlib.h>
+
+using namespace utest::v1;
+
+static const bd_size_t heap_erase_size = 512;
+static const bd_size_t num_blocks = 8;
+static const bd_size_t image_size = 3000;
+
+// The new image keeps the start of the source image with a few bytes
+// changed, inserts new bytes, and drops part of the source image
+static const bd_size_t kept_size = 1000;
+static const bd_size_t inserted_size = 100;
+static const bd_size_t dropped_size = 500;
+static const bd_size_t new_size = image_size - dropped_size + inserted_size;
+
+static uint8_t source_image[image_size];
+static uint8_t new_image[new_size];
+static uint8_t patch[new_size + 64];
+
+static size_t put_varint(uint8_t *buf, uint64_t val)
+{
+    size_t len = 0;
+    while (val >= 0x80) {
+        buf[len++] = (val & 0x7F) | 0x80;
+        val >>= 7;
+    }
+    buf[len++] = val;
+    return len;
+}
+
+static size_t make_patch()
+{
+    srand(1);
+    for (bd_size_t i = 0; i < image_size; i++) {
+        source_image[i] = 0xff & rand();
+    }
+
+    memcpy(new_image, source_image, kept_size);
+    new_image[10] ^= 0x55;
+    new_image[kept_size - 1] += 1;
+    for (bd_size_t i = 0; i < inserted_size; i++) {
+        new_image[kept_size + i] = 0xff & rand();
+    }
+    memcpy(new_image + kept_size + inserted_size, source_image + kept_size + dropped_size,
+           image_size - kept_size - dropped_size);
+
+    size_t len = 0;
+    memcpy(patch, "MBDP", 4);
+    len += 4;
+    len += put_varint(patch + len, new_size);
+
+    // Kept bytes as a diff, inserted bytes as extra, then skip the dropped bytes
+    len += put_varint(patch + len, kept_size);
+    for (bd_size_t i = 0; i < kept_size; i++) {
+        patch[len++] = new_image[i] - source_image[i];
+    }
+    len += put_varint(patch + len, inserted_size);
+    memcpy(patch + len, new_image + kept_size, inserted_size);
+    len += inserted_size;
+    len += put_varint(patch + len, 2 * dropped_size);
+
+    // The rest is unchanged, no extra, no move
+    len += put_varint(patch + len, image_size - kept_size - dropped_size);
+    for (bd_size_t i = kept_size + inserted_size; i < new_size; i++) {
+        patch[len++] = 0;
+    }
+    len += put_varint(patch + len, 0);
+    len += put_varint(patch + len, 0);
+    return len;
+}
+
+void test_apply_patch()
+{
+    uint8_t *dummy = new (std::nothrow) uint8_t[2 * num_blocks * heap_erase_size];
+    TEST_SKIP_UNLESS_MESSAGE(dummy, "Not enough memory for test");
+    delete[] dummy;
+
+    size_t patch_size = make_patch();
+
+    HeapBlockDevice source(num_blocks * heap_erase_size, 1, 1, heap_erase_size);
+    HeapBlockDevice dest(num_blocks * heap_erase_size, 1, 16, heap_erase_size);
+
+    int err = source.init();
+    TEST_ASSERT_EQUAL(0, err);
+    err = source.erase(0, source.size());
+    TEST_ASSERT_EQUAL(0, err);
+    err = source.program(source_image, 0, image_size);
+    TEST_ASSERT_EQUAL(0, err);
+
+    DeltaPatchWriter patcher(&source, &dest, 64);
+    err = patcher.init();
+    TEST_ASSERT_EQUAL(0, err);
+
+    // Feed the patch in odd sized pieces, splitting varints and records
+    for (size_t offset = 0; offset < patch_size; offset += 7) {
+        size_t size = patch_size - offset < 7 ? patch_size - offset : 7;
+        err = patcher.write(patch + offset, size);
+        TEST_ASSERT_EQUAL(0, err);
+    }
+    TEST_ASSERT_EQUAL(new_size, patcher.get_image_size());
+    TEST_ASSERT_EQUAL(new_size, patcher.get_written_size());
+
+    err = patcher.finish();
+    TEST_ASSERT_EQUAL(0, err);
+
+    uint8_t *read_buf = new (std::nothrow) uint8_t[new_size];
+    TEST_SKIP_UNLESS_MESSAGE(read_buf, "Not enough memory for test");
+    err = dest.read(read_buf, 0, new_size);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(new_image, read_buf, new_size);
+    delete[] read_buf;
+
+    err = patcher.deinit();
+    TEST_ASSERT_EQUAL(0, err);
+    source.deinit();
+}
+
+void test_bad_patch()
+{
+    uint8_t *dummy = new (std::nothrow) uint8_t[2 * num_blocks * heap_erase_size];
+    TEST_SKIP_UNLESS_MESSAGE(dummy, "Not enough memory for test");
+    delete[] dummy;
+
+    size_t patch_size = make_patch();
+
+    HeapBlockDevice source(num_blocks * heap_erase_size, 1, 1, heap_erase_size);
+    HeapBlockDevice dest(num_blocks * heap_erase_size, 1, 16, heap_erase_size);
+    DeltaPatchWriter patcher(&source, &dest);
+
+    // Truncated patch
+    int err = patcher.init();
+    TEST_ASSERT_EQUAL(0, err);
+    err = patcher.write(patch, patch_size - 1);
+    TEST_ASSERT_EQUAL(0, err);
+    err = patcher.finish();
+    TEST_ASSERT_EQUAL(DELTA_PATCH_ERROR_INCOMPLETE, err);
+    patcher.deinit();
+
+    // Trailing data after the last record
+    err = patcher.init();
+    TEST_ASSERT_EQUAL(0, err);
+    err = patcher.write(patch, patch_size);
+    TEST_ASSERT_EQUAL(0, err);
+    err = patcher.write(patch, 1);
+    TEST_ASSERT_EQUAL(DELTA_PATCH_ERROR_CORRUPT, err);
+    err = patcher.finish();
+    TEST_ASSERT_EQUAL(DELTA_PATCH_ERROR_CORRUPT, err);
+    patcher.deinit();
+
+    // Bad magic
+    err = patcher.init();
+    TEST_ASSERT_EQUAL(0, err);
+    err = patcher.write("MBDX", 4);
+    TEST_ASSERT_EQUAL(DELTA_PATCH_ERROR_CORRUPT, err);
+    patcher.deinit();
+
+    // New image larger than the destination
+    uint8_t header[16];
+    size_t len = 4;
+    memcpy(header, "MBDP", 4);
+    len += put_varint(header + len, dest.size() + 1);
+    err = patcher.init();
+    TEST_ASSERT_EQUAL(0, err);
+    err = patcher.write(header, len);
+    TEST_ASSERT_EQUAL(DELTA_PATCH_ERROR_SIZE, err);
+    patcher.deinit();
+
+    // Moving before the start of the source image
+    len = 4;
+    len += put_varint(header + len, 1);
+    len += put_varint(header + len, 0);
+    len += put_varint(header + len, 0);
+    len += put_varint(header + len, 1);
+    err = patcher.init();
+    TEST_ASSERT_EQUAL(0, err);
+    err = patcher.write(header, len);
+    TEST_ASSERT_EQUAL(DELTA_PATCH_ERROR_CORRUPT, err);
+    patcher.deinit();
+}
+
+// Test setup
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(30, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("DeltaPatchWriter apply test", test_apply_patch),
+    Case("DeltaPatchWriter bad patch test", test_bad_patch),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
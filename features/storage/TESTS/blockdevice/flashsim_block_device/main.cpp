@@ -125,6 +125,62 @@ void functionality_test()
     err = bd.read(read_buf, 0, test_buf_size);
     TEST_ASSERT_EQUAL(0, err);
     TEST_ASSERT_EQUAL_UINT8_ARRAY(write_buf, read_buf, test_buf_size);
+
+}
+
+// Virtual clock of the timing model
+void timing_test()
+{
+    uint8_t *dummy = new (std::nothrow) uint8_t[num_blocks * erase_size];
+    TEST_SKIP_UNLESS_MESSAGE(dummy, "Not enough memory for test");
+    delete[] dummy;
+
+    HeapBlockDevice heap_bd(num_blocks * erase_size, read_size, prog_size, erase_size);
+    FlashSimBlockDevice bd(&heap_bd, blank);
+    TEST_ASSERT_EQUAL(0, bd.init());
+
+    uint8_t buf[test_buf_size];
+    memset(buf, 0x5A, sizeof(buf));
+
+    // Instant without a timing
+    TEST_ASSERT_EQUAL(0, bd.erase(0, erase_size));
+    TEST_ASSERT_EQUAL(0, bd.program(buf, 0, test_buf_size));
+    TEST_ASSERT_EQUAL(0, bd.read(buf, 0, test_buf_size));
+    TEST_ASSERT_EQUAL_UINT64(0, bd.get_time_ns());
+
+    flash_sim_timing_t timing = {};
+    timing.read_ns = 100;
+    timing.read_byte_ns = 10;
+    timing.program_page_ns = 1000;
+    timing.program_page_size = 32;
+    timing.erase_ns = 100000;
+    bd.set_timing(timing);
+
+    TEST_ASSERT_EQUAL(0, bd.erase(0, 2 * erase_size));
+    TEST_ASSERT_EQUAL_UINT64(200000, bd.get_time_ns());
+    // Three pages touched
+    TEST_ASSERT_EQUAL(0, bd.program(buf, 24, 48));
+    TEST_ASSERT_EQUAL_UINT64(203000, bd.get_time_ns());
+    TEST_ASSERT_EQUAL(0, bd.read(buf, 0, test_buf_size));
+    TEST_ASSERT_EQUAL_UINT64(203000 + 100 + 640, bd.get_time_ns());
+
+    // Background erase, suspended by a read
+    timing.erase_suspend = true;
+    timing.suspend_ns = 20000;
+    timing.resume_ns = 30000;
+    bd.set_timing(timing);
+    bd.reset_time();
+
+    TEST_ASSERT_EQUAL(0, bd.erase(erase_size, erase_size));
+    TEST_ASSERT_EQUAL_UINT64(0, bd.get_time_ns());
+    bd.advance_time(10000);
+    TEST_ASSERT_EQUAL(0, bd.read(buf, 0, test_buf_size));
+    TEST_ASSERT_EQUAL_UINT64(10000 + 50000 + 740, bd.get_time_ns());
+    // The erase ends later by the time of the read
+    TEST_ASSERT_EQUAL(0, bd.sync());
+    TEST_ASSERT_EQUAL_UINT64(100000 + 50000 + 740, bd.get_time_ns());
+
+    TEST_ASSERT_EQUAL(0, bd.deinit());
 }
 
 
@@ -137,6 +193,7 @@ utest::v1::status_t test_setup(const size_t number_of_cases)
 
 Case cases[] = {
     Case("FlashSimBlockDevice functionality test", functionality_test),
+    Case("FlashSimBlockDevice timing test", timing_test),
 };
 
 Specification specification(test_setup, cases);
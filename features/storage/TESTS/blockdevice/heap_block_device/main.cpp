@@ -167,6 +167,36 @@ void test_get_type_functionality()
     TEST_ASSERT_EQUAL(0, strcmp(bd_type, "HEAP"));
 }
 
+void test_arena()
+{
+    static uint8_t arena[4 * TEST_BLOCK_SIZE];
+    uint8_t write_block[TEST_BLOCK_SIZE + 16];
+    uint8_t read_block[TEST_BLOCK_SIZE + 16];
+
+    HeapBlockDevice bd(sizeof(arena), 1, 1, TEST_BLOCK_SIZE, arena);
+    TEST_ASSERT_EQUAL(0, bd.init());
+    TEST_ASSERT_EQUAL_PTR(arena, bd.get_buffer());
+    TEST_ASSERT_EQUAL(sizeof(arena), bd.size());
+
+    // Program and read across a block boundary
+    for (size_t i = 0; i < sizeof(write_block); i++) {
+        write_block[i] = 0xff & rand();
+    }
+    TEST_ASSERT_EQUAL(0, bd.erase(0, 2 * TEST_BLOCK_SIZE));
+    TEST_ASSERT_EQUAL(0, bd.program(write_block, TEST_BLOCK_SIZE - 8, sizeof(write_block)));
+    TEST_ASSERT_EQUAL(0, bd.read(read_block, TEST_BLOCK_SIZE - 8, sizeof(read_block)));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_block, read_block, sizeof(write_block));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_block, &arena[TEST_BLOCK_SIZE - 8], sizeof(write_block));
+    TEST_ASSERT_EQUAL(0, bd.deinit());
+
+    // The contents are kept by a new device on the same arena
+    HeapBlockDevice bd2(sizeof(arena), 1, 1, TEST_BLOCK_SIZE, arena);
+    TEST_ASSERT_EQUAL(0, bd2.init());
+    memset(read_block, 0, sizeof(read_block));
+    TEST_ASSERT_EQUAL(0, bd2.read(read_block, TEST_BLOCK_SIZE - 8, sizeof(read_block)));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_block, read_block, sizeof(write_block));
+    TEST_ASSERT_EQUAL(0, bd2.deinit());
+}
 
 // Test setup
 utest::v1::status_t test_setup(const size_t number_of_cases)
@@ -177,7 +207,8 @@ utest::v1::status_t test_setup(const size_t number_of_cases)
 
 Case cases[] = {
     Case("Testing read write random blocks", test_read_write),
-    Case("Testing get type functionality", test_get_type_functionality)
+    Case("Testing get type functionality", test_get_type_functionality),
+    Case("Testing contiguous arena", test_arena)
 };
 
 Specification specification(test_setup, cases);
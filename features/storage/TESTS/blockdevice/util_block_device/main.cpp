@@ -22,6 +22,8 @@
 #include "SlicingBlockDevice.h"
 #include "ChainingBlockDevice.h"
 #include "ProfilingBlockDevice.h"
+#include "WearStatsBlockDevice.h"
+#include "StripingBlockDevice.h"
 #include <stdlib.h>
 
 using namespace utest::v1;
@@ -141,6 +143,72 @@ end:
     delete[] read_block;
 }
 
+// Test of slices of a slice, which map straight to the underlying device
+void test_nested_slicing()
+{
+    uint8_t *dummy = new (std::nothrow) uint8_t[BLOCK_COUNT * BLOCK_SIZE];
+    TEST_SKIP_UNLESS_MESSAGE(dummy, "Not enough memory for test");
+    delete[] dummy;
+
+    int err;
+    bd_addr_t offset;
+
+    HeapBlockDevice bd(BLOCK_COUNT * BLOCK_SIZE, BLOCK_SIZE);
+
+    SlicingBlockDevice outer(&bd, BLOCK_SIZE, -BLOCK_SIZE);
+    SlicingBlockDevice middle(&outer, BLOCK_SIZE);
+    SlicingBlockDevice inner(&middle, BLOCK_SIZE, -BLOCK_SIZE);
+
+    err = inner.init();
+    TEST_ASSERT_EQUAL(0, err);
+
+    TEST_ASSERT_EQUAL((BLOCK_COUNT - 5) * BLOCK_SIZE, inner.size());
+    TEST_ASSERT_EQUAL_PTR(&bd, inner.get_mapped_device(&offset));
+    TEST_ASSERT_EQUAL(3 * BLOCK_SIZE, offset);
+    TEST_ASSERT_EQUAL_PTR(&bd, middle.get_mapped_device(&offset));
+    TEST_ASSERT_EQUAL(2 * BLOCK_SIZE, offset);
+
+    uint8_t *write_block = new (std::nothrow) uint8_t[BLOCK_SIZE];
+    uint8_t *read_block = new (std::nothrow) uint8_t[BLOCK_SIZE];
+    if (!write_block || !read_block) {
+        printf("Not enough memory for test");
+        goto end;
+    }
+
+    // Fill with random sequence
+    srand(1);
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+        write_block[i] = 0xff & rand();
+    }
+
+    // Write the last block of the inner slice, and read it back
+    err = inner.erase(inner.size() - BLOCK_SIZE, BLOCK_SIZE);
+    TEST_ASSERT_EQUAL(0, err);
+
+    err = inner.program(write_block, inner.size() - BLOCK_SIZE, BLOCK_SIZE);
+    TEST_ASSERT_EQUAL(0, err);
+
+    err = inner.read(read_block, inner.size() - BLOCK_SIZE, BLOCK_SIZE);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_block, read_block, BLOCK_SIZE);
+
+    // Check through the outer slice and the original block device
+    err = outer.read(read_block, (BLOCK_COUNT - 4) * BLOCK_SIZE, BLOCK_SIZE);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_block, read_block, BLOCK_SIZE);
+
+    err = bd.read(read_block, (BLOCK_COUNT - 3) * BLOCK_SIZE, BLOCK_SIZE);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_block, read_block, BLOCK_SIZE);
+
+    err = inner.deinit();
+    TEST_ASSERT_EQUAL(0, err);
+
+end:
+    delete[] write_block;
+    delete[] read_block;
+}
+
 // Simple test which read/writes blocks on a chain of block devices
 void test_chaining()
 {
@@ -289,6 +357,191 @@ end:
 }
 
 
+// Test which checks the wear stats of a block device survive deinit
+void test_wear_stats()
+{
+    uint8_t *dummy = new (std::nothrow) uint8_t[BLOCK_COUNT * BLOCK_SIZE];
+    TEST_SKIP_UNLESS_MESSAGE(dummy, "Not enough memory for test");
+    delete[] dummy;
+
+    int err;
+    uint32_t ops;
+
+    HeapBlockDevice bd(BLOCK_COUNT * BLOCK_SIZE, BLOCK_SIZE);
+    // Keep the stats in the last block
+    WearStatsBlockDevice stats(&bd, BLOCK_SIZE);
+
+    err = stats.init();
+    TEST_ASSERT_EQUAL(0, err);
+
+    TEST_ASSERT_EQUAL((BLOCK_COUNT - 1) * BLOCK_SIZE, stats.size());
+    TEST_ASSERT_EQUAL(BLOCK_COUNT, stats.get_unit_count());
+
+    uint8_t *write_block = new (std::nothrow) uint8_t[BLOCK_SIZE];
+    uint8_t *read_block = new (std::nothrow) uint8_t[BLOCK_SIZE];
+
+    if (!write_block || !read_block) {
+        printf("Not enough memory for test");
+        goto end;
+    }
+
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+        write_block[i] = 0xff & rand();
+    }
+
+    // Erase the second block twice, and write half a block's worth of data in it
+    err = stats.erase(0, 2 * BLOCK_SIZE);
+    TEST_ASSERT_EQUAL(0, err);
+
+    err = stats.erase(BLOCK_SIZE, BLOCK_SIZE);
+    TEST_ASSERT_EQUAL(0, err);
+
+    err = stats.program(write_block, BLOCK_SIZE, BLOCK_SIZE);
+    TEST_ASSERT_EQUAL(0, err);
+    stats.add_requested_count(BLOCK_SIZE / 2);
+
+    err = stats.read(read_block, BLOCK_SIZE, BLOCK_SIZE);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_block, read_block, BLOCK_SIZE);
+
+    // Store the stats and load them back
+    err = stats.deinit();
+    TEST_ASSERT_EQUAL(0, err);
+
+    err = stats.init();
+    TEST_ASSERT_EQUAL(0, err);
+
+    TEST_ASSERT_EQUAL(1, stats.get_unit_erase_count(0));
+    TEST_ASSERT_EQUAL(2, stats.get_unit_erase_count(BLOCK_SIZE));
+    TEST_ASSERT_EQUAL(0, stats.get_unit_erase_count(2 * BLOCK_SIZE));
+    TEST_ASSERT_EQUAL(1, stats.get_unit_erase_count((BLOCK_COUNT - 1) * BLOCK_SIZE));
+    TEST_ASSERT_EQUAL(2, stats.get_max_erase_count());
+
+    TEST_ASSERT_EQUAL(BLOCK_SIZE / 2, stats.get_requested_count());
+    TEST_ASSERT_EQUAL(BLOCK_SIZE, stats.get_read_count());
+    TEST_ASSERT_EQUAL(BLOCK_SIZE, stats.get_program_count());
+    TEST_ASSERT_EQUAL(3 * BLOCK_SIZE, stats.get_erase_count());
+
+    ops = 0;
+    for (int i = 0; i < WearStatsBlockDevice::HISTOGRAM_BUCKETS; i++) {
+        ops += stats.get_latency_count(WearStatsBlockDevice::OP_ERASE, i);
+    }
+    TEST_ASSERT_EQUAL(2, ops);
+
+    stats.reset();
+    TEST_ASSERT_EQUAL(0, stats.get_max_erase_count());
+    TEST_ASSERT_EQUAL(0, stats.get_erase_count());
+
+    err = stats.deinit();
+    TEST_ASSERT_EQUAL(0, err);
+
+end:
+    delete[] write_block;
+    delete[] read_block;
+}
+
+
+static volatile int striping_result;
+
+static void striping_done(int err)
+{
+    striping_result = err;
+}
+
+// Simple test which read/writes blocks striped over block devices
+void test_striping()
+{
+    uint8_t *dummy = new (std::nothrow) uint8_t[2 * BLOCK_COUNT * BLOCK_SIZE];
+    TEST_SKIP_UNLESS_MESSAGE(dummy, "Not enough memory for test");
+    delete[] dummy;
+
+    int err;
+
+    HeapBlockDevice bd1((BLOCK_COUNT / 2)*BLOCK_SIZE, BLOCK_SIZE / 2, BLOCK_SIZE / 2, BLOCK_SIZE);
+    HeapBlockDevice bd2((BLOCK_COUNT / 2)*BLOCK_SIZE, BLOCK_SIZE / 2, BLOCK_SIZE / 2, BLOCK_SIZE);
+
+    // Test with block devices striped every block
+    BlockDevice *bds[] = {&bd1, &bd2};
+    StripingBlockDevice striped(bds);
+
+    const bd_size_t size = 5 * BLOCK_SIZE;
+    uint8_t *write_block = new (std::nothrow) uint8_t[size];
+    uint8_t *read_block = new (std::nothrow) uint8_t[size];
+
+    if (!write_block || !read_block) {
+        printf("Not enough memory for test");
+        goto end;
+    }
+
+    err = striped.init();
+    TEST_ASSERT_EQUAL(0, err);
+
+    TEST_ASSERT_EQUAL(BLOCK_SIZE / 2, striped.get_program_size());
+    TEST_ASSERT_EQUAL(BLOCK_SIZE, striped.get_erase_size());
+    TEST_ASSERT_EQUAL(BLOCK_COUNT * BLOCK_SIZE, striped.size());
+
+    // Fill with random sequence
+    srand(1);
+    for (bd_size_t i = 0; i < size; i++) {
+        write_block[i] = 0xff & rand();
+    }
+
+    // Write across stripes, starting in the middle of one
+    err = striped.erase(0, size);
+    TEST_ASSERT_EQUAL(0, err);
+
+    err = striped.program(write_block, BLOCK_SIZE / 2, size - BLOCK_SIZE);
+    TEST_ASSERT_EQUAL(0, err);
+
+    err = striped.read(read_block, BLOCK_SIZE / 2, size - BLOCK_SIZE);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_block, read_block, size - BLOCK_SIZE);
+
+    // Check that consecutive stripes alternate between the block devices
+    err = bd1.read(read_block, BLOCK_SIZE / 2, BLOCK_SIZE / 2);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_block, read_block, BLOCK_SIZE / 2);
+
+    err = bd2.read(read_block, 0, BLOCK_SIZE);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_block + BLOCK_SIZE / 2, read_block, BLOCK_SIZE);
+
+    err = bd1.read(read_block, BLOCK_SIZE, BLOCK_SIZE);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_block + 3 * BLOCK_SIZE / 2, read_block, BLOCK_SIZE);
+
+    // Same through the asynchronous requests, starting on the second block device
+    striping_result = 1;
+    err = striped.erase_async(7 * BLOCK_SIZE, size, striping_done);
+    TEST_ASSERT_EQUAL(0, err);
+    while (striping_result == 1);
+    TEST_ASSERT_EQUAL(0, striping_result);
+
+    striping_result = 1;
+    err = striped.program_async(write_block, 7 * BLOCK_SIZE, size, striping_done);
+    TEST_ASSERT_EQUAL(0, err);
+    while (striping_result == 1);
+    TEST_ASSERT_EQUAL(0, striping_result);
+
+    striping_result = 1;
+    err = striped.read_async(read_block, 7 * BLOCK_SIZE, size, striping_done);
+    TEST_ASSERT_EQUAL(0, err);
+    while (striping_result == 1);
+    TEST_ASSERT_EQUAL(0, striping_result);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_block, read_block, size);
+
+    err = bd2.read(read_block, 3 * BLOCK_SIZE, BLOCK_SIZE);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_block, read_block, BLOCK_SIZE);
+
+    err = striped.deinit();
+    TEST_ASSERT_EQUAL(0, err);
+
+end:
+    delete[] write_block;
+    delete[] read_block;
+}
+
 // Test setup
 utest::v1::status_t test_setup(const size_t number_of_cases)
 {
@@ -298,8 +551,11 @@ utest::v1::status_t test_setup(const size_t number_of_cases)
 
 Case cases[] = {
     Case("Testing slicing of a block device", test_slicing),
+    Case("Testing nested slicing of a block device", test_nested_slicing),
     Case("Testing chaining of block devices", test_chaining),
     Case("Testing profiling of block devices", test_profiling),
+    Case("Testing wear stats of block devices", test_wear_stats),
+    Case("Testing striping of block devices", test_striping),
 };
 
 Specification specification(test_setup, cases);
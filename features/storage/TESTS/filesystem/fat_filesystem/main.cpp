@@ -102,6 +102,65 @@ void test_read_write()
 }
 
 
+// Test random seeks in a fragmented file opened read-only
+#define SEEK_CHUNK_SIZE 64
+#define SEEK_CHUNK_COUNT 64
+void test_seek_fragmented()
+{
+    TEST_SKIP_UNLESS_MESSAGE(bd, "Not enough heap memory to run test. Test skipped.");
+
+    FATFileSystem fs("fat");
+
+    int err = fs.mount(bd);
+    TEST_ASSERT_EQUAL(0, err);
+
+    uint8_t buffer[SEEK_CHUNK_SIZE];
+
+    // Interleave the writes of two files so their cluster chains are fragmented
+    File file, other;
+    err = file.open(&fs, "test_seek.dat", O_WRONLY | O_CREAT);
+    TEST_ASSERT_EQUAL(0, err);
+    err = other.open(&fs, "test_seek_other.dat", O_WRONLY | O_CREAT);
+    TEST_ASSERT_EQUAL(0, err);
+    for (int i = 0; i < SEEK_CHUNK_COUNT; i++) {
+        memset(buffer, i, SEEK_CHUNK_SIZE);
+        TEST_ASSERT_EQUAL(SEEK_CHUNK_SIZE, file.write(buffer, SEEK_CHUNK_SIZE));
+        if (i % 8 == 7) {
+            err = file.sync();
+            TEST_ASSERT_EQUAL(0, err);
+            for (int j = 0; j < BLOCK_SIZE / SEEK_CHUNK_SIZE; j++) {
+                TEST_ASSERT_EQUAL(SEEK_CHUNK_SIZE, other.write(buffer, SEEK_CHUNK_SIZE));
+            }
+            err = other.sync();
+            TEST_ASSERT_EQUAL(0, err);
+        }
+    }
+    err = file.close();
+    TEST_ASSERT_EQUAL(0, err);
+    err = other.close();
+    TEST_ASSERT_EQUAL(0, err);
+
+    err = file.open(&fs, "test_seek.dat", O_RDONLY);
+    TEST_ASSERT_EQUAL(0, err);
+    srand(1);
+    for (int i = 0; i < 2 * SEEK_CHUNK_COUNT; i++) {
+        int chunk = rand() % SEEK_CHUNK_COUNT;
+        TEST_ASSERT_EQUAL(chunk * SEEK_CHUNK_SIZE, file.seek(chunk * SEEK_CHUNK_SIZE, SEEK_SET));
+        TEST_ASSERT_EQUAL(SEEK_CHUNK_SIZE, file.read(buffer, SEEK_CHUNK_SIZE));
+        for (int j = 0; j < SEEK_CHUNK_SIZE; j++) {
+            TEST_ASSERT_EQUAL(chunk, buffer[j]);
+        }
+    }
+    // Seeking past the end of a read-only file stops at the end
+    TEST_ASSERT_EQUAL(SEEK_CHUNK_COUNT * SEEK_CHUNK_SIZE, file.seek(SEEK_CHUNK_SIZE, SEEK_END));
+    err = file.close();
+    TEST_ASSERT_EQUAL(0, err);
+
+    err = fs.unmount();
+    TEST_ASSERT_EQUAL(0, err);
+}
+
+
 // Simple test for iterating dir entries
 void test_read_dir()
 {
@@ -180,6 +239,7 @@ Case cases[] = {
     Case("Testing formating", test_format),
     Case("Testing read write < block", test_read_write < BLOCK_SIZE / 2 >),
     Case("Testing read write > block", test_read_write<2 * BLOCK_SIZE>),
+    Case("Testing seek in fragmented file", test_seek_fragmented),
     Case("Testing dir iteration", test_read_dir),
 };
 
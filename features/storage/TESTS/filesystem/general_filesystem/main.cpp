@@ -18,6 +18,7 @@
 #include "utest/utest.h"
 #include "BlockDevice.h"
 #include "FileSystem.h"
+#include "Dir.h"
 
 #include <stdlib.h>
 #if COMPONENT_SPIF
@@ -1988,6 +1989,61 @@ static void FS_fill_data_and_seek()
     TEST_ASSERT_EQUAL(0, res);
 }
 
+//list a directory in batches, check names, types and sizes against the files written
+static void FS_dir_read_many()
+{
+    char name[32];
+    int res = mkdir("/default/" "list", 0777);
+    TEST_ASSERT_EQUAL(0, res);
+
+    for (int i = 0; i < 5; i++) {
+        sprintf(name, "/default/" "list/file%d", i);
+        fd[0] = fopen(name, "w");
+        TEST_ASSERT_NOT_NULL(fd[0]);
+        for (int j = 0; j < i * 10; j++) {
+            res = fputc(j, fd[0]);
+            TEST_ASSERT_EQUAL(j, res);
+        }
+        res = fclose(fd[0]);
+        TEST_ASSERT_EQUAL(0, res);
+    }
+
+    Dir dir;
+    res = dir.open(fs, "list");
+    TEST_ASSERT_EQUAL(0, res);
+
+    fs_dirent_t ents[2];
+    int files = 0;
+    int sizes = 0;
+    while ((res = dir.read_many(ents, 2)) > 0) {
+        TEST_ASSERT(res <= 2);
+        for (int i = 0; i < res; i++) {
+            if (ents[i].ent.d_type == DT_DIR) {
+                continue;
+            }
+            TEST_ASSERT_EQUAL(DT_REG, ents[i].ent.d_type);
+            TEST_ASSERT_EQUAL(0, strncmp(ents[i].ent.d_name, "file", 4));
+            TEST_ASSERT_EQUAL((ents[i].ent.d_name[4] - '0') * 10, ents[i].size);
+            files += 1;
+            sizes += ents[i].size;
+        }
+    }
+    TEST_ASSERT_EQUAL(0, res);
+    TEST_ASSERT_EQUAL(5, files);
+    TEST_ASSERT_EQUAL(100, sizes);
+
+    res = dir.close();
+    TEST_ASSERT_EQUAL(0, res);
+
+    for (int i = 0; i < 5; i++) {
+        sprintf(name, "/default/" "list/file%d", i);
+        res = remove(name);
+        TEST_ASSERT_EQUAL(0, res);
+    }
+    res = remove("/default/" "list");
+    TEST_ASSERT_EQUAL(0, res);
+}
+
 //deinit the blockdevice and unmount the filesystem
 static void bd_deinit_fs_unmount()
 {
@@ -2089,6 +2145,7 @@ Case cases[] = {
 
     Case("FS_write_read_random_data", FS_write_read_random_data),
     Case("FS_fill_data_and_seek", FS_fill_data_and_seek),
+    Case("FS_dir_read_many", FS_dir_read_many),
 
     Case("bd_deinit_fs_unmount", bd_deinit_fs_unmount),
 };
@@ -510,7 +510,73 @@ static void multi_set_test()
 }
 #endif
 
+static void value_cache_test()
+{
+    uint8_t get_buf[64];
+    size_t actual_data_size;
+    int result;
+    KVStore::info_t info;
+
+    uint8_t *dummy = new (std::nothrow) uint8_t[heap_alloc_threshold_size];
+    TEST_SKIP_UNLESS_MESSAGE(dummy, "Not enough heap to run test");
+    delete[] dummy;
+
+    TDBStore *ul_kv = new TDBStore(&ul_bd);
+    TDBStore *rbp_kv = new TDBStore(&rbp_bd);
+    SecureStore *sec_kv = new SecureStore(ul_kv, rbp_kv);
+
+    result = sec_kv->init();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    result = sec_kv->reset();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
 
+    result = sec_kv->set(key6, key6_val1, strlen(key6_val1), KVStore::REQUIRE_CONFIDENTIALITY_FLAG);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    // Read twice, the second get may be served by the value cache
+    for (int i = 0; i < 2; i++) {
+        result = sec_kv->get(key6, get_buf, sizeof(get_buf), &actual_data_size);
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+        TEST_ASSERT_EQUAL(strlen(key6_val1), actual_data_size);
+        TEST_ASSERT_EQUAL_STRING_LEN(key6_val1, get_buf, strlen(key6_val1));
+    }
+
+    result = sec_kv->get(key6, get_buf, 4, &actual_data_size, 2);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    TEST_ASSERT_EQUAL(4, actual_data_size);
+    TEST_ASSERT_EQUAL_STRING_LEN(key6_val1 + 2, get_buf, 4);
+
+    result = sec_kv->get_info(key6, &info);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    TEST_ASSERT_EQUAL(strlen(key6_val1), info.size);
+    TEST_ASSERT_EQUAL(KVStore::REQUIRE_CONFIDENTIALITY_FLAG, info.flags);
+
+    // Setting the key must not leave the old value cached
+    result = sec_kv->set(key6, key6_val2, strlen(key6_val2), 0);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    result = sec_kv->get(key6, get_buf, sizeof(get_buf), &actual_data_size);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    TEST_ASSERT_EQUAL(strlen(key6_val2), actual_data_size);
+    TEST_ASSERT_EQUAL_STRING_LEN(key6_val2, get_buf, strlen(key6_val2));
+
+    // Neither does removing it
+    result = sec_kv->remove(key6);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    result = sec_kv->get(key6, get_buf, sizeof(get_buf), &actual_data_size);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_ERROR_ITEM_NOT_FOUND, result);
+
+    result = sec_kv->get_info(key6, &info);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_ERROR_ITEM_NOT_FOUND, result);
+
+    result = sec_kv->deinit();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    delete sec_kv;
+    delete ul_kv;
+    delete rbp_kv;
+}
 
 utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason)
 {
@@ -520,6 +586,7 @@ utest::v1::status_t greentea_failure_handler(const Case *const source, const fai
 
 Case cases[] = {
     Case("SecureStore: White box test",     white_box_test,    greentea_failure_handler),
+    Case("SecureStore: Value cache test",   value_cache_test,  greentea_failure_handler),
 };
 
 utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
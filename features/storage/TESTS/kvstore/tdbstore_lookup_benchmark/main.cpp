@@ -0,0 +1,132 @@
+/*
+* Copyright (c) 2019 ARM Limited. All rights reserved.
+*
+* SPDX-License-Identifier: Apache-2.0
+*
+* Licensed under the Apache License, Version 2.0 (the License); you may
+* not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an AS IS BASIS, WITHOUT
+* WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "TDBStore.h"
+#include "mbed_error.h"
+#include "Timer.h"
+#include "HeapBlockDevice.h"
+#include "FlashSimBlockDevice.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+using namespace mbed;
+using namespace utest::v1;
+
+static const size_t bd_size = 16 * 4096;
+static const size_t bd_erase_size = 4096;
+static const int heap_alloc_threshold_size = 4096;
+static const int num_lookups = 256;
+
+static void make_key(char *key, int index)
+{
+    sprintf(key, "lookup_key_%d", index);
+}
+
+/* Given a TDBStore holding num_keys keys
+ * When keys are looked up with get() and set()
+ * Then the average time per lookup is reported
+ */
+template <int num_keys>
+static void lookup_benchmark()
+{
+    char key[32];
+    uint32_t value, get_value;
+    size_t actual_data_size;
+    int result;
+    Timer timer;
+
+    uint8_t *dummy = new (std::nothrow) uint8_t[heap_alloc_threshold_size];
+    TEST_SKIP_UNLESS_MESSAGE(dummy, "Not enough heap to run test");
+
+    HeapBlockDevice heap_bd(bd_size, 1, 1, bd_erase_size);
+    FlashSimBlockDevice flash_bd(&heap_bd);
+
+    // The heap block device allocates its erase units on the fly, "erase"
+    // it through the flash simulator to check there is enough heap
+    flash_bd.init();
+    result = flash_bd.erase(0, flash_bd.size());
+    TEST_SKIP_UNLESS_MESSAGE(!result, "Not enough heap to run test");
+    flash_bd.deinit();
+    delete[] dummy;
+
+    TDBStore tdbs(&flash_bd);
+    result = tdbs.init();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    result = tdbs.reset();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    for (int i = 0; i < num_keys; i++) {
+        make_key(key, i);
+        value = i;
+        result = tdbs.set(key, &value, sizeof(value), 0);
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    }
+
+    timer.start();
+    for (int i = 0; i < num_lookups; i++) {
+        make_key(key, (i * 7919) % num_keys);
+        result = tdbs.get(key, &get_value, sizeof(get_value), &actual_data_size);
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+        TEST_ASSERT_EQUAL((i * 7919) % num_keys, get_value);
+    }
+    int hit_us = timer.read_us();
+
+    timer.reset();
+    for (int i = 0; i < num_lookups; i++) {
+        make_key(key, num_keys + i);
+        result = tdbs.get(key, &get_value, sizeof(get_value), &actual_data_size);
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_ERROR_ITEM_NOT_FOUND, result);
+    }
+    int miss_us = timer.read_us();
+
+    printf("%d keys: get %d us (found), %d us (not found) per lookup\n",
+           num_keys, hit_us / num_lookups, miss_us / num_lookups);
+
+    result = tdbs.deinit();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+}
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason)
+{
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+    Case("TDBStore: lookup benchmark, 16 keys",  lookup_benchmark<16>,  greentea_failure_handler),
+    Case("TDBStore: lookup benchmark, 64 keys",  lookup_benchmark<64>,  greentea_failure_handler),
+    Case("TDBStore: lookup benchmark, 256 keys", lookup_benchmark<256>, greentea_failure_handler),
+    Case("TDBStore: lookup benchmark, 512 keys", lookup_benchmark<512>, greentea_failure_handler),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(240, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    return !Harness::run(specification);
+}
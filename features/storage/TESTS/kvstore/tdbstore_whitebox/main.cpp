@@ -613,6 +613,157 @@ static void error_inject_test()
     delete tdbs;
 }
 
+static void incremental_gc_test()
+{
+    const int num_keys = 8;
+    const int set_iters = 40;
+    char key[] = "gc_key_0";
+    uint32_t get_val;
+    uint32_t values[num_keys];
+    size_t actual_data_size;
+    int result;
+
+    uint8_t *dummy = new (std::nothrow) uint8_t[heap_alloc_threshold_size];
+    TEST_SKIP_UNLESS_MESSAGE(dummy, "Not enough heap to run test");
+
+    HeapBlockDevice bd(4 * 1024, 1, 1, 1024);
+    FlashSimBlockDevice flash_bd(&bd);
+
+    result = flash_bd.init();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    result = flash_bd.erase(0, flash_bd.size());
+    TEST_SKIP_UNLESS_MESSAGE(!result, "Not enough heap to run test");
+    result = flash_bd.deinit();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    delete[] dummy;
+
+    TDBStore *tdbs = new TDBStore(&flash_bd);
+
+    result = tdbs->init();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    // Enough sets to fill each area several times, with garbage collection steps in between
+    for (int i = 0; i < set_iters; i++) {
+        for (int key_ind = 0; key_ind < num_keys; key_ind++) {
+            key[strlen(key) - 1] = '0' + key_ind;
+            values[key_ind] = i * num_keys + key_ind;
+            result = tdbs->set(key, &values[key_ind], sizeof(values[key_ind]), 0);
+            TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+            if (key_ind % 2) {
+                result = tdbs->garbage_collection_step();
+                TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+            }
+        }
+    }
+
+    for (int iter = 0; iter < 2; iter++) {
+        for (int key_ind = 0; key_ind < num_keys; key_ind++) {
+            key[strlen(key) - 1] = '0' + key_ind;
+            result = tdbs->get(key, &get_val, sizeof(get_val), &actual_data_size);
+            TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+            TEST_ASSERT_EQUAL(sizeof(get_val), actual_data_size);
+            TEST_ASSERT_EQUAL(values[key_ind], get_val);
+        }
+
+        // Check the records also survive a reboot
+        result = tdbs->deinit();
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+        result = tdbs->init();
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    }
+
+    delete tdbs;
+}
+
+static void transaction_test()
+{
+    char get_buf[64];
+    size_t actual_data_size;
+    int result;
+
+    uint8_t *dummy = new (std::nothrow) uint8_t[heap_alloc_threshold_size];
+    TEST_SKIP_UNLESS_MESSAGE(dummy, "Not enough heap to run test");
+
+    HeapBlockDevice bd(4 * 1024, 1, 1, 1024);
+    FlashSimBlockDevice flash_bd(&bd);
+
+    result = flash_bd.init();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    result = flash_bd.erase(0, flash_bd.size());
+    TEST_SKIP_UNLESS_MESSAGE(!result, "Not enough heap to run test");
+    result = flash_bd.deinit();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    delete[] dummy;
+
+    TDBStore *tdbs = new TDBStore(&flash_bd);
+
+    result = tdbs->init();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    result = tdbs->set(key1, key1_val1, strlen(key1_val1), 0);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    // Committed transaction
+    result = tdbs->transaction_begin();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    result = tdbs->transaction_begin();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_ERROR_INVALID_OPERATION, result);
+    result = tdbs->set(key2, key2_val1, strlen(key2_val1), 0);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    result = tdbs->remove(key1);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    result = tdbs->transaction_commit();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    result = tdbs->transaction_commit();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_ERROR_INVALID_OPERATION, result);
+
+    // Aborted transaction
+    result = tdbs->transaction_begin();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    result = tdbs->set(key2, key2_val2, strlen(key2_val2), 0);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    result = tdbs->set(key1, key1_val1, strlen(key1_val1), 0);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    result = tdbs->get(key2, get_buf, sizeof(get_buf), &actual_data_size);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    TEST_ASSERT_EQUAL_STRING_LEN(key2_val2, get_buf, strlen(key2_val2));
+    result = tdbs->transaction_abort();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    // Transaction interrupted by a "power failure"
+    result = tdbs->transaction_begin();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    result = tdbs->set(key2, key2_val3, strlen(key2_val3), 0);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    result = tdbs->set(key3, key3_val1, strlen(key3_val1), 0);
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    result = tdbs->deinit();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    result = tdbs->init();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    // Only the committed transaction is left
+    for (int i = 0; i < 2; i++) {
+        result = tdbs->get(key1, get_buf, sizeof(get_buf), &actual_data_size);
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_ERROR_ITEM_NOT_FOUND, result);
+        result = tdbs->get(key2, get_buf, sizeof(get_buf), &actual_data_size);
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+        TEST_ASSERT_EQUAL(strlen(key2_val1), actual_data_size);
+        TEST_ASSERT_EQUAL_STRING_LEN(key2_val1, get_buf, strlen(key2_val1));
+        result = tdbs->get(key3, get_buf, sizeof(get_buf), &actual_data_size);
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_ERROR_ITEM_NOT_FOUND, result);
+
+        result = tdbs->deinit();
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+        result = tdbs->init();
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    }
+
+    delete tdbs;
+}
+
 
 utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason)
 {
@@ -624,6 +775,8 @@ Case cases[] = {
     Case("TDBStore: White box test",     white_box_test,    greentea_failure_handler),
     Case("TDBStore: Multiple set test",  multi_set_test,    greentea_failure_handler),
     Case("TDBStore: Error inject test",  error_inject_test, greentea_failure_handler),
+    Case("TDBStore: Incremental GC test", incremental_gc_test, greentea_failure_handler),
+    Case("TDBStore: Transaction test",   transaction_test,  greentea_failure_handler),
 };
 
 utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
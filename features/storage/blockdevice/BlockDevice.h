@@ -21,6 +21,7 @@
 #define MBED_BLOCK_DEVICE_H
 
 #include <stdint.h>
+#include "platform/Callback.h"
 
 namespace mbed {
 
@@ -41,6 +42,11 @@ typedef uint64_t bd_addr_t;
  */
 typedef uint64_t bd_size_t;
 
+/** Type of the callback completing an asynchronous block device request,
+ *  called with 0 on success or a negative error code on failure
+ */
+typedef mbed::Callback<void(int)> bd_callback_t;
+
 
 /** A hardware device capable of writing and reading blocks
  */
@@ -122,6 +128,62 @@ public:
         return 0;
     }
 
+    /** Read blocks from a block device without waiting for the read to complete
+     *
+     *  The callback is called once the read is complete, which may be before
+     *  this function returns. The buffer must stay valid until then. Devices
+     *  that can't read in the background complete the read here, by default.
+     *
+     *  @param buffer   Buffer to write blocks to
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of the read block size
+     *  @param callback Callback called with the result of the read
+     *  @return         0 if the read was started or a negative error code on failure,
+     *                  in which case the callback isn't called
+     */
+    virtual int read_async(void *buffer, bd_addr_t addr, bd_size_t size, bd_callback_t callback)
+    {
+        callback(read(buffer, addr, size));
+        return 0;
+    }
+
+    /** Program blocks to a block device without waiting for the program to complete
+     *
+     *  The callback is called once the program is complete, which may be before
+     *  this function returns. The buffer must stay valid until then. Devices
+     *  that can't program in the background complete the program here, by default.
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of the program block size
+     *  @param callback Callback called with the result of the program
+     *  @return         0 if the program was started or a negative error code on failure,
+     *                  in which case the callback isn't called
+     */
+    virtual int program_async(const void *buffer, bd_addr_t addr, bd_size_t size, bd_callback_t callback)
+    {
+        callback(program(buffer, addr, size));
+        return 0;
+    }
+
+    /** Erase blocks on a block device without waiting for the erase to complete
+     *
+     *  The callback is called once the erase is complete, which may be before
+     *  this function returns. Devices that can't erase in the background
+     *  complete the erase here, by default.
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of the erase block size
+     *  @param callback Callback called with the result of the erase
+     *  @return         0 if the erase was started or a negative error code on failure,
+     *                  in which case the callback isn't called
+     */
+    virtual int erase_async(bd_addr_t addr, bd_size_t size, bd_callback_t callback)
+    {
+        callback(erase(addr, size));
+        return 0;
+    }
+
     /** Mark blocks as no longer in use
      *
      *  This function provides a hint to the underlying block device that a region of blocks
@@ -192,6 +254,25 @@ public:
      */
     virtual bd_size_t size() const = 0;
 
+    /** Get the device that reads, programs and erases are passed to
+     *
+     *  Block devices which only add an offset to addresses, such as
+     *  SlicingBlockDevice and MBRBlockDevice, return the device they are
+     *  mapped to once initialized. They resolve the device below them the
+     *  same way in init(), so a stack of them reaches the physical device
+     *  in one call.
+     *
+     *  @param offset   Set to the address of block 0 in the returned device
+     *  @return         The mapped device, or this device if it isn't mapped
+     *  @note A subclass of a mapping block device that overrides read,
+     *        program or erase must return this device.
+     */
+    virtual BlockDevice *get_mapped_device(bd_addr_t *offset)
+    {
+        *offset = 0;
+        return this;
+    }
+
     /** Convenience function for checking block read validity
      *
      *  @param addr     Address of block to begin reading from
@@ -248,6 +329,7 @@ public:
 using mbed::BlockDevice;
 using mbed::bd_addr_t;
 using mbed::bd_size_t;
+using mbed::bd_callback_t;
 using mbed::BD_ERROR_OK;
 using mbed::BD_ERROR_DEVICE_ERROR;
 #endif
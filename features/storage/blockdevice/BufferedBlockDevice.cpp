@@ -27,10 +27,11 @@ static inline uint32_t align_down(bd_size_t val, bd_size_t size)
     return val / size * size;
 }
 
-BufferedBlockDevice::BufferedBlockDevice(BlockDevice *bd)
-    : _bd(bd), _bd_program_size(0), _bd_read_size(0), _write_cache_addr(0), _write_cache_valid(false),
-      _write_cache(0), _read_buf(0), _init_ref_count(0), _is_initialized(false)
+BufferedBlockDevice::BufferedBlockDevice(BlockDevice *bd, uint32_t cache_lines)
+    : _bd(bd), _bd_program_size(0), _bd_read_size(0), _num_lines(cache_lines), _cache(0),
+      _read_buf(0), _init_ref_count(0), _is_initialized(false), _mapped_bd(bd), _mapped_offset(0), _lines(0)
 {
+    MBED_ASSERT(cache_lines > 0);
 }
 
 BufferedBlockDevice::~BufferedBlockDevice()
@@ -51,12 +52,19 @@ int BufferedBlockDevice::init()
         return err;
     }
 
+    // Skip the slices and partitions below
+    _mapped_bd = _bd->get_mapped_device(&_mapped_offset);
+
     _bd_read_size = _bd->get_read_size();
     _bd_program_size = _bd->get_program_size();
     _bd_size = _bd->size();
 
-    if (!_write_cache) {
-        _write_cache = new uint8_t[_bd_program_size];
+    if (!_cache) {
+        _cache = new uint8_t[_num_lines * _bd_program_size];
+        _lines = new cache_line_t[_num_lines];
+        for (uint32_t i = 0; i < _num_lines; i++) {
+            _lines[i].buf = _cache + i * _bd_program_size;
+        }
     }
 
     if (!_read_buf) {
@@ -81,8 +89,10 @@ int BufferedBlockDevice::deinit()
         return BD_ERROR_OK;
     }
 
-    delete[] _write_cache;
-    _write_cache = 0;
+    delete[] _lines;
+    _lines = 0;
+    delete[] _cache;
+    _cache = 0;
     delete[] _read_buf;
     _read_buf = 0;
     _is_initialized = false;
@@ -91,25 +101,126 @@ int BufferedBlockDevice::deinit()
 
 int BufferedBlockDevice::flush()
 {
-    MBED_ASSERT(_write_cache);
+    MBED_ASSERT(_cache);
     if (!_is_initialized) {
         return BD_ERROR_DEVICE_ERROR;
     }
 
-    if (_write_cache_valid) {
-        int ret = _bd->program(_write_cache, _write_cache_addr, _bd_program_size);
+    // Program dirty lines in address order, so the underlying BD sees the same
+    // sequence of programs whatever the order the units were cached in
+    while (true) {
+        int next = -1;
+        for (uint32_t i = 0; i < _num_lines; i++) {
+            if (_lines[i].dirty && ((next < 0) || (_lines[i].addr < _lines[next].addr))) {
+                next = i;
+            }
+        }
+        if (next < 0) {
+            return 0;
+        }
+        int ret = flush_line(next);
         if (ret) {
             return ret;
         }
-        invalidate_write_cache();
     }
-    return 0;
 }
 
 void BufferedBlockDevice::invalidate_write_cache()
 {
-    _write_cache_addr = _bd_size;
-    _write_cache_valid = false;
+    for (uint32_t i = 0; i < _num_lines; i++) {
+        _lines[i].addr = _bd_size;
+        _lines[i].valid = false;
+        _lines[i].dirty = false;
+    }
+}
+
+void BufferedBlockDevice::invalidate_cache(bd_addr_t addr, bd_size_t size)
+{
+    for (uint32_t i = 0; i < _num_lines; i++) {
+        if (_lines[i].valid && (_lines[i].addr < addr + size) && (_lines[i].addr + _bd_program_size > addr)) {
+            _lines[i].addr = _bd_size;
+            _lines[i].valid = false;
+            _lines[i].dirty = false;
+        }
+    }
+}
+
+int BufferedBlockDevice::find_line(bd_addr_t addr) const
+{
+    for (uint32_t i = 0; i < _num_lines; i++) {
+        if (_lines[i].valid && (_lines[i].addr == addr)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bd_addr_t BufferedBlockDevice::next_cached_addr(bd_addr_t addr) const
+{
+    bd_addr_t next = _bd_size;
+    for (uint32_t i = 0; i < _num_lines; i++) {
+        if (_lines[i].valid && (_lines[i].addr >= addr) && (_lines[i].addr < next)) {
+            next = _lines[i].addr;
+        }
+    }
+    return next;
+}
+
+int BufferedBlockDevice::touch_line(int line)
+{
+    cache_line_t tmp = _lines[line];
+    memmove(&_lines[1], &_lines[0], line * sizeof(cache_line_t));
+    _lines[0] = tmp;
+    return 0;
+}
+
+int BufferedBlockDevice::flush_line(int line)
+{
+    int ret = _mapped_bd->program(_lines[line].buf, _lines[line].addr + _mapped_offset, _bd_program_size);
+    if (ret) {
+        return ret;
+    }
+    _lines[line].dirty = false;
+    return 0;
+}
+
+int BufferedBlockDevice::load_line(bd_addr_t addr, bool evict_dirty, int *line)
+{
+    // Take a free line, or else the least recently used one, clean lines first
+    int victim = -1;
+    for (int i = _num_lines - 1; i >= 0; i--) {
+        if (!_lines[i].valid) {
+            victim = i;
+            break;
+        }
+        if ((victim < 0) && !_lines[i].dirty) {
+            victim = i;
+        }
+    }
+
+    if (victim < 0) {
+        if (!evict_dirty) {
+            *line = -1;
+            return 0;
+        }
+        victim = _num_lines - 1;
+        int ret = flush_line(victim);
+        if (ret) {
+            return ret;
+        }
+    }
+
+    _lines[victim].valid = false;
+    int ret = _mapped_bd->read(_lines[victim].buf, addr + _mapped_offset, _bd_program_size);
+    if (ret) {
+        _lines[victim].addr = _bd_size;
+        return ret;
+    }
+    _lines[victim].addr = addr;
+    _lines[victim].valid = true;
+    _lines[victim].dirty = false;
+    *line = touch_line(victim);
+    return 0;
 }
 
 int BufferedBlockDevice::sync()
@@ -118,7 +229,7 @@ int BufferedBlockDevice::sync()
         return BD_ERROR_DEVICE_ERROR;
     }
 
-    MBED_ASSERT(_write_cache);
+    MBED_ASSERT(_cache);
     int ret = flush();
     if (ret) {
         return ret;
@@ -132,42 +243,51 @@ int BufferedBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
         return BD_ERROR_DEVICE_ERROR;
     }
 
-    MBED_ASSERT(_write_cache && _read_buf);
-    // Common case - no need to involve write cache or read buffer
+    MBED_ASSERT(_cache && _read_buf);
+    // Common case - no need to involve cache or read buffer
     if (_bd->is_valid_read(addr, size) &&
-            ((addr + size <= _write_cache_addr) || (addr > _write_cache_addr + _bd_program_size))) {
-        return _bd->read(b, addr, size);
+            (next_cached_addr(align_down(addr, _bd_program_size)) >= addr + size)) {
+        return _mapped_bd->read(b, addr + _mapped_offset, size);
     }
 
     uint8_t *buf = static_cast<uint8_t *>(b);
 
-    // Read logic: Split read to chunks, according to whether we cross the write cache
+    // Read logic: Split read to chunks, according to whether we cross cached units
     while (size) {
-        bd_size_t chunk;
-        bool read_from_bd = true;
-        if (addr < _write_cache_addr) {
-            chunk = std::min(size, _write_cache_addr - addr);
-        } else if ((addr >= _write_cache_addr) && (addr < _write_cache_addr + _bd_program_size)) {
-            // One case we need to take our data from cache
-            chunk = std::min(size, _bd_program_size - addr % _bd_program_size);
-            memcpy(buf, _write_cache + addr % _bd_program_size, chunk);
-            read_from_bd = false;
-        } else {
-            chunk = size;
+        bd_addr_t aligned_addr = align_down(addr, _bd_program_size);
+        bd_size_t offs_in_line = addr - aligned_addr;
+        bd_size_t chunk = std::min(size, _bd_program_size - offs_in_line);
+        int ret;
+
+        int line = find_line(aligned_addr);
+        if ((line < 0) && (chunk < _bd_program_size)) {
+            // Partial unit - cache it if there's a line to spare, but don't
+            // program anything to make room
+            ret = load_line(aligned_addr, false, &line);
+            if (ret) {
+                return ret;
+            }
         }
 
-        // Now, in case we read from the BD, make sure we are aligned with its read size.
-        // If not, use read buffer as a helper.
-        if (read_from_bd) {
+        if (line >= 0) {
+            memcpy(buf, _lines[line].buf + offs_in_line, chunk);
+            touch_line(line);
+        } else {
+            if (chunk == _bd_program_size) {
+                // Read whole units up to the next cached one at once
+                chunk = std::min(size, next_cached_addr(aligned_addr) - addr);
+            }
+
+            // Make sure we are aligned with the read size of the BD.
+            // If not, use read buffer as a helper.
             bd_size_t offs_in_read_buf = addr % _bd_read_size;
-            int ret;
             if (offs_in_read_buf || (chunk < _bd_read_size)) {
                 chunk = std::min(chunk, _bd_read_size - offs_in_read_buf);
-                ret = _bd->read(_read_buf, addr - offs_in_read_buf, _bd_read_size);
+                ret = _mapped_bd->read(_read_buf, addr - offs_in_read_buf + _mapped_offset, _bd_read_size);
                 memcpy(buf, _read_buf + offs_in_read_buf, chunk);
             } else {
                 chunk = align_down(chunk, _bd_read_size);
-                ret = _bd->read(buf, addr, chunk);
+                ret = _mapped_bd->read(buf, addr + _mapped_offset, chunk);
             }
             if (ret) {
                 return ret;
@@ -188,28 +308,17 @@ int BufferedBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
         return BD_ERROR_DEVICE_ERROR;
     }
 
-    MBED_ASSERT(_write_cache);
+    MBED_ASSERT(_cache);
 
     int ret;
 
-    bd_addr_t aligned_addr = align_down(addr, _bd_program_size);
-
     const uint8_t *buf = static_cast <const uint8_t *>(b);
 
-    // Need to flush if moved to another program unit
-    if (aligned_addr != _write_cache_addr) {
-        ret = flush();
-        if (ret) {
-            return ret;
-        }
-        _write_cache_addr = aligned_addr;
-    }
-
     // Write logic: Keep data in cache as long as we don't reach the end of the program unit.
     // Otherwise, program to the underlying BD.
     while (size) {
-        _write_cache_addr = align_down(addr, _bd_program_size);
-        bd_addr_t offs_in_buf = addr - _write_cache_addr;
+        bd_addr_t aligned_addr = align_down(addr, _bd_program_size);
+        bd_addr_t offs_in_buf = addr - aligned_addr;
         bd_size_t chunk;
         if (offs_in_buf) {
             chunk = std::min(_bd_program_size - offs_in_buf, size);
@@ -219,25 +328,35 @@ int BufferedBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
             chunk = size;
         }
 
-        const uint8_t *prog_buf;
         if (chunk < _bd_program_size) {
-            // If cache not valid, and program doesn't cover an entire unit, it means we need to
-            // read it from the underlying BD
-            if (!_write_cache_valid) {
-                ret = _bd->read(_write_cache, _write_cache_addr, _bd_program_size);
+            // If the unit isn't cached, and program doesn't cover an entire unit, it means
+            // we need to read it from the underlying BD
+            int line = find_line(aligned_addr);
+            if (line < 0) {
+                ret = load_line(aligned_addr, true, &line);
                 if (ret) {
                     return ret;
                 }
             }
-            memcpy(_write_cache + offs_in_buf, buf, chunk);
-            prog_buf = _write_cache;
-        } else {
-            prog_buf = buf;
-        }
+            line = touch_line(line);
+            memcpy(_lines[line].buf + offs_in_buf, buf, chunk);
+            _lines[line].dirty = true;
 
-        // Only program if we reached the end of a program unit
-        if (!((offs_in_buf + chunk) % _bd_program_size)) {
-            ret = _bd->program(prog_buf, _write_cache_addr, std::max(chunk, _bd_program_size));
+            // Only program if we reached the end of a program unit
+            if (!((offs_in_buf + chunk) % _bd_program_size)) {
+                ret = flush_line(line);
+                if (ret) {
+                    return ret;
+                }
+                ret = _bd->sync();
+                if (ret) {
+                    return ret;
+                }
+            }
+        } else {
+            // Whole units supersede whatever is cached for them
+            invalidate_cache(aligned_addr, chunk);
+            ret = _mapped_bd->program(buf, aligned_addr + _mapped_offset, chunk);
             if (ret) {
                 return ret;
             }
@@ -245,9 +364,6 @@ int BufferedBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
             if (ret) {
                 return ret;
             }
-            invalidate_write_cache();
-        } else {
-            _write_cache_valid = true;
         }
 
         buf += chunk;
@@ -265,10 +381,8 @@ int BufferedBlockDevice::erase(bd_addr_t addr, bd_size_t size)
         return BD_ERROR_DEVICE_ERROR;
     }
 
-    if ((_write_cache_addr >= addr) && (_write_cache_addr <= addr + size)) {
-        invalidate_write_cache();
-    }
-    return _bd->erase(addr, size);
+    invalidate_cache(addr, size);
+    return _mapped_bd->erase(addr + _mapped_offset, size);
 }
 
 int BufferedBlockDevice::trim(bd_addr_t addr, bd_size_t size)
@@ -278,9 +392,7 @@ int BufferedBlockDevice::trim(bd_addr_t addr, bd_size_t size)
         return BD_ERROR_DEVICE_ERROR;
     }
 
-    if ((_write_cache_addr >= addr) && (_write_cache_addr <= addr + size)) {
-        invalidate_write_cache();
-    }
+    invalidate_cache(addr, size);
     return _bd->trim(addr, size);
 }
 
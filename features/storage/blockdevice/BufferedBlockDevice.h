@@ -32,14 +32,20 @@ namespace mbed {
 
 /** Block device for allowing minimal read and program sizes (of 1) for the underlying BD,
  *  using a buffer on the heap.
+ *
+ *  Partial programs are merged in a cache of program units, and only reach the underlying
+ *  BD once a unit is complete, when it is evicted or on sync. Cached units also serve reads.
+ *  When the cache is full, the least recently used unit is evicted, clean units first.
  */
 class BufferedBlockDevice : public BlockDevice {
 public:
     /** Lifetime of a memory-buffered block device wrapping an underlying block device
      *
-     *  @param bd        Block device to back the BufferedBlockDevice
+     *  @param bd           Block device to back the BufferedBlockDevice
+     *  @param cache_lines  Number of program units held in the cache, so that interleaved
+     *                      programs to that many units don't evict each other
      */
-    BufferedBlockDevice(BlockDevice *bd);
+    BufferedBlockDevice(BlockDevice *bd, uint32_t cache_lines = 1);
 
     /** Lifetime of the memory-buffered block device
      */
@@ -60,6 +66,8 @@ public:
     /** Ensure that data on the underlying storage block device is in sync with the
      *  memory-buffered block device
      *
+     *  Cached units are programmed in address order.
+     *
      *  @return         0 on success or a negative error code on failure
      */
     virtual int sync();
@@ -164,14 +172,25 @@ protected:
     bd_size_t _bd_program_size;
     bd_size_t _bd_read_size;
     bd_size_t _bd_size;
-    bd_size_t _write_cache_addr;
-    bool _write_cache_valid;
-    uint8_t *_write_cache;
+    uint32_t _num_lines;
+    uint8_t *_cache;
     uint8_t *_read_buf;
     uint32_t _init_ref_count;
     bool _is_initialized;
+    BlockDevice *_mapped_bd;
+    bd_addr_t _mapped_offset;
 
 #if !(DOXYGEN_ONLY)
+    struct cache_line_t {
+        bd_addr_t addr;
+        uint8_t *buf;
+        bool valid;
+        bool dirty;
+    };
+
+    // Cache lines, most recently used first
+    cache_line_t *_lines;
+
     /** Flush data in cache
      *
      *  @return         0 on success or a negative error code on failure
@@ -183,6 +202,50 @@ protected:
      *  @return         none
      */
     void invalidate_write_cache();
+
+    /** Invalidate the cache lines overlapping a range, dropping their data
+     *
+     *  @param addr     Start of the range
+     *  @param size     Size of the range in bytes
+     */
+    void invalidate_cache(bd_addr_t addr, bd_size_t size);
+
+    /** Find the cache line holding a program unit
+     *
+     *  @param addr     Address of the program unit
+     *  @return         Index of the line, or -1 if the unit isn't cached
+     */
+    int find_line(bd_addr_t addr) const;
+
+    /** Get the address of the first cached program unit at or after an address
+     *
+     *  @param addr     Address to look from
+     *  @return         Address of the unit, or the device size if there is none
+     */
+    bd_addr_t next_cached_addr(bd_addr_t addr) const;
+
+    /** Make a cache line the most recently used one
+     *
+     *  @param line     Index of the line
+     *  @return         New index of the line
+     */
+    int touch_line(int line);
+
+    /** Program a dirty cache line to the underlying BD, keeping it as clean
+     *
+     *  @param line     Index of the line
+     *  @return         0 on success or a negative error code on failure
+     */
+    int flush_line(int line);
+
+    /** Load a program unit into a cache line, evicting one if needed
+     *
+     *  @param addr         Address of the program unit
+     *  @param evict_dirty  Whether a dirty line may be flushed to make room
+     *  @param line         Set to the index of the line, or -1 if there's no room
+     *  @return             0 on success or a negative error code on failure
+     */
+    int load_line(bd_addr_t addr, bool evict_dirty, int *line);
 #endif //#if !(DOXYGEN_ONLY)
 };
 } // namespace mbed
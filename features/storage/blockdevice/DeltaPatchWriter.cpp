@@ -0,0 +1,334 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DeltaPatchWriter.h"
+#include "platform/mbed_assert.h"
+#include <algorithm>
+#include <string.h>
+#include <new>
+
+namespace mbed {
+
+static const uint8_t patch_magic[] = { 'M', 'B', 'D', 'P' };
+
+static inline bd_size_t align_up(bd_size_t val, bd_size_t size)
+{
+    return (val + size - 1) / size * size;
+}
+
+DeltaPatchWriter::DeltaPatchWriter(BlockDevice *source, BlockDevice *dest, bd_size_t buffer_size)
+    : _source(source), _dest(dest), _buffer_size(buffer_size), _buffer(0), _buffered(0),
+      _source_buffer(0), _source_buffer_size(0), _source_buffer_addr(0), _source_buffered(0),
+      _erased(0), _image_size(0), _written(0), _source_pos(0), _remaining(0), _varint(0),
+      _varint_shift(0), _state(STATE_MAGIC), _error(DELTA_PATCH_ERROR_OK), _is_initialized(false)
+{
+}
+
+DeltaPatchWriter::~DeltaPatchWriter()
+{
+    deinit();
+}
+
+int DeltaPatchWriter::init()
+{
+    if (_is_initialized) {
+        return BD_ERROR_OK;
+    }
+
+    int err = _source->init();
+    if (err) {
+        return err;
+    }
+
+    err = _dest->init();
+    if (err) {
+        _source->deinit();
+        return err;
+    }
+
+    if (!_buffer_size) {
+        _buffer_size = _dest->get_program_size();
+    }
+    MBED_ASSERT(_buffer_size % _dest->get_program_size() == 0);
+    _source_buffer_size = align_up(_buffer_size, _source->get_read_size());
+
+    _buffer = new (std::nothrow) uint8_t[_buffer_size];
+    _source_buffer = new (std::nothrow) uint8_t[_source_buffer_size];
+    if (!_buffer || !_source_buffer) {
+        delete[] _buffer;
+        _buffer = 0;
+        delete[] _source_buffer;
+        _source_buffer = 0;
+        _dest->deinit();
+        _source->deinit();
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    _buffered = 0;
+    _source_buffer_addr = 0;
+    _source_buffered = 0;
+    _erased = 0;
+    _image_size = 0;
+    _written = 0;
+    _source_pos = 0;
+    _remaining = 0;
+    _varint = 0;
+    _varint_shift = 0;
+    _state = STATE_MAGIC;
+    _error = DELTA_PATCH_ERROR_OK;
+    _is_initialized = true;
+    return BD_ERROR_OK;
+}
+
+int DeltaPatchWriter::deinit()
+{
+    if (!_is_initialized) {
+        return BD_ERROR_OK;
+    }
+
+    delete[] _buffer;
+    _buffer = 0;
+    delete[] _source_buffer;
+    _source_buffer = 0;
+    _is_initialized = false;
+
+    int err = _dest->deinit();
+    int source_err = _source->deinit();
+    return err ? err : source_err;
+}
+
+int DeltaPatchWriter::parse_varint(uint8_t byte)
+{
+    if (_varint_shift >= 64) {
+        return DELTA_PATCH_ERROR_CORRUPT;
+    }
+    _varint |= (uint64_t)(byte & 0x7F) << _varint_shift;
+    _varint_shift += 7;
+    return (byte & 0x80) ? 0 : 1;
+}
+
+int DeltaPatchWriter::end_varint()
+{
+    uint64_t val = _varint;
+    _varint = 0;
+    _varint_shift = 0;
+
+    switch (_state) {
+        case STATE_IMAGE_SIZE:
+            if (val > _dest->size()) {
+                return DELTA_PATCH_ERROR_SIZE;
+            }
+            _image_size = val;
+            _state = _image_size ? STATE_DIFF_LENGTH : STATE_DONE;
+            break;
+
+        case STATE_DIFF_LENGTH:
+        case STATE_EXTRA_LENGTH:
+            if (val > _image_size - _written) {
+                return DELTA_PATCH_ERROR_CORRUPT;
+            }
+            _remaining = val;
+            if (_state == STATE_DIFF_LENGTH) {
+                _state = _remaining ? STATE_DIFF : STATE_EXTRA_LENGTH;
+            } else {
+                _state = _remaining ? STATE_EXTRA : STATE_OFFSET;
+            }
+            break;
+
+        case STATE_OFFSET: {
+            // Zigzag encoded, the sign is in the lowest bit
+            uint64_t offset = val >> 1;
+            if (val & 1) {
+                if (offset + 1 > _source_pos) {
+                    return DELTA_PATCH_ERROR_CORRUPT;
+                }
+                _source_pos -= offset + 1;
+            } else {
+                if (offset > _source->size() - _source_pos) {
+                    return DELTA_PATCH_ERROR_CORRUPT;
+                }
+                _source_pos += offset;
+            }
+            _state = (_written == _image_size) ? STATE_DONE : STATE_DIFF_LENGTH;
+            break;
+        }
+
+        default:
+            break;
+    }
+    return DELTA_PATCH_ERROR_OK;
+}
+
+int DeltaPatchWriter::load_source()
+{
+    if (_source_pos >= _source->size()) {
+        return DELTA_PATCH_ERROR_CORRUPT;
+    }
+
+    bd_size_t read_size = _source->get_read_size();
+    _source_buffer_addr = _source_pos / read_size * read_size;
+    _source_buffered = std::min(_source_buffer_size, _source->size() - _source_buffer_addr);
+    int err = _source->read(_source_buffer, _source_buffer_addr, _source_buffered);
+    if (err) {
+        _source_buffered = 0;
+    }
+    return err;
+}
+
+int DeltaPatchWriter::flush()
+{
+    if (!_buffered) {
+        return BD_ERROR_OK;
+    }
+
+    bd_addr_t addr = _written - _buffered;
+    bd_size_t size = align_up(_buffered, _dest->get_program_size());
+    int erase_value = _dest->get_erase_value();
+    memset(_buffer + _buffered, (erase_value < 0) ? 0xFF : erase_value, size - _buffered);
+
+    // Erase just ahead of programming, so the erase of the destination is
+    // spread over the transfer and units past the new image are left alone
+    while (_erased < addr + size) {
+        bd_size_t erase_size = _dest->get_erase_size(_erased);
+        int err = _dest->erase(_erased, erase_size);
+        if (err) {
+            return err;
+        }
+        _erased += erase_size;
+    }
+
+    int err = _dest->program(_buffer, addr, size);
+    if (err) {
+        return err;
+    }
+    _buffered = 0;
+    return BD_ERROR_OK;
+}
+
+int DeltaPatchWriter::write(const void *patch, bd_size_t size)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+    if (_error) {
+        return _error;
+    }
+
+    const uint8_t *data = static_cast<const uint8_t *>(patch);
+    int err = DELTA_PATCH_ERROR_OK;
+
+    while (size && !err) {
+        switch (_state) {
+            case STATE_MAGIC:
+                if (*data != patch_magic[_remaining]) {
+                    err = DELTA_PATCH_ERROR_CORRUPT;
+                    break;
+                }
+                data++;
+                size--;
+                if (++_remaining == sizeof(patch_magic)) {
+                    _remaining = 0;
+                    _state = STATE_IMAGE_SIZE;
+                }
+                break;
+
+            case STATE_IMAGE_SIZE:
+            case STATE_DIFF_LENGTH:
+            case STATE_EXTRA_LENGTH:
+            case STATE_OFFSET:
+                err = parse_varint(*data);
+                data++;
+                size--;
+                if (err > 0) {
+                    err = end_varint();
+                }
+                break;
+
+            case STATE_DIFF:
+            case STATE_EXTRA: {
+                bd_size_t chunk = std::min(std::min(size, _remaining), _buffer_size - _buffered);
+                if (_state == STATE_DIFF) {
+                    if (_source_pos < _source_buffer_addr || _source_pos >= _source_buffer_addr + _source_buffered) {
+                        err = load_source();
+                        if (err) {
+                            break;
+                        }
+                    }
+                    chunk = std::min(chunk, _source_buffer_addr + _source_buffered - _source_pos);
+                    const uint8_t *source = _source_buffer + (_source_pos - _source_buffer_addr);
+                    for (bd_size_t i = 0; i < chunk; i++) {
+                        _buffer[_buffered + i] = data[i] + source[i];
+                    }
+                    _source_pos += chunk;
+                } else {
+                    memcpy(_buffer + _buffered, data, chunk);
+                }
+
+                data += chunk;
+                size -= chunk;
+                _buffered += chunk;
+                _written += chunk;
+                _remaining -= chunk;
+                if (!_remaining) {
+                    _state = (_state == STATE_DIFF) ? STATE_EXTRA_LENGTH : STATE_OFFSET;
+                }
+                if (_buffered == _buffer_size) {
+                    err = flush();
+                }
+                break;
+            }
+
+            case STATE_DONE:
+                // Nothing may follow the last record
+                err = DELTA_PATCH_ERROR_CORRUPT;
+                break;
+        }
+    }
+
+    _error = err;
+    return err;
+}
+
+int DeltaPatchWriter::finish()
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+    if (_error) {
+        return _error;
+    }
+    if (_state != STATE_DONE) {
+        return DELTA_PATCH_ERROR_INCOMPLETE;
+    }
+
+    _error = flush();
+    if (_error) {
+        return _error;
+    }
+    return _dest->sync();
+}
+
+bd_size_t DeltaPatchWriter::get_image_size() const
+{
+    return _image_size;
+}
+
+bd_size_t DeltaPatchWriter::get_written_size() const
+{
+    return _written;
+}
+
+} // namespace mbed
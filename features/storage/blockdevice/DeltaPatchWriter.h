@@ -0,0 +1,187 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup storage */
+/** @{*/
+
+#ifndef MBED_DELTA_PATCH_WRITER_H
+#define MBED_DELTA_PATCH_WRITER_H
+
+#include "BlockDevice.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+
+/** Enum of delta patch error codes
+ *
+ *  @enum delta_patch_error
+ */
+enum delta_patch_error {
+    DELTA_PATCH_ERROR_OK         = 0,     /*!< no error */
+    DELTA_PATCH_ERROR_CORRUPT    = -4101, /*!< patch is malformed or refers outside the source image */
+    DELTA_PATCH_ERROR_SIZE       = -4102, /*!< new image is larger than the destination */
+    DELTA_PATCH_ERROR_INCOMPLETE = -4103, /*!< patch ended before the new image was complete */
+};
+
+/** Writer rebuilding an image from a source image and a delta patch
+ *
+ *  The patch is applied as it is received, so it can be written straight
+ *  from the transport, and only the patch has to be transferred instead of
+ *  the whole new image. The new image is programmed to the destination from
+ *  its start, in chunks of the buffer size, erasing each erase unit of the
+ *  destination just before it is first programmed.
+ *
+ *  The patch uses a streaming variant of the bsdiff format. All numbers are
+ *  unsigned LEB128 varints, signed ones zigzag encoded first:
+ *
+ *  - The magic "MBDP", followed by the size of the new image
+ *  - Records until the new image is complete, each made of
+ *    - a diff length, and that many bytes each added (modulo 256) to the
+ *      next byte of the source image
+ *    - an extra length, and that many bytes copied as they are
+ *    - a signed offset to move the position in the source image by
+ *
+ *  The position in the source image starts at 0. It advances with the diff
+ *  bytes only, so an unchanged block costs a few bytes of mostly zeros in the
+ *  patch, which compress well if the transport compresses.
+ *
+ *  The source and destination must not overlap.
+ *
+ *  Example:
+ *  @code
+ *  FlashIAPBlockDevice flash;
+ *  SlicingBlockDevice active(&flash, 0, SLOT_SIZE);
+ *  SlicingBlockDevice candidate(&flash, SLOT_SIZE, 2 * SLOT_SIZE);
+ *  DeltaPatchWriter patcher(&active, &candidate);
+ *
+ *  patcher.init();
+ *  while ((size = receive(buffer, sizeof(buffer))) > 0) {
+ *      patcher.write(buffer, size);
+ *  }
+ *  err = patcher.finish();
+ *  patcher.deinit();
+ *  @endcode
+ */
+class DeltaPatchWriter : private NonCopyable<DeltaPatchWriter> {
+public:
+    /** Lifetime of the writer
+     *
+     *  @param source       Block device holding the source image
+     *  @param dest         Block device to program the new image to
+     *  @param buffer_size  Size of the chunks to program, a multiple of the
+     *                      program size of the destination, or 0 to use
+     *                      the program size
+     */
+    DeltaPatchWriter(BlockDevice *source, BlockDevice *dest, bd_size_t buffer_size = 0);
+
+    /** Lifetime of the writer
+     */
+    ~DeltaPatchWriter();
+
+    /** Initialize the block devices and start a new patch
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    int init();
+
+    /** Deinitialize the block devices
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    int deinit();
+
+    /** Apply the next part of the patch
+     *
+     *  @param patch    Next bytes of the patch
+     *  @param size     Number of bytes
+     *  @return         0 on success, a delta_patch_error or a negative
+     *                  error code of a block device on failure. Once an
+     *                  error is returned, the patch can only be restarted
+     *                  with deinit and init.
+     */
+    int write(const void *patch, bd_size_t size);
+
+    /** Program the end of the new image
+     *
+     *  @return         0 on success, DELTA_PATCH_ERROR_INCOMPLETE if the
+     *                  patch isn't complete, or the error returned by write
+     */
+    int finish();
+
+    /** Get the size of the new image
+     *
+     *  @return         Size in bytes, 0 until the patch header is written
+     */
+    bd_size_t get_image_size() const;
+
+    /** Get how much of the new image has been rebuilt
+     *
+     *  @return         Size in bytes, including data not programmed yet
+     */
+    bd_size_t get_written_size() const;
+
+private:
+    enum state_t {
+        STATE_MAGIC,
+        STATE_IMAGE_SIZE,
+        STATE_DIFF_LENGTH,
+        STATE_DIFF,
+        STATE_EXTRA_LENGTH,
+        STATE_EXTRA,
+        STATE_OFFSET,
+        STATE_DONE,
+    };
+
+    BlockDevice *_source;
+    BlockDevice *_dest;
+    bd_size_t _buffer_size;
+    uint8_t *_buffer;
+    bd_size_t _buffered;
+    uint8_t *_source_buffer;
+    bd_size_t _source_buffer_size;
+    bd_addr_t _source_buffer_addr;
+    bd_size_t _source_buffered;
+    bd_addr_t _erased;
+    bd_size_t _image_size;
+    bd_size_t _written;
+    bd_addr_t _source_pos;
+    bd_size_t _remaining;
+    uint64_t _varint;
+    int _varint_shift;
+    int _state;
+    int _error;
+    bool _is_initialized;
+
+    int parse_varint(uint8_t byte);
+    int end_varint();
+    int load_source();
+    int flush();
+};
+
+} // namespace mbed
+
+// Added "using" for backwards compatibility
+#ifndef MBED_NO_GLOBAL_USING_DIRECTIVE
+using mbed::DeltaPatchWriter;
+using mbed::DELTA_PATCH_ERROR_OK;
+using mbed::DELTA_PATCH_ERROR_CORRUPT;
+using mbed::DELTA_PATCH_ERROR_SIZE;
+using mbed::DELTA_PATCH_ERROR_INCOMPLETE;
+#endif
+
+#endif
+
+/** @}*/
@@ -32,8 +32,10 @@ static inline uint32_t align_up(bd_size_t val, bd_size_t size)
 
 FlashSimBlockDevice::FlashSimBlockDevice(BlockDevice *bd, uint8_t erase_value) :
     _erase_value(erase_value), _blank_buf_size(0),
-    _blank_buf(0), _bd(bd), _init_ref_count(0), _is_initialized(false)
+    _blank_buf(0), _bd(bd), _time_ns(0), _erase_end_ns(0),
+    _init_ref_count(0), _is_initialized(false)
 {
+    memset(&_timing, 0, sizeof(_timing));
 }
 
 FlashSimBlockDevice::~FlashSimBlockDevice()
@@ -92,6 +94,7 @@ int FlashSimBlockDevice::sync()
         return BD_ERROR_DEVICE_ERROR;
     }
 
+    wait_erase();
     return _bd->sync();
 }
 
@@ -146,7 +149,19 @@ int FlashSimBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
         return BD_ERROR_DEVICE_ERROR;
     }
 
-    return _bd->read(b, addr, size);
+    int ret = _bd->read(b, addr, size);
+    if (ret) {
+        return ret;
+    }
+
+    uint64_t read_ns = _timing.read_ns + size * _timing.read_byte_ns;
+    if (_erase_end_ns > _time_ns) {
+        // Only with erase_suspend, the erase is delayed by the read
+        read_ns += _timing.suspend_ns + _timing.resume_ns;
+        _erase_end_ns += read_ns;
+    }
+    _time_ns += read_ns;
+    return BD_ERROR_OK;
 }
 
 int FlashSimBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
@@ -178,7 +193,16 @@ int FlashSimBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
         curr_size -= read_size;
     }
 
-    return _bd->program(b, addr, size);
+    int ret = _bd->program(b, addr, size);
+    if (ret) {
+        return ret;
+    }
+
+    bd_size_t page_size = _timing.program_page_size ? _timing.program_page_size : _bd->get_program_size();
+    bd_size_t pages = (addr + size - 1) / page_size - addr / page_size + 1;
+    wait_erase();
+    _time_ns += pages * _timing.program_page_ns;
+    return BD_ERROR_OK;
 }
 
 int FlashSimBlockDevice::erase(bd_addr_t addr, bd_size_t size)
@@ -204,6 +228,17 @@ int FlashSimBlockDevice::erase(bd_addr_t addr, bd_size_t size)
         curr_size -= prog_size;
     }
 
+    uint64_t erase_ns = 0;
+    for (curr_addr = addr; curr_addr < addr + size; curr_addr += _bd->get_erase_size(curr_addr)) {
+        erase_ns += _timing.erase_ns;
+    }
+    wait_erase();
+    if (_timing.erase_suspend) {
+        _erase_end_ns = _time_ns + erase_ns;
+    } else {
+        _time_ns += erase_ns;
+    }
+
     return BD_ERROR_OK;
 }
 
@@ -212,6 +247,34 @@ int FlashSimBlockDevice::get_erase_value() const
     return _erase_value;
 }
 
+void FlashSimBlockDevice::set_timing(const flash_sim_timing_t &timing)
+{
+    _timing = timing;
+}
+
+uint64_t FlashSimBlockDevice::get_time_ns() const
+{
+    return _time_ns;
+}
+
+void FlashSimBlockDevice::advance_time(uint64_t ns)
+{
+    _time_ns += ns;
+}
+
+void FlashSimBlockDevice::reset_time()
+{
+    _time_ns = 0;
+    _erase_end_ns = 0;
+}
+
+void FlashSimBlockDevice::wait_erase()
+{
+    if (_erase_end_ns > _time_ns) {
+        _time_ns = _erase_end_ns;
+    }
+}
+
 const char *FlashSimBlockDevice::get_type() const
 {
     if (_bd != NULL) {
@@ -34,10 +34,42 @@ enum {
     BD_ERROR_NOT_ERASED       = -3201,
 };
 
+/** Timing of a simulated flash, all times in nanoseconds
+ *
+ * With erase_suspend set, erases run in the background: erase() returns
+ * at once, a read during an erase suspends it, and a program, erase or
+ * sync waits for it to complete.
+ */
+typedef struct {
+    uint32_t read_ns;               /**< Time of each read command */
+    uint32_t read_byte_ns;          /**< Time of each byte read */
+    uint32_t program_page_ns;       /**< Time of programming a page, or part of it */
+    bd_size_t program_page_size;    /**< Size of a page in bytes, 0 for the program size */
+    uint32_t erase_ns;              /**< Time of erasing an erase block */
+    bool erase_suspend;             /**< Erases run in the background, suspended by reads */
+    uint32_t suspend_ns;            /**< Time of suspending an erase for a read */
+    uint32_t resume_ns;             /**< Time of resuming an erase after a read */
+} flash_sim_timing_t;
+
 /** Flash simulating block device
  *
  * Flash simulation BD adaptor
  *
+ * Operations take no time, unless a timing is set with set_timing(). The
+ * time they would take on the flash is then counted on a virtual clock,
+ * to estimate the performance of storage code from host or RAM based
+ * tests.
+ *
+ * @code
+ * flash_sim_timing_t timing = {};
+ * timing.read_byte_ns = 20;
+ * timing.program_page_ns = 700000;
+ * timing.program_page_size = 256;
+ * timing.erase_ns = 45000000;
+ * flash_bd.set_timing(timing);
+ * // ... operations on flash_bd ...
+ * printf("%llu us\n", flash_bd.get_time_ns() / 1000);
+ * @endcode
  */
 class FlashSimBlockDevice : public BlockDevice {
 public:
@@ -142,11 +174,42 @@ public:
      */
     virtual const char *get_type() const;
 
+    /** Set the timing of the simulated flash
+     *
+     *  @param timing   Timing of the operations, all zero for instant operations
+     */
+    void set_timing(const flash_sim_timing_t &timing);
+
+    /** Get the virtual clock
+     *
+     *  @return         Time taken by the flash operations since the last
+     *                  reset_time(), plus the time added by advance_time()
+     */
+    uint64_t get_time_ns() const;
+
+    /** Advance the virtual clock
+     *
+     *  Accounts for the time spent outside the flash, during which a
+     *  background erase progresses
+     *
+     *  @param ns       Time to add in nanoseconds
+     */
+    void advance_time(uint64_t ns);
+
+    /** Reset the virtual clock to zero, a background erase is completed */
+    void reset_time();
+
 private:
+    void wait_erase();
+
+
     uint8_t _erase_value;
     bd_size_t _blank_buf_size;
     uint8_t *_blank_buf;
     BlockDevice *_bd;
+    flash_sim_timing_t _timing;
+    uint64_t _time_ns;
+    uint64_t _erase_end_ns;
     uint32_t _init_ref_count;
     bool _is_initialized;
 };
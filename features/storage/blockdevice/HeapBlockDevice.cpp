@@ -23,14 +23,24 @@ namespace mbed {
 
 HeapBlockDevice::HeapBlockDevice(bd_size_t size, bd_size_t block)
     : _read_size(block), _program_size(block), _erase_size(block)
-    , _count(size / block), _blocks(0), _init_ref_count(0), _is_initialized(false)
+    , _count(size / block), _blocks(0), _arena(0), _arena_owned(false)
+    , _init_ref_count(0), _is_initialized(false)
 {
     MBED_ASSERT(_count * _erase_size == size);
 }
 
 HeapBlockDevice::HeapBlockDevice(bd_size_t size, bd_size_t read, bd_size_t program, bd_size_t erase)
     : _read_size(read), _program_size(program), _erase_size(erase)
-    , _count(size / erase), _blocks(0), _init_ref_count(0), _is_initialized(false)
+    , _count(size / erase), _blocks(0), _arena(0), _arena_owned(false)
+    , _init_ref_count(0), _is_initialized(false)
+{
+    MBED_ASSERT(_count * _erase_size == size);
+}
+
+HeapBlockDevice::HeapBlockDevice(bd_size_t size, bd_size_t read, bd_size_t program, bd_size_t erase, void *arena)
+    : _read_size(read), _program_size(program), _erase_size(erase)
+    , _count(size / erase), _blocks(0), _arena(static_cast<uint8_t *>(arena)), _arena_owned(!arena)
+    , _init_ref_count(0), _is_initialized(false)
 {
     MBED_ASSERT(_count * _erase_size == size);
 }
@@ -45,6 +55,11 @@ HeapBlockDevice::~HeapBlockDevice()
         delete[] _blocks;
         _blocks = 0;
     }
+
+    if (_arena_owned) {
+        delete[] _arena;
+        _arena = 0;
+    }
 }
 
 int HeapBlockDevice::init()
@@ -55,7 +70,12 @@ int HeapBlockDevice::init()
         return BD_ERROR_OK;
     }
 
-    if (!_blocks) {
+    if (_arena_owned) {
+        if (!_arena) {
+            _arena = new uint8_t[_count * _erase_size];
+            memset(_arena, 0, _count * _erase_size);
+        }
+    } else if (!_arena && !_blocks) {
         _blocks = new uint8_t *[_count];
         for (size_t i = 0; i < _count; i++) {
             _blocks[i] = 0;
@@ -78,7 +98,7 @@ int HeapBlockDevice::deinit()
         return BD_ERROR_OK;
     }
 
-    MBED_ASSERT(_blocks != NULL);
+    MBED_ASSERT(_blocks != NULL || _arena != NULL);
     // Memory is lazily cleaned up in destructor to allow
     // data to live across de/reinitialization
     _is_initialized = false;
@@ -87,37 +107,37 @@ int HeapBlockDevice::deinit()
 
 bd_size_t HeapBlockDevice::get_read_size() const
 {
-    MBED_ASSERT(_blocks != NULL);
+    MBED_ASSERT(_blocks != NULL || _arena != NULL);
     return _read_size;
 }
 
 bd_size_t HeapBlockDevice::get_program_size() const
 {
-    MBED_ASSERT(_blocks != NULL);
+    MBED_ASSERT(_blocks != NULL || _arena != NULL);
     return _program_size;
 }
 
 bd_size_t HeapBlockDevice::get_erase_size() const
 {
-    MBED_ASSERT(_blocks != NULL);
+    MBED_ASSERT(_blocks != NULL || _arena != NULL);
     return _erase_size;
 }
 
 bd_size_t HeapBlockDevice::get_erase_size(bd_addr_t addr) const
 {
-    MBED_ASSERT(_blocks != NULL);
+    MBED_ASSERT(_blocks != NULL || _arena != NULL);
     return _erase_size;
 }
 
 bd_size_t HeapBlockDevice::size() const
 {
-    MBED_ASSERT(_blocks != NULL);
+    MBED_ASSERT(_blocks != NULL || _arena != NULL);
     return _count * _erase_size;
 }
 
 int HeapBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
 {
-    MBED_ASSERT(_blocks != NULL);
+    MBED_ASSERT(_blocks != NULL || _arena != NULL);
     MBED_ASSERT(is_valid_read(addr, size));
     if (!_is_initialized) {
         return BD_ERROR_DEVICE_ERROR;
@@ -125,19 +145,28 @@ int HeapBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
 
     uint8_t *buffer = static_cast<uint8_t *>(b);
 
+    if (_arena) {
+        memcpy(buffer, &_arena[addr], size);
+        return 0;
+    }
+
     while (size > 0) {
         bd_addr_t hi = addr / _erase_size;
         bd_addr_t lo = addr % _erase_size;
+        bd_size_t chunk = _erase_size - lo;
+        if (chunk > size) {
+            chunk = size;
+        }
 
         if (_blocks[hi]) {
-            memcpy(buffer, &_blocks[hi][lo], _read_size);
+            memcpy(buffer, &_blocks[hi][lo], chunk);
         } else {
-            memset(buffer, 0, _read_size);
+            memset(buffer, 0, chunk);
         }
 
-        buffer += _read_size;
-        addr += _read_size;
-        size -= _read_size;
+        buffer += chunk;
+        addr += chunk;
+        size -= chunk;
     }
 
     return 0;
@@ -145,7 +174,7 @@ int HeapBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
 
 int HeapBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
 {
-    MBED_ASSERT(_blocks != NULL);
+    MBED_ASSERT(_blocks != NULL || _arena != NULL);
     MBED_ASSERT(is_valid_program(addr, size));
     if (!_is_initialized) {
         return BD_ERROR_DEVICE_ERROR;
@@ -153,9 +182,18 @@ int HeapBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
 
     const uint8_t *buffer = static_cast<const uint8_t *>(b);
 
+    if (_arena) {
+        memcpy(&_arena[addr], buffer, size);
+        return 0;
+    }
+
     while (size > 0) {
         bd_addr_t hi = addr / _erase_size;
         bd_addr_t lo = addr % _erase_size;
+        bd_size_t chunk = _erase_size - lo;
+        if (chunk > size) {
+            chunk = size;
+        }
 
         if (!_blocks[hi]) {
             _blocks[hi] = (uint8_t *)malloc(_erase_size);
@@ -164,11 +202,11 @@ int HeapBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
             }
         }
 
-        memcpy(&_blocks[hi][lo], buffer, _program_size);
+        memcpy(&_blocks[hi][lo], buffer, chunk);
 
-        buffer += _program_size;
-        addr += _program_size;
-        size -= _program_size;
+        buffer += chunk;
+        addr += chunk;
+        size -= chunk;
     }
 
     return 0;
@@ -176,7 +214,7 @@ int HeapBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
 
 int HeapBlockDevice::erase(bd_addr_t addr, bd_size_t size)
 {
-    MBED_ASSERT(_blocks != NULL);
+    MBED_ASSERT(_blocks != NULL || _arena != NULL);
     MBED_ASSERT(is_valid_erase(addr, size));
     // TODO assert on programming unerased blocks
 
@@ -188,5 +226,10 @@ const char *HeapBlockDevice::get_type() const
     return "HEAP";
 }
 
+uint8_t *HeapBlockDevice::get_buffer() const
+{
+    return _arena;
+}
+
 } // namespace mbed
 
@@ -37,6 +37,15 @@ namespace mbed {
  *
  * Useful for simulating a block device and tests
  *
+ * Given an arena, the device is stored contiguously instead, and reads and
+ * programs are a single memcpy. The arena can be placed in a dedicated
+ * section for a RAM disk:
+ *
+ * @code
+ * MBED_SECTION(".ramdisk") static uint8_t ramdisk[64 * 1024];
+ * HeapBlockDevice bd(sizeof(ramdisk), 1, 1, 4096, ramdisk);
+ * @endcode
+ *
  * @code
  * #include "mbed.h"
  * #include "HeapBlockDevice.h"
@@ -74,6 +83,17 @@ public:
      * @param erase     Minimum erase size required in bytes
      */
     HeapBlockDevice(bd_size_t size, bd_size_t read, bd_size_t program, bd_size_t erase);
+    /** Lifetime of a contiguous memory block device
+     *
+     * @param size      Size of the Block Device in bytes
+     * @param read      Minimum read size required in bytes
+     * @param program   Minimum program size required in bytes
+     * @param erase     Minimum erase size required in bytes
+     * @param arena     Memory of at least size bytes to store the device in, its
+     *                  contents are kept. If NULL, the memory is allocated and
+     *                  zeroed on the first init()
+     */
+    HeapBlockDevice(bd_size_t size, bd_size_t read, bd_size_t program, bd_size_t erase, void *arena);
     virtual ~HeapBlockDevice();
 
     /** Initialize a block device
@@ -156,12 +176,24 @@ public:
      */
     virtual const char *get_type() const;
 
+    /** Get the memory of a contiguous block device
+     *
+     *  Allows accessing the device in place, e.g. to execute or map its
+     *  contents
+     *
+     *  @return         Memory of the device, NULL if it is lazily allocated or
+     *                  not allocated yet
+     */
+    uint8_t *get_buffer() const;
+
 private:
     bd_size_t _read_size;
     bd_size_t _program_size;
     bd_size_t _erase_size;
     bd_size_t _count;
     uint8_t **_blocks;
+    uint8_t *_arena;
+    bool _arena_owned;
     uint32_t _init_ref_count;
     bool _is_initialized;
 };
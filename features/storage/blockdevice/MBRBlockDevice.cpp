@@ -228,7 +228,8 @@ int MBRBlockDevice::partition(BlockDevice *bd, int part, uint8_t type,
 }
 
 MBRBlockDevice::MBRBlockDevice(BlockDevice *bd, int part)
-    : _bd(bd), _offset(0), _size(0), _type(0), _part(part), _init_ref_count(0), _is_initialized(false)
+    : _bd(bd), _offset(0), _size(0), _type(0), _part(part), _init_ref_count(0), _is_initialized(false),
+      _mapped_bd(bd), _mapped_offset(0)
 {
     MBED_ASSERT(_part >= 1 && _part <= 4);
 }
@@ -298,6 +299,10 @@ int MBRBlockDevice::init()
         goto fail;
     }
 
+    // Skip the slices and partitions below
+    _mapped_bd = _bd->get_mapped_device(&_mapped_offset);
+    _mapped_offset += _offset;
+
     _is_initialized = true;
     delete[] buffer;
     return BD_ERROR_OK;
@@ -341,7 +346,7 @@ int MBRBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
         return BD_ERROR_DEVICE_ERROR;
     }
 
-    return _bd->read(b, addr + _offset, size);
+    return _mapped_bd->read(b, addr + _mapped_offset, size);
 }
 
 int MBRBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
@@ -351,7 +356,7 @@ int MBRBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
         return BD_ERROR_DEVICE_ERROR;
     }
 
-    return _bd->program(b, addr + _offset, size);
+    return _mapped_bd->program(b, addr + _mapped_offset, size);
 }
 
 int MBRBlockDevice::erase(bd_addr_t addr, bd_size_t size)
@@ -361,7 +366,7 @@ int MBRBlockDevice::erase(bd_addr_t addr, bd_size_t size)
         return BD_ERROR_DEVICE_ERROR;
     }
 
-    return _bd->erase(addr + _offset, size);
+    return _mapped_bd->erase(addr + _mapped_offset, size);
 }
 
 bd_size_t MBRBlockDevice::get_read_size() const
@@ -434,6 +439,17 @@ int MBRBlockDevice::get_partition_number() const
     return _part;
 }
 
+BlockDevice *MBRBlockDevice::get_mapped_device(bd_addr_t *offset)
+{
+    if (!_is_initialized) {
+        *offset = 0;
+        return this;
+    }
+
+    *offset = _mapped_offset;
+    return _mapped_bd;
+}
+
 const char *MBRBlockDevice::get_type() const
 {
     if (_bd != NULL) {
@@ -203,6 +203,15 @@ public:
      */
     virtual int get_partition_number() const;
 
+    /** Get the device that reads, programs and erases are passed to
+     *
+     *  @param offset   Set to the address of block 0 in the returned device
+     *  @return         The device below this partition and any slices or
+     *                  partitions it is made of, or this device if it isn't
+     *                  initialized
+     */
+    virtual BlockDevice *get_mapped_device(bd_addr_t *offset);
+
     /** Get the BlockDevice class type.
      *
      *  @return         A string represent the BlockDevice class type.
@@ -217,6 +226,8 @@ protected:
     uint8_t _part;
     uint32_t _init_ref_count;
     bool _is_initialized;
+    BlockDevice *_mapped_bd;
+    bd_addr_t _mapped_offset;
 };
 
 } // namespace mbed
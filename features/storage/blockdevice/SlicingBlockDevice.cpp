@@ -25,6 +25,7 @@ SlicingBlockDevice::SlicingBlockDevice(BlockDevice *bd, bd_addr_t start, bd_addr
     : _bd(bd)
     , _start_from_end(false), _start(start)
     , _stop_from_end(false), _stop(stop)
+    , _mapped_bd(bd), _mapped_offset(start)
 {
     if ((int64_t)_start < 0) {
         _start_from_end = true;
@@ -60,6 +61,11 @@ int SlicingBlockDevice::init()
     // Check that block addresses are valid
     MBED_ASSERT(_bd->is_valid_erase(_start, _stop - _start));
 
+    // Skip the slices and partitions below
+    bd_addr_t offset;
+    _mapped_bd = _bd->get_mapped_device(&offset);
+    _mapped_offset = offset + _start;
+
     return 0;
 }
 
@@ -76,19 +82,19 @@ int SlicingBlockDevice::sync()
 int SlicingBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
 {
     MBED_ASSERT(is_valid_read(addr, size));
-    return _bd->read(b, addr + _start, size);
+    return _mapped_bd->read(b, addr + _mapped_offset, size);
 }
 
 int SlicingBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
 {
     MBED_ASSERT(is_valid_program(addr, size));
-    return _bd->program(b, addr + _start, size);
+    return _mapped_bd->program(b, addr + _mapped_offset, size);
 }
 
 int SlicingBlockDevice::erase(bd_addr_t addr, bd_size_t size)
 {
     MBED_ASSERT(is_valid_erase(addr, size));
-    return _bd->erase(addr + _start, size);
+    return _mapped_bd->erase(addr + _mapped_offset, size);
 }
 
 bd_size_t SlicingBlockDevice::get_read_size() const
@@ -121,6 +127,12 @@ bd_size_t SlicingBlockDevice::size() const
     return _stop - _start;
 }
 
+BlockDevice *SlicingBlockDevice::get_mapped_device(bd_addr_t *offset)
+{
+    *offset = _mapped_offset;
+    return _mapped_bd;
+}
+
 const char *SlicingBlockDevice::get_type() const
 {
     if (_bd != NULL) {
@@ -145,6 +145,14 @@ public:
      */
     virtual bd_size_t size() const;
 
+    /** Get the device that reads, programs and erases are passed to
+     *
+     *  @param offset   Set to the address of block 0 in the returned device
+     *  @return         The device below this slice and any slices or
+     *                  partitions it is made of
+     */
+    virtual BlockDevice *get_mapped_device(bd_addr_t *offset);
+
     /** Get the BlockDevice class type.
      *
      *  @return         A string represent the BlockDevice class type.
@@ -157,6 +165,8 @@ protected:
     bd_size_t _start;
     bool _stop_from_end;
     bd_size_t _stop;
+    BlockDevice *_mapped_bd;
+    bd_addr_t _mapped_offset;
 };
 
 } // namespace mbed
@@ -0,0 +1,458 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "StripingBlockDevice.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_assert.h"
+#include <algorithm>
+#include <new>
+#if MBED_CONF_RTOS_PRESENT
+#include "rtos/Semaphore.h"
+#endif
+
+namespace mbed {
+
+// States of the request a block device is working on
+enum {
+    PART_ISSUING,   // being issued, a callback from now on completes it
+    PART_COMPLETED, // completed before the issuer got to wait for it
+    PART_WAITING,   // issued, the callback issues the next one
+};
+
+#if MBED_CONF_RTOS_PRESENT
+struct striping_waiter_t {
+    rtos::Semaphore sem;
+    int error;
+
+    striping_waiter_t() : sem(0), error(0) {}
+
+    void done(int err)
+    {
+        error = err;
+        sem.release();
+    }
+};
+#endif
+
+static bool is_aligned(uint64_t x, uint64_t alignment)
+{
+    return (x / alignment) * alignment == x;
+}
+
+StripingBlockDevice::StripingBlockDevice(BlockDevice **bds, size_t bd_count)
+    : _bds(bds), _bd_count(bd_count)
+    , _read_size(0), _program_size(0), _erase_size(0), _size(0), _erase_value(-1)
+    , _parts(0), _op(OP_NONE), _buffer(0), _start(0), _end(0), _pending(0), _error(0)
+    , _init_ref_count(0), _is_initialized(false)
+{
+}
+
+StripingBlockDevice::~StripingBlockDevice()
+{
+    delete[] _parts;
+}
+
+int StripingBlockDevice::init()
+{
+    int err;
+    size_t count = 0;
+    bd_size_t min_size = 0;
+    uint32_t val = core_util_atomic_incr_u32(&_init_ref_count, 1);
+
+    if (val != 1) {
+        return BD_ERROR_OK;
+    }
+
+    MBED_ASSERT(_bd_count > 0);
+
+    _read_size = 0;
+    _program_size = 0;
+    _erase_size = 0;
+    _erase_value = -1;
+    _size = 0;
+
+    // Initialize children block devices, find all sizes and
+    // assert that block sizes are similar
+    for (; count < _bd_count; count++) {
+        err = _bds[count]->init();
+        if (err) {
+            goto fail;
+        }
+
+        bd_size_t read = _bds[count]->get_read_size();
+        if (count == 0 || (read >= _read_size && is_aligned(read, _read_size))) {
+            _read_size = read;
+        } else {
+            MBED_ASSERT(_read_size > read && is_aligned(_read_size, read));
+        }
+
+        bd_size_t program = _bds[count]->get_program_size();
+        if (count == 0 || (program >= _program_size && is_aligned(program, _program_size))) {
+            _program_size = program;
+        } else {
+            MBED_ASSERT(_program_size > program && is_aligned(_program_size, program));
+        }
+
+        bd_size_t erase = _bds[count]->get_erase_size();
+        if (count == 0 || (erase >= _erase_size && is_aligned(erase, _erase_size))) {
+            _erase_size = erase;
+        } else {
+            MBED_ASSERT(_erase_size > erase && is_aligned(_erase_size, erase));
+        }
+
+        int value = _bds[count]->get_erase_value();
+        if (count == 0 || value == _erase_value) {
+            _erase_value = value;
+        } else {
+            _erase_value = -1;
+        }
+
+        if (count == 0 || _bds[count]->size() < min_size) {
+            min_size = _bds[count]->size();
+        }
+    }
+
+    // The erase sizes are multiples of each other, so a stripe of the
+    // largest one is made of whole erase blocks on each block device
+    _size = (min_size / _erase_size) * _erase_size * _bd_count;
+
+    if (!_parts) {
+        _parts = new (std::nothrow) part_t[_bd_count];
+        if (!_parts) {
+            err = BD_ERROR_DEVICE_ERROR;
+            goto fail;
+        }
+    }
+    for (size_t i = 0; i < _bd_count; i++) {
+        _parts[i].owner = this;
+        _parts[i].bd = _bds[i];
+    }
+
+    _op = OP_NONE;
+    _is_initialized = true;
+    return BD_ERROR_OK;
+
+fail:
+    while (count--) {
+        _bds[count]->deinit();
+    }
+    _is_initialized = false;
+    _init_ref_count = 0;
+    return err;
+}
+
+int StripingBlockDevice::deinit()
+{
+    if (!_is_initialized) {
+        return BD_ERROR_OK;
+    }
+
+    uint32_t val = core_util_atomic_decr_u32(&_init_ref_count, 1);
+
+    if (val) {
+        return BD_ERROR_OK;
+    }
+
+    for (size_t i = 0; i < _bd_count; i++) {
+        int err = _bds[i]->deinit();
+        if (err) {
+            return err;
+        }
+    }
+
+    _is_initialized = false;
+    return BD_ERROR_OK;
+}
+
+int StripingBlockDevice::sync()
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    for (size_t i = 0; i < _bd_count; i++) {
+        int err = _bds[i]->sync();
+        if (err) {
+            return err;
+        }
+    }
+
+    return 0;
+}
+
+int StripingBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(is_valid_read(addr, size));
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return wait(OP_READ, b, addr, size);
+}
+
+int StripingBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(is_valid_program(addr, size));
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return wait(OP_PROGRAM, b, addr, size);
+}
+
+int StripingBlockDevice::erase(bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(is_valid_erase(addr, size));
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return wait(OP_ERASE, 0, addr, size);
+}
+
+int StripingBlockDevice::read_async(void *b, bd_addr_t addr, bd_size_t size, bd_callback_t callback)
+{
+    MBED_ASSERT(is_valid_read(addr, size));
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return start(OP_READ, b, addr, size, callback);
+}
+
+int StripingBlockDevice::program_async(const void *b, bd_addr_t addr, bd_size_t size, bd_callback_t callback)
+{
+    MBED_ASSERT(is_valid_program(addr, size));
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return start(OP_PROGRAM, b, addr, size, callback);
+}
+
+int StripingBlockDevice::erase_async(bd_addr_t addr, bd_size_t size, bd_callback_t callback)
+{
+    MBED_ASSERT(is_valid_erase(addr, size));
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return start(OP_ERASE, 0, addr, size, callback);
+}
+
+int StripingBlockDevice::start(op_t op, const void *buffer, bd_addr_t addr, bd_size_t size, bd_callback_t callback)
+{
+    uint8_t expected = OP_NONE;
+    if (!core_util_atomic_cas_u8(&_op, &expected, op)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    _buffer = static_cast<uint8_t *>(const_cast<void *>(buffer));
+    _start = addr;
+    _end = addr + size;
+    _error = 0;
+    _callback = callback;
+
+    // Each block device starts at its first stripe from addr on. The
+    // extra count keeps the request from completing while it is issued
+    bd_size_t first = addr / _erase_size;
+    _pending = _bd_count + 1;
+    for (size_t i = 0; i < _bd_count; i++) {
+        bd_size_t stripe = first + (i + _bd_count - first % _bd_count) % _bd_count;
+        _parts[i].next = (stripe == first) ? addr : stripe * _erase_size;
+        _parts[i].error = 0;
+    }
+
+    for (size_t i = 0; i < _bd_count; i++) {
+        issue(&_parts[i]);
+    }
+    part_done(0);
+    return 0;
+}
+
+void StripingBlockDevice::issue(part_t *part)
+{
+    // Requests completing before they return are followed up here rather
+    // than from their callback, so the stack doesn't grow with each stripe
+    while (part->next < _end) {
+        bd_addr_t addr = part->next;
+        bd_size_t stripe = addr / _erase_size;
+        bd_addr_t bd_addr = (stripe / _bd_count) * _erase_size + addr % _erase_size;
+        bd_size_t size;
+
+        if (_op == OP_ERASE) {
+            // The stripes of a block device are contiguous on it
+            bd_size_t stripes = (_end / _erase_size - stripe + _bd_count - 1) / _bd_count;
+            size = stripes * _erase_size;
+            part->next = _end;
+        } else {
+            size = std::min((stripe + 1) * _erase_size, _end) - addr;
+            part->next = (stripe + _bd_count) * _erase_size;
+        }
+
+        part->state = PART_ISSUING;
+        bd_callback_t callback(part, &part_t::done);
+        int err;
+        if (_op == OP_READ) {
+            err = part->bd->read_async(_buffer + (addr - _start), bd_addr, size, callback);
+        } else if (_op == OP_PROGRAM) {
+            err = part->bd->program_async(_buffer + (addr - _start), bd_addr, size, callback);
+        } else {
+            err = part->bd->erase_async(bd_addr, size, callback);
+        }
+
+        if (err) {
+            part->error = err;
+            break;
+        }
+
+        uint8_t expected = PART_ISSUING;
+        if (core_util_atomic_cas_u8(&part->state, &expected, PART_WAITING)) {
+            return;
+        }
+
+        if (part->error) {
+            break;
+        }
+    }
+
+    part_done(part);
+}
+
+void StripingBlockDevice::part_t::done(int err)
+{
+    if (err) {
+        error = err;
+    }
+
+    uint8_t expected = PART_ISSUING;
+    if (core_util_atomic_cas_u8(&state, &expected, PART_COMPLETED)) {
+        return;
+    }
+
+    if (error) {
+        owner->part_done(this);
+    } else {
+        owner->issue(this);
+    }
+}
+
+void StripingBlockDevice::part_done(part_t *part)
+{
+    if (part && part->error) {
+        core_util_critical_section_enter();
+        if (!_error) {
+            _error = part->error;
+        }
+        core_util_critical_section_exit();
+    }
+
+    if (core_util_atomic_decr_u32(&_pending, 1) == 0) {
+        bd_callback_t callback = _callback;
+        int err = _error;
+        _callback = NULL;
+        _op = OP_NONE;
+
+        // The callback may start another request
+        callback(err);
+    }
+}
+
+int StripingBlockDevice::wait(op_t op, const void *buffer, bd_addr_t addr, bd_size_t size)
+{
+    _mutex.lock();
+
+#if MBED_CONF_RTOS_PRESENT
+    striping_waiter_t waiter;
+    int err = start(op, buffer, addr, size, callback(&waiter, &striping_waiter_t::done));
+    if (!err) {
+        waiter.sem.wait();
+        err = waiter.error;
+    }
+#else
+    // Without an RTOS nothing would complete requests running in the
+    // background while waiting, so the block devices are used in turn
+    uint8_t expected = OP_NONE;
+    if (!core_util_atomic_cas_u8(&_op, &expected, op)) {
+        _mutex.unlock();
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    int err = 0;
+    uint8_t *data = static_cast<uint8_t *>(const_cast<void *>(buffer));
+    bd_addr_t end = addr + size;
+    while (addr < end && !err) {
+        bd_size_t stripe = addr / _erase_size;
+        BlockDevice *bd = _bds[stripe % _bd_count];
+        bd_addr_t bd_addr = (stripe / _bd_count) * _erase_size + addr % _erase_size;
+        bd_size_t chunk = std::min((stripe + 1) * _erase_size, end) - addr;
+
+        if (op == OP_READ) {
+            err = bd->read(data, bd_addr, chunk);
+        } else if (op == OP_PROGRAM) {
+            err = bd->program(data, bd_addr, chunk);
+        } else {
+            err = bd->erase(bd_addr, chunk);
+        }
+
+        if (data) {
+            data += chunk;
+        }
+        addr += chunk;
+    }
+    _op = OP_NONE;
+#endif
+
+    _mutex.unlock();
+    return err;
+}
+
+bd_size_t StripingBlockDevice::get_read_size() const
+{
+    return _read_size;
+}
+
+bd_size_t StripingBlockDevice::get_program_size() const
+{
+    return _program_size;
+}
+
+bd_size_t StripingBlockDevice::get_erase_size() const
+{
+    return _erase_size;
+}
+
+bd_size_t StripingBlockDevice::get_erase_size(bd_addr_t addr) const
+{
+    return _erase_size;
+}
+
+int StripingBlockDevice::get_erase_value() const
+{
+    return _erase_value;
+}
+
+bd_size_t StripingBlockDevice::size() const
+{
+    return _size;
+}
+
+const char *StripingBlockDevice::get_type() const
+{
+    return "STRIPING";
+}
+
+} // namespace mbed
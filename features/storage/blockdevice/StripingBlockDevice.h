@@ -0,0 +1,274 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup storage */
+/** @{*/
+
+#ifndef MBED_STRIPING_BLOCK_DEVICE_H
+#define MBED_STRIPING_BLOCK_DEVICE_H
+
+#include "BlockDevice.h"
+#include "platform/PlatformMutex.h"
+
+namespace mbed {
+
+/** Block device striping consecutive blocks over multiple block devices
+ *
+ *  The address space is split into stripes of the largest erase size of the
+ *  block devices, stripe n being stored on block device n modulo the number
+ *  of block devices. Reads,
+ *  programs and erases spanning several stripes are issued to all the block
+ *  devices at once through their asynchronous requests, so devices that
+ *  complete requests in the background, like SPI flashes on separate buses,
+ *  work in parallel. The requests to each block device are issued one after
+ *  the other.
+ *
+ *  Only the smallest block device is used in full, the others are used up to
+ *  the same number of stripes.
+ *
+ *  @code
+ *  #include "mbed.h"
+ *  #include "SPIFBlockDevice.h"
+ *  #include "StripingBlockDevice.h"
+ *
+ *  SPIFBlockDevice flash1(PA_7, PA_6, PA_5, PA_4);
+ *  SPIFBlockDevice flash2(PB_15, PB_14, PB_13, PB_12);
+ *
+ *  // Consecutive sectors alternate between flash1 and flash2
+ *  BlockDevice *bds[] = {&flash1, &flash2};
+ *  StripingBlockDevice striped(bds);
+ *  @endcode
+ */
+class StripingBlockDevice : public BlockDevice {
+public:
+    /** Lifetime of the block device
+     *
+     *  @param bds          Array of block devices to stripe over
+     *  @param bd_count     Number of block devices to stripe over
+     *  @note The erase sizes of the block devices must be multiples of each other
+     */
+    StripingBlockDevice(BlockDevice **bds, size_t bd_count);
+
+    /** Lifetime of the block device
+     *
+     *  @param bds          Array of block devices to stripe over
+     *  @note The erase sizes of the block devices must be multiples of each other
+     */
+    template <size_t Size>
+    StripingBlockDevice(BlockDevice * (&bds)[Size])
+        : _bds(bds), _bd_count(sizeof(bds) / sizeof(bds[0]))
+        , _read_size(0), _program_size(0), _erase_size(0), _size(0), _erase_value(-1)
+        , _parts(0), _op(OP_NONE), _buffer(0), _start(0), _end(0), _pending(0), _error(0)
+        , _init_ref_count(0), _is_initialized(false)
+    {
+    }
+
+    /** Lifetime of the block device
+     */
+    virtual ~StripingBlockDevice();
+
+    /** Initialize a block device
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int init();
+
+    /** Deinitialize a block device
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int deinit();
+
+    /** Ensure data on storage is in sync with the driver
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int sync();
+
+    /** Read blocks from a block device
+     *
+     *  @param buffer   Buffer to read blocks into
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int read(void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Program blocks to a block device
+     *
+     *  The blocks must have been erased prior to being programmed
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int program(const void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Erase blocks on a block device
+     *
+     *  The state of an erased block is undefined until it has been programmed,
+     *  unless get_erase_value returns a non-negative byte value
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of erase block size
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int erase(bd_addr_t addr, bd_size_t size);
+
+    /** Read blocks from a block device without waiting for the read to complete
+     *
+     *  Only one asynchronous request can be in progress at a time.
+     *
+     *  @param buffer   Buffer to read blocks into
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of the read block size
+     *  @param callback Callback called with the result of the read, once all
+     *                  block devices completed their part
+     *  @return         0 if the read was started, BD_ERROR_DEVICE_ERROR if
+     *                  another asynchronous request is in progress
+     */
+    virtual int read_async(void *buffer, bd_addr_t addr, bd_size_t size, bd_callback_t callback);
+
+    /** Program blocks to a block device without waiting for the program to complete
+     *
+     *  Only one asynchronous request can be in progress at a time.
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of the program block size
+     *  @param callback Callback called with the result of the program, once
+     *                  all block devices completed their part
+     *  @return         0 if the program was started, BD_ERROR_DEVICE_ERROR if
+     *                  another asynchronous request is in progress
+     */
+    virtual int program_async(const void *buffer, bd_addr_t addr, bd_size_t size, bd_callback_t callback);
+
+    /** Erase blocks on a block device without waiting for the erase to complete
+     *
+     *  Only one asynchronous request can be in progress at a time. The
+     *  stripes of each block device are erased in a single request.
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of the erase block size
+     *  @param callback Callback called with the result of the erase, once all
+     *                  block devices completed their part
+     *  @return         0 if the erase was started, BD_ERROR_DEVICE_ERROR if
+     *                  another asynchronous request is in progress
+     */
+    virtual int erase_async(bd_addr_t addr, bd_size_t size, bd_callback_t callback);
+
+    /** Get the size of a readable block
+     *
+     *  @return         Size of a readable block in bytes
+     */
+    virtual bd_size_t get_read_size() const;
+
+    /** Get the size of a programmable block
+     *
+     *  @return         Size of a programmable block in bytes
+     *  @note Must be a multiple of the read size
+     */
+    virtual bd_size_t get_program_size() const;
+
+    /** Get the size of an erasable block
+     *
+     *  @return         Size of an erasable block in bytes, the stripe size
+     *  @note Must be a multiple of the program size
+     */
+    virtual bd_size_t get_erase_size() const;
+
+    /** Get the size of an erasable block given address
+     *
+     *  @param addr     Address within the erasable block
+     *  @return         Size of an erasable block in bytes, the stripe size
+     *  @note Must be a multiple of the program size
+     */
+    virtual bd_size_t get_erase_size(bd_addr_t addr) const;
+
+    /** Get the value of storage when erased
+     *
+     *  @return         The value of storage when erased, or -1 if you can't
+     *                  rely on the value of erased storage
+     */
+    virtual int get_erase_value() const;
+
+    /** Get the total size of the striped device
+     *
+     *  @return         Size of the striped device in bytes
+     */
+    virtual bd_size_t size() const;
+
+    /** Get the BlockDevice class type.
+     *
+     *  @return         A string represent the BlockDevice class type.
+     */
+    virtual const char *get_type() const;
+
+private:
+    enum op_t {
+        OP_NONE,
+        OP_READ,
+        OP_PROGRAM,
+        OP_ERASE,
+    };
+
+    // Requests of one block device, issued one at a time
+    struct part_t {
+        StripingBlockDevice *owner;
+        BlockDevice *bd;
+        bd_addr_t next;
+        volatile uint8_t state;
+        int error;
+
+        void done(int err);
+    };
+
+    BlockDevice **_bds;
+    size_t _bd_count;
+    bd_size_t _read_size;
+    bd_size_t _program_size;
+    bd_size_t _erase_size;
+    bd_size_t _size;
+    int _erase_value;
+    part_t *_parts;
+    PlatformMutex _mutex;
+    volatile uint8_t _op;
+    uint8_t *_buffer;
+    bd_addr_t _start;
+    bd_addr_t _end;
+    volatile uint32_t _pending;
+    int _error;
+    bd_callback_t _callback;
+    uint32_t _init_ref_count;
+    bool _is_initialized;
+
+    int start(op_t op, const void *buffer, bd_addr_t addr, bd_size_t size, bd_callback_t callback);
+    int wait(op_t op, const void *buffer, bd_addr_t addr, bd_size_t size);
+    void issue(part_t *part);
+    void part_done(part_t *part);
+};
+
+} // namespace mbed
+
+// Added "using" for backwards compatibility
+#ifndef MBED_NO_GLOBAL_USING_DIRECTIVE
+using mbed::StripingBlockDevice;
+#endif
+
+#endif
+
+/** @}*/
@@ -0,0 +1,409 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "WearStatsBlockDevice.h"
+#include "platform/mbed_assert.h"
+#include "drivers/MbedCRC.h"
+#include <string.h>
+#include <new>
+
+namespace mbed {
+
+// Stored stats are a header followed by the byte counts, the latency
+// histograms and the erase count of each unit
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t buckets;
+    uint32_t unit_size;
+    uint32_t unit_count;
+    uint32_t crc;
+} stats_header_t;
+
+static const uint32_t stats_magic = 0x57454152;
+static const uint16_t stats_version = 1;
+static const int stats_byte_counts = 4;
+
+static uint32_t calc_crc(uint32_t init_crc, uint32_t data_size, const void *data_buf)
+{
+    uint32_t crc;
+    MbedCRC<POLY_32BIT_ANSI, 32> ct(init_crc, 0x0, true, false);
+    ct.compute(const_cast<void *>(data_buf), data_size, &crc);
+    return crc;
+}
+
+static inline bd_size_t align_up(bd_size_t val, bd_size_t size)
+{
+    return (val + size - 1) / size * size;
+}
+
+WearStatsBlockDevice::WearStatsBlockDevice(BlockDevice *bd, bd_size_t stats_size)
+    : _bd(bd), _stats_size(stats_size), _unit_size(0), _unit_count(0), _erase_counts(0),
+      _is_initialized(false), _dirty(false)
+{
+    reset();
+    _dirty = false;
+}
+
+WearStatsBlockDevice::~WearStatsBlockDevice()
+{
+    deinit();
+    delete[] _erase_counts;
+}
+
+int WearStatsBlockDevice::init()
+{
+    if (_is_initialized) {
+        return BD_ERROR_OK;
+    }
+
+    int err = _bd->init();
+    if (err) {
+        return err;
+    }
+
+    MBED_ASSERT(!_stats_size || _bd->is_valid_erase(_bd->size() - _stats_size, _stats_size));
+
+    bd_size_t unit_size = _bd->get_erase_size();
+    bd_size_t unit_count = (_bd->size() + unit_size - 1) / unit_size;
+    if (!_erase_counts || unit_count != _unit_count) {
+        delete[] _erase_counts;
+        _erase_counts = new (std::nothrow) uint32_t[unit_count];
+        if (!_erase_counts) {
+            _unit_count = 0;
+            _bd->deinit();
+            return BD_ERROR_DEVICE_ERROR;
+        }
+    }
+    _unit_size = unit_size;
+    _unit_count = unit_count;
+    reset();
+
+    if (_stats_size) {
+        err = load();
+        if (err) {
+            _bd->deinit();
+            return err;
+        }
+    }
+    _dirty = false;
+
+    _timer.reset();
+    _timer.start();
+    _is_initialized = true;
+    return BD_ERROR_OK;
+}
+
+int WearStatsBlockDevice::deinit()
+{
+    if (!_is_initialized) {
+        return BD_ERROR_OK;
+    }
+
+    int err = BD_ERROR_OK;
+    if (_stats_size && _dirty) {
+        err = save();
+    }
+
+    _timer.stop();
+    _is_initialized = false;
+
+    int deinit_err = _bd->deinit();
+    return err ? err : deinit_err;
+}
+
+int WearStatsBlockDevice::sync()
+{
+    return _bd->sync();
+}
+
+int WearStatsBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(is_valid_read(addr, size));
+    us_timestamp_t start = _timer.read_high_resolution_us();
+    int err = _bd->read(b, addr, size);
+    if (!err) {
+        record_latency(OP_READ, start);
+        _read_count += size;
+    }
+    return err;
+}
+
+int WearStatsBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(is_valid_program(addr, size));
+    us_timestamp_t start = _timer.read_high_resolution_us();
+    int err = _bd->program(b, addr, size);
+    if (!err) {
+        record_latency(OP_PROGRAM, start);
+        _program_count += size;
+    }
+    return err;
+}
+
+int WearStatsBlockDevice::erase(bd_addr_t addr, bd_size_t size)
+{
+    MBED_ASSERT(is_valid_erase(addr, size));
+    us_timestamp_t start = _timer.read_high_resolution_us();
+    int err = _bd->erase(addr, size);
+    if (!err) {
+        record_latency(OP_ERASE, start);
+        _erase_bytes += size;
+        count_erase(addr, size);
+    }
+    return err;
+}
+
+void WearStatsBlockDevice::record_latency(operation op, us_timestamp_t start)
+{
+    us_timestamp_t elapsed = _timer.read_high_resolution_us() - start;
+    int bucket = 0;
+    while (elapsed && bucket < HISTOGRAM_BUCKETS - 1) {
+        elapsed >>= 1;
+        bucket++;
+    }
+    _latency[op][bucket]++;
+    _dirty = true;
+}
+
+void WearStatsBlockDevice::count_erase(bd_addr_t addr, bd_size_t size)
+{
+    for (bd_size_t unit = addr / _unit_size; unit < _unit_count && unit * _unit_size < addr + size; unit++) {
+        if (_erase_counts[unit] != 0xFFFFFFFF) {
+            _erase_counts[unit]++;
+        }
+    }
+    _dirty = true;
+}
+
+bd_size_t WearStatsBlockDevice::record_size() const
+{
+    return sizeof(stats_header_t) + stats_byte_counts * sizeof(uint64_t) +
+           sizeof(_latency) + _unit_count * sizeof(uint32_t);
+}
+
+int WearStatsBlockDevice::load()
+{
+    bd_addr_t stats_addr = _bd->size() - _stats_size;
+    bd_size_t buffer_size = align_up(record_size(), _bd->get_read_size());
+    if (buffer_size > _stats_size) {
+        // Can't hold the stats, save reports it
+        return BD_ERROR_OK;
+    }
+
+    uint8_t *buffer = new (std::nothrow) uint8_t[buffer_size];
+    if (!buffer) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    int err = _bd->read(buffer, stats_addr, buffer_size);
+    if (err) {
+        delete[] buffer;
+        return err;
+    }
+
+    stats_header_t header;
+    memcpy(&header, buffer, sizeof(header));
+    const uint8_t *payload = buffer + sizeof(header);
+    bd_size_t payload_size = record_size() - sizeof(header);
+
+    uint32_t crc = calc_crc(0xFFFFFFFF, sizeof(header) - sizeof(header.crc), &header);
+    crc = calc_crc(crc, payload_size, payload);
+
+    // Stats of a different device layout or an interrupted save are dropped
+    if (header.magic == stats_magic && header.version == stats_version &&
+            header.buckets == HISTOGRAM_BUCKETS && header.unit_size == _unit_size &&
+            header.unit_count == _unit_count && header.crc == crc) {
+        uint64_t counts[stats_byte_counts];
+        memcpy(counts, payload, sizeof(counts));
+        payload += sizeof(counts);
+        _requested_count = counts[0];
+        _read_count = counts[1];
+        _program_count = counts[2];
+        _erase_bytes = counts[3];
+        memcpy(_latency, payload, sizeof(_latency));
+        payload += sizeof(_latency);
+        memcpy(_erase_counts, payload, _unit_count * sizeof(uint32_t));
+    }
+
+    delete[] buffer;
+    return BD_ERROR_OK;
+}
+
+int WearStatsBlockDevice::save()
+{
+    if (!_is_initialized || !_stats_size) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    bd_addr_t stats_addr = _bd->size() - _stats_size;
+    bd_size_t buffer_size = align_up(record_size(), _bd->get_program_size());
+    if (buffer_size > _stats_size) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    uint8_t *buffer = new (std::nothrow) uint8_t[buffer_size];
+    if (!buffer) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    int err = _bd->erase(stats_addr, _stats_size);
+    if (err) {
+        delete[] buffer;
+        return err;
+    }
+    // The reserved region wears too, count it before it is stored
+    count_erase(stats_addr, _stats_size);
+
+    uint8_t *payload = buffer + sizeof(stats_header_t);
+    uint64_t counts[stats_byte_counts] = {
+        _requested_count, _read_count, _program_count, _erase_bytes
+    };
+    memcpy(payload, counts, sizeof(counts));
+    payload += sizeof(counts);
+    memcpy(payload, _latency, sizeof(_latency));
+    payload += sizeof(_latency);
+    memcpy(payload, _erase_counts, _unit_count * sizeof(uint32_t));
+    payload += _unit_count * sizeof(uint32_t);
+    memset(payload, 0xFF, buffer + buffer_size - payload);
+
+    stats_header_t header;
+    header.magic = stats_magic;
+    header.version = stats_version;
+    header.buckets = HISTOGRAM_BUCKETS;
+    header.unit_size = _unit_size;
+    header.unit_count = _unit_count;
+    header.crc = calc_crc(0xFFFFFFFF, sizeof(header) - sizeof(header.crc), &header);
+    header.crc = calc_crc(header.crc, record_size() - sizeof(header), buffer + sizeof(header));
+    memcpy(buffer, &header, sizeof(header));
+
+    err = _bd->program(buffer, stats_addr, buffer_size);
+    delete[] buffer;
+    if (!err) {
+        _dirty = false;
+    }
+    return err;
+}
+
+void WearStatsBlockDevice::reset()
+{
+    _requested_count = 0;
+    _read_count = 0;
+    _program_count = 0;
+    _erase_bytes = 0;
+    memset(_latency, 0, sizeof(_latency));
+    if (_erase_counts) {
+        memset(_erase_counts, 0, _unit_count * sizeof(uint32_t));
+    }
+    _dirty = true;
+}
+
+void WearStatsBlockDevice::add_requested_count(bd_size_t size)
+{
+    _requested_count += size;
+    _dirty = true;
+}
+
+bd_size_t WearStatsBlockDevice::get_requested_count() const
+{
+    return _requested_count;
+}
+
+bd_size_t WearStatsBlockDevice::get_read_count() const
+{
+    return _read_count;
+}
+
+bd_size_t WearStatsBlockDevice::get_program_count() const
+{
+    return _program_count;
+}
+
+bd_size_t WearStatsBlockDevice::get_erase_count() const
+{
+    return _erase_bytes;
+}
+
+bd_size_t WearStatsBlockDevice::get_unit_count() const
+{
+    return _unit_count;
+}
+
+uint32_t WearStatsBlockDevice::get_unit_erase_count(bd_addr_t addr) const
+{
+    if (!_erase_counts || addr / _unit_size >= _unit_count) {
+        return 0;
+    }
+    return _erase_counts[addr / _unit_size];
+}
+
+uint32_t WearStatsBlockDevice::get_max_erase_count() const
+{
+    uint32_t max = 0;
+    for (bd_size_t i = 0; i < _unit_count; i++) {
+        if (_erase_counts[i] > max) {
+            max = _erase_counts[i];
+        }
+    }
+    return max;
+}
+
+uint32_t WearStatsBlockDevice::get_latency_count(operation op, int bucket) const
+{
+    MBED_ASSERT(op < OP_COUNT && bucket >= 0 && bucket < HISTOGRAM_BUCKETS);
+    return _latency[op][bucket];
+}
+
+bd_size_t WearStatsBlockDevice::get_read_size() const
+{
+    return _bd->get_read_size();
+}
+
+bd_size_t WearStatsBlockDevice::get_program_size() const
+{
+    return _bd->get_program_size();
+}
+
+bd_size_t WearStatsBlockDevice::get_erase_size() const
+{
+    return _bd->get_erase_size();
+}
+
+bd_size_t WearStatsBlockDevice::get_erase_size(bd_addr_t addr) const
+{
+    return _bd->get_erase_size(addr);
+}
+
+int WearStatsBlockDevice::get_erase_value() const
+{
+    return _bd->get_erase_value();
+}
+
+bd_size_t WearStatsBlockDevice::size() const
+{
+    return _bd->size() - _stats_size;
+}
+
+const char *WearStatsBlockDevice::get_type() const
+{
+    if (_bd != NULL) {
+        return _bd->get_type();
+    }
+
+    return NULL;
+}
+
+} // namespace mbed
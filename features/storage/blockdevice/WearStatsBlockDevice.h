@@ -0,0 +1,289 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup storage */
+/** @{*/
+
+#ifndef MBED_WEAR_STATS_BLOCK_DEVICE_H
+#define MBED_WEAR_STATS_BLOCK_DEVICE_H
+
+#include "BlockDevice.h"
+#include "drivers/Timer.h"
+
+namespace mbed {
+
+/** Block device for measuring the wear and latency of another block device
+ *
+ *  Tracks how many times each erase unit of the underlying block device was
+ *  erased, the bytes read, programmed and erased, and a histogram of the time
+ *  taken by each operation. Bucket 0 of a histogram counts operations that
+ *  took less than 1 us, and bucket n counts the ones that took between 2^(n-1)
+ *  and 2^n us, the last bucket also counting all slower ones.
+ *
+ *  The stats can be kept across resets in a region reserved at the end of
+ *  the underlying block device. They are loaded by init, and stored by save
+ *  and deinit.
+ *
+ *  Example:
+ *  @code
+ *  WearStatsBlockDevice stats(&bd, 4096);
+ *  LittleFileSystem fs("fs", &stats);
+ *
+ *  FILE *f = fopen("/fs/log", "a");
+ *  fwrite(buffer, 1, size, f);
+ *  fclose(f);
+ *  stats.add_requested_count(size);
+ *
+ *  printf("write amplification %llu/%llu\n",
+ *         stats.get_program_count(), stats.get_requested_count());
+ *  @endcode
+ */
+class WearStatsBlockDevice : public BlockDevice {
+public:
+    /** Operations timed by the block device */
+    enum operation {
+        OP_READ,
+        OP_PROGRAM,
+        OP_ERASE,
+        OP_COUNT
+    };
+
+    /** Number of buckets in each latency histogram */
+    static const int HISTOGRAM_BUCKETS = 16;
+
+    /** Lifetime of the block device
+     *
+     *  @param bd           Block device to back the WearStatsBlockDevice
+     *  @param stats_size   Size in bytes of the region reserved at the end of
+     *                      the underlying block device to store the stats,
+     *                      a multiple of its erase size, or 0 to not store them
+     */
+    WearStatsBlockDevice(BlockDevice *bd, bd_size_t stats_size = 0);
+
+    /** Lifetime of a block device
+     */
+    virtual ~WearStatsBlockDevice();
+
+    /** Initialize a block device
+     *
+     *  Loads the stats stored in the reserved region. The stats start from
+     *  zero if there is no reserved region or it holds no valid stats.
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int init();
+
+    /** Deinitialize a block device
+     *
+     *  Stores the stats in the reserved region if they changed.
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int deinit();
+
+    /** Ensure data on storage is in sync with the driver
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int sync();
+
+    /** Read blocks from a block device
+     *
+     *  @param buffer   Buffer to read blocks into
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int read(void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Program blocks to a block device
+     *
+     *  The blocks must have been erased prior to being programmed
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int program(const void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Erase blocks on a block device
+     *
+     *  The state of an erased block is undefined until it has been programmed,
+     *  unless get_erase_value returns a non-negative byte value
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of erase block size
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int erase(bd_addr_t addr, bd_size_t size);
+
+    /** Get the size of a readable block
+     *
+     *  @return         Size of a readable block in bytes
+     */
+    virtual bd_size_t get_read_size() const;
+
+    /** Get the size of a programmable block
+     *
+     *  @return         Size of a programmable block in bytes
+     *  @note Must be a multiple of the read size
+     */
+    virtual bd_size_t get_program_size() const;
+
+    /** Get the size of an erasable block
+     *
+     *  @return         Size of an erasable block in bytes
+     *  @note Must be a multiple of the program size
+     */
+    virtual bd_size_t get_erase_size() const;
+
+    /** Get the size of an erasable block given address
+     *
+     *  @param addr     Address within the erasable block
+     *  @return         Size of an erasable block in bytes
+     *  @note Must be a multiple of the program size
+     */
+    virtual bd_size_t get_erase_size(bd_addr_t addr) const;
+
+    /** Get the value of storage when erased
+     *
+     *  @return         The value of storage when erased, or -1 if you can't
+     *                  rely on the value of erased storage
+     */
+    virtual int get_erase_value() const;
+
+    /** Get the total size of the device, without the reserved region
+     *
+     *  @return         Size of the device in bytes
+     */
+    virtual bd_size_t size() const;
+
+    /** Get the BlockDevice class type.
+     *
+     *  @return         A string represent the BlockDevice class type.
+     */
+    virtual const char *get_type() const;
+
+    /** Store the stats in the reserved region
+     *
+     *  The erase of the reserved region is counted in its erase units.
+     *
+     *  @return         0 on success, BD_ERROR_DEVICE_ERROR if there is no
+     *                  reserved region or the stats don't fit in it, or
+     *                  a negative error code of the underlying block device
+     */
+    int save();
+
+    /** Reset all stats to zero
+     */
+    void reset();
+
+    /** Add to the number of bytes requested to be written
+     *
+     *  The block device can't tell how much data the layer above it was asked
+     *  to write, so the application adds it here. Dividing the program count
+     *  by the requested count gives the write amplification of that layer.
+     *
+     *  @param size     Number of bytes requested to be written
+     */
+    void add_requested_count(bd_size_t size);
+
+    /** Get the number of bytes requested to be written
+     *
+     *  @return         The sum of the sizes passed to add_requested_count
+     */
+    bd_size_t get_requested_count() const;
+
+    /** Get number of bytes that have been read from the block device
+     *
+     *  @return         The number of bytes that have been read
+     */
+    bd_size_t get_read_count() const;
+
+    /** Get number of bytes that have been programmed to the block device
+     *
+     *  @return         The number of bytes that have been programmed
+     */
+    bd_size_t get_program_count() const;
+
+    /** Get number of bytes that have been erased from the block device
+     *
+     *  @return         The number of bytes that have been erased
+     */
+    bd_size_t get_erase_count() const;
+
+    /** Get the number of erase units tracked
+     *
+     *  Erase units are tracked at the granularity of the erase size of the
+     *  underlying block device, including the reserved region.
+     *
+     *  @return         The number of erase units, 0 before init
+     */
+    bd_size_t get_unit_count() const;
+
+    /** Get the number of times an erase unit has been erased
+     *
+     *  @param addr     Address within the erase unit, may be in the reserved region
+     *  @return         The number of times the unit has been erased
+     */
+    uint32_t get_unit_erase_count(bd_addr_t addr) const;
+
+    /** Get the highest erase count of all erase units
+     *
+     *  @return         The number of times the most worn unit has been erased
+     */
+    uint32_t get_max_erase_count() const;
+
+    /** Get a bucket of the latency histogram of an operation
+     *
+     *  @param op       Operation to get the histogram of
+     *  @param bucket   Bucket of the histogram, less than HISTOGRAM_BUCKETS
+     *  @return         The number of operations whose latency fell in the bucket
+     */
+    uint32_t get_latency_count(operation op, int bucket) const;
+
+private:
+    BlockDevice *_bd;
+    bd_size_t _stats_size;
+    bd_size_t _unit_size;
+    bd_size_t _unit_count;
+    uint32_t *_erase_counts;
+    bd_size_t _requested_count;
+    bd_size_t _read_count;
+    bd_size_t _program_count;
+    bd_size_t _erase_bytes;
+    uint32_t _latency[OP_COUNT][HISTOGRAM_BUCKETS];
+    Timer _timer;
+    bool _is_initialized;
+    bool _dirty;
+
+    void record_latency(operation op, us_timestamp_t start);
+    void count_erase(bd_addr_t addr, bd_size_t size);
+    bd_size_t record_size() const;
+    int load();
+};
+
+} // namespace mbed
+
+// Added "using" for backwards compatibility
+#ifndef MBED_NO_GLOBAL_USING_DIRECTIVE
+using mbed::WearStatsBlockDevice;
+#endif
+
+#endif
+
+/** @}*/
@@ -69,6 +69,13 @@ ssize_t Dir::read(struct dirent *ent)
     return _fs->dir_read(_dir, ent);
 }
 
+ssize_t Dir::read_many(fs_dirent_t *ents, size_t count)
+{
+    MBED_ASSERT(_fs);
+    memset(ents, 0, count * sizeof(fs_dirent_t));
+    return _fs->dir_read_many(_dir, ents, count);
+}
+
 void Dir::seek(off_t offset)
 {
     MBED_ASSERT(_fs);
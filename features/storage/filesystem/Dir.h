@@ -69,6 +69,17 @@ public:
      */
     virtual ssize_t read(struct dirent *ent);
 
+    /** Read the next directory entries along with their sizes
+     *
+     *  Reads up to count entries in one traversal of the directory, sparing
+     *  a stat of each of them.
+     *
+     *  @param ents     Array of directory entries to fill out
+     *  @param count    Number of entries in the array
+     *  @return         Number of entries read, 0 at end of directory, negative error on failure
+     */
+    virtual ssize_t read_many(fs_dirent_t *ents, size_t count);
+
     /** Set the current position of the directory
      *
      *  @param offset   Offset of the location to seek to,
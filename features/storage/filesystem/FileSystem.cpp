@@ -104,6 +104,21 @@ ssize_t FileSystem::dir_read(fs_dir_t dir, struct dirent *ent)
     return -ENOSYS;
 }
 
+ssize_t FileSystem::dir_read_many(fs_dir_t dir, fs_dirent_t *ents, size_t count)
+{
+    size_t i = 0;
+    for (; i < count; i++) {
+        ents[i].size = -1;
+        ssize_t res = dir_read(dir, &ents[i].ent);
+        if (res <= 0) {
+            // Report an error once the entries already read are returned
+            return i ? i : res;
+        }
+    }
+
+    return i;
+}
+
 void FileSystem::dir_seek(fs_dir_t dir, off_t offset)
 {
 }
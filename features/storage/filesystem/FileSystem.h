@@ -38,6 +38,13 @@ typedef void *fs_dir_t;
 class Dir;
 class File;
 
+/** Directory entry along with the metadata read in the same traversal
+ */
+struct fs_dirent_t {
+    struct dirent ent;  ///< Name and type of the entry
+    off_t size;         ///< Size of a file in bytes, -1 if the file system can't tell it without a stat
+};
+
 /** A file system object. Provides file system operations and file operations
  *  for the File and Dir classes on a block device.
  *
@@ -256,6 +263,15 @@ protected:
      */
     virtual ssize_t dir_read(fs_dir_t dir, struct dirent *ent);
 
+    /** Read the next directory entries and their sizes in one traversal.
+     *
+     *  @param dir      Dir handle.
+     *  @param ents     Array of directory entries to fill out.
+     *  @param count    Number of entries in the array.
+     *  @return         Number of entries read, 0 at the end of the directory, negative error on failure.
+     */
+    virtual ssize_t dir_read_many(fs_dir_t dir, fs_dirent_t *ents, size_t count);
+
     /** Set the current position of the directory.
      *
      *  @param dir      Dir handle.
@@ -3797,7 +3797,21 @@ FRESULT f_read (
 			cc = btr / SS(fs);					/* When remaining bytes >= sector size, */
 			if (cc > 0) {						/* Read maximum contiguous sectors directly */
 				if (csect + cc > fs->csize) {	/* Clip at cluster boundary */
+					UINT ncc = cc;
 					cc = fs->csize - csect;
+					while (ncc >= cc + fs->csize) {	/* Extend over the following clusters while they are contiguous */
+#if FF_USE_FASTSEEK
+						if (fp->cltbl) {
+							clst = clmt_clust(fp, fp->fptr + (FSIZE_t)cc * SS(fs));
+						} else
+#endif
+						{
+							clst = get_fat(&fp->obj, fp->clust);
+						}
+						if (clst != fp->clust + 1) break;	/* Fragmented or error, left to the next cluster lookup */
+						fp->clust = clst;
+						cc += fs->csize;
+					}
 				}
 				if (disk_read(fs->pdrv, rbuff, sect, cc) != RES_OK) ABORT(fs, FR_DISK_ERR);
 #if !FF_FS_READONLY && FF_FS_MINIMIZE <= 2		/* Replace one of the read sectors with cached data if it contains a dirty sector */
@@ -23,11 +23,13 @@
 #include "ffconf.h"
 #include "platform/mbed_debug.h"
 #include "platform/mbed_critical.h"
+#include "platform/mbed_swo_trace.h"
 #include "filesystem/mbed_filesystem.h"
 #include "FATFileSystem.h"
 
 #include <errno.h>
 #include <stdlib.h>
+#include <new>
 
 namespace mbed {
 
@@ -209,7 +211,9 @@ extern "C" DRESULT disk_read(BYTE pdrv, BYTE *buff, DWORD sector, UINT count)
     DWORD ssize = disk_get_sector_size(pdrv);
     mbed::bd_addr_t addr = (mbed::bd_addr_t)sector * ssize;
     mbed::bd_size_t size = (mbed::bd_size_t)count * ssize;
+    MBED_SWO_TRACE(MBED_SWO_TRACE_BD_READ, addr);
     int err = _ffs[pdrv]->read(buff, addr, size);
+    MBED_SWO_TRACE(MBED_SWO_TRACE_BD_END, err);
     return err ? RES_PARERR : RES_OK;
 }
 
@@ -220,12 +224,16 @@ extern "C" DRESULT disk_write(BYTE pdrv, const BYTE *buff, DWORD sector, UINT co
     mbed::bd_addr_t addr = (mbed::bd_addr_t)sector * ssize;
     mbed::bd_size_t size = (mbed::bd_size_t)count * ssize;
 
+    MBED_SWO_TRACE(MBED_SWO_TRACE_BD_ERASE, addr);
     int err = _ffs[pdrv]->erase(addr, size);
+    MBED_SWO_TRACE(MBED_SWO_TRACE_BD_END, err);
     if (err) {
         return RES_PARERR;
     }
 
+    MBED_SWO_TRACE(MBED_SWO_TRACE_BD_PROGRAM, addr);
     err = _ffs[pdrv]->program(buff, addr, size);
+    MBED_SWO_TRACE(MBED_SWO_TRACE_BD_END, err);
     if (err) {
         return RES_PARERR;
     }
@@ -571,11 +579,62 @@ void FATFileSystem::unlock()
 
 
 ////// File operations //////
+// Open file, FIL first so the handle can be used as a FIL
+struct fat_file_t {
+    FIL fil;
+    bool linkmap_tried;
+};
+
+#if FF_USE_FASTSEEK
+// Size of the cluster link map table tried first, enough for a file in 7 fragments,
+// and the largest size allocated, for a file in 127 fragments
+#define FAT_LINKMAP_INITIAL_SIZE 16
+#define FAT_LINKMAP_MAX_SIZE 256
+
+// Build the cluster link map table of a file opened read-only, so seeking doesn't
+// follow the cluster chain on the FAT from the start of the file. A file that can
+// grow can't use a link map, as FatFs doesn't extend it.
+static void fat_create_linkmap(FIL *fh)
+{
+    DWORD size = FAT_LINKMAP_INITIAL_SIZE;
+
+    for (int tries = 0; tries < 2; tries++) {
+        DWORD *tbl = new (std::nothrow) DWORD[size];
+        if (!tbl) {
+            return;
+        }
+
+        tbl[0] = size;
+        fh->cltbl = tbl;
+        FRESULT res = f_lseek(fh, CREATE_LINKMAP);
+        if (res == FR_OK) {
+            return;
+        }
+
+        // On FR_NOT_ENOUGH_CORE the first entry holds the size required
+        size = tbl[0];
+        fh->cltbl = NULL;
+        delete[] tbl;
+        if (res != FR_NOT_ENOUGH_CORE) {
+            debug_if(FFS_DBG, "f_lseek(CREATE_LINKMAP) failed: %d\n", res);
+            return;
+        }
+
+        // Too fragmented to be worth the memory, keep following the chain
+        if (size > FAT_LINKMAP_MAX_SIZE) {
+            return;
+        }
+    }
+}
+#endif
+
 int FATFileSystem::file_open(fs_file_t *file, const char *path, int flags)
 {
     debug_if(FFS_DBG, "open(%s) on filesystem [%s], drv [%d]\n", path, getName(), _id);
 
-    FIL *fh = new FIL;
+    fat_file_t *ff = new fat_file_t;
+    FIL *fh = &ff->fil;
+    ff->linkmap_tried = false;
     Deferred<const char *> fpath = fat_path_prefix(_id, path);
 
     /* POSIX flags -> FatFS open mode */
@@ -606,13 +665,13 @@ int FATFileSystem::file_open(fs_file_t *file, const char *path, int flags)
     if (res != FR_OK) {
         unlock();
         debug_if(FFS_DBG, "f_open('w') failed: %d\n", res);
-        delete fh;
+        delete ff;
         return fat_error_remap(res);
     }
 
     unlock();
 
-    *file = fh;
+    *file = ff;
     return 0;
 }
 
@@ -624,7 +683,10 @@ int FATFileSystem::file_close(fs_file_t file)
     FRESULT res = f_close(fh);
     unlock();
 
-    delete fh;
+#if FF_USE_FASTSEEK
+    delete[] fh->cltbl;
+#endif
+    delete static_cast<fat_file_t *>(file);
     return fat_error_remap(res);
 }
 
@@ -687,6 +749,15 @@ off_t FATFileSystem::file_seek(fs_file_t file, off_t offset, int whence)
         offset += f_tell(fh);
     }
 
+#if FF_USE_FASTSEEK
+    // Sequential reads never need the link map, build it on the first seek
+    fat_file_t *ff = static_cast<fat_file_t *>(file);
+    if (!ff->linkmap_tried && !(fh->flag & FA_WRITE)) {
+        ff->linkmap_tried = true;
+        fat_create_linkmap(fh);
+    }
+#endif
+
     FRESULT res = f_lseek(fh, offset);
     off_t noffset = fh->fptr;
     unlock();
@@ -749,6 +820,7 @@ int FATFileSystem::file_truncate(fs_file_t file, off_t length)
         return fat_error_remap(res);
     }
 
+    unlock();
     return 0;
 }
 
@@ -814,6 +886,36 @@ ssize_t FATFileSystem::dir_read(fs_dir_t dir, struct dirent *ent)
     return 1;
 }
 
+ssize_t FATFileSystem::dir_read_many(fs_dir_t dir, fs_dirent_t *ents, size_t count)
+{
+    FATFS_DIR *dh = static_cast<FATFS_DIR *>(dir);
+    FILINFO finfo;
+    FRESULT res = FR_OK;
+    size_t i = 0;
+
+    lock();
+    for (; i < count; i++) {
+        res = f_readdir(dh, &finfo);
+        if (res != FR_OK || finfo.fname[0] == 0) {
+            break;
+        }
+
+        ents[i].ent.d_type = (finfo.fattrib & AM_DIR) ? DT_DIR : DT_REG;
+        ents[i].size = finfo.fsize;
+#if FF_USE_LFN
+        strncpy(ents[i].ent.d_name, finfo.fname, FF_LFN_BUF);
+#else
+        strncpy(ents[i].ent.d_name, finfo.fname, FF_SFN_BUF);
+#endif
+    }
+    unlock();
+
+    if (i == 0 && res != FR_OK) {
+        return fat_error_remap(res);
+    }
+    return i;
+}
+
 void FATFileSystem::dir_seek(fs_dir_t dir, off_t offset)
 {
     FATFS_DIR *dh = static_cast<FATFS_DIR *>(dir);
@@ -259,6 +259,15 @@ protected:
      */
     virtual ssize_t dir_read(fs_dir_t dir, struct dirent *ent);
 
+    /** Read the next directory entries and their sizes
+     *
+     *  @param dir      Dir handle.
+     *  @param ents     Array of directory entries to fill out.
+     *  @param count    Number of entries in the array.
+     *  @return         Number of entries read, 0 at end of directory, negative error on failure
+     */
+    virtual ssize_t dir_read_many(fs_dir_t dir, fs_dirent_t *ents, size_t count);
+
     /** Set the current position of the directory.
      *
      *  @param dir      Dir handle.
@@ -19,6 +19,7 @@
 #include "lfs.h"
 #include "lfs_util.h"
 #include "MbedCRC.h"
+#include "platform/mbed_swo_trace.h"
 
 namespace mbed {
 
@@ -115,20 +116,32 @@ static int lfs_bd_read(const struct lfs_config *c, lfs_block_t block,
                        lfs_off_t off, void *buffer, lfs_size_t size)
 {
     BlockDevice *bd = (BlockDevice *)c->context;
-    return bd->read(buffer, (bd_addr_t)block * c->block_size + off, size);
+    bd_addr_t addr = (bd_addr_t)block * c->block_size + off;
+    MBED_SWO_TRACE(MBED_SWO_TRACE_BD_READ, addr);
+    int err = bd->read(buffer, addr, size);
+    MBED_SWO_TRACE(MBED_SWO_TRACE_BD_END, err);
+    return err;
 }
 
 static int lfs_bd_prog(const struct lfs_config *c, lfs_block_t block,
                        lfs_off_t off, const void *buffer, lfs_size_t size)
 {
     BlockDevice *bd = (BlockDevice *)c->context;
-    return bd->program(buffer, (bd_addr_t)block * c->block_size + off, size);
+    bd_addr_t addr = (bd_addr_t)block * c->block_size + off;
+    MBED_SWO_TRACE(MBED_SWO_TRACE_BD_PROGRAM, addr);
+    int err = bd->program(buffer, addr, size);
+    MBED_SWO_TRACE(MBED_SWO_TRACE_BD_END, err);
+    return err;
 }
 
 static int lfs_bd_erase(const struct lfs_config *c, lfs_block_t block)
 {
     BlockDevice *bd = (BlockDevice *)c->context;
-    return bd->erase((bd_addr_t)block * c->block_size, c->block_size);
+    bd_addr_t addr = (bd_addr_t)block * c->block_size;
+    MBED_SWO_TRACE(MBED_SWO_TRACE_BD_ERASE, addr);
+    int err = bd->erase(addr, c->block_size);
+    MBED_SWO_TRACE(MBED_SWO_TRACE_BD_END, err);
+    return err;
 }
 
 static int lfs_bd_sync(const struct lfs_config *c)
@@ -145,10 +158,19 @@ LittleFileSystem::LittleFileSystem(const char *name, BlockDevice *bd,
                                    lfs_size_t read_size, lfs_size_t prog_size,
                                    lfs_size_t block_size, lfs_size_t lookahead)
     : FileSystem(name)
+    , _bd(NULL)
     , _read_size(read_size)
     , _prog_size(prog_size)
     , _block_size(block_size)
     , _lookahead(lookahead)
+    , _read_buffer(NULL)
+    , _prog_buffer(NULL)
+    , _lookahead_buffer(NULL)
+    , _read_buffer_size(0)
+    , _prog_buffer_size(0)
+    , _lookahead_buffer_size(0)
+    , _name_buffer(NULL)
+    , _name_buffer_size(0)
 {
     if (bd) {
         mount(bd);
@@ -159,6 +181,47 @@ LittleFileSystem::~LittleFileSystem()
 {
     // nop if unmounted
     unmount();
+
+    lfs_free(_read_buffer);
+    lfs_free(_prog_buffer);
+    lfs_free(_lookahead_buffer);
+    lfs_free(_name_buffer);
+}
+
+static int lfs_realloc_buffer(void **buffer, lfs_size_t *buffer_size, lfs_size_t size)
+{
+    if (*buffer_size >= size) {
+        return 0;
+    }
+
+    lfs_free(*buffer);
+    *buffer = lfs_malloc(size);
+    *buffer_size = *buffer ? size : 0;
+    return *buffer ? 0 : LFS_ERR_NOMEM;
+}
+
+int LittleFileSystem::alloc_buffers()
+{
+    int err = lfs_realloc_buffer(&_read_buffer, &_read_buffer_size, _config.read_size);
+    if (!err) {
+        err = lfs_realloc_buffer(&_prog_buffer, &_prog_buffer_size, _config.prog_size);
+    }
+    if (!err) {
+        err = lfs_realloc_buffer(&_lookahead_buffer, &_lookahead_buffer_size, _config.lookahead / 8);
+    }
+    if (!err && MBED_LFS_NAME_CACHE > 0) {
+        err = lfs_realloc_buffer(&_name_buffer, &_name_buffer_size, MBED_LFS_NAME_CACHE * sizeof(lfs_name_t));
+    }
+    if (err) {
+        return err;
+    }
+
+    _config.read_buffer = _read_buffer;
+    _config.prog_buffer = _prog_buffer;
+    _config.lookahead_buffer = _lookahead_buffer;
+    _config.name_buffer = _name_buffer;
+    _config.name_count = _name_buffer ? MBED_LFS_NAME_CACHE : 0;
+    return 0;
 }
 
 int LittleFileSystem::mount(BlockDevice *bd)
@@ -198,7 +261,10 @@ int LittleFileSystem::mount(BlockDevice *bd)
         _config.lookahead = _lookahead;
     }
 
-    err = lfs_mount(&_lfs, &_config);
+    err = alloc_buffers();
+    if (!err) {
+        err = lfs_mount(&_lfs, &_config);
+    }
     if (err) {
         _bd = NULL;
         LFS_INFO("mount -> %d", lfs_toerror(err));
@@ -557,6 +623,28 @@ ssize_t LittleFileSystem::dir_read(fs_dir_t dir, struct dirent *ent)
     return lfs_toerror(res);
 }
 
+ssize_t LittleFileSystem::dir_read_many(fs_dir_t dir, fs_dirent_t *ents, size_t count)
+{
+    lfs_dir_t *d = (lfs_dir_t *)dir;
+    struct lfs_info info;
+    size_t i = 0;
+    int res = 0;
+    _mutex.lock();
+    LFS_INFO("dir_read_many(%p, %p, %d)", dir, ents, (int)count);
+    for (; i < count; i++) {
+        res = lfs_dir_read(&_lfs, d, &info);
+        if (res != 1) {
+            break;
+        }
+        ents[i].ent.d_type = lfs_totype(info.type);
+        strcpy(ents[i].ent.d_name, info.name);
+        ents[i].size = info.size;
+    }
+    LFS_INFO("dir_read_many -> %d", i ? (int)i : lfs_toerror(res));
+    _mutex.unlock();
+    return i ? i : lfs_toerror(res);
+}
+
 void LittleFileSystem::dir_seek(fs_dir_t dir, off_t offset)
 {
     lfs_dir_t *d = (lfs_dir_t *)dir;
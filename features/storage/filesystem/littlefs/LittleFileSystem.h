@@ -41,11 +41,13 @@ public:
      *  @param read_size
      *      Minimum size of a block read. This determines the size of read buffers.
      *      This may be larger than the physical read size to improve performance
-     *      by caching more of the block device.
+     *      by caching more of the block device, for example to read a metadata
+     *      pair in fewer block device reads.
      *  @param prog_size
      *      Minimum size of a block program. This determines the size of program
-     *      buffers. This may be larger than the physical program size to improve
-     *      performance by caching more of the block device.
+     *      buffers, including the cache of each open file. This may be larger than
+     *      the physical program size to improve performance by caching more of the
+     *      block device. Must be a multiple of read_size.
      *  @param block_size
      *      Size of an erasable block. This does not impact ram consumption and
      *      may be larger than the physical erase size. However, this should be
@@ -72,11 +74,13 @@ public:
      *  @param read_size
      *      Minimum size of a block read. This determines the size of read buffers.
      *      This may be larger than the physical read size to improve performance
-     *      by caching more of the block device.
+     *      by caching more of the block device, for example to read a metadata
+     *      pair in fewer block device reads.
      *  @param prog_size
      *      Minimum size of a block program. This determines the size of program
-     *      buffers. This may be larger than the physical program size to improve
-     *      performance by caching more of the block device.
+     *      buffers, including the cache of each open file. This may be larger than
+     *      the physical program size to improve performance by caching more of the
+     *      block device. Must be a multiple of read_size.
      *  @param block_size
      *      Size of an erasable block. This does not impact ram consumption and
      *      may be larger than the physical erase size. However, this should be
@@ -263,6 +267,15 @@ protected:
      */
     virtual ssize_t dir_read(mbed::fs_dir_t dir, struct dirent *ent);
 
+    /** Read the next directory entries and their sizes
+     *
+     *  @param dir      Dir handle.
+     *  @param ents     Array of directory entries to fill out.
+     *  @param count    Number of entries in the array.
+     *  @return         Number of entries read, 0 at end of directory, negative error on failure
+     */
+    virtual ssize_t dir_read_many(mbed::fs_dir_t dir, mbed::fs_dirent_t *ents, size_t count);
+
     /** Set the current position of the directory
      *
      *  @param dir      Dir handle.
@@ -296,6 +309,20 @@ private:
     const lfs_size_t _block_size;
     const lfs_size_t _lookahead;
 
+    // Read and program caches, lookahead bitmap and name cache, allocated on
+    // the first mount and kept across remounts
+    void *_read_buffer;
+    void *_prog_buffer;
+    void *_lookahead_buffer;
+    void *_name_buffer;
+    lfs_size_t _read_buffer_size;
+    lfs_size_t _prog_buffer_size;
+    lfs_size_t _lookahead_buffer_size;
+    lfs_size_t _name_buffer_size;
+
+    // Allocate the buffers for the sizes in _config, reusing them if large enough
+    int alloc_buffers();
+
     // thread-safe locking
     PlatformMutex _mutex;
 };
@@ -405,6 +405,40 @@ static inline lfs_size_t lfs_entry_size(const lfs_entry_t *entry) {
     return 4 + entry->d.elen + entry->d.alen + entry->d.nlen;
 }
 
+/// Name cache ///
+static uint32_t lfs_name_hash(const char *name, lfs_size_t nlen) {
+    // FNV-1a
+    uint32_t hash = 0x811c9dc5;
+    for (lfs_size_t i = 0; i < nlen; i++) {
+        hash = (hash ^ (uint8_t)name[i]) * 0x01000193;
+    }
+    return hash;
+}
+
+static void lfs_names_drop(lfs_t *lfs) {
+    for (lfs_size_t i = 0; i < lfs->cfg->name_count; i++) {
+        lfs->names[i].nlen = 0;
+    }
+}
+
+static void lfs_names_add(lfs_t *lfs, const lfs_block_t dir[2],
+        uint32_t hash, lfs_size_t nlen,
+        const lfs_block_t pair[2], lfs_off_t off) {
+    if (lfs->cfg->name_count == 0) {
+        return;
+    }
+
+    lfs_name_t *name = &lfs->names[lfs->name_next];
+    lfs->name_next = (lfs->name_next + 1) % lfs->cfg->name_count;
+    name->dir[0] = dir[0];
+    name->dir[1] = dir[1];
+    name->hash = hash;
+    name->nlen = nlen;
+    name->pair[0] = pair[0];
+    name->pair[1] = pair[1];
+    name->off = off;
+}
+
 static int lfs_dir_alloc(lfs_t *lfs, lfs_dir_t *dir) {
     // allocate pair of dir blocks
     for (int i = 0; i < 2; i++) {
@@ -507,6 +541,15 @@ struct lfs_region {
 
 static int lfs_dir_commit(lfs_t *lfs, lfs_dir_t *dir,
         const struct lfs_region *regions, int count) {
+    // entries only keep their offsets through in place updates
+    bool moves = (count == 0);
+    for (int i = 0; i < count; i++) {
+        moves = moves || regions[i].oldlen != regions[i].newlen;
+    }
+    if (moves) {
+        lfs_names_drop(lfs);
+    }
+
     // increment revision count
     dir->d.rev += 1;
 
@@ -619,6 +662,7 @@ relocate:
         // drop caches and prepare to relocate block
         relocated = true;
         lfs_cache_drop(lfs, &lfs->pcache);
+        lfs_names_drop(lfs);
 
         // can't relocate superblock, filesystem is now frozen
         if (lfs_paircmp(oldpair, (const lfs_block_t[2]){0, 1}) == 0) {
@@ -795,6 +839,52 @@ static int lfs_dir_next(lfs_t *lfs, lfs_dir_t *dir, lfs_entry_t *entry) {
     return 0;
 }
 
+static int lfs_names_find(lfs_t *lfs, lfs_dir_t *dir, lfs_entry_t *entry,
+        const lfs_block_t head[2], uint32_t hash,
+        const char *name, lfs_size_t nlen) {
+    for (lfs_size_t i = 0; i < lfs->cfg->name_count; i++) {
+        lfs_name_t *n = &lfs->names[i];
+        if (n->nlen != nlen || n->hash != hash ||
+            lfs_paircmp(n->dir, head) != 0) {
+            continue;
+        }
+
+        if (lfs_paircmp(n->pair, dir->pair) != 0) {
+            int err = lfs_dir_fetch(lfs, dir, n->pair);
+            if (err) {
+                return err;
+            }
+        }
+
+        // check the entry is still there
+        dir->off = n->off;
+        int err = lfs_dir_next(lfs, dir, entry);
+        if (err && err != LFS_ERR_NOENT) {
+            return err;
+        }
+
+        if (!err && ((0x7f & entry->d.type) == LFS_TYPE_REG ||
+                     (0x7f & entry->d.type) == LFS_TYPE_DIR) &&
+            entry->d.nlen == nlen) {
+            int res = lfs_bd_cmp(lfs, dir->pair[0],
+                    entry->off + 4+entry->d.elen+entry->d.alen,
+                    name, nlen);
+            if (res < 0) {
+                return res;
+            }
+
+            if (res) {
+                return 0;
+            }
+        }
+
+        n->nlen = 0;
+        break;
+    }
+
+    return LFS_ERR_NOENT;
+}
+
 static int lfs_dir_find(lfs_t *lfs, lfs_dir_t *dir,
         lfs_entry_t *entry, const char **path) {
     const char *pathname = *path;
@@ -856,11 +946,29 @@ nextname:
             return LFS_ERR_NOTDIR;
         }
 
-        int err = lfs_dir_fetch(lfs, dir, entry->d.u.dir);
+        const lfs_block_t head[2] = {entry->d.u.dir[0], entry->d.u.dir[1]};
+        int err = lfs_dir_fetch(lfs, dir, head);
         if (err) {
             return err;
         }
 
+        // try the name cache before scanning the directory
+        uint32_t hash = lfs_name_hash(pathname, pathlen);
+        err = lfs_names_find(lfs, dir, entry, head, hash, pathname, pathlen);
+        if (err != LFS_ERR_NOENT) {
+            if (err) {
+                return err;
+            }
+            goto found;
+        }
+
+        if (lfs_paircmp(dir->pair, head) != 0 || dir->off != sizeof(dir->d)) {
+            err = lfs_dir_fetch(lfs, dir, head);
+            if (err) {
+                return err;
+            }
+        }
+
         // find entry matching name
         while (true) {
             err = lfs_dir_next(lfs, dir, entry);
@@ -883,10 +991,12 @@ nextname:
 
             // found match
             if (res) {
+                lfs_names_add(lfs, head, hash, pathlen, dir->pair, entry->off);
                 break;
             }
         }
 
+found:
         // check that entry has not been moved
         if (entry->d.type & 0x80) {
             int moved = lfs_moved(lfs, &entry->d.u);
@@ -2085,6 +2195,12 @@ static int lfs_init(lfs_t *lfs, const struct lfs_config *cfg) {
     lfs->dirs = NULL;
     lfs->deorphaned = false;
 
+    // setup name cache, it is only used when given a buffer
+    LFS_ASSERT(lfs->cfg->name_count == 0 || lfs->cfg->name_buffer);
+    lfs->names = lfs->cfg->name_buffer;
+    lfs->name_next = 0;
+    lfs_names_drop(lfs);
+
     return 0;
 
 cleanup:
@@ -165,6 +165,12 @@ struct lfs_config {
     // Optional, statically allocated buffer for files. Must be program sized.
     // If enabled, only one file may be opened at a time.
     void *file_buffer;
+
+    // Optional, statically allocated cache of the location of names found in
+    // directories, so opening a name again skips the scan of its directory.
+    // Must hold name_count lfs_name_t, 0 disables the cache.
+    void *name_buffer;
+    lfs_size_t name_count;
 };
 
 // Optional configuration provided during lfs_file_opencfg
@@ -243,6 +249,14 @@ typedef struct lfs_dir {
     } d;
 } lfs_dir_t;
 
+typedef struct lfs_name {
+    lfs_block_t dir[2];
+    uint32_t hash;
+    lfs_size_t nlen;
+    lfs_block_t pair[2];
+    lfs_off_t off;
+} lfs_name_t;
+
 typedef struct lfs_superblock {
     lfs_off_t off;
 
@@ -280,6 +294,9 @@ typedef struct lfs {
 
     lfs_free_t free;
     bool deorphaned;
+
+    lfs_name_t *names;
+    lfs_size_t name_next;
 } lfs_t;
 
 
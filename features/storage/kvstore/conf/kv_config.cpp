@@ -134,6 +134,13 @@ int _storage_config_FILESYSTEM_NO_RBP();
 int _storage_config_tdb_external_common();
 int _storage_config_filesystem_common();
 
+int _storage_config_TDB_EXTERNAL_external();
+int _storage_config_TDB_EXTERNAL_NO_RBP_external();
+int _storage_config_FILESYSTEM_external();
+int _storage_config_FILESYSTEM_NO_RBP_external();
+int _storage_config_external(int (*external_init)());
+int _storage_config_attach();
+
 static const char *filesystemstore_folder_path = NULL;
 
 using namespace mbed;
@@ -143,6 +150,9 @@ static SingletonPtr<PlatformMutex> mutex;
 static bool is_kv_config_initialize = false;
 static kvstore_config_t kvstore_config;
 
+// Initialization of the external part of the configuration, when deferred
+static int (*pending_external_init)() = NULL;
+
 #define INTERNAL_BLOCKDEVICE_NAME FLASHIAP
 
 #define STR_EXPAND(tok) #tok
@@ -740,6 +750,13 @@ int _storage_config_TDB_EXTERNAL()
         return ret;
     }
 
+    kvstore_config.flags_mask = ~(0);
+
+    return _storage_config_external(_storage_config_TDB_EXTERNAL_external);
+}
+
+int _storage_config_TDB_EXTERNAL_external()
+{
     bd_size_t size = MBED_CONF_STORAGE_TDB_EXTERNAL_EXTERNAL_SIZE;
     bd_addr_t address = MBED_CONF_STORAGE_TDB_EXTERNAL_EXTERNAL_BASE_ADDRESS;
 
@@ -775,8 +792,6 @@ int _storage_config_TDB_EXTERNAL()
     kvstore_config.external_bd = bd;
 #endif
 
-    kvstore_config.flags_mask = ~(0);
-
     return _storage_config_tdb_external_common();
 }
 
@@ -785,6 +800,16 @@ int _storage_config_TDB_EXTERNAL_NO_RBP()
 #if !SECURESTORE_ENABLED
     return MBED_ERROR_UNSUPPORTED;
 #endif
+
+    //Masking flag - Actually used to remove any KVStore flag which is not supported
+    //in the chosen KVStore profile.
+    kvstore_config.flags_mask = ~(KVStore::REQUIRE_REPLAY_PROTECTION_FLAG);
+
+    return _storage_config_external(_storage_config_TDB_EXTERNAL_NO_RBP_external);
+}
+
+int _storage_config_TDB_EXTERNAL_NO_RBP_external()
+{
     bd_size_t size = MBED_CONF_STORAGE_TDB_EXTERNAL_NO_RBP_EXTERNAL_SIZE;
     bd_addr_t address = MBED_CONF_STORAGE_TDB_EXTERNAL_NO_RBP_EXTERNAL_BASE_ADDRESS;
 
@@ -820,10 +845,6 @@ int _storage_config_TDB_EXTERNAL_NO_RBP()
     kvstore_config.external_bd = bd;
 #endif
 
-    //Masking flag - Actually used to remove any KVStore flag which is not supported
-    //in the chosen KVStore profile.
-    kvstore_config.flags_mask = ~(KVStore::REQUIRE_REPLAY_PROTECTION_FLAG);
-
     return _storage_config_tdb_external_common();
 }
 
@@ -858,20 +879,6 @@ int _storage_config_tdb_external_common()
 
     kvstore_config.kvstore_main_instance = &secst;
 
-    //Init kv_map and add the configuration struct to KVStore map.
-    KVMap &kv_map = KVMap::get_instance();
-    ret = kv_map.init();
-    if (MBED_SUCCESS != ret) {
-        tr_error("KV Config: Fail to init KVStore global API");
-        return ret;
-    }
-
-    ret = kv_map.attach(STR(MBED_CONF_STORAGE_DEFAULT_KV), &kvstore_config);
-    if (MBED_SUCCESS != ret) {
-        tr_error("KV Config: Fail to attach KvStore main instance to KVStore global API");
-        return ret;
-    }
-
     return MBED_SUCCESS;
 #else
     return MBED_ERROR_UNSUPPORTED;
@@ -933,6 +940,13 @@ int _storage_config_FILESYSTEM()
         return ret;
     }
 
+    kvstore_config.flags_mask = ~(0);
+
+    return _storage_config_external(_storage_config_FILESYSTEM_external);
+}
+
+int _storage_config_FILESYSTEM_external()
+{
     bd_size_t size = MBED_CONF_STORAGE_FILESYSTEM_EXTERNAL_SIZE;
     bd_addr_t address = MBED_CONF_STORAGE_FILESYSTEM_EXTERNAL_BASE_ADDRESS;
     const char *mount_point = STR(MBED_CONF_STORAGE_FILESYSTEM_MOUNT_POINT);
@@ -944,7 +958,7 @@ int _storage_config_FILESYSTEM()
         return MBED_ERROR_FAILED_OPERATION ;
     }
 
-    ret = kvstore_config.external_bd->init();
+    int ret = kvstore_config.external_bd->init();
     if (MBED_SUCCESS != ret) {
         tr_error("KV Config: Fail to init external BlockDevice ");
         return MBED_ERROR_FAILED_OPERATION ;
@@ -960,8 +974,6 @@ int _storage_config_FILESYSTEM()
         return MBED_ERROR_FAILED_OPERATION ;
     }
 
-    kvstore_config.flags_mask = ~(0);
-
     return _storage_config_filesystem_common();
 }
 
@@ -973,6 +985,15 @@ int _storage_config_FILESYSTEM_NO_RBP()
 
     filesystemstore_folder_path = STR(MBED_CONF_STORAGE_FILESYSTEM_NO_RBP_FOLDER_PATH);
 
+    //Masking flag - Actually used to remove any KVStore flag which is not supported
+    //in the chosen KVStore profile.
+    kvstore_config.flags_mask = ~(KVStore::REQUIRE_REPLAY_PROTECTION_FLAG);
+
+    return _storage_config_external(_storage_config_FILESYSTEM_NO_RBP_external);
+}
+
+int _storage_config_FILESYSTEM_NO_RBP_external()
+{
     bd_size_t size = MBED_CONF_STORAGE_FILESYSTEM_NO_RBP_EXTERNAL_SIZE;
     bd_addr_t address = MBED_CONF_STORAGE_FILESYSTEM_NO_RBP_EXTERNAL_BASE_ADDRESS;
     const char *mount_point = STR(MBED_CONF_STORAGE_FILESYSTEM_NO_RBP_MOUNT_POINT);
@@ -1000,10 +1021,6 @@ int _storage_config_FILESYSTEM_NO_RBP()
         return MBED_ERROR_FAILED_OPERATION ;
     }
 
-    //Masking flag - Actually used to remove any KVStore flag which is not supported
-    //in the chosen KVStore profile.
-    kvstore_config.flags_mask = ~(KVStore::REQUIRE_REPLAY_PROTECTION_FLAG);
-
     return _storage_config_filesystem_common();
 }
 
@@ -1040,9 +1057,17 @@ int _storage_config_filesystem_common()
 
     kvstore_config.kvstore_main_instance = &secst;
 
+    return MBED_SUCCESS;
+#else
+    return MBED_ERROR_UNSUPPORTED;
+#endif
+}
+
+int _storage_config_attach()
+{
     //Init kv_map and add the configuration struct to KVStore map.
     KVMap &kv_map = KVMap::get_instance();
-    ret = kv_map.init();
+    int ret = kv_map.init();
     if (MBED_SUCCESS != ret) {
         tr_error("KV Config: Fail to init KVStore global API");
         return ret;
@@ -1055,9 +1080,43 @@ int _storage_config_filesystem_common()
     }
 
     return MBED_SUCCESS;
+}
+
+// Called by KVMap on the first use of the main or external instance
+static int _storage_config_deferred_external_init()
+{
+    int ret = MBED_SUCCESS;
+
+    mutex->lock();
+
+    if (pending_external_init) {
+        ret = pending_external_init();
+        if (ret == MBED_SUCCESS) {
+            pending_external_init = NULL;
+            kvstore_config.external_init = NULL;
+        }
+    }
+
+    mutex->unlock();
+    return ret;
+}
+
+// Initialize the external part of the configuration and attach it to KVMap,
+// or with kv-config.lazy-external-init, attach it with the initialization
+// deferred to the first use of the main or external instance
+int _storage_config_external(int (*external_init)())
+{
+#if MBED_CONF_KV_CONFIG_LAZY_EXTERNAL_INIT
+    pending_external_init = external_init;
+    kvstore_config.external_init = _storage_config_deferred_external_init;
 #else
-    return MBED_ERROR_UNSUPPORTED;
+    int ret = external_init();
+    if (ret != MBED_SUCCESS) {
+        return ret;
+    }
 #endif
+
+    return _storage_config_attach();
 }
 
 int _storage_config_default()
@@ -1106,3 +1165,13 @@ exit:
     mutex->unlock();
     return ret;
 }
+
+int kv_init_storage_config_external()
+{
+    int ret = kv_init_storage_config();
+    if (ret != MBED_SUCCESS) {
+        return ret;
+    }
+
+    return _storage_config_deferred_external_init();
+}
@@ -35,6 +35,16 @@ extern "C" {
  */
 int kv_init_storage_config();
 
+/**
+ * @brief Initialize the configuration, including the parts deferred by
+ *        kv-config.lazy-external-init to the first use of the main or
+ *        external KVStore. Can be called from a low priority thread, to
+ *        complete the initialization in the background after boot.
+ *
+ * @returns 0 on success or negative value on failure.
+ */
+int kv_init_storage_config_external();
+
 /**
  * @brief A getter for filesystemstore folder path configuration
  *
@@ -40,14 +40,6 @@ using namespace mbed;
 
 namespace {
 
-// incremental set handle
-typedef struct {
-    char *key;
-    uint32_t create_flags;
-    size_t data_size;
-    File *file_handle;
-} inc_set_handle_t;
-
 // iterator handle
 typedef struct {
     void *dir_handle;
@@ -62,9 +54,11 @@ static char *string_ndup(const char *src, size_t size);
 
 // Class Functions
 FileSystemStore::FileSystemStore(FileSystem *fs) : _fs(fs),
-    _is_initialized(false)
+    _is_initialized(false), _cur_inc_set_handle(NULL), _key_file_use(0)
 {
-
+    for (int i = 0; i < MBED_CONF_FILESYSTEMSTORE_OPEN_FILES; i++) {
+        _key_files[i].is_open = false;
+    }
 }
 
 int FileSystemStore::init()
@@ -115,6 +109,7 @@ exit_point:
 int FileSystemStore::deinit()
 {
     _mutex.lock();
+    _close_key_files();
     _is_initialized = false;
     delete[] _cfg_fs_path;
     delete[] _full_path_key;
@@ -135,6 +130,9 @@ int FileSystemStore::reset()
         goto exit_point;
     }
 
+    // Files can't be removed while open
+    _close_key_files();
+
     kv_dir.open(_fs, _cfg_fs_path);
 
     while (kv_dir.read(&dir_ent) != 0) {
@@ -198,7 +196,7 @@ int FileSystemStore::get(const char *key, void *buffer, size_t buffer_size, size
 {
     int status = MBED_SUCCESS;
 
-    File kv_file;
+    key_file_t *key_file;
     size_t kv_file_size = 0;
     size_t value_actual_size = 0;
 
@@ -209,14 +207,12 @@ int FileSystemStore::get(const char *key, void *buffer, size_t buffer_size, size
         goto exit_point;
     }
 
-    key_metadata_t key_metadata;
-
-    if ((status = _verify_key_file(key, &key_metadata, &kv_file)) != MBED_SUCCESS) {
+    if ((status = _open_key_file(key, &key_file)) != MBED_SUCCESS) {
         tr_debug("File Verification failed, status: %d", status);
         goto exit_point;
     }
 
-    kv_file_size = kv_file.size() - key_metadata.metadata_size;
+    kv_file_size = key_file->file.size() - key_file->metadata.metadata_size;
     // Actual size is the minimum of buffer_size and remainder of data in file (file's data size - offset)
     value_actual_size = buffer_size;
     if (offset > kv_file_size) {
@@ -235,15 +231,11 @@ int FileSystemStore::get(const char *key, void *buffer, size_t buffer_size, size
         *actual_size = value_actual_size;
     }
 
-    kv_file.seek(key_metadata.metadata_size + offset, SEEK_SET);
+    key_file->file.seek(key_file->metadata.metadata_size + offset, SEEK_SET);
     // Read remainder of data
-    kv_file.read(buffer, value_actual_size);
+    key_file->file.read(buffer, value_actual_size);
 
 exit_point:
-    if ((status == MBED_SUCCESS) ||
-            (status == MBED_ERROR_INVALID_DATA_DETECTED)) {
-        kv_file.close();
-    }
     _mutex.unlock();
 
     return status;
@@ -252,7 +244,7 @@ exit_point:
 int FileSystemStore::get_info(const char *key, info_t *info)
 {
     int status = MBED_SUCCESS;
-    File kv_file;
+    key_file_t *key_file;
 
     _mutex.lock();
 
@@ -261,23 +253,17 @@ int FileSystemStore::get_info(const char *key, info_t *info)
         goto exit_point;
     }
 
-    key_metadata_t key_metadata;
-
-    if ((status = _verify_key_file(key, &key_metadata, &kv_file)) != MBED_SUCCESS) {
+    if ((status = _open_key_file(key, &key_file)) != MBED_SUCCESS) {
         tr_debug("File Verification failed, status: %d", status);
         goto exit_point;
     }
 
     if (info != NULL) {
-        info->size = kv_file.size() - key_metadata.metadata_size;
-        info->flags = key_metadata.user_flags;
+        info->size = key_file->file.size() - key_file->metadata.metadata_size;
+        info->flags = key_file->metadata.user_flags;
     }
 
 exit_point:
-    if ((status == MBED_SUCCESS) ||
-            (status == MBED_ERROR_INVALID_DATA_DETECTED)) {
-        kv_file.close();
-    }
     _mutex.unlock();
 
     return status;
@@ -285,8 +271,7 @@ exit_point:
 
 int FileSystemStore::remove(const char *key)
 {
-    File kv_file;
-    key_metadata_t key_metadata;
+    key_file_t *key_file;
 
     _mutex.lock();
 
@@ -299,18 +284,16 @@ int FileSystemStore::remove(const char *key)
 
     /* If File Exists and is Valid, then check its Write Once Flag to verify its disabled before removing */
     /* If File exists and is not valid, or is Valid and not Write-Onced then remove it */
-    if ((status = _verify_key_file(key, &key_metadata, &kv_file)) == MBED_SUCCESS) {
-        if (key_metadata.user_flags & KVStore::WRITE_ONCE_FLAG) {
-            kv_file.close();
+    if ((status = _open_key_file(key, &key_file)) == MBED_SUCCESS) {
+        if (key_file->metadata.user_flags & KVStore::WRITE_ONCE_FLAG) {
             tr_error("File: %s, Exists but write protected", _full_path_key);
             status = MBED_ERROR_WRITE_PROTECTED;
             goto exit_point;
         }
-    } else if ((status == MBED_ERROR_ITEM_NOT_FOUND) ||
-               (status == MBED_ERROR_INVALID_ARGUMENT)) {
+    } else if (status != MBED_ERROR_INVALID_DATA_DETECTED) {
         goto exit_point;
     }
-    kv_file.close();
+    _close_key_file(key_file);
 
     if (0 != _fs->remove(_full_path_key)) {
         status =  MBED_ERROR_FAILED_OPERATION;
@@ -325,10 +308,8 @@ exit_point:
 int FileSystemStore::set_start(set_handle_t *handle, const char *key, size_t final_data_size, uint32_t create_flags)
 {
     int status = MBED_SUCCESS;
-    inc_set_handle_t *set_handle = NULL;
-    File *kv_file;
+    key_file_t *key_file;
     key_metadata_t key_metadata;
-    int key_len = 0;
 
     if (create_flags & ~supported_flags) {
         return MBED_ERROR_INVALID_ARGUMENT;
@@ -337,8 +318,6 @@ int FileSystemStore::set_start(set_handle_t *handle, const char *key, size_t fin
     // Only a single key file can be incrementaly editted at a time
     _mutex.lock();
 
-    kv_file = new File;
-
     if (handle == NULL) {
         status = MBED_ERROR_INVALID_ARGUMENT;
         goto exit_point;
@@ -346,52 +325,53 @@ int FileSystemStore::set_start(set_handle_t *handle, const char *key, size_t fin
 
     /* If File Exists and is Valid, then check its Write Once Flag to verify its disabled before setting */
     /* If File exists and is not valid, or is Valid and not Write-Onced then erase it */
-    status = _verify_key_file(key, &key_metadata, kv_file);
-
-    if (status == MBED_ERROR_INVALID_ARGUMENT) {
-        tr_error("File Verification failed, status: %d", status);
-        goto exit_point;
-    }
+    status = _open_key_file(key, &key_file);
 
     if (status == MBED_SUCCESS) {
         tr_info("File: %s, Exists. Verifying Write Once Disabled before setting new value", _full_path_key);
-        if (key_metadata.user_flags & KVStore::WRITE_ONCE_FLAG) {
-            kv_file->close();
+        if (key_file->metadata.user_flags & KVStore::WRITE_ONCE_FLAG) {
             status = MBED_ERROR_WRITE_PROTECTED;
             goto exit_point;
         }
-    }
-
-    /* For Success (not write_once) and for corrupted data close file before recreating it as a new file */
-    if (status != MBED_ERROR_ITEM_NOT_FOUND) {
-        kv_file->close();
-    }
 
-    if ((status = kv_file->open(_fs, _full_path_key, O_WRONLY | O_CREAT | O_TRUNC)) != MBED_SUCCESS) {
-        tr_info("set_start failed to open: %s, for writing, err: %d", _full_path_key, status);
-        status = MBED_ERROR_FAILED_OPERATION ;
+        // Rewrite the open file rather than recreating it
+        if ((key_file->file.seek(0, SEEK_SET) != 0) || (key_file->file.truncate(0) != 0)) {
+            tr_info("set_start failed to truncate: %s", _full_path_key);
+            _close_key_file(key_file);
+            status = MBED_ERROR_FAILED_OPERATION;
+            goto exit_point;
+        }
+    } else if ((status == MBED_ERROR_ITEM_NOT_FOUND) || (status == MBED_ERROR_INVALID_DATA_DETECTED)) {
+        if ((status = key_file->file.open(_fs, _full_path_key, O_RDWR | O_CREAT | O_TRUNC)) != MBED_SUCCESS) {
+            tr_info("set_start failed to open: %s, for writing, err: %d", _full_path_key, status);
+            status = MBED_ERROR_FAILED_OPERATION ;
+            goto exit_point;
+        }
+        strcpy(key_file->key, key);
+        key_file->is_open = true;
+    } else {
+        tr_error("File Verification failed, status: %d", status);
         goto exit_point;
     }
-    _cur_inc_data_size = 0;
-
-    set_handle = new inc_set_handle_t;
-    set_handle->create_flags = create_flags;
-    set_handle->data_size = final_data_size;
-    set_handle->file_handle = kv_file;
-    key_len = strlen(key);
-    set_handle->key = string_ndup(key, key_len);
-    *handle = (set_handle_t)set_handle;
-    _cur_inc_set_handle = *handle;
 
     key_metadata.magic = FSST_MAGIC;
     key_metadata.metadata_size = sizeof(key_metadata_t);
     key_metadata.revision = FSST_REVISION;
     key_metadata.user_flags = create_flags;
-    kv_file->write(&key_metadata, sizeof(key_metadata_t));
+    if (key_file->file.write(&key_metadata, sizeof(key_metadata_t)) != sizeof(key_metadata_t)) {
+        _close_key_file(key_file);
+        status = MBED_ERROR_FAILED_OPERATION;
+        goto exit_point;
+    }
+    key_file->metadata = key_metadata;
+
+    _cur_inc_data_size = 0;
+    _cur_inc_final_size = final_data_size;
+    *handle = (set_handle_t)key_file;
+    _cur_inc_set_handle = *handle;
 
 exit_point:
     if (status != MBED_SUCCESS) {
-        delete kv_file;
         _mutex.unlock();
     }
     return status;
@@ -401,8 +381,7 @@ int FileSystemStore::set_add_data(set_handle_t handle, const void *value_data, s
 {
     int status = MBED_SUCCESS;
     size_t added_data = 0;
-    inc_set_handle_t *set_handle = (inc_set_handle_t *)handle;
-    File *kv_file;
+    key_file_t *key_file = (key_file_t *)handle;
 
     if (((value_data == NULL) && (data_size > 0)) || (handle == NULL) || (handle != _cur_inc_set_handle)) {
         status = MBED_ERROR_INVALID_ARGUMENT;
@@ -411,16 +390,14 @@ int FileSystemStore::set_add_data(set_handle_t handle, const void *value_data, s
 
     // Single key incrementally edited, can be edited from multiple threads - lock to protect
     _inc_data_add_mutex.lock();
-    if ((_cur_inc_data_size + data_size) > set_handle->data_size) {
+    if ((_cur_inc_data_size + data_size) > _cur_inc_final_size) {
         tr_warning("Added Data(%d) will exceed set_start final size(%d) - not adding data to file: %s",
-                   _cur_inc_data_size + data_size, set_handle->data_size, _full_path_key);
+                   _cur_inc_data_size + data_size, _cur_inc_final_size, key_file->key);
         status = MBED_ERROR_INVALID_SIZE;
         goto exit_point;
     }
 
-    kv_file = set_handle->file_handle;
-
-    added_data = kv_file->write(value_data, data_size);
+    added_data = key_file->file.write(value_data, data_size);
     if (added_data != data_size) {
         status = MBED_ERROR_FAILED_OPERATION ;
     }
@@ -437,30 +414,28 @@ exit_point:
 int FileSystemStore::set_finalize(set_handle_t handle)
 {
     int status = MBED_SUCCESS;
-    inc_set_handle_t *set_handle = NULL;
+    key_file_t *key_file = NULL;
 
     if ((handle == NULL) || (handle != _cur_inc_set_handle)) {
         status =  MBED_ERROR_INVALID_ARGUMENT;
         goto exit_point;
     }
 
-    set_handle = (inc_set_handle_t *)handle;
+    key_file = (key_file_t *)handle;
 
-    if (set_handle->key == NULL) {
-        status = MBED_ERROR_INVALID_DATA_DETECTED;
-    } else {
-        if (_cur_inc_data_size != set_handle->data_size) {
-            tr_error("Accumulated Data (%d) size doesn't match set_start final size (%d) - file: %s", _cur_inc_data_size,
-                     set_handle->data_size, _full_path_key);
-            status = MBED_ERROR_INVALID_SIZE;
-            _fs->remove(_full_path_key);
-        }
-        delete[] set_handle->key;
+    if (_cur_inc_data_size != _cur_inc_final_size) {
+        tr_error("Accumulated Data (%d) size doesn't match set_start final size (%d) - file: %s", _cur_inc_data_size,
+                 _cur_inc_final_size, key_file->key);
+        status = MBED_ERROR_INVALID_SIZE;
+        _close_key_file(key_file);
+        _build_full_path_key(key_file->key);
+        _fs->remove(_full_path_key);
+    } else if (key_file->file.sync() != 0) {
+        // The file stays open for the next operations, commit the value now
+        status = MBED_ERROR_FAILED_OPERATION;
+        _close_key_file(key_file);
     }
 
-    set_handle->file_handle->close();
-    delete set_handle->file_handle;
-    delete set_handle;
     _cur_inc_data_size = 0;
     _cur_inc_set_handle = NULL;
 
@@ -593,34 +568,71 @@ exit_point:
     return status;
 }
 
-int FileSystemStore::_verify_key_file(const char *key, key_metadata_t *key_metadata, File *kv_file)
+int FileSystemStore::_open_key_file(const char *key, key_file_t **key_file)
 {
-    int status = MBED_SUCCESS;
+    key_file_t *entry = NULL;
 
     if (!is_valid_key(key)) {
-        status = MBED_ERROR_INVALID_ARGUMENT;
-        goto exit_point;
+        return MBED_ERROR_INVALID_ARGUMENT;
     }
 
     _build_full_path_key(key);
 
-    if (0 != kv_file->open(_fs, _full_path_key, O_RDONLY)) {
+    for (int i = 0; i < MBED_CONF_FILESYSTEMSTORE_OPEN_FILES; i++) {
+        key_file_t *cur = &_key_files[i];
+        if (cur->is_open && !strcmp(cur->key, key)) {
+            cur->last_use = ++_key_file_use;
+            *key_file = cur;
+            return MBED_SUCCESS;
+        }
+
+        // Take a closed entry, or else close the least recently used file,
+        // except the one under incremental set
+        if (((set_handle_t)cur != _cur_inc_set_handle) &&
+                (!entry || (entry->is_open && (!cur->is_open || (cur->last_use < entry->last_use))))) {
+            entry = cur;
+        }
+    }
+
+    if (!entry) {
+        return MBED_ERROR_FAILED_OPERATION;
+    }
+
+    _close_key_file(entry);
+    entry->last_use = ++_key_file_use;
+    *key_file = entry;
+
+    if (0 != entry->file.open(_fs, _full_path_key, O_RDWR)) {
         tr_info("Couldn't read: %s", _full_path_key);
-        status = MBED_ERROR_ITEM_NOT_FOUND;
-        goto exit_point;
+        return MBED_ERROR_ITEM_NOT_FOUND;
     }
 
     //Read Metadata
-    kv_file->read(key_metadata, sizeof(key_metadata_t));
+    if ((entry->file.read(&entry->metadata, sizeof(key_metadata_t)) != sizeof(key_metadata_t)) ||
+            (entry->metadata.magic != FSST_MAGIC) ||
+            (entry->metadata.revision > FSST_REVISION)) {
+        entry->file.close();
+        return MBED_ERROR_INVALID_DATA_DETECTED;
+    }
 
-    if ((key_metadata->magic != FSST_MAGIC) ||
-            (key_metadata->revision > FSST_REVISION)) {
-        status = MBED_ERROR_INVALID_DATA_DETECTED;
-        goto exit_point;
+    strcpy(entry->key, key);
+    entry->is_open = true;
+    return MBED_SUCCESS;
+}
+
+void FileSystemStore::_close_key_file(key_file_t *key_file)
+{
+    if (key_file->is_open) {
+        key_file->file.close();
+        key_file->is_open = false;
     }
+}
 
-exit_point:
-    return status;
+void FileSystemStore::_close_key_files()
+{
+    for (int i = 0; i < MBED_CONF_FILESYSTEMSTORE_OPEN_FILES; i++) {
+        _close_key_file(&_key_files[i]);
+    }
 }
 
 int FileSystemStore::_build_full_path_key(const char *key_src)
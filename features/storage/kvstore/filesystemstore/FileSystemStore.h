@@ -20,6 +20,12 @@
 
 #include "KVStore.h"
 #include "FileSystem.h"
+#include "File.h"
+
+// Number of key files kept open between operations
+#ifndef MBED_CONF_FILESYSTEMSTORE_OPEN_FILES
+#define MBED_CONF_FILESYSTEMSTORE_OPEN_FILES 4
+#endif
 
 namespace mbed {
 
@@ -27,6 +33,11 @@ namespace mbed {
  *  This class implements the KVStore interface to
  *  create a key value store over FileSystem.
  *
+ *  The files of the most recently used keys are kept open, up to
+ *  MBED_CONF_FILESYSTEMSTORE_OPEN_FILES of them, so keys accessed again
+ *  don't pay for a file open and close. Values are synced to the file
+ *  system before set() returns.
+ *
  *  @code
  *  ...
  *  @endcode
@@ -233,6 +244,15 @@ private:
         uint32_t user_flags;
     } key_metadata_t;
 
+    // Key file kept open between operations
+    typedef struct {
+        File file;
+        key_metadata_t metadata;
+        uint32_t last_use;
+        bool is_open;
+        char key[KVStore::MAX_KEY_SIZE + 1];
+    } key_file_t;
+
     /**
      * @brief Build Full name class member from Key, as a combination of FSST folder and key name
      *
@@ -243,15 +263,29 @@ private:
     int _build_full_path_key(const char *key_src);
 
     /**
-     * @brief Verify Key file metadata validity and open it if valid
+     * @brief Get the open key file of a key, opening it and verifying its
+     *        metadata if it isn't open yet
      *
-     * @param[in]  key                  In validated key file name.
-     * @param[in]  key_metadata         Returned key file metadata.
-     * @param[in]  kv_file              Opened KV file handle (unless file doesn't exist)
+     * @param[in]  key                  Key file name.
+     * @param[out] key_file             Open key file, or the closed entry to
+     *                                  open the key file with if it doesn't
+     *                                  exist or is corrupted.
      *
      * @returns 0 on success or a negative error code on failure
      */
-    int _verify_key_file(const char *key, key_metadata_t *key_metadata, File *kv_file);
+    int _open_key_file(const char *key, key_file_t **key_file);
+
+    /**
+     * @brief Close a key file
+     *
+     * @param[in]  key_file             Key file to close.
+     */
+    void _close_key_file(key_file_t *key_file);
+
+    /**
+     * @brief Close all key files
+     */
+    void _close_key_files();
 
     FileSystem *_fs;
     PlatformMutex _mutex;
@@ -262,7 +296,10 @@ private:
     size_t _cfg_fs_path_size; /* Size of configured FileSystemStore path name on FileSystem */
     char *_full_path_key; /* Full name of Key file currently working on */
     size_t _cur_inc_data_size; /* Amount of data added to Key file so far, during incremental add data */
+    size_t _cur_inc_final_size; /* Final data size given to set_start, during incremental add data */
     set_handle_t _cur_inc_set_handle; /* handle of currently key file under incremental set process */
+    key_file_t _key_files[MBED_CONF_FILESYSTEMSTORE_OPEN_FILES]; /* Key files kept open, least recently used reopened first */
+    uint32_t _key_file_use; /* Use counter ordering the key files */
 #endif
 };
 
@@ -19,6 +19,11 @@
 #include "KVMap.h"
 #include "KVStore.h"
 #include "mbed_error.h"
+#include <stdlib.h>
+
+#if FEATURE_STORAGE
+#include "configuration_store.h"
+#endif
 
 using namespace mbed;
 
@@ -202,3 +207,180 @@ int kv_reset(const char *kvstore_name)
 
 }
 
+int kv_transaction_begin(const char *kvstore_name)
+{
+    int ret = kv_init_storage_config();
+    if (MBED_SUCCESS != ret) {
+        return ret;
+    }
+
+    KVMap &kv_map = KVMap::get_instance();
+    KVStore *kv_instance = NULL;
+    size_t key_index = 0;
+    ret  = kv_map.lookup(kvstore_name, &kv_instance, &key_index);
+    if (ret != MBED_SUCCESS) {
+        return ret;
+    }
+
+    return kv_instance->transaction_begin();
+}
+
+int kv_transaction_commit(const char *kvstore_name)
+{
+    int ret = kv_init_storage_config();
+    if (MBED_SUCCESS != ret) {
+        return ret;
+    }
+
+    KVMap &kv_map = KVMap::get_instance();
+    KVStore *kv_instance = NULL;
+    size_t key_index = 0;
+    ret  = kv_map.lookup(kvstore_name, &kv_instance, &key_index);
+    if (ret != MBED_SUCCESS) {
+        return ret;
+    }
+
+    return kv_instance->transaction_commit();
+}
+
+int kv_transaction_abort(const char *kvstore_name)
+{
+    int ret = kv_init_storage_config();
+    if (MBED_SUCCESS != ret) {
+        return ret;
+    }
+
+    KVMap &kv_map = KVMap::get_instance();
+    KVStore *kv_instance = NULL;
+    size_t key_index = 0;
+    ret  = kv_map.lookup(kvstore_name, &kv_instance, &key_index);
+    if (ret != MBED_SUCCESS) {
+        return ret;
+    }
+
+    return kv_instance->transaction_abort();
+}
+
+#if FEATURE_STORAGE
+
+static int cfstore_import_key(KVStore *kv_instance, ARM_CFSTORE_DRIVER *drv, ARM_CFSTORE_HANDLE hkey)
+{
+    char key[CFSTORE_KEY_NAME_MAX_LENGTH + 1];
+    uint8_t key_len = sizeof(key);
+    if (drv->GetKeyName(hkey, key, &key_len) < ARM_DRIVER_OK) {
+        return MBED_ERROR_READ_FAILED;
+    }
+    if (!kv_instance->is_valid_key(key)) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    ARM_CFSTORE_SIZE size = 0;
+    if (drv->GetValueLen(hkey, &size) < ARM_DRIVER_OK) {
+        return MBED_ERROR_READ_FAILED;
+    }
+    void *buffer = NULL;
+    if (size) {
+        buffer = malloc(size);
+        if (!buffer) {
+            return MBED_ERROR_FAILED_OPERATION;
+        }
+        if (drv->Read(hkey, buffer, &size) < ARM_DRIVER_OK) {
+            free(buffer);
+            return MBED_ERROR_READ_FAILED;
+        }
+    }
+
+    int ret = kv_instance->set(key, buffer, size, 0);
+    free(buffer);
+    return ret;
+}
+
+int kv_import_cfstore(const char *kvstore_path, size_t max_keys, size_t *remaining)
+{
+    int ret = kv_init_storage_config();
+    if (MBED_SUCCESS != ret) {
+        return ret;
+    }
+
+    KVMap &kv_map = KVMap::get_instance();
+    KVStore *kv_instance = NULL;
+    size_t key_index = 0;
+    ret  = kv_map.lookup(kvstore_path, &kv_instance, &key_index);
+    if (ret != MBED_SUCCESS) {
+        return ret;
+    }
+
+    ARM_CFSTORE_DRIVER *drv = &cfstore_driver;
+    if (drv->GetCapabilities().asynchronous_ops) {
+        return MBED_ERROR_UNSUPPORTED;
+    }
+    if (drv->Initialize(NULL, NULL) < ARM_DRIVER_OK) {
+        return MBED_ERROR_INITIALIZATION_FAILED;
+    }
+
+    // the keys are deleted in CFSTORE's RAM area as they are set, which only reaches
+    // flash with the flush after the commit: a failed step leaves CFSTORE untouched
+    bool transaction = true;
+    ret = kv_instance->transaction_begin();
+    if (ret == MBED_ERROR_UNSUPPORTED) {
+        transaction = false;
+        ret = MBED_SUCCESS;
+    }
+
+    ARM_CFSTORE_HANDLE_INIT(next);
+    ARM_CFSTORE_HANDLE_INIT(prev);
+    size_t moved = 0;
+    int32_t found = ARM_CFSTORE_DRIVER_ERROR_KEY_NOT_FOUND;
+    while (ret == MBED_SUCCESS && moved < max_keys
+            && (found = drv->Find("*", prev, next)) == ARM_DRIVER_OK) {
+        ret = cfstore_import_key(kv_instance, drv, next);
+        if (ret == MBED_SUCCESS && drv->Delete(next) < ARM_DRIVER_OK) {
+            ret = MBED_ERROR_FAILED_OPERATION;
+        }
+        if (ret != MBED_SUCCESS) {
+            drv->Close(next);
+            break;
+        }
+        moved++;
+        CFSTORE_HANDLE_SWAP(prev, next);
+    }
+    if (ret == MBED_SUCCESS && found == ARM_DRIVER_OK) {
+        // step stopped at max_keys, release the handle of the last key
+        drv->Close(prev);
+    } else if (ret == MBED_SUCCESS && found != ARM_CFSTORE_DRIVER_ERROR_KEY_NOT_FOUND) {
+        ret = MBED_ERROR_READ_FAILED;
+    }
+
+    if (transaction) {
+        if (ret == MBED_SUCCESS) {
+            ret = kv_instance->transaction_commit();
+        } else {
+            kv_instance->transaction_abort();
+        }
+    }
+    if (ret == MBED_SUCCESS && moved && drv->Flush() < ARM_DRIVER_OK) {
+        ret = MBED_ERROR_WRITE_FAILED;
+    }
+
+    if (ret == MBED_SUCCESS && remaining) {
+        ARM_CFSTORE_HANDLE_INIT(count_next);
+        ARM_CFSTORE_HANDLE_INIT(count_prev);
+        *remaining = 0;
+        while (drv->Find("*", count_prev, count_next) == ARM_DRIVER_OK) {
+            (*remaining)++;
+            CFSTORE_HANDLE_SWAP(count_prev, count_next);
+        }
+    }
+
+    drv->Uninitialize();
+    return ret;
+}
+
+#else
+
+int kv_import_cfstore(const char *kvstore_path, size_t max_keys, size_t *remaining)
+{
+    return MBED_ERROR_UNSUPPORTED;
+}
+
+#endif // FEATURE_STORAGE
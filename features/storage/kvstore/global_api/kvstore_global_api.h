@@ -138,6 +138,50 @@ int kv_iterator_close(kv_iterator_t it);
  */
 int kv_reset(const char *kvstore_path);
 
+/**
+ * @brief Start a transaction on a specified partition. Sets and removes of its keys
+ *        until kv_transaction_commit are applied together, all or none of them.
+ *
+ * @param[in]  kvstore_path        /Partition/
+ *
+ * @returns MBED_SUCCESS on success or an error code from underlying KVStore instances
+ */
+int kv_transaction_begin(const char *kvstore_path);
+
+/**
+ * @brief Commit the transaction on a specified partition.
+ *
+ * @param[in]  kvstore_path        /Partition/
+ *
+ * @returns MBED_SUCCESS on success or an error code from underlying KVStore instances
+ */
+int kv_transaction_commit(const char *kvstore_path);
+
+/**
+ * @brief Abort the transaction on a specified partition, dropping its sets and removes.
+ *
+ * @param[in]  kvstore_path        /Partition/
+ *
+ * @returns MBED_SUCCESS on success or an error code from underlying KVStore instances
+ */
+int kv_transaction_abort(const char *kvstore_path);
+
+/**
+ * @brief Move the keys of the deprecated configuration store (CFSTORE) to a specified partition,
+ *        a bounded number of keys per call so the migration can run in steps on a live system.
+ *        The keys of a step are set in one transaction when the partition supports it, and
+ *        removed from CFSTORE only after that, so an interrupted step is repeated by the next call.
+ *
+ * @param[in]  kvstore_path        /Partition/
+ * @param[in]  max_keys            Maximum number of keys moved by this call.
+ * @param[out] remaining           Number of keys left in CFSTORE, may be NULL.
+ *
+ * @returns MBED_SUCCESS on success, MBED_ERROR_INVALID_ARGUMENT if a key name isn't valid in
+ *          the partition (the key is left in CFSTORE), MBED_ERROR_UNSUPPORTED if CFSTORE isn't
+ *          built or is asynchronous, or an error code from underlying KVStore instances
+ */
+int kv_import_cfstore(const char *kvstore_path, size_t max_keys, size_t *remaining);
+
 #ifdef __cplusplus
 } // closing brace for extern "C"
 #endif
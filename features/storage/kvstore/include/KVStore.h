@@ -20,6 +20,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
+#include "platform/mbed_error.h"
 
 namespace mbed {
 
@@ -190,6 +191,41 @@ public:
      */
     virtual int iterator_close(iterator_t it) = 0;
 
+    /**
+     * @brief Start a transaction. The sets and removes done until transaction_commit
+     *        are applied together: after a power failure, the store holds either all of
+     *        them or none of them. Other threads' operations wait until the transaction
+     *        is committed or aborted.
+     *
+     * @returns MBED_SUCCESS on success, MBED_ERROR_UNSUPPORTED if this KVStore doesn't
+     *          support transactions or an error code on failure
+     */
+    virtual int transaction_begin()
+    {
+        return MBED_ERROR_UNSUPPORTED;
+    }
+
+    /**
+     * @brief Commit a transaction, applying all its sets and removes at once.
+     *
+     * @returns MBED_SUCCESS on success or an error code on failure (the transaction is
+     *          then aborted)
+     */
+    virtual int transaction_commit()
+    {
+        return MBED_ERROR_UNSUPPORTED;
+    }
+
+    /**
+     * @brief Abort a transaction, dropping all its sets and removes.
+     *
+     * @returns MBED_SUCCESS on success or an error code on failure
+     */
+    virtual int transaction_abort()
+    {
+        return MBED_ERROR_UNSUPPORTED;
+    }
+
     /** Convenience function for checking key validity.
      *  Key must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
      *
@@ -151,7 +151,8 @@ int KVMap::deinit()
 
     for (int i = 0; i < _kv_num_attached_kvs; i++) {
 
-        if (_kv_map_table[i].kv_config->kvstore_main_instance == NULL) {
+        if (_kv_map_table[i].kv_config->kvstore_main_instance == NULL &&
+                _kv_map_table[i].kv_config->external_init == NULL) {
             goto exit;
         }
 
@@ -171,8 +172,16 @@ int KVMap::lookup(const char *full_name, KVStore **kv_instance, size_t *key_inde
 
     kvstore_config_t *kv_config;
     int ret = config_lookup(full_name, &kv_config, key_index);
+
+    _mutex->unlock();
+
     if (ret != MBED_SUCCESS) {
-        goto exit;
+        return ret;
+    }
+
+    ret = init_external(kv_config);
+    if (ret != MBED_SUCCESS) {
+        return ret;
     }
 
     *kv_instance = kv_config->kvstore_main_instance;
@@ -180,9 +189,17 @@ int KVMap::lookup(const char *full_name, KVStore **kv_instance, size_t *key_inde
         *flags_mask = kv_config->flags_mask;
     }
 
-exit:
-    _mutex->unlock();
-    return ret;
+    return MBED_SUCCESS;
+}
+
+int KVMap::init_external(kvstore_config_t *kv_config)
+{
+    int (*external_init)(void) = kv_config->external_init;
+    if (external_init == NULL) {
+        return MBED_SUCCESS;
+    }
+
+    return external_init();
 }
 
 // Full name lookup and then break it into KVStore configuration struct and key
@@ -275,6 +292,10 @@ KVStore *KVMap::get_external_kv_instance(const char *name)
 exit:
     _mutex->unlock();
 
+    if (ret == MBED_SUCCESS) {
+        ret = init_external(kv_config);
+    }
+
     return ret != MBED_SUCCESS ? NULL : kv_config->external_store;
 }
 
@@ -293,6 +314,10 @@ KVStore *KVMap::get_main_kv_instance(const char *name)
 exit:
     _mutex->unlock();
 
+    if (ret == MBED_SUCCESS) {
+        ret = init_external(kv_config);
+    }
+
     return ret != MBED_SUCCESS ? NULL : kv_config->kvstore_main_instance;
 }
 
@@ -329,6 +354,10 @@ BlockDevice *KVMap::get_external_blockdevice_instance(const char *name)
 exit:
     _mutex->unlock();
 
+    if (ret == MBED_SUCCESS) {
+        ret = init_external(kv_config);
+    }
+
     return ret != MBED_SUCCESS ? NULL : kv_config->external_bd;
 }
 
@@ -347,6 +376,10 @@ FileSystem *KVMap::get_external_filesystem_instance(const char *name)
 exit:
     _mutex->unlock();
 
+    if (ret == MBED_SUCCESS) {
+        ret = init_external(kv_config);
+    }
+
     return ret != MBED_SUCCESS ? NULL : kv_config->external_fs;
 }
 
@@ -67,6 +67,12 @@ typedef struct {
      * prevent errors in case the user choose an different security level.
      */
     uint32_t flags_mask;
+    /**
+     * Deferred initialization of the main and external instances, called by
+     * KVMap before their first use. NULL if they are initialized, otherwise
+     * kvstore_main_instance may be NULL until it is called.
+     */
+    int (*external_init)(void);
 } kvstore_config_t;
 
 /**
@@ -228,6 +234,15 @@ private:
      */
     int config_lookup(const char *full_name, kvstore_config_t **kv_config, size_t *key_index);
 
+    /**
+     * @brief Run the deferred initialization of a partition configuration, if any.
+     *        Must be called without holding the mutex, as it locks the configuration.
+     *
+     * @param kv_config  Partition configuration struct.
+     * @return 0 on success, negative error code on failure
+     */
+    int init_external(kvstore_config_t *kv_config);
+
     // Attachment table
     kv_map_entry_t _kv_map_table[MAX_ATTACHED_KVS];
     int _kv_num_attached_kvs;
@@ -23,12 +23,14 @@
 #include "aes.h"
 #include "cmac.h"
 #include "mbedtls/platform.h"
+#include "mbedtls/platform_util.h"
 #include "entropy.h"
 #include "DeviceKey.h"
 #include "mbed_assert.h"
 #include "mbed_wait_api.h"
 #include "mbed_error.h"
 #include <algorithm>
+#include <new>
 #include <string.h>
 #include <stdio.h>
 
@@ -49,6 +51,14 @@ static const char *const auth_prefix = "AUTH";
 
 static const uint32_t security_flags = KVStore::REQUIRE_CONFIDENTIALITY_FLAG | KVStore::REQUIRE_REPLAY_PROTECTION_FLAG;
 
+#ifndef MBED_CONF_SECURESTORE_VALUE_CACHE_SIZE
+#define MBED_CONF_SECURESTORE_VALUE_CACHE_SIZE 0
+#endif
+
+#ifndef MBED_CONF_SECURESTORE_VALUE_CACHE_SKIP_FLAGS
+#define MBED_CONF_SECURESTORE_VALUE_CACHE_SKIP_FLAGS 0
+#endif
+
 namespace {
 
 typedef struct {
@@ -75,6 +85,14 @@ typedef struct {
     KVStore::iterator_t underlying_it;
 } key_iterator_handle_t;
 
+// value cache entry, followed by the key and the decrypted data
+typedef struct cache_entry {
+    struct cache_entry *next;
+    uint32_t alloc_size;
+    uint32_t create_flags;
+    uint32_t data_size;
+} cache_entry_t;
+
 } // anonymous namespace
 
 
@@ -169,7 +187,7 @@ int cmac_calc_finish(mbedtls_cipher_context_t &auth_ctx, uint8_t *output)
 
 SecureStore::SecureStore(KVStore *underlying_kv, KVStore *rbp_kv) :
     _is_initialized(false), _underlying_kv(underlying_kv), _rbp_kv(rbp_kv), _entropy(0),
-    _inc_set_handle(0), _scratch_buf(0)
+    _inc_set_handle(0), _scratch_buf(0), _cache_head(0), _cache_used(0)
 {
 }
 
@@ -200,6 +218,8 @@ int SecureStore::set_start(set_handle_t *handle, const char *key, size_t final_d
 
     _mutex.lock();
 
+    cache_remove(key);
+
     ret = _underlying_kv->get(key, &ih->metadata, sizeof(record_metadata_t));
     if (ret == MBED_SUCCESS) {
         // Must not remove RP flag
@@ -496,6 +516,8 @@ int SecureStore::remove(const char *key)
         goto end;
     }
 
+    cache_remove(key);
+
     ret = _underlying_kv->remove(key);
     if (ret) {
         goto end;
@@ -711,11 +733,118 @@ end:
     return ret;
 }
 
+bool SecureStore::cache_get(const char *key, void *buffer, size_t buffer_size, size_t *actual_size,
+                            size_t offset, info_t *info)
+{
+    cache_entry_t *prev = 0;
+    cache_entry_t *entry = static_cast<cache_entry_t *>(_cache_head);
+
+    while (entry && strcmp(key, reinterpret_cast<char *>(entry + 1))) {
+        prev = entry;
+        entry = entry->next;
+    }
+
+    // Leave range errors to the underlying KVStore
+    if (!entry || (offset > entry->data_size)) {
+        return false;
+    }
+
+    if (prev) {
+        prev->next = entry->next;
+        entry->next = static_cast<cache_entry_t *>(_cache_head);
+        _cache_head = entry;
+    }
+
+    const uint8_t *data = reinterpret_cast<uint8_t *>(entry + 1) + strlen(key) + 1;
+    size_t copy_size = std::min(buffer_size, (size_t)(entry->data_size - offset));
+    if (copy_size) {
+        memcpy(buffer, data + offset, copy_size);
+    }
+    if (actual_size) {
+        *actual_size = copy_size;
+    }
+    if (info) {
+        info->flags = entry->create_flags;
+        info->size = entry->data_size;
+    }
+    return true;
+}
+
+void SecureStore::cache_add(const char *key, const void *buffer, const info_t &info)
+{
+    size_t key_size = strlen(key) + 1;
+    size_t alloc_size = sizeof(cache_entry_t) + key_size + info.size;
+
+    if (alloc_size > MBED_CONF_SECURESTORE_VALUE_CACHE_SIZE) {
+        return;
+    }
+
+    // Evict the least recently used entries until there's room
+    while (_cache_used + alloc_size > MBED_CONF_SECURESTORE_VALUE_CACHE_SIZE) {
+        cache_entry_t **last = reinterpret_cast<cache_entry_t **>(&_cache_head);
+        while ((*last)->next) {
+            last = &(*last)->next;
+        }
+        _cache_used -= (*last)->alloc_size;
+        mbedtls_platform_zeroize(*last, (*last)->alloc_size);
+        delete[] reinterpret_cast<uint8_t *>(*last);
+        *last = 0;
+    }
+
+    uint8_t *buf = new (std::nothrow) uint8_t[alloc_size];
+    if (!buf) {
+        return;
+    }
+
+    cache_entry_t *entry = reinterpret_cast<cache_entry_t *>(buf);
+    entry->alloc_size = alloc_size;
+    entry->create_flags = info.flags;
+    entry->data_size = info.size;
+    memcpy(entry + 1, key, key_size);
+    if (info.size) {
+        memcpy(buf + sizeof(cache_entry_t) + key_size, buffer, info.size);
+    }
+
+    entry->next = static_cast<cache_entry_t *>(_cache_head);
+    _cache_head = entry;
+    _cache_used += alloc_size;
+}
+
+void SecureStore::cache_remove(const char *key)
+{
+    cache_entry_t **curr = reinterpret_cast<cache_entry_t **>(&_cache_head);
+
+    while (*curr) {
+        cache_entry_t *entry = *curr;
+        if (key && strcmp(key, reinterpret_cast<char *>(entry + 1))) {
+            curr = &entry->next;
+            continue;
+        }
+        *curr = entry->next;
+        _cache_used -= entry->alloc_size;
+        mbedtls_platform_zeroize(entry, entry->alloc_size);
+        delete[] reinterpret_cast<uint8_t *>(entry);
+        if (key) {
+            break;
+        }
+    }
+}
+
 int SecureStore::get(const char *key, void *buffer, size_t buffer_size, size_t *actual_size,
                      size_t offset)
 {
+    info_t info;
+    int ret = MBED_SUCCESS;
+
     _mutex.lock();
-    int ret = do_get(key, buffer, buffer_size, actual_size, offset);
+    if (!cache_get(key, buffer, buffer_size, actual_size, offset, 0)) {
+        ret = do_get(key, buffer, buffer_size, actual_size, offset, &info);
+        // Only cache values we've just read in full
+        if (MBED_CONF_SECURESTORE_VALUE_CACHE_SIZE && !ret && !offset && (info.size <= buffer_size) &&
+                !(info.flags & MBED_CONF_SECURESTORE_VALUE_CACHE_SKIP_FLAGS)) {
+            cache_add(key, buffer, info);
+        }
+    }
     _mutex.unlock();
 
     return ret;
@@ -723,8 +852,12 @@ int SecureStore::get(const char *key, void *buffer, size_t buffer_size, size_t *
 
 int SecureStore::get_info(const char *key, info_t *info)
 {
+    int ret = MBED_SUCCESS;
+
     _mutex.lock();
-    int ret = do_get(key, 0, 0, 0, 0, info);
+    if (!cache_get(key, 0, 0, 0, 0, info)) {
+        ret = do_get(key, 0, 0, 0, 0, info);
+    }
     _mutex.unlock();
 
     return ret;
@@ -774,6 +907,7 @@ int SecureStore::deinit()
 {
     _mutex.lock();
     if (_is_initialized) {
+        cache_remove(0);
         mbedtls_entropy_free(static_cast<mbedtls_entropy_context *>(_entropy));
         delete static_cast<mbedtls_entropy_context *>(_entropy);
         delete static_cast<inc_set_handle_t *>(_inc_set_handle);
@@ -800,6 +934,7 @@ int SecureStore::reset()
     }
 
     _mutex.lock();
+    cache_remove(0);
     ret = _underlying_kv->reset();
     if (ret) {
         goto end;
@@ -117,6 +117,8 @@ public:
 
     /**
      * @brief Get one KVStore item, given key.
+     *        If securestore.value-cache-size is set, values read in full are kept authenticated
+     *        and decrypted in RAM, and later reads are served from there until the key is set or removed.
      *
      * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
      * @param[in]  buffer               Value data buffer.
@@ -276,6 +278,8 @@ private:
     void *_entropy;
     void *_inc_set_handle;
     uint8_t *_scratch_buf;
+    void *_cache_head;
+    size_t _cache_used;
 
     /**
      * @brief Actual get function, serving get and get_info APIs.
@@ -291,6 +295,37 @@ private:
      */
     int do_get(const char *key, void *buffer, size_t buffer_size, size_t *actual_size = NULL,
                size_t offset = 0, info_t *info = 0);
+
+    /**
+     * @brief Get a value from the value cache, making it the most recently used.
+     *
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[in]  buffer               Value data buffer.
+     * @param[in]  buffer_size          Value data buffer size.
+     * @param[out] actual_size          Actual read size.
+     * @param[in]  offset               Offset to read from in data.
+     * @param[out] info                 Returned information structure.
+     *
+     * @returns true if the key was found in the cache, false otherwise.
+     */
+    bool cache_get(const char *key, void *buffer, size_t buffer_size, size_t *actual_size,
+                   size_t offset, info_t *info);
+
+    /**
+     * @brief Add a value to the value cache, evicting the least recently used ones if needed.
+     *
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[in]  buffer               Value data buffer.
+     * @param[in]  info                 Value information structure.
+     */
+    void cache_add(const char *key, const void *buffer, const info_t &info);
+
+    /**
+     * @brief Remove a value from the value cache.
+     *
+     * @param[in]  key                  Key, or NULL to clear the whole cache.
+     */
+    void cache_remove(const char *key);
 #endif
 };
 /** @}*/
@@ -34,6 +34,9 @@ using namespace mbed;
 // --------------------------------------------------------- Definitions ----------------------------------------------------------
 
 static const uint32_t delete_flag = (1UL << 31);
+static const uint32_t transaction_begin_flag = (1UL << 30);
+static const uint32_t transaction_commit_flag = (1UL << 29);
+static const uint32_t transaction_flags = transaction_begin_flag | transaction_commit_flag;
 static const uint32_t internal_flags = delete_flag;
 static const uint32_t supported_flags = KVStore::WRITE_ONCE_FLAG;
 
@@ -50,8 +53,12 @@ typedef struct {
     uint32_t crc;
 } record_header_t;
 
+// The fingerprint is a second hash of the key, used to skip reading records
+// from the device on hash collisions. It fills what would be padding before
+// bd_offset, so it doesn't grow the RAM table.
 typedef struct {
     uint32_t  hash;
+    uint32_t  fingerprint;
     bd_size_t bd_offset;
 } ram_table_entry_t;
 
@@ -81,6 +88,16 @@ static const uint32_t work_buf_size = 64;
 static const uint32_t initial_crc = 0xFFFFFFFF;
 static const uint32_t initial_max_keys = 16;
 
+#ifndef MBED_CONF_TDBSTORE_GC_STEP_SIZE
+#define MBED_CONF_TDBSTORE_GC_STEP_SIZE 0
+#endif
+
+#ifndef MBED_CONF_TDBSTORE_SCAN_BUFFER_SIZE
+#define MBED_CONF_TDBSTORE_SCAN_BUFFER_SIZE 512
+#endif
+
+static const uint32_t scan_buf_size = MBED_CONF_TDBSTORE_SCAN_BUFFER_SIZE;
+
 // incremental set handle
 typedef struct {
     record_header_t header;
@@ -89,6 +106,7 @@ typedef struct {
     uint32_t offset_in_data;
     uint32_t ram_table_ind;
     uint32_t hash;
+    uint32_t fingerprint;
     bool new_key;
 } inc_set_handle_t;
 
@@ -120,12 +138,26 @@ static uint32_t calc_crc(uint32_t init_crc, uint32_t data_size, const void *data
     return crc;
 }
 
+// FNV-1a, independent from the CRC used as the key hash
+static uint32_t calc_fingerprint(const char *key)
+{
+    uint32_t fingerprint = 2166136261UL;
+    while (*key) {
+        fingerprint ^= (uint8_t) *key++;
+        fingerprint *= 16777619UL;
+    }
+    return fingerprint;
+}
+
 // Class member functions
 
 TDBStore::TDBStore(BlockDevice *bd) : _ram_table(0), _max_keys(0),
     _num_keys(0), _bd(bd), _buff_bd(0),  _free_space_offset(0), _master_record_offset(0),
     _master_record_size(0), _is_initialized(false), _active_area(0), _active_area_version(0), _size(0),
-    _prog_size(0), _work_buf(0), _key_buf(0), _variant_bd_erase_unit_size(false), _inc_set_handle(0)
+    _prog_size(0), _work_buf(0), _key_buf(0), _variant_bd_erase_unit_size(false), _inc_set_handle(0),
+    _gc_in_progress(false), _gc_scan_offset(0), _gc_start_offset(0), _gc_to_offset(0), _gc_offsets(0),
+    _in_transaction(false), _transaction_failed(false), _transaction_start_offset(0), _transaction_ram_table(0),
+    _transaction_num_keys(0), _scan_buf(0), _scan_area(0), _scan_offset(0), _scan_size(0)
 {
 }
 
@@ -136,6 +168,15 @@ TDBStore::~TDBStore()
 
 int TDBStore::read_area(uint8_t area, uint32_t offset, uint32_t size, void *buf)
 {
+    if (_scan_buf && (size <= scan_buf_size)) {
+        uint8_t *scan_buf;
+        int ret = scan_area(area, offset, size, scan_buf);
+        if (!ret) {
+            memcpy(buf, scan_buf, size);
+        }
+        return ret;
+    }
+
     int os_ret = _buff_bd->read(buf, _area_params[area].address + offset, size);
 
     if (os_ret) {
@@ -145,6 +186,41 @@ int TDBStore::read_area(uint8_t area, uint32_t offset, uint32_t size, void *buf)
     return MBED_SUCCESS;
 }
 
+int TDBStore::scan_area(uint8_t area, uint32_t offset, uint32_t size, uint8_t *&buf)
+{
+    if ((area != _scan_area) || (offset < _scan_offset) || (offset + size > _scan_offset + _scan_size)) {
+        // Refill with a large span, starting on a read unit boundary unless that
+        // leaves the requested block out
+        uint32_t read_size = _bd->get_read_size();
+        uint32_t start = offset - offset % read_size;
+        if (offset + size > start + scan_buf_size) {
+            start = offset;
+        }
+
+        if (start >= _area_params[area].size) {
+            return MBED_ERROR_READ_FAILED;
+        }
+
+        uint32_t span = std::min<uint32_t>(scan_buf_size, _area_params[area].size - start);
+        if (offset + size > start + span) {
+            return MBED_ERROR_READ_FAILED;
+        }
+
+        _scan_size = 0;
+        int os_ret = _buff_bd->read(_scan_buf, _area_params[area].address + start, span);
+        if (os_ret) {
+            return MBED_ERROR_READ_FAILED;
+        }
+
+        _scan_area = area;
+        _scan_offset = start;
+        _scan_size = span;
+    }
+
+    buf = _scan_buf + (offset - _scan_offset);
+    return MBED_SUCCESS;
+}
+
 int TDBStore::write_area(uint8_t area, uint32_t offset, uint32_t size, const void *buf)
 {
     int os_ret = _buff_bd->program(buf, _area_params[area].address + offset, size);
@@ -248,7 +324,7 @@ int TDBStore::read_record(uint8_t area, uint32_t offset, char *key,
         return MBED_ERROR_INVALID_SIZE;
     }
 
-    actual_data_size = std::min(data_buf_size, data_size - data_offset);
+    actual_data_size = std::min<uint32_t>(data_buf_size, data_size - data_offset);
 
     if (copy_data && actual_data_size && !data_buf) {
         return MBED_ERROR_INVALID_ARGUMENT;
@@ -292,17 +368,25 @@ int TDBStore::read_record(uint8_t area, uint32_t offset, char *key,
             // 3. After actual part is finished - read to work buffer
             // 4. Copy data flag not set - read to work buffer
             if (curr_data_offset < data_offset) {
-                chunk_size = std::min(work_buf_size, data_offset - curr_data_offset);
+                chunk_size = std::min<uint32_t>(work_buf_size, data_offset - curr_data_offset);
                 dest_buf = _work_buf;
             } else if (copy_data && (curr_data_offset < data_offset + actual_data_size)) {
                 chunk_size = actual_data_size;
                 dest_buf = static_cast<uint8_t *>(data_buf);
+            } else if (_scan_buf) {
+                // Scanning, calculate the CRC over the scan buffer in place
+                chunk_size = std::min(scan_buf_size, total_size);
+                dest_buf = 0;
             } else {
                 chunk_size = std::min(work_buf_size, total_size);
                 dest_buf = _work_buf;
             }
         }
-        ret = read_area(area, offset, chunk_size, dest_buf);
+        if (dest_buf) {
+            ret = read_area(area, offset, chunk_size, dest_buf);
+        } else {
+            ret = scan_area(area, offset, chunk_size, dest_buf);
+        }
         if (ret) {
             goto end;
         }
@@ -359,16 +443,30 @@ int TDBStore::find_record(uint8_t area, const char *key, uint32_t &offset,
 
 
     hash = calc_crc(initial_crc, strlen(key), key);
+    uint32_t fingerprint = calc_fingerprint(key);
+
+    // RAM table is sorted by descending hash, find the first entry whose hash
+    // isn't greater than ours (also the insertion point if the key is missing)
+    uint32_t low = 0, high = _num_keys;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if (ram_table[mid].hash > hash) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
 
-    for (ram_table_ind = 0; ram_table_ind < _num_keys; ram_table_ind++) {
+    for (ram_table_ind = low; ram_table_ind < _num_keys; ram_table_ind++) {
         entry = &ram_table[ram_table_ind];
         offset = entry->bd_offset;
-        if (hash < entry->hash)  {
-            continue;
-        }
         if (hash > entry->hash)  {
             return MBED_ERROR_ITEM_NOT_FOUND;
         }
+        // Different key with the same hash, no need to read it
+        if (fingerprint != entry->fingerprint) {
+            continue;
+        }
         ret = read_record(_active_area, offset, const_cast<char *>(key), 0, 0, actual_data_size, 0,
                           false, false, true, false, dummy_hash, flags, next_offset);
         // not found return code here means that hash doesn't belong to name. Continue searching.
@@ -425,8 +523,20 @@ int TDBStore::set_start(set_handle_t *handle, const char *key, size_t final_data
             }
         }
 
-        // If we have no room for the record, perform garbage collection
         uint32_t rec_size = record_size(key, final_data_size);
+        ret = gc_pace(rec_size);
+        if (ret) {
+            goto fail;
+        }
+
+        // Records of a transaction can't be moved to the standby area before it's committed,
+        // so they must fit, along with its commit marker
+        if (_in_transaction && (_free_space_offset + rec_size + record_size(master_rec_key, 0) > _size)) {
+            ret = MBED_ERROR_MEDIA_FULL;
+            goto fail;
+        }
+
+        // If we have no room for the record, perform garbage collection
         if (_free_space_offset + rec_size > _size) {
             ret = garbage_collection();
             if (ret) {
@@ -475,6 +585,7 @@ int TDBStore::set_start(set_handle_t *handle, const char *key, size_t final_data
     ih->bd_curr_offset = ih->bd_base_offset + align_up(sizeof(record_header_t), _prog_size);
     ih->offset_in_data = 0;
     ih->hash = hash;
+    ih->fingerprint = calc_fingerprint(key);
     ih->ram_table_ind = ram_table_ind;
     ih->header.magic = tdbstore_magic;
     ih->header.header_size = sizeof(record_header_t);
@@ -593,11 +704,14 @@ int TDBStore::set_finalize(set_handle_t handle)
     }
 
     // Need to flush buffered BD as our record is totally written now
-    os_ret = _buff_bd->sync();
-    if (os_ret) {
-        ret = MBED_ERROR_WRITE_FAILED;
-        need_gc = true;
-        goto end;
+    // (in a transaction, this is done once at commit)
+    if (!_in_transaction) {
+        os_ret = _buff_bd->sync();
+        if (os_ret) {
+            ret = MBED_ERROR_WRITE_FAILED;
+            need_gc = true;
+            goto end;
+        }
     }
 
     // In master record case we don't update RAM table
@@ -621,6 +735,10 @@ int TDBStore::set_finalize(set_handle_t handle)
         if (ih->ram_table_ind < _num_keys) {
             memmove(&ram_table[ih->ram_table_ind], &ram_table[ih->ram_table_ind + 1],
                     sizeof(ram_table_entry_t) * (_num_keys - ih->ram_table_ind));
+            if (_gc_in_progress) {
+                memmove(&_gc_offsets[ih->ram_table_ind], &_gc_offsets[ih->ram_table_ind + 1],
+                        sizeof(uint32_t) * (_num_keys - ih->ram_table_ind));
+            }
         }
         update_all_iterators(false, ih->ram_table_ind);
     } else {
@@ -628,12 +746,17 @@ int TDBStore::set_finalize(set_handle_t handle)
             if (ih->ram_table_ind < _num_keys) {
                 memmove(&ram_table[ih->ram_table_ind + 1], &ram_table[ih->ram_table_ind],
                         sizeof(ram_table_entry_t) * (_num_keys - ih->ram_table_ind));
+                if (_gc_in_progress) {
+                    memmove(&_gc_offsets[ih->ram_table_ind + 1], &_gc_offsets[ih->ram_table_ind],
+                            sizeof(uint32_t) * (_num_keys - ih->ram_table_ind));
+                }
             }
             _num_keys++;
             update_all_iterators(true, ih->ram_table_ind);
         }
         entry = &ram_table[ih->ram_table_ind];
         entry->hash = ih->hash;
+        entry->fingerprint = ih->fingerprint;
         entry->bd_offset = ih->bd_base_offset;
     }
 
@@ -821,16 +944,140 @@ int TDBStore::copy_record(uint8_t from_area, uint32_t from_offset, uint32_t to_o
 int TDBStore::garbage_collection()
 {
     ram_table_entry_t *ram_table = (ram_table_entry_t *) _ram_table;
-    uint32_t to_offset, to_next_offset;
-    uint32_t chunk_size, reserved_size;
+    uint32_t to_next_offset;
     int ret;
     size_t ind;
 
+    if (_in_transaction) {
+        // Records of an open transaction can't be moved, it can only be aborted now
+        _transaction_failed = true;
+        return MBED_ERROR_FAILED_OPERATION;
+    }
+
+    if (_gc_in_progress) {
+        ret = gc_copy((uint32_t) -1);
+        // Records superseded during an incremental garbage collection may fill the standby area,
+        // in which case start over
+        if (ret != MBED_ERROR_MEDIA_FULL) {
+            return ret;
+        }
+    }
+
+    ret = gc_start();
+    if (ret) {
+        return ret;
+    }
+
+    // Go over ram table and copy all entries to opposite area
+    for (ind = 0; ind < _num_keys; ind++) {
+        ret = copy_record(_active_area, ram_table[ind].bd_offset, _gc_to_offset, to_next_offset);
+        if (ret) {
+            gc_abort();
+            return ret;
+        }
+        _gc_offsets[ind] = _gc_to_offset;
+        _gc_to_offset = to_next_offset;
+    }
+
+    ret = gc_finish();
+    gc_abort();
+    return ret;
+}
+
+int TDBStore::gc_start()
+{
+    int ret;
+
     ret = check_erase_before_write(1 - _active_area, 0, _master_record_offset + _master_record_size);
     if (ret) {
         return ret;
     }
 
+    delete[] _gc_offsets;
+    _gc_offsets = new uint32_t[_max_keys];
+    _gc_scan_offset = _master_record_offset + _master_record_size;
+    _gc_start_offset = _free_space_offset;
+    _gc_to_offset = _master_record_offset + _master_record_size;
+    _gc_in_progress = true;
+    return MBED_SUCCESS;
+}
+
+void TDBStore::gc_abort()
+{
+    delete[] _gc_offsets;
+    _gc_offsets = 0;
+    _gc_in_progress = false;
+}
+
+int TDBStore::gc_copy(uint32_t budget)
+{
+    uint32_t offset, next_offset, to_next_offset, found_offset;
+    uint32_t hash, flags, actual_data_size, ram_table_ind;
+    uint32_t done = 0;
+    int ret;
+
+    // Records are copied in the order they were written, so that records written to the
+    // active area since we started are copied too, each one after the ones it supersedes.
+    while (_gc_scan_offset < _free_space_offset) {
+        if (done >= budget) {
+            return MBED_SUCCESS;
+        }
+
+        offset = _gc_scan_offset;
+        ret = read_record(_active_area, offset, _key_buf, 0, 0, actual_data_size, 0,
+                          true, false, false, true, hash, flags, next_offset);
+        if (ret) {
+            goto fail;
+        }
+
+        ret = find_record(_active_area, _key_buf, found_offset, ram_table_ind, hash);
+        if ((ret != MBED_SUCCESS) && (ret != MBED_ERROR_ITEM_NOT_FOUND)) {
+            goto fail;
+        }
+
+        bool live = (ret == MBED_SUCCESS) && (found_offset == offset);
+        // A key deleted since we started may have been copied already, so copy its delete record as well
+        bool new_delete = (flags & delete_flag) && (offset >= _gc_start_offset);
+
+        if (live || new_delete) {
+            if (_gc_to_offset + (next_offset - offset) > _size) {
+                ret = MBED_ERROR_MEDIA_FULL;
+                goto fail;
+            }
+            ret = copy_record(_active_area, offset, _gc_to_offset, to_next_offset);
+            if (ret) {
+                goto fail;
+            }
+            if (live) {
+                _gc_offsets[ram_table_ind] = _gc_to_offset;
+            }
+            _gc_to_offset = to_next_offset;
+        }
+
+        done += next_offset - offset;
+        _gc_scan_offset = next_offset;
+    }
+
+    // Switching areas would split an open transaction, so wait until it's committed
+    if (_in_transaction) {
+        return MBED_SUCCESS;
+    }
+
+    ret = gc_finish();
+
+fail:
+    gc_abort();
+    return ret;
+}
+
+int TDBStore::gc_finish()
+{
+    ram_table_entry_t *ram_table = (ram_table_entry_t *) _ram_table;
+    uint32_t to_offset, chunk_size, reserved_size;
+    int ret;
+    size_t ind;
+
+    // Reserved data may have been set since we started, so only copy it now
     ret = do_reserved_data_get(0, RESERVED_AREA_SIZE);
 
     if (!ret) {
@@ -853,25 +1100,14 @@ int TDBStore::garbage_collection()
         }
     }
 
-    to_offset = _master_record_offset + _master_record_size;
-
-    // Initialize in case table is empty
-    to_next_offset = to_offset;
-
-    // Go over ram table and copy all entries to opposite area
+    // Update RAM table
     for (ind = 0; ind < _num_keys; ind++) {
-        uint32_t from_offset = ram_table[ind].bd_offset;
-        ret = copy_record(_active_area, from_offset, to_offset, to_next_offset);
-        if (ret) {
-            return ret;
-        }
-        // Update RAM table
-        ram_table[ind].bd_offset = to_offset;
-        to_offset = to_next_offset;
+        ram_table[ind].bd_offset = _gc_offsets[ind];
     }
 
-    to_offset = to_next_offset;
-    _free_space_offset = to_next_offset;
+    to_offset = _gc_to_offset;
+    _free_space_offset = _gc_to_offset;
+    gc_abort();
 
     // Now we can switch to the new active area
     _active_area = 1 - _active_area;
@@ -892,6 +1128,60 @@ int TDBStore::garbage_collection()
     return MBED_SUCCESS;
 }
 
+int TDBStore::gc_pace(uint32_t rec_size)
+{
+    uint32_t room;
+    uint64_t budget;
+    int ret;
+
+    if (!MBED_CONF_TDBSTORE_GC_STEP_SIZE) {
+        return MBED_SUCCESS;
+    }
+
+    room = _size - _free_space_offset;
+    if (!_gc_in_progress) {
+        // Start once less than a quarter of the area is left
+        if (room >= rec_size + (_size - _master_record_offset) / 4) {
+            return MBED_SUCCESS;
+        }
+        ret = gc_start();
+        if (ret) {
+            return ret;
+        }
+    }
+
+    // If the record doesn't fit anyway, leave it to the full garbage collection
+    if (room <= rec_size) {
+        return MBED_SUCCESS;
+    }
+
+    // Go over at least what this record adds, plus the share of the backlog that
+    // lets us reach the end of the active area before it fills up.
+    budget = (uint64_t)(_free_space_offset - _gc_scan_offset) * rec_size / (room - rec_size) + rec_size;
+    budget = std::max(budget, (uint64_t) MBED_CONF_TDBSTORE_GC_STEP_SIZE);
+
+    ret = gc_copy((uint32_t) std::min(budget, (uint64_t) 0xFFFFFFFF));
+    if (ret == MBED_ERROR_MEDIA_FULL) {
+        // Abandoned, next step starts over
+        ret = MBED_SUCCESS;
+    }
+    return ret;
+}
+
+int TDBStore::garbage_collection_step()
+{
+    int ret;
+
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    _mutex.lock();
+    ret = gc_pace(0);
+    _mutex.unlock();
+    return ret;
+}
+
 
 int TDBStore::build_ram_table()
 {
@@ -902,6 +1192,7 @@ int TDBStore::build_ram_table()
     uint32_t flags;
     uint32_t actual_data_size;
     uint32_t ram_table_ind;
+    uint32_t transaction_offset = 0;
 
     _num_keys = 0;
     offset = _master_record_offset;
@@ -914,6 +1205,13 @@ int TDBStore::build_ram_table()
             goto end;
         }
 
+        if (flags & transaction_flags) {
+            // Records following a begin marker only count once its commit marker is found
+            transaction_offset = (flags & transaction_begin_flag) ? offset : 0;
+            offset = next_offset;
+            continue;
+        }
+
         ret = find_record(_active_area, _key_buf, dummy, ram_table_ind, hash);
 
         if ((ret != MBED_SUCCESS) && (ret != MBED_ERROR_ITEM_NOT_FOUND)) {
@@ -949,11 +1247,22 @@ int TDBStore::build_ram_table()
 
         // update record parameters
         ram_table[ram_table_ind].hash = hash;
+        ram_table[ram_table_ind].fingerprint = calc_fingerprint(_key_buf);
         ram_table[ram_table_ind].bd_offset = save_offset;
     }
 
 end:
     _free_space_offset = next_offset;
+
+    if (transaction_offset && ((ret == MBED_SUCCESS) || (ret == MBED_ERROR_INVALID_DATA_DETECTED))) {
+        // Last transaction wasn't committed, drop its records. They are not erased,
+        // so report the space after the remaining ones as corrupt.
+        _free_space_offset = transaction_offset;
+        ret = build_ram_table();
+        if (ret == MBED_SUCCESS) {
+            ret = MBED_ERROR_INVALID_DATA_DETECTED;
+        }
+    }
     return ret;
 }
 
@@ -970,6 +1279,13 @@ int TDBStore::increment_max_keys(void **ram_table)
     _ram_table = new_ram_table;
     delete[] old_ram_table;
 
+    if (_gc_in_progress) {
+        uint32_t *new_gc_offsets = new uint32_t[_max_keys];
+        memcpy(new_gc_offsets, _gc_offsets, sizeof(uint32_t) * (_max_keys - 1));
+        delete[] _gc_offsets;
+        _gc_offsets = new_gc_offsets;
+    }
+
     if (ram_table) {
         *ram_table = _ram_table;
     }
@@ -1098,6 +1414,13 @@ int TDBStore::init()
     // Currently set free space offset pointer to the end of free space.
     // Ram table build process needs it, but will update it.
     _free_space_offset = _size;
+
+    // Records, and the space after them, are read through a larger buffer while
+    // building the RAM table, so the scan takes few device reads and CRC calculations
+    if (scan_buf_size) {
+        _scan_buf = new uint8_t[scan_buf_size];
+        _scan_size = 0;
+    }
     ret = build_ram_table();
 
     if ((ret != MBED_SUCCESS) && (ret != MBED_ERROR_INVALID_DATA_DETECTED)) {
@@ -1116,6 +1439,9 @@ int TDBStore::init()
         }
     }
 
+    delete[] _scan_buf;
+    _scan_buf = 0;
+
     reserved_ret = do_reserved_data_get(0, RESERVED_AREA_SIZE);
 
     // If we either have a corrupt record somewhere, or the reserved area is corrupt,
@@ -1148,6 +1474,13 @@ int TDBStore::deinit()
         delete[] ram_table;
         delete[] _work_buf;
         delete[] _key_buf;
+        gc_abort();
+        if (_in_transaction) {
+            // Records of the transaction are dropped at next init
+            delete[] static_cast<ram_table_entry_t *>(_transaction_ram_table);
+            _in_transaction = false;
+            _mutex.unlock();
+        }
     }
 
     _is_initialized = false;
@@ -1173,6 +1506,13 @@ int TDBStore::reset()
 
     _mutex.lock();
 
+    gc_abort();
+    if (_in_transaction) {
+        delete[] static_cast<ram_table_entry_t *>(_transaction_ram_table);
+        _in_transaction = false;
+        _mutex.unlock();
+    }
+
     // Reset both areas
     for (area = 0; area < _num_areas; area++) {
         ret = reset_area(area);
@@ -1194,6 +1534,192 @@ end:
     return ret;
 }
 
+int TDBStore::write_transaction_marker(uint32_t flag)
+{
+    record_header_t header;
+    uint32_t offset = _free_space_offset;
+    uint32_t key_offset = offset + align_up(sizeof(record_header_t), _prog_size);
+    int os_ret, ret;
+
+    header.magic = tdbstore_magic;
+    header.header_size = sizeof(record_header_t);
+    header.revision = tdbstore_revision;
+    header.flags = flag;
+    header.key_size = strlen(master_rec_key);
+    header.reserved = 0;
+    header.data_size = 0;
+    header.crc = calc_crc(initial_crc, sizeof(record_header_t) - sizeof(header.crc), &header);
+    header.crc = calc_crc(header.crc, header.key_size, master_rec_key);
+
+    ret = check_erase_before_write(_active_area, offset, record_size(master_rec_key, 0));
+    if (ret) {
+        return ret;
+    }
+
+    ret = write_area(_active_area, key_offset, header.key_size, master_rec_key);
+    if (ret) {
+        return ret;
+    }
+
+    ret = write_area(_active_area, offset, sizeof(record_header_t), &header);
+    if (ret) {
+        return ret;
+    }
+
+    // Commit marker must be the last one to reach the media
+    if (flag & transaction_commit_flag) {
+        os_ret = _buff_bd->sync();
+        if (os_ret) {
+            return MBED_ERROR_WRITE_FAILED;
+        }
+    }
+
+    _free_space_offset = align_up(key_offset + header.key_size, _prog_size);
+    return MBED_SUCCESS;
+}
+
+int TDBStore::end_transaction(bool commit)
+{
+    ram_table_entry_t *ram_table = (ram_table_entry_t *) _ram_table;
+    int ret = MBED_SUCCESS;
+
+    commit = commit && !_transaction_failed;
+
+    // Nothing written, no need to drop anything
+    if (!commit && !_transaction_failed && (_free_space_offset == _transaction_start_offset)) {
+        commit = true;
+    }
+
+    if (commit) {
+        ret = write_transaction_marker(transaction_commit_flag);
+        if (ret) {
+            commit = false;
+        }
+    }
+
+    if (!commit) {
+        // Restore RAM table, so that garbage collection leaves the records of the transaction behind
+        memcpy(ram_table, _transaction_ram_table, sizeof(ram_table_entry_t) * _transaction_num_keys);
+        _num_keys = _transaction_num_keys;
+    }
+
+    delete[] static_cast<ram_table_entry_t *>(_transaction_ram_table);
+    _transaction_ram_table = 0;
+    _in_transaction = false;
+
+    if (!commit) {
+        // Incremental garbage collection may have copied records of the transaction
+        gc_abort();
+        int gc_ret = garbage_collection();
+        if (!ret) {
+            ret = gc_ret;
+        }
+    }
+
+    // Release the lock taken by transaction_begin
+    _mutex.unlock();
+    return ret;
+}
+
+int TDBStore::transaction_begin()
+{
+    ram_table_entry_t *ram_table;
+    uint32_t marker_size;
+    int ret;
+
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    _mutex.lock();
+
+    if (_in_transaction) {
+        ret = MBED_ERROR_INVALID_OPERATION;
+        goto fail;
+    }
+
+    // Make room for both markers
+    marker_size = record_size(master_rec_key, 0);
+    if (_free_space_offset + 2 * marker_size > _size) {
+        ret = garbage_collection();
+        if (ret) {
+            goto fail;
+        }
+        if (_free_space_offset + 2 * marker_size > _size) {
+            ret = MBED_ERROR_MEDIA_FULL;
+            goto fail;
+        }
+    }
+
+    ret = write_transaction_marker(transaction_begin_flag);
+    if (ret) {
+        garbage_collection();
+        goto fail;
+    }
+
+    // Keep the RAM table, in case the transaction is aborted
+    ram_table = (ram_table_entry_t *) _ram_table;
+    _transaction_ram_table = new ram_table_entry_t[_num_keys + 1];
+    memcpy(_transaction_ram_table, ram_table, sizeof(ram_table_entry_t) * _num_keys);
+    _transaction_num_keys = _num_keys;
+    _transaction_start_offset = _free_space_offset;
+    _transaction_failed = false;
+    _in_transaction = true;
+
+    // Keep the lock until the transaction ends
+    return MBED_SUCCESS;
+
+fail:
+    _mutex.unlock();
+    return ret;
+}
+
+int TDBStore::transaction_commit()
+{
+    int ret;
+
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    _mutex.lock();
+
+    if (!_in_transaction) {
+        ret = MBED_ERROR_INVALID_OPERATION;
+    } else {
+        bool failed = _transaction_failed;
+        ret = end_transaction(true);
+        if (failed) {
+            ret = MBED_ERROR_FAILED_OPERATION;
+        } else if (ret) {
+            ret = MBED_ERROR_WRITE_FAILED;
+        }
+    }
+
+    _mutex.unlock();
+    return ret;
+}
+
+int TDBStore::transaction_abort()
+{
+    int ret;
+
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    _mutex.lock();
+
+    if (!_in_transaction) {
+        ret = MBED_ERROR_INVALID_OPERATION;
+    } else {
+        ret = end_transaction(false);
+    }
+
+    _mutex.unlock();
+    return ret;
+}
+
 int TDBStore::iterator_open(iterator_t *it, const char *prefix)
 {
     key_iterator_handle_t *handle;
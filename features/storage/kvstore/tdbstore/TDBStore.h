@@ -245,6 +245,46 @@ public:
      */
     virtual int iterator_close(iterator_t it);
 
+    /**
+     * @brief Start a transaction. The sets and removes done until transaction_commit are
+     *        applied together: after a power failure, the store holds either all of them or
+     *        none of them. This operation is blocking other operations until the transaction
+     *        is committed or aborted. Records of a transaction must all fit in the active area.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_INVALID_OPERATION        A transaction is already in progress.
+     *          MBED_ERROR_READ_FAILED              Unable to read from media.
+     *          MBED_ERROR_WRITE_FAILED             Unable to write to media.
+     *          MBED_ERROR_MEDIA_FULL               No space left on media.
+     */
+    virtual int transaction_begin();
+
+    /**
+     * @brief Commit a transaction. Records are only flushed to media here, once for the
+     *        whole transaction.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_INVALID_OPERATION        No transaction in progress.
+     *          MBED_ERROR_FAILED_OPERATION         A media error occurred during the transaction, which was aborted.
+     *          MBED_ERROR_WRITE_FAILED             Unable to write to media, the transaction was aborted.
+     */
+    virtual int transaction_commit();
+
+    /**
+     * @brief Abort a transaction, dropping all its sets and removes. Unless nothing was
+     *        written in the transaction, this performs garbage collection. Iterators opened
+     *        during the transaction must not be used after it's aborted.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_INVALID_OPERATION        No transaction in progress.
+     *          MBED_ERROR_READ_FAILED              Unable to read from media.
+     *          MBED_ERROR_WRITE_FAILED             Unable to write to media.
+     */
+    virtual int transaction_abort();
+
     /**
      * @brief Set data in reserved area, which is a special location for special data, such as ROT.
      *        The data written to reserved area can't be overwritten.
@@ -280,6 +320,20 @@ public:
     virtual int reserved_data_get(void *reserved_data, size_t reserved_data_buf_size,
                                   size_t *actual_data_size = 0);
 
+    /**
+     * @brief Perform one bounded step of incremental garbage collection.
+     *        Starts compacting the active area once it is filling up, then copies up to
+     *        tdbstore.gc-step-size bytes of records to the standby area. Meant to be called
+     *        at idle time, for instance posted periodically on the shared event queue, so that
+     *        set() rarely has to do the copying itself. Does nothing if tdbstore.gc-step-size is 0.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_READ_FAILED              Unable to read from media.
+     *          MBED_ERROR_WRITE_FAILED             Unable to write to media.
+     */
+    int garbage_collection_step();
+
 #if !defined(DOXYGEN_ONLY)
 private:
 
@@ -312,6 +366,20 @@ private:
     bool _variant_bd_erase_unit_size;
     void *_inc_set_handle;
     void *_iterator_table[_max_open_iterators];
+    bool _gc_in_progress;
+    uint32_t _gc_scan_offset;
+    uint32_t _gc_start_offset;
+    uint32_t _gc_to_offset;
+    uint32_t *_gc_offsets;
+    bool _in_transaction;
+    bool _transaction_failed;
+    uint32_t _transaction_start_offset;
+    void *_transaction_ram_table;
+    size_t _transaction_num_keys;
+    uint8_t *_scan_buf;
+    uint8_t _scan_area;
+    uint32_t _scan_offset;
+    uint32_t _scan_size;
 
     /**
      * @brief Read a block from an area.
@@ -325,6 +393,20 @@ private:
      */
     int read_area(uint8_t area, uint32_t offset, uint32_t size, void *buf);
 
+    /**
+     * @brief Read a block from an area through the scan buffer, used while
+     *        building the RAM table. Reads of the buffer size or less are
+     *        served from the buffer, which is refilled with a large span as needed.
+     *
+     * @param[in]  area                   Area.
+     * @param[in]  offset                 Offset in area.
+     * @param[in]  size                   Number of bytes to read, up to the scan buffer size.
+     * @param[out] buf                    Pointer to the block in the scan buffer.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int scan_area(uint8_t area, uint32_t offset, uint32_t size, uint8_t *&buf);
+
     /**
      * @brief Write a block to an area.
      *
@@ -418,6 +500,62 @@ private:
      */
     int garbage_collection();
 
+    /**
+     * @brief Start an incremental garbage collection.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int gc_start();
+
+    /**
+     * @brief Copy live records of the active area to the standby one, and switch areas
+     *        once all of them are copied.
+     *
+     * @param[in]  budget                 Maximal number of active area bytes to go over.
+     *
+     * @returns 0 for success, nonzero for failure (garbage collection is then abandoned).
+     */
+    int gc_copy(uint32_t budget);
+
+    /**
+     * @brief Switch to the standby area once all live records are copied to it.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int gc_finish();
+
+    /**
+     * @brief Abandon an incremental garbage collection.
+     */
+    void gc_abort();
+
+    /**
+     * @brief Do the share of incremental garbage collection due before writing a record.
+     *
+     * @param[in]  rec_size               Size of the record about to be written.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int gc_pace(uint32_t rec_size);
+
+    /**
+     * @brief Write a transaction begin or commit marker record.
+     *
+     * @param[in]  flag                   Marker flag.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int write_transaction_marker(uint32_t flag);
+
+    /**
+     * @brief End the transaction in progress.
+     *
+     * @param[in]  commit                 Commit the transaction if true, abort it otherwise.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int end_transaction(bool commit);
+
     /**
      * @brief Return record size given key and data size.
      *
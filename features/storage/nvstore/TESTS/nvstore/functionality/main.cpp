@@ -391,6 +391,37 @@ static void nvstore_basic_functionality_test()
     result = nvstore.get(NVSTORE_NUM_PREDEFINED_KEYS + 1, 64, nvstore_testing_buf_get, actual_len_bytes);
     TEST_ASSERT_EQUAL(NVSTORE_NOT_FOUND, result);
 
+    // Garbage collection writes a checkpoint of all records, make sure init loads it
+    // and applies the records written after it
+    nvstore.set_max_keys(max_test_keys);
+    result = nvstore.set(10, 21, &(nvstore_testing_buf_set[11]));
+    TEST_ASSERT_EQUAL(NVSTORE_SUCCESS, result);
+    result = nvstore.remove(13);
+    TEST_ASSERT_EQUAL(NVSTORE_SUCCESS, result);
+
+    result = nvstore.deinit();
+    TEST_ASSERT_EQUAL(NVSTORE_SUCCESS, result);
+    result = nvstore.init();
+    TEST_ASSERT_EQUAL(NVSTORE_SUCCESS, result);
+
+    actual_len_bytes = 0;
+    result = nvstore.get(10, 64, nvstore_testing_buf_get, actual_len_bytes);
+    TEST_ASSERT_EQUAL(NVSTORE_SUCCESS, result);
+    TEST_ASSERT_EQUAL(21, actual_len_bytes);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&(nvstore_testing_buf_set[11]), nvstore_testing_buf_get, 21);
+
+    result = nvstore.get(13, 64, nvstore_testing_buf_get, actual_len_bytes);
+    TEST_ASSERT_EQUAL(NVSTORE_NOT_FOUND, result);
+
+    actual_len_bytes = 0;
+    result = nvstore.get(14, 89, nvstore_testing_buf_get, actual_len_bytes);
+    TEST_ASSERT_EQUAL(NVSTORE_SUCCESS, result);
+    TEST_ASSERT_EQUAL(89, actual_len_bytes);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&(nvstore_testing_buf_set[9]), nvstore_testing_buf_get, 89);
+
+    result = nvstore.set(19, 12, &(nvstore_testing_buf_set[2]));
+    TEST_ASSERT_EQUAL(NVSTORE_ALREADY_EXISTS, result);
+
 clean:
     delete[] nvstore_testing_buf_set;
     delete[] nvstore_testing_buf_get;
@@ -38,9 +38,10 @@ static const uint16_t delete_item_flag = 0x8000;
 static const uint16_t set_once_flag    = 0x4000;
 static const uint16_t header_flag_mask = 0xF000;
 
-static const uint16_t master_record_key = 0xFFE;
-static const uint16_t no_key            = 0xFFF;
-static const uint16_t last_reserved_key = master_record_key;
+static const uint16_t checkpoint_record_key = 0xFFD;
+static const uint16_t master_record_key     = 0xFFE;
+static const uint16_t no_key                = 0xFFF;
+static const uint16_t last_reserved_key     = checkpoint_record_key;
 
 typedef struct {
     uint16_t key_and_flags;
@@ -66,7 +67,7 @@ static const unsigned int owner_bit_pos = 12;
 typedef struct {
     uint16_t version;
     uint16_t max_keys;
-    uint32_t reserved;
+    uint32_t checkpoint_offset;
 } master_record_data_t;
 
 static const uint32_t min_area_size = 4096;
@@ -356,7 +357,7 @@ int NVStore::read_record(uint8_t area, uint32_t offset, uint16_t buf_size, void
     flags = header.key_and_flags & header_flag_mask;
     owner = (header.size_and_owner & owner_mask) >> owner_bit_pos;
 
-    if ((key >= _max_keys) && (key != master_record_key)) {
+    if ((key >= _max_keys) && (key != master_record_key) && (key != checkpoint_record_key)) {
         valid = 0;
         return NVSTORE_SUCCESS;
     }
@@ -457,13 +458,14 @@ int NVStore::write_record(uint8_t area, uint32_t offset, uint16_t key, uint16_t
     return NVSTORE_SUCCESS;
 }
 
-int NVStore::write_master_record(uint8_t area, uint16_t version, uint32_t &next_offset)
+int NVStore::write_master_record(uint8_t area, uint16_t version, uint32_t checkpoint_offset,
+                                 uint32_t &next_offset)
 {
     master_record_data_t master_rec;
 
     master_rec.version = version;
     master_rec.max_keys = _max_keys;
-    master_rec.reserved = 0;
+    master_rec.checkpoint_offset = checkpoint_offset;
     return write_record(area, 0, master_record_key, 0, 0, sizeof(master_rec),
                         &master_rec, next_offset);
 }
@@ -538,7 +540,7 @@ int NVStore::copy_record(uint8_t from_area, uint32_t from_offset, uint32_t to_of
 
 int NVStore::garbage_collection(uint16_t key, uint16_t flags, uint8_t owner, uint16_t buf_size, const void *buf, uint16_t num_keys)
 {
-    uint32_t curr_offset, new_area_offset, next_offset, curr_owner;
+    uint32_t curr_offset, new_area_offset, next_offset, curr_owner, checkpoint_offset;
     int ret;
     uint8_t curr_area;
 
@@ -577,9 +579,24 @@ int NVStore::garbage_collection(uint16_t key, uint16_t flags, uint8_t owner, uin
         new_area_offset = next_offset;
     }
 
+    // Write the offsets of all records as a checkpoint, so init doesn't need to traverse them.
+    // It's only an optimization, so just skip it if there is no room for it.
+    checkpoint_offset = 0;
+    uint32_t checkpoint_size = num_keys * sizeof(uint32_t);
+    if ((checkpoint_size <= size_mask) &&
+            (new_area_offset + align_up(sizeof(nvstore_record_header_t) + checkpoint_size, _min_prog_size) < _size)) {
+        ret = write_record(1 - _active_area, new_area_offset, checkpoint_record_key, 0, 0,
+                           checkpoint_size, _offset_by_key, next_offset);
+        if (ret != NVSTORE_SUCCESS) {
+            return ret;
+        }
+        checkpoint_offset = new_area_offset;
+        new_area_offset = next_offset;
+    }
+
     // Now write master record, with version incremented by 1.
     _active_area_version++;
-    ret = write_master_record(1 - _active_area, _active_area_version, next_offset);
+    ret = write_master_record(1 - _active_area, _active_area_version, checkpoint_offset, next_offset);
     if (ret != NVSTORE_SUCCESS) {
         return ret;
     }
@@ -818,6 +835,7 @@ int NVStore::init()
     uint16_t flags;
     uint16_t versions[NVSTORE_NUM_AREAS];
     uint16_t keys[NVSTORE_NUM_AREAS];
+    uint32_t checkpoint_offsets[NVSTORE_NUM_AREAS];
     uint16_t actual_size;
     uint8_t owner;
 
@@ -864,6 +882,7 @@ int NVStore::init()
         free_space_offset_of_area[area] =  0;
         versions[area] = 0;
         keys[area] = 0;
+        checkpoint_offsets[area] = 0;
 
         _size = std::min(_size, _flash_area_params[area].size);
 
@@ -898,6 +917,7 @@ int NVStore::init()
         }
         versions[area] = master_rec.version;
         keys[area] = master_rec.max_keys;
+        checkpoint_offsets[area] = master_rec.checkpoint_offset;
 
         // Place _free_space_offset after the master record (for the traversal,
         // which takes place after this loop).
@@ -924,7 +944,7 @@ int NVStore::init()
     // In case we have two empty areas, arbitrarily assign 0 to the active one.
     if ((area_state[0] == NVSTORE_AREA_STATE_EMPTY) && (area_state[1] == NVSTORE_AREA_STATE_EMPTY)) {
         _active_area = 0;
-        ret = write_master_record(_active_area, 1, _free_space_offset);
+        ret = write_master_record(_active_area, 1, 0, _free_space_offset);
         MBED_ASSERT(ret == NVSTORE_SUCCESS);
         _init_done = 1;
         return NVSTORE_SUCCESS;
@@ -943,6 +963,32 @@ int NVStore::init()
         MBED_ASSERT(!os_ret);
     }
 
+    // Load the offsets of the records written by the last garbage collection from its checkpoint,
+    // and only traverse the records written after it. Traverse the whole area if it's not valid.
+    uint32_t checkpoint_offset = checkpoint_offsets[_active_area];
+    if ((checkpoint_offset >= _free_space_offset) &&
+            (checkpoint_offset < free_space_offset_of_area[_active_area])) {
+        ret = read_record(_active_area, checkpoint_offset, _max_keys * sizeof(uint32_t), _offset_by_key,
+                          actual_size, 0, valid,
+                          key, flags, owner, next_offset);
+        if ((ret == NVSTORE_SUCCESS) && valid && (key == checkpoint_record_key) &&
+                !(actual_size % sizeof(uint32_t))) {
+            for (key = 0; key < _max_keys; key++) {
+                // Entries past the checkpoint's size, and keys allocated with no record, start empty
+                if ((key >= actual_size / sizeof(uint32_t)) || !(_offset_by_key[key] & offs_by_key_offset_mask)) {
+                    _offset_by_key[key] = 0;
+                } else {
+                    _offset_by_key[key] &= ~offs_by_key_allocated_mask;
+                }
+            }
+            _free_space_offset = next_offset;
+        } else {
+            for (key = 0; key < _max_keys; key++) {
+                _offset_by_key[key] = 0;
+            }
+        }
+    }
+
     // Traverse area until reaching the empty space at the end or until reaching a faulty record
     while (_free_space_offset < free_space_offset_of_area[_active_area]) {
         ret = read_record(_active_area, _free_space_offset, 0, NULL,
@@ -956,7 +1002,9 @@ int NVStore::init()
             ret = garbage_collection(no_key, 0, 0, 0, NULL, _max_keys);
             break;
         }
-        if (flags & delete_item_flag) {
+        if (key == checkpoint_record_key) {
+            // Only the checkpoint the master record points to is used
+        } else if (flags & delete_item_flag) {
             _offset_by_key[key] = 0;
         } else {
             _offset_by_key[key] = _free_space_offset | (_active_area << offs_by_key_area_bit_pos) |
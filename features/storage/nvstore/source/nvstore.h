@@ -388,11 +388,12 @@ private:
      *
      * @param[in]  area                   Area.
      * @param[in]  version                Area version.
+     * @param[in]  checkpoint_offset      Offset of checkpoint record (0 if none).
      * @param[out] next_offset            Offset of next record.
      *
      * @returns 0 for success, nonzero for failure.
      */
-    int write_master_record(uint8_t area, uint16_t version, uint32_t &next_offset);
+    int write_master_record(uint8_t area, uint16_t version, uint32_t checkpoint_offset, uint32_t &next_offset);
 
     /**
      * @brief Copy a record from one area to the other one.
@@ -55,6 +55,11 @@
 // max packet size
 #define MAX_PACKET  MAX_PACKET_SIZE_EPBULK
 
+// size of the block cache, best set to the erase unit of the storage
+#ifndef USBMSD_CACHE_SIZE
+#define USBMSD_CACHE_SIZE   4096
+#endif
+
 // CSW Status
 enum Status {
     CSW_PASSED,
@@ -68,6 +73,9 @@ USBMSD::USBMSD(uint16_t vendor_id, uint16_t product_id, uint16_t product_release
     memset((void *)&cbw, 0, sizeof(CBW));
     memset((void *)&csw, 0, sizeof(CSW));
     page = NULL;
+    cacheSize = 0;
+    cacheAddr = 0;
+    cacheLength = 0;
 }
 
 USBMSD::~USBMSD() {
@@ -120,8 +128,16 @@ bool USBMSD::connect(bool blocking) {
     if (BlockCount > 0) {
         BlockSize = MemorySize / BlockCount;
         if (BlockSize != 0) {
+            // whole blocks, no more than a disk access can transfer
+            cacheSize = (USBMSD_CACHE_SIZE / BlockSize) * BlockSize;
+            if (cacheSize < (uint32_t)BlockSize) {
+                cacheSize = BlockSize;
+            }
+            if (cacheSize > 255 * (uint32_t)BlockSize) {
+                cacheSize = 255 * BlockSize;
+            }
             free(page);
-            page = (uint8_t *)malloc(BlockSize * sizeof(uint8_t));
+            page = (uint8_t *)malloc(cacheSize * sizeof(uint8_t));
             if (page == NULL)
                 return false;
         }
@@ -143,6 +159,7 @@ void USBMSD::disconnect() {
 
 void USBMSD::reset() {
     stage = READ_CBW;
+    cacheLength = 0;
 }
 
 
@@ -225,21 +242,23 @@ void USBMSD::memoryWrite (uint8_t * buf, uint16_t size) {
         stallEndpoint(EPBULK_OUT);
     }
 
-    // we fill an array in RAM of 1 block before writing it in memory
-    for (int i = 0; i < size; i++)
-        page[addr%BlockSize + i] = buf[i];
-
-    // if the array is filled, write it in memory
-    if (!((addr + size)%BlockSize)) {
-        if (!(disk_status() & WRITE_PROTECT)) {
-            disk_write(page, addr/BlockSize, 1);
-        }
-    }
+    // we gather the data in RAM and write as many blocks as possible at once
+    if (!cacheLength)
+        cacheAddr = addr;
+    memcpy(&page[cacheLength], buf, size);
+    cacheLength += size;
 
     addr += size;
     length -= size;
     csw.DataResidue -= size;
 
+    if ((cacheLength == cacheSize) || (!length) || (stage != PROCESS_CBW)) {
+        if (!flushCache() && (stage == PROCESS_CBW)) {
+            stage = ERROR;
+            stallEndpoint(EPBULK_OUT);
+        }
+    }
+
     if ((!length) || (stage != PROCESS_CBW)) {
         csw.Status = (stage == ERROR) ? CSW_FAILED : CSW_PASSED;
         sendCSW();
@@ -255,13 +274,13 @@ void USBMSD::memoryVerify (uint8_t * buf, uint16_t size) {
         stallEndpoint(EPBULK_OUT);
     }
 
-    // beginning of a new block -> load a whole block in RAM
-    if (!(addr%BlockSize))
-        disk_read(page, addr/BlockSize, 1);
+    // end of the cached blocks -> load the next ones in RAM
+    if (addr >= cacheAddr + cacheLength)
+        fillCache();
 
     // info are in RAM -> no need to re-read memory
     for (n = 0; n < size; n++) {
-        if (page[addr%BlockSize + n] != buf[n]) {
+        if (page[addr - cacheAddr + n] != buf[n]) {
             memOK = false;
             break;
         }
@@ -503,12 +522,12 @@ void USBMSD::memoryRead (void) {
         stage = ERROR;
     }
 
-    // we read an entire block
-    if (!(addr%BlockSize))
-        disk_read(page, addr/BlockSize, 1);
+    // end of the cached blocks -> read the next ones at once
+    if (addr >= cacheAddr + cacheLength)
+        fillCache();
 
     // write data which are in RAM
-    writeNB(EPBULK_IN, &page[addr%BlockSize], n, MAX_PACKET_SIZE_EPBULK);
+    writeNB(EPBULK_IN, &page[addr - cacheAddr], n, MAX_PACKET_SIZE_EPBULK);
 
     addr += n;
     length -= n;
@@ -522,6 +541,34 @@ void USBMSD::memoryRead (void) {
 }
 
 
+void USBMSD::fillCache (void) {
+    uint32_t size = (length > cacheSize) ? cacheSize : length;
+
+    // length is a whole number of blocks, only the end of the memory cuts it
+    if ((addr + size) > MemorySize)
+        size = MemorySize - addr;
+
+    cacheAddr = addr;
+    cacheLength = size;
+    if (size)
+        disk_read(page, addr/BlockSize, size/BlockSize);
+}
+
+
+bool USBMSD::flushCache (void) {
+    // a partial block left by an error is dropped
+    uint32_t blocks = cacheLength/BlockSize;
+    int ret = 0;
+
+    if (blocks && !(disk_status() & WRITE_PROTECT)) {
+        ret = disk_write(page, cacheAddr/BlockSize, blocks);
+    }
+
+    cacheLength = 0;
+    return ret == 0;
+}
+
+
 bool USBMSD::infoTransfer (void) {
     uint32_t n;
 
@@ -546,6 +593,10 @@ bool USBMSD::infoTransfer (void) {
 
     length = n * BlockSize;
 
+    // the cache is only valid within a transfer
+    cacheAddr = addr;
+    cacheLength = 0;
+
     if (!cbw.DataLength) {              // host requests no data
         csw.Status = CSW_FAILED;
         sendCSW();
@@ -224,9 +224,19 @@ private:
     // memory OK (after a memoryVerify)
     bool memOK;
 
-    // cache in RAM before writing in memory. Useful also to read a block.
+    // cache in RAM of several blocks: writes are gathered in it before being
+    // programmed at once and reads fill it with all the blocks it can hold.
     uint8_t * page;
 
+    // size of the cache, a multiple of BlockSize
+    uint32_t cacheSize;
+
+    // addr of the first byte in the cache
+    uint32_t cacheAddr;
+
+    // number of bytes read or gathered in the cache
+    uint32_t cacheLength;
+
     int BlockSize;
     uint64_t MemorySize;
     uint64_t BlockCount;
@@ -244,6 +254,8 @@ private:
     bool requestSense (void);
     void memoryVerify (uint8_t * buf, uint16_t size);
     void memoryWrite (uint8_t * buf, uint16_t size);
+    void fillCache (void);
+    bool flushCache (void);
     void reset();
     void fail();
 };
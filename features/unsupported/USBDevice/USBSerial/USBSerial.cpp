@@ -18,18 +18,17 @@
 
 #include "stdint.h"
 #include "USBSerial.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_poll.h"
 
 int USBSerial::_putc(int c) {
-    if (!terminal_connected)
-        return 0;
-    send((uint8_t *)&c, 1);
-    return 1;
+    uint8_t byte = c;
+    return (write(&byte, 1) == 1) ? 1 : 0;
 }
 
 int USBSerial::_getc() {
     uint8_t c = 0;
-    while (buf.isEmpty());
-    buf.dequeue(&c);
+    while (read(&c, 1) != 1);
     return c;
 }
 
@@ -38,33 +37,154 @@ bool USBSerial::writeBlock(uint8_t * buf, uint16_t size) {
     if(size > MAX_PACKET_SIZE_EPBULK) {
         return false;
     }
-    if(!send(buf, size)) {
+    if(write(buf, size) != size) {
         return false;
     }
     return true;
 }
 
+ssize_t USBSerial::write(const void *buffer, size_t size) {
+    const uint8_t *ptr = (const uint8_t *)buffer;
+    size_t written = 0;
+
+    // nobody listens: drop the data rather than wait forever
+    if (!terminal_connected)
+        return size;
+
+    while (written < size) {
+        uint32_t n = tx_buf.push(ptr + written, size - written);
+        written += n;
+
+        // the IN endpoint is idle: send the first packet, the next ones
+        // are sent from its interrupt
+        core_util_critical_section_enter();
+        if (!tx_in_progress)
+            send_next_packet();
+        core_util_critical_section_exit();
+
+        if (!n && (!blocking || !terminal_connected))
+            break;
+    }
+
+    if (!written && size)
+        return -EAGAIN;
+    return written;
+}
+
+ssize_t USBSerial::read(void *buffer, size_t size) {
+    uint8_t *ptr = (uint8_t *)buffer;
+
+    if (!size)
+        return 0;
+
+    while (buf.empty()) {
+        if (!blocking)
+            return -EAGAIN;
+    }
+
+    uint32_t n = buf.pop(ptr, size);
+
+    // reception stopped while the ring was full, there is now room for a packet
+    core_util_critical_section_enter();
+    if (rx_paused && (USBSERIAL_RX_BUFFER_SIZE - buf.size() >= MAX_PACKET_SIZE_EPBULK)) {
+        rx_paused = false;
+        readStart(EPBULK_OUT, MAX_PACKET_SIZE_EPBULK);
+    }
+    core_util_critical_section_exit();
+
+    return n;
+}
+
+int USBSerial::set_blocking(bool blocking) {
+    this->blocking = blocking;
+    return 0;
+}
+
+bool USBSerial::is_blocking() const {
+    return blocking;
+}
+
+short USBSerial::poll(short events) const {
+    short revents = 0;
+
+    if (!buf.empty())
+        revents |= POLLIN;
+    if (!tx_buf.full())
+        revents |= POLLOUT;
+
+    return revents & events;
+}
+
+void USBSerial::sigio(Callback<void()> func) {
+    core_util_critical_section_enter();
+    sigio_cb = func;
+    if (sigio_cb && poll(POLLIN | POLLOUT))
+        sigio_cb();
+    core_util_critical_section_exit();
+}
+
+void USBSerial::wake() {
+    if (sigio_cb)
+        sigio_cb();
+}
 
+// Called with interrupts disabled or from the IN endpoint interrupt
+void USBSerial::send_next_packet() {
+    uint32_t size = tx_buf.pop(tx_packet, MAX_PACKET_SIZE_EPBULK);
+
+    if (!configured() || (!size && !tx_zlp_pending)) {
+        tx_in_progress = false;
+        tx_zlp_pending = false;
+        return;
+    }
+
+    // a full packet does not end the transfer for the host: if no data
+    // follows it, a zero length packet does
+    tx_zlp_pending = (size == MAX_PACKET_SIZE_EPBULK);
+    tx_in_progress = (endpointWrite(EPBULK_IN, tx_packet, size) == EP_PENDING);
+}
+
+bool USBSerial::EPBULK_IN_callback() {
+    send_next_packet();
+    wake();
+    return true;
+}
+
+void USBSerial::USBCallback_busReset(void) {
+    USBCDC::USBCallback_busReset();
+    tx_buf.consume(tx_buf.size());
+    tx_in_progress = false;
+    tx_zlp_pending = false;
+    rx_paused = false;
+}
 
 bool USBSerial::EPBULK_OUT_callback() {
-    uint8_t c[65];
+    uint8_t c[MAX_PACKET_SIZE_EPBULK];
     uint32_t size = 0;
 
     //we read the packet received and put it on the circular buffer
-    readEP(c, &size);
-    for (uint32_t i = 0; i < size; i++) {
-        buf.queue(c[i]);
+    USBDevice::readEP_NB(EPBULK_OUT, c, &size, MAX_PACKET_SIZE_EPBULK);
+    buf.push(c, size);
+
+    // keep receiving only if a whole packet fits in the buffer, otherwise
+    // the host is held off until the data is read
+    if (USBSERIAL_RX_BUFFER_SIZE - buf.size() >= MAX_PACKET_SIZE_EPBULK) {
+        readStart(EPBULK_OUT, MAX_PACKET_SIZE_EPBULK);
+    } else {
+        rx_paused = true;
     }
 
     //call a potential handlenr
     if (rx)
         rx.call();
+    wake();
 
     return true;
 }
 
 uint8_t USBSerial::available() {
-    return buf.available();
+    uint32_t size = buf.size();
+    return (size > 0xFF) ? 0xFF : size;
 }
 
 bool USBSerial::connected() {
@@ -23,10 +23,26 @@
 #include "Stream.h"
 #include "CircBuffer.h"
 #include "Callback.h"
+#include "platform/SPSCRingBuffer.h"
+
+// size of the receive ring, a power of two
+#ifndef USBSERIAL_RX_BUFFER_SIZE
+#define USBSERIAL_RX_BUFFER_SIZE    128
+#endif
+
+// size of the transmit ring, a power of two
+#ifndef USBSERIAL_TX_BUFFER_SIZE
+#define USBSERIAL_TX_BUFFER_SIZE    512
+#endif
 
 /**
 * USBSerial example
 *
+* Data written is queued in a ring buffer and sent in full packets from
+* interrupt context, so printf or write() of large blocks do not wait for
+* each packet to be acknowledged. The USBSERIAL_TX_BUFFER_SIZE and
+* USBSERIAL_RX_BUFFER_SIZE macros set the size of the rings.
+*
 * @code
 * #include "mbed.h"
 * #include "USBSerial.h"
@@ -58,8 +74,69 @@ public:
     */
     USBSerial(uint16_t vendor_id = 0x1f00, uint16_t product_id = 0x2012, uint16_t product_release = 0x0001, bool connect_blocking = true): USBCDC(vendor_id, product_id, product_release, connect_blocking){
         settingsChangedCallback = 0;
+        tx_in_progress = false;
+        tx_zlp_pending = false;
+        rx_paused = false;
+        blocking = true;
     };
 
+    /**
+    * Queue data to send. Full packets are sent as long as data is queued;
+    * a transfer ending on a full packet is terminated by a zero length packet.
+    *
+    * @param buffer data to send
+    * @param size number of bytes to send
+    *
+    * @returns the number of bytes queued, or -EAGAIN if none could be
+    * queued in non-blocking mode. Data is dropped if the terminal is not
+    * connected.
+    */
+    virtual ssize_t write(const void *buffer, size_t size);
+
+    /**
+    * Read received data.
+    *
+    * @param buffer buffer where the data is copied
+    * @param size maximum number of bytes to read
+    *
+    * @returns the number of bytes read, or -EAGAIN if none is available in
+    * non-blocking mode
+    */
+    virtual ssize_t read(void *buffer, size_t size);
+
+    /**
+    * Set blocking or non-blocking mode of read and write, blocking by default.
+    *
+    * @param blocking true for blocking mode, false for non-blocking mode
+    *
+    * @returns 0
+    */
+    virtual int set_blocking(bool blocking);
+
+    /**
+    * Check the blocking mode.
+    *
+    * @returns true if read and write are blocking
+    */
+    virtual bool is_blocking() const;
+
+    /**
+    * Check for poll event flags.
+    *
+    * @param events bitmask of poll events we're interested in
+    *
+    * @returns POLLIN if data can be read, POLLOUT if data can be written
+    */
+    virtual short poll(short events) const;
+
+    /**
+    * Register a callback on state change, called from interrupt context
+    * when data is received or space is freed in the transmit ring.
+    *
+    * @param func function to call on state change
+    */
+    virtual void sigio(Callback<void()> func);
+
 
     /**
     * Send a character. You can use puts, printf.
@@ -104,15 +181,16 @@ public:
      *    1 if there is space to write a character,
      *    0 otherwise
      */
-    int writeable() { return 1; } // always return 1, for write operation is blocking
+    int writeable() { return tx_buf.full() ? 0 : 1; }
 
     /**
     * Write a block of data.
     *
-    * For more efficiency, a block of size 64 (maximum size of a bulk endpoint) has to be written.
+    * The block is queued like with write(); larger blocks can be written
+    * with write().
     *
     * @param buf pointer on data which will be written
-    * @param size size of the buffer. The maximum size of a block is limited by the size of the endpoint (64 bytes)
+    * @param size size of the buffer, limited to the size of the endpoint (64 bytes)
     *
     * @returns true if successfull
     */
@@ -162,6 +240,8 @@ public:
 
 protected:
     virtual bool EPBULK_OUT_callback();
+    virtual bool EPBULK_IN_callback();
+    virtual void USBCallback_busReset(void);
     virtual void lineCodingChanged(int baud, int bits, int parity, int stop){
         if (settingsChangedCallback) {
             settingsChangedCallback(baud, bits, parity, stop);
@@ -169,8 +249,18 @@ protected:
     }
 
 private:
+    void send_next_packet();
+    void wake();
+
     Callback<void()> rx;
-    CircBuffer<uint8_t,128> buf;
+    Callback<void()> sigio_cb;
+    mbed::SPSCRingBuffer<uint8_t, USBSERIAL_RX_BUFFER_SIZE> buf;
+    mbed::SPSCRingBuffer<uint8_t, USBSERIAL_TX_BUFFER_SIZE> tx_buf;
+    uint8_t tx_packet[MAX_PACKET_SIZE_EPBULK];
+    volatile bool tx_in_progress;
+    volatile bool tx_zlp_pending;
+    volatile bool rx_paused;
+    bool blocking;
     void (*settingsChangedCallback)(int baud, int bits, int parity, int stop);
 };
 
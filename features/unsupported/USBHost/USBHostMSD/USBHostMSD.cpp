@@ -45,6 +45,11 @@ void USBHostMSD::init_usb()
     dev_connected = false;
     blockSize = 0;
     blockCount = 0;
+    next_block = 0;
+#if USBHOSTMSD_READ_AHEAD_SIZE
+    read_ahead_block = 0;
+    read_ahead_count = 0;
+#endif
     msd_intf = -1;
     msd_device_found = false;
     disk_init = false;
@@ -290,7 +295,7 @@ int USBHostMSD::SCSITransfer(uint8_t * cmd, uint8_t cmd_len, int flags, uint8_t
 }
 
 
-int USBHostMSD::dataTransfer(uint8_t * buf, uint32_t block, uint8_t nbBlock, int direction)
+int USBHostMSD::dataTransfer(uint8_t * buf, uint32_t block, uint16_t nbBlock, int direction)
 {
     uint8_t cmd[10];
     memset(cmd,0,10);
@@ -307,6 +312,27 @@ int USBHostMSD::dataTransfer(uint8_t * buf, uint32_t block, uint8_t nbBlock, int
     return SCSITransfer(cmd, 10, direction, buf, blockSize*nbBlock);
 }
 
+int USBHostMSD::blockTransfer(uint8_t * buf, uint32_t block, uint32_t count, int direction)
+{
+    // as many blocks per command as the transfer size allows
+    uint32_t max_blocks = USBHOSTMSD_MAX_TRANSFER_SIZE / blockSize;
+    if (max_blocks == 0) {
+        max_blocks = 1;
+    } else if (max_blocks > 0xffff) {
+        max_blocks = 0xffff;
+    }
+
+    while (count) {
+        uint32_t n = (count < max_blocks) ? count : max_blocks;
+        if (dataTransfer(buf, block, n, direction))
+            return -1;
+        buf += n * blockSize;
+        block += n;
+        count -= n;
+    }
+    return 0;
+}
+
 int USBHostMSD::getMaxLun()
 {
     uint8_t buf[1], res;
@@ -350,12 +376,15 @@ int USBHostMSD::program(const void *buffer, bd_addr_t addr, bd_size_t size)
     block_number =  addr / blockSize;
     count = size /blockSize;
 
-    for (uint32_t b = block_number; b < block_number + count; b++) {
-        if (dataTransfer(buf, b, 1, HOST_TO_DEVICE))
-            return -1;
-        buf += blockSize;
+#if USBHOSTMSD_READ_AHEAD_SIZE
+    // drop read-ahead blocks being overwritten
+    if (block_number < read_ahead_block + read_ahead_count &&
+            block_number + count > read_ahead_block) {
+        read_ahead_count = 0;
     }
-    return 0;
+#endif
+
+    return blockTransfer(buf, block_number, count, HOST_TO_DEVICE);
 }
 
 int USBHostMSD::read(void *buffer, bd_addr_t addr, bd_size_t size)
@@ -371,12 +400,44 @@ int USBHostMSD::read(void *buffer, bd_addr_t addr, bd_size_t size)
     block_number =  addr / blockSize;
     count = size / blockSize;
 
-    for (uint32_t b = block_number; b < block_number + count; b++) {
-        if (dataTransfer(buf, b, 1, DEVICE_TO_HOST))
-            return -1;
-        buf += blockSize;
+#if USBHOSTMSD_READ_AHEAD_SIZE
+    uint32_t read_ahead_max = USBHOSTMSD_READ_AHEAD_SIZE / blockSize;
+    bool sequential = (block_number == next_block);
+    next_block = block_number + count;
+
+    while (count) {
+        if (block_number >= read_ahead_block &&
+                block_number < read_ahead_block + read_ahead_count) {
+            // serve what the read-ahead buffer holds
+            uint32_t offset = block_number - read_ahead_block;
+            uint32_t n = read_ahead_block + read_ahead_count - block_number;
+            if (n > count) {
+                n = count;
+            }
+            memcpy(buf, &read_ahead[offset * blockSize], n * blockSize);
+            buf += n * blockSize;
+            block_number += n;
+            count -= n;
+        } else if (sequential && count < read_ahead_max) {
+            // refill the buffer with the blocks following a sequential read
+            uint32_t n = read_ahead_max;
+            if (n > blockCount - block_number) {
+                n = blockCount - block_number;
+            }
+            read_ahead_count = 0;
+            if (n < count || blockTransfer(read_ahead, block_number, n, DEVICE_TO_HOST))
+                return -1;
+            read_ahead_block = block_number;
+            read_ahead_count = n;
+        } else {
+            return blockTransfer(buf, block_number, count, DEVICE_TO_HOST);
+        }
     }
     return 0;
+#else
+    next_block = block_number + count;
+    return blockTransfer(buf, block_number, count, DEVICE_TO_HOST);
+#endif
 }
 
 int USBHostMSD::erase(bd_addr_t addr, bd_size_t size)
@@ -401,6 +462,6 @@ bd_size_t USBHostMSD::get_erase_size() const
 bd_size_t USBHostMSD::size() const
 {
     USB_DBG("FILESYSTEM: size ");
-    return (disk_init ? (bd_size_t)blockSize : 0);
+    return (disk_init ? (bd_size_t)blockSize * blockCount : 0);
 }
 #endif
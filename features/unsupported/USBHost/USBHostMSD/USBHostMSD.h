@@ -25,6 +25,17 @@
 #include "FATFileSystem.h"
 #include "BlockDevice.h"
 
+/* Largest data stage of a single READ(10) or WRITE(10) command, in bytes */
+#ifndef USBHOSTMSD_MAX_TRANSFER_SIZE
+#define USBHOSTMSD_MAX_TRANSFER_SIZE    4096
+#endif
+
+/* Size of the buffer filled ahead of sequential reads smaller than it,
+ * in bytes, 0 disables read-ahead */
+#ifndef USBHOSTMSD_READ_AHEAD_SIZE
+#define USBHOSTMSD_READ_AHEAD_SIZE      4096
+#endif
+
 /**
  * A class to communicate a USB flash disk
  */
@@ -108,13 +119,22 @@ private:
     int readCapacity();
     int inquiry(uint8_t lun, uint8_t page_code);
     int SCSIRequestSense();
-    int dataTransfer(uint8_t * buf, uint32_t block, uint8_t nbBlock, int direction);
+    int dataTransfer(uint8_t * buf, uint32_t block, uint16_t nbBlock, int direction);
+    int blockTransfer(uint8_t * buf, uint32_t block, uint32_t count, int direction);
     int checkResult(uint8_t res, USBEndpoint * ep);
     int getMaxLun();
 
     int blockSize;
     uint32_t blockCount;
 
+    // Block following the last one read, to detect sequential reads
+    uint32_t next_block;
+#if USBHOSTMSD_READ_AHEAD_SIZE
+    uint8_t read_ahead[USBHOSTMSD_READ_AHEAD_SIZE];
+    uint32_t read_ahead_block;
+    uint32_t read_ahead_count;
+#endif
+
     int msd_intf;
     bool msd_device_found;
     bool disk_init;
@@ -0,0 +1,134 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef BIQUAD_H
+#define BIQUAD_H
+
+#include <stdint.h>
+#include <string.h>
+#include "arm_math.h"
+
+namespace dsp {
+
+/** Cascade of biquad filters, in direct form I
+ *
+ * Each stage takes the coefficients {b0, b1, b2, a1, a2}, where a1 and a2
+ * have the opposite sign of the usual convention:
+ * y[n] = b0 * x[n] + b1 * x[n-1] + b2 * x[n-2] + a1 * y[n-1] + a2 * y[n-2]
+ *
+ * The fixed point versions use the fast CMSIS-DSP functions. Their
+ * coefficients are scaled down by 2^post_shift to fit in [-1, 1), and
+ * their accumulator is only as wide as the samples.
+ *
+ * @tparam T          Sample type, float32_t, q31_t or q15_t
+ * @tparam num_stages Number of second order stages
+ */
+template<typename T, uint8_t num_stages>
+class Biquad;
+
+template<uint8_t num_stages>
+class Biquad<float32_t, num_stages> {
+public:
+    /** Create a filter
+     *
+     * @param coeff 5 coefficients per stage, must stay valid
+     */
+    Biquad(const float32_t *coeff)
+    {
+        arm_biquad_cascade_df1_init_f32(&_biquad, num_stages, (float32_t *)coeff, _state);
+    }
+
+    void process(float32_t *sgn_in, float32_t *sgn_out, uint32_t length)
+    {
+        arm_biquad_cascade_df1_f32(&_biquad, sgn_in, sgn_out, length);
+    }
+
+    void reset(void)
+    {
+        memset(_state, 0, sizeof(_state));
+    }
+
+private:
+    arm_biquad_casd_df1_inst_f32 _biquad;
+    float32_t _state[4 * num_stages];
+};
+
+template<uint8_t num_stages>
+class Biquad<q31_t, num_stages> {
+public:
+    /** Create a filter
+     *
+     * @param coeff      5 coefficients per stage, must stay valid
+     * @param post_shift Scaling of the coefficients
+     */
+    Biquad(const q31_t *coeff, int8_t post_shift = 0)
+    {
+        arm_biquad_cascade_df1_init_q31(&_biquad, num_stages, (q31_t *)coeff, _state, post_shift);
+    }
+
+    /** Filter samples, using a 32-bit accumulator */
+    void process(q31_t *sgn_in, q31_t *sgn_out, uint32_t length)
+    {
+        arm_biquad_cascade_df1_fast_q31(&_biquad, sgn_in, sgn_out, length);
+    }
+
+    void reset(void)
+    {
+        memset(_state, 0, sizeof(_state));
+    }
+
+private:
+    arm_biquad_casd_df1_inst_q31 _biquad;
+    q31_t _state[4 * num_stages];
+};
+
+template<uint8_t num_stages>
+class Biquad<q15_t, num_stages> {
+public:
+    /** Create a filter
+     *
+     * @param coeff      6 coefficients per stage, {b0, 0, b1, b2, a1, a2}: the
+     *                   zero pads b0 so pairs can be read at once. Must stay
+     *                   valid and be 4-byte aligned.
+     * @param post_shift Scaling of the coefficients
+     */
+    Biquad(const q15_t *coeff, int8_t post_shift = 0)
+    {
+        arm_biquad_cascade_df1_init_q15(&_biquad, num_stages, (q15_t *)coeff, _state, post_shift);
+    }
+
+    /** Filter samples, two at a time with a 32-bit accumulator */
+    void process(q15_t *sgn_in, q15_t *sgn_out, uint32_t length)
+    {
+        arm_biquad_cascade_df1_fast_q15(&_biquad, sgn_in, sgn_out, length);
+    }
+
+    void reset(void)
+    {
+        memset(_state, 0, sizeof(_state));
+    }
+
+private:
+    arm_biquad_casd_df1_inst_q15 _biquad;
+    // Read as pairs of samples, so word aligned
+    union {
+        q15_t _state[4 * num_stages];
+        uint32_t _state_align;
+    };
+};
+
+}
+#endif
@@ -0,0 +1,131 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FIR_H
+#define FIR_H
+
+#include <stdint.h>
+#include <string.h>
+#include "arm_math.h"
+#include "platform/mbed_assert.h"
+
+namespace dsp {
+
+/** FIR filter
+ *
+ * The fixed point versions use the fast CMSIS-DSP functions, whose
+ * accumulator is only as wide as the samples: coefficients and inputs
+ * must be scaled so that the sum of a block doesn't overflow.
+ *
+ * @tparam T          Sample type, float32_t, q31_t or q15_t
+ * @tparam num_taps   Number of coefficients, even and at least 4 for q15_t
+ * @tparam block_size Number of samples processed at once
+ */
+template<typename T, uint16_t num_taps, uint32_t block_size = 32>
+class FIR;
+
+template<uint16_t num_taps, uint32_t block_size>
+class FIR<float32_t, num_taps, block_size> {
+public:
+    /** Create a filter
+     *
+     * @param coeff Coefficients in time reversed order, must stay valid
+     */
+    FIR(const float32_t *coeff)
+    {
+        arm_fir_init_f32(&_fir, num_taps, (float32_t *)coeff, _state, block_size);
+    }
+
+    void process(float32_t *sgn_in, float32_t *sgn_out)
+    {
+        arm_fir_f32(&_fir, sgn_in, sgn_out, block_size);
+    }
+
+    void reset(void)
+    {
+        memset(_state, 0, sizeof(_state));
+    }
+
+private:
+    arm_fir_instance_f32 _fir;
+    float32_t _state[block_size + num_taps - 1];
+};
+
+template<uint16_t num_taps, uint32_t block_size>
+class FIR<q31_t, num_taps, block_size> {
+public:
+    /** Create a filter
+     *
+     * @param coeff Coefficients in time reversed order, must stay valid
+     */
+    FIR(const q31_t *coeff)
+    {
+        arm_fir_init_q31(&_fir, num_taps, (q31_t *)coeff, _state, block_size);
+    }
+
+    /** Filter a block, using a 32-bit accumulator */
+    void process(q31_t *sgn_in, q31_t *sgn_out)
+    {
+        arm_fir_fast_q31(&_fir, sgn_in, sgn_out, block_size);
+    }
+
+    void reset(void)
+    {
+        memset(_state, 0, sizeof(_state));
+    }
+
+private:
+    arm_fir_instance_q31 _fir;
+    q31_t _state[block_size + num_taps - 1];
+};
+
+template<uint16_t num_taps, uint32_t block_size>
+class FIR<q15_t, num_taps, block_size> {
+    MBED_STATIC_ASSERT(num_taps >= 4 && (num_taps % 2) == 0, "q15 FIR filters need an even number of taps, at least 4");
+
+public:
+    /** Create a filter
+     *
+     * @param coeff Coefficients in time reversed order, must stay valid
+     *              and be 4-byte aligned
+     */
+    FIR(const q15_t *coeff)
+    {
+        arm_fir_init_q15(&_fir, num_taps, (q15_t *)coeff, _state, block_size);
+    }
+
+    /** Filter a block, two samples at a time with a 32-bit accumulator */
+    void process(q15_t *sgn_in, q15_t *sgn_out)
+    {
+        arm_fir_fast_q15(&_fir, sgn_in, sgn_out, block_size);
+    }
+
+    void reset(void)
+    {
+        memset(_state, 0, sizeof(_state));
+    }
+
+private:
+    arm_fir_instance_q15 _fir;
+    // Read as pairs of samples, so word aligned
+    union {
+        q15_t _state[block_size + num_taps];
+        uint32_t _state_align;
+    };
+};
+
+}
+#endif
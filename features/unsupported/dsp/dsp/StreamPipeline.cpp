@@ -0,0 +1,165 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "StreamPipeline.h"
+
+#if DEVICE_ANALOGIN_STREAM && MBED_CONF_RTOS_PRESENT
+
+#include "platform/mbed_critical.h"
+#include "rtos/ThisThread.h"
+
+#define BLOCK_FLAG      (1UL << 0)
+#define TERMINATE_FLAG  (1UL << 1)
+
+using namespace mbed;
+using namespace rtos;
+
+namespace dsp {
+
+StreamPipeline::StreamPipeline(AnalogInStream &source, size_t channels, size_t channel, size_t block_size,
+                               osPriority priority, uint32_t stack_size) :
+    _source(source),
+    _channels(channels),
+    _channel(channel),
+    _block_size(block_size),
+    _work(new float32_t[2 * block_size]),
+    _stage_count(0),
+    _thread(priority, stack_size, NULL, "dsp_pipeline"),
+    _thread_started(false),
+    _running(false),
+    _ready(NULL),
+    _busy(false),
+    _blocks_processed(0),
+    _deadline_misses(0)
+{
+    MBED_ASSERT(channel < channels);
+}
+
+StreamPipeline::~StreamPipeline()
+{
+    stop();
+    if (_thread_started) {
+        _thread.flags_set(TERMINATE_FLAG);
+        _thread.join();
+    }
+    delete[] _work;
+}
+
+int StreamPipeline::add_stage(StreamStage *stage)
+{
+    if (_running || _stage_count == MAX_STAGES) {
+        return -1;
+    }
+    _stages[_stage_count++] = stage;
+    return 0;
+}
+
+void StreamPipeline::set_output(Callback<void(const float32_t *, size_t)> output)
+{
+    _output = output;
+}
+
+int StreamPipeline::start(Span<uint16_t> dma_buffer)
+{
+    if (_running || (size_t)dma_buffer.size() != 2 * _block_size * _channels) {
+        return -1;
+    }
+
+    if (!_thread_started) {
+        if (_thread.start(callback(this, &StreamPipeline::thread_main)) != osOK) {
+            return -1;
+        }
+        _thread_started = true;
+    }
+
+    _ready = NULL;
+    _running = true;
+    int ret = _source.start(dma_buffer, callback(this, &StreamPipeline::on_block));
+    if (ret != 0) {
+        _running = false;
+    }
+    return ret;
+}
+
+void StreamPipeline::stop()
+{
+    if (_running) {
+        _source.stop();
+        _ready = NULL;
+        _running = false;
+    }
+}
+
+void StreamPipeline::on_block(Span<uint16_t> samples)
+{
+    // DMA now fills the other half: if it holds a block that is still
+    // waiting or being processed, that block missed its deadline
+    if (_busy || _ready) {
+        _deadline_misses++;
+    }
+    _ready = samples.data();
+    _thread.flags_set(BLOCK_FLAG);
+}
+
+void StreamPipeline::thread_main()
+{
+    while (true) {
+        uint32_t flags = ThisThread::flags_wait_any(BLOCK_FLAG | TERMINATE_FLAG);
+        if (flags & TERMINATE_FLAG) {
+            return;
+        }
+
+        core_util_critical_section_enter();
+        uint16_t *samples = (uint16_t *)_ready;
+        _ready = NULL;
+        _busy = samples != NULL;
+        core_util_critical_section_exit();
+
+        if (samples) {
+            process(samples);
+            _blocks_processed++;
+            _busy = false;
+        }
+    }
+}
+
+void StreamPipeline::process(const uint16_t *samples)
+{
+    float32_t *in = _work;
+    float32_t *out = _work + _block_size;
+
+    // Samples are scaled like read_u16(), center them on 0 and scale to [-1, 1)
+    samples += _channel;
+    for (size_t i = 0; i < _block_size; i++) {
+        in[i] = (float32_t)(int16_t)(samples[i * _channels] ^ 0x8000) * (1.0f / 32768.0f);
+    }
+
+    size_t length = _block_size;
+    for (size_t i = 0; i < _stage_count && length; i++) {
+        length = _stages[i]->process(in, out, length);
+        float32_t *tmp = in;
+        in = out;
+        out = tmp;
+    }
+
+    if (_output && length) {
+        _output(in, length);
+    }
+}
+
+}
+
+#endif
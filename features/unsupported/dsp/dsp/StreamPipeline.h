@@ -0,0 +1,149 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef STREAM_PIPELINE_H
+#define STREAM_PIPELINE_H
+
+#include "platform/platform.h"
+
+#if (DEVICE_ANALOGIN_STREAM && MBED_CONF_RTOS_PRESENT) || defined(DOXYGEN_ONLY)
+
+#include "arm_math.h"
+#include "StreamStage.h"
+#include "drivers/AnalogInStream.h"
+#include "platform/Callback.h"
+#include "platform/NonCopyable.h"
+#include "platform/Span.h"
+#include "rtos/Thread.h"
+
+namespace dsp {
+
+/** Block based processing of an analog input stream
+ *
+ * The DMA buffer of an AnalogInStream is used as ping-pong buffer: while
+ * DMA fills one half, a thread of the pipeline converts the other one to
+ * float and runs it through the stages, then hands the result to the output.
+ * Two work buffers alternate as input and output of the stages, so blocks
+ * are passed between stages without copies.
+ *
+ * The processing of a half must end before DMA comes back to it, that is
+ * within one block period. Blocks that miss this deadline are counted and,
+ * if not started yet, dropped.
+ *
+ * Example:
+ * @code
+ * const PinName pins[] = { A0 };
+ * AnalogInStream adc(pins, 1);
+ * uint16_t dma_buffer[2 * 256];
+ * FftStage fft(256);
+ * RmsStage rms;
+ * StreamPipeline pipeline(adc, 1, 0, 256);
+ *
+ * void on_spectrum(const float32_t *bins, size_t count)
+ * {
+ *     // 128 bins of each block of A0
+ * }
+ *
+ * int main() {
+ *     pipeline.add_stage(&fft);
+ *     pipeline.set_output(callback(on_spectrum));
+ *     adc.set_sample_rate(8000);
+ *     pipeline.start(dma_buffer);
+ * }
+ * @endcode
+ */
+class StreamPipeline : private mbed::NonCopyable<StreamPipeline> {
+public:
+    /** Maximum number of stages */
+    static const size_t MAX_STAGES = 4;
+
+    /** Create a pipeline
+     *
+     * @param source     Stream the blocks come from
+     * @param channels   Number of pins of the stream
+     * @param channel    Index of the pin whose samples are processed
+     * @param block_size Number of samples of the channel in a block
+     * @param priority   Priority of the processing thread
+     * @param stack_size Stack size of the processing thread
+     */
+    StreamPipeline(mbed::AnalogInStream &source, size_t channels, size_t channel, size_t block_size,
+                   osPriority priority = osPriorityAboveNormal, uint32_t stack_size = OS_STACK_SIZE);
+
+    virtual ~StreamPipeline();
+
+    /** Append a stage
+     *
+     * @param stage The stage, must stay valid while the pipeline exists
+     * @return 0 on success, or -1 if running or MAX_STAGES are already set
+     */
+    int add_stage(StreamStage *stage);
+
+    /** Set the function called from the processing thread with each processed block
+     *
+     * @param output Called with the output of the last stage and its sample count
+     */
+    void set_output(mbed::Callback<void(const float32_t *, size_t)> output);
+
+    /** Start sampling and processing
+     *
+     * @param dma_buffer Buffer of the stream, 2 * block_size * channels samples.
+     *                   It must stay valid until stop() is called.
+     * @return 0 on success, or a negative value on failure
+     */
+    int start(mbed::Span<uint16_t> dma_buffer);
+
+    /** Stop sampling; the block being processed, if any, is completed */
+    void stop();
+
+    /** Number of blocks processed since construction */
+    uint32_t get_blocks_processed() const
+    {
+        return _blocks_processed;
+    }
+
+    /** Number of blocks not processed within their block period */
+    uint32_t get_deadline_misses() const
+    {
+        return _deadline_misses;
+    }
+
+private:
+    void on_block(mbed::Span<uint16_t> samples);
+    void thread_main();
+    void process(const uint16_t *samples);
+
+    mbed::AnalogInStream &_source;
+    size_t _channels;
+    size_t _channel;
+    size_t _block_size;
+    float32_t *_work;
+    StreamStage *_stages[MAX_STAGES];
+    size_t _stage_count;
+    mbed::Callback<void(const float32_t *, size_t)> _output;
+    rtos::Thread _thread;
+    bool _thread_started;
+    bool _running;
+    volatile uint16_t *_ready;
+    volatile bool _busy;
+    volatile uint32_t _blocks_processed;
+    volatile uint32_t _deadline_misses;
+};
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,48 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "StreamStage.h"
+
+namespace dsp {
+
+FftStage::FftStage(uint16_t fft_size) : _fft_size(fft_size)
+{
+    arm_rfft_fast_init_f32(&_fft, fft_size);
+}
+
+size_t FftStage::process(float32_t *in, float32_t *out, size_t length)
+{
+    if (length != _fft_size) {
+        return 0;
+    }
+
+    // Packed output: bin 0 and bin N/2 real parts first, then complex bins
+    arm_rfft_fast_f32(&_fft, in, out, 0);
+
+    // The magnitude is computed in place, bin N/2 is dropped
+    float32_t dc = fabsf(out[0]);
+    arm_cmplx_mag_f32(out + 2, out + 1, length / 2 - 1);
+    out[0] = dc;
+    return length / 2;
+}
+
+size_t RmsStage::process(float32_t *in, float32_t *out, size_t length)
+{
+    arm_rms_f32(in, length, out);
+    return 1;
+}
+
+}
@@ -0,0 +1,110 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef STREAM_STAGE_H
+#define STREAM_STAGE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "arm_math.h"
+
+namespace dsp {
+
+/** A processing step of a StreamPipeline
+ *
+ * Stages are chained by the pipeline, which passes each one the output
+ * buffer of the previous one, so blocks are never copied between stages.
+ */
+class StreamStage {
+public:
+    virtual ~StreamStage() {}
+
+    /** Process a block
+     *
+     * @param in     Input samples. The stage may use it as scratch space.
+     * @param out    Buffer for the output, as large as the input
+     * @param length Number of input samples
+     * @return Number of output samples, at most length
+     */
+    virtual size_t process(float32_t *in, float32_t *out, size_t length) = 0;
+};
+
+/** FIR filter stage
+ *
+ * @tparam num_taps   Number of coefficients
+ * @tparam block_size Largest block size the stage is given
+ */
+template<uint16_t num_taps, uint32_t block_size>
+class FirStage : public StreamStage {
+public:
+    /** Create a FIR stage
+     *
+     * @param coeff Coefficients in time reversed order, must stay valid
+     */
+    FirStage(const float32_t *coeff)
+    {
+        arm_fir_init_f32(&_fir, num_taps, (float32_t *)coeff, _state, block_size);
+    }
+
+    virtual size_t process(float32_t *in, float32_t *out, size_t length)
+    {
+        arm_fir_f32(&_fir, in, out, length);
+        return length;
+    }
+
+    void reset(void)
+    {
+        memset(_state, 0, sizeof(_state));
+    }
+
+private:
+    arm_fir_instance_f32 _fir;
+    float32_t _state[block_size + num_taps - 1];
+};
+
+/** Magnitude spectrum stage
+ *
+ * Turns a block of real samples into the magnitude of its first length / 2
+ * frequency bins, the DC bin first.
+ */
+class FftStage : public StreamStage {
+public:
+    /** Create an FFT stage
+     *
+     * @param fft_size Block size, 32 to 4096 and a power of 2
+     */
+    FftStage(uint16_t fft_size);
+
+    /** Process a block of exactly fft_size samples, which are overwritten */
+    virtual size_t process(float32_t *in, float32_t *out, size_t length);
+
+private:
+    arm_rfft_fast_instance_f32 _fft;
+    uint16_t _fft_size;
+};
+
+/** Root mean square stage
+ *
+ * Reduces each block to a single sample, its RMS value.
+ */
+class RmsStage : public StreamStage {
+public:
+    virtual size_t process(float32_t *in, float32_t *out, size_t length);
+};
+
+}
+#endif
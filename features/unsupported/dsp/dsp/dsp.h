@@ -26,7 +26,11 @@
 #include "arm_math.h"
 
 #include "FIR_f32.h"
+#include "FIR.h"
+#include "Biquad.h"
 #include "Sine_f32.h"
+#include "StreamStage.h"
+#include "StreamPipeline.h"
 
 using namespace dsp;
 
@@ -16,6 +16,11 @@
  */
 #include "hal/LowPowerTickerWrapper.h"
 #include "platform/Callback.h"
+#include <string.h>
+
+#ifndef MBED_CONF_PLATFORM_LP_TICKER_WRAPPER_SPIN_MAX_US
+#define MBED_CONF_PLATFORM_LP_TICKER_WRAPPER_SPIN_MAX_US 250
+#endif
 
 LowPowerTickerWrapper::LowPowerTickerWrapper(const ticker_data_t *data, const ticker_interface_t *interface, uint32_t min_cycles_between_writes, uint32_t min_cycles_until_match)
     : _intf(data->interface), _min_count_between_writes(min_cycles_between_writes + 1), _min_count_until_match(min_cycles_until_match + 1), _suspended(false)
@@ -24,6 +29,7 @@ LowPowerTickerWrapper::LowPowerTickerWrapper(const ticker_data_t *data, const ti
 
     this->data.interface = interface;
     this->data.queue = data->queue;
+    memset(&_stats, 0, sizeof(_stats));
     _reset();
 
     core_util_critical_section_exit();
@@ -38,7 +44,22 @@ void LowPowerTickerWrapper::irq_handler(ticker_irq_handler_type handler)
     // until the next call to set_interrrupt or fire_interrupt (when not suspended).
     // This is to ensure that the device doesn't get stuck in sleep due to an
     // early low power ticker interrupt that was ignored.
-    if (_pending_fire_now || _pending_match || _suspended) {
+    _programmed = false;
+    timestamp_t current = _intf->read();
+    if (_batched && _pending_match && !_pending_fire_now && !_suspended && !_match_check(current)) {
+        // Interrupt of the match written before the current one was batched
+        // behind it, reschedule here instead of waking up the ticker layer
+        _intf->clear_interrupt();
+        _stats.absorbed_irqs++;
+        _schedule_match(current);
+    } else if (_pending_fire_now || _pending_match || _suspended) {
+        if (_pending_match && !_pending_fire_now && _match_check(current)) {
+            uint32_t late = (current - _cur_match_time) & _mask;
+            if (late > _stats.max_late_ticks) {
+                _stats.max_late_ticks = late;
+            }
+        }
+        _batched = false;
         _timeout.detach();
         _pending_timeout = false;
         _pending_match = false;
@@ -99,6 +120,15 @@ bool LowPowerTickerWrapper::timeout_pending()
     return pending;
 }
 
+void LowPowerTickerWrapper::get_stats(lp_ticker_wrapper_stats_t *stats)
+{
+    core_util_critical_section_enter();
+
+    *stats = _stats;
+
+    core_util_critical_section_exit();
+}
+
 void LowPowerTickerWrapper::init()
 {
     core_util_critical_section_enter();
@@ -145,6 +175,9 @@ void LowPowerTickerWrapper::set_interrupt(timestamp_t timestamp)
         _intf->set_interrupt(timestamp);
         _last_actual_set_interrupt = _last_set_interrupt;
         _set_interrupt_allowed = false;
+        _programmed = false;
+        _batched = false;
+        _stats.hw_writes++;
     }
 
     core_util_critical_section_exit();
@@ -155,6 +188,8 @@ void LowPowerTickerWrapper::disable_interrupt()
     core_util_critical_section_enter();
 
     _intf->disable_interrupt();
+    _programmed = false;
+    _batched = false;
 
     core_util_critical_section_exit();
 }
@@ -201,6 +236,9 @@ void LowPowerTickerWrapper::_reset()
     _cur_match_time = 0;
     _last_set_interrupt = 0;
     _last_actual_set_interrupt = 0;
+    _programmed = false;
+    _programmed_match = 0;
+    _batched = false;
 
     const ticker_info_t *info = _intf->get_info();
     if (info->bits >= 32) {
@@ -211,6 +249,8 @@ void LowPowerTickerWrapper::_reset()
 
     // Round us_per_tick up
     _us_per_tick = (1000000 + info->frequency - 1) / info->frequency;
+
+    _spin_max_ticks = (uint64_t)MBED_CONF_PLATFORM_LP_TICKER_WRAPPER_SPIN_MAX_US * info->frequency / 1000000;
 }
 
 void LowPowerTickerWrapper::_timeout_handler()
@@ -259,6 +299,8 @@ void LowPowerTickerWrapper::_schedule_match(timestamp_t current)
 {
     MBED_ASSERT(core_util_in_critical_section());
 
+    _batched = false;
+
     // Check if _intf->set_interrupt is allowed
     if (!_set_interrupt_allowed) {
         if (((current - _last_actual_set_interrupt) & _mask) >= _min_count_between_writes) {
@@ -271,14 +313,45 @@ void LowPowerTickerWrapper::_schedule_match(timestamp_t current)
 
     if (!_set_interrupt_allowed) {
 
+        // The match written last fires first, so reschedule from its
+        // interrupt rather than waking up for a Timeout
+        if (_programmed_first(current, cycles_until_match)) {
+            _batched = true;
+            _stats.batched++;
+            return;
+        }
+
+        if (too_close && cycles_until_match <= _spin_max_ticks) {
+            _fire_at_match(current);
+            return;
+        }
+
+        // Wait for the write to be allowed if the match can still be
+        // written afterwards
+        uint32_t cycles_until_allowed = _min_count_between_writes - ((current - _last_actual_set_interrupt) & _mask);
+        if (!too_close && cycles_until_allowed <= _spin_max_ticks &&
+                cycles_until_allowed + _min_count_until_match <= cycles_until_match) {
+            while (!_set_interrupt_allowed) {
+                current = _intf->read();
+                if (((current - _last_actual_set_interrupt) & _mask) >= _min_count_between_writes) {
+                    _set_interrupt_allowed  = true;
+                }
+            }
+            _stats.spins++;
+            if (_match_check(current)) {
+                _intf->fire_interrupt();
+            } else {
+                _schedule_match(current);
+            }
+            return;
+        }
+
         // Can't use _intf->set_interrupt so use microsecond Timeout instead
 
         // Speed optimization - if a timer has already been scheduled
         // then don't schedule it again.
         if (!_pending_timeout) {
-            uint32_t ticks = cycles_until_match < _min_count_until_match ? cycles_until_match : _min_count_until_match;
-            _timeout.attach_us(mbed::callback(this, &LowPowerTickerWrapper::_timeout_handler), _lp_ticks_to_us(ticks));
-            _pending_timeout = true;
+            _schedule_timeout(cycles_until_match);
         }
         return;
     }
@@ -290,11 +363,15 @@ void LowPowerTickerWrapper::_schedule_match(timestamp_t current)
         current = _intf->read();
         _last_actual_set_interrupt = current;
         _set_interrupt_allowed = false;
+        _programmed_match = _cur_match_time;
+        _programmed = true;
+        _stats.hw_writes++;
 
         // Check for overflow
         uint32_t new_cycles_until_match = (_cur_match_time - current) & _mask;
         if (new_cycles_until_match > cycles_until_match) {
             // Overflow so fire now
+            _programmed = false;
             _intf->fire_interrupt();
             return;
         }
@@ -307,10 +384,51 @@ void LowPowerTickerWrapper::_schedule_match(timestamp_t current)
     if (too_close) {
 
         // Low power ticker incremented to less than _min_count_until_match
-        // so low power ticker may not fire. Use Timeout to ensure it does fire.
-        uint32_t ticks = cycles_until_match < _min_count_until_match ? cycles_until_match : _min_count_until_match;
-        _timeout.attach_us(mbed::callback(this, &LowPowerTickerWrapper::_timeout_handler), _lp_ticks_to_us(ticks));
-        _pending_timeout = true;
+        // so low power ticker may not fire. Wait for the match if it is
+        // close enough, otherwise use Timeout to ensure it does fire.
+        _programmed = false;
+        if (cycles_until_match <= _spin_max_ticks) {
+            _fire_at_match(current);
+            return;
+        }
+        _schedule_timeout(cycles_until_match);
         return;
     }
 }
+
+void LowPowerTickerWrapper::_fire_at_match(timestamp_t current)
+{
+    MBED_ASSERT(core_util_in_critical_section());
+
+    while (!_match_check(current)) {
+        current = _intf->read();
+    }
+    _stats.spins++;
+    _intf->fire_interrupt();
+}
+
+bool LowPowerTickerWrapper::_programmed_first(timestamp_t current, uint32_t cycles_until_match)
+{
+    MBED_ASSERT(core_util_in_critical_section());
+
+    if (!_programmed) {
+        return false;
+    }
+
+    // A match already passed may have been handled, so only a match still
+    // ahead is known to interrupt
+    if (_ticker_match_interval_passed(_last_actual_set_interrupt, current, _programmed_match)) {
+        return false;
+    }
+    return ((_programmed_match - current) & _mask) <= cycles_until_match;
+}
+
+void LowPowerTickerWrapper::_schedule_timeout(uint32_t cycles_until_match)
+{
+    MBED_ASSERT(core_util_in_critical_section());
+
+    uint32_t ticks = cycles_until_match < _min_count_until_match ? cycles_until_match : _min_count_until_match;
+    _timeout.attach_us(mbed::callback(this, &LowPowerTickerWrapper::_timeout_handler), _lp_ticks_to_us(ticks));
+    _pending_timeout = true;
+    _stats.timeouts++;
+}
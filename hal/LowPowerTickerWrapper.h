@@ -24,6 +24,7 @@
 
 #include "hal/ticker_api.h"
 #include "hal/us_ticker_api.h"
+#include "hal/mbed_lp_ticker_wrapper.h"
 #include "drivers/Timeout.h"
 
 
@@ -93,6 +94,13 @@ public:
      */
     bool timeout_pending();
 
+    /**
+     * Get the scheduling statistics
+     *
+     * @param stats Filled with the statistics since the wrapper was created
+     */
+    void get_stats(lp_ticker_wrapper_stats_t *stats);
+
     /*
      * Implementation of ticker_init
      */
@@ -202,6 +210,31 @@ private:
      */
     uint32_t _us_per_tick;
 
+    /*
+     * Longest wait, in low power ticks, done by polling the ticker instead
+     * of scheduling a Timeout
+     */
+    uint32_t _spin_max_ticks;
+
+    /*
+     * _programmed_match is written to the hardware, is trusted to fire and
+     * hasn't fired yet
+     */
+    bool _programmed;
+
+    /*
+     * Last match written to the hardware
+     */
+    timestamp_t _programmed_match;
+
+    /*
+     * _cur_match_time is later than _programmed_match and is rescheduled
+     * from the interrupt of _programmed_match
+     */
+    bool _batched;
+
+    lp_ticker_wrapper_stats_t _stats;
+
 
     void _reset();
 
@@ -234,6 +267,29 @@ private:
      */
     void _schedule_match(timestamp_t current);
 
+    /*
+     * Poll the ticker until the match time then fire the interrupt
+     *
+     * @param current The current low power ticker time
+     */
+    void _fire_at_match(timestamp_t current);
+
+    /*
+     * Check that the match written to the hardware fires before the
+     * current match
+     *
+     * @param current The current low power ticker time
+     * @param cycles_until_match Ticks from current to the current match
+     */
+    bool _programmed_first(timestamp_t current, uint32_t cycles_until_match);
+
+    /*
+     * Use the microsecond Timeout to come back to the match
+     *
+     * @param cycles_until_match Ticks from now to the current match
+     */
+    void _schedule_timeout(uint32_t cycles_until_match);
+
 };
 
 #endif
@@ -0,0 +1,119 @@
+
+/** \addtogroup hal */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_ANALOGIN_STREAM_API_H
+#define MBED_ANALOGIN_STREAM_API_H
+
+#include "device.h"
+#include "pinmap.h"
+#include <stddef.h>
+
+#if DEVICE_ANALOGIN_STREAM
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Analogin stream hal structure. analogin_stream_s is declared in the target's hal
+ */
+typedef struct analogin_stream_s analogin_stream_t;
+
+/** Handler called from interrupt context when half of the buffer is filled
+ *
+ * @param id      The id passed to analogin_stream_start()
+ * @param samples The filled half of the buffer
+ * @param count   Number of samples in it
+ */
+typedef void (*analogin_stream_handler)(uint32_t id, uint16_t *samples, size_t count);
+
+/**
+ * \defgroup hal_analogin_stream Analogin stream hal functions
+ *
+ * Timer triggered conversions of one or more analog inputs, transferred
+ * to memory without CPU involvement.
+ *
+ * # Defined behavior
+ * * Each trigger converts all channels, in the order given to analogin_stream_init()
+ * * Samples are stored interleaved by channel, scaled like analogin_read_u16()
+ * * The buffer is filled circularly, the handler is called for each half
+ *   as soon as it is complete
+ * * Conversions continue while the handler runs, into the other half
+ * * analogin_stream_stop() returns after the last transfer has ended and
+ *   no handler is called after it
+ *
+ * # Undefined behavior
+ * * Calling any function other than analogin_stream_init() on an uninitialized object
+ * * Using a pin that is not in analogin_pinmap()
+ * * Starting with a buffer length that is not a multiple of twice the channel count
+ * * Starting a stream that is already running
+ *
+ * @{
+ */
+
+/** Initialize the stream
+ *
+ * @param obj       The analogin stream object to initialize
+ * @param pins      The analogin pins to convert, in order
+ * @param pin_count Number of pins
+ * @return 0 on success, or -1 if the pins can't be converted together
+ */
+int analogin_stream_init(analogin_stream_t *obj, const PinName *pins, size_t pin_count);
+
+/** Release the stream
+ *
+ * @param obj The analogin stream object
+ */
+void analogin_stream_free(analogin_stream_t *obj);
+
+/** Set the rate at which all channels are converted
+ *
+ * @param obj The analogin stream object
+ * @param hz  The requested rate
+ * @return The rate set, nearest to the requested one the hardware allows
+ */
+uint32_t analogin_stream_set_rate(analogin_stream_t *obj, uint32_t hz);
+
+/** Start converting into a buffer
+ *
+ * @param obj     The analogin stream object
+ * @param buffer  The buffer, filled circularly
+ * @param length  Number of samples the buffer holds
+ * @param handler Called with each filled half of the buffer
+ * @param id      Passed to the handler
+ */
+void analogin_stream_start(analogin_stream_t *obj, uint16_t *buffer, size_t length,
+                           analogin_stream_handler handler, uint32_t id);
+
+/** Stop converting
+ *
+ * @param obj The analogin stream object
+ */
+void analogin_stream_stop(analogin_stream_t *obj);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+#endif
+
+/** @}*/
@@ -0,0 +1,115 @@
+
+/** \addtogroup hal */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_ANALOGOUT_STREAM_API_H
+#define MBED_ANALOGOUT_STREAM_API_H
+
+#include "device.h"
+#include "pinmap.h"
+#include <stddef.h>
+
+#if DEVICE_ANALOGOUT_STREAM
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Analogout stream hal structure. analogout_stream_s is declared in the target's hal
+ */
+typedef struct analogout_stream_s analogout_stream_t;
+
+/** Handler called from interrupt context when half of the buffer has been output
+ *
+ * @param id      The id passed to analogout_stream_start()
+ * @param samples The half of the buffer that can be refilled
+ * @param count   Number of samples in it
+ */
+typedef void (*analogout_stream_handler)(uint32_t id, uint16_t *samples, size_t count);
+
+/**
+ * \defgroup hal_analogout_stream Analogout stream hal functions
+ *
+ * Timer triggered DAC updates, transferred from memory without CPU involvement.
+ *
+ * # Defined behavior
+ * * Each trigger writes the next sample to the DAC, scaled like analogout_write_u16()
+ * * The buffer is output circularly, the handler is called for each half
+ *   as soon as its last sample has been transferred
+ * * Output continues from the other half while the handler runs
+ * * analogout_stream_stop() returns after the last transfer has ended and
+ *   no handler is called after it. The output keeps the last value written.
+ *
+ * # Undefined behavior
+ * * Calling any function other than analogout_stream_init() on an uninitialized object
+ * * Using a pin that is not in analogout_pinmap()
+ * * Starting with an odd buffer length
+ * * Starting a stream that is already running
+ *
+ * @{
+ */
+
+/** Initialize the stream
+ *
+ * @param obj The analogout stream object to initialize
+ * @param pin The analogout pin name
+ */
+void analogout_stream_init(analogout_stream_t *obj, PinName pin);
+
+/** Release the stream
+ *
+ * @param obj The analogout stream object
+ */
+void analogout_stream_free(analogout_stream_t *obj);
+
+/** Set the rate at which samples are output
+ *
+ * @param obj The analogout stream object
+ * @param hz  The requested rate
+ * @return The rate set, nearest to the requested one the hardware allows
+ */
+uint32_t analogout_stream_set_rate(analogout_stream_t *obj, uint32_t hz);
+
+/** Start output from a buffer
+ *
+ * @param obj     The analogout stream object
+ * @param buffer  The buffer, output circularly
+ * @param length  Number of samples the buffer holds
+ * @param handler Called with each half of the buffer once it has been output
+ * @param id      Passed to the handler
+ */
+void analogout_stream_start(analogout_stream_t *obj, uint16_t *buffer, size_t length,
+                            analogout_stream_handler handler, uint32_t id);
+
+/** Stop output
+ *
+ * @param obj The analogout stream object
+ */
+void analogout_stream_stop(analogout_stream_t *obj);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+#endif
+
+/** @}*/
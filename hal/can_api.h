@@ -72,6 +72,8 @@ int           can_write(can_t *obj, CAN_Message, int cc);
 int           can_read(can_t *obj, CAN_Message *msg, int handle);
 int           can_mode(can_t *obj, CanMode mode);
 int           can_filter(can_t *obj, uint32_t id, uint32_t mask, CANFormat format, int32_t handle);
+/** Disable a filter set with can_filter(), returns 0 if unsupported or 1 on success */
+int           can_filter_remove(can_t *obj, int32_t handle);
 void          can_reset(can_t *obj);
 unsigned char can_rderror(can_t *obj);
 unsigned char can_tderror(can_t *obj);
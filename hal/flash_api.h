@@ -125,6 +125,48 @@ uint32_t flash_get_size(const flash_t *obj);
  */
 uint8_t flash_get_erase_value(const flash_t *obj);
 
+#if DEVICE_FLASH_ASYNCH
+
+/** Handler called from interrupt context when an asynchronous operation ends
+ *
+ * @param id     The id passed when the operation was started
+ * @param status 0 for success, -1 for error
+ */
+typedef void (*flash_asynch_handler)(uint32_t id, int32_t status);
+
+/** Start erasing one sector, returning immediately
+ *
+ * The flash controller's completion interrupt calls the handler. Code that
+ * runs while the operation is ongoing, including that interrupt handler,
+ * must not execute from the flash bank being erased, so targets with a
+ * single bank keep their interrupt handler and everything it calls in RAM.
+ * No other flash_* call is made on the object until the handler is called.
+ *
+ * @param obj     The flash object
+ * @param address The sector starting address
+ * @param handler Called when the erase ends
+ * @param id      Passed to the handler
+ * @return 0 if the erase has been started, -1 for error
+ */
+int32_t flash_erase_sector_asynch(flash_t *obj, uint32_t address, flash_asynch_handler handler, uint32_t id);
+
+/** Start programming pages, returning immediately
+ *
+ * Same constraints as flash_erase_sector_asynch().
+ *
+ * @param obj     The flash object
+ * @param address The sector starting address
+ * @param data    The data buffer to be programmed, valid until the handler is called
+ * @param size    The number of bytes to program
+ * @param handler Called when programming ends
+ * @param id      Passed to the handler
+ * @return 0 if programming has been started, -1 for error
+ */
+int32_t flash_program_page_asynch(flash_t *obj, uint32_t address, const uint8_t *data, uint32_t size,
+                                  flash_asynch_handler handler, uint32_t id);
+
+#endif
+
 /**@}*/
 
 #ifdef __cplusplus
@@ -21,6 +21,17 @@
 #include "hal/LowPowerTickerWrapper.h"
 #include "platform/mbed_critical.h"
 
+/* Targets can give the two constraints of their ticker separately, by
+ * default LPTICKER_DELAY_TICKS covers both
+ */
+#ifndef LPTICKER_MIN_WRITE_INTERVAL_TICKS
+#define LPTICKER_MIN_WRITE_INTERVAL_TICKS LPTICKER_DELAY_TICKS
+#endif
+
+#ifndef LPTICKER_MIN_MATCH_DELTA_TICKS
+#define LPTICKER_MIN_MATCH_DELTA_TICKS LPTICKER_DELAY_TICKS
+#endif
+
 // Do not use SingletonPtr since this must be initialized in a critical section
 static LowPowerTickerWrapper *ticker_wrapper;
 static uint64_t ticker_wrapper_data[(sizeof(LowPowerTickerWrapper) + 7) / 8];
@@ -96,7 +107,7 @@ const ticker_data_t *get_lp_ticker_wrapper_data(const ticker_data_t *data)
     core_util_critical_section_enter();
 
     if (!init) {
-        ticker_wrapper = new (ticker_wrapper_data) LowPowerTickerWrapper(data, &lp_interface, LPTICKER_DELAY_TICKS, LPTICKER_DELAY_TICKS);
+        ticker_wrapper = new (ticker_wrapper_data) LowPowerTickerWrapper(data, &lp_interface, LPTICKER_MIN_WRITE_INTERVAL_TICKS, LPTICKER_MIN_MATCH_DELTA_TICKS);
         init = true;
     }
 
@@ -125,4 +136,14 @@ void lp_ticker_wrapper_resume()
     ticker_wrapper->resume();
 }
 
+void lp_ticker_wrapper_get_stats(lp_ticker_wrapper_stats_t *stats)
+{
+    if (!init) {
+        // Force ticker to initialize
+        get_lp_ticker_data();
+    }
+
+    ticker_wrapper->get_stats(stats);
+}
+
 #endif
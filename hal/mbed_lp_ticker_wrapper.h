@@ -33,6 +33,19 @@ extern "C" {
 
 typedef void (*ticker_irq_handler_type)(const ticker_data_t *const);
 
+/**
+ * Scheduling statistics of the wrapper, to measure the wake-ups and the
+ * jitter of the low power ticker
+ */
+typedef struct {
+    uint32_t hw_writes;         /**< Match times written to the low power ticker */
+    uint32_t batched;           /**< Matches left behind an earlier match written to the ticker */
+    uint32_t absorbed_irqs;     /**< Interrupts of those earlier matches rescheduled without waking the ticker layer */
+    uint32_t spins;             /**< Matches too close to write, waited for by polling the ticker */
+    uint32_t timeouts;          /**< Matches scheduled with a microsecond Timeout */
+    uint32_t max_late_ticks;    /**< Longest delay from a match time to its interrupt, in low power ticks */
+} lp_ticker_wrapper_stats_t;
+
 /**
  * Interrupt handler for the wrapped lp ticker
  *
@@ -69,6 +82,13 @@ void lp_ticker_wrapper_suspend(void);
  */
 void lp_ticker_wrapper_resume(void);
 
+/**
+ * Get the scheduling statistics of the wrapper layer
+ *
+ * @param stats Filled with the statistics since the wrapper was created
+ */
+void lp_ticker_wrapper_get_stats(lp_ticker_wrapper_stats_t *stats);
+
 /**@}*/
 
 #ifdef __cplusplus
@@ -0,0 +1,38 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/port_api.h"
+
+#if DEVICE_PORTIN || DEVICE_PORTOUT
+
+#include "platform/mbed_toolchain.h"
+
+MBED_WEAK int port_pin_find(PinName pin, PortName *port, int *pin_n)
+{
+    for (int p = 0; p < 16; p++) {
+        for (int n = 0; n < 32; n++) {
+            if (port_pin((PortName)p, n) == pin) {
+                *port = (PortName)p;
+                *pin_n = n;
+                return 0;
+            }
+        }
+    }
+    return -1;
+}
+
+#endif
@@ -0,0 +1,29 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/qspi_api.h"
+
+#if DEVICE_QSPI
+
+#include "platform/mbed_toolchain.h"
+
+MBED_WEAK qspi_status_t qspi_memory_mapped(qspi_t *obj, const qspi_command_t *command, const void **address)
+{
+    return QSPI_STATUS_ERROR;
+}
+
+#endif
@@ -0,0 +1,30 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hal/spi_api.h"
+
+#if DEVICE_SPI
+
+#include "platform/mbed_toolchain.h"
+
+MBED_WEAK void spi_configure(spi_t *obj, int bits, int mode, int hz)
+{
+    spi_format(obj, bits, mode, 0);
+    spi_frequency(obj, hz);
+}
+
+#endif
@@ -19,6 +19,7 @@
 #include "hal/ticker_api.h"
 #include "platform/mbed_critical.h"
 #include "platform/mbed_assert.h"
+#include "platform/mbed_swo_trace.h"
 
 static void schedule_interrupt(const ticker_data_t *const ticker);
 static void update_present_time(const ticker_data_t *const ticker);
@@ -65,6 +66,11 @@ static void initialize(const ticker_data_t *ticker)
 
     ticker->queue->event_handler = NULL;
     ticker->queue->head = NULL;
+#if TICKER_SKIP_LEVELS
+    for (int i = 0; i < TICKER_SKIP_LEVELS; i++) {
+        ticker->queue->skip[i] = NULL;
+    }
+#endif
     ticker->queue->tick_last_read = ticker->interface->read();
     ticker->queue->tick_remainder = 0;
     ticker->queue->frequency = frequency;
@@ -81,6 +87,67 @@ static void initialize(const ticker_data_t *ticker)
     schedule_interrupt(ticker);
 }
 
+#if TICKER_SKIP_LEVELS
+/**
+ * Pick the number of express lanes of a new event, each lane holding a
+ * quarter of the events of the lane below.
+ */
+static uint8_t skip_level(ticker_event_queue_t *queue)
+{
+    queue->skip_seed = queue->skip_seed * 1664525 + 1013904223;
+
+    // the low bits of a linear congruential generator are poor
+    uint32_t bits = queue->skip_seed >> 16;
+    uint8_t level = 0;
+    while (level < TICKER_SKIP_LEVELS && (bits & 0x3) == 0) {
+        level++;
+        bits >>= 2;
+    }
+
+    return level;
+}
+
+/**
+ * Find the last event ordered before timestamp in each express lane, NULL
+ * standing for the start of the lane. If inclusive is set, events at
+ * exactly timestamp are ordered before it. Returns the event found in the
+ * lowest lane, which is where the search continues in the queue itself.
+ */
+static ticker_event_t *skip_search(const ticker_event_queue_t *queue, us_timestamp_t timestamp,
+                                   bool inclusive, ticker_event_t **preds)
+{
+    ticker_event_t *p = NULL;
+    for (int i = TICKER_SKIP_LEVELS - 1; i >= 0; i--) {
+        ticker_event_t *n = p ? p->skip[i] : queue->skip[i];
+        while (n != NULL && (n->timestamp < timestamp || (inclusive && n->timestamp == timestamp))) {
+            p = n;
+            n = n->skip[i];
+        }
+        preds[i] = p;
+    }
+
+    return p;
+}
+
+/**
+ * Remove an event from the express lanes it is in, starting the search in
+ * each lane at preds.
+ */
+static void skip_unlink(ticker_event_queue_t *queue, ticker_event_t *obj, ticker_event_t **preds)
+{
+    for (int i = 0; i < obj->level; i++) {
+        ticker_event_t **link = preds[i] ? &preds[i]->skip[i] : &queue->skip[i];
+        while (*link != NULL && *link != obj) {
+            link = &(*link)->skip[i];
+        }
+
+        if (*link != NULL) {
+            *link = obj->skip[i];
+        }
+    }
+}
+#endif
+
 /**
  * Set the event handler function of a ticker instance.
  */
@@ -222,6 +289,28 @@ int _ticker_match_interval_passed(timestamp_t prev_tick, timestamp_t cur_tick, t
     }
 }
 
+/**
+ * Return the latest time the next interrupt can happen without delaying any
+ * event past its tolerance.
+ *
+ * The queue is sorted by timestamp and an event can't be due before its
+ * timestamp, so the search stops at the first event starting after the
+ * deadline found so far.
+ */
+static us_timestamp_t next_deadline(const ticker_event_queue_t *queue)
+{
+    const ticker_event_t *p = queue->head;
+    us_timestamp_t deadline = p->timestamp + p->tolerance;
+
+    for (p = p->next; p != NULL && p->timestamp < deadline; p = p->next) {
+        if (p->timestamp + p->tolerance < deadline) {
+            deadline = p->timestamp + p->tolerance;
+        }
+    }
+
+    return deadline;
+}
+
 /**
  * Compute the time when the interrupt has to be triggered and schedule it.
  *
@@ -229,7 +318,8 @@ int _ticker_match_interval_passed(timestamp_t prev_tick, timestamp_t cur_tick, t
  * than ticker.queue.max_delta ticks from now then the ticker irq will be
  * scheduled in ticker.queue.max_delta ticks. Otherwise the irq will be
  * scheduled to happen when the running counter reach the timestamp of the
- * first event in the queue.
+ * first event in the queue, delayed as far as the tolerance of the queued
+ * events allows.
  *
  * @note If there is no event in the queue then the interrupt is scheduled to
  * in ticker.queue.max_delta. This is necessary to keep track
@@ -248,7 +338,7 @@ static void schedule_interrupt(const ticker_data_t *const ticker)
 
     if (ticker->queue->head) {
         us_timestamp_t present = ticker->queue->present_time;
-        us_timestamp_t match_time = ticker->queue->head->timestamp;
+        us_timestamp_t match_time = next_deadline(ticker->queue);
 
         // if the event at the head of the queue is in the past then schedule
         // it immediately.
@@ -287,11 +377,13 @@ void ticker_set_handler(const ticker_data_t *const ticker, ticker_event_handler
 
 void ticker_irq_handler(const ticker_data_t *const ticker)
 {
+    MBED_SWO_TRACE(MBED_SWO_TRACE_TICKER_IRQ, ticker);
     core_util_critical_section_enter();
 
     ticker->interface->clear_interrupt();
     if (ticker->queue->suspended) {
         core_util_critical_section_exit();
+        MBED_SWO_TRACE_MARK(MBED_SWO_TRACE_TICKER_IRQ_END);
         return;
     }
 
@@ -310,6 +402,12 @@ void ticker_irq_handler(const ticker_data_t *const ticker)
             //      point to the following one and execute its handler
             ticker_event_t *p = ticker->queue->head;
             ticker->queue->head = ticker->queue->head->next;
+#if TICKER_SKIP_LEVELS
+            // the head comes first in every lane it is in
+            for (int i = 0; i < p->level; i++) {
+                ticker->queue->skip[i] = p->skip[i];
+            }
+#endif
             if (ticker->queue->event_handler != NULL) {
                 (*ticker->queue->event_handler)(p->id); // NOTE: the handler can set new events
             }
@@ -324,6 +422,7 @@ void ticker_irq_handler(const ticker_data_t *const ticker)
     schedule_interrupt(ticker);
 
     core_util_critical_section_exit();
+    MBED_SWO_TRACE_MARK(MBED_SWO_TRACE_TICKER_IRQ_END);
 }
 
 void ticker_insert_event(const ticker_data_t *const ticker, ticker_event_t *obj, timestamp_t timestamp, uint32_t id)
@@ -347,6 +446,11 @@ void ticker_insert_event(const ticker_data_t *const ticker, ticker_event_t *obj,
 }
 
 void ticker_insert_event_us(const ticker_data_t *const ticker, ticker_event_t *obj, us_timestamp_t timestamp, uint32_t id)
+{
+    ticker_insert_event_with_tolerance_us(ticker, obj, timestamp, 0, id);
+}
+
+void ticker_insert_event_with_tolerance_us(const ticker_data_t *const ticker, ticker_event_t *obj, us_timestamp_t timestamp, uint32_t tolerance, uint32_t id)
 {
     core_util_critical_section_enter();
 
@@ -355,12 +459,21 @@ void ticker_insert_event_us(const ticker_data_t *const ticker, ticker_event_t *o
 
     // initialise our data
     obj->timestamp = timestamp;
+    obj->tolerance = tolerance;
     obj->id = id;
 
     /* Go through the list until we either reach the end, or find
        an element this should come before (which is possibly the
        head). */
     ticker_event_t *prev = NULL, *p = ticker->queue->head;
+#if TICKER_SKIP_LEVELS
+    /* The express lanes get us close quickly */
+    ticker_event_t *preds[TICKER_SKIP_LEVELS];
+    prev = skip_search(ticker->queue, timestamp, true, preds);
+    if (prev != NULL) {
+        p = prev->next;
+    }
+#endif
     while (p != NULL) {
         /* check if we come before p */
         if (timestamp < p->timestamp) {
@@ -382,6 +495,24 @@ void ticker_insert_event_us(const ticker_data_t *const ticker, ticker_event_t *o
         prev->next = obj;
     }
 
+#if TICKER_SKIP_LEVELS
+    obj->level = skip_level(ticker->queue);
+    for (int i = 0; i < obj->level; i++) {
+        ticker_event_t **link = preds[i] ? &preds[i]->skip[i] : &ticker->queue->skip[i];
+        obj->skip[i] = *link;
+        *link = obj;
+    }
+#endif
+
+    if (prev != NULL) {
+        /* the interrupt can't be later than the deadline of the head, so
+           only an event with an earlier deadline can move it */
+        ticker_event_t *head = ticker->queue->head;
+        if (timestamp + tolerance < head->timestamp + head->tolerance) {
+            schedule_interrupt(ticker);
+        }
+    }
+
     core_util_critical_section_exit();
 }
 
@@ -389,17 +520,33 @@ void ticker_remove_event(const ticker_data_t *const ticker, ticker_event_t *obj)
 {
     core_util_critical_section_enter();
 
+#if TICKER_SKIP_LEVELS
+    // find where I would be in the express lanes, then search from there
+    ticker_event_t *preds[TICKER_SKIP_LEVELS];
+    ticker_event_t *p = skip_search(ticker->queue, obj->timestamp, false, preds);
+#else
+    ticker_event_t *p = NULL;
+#endif
+
     // remove this object from the list
     if (ticker->queue->head == obj) {
         // first in the list, so just drop me
         ticker->queue->head = obj->next;
+#if TICKER_SKIP_LEVELS
+        skip_unlink(ticker->queue, obj, preds);
+#endif
         schedule_interrupt(ticker);
     } else {
         // find the object before me, then drop me
-        ticker_event_t *p = ticker->queue->head;
+        if (p == NULL) {
+            p = ticker->queue->head;
+        }
         while (p != NULL) {
             if (p->next == obj) {
                 p->next = obj->next;
+#if TICKER_SKIP_LEVELS
+                skip_unlink(ticker->queue, obj, preds);
+#endif
                 break;
             }
             p = p->next;
@@ -234,4 +234,38 @@ void mbed_mpu_enable_ram_xn(bool enable)
     __ISB();
 }
 
+void mbed_mpu_set_stack_guard(uint32_t addr, uint32_t size)
+{
+    // Flush memory writes before configuring the MPU.
+    __DMB();
+
+    // Use the last region, which takes priority over the ram regions
+    const uint32_t region = ((MPU->TYPE & MPU_TYPE_DREGION_Msk) >> MPU_TYPE_DREGION_Pos) - 1;
+    MBED_ASSERT(region > LAST_RAM_REGION);
+
+    if (size == 0) {
+        ARM_MPU_ClrRegion(region);
+    } else {
+        MBED_ASSERT((size >= 32) && ((size & (size - 1)) == 0) && ((addr & (size - 1)) == 0));
+        ARM_MPU_SetRegion(
+            ARM_MPU_RBAR(
+                region,                     // Region
+                addr),                      // Base
+            ARM_MPU_RASR(
+                1,                          // DisableExec
+                ARM_MPU_AP_PRO,             // AccessPermission - reads are left for stack watermarks
+                1,                          // TypeExtField
+                0,                          // IsShareable
+                1,                          // IsCacheable
+                1,                          // IsBufferable
+                0U,                         // SubRegionDisable
+                30 - __CLZ(size))           // Size
+        );
+    }
+
+    // Ensure changes take effect
+    __DSB();
+    __ISB();
+}
+
 #endif
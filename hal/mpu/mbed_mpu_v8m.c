@@ -208,4 +208,11 @@ void mbed_mpu_enable_ram_xn(bool enable)
     __ISB();
 }
 
+void mbed_mpu_set_stack_guard(uint32_t addr, uint32_t size)
+{
+    // ARMv8-M regions can't overlap the ram regions, so the process stack
+    // limit faults on the stack pointer going into the guard instead
+    __set_PSPLIM(size ? addr + size : 0);
+}
+
 #endif
@@ -21,6 +21,7 @@
 
 #include "device.h"
 #include <stdbool.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -41,6 +42,7 @@ extern "C" {
  *      This RAM includes heap, stack, data and zero init - Verified  by ::mpu_fault_test_data,
  *      ::mpu_fault_test_bss, ::mpu_fault_test_stack and ::mpu_fault_test_heap.
  * * Writing to ROM results in a fault when write never is enabled - Not verified
+ * * Writing to the stack guard results in a fault on ARMv7-M - Verified by ::mpu_stack_guard_test
  *
  * # Undefined behavior
  * * Calling any function other than ::mbed_mpu_init before the initialization of the MPU.
@@ -99,6 +101,19 @@ void mbed_mpu_enable_ram_xn(bool enable);
  */
 void mbed_mpu_free(void);
 
+/**
+ * Set the stack guard
+ *
+ * Writes to the guard cause a fault, so a thread overflowing its stack
+ * is stopped at its first write below the stack. On ARMv8-M the guard is
+ * set with the process stack limit register instead of an MPU region.
+ *
+ * @param addr Start of the guard, aligned on size
+ * @param size Size of the guard, a power of two of at least 32 bytes, or
+ *             0 to remove the guard
+ */
+void mbed_mpu_set_stack_guard(uint32_t addr, uint32_t size);
+
 /**@}*/
 
 #else
@@ -111,6 +126,8 @@ void mbed_mpu_free(void);
 
 #define mbed_mpu_free()
 
+#define mbed_mpu_set_stack_guard(addr, size) (void)addr, (void)size
+
 #endif
 
 #ifdef __cplusplus
@@ -45,6 +45,18 @@ typedef struct port_s port_t;
  */
 PinName port_pin(PortName port, int pin_n);
 
+/** Find the port and the port's pin number of a pin
+ *
+ * The default implementation searches port names 0 to 15 with port_pin(),
+ * targets with other port names override it.
+ *
+ * @param pin        The pin name
+ * @param[out] port  The port the pin belongs to
+ * @param[out] pin_n The pin number within the port
+ * @return 0 on success, -1 if the pin isn't in a port
+ */
+int port_pin_find(PinName pin, PortName *port, int *pin_n);
+
 /** Initilize the port
  *
  * @param obj  The port object to initialize
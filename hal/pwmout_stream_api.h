@@ -0,0 +1,115 @@
+
+/** \addtogroup hal */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_PWMOUT_STREAM_API_H
+#define MBED_PWMOUT_STREAM_API_H
+
+#include "device.h"
+#include "pinmap.h"
+#include <stddef.h>
+
+#if DEVICE_PWMOUT_STREAM
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Pwmout stream hal structure. pwmout_stream_s is declared in the target's hal
+ */
+typedef struct pwmout_stream_s pwmout_stream_t;
+
+/** Handler called from interrupt context when half of the buffer has been output
+ *
+ * @param id      The id passed to pwmout_stream_start()
+ * @param samples The half of the buffer that can be refilled
+ * @param count   Number of samples in it
+ */
+typedef void (*pwmout_stream_handler)(uint32_t id, uint16_t *samples, size_t count);
+
+/**
+ * \defgroup hal_pwmout_stream Pwmout stream hal functions
+ *
+ * PWM duty cycle updates, transferred from memory without CPU involvement.
+ *
+ * # Defined behavior
+ * * Each PWM period takes the next sample as its duty cycle, 0 for always
+ *   low up to 0xFFFF for always high
+ * * The buffer is output circularly, the handler is called for each half
+ *   as soon as its last sample has been transferred
+ * * Output continues from the other half while the handler runs
+ * * pwmout_stream_stop() returns after the last transfer has ended and
+ *   no handler is called after it. The output keeps the last duty cycle.
+ *
+ * # Undefined behavior
+ * * Calling any function other than pwmout_stream_init() on an uninitialized object
+ * * Using a pin that is not in pwmout_pinmap()
+ * * Starting with an odd buffer length
+ * * Starting a stream that is already running
+ *
+ * @{
+ */
+
+/** Initialize the stream
+ *
+ * @param obj The pwmout stream object to initialize
+ * @param pin The pwmout pin name
+ */
+void pwmout_stream_init(pwmout_stream_t *obj, PinName pin);
+
+/** Release the stream
+ *
+ * @param obj The pwmout stream object
+ */
+void pwmout_stream_free(pwmout_stream_t *obj);
+
+/** Set the PWM period, which is also the time each sample is output
+ *
+ * @param obj The pwmout stream object
+ * @param us  The period in microseconds
+ */
+void pwmout_stream_period_us(pwmout_stream_t *obj, int us);
+
+/** Start output from a buffer
+ *
+ * @param obj     The pwmout stream object
+ * @param buffer  The buffer, output circularly
+ * @param length  Number of samples the buffer holds
+ * @param handler Called with each half of the buffer once it has been output
+ * @param id      Passed to the handler
+ */
+void pwmout_stream_start(pwmout_stream_t *obj, uint16_t *buffer, size_t length,
+                         pwmout_stream_handler handler, uint32_t id);
+
+/** Stop output
+ *
+ * @param obj The pwmout stream object
+ */
+void pwmout_stream_stop(pwmout_stream_t *obj);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+#endif
+
+/** @}*/
@@ -183,6 +183,74 @@ qspi_status_t qspi_command_transfer(qspi_t *obj, const qspi_command_t *command,
  */
 qspi_status_t qspi_read(qspi_t *obj, const qspi_command_t *command, void *data, size_t *length);
 
+/** Map the QSPI device into the memory space for reading
+ *
+ * The controller issues the read command for every access to the mapped region,
+ * so the device can be read, or code executed from it, in place.
+ * Any other qspi_* call on the object leaves memory-mapped mode.
+ *
+ * @param obj QSPI object
+ * @param command QSPI read command, the address phase is set by the accesses
+ * @param[out] address Start of the mapped region, where device address 0 is mapped
+ * @return QSPI_STATUS_OK if the device has been mapped
+           QSPI_STATUS_INVALID_PARAMETER if invalid parameter found
+           QSPI_STATUS_ERROR if the target doesn't support memory-mapped mode, or otherwise
+ */
+qspi_status_t qspi_memory_mapped(qspi_t *obj, const qspi_command_t *command, const void **address);
+
+#if DEVICE_QSPI_ASYNCH
+
+/** Handler called from interrupt context when an asynchronous transfer ends
+ *
+ * @param id     The id passed when the transfer was started
+ * @param status QSPI_STATUS_OK if all the data was transferred, QSPI_STATUS_ERROR otherwise
+ */
+typedef void (*qspi_asynch_handler)(uint32_t id, qspi_status_t status);
+
+/** Start receiving a block of data by DMA, returning immediately
+ *
+ * The command only needs to be valid during the call. Only one asynchronous
+ * transfer can be ongoing per peripheral, and no other qspi_* call is made
+ * on it until the handler is called or the transfer is aborted.
+ *
+ * @param obj QSPI object
+ * @param command QSPI command
+ * @param data RX buffer, valid until the handler is called
+ * @param length RX buffer length in bytes
+ * @param handler Called when the transfer ends
+ * @param id Passed to the handler
+ * @return QSPI_STATUS_OK if the transfer has been started
+           QSPI_STATUS_INVALID_PARAMETER if invalid parameter found
+           QSPI_STATUS_ERROR otherwise
+ */
+qspi_status_t qspi_read_asynch(qspi_t *obj, const qspi_command_t *command, void *data, size_t length, qspi_asynch_handler handler, uint32_t id);
+
+/** Start sending a command and block of data by DMA, returning immediately
+ *
+ * Same constraints as qspi_read_asynch().
+ *
+ * @param obj QSPI object
+ * @param command QSPI command
+ * @param data TX buffer, valid until the handler is called
+ * @param length TX buffer length in bytes
+ * @param handler Called when the transfer ends
+ * @param id Passed to the handler
+ * @return QSPI_STATUS_OK if the transfer has been started
+           QSPI_STATUS_INVALID_PARAMETER if invalid parameter found
+           QSPI_STATUS_ERROR otherwise
+ */
+qspi_status_t qspi_write_asynch(qspi_t *obj, const qspi_command_t *command, const void *data, size_t length, qspi_asynch_handler handler, uint32_t id);
+
+/** Abort the ongoing asynchronous transfer
+ *
+ * The handler is not called after this returns.
+ *
+ * @param obj QSPI object
+ */
+void qspi_abort_asynch(qspi_t *obj);
+
+#endif
+
 /** Get the pins that support QSPI SCLK
  *
  * Return a PinMap array of pins that support QSPI SCLK in
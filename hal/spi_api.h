@@ -105,6 +105,19 @@ void spi_format(spi_t *obj, int bits, int mode, int slave);
  */
 void spi_frequency(spi_t *obj, int hz);
 
+/** Set the master format and baud rate in one call
+ *
+ * Used when the peripheral is handed over to another SPI object sharing it.
+ * The default implementation calls spi_format() and spi_frequency(). Targets
+ * can override it to restore register values computed for this object once,
+ * instead of recomputing the configuration on every hand over.
+ * @param[in,out] obj  The SPI object to configure
+ * @param[in]     bits The number of bits per frame
+ * @param[in]     mode The SPI mode (clock polarity, phase, and shift direction)
+ * @param[in]     hz   The baud rate in Hz
+ */
+void spi_configure(spi_t *obj, int bits, int mode, int hz);
+
 /**@}*/
 /**
  * \defgroup SynchSPI Synchronous SPI Hardware Abstraction Layer
@@ -38,12 +38,28 @@ typedef uint32_t timestamp_t;
  */
 typedef uint64_t us_timestamp_t;
 
+/**
+ * Number of express lanes of the skip list ordering ticker events.
+ * Each lane skips roughly four times as many events as the one below it,
+ * which keeps insertion and removal logarithmic up to about
+ * 4^(TICKER_SKIP_LEVELS + 1) events. Each lane costs a pointer per event,
+ * 0 keeps a plain sorted list.
+ */
+#ifndef TICKER_SKIP_LEVELS
+#define TICKER_SKIP_LEVELS 3
+#endif
+
 /** Ticker's event structure
  */
 typedef struct ticker_event_s {
     us_timestamp_t         timestamp; /**< Event's timestamp */
     uint32_t               id;        /**< TimerEvent object */
+    uint32_t               tolerance; /**< Time in us the event may be delayed by to share an interrupt with other events */
     struct ticker_event_s *next;      /**< Next event in the queue */
+#if TICKER_SKIP_LEVELS
+    struct ticker_event_s *skip[TICKER_SKIP_LEVELS]; /**< Next event in each express lane */
+    uint8_t                level;     /**< Number of express lanes the event is in */
+#endif
 } ticker_event_t;
 
 typedef void (*ticker_event_handler)(uint32_t id);
@@ -85,6 +101,10 @@ typedef struct {
     bool dispatching;                   /**< The function ticker_irq_handler is dispatching */
     bool suspended;                     /**< Indicate if the instance is suspended */
     uint8_t frequency_shifts;           /**< If frequency is a value of 2^n, this is n, otherwise 0 */
+#if TICKER_SKIP_LEVELS
+    ticker_event_t *skip[TICKER_SKIP_LEVELS]; /**< First event of each express lane */
+    uint32_t skip_seed;                 /**< State used to pick the lanes of new events */
+#endif
 } ticker_event_queue_t;
 
 /** Ticker's data structure
@@ -158,6 +178,25 @@ void ticker_insert_event(const ticker_data_t *const ticker, ticker_event_t *obj,
  */
 void ticker_insert_event_us(const ticker_data_t *const ticker, ticker_event_t *obj, us_timestamp_t timestamp, uint32_t id);
 
+/** Insert an event with a tolerance to the queue
+ *
+ * The event will be executed between timestamp and timestamp + tolerance.
+ * The ticker interrupt is scheduled at the latest time that satisfies every
+ * queued event, so events with overlapping windows share a single interrupt
+ * and the CPU wakes up less often.
+ *
+ * @note If an event is inserted with a timestamp less than the current
+ * timestamp then the event will be scheduled immediately resulting in
+ * an instant call to event handler.
+ *
+ * @param ticker    The ticker object.
+ * @param obj       The event object to be inserted to the queue
+ * @param timestamp The event's timestamp
+ * @param tolerance The time in us the event may be delayed by
+ * @param id        The event object
+ */
+void ticker_insert_event_with_tolerance_us(const ticker_data_t *const ticker, ticker_event_t *obj, us_timestamp_t timestamp, uint32_t tolerance, uint32_t id);
+
 /** Read the current (relative) ticker's timestamp
  *
  * @warning Return a relative timestamp because the counter wrap every 4294
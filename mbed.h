@@ -59,9 +59,13 @@
 #include "drivers/PortIn.h"
 #include "drivers/PortInOut.h"
 #include "drivers/PortOut.h"
+#include "drivers/PortBusOut.h"
 #include "drivers/AnalogIn.h"
+#include "drivers/AnalogInStream.h"
 #include "drivers/AnalogOut.h"
+#include "drivers/AnalogOutStream.h"
 #include "drivers/PwmOut.h"
+#include "drivers/PwmOutStream.h"
 #include "drivers/Serial.h"
 #include "drivers/SPI.h"
 #include "drivers/SPISlave.h"
@@ -84,6 +88,7 @@
 #include "drivers/LowPowerTimer.h"
 #include "platform/LocalFileSystem.h"
 #include "drivers/InterruptIn.h"
+#include "drivers/EdgeCapture.h"
 #include "platform/mbed_wait_api.h"
 #include "hal/sleep_api.h"
 #include "platform/mbed_power_mgmt.h"
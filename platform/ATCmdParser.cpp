@@ -25,6 +25,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
 
 #ifdef LF
 #undef LF
@@ -59,13 +60,19 @@ int ATCmdParser::putc(char c)
 
 int ATCmdParser::getc()
 {
+    unsigned char ch;
+
+    // Skip the poll when data is already waiting
+    if (_fh->readable()) {
+        return _fh->read(&ch, 1) == 1 ? ch : -1;
+    }
+
     pollfh fhs;
     fhs.fh = _fh;
     fhs.events = POLLIN;
 
     int count = poll(&fhs, 1, _timeout);
     if (count > 0 && (fhs.revents & POLLIN)) {
-        unsigned char ch;
         return _fh->read(&ch, 1) == 1 ? ch : -1;
     } else {
         return -1;
@@ -82,13 +89,27 @@ void ATCmdParser::flush()
 
 
 // read/write handling with timeouts
+// Data is moved in as large chunks as the file handle takes, polling
+// only when it is not ready
 int ATCmdParser::write(const char *data, int size)
 {
     int i = 0;
-    for (; i < size; i++) {
-        if (putc(data[i]) < 0) {
+    while (i < size) {
+        if (!_fh->writable()) {
+            pollfh fhs;
+            fhs.fh = _fh;
+            fhs.events = POLLOUT;
+            int count = poll(&fhs, 1, _timeout);
+            if (count <= 0 || !(fhs.revents & POLLOUT)) {
+                return -1;
+            }
+        }
+
+        ssize_t written = _fh->write(data + i, size - i);
+        if (written <= 0) {
             return -1;
         }
+        i += written;
     }
     return i;
 }
@@ -96,12 +117,22 @@ int ATCmdParser::write(const char *data, int size)
 int ATCmdParser::read(char *data, int size)
 {
     int i = 0;
-    for (; i < size; i++) {
-        int c = getc();
-        if (c < 0) {
+    while (i < size) {
+        if (!_fh->readable()) {
+            pollfh fhs;
+            fhs.fh = _fh;
+            fhs.events = POLLIN;
+            int count = poll(&fhs, 1, _timeout);
+            if (count <= 0 || !(fhs.revents & POLLIN)) {
+                return -1;
+            }
+        }
+
+        ssize_t received = _fh->read(data + i, size - i);
+        if (received <= 0) {
             return -1;
         }
-        data[i] = c;
+        i += received;
     }
     return i;
 }
@@ -241,6 +272,14 @@ restart:
             }
         }
 
+        // Literal text the line must start with, up to the first conversion
+        // or whitespace, which scanf matches loosely. Until it has been
+        // received, scanning can't match and is skipped.
+        int literal = 0;
+        while (literal < offset && _buffer[literal] != '%' && !isspace((unsigned char) _buffer[literal])) {
+            literal++;
+        }
+
         // Scanf has very poor support for catching errors
         // fortunately, we can abuse the %n specifier to determine
         // if the entire string was matched.
@@ -257,6 +296,7 @@ restart:
         // We keep trying the match until we succeed or some other error
         // derails us.
         int j = 0;
+        bool literal_failed = false;
 
         while (true) {
             // If just peeking for OOBs, and at start of line, check
@@ -286,8 +326,13 @@ restart:
             _buffer[offset + j++] = c;
             _buffer[offset + j] = 0;
 
-            // Check for oob data
-            for (struct oob *oob = _oobs; oob; oob = oob->next) {
+            if (j <= literal && c != _buffer[j - 1]) {
+                // Can't match this line anymore, wait for the next one
+                literal_failed = true;
+            }
+
+            // Check for oob data, none once past the longest prefix
+            for (struct oob *oob = (unsigned)j <= _oob_max_len ? _oobs : NULL; oob; oob = oob->next) {
                 if ((unsigned)j == oob->len && memcmp(
                             oob->prefix, _buffer + offset, oob->len) == 0) {
                     debug_if(_dbg_on, "AT! %s\n", oob->prefix);
@@ -310,7 +355,7 @@ restart:
                 // Don't attempt scanning until we get delimiter if they included it in format
                 // This allows recv("Foo: %s\n") to work, and not match with just the first character of a string
                 // (scanf does not itself match whitespace in its format string, so \n is not significant to it)
-            } else if (response) {
+            } else if (response && j >= literal && !literal_failed) {
                 sscanf(_buffer + offset, _buffer, &count);
             }
 
@@ -334,6 +379,7 @@ restart:
             if (c == '\n' || j + 1 >= _buffer_size - offset) {
                 debug_if(_dbg_on, "AT< %s", _buffer + offset);
                 j = 0;
+                literal_failed = false;
             }
         }
     }
@@ -387,6 +433,9 @@ void ATCmdParser::oob(const char *prefix, Callback<void()> cb)
     oob->cb = cb;
     oob->next = _oobs;
     _oobs = oob;
+    if (oob->len > _oob_max_len) {
+        _oob_max_len = oob->len;
+    }
 }
 
 void ATCmdParser::abort()
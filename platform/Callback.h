@@ -31,13 +31,6 @@ namespace mbed {
  * @{
  */
 
-/** Callback class based on template specialization
- *
- * @note Synchronization level: Not protected
- */
-template <typename F>
-class Callback;
-
 // Internal sfinae declarations
 //
 // These are used to eliminate overloads based on type attributes
@@ -62,20 +55,51 @@ template <typename M, M>
 struct is_type {
     static const bool value = true;
 };
+
+// Default storage of a Callback, a member function pointer and an object
+struct callback_storage {
+    struct _class;
+    union {
+        void (*_staticfunc)();
+        void (*_boundfunc)(_class *);
+        void (_class::*_methodfunc)();
+    } _func;
+    void *_obj;
+};
 }
 
+/** Callback class based on template specialization
+ *
+ * The function, object or function object attached is stored inline, in
+ * Size bytes. The default fits a member function and its object; a larger
+ * Size lets function objects with more state be attached without a heap
+ * allocated wrapper, for example:
+ *
+ * @code
+ * Callback<void(), 4 * sizeof(void *)> cb = [this, a, b]() { handle(a, b); };
+ * @endcode
+ *
+ * Callbacks of different sizes are different types and don't convert to
+ * each other.
+ *
+ * @note Synchronization level: Not protected
+ */
+template <typename F, size_t Size = sizeof(detail::callback_storage)>
+class Callback;
+
+// Used inside Callback, where Size is the inline storage size
 #define MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, M)                            \
     typename detail::enable_if<                                             \
             detail::is_type<M, &F::operator()>::value &&                    \
-            sizeof(F) <= sizeof(uintptr_t)                                  \
+            sizeof(F) <= Size                                               \
         >::type = detail::nil()
 
 /** Callback class based on template specialization
  *
  * @note Synchronization level: Not protected
  */
-template <typename R>
-class Callback<R()> {
+template <typename R, size_t Size>
+class Callback<R(), Size> {
 public:
     /** Create a Callback with a static function
      *  @param func     Static function to attach
@@ -85,20 +109,22 @@ public:
         if (!func) {
             memset(this, 0, sizeof(Callback));
         } else {
-            generate(func);
+            generate_function(func);
         }
     }
 
     /** Attach a Callback
      *  @param func     The Callback to attach
      */
-    Callback(const Callback<R()> &func)
+    Callback(const Callback &func)
     {
-        memset(this, 0, sizeof(Callback));
-        if (func._ops) {
+        if (func._ops && func._ops->move) {
+            memset(this, 0, sizeof(Callback));
             func._ops->move(this, &func);
+            _ops = func._ops;
+        } else {
+            memcpy(this, &func, sizeof(Callback));
         }
-        _ops = func._ops;
     }
 
     /** Create a Callback with a member function
@@ -108,7 +134,7 @@ public:
     template<typename T, typename U>
     Callback(U *obj, R(T::*method)())
     {
-        generate(method_context<T, R(T::*)()>(obj, method));
+        generate_trivial(method_context<T, R(T::*)()>(obj, method));
     }
 
     /** Create a Callback with a member function
@@ -118,7 +144,7 @@ public:
     template<typename T, typename U>
     Callback(const U *obj, R(T::*method)() const)
     {
-        generate(method_context<const T, R(T::*)() const>(obj, method));
+        generate_trivial(method_context<const T, R(T::*)() const>(obj, method));
     }
 
     /** Create a Callback with a member function
@@ -128,7 +154,7 @@ public:
     template<typename T, typename U>
     Callback(volatile U *obj, R(T::*method)() volatile)
     {
-        generate(method_context<volatile T, R(T::*)() volatile>(obj, method));
+        generate_trivial(method_context<volatile T, R(T::*)() volatile>(obj, method));
     }
 
     /** Create a Callback with a member function
@@ -138,7 +164,7 @@ public:
     template<typename T, typename U>
     Callback(const volatile U *obj, R(T::*method)() const volatile)
     {
-        generate(method_context<const volatile T, R(T::*)() const volatile>(obj, method));
+        generate_trivial(method_context<const volatile T, R(T::*)() const volatile>(obj, method));
     }
 
     /** Create a Callback with a static function and bound pointer
@@ -148,7 +174,7 @@ public:
     template<typename T, typename U>
     Callback(R(*func)(T *), U *arg)
     {
-        generate(function_context<R(*)(T *), T>(func, arg));
+        generate_trivial(function_context<R(*)(T *), T>(func, arg));
     }
 
     /** Create a Callback with a static function and bound pointer
@@ -158,7 +184,7 @@ public:
     template<typename T, typename U>
     Callback(R(*func)(const T *), const U *arg)
     {
-        generate(function_context<R(*)(const T *), const T>(func, arg));
+        generate_trivial(function_context<R(*)(const T *), const T>(func, arg));
     }
 
     /** Create a Callback with a static function and bound pointer
@@ -168,7 +194,7 @@ public:
     template<typename T, typename U>
     Callback(R(*func)(volatile T *), volatile U *arg)
     {
-        generate(function_context<R(*)(volatile T *), volatile T>(func, arg));
+        generate_trivial(function_context<R(*)(volatile T *), volatile T>(func, arg));
     }
 
     /** Create a Callback with a static function and bound pointer
@@ -178,12 +204,12 @@ public:
     template<typename T, typename U>
     Callback(R(*func)(const volatile T *), const volatile U *arg)
     {
-        generate(function_context<R(*)(const volatile T *), const volatile T>(func, arg));
+        generate_trivial(function_context<R(*)(const volatile T *), const volatile T>(func, arg));
     }
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      */
     template <typename F>
     Callback(F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)()))
@@ -193,7 +219,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      */
     template <typename F>
     Callback(const F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)() const))
@@ -203,7 +229,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      */
     template <typename F>
     Callback(volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)() volatile))
@@ -213,7 +239,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      */
     template <typename F>
     Callback(const volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)() const volatile))
@@ -281,7 +307,7 @@ public:
      */
     ~Callback()
     {
-        if (_ops) {
+        if (_ops && _ops->dtor) {
             _ops->dtor(this);
         }
     }
@@ -306,7 +332,7 @@ public:
      */
     MBED_DEPRECATED_SINCE("mbed-os-5.4",
                           "Replaced by simple assignment 'Callback cb = func")
-    void attach(const Callback<R()> &func)
+    void attach(const Callback &func)
     {
         this->~Callback();
         new (this) Callback(func);
@@ -434,7 +460,7 @@ public:
 
     /** Attach a function object
      *  @param f     Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -449,7 +475,7 @@ public:
 
     /** Attach a function object
      *  @param f     Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -464,7 +490,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -479,7 +505,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -569,6 +595,9 @@ public:
     R call() const
     {
         MBED_ASSERT(_ops);
+        if (!_ops->call) {
+            return (*(R(* const *)())this)();
+        }
         return _ops->call(this);
     }
 
@@ -611,16 +640,16 @@ public:
     }
 
 private:
-    // Stored as pointer to function and pointer to optional object
-    // Function pointer is stored as union of possible function types
-    // to guarantee proper size and alignment
+    // Stored as a function object of up to Size bytes, by default a pointer
+    // to function and pointer to optional object. The union of possible
+    // function types guarantees proper size and alignment
     struct _class;
     union {
         void (*_staticfunc)();
         void (*_boundfunc)(_class *);
         void (_class::*_methodfunc)();
+        char _data[Size];
     } _func;
-    void *_obj;
 
     // Dynamically dispatched operations
     const struct ops {
@@ -646,6 +675,34 @@ private:
         _ops = &ops;
     }
 
+    // Generate operations for trivially copyable function object, which is
+    // copied with memcpy and needs no destructor
+    template <typename F>
+    void generate_trivial(const F &f)
+    {
+        static const ops ops = {
+            &Callback::function_call<F>,
+            0,
+            0,
+        };
+
+        MBED_STATIC_ASSERT(sizeof(Callback) - sizeof(_ops) >= sizeof(F),
+                           "Type F must not exceed the size of the Callback class");
+        memset(this, 0, sizeof(Callback));
+        new (this) F(f);
+        _ops = &ops;
+    }
+
+    // Static functions are called directly, without operations
+    void generate_function(R(*func)())
+    {
+        static const ops ops = { 0, 0, 0 };
+
+        memset(this, 0, sizeof(Callback));
+        new (this) (R(*)())(func);
+        _ops = &ops;
+    }
+
     // Function attributes
     template <typename F>
     static R function_call(const void *p)
@@ -699,8 +756,8 @@ private:
  *
  * @note Synchronization level: Not protected
  */
-template <typename R, typename A0>
-class Callback<R(A0)> {
+template <typename R, typename A0, size_t Size>
+class Callback<R(A0), Size> {
 public:
     /** Create a Callback with a static function
      *  @param func     Static function to attach
@@ -710,20 +767,22 @@ public:
         if (!func) {
             memset(this, 0, sizeof(Callback));
         } else {
-            generate(func);
+            generate_function(func);
         }
     }
 
     /** Attach a Callback
      *  @param func     The Callback to attach
      */
-    Callback(const Callback<R(A0)> &func)
+    Callback(const Callback &func)
     {
-        memset(this, 0, sizeof(Callback));
-        if (func._ops) {
+        if (func._ops && func._ops->move) {
+            memset(this, 0, sizeof(Callback));
             func._ops->move(this, &func);
+            _ops = func._ops;
+        } else {
+            memcpy(this, &func, sizeof(Callback));
         }
-        _ops = func._ops;
     }
 
     /** Create a Callback with a member function
@@ -733,7 +792,7 @@ public:
     template<typename T, typename U>
     Callback(U *obj, R(T::*method)(A0))
     {
-        generate(method_context<T, R(T::*)(A0)>(obj, method));
+        generate_trivial(method_context<T, R(T::*)(A0)>(obj, method));
     }
 
     /** Create a Callback with a member function
@@ -743,7 +802,7 @@ public:
     template<typename T, typename U>
     Callback(const U *obj, R(T::*method)(A0) const)
     {
-        generate(method_context<const T, R(T::*)(A0) const>(obj, method));
+        generate_trivial(method_context<const T, R(T::*)(A0) const>(obj, method));
     }
 
     /** Create a Callback with a member function
@@ -753,7 +812,7 @@ public:
     template<typename T, typename U>
     Callback(volatile U *obj, R(T::*method)(A0) volatile)
     {
-        generate(method_context<volatile T, R(T::*)(A0) volatile>(obj, method));
+        generate_trivial(method_context<volatile T, R(T::*)(A0) volatile>(obj, method));
     }
 
     /** Create a Callback with a member function
@@ -763,7 +822,7 @@ public:
     template<typename T, typename U>
     Callback(const volatile U *obj, R(T::*method)(A0) const volatile)
     {
-        generate(method_context<const volatile T, R(T::*)(A0) const volatile>(obj, method));
+        generate_trivial(method_context<const volatile T, R(T::*)(A0) const volatile>(obj, method));
     }
 
     /** Create a Callback with a static function and bound pointer
@@ -773,7 +832,7 @@ public:
     template<typename T, typename U>
     Callback(R(*func)(T *, A0), U *arg)
     {
-        generate(function_context<R(*)(T *, A0), T>(func, arg));
+        generate_trivial(function_context<R(*)(T *, A0), T>(func, arg));
     }
 
     /** Create a Callback with a static function and bound pointer
@@ -783,7 +842,7 @@ public:
     template<typename T, typename U>
     Callback(R(*func)(const T *, A0), const U *arg)
     {
-        generate(function_context<R(*)(const T *, A0), const T>(func, arg));
+        generate_trivial(function_context<R(*)(const T *, A0), const T>(func, arg));
     }
 
     /** Create a Callback with a static function and bound pointer
@@ -793,7 +852,7 @@ public:
     template<typename T, typename U>
     Callback(R(*func)(volatile T *, A0), volatile U *arg)
     {
-        generate(function_context<R(*)(volatile T *, A0), volatile T>(func, arg));
+        generate_trivial(function_context<R(*)(volatile T *, A0), volatile T>(func, arg));
     }
 
     /** Create a Callback with a static function and bound pointer
@@ -803,12 +862,12 @@ public:
     template<typename T, typename U>
     Callback(R(*func)(const volatile T *, A0), const volatile U *arg)
     {
-        generate(function_context<R(*)(const volatile T *, A0), const volatile T>(func, arg));
+        generate_trivial(function_context<R(*)(const volatile T *, A0), const volatile T>(func, arg));
     }
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      */
     template <typename F>
     Callback(F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0)))
@@ -818,7 +877,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      */
     template <typename F>
     Callback(const F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0) const))
@@ -828,7 +887,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      */
     template <typename F>
     Callback(volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0) volatile))
@@ -838,7 +897,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      */
     template <typename F>
     Callback(const volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0) const volatile))
@@ -906,7 +965,7 @@ public:
      */
     ~Callback()
     {
-        if (_ops) {
+        if (_ops && _ops->dtor) {
             _ops->dtor(this);
         }
     }
@@ -931,7 +990,7 @@ public:
      */
     MBED_DEPRECATED_SINCE("mbed-os-5.4",
                           "Replaced by simple assignment 'Callback cb = func")
-    void attach(const Callback<R(A0)> &func)
+    void attach(const Callback &func)
     {
         this->~Callback();
         new (this) Callback(func);
@@ -1059,7 +1118,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -1074,7 +1133,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -1089,7 +1148,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -1104,7 +1163,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -1194,6 +1253,9 @@ public:
     R call(A0 a0) const
     {
         MBED_ASSERT(_ops);
+        if (!_ops->call) {
+            return (*(R(* const *)(A0))this)(a0);
+        }
         return _ops->call(this, a0);
     }
 
@@ -1237,16 +1299,16 @@ public:
     }
 
 private:
-    // Stored as pointer to function and pointer to optional object
-    // Function pointer is stored as union of possible function types
-    // to guarantee proper size and alignment
+    // Stored as a function object of up to Size bytes, by default a pointer
+    // to function and pointer to optional object. The union of possible
+    // function types guarantees proper size and alignment
     struct _class;
     union {
         void (*_staticfunc)(A0);
         void (*_boundfunc)(_class *, A0);
         void (_class::*_methodfunc)(A0);
+        char _data[Size];
     } _func;
-    void *_obj;
 
     // Dynamically dispatched operations
     const struct ops {
@@ -1272,6 +1334,34 @@ private:
         _ops = &ops;
     }
 
+    // Generate operations for trivially copyable function object, which is
+    // copied with memcpy and needs no destructor
+    template <typename F>
+    void generate_trivial(const F &f)
+    {
+        static const ops ops = {
+            &Callback::function_call<F>,
+            0,
+            0,
+        };
+
+        MBED_STATIC_ASSERT(sizeof(Callback) - sizeof(_ops) >= sizeof(F),
+                           "Type F must not exceed the size of the Callback class");
+        memset(this, 0, sizeof(Callback));
+        new (this) F(f);
+        _ops = &ops;
+    }
+
+    // Static functions are called directly, without operations
+    void generate_function(R(*func)(A0))
+    {
+        static const ops ops = { 0, 0, 0 };
+
+        memset(this, 0, sizeof(Callback));
+        new (this) (R(*)(A0))(func);
+        _ops = &ops;
+    }
+
     // Function attributes
     template <typename F>
     static R function_call(const void *p, A0 a0)
@@ -1325,8 +1415,8 @@ private:
  *
  * @note Synchronization level: Not protected
  */
-template <typename R, typename A0, typename A1>
-class Callback<R(A0, A1)> {
+template <typename R, typename A0, typename A1, size_t Size>
+class Callback<R(A0, A1), Size> {
 public:
     /** Create a Callback with a static function
      *  @param func     Static function to attach
@@ -1336,20 +1426,22 @@ public:
         if (!func) {
             memset(this, 0, sizeof(Callback));
         } else {
-            generate(func);
+            generate_function(func);
         }
     }
 
     /** Attach a Callback
      *  @param func     The Callback to attach
      */
-    Callback(const Callback<R(A0, A1)> &func)
+    Callback(const Callback &func)
     {
-        memset(this, 0, sizeof(Callback));
-        if (func._ops) {
+        if (func._ops && func._ops->move) {
+            memset(this, 0, sizeof(Callback));
             func._ops->move(this, &func);
+            _ops = func._ops;
+        } else {
+            memcpy(this, &func, sizeof(Callback));
         }
-        _ops = func._ops;
     }
 
     /** Create a Callback with a member function
@@ -1359,7 +1451,7 @@ public:
     template<typename T, typename U>
     Callback(U *obj, R(T::*method)(A0, A1))
     {
-        generate(method_context<T, R(T::*)(A0, A1)>(obj, method));
+        generate_trivial(method_context<T, R(T::*)(A0, A1)>(obj, method));
     }
 
     /** Create a Callback with a member function
@@ -1369,7 +1461,7 @@ public:
     template<typename T, typename U>
     Callback(const U *obj, R(T::*method)(A0, A1) const)
     {
-        generate(method_context<const T, R(T::*)(A0, A1) const>(obj, method));
+        generate_trivial(method_context<const T, R(T::*)(A0, A1) const>(obj, method));
     }
 
     /** Create a Callback with a member function
@@ -1379,7 +1471,7 @@ public:
     template<typename T, typename U>
     Callback(volatile U *obj, R(T::*method)(A0, A1) volatile)
     {
-        generate(method_context<volatile T, R(T::*)(A0, A1) volatile>(obj, method));
+        generate_trivial(method_context<volatile T, R(T::*)(A0, A1) volatile>(obj, method));
     }
 
     /** Create a Callback with a member function
@@ -1389,7 +1481,7 @@ public:
     template<typename T, typename U>
     Callback(const volatile U *obj, R(T::*method)(A0, A1) const volatile)
     {
-        generate(method_context<const volatile T, R(T::*)(A0, A1) const volatile>(obj, method));
+        generate_trivial(method_context<const volatile T, R(T::*)(A0, A1) const volatile>(obj, method));
     }
 
     /** Create a Callback with a static function and bound pointer
@@ -1399,7 +1491,7 @@ public:
     template<typename T, typename U>
     Callback(R(*func)(T *, A0, A1), U *arg)
     {
-        generate(function_context<R(*)(T *, A0, A1), T>(func, arg));
+        generate_trivial(function_context<R(*)(T *, A0, A1), T>(func, arg));
     }
 
     /** Create a Callback with a static function and bound pointer
@@ -1409,7 +1501,7 @@ public:
     template<typename T, typename U>
     Callback(R(*func)(const T *, A0, A1), const U *arg)
     {
-        generate(function_context<R(*)(const T *, A0, A1), const T>(func, arg));
+        generate_trivial(function_context<R(*)(const T *, A0, A1), const T>(func, arg));
     }
 
     /** Create a Callback with a static function and bound pointer
@@ -1419,7 +1511,7 @@ public:
     template<typename T, typename U>
     Callback(R(*func)(volatile T *, A0, A1), volatile U *arg)
     {
-        generate(function_context<R(*)(volatile T *, A0, A1), volatile T>(func, arg));
+        generate_trivial(function_context<R(*)(volatile T *, A0, A1), volatile T>(func, arg));
     }
 
     /** Create a Callback with a static function and bound pointer
@@ -1429,12 +1521,12 @@ public:
     template<typename T, typename U>
     Callback(R(*func)(const volatile T *, A0, A1), const volatile U *arg)
     {
-        generate(function_context<R(*)(const volatile T *, A0, A1), const volatile T>(func, arg));
+        generate_trivial(function_context<R(*)(const volatile T *, A0, A1), const volatile T>(func, arg));
     }
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      */
     template <typename F>
     Callback(F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0, A1)))
@@ -1444,7 +1536,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      */
     template <typename F>
     Callback(const F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0, A1) const))
@@ -1454,7 +1546,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      */
     template <typename F>
     Callback(volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0, A1) volatile))
@@ -1464,7 +1556,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      */
     template <typename F>
     Callback(const volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0, A1) const volatile))
@@ -1532,7 +1624,7 @@ public:
      */
     ~Callback()
     {
-        if (_ops) {
+        if (_ops && _ops->dtor) {
             _ops->dtor(this);
         }
     }
@@ -1557,7 +1649,7 @@ public:
      */
     MBED_DEPRECATED_SINCE("mbed-os-5.4",
                           "Replaced by simple assignment 'Callback cb = func")
-    void attach(const Callback<R(A0, A1)> &func)
+    void attach(const Callback &func)
     {
         this->~Callback();
         new (this) Callback(func);
@@ -1685,7 +1777,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -1700,7 +1792,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -1715,7 +1807,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -1730,7 +1822,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -1820,6 +1912,9 @@ public:
     R call(A0 a0, A1 a1) const
     {
         MBED_ASSERT(_ops);
+        if (!_ops->call) {
+            return (*(R(* const *)(A0, A1))this)(a0, a1);
+        }
         return _ops->call(this, a0, a1);
     }
 
@@ -1864,16 +1959,16 @@ public:
     }
 
 private:
-    // Stored as pointer to function and pointer to optional object
-    // Function pointer is stored as union of possible function types
-    // to guarantee proper size and alignment
+    // Stored as a function object of up to Size bytes, by default a pointer
+    // to function and pointer to optional object. The union of possible
+    // function types guarantees proper size and alignment
     struct _class;
     union {
         void (*_staticfunc)(A0, A1);
         void (*_boundfunc)(_class *, A0, A1);
         void (_class::*_methodfunc)(A0, A1);
+        char _data[Size];
     } _func;
-    void *_obj;
 
     // Dynamically dispatched operations
     const struct ops {
@@ -1899,6 +1994,34 @@ private:
         _ops = &ops;
     }
 
+    // Generate operations for trivially copyable function object, which is
+    // copied with memcpy and needs no destructor
+    template <typename F>
+    void generate_trivial(const F &f)
+    {
+        static const ops ops = {
+            &Callback::function_call<F>,
+            0,
+            0,
+        };
+
+        MBED_STATIC_ASSERT(sizeof(Callback) - sizeof(_ops) >= sizeof(F),
+                           "Type F must not exceed the size of the Callback class");
+        memset(this, 0, sizeof(Callback));
+        new (this) F(f);
+        _ops = &ops;
+    }
+
+    // Static functions are called directly, without operations
+    void generate_function(R(*func)(A0, A1))
+    {
+        static const ops ops = { 0, 0, 0 };
+
+        memset(this, 0, sizeof(Callback));
+        new (this) (R(*)(A0, A1))(func);
+        _ops = &ops;
+    }
+
     // Function attributes
     template <typename F>
     static R function_call(const void *p, A0 a0, A1 a1)
@@ -1952,8 +2075,8 @@ private:
  *
  * @note Synchronization level: Not protected
  */
-template <typename R, typename A0, typename A1, typename A2>
-class Callback<R(A0, A1, A2)> {
+template <typename R, typename A0, typename A1, typename A2, size_t Size>
+class Callback<R(A0, A1, A2), Size> {
 public:
     /** Create a Callback with a static function
      *  @param func     Static function to attach
@@ -1963,20 +2086,22 @@ public:
         if (!func) {
             memset(this, 0, sizeof(Callback));
         } else {
-            generate(func);
+            generate_function(func);
         }
     }
 
     /** Attach a Callback
      *  @param func     The Callback to attach
      */
-    Callback(const Callback<R(A0, A1, A2)> &func)
+    Callback(const Callback &func)
     {
-        memset(this, 0, sizeof(Callback));
-        if (func._ops) {
+        if (func._ops && func._ops->move) {
+            memset(this, 0, sizeof(Callback));
             func._ops->move(this, &func);
+            _ops = func._ops;
+        } else {
+            memcpy(this, &func, sizeof(Callback));
         }
-        _ops = func._ops;
     }
 
     /** Create a Callback with a member function
@@ -1986,7 +2111,7 @@ public:
     template<typename T, typename U>
     Callback(U *obj, R(T::*method)(A0, A1, A2))
     {
-        generate(method_context<T, R(T::*)(A0, A1, A2)>(obj, method));
+        generate_trivial(method_context<T, R(T::*)(A0, A1, A2)>(obj, method));
     }
 
     /** Create a Callback with a member function
@@ -1996,7 +2121,7 @@ public:
     template<typename T, typename U>
     Callback(const U *obj, R(T::*method)(A0, A1, A2) const)
     {
-        generate(method_context<const T, R(T::*)(A0, A1, A2) const>(obj, method));
+        generate_trivial(method_context<const T, R(T::*)(A0, A1, A2) const>(obj, method));
     }
 
     /** Create a Callback with a member function
@@ -2006,7 +2131,7 @@ public:
     template<typename T, typename U>
     Callback(volatile U *obj, R(T::*method)(A0, A1, A2) volatile)
     {
-        generate(method_context<volatile T, R(T::*)(A0, A1, A2) volatile>(obj, method));
+        generate_trivial(method_context<volatile T, R(T::*)(A0, A1, A2) volatile>(obj, method));
     }
 
     /** Create a Callback with a member function
@@ -2016,7 +2141,7 @@ public:
     template<typename T, typename U>
     Callback(const volatile U *obj, R(T::*method)(A0, A1, A2) const volatile)
     {
-        generate(method_context<const volatile T, R(T::*)(A0, A1, A2) const volatile>(obj, method));
+        generate_trivial(method_context<const volatile T, R(T::*)(A0, A1, A2) const volatile>(obj, method));
     }
 
     /** Create a Callback with a static function and bound pointer
@@ -2026,7 +2151,7 @@ public:
     template<typename T, typename U>
     Callback(R(*func)(T *, A0, A1, A2), U *arg)
     {
-        generate(function_context<R(*)(T *, A0, A1, A2), T>(func, arg));
+        generate_trivial(function_context<R(*)(T *, A0, A1, A2), T>(func, arg));
     }
 
     /** Create a Callback with a static function and bound pointer
@@ -2036,7 +2161,7 @@ public:
     template<typename T, typename U>
     Callback(R(*func)(const T *, A0, A1, A2), const U *arg)
     {
-        generate(function_context<R(*)(const T *, A0, A1, A2), const T>(func, arg));
+        generate_trivial(function_context<R(*)(const T *, A0, A1, A2), const T>(func, arg));
     }
 
     /** Create a Callback with a static function and bound pointer
@@ -2046,7 +2171,7 @@ public:
     template<typename T, typename U>
     Callback(R(*func)(volatile T *, A0, A1, A2), volatile U *arg)
     {
-        generate(function_context<R(*)(volatile T *, A0, A1, A2), volatile T>(func, arg));
+        generate_trivial(function_context<R(*)(volatile T *, A0, A1, A2), volatile T>(func, arg));
     }
 
     /** Create a Callback with a static function and bound pointer
@@ -2056,12 +2181,12 @@ public:
     template<typename T, typename U>
     Callback(R(*func)(const volatile T *, A0, A1, A2), const volatile U *arg)
     {
-        generate(function_context<R(*)(const volatile T *, A0, A1, A2), const volatile T>(func, arg));
+        generate_trivial(function_context<R(*)(const volatile T *, A0, A1, A2), const volatile T>(func, arg));
     }
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      */
     template <typename F>
     Callback(F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0, A1, A2)))
@@ -2071,7 +2196,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      */
     template <typename F>
     Callback(const F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0, A1, A2) const))
@@ -2081,7 +2206,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      */
     template <typename F>
     Callback(volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0, A1, A2) volatile))
@@ -2091,7 +2216,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      */
     template <typename F>
     Callback(const volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0, A1, A2) const volatile))
@@ -2159,7 +2284,7 @@ public:
      */
     ~Callback()
     {
-        if (_ops) {
+        if (_ops && _ops->dtor) {
             _ops->dtor(this);
         }
     }
@@ -2184,7 +2309,7 @@ public:
      */
     MBED_DEPRECATED_SINCE("mbed-os-5.4",
                           "Replaced by simple assignment 'Callback cb = func")
-    void attach(const Callback<R(A0, A1, A2)> &func)
+    void attach(const Callback &func)
     {
         this->~Callback();
         new (this) Callback(func);
@@ -2312,7 +2437,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -2327,7 +2452,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -2342,7 +2467,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -2357,7 +2482,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -2447,6 +2572,9 @@ public:
     R call(A0 a0, A1 a1, A2 a2) const
     {
         MBED_ASSERT(_ops);
+        if (!_ops->call) {
+            return (*(R(* const *)(A0, A1, A2))this)(a0, a1, a2);
+        }
         return _ops->call(this, a0, a1, a2);
     }
 
@@ -2492,16 +2620,16 @@ public:
     }
 
 private:
-    // Stored as pointer to function and pointer to optional object
-    // Function pointer is stored as union of possible function types
-    // to guarantee proper size and alignment
+    // Stored as a function object of up to Size bytes, by default a pointer
+    // to function and pointer to optional object. The union of possible
+    // function types guarantees proper size and alignment
     struct _class;
     union {
         void (*_staticfunc)(A0, A1, A2);
         void (*_boundfunc)(_class *, A0, A1, A2);
         void (_class::*_methodfunc)(A0, A1, A2);
+        char _data[Size];
     } _func;
-    void *_obj;
 
     // Dynamically dispatched operations
     const struct ops {
@@ -2527,6 +2655,34 @@ private:
         _ops = &ops;
     }
 
+    // Generate operations for trivially copyable function object, which is
+    // copied with memcpy and needs no destructor
+    template <typename F>
+    void generate_trivial(const F &f)
+    {
+        static const ops ops = {
+            &Callback::function_call<F>,
+            0,
+            0,
+        };
+
+        MBED_STATIC_ASSERT(sizeof(Callback) - sizeof(_ops) >= sizeof(F),
+                           "Type F must not exceed the size of the Callback class");
+        memset(this, 0, sizeof(Callback));
+        new (this) F(f);
+        _ops = &ops;
+    }
+
+    // Static functions are called directly, without operations
+    void generate_function(R(*func)(A0, A1, A2))
+    {
+        static const ops ops = { 0, 0, 0 };
+
+        memset(this, 0, sizeof(Callback));
+        new (this) (R(*)(A0, A1, A2))(func);
+        _ops = &ops;
+    }
+
     // Function attributes
     template <typename F>
     static R function_call(const void *p, A0 a0, A1 a1, A2 a2)
@@ -2580,8 +2736,8 @@ private:
  *
  * @note Synchronization level: Not protected
  */
-template <typename R, typename A0, typename A1, typename A2, typename A3>
-class Callback<R(A0, A1, A2, A3)> {
+template <typename R, typename A0, typename A1, typename A2, typename A3, size_t Size>
+class Callback<R(A0, A1, A2, A3), Size> {
 public:
     /** Create a Callback with a static function
      *  @param func     Static function to attach
@@ -2591,20 +2747,22 @@ public:
         if (!func) {
             memset(this, 0, sizeof(Callback));
         } else {
-            generate(func);
+            generate_function(func);
         }
     }
 
     /** Attach a Callback
      *  @param func     The Callback to attach
      */
-    Callback(const Callback<R(A0, A1, A2, A3)> &func)
+    Callback(const Callback &func)
     {
-        memset(this, 0, sizeof(Callback));
-        if (func._ops) {
+        if (func._ops && func._ops->move) {
+            memset(this, 0, sizeof(Callback));
             func._ops->move(this, &func);
+            _ops = func._ops;
+        } else {
+            memcpy(this, &func, sizeof(Callback));
         }
-        _ops = func._ops;
     }
 
     /** Create a Callback with a member function
@@ -2614,7 +2772,7 @@ public:
     template<typename T, typename U>
     Callback(U *obj, R(T::*method)(A0, A1, A2, A3))
     {
-        generate(method_context<T, R(T::*)(A0, A1, A2, A3)>(obj, method));
+        generate_trivial(method_context<T, R(T::*)(A0, A1, A2, A3)>(obj, method));
     }
 
     /** Create a Callback with a member function
@@ -2624,7 +2782,7 @@ public:
     template<typename T, typename U>
     Callback(const U *obj, R(T::*method)(A0, A1, A2, A3) const)
     {
-        generate(method_context<const T, R(T::*)(A0, A1, A2, A3) const>(obj, method));
+        generate_trivial(method_context<const T, R(T::*)(A0, A1, A2, A3) const>(obj, method));
     }
 
     /** Create a Callback with a member function
@@ -2634,7 +2792,7 @@ public:
     template<typename T, typename U>
     Callback(volatile U *obj, R(T::*method)(A0, A1, A2, A3) volatile)
     {
-        generate(method_context<volatile T, R(T::*)(A0, A1, A2, A3) volatile>(obj, method));
+        generate_trivial(method_context<volatile T, R(T::*)(A0, A1, A2, A3) volatile>(obj, method));
     }
 
     /** Create a Callback with a member function
@@ -2644,7 +2802,7 @@ public:
     template<typename T, typename U>
     Callback(const volatile U *obj, R(T::*method)(A0, A1, A2, A3) const volatile)
     {
-        generate(method_context<const volatile T, R(T::*)(A0, A1, A2, A3) const volatile>(obj, method));
+        generate_trivial(method_context<const volatile T, R(T::*)(A0, A1, A2, A3) const volatile>(obj, method));
     }
 
     /** Create a Callback with a static function and bound pointer
@@ -2654,7 +2812,7 @@ public:
     template<typename T, typename U>
     Callback(R(*func)(T *, A0, A1, A2, A3), U *arg)
     {
-        generate(function_context<R(*)(T *, A0, A1, A2, A3), T>(func, arg));
+        generate_trivial(function_context<R(*)(T *, A0, A1, A2, A3), T>(func, arg));
     }
 
     /** Create a Callback with a static function and bound pointer
@@ -2664,7 +2822,7 @@ public:
     template<typename T, typename U>
     Callback(R(*func)(const T *, A0, A1, A2, A3), const U *arg)
     {
-        generate(function_context<R(*)(const T *, A0, A1, A2, A3), const T>(func, arg));
+        generate_trivial(function_context<R(*)(const T *, A0, A1, A2, A3), const T>(func, arg));
     }
 
     /** Create a Callback with a static function and bound pointer
@@ -2674,7 +2832,7 @@ public:
     template<typename T, typename U>
     Callback(R(*func)(volatile T *, A0, A1, A2, A3), volatile U *arg)
     {
-        generate(function_context<R(*)(volatile T *, A0, A1, A2, A3), volatile T>(func, arg));
+        generate_trivial(function_context<R(*)(volatile T *, A0, A1, A2, A3), volatile T>(func, arg));
     }
 
     /** Create a Callback with a static function and bound pointer
@@ -2684,12 +2842,12 @@ public:
     template<typename T, typename U>
     Callback(R(*func)(const volatile T *, A0, A1, A2, A3), const volatile U *arg)
     {
-        generate(function_context<R(*)(const volatile T *, A0, A1, A2, A3), const volatile T>(func, arg));
+        generate_trivial(function_context<R(*)(const volatile T *, A0, A1, A2, A3), const volatile T>(func, arg));
     }
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      */
     template <typename F>
     Callback(F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0, A1, A2, A3)))
@@ -2699,7 +2857,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      */
     template <typename F>
     Callback(const F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0, A1, A2, A3) const))
@@ -2709,7 +2867,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      */
     template <typename F>
     Callback(volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0, A1, A2, A3) volatile))
@@ -2719,7 +2877,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      */
     template <typename F>
     Callback(const volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0, A1, A2, A3) const volatile))
@@ -2787,7 +2945,7 @@ public:
      */
     ~Callback()
     {
-        if (_ops) {
+        if (_ops && _ops->dtor) {
             _ops->dtor(this);
         }
     }
@@ -2812,7 +2970,7 @@ public:
      */
     MBED_DEPRECATED_SINCE("mbed-os-5.4",
                           "Replaced by simple assignment 'Callback cb = func")
-    void attach(const Callback<R(A0, A1, A2, A3)> &func)
+    void attach(const Callback &func)
     {
         this->~Callback();
         new (this) Callback(func);
@@ -2940,7 +3098,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -2955,7 +3113,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -2970,7 +3128,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -2985,7 +3143,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -3075,6 +3233,9 @@ public:
     R call(A0 a0, A1 a1, A2 a2, A3 a3) const
     {
         MBED_ASSERT(_ops);
+        if (!_ops->call) {
+            return (*(R(* const *)(A0, A1, A2, A3))this)(a0, a1, a2, a3);
+        }
         return _ops->call(this, a0, a1, a2, a3);
     }
 
@@ -3121,16 +3282,16 @@ public:
     }
 
 private:
-    // Stored as pointer to function and pointer to optional object
-    // Function pointer is stored as union of possible function types
-    // to guarantee proper size and alignment
+    // Stored as a function object of up to Size bytes, by default a pointer
+    // to function and pointer to optional object. The union of possible
+    // function types guarantees proper size and alignment
     struct _class;
     union {
         void (*_staticfunc)(A0, A1, A2, A3);
         void (*_boundfunc)(_class *, A0, A1, A2, A3);
         void (_class::*_methodfunc)(A0, A1, A2, A3);
+        char _data[Size];
     } _func;
-    void *_obj;
 
     // Dynamically dispatched operations
     const struct ops {
@@ -3156,6 +3317,34 @@ private:
         _ops = &ops;
     }
 
+    // Generate operations for trivially copyable function object, which is
+    // copied with memcpy and needs no destructor
+    template <typename F>
+    void generate_trivial(const F &f)
+    {
+        static const ops ops = {
+            &Callback::function_call<F>,
+            0,
+            0,
+        };
+
+        MBED_STATIC_ASSERT(sizeof(Callback) - sizeof(_ops) >= sizeof(F),
+                           "Type F must not exceed the size of the Callback class");
+        memset(this, 0, sizeof(Callback));
+        new (this) F(f);
+        _ops = &ops;
+    }
+
+    // Static functions are called directly, without operations
+    void generate_function(R(*func)(A0, A1, A2, A3))
+    {
+        static const ops ops = { 0, 0, 0 };
+
+        memset(this, 0, sizeof(Callback));
+        new (this) (R(*)(A0, A1, A2, A3))(func);
+        _ops = &ops;
+    }
+
     // Function attributes
     template <typename F>
     static R function_call(const void *p, A0 a0, A1 a1, A2 a2, A3 a3)
@@ -3209,8 +3398,8 @@ private:
  *
  * @note Synchronization level: Not protected
  */
-template <typename R, typename A0, typename A1, typename A2, typename A3, typename A4>
-class Callback<R(A0, A1, A2, A3, A4)> {
+template <typename R, typename A0, typename A1, typename A2, typename A3, typename A4, size_t Size>
+class Callback<R(A0, A1, A2, A3, A4), Size> {
 public:
     /** Create a Callback with a static function
      *  @param func     Static function to attach
@@ -3220,20 +3409,22 @@ public:
         if (!func) {
             memset(this, 0, sizeof(Callback));
         } else {
-            generate(func);
+            generate_function(func);
         }
     }
 
     /** Attach a Callback
      *  @param func     The Callback to attach
      */
-    Callback(const Callback<R(A0, A1, A2, A3, A4)> &func)
+    Callback(const Callback &func)
     {
-        memset(this, 0, sizeof(Callback));
-        if (func._ops) {
+        if (func._ops && func._ops->move) {
+            memset(this, 0, sizeof(Callback));
             func._ops->move(this, &func);
+            _ops = func._ops;
+        } else {
+            memcpy(this, &func, sizeof(Callback));
         }
-        _ops = func._ops;
     }
 
     /** Create a Callback with a member function
@@ -3243,7 +3434,7 @@ public:
     template<typename T, typename U>
     Callback(U *obj, R(T::*method)(A0, A1, A2, A3, A4))
     {
-        generate(method_context<T, R(T::*)(A0, A1, A2, A3, A4)>(obj, method));
+        generate_trivial(method_context<T, R(T::*)(A0, A1, A2, A3, A4)>(obj, method));
     }
 
     /** Create a Callback with a member function
@@ -3253,7 +3444,7 @@ public:
     template<typename T, typename U>
     Callback(const U *obj, R(T::*method)(A0, A1, A2, A3, A4) const)
     {
-        generate(method_context<const T, R(T::*)(A0, A1, A2, A3, A4) const>(obj, method));
+        generate_trivial(method_context<const T, R(T::*)(A0, A1, A2, A3, A4) const>(obj, method));
     }
 
     /** Create a Callback with a member function
@@ -3263,7 +3454,7 @@ public:
     template<typename T, typename U>
     Callback(volatile U *obj, R(T::*method)(A0, A1, A2, A3, A4) volatile)
     {
-        generate(method_context<volatile T, R(T::*)(A0, A1, A2, A3, A4) volatile>(obj, method));
+        generate_trivial(method_context<volatile T, R(T::*)(A0, A1, A2, A3, A4) volatile>(obj, method));
     }
 
     /** Create a Callback with a member function
@@ -3273,7 +3464,7 @@ public:
     template<typename T, typename U>
     Callback(const volatile U *obj, R(T::*method)(A0, A1, A2, A3, A4) const volatile)
     {
-        generate(method_context<const volatile T, R(T::*)(A0, A1, A2, A3, A4) const volatile>(obj, method));
+        generate_trivial(method_context<const volatile T, R(T::*)(A0, A1, A2, A3, A4) const volatile>(obj, method));
     }
 
     /** Create a Callback with a static function and bound pointer
@@ -3283,7 +3474,7 @@ public:
     template<typename T, typename U>
     Callback(R(*func)(T *, A0, A1, A2, A3, A4), U *arg)
     {
-        generate(function_context<R(*)(T *, A0, A1, A2, A3, A4), T>(func, arg));
+        generate_trivial(function_context<R(*)(T *, A0, A1, A2, A3, A4), T>(func, arg));
     }
 
     /** Create a Callback with a static function and bound pointer
@@ -3293,7 +3484,7 @@ public:
     template<typename T, typename U>
     Callback(R(*func)(const T *, A0, A1, A2, A3, A4), const U *arg)
     {
-        generate(function_context<R(*)(const T *, A0, A1, A2, A3, A4), const T>(func, arg));
+        generate_trivial(function_context<R(*)(const T *, A0, A1, A2, A3, A4), const T>(func, arg));
     }
 
     /** Create a Callback with a static function and bound pointer
@@ -3303,7 +3494,7 @@ public:
     template<typename T, typename U>
     Callback(R(*func)(volatile T *, A0, A1, A2, A3, A4), volatile U *arg)
     {
-        generate(function_context<R(*)(volatile T *, A0, A1, A2, A3, A4), volatile T>(func, arg));
+        generate_trivial(function_context<R(*)(volatile T *, A0, A1, A2, A3, A4), volatile T>(func, arg));
     }
 
     /** Create a Callback with a static function and bound pointer
@@ -3313,12 +3504,12 @@ public:
     template<typename T, typename U>
     Callback(R(*func)(const volatile T *, A0, A1, A2, A3, A4), const volatile U *arg)
     {
-        generate(function_context<R(*)(const volatile T *, A0, A1, A2, A3, A4), const volatile T>(func, arg));
+        generate_trivial(function_context<R(*)(const volatile T *, A0, A1, A2, A3, A4), const volatile T>(func, arg));
     }
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      */
     template <typename F>
     Callback(F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0, A1, A2, A3, A4)))
@@ -3328,7 +3519,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      */
     template <typename F>
     Callback(const F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0, A1, A2, A3, A4) const))
@@ -3338,7 +3529,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      */
     template <typename F>
     Callback(volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0, A1, A2, A3, A4) volatile))
@@ -3348,7 +3539,7 @@ public:
 
     /** Create a Callback with a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      */
     template <typename F>
     Callback(const volatile F f, MBED_ENABLE_IF_CALLBACK_COMPATIBLE(F, R(F::*)(A0, A1, A2, A3, A4) const volatile))
@@ -3416,7 +3607,7 @@ public:
      */
     ~Callback()
     {
-        if (_ops) {
+        if (_ops && _ops->dtor) {
             _ops->dtor(this);
         }
     }
@@ -3441,7 +3632,7 @@ public:
      */
     MBED_DEPRECATED_SINCE("mbed-os-5.4",
                           "Replaced by simple assignment 'Callback cb = func")
-    void attach(const Callback<R(A0, A1, A2, A3, A4)> &func)
+    void attach(const Callback &func)
     {
         this->~Callback();
         new (this) Callback(func);
@@ -3569,7 +3760,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -3584,7 +3775,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -3599,7 +3790,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -3614,7 +3805,7 @@ public:
 
     /** Attach a function object
      *  @param f Function object to attach
-     *  @note The function object is limited to a single word of storage
+     *  @note The function object is limited to Size bytes of storage
      *  @deprecated
      *      Replaced by simple assignment 'Callback cb = func'
      */
@@ -3704,6 +3895,9 @@ public:
     R call(A0 a0, A1 a1, A2 a2, A3 a3, A4 a4) const
     {
         MBED_ASSERT(_ops);
+        if (!_ops->call) {
+            return (*(R(* const *)(A0, A1, A2, A3, A4))this)(a0, a1, a2, a3, a4);
+        }
         return _ops->call(this, a0, a1, a2, a3, a4);
     }
 
@@ -3751,16 +3945,16 @@ public:
     }
 
 private:
-    // Stored as pointer to function and pointer to optional object
-    // Function pointer is stored as union of possible function types
-    // to guarantee proper size and alignment
+    // Stored as a function object of up to Size bytes, by default a pointer
+    // to function and pointer to optional object. The union of possible
+    // function types guarantees proper size and alignment
     struct _class;
     union {
         void (*_staticfunc)(A0, A1, A2, A3, A4);
         void (*_boundfunc)(_class *, A0, A1, A2, A3, A4);
         void (_class::*_methodfunc)(A0, A1, A2, A3, A4);
+        char _data[Size];
     } _func;
-    void *_obj;
 
     // Dynamically dispatched operations
     const struct ops {
@@ -3786,6 +3980,34 @@ private:
         _ops = &ops;
     }
 
+    // Generate operations for trivially copyable function object, which is
+    // copied with memcpy and needs no destructor
+    template <typename F>
+    void generate_trivial(const F &f)
+    {
+        static const ops ops = {
+            &Callback::function_call<F>,
+            0,
+            0,
+        };
+
+        MBED_STATIC_ASSERT(sizeof(Callback) - sizeof(_ops) >= sizeof(F),
+                           "Type F must not exceed the size of the Callback class");
+        memset(this, 0, sizeof(Callback));
+        new (this) F(f);
+        _ops = &ops;
+    }
+
+    // Static functions are called directly, without operations
+    void generate_function(R(*func)(A0, A1, A2, A3, A4))
+    {
+        static const ops ops = { 0, 0, 0 };
+
+        memset(this, 0, sizeof(Callback));
+        new (this) (R(*)(A0, A1, A2, A3, A4))(func);
+        _ops = &ops;
+    }
+
     // Function attributes
     template <typename F>
     static R function_call(const void *p, A0 a0, A1 a1, A2 a2, A3 a3, A4 a4)
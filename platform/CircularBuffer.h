@@ -17,8 +17,10 @@
 #ifndef MBED_CIRCULARBUFFER_H
 #define MBED_CIRCULARBUFFER_H
 
+#include <string.h>
 #include "platform/mbed_critical.h"
 #include "platform/mbed_assert.h"
+#include "platform/Span.h"
 
 namespace mbed {
 
@@ -61,6 +63,8 @@ struct is_unsigned<unsigned long long> {
  *
  *  @note Synchronization level: Interrupt safe
  *  @note CounterType must be unsigned and consistent with BufferSize
+ *  @note The bulk operations and spans copy elements with memcpy, so they
+ *        must only be used with trivially copyable element types
  */
 template<typename T, uint32_t BufferSize, typename CounterType = uint32_t>
 class CircularBuffer {
@@ -107,6 +111,40 @@ public:
         core_util_critical_section_exit();
     }
 
+    /** Push a number of transactions to the buffer. This overwrites the
+     *  oldest transactions if the buffer does not have room for all of them
+     *
+     * @param src Transactions to be pushed to the buffer
+     * @param len Number of transactions to push
+     */
+    void push(const T *src, CounterType len)
+    {
+        core_util_critical_section_enter();
+        if (len >= BufferSize) {
+            // only the newest transactions fit
+            memcpy(_pool, src + (len - BufferSize), BufferSize * sizeof(T));
+            _head = 0;
+            _tail = 0;
+            _full = true;
+        } else if (len) {
+            bool overwrite = len >= BufferSize - size();
+
+            CounterType chunk = BufferSize - _head;
+            if (chunk > len) {
+                chunk = len;
+            }
+            memcpy(&_pool[_head], src, chunk * sizeof(T));
+            memcpy(_pool, src + chunk, (len - chunk) * sizeof(T));
+
+            _head = wrap(_head + len);
+            if (overwrite) {
+                _tail = _head;
+                _full = true;
+            }
+        }
+        core_util_critical_section_exit();
+    }
+
     /** Pop the transaction from the buffer
      *
      * @param data Data to be popped from the buffer
@@ -128,6 +166,109 @@ public:
         return data_popped;
     }
 
+    /** Pop a number of transactions from the buffer
+     *
+     * @param dest Buffer to store the popped transactions in
+     * @param len Maximum number of transactions to pop
+     * @return Number of transactions popped
+     */
+    CounterType pop(T *dest, CounterType len)
+    {
+        core_util_critical_section_enter();
+        CounterType available = size();
+        if (len > available) {
+            len = available;
+        }
+
+        CounterType chunk = BufferSize - _tail;
+        if (chunk > len) {
+            chunk = len;
+        }
+        memcpy(dest, &_pool[_tail], chunk * sizeof(T));
+        memcpy(dest + chunk, _pool, (len - chunk) * sizeof(T));
+
+        if (len) {
+            _tail = wrap(_tail + len);
+            _full = false;
+        }
+        core_util_critical_section_exit();
+        return len;
+    }
+
+    /** Get the oldest transactions stored contiguously in the buffer
+     *
+     *  The transactions stay in the buffer until released with consume. If
+     *  the stored transactions wrap around the end of the buffer, only the
+     *  first part is returned, call again after consume to get the rest.
+     *
+     * @return Span over the stored transactions, empty if the buffer is empty
+     */
+    Span<const T> readable_span() const
+    {
+        core_util_critical_section_enter();
+        Span<const T> span;
+        if (!empty()) {
+            CounterType end = (_head > _tail) ? _head : BufferSize;
+            span = Span<const T>(&_pool[_tail], end - _tail);
+        }
+        core_util_critical_section_exit();
+        return span;
+    }
+
+    /** Release transactions returned by readable_span
+     *
+     * @param len Number of transactions to release, at most the size of
+     *            the span returned by readable_span
+     */
+    void consume(CounterType len)
+    {
+        core_util_critical_section_enter();
+        MBED_ASSERT(len <= size());
+        if (len) {
+            _tail = wrap(_tail + len);
+            _full = false;
+        }
+        core_util_critical_section_exit();
+    }
+
+    /** Get the free space after the newest transaction in the buffer
+     *
+     *  Transactions written to the span are added to the buffer with commit.
+     *  If the free space wraps around the end of the buffer, only the first
+     *  part is returned, call again after commit to get the rest.
+     *
+     * @return Span over the free space, empty if the buffer is full
+     */
+    Span<T> writable_span()
+    {
+        core_util_critical_section_enter();
+        Span<T> span;
+        if (!full()) {
+            CounterType end = (_tail > _head) ? _tail : BufferSize;
+            span = Span<T>(&_pool[_head], end - _head);
+        }
+        core_util_critical_section_exit();
+        return span;
+    }
+
+    /** Add transactions written to the span returned by writable_span
+     *
+     * @param len Number of transactions to add, at most the size of the
+     *            span returned by writable_span
+     */
+    void commit(CounterType len)
+    {
+        core_util_critical_section_enter();
+        MBED_ASSERT(len <= BufferSize - size());
+        if (len) {
+            _head = wrap(_head + len);
+            if (_head == _tail) {
+                _full = true;
+            }
+        }
+        core_util_critical_section_exit();
+    }
+
     /** Check if the buffer is empty
      *
      * @return True if the buffer is empty, false if not
@@ -200,6 +341,11 @@ public:
     }
 
 private:
+    static CounterType wrap(uint32_t index)
+    {
+        return (index >= BufferSize) ? index - BufferSize : index;
+    }
+
     T _pool[BufferSize];
     CounterType _head;
     CounterType _tail;
@@ -34,4 +34,16 @@ off_t FileHandle::size()
     return size;
 }
 
+int FileHandle::read_async(void *buffer, size_t size, Callback<void(ssize_t)> done)
+{
+    done(read(buffer, size));
+    return 0;
+}
+
+int FileHandle::write_async(const void *buffer, size_t size, Callback<void(ssize_t)> done)
+{
+    done(write(buffer, size));
+    return 0;
+}
+
 } // namespace mbed
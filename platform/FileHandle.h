@@ -279,6 +279,41 @@ public:
     {
         //Default for real files. Do nothing for real files.
     }
+
+    /** Start reading from a file, and report the result to a callback
+     *
+     *  The callback is called once with what read() would have returned,
+     *  either as soon as data is available, or before read_async() returns.
+     *  Only one read may be pending at a time, and read() must not be called
+     *  while it is. Pass the callback of an EventQueue event to get the
+     *  result on that queue.
+     *
+     *  By default the read is done synchronously, which suits real files.
+     *  Character devices override it to complete from their interrupts,
+     *  in which case the callback is called in an interrupt context.
+     *
+     *  @param buffer   The buffer to read in to, valid until the callback
+     *  @param size     The number of bytes to read
+     *  @param done     Called with the number of bytes read, or a negative error code
+     *  @return         0 once started, -EBUSY if a read is already pending
+     */
+    virtual int read_async(void *buffer, size_t size, Callback<void(ssize_t)> done);
+
+    /** Start writing to a file, and report the result to a callback
+     *
+     *  The callback is called once with the number of bytes written, which
+     *  may be less than size for character devices, as soon as they have
+     *  room, or before write_async() returns. Only one write may be pending
+     *  at a time, and write() must not be called while it is.
+     *
+     *  By default the write is done synchronously, see read_async().
+     *
+     *  @param buffer   The buffer to write from, valid until the callback
+     *  @param size     The number of bytes to write
+     *  @param done     Called with the number of bytes written, or a negative error code
+     *  @return         0 once started, -EBUSY if a write is already pending
+     */
+    virtual int write_async(const void *buffer, size_t size, Callback<void(ssize_t)> done);
 };
 
 /**@}*/
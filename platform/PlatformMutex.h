@@ -33,14 +33,20 @@
  * This enables the use of drivers when the Mbed OS is compiled without the RTOS.
  *
  * @note
- * - When the RTOS is present, the PlatformMutex becomes a typedef for rtos::Mutex.
+ * - When the RTOS is present, the PlatformMutex becomes a typedef for rtos::Mutex,
+ *   or rtos::FastMutex if rtos.fast-platform-mutex is set.
  * - When the RTOS is absent, all methods are defined as noop.
  */
 
 #ifdef MBED_CONF_RTOS_PRESENT
 
+#if MBED_CONF_RTOS_FAST_PLATFORM_MUTEX
+#include "rtos/FastMutex.h"
+typedef rtos::FastMutex PlatformMutex;
+#else
 #include "rtos/Mutex.h"
 typedef rtos::Mutex PlatformMutex;
+#endif
 
 #else
 
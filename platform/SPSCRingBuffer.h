@@ -0,0 +1,269 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_SPSCRINGBUFFER_H
+#define MBED_SPSCRINGBUFFER_H
+
+#include <string.h>
+#include "platform/mbed_critical.h"
+#include "platform/mbed_assert.h"
+#include "platform/Span.h"
+
+namespace mbed {
+
+/** \addtogroup platform */
+/** @{*/
+/**
+ * \defgroup platform_SPSCRingBuffer SPSCRingBuffer functions
+ * @{
+ */
+
+/** Templated lock-free single-producer single-consumer ring buffer
+ *
+ *  The producer side (push, writable_span, commit) and the consumer side
+ *  (pop, peek, readable_span, consume) may run concurrently, for example in
+ *  an interrupt handler and a thread, without disabling interrupts. Each
+ *  side owns one index and only publishes it with core_util_atomic_store_u32
+ *  after the elements it covers are written or read.
+ *
+ *  Unlike CircularBuffer, pushing to a full buffer fails rather than
+ *  overwriting the oldest element, as the producer can't move the
+ *  consumer's index.
+ *
+ *  @note Synchronization level: Interrupt safe for one producer and one
+ *        consumer. Several producers or several consumers must be
+ *        serialized by the caller.
+ *  @note BufferSize must be a power of two
+ *  @note The bulk operations copy elements with memcpy, so they must only
+ *        be used with trivially copyable element types
+ */
+template<typename T, uint32_t BufferSize>
+class SPSCRingBuffer {
+public:
+    SPSCRingBuffer() : _head(0), _tail(0)
+    {
+        MBED_STATIC_ASSERT(
+            BufferSize > 0 && (BufferSize & (BufferSize - 1)) == 0,
+            "BufferSize must be a power of two"
+        );
+    }
+
+    /** Push the transaction to the buffer
+     *
+     * @param data Data to be pushed to the buffer
+     * @return True if the data was pushed, false if the buffer is full
+     */
+    bool push(const T &data)
+    {
+        uint32_t head = _head;
+        if (head - core_util_atomic_load_u32(&_tail) == BufferSize) {
+            return false;
+        }
+
+        _pool[head & MASK] = data;
+        core_util_atomic_store_u32(&_head, head + 1);
+        return true;
+    }
+
+    /** Push a number of transactions to the buffer
+     *
+     * @param src Transactions to be pushed to the buffer
+     * @param len Maximum number of transactions to push
+     * @return Number of transactions pushed, less than len if the buffer
+     *         filled up
+     */
+    uint32_t push(const T *src, uint32_t len)
+    {
+        uint32_t head = _head;
+        uint32_t space = BufferSize - (head - core_util_atomic_load_u32(&_tail));
+        if (len > space) {
+            len = space;
+        }
+
+        uint32_t chunk = BufferSize - (head & MASK);
+        if (chunk > len) {
+            chunk = len;
+        }
+        memcpy(&_pool[head & MASK], src, chunk * sizeof(T));
+        memcpy(_pool, src + chunk, (len - chunk) * sizeof(T));
+
+        core_util_atomic_store_u32(&_head, head + len);
+        return len;
+    }
+
+    /** Pop the transaction from the buffer
+     *
+     * @param data Data to be popped from the buffer
+     * @return True if the buffer is not empty and data contains a transaction, false otherwise
+     */
+    bool pop(T &data)
+    {
+        uint32_t tail = _tail;
+        if (core_util_atomic_load_u32(&_head) == tail) {
+            return false;
+        }
+
+        data = _pool[tail & MASK];
+        core_util_atomic_store_u32(&_tail, tail + 1);
+        return true;
+    }
+
+    /** Pop a number of transactions from the buffer
+     *
+     * @param dest Buffer to store the popped transactions in
+     * @param len Maximum number of transactions to pop
+     * @return Number of transactions popped
+     */
+    uint32_t pop(T *dest, uint32_t len)
+    {
+        uint32_t tail = _tail;
+        uint32_t available = core_util_atomic_load_u32(&_head) - tail;
+        if (len > available) {
+            len = available;
+        }
+
+        uint32_t chunk = BufferSize - (tail & MASK);
+        if (chunk > len) {
+            chunk = len;
+        }
+        memcpy(dest, &_pool[tail & MASK], chunk * sizeof(T));
+        memcpy(dest + chunk, _pool, (len - chunk) * sizeof(T));
+
+        core_util_atomic_store_u32(&_tail, tail + len);
+        return len;
+    }
+
+    /** Peek into the buffer without popping
+     *
+     * @param data Data to be peeked from the buffer
+     * @return True if the buffer is not empty and data contains a transaction, false otherwise
+     */
+    bool peek(T &data) const
+    {
+        uint32_t tail = _tail;
+        if (core_util_atomic_load_u32(&_head) == tail) {
+            return false;
+        }
+
+        data = _pool[tail & MASK];
+        return true;
+    }
+
+    /** Get the oldest transactions stored contiguously in the buffer
+     *
+     *  Consumer side. The transactions stay in the buffer until released
+     *  with consume.
+     *
+     * @return Span over the stored transactions, empty if the buffer is empty
+     */
+    Span<const T> readable_span() const
+    {
+        uint32_t tail = _tail;
+        uint32_t len = core_util_atomic_load_u32(&_head) - tail;
+        uint32_t chunk = BufferSize - (tail & MASK);
+        if (chunk > len) {
+            chunk = len;
+        }
+
+        return Span<const T>(&_pool[tail & MASK], chunk);
+    }
+
+    /** Release transactions returned by readable_span
+     *
+     * @param len Number of transactions to release
+     */
+    void consume(uint32_t len)
+    {
+        uint32_t tail = _tail;
+        MBED_ASSERT(len <= core_util_atomic_load_u32(&_head) - tail);
+        core_util_atomic_store_u32(&_tail, tail + len);
+    }
+
+    /** Get the free space after the newest transaction in the buffer
+     *
+     *  Producer side. Transactions written to the span are published to
+     *  the consumer with commit.
+     *
+     * @return Span over the free space, empty if the buffer is full
+     */
+    Span<T> writable_span()
+    {
+        uint32_t head = _head;
+        uint32_t space = BufferSize - (head - core_util_atomic_load_u32(&_tail));
+        uint32_t chunk = BufferSize - (head & MASK);
+        if (chunk > space) {
+            chunk = space;
+        }
+
+        return Span<T>(&_pool[head & MASK], chunk);
+    }
+
+    /** Publish transactions written to the span returned by writable_span
+     *
+     * @param len Number of transactions to publish
+     */
+    void commit(uint32_t len)
+    {
+        uint32_t head = _head;
+        MBED_ASSERT(len <= BufferSize - (head - core_util_atomic_load_u32(&_tail)));
+        core_util_atomic_store_u32(&_head, head + len);
+    }
+
+    /** Check if the buffer is empty
+     *
+     * @return True if the buffer is empty, false if not
+     */
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /** Check if the buffer is full
+     *
+     * @return True if the buffer is full, false if not
+     */
+    bool full() const
+    {
+        return size() == BufferSize;
+    }
+
+    /** Get the number of elements currently stored in the buffer */
+    uint32_t size() const
+    {
+        // load the tail first, so the head can only have moved further
+        // ahead of it
+        uint32_t tail = core_util_atomic_load_u32(&_tail);
+        uint32_t head = core_util_atomic_load_u32(&_head);
+        uint32_t len = head - tail;
+        return (len > BufferSize) ? BufferSize : len;
+    }
+
+private:
+    static const uint32_t MASK = BufferSize - 1;
+
+    T _pool[BufferSize];
+    // free running indices, each only written by its own side
+    volatile uint32_t _head;
+    volatile uint32_t _tail;
+};
+
+/**@}*/
+
+/**@}*/
+
+}
+
+#endif
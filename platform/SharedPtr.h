@@ -22,6 +22,7 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <new>
 
 #include "platform/mbed_critical.h"
 
@@ -52,10 +53,13 @@ namespace mbed {
   *
   *
   * It is similar to the std::shared_ptr class introduced in C++11;
-  * however, this is not a compatible implementation (no weak pointer, no make_shared, no custom deleters and so on.)
+  * however, this is not a compatible implementation (no weak pointer, no custom deleters and so on.)
   *
   * Usage: SharedPtr<Class> ptr(new Class())
   *
+  * or, allocating the object and its reference counter together in a single
+  * allocation: SharedPtr<Class> ptr = make_shared<Class>(args)
+  *
   * When ptr is passed around by value, the copy constructor and
   * destructor manages the reference count of the raw pointer.
   * If the counter reaches zero, delete is called on the raw pointer.
@@ -180,7 +184,7 @@ public:
     uint32_t use_count() const
     {
         if (_ptr != NULL) {
-            return core_util_atomic_load_u32(_counter);
+            return core_util_atomic_load_u32(_counter) & ~IN_BLOCK;
         } else {
             return 0;
         }
@@ -214,6 +218,57 @@ public:
     }
 
 private:
+    template <class U>
+    friend SharedPtr<U> make_shared();
+    template <class U, typename A0>
+    friend SharedPtr<U> make_shared(const A0 &a0);
+    template <class U, typename A0, typename A1>
+    friend SharedPtr<U> make_shared(const A0 &a0, const A1 &a1);
+    template <class U, typename A0, typename A1, typename A2>
+    friend SharedPtr<U> make_shared(const A0 &a0, const A1 &a1, const A2 &a2);
+    template <class U, typename A0, typename A1, typename A2, typename A3>
+    friend SharedPtr<U> make_shared(const A0 &a0, const A1 &a1, const A2 &a2, const A3 &a3);
+
+    /* Set in the reference counter of an object allocated by make_shared,
+     * the object is stored in the same block right after the counter.
+     */
+    static const uint32_t IN_BLOCK = 0x80000000;
+
+    struct Block {
+        uint32_t counter;
+        union {
+            char data[sizeof(T)];
+            // For alignment
+            uint64_t u64;
+            double d;
+            void *p;
+        } object;
+    };
+
+    /**
+     * @brief Allocate the block of make_shared, before the object is constructed in it.
+     * @return Block allocated, with a reference count of one.
+     */
+    static Block *allocate_block()
+    {
+        Block *block = new Block;
+        block->counter = IN_BLOCK | 1;
+        return block;
+    }
+
+    /**
+     * @brief Create SharedPtr managing the object constructed in a block.
+     * @param block Block returned by allocate_block.
+     * @return SharedPtr to the object.
+     */
+    static SharedPtr from_block(Block *block)
+    {
+        SharedPtr ptr;
+        ptr._ptr = reinterpret_cast<T *>(block->object.data);
+        ptr._counter = &block->counter;
+        return ptr;
+    }
+
     /**
      * @brief Get pointer to reference counter.
      * @return Pointer to reference counter.
@@ -232,9 +287,13 @@ private:
     void decrement_counter()
     {
         if (_ptr != NULL) {
-            if (core_util_atomic_decr_u32(_counter, 1) == 0) {
+            uint32_t count = core_util_atomic_decr_u32(_counter, 1);
+            if (count == 0) {
                 delete _counter;
                 delete _ptr;
+            } else if (count == IN_BLOCK) {
+                _ptr->~T();
+                delete reinterpret_cast<Block *>(_counter);
             }
         }
     }
@@ -247,6 +306,75 @@ private:
     uint32_t *_counter;
 };
 
+/** Create an object and a SharedPtr managing it, with a single allocation
+  * for the object and its reference counter.
+  *
+  * @return SharedPtr to the new object.
+  */
+template <class T>
+SharedPtr<T> make_shared()
+{
+    typename SharedPtr<T>::Block *block = SharedPtr<T>::allocate_block();
+    new (block->object.data) T();
+    return SharedPtr<T>::from_block(block);
+}
+
+/** Create an object and a SharedPtr managing it, with a single allocation
+  * for the object and its reference counter.
+  *
+  * @param a0 Argument passed to the constructor of the object.
+  * @return SharedPtr to the new object.
+  */
+template <class T, typename A0>
+SharedPtr<T> make_shared(const A0 &a0)
+{
+    typename SharedPtr<T>::Block *block = SharedPtr<T>::allocate_block();
+    new (block->object.data) T(a0);
+    return SharedPtr<T>::from_block(block);
+}
+
+/** Create an object and a SharedPtr managing it, with a single allocation
+  * for the object and its reference counter.
+  *
+  * @param a0, a1 Arguments passed to the constructor of the object.
+  * @return SharedPtr to the new object.
+  */
+template <class T, typename A0, typename A1>
+SharedPtr<T> make_shared(const A0 &a0, const A1 &a1)
+{
+    typename SharedPtr<T>::Block *block = SharedPtr<T>::allocate_block();
+    new (block->object.data) T(a0, a1);
+    return SharedPtr<T>::from_block(block);
+}
+
+/** Create an object and a SharedPtr managing it, with a single allocation
+  * for the object and its reference counter.
+  *
+  * @param a0, a1, a2 Arguments passed to the constructor of the object.
+  * @return SharedPtr to the new object.
+  */
+template <class T, typename A0, typename A1, typename A2>
+SharedPtr<T> make_shared(const A0 &a0, const A1 &a1, const A2 &a2)
+{
+    typename SharedPtr<T>::Block *block = SharedPtr<T>::allocate_block();
+    new (block->object.data) T(a0, a1, a2);
+    return SharedPtr<T>::from_block(block);
+}
+
+/** Create an object and a SharedPtr managing it, with a single allocation
+  * for the object and its reference counter.
+  *
+  * @param a0, a1, a2, a3 Arguments passed to the constructor of the object.
+  * @return SharedPtr to the new object.
+  */
+template <class T, typename A0, typename A1, typename A2, typename A3>
+SharedPtr<T> make_shared(const A0 &a0, const A1 &a1, const A2 &a2, const A3 &a3)
+{
+    typename SharedPtr<T>::Block *block = SharedPtr<T>::allocate_block();
+    new (block->object.data) T(a0, a1, a2, a3);
+    return SharedPtr<T>::from_block(block);
+}
+
 /** Non-member relational operators.
   */
 template <class T, class U>
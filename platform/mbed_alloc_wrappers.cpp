@@ -20,11 +20,16 @@
 #include "platform/mbed_toolchain.h"
 #include "platform/SingletonPtr.h"
 #include "platform/PlatformMutex.h"
+#include "platform/mbed_tlsf.h"
 #include <stddef.h>
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 
+#if MBED_CONF_PLATFORM_TLSF_HEAP_ENABLED && defined(MBED_CONF_RTOS_PRESENT)
+#include "cmsis_os2.h"
+#endif
+
 /* There are two memory tracers in mbed OS:
 
 - the first can be used to detect the maximum heap usage at runtime. It is
@@ -35,7 +40,11 @@
 
 Both tracers can be activated and deactivated in any combination. If both tracers
 are active, the second one (MBED_MEM_TRACING_ENABLED) will trace the first one's
-(MBED_HEAP_STATS_ENABLED) memory calls.*/
+(MBED_HEAP_STATS_ENABLED) memory calls.
+
+When platform.tlsf-heap-enabled is set, the toolchain's allocator is replaced
+by a TLSF allocator (see mbed_tlsf.h) managing the same heap region, with
+constant time allocation and free.*/
 
 /******************************************************************************/
 /* Implementation of the runtime max heap usage checker                       */
@@ -50,7 +59,7 @@ typedef struct {
 #define MBED_HEAP_STATS_SIGNATURE       (0xdeadbeef)
 
 static SingletonPtr<PlatformMutex> malloc_stats_mutex;
-static mbed_stats_heap_t heap_stats = {0, 0, 0, 0, 0, 0, 0};
+static mbed_stats_heap_t heap_stats = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
 
 typedef struct  {
     size_t size;
@@ -61,9 +70,173 @@ typedef struct  {
 #define MALLOC_HEAP_TOTAL_SIZE(p)   (((p)->size) & (~0x1))
 #endif
 
+/******************************************************************************/
+/* TLSF heap                                                                  */
+/******************************************************************************/
+
+#if MBED_CONF_PLATFORM_TLSF_HEAP_ENABLED
+extern unsigned char *mbed_heap_start;
+extern uint32_t mbed_heap_size;
+
+static SingletonPtr<PlatformMutex> tlsf_mutex;
+static mbed_tlsf_t tlsf_heap;
+static bool tlsf_initialized = false;
+
+static void tlsf_lock()
+{
+    tlsf_mutex->lock();
+    // The heap region is only known once the boot code has run
+    if (!tlsf_initialized) {
+        mbed_tlsf_init(&tlsf_heap, mbed_heap_start, mbed_heap_size);
+        tlsf_initialized = true;
+    }
+}
+
+static void tlsf_unlock()
+{
+    tlsf_mutex->unlock();
+}
+
+static void *tlsf_owner()
+{
+#if defined(MBED_THREAD_STATS_ENABLED) && defined(MBED_CONF_RTOS_PRESENT)
+    return osThreadGetId();
+#else
+    return NULL;
+#endif
+}
+
+static void tlsf_stats_add(void *ptr)
+{
+#ifdef MBED_HEAP_STATS_ENABLED
+    if (ptr == NULL) {
+        heap_stats.alloc_fail_cnt += 1;
+        return;
+    }
+    size_t size = mbed_tlsf_requested_size(ptr);
+    heap_stats.current_size += size;
+    heap_stats.total_size += size;
+    heap_stats.alloc_cnt += 1;
+    if (heap_stats.current_size > heap_stats.max_size) {
+        heap_stats.max_size = heap_stats.current_size;
+    }
+    heap_stats.overhead_size += mbed_tlsf_block_size(ptr) - size;
+#endif
+}
+
+static void tlsf_stats_remove(void *ptr)
+{
+#ifdef MBED_HEAP_STATS_ENABLED
+    size_t size = mbed_tlsf_requested_size(ptr);
+    heap_stats.current_size -= size;
+    heap_stats.alloc_cnt -= 1;
+    heap_stats.overhead_size -= mbed_tlsf_block_size(ptr) - size;
+#endif
+}
+
+static void *tlsf_heap_malloc(size_t size)
+{
+    tlsf_lock();
+    void *ptr = mbed_tlsf_malloc(&tlsf_heap, size, tlsf_owner());
+    tlsf_stats_add(ptr);
+    tlsf_unlock();
+    return ptr;
+}
+
+static void *tlsf_heap_memalign(size_t alignment, size_t size)
+{
+    tlsf_lock();
+    void *ptr = mbed_tlsf_memalign(&tlsf_heap, alignment, size, tlsf_owner());
+    tlsf_stats_add(ptr);
+    tlsf_unlock();
+    return ptr;
+}
+
+static void *tlsf_heap_realloc(void *ptr, size_t size)
+{
+    tlsf_lock();
+    // The old block may be resized in place, so account for it first
+    if (ptr != NULL) {
+        tlsf_stats_remove(ptr);
+    }
+    void *new_ptr = mbed_tlsf_realloc(&tlsf_heap, ptr, size, tlsf_owner());
+    if (new_ptr != NULL) {
+        tlsf_stats_add(new_ptr);
+    } else if (size != 0) {
+        // The original memory is untouched on failure
+        if (ptr != NULL) {
+            tlsf_stats_add(ptr);
+        }
+        tlsf_stats_add(NULL);
+    }
+    tlsf_unlock();
+    return new_ptr;
+}
+
+static void *tlsf_heap_calloc(size_t nmemb, size_t size)
+{
+    void *ptr = tlsf_heap_malloc(nmemb * size);
+    if (ptr != NULL) {
+        memset(ptr, 0, nmemb * size);
+    }
+    return ptr;
+}
+
+static void tlsf_heap_free(void *ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
+    tlsf_lock();
+    tlsf_stats_remove(ptr);
+    mbed_tlsf_free(&tlsf_heap, ptr);
+    tlsf_unlock();
+}
+
+typedef struct {
+    mbed_stats_thread_t *stats;
+    size_t count;
+} tlsf_thread_sizes_t;
+
+static void tlsf_thread_size(void *ptr, size_t size, void *owner, void *context)
+{
+    tlsf_thread_sizes_t *threads = (tlsf_thread_sizes_t *)context;
+    for (size_t i = 0; i < threads->count; i++) {
+        if (threads->stats[i].id == (uintptr_t)owner) {
+            threads->stats[i].heap_size += size;
+            break;
+        }
+    }
+}
+
+// Called by mbed_stats_thread_get_each, walks the heap once for all threads
+extern "C" void mbed_heap_get_thread_sizes(mbed_stats_thread_t *stats, size_t count)
+{
+    tlsf_thread_sizes_t threads = { stats, count };
+    tlsf_lock();
+    mbed_tlsf_walk(&tlsf_heap, tlsf_thread_size, &threads);
+    tlsf_unlock();
+}
+#endif // #if MBED_CONF_PLATFORM_TLSF_HEAP_ENABLED
+
 void mbed_stats_heap_get(mbed_stats_heap_t *stats)
 {
+#if MBED_CONF_PLATFORM_TLSF_HEAP_ENABLED
+    memset(stats, 0, sizeof(mbed_stats_heap_t));
+
+    tlsf_lock();
 #ifdef MBED_HEAP_STATS_ENABLED
+    heap_stats.reserved_size = mbed_heap_size;
+    memcpy(stats, &heap_stats, sizeof(mbed_stats_heap_t));
+#endif
+    mbed_tlsf_stats_t tlsf_stats;
+    mbed_tlsf_get_stats(&tlsf_heap, &tlsf_stats);
+    tlsf_unlock();
+
+    stats->free_size = tlsf_stats.free_size;
+    stats->largest_free_size = tlsf_stats.largest_free_size;
+    stats->free_block_cnt = tlsf_stats.free_block_cnt;
+#elif defined(MBED_HEAP_STATS_ENABLED)
     extern uint32_t mbed_heap_size;
     heap_stats.reserved_size = mbed_heap_size;
 
@@ -103,7 +276,9 @@ extern "C" void *malloc_wrapper(struct _reent *r, size_t size, void *caller)
 #ifdef MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_lock();
 #endif
-#ifdef MBED_HEAP_STATS_ENABLED
+#if MBED_CONF_PLATFORM_TLSF_HEAP_ENABLED
+    ptr = tlsf_heap_malloc(size);
+#elif defined(MBED_HEAP_STATS_ENABLED)
     malloc_stats_mutex->lock();
     alloc_info_t *alloc_info = (alloc_info_t *)__real__malloc_r(r, size + sizeof(alloc_info_t));
     if (alloc_info != NULL) {
@@ -137,7 +312,9 @@ extern "C" void *__wrap__realloc_r(struct _reent *r, void *ptr, size_t size)
 #ifdef MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_lock();
 #endif
-#ifdef MBED_HEAP_STATS_ENABLED
+#if MBED_CONF_PLATFORM_TLSF_HEAP_ENABLED
+    new_ptr = tlsf_heap_realloc(ptr, size);
+#elif defined(MBED_HEAP_STATS_ENABLED)
     // Implement realloc_r with malloc and free.
     // The function realloc_r can't be used here directly since
     // it can call into __wrap__malloc_r (returns ptr + 4) or
@@ -184,7 +361,9 @@ extern "C" void free_wrapper(struct _reent *r, void *ptr, void *caller)
 #ifdef MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_lock();
 #endif
-#ifdef MBED_HEAP_STATS_ENABLED
+#if MBED_CONF_PLATFORM_TLSF_HEAP_ENABLED
+    tlsf_heap_free(ptr);
+#elif defined(MBED_HEAP_STATS_ENABLED)
     malloc_stats_mutex->lock();
     alloc_info_t *alloc_info = NULL;
     if (ptr != NULL) {
@@ -218,7 +397,9 @@ extern "C" void *__wrap__calloc_r(struct _reent *r, size_t nmemb, size_t size)
 #ifdef MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_lock();
 #endif
-#ifdef MBED_HEAP_STATS_ENABLED
+#if MBED_CONF_PLATFORM_TLSF_HEAP_ENABLED
+    ptr = tlsf_heap_calloc(nmemb, size);
+#elif defined(MBED_HEAP_STATS_ENABLED)
     // Note - no lock needed since malloc is thread safe
 
     ptr = malloc(nmemb * size);
@@ -237,7 +418,11 @@ extern "C" void *__wrap__calloc_r(struct _reent *r, size_t nmemb, size_t size)
 
 extern "C" void *__wrap__memalign_r(struct _reent *r, size_t alignment, size_t bytes)
 {
+#if MBED_CONF_PLATFORM_TLSF_HEAP_ENABLED
+    return tlsf_heap_memalign(alignment, bytes);
+#else
     return __real__memalign_r(r, alignment, bytes);
+#endif
 }
 
 
@@ -267,8 +452,8 @@ extern "C" void *__wrap__memalign_r(struct _reent *r, size_t alignment, size_t b
 #define SUB_FREE        $Sub$$__iar_dlfree
 #endif
 
-/* Enable hooking of memory function only if tracing is also enabled */
-#if defined(MBED_MEM_TRACING_ENABLED) || defined(MBED_HEAP_STATS_ENABLED)
+/* Enable hooking of memory function only if tracing or the TLSF heap is also enabled */
+#if defined(MBED_MEM_TRACING_ENABLED) || defined(MBED_HEAP_STATS_ENABLED) || MBED_CONF_PLATFORM_TLSF_HEAP_ENABLED
 
 extern "C" {
     void *SUPER_MALLOC(size_t size);
@@ -290,7 +475,9 @@ extern "C" void *malloc_wrapper(size_t size, void *caller)
 #ifdef MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_lock();
 #endif
-#ifdef MBED_HEAP_STATS_ENABLED
+#if MBED_CONF_PLATFORM_TLSF_HEAP_ENABLED
+    ptr = tlsf_heap_malloc(size);
+#elif defined(MBED_HEAP_STATS_ENABLED)
     malloc_stats_mutex->lock();
     alloc_info_t *alloc_info = (alloc_info_t *)SUPER_MALLOC(size + sizeof(alloc_info_t));
     if (alloc_info != NULL) {
@@ -325,7 +512,9 @@ extern "C" void *SUB_REALLOC(void *ptr, size_t size)
 #ifdef MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_lock();
 #endif
-#ifdef MBED_HEAP_STATS_ENABLED
+#if MBED_CONF_PLATFORM_TLSF_HEAP_ENABLED
+    new_ptr = tlsf_heap_realloc(ptr, size);
+#elif defined(MBED_HEAP_STATS_ENABLED)
     // Note - no lock needed since malloc and free are thread safe
 
     // Get old size
@@ -363,7 +552,9 @@ extern "C" void *SUB_CALLOC(size_t nmemb, size_t size)
 #ifdef MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_lock();
 #endif
-#ifdef MBED_HEAP_STATS_ENABLED
+#if MBED_CONF_PLATFORM_TLSF_HEAP_ENABLED
+    ptr = tlsf_heap_calloc(nmemb, size);
+#elif defined(MBED_HEAP_STATS_ENABLED)
     // Note - no lock needed since malloc is thread safe
     ptr = malloc(nmemb * size);
     if (ptr != NULL) {
@@ -389,7 +580,9 @@ extern "C" void free_wrapper(void *ptr, void *caller)
 #ifdef MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_lock();
 #endif
-#ifdef MBED_HEAP_STATS_ENABLED
+#if MBED_CONF_PLATFORM_TLSF_HEAP_ENABLED
+    tlsf_heap_free(ptr);
+#elif defined(MBED_HEAP_STATS_ENABLED)
     malloc_stats_mutex->lock();
     alloc_info_t *alloc_info = NULL;
     if (ptr != NULL) {
@@ -417,7 +610,7 @@ extern "C" void free_wrapper(void *ptr, void *caller)
 #endif // #ifdef MBED_MEM_TRACING_ENABLED
 }
 
-#endif // #if defined(MBED_MEM_TRACING_ENABLED) || defined(MBED_HEAP_STATS_ENABLED)
+#endif // #if defined(MBED_MEM_TRACING_ENABLED) || defined(MBED_HEAP_STATS_ENABLED) || MBED_CONF_PLATFORM_TLSF_HEAP_ENABLED
 
 /******************************************************************************/
 /* Allocation wrappers for other toolchains are not supported yet             */
@@ -433,4 +626,8 @@ extern "C" void free_wrapper(void *ptr, void *caller)
 #error Heap statistics are not supported with the current toolchain.
 #endif
 
+#if MBED_CONF_PLATFORM_TLSF_HEAP_ENABLED
+#error The TLSF heap is not supported with the current toolchain.
+#endif
+
 #endif // #if defined(TOOLCHAIN_GCC)
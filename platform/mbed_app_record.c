@@ -0,0 +1,192 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdbool.h>
+#include <string.h>
+#include "device.h"
+#include "platform/mbed_app_record.h"
+
+#if MBED_CONF_PLATFORM_APP_RECORD_ENABLED && !DEVICE_FLASH
+#error "Application records need the flash HAL"
+#endif
+
+#if MBED_CONF_PLATFORM_APP_RECORD_ENABLED
+
+#include "hal/flash_api.h"
+#include "mbedtls/sha256.h"
+
+#ifndef MBED_CONF_PLATFORM_APP_RECORD_ADDRESS
+#error platform.app-record-address must be set to a reserved flash region
+#endif
+
+#define APP_RECORD_ADDRESS      MBED_CONF_PLATFORM_APP_RECORD_ADDRESS
+#define APP_RECORD_SIZE         MBED_CONF_PLATFORM_APP_RECORD_SIZE
+#define APP_RECORD_SAMPLE_SIZE  MBED_CONF_PLATFORM_APP_RECORD_SAMPLE_SIZE
+
+// The record is programmed in one go, from a buffer of whole flash pages
+#define APP_RECORD_BUFFER       256
+
+static uint32_t app_record_page[APP_RECORD_BUFFER / 4];
+
+// Bitwise CRC-32, the sample is small and checked once per boot
+static uint32_t app_record_crc(uint32_t crc, const void *data, size_t size)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    crc = ~crc;
+    while (size--) {
+        crc ^= *p++;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc >> 1) ^ (0xEDB88320UL & -(crc & 1));
+        }
+    }
+    return ~crc;
+}
+
+static uint32_t app_record_self_crc(const mbed_app_record_t *record)
+{
+    return app_record_crc(0, &record->crc + 1,
+                          sizeof(*record) - offsetof(mbed_app_record_t, crc) - sizeof(record->crc));
+}
+
+static uint32_t app_record_sample_crc(uintptr_t address, uint32_t size)
+{
+    return app_record_crc(0, (const void *)address, size < APP_RECORD_SAMPLE_SIZE ? size : APP_RECORD_SAMPLE_SIZE);
+}
+
+static int app_record_erase(flash_t *flash)
+{
+    uint32_t addr = APP_RECORD_ADDRESS;
+    while (addr < APP_RECORD_ADDRESS + APP_RECORD_SIZE) {
+        uint32_t sector = flash_get_sector_size(flash, addr);
+        if (sector == MBED_FLASH_INVALID_SIZE || flash_erase_sector(flash, addr) != 0) {
+            return -1;
+        }
+        addr += sector;
+    }
+    return 0;
+}
+
+static mbed_error_status_t app_record_write(const mbed_app_record_t *record)
+{
+    flash_t flash;
+    mbed_error_status_t status = MBED_ERROR_FAILED_OPERATION;
+
+    if (flash_init(&flash) != 0) {
+        return MBED_ERROR_FAILED_OPERATION;
+    }
+    uint32_t page = flash_get_page_size(&flash);
+    uint32_t size = (sizeof(*record) + page - 1) / page * page;
+    if (size <= APP_RECORD_BUFFER && size <= APP_RECORD_SIZE && app_record_erase(&flash) == 0) {
+        memset(app_record_page, flash_get_erase_value(&flash), size);
+        memcpy(app_record_page, record, sizeof(*record));
+        if (flash_program_page(&flash, APP_RECORD_ADDRESS, (const uint8_t *)app_record_page, size) == 0) {
+            status = MBED_SUCCESS;
+        }
+    }
+    flash_free(&flash);
+    return status;
+}
+
+mbed_error_status_t mbed_app_record_read(mbed_app_record_t *record)
+{
+    flash_t flash;
+    mbed_error_status_t status = MBED_SUCCESS;
+
+    if (flash_init(&flash) != 0) {
+        return MBED_ERROR_FAILED_OPERATION;
+    }
+    if (flash_read(&flash, APP_RECORD_ADDRESS, (uint8_t *)record, sizeof(*record)) != 0) {
+        status = MBED_ERROR_FAILED_OPERATION;
+    } else if (record->magic != MBED_APP_RECORD_MAGIC) {
+        status = MBED_ERROR_ITEM_NOT_FOUND;
+    } else if (record->crc != app_record_self_crc(record)) {
+        status = MBED_ERROR_INVALID_DATA_DETECTED;
+    }
+    flash_free(&flash);
+    return status;
+}
+
+mbed_error_status_t mbed_app_record_clear(void)
+{
+    flash_t flash;
+    mbed_error_status_t status = MBED_SUCCESS;
+    mbed_app_record_t record;
+
+    if (flash_init(&flash) != 0) {
+        return MBED_ERROR_FAILED_OPERATION;
+    }
+    // Nothing to erase when there's no record, saves a sector erase per update
+    if (flash_read(&flash, APP_RECORD_ADDRESS, (uint8_t *)&record, sizeof(record)) != 0 ||
+            record.magic != (uint32_t)(flash_get_erase_value(&flash) * 0x01010101UL)) {
+        if (app_record_erase(&flash) != 0) {
+            status = MBED_ERROR_FAILED_OPERATION;
+        }
+    }
+    flash_free(&flash);
+    return status;
+}
+
+mbed_error_status_t mbed_app_verify(uintptr_t address, uint32_t size, uint32_t version,
+                                    const uint8_t hash[MBED_APP_HASH_SIZE])
+{
+    mbed_app_record_t record;
+    uint32_t sample_crc = app_record_sample_crc(address, size);
+
+    if (mbed_app_record_read(&record) == MBED_SUCCESS &&
+            record.address == address && record.size == size && record.version == version &&
+            record.sample_crc == sample_crc && memcmp(record.hash, hash, MBED_APP_HASH_SIZE) == 0) {
+        return MBED_SUCCESS;
+    }
+
+    uint8_t digest[MBED_APP_HASH_SIZE];
+    if (mbedtls_sha256_ret((const unsigned char *)address, size, digest, 0) != 0 ||
+            memcmp(digest, hash, MBED_APP_HASH_SIZE) != 0) {
+        mbed_app_record_clear();
+        return MBED_ERROR_INVALID_DATA_DETECTED;
+    }
+
+    memset(&record, 0, sizeof(record));
+    record.magic = MBED_APP_RECORD_MAGIC;
+    record.address = address;
+    record.size = size;
+    record.version = version;
+    record.sample_crc = sample_crc;
+    memcpy(record.hash, digest, MBED_APP_HASH_SIZE);
+    record.crc = app_record_self_crc(&record);
+    app_record_write(&record);
+
+    return MBED_SUCCESS;
+}
+
+#else
+
+mbed_error_status_t mbed_app_verify(uintptr_t address, uint32_t size, uint32_t version,
+                                    const uint8_t hash[MBED_APP_HASH_SIZE])
+{
+    return MBED_ERROR_UNSUPPORTED;
+}
+
+mbed_error_status_t mbed_app_record_read(mbed_app_record_t *record)
+{
+    return MBED_ERROR_UNSUPPORTED;
+}
+
+mbed_error_status_t mbed_app_record_clear(void)
+{
+    return MBED_ERROR_UNSUPPORTED;
+}
+
+#endif
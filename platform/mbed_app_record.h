@@ -0,0 +1,107 @@
+/** \addtogroup platform */
+/** @{*/
+/**
+ * \defgroup platform_app_record Verified application record
+ * @{
+ */
+
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_APP_RECORD_H
+#define MBED_APP_RECORD_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "platform/mbed_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Verified application record, for bootloaders
+ *
+ * When platform.app-record-enabled is set, mbed_app_verify() checks an
+ * application image against the SHA-256 hash of its header once, then
+ * writes a record of the verified image to the flash region at
+ * platform.app-record-address. On the next boots the image is taken as
+ * verified without hashing it again when the record matches the header
+ * and the first platform.app-record-sample-size bytes of the image are
+ * unchanged.
+ *
+ * The sample only catches accidental changes, the record is what the
+ * bootloader trusts: it must call mbed_app_record_clear() before writing
+ * a new image, and the region must be reserved, out of the application
+ * and any KVStore, and write-protected from the application if the
+ * target allows it.
+ */
+
+#define MBED_APP_RECORD_MAGIC   0x44524341UL    /**< "ACRD" */
+#define MBED_APP_HASH_SIZE      32
+
+/** Record of a verified image */
+typedef struct {
+    uint32_t magic;                     /**< MBED_APP_RECORD_MAGIC */
+    uint32_t crc;                       /**< CRC-32 of the record from the next member on */
+    uint32_t address;                   /**< Start address of the image */
+    uint32_t size;                      /**< Size of the image in bytes */
+    uint32_t version;                   /**< Version of the image, from its header */
+    uint32_t sample_crc;                /**< CRC-32 of the first bytes of the image */
+    uint8_t hash[MBED_APP_HASH_SIZE];   /**< SHA-256 of the image */
+} mbed_app_record_t;
+
+/** Verify an application image, from the record when it is unchanged
+ *
+ *  @param address  Start address of the image, in memory-mapped flash
+ *  @param size     Size of the image in bytes
+ *  @param version  Version of the image, from its header
+ *  @param hash     Expected SHA-256 of the image, from its header
+ *  @return         MBED_SUCCESS if the image is verified,
+ *                  MBED_ERROR_INVALID_DATA_DETECTED if its hash doesn't
+ *                  match, MBED_ERROR_UNSUPPORTED if records aren't enabled
+ *
+ *  @note A failed verification clears the record. Failing to write the
+ *        record isn't an error, the next boot hashes the image again.
+ */
+mbed_error_status_t mbed_app_verify(uintptr_t address, uint32_t size, uint32_t version,
+                                    const uint8_t hash[MBED_APP_HASH_SIZE]);
+
+/** Read the record of the last verified image
+ *
+ *  @param record   Filled with the record
+ *  @return         MBED_SUCCESS, MBED_ERROR_ITEM_NOT_FOUND if there is no
+ *                  record, MBED_ERROR_INVALID_DATA_DETECTED if it is
+ *                  corrupted, MBED_ERROR_UNSUPPORTED if records aren't
+ *                  enabled
+ */
+mbed_error_status_t mbed_app_record_read(mbed_app_record_t *record);
+
+/** Erase the record, so the next mbed_app_verify() hashes the image
+ *
+ *  @return         MBED_SUCCESS, MBED_ERROR_FAILED_OPERATION if the flash
+ *                  couldn't be erased, MBED_ERROR_UNSUPPORTED if records
+ *                  aren't enabled
+ */
+mbed_error_status_t mbed_app_record_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/** @}*/
+/** @}*/
@@ -54,8 +54,12 @@ static void powerdown_gic()
 
 #else
 
+#if MBED_CONF_PLATFORM_APPLICATION_JUMP_MINIMAL_TEARDOWN
+static void disable_nvic(void);
+#else
 static void powerdown_nvic(void);
 static void powerdown_scb(uint32_t vtor);
+#endif
 static void start_new_application(void *sp, void *pc);
 
 void mbed_start_application(uintptr_t address)
@@ -67,8 +71,14 @@ void mbed_start_application(uintptr_t address)
     __disable_irq();
 
     SysTick->CTRL = 0x00000000;
+#if MBED_CONF_PLATFORM_APPLICATION_JUMP_MINIMAL_TEARDOWN
+    disable_nvic();
+    SCB->ICSR = SCB_ICSR_PENDSVCLR_Msk | SCB_ICSR_PENDSTCLR_Msk;
+    SCB->VTOR = address;
+#else
     powerdown_nvic();
     powerdown_scb(address);
+#endif
     mbed_mpu_manager_deinit();
 
 #ifdef MBED_DEBUG
@@ -87,6 +97,26 @@ void mbed_start_application(uintptr_t address)
     start_new_application(sp, pc);
 }
 
+#if MBED_CONF_PLATFORM_APPLICATION_JUMP_MINIMAL_TEARDOWN
+
+static void disable_nvic()
+{
+    int isr_groups_32;
+    int i;
+
+#if defined(__CORTEX_M23)
+    isr_groups_32 = 8;
+#else
+    isr_groups_32 = ((SCnSCB->ICTR & SCnSCB_ICTR_INTLINESNUM_Msk) >> SCnSCB_ICTR_INTLINESNUM_Pos) + 1;
+#endif
+    for (i = 0; i < isr_groups_32; i++) {
+        NVIC->ICER[i] = 0xFFFFFFFF;
+        NVIC->ICPR[i] = 0xFFFFFFFF;
+    }
+}
+
+#else
+
 static void powerdown_nvic()
 {
     int isr_groups_32;
@@ -154,6 +184,8 @@ static void powerdown_scb(uint32_t vtor)
     // SCB->CPACR   - Implementation defined value
 }
 
+#endif
+
 #if defined (__CC_ARM)
 
 __asm static void start_new_application(void *sp, void *pc)
@@ -39,7 +39,10 @@ extern "C" {
  *  socket connections before calling this function. For Cortex-M
  *  devices this function powers down generic system components such as
  *  the NVIC and set the vector table to that of the new image followed
- *  by jumping to the reset handler of the new image.
+ *  by jumping to the reset handler of the new image. With
+ *  platform.application-jump-minimal-teardown set, only the NVIC
+ *  interrupts are disabled and the vector table is set, the new image
+ *  sets up the rest.
  *
  *  @param address    Starting address of next application to run
  */
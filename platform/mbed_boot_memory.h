@@ -0,0 +1,102 @@
+
+/** \addtogroup platform */
+/** @{*/
+/**
+ * \defgroup platform_boot_memory Boot memory initialization
+ * @{
+ */
+
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_BOOT_MEMORY_H
+#define MBED_BOOT_MEMORY_H
+
+#include <stdint.h>
+
+/* Helpers for the startup code of targets, to copy .data and zero .bss
+ * before the C library is initialized. They only use registers and the
+ * stack.
+ *
+ * Eight words are moved per iteration, which compilers turn into LDM/STM
+ * bursts on Cortex-M. Loop distribution is disabled on GCC, as it would
+ * replace the loops with calls to memcpy and memset, which are byte loops
+ * in newlib-nano. This also keeps GCC from inlining them.
+ */
+
+#if defined(__GNUC__) && !defined(__clang__) && !defined(__CC_ARM)
+#define MBED_BOOT_MEMORY_FUNC static __attribute__((unused, optimize("no-tree-loop-distribute-patterns")))
+#else
+#define MBED_BOOT_MEMORY_FUNC static inline
+#endif
+
+/** Copy words from ROM to RAM
+ *
+ * @param dst Start of the destination, word aligned
+ * @param src Start of the source, word aligned
+ * @param end End of the destination, word aligned
+ */
+MBED_BOOT_MEMORY_FUNC void mbed_boot_copy_words(uint32_t *dst, const uint32_t *src, uint32_t *end)
+{
+    if (dst == src) {
+        return;
+    }
+    while (end - dst >= 8) {
+        uint32_t a = src[0], b = src[1], c = src[2], d = src[3];
+        uint32_t e = src[4], f = src[5], g = src[6], h = src[7];
+        dst[0] = a;
+        dst[1] = b;
+        dst[2] = c;
+        dst[3] = d;
+        dst[4] = e;
+        dst[5] = f;
+        dst[6] = g;
+        dst[7] = h;
+        dst += 8;
+        src += 8;
+    }
+    while (dst < end) {
+        *dst++ = *src++;
+    }
+}
+
+/** Zero words of RAM
+ *
+ * @param dst Start of the memory, word aligned
+ * @param end End of the memory, word aligned
+ */
+MBED_BOOT_MEMORY_FUNC void mbed_boot_zero_words(uint32_t *dst, uint32_t *end)
+{
+    while (end - dst >= 8) {
+        dst[0] = 0;
+        dst[1] = 0;
+        dst[2] = 0;
+        dst[3] = 0;
+        dst[4] = 0;
+        dst[5] = 0;
+        dst[6] = 0;
+        dst[7] = 0;
+        dst += 8;
+    }
+    while (dst < end) {
+        *dst++ = 0;
+    }
+}
+
+#endif
+
+/** @}*/
+/** @}*/
@@ -0,0 +1,292 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdbool.h>
+#include <string.h>
+#include "device.h"
+#include "platform/mbed_crash_dump.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_toolchain.h"
+
+#if MBED_CONF_PLATFORM_CRASH_DUMP_ENABLED && !DEVICE_FLASH
+#error "Crash dumps need the flash HAL"
+#endif
+
+#if MBED_CONF_PLATFORM_CRASH_DUMP_ENABLED
+
+#include "hal/flash_api.h"
+#if defined(__CORTEX_M) && !defined(MBED_FAULT_HANDLER_DISABLED)
+#include "mbed_fault_handler.h"
+#endif
+#ifdef MBED_CONF_RTOS_PRESENT
+#include "mbed_boot.h"
+#endif
+
+#ifndef MBED_CONF_PLATFORM_CRASH_DUMP_ADDRESS
+#error platform.crash-dump-address must be set to a reserved flash region
+#endif
+
+#define CRASH_DUMP_ADDRESS  MBED_CONF_PLATFORM_CRASH_DUMP_ADDRESS
+#define CRASH_DUMP_SIZE     MBED_CONF_PLATFORM_CRASH_DUMP_SIZE
+#define CRASH_DUMP_BUFFER   MBED_CONF_PLATFORM_CRASH_DUMP_BUFFER_SIZE
+
+MBED_STATIC_ASSERT(CRASH_DUMP_SIZE > sizeof(mbed_crash_dump_t),
+                   "platform.crash-dump-size is too small for the dump header");
+
+// Static rather than on the stack, which may have overflowed
+static mbed_crash_dump_t crash_dump;
+static uint32_t crash_dump_page[CRASH_DUMP_BUFFER / 4];
+
+// Bitwise CRC-32, the dump is written once and checked once
+static uint32_t crash_dump_crc(uint32_t crc, const void *data, size_t size)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    crc = ~crc;
+    while (size--) {
+        crc ^= *p++;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc >> 1) ^ (0xEDB88320UL & -(crc & 1));
+        }
+    }
+    return ~crc;
+}
+
+// Copy bytes of the dump being written, from the header then the stack
+static void crash_dump_copy(uint8_t *dst, uint32_t offset, uint32_t size)
+{
+    for (uint32_t i = 0; i < size; i++, offset++) {
+        if (offset < sizeof(crash_dump)) {
+            dst[i] = ((const uint8_t *)&crash_dump)[offset];
+        } else if (offset < crash_dump.size) {
+            dst[i] = ((const uint8_t *)crash_dump.stack_addr)[offset - sizeof(crash_dump)];
+        } else {
+            dst[i] = 0;
+        }
+    }
+}
+
+static int crash_dump_erase(flash_t *flash)
+{
+    uint32_t addr = CRASH_DUMP_ADDRESS;
+    while (addr < CRASH_DUMP_ADDRESS + CRASH_DUMP_SIZE) {
+        uint32_t sector = flash_get_sector_size(flash, addr);
+        if (sector == MBED_FLASH_INVALID_SIZE || flash_erase_sector(flash, addr) != 0) {
+            return -1;
+        }
+        addr += sector;
+    }
+    return 0;
+}
+
+static bool crash_dump_erased(flash_t *flash, uint32_t size)
+{
+    uint8_t erase_value = flash_get_erase_value(flash);
+    uint8_t *buf = (uint8_t *)crash_dump_page;
+    for (uint32_t offset = 0; offset < size; offset += CRASH_DUMP_BUFFER) {
+        uint32_t n = size - offset < CRASH_DUMP_BUFFER ? size - offset : CRASH_DUMP_BUFFER;
+        if (flash_read(flash, CRASH_DUMP_ADDRESS + offset, buf, n) != 0) {
+            return false;
+        }
+        for (uint32_t i = 0; i < n; i++) {
+            if (buf[i] != erase_value) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Locate the stack the error happened on, and capture it from the stack
+// pointer up, as far as the region allows
+static void crash_dump_capture_stack(const mbed_error_ctx *error_ctx)
+{
+    uint32_t sp = error_ctx->thread_current_sp;
+    if (crash_dump.fault_valid) {
+        // SP saved by the fault handler, from before the exception
+        sp = crash_dump.fault_regs[13];
+    }
+#if defined(__CORTEX_M)
+    if (sp == 0) {
+        sp = __get_MSP();
+    }
+#endif
+
+    // A stack pointer out of the known stacks isn't followed, it may point
+    // to unmapped memory
+    uint32_t top = 0;
+    if (sp >= error_ctx->thread_stack_mem &&
+            sp < error_ctx->thread_stack_mem + error_ctx->thread_stack_size) {
+        top = error_ctx->thread_stack_mem + error_ctx->thread_stack_size;
+    }
+#ifdef MBED_CONF_RTOS_PRESENT
+    else if (sp >= (uint32_t)mbed_stack_isr_start &&
+             sp < (uint32_t)mbed_stack_isr_start + mbed_stack_isr_size) {
+        top = (uint32_t)mbed_stack_isr_start + mbed_stack_isr_size;
+    }
+#elif defined(__CORTEX_M)
+    else {
+        // Main stack, its initial value is the first entry of the vector table
+        top = *(const uint32_t *)SCB->VTOR;
+    }
+#endif
+
+    uint32_t len = 0;
+    if (top > sp) {
+        len = top - sp;
+    }
+    if (len > CRASH_DUMP_SIZE - sizeof(crash_dump)) {
+        len = CRASH_DUMP_SIZE - sizeof(crash_dump);
+    }
+    crash_dump.stack_top = top;
+    crash_dump.stack_addr = sp;
+    crash_dump.stack_len = len;
+}
+
+void mbed_crash_dump_write(const mbed_error_ctx *error_ctx)
+{
+    memset(&crash_dump, 0, sizeof(crash_dump));
+    crash_dump.version = MBED_CRASH_DUMP_VERSION;
+    memcpy(&crash_dump.error_ctx, error_ctx, sizeof(mbed_error_ctx));
+
+#if defined(__CORTEX_M) && !defined(MBED_FAULT_HANDLER_DISABLED)
+    extern mbed_fault_context_t *const mbed_fault_context;
+    int code = MBED_GET_ERROR_CODE(error_ctx->error_status);
+    if (code == MBED_ERROR_CODE_HARDFAULT_EXCEPTION || code == MBED_ERROR_CODE_MEMMANAGE_EXCEPTION ||
+            code == MBED_ERROR_CODE_BUSFAULT_EXCEPTION || code == MBED_ERROR_CODE_USAGEFAULT_EXCEPTION) {
+        crash_dump.fault_valid = 1;
+        memcpy(crash_dump.fault_regs, mbed_fault_context, sizeof(crash_dump.fault_regs));
+    }
+#endif
+#if defined(SCB_CFSR_MEMFAULTSR_Pos)
+    crash_dump.cfsr = SCB->CFSR;
+    crash_dump.hfsr = SCB->HFSR;
+    crash_dump.mmfar = SCB->MMFAR;
+    crash_dump.bfar = SCB->BFAR;
+#endif
+
+    // The heap stats take a mutex
+    if (!core_util_is_isr_active() && core_util_are_interrupts_enabled()) {
+        mbed_stats_heap_get(&crash_dump.heap_stats);
+    }
+    mbed_stats_sys_get(&crash_dump.sys_stats);
+
+    crash_dump_capture_stack(error_ctx);
+    crash_dump.size = sizeof(crash_dump) + crash_dump.stack_len;
+    crash_dump.crc = crash_dump_crc(0, &crash_dump.crc + 1,
+                                    sizeof(crash_dump) - offsetof(mbed_crash_dump_t, crc) - sizeof(crash_dump.crc));
+    crash_dump.crc = crash_dump_crc(crash_dump.crc, (const void *)crash_dump.stack_addr, crash_dump.stack_len);
+    crash_dump.magic = MBED_CRASH_DUMP_MAGIC;
+
+    flash_t flash;
+    core_util_critical_section_enter();
+    if (flash_init(&flash) != 0) {
+        core_util_critical_section_exit();
+        return;
+    }
+    uint32_t page = flash_get_page_size(&flash);
+    uint32_t chunk = CRASH_DUMP_BUFFER - CRASH_DUMP_BUFFER % page;
+    uint32_t size = (crash_dump.size + page - 1) / page * page;
+    if (page <= CRASH_DUMP_BUFFER && size <= CRASH_DUMP_SIZE &&
+            (crash_dump_erased(&flash, size) || crash_dump_erase(&flash) == 0)) {
+        // Program backwards, so the magic number at the start is written
+        // last and an interrupted dump isn't taken for a valid one
+        uint32_t offset = (size - 1) / chunk * chunk;
+        while (true) {
+            uint32_t n = size - offset < chunk ? size - offset : chunk;
+            crash_dump_copy((uint8_t *)crash_dump_page, offset, n);
+            if (flash_program_page(&flash, CRASH_DUMP_ADDRESS + offset, (const uint8_t *)crash_dump_page, n) != 0 ||
+                    offset == 0) {
+                break;
+            }
+            offset -= chunk;
+        }
+    }
+    flash_free(&flash);
+    core_util_critical_section_exit();
+}
+
+mbed_error_status_t mbed_crash_dump_read(mbed_crash_dump_t *dump, void *stack, size_t stack_size)
+{
+    flash_t flash;
+    mbed_error_status_t status = MBED_SUCCESS;
+
+    if (flash_init(&flash) != 0) {
+        return MBED_ERROR_FAILED_OPERATION;
+    }
+    if (flash_read(&flash, CRASH_DUMP_ADDRESS, (uint8_t *)dump, sizeof(*dump)) != 0) {
+        status = MBED_ERROR_FAILED_OPERATION;
+    } else if (dump->magic != MBED_CRASH_DUMP_MAGIC) {
+        status = MBED_ERROR_ITEM_NOT_FOUND;
+    } else if (dump->version != MBED_CRASH_DUMP_VERSION || dump->size != sizeof(*dump) + dump->stack_len ||
+               dump->size > CRASH_DUMP_SIZE) {
+        status = MBED_ERROR_INVALID_DATA_DETECTED;
+    } else {
+        // Check the CRC over the stack in flash, then copy what fits
+        uint32_t crc = crash_dump_crc(0, &dump->crc + 1,
+                                      sizeof(*dump) - offsetof(mbed_crash_dump_t, crc) - sizeof(dump->crc));
+        uint8_t buf[64];
+        for (uint32_t offset = 0; offset < dump->stack_len; offset += sizeof(buf)) {
+            uint32_t n = dump->stack_len - offset < sizeof(buf) ? dump->stack_len - offset : sizeof(buf);
+            if (flash_read(&flash, CRASH_DUMP_ADDRESS + sizeof(*dump) + offset, buf, n) != 0) {
+                status = MBED_ERROR_FAILED_OPERATION;
+                break;
+            }
+            crc = crash_dump_crc(crc, buf, n);
+            if (stack && offset < stack_size) {
+                memcpy((uint8_t *)stack + offset, buf, stack_size - offset < n ? stack_size - offset : n);
+            }
+        }
+        if (status == MBED_SUCCESS && crc != dump->crc) {
+            status = MBED_ERROR_INVALID_DATA_DETECTED;
+        }
+    }
+    flash_free(&flash);
+    return status;
+}
+
+mbed_error_status_t mbed_crash_dump_clear(void)
+{
+    flash_t flash;
+    mbed_error_status_t status = MBED_SUCCESS;
+
+    if (flash_init(&flash) != 0) {
+        return MBED_ERROR_FAILED_OPERATION;
+    }
+    if (!crash_dump_erased(&flash, CRASH_DUMP_SIZE) && crash_dump_erase(&flash) != 0) {
+        status = MBED_ERROR_FAILED_OPERATION;
+    }
+    flash_free(&flash);
+    return status;
+}
+
+#else
+
+void mbed_crash_dump_write(const mbed_error_ctx *error_ctx)
+{
+}
+
+mbed_error_status_t mbed_crash_dump_read(mbed_crash_dump_t *dump, void *stack, size_t stack_size)
+{
+    return MBED_ERROR_UNSUPPORTED;
+}
+
+mbed_error_status_t mbed_crash_dump_clear(void)
+{
+    return MBED_ERROR_UNSUPPORTED;
+}
+
+#endif
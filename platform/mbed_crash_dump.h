@@ -0,0 +1,110 @@
+/** \addtogroup platform */
+/** @{*/
+/**
+ * \defgroup platform_crash_dump Crash dump functions
+ * @{
+ */
+
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_CRASH_DUMP_H
+#define MBED_CRASH_DUMP_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "platform/mbed_error.h"
+#include "platform/mbed_stats.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Crash dumps to internal flash
+ *
+ * When platform.crash-dump-enabled is set, a fatal error writes a dump to
+ * the flash region at platform.crash-dump-address, of
+ * platform.crash-dump-size bytes. The dump holds the error context, the
+ * registers of a fault exception, heap and system stats, and as much of
+ * the stack of the failing context as fits, starting from its stack
+ * pointer. It is readable after the reset with mbed_crash_dump_read().
+ *
+ * The dump is written with the flash HAL, which doesn't need interrupts
+ * or the RTOS. Nothing is done at boot: the region is erased when the
+ * dump is written, or beforehand by mbed_crash_dump_clear() so the next
+ * fatal error only has to program it. The region must be reserved, out
+ * of the application and any KVStore.
+ */
+
+#define MBED_CRASH_DUMP_MAGIC   0x504D5544UL    /**< "DUMP" */
+#define MBED_CRASH_DUMP_VERSION 1
+
+/** Header of a crash dump, followed by the captured stack */
+typedef struct {
+    uint32_t magic;                 /**< MBED_CRASH_DUMP_MAGIC */
+    uint32_t version;               /**< MBED_CRASH_DUMP_VERSION */
+    uint32_t size;                  /**< Size of the header and the stack in bytes */
+    uint32_t crc;                   /**< CRC-32 of the dump from the next member on */
+    mbed_error_ctx error_ctx;       /**< Context of the fatal error */
+    uint32_t fault_valid;           /**< 1 if the error is a fault exception, and the next members are set */
+    uint32_t fault_regs[21];        /**< Registers saved by the fault handler, in mbed_fault_context_t order */
+    uint32_t cfsr;                  /**< Configurable Fault Status Register */
+    uint32_t hfsr;                  /**< HardFault Status Register */
+    uint32_t mmfar;                 /**< MemManage Fault Address Register */
+    uint32_t bfar;                  /**< BusFault Address Register */
+    mbed_stats_heap_t heap_stats;   /**< Heap stats, zero when the error came from an interrupt or critical section */
+    mbed_stats_sys_t sys_stats;     /**< System stats */
+    uint32_t stack_top;             /**< End of the stack of the failing context */
+    uint32_t stack_addr;            /**< Address of the first captured stack byte */
+    uint32_t stack_len;             /**< Number of captured stack bytes following the header */
+} mbed_crash_dump_t;
+
+/** Read the crash dump written by the last fatal error
+ *
+ *  @param dump         Header of the dump
+ *  @param stack        Buffer for the captured stack, or NULL
+ *  @param stack_size   Size of the buffer, a longer stack is truncated
+ *  @return             MBED_SUCCESS, MBED_ERROR_ITEM_NOT_FOUND if there is
+ *                      no dump, MBED_ERROR_INVALID_DATA_DETECTED if the dump
+ *                      is corrupted, MBED_ERROR_UNSUPPORTED if dumps aren't
+ *                      enabled
+ */
+mbed_error_status_t mbed_crash_dump_read(mbed_crash_dump_t *dump, void *stack, size_t stack_size);
+
+/** Erase the crash dump, so the next one is written without erasing
+ *
+ *  @return             MBED_SUCCESS, MBED_ERROR_FAILED_OPERATION if the flash
+ *                      couldn't be erased, MBED_ERROR_UNSUPPORTED if dumps
+ *                      aren't enabled
+ *
+ *  @note You cannot call this function from ISR context.
+ */
+mbed_error_status_t mbed_crash_dump_clear(void);
+
+/** Write a crash dump of the given error, called by mbed_error()
+ *
+ *  @param error_ctx    Context of the fatal error
+ */
+void mbed_crash_dump_write(const mbed_error_ctx *error_ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/** @}*/
+/** @}*/
@@ -23,6 +23,7 @@
 #include "platform/mbed_assert.h"
 #include "platform/mbed_critical.h"
 #include "platform/mbed_toolchain.h"
+#include "platform/mbed_stats.h"
 
 // if __EXCLUSIVE_ACCESS rtx macro not defined, we need to get this via own-set architecture macros
 #ifndef MBED_EXCLUSIVE_ACCESS
@@ -83,6 +84,12 @@ void core_util_critical_section_enter(void)
     MBED_ASSERT(critical_section_reentrancy_counter < UINT32_MAX);
 
     ++critical_section_reentrancy_counter;
+
+#if defined(MBED_IRQ_STATS_ENABLED)
+    if (critical_section_reentrancy_counter == 1) {
+        mbed_stats_critical_section_entered(MBED_CALLER_ADDR());
+    }
+#endif
 }
 
 void core_util_critical_section_exit(void)
@@ -96,6 +103,9 @@ void core_util_critical_section_exit(void)
     --critical_section_reentrancy_counter;
 
     if (critical_section_reentrancy_counter == 0) {
+#if defined(MBED_IRQ_STATS_ENABLED)
+        mbed_stats_critical_section_exiting();
+#endif
         hal_critical_section_exit();
     }
 }
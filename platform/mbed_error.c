@@ -19,6 +19,7 @@
 #include <string.h>
 #include "device.h"
 #include "platform/mbed_crash_data_offsets.h"
+#include "platform/mbed_crash_dump.h"
 #include "platform/mbed_retarget.h"
 #include "platform/mbed_critical.h"
 #include "platform/mbed_error.h"
@@ -26,6 +27,8 @@
 #include "platform/mbed_interface.h"
 #include "platform/mbed_power_mgmt.h"
 #include "platform/mbed_stats.h"
+#include "hal/ticker_api.h"
+#include "hal/us_ticker_api.h"
 #ifdef MBED_CONF_RTOS_PRESENT
 #include "rtx_os.h"
 #endif
@@ -54,6 +57,58 @@ static mbed_error_ctx last_error_ctx = {0};
 static mbed_error_hook_t error_hook = NULL;
 static mbed_error_status_t handle_error(mbed_error_status_t error_status, unsigned int error_value, const char *filename, int line_number, void *caller);
 
+#if MBED_CONF_PLATFORM_ERROR_RATE_LIMIT
+typedef struct {
+    volatile uint32_t status;
+    volatile uint32_t window_start;
+    volatile uint32_t count;
+} error_rate_t;
+
+static error_rate_t error_rates[MBED_CONF_PLATFORM_ERROR_RATE_LIMIT_CODES];
+static volatile uint32_t error_suppressed_count = 0;
+
+//Check a warning against the rate limit of its status, without locking
+static bool error_rate_limited(mbed_error_status_t error_status)
+{
+    uint32_t status = (uint32_t)error_status;
+    error_rate_t *rate = NULL;
+
+    for (int i = 0; i < MBED_CONF_PLATFORM_ERROR_RATE_LIMIT_CODES; i++) {
+        uint32_t current = core_util_atomic_load_u32(&error_rates[i].status);
+        if (current == 0) {
+            //Claim a free entry, or use the one another caller just claimed for this status
+            if (!core_util_atomic_cas_u32(&error_rates[i].status, &current, status) && current != status) {
+                continue;
+            }
+            current = status;
+        }
+        if (current == status) {
+            rate = &error_rates[i];
+            break;
+        }
+    }
+
+    //Statuses beyond the table aren't limited
+    if (rate == NULL) {
+        return false;
+    }
+
+    uint32_t now = (uint32_t)(ticker_read_us(get_us_ticker_data()) / 1000);
+    uint32_t start = core_util_atomic_load_u32(&rate->window_start);
+    if (now - start >= MBED_CONF_PLATFORM_ERROR_RATE_LIMIT_WINDOW_MS) {
+        if (core_util_atomic_cas_u32(&rate->window_start, &start, now)) {
+            core_util_atomic_store_u32(&rate->count, 0);
+        }
+    }
+
+    if (core_util_atomic_incr_u32(&rate->count, 1) > MBED_CONF_PLATFORM_ERROR_RATE_LIMIT) {
+        core_util_atomic_incr_u32(&error_suppressed_count, 1);
+        return true;
+    }
+    return false;
+}
+#endif
+
 #if MBED_CONF_PLATFORM_CRASH_CAPTURE_ENABLED
 //Global for populating the context in exception handler
 static mbed_error_ctx *const report_error_ctx = (mbed_error_ctx *)(ERROR_CONTEXT_LOCATION);
@@ -179,11 +234,6 @@ static mbed_error_status_t handle_error(mbed_error_status_t error_status, unsign
     //copy this error to last error
     memcpy(&last_error_ctx, &current_error_ctx, sizeof(mbed_error_ctx));
 
-#if MBED_CONF_PLATFORM_ERROR_HIST_ENABLED
-    //Log the error with error log
-    mbed_error_hist_put(&current_error_ctx);
-#endif
-
     //Call the error hook if available
     if (error_hook != NULL) {
         error_hook(&last_error_ctx);
@@ -191,6 +241,11 @@ static mbed_error_status_t handle_error(mbed_error_status_t error_status, unsign
 
     core_util_critical_section_exit();
 
+#if MBED_CONF_PLATFORM_ERROR_HIST_ENABLED
+    //Log the error with error log, it takes no lock
+    mbed_error_hist_put(&current_error_ctx);
+#endif
+
     return MBED_SUCCESS;
 }
 
@@ -259,9 +314,25 @@ int mbed_get_error_count(void)
 //Sets a non-fatal error
 mbed_error_status_t mbed_warning(mbed_error_status_t error_status, const char *error_msg, unsigned int error_value, const char *filename, int line_number)
 {
+#if MBED_CONF_PLATFORM_ERROR_RATE_LIMIT
+    //Drop warnings flooding with the same status
+    if (error_rate_limited(error_status)) {
+        return MBED_SUCCESS;
+    }
+#endif
     return handle_error(error_status, error_value, filename, line_number, MBED_CALLER_ADDR());
 }
 
+//Gets the number of warnings dropped by the rate limit
+int mbed_get_error_suppressed_count(void)
+{
+#if MBED_CONF_PLATFORM_ERROR_RATE_LIMIT
+    return core_util_atomic_load_u32(&error_suppressed_count);
+#else
+    return 0;
+#endif
+}
+
 //Sets a fatal error, this function is marked WEAK to be able to override this for some tests
 WEAK MBED_NORETURN mbed_error_status_t mbed_error(mbed_error_status_t error_status, const char *error_msg, unsigned int error_value, const char *filename, int line_number)
 {
@@ -272,6 +343,10 @@ WEAK MBED_NORETURN mbed_error_status_t mbed_error(mbed_error_status_t error_stat
 
         //On fatal errors print the error context/report
         ERROR_REPORT(&last_error_ctx, error_msg, filename, line_number);
+
+#if MBED_CONF_PLATFORM_CRASH_DUMP_ENABLED
+        mbed_crash_dump_write(&last_error_ctx);
+#endif
     }
 
 #if MBED_CONF_PLATFORM_CRASH_CAPTURE_ENABLED
@@ -424,6 +499,10 @@ mbed_error_status_t mbed_clear_all_errors(void)
     memset(&last_error_ctx, 0, sizeof(mbed_error_ctx));
     //reset error count to 0
     error_count = 0;
+#if MBED_CONF_PLATFORM_ERROR_RATE_LIMIT
+    memset((void *)error_rates, 0, sizeof(error_rates));
+    error_suppressed_count = 0;
+#endif
 #if MBED_CONF_PLATFORM_ERROR_HIST_ENABLED
     status = mbed_error_hist_reset();
 #endif
@@ -454,6 +533,22 @@ static void print_threads_info(const osRtxThread_t *threads)
 }
 #endif
 
+#if defined(MBED_IRQ_STATS_ENABLED)
+/* Prints the profiled IRQ handlers and the longest critical sections */
+static void print_irq_stats(void)
+{
+    mbed_stats_irq_t stats;
+    mbed_stats_irq_get(&stats);
+
+    for (uint32_t i = 0; i < stats.handler_cnt; i++) {
+        mbed_error_printf("\nIRQ: %" PRId32 " Count: %" PRIu32 " Max: %" PRIu32 "us Total: %" PRIu32 "us", stats.handlers[i].irqn, stats.handlers[i].count, (uint32_t)stats.handlers[i].max_time, (uint32_t)stats.handlers[i].total_time);
+    }
+    for (uint32_t i = 0; i < stats.critical_section_cnt; i++) {
+        mbed_error_printf("\nCritical section: 0x%08" PRIX32 " Time: %" PRIu32 "us", (uint32_t)stats.critical_sections[i].caller, (uint32_t)stats.critical_sections[i].time);
+    }
+}
+#endif
+
 #ifndef NDEBUG
 #define GET_TARGET_NAME_STR(tgt_name)   #tgt_name
 #define GET_TARGET_NAME(tgt_name)       GET_TARGET_NAME_STR(tgt_name)
@@ -542,6 +637,9 @@ static void print_error_report(const mbed_error_ctx *ctx, const char *error_msg,
     mbed_error_printf("\nDelay:");
     print_threads_info(osRtxInfo.thread.delay_list);
 #endif
+#if defined(MBED_IRQ_STATS_ENABLED)
+    print_irq_stats();
+#endif
 #if !defined(MBED_SYS_STATS_ENABLED)
     mbed_error_printf("\nFor more info, visit: https://mbed.com/s/error?error=0x%08X&tgt=" GET_TARGET_NAME(TARGET_NAME), ctx->error_status);
 #else
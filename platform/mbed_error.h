@@ -1036,6 +1036,16 @@ mbed_error_status_t mbed_get_last_error(void);
  */
 int mbed_get_error_count(void);
 
+/**
+ * Returns the number of warnings dropped by the rate limit after boot.
+ * Warnings are limited to platform.error-rate-limit per error status in
+ * each window of platform.error-rate-limit-window-ms, for the first
+ * platform.error-rate-limit-codes statuses reported.
+ * @return                  int Number of warnings dropped, 0 if the rate limit is disabled.
+ *
+ */
+int mbed_get_error_suppressed_count(void);
+
 /**
  * Call this function to set a fatal system error and halt the system. This function will log the fatal error with the context info and prints the error report and halts the system.
  *
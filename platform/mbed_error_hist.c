@@ -16,6 +16,7 @@
  */
 #include <stdlib.h>
 #include <stdarg.h>
+#include <string.h>
 #include "device.h"
 #include "platform/mbed_error.h"
 #include "platform/mbed_toolchain.h"
@@ -25,8 +26,42 @@
 #if MBED_CONF_PLATFORM_ERROR_HIST_ENABLED
 #include "platform/mbed_error_hist.h"
 
+/* The history is a ring written without locks, so warnings flooding from
+ * interrupts and threads don't hold interrupts off. A writer takes the next
+ * ticket, and publishes the slot with the ticket number plus one once the
+ * context is copied. Readers check that number before and after copying the
+ * slot, and skip an entry that is being overwritten.
+ */
 static mbed_error_ctx mbed_error_ctx_log[MBED_CONF_PLATFORM_ERROR_HIST_SIZE] = {0};
-static int error_log_count = -1;
+static volatile uint32_t error_log_seq[MBED_CONF_PLATFORM_ERROR_HIST_SIZE] = {0};
+static volatile uint32_t error_log_next = 0;
+
+static mbed_error_ctx *error_hist_claim(uint32_t *ticket)
+{
+    *ticket = core_util_atomic_incr_u32(&error_log_next, 1) - 1;
+    uint32_t slot = *ticket % MBED_CONF_PLATFORM_ERROR_HIST_SIZE;
+    core_util_atomic_store_u32(&error_log_seq[slot], 0);
+    return &mbed_error_ctx_log[slot];
+}
+
+static void error_hist_publish(uint32_t ticket)
+{
+    core_util_atomic_store_u32(&error_log_seq[ticket % MBED_CONF_PLATFORM_ERROR_HIST_SIZE], ticket + 1);
+}
+
+static mbed_error_status_t error_hist_read(uint32_t ticket, mbed_error_ctx *error_ctx)
+{
+    uint32_t slot = ticket % MBED_CONF_PLATFORM_ERROR_HIST_SIZE;
+    if (core_util_atomic_load_u32(&error_log_seq[slot]) != ticket + 1) {
+        return MBED_ERROR_ITEM_NOT_FOUND;
+    }
+    memcpy(error_ctx, &mbed_error_ctx_log[slot], sizeof(mbed_error_ctx));
+    if (core_util_atomic_load_u32(&error_log_seq[slot]) != ticket + 1) {
+        return MBED_ERROR_ITEM_NOT_FOUND;
+    }
+
+    return MBED_SUCCESS;
+}
 
 mbed_error_status_t mbed_error_hist_put(mbed_error_ctx *error_ctx)
 {
@@ -35,10 +70,9 @@ mbed_error_status_t mbed_error_hist_put(mbed_error_ctx *error_ctx)
         return MBED_ERROR_INVALID_ARGUMENT;
     }
 
-    core_util_critical_section_enter();
-    error_log_count++;
-    memcpy(&mbed_error_ctx_log[error_log_count % MBED_CONF_PLATFORM_ERROR_HIST_SIZE], error_ctx, sizeof(mbed_error_ctx));
-    core_util_critical_section_exit();
+    uint32_t ticket;
+    memcpy(error_hist_claim(&ticket), error_ctx, sizeof(mbed_error_ctx));
+    error_hist_publish(ticket);
 
     return MBED_SUCCESS;
 }
@@ -46,52 +80,50 @@ mbed_error_status_t mbed_error_hist_put(mbed_error_ctx *error_ctx)
 mbed_error_status_t mbed_error_hist_get(int index, mbed_error_ctx *error_ctx)
 {
     //Return error if index is more than max log size
-    if (index >= MBED_CONF_PLATFORM_ERROR_HIST_SIZE) {
+    if (index < 0 || index >= MBED_CONF_PLATFORM_ERROR_HIST_SIZE) {
         return MBED_ERROR_INVALID_ARGUMENT;
     }
 
-    core_util_critical_section_enter();
-    //calculate the index where we want to pick the ctx
-    if (error_log_count >= MBED_CONF_PLATFORM_ERROR_HIST_SIZE) {
-        index = (error_log_count + index + 1) % MBED_CONF_PLATFORM_ERROR_HIST_SIZE;
+    //calculate the ticket of the entry, 0 is the oldest one kept
+    uint32_t next = core_util_atomic_load_u32(&error_log_next);
+    if (next > MBED_CONF_PLATFORM_ERROR_HIST_SIZE) {
+        index += next - MBED_CONF_PLATFORM_ERROR_HIST_SIZE;
     }
-    core_util_critical_section_exit();
-    memcpy(error_ctx, &mbed_error_ctx_log[index % MBED_CONF_PLATFORM_ERROR_HIST_SIZE], sizeof(mbed_error_ctx));
 
-    return MBED_SUCCESS;
+    return error_hist_read(index, error_ctx);
 }
 
 mbed_error_ctx *mbed_error_hist_get_entry(void)
 {
-    core_util_critical_section_enter();
-    error_log_count++;
-    mbed_error_ctx *ctx = &mbed_error_ctx_log[error_log_count % MBED_CONF_PLATFORM_ERROR_HIST_SIZE];
-    core_util_critical_section_exit();
+    //the caller fills the entry in place
+    uint32_t ticket;
+    mbed_error_ctx *ctx = error_hist_claim(&ticket);
+    error_hist_publish(ticket);
 
     return ctx;
 }
 
 mbed_error_status_t mbed_error_hist_get_last_error(mbed_error_ctx *error_ctx)
 {
-    if (-1 == error_log_count) {
+    uint32_t next = core_util_atomic_load_u32(&error_log_next);
+    if (0 == next) {
         return MBED_ERROR_ITEM_NOT_FOUND;
     }
-    core_util_critical_section_enter();
-    memcpy(error_ctx, &mbed_error_ctx_log[error_log_count % MBED_CONF_PLATFORM_ERROR_HIST_SIZE], sizeof(mbed_error_ctx));
-    core_util_critical_section_exit();
 
-    return MBED_SUCCESS;
+    return error_hist_read(next - 1, error_ctx);
 }
 
 int mbed_error_hist_get_count()
 {
-    return (error_log_count >= MBED_CONF_PLATFORM_ERROR_HIST_SIZE ? MBED_CONF_PLATFORM_ERROR_HIST_SIZE : error_log_count + 1);
+    uint32_t next = core_util_atomic_load_u32(&error_log_next);
+    return (next >= MBED_CONF_PLATFORM_ERROR_HIST_SIZE ? MBED_CONF_PLATFORM_ERROR_HIST_SIZE : next);
 }
 
 mbed_error_status_t mbed_error_hist_reset()
 {
     core_util_critical_section_enter();
-    error_log_count = -1;
+    error_log_next = 0;
+    memset((void *)error_log_seq, 0, sizeof(error_log_seq));
     core_util_critical_section_exit();
 
     return MBED_SUCCESS;
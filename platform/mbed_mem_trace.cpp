@@ -18,7 +18,9 @@
 #include <stdlib.h>
 #include <stdarg.h>
 #include <stdio.h>
+#include <string.h>
 #include "platform/mbed_mem_trace.h"
+#include "platform/mbed_assert.h"
 #include "platform/mbed_critical.h"
 #include "platform/SingletonPtr.h"
 #include "platform/PlatformMutex.h"
@@ -153,3 +155,198 @@ void mbed_mem_trace_default_callback(uint8_t op, void *res, void *caller, ...)
     va_end(va);
 }
 
+/******************************************************************************
+ * Aggregating tracer
+ *****************************************************************************/
+
+#define AGGREGATE_SITES         MBED_CONF_PLATFORM_MEM_TRACE_AGGREGATE_SITES
+#define AGGREGATE_ALLOCATIONS   MBED_CONF_PLATFORM_MEM_TRACE_AGGREGATE_ALLOCATIONS
+
+MBED_STATIC_ASSERT((AGGREGATE_SITES & (AGGREGATE_SITES - 1)) == 0 && AGGREGATE_SITES < 0x10000,
+                   "platform.mem-trace-aggregate-sites must be a power of two");
+MBED_STATIC_ASSERT((AGGREGATE_ALLOCATIONS & (AGGREGATE_ALLOCATIONS - 1)) == 0,
+                   "platform.mem-trace-aggregate-allocations must be a power of two");
+
+typedef struct {
+    void *ptr;
+    uint32_t size;
+    uint16_t site;
+} aggregate_allocation_t;
+
+/* Both tables use open addressing with linear probing. The extra site
+ * collects the call sites that don't fit in the table. A site is in use
+ * once it has allocated. */
+static mbed_mem_trace_site_t aggregate_sites[AGGREGATE_SITES + 1];
+static aggregate_allocation_t aggregate_allocations[AGGREGATE_ALLOCATIONS];
+static uint32_t aggregate_untracked_cnt;
+static uint32_t aggregate_unknown_free_cnt;
+
+static uint32_t aggregate_hash(const void *key)
+{
+    uint32_t hash = (uint32_t)(uintptr_t)key * 2654435761UL;
+    return hash ^ (hash >> 16);
+}
+
+static uint16_t aggregate_site(void *caller)
+{
+    uint32_t i = aggregate_hash(caller) & (AGGREGATE_SITES - 1);
+    for (uint32_t n = 0; n < AGGREGATE_SITES; n++) {
+        if (aggregate_sites[i].alloc_cnt == 0) {
+            aggregate_sites[i].caller = (uint32_t)(uintptr_t)caller;
+            return i;
+        }
+        if (aggregate_sites[i].caller == (uint32_t)(uintptr_t)caller) {
+            return i;
+        }
+        i = (i + 1) & (AGGREGATE_SITES - 1);
+    }
+    return AGGREGATE_SITES;
+}
+
+static void aggregate_malloc(void *ptr, size_t size, void *caller)
+{
+    if (ptr == NULL) {
+        return;
+    }
+
+    uint16_t site = aggregate_site(caller);
+    mbed_mem_trace_site_t *stats = &aggregate_sites[site];
+    stats->alloc_cnt++;
+
+    // Remember the allocation, so its free can be accounted to this site
+    uint32_t i = aggregate_hash(ptr) & (AGGREGATE_ALLOCATIONS - 1);
+    for (uint32_t n = 0; n < AGGREGATE_ALLOCATIONS; n++) {
+        if (aggregate_allocations[i].ptr == NULL) {
+            aggregate_allocations[i].ptr = ptr;
+            aggregate_allocations[i].size = size;
+            aggregate_allocations[i].site = site;
+
+            stats->live_size += size;
+            if (stats->live_size > stats->peak_size) {
+                stats->peak_size = stats->live_size;
+            }
+            return;
+        }
+        i = (i + 1) & (AGGREGATE_ALLOCATIONS - 1);
+    }
+    aggregate_untracked_cnt++;
+}
+
+static void aggregate_free(void *ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
+
+    uint32_t i = aggregate_hash(ptr) & (AGGREGATE_ALLOCATIONS - 1);
+    for (uint32_t n = 0; aggregate_allocations[i].ptr != ptr; n++) {
+        if (aggregate_allocations[i].ptr == NULL || n == AGGREGATE_ALLOCATIONS) {
+            aggregate_unknown_free_cnt++;
+            return;
+        }
+        i = (i + 1) & (AGGREGATE_ALLOCATIONS - 1);
+    }
+
+    mbed_mem_trace_site_t *stats = &aggregate_sites[aggregate_allocations[i].site];
+    stats->live_size -= aggregate_allocations[i].size;
+    stats->free_cnt++;
+
+    // Shift back the following entries that may no longer be found past the hole
+    for (uint32_t j = (i + 1) & (AGGREGATE_ALLOCATIONS - 1);
+            aggregate_allocations[j].ptr != NULL;
+            j = (j + 1) & (AGGREGATE_ALLOCATIONS - 1)) {
+        uint32_t home = aggregate_hash(aggregate_allocations[j].ptr) & (AGGREGATE_ALLOCATIONS - 1);
+        if (((j - home) & (AGGREGATE_ALLOCATIONS - 1)) >= ((j - i) & (AGGREGATE_ALLOCATIONS - 1))) {
+            aggregate_allocations[i] = aggregate_allocations[j];
+            i = j;
+        }
+    }
+    aggregate_allocations[i].ptr = NULL;
+}
+
+void mbed_mem_trace_aggregate_callback(uint8_t op, void *res, void *caller, ...)
+{
+    va_list va;
+    size_t temp_s1, temp_s2;
+    void *temp_ptr;
+
+    va_start(va, caller);
+    switch (op) {
+        case MBED_MEM_TRACE_MALLOC:
+            temp_s1 = va_arg(va, size_t);
+            aggregate_malloc(res, temp_s1, caller);
+            break;
+
+        case MBED_MEM_TRACE_REALLOC:
+            temp_ptr = va_arg(va, void *);
+            temp_s1 = va_arg(va, size_t);
+            // A failed realloc leaves the original memory allocated
+            if (res != NULL || temp_s1 == 0) {
+                aggregate_free(temp_ptr);
+            }
+            aggregate_malloc(res, temp_s1, caller);
+            break;
+
+        case MBED_MEM_TRACE_CALLOC:
+            temp_s1 = va_arg(va, size_t);
+            temp_s2 = va_arg(va, size_t);
+            aggregate_malloc(res, temp_s1 * temp_s2, caller);
+            break;
+
+        case MBED_MEM_TRACE_FREE:
+            temp_ptr = va_arg(va, void *);
+            aggregate_free(temp_ptr);
+            break;
+
+        default:
+            break;
+    }
+    va_end(va);
+}
+
+void mbed_mem_trace_aggregate_reset(void)
+{
+    mbed_mem_trace_lock();
+    memset(aggregate_sites, 0, sizeof(aggregate_sites));
+    memset(aggregate_allocations, 0, sizeof(aggregate_allocations));
+    aggregate_untracked_cnt = 0;
+    aggregate_unknown_free_cnt = 0;
+    mbed_mem_trace_unlock();
+}
+
+size_t mbed_mem_trace_aggregate_snapshot(void *buffer, size_t size)
+{
+    mbed_mem_trace_snapshot_t header;
+    header.magic = MBED_MEM_TRACE_SNAPSHOT_MAGIC;
+    header.version = MBED_MEM_TRACE_SNAPSHOT_VERSION;
+    header.site_cnt = 0;
+
+    if (buffer != NULL && size < sizeof(header)) {
+        return 0;
+    }
+
+    mbed_mem_trace_lock();
+    header.untracked_cnt = aggregate_untracked_cnt;
+    header.unknown_free_cnt = aggregate_unknown_free_cnt;
+
+    size_t pos = sizeof(header);
+    for (uint32_t i = 0; i <= AGGREGATE_SITES; i++) {
+        if (aggregate_sites[i].alloc_cnt == 0) {
+            continue;
+        }
+        if (buffer != NULL) {
+            if (size - pos < sizeof(mbed_mem_trace_site_t)) {
+                break;
+            }
+            memcpy((char *)buffer + pos, &aggregate_sites[i], sizeof(mbed_mem_trace_site_t));
+        }
+        pos += sizeof(mbed_mem_trace_site_t);
+        header.site_cnt++;
+    }
+    mbed_mem_trace_unlock();
+
+    if (buffer != NULL) {
+        memcpy(buffer, &header, sizeof(header));
+    }
+    return pos;
+}
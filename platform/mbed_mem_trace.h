@@ -163,6 +163,66 @@ void mbed_mem_trace_free(void *ptr, void *caller);
  */
 void mbed_mem_trace_default_callback(uint8_t op, void *res, void *caller, ...);
 
+/** Magic number at the start of a snapshot of the aggregating tracer */
+#define MBED_MEM_TRACE_SNAPSHOT_MAGIC   0x4D54524D
+
+/** Version of the snapshot format of the aggregating tracer */
+#define MBED_MEM_TRACE_SNAPSHOT_VERSION 1
+
+/**
+ * Header of a snapshot of the aggregating tracer, followed by 'site_cnt'
+ * mbed_mem_trace_site_t records. All fields are in the native byte order.
+ */
+typedef struct {
+    uint32_t magic;             /**< MBED_MEM_TRACE_SNAPSHOT_MAGIC */
+    uint16_t version;           /**< MBED_MEM_TRACE_SNAPSHOT_VERSION */
+    uint16_t site_cnt;          /**< Number of site records following the header */
+    uint32_t untracked_cnt;     /**< Allocations not accounted for because too many were live */
+    uint32_t unknown_free_cnt;  /**< Frees of memory not allocated while tracing */
+} mbed_mem_trace_snapshot_t;
+
+/**
+ * Allocation statistics of a call site, as recorded by the aggregating tracer.
+ * Frees are accounted to the site that allocated the memory.
+ */
+typedef struct {
+    uint32_t caller;            /**< Address of the call site, 0 for sites that didn't fit the table */
+    uint32_t live_size;         /**< Bytes allocated by the site that have not been freed */
+    uint32_t peak_size;         /**< Maximum of live_size since tracing started */
+    uint32_t alloc_cnt;         /**< Number of allocations made by the site */
+    uint32_t free_cnt;          /**< Number of allocations of the site freed */
+} mbed_mem_trace_site_t;
+
+/**
+ * Aggregating memory trace callback. DO NOT CALL DIRECTLY. It is meant to be used
+ * as the argument of 'mbed_mem_trace_set_callback'.
+ * Instead of printing each memory operation, this callback keeps per call site
+ * statistics in RAM, in tables of platform.mem-trace-aggregate-sites call sites
+ * and platform.mem-trace-aggregate-allocations live allocations. The statistics
+ * are read with 'mbed_mem_trace_aggregate_snapshot'.
+ * @param op        the ID of the operation, see 'mbed_mem_trace_cb_t'.
+ * @param res       the result that the memory operation returned.
+ * @param caller    the caller of the memory operation.
+ */
+void mbed_mem_trace_aggregate_callback(uint8_t op, void *res, void *caller, ...);
+
+/**
+ * Clear the statistics of the aggregating tracer.
+ * @note Memory allocated before the reset is reported as unknown when freed.
+ */
+void mbed_mem_trace_aggregate_reset(void);
+
+/**
+ * Write a binary snapshot of the aggregating tracer: a mbed_mem_trace_snapshot_t
+ * header followed by a mbed_mem_trace_site_t record for each call site.
+ * @param buffer    buffer to write the snapshot to, or NULL to get the size needed.
+ * @param size      size of the buffer in bytes. If too small for all the sites,
+ *                  only the records that fit are written.
+ * @return          the number of bytes written, or needed if 'buffer' is NULL.
+ *                  0 if the buffer can't hold the header.
+ */
+size_t mbed_mem_trace_aggregate_snapshot(void *buffer, size_t size);
+
 /** @}*/
 
 #ifdef __cplusplus
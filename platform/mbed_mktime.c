@@ -67,6 +67,14 @@ static const uint32_t seconds_before_month[2][12] = {
     }
 };
 
+/* Days elapsed before each year of a 4 year cycle starting with 1970. */
+static const uint16_t days_before_cycle_year[4] = { 0, 365, 730, 1096 };
+
+#define DAYS_BY_4_YEARS (4 * 365 + 1)
+
+/* 1st of March 2100, the first day after the missing 29th of February 2100. */
+#define DAYS_TO_MARCH_2100 47541
+
 bool _rtc_is_leap_year(int year, rtc_leap_year_support_t leap_year_support)
 {
     /*
@@ -156,19 +164,25 @@ bool _rtc_localtime(time_t timestamp, struct tm *time_info, rtc_leap_year_suppor
      */
     time_info->tm_wday = (seconds + 4) % 7;
 
-    /* Years start at 70. */
-    time_info->tm_year = 70;
-    while (true) {
-        if (_rtc_is_leap_year(time_info->tm_year, leap_year_support) && seconds >= 366) {
-            ++time_info->tm_year;
-            seconds -= 366;
-        } else if (!_rtc_is_leap_year(time_info->tm_year, leap_year_support) && seconds >= 365) {
-            ++time_info->tm_year;
-            seconds -= 365;
-        } else {
-            /* The remaining days are less than a years. */
-            break;
-        }
+    /* Years start at 70 and follow 4 year cycles, 2100 is handled as if it
+     * had a 29th of February and corrected afterwards.
+     */
+    bool after_2100_feb = (leap_year_support == RTC_FULL_LEAP_YEAR_SUPPORT && seconds >= DAYS_TO_MARCH_2100);
+    if (after_2100_feb) {
+        ++seconds;
+    }
+
+    uint32_t cycle_days = seconds % DAYS_BY_4_YEARS;
+    uint32_t cycle_year = 3;
+    while (cycle_days < days_before_cycle_year[cycle_year]) {
+        --cycle_year;
+    }
+    time_info->tm_year = 70 + (seconds / DAYS_BY_4_YEARS) * 4 + cycle_year;
+    seconds = cycle_days - days_before_cycle_year[cycle_year];
+
+    bool leap = _rtc_is_leap_year(time_info->tm_year, leap_year_support);
+    if (after_2100_feb && time_info->tm_year == 200) {
+        --seconds;
     }
 
     time_info->tm_yday = seconds;
@@ -176,7 +190,6 @@ bool _rtc_localtime(time_t timestamp, struct tm *time_info, rtc_leap_year_suppor
     /* Convert days into seconds and find the current month. */
     seconds *= SECONDS_BY_DAY;
     time_info->tm_mon = 11;
-    bool leap = _rtc_is_leap_year(time_info->tm_year, leap_year_support);
     for (uint32_t i = 0; i < 12; ++i) {
         if ((uint32_t) seconds < seconds_before_month[leap][i]) {
             time_info->tm_mon = i - 1;
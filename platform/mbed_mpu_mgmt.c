@@ -69,4 +69,17 @@ void mbed_mpu_manager_unlock_rom_write()
     core_util_critical_section_exit();
 }
 
+void mbed_mpu_manager_set_stack_guard(const void *stack_mem, uint32_t stack_size)
+{
+    const uint32_t size = MBED_CONF_PLATFORM_MPU_STACK_GUARD_SIZE;
+    uint32_t addr = ((uint32_t)stack_mem + size - 1) & ~(size - 1);
+
+    // Keep at least half of the stack usable
+    if ((stack_mem == NULL) || (addr + size - (uint32_t)stack_mem > stack_size / 2)) {
+        mbed_mpu_set_stack_guard(0, 0);
+    } else {
+        mbed_mpu_set_stack_guard(addr, size);
+    }
+}
+
 #endif
@@ -85,6 +85,20 @@ void mbed_mpu_manager_lock_rom_write(void);
  */
 void mbed_mpu_manager_unlock_rom_write(void);
 
+/** Move the stack guard to the bottom of a stack
+ *
+ * Writes to the first platform.mpu-stack-guard-size aligned bytes of the
+ * stack fault, so the stack is overflowed by that many bytes at most
+ * before a fault. Stacks too small for the guard aren't guarded.
+ *
+ * Called by the RTOS on every thread switch when platform.mpu-stack-guard
+ * is set, with the stack of the thread switched in.
+ *
+ * @param stack_mem     Bottom of the stack, or NULL to remove the guard
+ * @param stack_size    Size of the stack in bytes
+ */
+void mbed_mpu_manager_set_stack_guard(const void *stack_mem, uint32_t stack_size);
+
 #else
 
 #define mbed_mpu_manager_init() (void)0
@@ -99,6 +113,8 @@ void mbed_mpu_manager_unlock_rom_write(void);
 
 #define mbed_mpu_manager_unlock_rom_write() (void)0
 
+#define mbed_mpu_manager_set_stack_guard(stack_mem, stack_size) (void)0
+
 #endif
 
 #ifdef __cplusplus
@@ -94,6 +94,47 @@ extern "C" {
 void sleep_tracker_lock(const char *const filename, int line);
 void sleep_tracker_unlock(const char *const filename, int line);
 
+/** Deep sleep lock accounting of a lock owner, identified by its file name */
+typedef struct {
+    char identifier[15];            /**< Start of the file name of the owner */
+    uint8_t count;                  /**< Number of locks currently held */
+    us_timestamp_t held_time;       /**< Time at least one lock was held, in microseconds */
+    us_timestamp_t blocked_time;    /**< Time spent in sleep instead of deep sleep while a lock was held, in microseconds */
+    uint64_t energy_nj;             /**< Estimated energy spent above deep sleep during blocked_time, in nanojoules */
+} mbed_sleep_tracker_stats_t;
+
+/** Current measurement source
+ *
+ * Called after each sleep blocked by deep sleep locks, returns the average
+ * current drawn during that sleep in microamps. It is called in a critical
+ * section.
+ *
+ * @param duration  Duration of the sleep in microseconds
+ * @return          Average current in microamps
+ */
+typedef uint32_t (*sleep_tracker_current_source_t)(us_timestamp_t duration);
+
+/** Fill in the accounting of the deep sleep lock owners
+ *
+ * The held time of owners still holding a lock includes the time up to
+ * this call. Sleeps blocked by several owners are charged to each of them,
+ * their energy is split between them.
+ *
+ * @param stats     Array to fill in
+ * @param count     Number of entries in the array
+ * @return          Number of entries filled in
+ */
+int sleep_tracker_get_stats(mbed_sleep_tracker_stats_t *stats, int count);
+
+/** Set the current measurement source of the energy estimates
+ *
+ * Without a source, the sleep current is platform.sleep-tracing-sleep-current-ua.
+ * The energy is the one spent above platform.sleep-tracing-deep-sleep-current-ua.
+ *
+ * @param source    Source of the sleep current, or NULL to use the configured one
+ */
+void sleep_tracker_set_current_source(sleep_tracker_current_source_t source);
+
 #define sleep_manager_lock_deep_sleep()              \
     do                                               \
     {                                                \
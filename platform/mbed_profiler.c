@@ -0,0 +1,311 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "platform/mbed_profiler.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_toolchain.h"
+
+#include <stdio.h>
+#include <string.h>
+#include "device.h"
+#include "cmsis.h"
+#ifdef MBED_CONF_RTOS_PRESENT
+#include "cmsis_os2.h"
+#endif
+
+#if defined(MBED_PROFILER_ENABLED) && !defined(__CORTEX_M)
+#warning The profiler is only supported on Cortex-M.
+#endif
+
+#if defined(MBED_PROFILER_ENABLED) && defined(__CORTEX_M)
+
+#define PROFILER_SLOTS MBED_CONF_PLATFORM_PROFILER_SLOTS
+
+MBED_STATIC_ASSERT((PROFILER_SLOTS & (PROFILER_SLOTS - 1)) == 0,
+                   "platform.profiler-slots must be a power of two");
+
+#if defined(MBED_CONF_RTOS_PRESENT) && defined(NO_SYSTICK)
+extern IRQn_Type mbed_get_m0_tick_irqn(void);
+#define PROFILER_IRQN mbed_get_m0_tick_irqn()
+#else
+#define PROFILER_IRQN SysTick_IRQn
+#endif
+
+// Open addressing hash table, a slot with a zero count is free. Only
+// written from the sampling interrupt, other accesses are made in
+// critical sections.
+static mbed_profiler_sample_t profiler_table[PROFILER_SLOTS];
+static uint32_t profiler_total;
+static uint32_t profiler_dropped;
+static bool profiler_threads;
+static bool profiler_running;
+
+// Handler of the sampling interrupt before the profiler was started, the
+// sampling handler jumps to it
+static uint32_t profiler_vector;
+
+#ifndef MBED_CONF_RTOS_PRESENT
+static void profiler_systick_handler(void)
+{
+}
+#endif
+
+static uint32_t profiler_hash(uint32_t pc, uint32_t thread_id)
+{
+    uint32_t h = ((pc >> 1) ^ thread_id) * 0x9E3779B1UL;
+    return (h ^ (h >> 16)) & (PROFILER_SLOTS - 1);
+}
+
+// Called by profiler_irq_handler with the stacked PC and EXC_RETURN of the
+// interrupted context, returns the handler to continue with
+MBED_USED uint32_t mbed_profiler_sample(uint32_t pc, uint32_t exc_return)
+{
+    uint32_t thread_id = 0;
+#ifdef MBED_CONF_RTOS_PRESENT
+    // EXC_RETURN bit 3 is set when returning to thread mode
+    if (profiler_threads && (exc_return & 0x8)) {
+        thread_id = (uint32_t)osThreadGetId();
+    }
+#endif
+    pc &= ~1UL;
+
+    profiler_total++;
+    uint32_t i = profiler_hash(pc, thread_id);
+    for (uint32_t n = 0; n < PROFILER_SLOTS; n++) {
+        mbed_profiler_sample_t *slot = &profiler_table[i];
+        if (slot->count == 0) {
+            slot->pc = pc;
+            slot->thread_id = thread_id;
+            slot->count = 1;
+            return profiler_vector;
+        }
+        if (slot->pc == pc && slot->thread_id == thread_id) {
+            slot->count++;
+            return profiler_vector;
+        }
+        i = (i + 1) & (PROFILER_SLOTS - 1);
+    }
+    profiler_dropped++;
+    return profiler_vector;
+}
+
+// Entered in place of the sampling interrupt handler. Passes the stacked
+// PC to mbed_profiler_sample, then jumps to the original handler with LR
+// still holding EXC_RETURN, as if it had been entered directly.
+// Only uses ARMv6-M instructions so it runs on all Cortex-M.
+#if defined (__CC_ARM)
+
+__asm static void profiler_irq_handler(void)
+{
+    PRESERVE8
+    MOVS    R0, #4
+    MOV     R1, LR
+    TST     R0, R1
+    BEQ     profiler_msp
+    MRS     R0, PSP
+    B       profiler_pc
+profiler_msp
+    MRS     R0, MSP
+profiler_pc
+    LDR     R0, [R0, #24]
+    PUSH    {R1, LR}
+    BL      __cpp(mbed_profiler_sample)
+    POP     {R1, R2}
+    MOV     LR, R2
+    BX      R0
+}
+
+#elif defined (__GNUC__) || defined (__ICCARM__)
+
+#if defined (__ICCARM__)
+__stackless
+#else
+__attribute__((naked))
+#endif
+static void profiler_irq_handler(void)
+{
+    __asm volatile(
+        ".syntax unified                \n"
+        "movs   r0, #4                  \n"
+        "mov    r1, lr                  \n"
+        "tst    r0, r1                  \n" // EXC_RETURN bit 2 selects the stack
+        "beq    profiler_msp            \n"
+        "mrs    r0, psp                 \n"
+        "b      profiler_pc             \n"
+        "profiler_msp:                  \n"
+        "mrs    r0, msp                 \n"
+        "profiler_pc:                   \n"
+        "ldr    r0, [r0, #24]           \n" // Stacked PC
+        "push   {r1, lr}                \n"
+        "bl     mbed_profiler_sample    \n"
+        "pop    {r1, r2}                \n"
+        "mov    lr, r2                  \n"
+        "bx     r0                      \n"
+    );
+}
+
+#else
+
+#error "Unsupported toolchain"
+
+#endif
+
+int mbed_profiler_start(bool threads)
+{
+#if !defined(MBED_CONF_RTOS_PRESENT) && defined(NO_SYSTICK)
+    // No periodic interrupt to sample from
+    return -1;
+#endif
+    core_util_critical_section_enter();
+    if (profiler_running) {
+        profiler_threads = threads;
+        core_util_critical_section_exit();
+        return 0;
+    }
+    profiler_threads = threads;
+#ifdef MBED_CONF_RTOS_PRESENT
+    // Sample on the OS tick
+    profiler_vector = NVIC_GetVector(PROFILER_IRQN);
+#else
+    profiler_vector = (uint32_t)profiler_systick_handler;
+#endif
+    NVIC_SetVector(PROFILER_IRQN, (uint32_t)profiler_irq_handler);
+#ifndef MBED_CONF_RTOS_PRESENT
+    // SysTick is free without the RTOS, give it the highest priority so
+    // interrupt handlers are sampled too
+    SysTick_Config(SystemCoreClock / MBED_CONF_PLATFORM_PROFILER_FREQUENCY);
+    NVIC_SetPriority(SysTick_IRQn, 0);
+#endif
+    profiler_running = true;
+    core_util_critical_section_exit();
+    return 0;
+}
+
+void mbed_profiler_stop(void)
+{
+    core_util_critical_section_enter();
+    if (profiler_running) {
+#ifndef MBED_CONF_RTOS_PRESENT
+        SysTick->CTRL = 0;
+        SCB->ICSR = SCB_ICSR_PENDSTCLR_Msk;
+#endif
+        NVIC_SetVector(PROFILER_IRQN, profiler_vector);
+        profiler_running = false;
+    }
+    core_util_critical_section_exit();
+}
+
+void mbed_profiler_reset(void)
+{
+    core_util_critical_section_enter();
+    memset(profiler_table, 0, sizeof(profiler_table));
+    profiler_total = 0;
+    profiler_dropped = 0;
+    core_util_critical_section_exit();
+}
+
+size_t mbed_profiler_get_each(mbed_profiler_sample_t *samples, size_t count)
+{
+    MBED_ASSERT(samples != NULL);
+
+    // Keep the most frequent in the array, sorted by insertion
+    size_t used = 0;
+    for (uint32_t i = 0; i < PROFILER_SLOTS; i++) {
+        core_util_critical_section_enter();
+        mbed_profiler_sample_t sample = profiler_table[i];
+        core_util_critical_section_exit();
+
+        if (sample.count == 0) {
+            continue;
+        }
+        size_t j = used;
+        if (used < count) {
+            used++;
+        } else if (count == 0 || sample.count <= samples[count - 1].count) {
+            continue;
+        } else {
+            j = count - 1;
+        }
+        for (; j > 0 && samples[j - 1].count < sample.count; j--) {
+            samples[j] = samples[j - 1];
+        }
+        samples[j] = sample;
+    }
+    return used;
+}
+
+uint32_t mbed_profiler_get_total(void)
+{
+    return profiler_total;
+}
+
+uint32_t mbed_profiler_get_dropped(void)
+{
+    return profiler_dropped;
+}
+
+void mbed_profiler_print(void)
+{
+    printf("mbed_profiler: %lu samples, %lu dropped\r\n",
+           (unsigned long)profiler_total, (unsigned long)profiler_dropped);
+    for (uint32_t i = 0; i < PROFILER_SLOTS; i++) {
+        core_util_critical_section_enter();
+        mbed_profiler_sample_t sample = profiler_table[i];
+        core_util_critical_section_exit();
+
+        if (sample.count) {
+            printf("0x%08lx 0x%08lx %lu\r\n", (unsigned long)sample.pc,
+                   (unsigned long)sample.thread_id, (unsigned long)sample.count);
+        }
+    }
+}
+
+#else
+
+int mbed_profiler_start(bool threads)
+{
+    return -1;
+}
+
+void mbed_profiler_stop(void)
+{
+}
+
+void mbed_profiler_reset(void)
+{
+}
+
+size_t mbed_profiler_get_each(mbed_profiler_sample_t *samples, size_t count)
+{
+    return 0;
+}
+
+uint32_t mbed_profiler_get_total(void)
+{
+    return 0;
+}
+
+uint32_t mbed_profiler_get_dropped(void)
+{
+    return 0;
+}
+
+void mbed_profiler_print(void)
+{
+}
+
+#endif
@@ -0,0 +1,112 @@
+/** \addtogroup platform */
+/** @{*/
+/**
+ * \defgroup platform_profiler Sampling profiler functions
+ * @{
+ */
+
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_PROFILER_H
+#define MBED_PROFILER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Statistical profiler sampling the interrupted PC
+ *
+ * Each sample is taken from a periodic interrupt: the OS tick when the RTOS
+ * is present, otherwise SysTick running at platform.profiler-frequency.
+ * Samples are counted per PC, and optionally per thread, in a table of
+ * platform.profiler-slots entries. Samples which don't fit are dropped and
+ * counted.
+ *
+ * With the RTOS the OS tick has the lowest priority, so time spent in
+ * interrupt handlers and critical sections is charged to the instruction
+ * where they end.
+ *
+ * The samples are printed by mbed_profiler_print(), or read with
+ * mbed_profiler_get_each() to store them, for example in a KVStore file:
+ *
+ * @code
+ * mbed_profiler_sample_t samples[64];
+ * size_t count = mbed_profiler_get_each(samples, 64);
+ * kv_set("/kv/profile", samples, count * sizeof(samples[0]), 0);
+ * @endcode
+ *
+ * tools/profiler_symbolize.py converts either output to a list of functions
+ * with the ELF file of the application.
+ *
+ * Enabled with the platform.profiler-enabled option, on Cortex-M.
+ */
+
+/** Number of samples at a PC, in a thread */
+typedef struct {
+    uint32_t pc;            /**< Interrupted instruction */
+    uint32_t thread_id;     /**< Interrupted thread, 0 if not recorded or in an interrupt handler */
+    uint32_t count;         /**< Number of samples */
+} mbed_profiler_sample_t;
+
+/** Start sampling
+ *
+ *  @param threads  Record the thread of each sample, when the RTOS is present
+ *  @return         0 on success, -1 if the profiler isn't enabled or supported
+ *
+ *  @note Samples taken before are kept, see mbed_profiler_reset().
+ */
+int mbed_profiler_start(bool threads);
+
+/** Stop sampling */
+void mbed_profiler_stop(void);
+
+/** Discard all samples */
+void mbed_profiler_reset(void);
+
+/** Copy the sampled PCs, most frequent first
+ *
+ *  @param samples  Array of mbed_profiler_sample_t to fill
+ *  @param count    Number of entries in the array
+ *  @return         Number of entries filled
+ */
+size_t mbed_profiler_get_each(mbed_profiler_sample_t *samples, size_t count);
+
+/** Get the number of samples taken, including the dropped ones */
+uint32_t mbed_profiler_get_total(void);
+
+/** Get the number of samples dropped because the table was full */
+uint32_t mbed_profiler_get_dropped(void);
+
+/** Print the samples to the console
+ *
+ *  The first line gives the totals, each following line a PC, a thread ID
+ *  and a count, in hexadecimal, hexadecimal and decimal.
+ */
+void mbed_profiler_print(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/** @}*/
+/** @}*/
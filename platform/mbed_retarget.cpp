@@ -267,6 +267,9 @@ static FileHandle *default_console()
 #   elif CONSOLE_FLOWCONTROL == CONSOLE_FLOWCONTROL_RTSCTS
     console.set_flow_control(SerialBase::RTSCTS, STDIO_UART_RTS, STDIO_UART_CTS);
 #   endif
+#   if DEVICE_SERIAL_ASYNCH && MBED_CONF_PLATFORM_STDIO_BUFFERED_SERIAL_DMA
+    console.set_dma_tx(true);
+#   endif
 #  else
     static DirectSerial console(STDIO_UART_TX, STDIO_UART_RX, MBED_CONF_PLATFORM_STDIO_BAUD_RATE);
 #  endif
@@ -20,9 +20,72 @@
 #include "platform/mbed_rtc_time.h"
 #include "platform/SingletonPtr.h"
 #include "platform/PlatformMutex.h"
+#include "hal/lp_ticker_api.h"
 
 static SingletonPtr<PlatformMutex> _mutex;
 
+#ifndef MBED_CONF_PLATFORM_TIME_CACHE_SYNC_MS
+#define MBED_CONF_PLATFORM_TIME_CACHE_SYNC_MS   0
+#endif
+
+#if MBED_CONF_PLATFORM_TIME_CACHE_SYNC_MS && DEVICE_LPTICKER
+/* Time read from the RTC and the LP ticker time it was read at. Between RTC
+ * reads, the time is extrapolated with the LP ticker, in a critical section
+ * instead of under the mutex. The time is never ahead of the RTC, and at
+ * most the RTC resolution plus the drift between the clocks over a sync
+ * interval behind.
+ */
+static time_t _time_cache_base;
+static us_timestamp_t _time_cache_ticks;
+static bool _time_cache_valid;
+
+static bool _time_cache_read(time_t *t)
+{
+    bool valid = false;
+
+    core_util_critical_section_enter();
+    if (_time_cache_valid) {
+        us_timestamp_t elapsed = ticker_read_us(get_lp_ticker_data()) - _time_cache_ticks;
+        if (elapsed < MBED_CONF_PLATFORM_TIME_CACHE_SYNC_MS * 1000ULL) {
+            *t = _time_cache_base + (time_t)(elapsed / 1000000);
+            valid = true;
+        }
+    }
+    core_util_critical_section_exit();
+
+    return valid;
+}
+
+static void _time_cache_sync(time_t t)
+{
+    core_util_critical_section_enter();
+    _time_cache_base = t;
+    _time_cache_ticks = ticker_read_us(get_lp_ticker_data());
+    _time_cache_valid = (t != (time_t) -1);
+    core_util_critical_section_exit();
+}
+
+static void _time_cache_invalidate(void)
+{
+    core_util_critical_section_enter();
+    _time_cache_valid = false;
+    core_util_critical_section_exit();
+}
+#else
+static bool _time_cache_read(time_t *)
+{
+    return false;
+}
+
+static void _time_cache_sync(time_t)
+{
+}
+
+static void _time_cache_invalidate(void)
+{
+}
+#endif
+
 #if DEVICE_RTC
 
 static void (*_rtc_init)(void) = rtc_init;
@@ -82,6 +145,7 @@ extern "C" {
 int settimeofday(const struct timeval *tv, MBED_UNUSED const struct timezone *tz)
 {
     _mutex->lock();
+    _time_cache_invalidate();
     if (_rtc_init != NULL) {
         _rtc_init();
     }
@@ -95,6 +159,15 @@ int settimeofday(const struct timeval *tv, MBED_UNUSED const struct timezone *tz
 
 int gettimeofday(struct timeval *tv, MBED_UNUSED void *tz)
 {
+    time_t t = (time_t) - 1;
+
+    // Fast path, extrapolated from the last RTC read
+    if (_time_cache_read(&t)) {
+        tv->tv_sec  = t;
+        tv->tv_usec = 0;
+        return 0;
+    }
+
     _mutex->lock();
     if (_rtc_isenabled != NULL) {
         if (!(_rtc_isenabled())) {
@@ -102,9 +175,9 @@ int gettimeofday(struct timeval *tv, MBED_UNUSED void *tz)
         }
     }
 
-    time_t t = (time_t) - 1;
     if (_rtc_read != NULL) {
         t = _rtc_read();
+        _time_cache_sync(t);
     }
 
     tv->tv_sec  = t;
@@ -141,6 +214,7 @@ void set_time(time_t t)
 void attach_rtc(time_t (*read_rtc)(void), void (*write_rtc)(time_t), void (*init_rtc)(void), int (*isenabled_rtc)(void))
 {
     _mutex->lock();
+    _time_cache_invalidate();
     _rtc_read = read_rtc;
     _rtc_write = write_rtc;
     _rtc_init = init_rtc;
@@ -19,6 +19,7 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include "cmsis.h"
+#include "platform/mbed_stats.h"
 
 /* This startup is for mbed 2 baremetal. There is no config for RTOS for mbed 2,
  * therefore we protect this file with MBED_CONF_RTOS_PRESENT
@@ -75,13 +76,16 @@ int $Super$$main(void);
 int $Sub$$main(void)
 {
     mbed_main();
+    mbed_stats_boot_mark(MBED_BOOT_PHASE_MAIN);
     return $Super$$main();
 }
 
 void _platform_post_stackheap_init(void)
 {
+    mbed_stats_boot_mark(MBED_BOOT_PHASE_INIT);
     mbed_copy_nvic();
     mbed_sdk_init();
+    mbed_stats_boot_mark(MBED_BOOT_PHASE_SDK_INIT);
 }
 
 #elif defined (__GNUC__)
@@ -90,8 +94,10 @@ extern int __real_main(void);
 
 void software_init_hook(void)
 {
+    mbed_stats_boot_mark(MBED_BOOT_PHASE_INIT);
     mbed_copy_nvic();
     mbed_sdk_init();
+    mbed_stats_boot_mark(MBED_BOOT_PHASE_SDK_INIT);
     software_init_hook_rtos();
 }
 
@@ -99,6 +105,7 @@ void software_init_hook(void)
 int __wrap_main(void)
 {
     mbed_main();
+    mbed_stats_boot_mark(MBED_BOOT_PHASE_MAIN);
     return __real_main();
 }
 
@@ -27,6 +27,7 @@
 
 #include <limits.h>
 #include <stdio.h>
+#include <string.h>
 
 #if DEVICE_SLEEP
 
@@ -79,12 +80,35 @@ us_timestamp_t mbed_time_deepsleep(void)
 // Number of drivers that can be stored in the structure
 #define STATISTIC_COUNT  10
 
+#ifndef MBED_CONF_PLATFORM_SLEEP_TRACING_SLEEP_CURRENT_UA
+#define MBED_CONF_PLATFORM_SLEEP_TRACING_SLEEP_CURRENT_UA       0
+#endif
+
+#ifndef MBED_CONF_PLATFORM_SLEEP_TRACING_DEEP_SLEEP_CURRENT_UA
+#define MBED_CONF_PLATFORM_SLEEP_TRACING_DEEP_SLEEP_CURRENT_UA  0
+#endif
+
 typedef struct sleep_statistic {
     char identifier[IDENTIFIER_WIDTH];
     uint8_t count;
+    us_timestamp_t lock_start;
+    us_timestamp_t held_time;
+    us_timestamp_t blocked_time;
+    uint64_t energy_nj;
 } sleep_statistic_t;
 
 static sleep_statistic_t sleep_stats[STATISTIC_COUNT];
+static sleep_tracker_current_source_t sleep_current_source = NULL;
+
+// Lock owners are timed even without the CPU stats
+static us_timestamp_t sleep_tracker_read_us(void)
+{
+#if DEVICE_LPTICKER
+    return ticker_read_us(get_lp_ticker_data());
+#else
+    return ticker_read_us(get_us_ticker_data());
+#endif
+}
 
 static sleep_statistic_t *sleep_tracker_find(const char *const filename)
 {
@@ -135,11 +159,76 @@ static void sleep_tracker_print_stats(void)
             return;
         }
 
-        mbed_error_printf("[id: %s, count: %u]\r\n", sleep_stats[i].identifier,
-                          sleep_stats[i].count);
+        mbed_error_printf("[id: %s, count: %u, held: %lu ms, blocked: %lu ms, energy: %lu uJ]\r\n",
+                          sleep_stats[i].identifier, sleep_stats[i].count,
+                          (unsigned long)(sleep_stats[i].held_time / 1000),
+                          (unsigned long)(sleep_stats[i].blocked_time / 1000),
+                          (unsigned long)(sleep_stats[i].energy_nj / 1000));
     }
 }
 
+// Charge a sleep blocked by deep sleep locks to the owners holding them
+static void sleep_tracker_blocked(us_timestamp_t duration)
+{
+    uint32_t current = MBED_CONF_PLATFORM_SLEEP_TRACING_SLEEP_CURRENT_UA;
+    if (sleep_current_source != NULL) {
+        current = sleep_current_source(duration);
+    }
+
+    // uA * us is pJ
+    uint64_t energy = 0;
+    if (current > MBED_CONF_PLATFORM_SLEEP_TRACING_DEEP_SLEEP_CURRENT_UA) {
+        energy = (uint64_t)(current - MBED_CONF_PLATFORM_SLEEP_TRACING_DEEP_SLEEP_CURRENT_UA) * duration / 1000;
+    }
+
+    int holders = 0;
+    for (int i = 0; i < STATISTIC_COUNT; ++i) {
+        if (sleep_stats[i].count != 0) {
+            holders++;
+        }
+    }
+
+    for (int i = 0; i < STATISTIC_COUNT; ++i) {
+        if (sleep_stats[i].count != 0) {
+            sleep_stats[i].blocked_time += duration;
+            sleep_stats[i].energy_nj += energy / holders;
+        }
+    }
+}
+
+int sleep_tracker_get_stats(mbed_sleep_tracker_stats_t *stats, int count)
+{
+    int filled = 0;
+
+    core_util_critical_section_enter();
+    us_timestamp_t now = sleep_tracker_read_us();
+    for (int i = 0; i < STATISTIC_COUNT && filled < count; ++i) {
+        if (sleep_stats[i].identifier[0] == '\0') {
+            break;
+        }
+
+        mbed_sleep_tracker_stats_t *stat = &stats[filled++];
+        memcpy(stat->identifier, sleep_stats[i].identifier, sizeof(stat->identifier));
+        stat->count = sleep_stats[i].count;
+        stat->held_time = sleep_stats[i].held_time;
+        if (sleep_stats[i].count != 0) {
+            stat->held_time += now - sleep_stats[i].lock_start;
+        }
+        stat->blocked_time = sleep_stats[i].blocked_time;
+        stat->energy_nj = sleep_stats[i].energy_nj;
+    }
+    core_util_critical_section_exit();
+
+    return filled;
+}
+
+void sleep_tracker_set_current_source(sleep_tracker_current_source_t source)
+{
+    core_util_critical_section_enter();
+    sleep_current_source = source;
+    core_util_critical_section_exit();
+}
+
 void sleep_tracker_lock(const char *const filename, int line)
 {
     sleep_statistic_t *stat = sleep_tracker_find(filename);
@@ -147,9 +236,16 @@ void sleep_tracker_lock(const char *const filename, int line)
     // Entry for this driver does not exist, create one.
     if (stat == NULL) {
         stat = sleep_tracker_add(filename);
+        if (stat == NULL) {
+            return;
+        }
     }
 
-    core_util_atomic_incr_u8(&stat->count, 1);
+    core_util_critical_section_enter();
+    if (stat->count++ == 0) {
+        stat->lock_start = sleep_tracker_read_us();
+    }
+    core_util_critical_section_exit();
 
     mbed_error_printf("LOCK: %s, ln: %i, lock count: %u\r\n", filename, line, deep_sleep_lock);
 }
@@ -164,7 +260,11 @@ void sleep_tracker_unlock(const char *const filename, int line)
         return;
     }
 
-    core_util_atomic_decr_u8(&stat->count, 1);
+    core_util_critical_section_enter();
+    if (stat->count != 0 && --stat->count == 0) {
+        stat->held_time += sleep_tracker_read_us() - stat->lock_start;
+    }
+    core_util_critical_section_exit();
 
     mbed_error_printf("UNLOCK: %s, ln: %i, lock count: %u\r\n", filename, line, deep_sleep_lock);
 }
@@ -219,6 +319,10 @@ void sleep_manager_sleep_auto(void)
     core_util_critical_section_enter();
     us_timestamp_t start = read_us();
     bool deep = false;
+#ifdef MBED_SLEEP_TRACING_ENABLED
+    bool blocked = !sleep_manager_can_deep_sleep();
+    us_timestamp_t tracker_start = sleep_tracker_read_us();
+#endif
 
 // debug profile should keep debuggers attached, no deep sleep allowed
 #ifdef MBED_DEBUG
@@ -238,6 +342,11 @@ void sleep_manager_sleep_auto(void)
     } else {
         sleep_time += end - start;
     }
+#ifdef MBED_SLEEP_TRACING_ENABLED
+    if (blocked) {
+        sleep_tracker_blocked(sleep_tracker_read_us() - tracker_start);
+    }
+#endif
     core_util_critical_section_exit();
 }
 
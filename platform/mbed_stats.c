@@ -6,9 +6,12 @@
 #include <stdlib.h>
 
 #include "device.h"
+#include "platform/mbed_critical.h"
+#include "hal/us_ticker_api.h"
 #ifdef MBED_CONF_RTOS_PRESENT
 #include "cmsis_os2.h"
 #include "rtos_idle.h"
+#include "rtos_handlers.h"
 #elif defined(MBED_STACK_STATS_ENABLED) || defined(MBED_THREAD_STATS_ENABLED) || defined(MBED_CPU_STATS_ENABLED)
 #warning Statistics are currently not supported without the rtos.
 #endif
@@ -17,6 +20,18 @@
 #warning CPU statistics are not supported without low power timer support.
 #endif
 
+#if defined(MBED_MUTEX_STATS_ENABLED) && !defined(MBED_CONF_RTOS_PRESENT)
+#warning Mutex statistics are not supported without the rtos.
+#endif
+
+#if defined(MBED_IRQ_STATS_ENABLED) && !defined(__CORTEX_M)
+#warning IRQ statistics are only supported on Cortex-M.
+#endif
+
+#if defined(MBED_BOOT_STATS_ENABLED) && !defined(DWT_CTRL_CYCCNTENA_Msk)
+#warning Boot statistics are only supported on cores with a DWT cycle counter.
+#endif
+
 void mbed_stats_cpu_get(mbed_stats_cpu_t *stats)
 {
     MBED_ASSERT(stats != NULL);
@@ -30,6 +45,10 @@ void mbed_stats_cpu_get(mbed_stats_cpu_t *stats)
 }
 
 // note: mbed_stats_heap_get defined in mbed_alloc_wrappers.cpp
+#if MBED_CONF_PLATFORM_TLSF_HEAP_ENABLED
+void mbed_heap_get_thread_sizes(mbed_stats_thread_t *stats, size_t count);
+#endif
+
 void mbed_stats_stack_get(mbed_stats_stack_t *stats)
 {
     MBED_ASSERT(stats != NULL);
@@ -95,6 +114,40 @@ size_t mbed_stats_stack_get_each(mbed_stats_stack_t *stats, size_t count)
     return i;
 }
 
+size_t mbed_stats_stack_get_each_sampled(mbed_stats_stack_t *stats, size_t count)
+{
+    MBED_ASSERT(stats != NULL);
+    memset(stats, 0, count * sizeof(mbed_stats_stack_t));
+
+    size_t i = 0;
+
+#if defined(MBED_STACK_STATS_ENABLED) && defined(MBED_CONF_RTOS_PRESENT)
+    osThreadId_t *threads;
+
+    threads = malloc(sizeof(osThreadId_t) * count);
+    // Don't fail on lack of memory
+    if (!threads) {
+        return 0;
+    }
+
+    osKernelLock();
+    count = osThreadEnumerate(threads, count);
+
+    for (i = 0; i < count; i++) {
+        uint32_t stack_size = osThreadGetStackSize(threads[i]);
+        stats[i].max_size = stack_size - rtos_thread_get_stack_space_sampled(threads[i]);
+        stats[i].reserved_size = stack_size;
+        stats[i].thread_id = (uint32_t)threads[i];
+        stats[i].stack_cnt = 1;
+    }
+    osKernelUnlock();
+
+    free(threads);
+#endif
+
+    return i;
+}
+
 size_t mbed_stats_thread_get_each(mbed_stats_thread_t *stats, size_t count)
 {
     MBED_ASSERT(stats != NULL);
@@ -117,13 +170,29 @@ size_t mbed_stats_thread_get_each(mbed_stats_thread_t *stats, size_t count)
         stats[i].stack_size = osThreadGetStackSize(threads[i]);
         stats[i].stack_space = osThreadGetStackSpace(threads[i]);
         stats[i].name = osThreadGetName(threads[i]);
+        stats[i].cpu_time = rtos_thread_get_cpu_time(threads[i]);
     }
     osKernelUnlock();
     free(threads);
+
+#if MBED_CONF_PLATFORM_TLSF_HEAP_ENABLED
+    // the heap lock can't be taken with the kernel locked
+    mbed_heap_get_thread_sizes(stats, i);
+#endif
 #endif
     return i;
 }
 
+// note: mbed_stats_mutex_get_each defined in rtos/Mutex.cpp when enabled
+#if !defined(MBED_MUTEX_STATS_ENABLED) || !defined(MBED_CONF_RTOS_PRESENT)
+size_t mbed_stats_mutex_get_each(mbed_stats_mutex_t *stats, size_t count)
+{
+    MBED_ASSERT(stats != NULL);
+    memset(stats, 0, count * sizeof(mbed_stats_mutex_t));
+    return 0;
+}
+#endif
+
 void mbed_stats_sys_get(mbed_stats_sys_t *stats)
 {
     MBED_ASSERT(stats != NULL);
@@ -181,3 +250,226 @@ void mbed_stats_sys_get(mbed_stats_sys_t *stats)
 #endif
     return;
 }
+
+#if defined(MBED_IRQ_STATS_ENABLED) && defined(__CORTEX_M)
+typedef struct {
+    int32_t irqn;
+    uint32_t vector;
+    uint32_t count;
+    uint32_t max_ticks;
+    uint64_t total_ticks;
+} irq_stats_handler_t;
+
+typedef struct {
+    void *caller;
+    uint32_t ticks;
+} irq_stats_critical_section_t;
+
+static irq_stats_handler_t irq_handlers[MBED_IRQ_STATS_MAX_HANDLERS];
+static uint32_t irq_handler_cnt;
+static irq_stats_critical_section_t critical_sections[MBED_IRQ_STATS_MAX_CRITICAL_SECTIONS];
+static uint32_t critical_section_cnt;
+static void *critical_section_caller;
+static uint32_t critical_section_start;
+static bool critical_section_timed;
+
+// Times are measured in raw us ticker counts, as the ticker API itself uses
+// critical sections and can't be called from the hooks
+static bool irq_stats_ticker_ready(void)
+{
+    return get_us_ticker_data()->queue->initialized;
+}
+
+static uint32_t irq_stats_read(void)
+{
+    return get_us_ticker_data()->interface->read();
+}
+
+static uint32_t irq_stats_elapsed(uint32_t start)
+{
+    uint32_t bits = get_us_ticker_data()->interface->get_info()->bits;
+    uint32_t mask = (bits >= 32) ? 0xFFFFFFFF : ((1UL << bits) - 1);
+    return (irq_stats_read() - start) & mask;
+}
+
+static us_timestamp_t irq_stats_to_us(uint64_t ticks)
+{
+    uint32_t frequency = get_us_ticker_data()->interface->get_info()->frequency;
+    if (frequency == 1000000) {
+        return ticks;
+    }
+    return ticks * 1000000 / frequency;
+}
+
+static void irq_stats_handler(void)
+{
+    int32_t irqn = (int32_t)(__get_IPSR() & 0x1FF) - 16;
+    irq_stats_handler_t *handler = NULL;
+    for (uint32_t i = 0; i < irq_handler_cnt; i++) {
+        if (irq_handlers[i].irqn == irqn) {
+            handler = &irq_handlers[i];
+            break;
+        }
+    }
+    MBED_ASSERT(handler != NULL);
+
+    uint32_t start = irq_stats_read();
+    ((void (*)(void))handler->vector)();
+    uint32_t ticks = irq_stats_elapsed(start);
+
+    core_util_critical_section_enter();
+    handler->count++;
+    handler->total_ticks += ticks;
+    if (ticks > handler->max_ticks) {
+        handler->max_ticks = ticks;
+    }
+    core_util_critical_section_exit();
+}
+
+void mbed_stats_critical_section_entered(void *caller)
+{
+    critical_section_timed = irq_stats_ticker_ready();
+    if (critical_section_timed) {
+        critical_section_caller = caller;
+        critical_section_start = irq_stats_read();
+    }
+}
+
+void mbed_stats_critical_section_exiting(void)
+{
+    if (!critical_section_timed) {
+        return;
+    }
+    critical_section_timed = false;
+    uint32_t ticks = irq_stats_elapsed(critical_section_start);
+
+    // keep the list sorted longest first, a caller appears only once
+    uint32_t i;
+    for (i = 0; i < critical_section_cnt; i++) {
+        if (critical_sections[i].caller == critical_section_caller) {
+            break;
+        }
+    }
+    if (i < critical_section_cnt) {
+        if (ticks <= critical_sections[i].ticks) {
+            return;
+        }
+    } else if (critical_section_cnt < MBED_IRQ_STATS_MAX_CRITICAL_SECTIONS) {
+        i = critical_section_cnt++;
+    } else if (ticks > critical_sections[critical_section_cnt - 1].ticks) {
+        i = critical_section_cnt - 1;
+    } else {
+        return;
+    }
+    for (; i > 0 && critical_sections[i - 1].ticks < ticks; i--) {
+        critical_sections[i] = critical_sections[i - 1];
+    }
+    critical_sections[i].caller = critical_section_caller;
+    critical_sections[i].ticks = ticks;
+}
+#endif
+
+void mbed_stats_irq_get(mbed_stats_irq_t *stats)
+{
+    MBED_ASSERT(stats != NULL);
+    memset(stats, 0, sizeof(mbed_stats_irq_t));
+
+#if defined(MBED_IRQ_STATS_ENABLED) && defined(__CORTEX_M)
+    core_util_critical_section_enter();
+    stats->handler_cnt = irq_handler_cnt;
+    for (uint32_t i = 0; i < irq_handler_cnt; i++) {
+        stats->handlers[i].irqn = irq_handlers[i].irqn;
+        stats->handlers[i].count = irq_handlers[i].count;
+        stats->handlers[i].max_time = irq_stats_to_us(irq_handlers[i].max_ticks);
+        stats->handlers[i].total_time = irq_stats_to_us(irq_handlers[i].total_ticks);
+    }
+    stats->critical_section_cnt = critical_section_cnt;
+    for (uint32_t i = 0; i < critical_section_cnt; i++) {
+        stats->critical_sections[i].caller = critical_sections[i].caller;
+        stats->critical_sections[i].time = irq_stats_to_us(critical_sections[i].ticks);
+    }
+    core_util_critical_section_exit();
+#endif
+}
+
+int mbed_stats_irq_profile(int irqn)
+{
+#if defined(MBED_IRQ_STATS_ENABLED) && defined(__CORTEX_M)
+    // Make sure the ticker is running before the first measurement
+    us_ticker_read();
+
+    int ret = 0;
+    core_util_critical_section_enter();
+    uint32_t i;
+    for (i = 0; i < irq_handler_cnt; i++) {
+        if (irq_handlers[i].irqn == irqn) {
+            break;
+        }
+    }
+    if (i == irq_handler_cnt) {
+        if (irq_handler_cnt < MBED_IRQ_STATS_MAX_HANDLERS) {
+            irq_handlers[i].irqn = irqn;
+            irq_handlers[i].vector = NVIC_GetVector((IRQn_Type)irqn);
+            irq_handler_cnt++;
+            NVIC_SetVector((IRQn_Type)irqn, (uint32_t)irq_stats_handler);
+        } else {
+            ret = -1;
+        }
+    }
+    core_util_critical_section_exit();
+    return ret;
+#else
+    return -1;
+#endif
+}
+
+#if defined(MBED_BOOT_STATS_ENABLED)
+static uint32_t boot_phase_mask;
+static uint32_t boot_phase_cycles[MBED_BOOT_PHASE_COUNT];
+static us_timestamp_t boot_phase_time[MBED_BOOT_PHASE_COUNT];
+
+void mbed_stats_boot_mark(mbed_boot_phase_t phase)
+{
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+    if (phase == MBED_BOOT_PHASE_INIT) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    uint32_t cycles = DWT->CYCCNT;
+
+    // SystemCoreClock changes during mbed_sdk_init, convert each interval
+    // with the clock it ends at rather than the final one
+    uint32_t last = 0;
+    us_timestamp_t time = 0;
+    for (int i = phase - 1; i >= 0; i--) {
+        if (boot_phase_mask & (1UL << i)) {
+            last = boot_phase_cycles[i];
+            time = boot_phase_time[i];
+            break;
+        }
+    }
+    uint32_t mhz = SystemCoreClock / 1000000;
+    if (mhz) {
+        time += (cycles - last) / mhz;
+    }
+    boot_phase_cycles[phase] = cycles;
+    boot_phase_time[phase] = time;
+#endif
+    boot_phase_mask |= 1UL << phase;
+}
+#endif
+
+void mbed_stats_boot_get(mbed_stats_boot_t *stats)
+{
+    MBED_ASSERT(stats != NULL);
+    memset(stats, 0, sizeof(mbed_stats_boot_t));
+
+#if defined(MBED_BOOT_STATS_ENABLED)
+    stats->phase_mask = boot_phase_mask;
+    for (int i = 0; i < MBED_BOOT_PHASE_COUNT; i++) {
+        stats->phase_cycles[i] = boot_phase_cycles[i];
+        stats->phase_time[i] = boot_phase_time[i];
+    }
+#endif
+}
@@ -54,6 +54,16 @@ extern "C" {
 /** Maximum memory regions reported by mbed-os memory statistics */
 #define MBED_MAX_MEM_REGIONS     4
 
+/** Maximum IRQ handlers profiled by mbed-os IRQ statistics */
+#ifndef MBED_IRQ_STATS_MAX_HANDLERS
+#define MBED_IRQ_STATS_MAX_HANDLERS             8
+#endif
+
+/** Number of longest critical sections reported by mbed-os IRQ statistics */
+#ifndef MBED_IRQ_STATS_MAX_CRITICAL_SECTIONS
+#define MBED_IRQ_STATS_MAX_CRITICAL_SECTIONS    4
+#endif
+
 /**
  * struct mbed_stats_heap_t definition
  */
@@ -65,6 +75,9 @@ typedef struct {
     uint32_t alloc_cnt;         /**< Current number of allocations that have not been freed since reset */
     uint32_t alloc_fail_cnt;    /**< Number of failed allocations since reset */
     uint32_t overhead_size;     /**< Number of bytes used to store heap statistics. This overhead takes up space on the heap, reducing the available heap space */
+    uint32_t free_size;         /**< Bytes currently free on the heap, only reported by the TLSF heap */
+    uint32_t largest_free_size; /**< Size of the largest free block, the largest allocation that can succeed. Only reported by the TLSF heap */
+    uint32_t free_block_cnt;    /**< Number of free blocks the free space is fragmented into. Only reported by the TLSF heap */
 } mbed_stats_heap_t;
 
 /**
@@ -103,6 +116,20 @@ void mbed_stats_stack_get(mbed_stats_stack_t *stats);
  */
 size_t mbed_stats_stack_get_each(mbed_stats_stack_t *stats, size_t count);
 
+/**
+ *  Fill the passed array of structures with the sampled stack statistics for each available thread.
+ *
+ *  Unlike mbed_stats_stack_get_each, this doesn't scan each stack: the maximum
+ *  stack usage is tracked a few words at a time on each thread switch, so it
+ *  is cheap enough to call periodically but may lag behind a recent deeper use.
+ *
+ *  @param stats    A pointer to an array of mbed_stats_stack_t structures to fill
+ *  @param count    The number of mbed_stats_stack_t structures in the provided array
+ *  @return         The number of mbed_stats_stack_t structures that have been filled,
+ *                  as for mbed_stats_stack_get_each.
+ */
+size_t mbed_stats_stack_get_each_sampled(mbed_stats_stack_t *stats, size_t count);
+
 /**
  * struct mbed_stats_cpu_t definition
  */
@@ -130,6 +157,8 @@ typedef struct {
     uint32_t stack_size;        /**< Current number of bytes reserved for the stack */
     uint32_t stack_space;       /**< Current number of free bytes remaining on the stack */
     const char   *name;         /**< Name of the thread */
+    us_timestamp_t cpu_time;    /**< Time the thread has been running since it was started, 0 if more threads exist than MBED_CONF_RTOS_THREAD_CPU_STATS_COUNT */
+    uint32_t heap_size;         /**< Bytes currently allocated on the heap by the thread, only reported by the TLSF heap */
 } mbed_stats_thread_t;
 
 /**
@@ -143,6 +172,36 @@ typedef struct {
  */
 size_t mbed_stats_thread_get_each(mbed_stats_thread_t *stats, size_t count);
 
+/**
+ * struct mbed_stats_mutex_t definition
+ */
+typedef struct {
+    uint32_t id;                    /**< ID of the mutex */
+    const char *name;               /**< Name of the mutex */
+    uint32_t acquire_cnt;           /**< Number of times the mutex was acquired, including recursive locks */
+    uint32_t contended_cnt;         /**< Number of times a thread had to wait for the mutex */
+    us_timestamp_t total_wait_time; /**< Cumulative time threads waited for the mutex */
+    us_timestamp_t max_wait_time;   /**< Longest time a thread waited for the mutex */
+    us_timestamp_t max_hold_time;   /**< Longest time the mutex was held */
+    uint32_t max_hold_thread_id;    /**< ID of the thread which held the mutex the longest */
+} mbed_stats_mutex_t;
+
+/**
+ *  Fill the passed array of stat structures with the contention statistics of each rtos::Mutex.
+ *
+ *  Mutex statistics are not part of MBED_ALL_STATS_ENABLED, as they add
+ *  overhead to every lock. Waits and holds are timed with the microsecond
+ *  ticker, so times longer than about 71 minutes wrap around.
+ *
+ *  @param stats    A pointer to an array of mbed_stats_mutex_t structures to fill
+ *  @param count    The number of mbed_stats_mutex_t structures in the provided array
+ *  @return         The number of mbed_stats_mutex_t structures that have been filled,
+ *                  the most recently created mutexes first.
+ *                  If the number of mutexes on the system is less than or equal to count, it will equal the number of mutexes on the system.
+ *                  If the number of mutexes on the system is greater than count, it will equal count.
+ */
+size_t mbed_stats_mutex_get_each(mbed_stats_mutex_t *stats, size_t count);
+
 /**
  * enum mbed_compiler_id_t definition
  */
@@ -173,6 +232,110 @@ typedef struct {
  */
 void mbed_stats_sys_get(mbed_stats_sys_t *stats);
 
+/**
+ * struct mbed_stats_irq_handler_t definition
+ */
+typedef struct {
+    int32_t irqn;                   /**< IRQ number of the handler */
+    uint32_t count;                 /**< Number of times the handler has run */
+    us_timestamp_t max_time;        /**< Longest run of the handler, including any nested interrupts */
+    us_timestamp_t total_time;      /**< Cumulative run time of the handler, including any nested interrupts */
+} mbed_stats_irq_handler_t;
+
+/**
+ * struct mbed_stats_critical_section_t definition
+ */
+typedef struct {
+    void *caller;                   /**< Address core_util_critical_section_enter was called from */
+    us_timestamp_t time;            /**< Time interrupts stayed masked */
+} mbed_stats_critical_section_t;
+
+/**
+ * struct mbed_stats_irq_t definition
+ */
+typedef struct {
+    uint32_t handler_cnt;                                                               /**< Number of profiled IRQ handlers */
+    mbed_stats_irq_handler_t handlers[MBED_IRQ_STATS_MAX_HANDLERS];                     /**< Statistics of each profiled IRQ handler */
+    uint32_t critical_section_cnt;                                                      /**< Number of recorded critical sections */
+    mbed_stats_critical_section_t critical_sections[MBED_IRQ_STATS_MAX_CRITICAL_SECTIONS]; /**< Longest critical sections since reset, longest first */
+} mbed_stats_irq_t;
+
+/**
+ *  Fill the passed in IRQ stat structure with IRQ statistics.
+ *
+ *  IRQ statistics are not part of MBED_ALL_STATS_ENABLED, as they add
+ *  overhead to every critical section. Critical sections are timed from the
+ *  moment the microsecond ticker is initialized.
+ *
+ *  @param stats    A pointer to the mbed_stats_irq_t structure to fill
+ */
+void mbed_stats_irq_get(mbed_stats_irq_t *stats);
+
+/**
+ *  Start profiling the handler of an IRQ.
+ *
+ *  The vector of the IRQ is replaced with a wrapper measuring the run time
+ *  of the current handler, so this must be called after the handler is
+ *  installed, and the vector table must be in RAM.
+ *
+ *  @param irqn     IRQ number of the handler to profile
+ *  @return         0 on success, -1 if MBED_IRQ_STATS_MAX_HANDLERS handlers
+ *                  are already profiled or IRQ statistics are not enabled
+ */
+int mbed_stats_irq_profile(int irqn);
+
+/**
+ * enum mbed_boot_phase_t definition
+ */
+typedef enum {
+    MBED_BOOT_PHASE_INIT = 0,       /**< mbed_init entered, C runtime memory initialized */
+    MBED_BOOT_PHASE_SDK_INIT,       /**< mbed_sdk_init returned, clocks and target set up */
+    MBED_BOOT_PHASE_RTOS_INIT,      /**< RTOS kernel initialized */
+    MBED_BOOT_PHASE_START,          /**< mbed_start entered, in the main thread if the RTOS is present */
+    MBED_BOOT_PHASE_STATIC_INIT,    /**< C++ static constructors run */
+    MBED_BOOT_PHASE_MAIN,           /**< main about to be called */
+    MBED_BOOT_PHASE_COUNT
+} mbed_boot_phase_t;
+
+/**
+ * struct mbed_stats_boot_t definition
+ */
+typedef struct {
+    uint32_t phase_mask;                            /**< Bit n set if phase n was reached */
+    us_timestamp_t phase_time[MBED_BOOT_PHASE_COUNT]; /**< Time each phase was reached, from MBED_BOOT_PHASE_INIT */
+    uint32_t phase_cycles[MBED_BOOT_PHASE_COUNT];   /**< CPU cycles each phase was reached, from MBED_BOOT_PHASE_INIT */
+} mbed_stats_boot_t;
+
+/**
+ *  Fill the passed in boot stat structure with the timestamps of the boot phases.
+ *
+ *  Timestamps are read from the DWT cycle counter, so they are only available
+ *  on Cortex-M3 and later cores. Cycles are converted with SystemCoreClock at
+ *  the time each phase is reached. The time spent before mbed_init, in the
+ *  reset handler, SystemInit and the C runtime memory initialization, is not
+ *  included.
+ *
+ *  @param stats    A pointer to the mbed_stats_boot_t structure to fill
+ */
+void mbed_stats_boot_get(mbed_stats_boot_t *stats);
+
+/** @cond INTERNAL */
+/* Called by the boot code as each phase is reached */
+#if defined(MBED_BOOT_STATS_ENABLED)
+void mbed_stats_boot_mark(mbed_boot_phase_t phase);
+#else
+#define mbed_stats_boot_mark(phase) ((void)0)
+#endif
+/** @endcond */
+
+#if defined(MBED_IRQ_STATS_ENABLED)
+/** @cond INTERNAL */
+/* Called by core_util_critical_section_enter/exit with interrupts masked */
+void mbed_stats_critical_section_entered(void *caller);
+void mbed_stats_critical_section_exiting(void);
+/** @endcond */
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,74 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "platform/mbed_swo_trace.h"
+#include "device.h"
+
+#if defined(MBED_SWO_TRACE_ENABLED) && !DEVICE_ITM
+#warning SWO trace enabled on a target without ITM, no events are emitted
+#endif
+
+#if defined(MBED_SWO_TRACE_ENABLED) && DEVICE_ITM
+
+#include "hal/itm_api.h"
+#include "platform/mbed_critical.h"
+
+void mbed_swo_trace_start(uint32_t ports)
+{
+    mbed_itm_init();
+
+    // Port 0 is owned by SerialWireOutput
+    ports &= ~(1UL << ITM_PORT_SWO);
+
+    core_util_critical_section_enter();
+    // Local timestamps on the core clock, without prescaler
+#ifdef ITM_TCR_TSPrescale_Msk
+    ITM->TCR = (ITM->TCR & ~ITM_TCR_TSPrescale_Msk) | ITM_TCR_TSENA_Msk;
+#else
+    ITM->TCR |= ITM_TCR_TSENA_Msk;
+#endif
+    ITM->TER |= ports | (1UL << MBED_SWO_TRACE_CLOCK);
+    core_util_critical_section_exit();
+
+    // The decoder converts timestamps to time with the last clock event
+    mbed_swo_trace(MBED_SWO_TRACE_CLOCK, SystemCoreClock);
+    if (!(ports & (1UL << MBED_SWO_TRACE_CLOCK))) {
+        core_util_critical_section_enter();
+        ITM->TER &= ~(1UL << MBED_SWO_TRACE_CLOCK);
+        core_util_critical_section_exit();
+    }
+}
+
+void mbed_swo_trace_stop(uint32_t ports)
+{
+    ports &= ~(1UL << ITM_PORT_SWO);
+
+    core_util_critical_section_enter();
+    ITM->TER &= ~ports;
+    core_util_critical_section_exit();
+}
+
+#else
+
+void mbed_swo_trace_start(uint32_t ports)
+{
+}
+
+void mbed_swo_trace_stop(uint32_t ports)
+{
+}
+
+#endif
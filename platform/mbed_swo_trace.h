@@ -0,0 +1,147 @@
+/** \addtogroup platform */
+/** @{*/
+/**
+ * \defgroup platform_swo_trace SWO trace functions
+ * @{
+ */
+
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_SWO_TRACE_H
+#define MBED_SWO_TRACE_H
+
+#include <stdint.h>
+#if defined(MBED_SWO_TRACE_ENABLED) && DEVICE_ITM
+#include "cmsis.h"
+#endif
+
+/* Binary trace events over the ITM stimulus ports
+ *
+ * Each event is a single write of its argument to the stimulus port of
+ * the event, so the port number identifies the event in the ITM packet and
+ * costs no payload. The ITM adds local timestamps in hardware, counting
+ * core clock cycles. Port 0 stays the SerialWireOutput character stream.
+ *
+ * Events are compiled in when the platform.swo-trace-enabled option is set
+ * on a target with ITM, and emitted once their port is enabled with
+ * mbed_swo_trace_start(). tools/swo_trace_decode.py converts the captured
+ * SWO stream to a timeline.
+ */
+
+/** Trace events, the value is the stimulus port */
+enum {
+    MBED_SWO_TRACE_THREAD_SWITCH = 1,       /**< RTOS thread switched in, argument: thread ID */
+    MBED_SWO_TRACE_TICKER_IRQ = 2,          /**< Ticker interrupt handler entered, argument: ticker data */
+    MBED_SWO_TRACE_TICKER_IRQ_END = 3,      /**< Ticker interrupt handler left */
+    MBED_SWO_TRACE_EQUEUE_DISPATCH = 4,     /**< Event queue callback called, argument: callback address */
+    MBED_SWO_TRACE_EQUEUE_DISPATCH_END = 5, /**< Event queue callback returned */
+    MBED_SWO_TRACE_SOCKET_SEND = 6,         /**< Socket data sent, argument: number of bytes */
+    MBED_SWO_TRACE_SOCKET_RECV = 7,         /**< Socket data received, argument: number of bytes */
+    MBED_SWO_TRACE_BD_READ = 8,             /**< Block device read started, argument: address */
+    MBED_SWO_TRACE_BD_PROGRAM = 9,          /**< Block device program started, argument: address */
+    MBED_SWO_TRACE_BD_ERASE = 10,           /**< Block device erase started, argument: address */
+    MBED_SWO_TRACE_BD_END = 11,             /**< Block device operation completed, argument: error code */
+    MBED_SWO_TRACE_CLOCK = 15,              /**< Timestamp clock, argument: frequency in Hz */
+    MBED_SWO_TRACE_USER = 16                /**< First of the 16 ports left to the application */
+};
+
+/** Mask of the ports of all the events above */
+#define MBED_SWO_TRACE_ALL      0x8FFEUL
+
+/** Mask of the application ports */
+#define MBED_SWO_TRACE_ALL_USER 0xFFFF0000UL
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Start tracing the given events
+ *
+ *  Initializes the ITM if needed, enables its local timestamps and the
+ *  ports of the events, then emits MBED_SWO_TRACE_CLOCK.
+ *
+ *  @param ports    Mask of the stimulus ports to enable, for example
+ *                  MBED_SWO_TRACE_ALL or
+ *                  (1 << MBED_SWO_TRACE_EQUEUE_DISPATCH) | (1 << MBED_SWO_TRACE_EQUEUE_DISPATCH_END)
+ *
+ *  @note Does nothing unless platform.swo-trace-enabled is set.
+ */
+void mbed_swo_trace_start(uint32_t ports);
+
+/** Stop tracing the given events
+ *
+ *  @param ports    Mask of the stimulus ports to disable
+ */
+void mbed_swo_trace_stop(uint32_t ports);
+
+#if defined(MBED_SWO_TRACE_ENABLED) && DEVICE_ITM
+
+#ifndef ITM_STIM_FIFOREADY_Msk
+#define ITM_STIM_FIFOREADY_Msk 1
+#endif
+
+/** Emit an event with a 32-bit argument
+ *
+ *  Does nothing if the port is disabled, otherwise waits for room in the
+ *  ITM FIFO. Interrupts are masked for the few instructions of the write,
+ *  so an event from an interrupt handler can't take the room.
+ *
+ *  @note You may call this function from ISR context.
+ */
+static inline void mbed_swo_trace(uint32_t port, uint32_t arg)
+{
+    if (ITM->TER & (1UL << port)) {
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        while ((ITM->PORT[port].u32 & ITM_STIM_FIFOREADY_Msk) == 0) {
+        }
+        ITM->PORT[port].u32 = arg;
+        __set_PRIMASK(primask);
+    }
+}
+
+/** Emit an event without argument, as an 8-bit write for a shorter packet */
+static inline void mbed_swo_trace_mark(uint32_t port)
+{
+    if (ITM->TER & (1UL << port)) {
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        while ((ITM->PORT[port].u32 & ITM_STIM_FIFOREADY_Msk) == 0) {
+        }
+        ITM->PORT[port].u8 = 0;
+        __set_PRIMASK(primask);
+    }
+}
+
+#define MBED_SWO_TRACE(port, arg)   mbed_swo_trace((port), (uint32_t)(arg))
+#define MBED_SWO_TRACE_MARK(port)   mbed_swo_trace_mark(port)
+
+#else
+
+#define MBED_SWO_TRACE(port, arg)   ((void)0)
+#define MBED_SWO_TRACE_MARK(port)   ((void)0)
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/** @}*/
+/** @}*/
@@ -0,0 +1,400 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "platform/mbed_tlsf.h"
+#include "platform/mbed_assert.h"
+#include <string.h>
+
+/* Every block starts with a header, followed by the payload. The blocks of
+ * the pool are physically linked through prev_phys and their sizes; a zero
+ * sized block marks the end of the pool. Free blocks store their free list
+ * links in the payload.
+ */
+typedef struct mbed_tlsf_block {
+    struct mbed_tlsf_block *prev_phys;
+    size_t size;                        // payload size, the low bit is set if free
+    void *owner;
+    size_t requested;
+    struct mbed_tlsf_block *next_free;
+    struct mbed_tlsf_block *prev_free;
+} block_t;
+
+#define BLOCK_FREE          ((size_t)1)
+#define BLOCK_SIZE_MASK     (~(size_t)(MBED_TLSF_ALIGN - 1))
+#define BLOCK_HEADER_SIZE   offsetof(block_t, next_free)
+#define BLOCK_MIN_SIZE      ((sizeof(block_t) - BLOCK_HEADER_SIZE + MBED_TLSF_ALIGN - 1) & BLOCK_SIZE_MASK)
+#define BLOCK_MAX_SIZE      (((size_t)1 << (MBED_TLSF_FL_MAX_LOG2 + 1)) - MBED_TLSF_ALIGN)
+#define SMALL_BLOCK_SIZE    ((size_t)1 << MBED_TLSF_FL_SHIFT)
+
+MBED_STATIC_ASSERT(BLOCK_HEADER_SIZE % MBED_TLSF_ALIGN == 0, "TLSF block header must keep the payload aligned");
+MBED_STATIC_ASSERT(SMALL_BLOCK_SIZE == MBED_TLSF_SL_COUNT * MBED_TLSF_ALIGN, "TLSF first level shift must match the alignment");
+
+static int tlsf_fls(uint32_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return x ? 31 - __builtin_clz(x) : -1;
+#else
+    int bit = -1;
+    while (x) {
+        x >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+static int tlsf_ffs(uint32_t x)
+{
+    return tlsf_fls(x & (~x + 1));
+}
+
+static size_t block_size(const block_t *block)
+{
+    return block->size & BLOCK_SIZE_MASK;
+}
+
+static bool block_is_free(const block_t *block)
+{
+    return block->size & BLOCK_FREE;
+}
+
+static block_t *block_next(const block_t *block)
+{
+    return (block_t *)((char *)block + BLOCK_HEADER_SIZE + block_size(block));
+}
+
+static void *block_to_ptr(const block_t *block)
+{
+    return (char *)block + BLOCK_HEADER_SIZE;
+}
+
+static block_t *block_from_ptr(const void *ptr)
+{
+    return (block_t *)((char *)ptr - BLOCK_HEADER_SIZE);
+}
+
+static size_t adjust_size(size_t size)
+{
+    if (size < BLOCK_MIN_SIZE) {
+        return BLOCK_MIN_SIZE;
+    }
+    return (size + MBED_TLSF_ALIGN - 1) & BLOCK_SIZE_MASK;
+}
+
+static void mapping_insert(size_t size, int *fl, int *sl)
+{
+    if (size < SMALL_BLOCK_SIZE) {
+        *fl = 0;
+        *sl = (int)(size / MBED_TLSF_ALIGN);
+    } else {
+        int t = tlsf_fls((uint32_t)size);
+        *sl = (int)(size >> (t - MBED_TLSF_SL_LOG2)) ^ MBED_TLSF_SL_COUNT;
+        *fl = t - MBED_TLSF_FL_SHIFT + 1;
+    }
+}
+
+// Rounds the size up to the next class, so any block found there fits
+static void mapping_search(size_t size, int *fl, int *sl)
+{
+    if (size >= SMALL_BLOCK_SIZE) {
+        size += ((size_t)1 << (tlsf_fls((uint32_t)size) - MBED_TLSF_SL_LOG2)) - 1;
+    }
+    mapping_insert(size, fl, sl);
+}
+
+static void insert_free(mbed_tlsf_t *tlsf, block_t *block)
+{
+    int fl, sl;
+    mapping_insert(block_size(block), &fl, &sl);
+
+    block_t *head = tlsf->blocks[fl][sl];
+    block->next_free = head;
+    block->prev_free = NULL;
+    if (head) {
+        head->prev_free = block;
+    }
+    tlsf->blocks[fl][sl] = block;
+    tlsf->fl_bitmap |= 1UL << fl;
+    tlsf->sl_bitmap[fl] |= 1UL << sl;
+
+    tlsf->free_size += block_size(block);
+    tlsf->free_block_cnt++;
+}
+
+static void remove_free(mbed_tlsf_t *tlsf, block_t *block)
+{
+    int fl, sl;
+    mapping_insert(block_size(block), &fl, &sl);
+
+    if (block->next_free) {
+        block->next_free->prev_free = block->prev_free;
+    }
+    if (block->prev_free) {
+        block->prev_free->next_free = block->next_free;
+    } else {
+        tlsf->blocks[fl][sl] = block->next_free;
+        if (!block->next_free) {
+            tlsf->sl_bitmap[fl] &= ~(1UL << sl);
+            if (!tlsf->sl_bitmap[fl]) {
+                tlsf->fl_bitmap &= ~(1UL << fl);
+            }
+        }
+    }
+
+    tlsf->free_size -= block_size(block);
+    tlsf->free_block_cnt--;
+}
+
+// Marks the block free, coalescing it with free neighbours
+static void block_release(mbed_tlsf_t *tlsf, block_t *block)
+{
+    block->size |= BLOCK_FREE;
+    block->owner = NULL;
+
+    block_t *prev = block->prev_phys;
+    if (prev && block_is_free(prev)) {
+        remove_free(tlsf, prev);
+        prev->size += BLOCK_HEADER_SIZE + block_size(block);
+        block = prev;
+        block_next(block)->prev_phys = block;
+    }
+
+    block_t *next = block_next(block);
+    if (block_is_free(next)) {
+        remove_free(tlsf, next);
+        block->size += BLOCK_HEADER_SIZE + block_size(next);
+        block_next(block)->prev_phys = block;
+    }
+
+    insert_free(tlsf, block);
+}
+
+// Trims a used block to size, returning the remainder to the heap
+static void block_trim(mbed_tlsf_t *tlsf, block_t *block, size_t size)
+{
+    if (block_size(block) < size + BLOCK_HEADER_SIZE + BLOCK_MIN_SIZE) {
+        return;
+    }
+
+    block_t *rest = (block_t *)((char *)block_to_ptr(block) + size);
+    rest->prev_phys = block;
+    rest->size = block_size(block) - size - BLOCK_HEADER_SIZE;
+    block->size = size;
+    block_next(rest)->prev_phys = rest;
+    block_release(tlsf, rest);
+}
+
+// Takes a free block of at least size out of the heap
+static block_t *block_locate(mbed_tlsf_t *tlsf, size_t size)
+{
+    int fl, sl;
+    mapping_search(size, &fl, &sl);
+    if (fl >= MBED_TLSF_FL_COUNT) {
+        return NULL;
+    }
+
+    uint32_t sl_map = tlsf->sl_bitmap[fl] & (~0UL << sl);
+    if (!sl_map) {
+        uint32_t fl_map = tlsf->fl_bitmap & (~0UL << (fl + 1));
+        if (!fl_map) {
+            return NULL;
+        }
+        fl = tlsf_ffs(fl_map);
+        sl_map = tlsf->sl_bitmap[fl];
+    }
+    sl = tlsf_ffs(sl_map);
+
+    block_t *block = tlsf->blocks[fl][sl];
+    remove_free(tlsf, block);
+    block->size &= ~BLOCK_FREE;
+    return block;
+}
+
+int mbed_tlsf_init(mbed_tlsf_t *tlsf, void *mem, size_t size)
+{
+    memset(tlsf, 0, sizeof(mbed_tlsf_t));
+
+    uintptr_t start = ((uintptr_t)mem + MBED_TLSF_ALIGN - 1) & BLOCK_SIZE_MASK;
+    if (size < start - (uintptr_t)mem + 2 * BLOCK_HEADER_SIZE + BLOCK_MIN_SIZE) {
+        return -1;
+    }
+    size = (size - (start - (uintptr_t)mem)) & BLOCK_SIZE_MASK;
+    if (size > BLOCK_MAX_SIZE + 2 * BLOCK_HEADER_SIZE) {
+        size = BLOCK_MAX_SIZE + 2 * BLOCK_HEADER_SIZE;
+    }
+
+    block_t *block = (block_t *)start;
+    block->prev_phys = NULL;
+    block->size = size - 2 * BLOCK_HEADER_SIZE;
+
+    // zero sized used block ending the pool
+    block_t *end = block_next(block);
+    end->prev_phys = block;
+    end->size = 0;
+
+    tlsf->first = block;
+    block_release(tlsf, block);
+    return 0;
+}
+
+void *mbed_tlsf_malloc(mbed_tlsf_t *tlsf, size_t size, void *owner)
+{
+    if (size > BLOCK_MAX_SIZE) {
+        return NULL;
+    }
+
+    size_t adjusted = adjust_size(size);
+    block_t *block = block_locate(tlsf, adjusted);
+    if (!block) {
+        return NULL;
+    }
+
+    block_trim(tlsf, block, adjusted);
+    block->owner = owner;
+    block->requested = size;
+    return block_to_ptr(block);
+}
+
+void *mbed_tlsf_memalign(mbed_tlsf_t *tlsf, size_t align, size_t size, void *owner)
+{
+    MBED_ASSERT((align & (align - 1)) == 0);
+    if (align <= MBED_TLSF_ALIGN) {
+        return mbed_tlsf_malloc(tlsf, size, owner);
+    }
+    if (size > BLOCK_MAX_SIZE - align - BLOCK_HEADER_SIZE - BLOCK_MIN_SIZE) {
+        return NULL;
+    }
+
+    // leave room to split a free block off in front of the aligned payload
+    size_t adjusted = adjust_size(size);
+    block_t *block = block_locate(tlsf, adjusted + align + BLOCK_HEADER_SIZE + BLOCK_MIN_SIZE);
+    if (!block) {
+        return NULL;
+    }
+
+    uintptr_t ptr = (uintptr_t)block_to_ptr(block);
+    uintptr_t aligned = (ptr + align - 1) & ~(uintptr_t)(align - 1);
+    while (aligned != ptr && aligned - ptr < BLOCK_HEADER_SIZE + BLOCK_MIN_SIZE) {
+        aligned += align;
+    }
+
+    if (aligned != ptr) {
+        block_t *front = block;
+        block = block_from_ptr((void *)aligned);
+        block->prev_phys = front;
+        block->size = block_size(front) - (aligned - ptr);
+        block_next(block)->prev_phys = block;
+        front->size = aligned - ptr - BLOCK_HEADER_SIZE;
+        block_release(tlsf, front);
+    }
+
+    block_trim(tlsf, block, adjusted);
+    block->owner = owner;
+    block->requested = size;
+    return block_to_ptr(block);
+}
+
+void *mbed_tlsf_realloc(mbed_tlsf_t *tlsf, void *ptr, size_t size, void *owner)
+{
+    if (!ptr) {
+        return mbed_tlsf_malloc(tlsf, size, owner);
+    }
+    if (size == 0) {
+        mbed_tlsf_free(tlsf, ptr);
+        return NULL;
+    }
+    if (size > BLOCK_MAX_SIZE) {
+        return NULL;
+    }
+
+    block_t *block = block_from_ptr(ptr);
+    MBED_ASSERT(!block_is_free(block));
+    size_t adjusted = adjust_size(size);
+
+    // grow into the following block if it is free
+    block_t *next = block_next(block);
+    if (block_size(block) < adjusted && block_is_free(next) &&
+            block_size(block) + BLOCK_HEADER_SIZE + block_size(next) >= adjusted) {
+        remove_free(tlsf, next);
+        block->size += BLOCK_HEADER_SIZE + block_size(next);
+        block_next(block)->prev_phys = block;
+    }
+
+    if (block_size(block) >= adjusted) {
+        block_trim(tlsf, block, adjusted);
+        block->requested = size;
+        return ptr;
+    }
+
+    void *new_ptr = mbed_tlsf_malloc(tlsf, size, owner);
+    if (new_ptr) {
+        memcpy(new_ptr, ptr, block_size(block));
+        mbed_tlsf_free(tlsf, ptr);
+    }
+    return new_ptr;
+}
+
+void mbed_tlsf_free(mbed_tlsf_t *tlsf, void *ptr)
+{
+    if (!ptr) {
+        return;
+    }
+
+    block_t *block = block_from_ptr(ptr);
+    MBED_ASSERT(!block_is_free(block));
+    block_release(tlsf, block);
+}
+
+size_t mbed_tlsf_requested_size(const void *ptr)
+{
+    return block_from_ptr(ptr)->requested;
+}
+
+size_t mbed_tlsf_block_size(const void *ptr)
+{
+    return BLOCK_HEADER_SIZE + block_size(block_from_ptr(ptr));
+}
+
+void mbed_tlsf_get_stats(const mbed_tlsf_t *tlsf, mbed_tlsf_stats_t *stats)
+{
+    stats->free_size = tlsf->free_size;
+    stats->free_block_cnt = tlsf->free_block_cnt;
+    stats->largest_free_size = 0;
+
+    // the largest block is in the highest non-empty class
+    if (tlsf->fl_bitmap) {
+        int fl = tlsf_fls(tlsf->fl_bitmap);
+        int sl = tlsf_fls(tlsf->sl_bitmap[fl]);
+        for (const block_t *block = tlsf->blocks[fl][sl]; block; block = block->next_free) {
+            if (block_size(block) > stats->largest_free_size) {
+                stats->largest_free_size = block_size(block);
+            }
+        }
+    }
+}
+
+void mbed_tlsf_walk(const mbed_tlsf_t *tlsf, void (*walker)(void *ptr, size_t size, void *owner, void *context), void *context)
+{
+    if (!tlsf->first) {
+        return;
+    }
+
+    for (const block_t *block = tlsf->first; block_size(block); block = block_next(block)) {
+        if (!block_is_free(block)) {
+            walker(block_to_ptr(block), block->requested, block->owner, context);
+        }
+    }
+}
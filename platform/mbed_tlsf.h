@@ -0,0 +1,159 @@
+/** \addtogroup platform */
+/** @{*/
+/**
+ * \defgroup platform_tlsf TLSF heap allocator
+ * @{
+ */
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_TLSF_H
+#define MBED_TLSF_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Alignment of the memory returned by the allocator */
+#define MBED_TLSF_ALIGN             8
+
+/** Log2 of the number of second level lists per power of two */
+#define MBED_TLSF_SL_LOG2           3
+#define MBED_TLSF_SL_COUNT          (1 << MBED_TLSF_SL_LOG2)
+
+/** Log2 of the largest block size, pools are clamped to this size */
+#define MBED_TLSF_FL_MAX_LOG2       30
+#define MBED_TLSF_FL_SHIFT          (MBED_TLSF_SL_LOG2 + 3)
+#define MBED_TLSF_FL_COUNT          (MBED_TLSF_FL_MAX_LOG2 - MBED_TLSF_FL_SHIFT + 2)
+
+struct mbed_tlsf_block;
+
+/** Two-level segregated fit allocator
+ *
+ *  Free blocks are kept in size classes, split into powers of two and then
+ *  MBED_TLSF_SL_COUNT linear steps, with a bitmap of non-empty classes.
+ *  Allocation and free take constant time and adjacent free blocks are
+ *  always coalesced.
+ *
+ *  @note Synchronization level: Not protected
+ */
+typedef struct {
+    uint32_t fl_bitmap;
+    uint32_t sl_bitmap[MBED_TLSF_FL_COUNT];
+    struct mbed_tlsf_block *blocks[MBED_TLSF_FL_COUNT][MBED_TLSF_SL_COUNT];
+    struct mbed_tlsf_block *first;
+    size_t free_size;
+    uint32_t free_block_cnt;
+} mbed_tlsf_t;
+
+/** Fragmentation statistics of a TLSF heap */
+typedef struct {
+    size_t free_size;           /**< Bytes available in free blocks */
+    size_t largest_free_size;   /**< Size of the largest free block */
+    uint32_t free_block_cnt;    /**< Number of free blocks */
+} mbed_tlsf_stats_t;
+
+/** Initialize a TLSF heap over a memory pool
+ *
+ *  @param tlsf     Heap to initialize
+ *  @param mem      Start of the memory pool
+ *  @param size     Size of the memory pool in bytes
+ *  @return         0 on success, -1 if the pool is too small
+ */
+int mbed_tlsf_init(mbed_tlsf_t *tlsf, void *mem, size_t size);
+
+/** Allocate memory
+ *
+ *  @param tlsf     Heap to allocate from
+ *  @param size     Number of bytes to allocate
+ *  @param owner    Value recorded with the allocation, see mbed_tlsf_walk
+ *  @return         Pointer to the memory, NULL if no block is large enough
+ */
+void *mbed_tlsf_malloc(mbed_tlsf_t *tlsf, size_t size, void *owner);
+
+/** Allocate aligned memory
+ *
+ *  @param tlsf     Heap to allocate from
+ *  @param align    Alignment in bytes, must be a power of two
+ *  @param size     Number of bytes to allocate
+ *  @param owner    Value recorded with the allocation, see mbed_tlsf_walk
+ *  @return         Pointer to the memory, NULL if no block is large enough
+ */
+void *mbed_tlsf_memalign(mbed_tlsf_t *tlsf, size_t align, size_t size, void *owner);
+
+/** Resize memory, in place if possible
+ *
+ *  @param tlsf     Heap the memory was allocated from
+ *  @param ptr      Memory to resize, or NULL to allocate
+ *  @param size     New size in bytes, or 0 to free
+ *  @param owner    Value recorded if the memory moves
+ *  @return         Pointer to the memory, NULL on failure or if size is 0.
+ *                  On failure the original memory is left untouched
+ */
+void *mbed_tlsf_realloc(mbed_tlsf_t *tlsf, void *ptr, size_t size, void *owner);
+
+/** Free memory
+ *
+ *  @param tlsf     Heap the memory was allocated from
+ *  @param ptr      Memory to free, or NULL
+ */
+void mbed_tlsf_free(mbed_tlsf_t *tlsf, void *ptr);
+
+/** Get the size requested for an allocation
+ *
+ *  @param ptr      Memory returned by the allocator
+ *  @return         Size requested in the last malloc or realloc
+ */
+size_t mbed_tlsf_requested_size(const void *ptr);
+
+/** Get the size an allocation takes from the pool
+ *
+ *  @param ptr      Memory returned by the allocator
+ *  @return         Bytes taken by the block, including its header
+ */
+size_t mbed_tlsf_block_size(const void *ptr);
+
+/** Get the fragmentation statistics of a heap
+ *
+ *  @param tlsf     Heap to query
+ *  @param stats    Statistics to fill
+ */
+void mbed_tlsf_get_stats(const mbed_tlsf_t *tlsf, mbed_tlsf_stats_t *stats);
+
+/** Call a function for each allocation in a heap
+ *
+ *  Takes time linear in the number of blocks in the heap.
+ *
+ *  @param tlsf     Heap to walk
+ *  @param walker   Function called with each allocation, its requested size
+ *                  and the owner recorded when it was allocated
+ *  @param context  Value passed to the walker
+ */
+void mbed_tlsf_walk(const mbed_tlsf_t *tlsf, void (*walker)(void *ptr, size_t size, void *owner, void *context), void *context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/** @}*/
+
+/** @}*/
@@ -404,6 +404,32 @@
 #endif
 #endif
 
+/** MBED_NOINIT
+ * Declare a variable the startup code doesn't zero.
+ *
+ * Use it for large buffers which are always written before being read,
+ * to save the time spent zeroing them at boot. The content is undefined
+ * at boot. Targets whose linker script doesn't place .bss.noinit outside
+ * of .bss zero the variable as usual.
+ *
+ * @code
+ * #include "mbed_toolchain.h"
+ *
+ * MBED_NOINIT static uint8_t buffer[16384];
+ * @endcode
+ */
+#ifndef MBED_NOINIT
+#if defined(__ICCARM__)
+#define MBED_NOINIT __no_init
+#elif defined(__CC_ARM)
+#define MBED_NOINIT __attribute__ ((section (".bss.noinit"), zero_init))
+#elif defined(__GNUC__) || defined(__clang__)
+#define MBED_NOINIT __attribute__ ((section (".bss.noinit")))
+#else
+#define MBED_NOINIT
+#endif
+#endif
+
 /**
  * Macro expanding to a string literal of the enclosing function name.
  *
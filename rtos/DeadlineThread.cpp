@@ -0,0 +1,155 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "rtos/DeadlineThread.h"
+#include "rtos/Kernel.h"
+#include "rtos/ThisThread.h"
+
+#include "platform/mbed_assert.h"
+
+namespace rtos {
+
+// All started DeadlineThreads, only changed with the kernel locked
+static DeadlineThread *deadline_threads;
+
+DeadlineThread::DeadlineThread(uint32_t period_ms, uint32_t deadline_ms, uint32_t stack_size, const char *name) :
+    _thread(PRIORITY_MIN, stack_size, NULL, name),
+    _period(period_ms),
+    _deadline(deadline_ms),
+    _stopping(false),
+    _next(NULL),
+    _abs_deadline(0),
+    _pending(false),
+    _jobs(0),
+    _misses(0),
+    _max_response_time(0)
+{
+    MBED_ASSERT(period_ms > 0);
+    MBED_ASSERT(deadline_ms > 0);
+}
+
+DeadlineThread::~DeadlineThread()
+{
+    stop();
+}
+
+osStatus DeadlineThread::start(mbed::Callback<void()> job)
+{
+    _job = job;
+
+    int32_t lock = osKernelLock();
+    _next = deadline_threads;
+    deadline_threads = this;
+    osKernelRestoreLock(lock);
+
+    osStatus status = _thread.start(mbed::callback(this, &DeadlineThread::run));
+    if (status != osOK) {
+        stop();
+    }
+    return status;
+}
+
+void DeadlineThread::stop()
+{
+    _stopping = true;
+    if (_thread.get_state() != Thread::Deleted && _thread.get_state() != Thread::Inactive) {
+        _thread.flags_set(STOP_FLAG);
+        _thread.join();
+    }
+
+    int32_t lock = osKernelLock();
+    for (DeadlineThread **p = &deadline_threads; *p; p = &(*p)->_next) {
+        if (*p == this) {
+            *p = _next;
+            break;
+        }
+    }
+    osKernelRestoreLock(lock);
+}
+
+void DeadlineThread::run()
+{
+    uint64_t next_release = Kernel::get_ms_count();
+    while (!_stopping) {
+        release(next_release + _deadline);
+        _job();
+        complete();
+
+        uint64_t now = Kernel::get_ms_count();
+        uint32_t response_time = now - next_release;
+        if (now > _abs_deadline) {
+            _misses++;
+        }
+        if (response_time > _max_response_time) {
+            _max_response_time = response_time;
+        }
+        _jobs++;
+
+        next_release += _period;
+        if (now > next_release) {
+            // Skipped releases also missed their deadline
+            uint64_t skipped = (now - next_release) / _period + 1;
+            _misses += skipped;
+            next_release += skipped * _period;
+        }
+        ThisThread::flags_wait_any_until(STOP_FLAG, next_release);
+    }
+}
+
+void DeadlineThread::release(uint64_t deadline)
+{
+    int32_t lock = osKernelLock();
+    _abs_deadline = deadline;
+    _pending = true;
+    update_priorities();
+    // The released job may now have a lower priority than another pending
+    // one, the switch happens when the kernel is unlocked
+    osKernelRestoreLock(lock);
+}
+
+void DeadlineThread::complete()
+{
+    int32_t lock = osKernelLock();
+    _pending = false;
+    update_priorities();
+    osKernelRestoreLock(lock);
+}
+
+void DeadlineThread::update_priorities()
+{
+    // Called with the kernel locked. The number of DeadlineThreads is
+    // small, so each one is ranked by counting the earlier deadlines.
+    for (DeadlineThread *t = deadline_threads; t; t = t->_next) {
+        if (!t->_pending) {
+            continue;
+        }
+        int rank = 0;
+        for (DeadlineThread *u = deadline_threads; u; u = u->_next) {
+            if (u != t && u->_pending &&
+                    (u->_abs_deadline < t->_abs_deadline ||
+                     (u->_abs_deadline == t->_abs_deadline && u < t))) {
+                rank++;
+            }
+        }
+        int priority = PRIORITY_MAX - rank;
+        if (priority < PRIORITY_MIN) {
+            priority = PRIORITY_MIN;
+        }
+        osThreadSetPriority(t->_thread.get_id(), (osPriority_t)priority);
+    }
+}
+
+}
@@ -0,0 +1,152 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DEADLINE_THREAD_H
+#define DEADLINE_THREAD_H
+
+#include <stdint.h>
+#include "rtos/Thread.h"
+#include "platform/Callback.h"
+#include "platform/NonCopyable.h"
+
+namespace rtos {
+/** \addtogroup rtos */
+/** @{*/
+
+/**
+ * \defgroup rtos_DeadlineThread DeadlineThread class
+ * @{
+ */
+
+/** A thread running a job periodically, scheduled earliest deadline first
+ *
+ * Each period the job is released, and must complete within the relative
+ * deadline. The priorities of the DeadlineThreads with a pending job are
+ * reassigned at each release and completion, so the earliest absolute
+ * deadline gets the highest priority. Priorities are taken from
+ * PRIORITY_MAX down to PRIORITY_MIN, so other threads keep their place:
+ * networking and application threads below PRIORITY_MIN are preempted by
+ * all jobs, threads above PRIORITY_MAX preempt them.
+ *
+ * A job completing after its deadline is counted as a miss. If a job
+ * overruns whole periods, the releases it skipped are also counted as
+ * misses, and the next release is aligned on the period again.
+ *
+ * Example:
+ * @code
+ * void control_loop()
+ * {
+ *     // read sensors, update outputs
+ * }
+ *
+ * DeadlineThread loop(10, 5);
+ *
+ * int main() {
+ *     loop.start(control_loop);
+ * }
+ * @endcode
+ *
+ * @note The deadline is checked with the 1 ms resolution of the kernel tick.
+ */
+class DeadlineThread : private mbed::NonCopyable<DeadlineThread> {
+public:
+    /** Highest priority given to a pending job */
+    static const osPriority PRIORITY_MAX = osPriorityHigh;
+
+    /** Lowest priority given to a pending job */
+    static const osPriority PRIORITY_MIN = osPriorityAboveNormal;
+
+    /** Allocate a new deadline thread without starting it
+     *
+     * @param period_ms   Time between two releases of the job, in ms
+     * @param deadline_ms Time after its release the job must complete by, in ms
+     * @param stack_size  Stack size of the thread (default: OS_STACK_SIZE)
+     * @param name        Name of the thread, it has to stay allocated for the lifetime of the thread (default: NULL)
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    DeadlineThread(uint32_t period_ms, uint32_t deadline_ms,
+                   uint32_t stack_size = OS_STACK_SIZE, const char *name = NULL);
+
+    /** Stop the thread and free it
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    virtual ~DeadlineThread();
+
+    /** Start running the job, the first release is immediate
+     *
+     * @param job Function run once per period
+     * @return status code that indicates the execution status of the function
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    osStatus start(mbed::Callback<void()> job);
+
+    /** Stop releasing the job, and wait for the thread to finish
+     *
+     * A running job completes first.
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    void stop();
+
+    /** Get the number of jobs completed */
+    uint32_t jobs() const
+    {
+        return _jobs;
+    }
+
+    /** Get the number of deadline misses, including skipped releases */
+    uint32_t deadline_misses() const
+    {
+        return _misses;
+    }
+
+    /** Get the longest time from release to completion of a job, in ms */
+    uint32_t max_response_time() const
+    {
+        return _max_response_time;
+    }
+
+private:
+    static const uint32_t STOP_FLAG = 1;
+
+    void run();
+    void release(uint64_t deadline);
+    void complete();
+    static void update_priorities();
+
+    Thread _thread;
+    mbed::Callback<void()> _job;
+    uint32_t _period;
+    uint32_t _deadline;
+    bool _stopping;
+
+    // Pending job, scheduling state shared by all DeadlineThreads
+    DeadlineThread *_next;
+    uint64_t _abs_deadline;
+    bool _pending;
+
+    uint32_t _jobs;
+    uint32_t _misses;
+    uint32_t _max_response_time;
+};
+
+/** @}*/
+/** @}*/
+}
+#endif
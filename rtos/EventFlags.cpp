@@ -49,7 +49,11 @@ void EventFlags::constructor(const char *name)
 
 uint32_t EventFlags::set(uint32_t flags)
 {
-    return osEventFlagsSet(_id, flags);
+    uint32_t ret = osEventFlagsSet(_id, flags);
+    if (!(ret & osFlagsError)) {
+        notify();
+    }
+    return ret;
 }
 
 uint32_t EventFlags::clear(uint32_t flags)
@@ -62,6 +66,11 @@ uint32_t EventFlags::get() const
     return osEventFlagsGet(_id);
 }
 
+bool EventFlags::ready() const
+{
+    return get() != 0;
+}
+
 uint32_t EventFlags::wait_all(uint32_t flags, uint32_t timeout, bool clear)
 {
     return wait(flags, osFlagsWaitAll, timeout, clear);
@@ -27,6 +27,7 @@
 #include "mbed_rtos1_types.h"
 #include "mbed_rtos_storage.h"
 
+#include "rtos/Waitable.h"
 #include "platform/NonCopyable.h"
 
 namespace rtos {
@@ -46,7 +47,7 @@ namespace rtos {
  Memory considerations: The EventFlags control structures will be created on the current thread's stack, both for the Mbed OS
  and underlying RTOS objects (static or dynamic RTOS memory pools are not being used).
 */
-class EventFlags : private mbed::NonCopyable<EventFlags> {
+class EventFlags : public Waitable, private mbed::NonCopyable<EventFlags> {
 public:
     /** Create and initialize an EventFlags object.
      *
@@ -114,6 +115,7 @@ public:
 private:
     void constructor(const char *name = NULL);
     uint32_t wait(uint32_t flags, uint32_t opt, uint32_t timeout, bool clear);
+    virtual bool ready() const;
     osEventFlagsId_t                _id;
     mbed_rtos_storage_event_flags_t _obj_mem;
 };
@@ -0,0 +1,105 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "rtos/FastMutex.h"
+#include "rtos/Kernel.h"
+
+namespace rtos {
+
+FastMutex::FastMutex(): _owner(0), _count(0), _waiters(0), _owner_priority(osPriorityNone), _boosted(false)
+{
+}
+
+bool FastMutex::trylock_for(uint32_t millisec)
+{
+    osThreadId_t self = current_thread();
+    uint32_t expected = 0;
+    if (!core_util_atomic_cas_u32(&_owner, &expected, (uint32_t)self)) {
+        if ((expected & ~CONTENDED) == (uint32_t)self) {
+            _count++;
+            return true;
+        }
+        if (millisec == 0 || !lock_slow(self, millisec)) {
+            return false;
+        }
+    }
+    _count = 1;
+    return true;
+}
+
+bool FastMutex::lock_slow(osThreadId_t self, uint32_t millisec)
+{
+    uint64_t deadline = Kernel::get_ms_count() + millisec;
+    uint32_t current = _owner;
+    while (true) {
+        if (current == 0) {
+            // Other threads may still be waiting, keep the flag so they are woken
+            if (core_util_atomic_cas_u32(&_owner, &current, (uint32_t)self | CONTENDED)) {
+                return true;
+            }
+            continue;
+        }
+        if (!(current & CONTENDED)) {
+            if (!core_util_atomic_cas_u32(&_owner, &current, current | CONTENDED)) {
+                continue;
+            }
+            current |= CONTENDED;
+        }
+
+        // With the kernel locked the owner can't run, so it can't release
+        // the mutex between the check and the priority change
+        osPriority_t priority = osThreadGetPriority(self);
+        int32_t lock = osKernelLock();
+        if (_owner == current) {
+            osThreadId_t owner = (osThreadId_t)(current & ~CONTENDED);
+            osPriority_t owner_priority = osThreadGetPriority(owner);
+            if (priority > owner_priority) {
+                if (!_boosted) {
+                    _owner_priority = owner_priority;
+                    _boosted = true;
+                }
+                osThreadSetPriority(owner, priority);
+            }
+        }
+        osKernelRestoreLock(lock);
+
+        uint32_t wait = osWaitForever;
+        if (millisec != osWaitForever) {
+            uint64_t now = Kernel::get_ms_count();
+            if (now >= deadline) {
+                return false;
+            }
+            wait = deadline - now;
+        }
+        // Wake-ups may be spurious, the owner is checked again
+        _waiters.wait(wait);
+        current = _owner;
+    }
+}
+
+void FastMutex::unlock_slow()
+{
+    int32_t lock = osKernelLock();
+    if (_boosted) {
+        osThreadSetPriority(current_thread(), _owner_priority);
+        _boosted = false;
+    }
+    _owner = 0;
+    osKernelRestoreLock(lock);
+    _waiters.release();
+}
+
+}
@@ -0,0 +1,155 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FAST_MUTEX_H
+#define FAST_MUTEX_H
+
+#include <stdint.h>
+#include "cmsis_os2.h"
+#include "mbed_rtos_storage.h"
+#include "rtos/Semaphore.h"
+
+#include "platform/NonCopyable.h"
+#include "platform/ScopedLock.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_critical.h"
+
+namespace rtos {
+/** \addtogroup rtos */
+/** @{*/
+
+/**
+ * \defgroup rtos_FastMutex FastMutex class
+ * @{
+ */
+
+/** A recursive mutex which only calls the kernel when contended.
+ *
+ * Locking and unlocking an uncontended FastMutex is a compare and swap on
+ * the owner, instead of the supervisor calls of Mutex. Threads which find
+ * it locked wait on a semaphore, after raising the priority of the owner
+ * to their own if it is lower. The owner goes back to its previous
+ * priority when it releases the mutex, like with the priority inheritance
+ * of Mutex.
+ *
+ * Use it in place of Mutex for locks taken very often and held briefly.
+ * Unlike Mutex, it can't be used with ConditionVariable, and is not
+ * reported by the mutex statistics.
+ *
+ * @note You cannot use member functions of this class in ISR context, or
+ * before the kernel is started.
+ */
+class FastMutex : private mbed::NonCopyable<FastMutex> {
+public:
+    /** Create and initialize a FastMutex object
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    FastMutex();
+
+    /** Wait until the mutex becomes available
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    void lock()
+    {
+        osThreadId_t self = current_thread();
+        uint32_t expected = 0;
+        if (!core_util_atomic_cas_u32(&_owner, &expected, (uint32_t)self)) {
+            if ((expected & ~CONTENDED) == (uint32_t)self) {
+                _count++;
+                return;
+            }
+            lock_slow(self, osWaitForever);
+        }
+        _count = 1;
+    }
+
+    /** Try to lock the mutex, and return immediately
+     *
+     * @return true if the mutex was acquired, false otherwise.
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    bool trylock()
+    {
+        return trylock_for(0);
+    }
+
+    /** Try to lock the mutex for a specified time
+     *
+     * @param millisec timeout value.
+     * @return true if the mutex was acquired, false otherwise.
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    bool trylock_for(uint32_t millisec);
+
+    /** Unlock the mutex that has previously been locked by the same thread
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    void unlock()
+    {
+        MBED_ASSERT((_owner & ~CONTENDED) == (uint32_t)current_thread());
+        if (--_count) {
+            return;
+        }
+        uint32_t expected = (uint32_t)current_thread();
+        if (!core_util_atomic_cas_u32(&_owner, &expected, 0)) {
+            unlock_slow();
+        }
+    }
+
+    /** Get the owner of this mutex
+     *
+     * @return the current owner of this mutex, or NULL if it is unlocked.
+     */
+    osThreadId_t get_owner()
+    {
+        return (osThreadId_t)(_owner & ~CONTENDED);
+    }
+
+private:
+    // Thread control blocks are word aligned, so the low bit of the owner
+    // is free to tell that other threads may be waiting
+    static const uint32_t CONTENDED = 1;
+
+    static osThreadId_t current_thread()
+    {
+        // osThreadGetId() is a supervisor call, read the running thread directly
+        osThreadId_t self = (osThreadId_t)osRtxInfo.thread.run.curr;
+        MBED_ASSERT(self != NULL);
+        return self;
+    }
+
+    bool lock_slow(osThreadId_t self, uint32_t millisec);
+    void unlock_slow();
+
+    volatile uint32_t _owner;
+    uint32_t _count;
+    Semaphore _waiters;
+    osPriority_t _owner_priority;
+    bool _boosted;
+};
+
+/** Typedef for the fast mutex lock */
+typedef mbed::ScopedLock<FastMutex> ScopedFastMutexLock;
+
+/** @}*/
+/** @}*/
+}
+#endif
@@ -0,0 +1,186 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LOCKFREEMEMORYPOOL_H
+#define LOCKFREEMEMORYPOOL_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "cmsis_os2.h"
+#include "rtos/Kernel.h"
+#include "rtos/Semaphore.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_assert.h"
+#include "platform/NonCopyable.h"
+
+namespace rtos {
+/** \addtogroup rtos */
+/** @{*/
+/**
+ * \defgroup rtos_LockFreeMemoryPool LockFreeMemoryPool class
+ * @{
+ */
+
+/** Fixed-size memory pool of objects of a given type, with a lock-free fast path.
+
+  Same interface as MemoryPool, but free blocks are kept in a free list
+  updated with core_util_atomic_cas_u32, so alloc() and free() don't call
+  into the RTOS kernel. The kernel is only called when alloc_for() has to
+  wait for a block, and by free() to wake such a waiter.
+
+  @tparam  T         data type of a single object (element).
+  @tparam  pool_sz   maximum number of objects (elements) in the memory pool.
+
+ @note
+ Memory considerations: the memory pool data store and control structures are part of this object.
+
+ @note Synchronization level: Interrupt safe
+*/
+template<typename T, uint32_t pool_sz>
+class LockFreeMemoryPool : private mbed::NonCopyable<LockFreeMemoryPool<T, pool_sz> > {
+    MBED_STATIC_ASSERT(pool_sz > 0, "Invalid memory pool size. Must be greater than 0.");
+    MBED_STATIC_ASSERT(pool_sz < 0xFFFF, "Invalid memory pool size. Must be less than 65535.");
+public:
+    /** Create and Initialize a memory pool.
+     *
+     * @note You cannot call this function from ISR context.
+    */
+    LockFreeMemoryPool() : _head(1), _waiters(0), _sem(0, pool_sz)
+    {
+        memset(_pool_mem, 0, sizeof(_pool_mem));
+        for (uint32_t i = 0; i < pool_sz; i++) {
+            _next[i] = i + 2 <= pool_sz ? i + 2 : 0;
+        }
+    }
+
+    /** Allocate a memory block of type T from a memory pool.
+      @return  address of the allocated memory block or NULL in case of no memory available.
+
+      @note You may call this function from ISR context.
+    */
+    T *alloc(void)
+    {
+        uint32_t head = core_util_atomic_load_u32(&_head);
+        uint32_t index;
+        do {
+            index = head & INDEX_MASK;
+            if (index == 0) {
+                return NULL;
+            }
+            // The tag changes on every update, so the exchange fails if the
+            // block was taken and returned since _next was read
+        } while (!core_util_atomic_cas_u32(&_head, &head, next_head(head, _next[index - 1])));
+
+        return (T *)_pool_mem[index - 1];
+    }
+
+    /** Allocate a memory block of type T from a memory pool, waiting for one to be freed if none is available.
+      @param   millisec  timeout value (osWaitForever to wait forever).
+      @return  address of the allocated memory block or NULL in case of no memory available.
+
+      @note You may call this function from ISR context if the millisec parameter is set to 0.
+    */
+    T *alloc_for(uint32_t millisec)
+    {
+        T *item = alloc();
+        if (item != NULL || millisec == 0) {
+            return item;
+        }
+
+        const uint64_t deadline = Kernel::get_ms_count() + millisec;
+        core_util_atomic_incr_u32(&_waiters, 1);
+        // Try again after registering as a waiter, so a block freed in
+        // between is not missed
+        while ((item = alloc()) == NULL) {
+            int32_t tokens;
+            if (millisec == osWaitForever) {
+                tokens = _sem.wait(osWaitForever);
+            } else {
+                tokens = _sem.wait_until(deadline);
+            }
+            if (tokens <= 0) {
+                item = alloc();
+                break;
+            }
+        }
+        core_util_atomic_decr_u32(&_waiters, 1);
+        return item;
+    }
+
+    /** Allocate a memory block of type T from a memory pool and set memory block to zero.
+      @return  address of the allocated memory block or NULL in case of no memory available.
+
+      @note You may call this function from ISR context.
+    */
+    T *calloc(void)
+    {
+        T *item = alloc();
+        if (item != NULL) {
+            memset(item, 0, sizeof(T));
+        }
+        return item;
+    }
+
+    /** Free a memory block.
+      @param   block  address of the allocated memory block to be freed.
+      @return         osOK on successful deallocation, osErrorParameter if given memory block id
+                      is NULL or invalid.
+
+      @note You may call this function from ISR context.
+    */
+    osStatus free(T *block)
+    {
+        const char *ptr = (const char *)block;
+        const char *base = (const char *)_pool_mem;
+        if (ptr < base || ptr >= base + sizeof(_pool_mem) || (ptr - base) % sizeof(_pool_mem[0]) != 0) {
+            return osErrorParameter;
+        }
+        const uint32_t index = (ptr - base) / sizeof(_pool_mem[0]) + 1;
+
+        uint32_t head = core_util_atomic_load_u32(&_head);
+        do {
+            _next[index - 1] = head & INDEX_MASK;
+        } while (!core_util_atomic_cas_u32(&_head, &head, next_head(head, index)));
+
+        if (core_util_atomic_load_u32(&_waiters) != 0) {
+            _sem.release();
+        }
+        return osOK;
+    }
+
+private:
+    // _head holds the 1-based index of the first free block, 0 when the pool
+    // is empty, and a tag in the upper half to detect concurrent updates
+    static const uint32_t INDEX_MASK = 0xFFFF;
+    static const uint32_t TAG_INCREMENT = 0x10000;
+
+    static uint32_t next_head(uint32_t head, uint32_t index)
+    {
+        return ((head + TAG_INCREMENT) & ~INDEX_MASK) | index;
+    }
+
+    volatile uint32_t _head;
+    volatile uint32_t _waiters;
+    Semaphore _sem;
+    volatile uint16_t _next[pool_sz];
+    uint32_t _pool_mem[pool_sz][(sizeof(T) + 3) / 4];
+};
+/** @}*/
+/** @}*/
+
+}
+#endif
@@ -0,0 +1,295 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "rtos/MessageChannel.h"
+#include "rtos/Kernel.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_assert.h"
+
+namespace rtos {
+namespace internal {
+
+#define MESSAGE_FLAG    0x1
+#define SPACE_FLAG      0x2
+
+// The state of a message is kept in the low bits of its record size, which
+// is always a multiple of 8
+#define STATE_MASK      0x7
+#define STATE_BORROWED  0x0
+#define STATE_COMMITTED 0x1
+#define STATE_RECEIVED  0x2
+#define STATE_RELEASED  0x3
+
+// Size of the released record padding the end of the arena when a message
+// doesn't fit there
+#define SIZE_PADDING    0xFFFFFFFF
+
+struct MessageChannelBase::Header {
+    uint32_t record;
+    uint32_t size;
+};
+
+MessageChannelBase::MessageChannelBase(uint64_t *buffer, uint32_t size)
+    : _buffer(buffer), _size(size), _free(0), _read(0), _write(0), _used(0),
+      _pending(0), _borrowers(0), _receivers(0)
+{
+    MBED_ASSERT((size % sizeof(Header)) == 0 && size > sizeof(Header));
+}
+
+MessageChannelBase::Header *MessageChannelBase::header(uint32_t offset) const
+{
+    return (Header *)((char *)_buffer + offset);
+}
+
+uint32_t MessageChannelBase::max_message_size() const
+{
+    return _size - sizeof(Header);
+}
+
+MessageChannelBase::Header *MessageChannelBase::try_borrow(uint32_t size)
+{
+    const uint32_t record = sizeof(Header) + ((size + 7) & ~7);
+
+    if (_used == 0) {
+        // Start again from the beginning, so the whole arena is contiguous
+        _free = _read = _write = 0;
+    } else if (_write == _free) {
+        return NULL;
+    }
+
+    if (_write < _free) {
+        if (record > _free - _write) {
+            return NULL;
+        }
+    } else if (record > _size - _write) {
+        if (record > _free) {
+            return NULL;
+        }
+        Header *padding = header(_write);
+        padding->record = (_size - _write) | STATE_RELEASED;
+        padding->size = SIZE_PADDING;
+        _used += _size - _write;
+        if (_pending == 0) {
+            _read = 0;
+        }
+        _write = 0;
+    }
+
+    Header *h = header(_write);
+    h->record = record | STATE_BORROWED;
+    h->size = size;
+    _write += record;
+    if (_write == _size) {
+        _write = 0;
+    }
+    _used += record;
+    _pending++;
+    return h;
+}
+
+void MessageChannelBase::advance_read()
+{
+    _read += header(_read)->record & ~STATE_MASK;
+    if (_read == _size) {
+        _read = 0;
+    }
+    _pending--;
+    // Never leave the read offset on padding
+    if (_pending > 0 && header(_read)->size == SIZE_PADDING) {
+        _read = 0;
+    }
+}
+
+MessageChannelBase::Header *MessageChannelBase::try_receive()
+{
+    while (_pending > 0) {
+        Header *h = header(_read);
+        const uint32_t state = h->record & STATE_MASK;
+        if (state == STATE_BORROWED) {
+            return NULL;
+        }
+
+        advance_read();
+        if (state == STATE_COMMITTED) {
+            h->record = (h->record & ~STATE_MASK) | STATE_RECEIVED;
+            return h;
+        }
+        // Discarded before it was committed
+    }
+    return NULL;
+}
+
+void MessageChannelBase::reclaim(bool *space_released)
+{
+    // Skip messages discarded before they were received
+    while (_pending > 0 && (header(_read)->record & STATE_MASK) == STATE_RELEASED) {
+        advance_read();
+    }
+
+    // Space is only reclaimed up to the next message to receive
+    while (_used > 0 && !(_free == _read && _pending > 0)) {
+        Header *h = header(_free);
+        if ((h->record & STATE_MASK) != STATE_RELEASED) {
+            break;
+        }
+        const uint32_t record = h->record & ~STATE_MASK;
+        _free += record;
+        if (_free == _size) {
+            _free = 0;
+        }
+        _used -= record;
+        *space_released = true;
+    }
+}
+
+bool MessageChannelBase::wait(uint32_t flag, uint64_t deadline, uint32_t millisec)
+{
+    uint32_t timeout = osWaitForever;
+    if (millisec != osWaitForever) {
+        uint64_t now = Kernel::get_ms_count();
+        if (now >= deadline) {
+            return false;
+        }
+        timeout = deadline - now;
+    }
+    return (_flags.wait_any(flag, timeout) & osFlagsError) == 0;
+}
+
+void *MessageChannelBase::borrow(uint32_t size, uint32_t millisec)
+{
+    if (size > max_message_size()) {
+        return NULL;
+    }
+
+    const uint64_t deadline = millisec != 0 && millisec != osWaitForever ? Kernel::get_ms_count() + millisec : 0;
+    core_util_critical_section_enter();
+    Header *h = try_borrow(size);
+    bool wake_next = false;
+    if (h == NULL && millisec != 0) {
+        bool woken;
+        _borrowers++;
+        do {
+            core_util_critical_section_exit();
+            woken = wait(SPACE_FLAG, deadline, millisec);
+            core_util_critical_section_enter();
+            h = try_borrow(size);
+        } while (h == NULL && woken);
+        _borrowers--;
+        // Only one waiter is woken at a time, let the next one check the space left
+        wake_next = h != NULL && _borrowers > 0;
+    }
+    core_util_critical_section_exit();
+
+    if (wake_next) {
+        _flags.set(SPACE_FLAG);
+    }
+    return h != NULL ? h + 1 : NULL;
+}
+
+void MessageChannelBase::commit(void *message, uint32_t size)
+{
+    Header *h = (Header *)message - 1;
+
+    core_util_critical_section_enter();
+    MBED_ASSERT((h->record & STATE_MASK) == STATE_BORROWED && size <= h->size);
+    h->size = size;
+    h->record = (h->record & ~STATE_MASK) | STATE_COMMITTED;
+    const bool wake = _receivers > 0;
+    core_util_critical_section_exit();
+
+    if (wake) {
+        _flags.set(MESSAGE_FLAG);
+    }
+}
+
+void *MessageChannelBase::receive(uint32_t *size, uint32_t millisec)
+{
+    const uint64_t deadline = millisec != 0 && millisec != osWaitForever ? Kernel::get_ms_count() + millisec : 0;
+    core_util_critical_section_enter();
+    Header *h = try_receive();
+    bool wake_next = false;
+    if (h == NULL && millisec != 0) {
+        bool woken;
+        _receivers++;
+        do {
+            core_util_critical_section_exit();
+            woken = wait(MESSAGE_FLAG, deadline, millisec);
+            core_util_critical_section_enter();
+            h = try_receive();
+        } while (h == NULL && woken);
+        _receivers--;
+        wake_next = h != NULL && _receivers > 0 && readable();
+    }
+    core_util_critical_section_exit();
+
+    if (wake_next) {
+        _flags.set(MESSAGE_FLAG);
+    }
+    if (h == NULL) {
+        return NULL;
+    }
+    *size = h->size;
+    return h + 1;
+}
+
+void MessageChannelBase::release(void *message)
+{
+    Header *h = (Header *)message - 1;
+    bool space_released = false;
+
+    core_util_critical_section_enter();
+    MBED_ASSERT((h->record & STATE_MASK) != STATE_RELEASED && (h->record & STATE_MASK) != STATE_COMMITTED);
+    h->record = (h->record & ~STATE_MASK) | STATE_RELEASED;
+    reclaim(&space_released);
+    const bool wake = space_released && _borrowers > 0;
+    core_util_critical_section_exit();
+
+    if (wake) {
+        _flags.set(SPACE_FLAG);
+    }
+}
+
+bool MessageChannelBase::readable() const
+{
+    core_util_critical_section_enter();
+    uint32_t offset = _read;
+    uint32_t pending = _pending;
+    bool found = false;
+    while (pending > 0) {
+        const Header *h = header(offset);
+        const uint32_t state = h->record & STATE_MASK;
+        if (state == STATE_BORROWED) {
+            break;
+        }
+        if (state == STATE_COMMITTED) {
+            found = true;
+            break;
+        }
+        offset += h->record & ~STATE_MASK;
+        if (offset == _size) {
+            offset = 0;
+        }
+        pending--;
+        if (pending > 0 && header(offset)->size == SIZE_PADDING) {
+            offset = 0;
+        }
+    }
+    core_util_critical_section_exit();
+    return found;
+}
+
+}
+}
@@ -0,0 +1,180 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MESSAGECHANNEL_H
+#define MESSAGECHANNEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "cmsis_os2.h"
+#include "rtos/EventFlags.h"
+#include "platform/mbed_toolchain.h"
+#include "platform/mbed_assert.h"
+#include "platform/NonCopyable.h"
+
+namespace rtos {
+/** \addtogroup rtos */
+/** @{*/
+/**
+ * \defgroup rtos_MessageChannel MessageChannel class
+ * @{
+ */
+
+namespace internal {
+
+/** Message channel over caller-provided storage, see MessageChannel
+ *
+ * @note You should use MessageChannel rather than this class directly.
+ */
+class MessageChannelBase : private mbed::NonCopyable<MessageChannelBase> {
+public:
+    /** Create a message channel over an arena
+     *
+     * @param buffer    Arena for the messages
+     * @param size      Size of the arena in bytes, a multiple of 8
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    MessageChannelBase(uint64_t *buffer, uint32_t size);
+
+    /** Borrow space for a message
+     *
+     * The space stays owned by the caller until passed to commit. Messages
+     * are received in the order they are borrowed, so a message that is
+     * borrowed but not yet committed holds back the ones borrowed after it.
+     *
+     * @param size      Size of the message in bytes
+     * @param millisec  Time to wait for space to be released (osWaitForever to wait forever)
+     * @return          Pointer to the message, 8 byte aligned, or NULL if
+     *                  there is no space or the message can never fit
+     *
+     * @note You may call this function from ISR context if the millisec parameter is set to 0.
+     */
+    void *borrow(uint32_t size, uint32_t millisec = 0);
+
+    /** Commit a borrowed message, making it available to receive
+     *
+     * @param message   Message returned by borrow
+     * @param size      Size of the message in bytes, at most the size borrowed
+     *
+     * @note You may call this function from ISR context.
+     */
+    void commit(void *message, uint32_t size);
+
+    /** Receive the oldest committed message
+     *
+     * The message stays in the arena, owned by the caller, until passed to release.
+     *
+     * @param size      Set to the size of the message in bytes
+     * @param millisec  Time to wait for a message (osWaitForever to wait forever)
+     * @return          Pointer to the message, or NULL if there is none
+     *
+     * @note You may call this function from ISR context if the millisec parameter is set to 0.
+     */
+    void *receive(uint32_t *size, uint32_t millisec = 0);
+
+    /** Release a received message, or discard a borrowed one
+     *
+     * Space is reclaimed in order, so releasing a message out of order only
+     * frees its space once the messages before it are released too.
+     *
+     * @param message   Message returned by receive, or by borrow and not committed
+     *
+     * @note You may call this function from ISR context.
+     */
+    void release(void *message);
+
+    /** Check if there is a committed message to receive
+     *
+     * @return True if receive would return a message
+     */
+    bool readable() const;
+
+    /** Get the size of the largest message that can ever be borrowed
+     *
+     * @return Size in bytes
+     */
+    uint32_t max_message_size() const;
+
+private:
+    struct Header;
+
+    Header *header(uint32_t offset) const;
+    Header *try_borrow(uint32_t size);
+    Header *try_receive();
+    void advance_read();
+    void reclaim(bool *space_released);
+    bool wait(uint32_t flag, uint64_t deadline, uint32_t millisec);
+
+    uint64_t *const _buffer;
+    const uint32_t _size;
+    // Byte offsets of the oldest unreleased message, the next message to
+    // receive and the next free space
+    uint32_t _free;
+    uint32_t _read;
+    uint32_t _write;
+    uint32_t _used;
+    // Messages borrowed but not received yet
+    uint32_t _pending;
+    // Threads waiting in borrow and in receive
+    uint32_t _borrowers;
+    uint32_t _receivers;
+    EventFlags _flags;
+};
+
+}
+
+/** Zero-copy channel for variable-size messages
+ *
+ * Producers borrow space for a message from a single arena, fill it in place
+ * and commit it. Consumers receive a pointer to the oldest committed message
+ * and release it when done. No data is copied, and messages of any size up
+ * to max_message_size() share the arena.
+ *
+ * Each message takes its size rounded up to a multiple of 8 plus an 8 byte
+ * header. A message that doesn't fit before the end of the arena starts
+ * again at its beginning, leaving the space at the end unused until then.
+ *
+ * @tparam BufferSize   Size of the arena in bytes
+ *
+ * @note Synchronization level: Interrupt safe
+ *
+ * @note
+ * Memory considerations: The arena and control structures are part of this class.
+ */
+template<uint32_t BufferSize>
+class MessageChannel : public internal::MessageChannelBase {
+    MBED_STATIC_ASSERT(BufferSize > 8 && (BufferSize % 8) == 0, "BufferSize must be a multiple of 8, larger than 8");
+public:
+    /** Create a message channel
+     *
+     * @note You cannot call this function from ISR context.
+     */
+    MessageChannel() : internal::MessageChannelBase(_arena, BufferSize)
+    {
+    }
+
+private:
+    uint64_t _arena[BufferSize / 8];
+};
+
+/** @}*/
+/** @}*/
+
+}
+
+#endif
@@ -25,15 +25,23 @@
 #include <string.h>
 #include "mbed_error.h"
 #include "mbed_assert.h"
+#if defined(MBED_MUTEX_STATS_ENABLED)
+#include "platform/mbed_critical.h"
+#include "hal/us_ticker_api.h"
+#endif
 
 namespace rtos {
 
+#if defined(MBED_MUTEX_STATS_ENABLED)
+static Mutex *stats_list;
+#endif
+
 Mutex::Mutex(): _count(0)
 {
     constructor();
 }
 
-Mutex::Mutex(const char *name)
+Mutex::Mutex(const char *name): _count(0)
 {
     constructor(name);
 }
@@ -49,14 +57,57 @@ void Mutex::constructor(const char *name)
     attr.attr_bits = osMutexRecursive | osMutexPrioInherit | osMutexRobust;
     _id = osMutexNew(&attr);
     MBED_ASSERT(_id);
+
+#if defined(MBED_MUTEX_STATS_ENABLED)
+    _acquire_cnt = 0;
+    _contended_cnt = 0;
+    _total_wait_time = 0;
+    _max_wait_time = 0;
+    _max_hold_time = 0;
+    _max_hold_thread = NULL;
+    _hold_start = 0;
+    core_util_critical_section_enter();
+    _stats_next = stats_list;
+    stats_list = this;
+    core_util_critical_section_exit();
+#endif
 }
 
-osStatus Mutex::lock(void)
+osStatus Mutex::acquire(uint32_t millisec)
 {
-    osStatus status = osMutexAcquire(_id, osWaitForever);
-    if (osOK == status) {
+#if defined(MBED_MUTEX_STATS_ENABLED)
+    // Only pay for the timing when the mutex is actually contended
+    osStatus status = osMutexAcquire(_id, 0);
+    if (status == osErrorResource && millisec != 0) {
+        uint32_t start = us_ticker_read();
+        status = osMutexAcquire(_id, millisec);
+        uint32_t wait = us_ticker_read() - start;
+        if (status == osOK) {
+            _contended_cnt++;
+            _total_wait_time += wait;
+            if (wait > _max_wait_time) {
+                _max_wait_time = wait;
+            }
+        }
+    }
+    if (status == osOK) {
+        _acquire_cnt++;
+        if (_count == 0) {
+            _hold_start = us_ticker_read();
+        }
+    }
+#else
+    osStatus status = osMutexAcquire(_id, millisec);
+#endif
+    if (status == osOK) {
         _count++;
     }
+    return status;
+}
+
+osStatus Mutex::lock(void)
+{
+    osStatus status = acquire(osWaitForever);
 
     if (status != osOK) {
         MBED_ERROR1(MBED_MAKE_ERROR(MBED_MODULE_KERNEL, MBED_ERROR_CODE_MUTEX_LOCK_FAILED), "Mutex lock failed", status);
@@ -67,10 +118,7 @@ osStatus Mutex::lock(void)
 
 osStatus Mutex::lock(uint32_t millisec)
 {
-    osStatus status = osMutexAcquire(_id, millisec);
-    if (osOK == status) {
-        _count++;
-    }
+    osStatus status = acquire(millisec);
 
     bool success = (status == osOK ||
                     (status == osErrorResource && millisec == 0) ||
@@ -90,7 +138,7 @@ bool Mutex::trylock()
 
 bool Mutex::trylock_for(uint32_t millisec)
 {
-    osStatus status = osMutexAcquire(_id, millisec);
+    osStatus status = acquire(millisec);
     if (status == osOK) {
         return true;
     }
@@ -124,6 +172,16 @@ osStatus Mutex::unlock()
 {
     _count--;
 
+#if defined(MBED_MUTEX_STATS_ENABLED)
+    if (_count == 0) {
+        uint32_t hold = us_ticker_read() - _hold_start;
+        if (hold > _max_hold_time) {
+            _max_hold_time = hold;
+            _max_hold_thread = osThreadGetId();
+        }
+    }
+#endif
+
     osStatus status = osMutexRelease(_id);
 
     if (status != osOK) {
@@ -140,7 +198,40 @@ osThreadId Mutex::get_owner()
 
 Mutex::~Mutex()
 {
+#if defined(MBED_MUTEX_STATS_ENABLED)
+    core_util_critical_section_enter();
+    for (Mutex **p = &stats_list; *p; p = &(*p)->_stats_next) {
+        if (*p == this) {
+            *p = _stats_next;
+            break;
+        }
+    }
+    core_util_critical_section_exit();
+#endif
     osMutexDelete(_id);
 }
 
 }
+
+#if defined(MBED_MUTEX_STATS_ENABLED)
+size_t mbed_stats_mutex_get_each(mbed_stats_mutex_t *stats, size_t count)
+{
+    MBED_ASSERT(stats != NULL);
+    memset(stats, 0, count * sizeof(mbed_stats_mutex_t));
+
+    size_t i = 0;
+    core_util_critical_section_enter();
+    for (rtos::Mutex *m = rtos::stats_list; m && i < count; m = m->_stats_next, i++) {
+        stats[i].id = (uint32_t)m->_id;
+        stats[i].name = osMutexGetName(m->_id);
+        stats[i].acquire_cnt = m->_acquire_cnt;
+        stats[i].contended_cnt = m->_contended_cnt;
+        stats[i].total_wait_time = m->_total_wait_time;
+        stats[i].max_wait_time = m->_max_wait_time;
+        stats[i].max_hold_time = m->_max_hold_time;
+        stats[i].max_hold_thread_id = (uint32_t)m->_max_hold_thread;
+    }
+    core_util_critical_section_exit();
+    return i;
+}
+#endif
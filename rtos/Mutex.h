@@ -30,6 +30,9 @@
 #include "platform/NonCopyable.h"
 #include "platform/ScopedLock.h"
 #include "platform/mbed_toolchain.h"
+#if defined(MBED_MUTEX_STATS_ENABLED)
+#include "platform/mbed_stats.h"
+#endif
 
 namespace rtos {
 /** \addtogroup rtos */
@@ -167,11 +170,24 @@ public:
 
 private:
     void constructor(const char *name = NULL);
+    osStatus acquire(uint32_t millisec);
     friend class ConditionVariable;
 
     osMutexId_t               _id;
     mbed_rtos_storage_mutex_t _obj_mem;
     uint32_t                  _count;
+#if defined(MBED_MUTEX_STATS_ENABLED)
+    friend size_t ::mbed_stats_mutex_get_each(mbed_stats_mutex_t *stats, size_t count);
+
+    Mutex                    *_stats_next;
+    uint32_t                  _acquire_cnt;
+    uint32_t                  _contended_cnt;
+    uint64_t                  _total_wait_time;
+    uint32_t                  _max_wait_time;
+    uint32_t                  _max_hold_time;
+    osThreadId_t              _max_hold_thread;
+    uint32_t                  _hold_start;
+#endif
 };
 /** @}*/
 /** @}*/
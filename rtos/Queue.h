@@ -27,6 +27,7 @@
 #include "mbed_rtos_storage.h"
 #include "platform/mbed_error.h"
 #include "platform/NonCopyable.h"
+#include "rtos/Waitable.h"
 
 namespace rtos {
 /** \addtogroup rtos */
@@ -56,7 +57,7 @@ namespace rtos {
  *
  */
 template<typename T, uint32_t queue_sz>
-class Queue : private mbed::NonCopyable<Queue<T, queue_sz> > {
+class Queue : public Waitable, private mbed::NonCopyable<Queue<T, queue_sz> > {
 public:
     /** Create and initialize a message Queue of objects of the parameterized
      * type `T` and maximum capacity specified by `queue_sz`.
@@ -145,7 +146,11 @@ public:
      */
     osStatus put(T *data, uint32_t millisec = 0, uint8_t prio = 0)
     {
-        return osMessageQueuePut(_id, &data, prio, millisec);
+        osStatus status = osMessageQueuePut(_id, &data, prio, millisec);
+        if (status == osOK) {
+            notify();
+        }
+        return status;
     }
 
     /** Get a message or wait for a message from the queue.
@@ -211,6 +216,11 @@ public:
     }
 
 private:
+    virtual bool ready() const
+    {
+        return !empty();
+    }
+
     osMessageQueueId_t            _id;
     char                          _queue_mem[queue_sz * (sizeof(T *) + sizeof(mbed_rtos_storage_message_t))];
     mbed_rtos_storage_msg_queue_t _obj_mem;
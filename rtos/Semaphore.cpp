@@ -78,7 +78,16 @@ int32_t Semaphore::wait_until(uint64_t millisec)
 
 osStatus Semaphore::release(void)
 {
-    return osSemaphoreRelease(_id);
+    osStatus status = osSemaphoreRelease(_id);
+    if (status == osOK) {
+        notify();
+    }
+    return status;
+}
+
+bool Semaphore::ready() const
+{
+    return osSemaphoreGetCount(_id) > 0;
 }
 
 Semaphore::~Semaphore()
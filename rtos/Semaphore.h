@@ -26,6 +26,7 @@
 #include "cmsis_os2.h"
 #include "mbed_rtos1_types.h"
 #include "mbed_rtos_storage.h"
+#include "rtos/Waitable.h"
 #include "platform/NonCopyable.h"
 
 namespace rtos {
@@ -42,7 +43,7 @@ namespace rtos {
  * Memory considerations: The semaphore control structures will be created on current thread's stack, both for the mbed OS
  * and underlying RTOS objects (static or dynamic RTOS memory pools are not being used).
  */
-class Semaphore : private mbed::NonCopyable<Semaphore> {
+class Semaphore : public Waitable, private mbed::NonCopyable<Semaphore> {
 public:
     /** Create and Initialize a Semaphore object used for managing resources.
       @param count      number of available resources; maximum index value is (count-1). (default: 0).
@@ -97,6 +98,7 @@ public:
 
 private:
     void constructor(int32_t count, uint16_t max_count);
+    virtual bool ready() const;
 
     osSemaphoreId_t               _id;
     mbed_rtos_storage_semaphore_t _obj_mem;
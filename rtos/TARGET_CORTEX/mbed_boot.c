@@ -78,6 +78,7 @@
 #include "mbed_boot.h"
 #include "mbed_error.h"
 #include "mbed_mpu_mgmt.h"
+#include "mbed_stats.h"
 
 int main(void);
 static void mbed_cpy_nvic(void);
@@ -88,17 +89,23 @@ uint32_t mbed_stack_isr_size = 0;
 
 void mbed_init(void)
 {
+    mbed_stats_boot_mark(MBED_BOOT_PHASE_INIT);
     mbed_mpu_manager_init();
     mbed_cpy_nvic();
     mbed_sdk_init();
+    mbed_stats_boot_mark(MBED_BOOT_PHASE_SDK_INIT);
     mbed_rtos_init();
+    mbed_stats_boot_mark(MBED_BOOT_PHASE_RTOS_INIT);
 }
 
 void mbed_start(void)
 {
+    mbed_stats_boot_mark(MBED_BOOT_PHASE_START);
     mbed_toolchain_init();
+    mbed_stats_boot_mark(MBED_BOOT_PHASE_STATIC_INIT);
     mbed_main();
     mbed_error_initialize();
+    mbed_stats_boot_mark(MBED_BOOT_PHASE_MAIN);
     main();
 }
 
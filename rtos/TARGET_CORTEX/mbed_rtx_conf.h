@@ -53,6 +53,13 @@
 
 #define OS_DYNAMIC_MEM_SIZE         0
 
+// The RTX stack check is also the hook moving the MPU stack guard, so it is
+// only left out when neither is wanted
+#if !defined(OS_STACK_CHECK) && defined(MBED_CONF_RTOS_STACK_CHECK) && !MBED_CONF_RTOS_STACK_CHECK && \
+    !(defined(MBED_CONF_PLATFORM_MPU_STACK_GUARD) && MBED_CONF_PLATFORM_MPU_STACK_GUARD)
+#define OS_STACK_CHECK              0
+#endif
+
 #if defined(OS_TICK_FREQ) && (OS_TICK_FREQ != 1000)
 #error "OS Tickrate must be 1000 for system timing"
 #endif
@@ -92,6 +99,11 @@
 //#define EVR_RTX_MEMORY_POOL_ERROR_DISABLE
 //#define EVR_RTX_MESSAGE_QUEUE_ERROR_DISABLE
 
+//Thread switch event is used to account the CPU time and sample the stack watermark of each thread
+#if !defined(MBED_THREAD_STATS_ENABLED) && !defined(MBED_STACK_STATS_ENABLED) && !defined(MBED_ALL_STATS_ENABLED)
+#define EVR_RTX_THREAD_SWITCHED_DISABLE
+#endif
+
 //Following events are NOT used by Mbed-OS, you may enable them if needed for debug purposes
 #define EVR_RTX_MEMORY_INIT_DISABLE
 #define EVR_RTX_MEMORY_ALLOC_DISABLE
@@ -142,7 +154,6 @@
 #define EVR_RTX_THREAD_BLOCKED_DISABLE
 #define EVR_RTX_THREAD_UNBLOCKED_DISABLE
 #define EVR_RTX_THREAD_PREEMPTED_DISABLE
-#define EVR_RTX_THREAD_SWITCHED_DISABLE
 #define EVR_RTX_THREAD_DESTROYED_DISABLE
 #define EVR_RTX_THREAD_GET_COUNT_DISABLE
 #define EVR_RTX_THREAD_ENUMERATE_DISABLE
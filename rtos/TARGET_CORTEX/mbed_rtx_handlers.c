@@ -24,18 +24,184 @@
 #include "RTX_Config.h"
 #include "rtos/rtos_handlers.h"
 #include "rtos/rtos_idle.h"
+#include "hal/us_ticker_api.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_swo_trace.h"
+#include "platform/mbed_mpu_mgmt.h"
 
 #ifdef RTE_Compiler_EventRecorder
 #include "EventRecorder.h"              // Keil::Compiler:Event Recorder
 // Used from rtx_evr.c
 #define EvtRtxThreadExit               EventID(EventLevelAPI, 0xF2U, 0x19U)
 #define EvtRtxThreadTerminate          EventID(EventLevelAPI, 0xF2U, 0x1AU)
+#define EvtRtxThreadSwitched           EventID(EventLevelOp, 0xF2U, 0x19U)
 #endif
 
 static void (*terminate_hook)(osThreadId_t id);
 
+#if MBED_CONF_PLATFORM_MPU_STACK_GUARD && DEVICE_MPU && MBED_CONF_PLATFORM_USE_MPU
+// Replaces the RTX stack check, which is called on every thread switch:
+// checks the thread switched out if rtos.stack-check is set, and moves the
+// MPU stack guard to the thread switched in
+void osRtxThreadStackCheck(void)
+{
+#if MBED_CONF_RTOS_STACK_CHECK
+    osRtxThread_t *thread = osRtxInfo.thread.run.curr;
+    if ((thread != NULL) && ((thread->sp <= (uint32_t)thread->stack_mem) ||
+                             (*((const uint32_t *)thread->stack_mem) != osRtxStackMagicWord))) {
+        (void)osRtxErrorNotify(osRtxErrorStackUnderflow, thread);
+    }
+#endif
+    const osRtxThread_t *next = osRtxInfo.thread.run.next;
+    mbed_mpu_manager_set_stack_guard(next->stack_mem, next->stack_size);
+}
+#endif
+
+#if (!defined(EVR_RTX_DISABLE) && (OS_EVR_THREAD != 0) && !defined(EVR_RTX_THREAD_SWITCHED_DISABLE))
+#define THREAD_CPU_STATS_ENABLED 1
+
+// Run time and stack watermark of the threads seen by the switch hook, slots
+// are freed when their thread terminates. Only accessed with the kernel in
+// handler mode or under a critical section.
+static struct {
+    osThreadId_t id;
+    us_timestamp_t time;
+    // lowest free stack space seen, and the next word to check
+    uint32_t stack_space;
+    uint32_t stack_scan;
+} cpu_time[MBED_CONF_RTOS_THREAD_CPU_STATS_COUNT];
+
+static osThreadId_t cpu_running;
+static int cpu_running_slot = -1;
+static us_timestamp_t cpu_switch_time;
+
+static int cpu_time_slot(osThreadId_t id)
+{
+    for (int i = 0; i < MBED_CONF_RTOS_THREAD_CPU_STATS_COUNT; i++) {
+        if (cpu_time[i].id == id) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+#if OS_STACK_WATERMARK
+// Check a few more words of the painted stack, from its base up to the
+// lowest free space seen. Once the scan reaches it without finding a used
+// word it starts again from the base, so a deeper use is found within
+// stack_space / (4 * MBED_CONF_RTOS_STACK_WATERMARK_WORDS) switches.
+static void stack_watermark_sample(int i)
+{
+    const osRtxThread_t *thread = (const osRtxThread_t *)cpu_time[i].id;
+    const uint32_t *stack = (const uint32_t *)thread->stack_mem;
+    if (stack == NULL) {
+        return;
+    }
+    if (stack[0] != osRtxStackMagicWord) {
+        cpu_time[i].stack_space = 0;
+        return;
+    }
+
+    uint32_t scan = cpu_time[i].stack_scan;
+    for (int n = 0; n < MBED_CONF_RTOS_STACK_WATERMARK_WORDS; n++) {
+        if (scan >= cpu_time[i].stack_space / 4) {
+            scan = 1;
+            break;
+        }
+        if (stack[scan] != osRtxStackFillPattern) {
+            cpu_time[i].stack_space = scan * 4;
+            scan = 1;
+            break;
+        }
+        scan++;
+    }
+    cpu_time[i].stack_scan = scan;
+}
+#endif
+
+// RTX hook which gets called on every thread switch, charges the time since
+// the previous switch to the thread switched out and samples the stack of
+// the thread switched in
+void EvrRtxThreadSwitched(osThreadId_t thread_id)
+{
+    MBED_SWO_TRACE(MBED_SWO_TRACE_THREAD_SWITCH, thread_id);
+    us_timestamp_t now = ticker_read_us(get_us_ticker_data());
+    if (cpu_running_slot >= 0) {
+        cpu_time[cpu_running_slot].time += now - cpu_switch_time;
+    }
+
+    int i = cpu_time_slot(thread_id);
+    if (i < 0) {
+        // threads beyond the table size are not accounted for
+        i = cpu_time_slot(NULL);
+        if (i >= 0) {
+            cpu_time[i].id = thread_id;
+            cpu_time[i].time = 0;
+            cpu_time[i].stack_space = ((const osRtxThread_t *)thread_id)->stack_size;
+            cpu_time[i].stack_scan = 1;
+        }
+    }
+#if OS_STACK_WATERMARK
+    if (i >= 0) {
+        stack_watermark_sample(i);
+    }
+#endif
+
+    cpu_running = thread_id;
+    cpu_running_slot = i;
+    cpu_switch_time = now;
+#if defined(RTE_Compiler_EventRecorder)
+    EventRecord2(EvtRtxThreadSwitched, (uint32_t)thread_id, 0U);
+#endif
+}
+#endif
+
+uint64_t rtos_thread_get_cpu_time(osThreadId_t id)
+{
+    uint64_t time = 0;
+#if THREAD_CPU_STATS_ENABLED
+    core_util_critical_section_enter();
+    int i = cpu_time_slot(id);
+    if (id && i >= 0) {
+        time = cpu_time[i].time;
+    }
+    if (id && id == cpu_running) {
+        time += ticker_read_us(get_us_ticker_data()) - cpu_switch_time;
+    }
+    core_util_critical_section_exit();
+#endif
+    return time;
+}
+
+uint32_t rtos_thread_get_stack_space_sampled(osThreadId_t id)
+{
+#if THREAD_CPU_STATS_ENABLED && OS_STACK_WATERMARK
+    core_util_critical_section_enter();
+    int i = id ? cpu_time_slot(id) : -1;
+    uint32_t space = i >= 0 ? cpu_time[i].stack_space : 0;
+    core_util_critical_section_exit();
+    if (i >= 0) {
+        return space;
+    }
+#endif
+    // Not sampled, fall back to scanning the whole stack
+    return osThreadGetStackSpace(id);
+}
+
 static void thread_terminate_hook(osThreadId_t id)
 {
+#if THREAD_CPU_STATS_ENABLED
+    core_util_critical_section_enter();
+    int i = cpu_time_slot(id);
+    if (i >= 0) {
+        cpu_time[i].id = NULL;
+    }
+    if (id == cpu_running) {
+        cpu_running = NULL;
+        cpu_running_slot = -1;
+    }
+    core_util_critical_section_exit();
+#endif
     if (terminate_hook) {
         terminate_hook(id);
     }
@@ -27,6 +27,7 @@
 #include "mbed_critical.h"
 #include "mbed_assert.h"
 #include <new>
+#include <string.h>
 #include "rtx_os.h"
 
 /* Everything in rtx_lib.h, and provided by this file, has C linkage */
@@ -91,16 +92,36 @@ extern "C" {
         return 1000;
     }
 
+    // Wake-up latency of deep sleep, starting from the target's figure and
+    // refined each time the system timer wakes the target from deep sleep
+    static uint32_t deep_sleep_latency_us = MBED_CONF_TARGET_DEEP_SLEEP_LATENCY * 1000;
+    static rtos_idle_stats_t idle_stats;
+
+    void rtos_idle_get_stats(rtos_idle_stats_t *stats)
+    {
+        core_util_critical_section_enter();
+        *stats = idle_stats;
+        stats->deep_sleep_latency_us = deep_sleep_latency_us;
+        core_util_critical_section_exit();
+    }
+
     static void default_idle_hook(void)
     {
         uint32_t ticks_to_sleep = osKernelSuspend();
-        const bool block_deep_sleep = ticks_to_sleep <= MBED_CONF_TARGET_DEEP_SLEEP_LATENCY;
+        const uint32_t latency_ticks = (deep_sleep_latency_us + 999) / 1000;
+        const us_timestamp_t break_even_us = (us_timestamp_t)deep_sleep_latency_us * MBED_CONF_RTOS_DEEP_SLEEP_BREAK_EVEN;
+        // Only a choice if nothing else holds deep sleep off
+        const bool deep_sleep_allowed = sleep_manager_can_deep_sleep();
+        // Deep sleep costs its latency on every wake-up, so only enter it if
+        // the gap to the next wake-up is long enough to make up for it
+        const bool block_deep_sleep = ticks_to_sleep <= latency_ticks * MBED_CONF_RTOS_DEEP_SLEEP_BREAK_EVEN;
 
         if (block_deep_sleep) {
             sleep_manager_lock_deep_sleep();
         } else {
-            ticks_to_sleep -= MBED_CONF_TARGET_DEEP_SLEEP_LATENCY;
+            ticks_to_sleep -= latency_ticks;
         }
+        const us_timestamp_t start = os_timer->get_time();
         os_timer->suspend(ticks_to_sleep);
 
         bool event_pending = false;
@@ -122,6 +143,25 @@ extern "C" {
             sleep_manager_unlock_deep_sleep();
         }
 
+        if (deep_sleep_allowed) {
+            const us_timestamp_t slept = os_timer->get_time() - start;
+            if (block_deep_sleep) {
+                idle_stats.sleep_cnt++;
+            } else if (!event_pending) {
+                idle_stats.deep_sleep_cnt++;
+                // Woken by the system timer, any time past the wake-up it was
+                // set for is the latency of getting out of deep sleep
+                const us_timestamp_t target = (us_timestamp_t)ticks_to_sleep * 1000;
+                const uint32_t overshoot = slept > target ? (uint32_t)(slept - target) : 0;
+                deep_sleep_latency_us = (deep_sleep_latency_us * 7 + overshoot) / 8;
+            } else {
+                idle_stats.deep_sleep_cnt++;
+                if (slept < break_even_us) {
+                    idle_stats.short_deep_sleep_cnt++;
+                }
+            }
+        }
+
         osKernelResume(os_timer->resume());
     }
 
@@ -138,6 +178,11 @@ extern "C" {
         core_util_critical_section_exit();
     }
 
+    void rtos_idle_get_stats(rtos_idle_stats_t *stats)
+    {
+        memset(stats, 0, sizeof(*stats));
+    }
+
 #endif // (defined(MBED_TICKLESS) && DEVICE_LPTICKER)
 
     static void (*idle_hook_fptr)(void) = &default_idle_hook;
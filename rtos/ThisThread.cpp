@@ -24,11 +24,39 @@
 #include "rtos/ThisThread.h"
 
 #include "rtos/Kernel.h"
+#include "rtos/Semaphore.h"
 #include "rtos/rtos_idle.h"
+#include "drivers/TimerEvent.h"
+#include "hal/us_ticker_api.h"
 #include "platform/mbed_assert.h"
+#include "platform/mbed_power_mgmt.h"
 
 namespace rtos {
 
+namespace {
+// Wakes up a thread sleeping in sleep_until_us
+class WakeUp : public mbed::TimerEvent {
+public:
+    WakeUp() : _sem(0, 1)
+    {
+    }
+
+    void sleep_until(us_timestamp_t us)
+    {
+        insert_absolute(us);
+        _sem.wait();
+    }
+
+private:
+    virtual void handler()
+    {
+        _sem.release();
+    }
+
+    Semaphore _sem;
+};
+}
+
 uint32_t ThisThread::flags_clear(uint32_t flags)
 {
     flags = osThreadFlagsClear(flags);
@@ -128,6 +156,23 @@ void ThisThread::sleep_until(uint64_t millisec)
     }
 }
 
+void ThisThread::sleep_for_us(uint32_t us)
+{
+    sleep_until_us(ticker_read_us(get_us_ticker_data()) + us);
+}
+
+void ThisThread::sleep_until_us(uint64_t us)
+{
+    if (ticker_read_us(get_us_ticker_data()) >= us) {
+        return;
+    }
+
+    sleep_manager_lock_deep_sleep();
+    WakeUp wake_up;
+    wake_up.sleep_until(us);
+    sleep_manager_unlock_deep_sleep();
+}
+
 void ThisThread::yield()
 {
     osThreadYield();
@@ -166,6 +166,26 @@ void sleep_for(uint32_t millisec);
 */
 void sleep_until(uint64_t millisec);
 
+/** Sleep for a specified time period in microseconds
+  The thread is woken by a microsecond ticker event rather than the kernel tick,
+  so the delay is not rounded to milliseconds and other threads run meanwhile.
+  @param   us  time delay value in microseconds
+  @note You cannot call this function from ISR context.
+  @note Deep sleep is locked while sleeping, as the microsecond ticker doesn't run in deep sleep.
+*/
+void sleep_for_us(uint32_t us);
+
+/** Sleep until a specified time in microseconds
+  The specified time is according to the microsecond ticker, as read by
+  ticker_read_us(get_us_ticker_data()). Sleeping until times a fixed period
+  apart runs a periodic task without drift.
+  @param   us absolute time in microseconds
+  @note You cannot call this function from ISR context.
+  @note if us is equal to or lower than the current time, this returns immediately.
+  @note Deep sleep is locked while sleeping, as the microsecond ticker doesn't run in deep sleep.
+*/
+void sleep_until_us(uint64_t us);
+
 /** Pass control to next equal-priority thread that is in state READY.
     (Higher-priority READY threads would prevent us from running; this
     will not enable lower-priority threads to run, as we remain READY).
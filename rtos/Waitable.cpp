@@ -0,0 +1,95 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "rtos/Waitable.h"
+#include "rtos/Kernel.h"
+#include "mbed_rtos_storage.h"
+
+#include <string.h>
+#include "platform/mbed_assert.h"
+#include "platform/mbed_critical.h"
+
+namespace rtos {
+
+void Waitable::notify_waiter()
+{
+    // The waiter deletes its semaphore after clearing _waiter. In an ISR
+    // it can't run in between, in a thread the kernel is locked to keep it
+    // from running.
+    if (core_util_is_isr_active()) {
+        osSemaphoreId_t waiter = _waiter;
+        if (waiter) {
+            osSemaphoreRelease(waiter);
+        }
+    } else {
+        int32_t lock = osKernelLock();
+        osSemaphoreId_t waiter = _waiter;
+        if (waiter) {
+            osSemaphoreRelease(waiter);
+        }
+        osKernelRestoreLock(lock);
+    }
+}
+
+int wait_any(Waitable *const objects[], size_t count, uint32_t millisec)
+{
+    mbed_rtos_storage_semaphore_t sem_mem;
+    memset(&sem_mem, 0, sizeof(sem_mem));
+    osSemaphoreAttr_t attr = { 0 };
+    attr.cb_mem = &sem_mem;
+    attr.cb_size = sizeof(sem_mem);
+    osSemaphoreId_t sem = osSemaphoreNew(1, 0, &attr);
+    MBED_ASSERT(sem != NULL);
+
+    // Register before checking, so a notification between the check and
+    // the wait isn't lost
+    for (size_t i = 0; i < count; i++) {
+        MBED_ASSERT(objects[i]->_waiter == NULL);
+        objects[i]->_waiter = sem;
+    }
+
+    uint64_t deadline = Kernel::get_ms_count() + millisec;
+    int ret = -1;
+    while (true) {
+        for (size_t i = 0; i < count; i++) {
+            if (objects[i]->ready()) {
+                ret = i;
+                break;
+            }
+        }
+        if (ret >= 0) {
+            break;
+        }
+
+        uint32_t wait = osWaitForever;
+        if (millisec != osWaitForever) {
+            uint64_t now = Kernel::get_ms_count();
+            if (now >= deadline) {
+                break;
+            }
+            wait = deadline - now;
+        }
+        osSemaphoreAcquire(sem, wait);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        objects[i]->_waiter = NULL;
+    }
+    osSemaphoreDelete(sem);
+    return ret;
+}
+
+}
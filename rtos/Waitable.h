@@ -0,0 +1,112 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2019 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef WAITABLE_H
+#define WAITABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "cmsis_os2.h"
+
+namespace rtos {
+/** \addtogroup rtos */
+/** @{*/
+
+/**
+ * \defgroup rtos_Waitable Waitable class
+ * @{
+ */
+
+class Waitable;
+
+/** Wait until one of several objects is ready
+ *
+ * Semaphore, EventFlags and Queue are Waitable. A Semaphore is ready when
+ * it has a token, EventFlags when any flag is set and a Queue when it
+ * holds a message. Nothing is consumed: the caller gets the token, flags
+ * or message with a zero timeout once this returns.
+ *
+ * Only one thread can wait for an object with wait_any() at a time.
+ * Socket events can be waited for by releasing a Semaphore or setting
+ * EventFlags from the socket's sigio() callback.
+ *
+ * @code
+ * Semaphore sem;
+ * Queue<message_t, 8> queue;
+ * Waitable *const sources[] = { &sem, &queue };
+ *
+ * while (true) {
+ *     switch (wait_any(sources, 2)) {
+ *         case 0:
+ *             sem.wait(0);
+ *             break;
+ *         case 1:
+ *             handle((message_t *)queue.get(0).value.p);
+ *             break;
+ *     }
+ * }
+ * @endcode
+ *
+ * @param objects  The objects to wait for
+ * @param count    Number of objects
+ * @param millisec Timeout value, or osWaitForever (default)
+ * @return The index of the first ready object, or -1 on timeout
+ *
+ * @note You cannot call this function from ISR context.
+ */
+int wait_any(Waitable *const objects[], size_t count, uint32_t millisec = osWaitForever);
+
+/** Base class of the RTOS objects wait_any() can wait for
+ */
+class Waitable {
+protected:
+    Waitable() : _waiter(NULL)
+    {
+    }
+
+    ~Waitable()
+    {
+    }
+
+    /** Check whether the object is ready, without blocking or consuming anything */
+    virtual bool ready() const = 0;
+
+    /** Wake up the thread waiting for this object in wait_any(), if any
+     *
+     * Derived classes call it when they become ready. It costs a single
+     * load when no thread is waiting.
+     *
+     * @note You may call this function from ISR context.
+     */
+    void notify()
+    {
+        if (_waiter) {
+            notify_waiter();
+        }
+    }
+
+private:
+    friend int wait_any(Waitable *const objects[], size_t count, uint32_t millisec);
+
+    void notify_waiter();
+
+    osSemaphoreId_t volatile _waiter;
+};
+
+/** @}*/
+/** @}*/
+}
+#endif
@@ -29,14 +29,19 @@
 #include "rtos/Kernel.h"
 #include "rtos/Thread.h"
 #include "rtos/ThisThread.h"
+#include "rtos/DeadlineThread.h"
 #include "rtos/Mutex.h"
+#include "rtos/FastMutex.h"
 #include "rtos/RtosTimer.h"
 #include "rtos/Semaphore.h"
 #include "rtos/Mail.h"
 #include "rtos/MemoryPool.h"
+#include "rtos/LockFreeMemoryPool.h"
 #include "rtos/Queue.h"
 #include "rtos/EventFlags.h"
 #include "rtos/ConditionVariable.h"
+#include "rtos/Waitable.h"
+#include "rtos/MessageChannel.h"
 
 #ifndef MBED_NO_GLOBAL_USING_DIRECTIVE
 using namespace rtos;
@@ -41,6 +41,25 @@ extern "C" {
  @param fptr Hook function pointer.
  */
 void rtos_attach_thread_terminate_hook(void (*fptr)(osThreadId_t id));
+
+/**
+ @note
+ Gets the time a thread has been running, only accounted for when thread
+ statistics are enabled
+ @param id Thread ID.
+ @return Run time in microseconds, or 0 if not accounted for.
+ */
+uint64_t rtos_thread_get_cpu_time(osThreadId_t id);
+
+/**
+ @note
+ Gets the lowest free stack space of a thread, as sampled a few words at a
+ time on each thread switch when stack statistics are enabled. Threads that
+ have not been sampled fall back to osThreadGetStackSpace.
+ @param id Thread ID.
+ @return Free stack space in bytes.
+ */
+uint32_t rtos_thread_get_stack_space_sampled(osThreadId_t id);
 /** @}*/
 
 #ifdef __cplusplus
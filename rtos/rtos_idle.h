@@ -27,6 +27,7 @@
 
 #include "mbed_toolchain.h"
 #include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -43,6 +44,22 @@ extern "C" {
  */
 void rtos_attach_idle_hook(void (*fptr)(void));
 
+/** Statistics of the sleep mode choices of the default idle hook */
+typedef struct {
+    uint32_t sleep_cnt;             /**< Times sleep was chosen although deep sleep was allowed */
+    uint32_t deep_sleep_cnt;        /**< Times deep sleep was chosen */
+    uint32_t short_deep_sleep_cnt;  /**< Times deep sleep was chosen but an early wake-up made it cost more than it saved */
+    uint32_t deep_sleep_latency_us; /**< Current estimate of the deep sleep wake-up latency */
+} rtos_idle_stats_t;
+
+/**
+ @note
+ Gets the statistics of the default idle hook. They are only kept in
+ tickless mode, otherwise all fields are 0.
+ @param stats Statistics to fill.
+ */
+void rtos_idle_get_stats(rtos_idle_stats_t *stats);
+
 /** @private */
 MBED_NORETURN void rtos_idle_loop(void);
 
@@ -10,6 +10,7 @@
 *****************************************************************************/  
 
 #include "Nano100Series.h"
+#include "platform/mbed_boot_memory.h"
 
 /* Suppress warning messages */
 #if defined(__CC_ARM)
@@ -205,25 +206,11 @@ void Reset_Handler(void)
     __iar_program_start();
 
 #elif defined(__GNUC__)
-    uint32_t *src_ind = (uint32_t *) &__etext;
-    uint32_t *dst_ind = (uint32_t *) &__data_start__;
-    uint32_t *dst_end = (uint32_t *) &__data_end__;
-
     /* Move .data section from ROM to RAM */
-    if (src_ind != dst_ind) {
-        for (; dst_ind < dst_end;) {
-            *dst_ind ++ = *src_ind ++;
-        }
-    }
-   
+    mbed_boot_copy_words(&__data_start__, &__etext, &__data_end__);
+
     /* Initialize .bss section to zero */
-    dst_ind = (uint32_t *) &__bss_start__;
-    dst_end = (uint32_t *) &__bss_end__;
-    if (dst_ind != dst_end) {
-        for (; dst_ind < dst_end;) {
-            *dst_ind ++ = 0;
-        }
-    }
+    mbed_boot_zero_words(&__bss_start__, &__bss_end__);
     
     _start();
     
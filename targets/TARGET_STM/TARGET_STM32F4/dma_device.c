@@ -0,0 +1,104 @@
+/* mbed Microcontroller Library
+ *******************************************************************************
+ * Copyright (c) 2019, STMicroelectronics
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of STMicroelectronics nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *******************************************************************************
+ */
+#include "stm_dma.h"
+
+#define DMA1_S(n)   (n)
+#define DMA2_S(n)   (8 + (n))
+
+/* Streams and channels of the peripheral requests, from the DMA request
+ * mapping tables of RM0090 and RM0368. Alternatives follow the preferred
+ * link, so that peripherals sharing a stream can still run together.
+ */
+static const stm_dma_link_t dma_links[] = {
+#if defined(SPI1_BASE)
+    {SPI1_BASE, STM_DMA_TX, DMA2_S(3), DMA_CHANNEL_3},
+    {SPI1_BASE, STM_DMA_TX, DMA2_S(5), DMA_CHANNEL_3},
+    {SPI1_BASE, STM_DMA_RX, DMA2_S(0), DMA_CHANNEL_3},
+    {SPI1_BASE, STM_DMA_RX, DMA2_S(2), DMA_CHANNEL_3},
+#endif
+#if defined(SPI2_BASE)
+    {SPI2_BASE, STM_DMA_TX, DMA1_S(4), DMA_CHANNEL_0},
+    {SPI2_BASE, STM_DMA_RX, DMA1_S(3), DMA_CHANNEL_0},
+#endif
+#if defined(SPI3_BASE)
+    {SPI3_BASE, STM_DMA_TX, DMA1_S(5), DMA_CHANNEL_0},
+    {SPI3_BASE, STM_DMA_TX, DMA1_S(7), DMA_CHANNEL_0},
+    {SPI3_BASE, STM_DMA_RX, DMA1_S(0), DMA_CHANNEL_0},
+    {SPI3_BASE, STM_DMA_RX, DMA1_S(2), DMA_CHANNEL_0},
+#endif
+#if defined(SPI4_BASE)
+    {SPI4_BASE, STM_DMA_TX, DMA2_S(1), DMA_CHANNEL_4},
+    {SPI4_BASE, STM_DMA_TX, DMA2_S(4), DMA_CHANNEL_5},
+    {SPI4_BASE, STM_DMA_RX, DMA2_S(0), DMA_CHANNEL_4},
+    {SPI4_BASE, STM_DMA_RX, DMA2_S(3), DMA_CHANNEL_5},
+#endif
+#if defined(SPI5_BASE)
+    {SPI5_BASE, STM_DMA_TX, DMA2_S(4), DMA_CHANNEL_2},
+    {SPI5_BASE, STM_DMA_TX, DMA2_S(6), DMA_CHANNEL_7},
+    {SPI5_BASE, STM_DMA_RX, DMA2_S(3), DMA_CHANNEL_2},
+    {SPI5_BASE, STM_DMA_RX, DMA2_S(5), DMA_CHANNEL_7},
+#endif
+#if defined(SPI6_BASE)
+    {SPI6_BASE, STM_DMA_TX, DMA2_S(5), DMA_CHANNEL_1},
+    {SPI6_BASE, STM_DMA_RX, DMA2_S(6), DMA_CHANNEL_1},
+#endif
+#if defined(USART1_BASE)
+    {USART1_BASE, STM_DMA_TX, DMA2_S(7), DMA_CHANNEL_4},
+#endif
+#if defined(USART2_BASE)
+    {USART2_BASE, STM_DMA_TX, DMA1_S(6), DMA_CHANNEL_4},
+#endif
+#if defined(USART3_BASE)
+    {USART3_BASE, STM_DMA_TX, DMA1_S(3), DMA_CHANNEL_4},
+    {USART3_BASE, STM_DMA_TX, DMA1_S(4), DMA_CHANNEL_7},
+#endif
+#if defined(UART4_BASE)
+    {UART4_BASE, STM_DMA_TX, DMA1_S(4), DMA_CHANNEL_4},
+#endif
+#if defined(UART5_BASE)
+    {UART5_BASE, STM_DMA_TX, DMA1_S(7), DMA_CHANNEL_4},
+#endif
+#if defined(USART6_BASE)
+    {USART6_BASE, STM_DMA_TX, DMA2_S(6), DMA_CHANNEL_5},
+    {USART6_BASE, STM_DMA_TX, DMA2_S(7), DMA_CHANNEL_5},
+#endif
+#if defined(UART7_BASE)
+    {UART7_BASE, STM_DMA_TX, DMA1_S(1), DMA_CHANNEL_5},
+#endif
+#if defined(UART8_BASE)
+    {UART8_BASE, STM_DMA_TX, DMA1_S(0), DMA_CHANNEL_5},
+#endif
+};
+
+const stm_dma_link_t *stm_dma_links(size_t *count)
+{
+    *count = sizeof(dma_links) / sizeof(dma_links[0]);
+    return dma_links;
+}
@@ -31,6 +31,7 @@
 #if DEVICE_SERIAL
 
 #include "serial_api_hal.h"
+#include "stm_dma.h"
 
 #if defined (TARGET_STM32F401xC) || defined (TARGET_STM32F401xE) || defined (TARGET_STM32F410xB) || defined (TARGET_STM32F411xE)
 #define UART_NUM (3)
@@ -437,6 +438,16 @@ static IRQn_Type serial_get_irq_n(UARTName uart_name)
     return irq_n;
 }
 
+/**
+ * Give back the DMA stream of a transmission
+ */
+static void serial_tx_dma_free(UART_HandleTypeDef *huart)
+{
+    CLEAR_BIT(huart->Instance->CR3, USART_CR3_DMAT);
+    stm_dma_free(huart->hdmatx);
+    huart->hdmatx = NULL;
+}
+
 /******************************************************************************
  * MBED API FUNCTIONS
  ******************************************************************************/
@@ -456,9 +467,6 @@ static IRQn_Type serial_get_irq_n(UARTName uart_name)
  */
 int serial_tx_asynch(serial_t *obj, const void *tx, size_t tx_length, uint8_t tx_width, uint32_t handler, uint32_t event, DMAUsage hint)
 {
-    // TODO: DMA usage is currently ignored
-    (void) hint;
-
     // Check buffer is ok
     MBED_ASSERT(tx != (void *)0);
     MBED_ASSERT(tx_width == 8); // support only 8b width
@@ -485,6 +493,24 @@ int serial_tx_asynch(serial_t *obj, const void *tx, size_t tx_length, uint8_t tx
     NVIC_SetVector(irq_n, (uint32_t)handler);
     NVIC_EnableIRQ(irq_n);
 
+    IRQn_Type dma_irq_n;
+    if (hint != DMA_USAGE_NEVER) {
+        huart->hdmatx = stm_dma_alloc(obj_s->uart, STM_DMA_TX, 8, &dma_irq_n);
+    }
+    if (huart->hdmatx) {
+        huart->hdmatx->Parent = huart;
+        NVIC_SetPriority(dma_irq_n, 1);
+        NVIC_SetVector(dma_irq_n, (uint32_t)handler);
+        NVIC_EnableIRQ(dma_irq_n);
+
+        // the stream sends the data, then the UART_IT_TC interrupt ends the transfer
+        if (HAL_UART_Transmit_DMA(huart, (uint8_t *)tx, tx_length) != HAL_OK) {
+            serial_tx_dma_free(huart);
+            return 0;
+        }
+        return tx_length;
+    }
+
     // the following function will enable UART_IT_TXE and error interrupts
     if (HAL_UART_Transmit_IT(huart, (uint8_t *)tx, tx_length) != HAL_OK) {
         return 0;
@@ -606,6 +632,11 @@ int serial_irq_handler_asynch(serial_t *obj)
     uint8_t *buf = (uint8_t *)(obj->rx_buff.buffer);
     uint8_t i = 0;
 
+    // the DMA stream of a transmission shares the handler with the UART interrupt
+    if (huart->hdmatx) {
+        HAL_DMA_IRQHandler(huart->hdmatx);
+    }
+
     // TX PART:
     if (__HAL_UART_GET_FLAG(huart, UART_FLAG_TC) != RESET) {
         if (__HAL_UART_GET_IT_SOURCE(huart, UART_IT_TC) != RESET) {
@@ -637,6 +668,10 @@ int serial_irq_handler_asynch(serial_t *obj)
 
     HAL_UART_IRQHandler(huart);
 
+    if (huart->hdmatx && huart->gState != HAL_UART_STATE_BUSY_TX) {
+        serial_tx_dma_free(huart);
+    }
+
     // Abort if an error occurs
     if ((return_event & SERIAL_EVENT_RX_PARITY_ERROR) ||
             (return_event & SERIAL_EVENT_RX_FRAMING_ERROR) ||
@@ -682,6 +717,9 @@ void serial_tx_abort_asynch(serial_t *obj)
 
     __HAL_UART_DISABLE_IT(huart, UART_IT_TC);
     __HAL_UART_DISABLE_IT(huart, UART_IT_TXE);
+    if (huart->hdmatx) {
+        serial_tx_dma_free(huart);
+    }
 
     // clear flags
     __HAL_UART_CLEAR_FLAG(huart, UART_FLAG_TC);
@@ -131,6 +131,14 @@ void qspi_prepare_command(const qspi_command_t *command, QSPI_CommandTypeDef *st
 }
 
 
+// Memory-mapped mode must be left before the controller accepts another command
+static void qspi_leave_memory_mapped(qspi_t *obj)
+{
+    if (obj->handle.State == HAL_QSPI_STATE_BUSY_MEM_MAPPED) {
+        HAL_QSPI_Abort(&obj->handle);
+    }
+}
+
 qspi_status_t qspi_init(qspi_t *obj, PinName io0, PinName io1, PinName io2, PinName io3, PinName sclk, PinName ssel, uint32_t hz, uint8_t mode)
 {
     // Enable interface clock for QSPI
@@ -224,6 +232,8 @@ qspi_status_t qspi_frequency(qspi_t *obj, int hz)
 {
     qspi_status_t status = QSPI_STATUS_OK;
 
+    qspi_leave_memory_mapped(obj);
+
     /* HCLK drives QSPI. QSPI clock depends on prescaler value:
     *  0: Freq = HCLK
     *  1: Freq = HCLK/2
@@ -252,6 +262,7 @@ qspi_status_t qspi_frequency(qspi_t *obj, int hz)
 qspi_status_t qspi_write(qspi_t *obj, const qspi_command_t *command, const void *data, size_t *length)
 {
     QSPI_CommandTypeDef st_command;
+    qspi_leave_memory_mapped(obj);
     qspi_prepare_command(command, &st_command);
 
     st_command.NbData = *length;
@@ -271,6 +282,7 @@ qspi_status_t qspi_write(qspi_t *obj, const qspi_command_t *command, const void
 qspi_status_t qspi_read(qspi_t *obj, const qspi_command_t *command, void *data, size_t *length)
 {
     QSPI_CommandTypeDef st_command;
+    qspi_leave_memory_mapped(obj);
     qspi_prepare_command(command, &st_command);
 
     st_command.NbData = *length;
@@ -291,6 +303,8 @@ qspi_status_t qspi_command_transfer(qspi_t *obj, const qspi_command_t *command,
 {
     qspi_status_t status = QSPI_STATUS_OK;
 
+    qspi_leave_memory_mapped(obj);
+
     if ((tx_data == NULL || tx_size == 0) && (rx_data == NULL || rx_size == 0)) {
         // only command, no rx or tx
         QSPI_CommandTypeDef st_command;
@@ -320,6 +334,28 @@ qspi_status_t qspi_command_transfer(qspi_t *obj, const qspi_command_t *command,
     return status;
 }
 
+#if defined(QSPI_BASE)
+qspi_status_t qspi_memory_mapped(qspi_t *obj, const qspi_command_t *command, const void **address)
+{
+    QSPI_CommandTypeDef st_command;
+    QSPI_MemoryMappedTypeDef st_mem_mapped;
+
+    qspi_leave_memory_mapped(obj);
+    qspi_prepare_command(command, &st_command);
+
+    // Keep nCS active between accesses, the device is only read
+    st_mem_mapped.TimeOutActivation = QSPI_TIMEOUT_COUNTER_DISABLE;
+    st_mem_mapped.TimeOutPeriod = 0;
+
+    if (HAL_QSPI_MemoryMapped(&obj->handle, &st_command, &st_mem_mapped) != HAL_OK) {
+        return QSPI_STATUS_ERROR;
+    }
+
+    *address = (const void *)QSPI_BASE;
+    return QSPI_STATUS_OK;
+}
+#endif
+
 const PinMap *qspi_master_sclk_pinmap()
 {
     return PinMap_QSPI_SCLK;
@@ -0,0 +1,135 @@
+/* mbed Microcontroller Library
+ *******************************************************************************
+ * Copyright (c) 2019, STMicroelectronics
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of STMicroelectronics nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *******************************************************************************
+ */
+#include "stm_dma.h"
+#include "mbed_critical.h"
+#include "mbed_assert.h"
+#include "mbed_toolchain.h"
+
+MBED_WEAK const stm_dma_link_t *stm_dma_links(size_t *count)
+{
+    *count = 0;
+    return NULL;
+}
+
+#if defined(DMA_SxCR_CHSEL)
+
+#define STM_DMA_STREAMS 16
+
+static DMA_Stream_TypeDef *const dma_streams[STM_DMA_STREAMS] = {
+    DMA1_Stream0, DMA1_Stream1, DMA1_Stream2, DMA1_Stream3,
+    DMA1_Stream4, DMA1_Stream5, DMA1_Stream6, DMA1_Stream7,
+    DMA2_Stream0, DMA2_Stream1, DMA2_Stream2, DMA2_Stream3,
+    DMA2_Stream4, DMA2_Stream5, DMA2_Stream6, DMA2_Stream7,
+};
+
+static const IRQn_Type dma_irqs[STM_DMA_STREAMS] = {
+    DMA1_Stream0_IRQn, DMA1_Stream1_IRQn, DMA1_Stream2_IRQn, DMA1_Stream3_IRQn,
+    DMA1_Stream4_IRQn, DMA1_Stream5_IRQn, DMA1_Stream6_IRQn, DMA1_Stream7_IRQn,
+    DMA2_Stream0_IRQn, DMA2_Stream1_IRQn, DMA2_Stream2_IRQn, DMA2_Stream3_IRQn,
+    DMA2_Stream4_IRQn, DMA2_Stream5_IRQn, DMA2_Stream6_IRQn, DMA2_Stream7_IRQn,
+};
+
+static DMA_HandleTypeDef dma_handles[STM_DMA_STREAMS];
+static uint16_t dma_used;
+
+DMA_HandleTypeDef *stm_dma_alloc(uint32_t periph, stm_dma_direction_t direction, uint8_t width, IRQn_Type *irq)
+{
+    size_t count;
+    const stm_dma_link_t *links = stm_dma_links(&count);
+    const stm_dma_link_t *link = NULL;
+
+    core_util_critical_section_enter();
+    for (size_t i = 0; i < count; i++) {
+        if (links[i].periph == periph && links[i].direction == direction &&
+                !(dma_used & (1 << links[i].stream))) {
+            link = &links[i];
+            dma_used |= 1 << link->stream;
+            break;
+        }
+    }
+    core_util_critical_section_exit();
+
+    if (!link) {
+        return NULL;
+    }
+
+    if (link->stream < 8) {
+        __HAL_RCC_DMA1_CLK_ENABLE();
+    } else {
+        __HAL_RCC_DMA2_CLK_ENABLE();
+    }
+
+    DMA_HandleTypeDef *hdma = &dma_handles[link->stream];
+    hdma->Instance = dma_streams[link->stream];
+    hdma->Init.Channel = link->channel;
+    hdma->Init.Direction = (direction == STM_DMA_TX) ? DMA_MEMORY_TO_PERIPH : DMA_PERIPH_TO_MEMORY;
+    hdma->Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma->Init.MemInc = DMA_MINC_ENABLE;
+    hdma->Init.PeriphDataAlignment = (width == 16) ? DMA_PDATAALIGN_HALFWORD : DMA_PDATAALIGN_BYTE;
+    hdma->Init.MemDataAlignment = (width == 16) ? DMA_MDATAALIGN_HALFWORD : DMA_MDATAALIGN_BYTE;
+    hdma->Init.Mode = DMA_NORMAL;
+    hdma->Init.Priority = (direction == STM_DMA_RX) ? DMA_PRIORITY_HIGH : DMA_PRIORITY_MEDIUM;
+    hdma->Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    hdma->Init.FIFOThreshold = DMA_FIFO_THRESHOLD_FULL;
+    hdma->Init.MemBurst = DMA_MBURST_SINGLE;
+    hdma->Init.PeriphBurst = DMA_PBURST_SINGLE;
+
+    if (HAL_DMA_Init(hdma) != HAL_OK) {
+        stm_dma_free(hdma);
+        return NULL;
+    }
+
+    *irq = dma_irqs[link->stream];
+    NVIC_ClearPendingIRQ(*irq);
+    return hdma;
+}
+
+void stm_dma_free(DMA_HandleTypeDef *hdma)
+{
+    if (!hdma) {
+        return;
+    }
+
+    size_t stream = hdma - dma_handles;
+    MBED_ASSERT(stream < STM_DMA_STREAMS);
+
+    NVIC_DisableIRQ(dma_irqs[stream]);
+    if (hdma->State != HAL_DMA_STATE_RESET) {
+        HAL_DMA_Abort(hdma);
+        HAL_DMA_DeInit(hdma);
+    }
+    hdma->Parent = NULL;
+
+    core_util_critical_section_enter();
+    dma_used &= ~(1 << stream);
+    core_util_critical_section_exit();
+}
+
+#endif
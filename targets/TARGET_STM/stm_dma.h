@@ -0,0 +1,104 @@
+/* mbed Microcontroller Library
+ *******************************************************************************
+ * Copyright (c) 2019, STMicroelectronics
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of STMicroelectronics nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *******************************************************************************
+ */
+#ifndef MBED_STM_DMA_H
+#define MBED_STM_DMA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "cmsis.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Shared allocator of the DMA streams
+ *
+ * The asynchronous serial and SPI transfers take a stream for the length
+ * of a transfer and give it back when it ends, so peripherals mapped on
+ * the same stream can take turns. A transfer that finds none of its
+ * streams free runs on interrupts as before.
+ *
+ * The streams each peripheral request is wired to come from the family
+ * table returned by stm_dma_links(). Families without one, or with
+ * channel based DMA controllers, have no DMA and keep interrupt transfers.
+ */
+
+typedef enum {
+    STM_DMA_TX = 0,     /**< Memory to peripheral */
+    STM_DMA_RX = 1      /**< Peripheral to memory */
+} stm_dma_direction_t;
+
+/** A stream a peripheral request is wired to */
+typedef struct {
+    uint32_t periph;    /**< Base address of the peripheral */
+    uint8_t direction;  /**< stm_dma_direction_t */
+    uint8_t stream;     /**< 0-7 for the streams of DMA1, 8-15 for DMA2 */
+    uint32_t channel;   /**< Channel selecting the request on the stream */
+} stm_dma_link_t;
+
+/** Table of the streams of the family, weak and empty by default
+ *
+ *  @param count    Number of links in the table
+ *  @return         The table, a peripheral request may have several links
+ */
+const stm_dma_link_t *stm_dma_links(size_t *count);
+
+#if defined(DMA_SxCR_CHSEL)
+
+/** Allocate a free stream wired to a peripheral request, and initialize it
+ *
+ *  @param periph       Base address of the peripheral
+ *  @param direction    Direction of the transfers
+ *  @param width        Width of the data, 8 or 16 bits
+ *  @param irq          Interrupt of the stream, to attach the transfer handler to
+ *  @return             DMA handle to link to the HAL handle of the peripheral,
+ *                      NULL if none of the streams of the request is free
+ */
+DMA_HandleTypeDef *stm_dma_alloc(uint32_t periph, stm_dma_direction_t direction, uint8_t width, IRQn_Type *irq);
+
+/** Stop a stream and give it back
+ *
+ *  @param hdma         DMA handle returned by stm_dma_alloc(), may be NULL
+ */
+void stm_dma_free(DMA_HandleTypeDef *hdma);
+
+#else
+
+#define stm_dma_alloc(periph, direction, width, irq)    \
+    ((void)(periph), (void)(direction), (void)(width), (void)(irq), (DMA_HandleTypeDef *)NULL)
+#define stm_dma_free(hdma)                              ((void)(hdma))
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
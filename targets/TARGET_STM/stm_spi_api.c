@@ -40,6 +40,7 @@
 #include "pinmap.h"
 #include "PeripheralPins.h"
 #include "spi_device.h"
+#include "stm_dma.h"
 
 #if DEVICE_SPI_ASYNCH
 #define SPI_INST(obj)    ((SPI_TypeDef *)(obj->spi.spi))
@@ -185,6 +186,8 @@ void spi_init(spi_t *obj, PinName mosi, PinName miso, PinName sclk, PinName ssel
     handle->Init.DataSize          = SPI_DATASIZE_8BIT;
     handle->Init.FirstBit          = SPI_FIRSTBIT_MSB;
     handle->Init.TIMode            = SPI_TIMODE_DISABLE;
+    handle->hdmatx                 = NULL;
+    handle->hdmarx                 = NULL;
 
 #if TARGET_STM32H7
     handle->Init.NSSPMode          = SPI_NSS_PULSE_DISABLE;
@@ -579,8 +582,50 @@ typedef enum {
 } transfer_type_t;
 
 
+static void spi_dma_free(SPI_HandleTypeDef *handle)
+{
+    stm_dma_free(handle->hdmatx);
+    stm_dma_free(handle->hdmarx);
+    handle->hdmatx = NULL;
+    handle->hdmarx = NULL;
+}
+
+/* Take the streams of the transfer, the HAL uses the transmit stream for
+ * receptions too, to clock the data in. Returns false to fall back to
+ * interrupts if any of them is busy.
+ */
+static bool spi_dma_alloc(spi_t *obj, transfer_type_t transfer_type, uint32_t handler)
+{
+    struct spi_s *spiobj = SPI_S(obj);
+    SPI_HandleTypeDef *handle = &(spiobj->handle);
+    uint8_t width = (handle->Init.DataSize == SPI_DATASIZE_16BIT) ? 16 : 8;
+    IRQn_Type irq_tx;
+    IRQn_Type irq_rx;
+
+    handle->hdmatx = stm_dma_alloc((uint32_t)spiobj->spi, STM_DMA_TX, width, &irq_tx);
+    if (handle->hdmatx && (transfer_type & SPI_TRANSFER_TYPE_RX)) {
+        handle->hdmarx = stm_dma_alloc((uint32_t)spiobj->spi, STM_DMA_RX, width, &irq_rx);
+    }
+    if (!handle->hdmatx || ((transfer_type & SPI_TRANSFER_TYPE_RX) && !handle->hdmarx)) {
+        spi_dma_free(handle);
+        return false;
+    }
+
+    handle->hdmatx->Parent = handle;
+    NVIC_SetVector(irq_tx, handler);
+    NVIC_SetPriority(irq_tx, 1);
+    NVIC_EnableIRQ(irq_tx);
+    if (handle->hdmarx) {
+        handle->hdmarx->Parent = handle;
+        NVIC_SetVector(irq_rx, handler);
+        NVIC_SetPriority(irq_rx, 1);
+        NVIC_EnableIRQ(irq_rx);
+    }
+    return true;
+}
+
 /// @returns the number of bytes transferred, or `0` if nothing transferred
-static int spi_master_start_asynch_transfer(spi_t *obj, transfer_type_t transfer_type, const void *tx, void *rx, size_t length)
+static int spi_master_start_asynch_transfer(spi_t *obj, transfer_type_t transfer_type, const void *tx, void *rx, size_t length, bool dma)
 {
     struct spi_s *spiobj = SPI_S(obj);
     SPI_HandleTypeDef *handle = &(spiobj->handle);
@@ -615,16 +660,28 @@ static int spi_master_start_asynch_transfer(spi_t *obj, transfer_type_t transfer
     int rc = 0;
     switch (transfer_type) {
         case SPI_TRANSFER_TYPE_TXRX:
-            rc = HAL_SPI_TransmitReceive_IT(handle, (uint8_t *)tx, (uint8_t *)rx, words);
+            if (dma) {
+                rc = HAL_SPI_TransmitReceive_DMA(handle, (uint8_t *)tx, (uint8_t *)rx, words);
+            } else {
+                rc = HAL_SPI_TransmitReceive_IT(handle, (uint8_t *)tx, (uint8_t *)rx, words);
+            }
             break;
         case SPI_TRANSFER_TYPE_TX:
-            rc = HAL_SPI_Transmit_IT(handle, (uint8_t *)tx, words);
+            if (dma) {
+                rc = HAL_SPI_Transmit_DMA(handle, (uint8_t *)tx, words);
+            } else {
+                rc = HAL_SPI_Transmit_IT(handle, (uint8_t *)tx, words);
+            }
             break;
         case SPI_TRANSFER_TYPE_RX:
             // the receive function also "transmits" the receive buffer so in order
             // to guarantee that 0xff is on the line, we explicitly memset it here
             memset(rx, SPI_FILL_WORD, length);
-            rc = HAL_SPI_Receive_IT(handle, (uint8_t *)rx, words);
+            if (dma) {
+                rc = HAL_SPI_Receive_DMA(handle, (uint8_t *)rx, words);
+            } else {
+                rc = HAL_SPI_Receive_IT(handle, (uint8_t *)rx, words);
+            }
             break;
         default:
             length = 0;
@@ -635,6 +692,10 @@ static int spi_master_start_asynch_transfer(spi_t *obj, transfer_type_t transfer
         length = 0;
     }
 
+    if (dma && !length) {
+        spi_dma_free(handle);
+    }
+
     return length;
 }
 
@@ -644,9 +705,6 @@ void spi_master_transfer(spi_t *obj, const void *tx, size_t tx_length, void *rx,
     struct spi_s *spiobj = SPI_S(obj);
     SPI_HandleTypeDef *handle = &(spiobj->handle);
 
-    // TODO: DMA usage is currently ignored
-    (void) hint;
-
     // check which use-case we have
     bool use_tx = (tx != NULL && tx_length > 0);
     bool use_rx = (rx != NULL && rx_length > 0);
@@ -676,6 +734,9 @@ void spi_master_transfer(spi_t *obj, const void *tx, size_t tx_length, void *rx,
     IRQn_Type irq_n = spiobj->spiIRQ;
     NVIC_SetVector(irq_n, (uint32_t)handler);
 
+    transfer_type_t transfer_type = use_tx ? (use_rx ? SPI_TRANSFER_TYPE_TXRX : SPI_TRANSFER_TYPE_TX) : SPI_TRANSFER_TYPE_RX;
+    bool dma = (hint != DMA_USAGE_NEVER) && spi_dma_alloc(obj, transfer_type, handler);
+
     // enable the right hal transfer
     if (use_tx && use_rx) {
         // we cannot manage different rx / tx sizes, let's use smaller one
@@ -685,11 +746,11 @@ void spi_master_transfer(spi_t *obj, const void *tx, size_t tx_length, void *rx,
             obj->tx_buff.length = size;
             obj->rx_buff.length = size;
         }
-        spi_master_start_asynch_transfer(obj, SPI_TRANSFER_TYPE_TXRX, tx, rx, size);
+        spi_master_start_asynch_transfer(obj, SPI_TRANSFER_TYPE_TXRX, tx, rx, size, dma);
     } else if (use_tx) {
-        spi_master_start_asynch_transfer(obj, SPI_TRANSFER_TYPE_TX, tx, NULL, tx_length);
+        spi_master_start_asynch_transfer(obj, SPI_TRANSFER_TYPE_TX, tx, NULL, tx_length, dma);
     } else if (use_rx) {
-        spi_master_start_asynch_transfer(obj, SPI_TRANSFER_TYPE_RX, NULL, rx, rx_length);
+        spi_master_start_asynch_transfer(obj, SPI_TRANSFER_TYPE_RX, NULL, rx, rx_length, dma);
     }
 }
 
@@ -697,6 +758,14 @@ inline uint32_t spi_irq_handler_asynch(spi_t *obj)
 {
     int event = 0;
 
+    // the streams of a DMA transfer share the handler with the SPI interrupt
+    if (obj->spi.handle.hdmatx) {
+        HAL_DMA_IRQHandler(obj->spi.handle.hdmatx);
+    }
+    if (obj->spi.handle.hdmarx) {
+        HAL_DMA_IRQHandler(obj->spi.handle.hdmarx);
+    }
+
     // call the CubeF4 handler, this will update the handle
     HAL_SPI_IRQHandler(&obj->spi.handle);
 
@@ -718,6 +787,7 @@ inline uint32_t spi_irq_handler_asynch(spi_t *obj)
         // enable the interrupt
         NVIC_DisableIRQ(obj->spi.spiIRQ);
         NVIC_ClearPendingIRQ(obj->spi.spiIRQ);
+        spi_dma_free(&obj->spi.handle);
     }
 
 
@@ -751,6 +821,7 @@ void spi_abort_asynch(spi_t *obj)
     NVIC_DisableIRQ(irq_n);
 
     // clean-up
+    spi_dma_free(handle);
     __HAL_SPI_DISABLE(handle);
     HAL_SPI_DeInit(handle);
     HAL_SPI_Init(handle);
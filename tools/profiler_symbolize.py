@@ -0,0 +1,108 @@
+#!/usr/bin/env python
+"""
+mbed SDK
+Copyright (c) 2019 ARM Limited
+SPDX-License-Identifier: Apache-2.0
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+Symbolize the samples of platform/mbed_profiler.h against the ELF file of
+the application, and list the functions with the most samples. The samples
+are either the console output of mbed_profiler_print(), or the binary array
+of mbed_profiler_sample_t written by mbed_profiler_get_each().
+
+    profiler_symbolize.py BUILD/app.elf profile.txt
+"""
+
+import argparse
+import bisect
+import re
+import struct
+import subprocess
+from collections import defaultdict
+
+SAMPLE_LINE = re.compile(r"^\s*0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\d+)\s*$")
+SAMPLE_SIZE = 12
+
+
+def read_samples(path):
+    """Return a list of (pc, thread_id, count)"""
+    with open(path, "rb") as f:
+        data = f.read()
+    if b"mbed_profiler:" in data:
+        samples = []
+        for line in data.decode("ascii", "replace").splitlines():
+            match = SAMPLE_LINE.match(line)
+            if match:
+                samples.append((int(match.group(1), 16), int(match.group(2), 16),
+                                int(match.group(3))))
+        return samples
+    count = len(data) // SAMPLE_SIZE
+    return list(struct.iter_unpack("<III", data[:count * SAMPLE_SIZE]))
+
+
+def read_symbols(elf, nm):
+    """Return the sorted start addresses, sizes and names of the functions"""
+    output = subprocess.check_output([nm, "--numeric-sort", "--print-size",
+                                      "--defined-only", "--demangle", elf])
+    symbols = []
+    for line in output.decode().splitlines():
+        fields = line.split(None, 3)
+        if len(fields) == 4 and fields[2] in "tTwW":
+            address = int(fields[0], 16) & ~1
+            symbols.append((address, int(fields[1], 16), fields[3]))
+    symbols.sort()
+    return [s[0] for s in symbols], [s[1] for s in symbols], [s[2] for s in symbols]
+
+
+def symbolize(pc, addresses, sizes, names):
+    i = bisect.bisect_right(addresses, pc) - 1
+    if i >= 0 and pc < addresses[i] + max(sizes[i], 1):
+        return names[i]
+    return "0x%08x" % pc
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="List the functions sampled most by the mbed profiler")
+    parser.add_argument("elf", help="ELF file of the profiled application")
+    parser.add_argument("samples", help="console output of mbed_profiler_print, or a binary sample file")
+    parser.add_argument("--threads", action="store_true", help="list functions per thread")
+    parser.add_argument("--nm", default="arm-none-eabi-nm", help="nm of the toolchain (default: %(default)s)")
+    parser.add_argument("-n", "--limit", type=int, default=30,
+                        help="number of functions to list (default: %(default)s, 0 for all)")
+    args = parser.parse_args()
+
+    samples = read_samples(args.samples)
+    addresses, sizes, names = read_symbols(args.elf, args.nm)
+
+    counts = defaultdict(int)
+    total = 0
+    for pc, thread_id, count in samples:
+        name = symbolize(pc, addresses, sizes, names)
+        key = (name, thread_id) if args.threads else (name, None)
+        counts[key] += count
+        total += count
+
+    ranked = sorted(counts.items(), key=lambda item: -item[1])
+    if args.limit:
+        ranked = ranked[:args.limit]
+    for (name, thread_id), count in ranked:
+        thread = ""
+        if thread_id is not None:
+            thread = " [%s]" % ("no thread" if thread_id == 0 else "thread 0x%08x" % thread_id)
+        print("%8d %6.2f%%  %s%s" % (count, 100.0 * count / total, name, thread))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,188 @@
+#!/usr/bin/env python
+"""
+mbed SDK
+Copyright (c) 2019 ARM Limited
+SPDX-License-Identifier: Apache-2.0
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+Decode the events of platform/mbed_swo_trace.h from a raw ITM stream, as
+captured from SWO by a debug probe, into a Chrome trace (JSON) timeline to
+open in chrome://tracing or Perfetto.
+
+    swo_trace_decode.py swo.bin -o trace.json
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+# Stimulus ports of the events, see platform/mbed_swo_trace.h
+THREAD_SWITCH = 1
+TICKER_IRQ = 2
+TICKER_IRQ_END = 3
+EQUEUE_DISPATCH = 4
+EQUEUE_DISPATCH_END = 5
+SOCKET_SEND = 6
+SOCKET_RECV = 7
+BD_READ = 8
+BD_PROGRAM = 9
+BD_ERASE = 10
+BD_END = 11
+CLOCK = 15
+USER = 16
+
+BD_NAMES = {BD_READ: "bd read", BD_PROGRAM: "bd program", BD_ERASE: "bd erase"}
+
+# Timeline rows which aren't threads
+IRQ_TID = 0
+PID = 1
+
+
+def itm_packets(data):
+    """Yield (port, value) for instrumentation packets and (None, cycles)
+    for local timestamps, skipping the other packets"""
+    i = 0
+    size = len(data)
+    while i < size:
+        header = data[i]
+        i += 1
+        if header & 0x03:
+            length = (1, 2, 4)[(header & 0x03) - 1]
+            payload = data[i:i + length]
+            i += length
+            if len(payload) < length:
+                return
+            if not header & 0x04:
+                value = 0
+                for n, byte in enumerate(payload):
+                    value |= byte << (8 * n)
+                yield header >> 3, value
+        elif header & 0x0F == 0:
+            if header & 0xC0 == 0xC0:
+                # Local timestamp, format 1
+                value = 0
+                shift = 0
+                while i < size:
+                    byte = data[i]
+                    i += 1
+                    value |= (byte & 0x7F) << shift
+                    shift += 7
+                    if not byte & 0x80:
+                        break
+                yield None, value
+            elif not header & 0x80 and header not in (0x00, 0x70):
+                # Local timestamp, format 2
+                yield None, (header >> 4) & 0x07
+            # Synchronization and overflow packets have no payload
+        elif header & 0x80:
+            # Extension and global timestamp packets
+            while i < size and data[i] & 0x80:
+                i += 1
+            i += 1
+
+
+def decode(data, clock):
+    """Return the Chrome trace events of a raw ITM stream"""
+    events = []
+    cycles = 0
+    pending = []
+    # Running thread, in a dict so the nested functions can change it
+    state = {"thread": None}
+    threads = set()
+
+    def time(at):
+        return at * 1e6 / clock
+
+    def flush():
+        for port, value in pending:
+            handle(port, value, time(cycles))
+        del pending[:]
+
+    def handle(port, value, ts):
+        tid = state["thread"] if state["thread"] is not None else IRQ_TID
+        if port == THREAD_SWITCH:
+            if state["thread"] is not None:
+                events.append({"ph": "E", "pid": PID, "tid": -1, "ts": ts})
+            name = "thread 0x%08x" % value
+            events.append({"ph": "B", "pid": PID, "tid": -1, "ts": ts, "name": name})
+            state["thread"] = value
+            threads.add(value)
+        elif port == TICKER_IRQ:
+            events.append({"ph": "B", "pid": PID, "tid": IRQ_TID, "ts": ts,
+                           "name": "ticker irq", "args": {"ticker": "0x%08x" % value}})
+        elif port == TICKER_IRQ_END:
+            events.append({"ph": "E", "pid": PID, "tid": IRQ_TID, "ts": ts})
+        elif port == EQUEUE_DISPATCH:
+            events.append({"ph": "B", "pid": PID, "tid": tid, "ts": ts,
+                           "name": "event 0x%08x" % value})
+        elif port == EQUEUE_DISPATCH_END:
+            events.append({"ph": "E", "pid": PID, "tid": tid, "ts": ts})
+        elif port in (SOCKET_SEND, SOCKET_RECV):
+            name = "socket send" if port == SOCKET_SEND else "socket recv"
+            events.append({"ph": "i", "s": "t", "pid": PID, "tid": tid, "ts": ts,
+                           "name": name, "args": {"bytes": value}})
+        elif port in BD_NAMES:
+            events.append({"ph": "B", "pid": PID, "tid": tid, "ts": ts,
+                           "name": BD_NAMES[port], "args": {"address": "0x%08x" % value}})
+        elif port == BD_END:
+            err = struct.unpack("<i", struct.pack("<I", value))[0]
+            events.append({"ph": "E", "pid": PID, "tid": tid, "ts": ts,
+                           "args": {"error": err}})
+        elif port >= USER:
+            events.append({"ph": "i", "s": "t", "pid": PID, "tid": tid, "ts": ts,
+                           "name": "user %d" % (port - USER), "args": {"value": value}})
+
+    for port, value in itm_packets(bytearray(data)):
+        if port is None:
+            # A timestamp gives the time of the packets since the previous one
+            cycles += value
+            flush()
+        elif port == CLOCK:
+            flush()
+            clock = value
+        else:
+            pending.append((port, value))
+    flush()
+
+    events.append({"ph": "M", "pid": PID, "tid": -1, "name": "thread_name",
+                   "args": {"name": "threads"}})
+    events.append({"ph": "M", "pid": PID, "tid": IRQ_TID, "name": "thread_name",
+                   "args": {"name": "interrupts"}})
+    for tid in threads:
+        events.append({"ph": "M", "pid": PID, "tid": tid, "name": "thread_name",
+                       "args": {"name": "thread 0x%08x" % tid}})
+    return events
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Convert a raw ITM stream of mbed SWO trace events to a Chrome trace")
+    parser.add_argument("input", help="raw ITM stream captured from SWO")
+    parser.add_argument("-o", "--output", help="Chrome trace file (default: stdout)")
+    parser.add_argument("-c", "--clock", type=int, default=1000000,
+                        help="timestamp clock in Hz until the first clock event (default: %(default)s)")
+    args = parser.parse_args()
+
+    with open(args.input, "rb") as f:
+        events = decode(f.read(), args.clock)
+
+    out = open(args.output, "w") if args.output else sys.stdout
+    json.dump({"traceEvents": events, "displayTimeUnit": "ns"}, out)
+    if args.output:
+        out.close()
+
+
+if __name__ == "__main__":
+    main()